@@ -11,13 +11,20 @@
 #import "UANotificationCategories.h"
 #import "UAPush.h"
 #import "ACCStubData+Internal.h"
+#import "UADispatcher.h"
 
 static NSString * const UAAccengageIDKey = @"a4sid";
 static NSString * const UAAccengageForegroundKey = @"a4sd";
 NSString *const UAAccengageSettingsMigrated = @"UAAccengageSettingsMigrated";
 
+// Set once the legacy Accengage data has been read, after which it is never unarchived again
+static NSString * const UAAccengageLegacyDataMigrated = @"UAAccengageLegacyDataMigrated";
+static NSString * const UAAccengageDeviceIDKey = @"UAAccengageDeviceID";
+
 @interface UAAccengage() <NSKeyedUnarchiverDelegate>
 @property (nonatomic, strong) NSDictionary *accengageSettings;
+@property (nonatomic, strong) UAPreferenceDataStore *dataStore;
+@property (nonatomic, strong) UADispatcher *migrationDispatcher;
 @end
 
 @implementation UAAccengage
@@ -36,7 +43,10 @@ NSString *const UAAccengageSettingsMigrated = @"UAAccengageSettingsMigrated";
 
         NSSet *accengageCategories = [UANotificationCategories createCategoriesFromFile:[[UAAccengageResources bundle] pathForResource:@"UAAccengageNotificationCategories" ofType:@"plist"]];
         push.accengageCategories = accengageCategories;
-        
+
+        self.dataStore = dataStore;
+
+        // Applied before takeOff returns, so the legacy opt-outs are in place before anything is sent
         BOOL settingsMigrated = [dataStore boolForKey:UAAccengageSettingsMigrated];
         if (!settingsMigrated) {
             [self migrateSettingsToAnalytics:analytics];
@@ -45,6 +55,14 @@ NSString *const UAAccengageSettingsMigrated = @"UAAccengageSettingsMigrated";
                 [dataStore setBool:YES forKey:UAAccengageSettingsMigrated];
             }];
         }
+
+        if (![dataStore boolForKey:UAAccengageLegacyDataMigrated]) {
+            self.migrationDispatcher = [UADispatcher serialDispatcher:QOS_CLASS_UTILITY];
+            [self.migrationDispatcher dispatchAsync:^{
+                UA_STRONGIFY(self);
+                [self migrateLegacyDeviceID];
+            }];
+        }
     }
     return self;
 }
@@ -58,6 +76,18 @@ NSString *const UAAccengageSettingsMigrated = @"UAAccengageSettingsMigrated";
 }
 
 - (NSDictionary *)accengageSettings {
+    @synchronized (self) {
+        return [self loadAccengageSettings];
+    }
+}
+
+- (void)setAccengageSettings:(NSDictionary *)accengageSettings {
+    @synchronized (self) {
+        _accengageSettings = accengageSettings;
+    }
+}
+
+- (NSDictionary *)loadAccengageSettings {
     if (!_accengageSettings) {
         NSArray *paths = NSSearchPathForDirectoriesInDomains(NSLibraryDirectory, NSUserDomainMask, YES);
         NSString *documentsDirectory = [paths firstObject];
@@ -149,6 +179,19 @@ NSString *const UAAccengageSettingsMigrated = @"UAAccengageSettingsMigrated";
     completionHandler();
 }
 
+/**
+ * Reads the legacy Accengage data once, keeping only the device ID. Called on the migration dispatcher.
+ */
+- (void)migrateLegacyDeviceID {
+    id deviceID = self.accengageSettings[@"BMA4SID"];
+    if ([deviceID isKindOfClass:[NSString class]]) {
+        [self.dataStore setObject:deviceID forKey:UAAccengageDeviceIDKey];
+    }
+
+    // Only set once the device ID is stored
+    [self.dataStore setBool:YES forKey:UAAccengageLegacyDataMigrated];
+}
+
 - (void)migrateSettingsToAnalytics:(UAAnalytics *)analytics {
     NSDictionary *dataDictionary = self.accengageSettings;
     id accAnalytics = dataDictionary[@"DoNotTrack"];
@@ -200,8 +243,7 @@ NSString *const UAAccengageSettingsMigrated = @"UAAccengageSettingsMigrated";
                        completionHandler:(UAChannelRegistrationExtenderCompletionHandler)completionHandler {
 
     // get the Accengage ID and set it as an identity hint
-    NSDictionary *dataDictionary = self.accengageSettings;
-    id accengageDeviceIDObject = dataDictionary[@"BMA4SID"];
+    id accengageDeviceIDObject = [self legacyDeviceID];
 
     NSString *accengageDeviceID = @"";
     if ([accengageDeviceIDObject isKindOfClass:[NSString class]]) {
@@ -218,6 +260,17 @@ NSString *const UAAccengageSettingsMigrated = @"UAAccengageSettingsMigrated";
     completionHandler(payload);
 }
 
+- (nullable NSString *)legacyDeviceID {
+    NSString *deviceID = [self.dataStore stringForKey:UAAccengageDeviceIDKey];
+    if (deviceID || [self.dataStore boolForKey:UAAccengageLegacyDataMigrated]) {
+        return deviceID;
+    }
+
+    // Registration raced the migration
+    id legacyDeviceID = self.accengageSettings[@"BMA4SID"];
+    return [legacyDeviceID isKindOfClass:[NSString class]] ? legacyDeviceID : nil;
+}
+
 - (BOOL)isValidDeviceID:(NSString *)deviceID {
     return deviceID && deviceID.length && ![deviceID isEqualToString:@"00000000-0000-0000-0000-000000000000"];
 }
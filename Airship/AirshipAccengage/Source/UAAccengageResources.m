@@ -5,10 +5,14 @@
 @implementation UAAccengageResources
 
 + (NSBundle *)bundle {
-    NSBundle *bundle = [NSBundle bundleWithPath:[[NSBundle mainBundle] pathForResource:@"Airship_AirshipAccengage"
-                                                                                ofType:@"bundle"]];
+    static NSBundle *bundle;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        bundle = [NSBundle bundleWithPath:[[NSBundle mainBundle] pathForResource:@"Airship_AirshipAccengage" ofType:@"bundle"]];
+        bundle = bundle ? : [NSBundle bundleForClass:[self class]];
+    });
 
-    return bundle ? : [NSBundle bundleForClass:[self class]];
+    return bundle;
 }
 
 @end
@@ -158,6 +158,25 @@
     [payloadMock verify];
 }
 
+- (void)testExtendChannelAfterMigration {
+    [self.dataStore setBool:YES forKey:@"UAAccengageLegacyDataMigrated"];
+    [self.dataStore setObject:@"migrated-id" forKey:@"UAAccengageDeviceID"];
+
+    UAChannel *channel = [UAChannel channelWithDataStore:self.dataStore config:self.config localeManager:self.localeManager];
+    id pushMock = OCMClassMock([UAPush class]);
+    UAAccengage *accengage = [[UAAccengage alloc] initWithDataStore:self.dataStore channel:channel push:pushMock analytics:self.analytics];
+
+    // Once migrated the legacy data is ignored
+    accengage.accengageSettings = @{@"BMA4SID":@"legacy-id"};
+
+    UAChannelRegistrationPayload *payload = [[UAChannelRegistrationPayload alloc] init];
+    [accengage extendChannelRegistrationPayload:payload completionHandler:^(UAChannelRegistrationPayload *payload) {}];
+    XCTAssertEqualObjects(@"migrated-id", payload.accengageDeviceID);
+
+    [self.dataStore removeObjectForKey:@"UAAccengageLegacyDataMigrated"];
+    [self.dataStore removeObjectForKey:@"UAAccengageDeviceID"];
+}
+
 - (void)testMigrateSettings {
     [self.dataStore setBool:YES forKey:UAirshipDataCollectionEnabledKey];
 
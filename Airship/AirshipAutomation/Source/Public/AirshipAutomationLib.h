@@ -45,5 +45,6 @@
 #import "UAScheduleAudience.h"
 #import "UAScheduleDelay.h"
 #import "UAScheduleEdits.h"
+#import "UAScheduleTimeline.h"
 #import "UAScheduleTrigger.h"
 #import "UATagSelector.h"
@@ -9,6 +9,7 @@
 #import "UAAPIClient.h"
 #import "UAAction.h"
 #import "UAActionArguments.h"
+#import "UAActionRegistry.h"
 #import "UAActionResult.h"
 #import "UAActionRunner.h"
 #import "UAAnalytics.h"
@@ -18,6 +19,7 @@
 #import "UAApplicationState.h"
 #import "UAAsyncOperation.h"
 #import "UAAutomationModuleLoaderFactory.h"
+#import "UABackgroundWorkScheduler.h"
 #import "UABespokeCloseView.h"
 #import "UABeveledLoadingIndicator.h"
 #import "UAChannel.h"
@@ -29,11 +31,15 @@
 #import "UADeepLinkAction.h"
 #import "UADisposable.h"
 #import "UAEvent.h"
+#import "UAForegroundWorkScheduler.h"
 #import "UAGlobal.h"
 #import "UAJSONMatcher.h"
 #import "UAJSONPredicate.h"
 #import "UAJSONValueMatcher.h"
+#import "UAMemoryPressureCoordinator.h"
+#import "UAMetricsRegistry.h"
 #import "UAModuleLoader.h"
+#import "UANetworkMonitor.h"
 #import "UANotificationAction.h"
 #import "UANotificationCategories.h"
 #import "UANotificationCategory.h"
@@ -50,6 +56,8 @@
 #import "UARuntimeConfig.h"
 #import "UASystemVersion.h"
 #import "UATagGroups.h"
+#import "UATask.h"
+#import "UATaskQueue.h"
 #import "UAUtils.h"
 #import "UAViewUtils.h"
 #import "UA_Base64.h"
@@ -11,6 +11,7 @@
 #import "UAInAppMessageManager.h"
 #import "UAActionSchedule.h"
 #import "UAInAppMessageSchedule.h"
+#import "UAScheduleTimeline.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -34,6 +35,21 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property(nonatomic, readonly, strong) UAInAppMessageManager *inAppMessageManager;
 
+/**
+ * Schedule timeline delegate, notified when a schedule's timeline finishes.
+ */
+@property (nonatomic, weak, nullable) id<UAScheduleTimelineDelegate> timelineDelegate;
+
+/**
+ * The most recently finished schedule timelines, newest first.
+ */
+@property (nonatomic, readonly, copy) NSArray<UAScheduleTimeline *> *recentTimelines;
+
+/**
+ * Aggregate stage durations across all schedule timelines, keyed by stage name.
+ */
+@property (nonatomic, readonly, copy) NSDictionary<NSString *, UAScheduleStageMetrics *> *stageMetrics;
+
 /**
  * Schedules an in-app automation.
  *
@@ -148,6 +164,14 @@ NS_ASSUME_NONNULL_BEGIN
                      edits:(UAScheduleEdits *)edits
          completionHandler:(nullable void (^)(BOOL))completionHandler;
 
+/**
+ * Gets a schedule's timeline in progress, or its most recently finished timeline.
+ *
+ * @param scheduleID The schedule ID.
+ * @return The timeline, or `nil` if the schedule has none.
+ */
+- (nullable UAScheduleTimeline *)timelineForScheduleID:(NSString *)scheduleID;
+
 /**
  * Check display audience conditions.
  *
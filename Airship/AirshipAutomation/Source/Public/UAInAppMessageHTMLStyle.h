@@ -33,6 +33,11 @@ extern NSString *const UAHTMLMaxHeightKey;
  */
 extern NSString *const UAHTMLHideDismissIconKey;
 
+/**
+ * The key representing the preload content flag in a style plist.
+ */
+extern NSString *const UAHTMLPreloadContentKey;
+
 /**
  * Model object representing a custom style to be applied
  * to HTML in-app messages.
@@ -68,6 +73,12 @@ extern NSString *const UAHTMLHideDismissIconKey;
  */
 @property(nonatomic, assign) BOOL hideDismissIcon;
 
+/**
+ * Flag to load the HTML content offscreen while the message is prepared. The message is
+ * not ready to display until the content finishes loading. Defaults to `NO`.
+ */
+@property(nonatomic, assign) BOOL preloadContent;
+
 @end
 
 NS_ASSUME_NONNULL_END
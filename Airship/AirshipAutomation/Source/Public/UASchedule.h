@@ -113,6 +113,13 @@ extern NSUInteger const UAScheduleMaxTriggers;
  */
 @property(nonatomic, strong, nullable) UAScheduleAudience *audience;
 
+/**
+ * The IDs of the frequency constraints that cap how often the schedule is executed.
+ *
+ * Optional.
+ */
+@property(nonatomic, copy, nullable) NSArray<NSString *> *frequencyConstraintIDs;
+
 @end
 
 
@@ -157,6 +164,11 @@ extern NSUInteger const UAScheduleMaxTriggers;
  */
 @property(nonatomic, nullable, readonly) UAScheduleAudience *audience;
 
+/**
+ * The IDs of the frequency constraints that cap how often the schedule is executed.
+ */
+@property(nonatomic, nullable, readonly) NSArray<NSString *> *frequencyConstraintIDs;
+
 /**
  * The max number of times the schedule may be executed.
  *
@@ -61,6 +61,13 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property(nonatomic, strong, nullable) UAScheduleAudience *audience;
 
+/**
+ * The IDs of the frequency constraints that cap how often the schedule is executed. An empty
+ * array removes the schedule's constraints.
+ *
+ * Optional.
+ */
+@property(nonatomic, copy, nullable) NSArray<NSString *> *frequencyConstraintIDs;
 
 @end
 
@@ -117,6 +124,11 @@ NS_ASSUME_NONNULL_BEGIN
 */
 @property(nonatomic, readonly, nullable) UAScheduleAudience *audience;
 
+/**
+ * The IDs of the frequency constraints that cap how often the schedule is executed.
+ */
+@property(nonatomic, readonly, nullable) NSArray<NSString *> *frequencyConstraintIDs;
+
 ///---------------------------------------------------------------------------------------
 /// @name Schedule Edit Methods
 ///---------------------------------------------------------------------------------------
@@ -0,0 +1,168 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Trigger evaluation stage.
+ */
+extern NSString *const UAScheduleTimelineStageTrigger;
+
+/**
+ * Audience check stage.
+ */
+extern NSString *const UAScheduleTimelineStageAudience;
+
+/**
+ * Tag group lookup stage, part of the audience check.
+ */
+extern NSString *const UAScheduleTimelineStageTagLookup;
+
+/**
+ * Message asset download stage.
+ */
+extern NSString *const UAScheduleTimelineStageAssets;
+
+/**
+ * Adapter prepare stage.
+ */
+extern NSString *const UAScheduleTimelineStageAdapterPrepare;
+
+/**
+ * Ready to display stage. Measured from the first readiness check until the schedule is ready,
+ * so it includes any time spent waiting on the display coordinator or the adapter.
+ */
+extern NSString *const UAScheduleTimelineStageReady;
+
+/**
+ * Display stage.
+ */
+extern NSString *const UAScheduleTimelineStageDisplay;
+
+/**
+ * Outcome when the message was displayed.
+ */
+extern NSString *const UAScheduleTimelineOutcomeDisplayed;
+
+/**
+ * Outcome when the schedule's actions were run.
+ */
+extern NSString *const UAScheduleTimelineOutcomeExecuted;
+
+/**
+ * Outcome when the schedule was cancelled during prepare.
+ */
+extern NSString *const UAScheduleTimelineOutcomeCancelled;
+
+/**
+ * Outcome when the schedule was skipped during prepare.
+ */
+extern NSString *const UAScheduleTimelineOutcomeSkipped;
+
+/**
+ * Outcome when the schedule was penalized during prepare.
+ */
+extern NSString *const UAScheduleTimelineOutcomePenalized;
+
+/**
+ * A measured stage of a schedule's timeline.
+ */
+@interface UAScheduleTimelineStage : NSObject
+
+/**
+ * The stage name.
+ */
+@property (nonatomic, copy, readonly) NSString *name;
+
+/**
+ * How long the stage took, in seconds.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval duration;
+
+/**
+ * The stage result, if any.
+ */
+@property (nonatomic, copy, readonly, nullable) NSString *result;
+
+@end
+
+/**
+ * The stages a schedule went through from being triggered to being displayed or dropped.
+ */
+@interface UAScheduleTimeline : NSObject
+
+/**
+ * The schedule ID.
+ */
+@property (nonatomic, copy, readonly) NSString *scheduleID;
+
+/**
+ * When the timeline started.
+ */
+@property (nonatomic, strong, readonly) NSDate *startDate;
+
+/**
+ * The measured stages, in the order they finished.
+ */
+@property (nonatomic, copy, readonly) NSArray<UAScheduleTimelineStage *> *stages;
+
+/**
+ * The outcome, or `nil` if the timeline is still in progress.
+ */
+@property (nonatomic, copy, readonly, nullable) NSString *outcome;
+
+/**
+ * Time from the start of the timeline until it finished, or until now if it is still in progress, in seconds.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval duration;
+
+@end
+
+/**
+ * Aggregate durations for a stage across all schedules.
+ */
+@interface UAScheduleStageMetrics : NSObject
+
+/**
+ * The stage name.
+ */
+@property (nonatomic, copy, readonly) NSString *name;
+
+/**
+ * How many times the stage was measured.
+ */
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+/**
+ * The total duration, in seconds.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval totalDuration;
+
+/**
+ * The longest duration, in seconds.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval maxDuration;
+
+/**
+ * The average duration, in seconds.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval averageDuration;
+
+@end
+
+/**
+ * Delegate protocol for receiving schedule timelines.
+ */
+@protocol UAScheduleTimelineDelegate <NSObject>
+
+/**
+ * Called on the main queue when a schedule's timeline finishes.
+ *
+ * @param timeline The finished timeline.
+ */
+- (void)scheduleTimelineFinished:(UAScheduleTimeline *)timeline;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -40,7 +40,7 @@ NSString * const UAAuthTokenAPIClientErrorDomain = @"com.urbanairship.auth_token
 - (void)tokenWithChannelID:(NSString *)channelID completionHandler:(void (^)(UAAuthToken * _Nullable, NSError * _Nullable))completionHandler {
     UARequest *request = [self authTokenRequestWithChannelID:channelID];
 
-    [self.session dataTaskWithRequest:request retryWhere:^BOOL(NSData * _Nullable data, NSURLResponse * _Nullable response) {
+    [self dataTaskWithRequest:request requestKey:[UAAPIClient requestKeyForRequest:request] retryWhere:^BOOL(NSData * _Nullable data, NSURLResponse * _Nullable response) {
         return NO;
     } completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
         if (error) {
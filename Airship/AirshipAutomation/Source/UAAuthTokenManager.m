@@ -1,6 +1,10 @@
 /* Copyright Airship and Contributors */
 
 #import "UAAuthTokenManager+Internal.h"
+#import "UAAirshipAutomationCoreImport.h"
+
+// Fraction of a token's lifetime after which it is refreshed in the background
+static double const UAAuthTokenManagerRefreshLifetimeFraction = 0.8;
 
 @interface UAAuthTokenManager ()
 @property(nonatomic, strong) UAAuthTokenAPIClient *client;
@@ -8,6 +12,8 @@
 @property(nonatomic, strong) UAAuthToken *cachedToken;
 @property(nonatomic, strong) UADate *date;
 @property(nonatomic, strong) UADispatcher *requestDispatcher;
+@property(nonatomic, strong, nullable) NSDate *refreshDate;
+@property(nonatomic, assign) BOOL refreshing;
 @end
 
 @implementation UAAuthTokenManager
@@ -24,11 +30,20 @@
         self.channel = channel;
         self.date = date;
         self.requestDispatcher = dispatcher;
+
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationDidTransitionToForeground)
+                                                     name:UAApplicationDidTransitionToForeground
+                                                   object:nil];
     }
 
     return self;
 }
 
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
 + (instancetype)authTokenManagerWithAPIClient:(UAAuthTokenAPIClient *)client
                                       channel:(UAChannel *)channel
                                          date:(UADate *)date
@@ -58,6 +73,7 @@
         UAAuthToken *cachedToken = self.cachedToken;
 
         if (cachedToken) {
+            [self refreshTokenIfNeeded];
             return completionHandler(cachedToken.token);
         }
 
@@ -80,17 +96,72 @@
             return completionHandler(nil);
         }
 
-        self.cachedToken = responseToken;
+        [self cacheToken:responseToken];
         completionHandler(responseToken.token);
     }];
 }
 
+- (void)cacheToken:(UAAuthToken *)token {
+    NSDate *now = [self.date now];
+    NSTimeInterval lifetime = [token.expiration timeIntervalSinceDate:now];
+
+    self.cachedToken = token;
+    self.refreshDate = [now dateByAddingTimeInterval:MAX(0, lifetime * UAAuthTokenManagerRefreshLifetimeFraction)];
+}
+
+/**
+ * Fetches a replacement for a cached token that is close to expiring without blocking the
+ * request queue, so callers keep getting the current token until the new one arrives. Must
+ * be called on the request dispatcher.
+ */
+- (void)refreshTokenIfNeeded {
+    if (self.refreshing || !self.refreshDate || [[self.date now] compare:self.refreshDate] == NSOrderedAscending) {
+        return;
+    }
+
+    NSString *channelID = self.channel.identifier;
+    if (!channelID) {
+        return;
+    }
+
+    UA_LTRACE(@"Refreshing auth token ahead of expiration");
+    self.refreshing = YES;
+
+    UA_WEAKIFY(self)
+    [self.client tokenWithChannelID:channelID completionHandler:^(UAAuthToken * _Nullable token, NSError * _Nullable error) {
+        UA_STRONGIFY(self)
+        [self.requestDispatcher dispatchAsync:^{
+            self.refreshing = NO;
+
+            if (!token || error) {
+                UA_LDEBUG(@"Unable to refresh auth token: %@", error);
+                return;
+            }
+
+            if ([channelID isEqualToString:self.channel.identifier]) {
+                [self cacheToken:token];
+            }
+        }];
+    }];
+}
+
+- (void)applicationDidTransitionToForeground {
+    UA_WEAKIFY(self)
+    [self.requestDispatcher dispatchAsync:^{
+        UA_STRONGIFY(self)
+        if (self.cachedToken) {
+            [self refreshTokenIfNeeded];
+        }
+    }];
+}
+
 - (void)expireToken:(NSString *)token {
     UA_WEAKIFY(self)
     [self.requestDispatcher dispatchAsync:^{
         UA_STRONGIFY(self)
         if ([token isEqualToString:self->_cachedToken.token]) {
             self->_cachedToken = nil;
+            self.refreshDate = nil;
         }
     }];
 }
@@ -10,6 +10,7 @@
 NS_ASSUME_NONNULL_BEGIN
 
 @class UAScheduleTriggerContext;
+@class UAFrequencyConstraint;
 
 /**
  * Prepare results
@@ -109,6 +110,13 @@ typedef NS_ENUM(NSInteger, UAAutomationScheduleReadyResult) {
  */
 - (void)onScheduleCancelled:(nonnull UASchedule *)schedule;
 
+/**
+ * Called once when schedules are cancelled together. If implemented, it is called instead of
+ * `onScheduleCancelled:`.
+ * @param schedules The schedules.
+ */
+- (void)onSchedulesCancelled:(nonnull NSArray<UASchedule *> *)schedules;
+
 /**
  * Called when a schedule's limit is reached.
  * @param schedule The schedule.
@@ -121,6 +129,22 @@ typedef NS_ENUM(NSInteger, UAAutomationScheduleReadyResult) {
  */
 - (void)onNewSchedule:(nonnull UASchedule *)schedule;
 
+/**
+ * Called when a prepared schedule is not executed because one of its frequency constraints
+ * is over the limit. The schedule goes back to idle.
+ * @param schedule The schedule.
+ */
+- (void)onScheduleFrequencyLimited:(nonnull UASchedule *)schedule;
+
+/**
+ * Called when an idle schedule's trigger moves within one increment of its goal, so the
+ * schedule is likely to be triggered by the next matching event.
+ * @param schedule The schedule.
+ * @param triggerContext The expected trigger context. The event is not known yet and will be `nil`.
+ */
+- (void)onScheduleTriggerNearlyMet:(nonnull UASchedule *)schedule
+                    triggerContext:(nonnull UAScheduleTriggerContext *)triggerContext;
+
 @end
 
 
@@ -155,6 +179,7 @@ typedef NS_ENUM(NSInteger, UAAutomationScheduleReadyResult) {
  * @param timerScheduler A timer scheduler
  * @param notificationCenter The notification center.
  * @param dispatcher The dispatcher to dispatch main queue blocks.
+ * @param triggerEventDispatcher The serial dispatcher tracked events are buffered and applied on.
  * @param application The main application.
  * @param date The UADate instance.
  *
@@ -165,6 +190,7 @@ typedef NS_ENUM(NSInteger, UAAutomationScheduleReadyResult) {
                                      timerScheduler:(UATimerScheduler *)timerScheduler
                                  notificationCenter:(NSNotificationCenter *)notificationCenter
                                          dispatcher:(UADispatcher *)dispatcher
+                             triggerEventDispatcher:(UADispatcher *)triggerEventDispatcher
                                         application:(UIApplication *)application
                                                date:(UADate *)date;
 
@@ -210,6 +236,14 @@ typedef NS_ENUM(NSInteger, UAAutomationScheduleReadyResult) {
  */
 - (void)scheduleConditionsChanged;
 
+/**
+ * Called when the schedule conditions change for specific waiting schedules. Only those
+ * schedules are attempted, in the given order.
+ *
+ * @param scheduleIDs The schedule IDs.
+ */
+- (void)scheduleConditionsChangedForScheduleIDs:(NSArray<NSString *> *)scheduleIDs;
+
 /**
  * Cancels a schedule with the given identifier.
  *
@@ -297,6 +331,28 @@ typedef NS_ENUM(NSInteger, UAAutomationScheduleReadyResult) {
                      edits:(UAScheduleEdits *)edits
          completionHandler:(void (^)(BOOL))completionHandler;
 
+/**
+ * Edits existing schedules and saves new schedules in a single transaction.
+ *
+ * @param edits The edits to apply, keyed by schedule identifier. Schedules that are not found are ignored.
+ * @param schedules The new schedules. Schedules over the schedule limit are not saved.
+ * @param completionHandler The completion handler with the result. `NO` if any of the new schedules
+ * are invalid or the changes failed to save, in which case none of the changes are applied, or if
+ * some of the new schedules were over the limit, in which case the edits are still applied.
+ */
+- (void)updateSchedulesWithEdits:(NSDictionary<NSString *, UAScheduleEdits *> *)edits
+                    newSchedules:(NSArray<UASchedule *> *)schedules
+               completionHandler:(void (^)(BOOL))completionHandler;
+
+/**
+ * Replaces the frequency constraints that cap schedule executions. Schedules that are over
+ * one of their constraints are skipped before they are prepared, and checked again right
+ * before they execute.
+ *
+ * @param constraints The frequency constraints.
+ */
+- (void)updateFrequencyConstraints:(NSArray<UAFrequencyConstraint *> *)constraints;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -15,6 +15,11 @@
 #import "UAInAppMessageSchedule.h"
 #import "UAActionSchedule.h"
 #import "UADeferredSchedule+Internal.h"
+#import "UAScheduleTriggerIndex+Internal.h"
+#import "UAScheduleTimerQueue+Internal.h"
+#import "UAScheduleRunQueue+Internal.h"
+#import "UAScheduleTimeline+Internal.h"
+#import "UAFrequencyLimitManager+Internal.h"
 
 @interface UAAutomationStateCondition : NSObject
 
@@ -40,6 +45,74 @@
 
 @end
 
+/**
+ * A tracked event waiting to be applied to triggers.
+ */
+@interface UAAutomationTriggerEvent : NSObject
+
+@property (nonatomic, assign) UAScheduleTriggerType type;
+@property (nonatomic, strong, nullable) id argument;
+@property (nonatomic, assign) double incrementAmount;
+
++ (instancetype)eventWithType:(UAScheduleTriggerType)type argument:(nullable id)argument incrementAmount:(double)amount;
+
+@end
+
+@implementation UAAutomationTriggerEvent
+
++ (instancetype)eventWithType:(UAScheduleTriggerType)type argument:(id)argument incrementAmount:(double)amount {
+    UAAutomationTriggerEvent *event = [[UAAutomationTriggerEvent alloc] init];
+    event.type = type;
+    event.argument = argument;
+    event.incrementAmount = amount;
+    return event;
+}
+
+@end
+
+/**
+ * A decoded schedule along with the object ID of the schedule data it was decoded from.
+ */
+@interface UAAutomationCachedSchedule : NSObject
+
+@property (nonatomic, strong, nonnull) NSManagedObjectID *objectID;
+@property (nonatomic, strong, nonnull) UASchedule *schedule;
+
++ (instancetype)cachedSchedule:(UASchedule *)schedule objectID:(NSManagedObjectID *)objectID;
+
+@end
+
+@implementation UAAutomationCachedSchedule
+
++ (instancetype)cachedSchedule:(UASchedule *)schedule objectID:(NSManagedObjectID *)objectID {
+    UAAutomationCachedSchedule *cached = [[UAAutomationCachedSchedule alloc] init];
+    cached.schedule = schedule;
+    cached.objectID = objectID;
+    return cached;
+}
+
+@end
+
+// Maximum number of compiled trigger predicates kept in memory
+static NSUInteger const UAAutomationEnginePredicateCacheLimit = 500;
+
+// Maximum number of decoded schedules kept in memory
+static NSUInteger const UAAutomationEngineScheduleCacheLimit = 200;
+
+// Estimated sizes of a cached predicate and a cached decoded schedule
+static NSUInteger const UAAutomationEnginePredicateEstimatedSize = 1024;
+static NSUInteger const UAAutomationEngineScheduleEstimatedSize = 4096;
+
+// Maximum number of schedules waiting on the delegate to finish preparing
+static NSUInteger const UAAutomationEngineMaxConcurrentPrepares = 4;
+
+// Seconds a prepare holds its slot before the next queued schedule may start, so prepares that
+// are backing off before a retry can't starve the queue
+static NSTimeInterval const UAAutomationEnginePrepareSlotTimeout = 30;
+
+// Maximum number of finished schedules deleted per store operation
+static NSUInteger const UAAutomationEnginePurgeSliceSize = 100;
+
 @interface UAAutomationEngine()
 @property (nonatomic, strong) UAAppStateTracker *appStateTracker;
 @property (nonatomic, strong) UATimerScheduler *timerScheduler;
@@ -50,12 +123,27 @@
 
 @property (nonatomic, copy) NSString *currentScreen;
 @property (nonatomic, copy, nullable) NSString * currentRegion;
-@property (nonatomic, strong) NSMutableArray *activeTimers;
+@property (nonatomic, strong) UAScheduleTimerQueue *timerQueue;
+@property (nonatomic, assign) NSUInteger firingTimerCount;
+@property (nonatomic, assign) BOOL timersNeedReschedule;
+@property (nonatomic, strong) UAScheduleRunQueue *prepareQueue;
+@property (nonatomic, assign) NSUInteger preparingScheduleCount;
 @property (nonatomic, assign) UIBackgroundTaskIdentifier backgroundTaskIdentifier;
 @property (nonatomic, assign) BOOL isStarted;
 @property (nonnull, strong) NSMutableDictionary *stateConditions;
 @property (atomic, assign) BOOL paused;
 @property (nonatomic, readonly) BOOL isForegrounded;
+@property (nonnull, strong) NSCache<NSData *, id> *predicateCache;
+@property (nonnull, strong) NSCache<NSString *, UAAutomationCachedSchedule *> *scheduleCache;
+@property (nonnull, strong) NSMapTable<UAJSONPredicate *, NSMutableDictionary *> *predicateMatchKeys;
+@property (nonnull, strong) UAScheduleTriggerIndex *triggerIndex;
+@property (nonnull, strong) NSArray<UADisposable *> *memoryPressureDisposables;
+@property (nonnull, strong) UADispatcher *triggerEventDispatcher;
+@property (nonnull, strong) NSMutableArray<UAAutomationTriggerEvent *> *pendingTriggerEvents;
+@property (nonnull, strong) UAMetricHistogram *triggerEvaluationHistogram;
+@property (nonnull, strong) UAMetricCounter *triggerEventCounter;
+@property (nonnull, strong) UAFrequencyLimitManager *frequencyLimitManager;
+@property (atomic, assign) BOOL isPurging;
 
 @end
 
@@ -64,6 +152,10 @@
 - (void)dealloc {
     [self stop];
     [self.automationStore shutDown];
+
+    for (UADisposable *disposable in self.memoryPressureDisposables) {
+        [disposable dispose];
+    }
 }
 
 - (instancetype)initWithAutomationStore:(UAAutomationStore *)automationStore
@@ -71,6 +163,7 @@
                          timerScheduler:(UATimerScheduler *)timerScheduler
                      notificationCenter:(NSNotificationCenter *)notificationCenter
                              dispatcher:(UADispatcher *)dispatcher
+                 triggerEventDispatcher:(UADispatcher *)triggerEventDispatcher
                             application:(UIApplication *)application
                                    date:(UADate *)date {
     self = [super init];
@@ -81,12 +174,34 @@
         self.timerScheduler = timerScheduler;
         self.notificationCenter = notificationCenter;
         self.dispatcher = dispatcher;
+        self.triggerEventDispatcher = triggerEventDispatcher;
         self.application = application;
         self.date = date;
 
-        self.activeTimers = [NSMutableArray array];
+        self.timerQueue = [UAScheduleTimerQueue timerQueueWithTimerScheduler:timerScheduler date:date];
+        self.prepareQueue = [UAScheduleRunQueue runQueue];
         self.stateConditions = [NSMutableDictionary dictionary];
         self.paused = NO;
+        self.predicateCache = [[NSCache alloc] init];
+        self.predicateCache.countLimit = UAAutomationEnginePredicateCacheLimit;
+        self.scheduleCache = [[NSCache alloc] init];
+        self.scheduleCache.countLimit = UAAutomationEngineScheduleCacheLimit;
+
+        // Both caches are rebuilt from the store, so they are only dropped under critical pressure
+        UAMemoryPressureCoordinator *memoryPressureCoordinator = [UAMemoryPressureCoordinator shared];
+        self.memoryPressureDisposables = @[[memoryPressureCoordinator registerCache:self.predicateCache
+                                                                           priority:UAMemoryPressurePriorityHigh
+                                                                 estimatedEntrySize:UAAutomationEnginePredicateEstimatedSize],
+                                           [memoryPressureCoordinator registerCache:self.scheduleCache
+                                                                           priority:UAMemoryPressurePriorityHigh
+                                                                 estimatedEntrySize:UAAutomationEngineScheduleEstimatedSize]];
+        self.predicateMatchKeys = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                                        valueOptions:NSPointerFunctionsStrongMemory];
+        self.triggerIndex = [UAScheduleTriggerIndex triggerIndex];
+        self.pendingTriggerEvents = [NSMutableArray array];
+        self.triggerEvaluationHistogram = [[UAMetricsRegistry shared] durationHistogramWithName:UAMetricAutomationTriggerEvaluationDuration];
+        self.triggerEventCounter = [[UAMetricsRegistry shared] counterWithName:UAMetricAutomationTriggerEvents];
+        self.frequencyLimitManager = [UAFrequencyLimitManager managerWithAutomationStore:automationStore date:date];
     }
 
     return self;
@@ -97,6 +212,7 @@
                                      timerScheduler:(UATimerScheduler *)timerScheduler
                                  notificationCenter:(NSNotificationCenter *)notificationCenter
                                          dispatcher:(UADispatcher *)dispatcher
+                             triggerEventDispatcher:(UADispatcher *)triggerEventDispatcher
                                         application:(UIApplication *)application
                                                date:(UADate *)date {
 
@@ -105,6 +221,7 @@
                                                 timerScheduler:timerScheduler
                                             notificationCenter:notificationCenter
                                                     dispatcher:dispatcher
+                                        triggerEventDispatcher:triggerEventDispatcher
                                                    application:application
                                                           date:date];
 }
@@ -115,6 +232,7 @@
                                                 timerScheduler:[[UATimerScheduler alloc] init]
                                             notificationCenter:[NSNotificationCenter defaultCenter]
                                                     dispatcher:[UADispatcher mainDispatcher]
+                                        triggerEventDispatcher:[UADispatcher serialDispatcherForWorkType:UADispatcherWorkTypeProcessing]
                                                    application:[UIApplication sharedApplication]
                                                           date:[[UADate alloc] init]];
 }
@@ -122,6 +240,13 @@
 #pragma mark -
 #pragma mark Public API
 
+- (void)setDelegate:(id<UAAutomationEngineDelegate>)delegate {
+    _delegate = delegate;
+
+    // Hand off any schedules queued while there was no delegate
+    [self dispatchQueuedPrepares];
+}
+
 - (void)start {
     if (self.isStarted) {
         return;
@@ -142,6 +267,11 @@
                                     name:UARegionEventAdded
                                   object:nil];
 
+    [self.notificationCenter addObserver:self
+                                selector:@selector(regionEventsAdded:)
+                                    name:UARegionEventsAdded
+                                  object:nil];
+
     [self.notificationCenter addObserver:self
                                 selector:@selector(applicationDidTransitionToBackground)
                                     name:UAApplicationDidTransitionToBackground
@@ -153,6 +283,7 @@
                                   object:nil];
 
     [self cleanSchedules];
+    [self rebuildTriggerIndex];
     [self resetExecutingSchedules];
     [self rescheduleTimers];
     [self createStateConditions];
@@ -164,7 +295,7 @@
     [self.automationStore getSchedulesWithStates:@[@(UAScheduleStatePreparingSchedule)]
                                completionHandler:^(NSArray<UAScheduleData *> *schedules) {
         UA_STRONGIFY(self)
-        [self prepareSchedules:[self sortedScheduleDataByPriority:schedules]];
+        [self prepareSchedules:schedules];
     }];
 
     self.isStarted = YES;
@@ -212,25 +343,30 @@
 
     [self cleanSchedules];
 
-    // Try to save the schedule
-    UA_WEAKIFY(self);
-    [self.automationStore saveSchedule:schedule completionHandler:^(BOOL success) {
-        UA_STRONGIFY(self);
+    // Index the triggers before the save is queued so a concurrent rebuild can't drop them
+    @synchronized (self.triggerIndex) {
+        [self.triggerIndex addSchedules:@[schedule]];
 
-        // If saving the schedule was successful, process any compound triggers
-        if (success) {
-            [self.dispatcher dispatchAsync:^{
-                UA_STRONGIFY(self);
-                [self checkCompoundTriggerState:@[schedule]];
-            }];
-        }
+        // Try to save the schedule
+        UA_WEAKIFY(self);
+        [self.automationStore saveSchedule:schedule completionHandler:^(BOOL success) {
+            UA_STRONGIFY(self);
 
-        if (completionHandler) {
-            [self.dispatcher dispatchAsync:^{
-                completionHandler(success);
-            }];
-        }
-    }];
+            // If saving the schedule was successful, process any compound triggers
+            if (success) {
+                [self.dispatcher dispatchAsync:^{
+                    UA_STRONGIFY(self);
+                    [self checkCompoundTriggerState:@[schedule]];
+                }];
+            }
+
+            if (completionHandler) {
+                [self.dispatcher dispatchAsync:^{
+                    completionHandler(success);
+                }];
+            }
+        }];
+    }
 }
 
 - (void)scheduleMultiple:(NSArray<UASchedule *> *)schedules
@@ -246,24 +382,29 @@
         }
     }
 
-    // Try to save the schedules
-    UA_WEAKIFY(self);
-    [self.automationStore saveSchedules:schedules completionHandler:^(BOOL success) {
-        UA_STRONGIFY(self);
+    // Index the triggers before the save is queued so a concurrent rebuild can't drop them
+    @synchronized (self.triggerIndex) {
+        [self.triggerIndex addSchedules:schedules];
 
-        if (success) {
-            [self.dispatcher dispatchAsync:^{
-                UA_STRONGIFY(self);
-                [self checkCompoundTriggerState:schedules];
-            }];
-        }
+        // Try to save the schedules
+        UA_WEAKIFY(self);
+        [self.automationStore saveSchedules:schedules completionHandler:^(BOOL success) {
+            UA_STRONGIFY(self);
 
-        if (completionHandler) {
-            [self.dispatcher dispatchAsync:^{
-                completionHandler(success);
-            }];
-        }
-    }];
+            if (success) {
+                [self.dispatcher dispatchAsync:^{
+                    UA_STRONGIFY(self);
+                    [self checkCompoundTriggerState:schedules];
+                }];
+            }
+
+            if (completionHandler) {
+                [self.dispatcher dispatchAsync:^{
+                    completionHandler(success);
+                }];
+            }
+        }];
+    }
 }
 
 - (void)cancelScheduleWithID:(NSString *)identifier completionHandler:(nullable void (^)(BOOL))completionHandler {
@@ -278,29 +419,60 @@
 - (void)cancelSchedulesWithGroup:(NSString *)group
                             type:(UAScheduleType)scheduleType
                completionHandler:(void (^)(BOOL))completionHandler {
-    UA_WEAKIFY(self)
-    [self.automationStore getSchedules:group type:scheduleType completionHandler:^(NSArray<UAScheduleData *> * _Nonnull scheduleDatas) {
-        UA_STRONGIFY(self)
-        [self handleCancelledSchedules:scheduleDatas completionHandler:completionHandler];
-    }];
+    [self cancelSchedulesWithGroup:group type:@(scheduleType) completionHandler:completionHandler];
 }
 
 - (void)cancelSchedulesWithGroup:(NSString *)group
                completionHandler:(nullable void (^)(BOOL))completionHandler {
-    UA_WEAKIFY(self)
-    [self.automationStore getSchedules:group completionHandler:^(NSArray<UAScheduleData *> * _Nonnull scheduleDatas) {
-        UA_STRONGIFY(self)
-        [self handleCancelledSchedules:scheduleDatas completionHandler:completionHandler];
-    }];
+    [self cancelSchedulesWithGroup:group type:nil completionHandler:completionHandler];
 }
 
 - (void)cancelSchedulesWithType:(UAScheduleType)scheduleType
               completionHandler:(nullable void (^)(BOOL))completionHandler {
+    [self cancelSchedulesWithGroup:nil type:@(scheduleType) completionHandler:completionHandler];
+}
+
+/**
+ * Cancels the schedules as a set. The schedules are deleted in a single batch, then their timers are
+ * cancelled in one pass and the delegate is notified once.
+ *
+ * @param group The schedule group, or nil to match any group.
+ * @param scheduleType The schedule type, or nil to match any type.
+ * @param completionHandler A completion handler called with the result.
+ */
+- (void)cancelSchedulesWithGroup:(nullable NSString *)group
+                            type:(nullable NSNumber *)scheduleType
+               completionHandler:(nullable void (^)(BOOL))completionHandler {
+    NSMutableArray<UASchedule *> *cancelled = [NSMutableArray array];
+
+    // Only load the schedules if the delegate is notified about them
+    id<UAAutomationEngineDelegate> delegate = self.delegate;
+    BOOL notifiesDelegate = [delegate respondsToSelector:@selector(onSchedulesCancelled:)] ||
+                            [delegate respondsToSelector:@selector(onScheduleCancelled:)];
+
     UA_WEAKIFY(self)
-    [self.automationStore getSchedulesWithType:scheduleType
-                             completionHandler:^(NSArray<UAScheduleData *> *scheduleDatas) {
+    void (^willDelete)(NSArray<UAScheduleData *> *) = ^(NSArray<UAScheduleData *> *scheduleDatas) {
+        UA_STRONGIFY(self)
+        for (UAScheduleData *scheduleData in scheduleDatas) {
+            UASchedule *schedule = [self scheduleFromData:scheduleData];
+            if (schedule) {
+                [cancelled addObject:schedule];
+            }
+        }
+    };
+
+    [self.automationStore deleteSchedulesWithGroup:group
+                                              type:scheduleType
+                                        willDelete:notifiesDelegate ? willDelete : nil
+                                 completionHandler:^(NSSet<NSString *> *identifiers) {
         UA_STRONGIFY(self)
-        [self handleCancelledSchedules:scheduleDatas completionHandler:completionHandler];
+        [self schedulesCancelled:cancelled identifiers:identifiers];
+
+        if (completionHandler) {
+            [self.dispatcher dispatchAsync:^{
+                completionHandler(identifiers.count > 0);
+            }];
+        }
     }];
 }
 
@@ -411,33 +583,10 @@
 
         UASchedule *schedule = nil;
         if (scheduleData) {
-            [UAAutomationEngine applyEdits:edits toData:scheduleData];
-            schedule = [self scheduleFromData:scheduleData];
-
-            BOOL overLimit = [scheduleData isOverLimit];
-            BOOL isExpired = [scheduleData isExpired];
-
-            // Check if the schedule needs to be rehabilitated or finished due to the edits
-            if ([scheduleData.executionState unsignedIntegerValue] == UAScheduleStateFinished && !overLimit && !isExpired) {
-                NSDate *finishDate = scheduleData.executionStateChangeDate;
-                scheduleData.executionState = @(UAScheduleStateIdle);
-
-                // Handle any state changes that might have been missed while the schedule was finished
-                if (schedule) {
-                    UA_WEAKIFY(self);
-                    [self.dispatcher dispatchAsync:^{
-                        UA_STRONGIFY(self);
-                        [self checkCompoundTriggerState:@[schedule] forStateNewerThanDate:finishDate];
-                    }];
-                }
-            } else if ([scheduleData.executionState unsignedIntegerValue] != UAScheduleStateFinished && (overLimit || isExpired)) {
-                if (overLimit) {
-                    [self notifyDelegateOnScheduleLimitReached:schedule];
-                }
-                if (isExpired) {
-                    [self notifyDelegateOnScheduleExpired:schedule];
-                }
-                [self finishSchedule:scheduleData];
+            NSMutableArray<void (^)(void)> *followUps = [NSMutableArray array];
+            schedule = [self applyEdits:edits toScheduleData:scheduleData followUps:followUps];
+            for (void (^followUp)(void) in followUps) {
+                followUp();
             }
         }
 
@@ -449,17 +598,136 @@
     }];
 }
 
+- (void)updateSchedulesWithEdits:(NSDictionary<NSString *, UAScheduleEdits *> *)edits
+                    newSchedules:(NSArray<UASchedule *> *)schedules
+               completionHandler:(void (^)(BOOL))completionHandler {
+    for (UASchedule *schedule in schedules) {
+        if (!schedule.isValid) {
+            if (completionHandler) {
+                [self.dispatcher dispatchAsync:^{
+                    completionHandler(NO);
+                }];
+            }
+            return;
+        }
+    }
+
+    [self cleanSchedules];
+
+    // Delegate callbacks and compound trigger checks only run once the update is saved
+    NSMutableArray<void (^)(void)> *followUps = [NSMutableArray array];
+
+    // Index the triggers before the save is queued so a concurrent rebuild can't drop them
+    @synchronized (self.triggerIndex) {
+        [self.triggerIndex addSchedules:schedules];
+
+        UA_WEAKIFY(self);
+        [self.automationStore updateSchedulesWithIDs:edits.allKeys editBlock:^(NSArray<UAScheduleData *> *scheduleDatas) {
+            UA_STRONGIFY(self);
+            for (UAScheduleData *scheduleData in scheduleDatas) {
+                [self applyEdits:edits[scheduleData.identifier] toScheduleData:scheduleData followUps:followUps];
+            }
+        } newSchedules:schedules completionHandler:^(BOOL saved, NSArray<UASchedule *> *savedSchedules) {
+            UA_STRONGIFY(self);
+
+            if (saved) {
+                for (void (^followUp)(void) in followUps) {
+                    followUp();
+                }
+
+                if (savedSchedules.count) {
+                    [self.dispatcher dispatchAsync:^{
+                        UA_STRONGIFY(self);
+                        [self checkCompoundTriggerState:savedSchedules];
+                    }];
+                }
+            }
+
+            // Edits are kept even if some of the new schedules are over the limit
+            BOOL success = saved && savedSchedules.count == schedules.count;
+            if (completionHandler) {
+                [self.dispatcher dispatchAsync:^{
+                    completionHandler(success);
+                }];
+            }
+        }];
+    }
+}
+
+- (void)updateFrequencyConstraints:(NSArray<UAFrequencyConstraint *> *)constraints {
+    [self.frequencyLimitManager updateConstraints:constraints];
+}
+
 #pragma mark -
 #pragma mark Private
 
+/**
+ * Applies edits to the schedule data. Schedules that are no longer over their limit or expired are
+ * rehabilitated, schedules that become over their limit or expired are finished.
+ *
+ * Must be called on the store's context. Anything that should only happen once the edits are saved
+ * is added to the follow ups.
+ *
+ * @param edits The edits.
+ * @param scheduleData The schedule data.
+ * @param followUps The follow ups to run once the edits are saved.
+ * @return The edited schedule, or `nil` if the schedule data is invalid.
+ */
+- (nullable UASchedule *)applyEdits:(UAScheduleEdits *)edits
+                     toScheduleData:(UAScheduleData *)scheduleData
+                          followUps:(NSMutableArray<void (^)(void)> *)followUps {
+    [UAAutomationEngine applyEdits:edits toData:scheduleData];
+
+    // Decode the edited schedule so the cache holds the new version
+    if (scheduleData.identifier) {
+        [self.scheduleCache removeObjectForKey:scheduleData.identifier];
+    }
+    UASchedule *schedule = [self scheduleFromData:scheduleData];
+
+    BOOL overLimit = [scheduleData isOverLimit];
+    BOOL isExpired = [scheduleData isExpired];
+
+    // Check if the schedule needs to be rehabilitated or finished due to the edits
+    if ([scheduleData.executionState unsignedIntegerValue] == UAScheduleStateFinished && !overLimit && !isExpired) {
+        NSDate *finishDate = scheduleData.executionStateChangeDate;
+        scheduleData.executionState = @(UAScheduleStateIdle);
+
+        // Handle any state changes that might have been missed while the schedule was finished
+        if (schedule) {
+            UA_WEAKIFY(self);
+            [followUps addObject:^{
+                [self.dispatcher dispatchAsync:^{
+                    UA_STRONGIFY(self);
+                    [self checkCompoundTriggerState:@[schedule] forStateNewerThanDate:finishDate];
+                }];
+            }];
+        }
+    } else if ([scheduleData.executionState unsignedIntegerValue] != UAScheduleStateFinished && (overLimit || isExpired)) {
+        UA_WEAKIFY(self);
+        [followUps addObject:^{
+            UA_STRONGIFY(self);
+            if (overLimit) {
+                [self notifyDelegateOnScheduleLimitReached:schedule];
+            }
+            if (isExpired) {
+                [self notifyDelegateOnScheduleExpired:schedule];
+            }
+        }];
+        [self finishSchedule:scheduleData];
+    }
+
+    return schedule;
+}
+
 - (void)handleCancelledSchedules:(NSArray<UAScheduleData *> *)scheduleDatas
                completionHandler:(nullable void (^)(BOOL))completionHandler {
 
     NSMutableSet *identifiers = [NSMutableSet set];
+    NSMutableArray<UASchedule *> *cancelled = [NSMutableArray array];
     for (UAScheduleData *scheduleData in scheduleDatas) {
         UASchedule *schedule = [self scheduleFromData:scheduleData];
         if (schedule) {
-            [self notifyDelegateOnScheduleCancelled:schedule];
+            [cancelled addObject:schedule];
             [identifiers addObject:scheduleData.identifier];
             [scheduleData.managedObjectContext deleteObject:scheduleData];
         }
@@ -471,7 +739,48 @@
         }];
     }
 
+    [self schedulesCancelled:cancelled identifiers:identifiers];
+}
+
+/**
+ * Cleans up after deleted schedules: drops them from the cache, cancels their timers, notifies the
+ * delegate and rebuilds the trigger index.
+ *
+ * @param schedules The cancelled schedules to notify the delegate about.
+ * @param identifiers The identifiers of all the deleted schedules.
+ */
+- (void)schedulesCancelled:(NSArray<UASchedule *> *)schedules identifiers:(NSSet<NSString *> *)identifiers {
+    for (NSString *identifier in identifiers) {
+        [self.scheduleCache removeObjectForKey:identifier];
+    }
+
+    [self notifyDelegateOnSchedulesCancelled:schedules];
     [self cancelTimersWithIdentifiers:identifiers];
+
+    if (identifiers.count) {
+        [self rebuildTriggerIndex];
+    }
+}
+
+/**
+ * Rebuilds the trigger index from the store to drop triggers of removed schedules.
+ */
+- (void)rebuildTriggerIndex {
+    @synchronized (self.triggerIndex) {
+        NSUInteger rebuildID = [self.triggerIndex beginRebuild];
+
+        UA_WEAKIFY(self)
+        [self.automationStore getTriggerPredicates:^(NSArray<NSDictionary *> *triggerPredicates) {
+            UA_STRONGIFY(self)
+            UAScheduleTriggerIndex *index = [UAScheduleTriggerIndex triggerIndex];
+            for (NSDictionary *trigger in triggerPredicates) {
+                [index addTriggerWithType:(UAScheduleTriggerType)[trigger[@"type"] integerValue]
+                                predicate:[self predicateForData:trigger[@"predicateData"]]];
+            }
+
+            [self.triggerIndex finishRebuild:rebuildID withIndex:index];
+        }];
+    }
 }
 
 - (BOOL)isForegrounded {
@@ -489,22 +798,40 @@
     }];
 
     // Finished schedules
-    [self.automationStore getSchedulesWithStates:@[@(UAScheduleStateFinished)] completionHandler:^(NSArray<UAScheduleData *> *schedulesData) {
-        for (UAScheduleData *scheduleData in schedulesData) {
-            NSDate *finishDate;
+    [self purgeFinishedSchedules];
+}
 
-            // If grace period is unset - use the executionStateChangeDate as finishDate to avoid unnecessarily keeping schedules around until distant future.
-            if (scheduleData.editGracePeriod == 0) {
-                finishDate = scheduleData.executionStateChangeDate;
-            } else {
-                // If the grace period is set - follow the end date behavior outlined in the specification.
-                finishDate = [scheduleData.end dateByAddingTimeInterval:[scheduleData.editGracePeriod doubleValue]];
-            }
+/**
+ * Deletes finished schedules past their purge date. Schedules are deleted in bounded slices,
+ * each queued behind any store work that arrived during the previous one.
+ */
+- (void)purgeFinishedSchedules {
+    @synchronized (self) {
+        if (self.isPurging) {
+            return;
+        }
+        self.isPurging = YES;
+    }
+
+    [self purgeFinishedScheduleSlice];
+}
 
-            if ([finishDate compare:self.date.now] == NSOrderedAscending) {
-                [scheduleData.managedObjectContext deleteObject:scheduleData];
+- (void)purgeFinishedScheduleSlice {
+    UA_WEAKIFY(self)
+    [self.automationStore deletePurgeableSchedulesWithLimit:UAAutomationEnginePurgeSliceSize completionHandler:^(NSUInteger deletedCount) {
+        UA_STRONGIFY(self)
+        if (deletedCount) {
+            UA_LTRACE(@"Deleted %lu finished schedules", (unsigned long)deletedCount);
+        }
+
+        if (deletedCount < UAAutomationEnginePurgeSliceSize) {
+            @synchronized (self) {
+                self.isPurging = NO;
             }
+            return;
         }
+
+        [self purgeFinishedScheduleSlice];
     }];
 }
 
@@ -512,8 +839,18 @@
 #pragma mark Event listeners
 
 - (void)applicationDidTransitionToForeground {
-    if (!self.activeTimers) {
-        [self rescheduleTimers];
+    // Only rescan the store if timers were dropped while in the background
+    if (self.timersNeedReschedule) {
+        UA_WEAKIFY(self)
+        [[UAForegroundWorkScheduler shared] scheduleWorkWithName:@"com.urbanairship.automation.reschedule_timers"
+                                                        priority:UAForegroundWorkPriorityHigh
+                                                      dispatcher:self.dispatcher
+                                                           block:^{
+            UA_STRONGIFY(self)
+            if (self.timersNeedReschedule) {
+                [self rescheduleTimers];
+            }
+        }];
     }
 
     // Update any dependent foreground triggers
@@ -530,49 +867,80 @@
 - (void)applicationDidTransitionToBackground {
     [self updateTriggersWithType:UAScheduleTriggerAppBackground argument:nil incrementAmount:1.0];
     [self scheduleConditionsChanged];
+    [self.automationStore savePendingTriggerProgress];
 }
 
 -(void)customEventAdded:(NSNotification *)notification {
     UACustomEvent *event = notification.userInfo[UAEventKey];
 
-    [self updateTriggersWithType:UAScheduleTriggerCustomEventCount
-                        argument:event.payload
-                 incrementAmount:1.0];
+    [self enqueueTriggerEventWithType:UAScheduleTriggerCustomEventCount
+                             argument:event.payload
+                      incrementAmount:1.0];
 
     if (event.eventValue) {
-        [self updateTriggersWithType:UAScheduleTriggerCustomEventValue
-                            argument:event.payload
-                     incrementAmount:[event.eventValue doubleValue]];
+        [self enqueueTriggerEventWithType:UAScheduleTriggerCustomEventValue
+                                 argument:event.payload
+                          incrementAmount:[event.eventValue doubleValue]];
     }
 }
 
 -(void)regionEventAdded:(NSNotification *)notification {
     UARegionEvent *event = notification.userInfo[UAEventKey];
+    if (event) {
+        [self processRegionEvents:@[event]];
+    }
+}
 
-    UAScheduleTriggerType triggerType;
-
-    if (event.boundaryEvent == UABoundaryEventEnter) {
-        triggerType = UAScheduleTriggerRegionEnter;
-        self.currentRegion = event.regionID;
-    } else {
-        triggerType = UAScheduleTriggerRegionExit;
-        self.currentRegion = nil;
+-(void)regionEventsAdded:(NSNotification *)notification {
+    NSArray<UARegionEvent *> *events = notification.userInfo[UAEventsKey];
+    if (events.count) {
+        [self processRegionEvents:events];
     }
+}
 
-    [self updateTriggersWithType:triggerType argument:event.payload incrementAmount:1.0];
+/**
+ * Applies region events in order. The trigger events are buffered for a shared drain, and
+ * schedule conditions are only checked once for the region the batch ends in.
+ */
+- (void)processRegionEvents:(NSArray<UARegionEvent *> *)events {
+    for (UARegionEvent *event in events) {
+        UAScheduleTriggerType triggerType;
 
-    [self scheduleConditionsChanged];
+        if (event.boundaryEvent == UABoundaryEventEnter) {
+            triggerType = UAScheduleTriggerRegionEnter;
+            self.currentRegion = event.regionID;
+        } else {
+            triggerType = UAScheduleTriggerRegionExit;
+            self.currentRegion = nil;
+        }
+
+        [self enqueueTriggerEventWithType:triggerType argument:event.payload incrementAmount:1.0];
+    }
+
+    // Leaving a region can't satisfy a region condition, entering one only wakes schedules waiting on it
+    NSString *regionID = self.currentRegion;
+    if (regionID) {
+        [self scheduleConditionsChangedMatching:^BOOL(UAScheduleDelayData *delay) {
+            return [delay.regionID isEqualToString:regionID];
+        }];
+    }
 }
 
 -(void)screenTracked:(NSNotification *)notification {
     NSString *screenName = notification.userInfo[UAScreenKey];
 
     if (screenName) {
-        [self updateTriggersWithType:UAScheduleTriggerScreen argument:screenName incrementAmount:1.0];
+        [self enqueueTriggerEventWithType:UAScheduleTriggerScreen argument:screenName incrementAmount:1.0];
     }
 
     self.currentScreen = screenName;
-    [self scheduleConditionsChanged];
+
+    // Only schedules waiting on this screen can become ready
+    if (screenName) {
+        [self scheduleConditionsChangedMatching:^BOOL(UAScheduleDelayData *delay) {
+            return [[UAAutomationEngine screensFromDelayData:delay] containsObject:screenName];
+        }];
+    }
 }
 
 #pragma mark -
@@ -588,16 +956,84 @@
     return [schedules sortedArrayUsingDescriptors:@[ascending]];
 }
 
+/**
+ * Buffers a tracked event and schedules a drain on the trigger event dispatcher, so the
+ * posting thread only pays for the enqueue.
+ */
+- (void)enqueueTriggerEventWithType:(UAScheduleTriggerType)triggerType argument:(id)argument incrementAmount:(double)amount {
+    UAAutomationTriggerEvent *event = [UAAutomationTriggerEvent eventWithType:triggerType argument:argument incrementAmount:amount];
+
+    BOOL drainNeeded;
+    @synchronized (self.pendingTriggerEvents) {
+        drainNeeded = self.pendingTriggerEvents.count == 0;
+        [self.pendingTriggerEvents addObject:event];
+    }
+
+    if (drainNeeded) {
+        UA_WEAKIFY(self)
+        [self.triggerEventDispatcher dispatchAsync:^{
+            UA_STRONGIFY(self)
+            [self drainTriggerEvents];
+        }];
+    }
+}
+
+/**
+ * Applies all buffered events, with a single trigger lookup per trigger type.
+ */
+- (void)drainTriggerEvents {
+    NSArray<UAAutomationTriggerEvent *> *events;
+    @synchronized (self.pendingTriggerEvents) {
+        events = [self.pendingTriggerEvents copy];
+        [self.pendingTriggerEvents removeAllObjects];
+    }
+
+    NSMutableArray<NSNumber *> *types = [NSMutableArray array];
+    NSMutableDictionary<NSNumber *, NSMutableArray<UAAutomationTriggerEvent *> *> *eventsByType = [NSMutableDictionary dictionary];
+    for (UAAutomationTriggerEvent *event in events) {
+        NSMutableArray *typeEvents = eventsByType[@(event.type)];
+        if (!typeEvents) {
+            typeEvents = [NSMutableArray array];
+            eventsByType[@(event.type)] = typeEvents;
+            [types addObject:@(event.type)];
+        }
+        [typeEvents addObject:event];
+    }
+
+    for (NSNumber *type in types) {
+        [self updateTriggersWithScheduleID:nil type:type.integerValue events:eventsByType[type]];
+    }
+}
+
 - (void)updateTriggersWithScheduleID:(NSString *)scheduleID
                                 type:(UAScheduleTriggerType)triggerType
                             argument:(id)argument
                      incrementAmount:(double)amount {
+    UAAutomationTriggerEvent *event = [UAAutomationTriggerEvent eventWithType:triggerType argument:argument incrementAmount:amount];
+    [self updateTriggersWithScheduleID:scheduleID type:triggerType events:@[event]];
+}
+
+- (void)updateTriggersWithScheduleID:(NSString *)scheduleID
+                                type:(UAScheduleTriggerType)triggerType
+                              events:(NSArray<UAAutomationTriggerEvent *> *)events {
 
     if (self.paused) {
         return;
     }
 
-    UA_LDEBUG(@"Updating triggers with type: %ld", (long)triggerType);
+    NSMutableArray<UAAutomationTriggerEvent *> *candidateEvents = [NSMutableArray array];
+    for (UAAutomationTriggerEvent *event in events) {
+        if ([self.triggerIndex hasCandidatesForType:triggerType argument:event.argument]) {
+            [candidateEvents addObject:event];
+        }
+    }
+
+    if (!candidateEvents.count) {
+        UA_LTRACE(@"No triggers for type: %ld", (long)triggerType);
+        return;
+    }
+
+    UA_LDEBUG(@"Updating triggers with type: %ld events: %ld", (long)triggerType, (unsigned long)candidateEvents.count);
 
     NSDate *start = self.date.now;
 
@@ -609,42 +1045,97 @@
         // Capture what schedules need to be cancelled and executed in sets so we do not double process any schedules
         NSMutableSet *schedulesToCancel = [NSMutableSet set];
         NSMutableSet *schedulesToExecute = [NSMutableSet set];
+        NSMutableDictionary<NSString *, UAScheduleTriggerData *> *nearlyMetTriggers = [NSMutableDictionary dictionary];
+
+        // Bucket the triggers by match key so each event only visits the triggers that can match it
+        NSMutableArray<UAScheduleTriggerData *> *unkeyedTriggers = [NSMutableArray array];
+        NSDictionary<NSString *, NSArray<UAScheduleTriggerData *> *> *keyedTriggers = [self triggersByMatchKey:triggers
+                                                                                                           type:triggerType
+                                                                                                unkeyedTriggers:unkeyedTriggers];
+
+        // Apply events in the order they were tracked
+        for (UAAutomationTriggerEvent *event in candidateEvents) {
+            id argument = event.argument;
+            NSString *matchKey = [UAScheduleTriggerIndex matchKeyForType:triggerType argument:argument];
+
+            NSArray<UAScheduleTriggerData *> *eventTriggers = triggers;
+            if (matchKey) {
+                eventTriggers = [unkeyedTriggers arrayByAddingObjectsFromArray:keyedTriggers[matchKey] ?: @[]];
+            }
+
+            // Triggers sharing a predicate share the compiled instance, so each distinct predicate
+            // is evaluated at most once per event
+            NSMapTable<UAJSONPredicate *, NSNumber *> *results = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsObjectPointerPersonality
+                                                                                      valueOptions:NSPointerFunctionsStrongMemory];
 
-        // Process triggers
-        for (UAScheduleTriggerData *trigger in triggers) {
-            UAJSONPredicate *predicate = [UAAutomationEngine predicateFromData:trigger.predicateData];
-            if (predicate && argument) {
-                if (![predicate evaluateObject:argument]) {
+            // Triggers that fired for an earlier event in the batch are no longer active
+            NSSet *executed = [schedulesToExecute copy];
+            NSSet *cancelled = [schedulesToCancel copy];
+
+            for (UAScheduleTriggerData *trigger in eventTriggers) {
+                if (trigger.delay ? [cancelled containsObject:trigger.delay.schedule] : [executed containsObject:trigger.schedule]) {
                     continue;
                 }
-            }
 
-            trigger.goalProgress = @([trigger.goalProgress doubleValue] + amount);
-            if ([trigger.goalProgress compare:trigger.goal] != NSOrderedAscending) {
-                trigger.goalProgress = 0;
+                UAJSONPredicate *predicate = [self predicateForTriggerData:trigger];
+                if (predicate && argument) {
+                    if (![self evaluatePredicate:predicate argument:argument results:results]) {
+                        continue;
+                    }
+                }
 
-                // A delay associated with a trigger indicates its a cancellation trigger
-                if (trigger.delay) {
-                    [schedulesToCancel addObject:trigger.delay.schedule];
-                    continue;
+                double previousProgress = [trigger.goalProgress doubleValue];
+                trigger.goalProgress = @(previousProgress + event.incrementAmount);
+
+                // Only report the trigger when it enters the last increment, not on every event after
+                double nearlyMetProgress = [trigger.goal doubleValue] - 1;
+                if (!trigger.delay && trigger.schedule.identifier && previousProgress < nearlyMetProgress &&
+                    [trigger.goalProgress doubleValue] >= nearlyMetProgress) {
+                    nearlyMetTriggers[trigger.schedule.identifier] = trigger;
                 }
 
-                // Store trigger context
-                trigger.schedule.triggerContext = [UAScheduleTriggerContext
-                                                   triggerContextWithTrigger:[UAAutomationEngine triggerFromData:trigger]
+                if ([trigger.goalProgress compare:trigger.goal] != NSOrderedAscending) {
+                    trigger.goalProgress = 0;
+
+                    // A delay associated with a trigger indicates its a cancellation trigger
+                    if (trigger.delay) {
+                        [schedulesToCancel addObject:trigger.delay.schedule];
+                        continue;
+                    }
 
-                                                   event:argument];
+                    // Store trigger context
+                    trigger.schedule.triggerContext = [UAScheduleTriggerContext
+                                                       triggerContextWithTrigger:[UAAutomationEngine triggerFromData:trigger]
 
-                // Normal execution trigger. Only reexecute schedules that are not currently pending
-                if (trigger.schedule) {
-                    [schedulesToExecute addObject:trigger.schedule];
+                                                       event:argument];
+
+                    // Normal execution trigger. Only reexecute schedules that are not currently pending
+                    if (trigger.schedule) {
+                        [schedulesToExecute addObject:trigger.schedule];
+                    }
                 }
             }
         }
 
+        // Start the triggered schedules' timelines with the time spent evaluating triggers
+        NSTimeInterval triggerTime = -[start timeIntervalSinceDate:self.date.now];
+        [self.triggerEvaluationHistogram recordValue:triggerTime];
+        [self.triggerEventCounter incrementBy:candidateEvents.count];
+
+        UAScheduleTimelineRecorder *timelineRecorder = [UAScheduleTimelineRecorder shared];
+        for (UAScheduleData *scheduleData in schedulesToExecute) {
+            [timelineRecorder beginTimelineWithScheduleID:scheduleData.identifier];
+            [timelineRecorder recordStage:UAScheduleTimelineStageTrigger
+                               scheduleID:scheduleData.identifier
+                                 duration:triggerTime
+                                   result:nil];
+        }
+
         // Process all the schedules to execute
         [self processTriggeredSchedules:[schedulesToExecute allObjects]];
 
+        [self notifyNearlyMetTriggers:nearlyMetTriggers executedSchedules:schedulesToExecute];
+
         // Process all the schedules to cancel
         for (UAScheduleData *scheduleData in schedulesToCancel) {
             UA_LTRACE(@"Pending automation schedule %@ execution canceled", scheduleData.identifier);
@@ -662,84 +1153,227 @@
     }];
 }
 
+/**
+ * Notifies the delegate of schedules whose triggers are one increment away from firing.
+ */
+- (void)notifyNearlyMetTriggers:(NSDictionary<NSString *, UAScheduleTriggerData *> *)triggers
+              executedSchedules:(NSSet<UAScheduleData *> *)executedSchedules {
+    id<UAAutomationEngineDelegate> delegate = self.delegate;
+    if (!triggers.count || ![delegate respondsToSelector:@selector(onScheduleTriggerNearlyMet:triggerContext:)]) {
+        return;
+    }
+
+    for (UAScheduleTriggerData *trigger in triggers.allValues) {
+        UAScheduleData *scheduleData = trigger.schedule;
+        if ([executedSchedules containsObject:scheduleData] || [scheduleData.executionState unsignedIntegerValue] != UAScheduleStateIdle) {
+            continue;
+        }
+
+        UASchedule *schedule = [self scheduleFromData:scheduleData];
+        if (!schedule) {
+            continue;
+        }
+
+        UAScheduleTriggerContext *context = [UAScheduleTriggerContext triggerContextWithTrigger:[UAAutomationEngine triggerFromData:trigger]
+                                                                                          event:nil];
+        [delegate onScheduleTriggerNearlyMet:schedule triggerContext:context];
+    }
+}
+
+/**
+ * Evaluates a trigger predicate for an event. Results are memoized for the event.
+ */
+- (BOOL)evaluatePredicate:(UAJSONPredicate *)predicate
+                 argument:(id)argument
+                  results:(NSMapTable<UAJSONPredicate *, NSNumber *> *)results {
+    NSNumber *result = [results objectForKey:predicate];
+    if (result) {
+        return [result boolValue];
+    }
+
+    BOOL matches = [predicate evaluateObject:argument];
+    [results setObject:@(matches) forKey:predicate];
+    return matches;
+}
+
+/**
+ * Groups triggers by the match keys their predicates require, so an event with a match key
+ * only needs to visit the triggers in its bucket and the triggers that may match any key.
+ *
+ * @param triggers The triggers.
+ * @param type The trigger type.
+ * @param unkeyedTriggers Filled with the triggers that may match any key.
+ * @return The keyed triggers by lowercased match key.
+ */
+- (NSDictionary<NSString *, NSArray<UAScheduleTriggerData *> *> *)triggersByMatchKey:(NSArray<UAScheduleTriggerData *> *)triggers
+                                                                                type:(UAScheduleTriggerType)type
+                                                                     unkeyedTriggers:(NSMutableArray<UAScheduleTriggerData *> *)unkeyedTriggers {
+    NSMutableDictionary<NSString *, NSMutableArray<UAScheduleTriggerData *> *> *keyedTriggers = [NSMutableDictionary dictionary];
+
+    for (UAScheduleTriggerData *trigger in triggers) {
+        UAJSONPredicate *predicate = [self predicateForTriggerData:trigger];
+        NSSet<NSString *> *keys = predicate ? [self matchKeysForPredicate:predicate type:type] : nil;
+        if (!keys) {
+            [unkeyedTriggers addObject:trigger];
+            continue;
+        }
+
+        for (NSString *key in keys) {
+            NSMutableArray *bucket = keyedTriggers[key];
+            if (!bucket) {
+                bucket = [NSMutableArray array];
+                keyedTriggers[key] = bucket;
+            }
+            [bucket addObject:trigger];
+        }
+    }
+
+    return keyedTriggers;
+}
+
+/**
+ * Returns the match keys the predicate requires for a trigger type, extracted once per
+ * compiled predicate.
+ */
+- (nullable NSSet<NSString *> *)matchKeysForPredicate:(UAJSONPredicate *)predicate type:(UAScheduleTriggerType)type {
+    @synchronized (self.predicateMatchKeys) {
+        NSMutableDictionary *keysByType = [self.predicateMatchKeys objectForKey:predicate];
+        if (!keysByType) {
+            keysByType = [NSMutableDictionary dictionary];
+            [self.predicateMatchKeys setObject:keysByType forKey:predicate];
+        }
+
+        id keys = keysByType[@(type)];
+        if (!keys) {
+            keys = [UAScheduleTriggerIndex matchKeysForType:type predicate:predicate] ?: [NSNull null];
+            keysByType[@(type)] = keys;
+        }
+
+        return [keys isKindOfClass:[NSSet class]] ? keys : nil;
+    }
+}
+
+/**
+ * Returns the compiled predicate for the trigger. Predicates are cached by their serialized
+ * data, so an edit that rewrites the data misses the cache instead of needing an explicit
+ * invalidation, and triggers sharing a predicate share the compiled matcher tree.
+ */
+- (nullable UAJSONPredicate *)predicateForTriggerData:(UAScheduleTriggerData *)trigger {
+    return [self predicateForData:trigger.predicateData];
+}
+
+- (nullable UAJSONPredicate *)predicateForData:(nullable NSData *)data {
+    if (!data) {
+        return nil;
+    }
+
+    id cached = [self.predicateCache objectForKey:data];
+    if (!cached) {
+        cached = [UAAutomationEngine predicateFromData:data] ?: [NSNull null];
+        [self.predicateCache setObject:cached forKey:data];
+    }
+
+    return [cached isKindOfClass:[UAJSONPredicate class]] ? cached : nil;
+}
+
 - (void)updateTriggersWithType:(UAScheduleTriggerType)triggerType argument:(id)argument incrementAmount:(double)amount {
     [self updateTriggersWithScheduleID:nil type:triggerType argument:argument incrementAmount:amount];
 }
 
 /**
- * Starts a timer for the schedule.
+ * Starts a delay timer for the schedule.
  *
  * @param scheduleData The schedule's data.
+ * @param timeInterval The delay.
  */
+- (void)startDelayTimerForSchedule:(UAScheduleData *)scheduleData timeInterval:(NSTimeInterval)timeInterval {
+    UA_WEAKIFY(self);
+    [self startTimerForSchedule:scheduleData timeInterval:timeInterval block:^(NSString *identifier) {
+        UA_STRONGIFY(self);
+        [self delayTimerFired:identifier];
+    }];
+}
 
+/**
+ * Starts an interval timer for the schedule.
+ *
+ * @param scheduleData The schedule's data.
+ * @param timeInterval The remaining interval.
+ */
+- (void)startIntervalTimerForSchedule:(UAScheduleData *)scheduleData timeInterval:(NSTimeInterval)timeInterval {
+    UA_WEAKIFY(self);
+    [self startTimerForSchedule:scheduleData timeInterval:timeInterval block:^(NSString *identifier) {
+        UA_STRONGIFY(self);
+        [self intervalTimerFired:identifier];
+    }];
+}
+
+/**
+ * Starts a timer for the schedule.
+ *
+ * @param scheduleData The schedule's data.
+ * @param timeInterval The time interval.
+ * @param block The block called on the main queue when the timer fires.
+ */
 - (void)startTimerForSchedule:(UAScheduleData *)scheduleData
                  timeInterval:(NSTimeInterval)timeInterval
-                     selector:(SEL)selector {
+                        block:(void (^)(NSString *))block {
 
-    NSMutableDictionary *userInfo = [NSMutableDictionary dictionary];
-    [userInfo setValue:scheduleData.identifier forKey:@"identifier"];
+    NSString *identifier = scheduleData.identifier;
 
     UA_WEAKIFY(self);
     [self.dispatcher dispatchAsync:^{
         UA_STRONGIFY(self);
 
-        NSTimer *timer = [NSTimer timerWithTimeInterval:timeInterval <= 0 ? .1 : timeInterval
-                                                 target:self
-                                               selector:selector
-                                               userInfo:userInfo
-                                                repeats:NO];
-
         // Make sure we have a background task identifier before starting the timer
         if (self.backgroundTaskIdentifier == UIBackgroundTaskInvalid) {
             self.backgroundTaskIdentifier = [self.application beginBackgroundTaskWithExpirationHandler:^{
                 UA_LTRACE(@"Automation background task expired. Cancelling timer alarm.");
                 [self cancelTimers];
+                self.timersNeedReschedule = YES;
             }];
 
             // No background time. The timer will be rescheduled the next time the app is active
             if (self.backgroundTaskIdentifier == UIBackgroundTaskInvalid) {
                 UA_LTRACE(@"Unable to request background task for automation timer.");
+                self.timersNeedReschedule = YES;
                 return;
             }
         }
 
-        UA_LTRACE(@"Starting automation timer for %f seconds with user info %@", timeInterval, timer.userInfo);
-        [self.timerScheduler scheduleTimer:timer];
-        [self.activeTimers addObject:timer];
+        UA_LTRACE(@"Starting automation timer for %f seconds for schedule %@", timeInterval, identifier);
+        [self.timerQueue addTimerWithIdentifier:identifier timeInterval:timeInterval block:^(NSString *firedIdentifier) {
+            UA_STRONGIFY(self);
+            self.firingTimerCount++;
+            block(firedIdentifier);
+        }];
     }];
 }
 
 /**
- * Finishes the timer.
- *
- * @param timer The timer to finish.
+ * Finishes a fired timer.
  */
-- (void)finishTimer:(NSTimer *)timer {
+- (void)finishTimer {
     [self.dispatcher dispatchAsync:^{
-        [timer invalidate];
-        [self.activeTimers removeObject:timer];
+        if (self.firingTimerCount) {
+            self.firingTimerCount--;
+        }
 
-        if (!self.activeTimers.count) {
+        if (!self.timerQueue.count && !self.firingTimerCount) {
             [self endBackgroundTask];
         }
     }];
 }
 
 /**
- * Delay timer fired for a schedule. Method is called on the main queue.
+ * Delay timer fired for a schedule.
  *
  * Called from the main queue.
  *
- * @param timer The timer.
+ * @param identifier The schedule identifier.
  */
-- (void)delayTimerFired:(NSTimer *)timer {
-    if (!timer.isValid) {
-        return;
-    }
-
-    UA_LTRACE(@"Automation delay timer fired: %@", timer.userInfo);
-
-    NSString *identifier = timer.userInfo[@"identifier"];
+- (void)delayTimerFired:(NSString *)identifier {
+    UA_LTRACE(@"Automation delay timer fired: %@", identifier);
 
     UA_WEAKIFY(self);
     [self.automationStore getSchedule:identifier completionHandler:^(UAScheduleData *scheduleData) {
@@ -747,12 +1381,14 @@
 
         // Verify we are still delayed
         if (!scheduleData || [scheduleData.executionState intValue] != UAScheduleStateTimeDelayed) {
+            [self finishTimer];
             return;
         }
 
         // Check expired
         if ([scheduleData isExpired]) {
             [self handleExpiredScheduleData:scheduleData];
+            [self finishTimer];
             return;
         }
 
@@ -761,23 +1397,19 @@
         [self prepareSchedules:@[scheduleData]];
 
         // Finish the timer
-        [self finishTimer:timer];
+        [self finishTimer];
     }];
 }
 
 /**
- * Interval timer fired for a schedule. Method is called on the main queue.
+ * Interval timer fired for a schedule.
+ *
+ * Called from the main queue.
  *
- * @param timer The timer.
+ * @param identifier The schedule identifier.
  */
-- (void)intervalTimerFired:(NSTimer *)timer {
-    if (!timer.isValid) {
-        return;
-    }
-
-    UA_LTRACE(@"Automation interval timer fired: %@", timer.userInfo);
-
-    NSString *identifier = timer.userInfo[@"identifier"];
+- (void)intervalTimerFired:(NSString *)identifier {
+    UA_LTRACE(@"Automation interval timer fired: %@", identifier);
 
     UA_WEAKIFY(self);
     [self.automationStore getSchedule:identifier completionHandler:^(UAScheduleData *scheduleData) {
@@ -785,12 +1417,14 @@
 
         // Verify we are still paused
         if (!scheduleData || [scheduleData.executionState intValue] != UAScheduleStatePaused) {
+            [self finishTimer];
             return;
         }
 
         // Check expired
         if ([scheduleData isExpired]) {
             [self handleExpiredScheduleData:scheduleData];
+            [self finishTimer];
             return;
         }
 
@@ -809,7 +1443,7 @@
         }
 
         // Finish the timer
-        [self finishTimer:timer];
+        [self finishTimer];
     }];
 }
 
@@ -819,40 +1453,26 @@
  * @param identifiers A set of identifiers to cancel.
  */
 - (void)cancelTimersWithIdentifiers:(NSSet<NSString *> *)identifiers {
-        if (!identifiers.count) {
-            return;
-        }
-        [self.dispatcher dispatchAsync:^{
-            for (NSTimer *timer in [self.activeTimers copy]) {
-                if (!timer.isValid || !timer.userInfo) {
-                    [self.activeTimers removeObject:timer];
-                    continue;
-                }
+    if (!identifiers.count) {
+        return;
+    }
 
-                if ([identifiers containsObject:timer.userInfo[@"identifier"]]) {
-                    [timer invalidate];
-                    [self.activeTimers removeObject:timer];
-                }
-            }
+    [self.dispatcher dispatchAsync:^{
+        [self.timerQueue cancelTimersWithIdentifiers:identifiers];
 
-            if (!self.activeTimers.count) {
-                [self endBackgroundTask];
-            }
-        }];
-    }
+        if (!self.timerQueue.count && !self.firingTimerCount) {
+            [self endBackgroundTask];
+        }
+    }];
+}
 
 /**
  * Cancels all timers.
  */
 - (void)cancelTimers {
     [self.dispatcher dispatchAsync:^{
-        for (NSTimer *timer in self.activeTimers) {
-            if (timer.isValid) {
-                [timer invalidate];
-            }
-        }
-
-        [self.activeTimers removeAllObjects];
+        [self.timerQueue cancelAllTimers];
+        self.firingTimerCount = 0;
         [self endBackgroundTask];
     }];
 }
@@ -862,6 +1482,7 @@
  */
 - (void)rescheduleTimers {
     [self cancelTimers];
+    self.timersNeedReschedule = NO;
 
     // Delay timers
     UA_WEAKIFY(self);
@@ -873,9 +1494,8 @@
                 scheduleData.delayedExecutionDate = [NSDate dateWithTimeInterval:scheduleData.delay.seconds.doubleValue sinceDate:self.date.now];
             }
 
-            [self startTimerForSchedule:scheduleData
-                           timeInterval:[scheduleData.delay.seconds doubleValue]
-                               selector:@selector(delayTimerFired:)];
+            [self startDelayTimerForSchedule:scheduleData
+                                timeInterval:[scheduleData.delay.seconds doubleValue]];
         }
     }];
 
@@ -890,9 +1510,8 @@
                 remainingTime = interval;
             }
 
-            [self startTimerForSchedule:scheduleData
-                           timeInterval:remainingTime
-                               selector:@selector(intervalTimerFired:)];
+            [self startIntervalTimerForSchedule:scheduleData
+                                   timeInterval:remainingTime];
         }
     }];
 }
@@ -986,10 +1605,53 @@
  * Called when one of the schedule conditions changes.
  */
 - (void)scheduleConditionsChanged {
+    [self scheduleConditionsChangedMatching:nil];
+}
+
+- (void)scheduleConditionsChangedForScheduleIDs:(NSArray<NSString *> *)scheduleIDs {
+    if (!scheduleIDs.count) {
+        return;
+    }
+
     UA_WEAKIFY(self)
     [self.automationStore getSchedulesWithStates:@[@(UAScheduleStateWaitingScheduleConditions)]
                                completionHandler:^(NSArray<UAScheduleData *> *schedulesData) {
         UA_STRONGIFY(self);
+        NSMutableDictionary<NSString *, UAScheduleData *> *waiting = [NSMutableDictionary dictionary];
+        for (UAScheduleData *scheduleData in schedulesData) {
+            if (scheduleData.identifier) {
+                waiting[scheduleData.identifier] = scheduleData;
+            }
+        }
+
+        // Schedules that are no longer waiting are ignored
+        for (NSString *scheduleID in scheduleIDs) {
+            UAScheduleData *scheduleData = waiting[scheduleID];
+            if (scheduleData) {
+                [self attemptExecution:scheduleData];
+            }
+        }
+    }];
+}
+
+/**
+ * Attempts to execute the waiting schedules whose delay matches the predicate.
+ *
+ * @param predicate Checks the delay data of a waiting schedule. Schedules without a delay never match.
+ * If nil, all waiting schedules are attempted.
+ */
+- (void)scheduleConditionsChangedMatching:(nullable BOOL (^)(UAScheduleDelayData *delay))predicate {
+    UA_WEAKIFY(self)
+    [self.automationStore getSchedulesWithStates:@[@(UAScheduleStateWaitingScheduleConditions)]
+                               completionHandler:^(NSArray<UAScheduleData *> *schedulesData) {
+        UA_STRONGIFY(self);
+        if (predicate) {
+            NSPredicate *matching = [NSPredicate predicateWithBlock:^BOOL(UAScheduleData *scheduleData, NSDictionary *bindings) {
+                return scheduleData.delay && predicate(scheduleData.delay);
+            }];
+            schedulesData = [schedulesData filteredArrayUsingPredicate:matching];
+        }
+
         schedulesData = [self sortedScheduleDataByPriority:schedulesData];
         for (UAScheduleData *scheduleData in schedulesData) {
             [self attemptExecution:scheduleData];
@@ -1062,9 +1724,8 @@
             scheduleData.delayedExecutionDate = [NSDate dateWithTimeInterval:scheduleData.delay.seconds.doubleValue sinceDate:self.date.now];
 
             // Start a timer
-            [self startTimerForSchedule:scheduleData
-                           timeInterval:[scheduleData.delay.seconds doubleValue]
-                               selector:@selector(delayTimerFired:)];
+            [self startDelayTimerForSchedule:scheduleData
+                                timeInterval:[scheduleData.delay.seconds doubleValue]];
             continue;
         }
 
@@ -1075,70 +1736,132 @@
     [self prepareSchedules:schedulesToPrepare];
 }
 
+/**
+ * Queues schedules to be prepared. Schedules from every trigger share one queue ordered by
+ * priority, and only a bounded number are handed to the delegate at a time.
+ *
+ * @param schedules The schedules in the preparing state.
+ */
 - (void)prepareSchedules:(NSArray<UAScheduleData *> *)schedules {
     if (!schedules.count) {
         return;
     }
 
-    // Sort schedules by priority in ascending order
-    schedules = [self sortedScheduleDataByPriority:schedules];
-
     for (UAScheduleData *scheduleData in schedules) {
-        NSString *scheduleID = scheduleData.identifier;
-
         UASchedule *schedule = [self scheduleFromData:scheduleData];
         if (!schedule) {
             continue;
         }
 
-        UAScheduleTriggerContext *triggerContext = scheduleData.triggerContext;
+        // Skip over capped schedules before any audience checks or asset downloads
+        if ([self.frequencyLimitManager isOverLimit:schedule.frequencyConstraintIDs]) {
+            UA_LDEBUG(@"Schedule %@ is over its frequency limit, skipping prepare", schedule.identifier);
+            scheduleData.executionState = @(UAScheduleStateIdle);
+            [[UAScheduleTimelineRecorder shared] finishTimelineWithScheduleID:schedule.identifier
+                                                                      outcome:UAScheduleTimelineOutcomeSkipped];
+            continue;
+        }
 
-        UA_WEAKIFY(self)
-        [self.delegate prepareSchedule:schedule triggerContext:triggerContext completionHandler:^(UAAutomationSchedulePrepareResult prepareResult) {
-            UA_STRONGIFY(self)
+        [self.prepareQueue addSchedule:schedule triggerContext:scheduleData.triggerContext];
+    }
 
-            // Get the updated schedule
-            [self.automationStore getSchedule:scheduleID completionHandler:^(UAScheduleData *scheduleData) {
-                UA_STRONGIFY(self)
-                if (!scheduleData) {
-                    return;
-                }
+    [self dispatchQueuedPrepares];
+}
 
-                // Make sure it's still preparing
-                if ([scheduleData.executionState intValue] != UAScheduleStatePreparingSchedule) {
-                    return;
-                }
+/**
+ * Hands queued schedules to the delegate until the concurrency limit is reached.
+ */
+- (void)dispatchQueuedPrepares {
+    while (YES) {
+        UAScheduleRunQueueEntry *entry;
+        @synchronized (self.prepareQueue) {
+            // Without a delegate the schedules stay queued until one is set
+            if (!self.delegate || self.preparingScheduleCount >= UAAutomationEngineMaxConcurrentPrepares) {
+                return;
+            }
 
-                // Handle expired
-                if ([scheduleData isExpired]) {
-                    [self handleExpiredScheduleData:scheduleData];
-                }
+            entry = [self.prepareQueue popEntry];
+            if (!entry) {
+                return;
+            }
 
-                switch (prepareResult) {
-                    case UAAutomationSchedulePrepareResultCancel:
-                        [self notifyDelegateOnScheduleCancelled:[self scheduleFromData:scheduleData]];
-                        [scheduleData.managedObjectContext deleteObject:scheduleData];
-                        break;
-                    case UAAutomationSchedulePrepareResultContinue:
-                        scheduleData.executionState = @(UAScheduleStateWaitingScheduleConditions);
-                        [self attemptExecution:scheduleData];
-                        break;
-                    case UAAutomationSchedulePrepareResultSkip:
-                        scheduleData.executionState = @(UAScheduleStateIdle);
-                        break;
-                    case UAAutomationSchedulePrepareResultInvalidate:
-                        [self prepareSchedules:@[scheduleData]];
-                        break;
-                    case UAAutomationSchedulePrepareResultPenalize:
-                    default:
-                        [self scheduleFinishedExecuting:scheduleData];
-                        break;
-                }
-            }];
-        }];
+            self.preparingScheduleCount++;
+        }
+
+        [self prepareSchedule:entry.schedule triggerContext:entry.triggerContext];
     }
 }
 
+- (void)prepareSchedule:(UASchedule *)schedule triggerContext:(UAScheduleTriggerContext *)triggerContext {
+    NSString *scheduleID = schedule.identifier;
+
+    // Free up the slot for the next queued schedule, once the prepare finishes or times out
+    __block BOOL slotReleased = NO;
+    UA_WEAKIFY(self)
+    void (^releaseSlot)(void) = ^{
+        UA_STRONGIFY(self)
+        @synchronized (self.prepareQueue) {
+            if (slotReleased) {
+                return;
+            }
+            slotReleased = YES;
+            self.preparingScheduleCount--;
+        }
+        [self dispatchQueuedPrepares];
+    };
+
+    UADisposable *slotTimeout = [self.dispatcher dispatchAfter:UAAutomationEnginePrepareSlotTimeout block:^{
+        UA_LTRACE(@"Prepare for schedule %@ is taking too long, releasing its slot", scheduleID);
+        releaseSlot();
+    }];
+
+    [self.delegate prepareSchedule:schedule triggerContext:triggerContext completionHandler:^(UAAutomationSchedulePrepareResult prepareResult) {
+        UA_STRONGIFY(self)
+
+        [slotTimeout dispose];
+        releaseSlot();
+
+        // Get the updated schedule
+        [self.automationStore getSchedule:scheduleID completionHandler:^(UAScheduleData *scheduleData) {
+            UA_STRONGIFY(self)
+            if (!scheduleData) {
+                return;
+            }
+
+            // Make sure it's still preparing
+            if ([scheduleData.executionState intValue] != UAScheduleStatePreparingSchedule) {
+                return;
+            }
+
+            // Handle expired
+            if ([scheduleData isExpired]) {
+                [self handleExpiredScheduleData:scheduleData];
+            }
+
+            switch (prepareResult) {
+                case UAAutomationSchedulePrepareResultCancel:
+                    [self notifyDelegateOnScheduleCancelled:[self scheduleFromData:scheduleData]];
+                    [scheduleData.managedObjectContext deleteObject:scheduleData];
+                    break;
+                case UAAutomationSchedulePrepareResultContinue:
+                    scheduleData.executionState = @(UAScheduleStateWaitingScheduleConditions);
+                    [self attemptExecution:scheduleData];
+                    break;
+                case UAAutomationSchedulePrepareResultSkip:
+                    scheduleData.executionState = @(UAScheduleStateIdle);
+                    break;
+                case UAAutomationSchedulePrepareResultInvalidate:
+                    [self prepareSchedules:@[scheduleData]];
+                    break;
+                case UAAutomationSchedulePrepareResultPenalize:
+                default:
+                    [self scheduleFinishedExecuting:scheduleData];
+                    break;
+            }
+        }];
+    }];
+}
+
 - (void)prepareScheduleWithIdentifier:(NSString *)scheduleID {
     UA_WEAKIFY(self)
     [self.automationStore getSchedule:scheduleID completionHandler:^(UAScheduleData *schedule) {
@@ -1196,6 +1919,16 @@
                 break;
             }
             case UAAutomationScheduleReadyResultContinue: {
+                // Counts the execution, so it must be the last check
+                if (![self.frequencyLimitManager checkAndIncrement:schedule.frequencyConstraintIDs]) {
+                    UA_LDEBUG("Schedule:%@ is over its frequency limit.", schedule);
+                    nextExecutionState = @(UAScheduleStateIdle);
+                    [[UAScheduleTimelineRecorder shared] finishTimelineWithScheduleID:schedule.identifier
+                                                                              outcome:UAScheduleTimelineOutcomeSkipped];
+                    [self notifyDelegateOnScheduleFrequencyLimited:schedule];
+                    break;
+                }
+
                 UA_LTRACE("Execute schedule:%@.", schedule);
 
                 [delegate executeSchedule:schedule completionHandler:^{
@@ -1262,9 +1995,8 @@
     } else if ([scheduleData.interval doubleValue] > 0) {
         // Paused
         scheduleData.executionState = @(UAScheduleStatePaused);
-        [self startTimerForSchedule:scheduleData
-                       timeInterval:[scheduleData.interval doubleValue]
-                           selector:@selector(intervalTimerFired:)];
+        [self startIntervalTimerForSchedule:scheduleData
+                               timeInterval:[scheduleData.interval doubleValue]];
     } else {
         // Back to idle
         scheduleData.executionState = @(UAScheduleStateIdle);
@@ -1301,6 +2033,36 @@
     }];
 }
 
+- (void)notifyDelegateOnSchedulesCancelled:(NSArray<UASchedule *> *)schedules {
+    if (!schedules.count) {
+        return;
+    }
+
+    UA_WEAKIFY(self)
+    [self.dispatcher dispatchAsync:^{
+        UA_STRONGIFY(self)
+        id<UAAutomationEngineDelegate> delegate = self.delegate;
+        if ([delegate respondsToSelector:@selector(onSchedulesCancelled:)]) {
+            [delegate onSchedulesCancelled:schedules];
+        } else if ([delegate respondsToSelector:@selector(onScheduleCancelled:)]) {
+            for (UASchedule *schedule in schedules) {
+                [delegate onScheduleCancelled:schedule];
+            }
+        }
+    }];
+}
+
+- (void)notifyDelegateOnScheduleFrequencyLimited:(UASchedule *)schedule {
+    UA_WEAKIFY(self)
+    [self.dispatcher dispatchAsync:^{
+        UA_STRONGIFY(self)
+        id<UAAutomationEngineDelegate> delegate = self.delegate;
+        if ([delegate respondsToSelector:@selector(onScheduleFrequencyLimited:)]) {
+            [delegate onScheduleFrequencyLimited:schedule];
+        }
+    }];
+}
+
 - (void)notifyDelegateOnScheduleLimitReached:(nullable UASchedule *)schedule {
     if (!schedule) {
         return;
@@ -1340,8 +2102,29 @@
     return schedules;
 }
 
+/**
+ * Gets the schedule for the schedule data, decoding it only if the cache does not already have it.
+ * Schedule data is only edited through `applyEdits:toScheduleData:followUps:`, which refreshes the
+ * cached schedule, and the object ID guards against a new schedule reusing an identifier.
+ */
 - (nullable UASchedule *)scheduleFromData:(UAScheduleData *)scheduleData {
-    id dataJSON = [NSJSONSerialization objectWithString:scheduleData.data];
+    NSString *identifier = scheduleData.identifier;
+    UAAutomationCachedSchedule *cached = identifier ? [self.scheduleCache objectForKey:identifier] : nil;
+    if (cached && [cached.objectID isEqual:scheduleData.objectID]) {
+        return cached.schedule;
+    }
+
+    UASchedule *schedule = [self decodeScheduleFromData:scheduleData];
+    if (schedule && identifier) {
+        [self.scheduleCache setObject:[UAAutomationCachedSchedule cachedSchedule:schedule objectID:scheduleData.objectID]
+                               forKey:identifier];
+    }
+
+    return schedule;
+}
+
+- (nullable UASchedule *)decodeScheduleFromData:(UAScheduleData *)scheduleData {
+    id dataJSON = scheduleData.dataJSON;
     if (!dataJSON) {
         UA_LERR(@"Invalid schedule. Deleting %@", scheduleData.identifier);
         [scheduleData.managedObjectContext deleteObject:scheduleData];
@@ -1360,6 +2143,14 @@
         }
     }
 
+    NSArray<NSString *> *frequencyConstraintIDs;
+    if (scheduleData.frequencyConstraintIDs) {
+        id constraintIDsJSON = [NSJSONSerialization objectWithString:scheduleData.frequencyConstraintIDs];
+        if ([constraintIDsJSON isKindOfClass:[NSArray class]]) {
+            frequencyConstraintIDs = constraintIDsJSON;
+        }
+    }
+
     UASchedule *schedule = [UAAutomationEngine scheduleWithType:[scheduleData.type unsignedIntegerValue]
                                                        dataJSON:dataJSON
                                                    builderBlock:^(UAScheduleBuilder * _Nonnull builder) {
@@ -1375,6 +2166,7 @@
         builder.metadata = [NSJSONSerialization objectWithString:scheduleData.metadata];
         builder.identifier = scheduleData.identifier;
         builder.audience = audience;
+        builder.frequencyConstraintIDs = frequencyConstraintIDs;
     }];
 
     if (![schedule isValid]) {
@@ -1440,6 +2232,16 @@
 }
 
 
++ (nullable NSArray *)screensFromDelayData:(UAScheduleDelayData *)data {
+    NSData *screenData = [data.screens dataUsingEncoding:NSUTF8StringEncoding];
+    if (!screenData) {
+        return nil;
+    }
+
+    id screens = [NSJSONSerialization JSONObjectWithData:screenData options:0 error:nil];
+    return [screens isKindOfClass:[NSArray class]] ? screens : nil;
+}
+
 + (UAScheduleDelay *)delayFromData:(UAScheduleDelayData *)data {
     if (!data) {
         return nil;
@@ -1474,13 +2276,15 @@
         return nil;
     }
 
-    id json = [NSJSONSerialization JSONObjectWithData:data options:NSJSONReadingMutableContainers error:nil];
+    id json = [UAScheduleData JSONWithStoredData:data];
     return [UAJSONPredicate predicateWithJSON:json error:nil];
 }
 
 + (void)applyEdits:(UAScheduleEdits *)edits toData:(UAScheduleData *)scheduleData {
     if (edits.data && edits.type) {
+        // Edited data is stored as JSON, the store re-encodes it the next time it loads if binary encoding is enabled
         scheduleData.data = edits.data;
+        scheduleData.binaryData = nil;
         scheduleData.type = edits.type;
     }
 
@@ -1515,6 +2319,10 @@
     if (edits.audience) {
         scheduleData.audience = [NSJSONSerialization stringWithObject:[edits.audience toJSON]];
     }
+
+    if (edits.frequencyConstraintIDs) {
+        scheduleData.frequencyConstraintIDs = edits.frequencyConstraintIDs.count ? [NSJSONSerialization stringWithObject:edits.frequencyConstraintIDs] : nil;
+    }
 }
      
 
@@ -11,6 +11,7 @@ NS_ASSUME_NONNULL_BEGIN
 @class UAScheduleTriggerData;
 @class UARuntimeConfig;
 @class UAScheduleTriggerContext;
+@class UAFrequencyConstraint;
 
 /**
  * Manager class for the Automation CoreData store.
@@ -47,6 +48,30 @@ NS_ASSUME_NONNULL_BEGIN
 + (instancetype)automationStoreWithConfig:(UARuntimeConfig *)config
                             scheduleLimit:(NSUInteger)scheduleLimit;
 
+/**
+ * How long trigger progress updates are held in memory before they are saved. Changes
+ * that go beyond trigger progress, such as a schedule being triggered, are always saved
+ * immediately. Defaults to 0, which saves every update immediately.
+ */
+@property (nonatomic, assign) NSTimeInterval triggerProgressSaveInterval;
+
+/**
+ * Whether schedule data and trigger predicates are stored as binary property lists instead of
+ * JSON. Existing JSON data is converted when the store loads. Data that can't be represented as
+ * a property list, such as JSON containing nulls, is still stored as JSON. Either form can always
+ * be read. Must be set before the store is first used. Defaults to `NO`.
+ */
+@property (atomic, assign) BOOL binaryEncodingEnabled;
+
+/**
+ * The max size in bytes of the triggering event JSON kept with a triggered schedule. Larger
+ * events are stored without their custom event properties, or dropped if that is still too
+ * large. Shared by all automation stores and applies to trigger contexts saved after it is
+ * set. Defaults to
+ * `UAScheduleTriggerContextTransformerDefaultMaxEventSize`.
+ */
+@property (atomic, assign) NSUInteger triggerContextMaxEventSize;
+
 /**
  * Saves the UAActionSchedule to the data store.
  *
@@ -67,6 +92,23 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)saveSchedules:(NSArray<UASchedule *> *)schedules completionHandler:(void (^)(BOOL))completionHandler;
 
+/**
+ * Edits existing schedules and saves new schedules in a single save.
+ *
+ * @param scheduleIDs The identifiers of the schedules to edit.
+ * @param editBlock Called on the store's context with the schedule data found for the identifiers.
+ * Any changes made in the block are saved together with the new schedules.
+ * @param schedules The new schedules to save. Schedules that would exceed the specified limit are
+ * not saved, the edits are saved regardless.
+ * @param completionHandler Completion handler when the operation is finished. `YES` if the
+ * changes were saved, `NO` if they failed to save, along with the new schedules that were saved.
+ * None of the update's changes are kept if it fails to save.
+ */
+- (void)updateSchedulesWithIDs:(NSArray<NSString *> *)scheduleIDs
+                     editBlock:(void (^)(NSArray<UAScheduleData *> *))editBlock
+                  newSchedules:(NSArray<UASchedule *> *)schedules
+             completionHandler:(void (^)(BOOL saved, NSArray<UASchedule *> *savedSchedules))completionHandler;
+
 /**
  * Gets all schedules corresponding to the provided group.
  *
@@ -138,6 +180,30 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)getActiveExpiredSchedules:(void (^)(NSArray<UAScheduleData *> *))completionHandler;
 
+/**
+ * Deletes finished schedules whose purge date has passed, oldest first. Along with the schedules,
+ * their triggers and delays are deleted.
+ *
+ * @param limit The maximum number of schedules to delete.
+ * @param completionHandler Completion handler called back with the number of deleted schedules.
+ */
+- (void)deletePurgeableSchedulesWithLimit:(NSUInteger)limit completionHandler:(void (^)(NSUInteger deletedCount))completionHandler;
+
+/**
+ * Deletes the schedules matching the group and type, along with their triggers and delays. The
+ * matching schedules are found with an ID-only fetch and deleted in a single batch.
+ *
+ * @param groupID The schedule group, or nil to match any group.
+ * @param scheduleType The schedule type as an NSNumber, or nil to match any type.
+ * @param willDelete Optional block called with the schedules right before they are deleted. Leave nil
+ * when the schedules are not needed, so they are never loaded.
+ * @param completionHandler Completion handler called back with the identifiers of the deleted schedules.
+ */
+- (void)deleteSchedulesWithGroup:(nullable NSString *)groupID
+                            type:(nullable NSNumber *)scheduleType
+                      willDelete:(nullable void (^)(NSArray<UAScheduleData *> *scheduleDatas))willDelete
+               completionHandler:(void (^)(NSSet<NSString *> *identifiers))completionHandler;
+
 /**
  * Gets all active triggers corresponding to the provided schedule identifier and trigger type.
  *
@@ -149,6 +215,22 @@ NS_ASSUME_NONNULL_BEGIN
                      type:(UAScheduleTriggerType)triggerType
         completionHandler:(void (^)(NSArray<UAScheduleTriggerData *> *triggers))completionHandler;
 
+/**
+ * Gets all triggers, including cancellation triggers, regardless of schedule state.
+ *
+ * @param completionHandler Completion handler called back with the retrieved trigger data.
+ */
+- (void)getTriggers:(void (^)(NSArray<UAScheduleTriggerData *> *triggers))completionHandler;
+
+/**
+ * Gets the type and predicate data of all triggers, including cancellation triggers, without
+ * loading the triggers themselves.
+ *
+ * @param completionHandler Completion handler called back with a dictionary per trigger, keyed by
+ * `type` and `predicateData`. `predicateData` is absent if the trigger has no predicate.
+ */
+- (void)getTriggerPredicates:(void (^)(NSArray<NSDictionary *> *triggerPredicates))completionHandler;
+
 /**
  * Gets the schedule count.
  *
@@ -156,6 +238,44 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)getScheduleCount:(void (^)(NSNumber *))completionHandler;
 
+/**
+ * Gets the frequency constraints along with the occurrences still within each constraint's range.
+ * Occurrences that fell out of their constraint's range are deleted.
+ *
+ * @param completionHandler Completion handler called back with the constraints and the occurrence
+ * dates per constraint identifier, oldest first.
+ */
+- (void)getFrequencyConstraints:(void (^)(NSArray<UAFrequencyConstraint *> *constraints,
+                                          NSDictionary<NSString *, NSArray<NSDate *> *> *occurrences))completionHandler;
+
+/**
+ * Replaces the stored frequency constraints. The occurrences of constraints that are removed, or
+ * whose range changed, are deleted.
+ *
+ * @param constraints The constraints.
+ * @param completionHandler Completion handler when the operation is finished. `YES` if the
+ * constraints were saved, otherwise `NO`.
+ */
+- (void)saveFrequencyConstraints:(NSArray<UAFrequencyConstraint *> *)constraints
+               completionHandler:(nullable void (^)(BOOL))completionHandler;
+
+/**
+ * Saves an occurrence for each of the frequency constraints.
+ *
+ * @param constraintIDs The constraint identifiers.
+ * @param date The occurrence date.
+ * @param completionHandler Completion handler when the operation is finished. `YES` if the
+ * occurrences were saved, otherwise `NO`.
+ */
+- (void)addFrequencyOccurrencesForConstraintIDs:(NSArray<NSString *> *)constraintIDs
+                                           date:(NSDate *)date
+                              completionHandler:(nullable void (^)(BOOL))completionHandler;
+
+/**
+ * Saves any trigger progress held in memory.
+ */
+- (void)savePendingTriggerProgress;
+
 /**
  * Waits for the store to become idle and then returns. Used by Unit Tests.
  */
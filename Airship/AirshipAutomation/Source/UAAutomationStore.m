@@ -10,12 +10,21 @@
 #import "UAScheduleDataMigrator+Internal.h"
 #import "UAAirshipAutomationCoreImport.h"
 #import "UAScheduleTriggerContext+Internal.h"
+#import "UAScheduleTriggerContextTransformer+Internal.h"
 #import "UAScheduleAudience+Internal.h"
 #import "UAAutomationResources.h"
+#import "UAFrequencyConstraint+Internal.h"
+#import "UAFrequencyConstraintData+Internal.h"
+#import "UAFrequencyOccurrenceData+Internal.h"
 
 NSString *const UAInAppAutomationStoreFileFormat = @"In-app-automation-%@.sqlite";
 NSString *const UALegacyActionAutomationStoreFileFormat = @"Automation-%@.sqlite";
 
+/**
+ * The number of schedules migrated per save.
+ */
+static NSUInteger const UAAutomationStoreMigrationBatchSize = 50;
+
 @interface UAAutomationStore ()
 @property (nonatomic, strong) NSManagedObjectContext *managedContext;
 @property (nonatomic, strong) NSPersistentStore *mainStore;
@@ -26,6 +35,23 @@ NSString *const UALegacyActionAutomationStoreFileFormat = @"Automation-%@.sqlite
 @property (nonatomic, assign) NSUInteger scheduleLimit;
 @property (nonatomic, assign) BOOL inMemory;
 @property (nonatomic, assign) BOOL finished;
+@property (nonatomic, assign) BOOL triggerProgressSaveScheduled;
+
+/**
+ * The number of saved schedules, or nil if unknown. Only accessed on the managed context's queue.
+ */
+@property (nonatomic, strong, nullable) NSNumber *savedScheduleCount;
+
+/**
+ * Whether all the stored schedules are at the current data version. Only accessed on the managed context's queue.
+ */
+@property (nonatomic, assign) BOOL dataMigrated;
+
+/**
+ * The IDs of the schedules at the current data version, used to keep migrated IDs unique. Only accessed
+ * on the managed context's queue.
+ */
+@property (nonatomic, strong, nullable) NSMutableArray<NSString *> *migratedScheduleIDs;
 @end
 
 
@@ -47,23 +73,57 @@ NSString *const UALegacyActionAutomationStoreFileFormat = @"Automation-%@.sqlite
         self.date = date;
         self.finished = NO;
 
+        // Register the trigger context transformer before the model loads
+        [UAAutomationStore triggerContextTransformer];
+
         NSBundle *bundle = [UAAutomationResources bundle];
         NSURL *modelURL = [bundle URLForResource:@"UAAutomation" withExtension:@"momd"];
 
-        self.managedContext = [NSManagedObjectContext managedObjectContextForModelURL:modelURL
-                                                                      concurrencyType:NSPrivateQueueConcurrencyType];
+        UA_WEAKIFY(self)
+        self.managedContext = [NSManagedObjectContext lazyManagedObjectContextForModelURL:modelURL
+                                                                              storeLoader:^(NSManagedObjectContext *context) {
+            UA_STRONGIFY(self)
+            [self addStoresToContext:context];
+        }];
         self.managedContext.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy;
-        [self addStores];
-        
+
         [[NSNotificationCenter defaultCenter] addObserver:self
-                                                 selector:@selector(protectedDataAvailable)
-                                                     name:UIApplicationProtectedDataDidBecomeAvailable
-                                                   object:nil];
+                                                 selector:@selector(managedContextDidSave:)
+                                                     name:NSManagedObjectContextDidSaveNotification
+                                                   object:self.managedContext];
     }
 
     return self;
 }
 
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+/**
+ * The transformer Core Data uses for the schedule trigger context attribute. Registered under
+ * the model's transformer name so the event size limit can be configured.
+ */
++ (UAScheduleTriggerContextTransformer *)triggerContextTransformer {
+    static UAScheduleTriggerContextTransformer *transformer;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        transformer = [UAScheduleTriggerContextTransformer transformerWithMaxEventSize:UAScheduleTriggerContextTransformerDefaultMaxEventSize];
+        [NSValueTransformer setValueTransformer:transformer
+                                        forName:NSStringFromClass([UAScheduleTriggerContextTransformer class])];
+    });
+
+    return transformer;
+}
+
+- (NSUInteger)triggerContextMaxEventSize {
+    return [UAAutomationStore triggerContextTransformer].maxEventSize;
+}
+
+- (void)setTriggerContextMaxEventSize:(NSUInteger)triggerContextMaxEventSize {
+    [UAAutomationStore triggerContextTransformer].maxEventSize = triggerContextMaxEventSize;
+}
+
 + (instancetype)automationStoreWithConfig:(UARuntimeConfig *)config scheduleLimit:(NSUInteger)scheduleLimit inMemory:(BOOL)inMemory date:(UADate *)date {
     return [[UAAutomationStore alloc] initWithConfig:config
                                        scheduleLimit:scheduleLimit
@@ -78,51 +138,226 @@ NSString *const UALegacyActionAutomationStoreFileFormat = @"Automation-%@.sqlite
                                                 date:[[UADate alloc] init]];
 }
 
-- (void)addStores {
-    UA_WEAKIFY(self)
-    void (^completion)(NSPersistentStore *, NSError *) = ^void(NSPersistentStore *store, NSError *error) {
-        UA_STRONGIFY(self);
+- (void)addStoresToContext:(NSManagedObjectContext *)context {
+    NSError *error = nil;
 
-        if (!store) {
+    if (self.inMemory) {
+        self.mainStore = [context addPersistentInMemoryStore:self.storeName error:&error];
+        if (!self.mainStore) {
             UA_LERR(@"Failed to create automation persistent store: %@", error);
-            return;
         }
 
-        if (!self.mainStore) {
-            self.mainStore = store;
-        }
+        self.dataMigrated = YES;
+        [self seedScheduleCount];
+        return;
+    }
 
-        if (!self.inMemory) {
-            [self migrateData];
-        }
-    };
+    // Instead of trying to copy data from one store to the other, we are going to attach both stores
+    // to the context, but only save new data on the primary store.
+    self.mainStore = [context addPersistentSqlStore:self.storeName error:&error];
+    if (!self.mainStore) {
+        UA_LERR(@"Failed to create automation persistent store: %@", error);
+    }
 
-    if (self.inMemory) {
-        [self.managedContext addPersistentInMemoryStore:self.storeName completionHandler:completion];
+    if (![context addPersistentSqlStore:self.legacyActionStoreName error:&error]) {
+        UA_LERR(@"Failed to create automation persistent store: %@", error);
+    }
+
+    if (context.persistentStoreCoordinator.persistentStores.count) {
+        [self seedScheduleCount];
+        [self scheduleDataMigration];
     } else {
-        // Instead of trying to copy data from one store to the other, we are going to attach both stores
-        // to the context, but only save new data on the primary store.
-        [self.managedContext addPersistentSqlStore:self.storeName completionHandler:completion];
-        [self.managedContext addPersistentSqlStore:self.legacyActionStoreName completionHandler:completion];
+        self.dataMigrated = YES;
+    }
+}
+
+/**
+ * Counts the saved schedules. Must be called on the managed context's queue.
+ */
+- (void)seedScheduleCount {
+    NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
+    request.includesPendingChanges = NO;
+
+    NSError *error;
+    NSUInteger count = [self.managedContext countForFetchRequest:request error:&error];
+
+    if (count == NSNotFound) {
+        UA_LERR(@"Error counting schedules %@", error);
+        self.savedScheduleCount = nil;
+    } else {
+        self.savedScheduleCount = @(count);
+    }
+}
+
+/**
+ * The number of saved schedules, counted from the store only if unknown. Must be called on the
+ * managed context's queue.
+ */
+- (NSUInteger)scheduleCount {
+    if (!self.savedScheduleCount) {
+        [self seedScheduleCount];
+    }
+
+    return [self.savedScheduleCount unsignedIntegerValue];
+}
+
+- (void)managedContextDidSave:(NSNotification *)notification {
+    // Posted on the managed context's queue
+    if (!self.savedScheduleCount) {
+        return;
+    }
+
+    NSInteger count = [self.savedScheduleCount integerValue];
+    count += [self scheduleCountInObjects:notification.userInfo[NSInsertedObjectsKey]];
+    count -= [self scheduleCountInObjects:notification.userInfo[NSDeletedObjectsKey]];
+
+    self.savedScheduleCount = @(MAX(count, 0));
+}
+
+- (NSUInteger)scheduleCountInObjects:(NSSet<NSManagedObject *> *)objects {
+    NSUInteger count = 0;
+    for (NSManagedObject *object in objects) {
+        if ([object isKindOfClass:[UAScheduleData class]]) {
+            count++;
+        }
     }
+
+    return count;
 }
-- (void)protectedDataAvailable {
-    if (!self.managedContext.persistentStoreCoordinator.persistentStores.count) {
-        [self addStores];
+
+/**
+ * Migrates the stored schedules one batch per context block, so other store operations can run
+ * between batches. Must be called on the managed context's queue.
+ */
+- (void)scheduleDataMigration {
+    if (self.dataMigrated) {
+        return;
+    }
+
+    if ([self migrateDataBatch]) {
+        [self safePerformBlock:^(BOOL isSafe) {
+            if (isSafe) {
+                [self scheduleDataMigration];
+            }
+        }];
     }
 }
 
-- (void)migrateData {
+/**
+ * Migrates any schedules that are not at the current data version yet. Must be called on the
+ * managed context's queue before reading or writing schedules.
+ */
+- (void)migrateRemainingData {
+    while (!self.dataMigrated && [self migrateDataBatch]);
+}
+
+/**
+ * Migrates the next batch of schedules. Each batch is saved, so the data version doubles as a
+ * persisted cursor and an interrupted migration resumes where it left off on the next launch.
+ * Must be called on the managed context's queue.
+ *
+ * @return `YES` if more batches may remain, otherwise `NO`.
+ */
+- (BOOL)migrateDataBatch {
     NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
     request.predicate = [NSPredicate predicateWithFormat:@"dataVersion < %d", UAScheduleDataVersion];
+    request.fetchLimit = UAAutomationStoreMigrationBatchSize;
     NSError *error;
-    NSArray *result = [self.managedContext executeFetchRequest:request error:&error];
+    NSArray<UAScheduleData *> *result = [self.managedContext executeFetchRequest:request error:&error];
 
     if (error) {
         UA_LERR(@"Error fetching schedules %@", error);
-        return;
+        self.dataMigrated = YES;
+        return NO;
+    }
+
+    if (result.count) {
+        if (!self.migratedScheduleIDs) {
+            self.migratedScheduleIDs = [self fetchMigratedScheduleIDs];
+        }
+
+        [UAScheduleDataMigrator migrateSchedules:result migratedScheduleIDs:self.migratedScheduleIDs];
+
+        if (![self.managedContext safeSave]) {
+            self.dataMigrated = YES;
+            return NO;
+        }
+
+        // Release the migrated batch
+        for (UAScheduleData *scheduleData in result) {
+            [self.managedContext refreshObject:scheduleData mergeChanges:NO];
+        }
+
+        if (result.count == UAAutomationStoreMigrationBatchSize) {
+            return YES;
+        }
+    }
+
+    [self finishDataMigration];
+    return NO;
+}
+
+/**
+ * Fetches the IDs of the schedules already at the current data version. Must be called on the
+ * managed context's queue.
+ */
+- (NSMutableArray<NSString *> *)fetchMigratedScheduleIDs {
+    NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
+    request.predicate = [NSPredicate predicateWithFormat:@"dataVersion >= %d", UAScheduleDataVersion];
+    request.resultType = NSDictionaryResultType;
+    request.propertiesToFetch = @[@"identifier"];
+
+    NSError *error;
+    NSArray<NSDictionary *> *result = [self.managedContext executeFetchRequest:request error:&error];
+
+    if (error) {
+        UA_LERR(@"Error fetching schedule IDs %@", error);
+    }
+
+    NSMutableArray<NSString *> *identifiers = [NSMutableArray array];
+    for (NSDictionary *schedule in result) {
+        if (schedule[@"identifier"]) {
+            [identifiers addObject:schedule[@"identifier"]];
+        }
+    }
+
+    return identifiers;
+}
+
+/**
+ * Runs the migrations that don't depend on the data version, once every schedule is migrated.
+ * Must be called on the managed context's queue.
+ */
+- (void)finishDataMigration {
+    self.dataMigrated = YES;
+    self.migratedScheduleIDs = nil;
+
+    NSError *error;
+    if (self.binaryEncodingEnabled) {
+        NSFetchRequest *jsonRequest = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
+        jsonRequest.predicate = [NSPredicate predicateWithFormat:@"data != nil"];
+        NSArray *jsonSchedules = [self.managedContext executeFetchRequest:jsonRequest error:&error];
+
+        if (error) {
+            UA_LERR(@"Error fetching schedules %@", error);
+        } else {
+            [UAScheduleDataMigrator migrateSchedulesToBinaryEncoding:jsonSchedules];
+        }
     }
-    [UAScheduleDataMigrator migrateSchedules:result];
+
+    // Schedules finished before the purge date was stored
+    NSFetchRequest *purgeRequest = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
+    purgeRequest.predicate = [NSPredicate predicateWithFormat:@"executionState == %d && purgeAfter == nil", UAScheduleStateFinished];
+    NSArray<UAScheduleData *> *finishedSchedules = [self.managedContext executeFetchRequest:purgeRequest error:&error];
+
+    if (error) {
+        UA_LERR(@"Error fetching schedules %@", error);
+    } else {
+        for (UAScheduleData *scheduleData in finishedSchedules) {
+            [scheduleData updatePurgeAfter];
+        }
+    }
+
     [self.managedContext safeSave];
 }
 
@@ -134,19 +369,30 @@ NSString *const UALegacyActionAutomationStoreFileFormat = @"Automation-%@.sqlite
     }
 }
 
+/**
+ * Performs a block that reads or writes schedules, after migrating any schedules that are
+ * not at the current data version yet.
+ */
+- (void)safePerformScheduleBlock:(void (^)(BOOL))block {
+    [self safePerformBlock:^(BOOL isSafe) {
+        if (isSafe) {
+            [self migrateRemainingData];
+        }
+        block(isSafe);
+    }];
+}
+
 #pragma mark -
 #pragma mark Data Access
 
 - (void)saveSchedule:(UASchedule *)schedule completionHandler:(void (^)(BOOL))completionHandler {
-    [self safePerformBlock:^(BOOL isSafe) {
+    [self safePerformScheduleBlock:^(BOOL isSafe) {
         if (!isSafe) {
             completionHandler(NO);
             return;
         }
 
-        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
-        NSUInteger count = [self.managedContext countForFetchRequest:request error:nil];
-        if (count >= self.scheduleLimit) {
+        if ([self scheduleCount] >= self.scheduleLimit) {
             UA_LERR(@"Max schedule limit reached. Unable to save new schedule.");
             completionHandler(NO);
             return;
@@ -159,20 +405,18 @@ NSString *const UALegacyActionAutomationStoreFileFormat = @"Automation-%@.sqlite
 }
 
 - (void)saveSchedules:(NSArray<UASchedule *> *)schedules completionHandler:(void (^)(BOOL))completionHandler {
-    [self safePerformBlock:^(BOOL isSafe) {
+    [self safePerformScheduleBlock:^(BOOL isSafe) {
         if (!isSafe) {
             completionHandler(NO);
             return;
         }
 
-        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
-        NSUInteger count = [self.managedContext countForFetchRequest:request error:nil];
-        if (count + schedules.count > self.scheduleLimit) {
+        if ([self scheduleCount] + schedules.count > self.scheduleLimit) {
             UA_LERR(@"Max schedule limit reached. Unable to save new schedules.");
             completionHandler(NO);
             return;
         }
-        
+
         // create managed object for each schedule
         for (UASchedule *schedule in schedules) {
             [self addScheduleDataFromSchedule:schedule];
@@ -182,6 +426,69 @@ NSString *const UALegacyActionAutomationStoreFileFormat = @"Automation-%@.sqlite
     }];
 }
 
+- (void)updateSchedulesWithIDs:(NSArray<NSString *> *)scheduleIDs
+                     editBlock:(void (^)(NSArray<UAScheduleData *> *))editBlock
+                  newSchedules:(NSArray<UASchedule *> *)schedules
+             completionHandler:(void (^)(BOOL, NSArray<UASchedule *> *))completionHandler {
+    [self safePerformScheduleBlock:^(BOOL isSafe) {
+        if (!isSafe) {
+            completionHandler(NO, @[]);
+            return;
+        }
+
+        // Changes already pending in the context, such as deferred trigger progress, are not part of the update
+        NSSet<NSManagedObject *> *pendingInserts = [self.managedContext.insertedObjects copy];
+        NSSet<NSManagedObject *> *pendingUpdates = [self.managedContext.updatedObjects copy];
+
+        NSArray<UASchedule *> *savedSchedules = schedules;
+        NSUInteger scheduleCount = [self scheduleCount];
+        if (scheduleCount + schedules.count > self.scheduleLimit) {
+            NSUInteger available = self.scheduleLimit > scheduleCount ? self.scheduleLimit - scheduleCount : 0;
+            UA_LERR(@"Max schedule limit reached. Unable to save %lu new schedules.", (unsigned long)(schedules.count - available));
+            savedSchedules = [schedules subarrayWithRange:NSMakeRange(0, available)];
+        }
+
+        if (scheduleIDs.count) {
+            NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
+            request.predicate = [NSPredicate predicateWithFormat:@"identifier IN %@", scheduleIDs];
+
+            NSError *error;
+            NSArray *result = [self.managedContext executeFetchRequest:request error:&error];
+            if (error) {
+                UA_LERR(@"Error fetching schedules %@", error);
+                completionHandler(NO, @[]);
+                return;
+            }
+
+            editBlock(result);
+        }
+
+        for (UASchedule *schedule in savedSchedules) {
+            [self addScheduleDataFromSchedule:schedule];
+        }
+
+        if (![self.managedContext safeSave]) {
+            // Revert only this update, the rest of the pending changes are saved later
+            for (NSManagedObject *object in [self.managedContext.insertedObjects copy]) {
+                if (![pendingInserts containsObject:object]) {
+                    [self.managedContext deleteObject:object];
+                }
+            }
+
+            for (NSManagedObject *object in [self.managedContext.updatedObjects copy]) {
+                if (![pendingUpdates containsObject:object]) {
+                    [self.managedContext refreshObject:object mergeChanges:NO];
+                }
+            }
+
+            completionHandler(NO, @[]);
+            return;
+        }
+
+        completionHandler(YES, savedSchedules);
+    }];
+}
+
 - (void)getSchedules:(NSString *)groupID completionHandler:(void (^)(NSArray<UAScheduleData *> *))completionHandler {
     NSPredicate *predicate = [NSPredicate predicateWithFormat:@"group == %@", groupID];
     [self fetchSchedulesWithPredicate:predicate limit:self.scheduleLimit completionHandler:completionHandler];
@@ -201,7 +508,12 @@ NSString *const UALegacyActionAutomationStoreFileFormat = @"Automation-%@.sqlite
 - (void)getSchedulesWithStates:(NSArray *)state
              completionHandler:(void (^)(NSArray<UAScheduleData *> * _Nonnull))completionHandler {
     NSPredicate *predicate = [NSPredicate predicateWithFormat:@"executionState IN %@", state];
-    [self fetchSchedulesWithPredicate:predicate limit:self.scheduleLimit completionHandler:completionHandler];
+
+    // Callers check the delay of delayed and paused schedules
+    [self fetchSchedulesWithPredicate:predicate
+                                limit:self.scheduleLimit
+                           prefetches:@[@"delay"]
+                    completionHandler:completionHandler];
 }
 
 - (void)getSchedulesWithType:(UAScheduleType)scheduleType
@@ -232,6 +544,180 @@ NSString *const UALegacyActionAutomationStoreFileFormat = @"Automation-%@.sqlite
     [self fetchSchedulesWithPredicate:predicate limit:self.scheduleLimit completionHandler:completionHandler];
 }
 
+- (void)deletePurgeableSchedulesWithLimit:(NSUInteger)limit completionHandler:(void (^)(NSUInteger))completionHandler {
+    [self safePerformScheduleBlock:^(BOOL isSafe) {
+        if (!isSafe) {
+            completionHandler(0);
+            return;
+        }
+
+        // Ranged on the purge date index, oldest first
+        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
+        request.predicate = [NSPredicate predicateWithFormat:@"purgeAfter < %@", self.date.now];
+        request.sortDescriptors = @[[NSSortDescriptor sortDescriptorWithKey:@"purgeAfter" ascending:YES]];
+        request.fetchLimit = limit;
+        request.resultType = NSManagedObjectIDResultType;
+
+        NSError *error;
+        NSArray<NSManagedObjectID *> *scheduleIDs = [self.managedContext executeFetchRequest:request error:&error];
+
+        if (error) {
+            UA_LERR(@"Error fetching purgeable schedules %@", error);
+            completionHandler(0);
+            return;
+        }
+
+        if (!scheduleIDs.count) {
+            completionHandler(0);
+            return;
+        }
+
+        completionHandler([self deleteSchedulesWithObjectIDs:scheduleIDs] ? scheduleIDs.count : 0);
+    }];
+}
+
+- (void)deleteSchedulesWithGroup:(NSString *)groupID
+                            type:(NSNumber *)scheduleType
+                      willDelete:(void (^)(NSArray<UAScheduleData *> *))willDelete
+               completionHandler:(void (^)(NSSet<NSString *> *))completionHandler {
+    [self safePerformScheduleBlock:^(BOOL isSafe) {
+        if (!isSafe) {
+            completionHandler([NSSet set]);
+            return;
+        }
+
+        NSMutableArray<NSPredicate *> *predicates = [NSMutableArray array];
+        if (groupID) {
+            [predicates addObject:[NSPredicate predicateWithFormat:@"group == %@", groupID]];
+        }
+        if (scheduleType) {
+            [predicates addObject:[NSPredicate predicateWithFormat:@"type == %@", scheduleType]];
+        }
+
+        // Only the IDs are needed to delete
+        NSExpressionDescription *objectID = [[NSExpressionDescription alloc] init];
+        objectID.name = @"objectID";
+        objectID.expression = [NSExpression expressionForEvaluatedObject];
+        objectID.expressionResultType = NSObjectIDAttributeType;
+
+        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
+        request.predicate = [NSCompoundPredicate andPredicateWithSubpredicates:predicates];
+        request.resultType = NSDictionaryResultType;
+        request.propertiesToFetch = @[@"identifier", objectID];
+
+        NSError *error;
+        NSArray<NSDictionary *> *result = [self.managedContext executeFetchRequest:request error:&error];
+
+        if (error) {
+            UA_LERR(@"Error fetching schedule IDs %@", error);
+            completionHandler([NSSet set]);
+            return;
+        }
+
+        NSMutableSet<NSString *> *identifiers = [NSMutableSet set];
+        NSMutableArray<NSManagedObjectID *> *scheduleIDs = [NSMutableArray array];
+        for (NSDictionary *schedule in result) {
+            [scheduleIDs addObject:schedule[@"objectID"]];
+            if (schedule[@"identifier"]) {
+                [identifiers addObject:schedule[@"identifier"]];
+            }
+        }
+
+        if (!scheduleIDs.count) {
+            completionHandler([NSSet set]);
+            return;
+        }
+
+        if (willDelete) {
+            // Fault the schedules in with a single fetch, only when the caller needs them
+            NSFetchRequest *scheduleRequest = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
+            scheduleRequest.predicate = [NSPredicate predicateWithFormat:@"self IN %@", scheduleIDs];
+            scheduleRequest.relationshipKeyPathsForPrefetching = @[@"triggers", @"delay", @"delay.cancellationTriggers"];
+
+            NSArray<UAScheduleData *> *schedules = [self.managedContext executeFetchRequest:scheduleRequest error:&error];
+            if (error) {
+                UA_LERR(@"Error fetching schedules %@", error);
+            } else {
+                willDelete(schedules);
+            }
+        }
+
+        completionHandler([self deleteSchedulesWithObjectIDs:scheduleIDs] ? identifiers : [NSSet set]);
+    }];
+}
+
+/**
+ * Deletes the schedules along with their triggers and delays, in a single batch on SQLite stores.
+ *
+ * Must be called on the managed context's queue.
+ */
+- (BOOL)deleteSchedulesWithObjectIDs:(NSArray<NSManagedObjectID *> *)scheduleIDs {
+    if (self.inMemory) {
+        // Batch deletes are only supported by SQLite stores
+        for (NSManagedObjectID *objectID in scheduleIDs) {
+            [self.managedContext deleteObject:[self.managedContext objectWithID:objectID]];
+        }
+
+        return [self.managedContext safeSave];
+    }
+
+    // Children are deleted explicitly so the batch does not depend on the store applying the cascade rules
+    NSMutableArray<NSManagedObjectID *> *deletedIDs = [NSMutableArray array];
+    BOOL deleted = [self batchDeleteEntityWithName:@"UAScheduleTriggerData"
+                                         predicate:[NSPredicate predicateWithFormat:@"schedule IN %@", scheduleIDs]
+                                        deletedIDs:deletedIDs];
+
+    deleted = deleted && [self batchDeleteEntityWithName:@"UAScheduleDelayData"
+                                               predicate:[NSPredicate predicateWithFormat:@"schedule IN %@", scheduleIDs]
+                                              deletedIDs:deletedIDs];
+
+    deleted = deleted && [self batchDeleteEntityWithName:@"UAScheduleData"
+                                               predicate:[NSPredicate predicateWithFormat:@"self IN %@", scheduleIDs]
+                                              deletedIDs:deletedIDs];
+
+    if (deletedIDs.count) {
+        // Batch deletes bypass the context, so drop any registered objects
+        [NSManagedObjectContext mergeChangesFromRemoteContextSave:@{ NSDeletedObjectsKey: deletedIDs }
+                                                     intoContexts:@[self.managedContext]];
+    }
+
+    // Batch deletes do not post a save notification either
+    if (deleted && self.savedScheduleCount) {
+        NSUInteger count = [self.savedScheduleCount unsignedIntegerValue];
+        self.savedScheduleCount = @(count > scheduleIDs.count ? count - scheduleIDs.count : 0);
+    } else {
+        self.savedScheduleCount = nil;
+    }
+
+    return deleted;
+}
+
+/**
+ * Batch deletes the entities matching the predicate.
+ *
+ * Must be called on the managed context's queue.
+ */
+- (BOOL)batchDeleteEntityWithName:(NSString *)name
+                        predicate:(NSPredicate *)predicate
+                       deletedIDs:(NSMutableArray<NSManagedObjectID *> *)deletedIDs {
+    NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:name];
+    request.predicate = predicate;
+
+    NSBatchDeleteRequest *deleteRequest = [[NSBatchDeleteRequest alloc] initWithFetchRequest:request];
+    deleteRequest.resultType = NSBatchDeleteResultTypeObjectIDs;
+
+    NSError *error;
+    NSBatchDeleteResult *result = [self.managedContext executeRequest:deleteRequest error:&error];
+
+    if (error) {
+        UA_LERR(@"Error deleting %@: %@", name, error);
+        return NO;
+    }
+
+    [deletedIDs addObjectsFromArray:result.result];
+    return YES;
+}
+
 - (void)getActiveTriggers:(NSString *)scheduleID
                      type:(UAScheduleTriggerType)triggerType
         completionHandler:(void (^)(NSArray<UAScheduleTriggerData *> *triggers))completionHandler {
@@ -243,7 +729,37 @@ NSString *const UALegacyActionAutomationStoreFileFormat = @"Automation-%@.sqlite
     NSArray *cancelTriggerState = @[@(UAScheduleStateTimeDelayed), @(UAScheduleStateWaitingScheduleConditions), @(UAScheduleStatePreparingSchedule)];
     NSPredicate *predicate = [NSPredicate predicateWithFormat:format, scheduleID, triggerType, self.date.now, cancelTriggerState, UAScheduleStateIdle];
 
-    [self fetchTriggersWithPredicate:predicate completionHandler:completionHandler];
+
+    // Evaluating the triggers walks to their schedules, and to the delay's schedule for cancellation triggers
+    [self fetchTriggersWithPredicate:predicate
+                          prefetches:@[@"schedule", @"delay", @"delay.schedule"]
+                   completionHandler:completionHandler];
+}
+
+- (void)getTriggers:(void (^)(NSArray<UAScheduleTriggerData *> *))completionHandler {
+    [self fetchTriggersWithPredicate:nil prefetches:nil completionHandler:completionHandler];
+}
+
+- (void)getTriggerPredicates:(void (^)(NSArray<NSDictionary *> *))completionHandler {
+    [self safePerformBlock:^(BOOL isSafe) {
+        if (!isSafe) {
+            completionHandler(@[]);
+            return;
+        }
+
+        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleTriggerData"];
+        request.resultType = NSDictionaryResultType;
+        request.propertiesToFetch = @[@"type", @"predicateData"];
+
+        NSError *error;
+        NSArray *result = [self.managedContext executeFetchRequest:request error:&error];
+        if (error) {
+            UA_LERR(@"Error fetching trigger predicates %@", error);
+            completionHandler(@[]);
+        } else {
+            completionHandler(result);
+        }
+    }];
 }
 
 - (void)getScheduleCount:(void (^)(NSNumber *))completionHandler {
@@ -252,16 +768,171 @@ NSString *const UALegacyActionAutomationStoreFileFormat = @"Automation-%@.sqlite
             completionHandler(nil);
             return;
         }
-        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
-        NSUInteger count = [self.managedContext countForFetchRequest:request error:nil];
-        completionHandler(@(count));
+        completionHandler(@([self scheduleCount]));
+    }];
+}
+
+- (void)getFrequencyConstraints:(void (^)(NSArray<UAFrequencyConstraint *> *,
+                                          NSDictionary<NSString *, NSArray<NSDate *> *> *))completionHandler {
+    [self safePerformBlock:^(BOOL isSafe) {
+        if (!isSafe) {
+            completionHandler(@[], @{});
+            return;
+        }
+
+        NSError *error;
+        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAFrequencyConstraintData"];
+        NSArray<UAFrequencyConstraintData *> *constraintDatas = [self.managedContext executeFetchRequest:request error:&error];
+        if (error) {
+            UA_LERR(@"Error fetching frequency constraints %@", error);
+            completionHandler(@[], @{});
+            return;
+        }
+
+        NSMutableArray<UAFrequencyConstraint *> *constraints = [NSMutableArray array];
+        NSMutableDictionary<NSString *, NSMutableArray<NSDate *> *> *occurrences = [NSMutableDictionary dictionary];
+        NSMutableDictionary<NSString *, NSDate *> *windowStarts = [NSMutableDictionary dictionary];
+        NSDate *now = self.date.now;
+
+        for (UAFrequencyConstraintData *data in constraintDatas) {
+            UAFrequencyConstraint *constraint = [UAFrequencyConstraint constraintWithIdentifier:data.identifier
+                                                                                          range:data.range.doubleValue
+                                                                                          count:data.count.unsignedIntegerValue];
+            [constraints addObject:constraint];
+            occurrences[constraint.identifier] = [NSMutableArray array];
+            windowStarts[constraint.identifier] = [now dateByAddingTimeInterval:-constraint.range];
+        }
+
+        request = [NSFetchRequest fetchRequestWithEntityName:@"UAFrequencyOccurrenceData"];
+        request.sortDescriptors = @[[NSSortDescriptor sortDescriptorWithKey:@"timestamp" ascending:YES]];
+        NSArray<UAFrequencyOccurrenceData *> *occurrenceDatas = [self.managedContext executeFetchRequest:request error:&error];
+        if (error) {
+            UA_LERR(@"Error fetching frequency occurrences %@", error);
+            completionHandler(constraints, occurrences);
+            return;
+        }
+
+        for (UAFrequencyOccurrenceData *data in occurrenceDatas) {
+            NSDate *windowStart = windowStarts[data.constraintID];
+            if (!windowStart || [data.timestamp compare:windowStart] != NSOrderedDescending) {
+                [self.managedContext deleteObject:data];
+            } else {
+                [occurrences[data.constraintID] addObject:data.timestamp];
+            }
+        }
+
+        [self.managedContext safeSave];
+        completionHandler(constraints, occurrences);
+    }];
+}
+
+- (void)saveFrequencyConstraints:(NSArray<UAFrequencyConstraint *> *)constraints
+               completionHandler:(void (^)(BOOL))completionHandler {
+    [self safePerformBlock:^(BOOL isSafe) {
+        if (!isSafe) {
+            if (completionHandler) {
+                completionHandler(NO);
+            }
+            return;
+        }
+
+        NSError *error;
+        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAFrequencyConstraintData"];
+        NSArray<UAFrequencyConstraintData *> *existing = [self.managedContext executeFetchRequest:request error:&error];
+        if (error) {
+            UA_LERR(@"Error fetching frequency constraints %@", error);
+            if (completionHandler) {
+                completionHandler(NO);
+            }
+            return;
+        }
+
+        NSMutableDictionary<NSString *, UAFrequencyConstraint *> *updated = [NSMutableDictionary dictionary];
+        for (UAFrequencyConstraint *constraint in constraints) {
+            updated[constraint.identifier] = constraint;
+        }
+
+        NSMutableArray<NSString *> *clearedIDs = [NSMutableArray array];
+        for (UAFrequencyConstraintData *data in existing) {
+            UAFrequencyConstraint *constraint = updated[data.identifier];
+            if (!constraint) {
+                [clearedIDs addObject:data.identifier];
+                [self.managedContext deleteObject:data];
+                continue;
+            }
+
+            // Occurrences counted against a different window no longer apply
+            if (data.range.doubleValue != constraint.range) {
+                [clearedIDs addObject:data.identifier];
+                data.range = @(constraint.range);
+            }
+
+            data.count = @(constraint.count);
+            [updated removeObjectForKey:data.identifier];
+        }
+
+        for (UAFrequencyConstraint *constraint in updated.allValues) {
+            UAFrequencyConstraintData *data = [self insertNewEntityForName:@"UAFrequencyConstraintData"];
+            data.identifier = constraint.identifier;
+            data.range = @(constraint.range);
+            data.count = @(constraint.count);
+        }
+
+        if (clearedIDs.count) {
+            request = [NSFetchRequest fetchRequestWithEntityName:@"UAFrequencyOccurrenceData"];
+            request.predicate = [NSPredicate predicateWithFormat:@"constraintID IN %@", clearedIDs];
+            NSArray<UAFrequencyOccurrenceData *> *occurrences = [self.managedContext executeFetchRequest:request error:&error];
+            if (error) {
+                UA_LERR(@"Error fetching frequency occurrences %@", error);
+            }
+
+            for (UAFrequencyOccurrenceData *data in occurrences) {
+                [self.managedContext deleteObject:data];
+            }
+        }
+
+        BOOL saved = [self.managedContext safeSave];
+        if (completionHandler) {
+            completionHandler(saved);
+        }
+    }];
+}
+
+- (void)addFrequencyOccurrencesForConstraintIDs:(NSArray<NSString *> *)constraintIDs
+                                           date:(NSDate *)date
+                              completionHandler:(void (^)(BOOL))completionHandler {
+    [self safePerformBlock:^(BOOL isSafe) {
+        if (!isSafe) {
+            if (completionHandler) {
+                completionHandler(NO);
+            }
+            return;
+        }
+
+        for (NSString *constraintID in constraintIDs) {
+            UAFrequencyOccurrenceData *data = [self insertNewEntityForName:@"UAFrequencyOccurrenceData"];
+            data.constraintID = constraintID;
+            data.timestamp = date;
+        }
+
+        BOOL saved = [self.managedContext safeSave];
+        if (completionHandler) {
+            completionHandler(saved);
+        }
     }];
 }
 
 - (void)fetchSchedulesWithPredicate:(NSPredicate *)predicate
                               limit:(NSUInteger)limit
                   completionHandler:(void (^)(NSArray<UAScheduleData *> *))completionHandler {
-    [self safePerformBlock:^(BOOL isSafe) {
+    [self fetchSchedulesWithPredicate:predicate limit:limit prefetches:nil completionHandler:completionHandler];
+}
+
+- (void)fetchSchedulesWithPredicate:(NSPredicate *)predicate
+                              limit:(NSUInteger)limit
+                         prefetches:(NSArray<NSString *> *)prefetches
+                  completionHandler:(void (^)(NSArray<UAScheduleData *> *))completionHandler {
+    [self safePerformScheduleBlock:^(BOOL isSafe) {
         if (!isSafe) {
             completionHandler(@[]);
             return;
@@ -270,6 +941,7 @@ NSString *const UALegacyActionAutomationStoreFileFormat = @"Automation-%@.sqlite
         NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleData"];
         request.predicate = predicate;
         request.fetchLimit = limit;
+        request.relationshipKeyPathsForPrefetching = prefetches;
 
         NSError *error;
         NSArray *result = [self.managedContext executeFetchRequest:request error:&error];
@@ -284,8 +956,10 @@ NSString *const UALegacyActionAutomationStoreFileFormat = @"Automation-%@.sqlite
     }];
 }
 
-- (void)fetchTriggersWithPredicate:(NSPredicate *)predicate completionHandler:(void (^)(NSArray<UAScheduleTriggerData *> *))completionHandler {
-    [self safePerformBlock:^(BOOL isSafe) {
+- (void)fetchTriggersWithPredicate:(NSPredicate *)predicate
+                        prefetches:(NSArray<NSString *> *)prefetches
+                 completionHandler:(void (^)(NSArray<UAScheduleTriggerData *> *))completionHandler {
+    [self safePerformScheduleBlock:^(BOOL isSafe) {
         if (!isSafe) {
             completionHandler(@[]);
             return;
@@ -293,6 +967,7 @@ NSString *const UALegacyActionAutomationStoreFileFormat = @"Automation-%@.sqlite
 
         NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:@"UAScheduleTriggerData"];
         request.predicate = predicate;
+        request.relationshipKeyPathsForPrefetching = prefetches;
 
         NSError *error;
         NSArray *result = [self.managedContext executeFetchRequest:request error:&error];
@@ -301,6 +976,59 @@ NSString *const UALegacyActionAutomationStoreFileFormat = @"Automation-%@.sqlite
             completionHandler(@[]);
         } else {
             completionHandler(result);
+            [self saveTriggerChanges];
+        }
+    }];
+}
+
+/**
+ * Saves changes made while processing triggers. Progress-only changes are saved after the
+ * trigger progress save interval, anything else is saved immediately.
+ *
+ * Must be called on the managed context's queue.
+ */
+- (void)saveTriggerChanges {
+    if (!self.managedContext.hasChanges) {
+        return;
+    }
+
+    if (self.triggerProgressSaveInterval <= 0 || ![self hasOnlyTriggerProgressChanges]) {
+        [self.managedContext safeSave];
+        return;
+    }
+
+    if (self.triggerProgressSaveScheduled) {
+        return;
+    }
+
+    self.triggerProgressSaveScheduled = YES;
+
+    UA_WEAKIFY(self)
+    [[UADispatcher globalDispatcherForWorkType:UADispatcherWorkTypeProcessing] dispatchAfter:self.triggerProgressSaveInterval block:^{
+        UA_STRONGIFY(self)
+        [self savePendingTriggerProgress];
+    }];
+}
+
+- (BOOL)hasOnlyTriggerProgressChanges {
+    if (self.managedContext.insertedObjects.count || self.managedContext.deletedObjects.count) {
+        return NO;
+    }
+
+    for (NSManagedObject *object in self.managedContext.updatedObjects) {
+        if (![object isKindOfClass:[UAScheduleTriggerData class]]) {
+            return NO;
+        }
+    }
+
+    return YES;
+}
+
+- (void)savePendingTriggerProgress {
+    [self safePerformBlock:^(BOOL isSafe) {
+        self.triggerProgressSaveScheduled = NO;
+
+        if (isSafe && self.managedContext.hasChanges) {
             [self.managedContext safeSave];
         }
     }];
@@ -324,7 +1052,12 @@ NSString *const UALegacyActionAutomationStoreFileFormat = @"Automation-%@.sqlite
 
     scheduleData.identifier = schedule.identifier;
     scheduleData.limit = @(schedule.limit);
-    scheduleData.data = schedule.dataJSONString;
+    NSData *binaryData = self.binaryEncodingEnabled ? [UAScheduleData binaryDataWithJSON:[NSJSONSerialization objectWithString:schedule.dataJSONString]] : nil;
+    if (binaryData) {
+        scheduleData.binaryData = binaryData;
+    } else {
+        scheduleData.data = schedule.dataJSONString;
+    }
     scheduleData.type = @(schedule.type);
     scheduleData.priority = [NSNumber numberWithInteger:schedule.priority];
     scheduleData.group = schedule.group;
@@ -339,6 +1072,10 @@ NSString *const UALegacyActionAutomationStoreFileFormat = @"Automation-%@.sqlite
         scheduleData.audience = [NSJSONSerialization stringWithObject:[schedule.audience toJSON]];
     }
 
+    if (schedule.frequencyConstraintIDs.count) {
+        scheduleData.frequencyConstraintIDs = [NSJSONSerialization stringWithObject:schedule.frequencyConstraintIDs];
+    }
+
     if (schedule.delay) {
         scheduleData.delay = [self createDelayDataFromDelay:schedule.delay scheduleStart:schedule.start schedule:scheduleData];
     }
@@ -383,7 +1120,8 @@ NSString *const UALegacyActionAutomationStoreFileFormat = @"Automation-%@.sqlite
     triggerData.start = scheduleStart;
 
     if (trigger.predicate) {
-        triggerData.predicateData = [UAJSONSerialization dataWithJSONObject:trigger.predicate.payload options:0 error:nil];
+        NSData *binaryData = self.binaryEncodingEnabled ? [UAScheduleData binaryDataWithJSON:trigger.predicate.payload] : nil;
+        triggerData.predicateData = binaryData ?: [UAJSONSerialization dataWithJSONObject:trigger.predicate.payload options:0 error:nil];
     }
 
     triggerData.schedule = schedule;
@@ -37,6 +37,10 @@ NSString * const UACancelSchedulesActionDefaultRegistryAlias = @"^csa";
     }
 }
 
+- (UAActionThreadAffinity)threadAffinity {
+    return UAActionThreadAffinityBackground;
+}
+
 - (void)performWithArguments:(UAActionArguments *)arguments
            completionHandler:(UAActionCompletionHandler)completionHandler {
 
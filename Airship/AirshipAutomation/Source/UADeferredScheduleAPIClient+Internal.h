@@ -26,7 +26,12 @@ typedef NS_ENUM(NSInteger, UADeferredScheduleAPIClientError) {
     /**
      * Indicates an unsuccessful client status.
      */
-    UADeferredScheduleAPIClientErrorUnsuccessfulStatus
+    UADeferredScheduleAPIClientErrorUnsuccessfulStatus,
+
+    /**
+     * Indicates a server error (5xx) or a rate limited (429) status.
+     */
+    UADeferredScheduleAPIClientErrorServerError
 };
 
 /**
@@ -34,6 +39,16 @@ typedef NS_ENUM(NSInteger, UADeferredScheduleAPIClientError) {
  */
 extern NSString * const UADeferredScheduleAPIClientErrorDomain;
 
+/**
+ * The default time a resolved result is reused for an identical request, in seconds.
+ */
+extern NSTimeInterval const UADeferredScheduleAPIClientDefaultResultCacheTime;
+
+/**
+ * The default time a speculatively resolved result is reused, in seconds.
+ */
+extern NSTimeInterval const UADeferredScheduleAPIClientDefaultSpeculativeResultCacheTime;
+
 /**
  * Deferred schedule API client.
  */
@@ -60,6 +75,20 @@ extern NSString * const UADeferredScheduleAPIClientErrorDomain;
  */
 + (instancetype)clientWithConfig:(UARuntimeConfig *)config authManager:(UAAuthTokenManager *)authManager;
 
+/**
+ * How long a successfully resolved result is reused for an identical request. A request is
+ * identical when the URL, channel ID, trigger context and overrides all match. Set to 0 to
+ * disable caching. Defaults to `UADeferredScheduleAPIClientDefaultResultCacheTime`.
+ */
+@property (nonatomic, assign) NSTimeInterval resultCacheTime;
+
+/**
+ * How long a result resolved by `prefetchURL:channelID:triggerContext:tagOverrides:attributeOverrides:`
+ * is reused. Set to 0 to disable speculative results. Defaults to
+ * `UADeferredScheduleAPIClientDefaultSpeculativeResultCacheTime`.
+ */
+@property (nonatomic, assign) NSTimeInterval speculativeResultCacheTime;
+
 /**
  * Resolves a deferred schedule.
  * @param URL The URL.
@@ -76,6 +105,27 @@ extern NSString * const UADeferredScheduleAPIClientErrorDomain;
 attributeOverrides:(UAAttributePendingMutations *)attributeOverrides
  completionHandler:(void (^)(UADeferredScheduleResult * _Nullable, NSError * _Nullable))completionHandler;
 
+/**
+ * Resolves a deferred schedule ahead of its trigger. The result is reused by a later
+ * `resolveURL:channelID:triggerContext:tagOverrides:attributeOverrides:completionHandler:` call
+ * with the same URL, channel ID, trigger and overrides, whatever the triggering event. Only use
+ * for schedules whose response does not depend on the event.
+ *
+ * Requests share a serial queue, so a resolution made while the prefetch is in flight waits for
+ * it instead of sending a duplicate request.
+ *
+ * @param URL The URL.
+ * @param channelID The channel ID.
+ * @param triggerContext The expected trigger context. Its event is ignored.
+ * @param tagOverrides The tag overrides.
+ * @param attributeOverrides The attribute overrides.
+ */
+- (void)prefetchURL:(NSURL *)URL
+          channelID:(NSString *)channelID
+     triggerContext:(UAScheduleTriggerContext *)triggerContext
+       tagOverrides:(NSArray<UATagGroupsMutation *> *)tagOverrides
+ attributeOverrides:(UAAttributePendingMutations *)attributeOverrides;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -20,8 +20,13 @@
 #define kUADeferredScheduleAPIClientMessageKey @"message"
 #define kUADeferredScheduleAPIClientInAppMessageType @"in_app_message"
 
+#define kUADeferredScheduleAPIClientResultCacheCountLimit 16
+
 NSString * const UADeferredScheduleAPIClientErrorDomain = @"com.urbanairship.deferred_api_client";
 
+NSTimeInterval const UADeferredScheduleAPIClientDefaultResultCacheTime = 30;
+NSTimeInterval const UADeferredScheduleAPIClientDefaultSpeculativeResultCacheTime = 120;
+
 @interface UADeferredScheduleAPIClientResponse : NSObject
 @property (nonatomic, copy, nullable) NSDictionary *body;
 @property (nonatomic, strong, nullable) NSError *error;
@@ -31,9 +36,19 @@ NSString * const UADeferredScheduleAPIClientErrorDomain = @"com.urbanairship.def
 @implementation UADeferredScheduleAPIClientResponse
 @end
 
+@interface UADeferredScheduleAPIClientCachedResult : NSObject
+@property (nonatomic, strong) UADeferredScheduleResult *result;
+@property (nonatomic, strong) NSDate *date;
+@property (nonatomic, assign, getter=isSpeculative) BOOL speculative;
+@end
+
+@implementation UADeferredScheduleAPIClientCachedResult
+@end
+
 @interface UADeferredScheduleAPIClient ()
 @property(nonatomic, strong) UAAuthTokenManager *authManager;
 @property(nonatomic, strong) UADispatcher *requestDispatcher;
+@property(nonatomic, strong) NSCache<NSArray *, UADeferredScheduleAPIClientCachedResult *> *resultCache;
 @end
 
 @implementation UADeferredScheduleAPIClient
@@ -48,6 +63,10 @@ NSString * const UADeferredScheduleAPIClientErrorDomain = @"com.urbanairship.def
     if (self) {
         self.authManager = authManager;
         self.requestDispatcher = dispatcher;
+        self.resultCache = [[NSCache alloc] init];
+        self.resultCache.countLimit = kUADeferredScheduleAPIClientResultCacheCountLimit;
+        self.resultCacheTime = UADeferredScheduleAPIClientDefaultResultCacheTime;
+        self.speculativeResultCacheTime = UADeferredScheduleAPIClientDefaultSpeculativeResultCacheTime;
     }
 
     return self;
@@ -81,63 +100,165 @@ attributeOverrides:(UAAttributePendingMutations *)attributeOverrides
     UA_WEAKIFY(self)
     [self.requestDispatcher dispatchAsync:^{
         UA_STRONGIFY(self)
-        NSString *token = [self authToken];
+        NSData *body = [self requestBodyWithChannelID:channelID
+                                       triggerContext:triggerContext
+                                         tagOverrides:tagOverrides
+                                   attributeOverrides:attributeOverrides];
 
-        if (!token) {
-            return completionHandler(nil, [self missingAuthTokenError]);
+        // The same request resolved moments ago, e.g. a schedule prepared again after an interruption
+        NSArray *cacheKey = @[URL, body ?: [NSData data]];
+        UADeferredScheduleResult *cachedResult = [self cachedResultForKey:cacheKey speculativeOnly:NO];
+
+        // Or resolved ahead of the trigger, before the event was known
+        if (!cachedResult && triggerContext.event) {
+            NSData *speculativeBody = [self requestBodyWithChannelID:channelID
+                                                      triggerContext:[UAScheduleTriggerContext triggerContextWithTrigger:triggerContext.trigger event:nil]
+                                                        tagOverrides:tagOverrides
+                                                  attributeOverrides:attributeOverrides];
+            cachedResult = [self cachedResultForKey:@[URL, speculativeBody ?: [NSData data]] speculativeOnly:YES];
         }
 
-        UADeferredScheduleAPIClientResponse *response = [self performRequest:token
-                                                                         URL:URL
-                                                                   channelID:channelID
-                                                              triggerContext:triggerContext
-                                                                tagOverrides:tagOverrides
-                                                          attributeOverrides:attributeOverrides];
-
-        if (response.error) {
-            UA_LTRACE(@"Deferred schedule request failed with error %@", response.error);
-            return completionHandler(nil, [self timeoutError]);
+        if (cachedResult) {
+            UA_LTRACE(@"Using cached deferred schedule result for %@", URL);
+            return completionHandler(cachedResult, nil);
         }
 
-        // If unauthorized, manually expire the token and try again.
-        if (response.status == 401){
-            [self.authManager expireToken:token];
+        NSError *error;
+        UADeferredScheduleResult *result = [self requestResultWithURL:URL body:body error:&error];
+        if (!result) {
+            return completionHandler(nil, error);
+        }
 
-            token = [self authToken];
+        if (self.resultCacheTime > 0) {
+            [self cacheResult:result forKey:cacheKey speculative:NO];
+        }
 
-            if (!token) {
-                return completionHandler(nil, [self missingAuthTokenError]);
-            }
+        // Successful deferred schedule request
+        completionHandler(result, nil);
+    }];
+}
 
-            response = [self performRequest:token
-                                        URL:URL
-                                  channelID:channelID
-                             triggerContext:triggerContext
-                               tagOverrides:tagOverrides
-                         attributeOverrides:attributeOverrides];
+- (void)prefetchURL:(NSURL *)URL
+          channelID:(NSString *)channelID
+     triggerContext:(UAScheduleTriggerContext *)triggerContext
+       tagOverrides:(NSArray<UATagGroupsMutation *> *)tagOverrides
+ attributeOverrides:(UAAttributePendingMutations *)attributeOverrides {
 
-            if (response.error) {
-                UA_LTRACE(@"Deferred schedule request failed with error %@", response.error);
-                return completionHandler(nil, [self timeoutError]);
-            }
+    UA_WEAKIFY(self)
+    [self.requestDispatcher dispatchAsync:^{
+        UA_STRONGIFY(self)
+        if (self.speculativeResultCacheTime <= 0) {
+            return;
         }
 
-        // Unsuccessful HTTP response
-        if (!(response.status >= 200 && response.status <= 299)) {
-            UA_LTRACE(@"Deferred schedule request failed with status: %lu", (unsigned long)response.status);
-            return completionHandler(nil, [self unsuccessfulStatusError]);
+        NSData *body = [self requestBodyWithChannelID:channelID
+                                       triggerContext:[UAScheduleTriggerContext triggerContextWithTrigger:triggerContext.trigger event:nil]
+                                         tagOverrides:tagOverrides
+                                   attributeOverrides:attributeOverrides];
+
+        NSArray *cacheKey = @[URL, body ?: [NSData data]];
+        if ([self cachedResultForKey:cacheKey speculativeOnly:NO]) {
+            return;
         }
 
-        // Successful HTTP response
-        UA_LTRACE(@"Deferred schedule request succeeded with status: %lu", (unsigned long)response.status);
+        UA_LTRACE(@"Speculatively resolving deferred schedule %@", URL);
 
-        UADeferredScheduleResult *result = [self parseResponseBody:response.body];
+        NSError *error;
+        UADeferredScheduleResult *result = [self requestResultWithURL:URL body:body error:&error];
+        if (!result) {
+            UA_LTRACE(@"Speculative deferred schedule request failed with error %@", error);
+            return;
+        }
 
-        // Successful deferred schedule request
-        completionHandler(result, nil);
+        [self cacheResult:result forKey:cacheKey speculative:YES];
     }];
 }
 
+/**
+ * Returns an unexpired cached result. Must be called on the request dispatcher.
+ */
+- (nullable UADeferredScheduleResult *)cachedResultForKey:(NSArray *)cacheKey speculativeOnly:(BOOL)speculativeOnly {
+    UADeferredScheduleAPIClientCachedResult *cached = [self.resultCache objectForKey:cacheKey];
+    if (!cached || (speculativeOnly && !cached.isSpeculative)) {
+        return nil;
+    }
+
+    NSTimeInterval cacheTime = cached.isSpeculative ? self.speculativeResultCacheTime : self.resultCacheTime;
+    if ([[NSDate date] timeIntervalSinceDate:cached.date] >= cacheTime) {
+        return nil;
+    }
+
+    return cached.result;
+}
+
+- (void)cacheResult:(UADeferredScheduleResult *)result forKey:(NSArray *)cacheKey speculative:(BOOL)speculative {
+    UADeferredScheduleAPIClientCachedResult *cachedResult = [[UADeferredScheduleAPIClientCachedResult alloc] init];
+    cachedResult.result = result;
+    cachedResult.date = [NSDate date];
+    cachedResult.speculative = speculative;
+    [self.resultCache setObject:cachedResult forKey:cacheKey];
+}
+
+/**
+ * Performs the deferred schedule request, retrying once with a new token if unauthorized.
+ * Blocks the calling thread, must be called on the request dispatcher.
+ */
+- (nullable UADeferredScheduleResult *)requestResultWithURL:(NSURL *)URL body:(NSData *)body error:(NSError **)error {
+    NSString *token = [self authToken];
+
+    if (!token) {
+        *error = [self missingAuthTokenError];
+        return nil;
+    }
+
+    UADeferredScheduleAPIClientResponse *response = [self performRequest:token URL:URL body:body];
+
+    if (response.error) {
+        UA_LTRACE(@"Deferred schedule request failed with error %@", response.error);
+        *error = [self timeoutError];
+        return nil;
+    }
+
+    // If unauthorized, manually expire the token and try again.
+    if (response.status == 401){
+        [self.authManager expireToken:token];
+
+        token = [self authToken];
+
+        if (!token) {
+            *error = [self missingAuthTokenError];
+            return nil;
+        }
+
+        response = [self performRequest:token URL:URL body:body];
+
+        if (response.error) {
+            UA_LTRACE(@"Deferred schedule request failed with error %@", response.error);
+            *error = [self timeoutError];
+            return nil;
+        }
+    }
+
+    // Server error or rate limited
+    if (response.status >= 500 || response.status == 429) {
+        UA_LTRACE(@"Deferred schedule request failed with server status: %lu", (unsigned long)response.status);
+        *error = [self serverError];
+        return nil;
+    }
+
+    // Unsuccessful HTTP response
+    if (!(response.status >= 200 && response.status <= 299)) {
+        UA_LTRACE(@"Deferred schedule request failed with status: %lu", (unsigned long)response.status);
+        *error = [self unsuccessfulStatusError];
+        return nil;
+    }
+
+    // Successful HTTP response
+    UA_LTRACE(@"Deferred schedule request succeeded with status: %lu", (unsigned long)response.status);
+
+    return [self parseResponseBody:response.body];
+}
+
 - (NSError *)missingAuthTokenError {
     NSString *msg = [NSString stringWithFormat:@"Unable to retrieve auth token"];
 
@@ -168,6 +289,16 @@ attributeOverrides:(UAAttributePendingMutations *)attributeOverrides
     return error;
 }
 
+- (NSError *)serverError {
+    NSString *msg = [NSString stringWithFormat:@"Deferred schedule client encountered a server error"];
+
+    NSError *error = [NSError errorWithDomain:UADeferredScheduleAPIClientErrorDomain
+                                         code:UADeferredScheduleAPIClientErrorServerError
+                                     userInfo:@{NSLocalizedDescriptionKey:msg}];
+
+    return error;
+}
+
 - (NSString *)authToken {
     __block NSString *authToken;
     __block UASemaphore *semaphore = [UASemaphore semaphore];
@@ -184,17 +315,9 @@ attributeOverrides:(UAAttributePendingMutations *)attributeOverrides
 
 - (UADeferredScheduleAPIClientResponse *)performRequest:(NSString *)authToken
                                                     URL:(NSURL *)URL
-                                              channelID:(NSString *)channelID
-                                         triggerContext:(UAScheduleTriggerContext *)triggerContext
-                                           tagOverrides:(NSArray<UATagGroupsMutation *> *)tagOverrides
-                                     attributeOverrides:(UAAttributePendingMutations *)attributeOverrides {
-
-    UARequest *request = [self requestWithAuthToken:authToken
-                                                URL:URL
-                                          channelID:channelID
-                                     triggerContext:triggerContext
-                                       tagOverrides:tagOverrides
-                                 attributeOverrides:attributeOverrides];
+                                                   body:(NSData *)body {
+
+    UARequest *request = [self requestWithAuthToken:authToken URL:URL body:body];
 
     __block UADeferredScheduleAPIClientResponse *clientResponse;
     __block UASemaphore *semaphore = [UASemaphore semaphore];
@@ -258,26 +381,20 @@ attributeOverrides:(UAAttributePendingMutations *)attributeOverrides
         payload[kUADeferredScheduleAPIClientAttributeOverridesKey] = attributeMutationsPayload;
     }
 
+    // Sorted keys keep the body stable so it can be used as a cache key
     return [UAJSONSerialization dataWithJSONObject:payload
-                                           options:0
+                                           options:NSJSONWritingSortedKeys
                                              error:nil];
 }
 
 - (UARequest *)requestWithAuthToken:(NSString *)authToken
                                 URL:(NSURL *)URL
-                          channelID:(NSString *)channelID
-                     triggerContext:(nullable UAScheduleTriggerContext *)triggerContext
-                       tagOverrides:(NSArray<UATagGroupsMutation *> *)tagOverrides
-                 attributeOverrides:(UAAttributePendingMutations *)attributeOverrides {
+                               body:(NSData *)body {
 
     UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder * _Nonnull builder) {
         builder.method = @"POST";
         builder.URL = URL;
-
-        builder.body = [self requestBodyWithChannelID:channelID
-                                       triggerContext:triggerContext
-                                         tagOverrides:tagOverrides
-                                   attributeOverrides:attributeOverrides];
+        builder.body = body;
 
         [builder setValue:@"application/vnd.urbanairship+json; version=3;" forHeader:@"Accept"];
         [builder setValue:[@"Bearer " stringByAppendingString:authToken] forHeader:@"Authorization"];
@@ -0,0 +1,60 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Represents the possible error conditions when deserializing a frequency constraint from JSON.
+ */
+typedef NS_ENUM(NSUInteger, UAFrequencyConstraintErrorCode) {
+    /**
+     * Indicates an error with the JSON definition.
+     */
+    UAFrequencyConstraintErrorCodeInvalidJSON,
+};
+
+/**
+ * Caps how many times the schedules referencing it may execute within a sliding time window.
+ */
+@interface UAFrequencyConstraint : NSObject
+
+/**
+ * The constraint identifier.
+ */
+@property(nonatomic, readonly) NSString *identifier;
+
+/**
+ * The length of the sliding window in seconds.
+ */
+@property(nonatomic, readonly) NSTimeInterval range;
+
+/**
+ * The max number of executions within the window.
+ */
+@property(nonatomic, readonly) NSUInteger count;
+
+/**
+ * Factory method.
+ *
+ * @param identifier The constraint identifier.
+ * @param range The length of the sliding window in seconds.
+ * @param count The max number of executions within the window.
+ * @return A frequency constraint.
+ */
++ (instancetype)constraintWithIdentifier:(NSString *)identifier
+                                   range:(NSTimeInterval)range
+                                   count:(NSUInteger)count;
+
+/**
+ * Class factory method for constructing a frequency constraint from JSON.
+ *
+ * @param JSON JSON object that defines the constraint.
+ * @param error An NSError pointer for storing errors, if applicable.
+ * @return A frequency constraint or nil if JSON parsing fails.
+ */
++ (nullable instancetype)constraintWithJSON:(id)JSON error:(NSError * _Nullable *)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,96 @@
+/* Copyright Airship and Contributors */
+
+#import "UAFrequencyConstraint+Internal.h"
+#import "NSDictionary+UAAdditions.h"
+
+NSString *const UAFrequencyConstraintErrorDomain = @"com.urbanairship.frequency_constraint";
+
+NSString *const UAFrequencyConstraintIDKey = @"id";
+NSString *const UAFrequencyConstraintRangeKey = @"range";
+NSString *const UAFrequencyConstraintBoundaryKey = @"boundary";
+
+@interface UAFrequencyConstraint()
+@property(nonatomic, copy) NSString *identifier;
+@property(nonatomic, assign) NSTimeInterval range;
+@property(nonatomic, assign) NSUInteger count;
+@end
+
+@implementation UAFrequencyConstraint
+
+- (instancetype)initWithIdentifier:(NSString *)identifier
+                             range:(NSTimeInterval)range
+                             count:(NSUInteger)count {
+    self = [super init];
+    if (self) {
+        self.identifier = identifier;
+        self.range = range;
+        self.count = count;
+    }
+    return self;
+}
+
++ (instancetype)constraintWithIdentifier:(NSString *)identifier
+                                   range:(NSTimeInterval)range
+                                   count:(NSUInteger)count {
+    return [[self alloc] initWithIdentifier:identifier range:range count:count];
+}
+
++ (nullable instancetype)constraintWithJSON:(id)JSON error:(NSError * _Nullable *)error {
+    if (![JSON isKindOfClass:[NSDictionary class]]) {
+        if (error) {
+            NSString *msg = [NSString stringWithFormat:@"Attempted to deserialize invalid object: %@", JSON];
+            *error =  [NSError errorWithDomain:UAFrequencyConstraintErrorDomain
+                                          code:UAFrequencyConstraintErrorCodeInvalidJSON
+                                      userInfo:@{NSLocalizedDescriptionKey:msg}];
+        }
+
+        return nil;
+    }
+
+    NSString *identifier = [JSON stringForKey:UAFrequencyConstraintIDKey defaultValue:nil];
+    NSNumber *range = [JSON numberForKey:UAFrequencyConstraintRangeKey defaultValue:nil];
+    NSNumber *count = [JSON numberForKey:UAFrequencyConstraintBoundaryKey defaultValue:nil];
+
+    if (!identifier || range.doubleValue <= 0 || !count || count.integerValue < 0) {
+        if (error) {
+            NSString *msg = [NSString stringWithFormat:@"Frequency constraint requires an ID, a positive range, and a boundary: %@", JSON];
+            *error =  [NSError errorWithDomain:UAFrequencyConstraintErrorDomain
+                                          code:UAFrequencyConstraintErrorCodeInvalidJSON
+                                      userInfo:@{NSLocalizedDescriptionKey:msg}];
+        }
+
+        return nil;
+    }
+
+    return [self constraintWithIdentifier:identifier range:range.doubleValue count:count.unsignedIntegerValue];
+}
+
+- (BOOL)isEqual:(id)other {
+    if (other == self) {
+        return YES;
+    }
+
+    if (![other isKindOfClass:[UAFrequencyConstraint class]]) {
+        return NO;
+    }
+
+    UAFrequencyConstraint *constraint = (UAFrequencyConstraint *)other;
+    return [self.identifier isEqualToString:constraint.identifier] &&
+        self.range == constraint.range &&
+        self.count == constraint.count;
+}
+
+- (NSUInteger)hash {
+    NSUInteger result = 1;
+    result = 31 * result + [self.identifier hash];
+    result = 31 * result + self.range;
+    result = 31 * result + self.count;
+    return result;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<UAFrequencyConstraint: %@ count: %lu range: %f>",
+            self.identifier, (unsigned long)self.count, self.range];
+}
+
+@end
@@ -0,0 +1,37 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+#import <CoreData/CoreData.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * CoreData class representing the backing data for
+ * a UAFrequencyConstraint.
+ *
+ * This class should not ordinarily be used directly.
+ */
+@interface UAFrequencyConstraintData : NSManagedObject
+
+///---------------------------------------------------------------------------------------
+/// @name Frequency Constraint Data Internal Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The constraint identifier.
+ */
+@property (nullable, nonatomic, copy) NSString *identifier;
+
+/**
+ * The length of the sliding window in seconds.
+ */
+@property (nullable, nonatomic, retain) NSNumber *range;
+
+/**
+ * The max number of executions within the window.
+ */
+@property (nullable, nonatomic, retain) NSNumber *count;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,11 @@
+/* Copyright Airship and Contributors */
+
+#import "UAFrequencyConstraintData+Internal.h"
+
+@implementation UAFrequencyConstraintData
+
+@dynamic identifier;
+@dynamic range;
+@dynamic count;
+
+@end
@@ -0,0 +1,67 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+#import "UAAirshipAutomationCoreImport.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class UAAutomationStore;
+@class UAFrequencyConstraint;
+
+/**
+ * Counts schedule executions against frequency constraints. The constraints and their occurrences
+ * are held in memory so checks never wait on the store, and every change is persisted to the
+ * automation store in the background.
+ */
+@interface UAFrequencyLimitManager : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Frequency Limit Manager Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method. Loads the stored constraints and occurrences from the store.
+ *
+ * @param automationStore The automation store.
+ * @return A frequency limit manager.
+ */
++ (instancetype)managerWithAutomationStore:(UAAutomationStore *)automationStore;
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param automationStore The automation store.
+ * @param date The date.
+ * @return A frequency limit manager.
+ */
++ (instancetype)managerWithAutomationStore:(UAAutomationStore *)automationStore date:(UADate *)date;
+
+/**
+ * Replaces the constraints. Occurrences of removed constraints, or of constraints whose range
+ * changed, are dropped.
+ *
+ * @param constraints The constraints.
+ */
+- (void)updateConstraints:(NSArray<UAFrequencyConstraint *> *)constraints;
+
+/**
+ * Checks if any of the constraints has reached its count within its range. Unknown
+ * constraint IDs never limit.
+ *
+ * @param constraintIDs The constraint IDs.
+ * @return `YES` if over the limit, otherwise `NO`.
+ */
+- (BOOL)isOverLimit:(nullable NSArray<NSString *> *)constraintIDs;
+
+/**
+ * Checks the constraints and, if none of them is over the limit, counts an occurrence
+ * against each of them.
+ *
+ * @param constraintIDs The constraint IDs.
+ * @return `YES` if the occurrence was counted, `NO` if over the limit.
+ */
+- (BOOL)checkAndIncrement:(nullable NSArray<NSString *> *)constraintIDs;
+
+@end
+
+NS_ASSUME_NONNULL_END
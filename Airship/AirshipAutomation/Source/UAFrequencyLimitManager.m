@@ -0,0 +1,155 @@
+/* Copyright Airship and Contributors */
+
+#import "UAFrequencyLimitManager+Internal.h"
+#import "UAFrequencyConstraint+Internal.h"
+#import "UAAutomationStore+Internal.h"
+
+@interface UAFrequencyLimitManager ()
+@property (nonatomic, strong) UAAutomationStore *automationStore;
+@property (nonatomic, strong) UADate *date;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, UAFrequencyConstraint *> *constraints;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<NSDate *> *> *occurrences;
+@property (nonatomic, assign) BOOL constraintsUpdated;
+@end
+
+@implementation UAFrequencyLimitManager
+
+- (instancetype)initWithAutomationStore:(UAAutomationStore *)automationStore date:(UADate *)date {
+    self = [super init];
+    if (self) {
+        self.automationStore = automationStore;
+        self.date = date;
+        self.constraints = [NSMutableDictionary dictionary];
+        self.occurrences = [NSMutableDictionary dictionary];
+        [self loadFromStore];
+    }
+
+    return self;
+}
+
++ (instancetype)managerWithAutomationStore:(UAAutomationStore *)automationStore {
+    return [[self alloc] initWithAutomationStore:automationStore date:[[UADate alloc] init]];
+}
+
++ (instancetype)managerWithAutomationStore:(UAAutomationStore *)automationStore date:(UADate *)date {
+    return [[self alloc] initWithAutomationStore:automationStore date:date];
+}
+
+- (void)loadFromStore {
+    // Store blocks run serially, so the load finishes before any schedule is read from the store
+    UA_WEAKIFY(self)
+    [self.automationStore getFrequencyConstraints:^(NSArray<UAFrequencyConstraint *> *constraints,
+                                                    NSDictionary<NSString *, NSArray<NSDate *> *> *occurrences) {
+        UA_STRONGIFY(self)
+        @synchronized (self) {
+            if (self.constraintsUpdated) {
+                // Newer constraints were set while loading, keep the stored occurrences that still apply
+                for (UAFrequencyConstraint *constraint in constraints) {
+                    NSArray<NSDate *> *stored = occurrences[constraint.identifier];
+                    if (stored.count && self.constraints[constraint.identifier].range == constraint.range) {
+                        [self.occurrences[constraint.identifier] insertObjects:stored
+                                                                     atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, stored.count)]];
+                    }
+                }
+                return;
+            }
+
+            for (UAFrequencyConstraint *constraint in constraints) {
+                self.constraints[constraint.identifier] = constraint;
+                self.occurrences[constraint.identifier] = [occurrences[constraint.identifier] mutableCopy] ?: [NSMutableArray array];
+            }
+        }
+    }];
+}
+
+- (void)updateConstraints:(NSArray<UAFrequencyConstraint *> *)constraints {
+    @synchronized (self) {
+        self.constraintsUpdated = YES;
+
+        NSMutableDictionary<NSString *, UAFrequencyConstraint *> *updated = [NSMutableDictionary dictionary];
+        NSMutableDictionary<NSString *, NSMutableArray<NSDate *> *> *occurrences = [NSMutableDictionary dictionary];
+        for (UAFrequencyConstraint *constraint in constraints) {
+            UAFrequencyConstraint *existing = self.constraints[constraint.identifier];
+            updated[constraint.identifier] = constraint;
+
+            if (existing && existing.range == constraint.range) {
+                occurrences[constraint.identifier] = self.occurrences[constraint.identifier];
+            } else {
+                occurrences[constraint.identifier] = [NSMutableArray array];
+            }
+        }
+
+        self.constraints = updated;
+        self.occurrences = occurrences;
+    }
+
+    [self.automationStore saveFrequencyConstraints:constraints completionHandler:nil];
+}
+
+- (BOOL)isOverLimit:(NSArray<NSString *> *)constraintIDs {
+    if (!constraintIDs.count) {
+        return NO;
+    }
+
+    @synchronized (self) {
+        return [self isOverLimitWithIDs:constraintIDs now:self.date.now];
+    }
+}
+
+- (BOOL)checkAndIncrement:(NSArray<NSString *> *)constraintIDs {
+    if (!constraintIDs.count) {
+        return YES;
+    }
+
+    NSDate *now = self.date.now;
+    NSMutableArray<NSString *> *countedIDs = [NSMutableArray array];
+
+    @synchronized (self) {
+        if ([self isOverLimitWithIDs:constraintIDs now:now]) {
+            return NO;
+        }
+
+        for (NSString *constraintID in constraintIDs) {
+            if (self.constraints[constraintID]) {
+                [self.occurrences[constraintID] addObject:now];
+                [countedIDs addObject:constraintID];
+            }
+        }
+    }
+
+    if (countedIDs.count) {
+        [self.automationStore addFrequencyOccurrencesForConstraintIDs:countedIDs date:now completionHandler:nil];
+    }
+
+    return YES;
+}
+
+/**
+ * Must be called while synchronized on self.
+ */
+- (BOOL)isOverLimitWithIDs:(NSArray<NSString *> *)constraintIDs now:(NSDate *)now {
+    for (NSString *constraintID in constraintIDs) {
+        UAFrequencyConstraint *constraint = self.constraints[constraintID];
+        if (!constraint) {
+            continue;
+        }
+
+        NSMutableArray<NSDate *> *occurrences = self.occurrences[constraintID];
+        NSDate *windowStart = [now dateByAddingTimeInterval:-constraint.range];
+
+        // Occurrences are in order, so drop the ones that slid out of the window from the front
+        NSUInteger expired = 0;
+        while (expired < occurrences.count && [occurrences[expired] compare:windowStart] != NSOrderedDescending) {
+            expired++;
+        }
+        [occurrences removeObjectsInRange:NSMakeRange(0, expired)];
+
+        if (occurrences.count >= constraint.count) {
+            return YES;
+        }
+    }
+
+    return NO;
+}
+
+@end
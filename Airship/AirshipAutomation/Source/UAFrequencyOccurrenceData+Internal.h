@@ -0,0 +1,32 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+#import <CoreData/CoreData.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * CoreData class representing a single execution counted against
+ * a frequency constraint.
+ *
+ * This class should not ordinarily be used directly.
+ */
+@interface UAFrequencyOccurrenceData : NSManagedObject
+
+///---------------------------------------------------------------------------------------
+/// @name Frequency Occurrence Data Internal Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The identifier of the constraint the occurrence counts against.
+ */
+@property (nullable, nonatomic, copy) NSString *constraintID;
+
+/**
+ * The time of the execution.
+ */
+@property (nullable, nonatomic, retain) NSDate *timestamp;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,10 @@
+/* Copyright Airship and Contributors */
+
+#import "UAFrequencyOccurrenceData+Internal.h"
+
+@implementation UAFrequencyOccurrenceData
+
+@dynamic constraintID;
+@dynamic timestamp;
+
+@end
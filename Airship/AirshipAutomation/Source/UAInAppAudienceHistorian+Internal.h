@@ -17,6 +17,16 @@ NS_ASSUME_NONNULL_BEGIN
 + (instancetype)historianWithChannel:(UAChannel *)channel
                            namedUser:(UANamedUser *)namedUser;
 
+/**
+ * The maximum age of a record before it is dropped from the history. Defaults to 0, which keeps all records.
+ */
+@property (nonatomic, assign) NSTimeInterval maxRecordAge;
+
+/**
+ * A version stamp that changes whenever records are added or dropped.
+ */
+@property (nonatomic, readonly) NSUInteger version;
+
 /**
  * Gets tag history newer than the provided date.
  * @param date The date.
@@ -31,6 +41,20 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (NSArray<UAAttributePendingMutations *> *)attributeHistoryNewerThan:(NSDate *)date;
 
+/**
+ * Gets the date of the oldest tag record newer than the provided date.
+ * @param date The date.
+ * @return The record date, or `nil` if there are no newer records.
+ */
+- (nullable NSDate *)oldestTagRecordDateNewerThan:(NSDate *)date;
+
+/**
+ * Gets the date of the oldest attribute record newer than the provided date.
+ * @param date The date.
+ * @return The record date, or `nil` if there are no newer records.
+ */
+- (nullable NSDate *)oldestAttributeRecordDateNewerThan:(NSDate *)date;
+
 @end
 
 NS_ASSUME_NONNULL_END
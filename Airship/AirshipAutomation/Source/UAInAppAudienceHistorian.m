@@ -23,6 +23,11 @@ NS_ASSUME_NONNULL_END
 @property (nonatomic, strong) UANamedUser *namedUser;
 @property (nonatomic, strong) NSMutableArray *tagRecords;
 @property (nonatomic, strong) NSMutableArray *attributeRecords;
+
+// Whether the records of each list were uploaded in date order
+@property (nonatomic, assign) BOOL tagRecordsOrdered;
+@property (nonatomic, assign) BOOL attributeRecordsOrdered;
+@property (nonatomic, assign) NSUInteger version;
 @end
 
 @implementation UAInAppAudienceHistorian
@@ -36,6 +41,8 @@ NS_ASSUME_NONNULL_END
         self.namedUser = namedUser;
         self.tagRecords = [NSMutableArray array];
         self.attributeRecords = [NSMutableArray array];
+        self.tagRecordsOrdered = YES;
+        self.attributeRecordsOrdered = YES;
 
         [[NSNotificationCenter defaultCenter] addObserver:self
                                                  selector:@selector(uploadedChannelTagGroupsMutation:)
@@ -72,7 +79,7 @@ NS_ASSUME_NONNULL_END
     NSString *identifier = [notification.userInfo objectForKey:UAChannelUploadedAudienceMutationNotificationIdentifierKey];
 
     if (mutation && date && identifier) {
-        [self.tagRecords addObject:@{ kUAInAppAudienceHistorianRecordType: @(UAInAppAudienceRecordTypeChannel),
+        [self addTagRecord:@{ kUAInAppAudienceHistorianRecordType: @(UAInAppAudienceRecordTypeChannel),
                                       kUAInAppAudienceHistorianRecordDate: date,
                                       kUAInAppAudienceHistorianRecordMutation: mutation,
                                       kUAInAppAudienceHistorianRecordIdentifier: identifier }];
@@ -85,7 +92,7 @@ NS_ASSUME_NONNULL_END
     NSString *identifier = [notification.userInfo objectForKey:UAChannelUploadedAudienceMutationNotificationIdentifierKey];
 
     if (mutations && date && identifier) {
-        [self.attributeRecords addObject:@{ kUAInAppAudienceHistorianRecordType: @(UAInAppAudienceRecordTypeChannel),
+        [self addAttributeRecord:@{ kUAInAppAudienceHistorianRecordType: @(UAInAppAudienceRecordTypeChannel),
                                             kUAInAppAudienceHistorianRecordDate: date,
                                             kUAInAppAudienceHistorianRecordMutation: mutations,
                                             kUAInAppAudienceHistorianRecordIdentifier: identifier }];
@@ -98,7 +105,7 @@ NS_ASSUME_NONNULL_END
     NSString *identifier = [notification.userInfo objectForKey:UANamedUserUploadedAudienceMutationNotificationIdentifierKey];
 
     if (mutation && date && identifier) {
-        [self.tagRecords addObject:@{ kUAInAppAudienceHistorianRecordType: @(UAInAppAudienceRecordTypeNamedUser),
+        [self addTagRecord:@{ kUAInAppAudienceHistorianRecordType: @(UAInAppAudienceRecordTypeNamedUser),
                                       kUAInAppAudienceHistorianRecordDate: date,
                                       kUAInAppAudienceHistorianRecordMutation: mutation,
                                       kUAInAppAudienceHistorianRecordIdentifier: identifier }];
@@ -112,19 +119,84 @@ NS_ASSUME_NONNULL_END
     NSString *identifier = [notification.userInfo objectForKey:UANamedUserUploadedAudienceMutationNotificationIdentifierKey];
 
     if (mutations && date && identifier) {
-        [self.attributeRecords addObject:@{ kUAInAppAudienceHistorianRecordType: @(UAInAppAudienceRecordTypeNamedUser),
+        [self addAttributeRecord:@{ kUAInAppAudienceHistorianRecordType: @(UAInAppAudienceRecordTypeNamedUser),
                                             kUAInAppAudienceHistorianRecordDate: date,
                                             kUAInAppAudienceHistorianRecordMutation: mutations,
                                             kUAInAppAudienceHistorianRecordIdentifier: identifier }];
     }
 }
 
-- (NSArray *)mutationsFromRecords:(NSArray *)records newerThan:(NSDate *)date {
+- (void)addTagRecord:(NSDictionary *)record {
+    @synchronized (self) {
+        self.tagRecordsOrdered = [self addRecord:record toRecords:self.tagRecords ordered:self.tagRecordsOrdered];
+    }
+}
+
+- (void)addAttributeRecord:(NSDictionary *)record {
+    @synchronized (self) {
+        self.attributeRecordsOrdered = [self addRecord:record toRecords:self.attributeRecords ordered:self.attributeRecordsOrdered];
+    }
+}
+
+/**
+ * Appends a record and drops any that are older than the max record age.
+ *
+ * @return `YES` if the records are still in date order, otherwise `NO`.
+ */
+- (BOOL)addRecord:(NSDictionary *)record toRecords:(NSMutableArray *)records ordered:(BOOL)ordered {
+    NSDate *date = record[kUAInAppAudienceHistorianRecordDate];
+    if (ordered && records.count && [date compare:[records.lastObject objectForKey:kUAInAppAudienceHistorianRecordDate]] == NSOrderedAscending) {
+        ordered = NO;
+    }
+
+    [records addObject:record];
+    self.version++;
+
+    if (self.maxRecordAge > 0) {
+        NSDate *cutoff = [NSDate dateWithTimeIntervalSinceNow:-self.maxRecordAge];
+        if (ordered) {
+            [records removeObjectsInRange:NSMakeRange(0, [self indexOfFirstRecord:records newerThan:cutoff])];
+        } else {
+            NSIndexSet *expired = [records indexesOfObjectsPassingTest:^BOOL(id obj, NSUInteger idx, BOOL *stop) {
+                return [obj[kUAInAppAudienceHistorianRecordDate] compare:cutoff] == NSOrderedAscending;
+            }];
+            [records removeObjectsAtIndexes:expired];
+        }
+    }
+
+    return ordered;
+}
+
+/**
+ * Binary searches date ordered records for the first record that is not older than the date.
+ */
+- (NSUInteger)indexOfFirstRecord:(NSArray *)records newerThan:(NSDate *)date {
+    NSUInteger low = 0;
+    NSUInteger high = records.count;
+
+    while (low < high) {
+        NSUInteger mid = low + (high - low) / 2;
+        if ([records[mid][kUAInAppAudienceHistorianRecordDate] compare:date] == NSOrderedAscending) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+- (NSArray *)mutationsFromRecords:(NSArray *)records ordered:(BOOL)ordered newerThan:(NSDate *)date {
     NSString *namedUserIdentifier = self.namedUser.identifier;
     NSMutableArray *mutations = [NSMutableArray array];
 
-    for (id record in records) {
-        if ([record[kUAInAppAudienceHistorianRecordDate] compare:date] == NSOrderedAscending) {
+    // Ordered records only need to be scanned from the first match
+    NSUInteger start = ordered ? [self indexOfFirstRecord:records newerThan:date] : 0;
+
+    for (NSUInteger i = start; i < records.count; i++) {
+        id record = records[i];
+
+        if (!ordered && [record[kUAInAppAudienceHistorianRecordDate] compare:date] == NSOrderedAscending) {
             continue;
         }
 
@@ -138,12 +210,45 @@ NS_ASSUME_NONNULL_END
     return mutations;
 }
 
+- (nullable NSDate *)oldestDateFromRecords:(NSArray *)records ordered:(BOOL)ordered newerThan:(NSDate *)date {
+    if (ordered) {
+        NSUInteger index = [self indexOfFirstRecord:records newerThan:date];
+        return index < records.count ? records[index][kUAInAppAudienceHistorianRecordDate] : nil;
+    }
+
+    NSDate *oldest = nil;
+    for (id record in records) {
+        NSDate *recordDate = record[kUAInAppAudienceHistorianRecordDate];
+        if ([recordDate compare:date] != NSOrderedAscending && (!oldest || [recordDate compare:oldest] == NSOrderedAscending)) {
+            oldest = recordDate;
+        }
+    }
+
+    return oldest;
+}
+
 - (NSArray<UATagGroupsMutation *> *)tagHistoryNewerThan:(NSDate *)date {
-    return [self mutationsFromRecords:self.tagRecords newerThan:date];
+    @synchronized (self) {
+        return [self mutationsFromRecords:self.tagRecords ordered:self.tagRecordsOrdered newerThan:date];
+    }
+}
+
+- (NSArray<UAAttributePendingMutations *> *)attributeHistoryNewerThan:(NSDate *)date {
+    @synchronized (self) {
+        return [self mutationsFromRecords:self.attributeRecords ordered:self.attributeRecordsOrdered newerThan:date];
+    }
 }
 
-- (NSArray<UATagGroupsMutation *> *)attributeHistoryNewerThan:(NSDate *)date {
-    return [self mutationsFromRecords:self.attributeRecords newerThan:date];
+- (nullable NSDate *)oldestTagRecordDateNewerThan:(NSDate *)date {
+    @synchronized (self) {
+        return [self oldestDateFromRecords:self.tagRecords ordered:self.tagRecordsOrdered newerThan:date];
+    }
+}
+
+- (nullable NSDate *)oldestAttributeRecordDateNewerThan:(NSDate *)date {
+    @synchronized (self) {
+        return [self oldestDateFromRecords:self.attributeRecords ordered:self.attributeRecordsOrdered newerThan:date];
+    }
 }
 
 @end
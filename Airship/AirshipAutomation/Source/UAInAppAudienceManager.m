@@ -14,6 +14,22 @@ NSTimeInterval const UAInAppAudienceManagerDefaultPreferLocalAudienceDataTimeSec
 
 NSString * const UAInAppAudienceManagerErrorDomain = @"com.urbanairship.in_app_audience_manager";
 
+static NSString * const UAInAppAudienceManagerTagOverridesKey = @"tag_overrides";
+static NSString * const UAInAppAudienceManagerAttributeOverridesKey = @"attribute_overrides";
+static NSString * const UAInAppAudienceManagerEffectiveTagsKey = @"effective_tags";
+
+/**
+ * A merged audience view, valid while its stamp matches and until its expiry date.
+ */
+@interface UAInAppAudienceCachedView : NSObject
+@property (nonatomic, copy) NSArray *stamp;
+@property (nonatomic, strong, nullable) NSDate *expiryDate;
+@property (nonatomic, strong) id value;
+@end
+
+@implementation UAInAppAudienceCachedView
+@end
+
 @interface UAInAppAudienceManager ()
 
 @property (nonatomic, strong) UAPreferenceDataStore *dataStore;
@@ -23,6 +39,18 @@ NSString * const UAInAppAudienceManagerErrorDomain = @"com.urbanairship.in_app_a
 @property (nonatomic, strong) UADate *currentTime;
 @property (nonatomic, strong) UANamedUser *namedUser;
 @property (nonatomic, strong) UAChannel *channel;
+@property (nonatomic, strong, nullable) UATagGroups *refreshingTagGroups;
+@property (nonatomic, strong) NSMutableArray<void (^)(void)> *refreshCompletionHandlers;
+
+/**
+ * Merged tag and attribute views shared by audience checks until their inputs change.
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, UAInAppAudienceCachedView *> *cachedViews;
+
+/**
+ * Bumped whenever the lookup response changes.
+ */
+@property (nonatomic, assign) NSUInteger lookupVersion;
 
 @property (nonatomic, readonly) NSTimeInterval maxSentMutationAge;
 
@@ -48,7 +76,10 @@ NSString * const UAInAppAudienceManagerErrorDomain = @"com.urbanairship.in_app_a
         self.currentTime = currentTime;
         self.namedUser = namedUser;
         self.channel = channel;
+        self.refreshCompletionHandlers = [NSMutableArray array];
+        self.cachedViews = [NSMutableDictionary dictionary];
         self.lookupAPIClient.enabled = self.enabled;
+        [self updateHistorianMaxRecordAge];
 
         [[NSNotificationCenter defaultCenter] addObserver:self
                                                  selector:@selector(namedUserChanged:)
@@ -106,6 +137,7 @@ NSString * const UAInAppAudienceManagerErrorDomain = @"com.urbanairship.in_app_a
 
 - (void)setPreferLocalTagDataTime:(NSTimeInterval)preferLocalTagDataTime {
     [self.dataStore setDouble:preferLocalTagDataTime forKey:kUAInAppAudienceManagerPreferLocalTagDataTimeKey];
+    [self updateHistorianMaxRecordAge];
 }
 
 - (NSTimeInterval)cacheMaxAgeTime {
@@ -122,25 +154,60 @@ NSString * const UAInAppAudienceManagerErrorDomain = @"com.urbanairship.in_app_a
 
 - (void)setCacheStaleReadTime:(NSTimeInterval)cacheStaleReadTime {
     self.cache.staleReadTime = cacheStaleReadTime;
+    [self updateHistorianMaxRecordAge];
 }
 
 - (NSTimeInterval)maxSentMutationAge {
     return self.cache.staleReadTime + self.preferLocalTagDataTime;
 }
 
+- (void)updateHistorianMaxRecordAge {
+    // Keep history for as long as it can be applied to tag or attribute overrides
+    self.historian.maxRecordAge = MAX(self.maxSentMutationAge, UAInAppAudienceManagerDefaultPreferLocalAudienceDataTimeSeconds);
+}
+
 - (NSError *)errorWithCode:(UAInAppAudienceManagerErrorCode)code message:(NSString *)message {
     return [NSError errorWithDomain:UAInAppAudienceManagerErrorDomain
                                code:code
                            userInfo:@{NSLocalizedDescriptionKey:message}];
 }
 
-- (NSArray<UATagGroupsMutation *> *)tagOverrides {
-    NSDate *date = [self.currentTime.now dateByAddingTimeInterval:-self.preferLocalTagDataTime];
-    return [self tagOverridesNewerThan:date];
+#pragma mark -
+#pragma mark Cached Views
+
+- (nullable id)cachedViewForKey:(NSString *)key stamp:(NSArray *)stamp {
+    NSDate *now = self.currentTime.now;
+
+    @synchronized (self) {
+        UAInAppAudienceCachedView *view = self.cachedViews[key];
+        if (!view || ![view.stamp isEqualToArray:stamp]) {
+            return nil;
+        }
+
+        if (view.expiryDate && [now compare:view.expiryDate] != NSOrderedAscending) {
+            return nil;
+        }
+
+        return view.value;
+    }
 }
 
-- (NSArray<UATagGroupsMutation *> *)tagOverridesNewerThan:(NSDate *)date {
-    NSMutableArray *overrides = [[self.historian tagHistoryNewerThan:date] mutableCopy];
+- (void)cacheView:(id)value forKey:(NSString *)key stamp:(NSArray *)stamp expiryDate:(nullable NSDate *)expiryDate {
+    UAInAppAudienceCachedView *view = [[UAInAppAudienceCachedView alloc] init];
+    view.stamp = stamp;
+    view.expiryDate = expiryDate;
+    view.value = value;
+
+    @synchronized (self) {
+        self.cachedViews[key] = view;
+    }
+}
+
+/**
+ * The locally pending tag mutations, applied on top of the tag history.
+ */
+- (NSArray<UATagGroupsMutation *> *)localTagOverrides {
+    NSMutableArray *overrides = [NSMutableArray array];
 
     [overrides addObjectsFromArray:self.namedUser.pendingTagGroups];
     [overrides addObjectsFromArray:self.channel.pendingTagGroups];
@@ -150,29 +217,113 @@ NSString * const UAInAppAudienceManagerErrorDomain = @"com.urbanairship.in_app_a
         [overrides addObject:[UATagGroupsMutation mutationToSetTags:self.channel.tags group:@"device"]];
     }
 
+    return overrides;
+}
+
+/**
+ * The locally pending attribute mutations, applied on top of the attribute history.
+ */
+- (NSArray<UAAttributePendingMutations *> *)localAttributeOverrides {
+    NSMutableArray *overrides = [NSMutableArray array];
+
+    UAAttributePendingMutations *namedUserAttributes = self.namedUser.pendingAttributes;
+    if (namedUserAttributes) {
+        [overrides addObject:namedUserAttributes];
+    }
+
+    UAAttributePendingMutations *channelAttributes = self.channel.pendingAttributes;
+    if (channelAttributes) {
+        [overrides addObject:channelAttributes];
+    }
+
+    return overrides;
+}
+
+/**
+ * The version stamp of a merged view. Local overrides are compared by value, which is cheap
+ * next to collapsing them with the history.
+ */
+- (NSArray *)stampWithLocalOverrides:(NSArray *)localOverrides {
+    return @[@(self.historian.version),
+             @(self.preferLocalTagDataTime),
+             self.namedUser.identifier ?: [NSNull null],
+             localOverrides];
+}
+
+#pragma mark -
+#pragma mark Overrides
+
+- (NSArray<UATagGroupsMutation *> *)tagOverrides {
+    NSArray *localOverrides = [self localTagOverrides];
+    NSArray *stamp = [self stampWithLocalOverrides:localOverrides];
+
+    NSArray<UATagGroupsMutation *> *overrides = [self cachedViewForKey:UAInAppAudienceManagerTagOverridesKey stamp:stamp];
+    if (overrides) {
+        return overrides;
+    }
+
+    NSDate *date = [self.currentTime.now dateByAddingTimeInterval:-self.preferLocalTagDataTime];
+    overrides = [self tagOverridesNewerThan:date localOverrides:localOverrides];
+
+    // The overrides change once the oldest record in them falls out of the window
+    NSDate *oldestRecordDate = [self.historian oldestTagRecordDateNewerThan:date];
+    [self cacheView:overrides
+             forKey:UAInAppAudienceManagerTagOverridesKey
+              stamp:stamp
+         expiryDate:[oldestRecordDate dateByAddingTimeInterval:self.preferLocalTagDataTime]];
+
+    return overrides;
+}
+
+- (NSArray<UATagGroupsMutation *> *)tagOverridesNewerThan:(NSDate *)date localOverrides:(NSArray<UATagGroupsMutation *> *)localOverrides {
+    NSMutableArray *overrides = [[self.historian tagHistoryNewerThan:date] mutableCopy];
+    [overrides addObjectsFromArray:localOverrides];
     return [UATagGroupsMutation collapseMutations:overrides];
 }
 
 - (UAAttributePendingMutations *)attributeOverrides {
+    NSArray *localOverrides = [self localAttributeOverrides];
+    NSArray *stamp = [self stampWithLocalOverrides:localOverrides];
+
+    UAAttributePendingMutations *collapsed = [self cachedViewForKey:UAInAppAudienceManagerAttributeOverridesKey stamp:stamp];
+    if (collapsed) {
+        return collapsed;
+    }
+
     NSDate *date = [self.currentTime.now dateByAddingTimeInterval:-UAInAppAudienceManagerDefaultPreferLocalAudienceDataTimeSeconds];
     NSMutableArray *overrides = [[self.historian attributeHistoryNewerThan:date] mutableCopy];
+    [overrides addObjectsFromArray:localOverrides];
+
+    collapsed = [UAAttributePendingMutations collapseMutations:overrides];
 
-    [overrides addObject:self.namedUser.pendingAttributes];
-    [overrides addObject:self.channel.pendingAttributes];
+    NSDate *oldestRecordDate = [self.historian oldestAttributeRecordDateNewerThan:date];
+    [self cacheView:collapsed
+             forKey:UAInAppAudienceManagerAttributeOverridesKey
+              stamp:stamp
+         expiryDate:[oldestRecordDate dateByAddingTimeInterval:UAInAppAudienceManagerDefaultPreferLocalAudienceDataTimeSeconds]];
 
-    return [UAAttributePendingMutations collapseMutations:overrides];
+    return collapsed;
 }
 
 - (UATagGroups *)generateTagGroups:(UATagGroups *)requestedTagGroups
                     cachedResponse:(UATagGroupsLookupResponse *)cachedResponse
                        refreshDate:(NSDate *)refreshDate {
 
-    NSDictionary *tags = cachedResponse.tagGroups.tags;
+    // The history window is anchored to the refresh date, so the view only changes with its inputs
+    NSArray *localOverrides = [self localTagOverrides];
+    NSArray *stamp = [[self stampWithLocalOverrides:localOverrides] arrayByAddingObjectsFromArray:@[@(self.lookupVersion), refreshDate ?: [NSNull null]]];
+    NSDictionary *tags = [self cachedViewForKey:UAInAppAudienceManagerEffectiveTagsKey stamp:stamp];
 
-    // Apply local history
-    NSDate *date = [refreshDate dateByAddingTimeInterval:-self.preferLocalTagDataTime];
-    for (UATagGroupsMutation *mutation in [self tagOverridesNewerThan:date]) {
-        tags = [mutation applyToTagGroups:tags];
+    if (!tags) {
+        tags = cachedResponse.tagGroups.tags;
+
+        // Apply local history
+        NSDate *date = [refreshDate dateByAddingTimeInterval:-self.preferLocalTagDataTime];
+        for (UATagGroupsMutation *mutation in [self tagOverridesNewerThan:date localOverrides:localOverrides]) {
+            tags = [mutation applyToTagGroups:tags];
+        }
+
+        [self cacheView:tags forKey:UAInAppAudienceManagerEffectiveTagsKey stamp:stamp expiryDate:nil];
     }
 
     // Only return the requested tags if available
@@ -182,19 +333,64 @@ NSString * const UAInAppAudienceManagerErrorDomain = @"com.urbanairship.in_app_a
 - (void)refreshCacheWithRequestedTagGroups:(UATagGroups *)requestedTagGroups
                          completionHandler:(void(^)(void))completionHandler {
 
+    @synchronized (self) {
+        // Join the lookup in flight if it already covers the requested groups
+        if (self.refreshingTagGroups && [self.refreshingTagGroups containsAllTags:requestedTagGroups]) {
+            [self.refreshCompletionHandlers addObject:completionHandler];
+            return;
+        }
+    }
+
     [self.delegate gatherTagGroupsWithCompletionHandler:^(UATagGroups *tagGroups) {
         tagGroups = [requestedTagGroups merge:tagGroups];
+
+        // Keep the groups from previous lookups so a partial request does not evict them
+        UATagGroupsLookupResponse *cachedResponse = self.cache.response;
+        if (cachedResponse) {
+            tagGroups = [tagGroups merge:self.cache.requestedTagGroups];
+        }
+
+        BOOL sharedLookup = NO;
+        @synchronized (self) {
+            if (self.refreshingTagGroups && [self.refreshingTagGroups containsAllTags:tagGroups]) {
+                [self.refreshCompletionHandlers addObject:completionHandler];
+                return;
+            }
+
+            // Only one lookup at a time is shared, others complete on their own
+            if (!self.refreshingTagGroups) {
+                self.refreshingTagGroups = tagGroups;
+                [self.refreshCompletionHandlers addObject:completionHandler];
+                sharedLookup = YES;
+            }
+        }
+
         [self.lookupAPIClient lookupTagGroupsWithChannelID:[UAirship channel].identifier
                                         requestedTagGroups:tagGroups
-                                            cachedResponse:self.cache.response
+                                            cachedResponse:cachedResponse
                                          completionHandler:^(UATagGroupsLookupResponse *response) {
             if (response.status != 200) {
                 UA_LTRACE(@"Failed to refresh the cache. Status: %lu", (unsigned long)response.status);
             } else {
                 self.cache.response = response;
                 self.cache.requestedTagGroups = tagGroups;
+                [self lookupChanged];
+            }
+
+            if (!sharedLookup) {
+                return completionHandler();
+            }
+
+            NSArray<void (^)(void)> *handlers;
+            @synchronized (self) {
+                handlers = [self.refreshCompletionHandlers copy];
+                [self.refreshCompletionHandlers removeAllObjects];
+                self.refreshingTagGroups = nil;
+            }
+
+            for (void (^handler)(void) in handlers) {
+                handler();
             }
-            completionHandler();
         }];
     }];
 }
@@ -232,6 +428,15 @@ NSString * const UAInAppAudienceManagerErrorDomain = @"com.urbanairship.in_app_a
                                              refreshDate:cacheRefreshDate], error);
     }
 
+    // Serve a cached response that is old but not yet stale and refresh it in the background
+    if (cachedResponse && ![self.cache isStale]) {
+        UA_LTRACE(@"Tag group cache needs refresh, refreshing in the background");
+        [self refreshCacheWithRequestedTagGroups:requestedTagGroups completionHandler:^{}];
+        return completionHandler([self generateTagGroups:requestedTagGroups
+                                          cachedResponse:cachedResponse
+                                             refreshDate:cacheRefreshDate], error);
+    }
+
     [self refreshCacheWithRequestedTagGroups:requestedTagGroups completionHandler:^{
         cachedResponse = self.cache.response;
         cacheRefreshDate = self.cache.refreshDate;
@@ -252,8 +457,15 @@ NSString * const UAInAppAudienceManagerErrorDomain = @"com.urbanairship.in_app_a
     }];
 }
 
+- (void)lookupChanged {
+    @synchronized (self) {
+        self.lookupVersion++;
+    }
+}
+
 - (void)namedUserChanged:(NSNotification *)notification {
     self.cache.response = nil;
+    [self lookupChanged];
 }
 
 @end
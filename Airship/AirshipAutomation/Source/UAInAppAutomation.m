@@ -15,15 +15,18 @@
 #import "UAScheduleAudienceChecks+Internal.h"
 #import "UAInAppMessageSchedule.h"
 #import "UADeferredScheduleAPIClient+Internal.h"
+#import "UAScheduleTimeline+Internal.h"
+#import "UALandingPagePreloader+Internal.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
 static NSTimeInterval const MaxSchedules = 1000;
+static NSTimeInterval const TriggerProgressSaveInterval = 10;
 
 NSString *const UAInAppMessageManagerEnabledKey = @"UAInAppMessageManagerEnabled";
 NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
 
-@interface UAInAppAutomation () <UAAutomationEngineDelegate, UAInAppAudienceManagerDelegate, UAInAppRemoteDataClientDelegate, UAInAppMessagingExecutionDelegate>
+@interface UAInAppAutomation () <UAAutomationEngineDelegate, UAInAppAudienceManagerDelegate, UAInAppRemoteDataClientDelegate, UAInAppMessagingExecutionDelegate, UAPushableComponent>
 
 @property(nonatomic, strong) UAAutomationEngine *automationEngine;
 @property(nonatomic, strong) UAPreferenceDataStore *dataStore;
@@ -33,6 +36,7 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
 @property(nonatomic, strong) UAInAppMessageManager *inAppMessageManager;
 @property(nonatomic, strong) UADeferredScheduleAPIClient *deferredScheduleAPIClient;
 @property(nonatomic, strong) UAChannel *channel;
+@property(nonatomic, strong) UALandingPagePreloader *landingPagePreloader;
 @end
 
 @implementation UAInAppAutomation
@@ -64,6 +68,7 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
 
     UAAutomationStore *store = [UAAutomationStore automationStoreWithConfig:config
                                                               scheduleLimit:MaxSchedules];
+    store.triggerProgressSaveInterval = TriggerProgressSaveInterval;
     UAAutomationEngine *automationEngine = [UAAutomationEngine automationEngineWithAutomationStore:store];
 
     UAInAppRemoteDataClient *dataClient = [UAInAppRemoteDataClient clientWithRemoteDataProvider:remoteDataProvider
@@ -106,6 +111,7 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
         self.channel = channel;
         self.deferredScheduleAPIClient = deferredScheduleAPIClient;
         self.prepareSchedulePipeline = [UARetriablePipeline pipeline];
+        self.landingPagePreloader = [UALandingPagePreloader preloader];
 
         self.automationEngine.delegate = self;
         self.audienceManager.delegate = self;
@@ -213,6 +219,16 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
     [self.automationEngine editScheduleWithID:scheduleID edits:edits completionHandler:completionHandler];
 }
 
+- (void)updateSchedulesWithEdits:(NSDictionary<NSString *, UAScheduleEdits *> *)edits
+                    newSchedules:(NSArray<UASchedule *> *)schedules
+               completionHandler:(void (^)(BOOL))completionHandler {
+    [self.automationEngine updateSchedulesWithEdits:edits newSchedules:schedules completionHandler:completionHandler];
+}
+
+- (void)updateFrequencyConstraints:(NSArray<UAFrequencyConstraint *> *)constraints {
+    [self.automationEngine updateFrequencyConstraints:constraints];
+}
+
 - (void)prepareSchedule:(UASchedule *)schedule
          triggerContext:(nullable UAScheduleTriggerContext *)triggerContext
       completionHandler:(void (^)(UAAutomationSchedulePrepareResult))completionHandler {
@@ -229,10 +245,23 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
 
     NSString *scheduleID = schedule.identifier;
 
+    // Finish the schedule's timeline if it will not be displayed
+    completionHandler = ^(UAAutomationSchedulePrepareResult result) {
+        NSString *outcome = [UAInAppAutomation timelineOutcomeForPrepareResult:result];
+        if (outcome) {
+            [[UAScheduleTimelineRecorder shared] finishTimelineWithScheduleID:scheduleID outcome:outcome];
+        }
+        completionHandler(result);
+    };
+
     // Check audience conditions
     UARetriable *checkAudience = [UARetriable retriableWithRunBlock:^(UARetriableCompletionHandler _Nonnull retriableHandler) {
         UAScheduleAudience *audience = schedule.audience;
-        [self checkAudience:audience completionHandler:^(BOOL success, NSError *error) {
+        [[UAScheduleTimelineRecorder shared] beginStage:UAScheduleTimelineStageAudience scheduleID:scheduleID];
+        [self checkAudience:audience scheduleID:scheduleID completionHandler:^(BOOL success, NSError *error) {
+            [[UAScheduleTimelineRecorder shared] endStage:UAScheduleTimelineStageAudience
+                                               scheduleID:scheduleID
+                                                   result:error ? @"error" : (success ? @"match" : @"miss")];
             if (error) {
                 retriableHandler(UARetriableResultRetry);
             } else if (success) {
@@ -309,6 +338,10 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
                     }
                     break;
 
+                case UADeferredScheduleAPIClientErrorServerError:
+                    retriableHandler(UARetriableResultServerError);
+                    break;
+
                 case UADeferredScheduleAPIClientErrorMissingAuthToken:
                 case UADeferredScheduleAPIClientErrorUnsuccessfulStatus:
                 default:
@@ -348,6 +381,20 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
     }
 }
 
++ (nullable NSString *)timelineOutcomeForPrepareResult:(UAAutomationSchedulePrepareResult)result {
+    switch (result) {
+        case UAAutomationSchedulePrepareResultCancel:
+            return UAScheduleTimelineOutcomeCancelled;
+        case UAAutomationSchedulePrepareResultSkip:
+            return UAScheduleTimelineOutcomeSkipped;
+        case UAAutomationSchedulePrepareResultPenalize:
+            return UAScheduleTimelineOutcomePenalized;
+        case UAAutomationSchedulePrepareResultContinue:
+        case UAAutomationSchedulePrepareResultInvalidate:
+            return nil;
+    }
+}
+
 - (UAAutomationScheduleReadyResult)isScheduleReadyToExecute:(UASchedule *)schedule {
     UA_LTRACE(@"Checking if schedule %@ is ready to execute.", schedule.identifier);
 
@@ -381,13 +428,26 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
 
     switch (schedule.type) {
         case UAScheduleTypeActions: {
-            // Run the actions
-            [UAActionRunner runActionsWithActionValues:schedule.data
-                                             situation:UASituationAutomation
-                                              metadata:nil
-                                     completionHandler:^(UAActionResult *result) {
-                completionHandler();
-            }];
+            NSDictionary *actions = schedule.data;
+            void (^runActions)(void) = ^{
+                [UAActionRunner runActionsWithActionValues:actions
+                                                 situation:UASituationAutomation
+                                                  metadata:nil
+                                         completionHandler:^(UAActionResult *result) {
+                    completionHandler();
+                }];
+            };
+
+            // Actions that never touch the UI run on the automation queue instead of holding the main queue
+            UAActionRegistry *registry = [UAirship shared].actionRegistry;
+            if (registry && [registry isBackgroundSafeForActionNames:actions.allKeys situation:UASituationAutomation]) {
+                [[UADispatcher globalDispatcherForWorkType:UADispatcherWorkTypeProcessing] dispatchAsync:runActions];
+            } else {
+                runActions();
+            }
+
+            [[UAScheduleTimelineRecorder shared] finishTimelineWithScheduleID:schedule.identifier
+                                                                      outcome:UAScheduleTimelineOutcomeExecuted];
             break;
         }
 
@@ -440,8 +500,34 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
 - (void)onNewSchedule:(nonnull UASchedule *)schedule {
     if (schedule.type == UAScheduleTypeInAppMessage) {
         [self.inAppMessageManager messageScheduled:(UAInAppMessage *)schedule.data
-                                        scheduleID:schedule.identifier];
+                                          schedule:schedule];
+    }
+}
+
+- (void)onScheduleFrequencyLimited:(nonnull UASchedule *)schedule {
+    if (schedule.type == UAScheduleTypeInAppMessage) {
+        [self.inAppMessageManager scheduleExecutionAborted:schedule.identifier];
+    }
+}
+
+- (void)onScheduleTriggerNearlyMet:(nonnull UASchedule *)schedule
+                    triggerContext:(nonnull UAScheduleTriggerContext *)triggerContext {
+    if (schedule.type != UAScheduleTypeDeferred || !self.componentEnabled || !self.isEnabled) {
+        return;
     }
+
+    UAScheduleDeferredData *deferred = (UAScheduleDeferredData *)schedule.data;
+    NSString *channelID = self.channel.identifier;
+    if (!deferred.isSpeculative || !channelID) {
+        return;
+    }
+
+    // Resolve now so the round trip is already done when the trigger fires
+    [self.deferredScheduleAPIClient prefetchURL:deferred.URL
+                                      channelID:channelID
+                                 triggerContext:triggerContext
+                                   tagOverrides:[self.audienceManager tagOverrides]
+                             attributeOverrides:[self.audienceManager attributeOverrides]];
 }
 
 - (void)onComponentEnableChange {
@@ -511,6 +597,15 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
 }
 
 - (void)checkAudience:(UAScheduleAudience *)audience completionHandler:(void (^)(BOOL, NSError * _Nullable))completionHandler {
+    [self checkAudience:audience scheduleID:nil completionHandler:completionHandler];
+}
+
+/**
+ * Checks the audience conditions, recording the tag lookup in the schedule's timeline if a schedule ID is provided.
+ */
+- (void)checkAudience:(UAScheduleAudience *)audience
+           scheduleID:(nullable NSString *)scheduleID
+    completionHandler:(void (^)(BOOL, NSError * _Nullable))completionHandler {
     void (^performAudienceCheck)(UATagGroups *) = ^(UATagGroups *tagGroups) {
         if ([UAScheduleAudienceChecks checkDisplayAudienceConditions:audience tagGroups:tagGroups]) {
             completionHandler(YES, nil);
@@ -522,7 +617,17 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
     UATagGroups *requestedTagGroups = audience.tagSelector.tagGroups;
 
     if (requestedTagGroups.tags.count) {
+        if (scheduleID) {
+            [[UAScheduleTimelineRecorder shared] beginStage:UAScheduleTimelineStageTagLookup scheduleID:scheduleID];
+        }
+
         [self.audienceManager getTagGroups:requestedTagGroups completionHandler:^(UATagGroups * _Nullable tagGroups, NSError * _Nonnull error) {
+            if (scheduleID) {
+                [[UAScheduleTimelineRecorder shared] endStage:UAScheduleTimelineStageTagLookup
+                                                   scheduleID:scheduleID
+                                                       result:error ? @"error" : @"success"];
+            }
+
             if (error) {
                 completionHandler(NO, error);
             } else {
@@ -538,10 +643,52 @@ NSString *const UAInAppMessageManagerPausedKey = @"UAInAppMessageManagerPaused";
     [self.automationEngine scheduleConditionsChanged];
 }
 
+- (void)executionReadinessChangedForScheduleIDs:(NSArray<NSString *> *)scheduleIDs {
+    [self.automationEngine scheduleConditionsChangedForScheduleIDs:scheduleIDs];
+}
+
+- (void)setTimelineDelegate:(nullable id<UAScheduleTimelineDelegate>)timelineDelegate {
+    [UAScheduleTimelineRecorder shared].delegate = timelineDelegate;
+}
+
+- (nullable id<UAScheduleTimelineDelegate>)timelineDelegate {
+    return [UAScheduleTimelineRecorder shared].delegate;
+}
+
+- (NSArray<UAScheduleTimeline *> *)recentTimelines {
+    return [UAScheduleTimelineRecorder shared].recentTimelines;
+}
+
+- (NSDictionary<NSString *, UAScheduleStageMetrics *> *)stageMetrics {
+    return [UAScheduleTimelineRecorder shared].stageMetrics;
+}
+
+- (nullable UAScheduleTimeline *)timelineForScheduleID:(NSString *)scheduleID {
+    return [[UAScheduleTimelineRecorder shared] timelineForScheduleID:scheduleID];
+}
+
 - (void)cancelScheduleWithID:(nonnull NSString *)scheduleID {
     [self.automationEngine cancelScheduleWithID:scheduleID completionHandler:nil];
 }
 
+#pragma mark -
+#pragma mark UAPushableComponent
+
+- (void)receivedRemoteNotification:(UANotificationContent *)notification
+                 completionHandler:(void (^)(UIBackgroundFetchResult))completionHandler {
+    if (!self.componentEnabled) {
+        completionHandler(UIBackgroundFetchResultNoData);
+        return;
+    }
+
+    [self.landingPagePreloader preloadLandingPageForNotification:notification completionHandler:completionHandler];
+}
+
+- (UAPushableComponentPriority)priorityForRemoteNotification:(UANotificationContent *)notification {
+    // Preloading only saves a blank frame when the page opens, it should not hold up other work
+    return UAPushableComponentPriorityLow;
+}
+
 @end
 
 NS_ASSUME_NONNULL_END
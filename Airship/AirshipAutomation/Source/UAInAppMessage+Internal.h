@@ -95,6 +95,9 @@ extern NSString *const UAInAppMessageDisplayTypeCustomValue;
 /**
  * Class factory method for constructing an in-app message from JSON.
  *
+ * Only the structure of the display content is checked, the content itself is validated when
+ * `displayContent` is first read.
+ *
  * @param json JSON object that defines the message.
  * @param error An NSError pointer for storing errors, if applicable.
  * @return A fully configured instance of UAInAppMessage or nil if JSON parsing fails.
@@ -104,6 +107,9 @@ extern NSString *const UAInAppMessageDisplayTypeCustomValue;
 /**
  * Class factory method for constructing an in-app message from JSON.
  *
+ * Only the structure of the display content is checked, the content itself is validated when
+ * `displayContent` is first read.
+ *
  * @param json JSON object that defines the message.
  * @param defaultSource The in-app message source to use if one is not set in the JSON.
  * @param error An NSError pointer for storing errors, if applicable.
@@ -38,6 +38,11 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)clearAllAssets;
 
+/**
+ * The total size of the cached assets in bytes.
+ */
+- (NSUInteger)cachedSize;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -2,12 +2,16 @@
 
 #import "UAInAppMessageAssetCache+Internal.h"
 #import "UAInAppMessageAssets+Internal.h"
+#import "UAInAppMessageAssetStore+Internal.h"
 #import "UAAirshipAutomationCoreImport.h"
 
+// Max size of the shared asset store before least recently used assets are evicted
+static NSUInteger const UAInAppMessageAssetCacheMaxSize = 50 * 1024 * 1024;
 
 @interface UAInAppMessageAssetCache()
 
 @property (nonatomic, strong) NSURL *rootURL;
+@property (nonatomic, strong) UAInAppMessageAssetStore *store;
 @property (nonatomic, strong) NSMutableDictionary<NSString *, UAInAppMessageAssets *> *activeAssets;
 
 @end
@@ -23,9 +27,13 @@
     if (self) {
         self.rootURL = [self assetCacheRootURL];
         self.activeAssets = [NSMutableDictionary dictionary];
+
+        if (self.rootURL) {
+            self.store = [UAInAppMessageAssetStore storeWithRootURL:self.rootURL maxCacheSize:UAInAppMessageAssetCacheMaxSize];
+        }
     }
     
-    if (self.rootURL) {
+    if (self.store) {
         return self;
     } else {
         return nil;
@@ -35,8 +43,9 @@
 - (UAInAppMessageAssets *)assetsForScheduleId:(NSString *)scheduleId {
     @synchronized (self.activeAssets) {
         if (!self.activeAssets[scheduleId]) {
-            UAInAppMessageAssets *assets = [UAInAppMessageAssets assets:[self.rootURL URLByAppendingPathComponent:scheduleId]];
+            UAInAppMessageAssets *assets = [UAInAppMessageAssets assetsWithScheduleID:scheduleId store:self.store];
             self.activeAssets[scheduleId] = assets;
+            [self.store activateScheduleID:scheduleId];
         }
         return self.activeAssets[scheduleId];
     }
@@ -47,18 +56,14 @@
     @synchronized (self.activeAssets) {
         [self.activeAssets enumerateKeysAndObjectsUsingBlock:^(id scheduleId, id assets, BOOL* stop) {
             [(UAInAppMessageAssets *)assets clearAssets];
+            [self.store deactivateScheduleID:scheduleId];
         }];
         
         // clear our dictionary of asset instances
         self.activeAssets = [NSMutableDictionary dictionary];
 
-        // remove the contents of the root cache directory
-        NSFileManager *fileManager = [NSFileManager defaultManager];
-        NSString *rootPath = [self.rootURL path];
-        NSArray *fileArray = [fileManager contentsOfDirectoryAtPath:rootPath error:nil];
-        for (NSString *filename in fileArray)  {
-            [fileManager removeItemAtPath:[rootPath stringByAppendingPathComponent:filename] error:NULL];
-        }
+        // remove the contents of the shared store
+        [self.store removeAllAssets];
     }
 }
 
@@ -68,10 +73,18 @@
             UAInAppMessageAssets *assets = [self assetsForScheduleId:scheduleId];
             [assets clearAssets];
         }
-        [self.activeAssets removeObjectForKey:scheduleId];
+
+        if (self.activeAssets[scheduleId]) {
+            [self.activeAssets removeObjectForKey:scheduleId];
+            [self.store deactivateScheduleID:scheduleId];
+        }
     }
 }
 
+- (NSUInteger)cachedSize {
+    return self.store.totalSize;
+}
+
 #pragma mark -
 #pragma mark Utilities
 - (NSURL *)assetCacheRootURL {
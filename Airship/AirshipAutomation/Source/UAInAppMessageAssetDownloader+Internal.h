@@ -0,0 +1,67 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Download completion handler.
+ *
+ * @param location The downloaded file location, or `nil` if the request failed or the asset was not modified.
+ * @param response The response.
+ * @param error The error, if any.
+ */
+typedef void (^UAInAppMessageAssetDownloadCompletionHandler)(NSURL * _Nullable location, NSURLResponse * _Nullable response, NSError * _Nullable error);
+
+/**
+ * Downloads in-app message assets on a dedicated URL session.
+ *
+ * Requests are made conditional when validators are available. Interrupted downloads
+ * keep their resume data so a retry picks up where the previous attempt stopped.
+ */
+@interface UAInAppMessageAssetDownloader : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Asset Downloader Factories
+///---------------------------------------------------------------------------------------
+
+/**
+ * The shared downloader, backed by a single URL session for the lifetime of the app.
+ */
++ (instancetype)shared;
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param session The URL session.
+ */
++ (instancetype)downloaderWithSession:(NSURLSession *)session;
+
+///---------------------------------------------------------------------------------------
+/// @name Asset Downloader Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Downloads an asset.
+ *
+ * @param assetURL The asset URL.
+ * @param validators The `ETag` and `Last-Modified` headers from the previous response. If set,
+ * the request is conditional.
+ * @param completionHandler The completion handler. The downloaded file is removed once the
+ * handler returns.
+ */
+- (void)downloadAsset:(NSURL *)assetURL
+           validators:(nullable NSDictionary<NSString *, NSString *> *)validators
+    completionHandler:(UAInAppMessageAssetDownloadCompletionHandler)completionHandler;
+
+/**
+ * Returns the validators to store for a response.
+ *
+ * @param response The response.
+ * @return The `ETag` and `Last-Modified` headers, or `nil` if the response has neither.
+ */
++ (nullable NSDictionary<NSString *, NSString *> *)validatorsForResponse:(NSURLResponse *)response;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,114 @@
+/* Copyright Airship and Contributors */
+
+#import "UAInAppMessageAssetDownloader+Internal.h"
+#import "UAAirshipAutomationCoreImport.h"
+
+static NSString * const UAInAppMessageAssetDownloaderETagHeader = @"ETag";
+static NSString * const UAInAppMessageAssetDownloaderLastModifiedHeader = @"Last-Modified";
+
+// Max number of interrupted downloads to keep resume data for
+static NSUInteger const UAInAppMessageAssetDownloaderResumeDataCountLimit = 10;
+
+@interface UAInAppMessageAssetDownloader()
+@property (nonatomic, strong) NSURLSession *session;
+@property (nonatomic, strong) NSCache<NSString *, NSData *> *resumeData;
+@end
+
+@implementation UAInAppMessageAssetDownloader
+
+- (instancetype)initWithSession:(NSURLSession *)session {
+    self = [super init];
+    if (self) {
+        self.session = session;
+        self.resumeData = [[NSCache alloc] init];
+        self.resumeData.countLimit = UAInAppMessageAssetDownloaderResumeDataCountLimit;
+    }
+    return self;
+}
+
++ (instancetype)shared {
+    static dispatch_once_t onceToken;
+    static UAInAppMessageAssetDownloader *_shared;
+    dispatch_once(&onceToken, ^{
+        NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration defaultSessionConfiguration];
+
+        // Assets are cached and revalidated by the asset store
+        configuration.URLCache = nil;
+        configuration.requestCachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+
+        // Sessions are never invalidated, so every downloader shares this one
+        _shared = [self downloaderWithSession:[NSURLSession sessionWithConfiguration:configuration]];
+    });
+
+    return _shared;
+}
+
++ (instancetype)downloaderWithSession:(NSURLSession *)session {
+    return [[self alloc] initWithSession:session];
+}
+
+- (void)downloadAsset:(NSURL *)assetURL
+           validators:(nullable NSDictionary<NSString *, NSString *> *)validators
+    completionHandler:(UAInAppMessageAssetDownloadCompletionHandler)completionHandler {
+
+    NSString *resumeKey = assetURL.absoluteString;
+
+    UA_WEAKIFY(self)
+    void (^handler)(NSURL *, NSURLResponse *, NSError *) = ^(NSURL *location, NSURLResponse *response, NSError *error) {
+        UA_STRONGIFY(self)
+        NSData *resumeData = error.userInfo[NSURLSessionDownloadTaskResumeData];
+        if (resumeData) {
+            UA_LTRACE(@"Saving resume data for asset %@", assetURL);
+            [self.resumeData setObject:resumeData forKey:resumeKey];
+        }
+
+        completionHandler(location, response, error);
+    };
+
+    NSData *resumeData = [self.resumeData objectForKey:resumeKey];
+    if (resumeData) {
+        UA_LTRACE(@"Resuming download for asset %@", assetURL);
+        [self.resumeData removeObjectForKey:resumeKey];
+        [[self.session downloadTaskWithResumeData:resumeData completionHandler:handler] resume];
+        return;
+    }
+
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:assetURL];
+    NSString *eTag = validators[UAInAppMessageAssetDownloaderETagHeader];
+    if (eTag) {
+        [request setValue:eTag forHTTPHeaderField:@"If-None-Match"];
+    }
+
+    NSString *lastModified = validators[UAInAppMessageAssetDownloaderLastModifiedHeader];
+    if (lastModified) {
+        [request setValue:lastModified forHTTPHeaderField:@"If-Modified-Since"];
+    }
+
+    [[self.session downloadTaskWithRequest:request completionHandler:handler] resume];
+}
+
++ (nullable NSDictionary<NSString *, NSString *> *)validatorsForResponse:(NSURLResponse *)response {
+    if (![response isKindOfClass:[NSHTTPURLResponse class]]) {
+        return nil;
+    }
+
+    NSDictionary *headers = ((NSHTTPURLResponse *)response).allHeaderFields;
+    NSMutableDictionary *validators = [NSMutableDictionary dictionary];
+
+    // Header names are case insensitive
+    for (NSString *name in headers) {
+        if (![name isKindOfClass:[NSString class]] || ![headers[name] isKindOfClass:[NSString class]]) {
+            continue;
+        }
+
+        if ([name caseInsensitiveCompare:UAInAppMessageAssetDownloaderETagHeader] == NSOrderedSame) {
+            validators[UAInAppMessageAssetDownloaderETagHeader] = headers[name];
+        } else if ([name caseInsensitiveCompare:UAInAppMessageAssetDownloaderLastModifiedHeader] == NSOrderedSame) {
+            validators[UAInAppMessageAssetDownloaderLastModifiedHeader] = headers[name];
+        }
+    }
+
+    return validators.count ? validators : nil;
+}
+
+@end
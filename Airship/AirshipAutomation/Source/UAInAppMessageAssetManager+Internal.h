@@ -5,6 +5,7 @@
 #import "UAInAppMessageAssetManager.h"
 #import "UAInAppMessageAssets.h"
 #import "UAInAppMessageAssetCache+Internal.h"
+#import "UAInAppMessageAssetPrefetchScheduler+Internal.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -22,16 +23,41 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (instancetype)assetManagerWithAssetCache:(UAInAppMessageAssetCache *)assetCache operationQueue:(NSOperationQueue *)queue;
 
+/**
+ * Factory method. Use for testing.
+ *
+ * @param assetCache Instance of UAInAppMessageAssetCache
+ * @param queue The serial queue used for asset cache bookkeeping.
+ * @param prepareQueue The queue used to prepare message assets. Its max concurrent operation count
+ * bounds the number of messages downloading assets at the same time.
+ */
++ (instancetype)assetManagerWithAssetCache:(UAInAppMessageAssetCache *)assetCache
+                            operationQueue:(NSOperationQueue *)queue
+                              prepareQueue:(NSOperationQueue *)prepareQueue;
+
+/**
+ * Factory method. Use for testing.
+ *
+ * @param assetCache Instance of UAInAppMessageAssetCache
+ * @param queue The serial queue used for asset cache bookkeeping.
+ * @param prepareQueue The queue used to prepare message assets.
+ * @param prefetchScheduler The scheduler for the prefetches requested when messages are scheduled.
+ */
++ (instancetype)assetManagerWithAssetCache:(UAInAppMessageAssetCache *)assetCache
+                            operationQueue:(NSOperationQueue *)queue
+                              prepareQueue:(NSOperationQueue *)prepareQueue
+                         prefetchScheduler:(UAInAppMessageAssetPrefetchScheduler *)prefetchScheduler;
+
 /**
  * Called when message is being scheduled.
  *
- * If delegate's cache policy supports caching on schedule, fetch and
- * cache all assets for the schedule.
+ * If delegate's cache policy supports caching on schedule, the schedule's assets
+ * are fetched and cached once the prefetch scheduler allows it.
  *
  * @param message The message.
- * @param scheduleID The schedule ID.
+ * @param schedule The schedule.
  */
-- (void)onMessageScheduled:(UAInAppMessage *)message scheduleID:(NSString *)scheduleID;
+- (void)onMessageScheduled:(UAInAppMessage *)message schedule:(UASchedule *)schedule;
 
 /**
  * Called when message is being prepared.
@@ -60,6 +86,16 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)onDisplayFinished:(UAInAppMessage *)message
                scheduleID:(NSString *)scheduleID;
 
+/**
+ * Called when the schedule's prepared version is no longer valid and the schedule will be prepared again.
+ *
+ * Release the schedule's assets without clearing them, so the next version can reuse any that it
+ * still needs. The rest are dropped once the next version has prepared.
+ *
+ * @param scheduleID The schedule ID.
+ */
+- (void)onScheduleInvalidated:(NSString *)scheduleID;
+
 /**
  * Called when the schedule has finished.
  *
@@ -2,14 +2,23 @@
 
 #import "UAInAppMessageAssetManager+Internal.h"
 #import "UAInAppMessageAssetCache+Internal.h"
-#import "UAInAppMessageDefaultPrepareAssetsDelegate.h"
+#import "UAInAppMessageDefaultPrepareAssetsDelegate+Internal.h"
+#import "UAInAppMessageAssetPrefetchScheduler+Internal.h"
 #import "UAAirshipAutomationCoreImport.h"
 
+// Max number of messages that can download assets at the same time
+static NSInteger const UAInAppMessageAssetManagerMaxConcurrentPrepares = 4;
+
+// How long a prepare holds its slot, so a download that is stuck waiting can't block the other messages
+static NSTimeInterval const UAInAppMessageAssetManagerPrepareSlotTimeout = 30;
 
 @interface UAInAppMessageAssetManager()
 
 @property(nonatomic, strong) UAInAppMessageAssetCache *assetCache;
 @property(nonatomic, strong) NSOperationQueue *queue;
+@property(nonatomic, strong) NSOperationQueue *prepareQueue;
+@property(nonatomic, strong) UAInAppMessageAssetDownloader *downloader;
+@property(nonatomic, strong) UAInAppMessageAssetPrefetchScheduler *prefetchScheduler;
 
 @end
 
@@ -18,26 +27,58 @@
 + (instancetype)assetManager {
     NSOperationQueue *queue = [[NSOperationQueue alloc] init];
     queue.maxConcurrentOperationCount = 1;
-    return [self assetManagerWithAssetCache:[UAInAppMessageAssetCache assetCache] operationQueue:queue];
+    queue.qualityOfService = [UADispatcher qualityOfServiceForWorkType:UADispatcherWorkTypeProcessing];
+
+    // Prepares run right before a message displays
+    NSOperationQueue *prepareQueue = [[NSOperationQueue alloc] init];
+    prepareQueue.maxConcurrentOperationCount = UAInAppMessageAssetManagerMaxConcurrentPrepares;
+    prepareQueue.qualityOfService = [UADispatcher qualityOfServiceForWorkType:UADispatcherWorkTypeDisplay];
+
+    return [self assetManagerWithAssetCache:[UAInAppMessageAssetCache assetCache]
+                             operationQueue:queue
+                               prepareQueue:prepareQueue];
 }
 
 + (instancetype)assetManagerWithAssetCache:(UAInAppMessageAssetCache *)assetCache operationQueue:(NSOperationQueue *)queue {
-    return [[self alloc] initWithAssetCache:assetCache operationQueue:queue];
+    return [self assetManagerWithAssetCache:assetCache operationQueue:queue prepareQueue:queue];
+}
+
++ (instancetype)assetManagerWithAssetCache:(UAInAppMessageAssetCache *)assetCache
+                            operationQueue:(NSOperationQueue *)queue
+                              prepareQueue:(NSOperationQueue *)prepareQueue {
+    return [self assetManagerWithAssetCache:assetCache
+                             operationQueue:queue
+                               prepareQueue:prepareQueue
+                          prefetchScheduler:[UAInAppMessageAssetPrefetchScheduler schedulerWithAssetCache:assetCache]];
+}
+
++ (instancetype)assetManagerWithAssetCache:(UAInAppMessageAssetCache *)assetCache
+                            operationQueue:(NSOperationQueue *)queue
+                              prepareQueue:(NSOperationQueue *)prepareQueue
+                         prefetchScheduler:(UAInAppMessageAssetPrefetchScheduler *)prefetchScheduler {
+    return [[self alloc] initWithAssetCache:assetCache operationQueue:queue prepareQueue:prepareQueue prefetchScheduler:prefetchScheduler];
 }
 
-- (instancetype)initWithAssetCache:(UAInAppMessageAssetCache *)assetCache operationQueue:(NSOperationQueue *)queue {
+- (instancetype)initWithAssetCache:(UAInAppMessageAssetCache *)assetCache
+                    operationQueue:(NSOperationQueue *)queue
+                      prepareQueue:(NSOperationQueue *)prepareQueue
+                 prefetchScheduler:(UAInAppMessageAssetPrefetchScheduler *)prefetchScheduler {
     self = [super init];
     if (self) {
         self.assetCache = assetCache;
         self.queue = queue;
-        self.prepareAssetsDelegate = [[UAInAppMessageDefaultPrepareAssetsDelegate alloc] init];
+        self.prepareQueue = prepareQueue;
+        self.prefetchScheduler = prefetchScheduler;
+        self.downloader = [UAInAppMessageAssetDownloader shared];
+        self.prepareAssetsDelegate = [UAInAppMessageDefaultPrepareAssetsDelegate delegateWithDownloader:self.downloader];
     }
     return self;
 }
 
 - (void)onMessageScheduled:(UAInAppMessage *)message
-                scheduleID:(NSString *)scheduleID {
+                  schedule:(UASchedule *)schedule {
 
+    NSString *scheduleID = schedule.identifier;
     UAAsyncOperation *operation = [UAAsyncOperation operationWithBlock:^(UAAsyncOperation *operation) {
 
         // ask delegate if we should cache the assets onSchedule
@@ -57,7 +98,22 @@
             [operation finish];
             return;
         }
-        
+
+        // Wait for the scheduler to allow the prefetch
+        UA_WEAKIFY(self)
+        [self.prefetchScheduler schedulePrefetchForSchedule:schedule block:^(void (^completionHandler)(void)) {
+            UA_STRONGIFY(self)
+            [self prefetchAssetsForMessage:message scheduleID:scheduleID completionHandler:completionHandler];
+        }];
+        [operation finish];
+    }];
+    [self.queue addOperation:operation];
+}
+
+- (void)prefetchAssetsForMessage:(UAInAppMessage *)message
+                      scheduleID:(NSString *)scheduleID
+               completionHandler:(void (^)(void))completionHandler {
+    UAAsyncOperation *operation = [UAAsyncOperation operationWithBlock:^(UAAsyncOperation *operation) {
         // Get the assets instance for this schedule
         UAInAppMessageAssets *assets = [self.assetCache assetsForScheduleId:scheduleID];
         
@@ -66,6 +122,7 @@
             // Release the assets instance for this schedule but keep the assets
             [self.assetCache releaseAssets:scheduleID wipeFromDisk:NO];
             [operation finish];
+            completionHandler();
         }];
     }];
     [self.queue addOperation:operation];
@@ -85,14 +142,29 @@
         }
         
         // Get the assets instance for this schedule
-        // Get the message and assets instance for this schedule
         UAInAppMessageAssets *assets = [self.assetCache assetsForScheduleId:scheduleID];
 
-        // Prepare the assets for this schedule
-        [self.prepareAssetsDelegate onPrepare:message assets:assets completionHandler:^(UAInAppMessagePrepareResult result) {
-            completionHandler(result);
-            [operation finish];
+        // Prepare the assets for this schedule off the cache queue so other messages can prepare at the same time
+        id<UAInAppMessagePrepareAssetsDelegate> prepareAssetsDelegate = self.prepareAssetsDelegate;
+        UAAsyncOperation *prepareOperation = [UAAsyncOperation operationWithBlock:^(UAAsyncOperation *prepareOperation) {
+            UADisposable *slotTimeout = [[UADispatcher globalDispatcherForWorkType:UADispatcherWorkTypeProcessing] dispatchAfter:UAInAppMessageAssetManagerPrepareSlotTimeout block:^{
+                [prepareOperation finish];
+            }];
+
+            [prepareAssetsDelegate onPrepare:message assets:assets completionHandler:^(UAInAppMessagePrepareResult result) {
+                [slotTimeout dispose];
+
+                // Assets cached for an earlier version of the schedule that this version no longer uses
+                if (result == UAInAppMessagePrepareResultSuccess) {
+                    [assets removeStaleAssets];
+                }
+                completionHandler(result);
+                [prepareOperation finish];
+            }];
         }];
+
+        [self.prepareQueue addOperation:prepareOperation];
+        [operation finish];
     }];
     [self.queue addOperation:operation];
 }
@@ -115,7 +187,18 @@
     [self.queue addOperation:operation];
 }
 
+- (void)onScheduleInvalidated:(NSString *)scheduleID {
+    UAAsyncOperation *operation = [UAAsyncOperation operationWithBlock:^(UAAsyncOperation *operation) {
+        // Release the assets instance for this schedule but keep the assets for the next version
+        [self.assetCache releaseAssets:scheduleID wipeFromDisk:NO];
+        [operation finish];
+    }];
+    [self.queue addOperation:operation];
+}
+
 - (void)onScheduleFinished:(NSString *)scheduleID {
+    [self.prefetchScheduler cancelPrefetchForScheduleID:scheduleID];
+
     UAAsyncOperation *operation = [UAAsyncOperation operationWithBlock:^(UAAsyncOperation *operation) {
         // Release the assets instance for this schedule
         [self.assetCache releaseAssets:scheduleID wipeFromDisk:YES];
@@ -0,0 +1,91 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+#import "UASchedule.h"
+
+@class UAInAppMessageAssetCache;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A prefetch block. Must call the completion handler once the prefetch has finished.
+ */
+typedef void (^UAInAppMessageAssetPrefetchBlock)(void (^completionHandler)(void));
+
+/**
+ * Schedules the asset prefetches requested when messages are scheduled.
+ *
+ * Prefetches run one at a time, ordered by schedule priority and then by how likely the schedule
+ * is to trigger soon. They only run on Wi-Fi, outside of Low Power Mode and while the asset cache is
+ * under the storage budget. Deferred prefetches are reconsidered when the app becomes active, when
+ * the power state changes and after each prefetch finishes.
+ */
+@interface UAInAppMessageAssetPrefetchScheduler : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Asset Prefetch Scheduler Internal Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The cache size in bytes above which prefetches are deferred.
+ */
+@property (nonatomic, assign) NSUInteger storageBudget;
+
+/**
+ * The number of prefetches waiting to run.
+ */
+@property (nonatomic, readonly) NSUInteger pendingCount;
+
+///---------------------------------------------------------------------------------------
+/// @name Asset Prefetch Scheduler Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method.
+ *
+ * @param assetCache The asset cache, used to check the storage budget.
+ */
++ (instancetype)schedulerWithAssetCache:(UAInAppMessageAssetCache *)assetCache;
+
+/**
+ * Factory method. Use for testing.
+ *
+ * @param assetCache The asset cache, used to check the storage budget.
+ * @param notificationCenter The notification center.
+ * @param processInfo The process info, used to check Low Power Mode.
+ */
++ (instancetype)schedulerWithAssetCache:(UAInAppMessageAssetCache *)assetCache
+                     notificationCenter:(NSNotificationCenter *)notificationCenter
+                            processInfo:(NSProcessInfo *)processInfo;
+
+/**
+ * Schedules a prefetch, replacing any pending prefetch for the schedule.
+ *
+ * @param schedule The schedule.
+ * @param block The prefetch block.
+ */
+- (void)schedulePrefetchForSchedule:(UASchedule *)schedule block:(UAInAppMessageAssetPrefetchBlock)block;
+
+/**
+ * Cancels the pending prefetch for a schedule. A prefetch that is already running is not affected.
+ *
+ * @param scheduleID The schedule ID.
+ */
+- (void)cancelPrefetchForScheduleID:(NSString *)scheduleID;
+
+/**
+ * Runs the pending prefetches if the conditions allow it.
+ */
+- (void)prefetchIfAllowed;
+
+/**
+ * Runs the pending prefetches if the conditions allow it, then calls the completion handler once
+ * no prefetch is running and the rest are deferred or done. Used by background work.
+ *
+ * @param completionHandler The completion handler.
+ */
+- (void)prefetchWithCompletionHandler:(void (^)(BOOL success))completionHandler;
+
+@end
+
+NS_ASSUME_NONNULL_END
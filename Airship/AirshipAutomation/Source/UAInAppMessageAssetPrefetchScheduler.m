@@ -0,0 +1,242 @@
+/* Copyright Airship and Contributors */
+
+#import "UAInAppMessageAssetPrefetchScheduler+Internal.h"
+#import "UAInAppMessageAssetCache+Internal.h"
+#import "UAScheduleTrigger.h"
+#import "UAAirshipAutomationCoreImport.h"
+
+// Default storage budget for prefetched assets, half of the asset cache
+static NSUInteger const UAInAppMessageAssetPrefetchDefaultStorageBudget = 25 * 1024 * 1024;
+
+@interface UAInAppMessageAssetPrefetchRequest : NSObject
+@property (nonatomic, copy) NSString *scheduleID;
+@property (nonatomic, assign) NSInteger priority;
+@property (nonatomic, assign) BOOL likelyToTrigger;
+@property (nonatomic, assign) NSUInteger sequence;
+@property (nonatomic, copy) UAInAppMessageAssetPrefetchBlock block;
+@end
+
+@implementation UAInAppMessageAssetPrefetchRequest
+@end
+
+@interface UAInAppMessageAssetPrefetchScheduler ()
+@property (nonatomic, strong) UAInAppMessageAssetCache *assetCache;
+@property (nonatomic, strong) NSNotificationCenter *notificationCenter;
+@property (nonatomic, strong) NSProcessInfo *processInfo;
+@property (nonatomic, strong) NSMutableArray<UAInAppMessageAssetPrefetchRequest *> *pendingRequests;
+@property (nonatomic, assign) NSUInteger nextSequence;
+@property (nonatomic, assign) BOOL prefetching;
+@property (nonatomic, strong) NSMutableArray<void (^)(BOOL)> *idleHandlers;
+@end
+
+@implementation UAInAppMessageAssetPrefetchScheduler
+
+- (instancetype)initWithAssetCache:(UAInAppMessageAssetCache *)assetCache
+                notificationCenter:(NSNotificationCenter *)notificationCenter
+                       processInfo:(NSProcessInfo *)processInfo {
+    self = [super init];
+
+    if (self) {
+        self.assetCache = assetCache;
+        self.notificationCenter = notificationCenter;
+        self.processInfo = processInfo;
+        self.pendingRequests = [NSMutableArray array];
+        self.idleHandlers = [NSMutableArray array];
+        self.storageBudget = UAInAppMessageAssetPrefetchDefaultStorageBudget;
+
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(prefetchIfAllowed)
+                                        name:UAApplicationDidBecomeActiveNotification
+                                      object:nil];
+
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(prefetchIfAllowed)
+                                        name:NSProcessInfoPowerStateDidChangeNotification
+                                      object:nil];
+
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(prefetchIfAllowed)
+                                        name:UANetworkConnectivityChangedEvent
+                                      object:nil];
+    }
+
+    return self;
+}
+
++ (instancetype)schedulerWithAssetCache:(UAInAppMessageAssetCache *)assetCache {
+    UAInAppMessageAssetPrefetchScheduler *scheduler = [[self alloc] initWithAssetCache:assetCache
+                                                                    notificationCenter:[NSNotificationCenter defaultCenter]
+                                                                           processInfo:[NSProcessInfo processInfo]];
+
+    // Deferred prefetches also run in the background processing window
+    UA_WEAKIFY(scheduler)
+    [[UABackgroundWorkScheduler shared] registerWorkWithName:@"in_app_asset_prefetch" type:UABackgroundWorkTypeProcessing block:^UADisposable *(void (^completionHandler)(BOOL)) {
+        UA_STRONGIFY(scheduler)
+        if (!scheduler) {
+            completionHandler(YES);
+            return nil;
+        }
+        [scheduler prefetchWithCompletionHandler:completionHandler];
+        return nil;
+    }];
+
+    return scheduler;
+}
+
++ (instancetype)schedulerWithAssetCache:(UAInAppMessageAssetCache *)assetCache
+                     notificationCenter:(NSNotificationCenter *)notificationCenter
+                            processInfo:(NSProcessInfo *)processInfo {
+    return [[self alloc] initWithAssetCache:assetCache notificationCenter:notificationCenter processInfo:processInfo];
+}
+
+- (void)dealloc {
+    [self.notificationCenter removeObserver:self];
+}
+
+- (NSUInteger)pendingCount {
+    @synchronized (self.pendingRequests) {
+        return self.pendingRequests.count;
+    }
+}
+
+- (void)schedulePrefetchForSchedule:(UASchedule *)schedule block:(UAInAppMessageAssetPrefetchBlock)block {
+    UAInAppMessageAssetPrefetchRequest *request = [[UAInAppMessageAssetPrefetchRequest alloc] init];
+    request.scheduleID = schedule.identifier;
+    request.priority = schedule.priority;
+    request.likelyToTrigger = [self isLikelyToTrigger:schedule];
+    request.block = block;
+
+    @synchronized (self.pendingRequests) {
+        [self removePendingRequestForScheduleID:schedule.identifier];
+        request.sequence = self.nextSequence++;
+
+        NSUInteger index = [self.pendingRequests indexOfObject:request
+                                                 inSortedRange:NSMakeRange(0, self.pendingRequests.count)
+                                                       options:NSBinarySearchingInsertionIndex
+                                               usingComparator:^NSComparisonResult(UAInAppMessageAssetPrefetchRequest *first, UAInAppMessageAssetPrefetchRequest *second) {
+            return [self compareRequest:first toRequest:second];
+        }];
+        [self.pendingRequests insertObject:request atIndex:index];
+    }
+
+    [self prefetchIfAllowed];
+}
+
+- (void)cancelPrefetchForScheduleID:(NSString *)scheduleID {
+    @synchronized (self.pendingRequests) {
+        [self removePendingRequestForScheduleID:scheduleID];
+    }
+}
+
+- (void)prefetchWithCompletionHandler:(void (^)(BOOL success))completionHandler {
+    @synchronized (self.pendingRequests) {
+        [self.idleHandlers addObject:completionHandler];
+    }
+
+    [self prefetchIfAllowed];
+}
+
+- (void)prefetchIfAllowed {
+    UAInAppMessageAssetPrefetchRequest *request;
+    NSArray<void (^)(BOOL)> *idleHandlers;
+
+    @synchronized (self.pendingRequests) {
+        if (self.prefetching) {
+            return;
+        }
+
+        if (!self.pendingRequests.count || ![self isPrefetchAllowed]) {
+            idleHandlers = [self.idleHandlers copy];
+            [self.idleHandlers removeAllObjects];
+        } else {
+            request = self.pendingRequests.firstObject;
+            [self.pendingRequests removeObjectAtIndex:0];
+            self.prefetching = YES;
+        }
+    }
+
+    if (!request) {
+        for (void (^handler)(BOOL) in idleHandlers) {
+            handler(YES);
+        }
+        return;
+    }
+
+    UA_LTRACE(@"Prefetching assets for schedule %@", request.scheduleID);
+
+    UA_WEAKIFY(self)
+    request.block(^{
+        UA_STRONGIFY(self)
+        @synchronized (self.pendingRequests) {
+            self.prefetching = NO;
+        }
+        [self prefetchIfAllowed];
+    });
+}
+
+#pragma mark -
+#pragma mark Utilities
+
+- (BOOL)isPrefetchAllowed {
+    if (![[UAUtils connectionType] isEqualToString:UAConnectionTypeWifi]) {
+        UA_LTRACE(@"Not on Wi-Fi, deferring asset prefetch");
+        return NO;
+    }
+
+    UANetworkMonitor *networkMonitor = [UANetworkMonitor shared];
+    if (networkMonitor.isExpensive || networkMonitor.isConstrained) {
+        UA_LTRACE(@"Network is expensive or constrained, deferring asset prefetch");
+        return NO;
+    }
+
+    if (self.processInfo.isLowPowerModeEnabled) {
+        UA_LTRACE(@"Low Power Mode enabled, deferring asset prefetch");
+        return NO;
+    }
+
+    if ([self.assetCache cachedSize] >= self.storageBudget) {
+        UA_LTRACE(@"Asset cache over the prefetch budget, deferring asset prefetch");
+        return NO;
+    }
+
+    return YES;
+}
+
+// Schedules that trigger on app launch, foreground or session start usually display soon after scheduling
+- (BOOL)isLikelyToTrigger:(UASchedule *)schedule {
+    for (UAScheduleTrigger *trigger in schedule.triggers) {
+        switch (trigger.type) {
+            case UAScheduleTriggerAppInit:
+            case UAScheduleTriggerAppForeground:
+            case UAScheduleTriggerActiveSession:
+                return YES;
+            default:
+                break;
+        }
+    }
+    return NO;
+}
+
+- (NSComparisonResult)compareRequest:(UAInAppMessageAssetPrefetchRequest *)first toRequest:(UAInAppMessageAssetPrefetchRequest *)second {
+    if (first.priority != second.priority) {
+        return first.priority < second.priority ? NSOrderedAscending : NSOrderedDescending;
+    }
+
+    if (first.likelyToTrigger != second.likelyToTrigger) {
+        return first.likelyToTrigger ? NSOrderedAscending : NSOrderedDescending;
+    }
+
+    if (first.sequence == second.sequence) {
+        return NSOrderedSame;
+    }
+    return first.sequence < second.sequence ? NSOrderedAscending : NSOrderedDescending;
+}
+
+- (void)removePendingRequestForScheduleID:(NSString *)scheduleID {
+    NSIndexSet *indexes = [self.pendingRequests indexesOfObjectsPassingTest:^BOOL(UAInAppMessageAssetPrefetchRequest *request, NSUInteger idx, BOOL *stop) {
+        return [request.scheduleID isEqualToString:scheduleID];
+    }];
+    [self.pendingRequests removeObjectsAtIndexes:indexes];
+}
+
+@end
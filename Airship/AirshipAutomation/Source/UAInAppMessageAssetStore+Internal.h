@@ -0,0 +1,144 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Content addressed storage for in-app message assets that is shared across schedules.
+ *
+ * Each asset is stored once, no matter how many schedules reference it. The store keeps
+ * a persistent index of entries with their size, last access time and referencing schedules,
+ * so cache lookups do not need to touch the file system. When the total size exceeds
+ * the max cache size, the least recently used entries not referenced by an active schedule
+ * are evicted.
+ */
+@interface UAInAppMessageAssetStore : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Asset Store Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The max size of the store in bytes.
+ */
+@property (nonatomic, assign) NSUInteger maxCacheSize;
+
+/**
+ * The total size of the cached assets in bytes.
+ */
+@property (nonatomic, readonly) NSUInteger totalSize;
+
+///---------------------------------------------------------------------------------------
+/// @name Asset Store Factories
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method.
+ *
+ * @param rootURL The directory for the store's index and asset files.
+ * @param maxCacheSize The max size of the store in bytes.
+ * @return The store, or `nil` if the store directory could not be created.
+ */
++ (nullable instancetype)storeWithRootURL:(NSURL *)rootURL maxCacheSize:(NSUInteger)maxCacheSize;
+
+///---------------------------------------------------------------------------------------
+/// @name Asset Store Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Returns the key for an asset URL.
+ *
+ * @param assetURL The asset URL.
+ * @return The content key.
+ */
++ (NSString *)keyForAssetURL:(NSURL *)assetURL;
+
+/**
+ * Returns the file URL for an asset and records the schedule's reference to it.
+ *
+ * @param key The content key.
+ * @param scheduleID The schedule ID.
+ * @return The file URL for the asset, or `nil` if the store is unavailable.
+ */
+- (nullable NSURL *)fileURLForKey:(NSString *)key scheduleID:(NSString *)scheduleID;
+
+/**
+ * Checks if an asset is cached and records the schedule's reference to it.
+ *
+ * @param key The content key.
+ * @param scheduleID The schedule ID.
+ * @return `YES` if the asset is cached, otherwise `NO`.
+ */
+- (BOOL)isCachedForKey:(NSString *)key scheduleID:(NSString *)scheduleID;
+
+/**
+ * Records that an asset was written to its file URL.
+ *
+ * @param key The content key.
+ * @param validators The response headers used to revalidate the asset, or `nil` if not available.
+ */
+- (void)assetCachedForKey:(NSString *)key validators:(nullable NSDictionary<NSString *, NSString *> *)validators;
+
+/**
+ * Records that a cached asset was revalidated with the remote server.
+ *
+ * @param key The content key.
+ */
+- (void)assetValidatedForKey:(NSString *)key;
+
+/**
+ * Returns the response headers used to revalidate a cached asset.
+ *
+ * @param key The content key.
+ * @return The validators, or `nil` if none are stored for the asset.
+ */
+- (nullable NSDictionary<NSString *, NSString *> *)validatorsForKey:(NSString *)key;
+
+/**
+ * Returns the last time a cached asset was downloaded or revalidated.
+ *
+ * @param key The content key.
+ * @return The date, or `nil` if the asset is not cached.
+ */
+- (nullable NSDate *)lastValidatedForKey:(NSString *)key;
+
+/**
+ * Marks a schedule as active. Assets referenced by an active schedule are never evicted.
+ *
+ * @param scheduleID The schedule ID.
+ */
+- (void)activateScheduleID:(NSString *)scheduleID;
+
+/**
+ * Marks a schedule as inactive. Its assets may be evicted if the store is over its max size.
+ *
+ * @param scheduleID The schedule ID.
+ */
+- (void)deactivateScheduleID:(NSString *)scheduleID;
+
+/**
+ * Removes all of the schedule's references. Assets no longer referenced by any
+ * schedule are removed from disk.
+ *
+ * @param scheduleID The schedule ID.
+ */
+- (void)removeReferencesForScheduleID:(NSString *)scheduleID;
+
+/**
+ * Removes the schedule's references to assets other than the given ones. Assets no longer
+ * referenced by any schedule are removed from disk.
+ *
+ * @param scheduleID The schedule ID.
+ * @param keys The keys of the assets the schedule still uses.
+ */
+- (void)removeReferencesForScheduleID:(NSString *)scheduleID exceptKeys:(NSSet<NSString *> *)keys;
+
+/**
+ * Removes all assets and the index.
+ */
+- (void)removeAllAssets;
+
+@end
+
+NS_ASSUME_NONNULL_END
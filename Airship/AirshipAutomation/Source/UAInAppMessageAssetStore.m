@@ -0,0 +1,461 @@
+/* Copyright Airship and Contributors */
+
+#import "UAInAppMessageAssetStore+Internal.h"
+#import "UAAirshipAutomationCoreImport.h"
+
+static NSString * const UAInAppMessageAssetStoreIndexFileName = @"index.plist";
+static NSString * const UAInAppMessageAssetStoreAssetsDirectoryName = @"assets";
+
+// Marks the root directory as migrated from the per schedule layout
+static NSString * const UAInAppMessageAssetStoreMigratedFileName = @"migrated";
+
+static NSString * const UAInAppMessageAssetStoreSizeKey = @"size";
+static NSString * const UAInAppMessageAssetStoreLastAccessKey = @"last_access";
+static NSString * const UAInAppMessageAssetStoreSchedulesKey = @"schedules";
+static NSString * const UAInAppMessageAssetStoreValidatorsKey = @"validators";
+static NSString * const UAInAppMessageAssetStoreLastValidatedKey = @"last_validated";
+
+@interface UAInAppMessageAssetStoreEntry : NSObject
+@property (nonatomic, assign, getter=isCached) BOOL cached;
+@property (nonatomic, assign) NSUInteger size;
+@property (nonatomic, assign) NSTimeInterval lastAccess;
+@property (nonatomic, assign) NSTimeInterval lastValidated;
+@property (nonatomic, copy) NSDictionary<NSString *, NSString *> *validators;
+@property (nonatomic, strong) NSMutableSet<NSString *> *scheduleIDs;
+@end
+
+@implementation UAInAppMessageAssetStoreEntry
+
++ (instancetype)entry {
+    UAInAppMessageAssetStoreEntry *entry = [[self alloc] init];
+    entry.scheduleIDs = [NSMutableSet set];
+    return entry;
+}
+
++ (nullable instancetype)entryWithDictionary:(NSDictionary *)dictionary {
+    if (![dictionary isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+
+    UAInAppMessageAssetStoreEntry *entry = [self entry];
+    NSNumber *size = dictionary[UAInAppMessageAssetStoreSizeKey];
+    if ([size isKindOfClass:[NSNumber class]]) {
+        entry.cached = YES;
+        entry.size = size.unsignedIntegerValue;
+    }
+
+    NSNumber *lastAccess = dictionary[UAInAppMessageAssetStoreLastAccessKey];
+    if ([lastAccess isKindOfClass:[NSNumber class]]) {
+        entry.lastAccess = lastAccess.doubleValue;
+    }
+
+    NSNumber *lastValidated = dictionary[UAInAppMessageAssetStoreLastValidatedKey];
+    if ([lastValidated isKindOfClass:[NSNumber class]]) {
+        entry.lastValidated = lastValidated.doubleValue;
+    }
+
+    NSDictionary *validators = dictionary[UAInAppMessageAssetStoreValidatorsKey];
+    if ([validators isKindOfClass:[NSDictionary class]]) {
+        entry.validators = validators;
+    }
+
+    NSArray *scheduleIDs = dictionary[UAInAppMessageAssetStoreSchedulesKey];
+    if ([scheduleIDs isKindOfClass:[NSArray class]]) {
+        [entry.scheduleIDs addObjectsFromArray:scheduleIDs];
+    }
+
+    return entry;
+}
+
+- (NSDictionary *)dictionaryValue {
+    NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
+    if (self.isCached) {
+        dictionary[UAInAppMessageAssetStoreSizeKey] = @(self.size);
+    }
+    dictionary[UAInAppMessageAssetStoreLastAccessKey] = @(self.lastAccess);
+    dictionary[UAInAppMessageAssetStoreLastValidatedKey] = @(self.lastValidated);
+    if (self.validators) {
+        dictionary[UAInAppMessageAssetStoreValidatorsKey] = self.validators;
+    }
+    dictionary[UAInAppMessageAssetStoreSchedulesKey] = [self.scheduleIDs allObjects];
+    return dictionary;
+}
+
+@end
+
+@interface UAInAppMessageAssetStore()
+@property (nonatomic, strong) NSURL *rootURL;
+@property (nonatomic, strong) NSURL *assetsURL;
+@property (nonatomic, strong) NSURL *indexURL;
+@property (nonatomic, strong) NSURL *migratedURL;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, UAInAppMessageAssetStoreEntry *> *entries;
+@property (nonatomic, strong) NSCountedSet<NSString *> *activeScheduleIDs;
+@property (nonatomic, assign) NSUInteger totalSize;
+@end
+
+@implementation UAInAppMessageAssetStore
+
++ (nullable instancetype)storeWithRootURL:(NSURL *)rootURL maxCacheSize:(NSUInteger)maxCacheSize {
+    return [[self alloc] initWithRootURL:rootURL maxCacheSize:maxCacheSize];
+}
+
+- (nullable instancetype)initWithRootURL:(NSURL *)rootURL maxCacheSize:(NSUInteger)maxCacheSize {
+    self = [super init];
+    if (self) {
+        self.rootURL = rootURL;
+        self.assetsURL = [rootURL URLByAppendingPathComponent:UAInAppMessageAssetStoreAssetsDirectoryName];
+        self.indexURL = [rootURL URLByAppendingPathComponent:UAInAppMessageAssetStoreIndexFileName];
+        self.migratedURL = [rootURL URLByAppendingPathComponent:UAInAppMessageAssetStoreMigratedFileName];
+        self.maxCacheSize = maxCacheSize;
+        self.entries = [NSMutableDictionary dictionary];
+        self.activeScheduleIDs = [NSCountedSet set];
+
+        if (![self createAssetsDirectory]) {
+            return nil;
+        }
+
+        [self removeLegacyScheduleDirectoriesIfNeeded];
+        [self loadIndex];
+    }
+    return self;
+}
+
++ (NSString *)keyForAssetURL:(NSURL *)assetURL {
+    return [UAUtils sha256HashWithString:[assetURL absoluteString]];
+}
+
+- (nullable NSURL *)fileURLForKey:(NSString *)key scheduleID:(NSString *)scheduleID {
+    @synchronized (self) {
+        if (![self createAssetsDirectory]) {
+            return nil;
+        }
+
+        [self referenceEntryForKey:key scheduleID:scheduleID];
+        return [self.assetsURL URLByAppendingPathComponent:key];
+    }
+}
+
+- (BOOL)isCachedForKey:(NSString *)key scheduleID:(NSString *)scheduleID {
+    @synchronized (self) {
+        UAInAppMessageAssetStoreEntry *entry = [self referenceEntryForKey:key scheduleID:scheduleID];
+        if (entry.isCached) {
+            return YES;
+        }
+
+        // Pick up assets written since the URL was handed out
+        NSString *path = [self.assetsURL URLByAppendingPathComponent:key].path;
+        NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:path error:nil];
+        if (!attributes) {
+            return NO;
+        }
+
+        entry.cached = YES;
+        entry.size = (NSUInteger)[attributes fileSize];
+        self.totalSize += entry.size;
+
+        [self trim];
+        [self saveIndex];
+
+        // Trimming may evict the entry if the schedule is not active
+        return self.entries[key] != nil;
+    }
+}
+
+- (void)assetCachedForKey:(NSString *)key validators:(nullable NSDictionary<NSString *, NSString *> *)validators {
+    @synchronized (self) {
+        UAInAppMessageAssetStoreEntry *entry = self.entries[key];
+        if (!entry) {
+            return;
+        }
+
+        NSString *path = [self.assetsURL URLByAppendingPathComponent:key].path;
+        NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:path error:nil];
+        if (!attributes) {
+            return;
+        }
+
+        if (entry.isCached) {
+            self.totalSize -= MIN(self.totalSize, entry.size);
+        }
+
+        entry.cached = YES;
+        entry.size = (NSUInteger)[attributes fileSize];
+        entry.validators = validators;
+        entry.lastValidated = [NSDate date].timeIntervalSince1970;
+        self.totalSize += entry.size;
+
+        [self trim];
+        [self saveIndex];
+    }
+}
+
+- (void)assetValidatedForKey:(NSString *)key {
+    @synchronized (self) {
+        UAInAppMessageAssetStoreEntry *entry = self.entries[key];
+        if (!entry.isCached) {
+            return;
+        }
+
+        entry.lastValidated = [NSDate date].timeIntervalSince1970;
+        [self saveIndex];
+    }
+}
+
+- (nullable NSDictionary<NSString *, NSString *> *)validatorsForKey:(NSString *)key {
+    @synchronized (self) {
+        return self.entries[key].validators;
+    }
+}
+
+- (nullable NSDate *)lastValidatedForKey:(NSString *)key {
+    @synchronized (self) {
+        UAInAppMessageAssetStoreEntry *entry = self.entries[key];
+        if (!entry.isCached) {
+            return nil;
+        }
+        return [NSDate dateWithTimeIntervalSince1970:entry.lastValidated];
+    }
+}
+
+- (void)activateScheduleID:(NSString *)scheduleID {
+    @synchronized (self) {
+        [self.activeScheduleIDs addObject:scheduleID];
+    }
+}
+
+- (void)deactivateScheduleID:(NSString *)scheduleID {
+    @synchronized (self) {
+        [self.activeScheduleIDs removeObject:scheduleID];
+        [self trim];
+    }
+}
+
+- (void)removeReferencesForScheduleID:(NSString *)scheduleID {
+    [self removeReferencesForScheduleID:scheduleID exceptKeys:[NSSet set]];
+}
+
+- (void)removeReferencesForScheduleID:(NSString *)scheduleID exceptKeys:(NSSet<NSString *> *)keys {
+    @synchronized (self) {
+        BOOL changed = NO;
+        for (NSString *key in [self.entries allKeys]) {
+            UAInAppMessageAssetStoreEntry *entry = self.entries[key];
+            if (![entry.scheduleIDs containsObject:scheduleID] || [keys containsObject:key]) {
+                continue;
+            }
+
+            changed = YES;
+            [entry.scheduleIDs removeObject:scheduleID];
+            if (!entry.scheduleIDs.count) {
+                [self removeEntryForKey:key];
+            }
+        }
+
+        if (changed) {
+            [self saveIndex];
+        }
+    }
+}
+
+- (void)removeAllAssets {
+    @synchronized (self) {
+        NSFileManager *fileManager = [NSFileManager defaultManager];
+        [fileManager removeItemAtURL:self.assetsURL error:nil];
+        [fileManager removeItemAtURL:self.indexURL error:nil];
+
+        [self.entries removeAllObjects];
+        self.totalSize = 0;
+
+        [self createAssetsDirectory];
+    }
+}
+
+#pragma mark -
+#pragma mark Entries
+
+- (UAInAppMessageAssetStoreEntry *)referenceEntryForKey:(NSString *)key scheduleID:(NSString *)scheduleID {
+    UAInAppMessageAssetStoreEntry *entry = self.entries[key];
+    if (!entry) {
+        entry = [UAInAppMessageAssetStoreEntry entry];
+        self.entries[key] = entry;
+    }
+
+    // Access times are persisted with the next index change
+    entry.lastAccess = [NSDate date].timeIntervalSince1970;
+
+    if (![entry.scheduleIDs containsObject:scheduleID]) {
+        [entry.scheduleIDs addObject:scheduleID];
+        [self saveIndex];
+    }
+
+    return entry;
+}
+
+- (void)removeEntryForKey:(NSString *)key {
+    UAInAppMessageAssetStoreEntry *entry = self.entries[key];
+    if (!entry) {
+        return;
+    }
+
+    if (entry.isCached) {
+        self.totalSize -= MIN(self.totalSize, entry.size);
+    }
+
+    [self.entries removeObjectForKey:key];
+
+    NSURL *fileURL = [self.assetsURL URLByAppendingPathComponent:key];
+    if ([[NSFileManager defaultManager] fileExistsAtPath:fileURL.path]) {
+        NSError *error;
+        [[NSFileManager defaultManager] removeItemAtURL:fileURL error:&error];
+        if (error) {
+            UA_LERR(@"Unable to remove asset %@: %@", fileURL, error.localizedDescription);
+        }
+    }
+}
+
+- (BOOL)isEntryActive:(UAInAppMessageAssetStoreEntry *)entry {
+    for (NSString *scheduleID in entry.scheduleIDs) {
+        if ([self.activeScheduleIDs containsObject:scheduleID]) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+- (void)trim {
+    if (self.totalSize <= self.maxCacheSize) {
+        return;
+    }
+
+    NSMutableArray<NSString *> *candidates = [NSMutableArray array];
+    [self.entries enumerateKeysAndObjectsUsingBlock:^(NSString *key, UAInAppMessageAssetStoreEntry *entry, BOOL *stop) {
+        if (entry.isCached && ![self isEntryActive:entry]) {
+            [candidates addObject:key];
+        }
+    }];
+
+    [candidates sortUsingComparator:^NSComparisonResult(NSString *key1, NSString *key2) {
+        NSTimeInterval access1 = self.entries[key1].lastAccess;
+        NSTimeInterval access2 = self.entries[key2].lastAccess;
+        return access1 < access2 ? NSOrderedAscending : (access1 > access2 ? NSOrderedDescending : NSOrderedSame);
+    }];
+
+    BOOL changed = NO;
+    for (NSString *key in candidates) {
+        if (self.totalSize <= self.maxCacheSize) {
+            break;
+        }
+
+        UA_LTRACE(@"Evicting asset %@", key);
+        [self removeEntryForKey:key];
+        changed = YES;
+    }
+
+    if (changed) {
+        [self saveIndex];
+    }
+}
+
+#pragma mark -
+#pragma mark Persistence
+
+- (void)loadIndex {
+    NSData *data = [NSData dataWithContentsOfURL:self.indexURL];
+    if (!data) {
+        return;
+    }
+
+    NSError *error;
+    NSDictionary *index = [NSPropertyListSerialization propertyListWithData:data
+                                                                    options:NSPropertyListImmutable
+                                                                     format:NULL
+                                                                      error:&error];
+    if (error || ![index isKindOfClass:[NSDictionary class]]) {
+        UA_LERR(@"Unable to read asset index, clearing assets: %@", error.localizedDescription);
+        [self removeAllAssets];
+        return;
+    }
+
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    [index enumerateKeysAndObjectsUsingBlock:^(NSString *key, id value, BOOL *stop) {
+        UAInAppMessageAssetStoreEntry *entry = [UAInAppMessageAssetStoreEntry entryWithDictionary:value];
+        if (!entry) {
+            return;
+        }
+
+        // Validate once on load so lookups can trust the index afterwards
+        if (entry.isCached && ![fileManager fileExistsAtPath:[self.assetsURL URLByAppendingPathComponent:key].path]) {
+            entry.cached = NO;
+            entry.size = 0;
+        }
+
+        self.entries[key] = entry;
+        if (entry.isCached) {
+            self.totalSize += entry.size;
+        }
+    }];
+
+    [self trim];
+}
+
+- (void)saveIndex {
+    NSMutableDictionary *index = [NSMutableDictionary dictionary];
+    [self.entries enumerateKeysAndObjectsUsingBlock:^(NSString *key, UAInAppMessageAssetStoreEntry *entry, BOOL *stop) {
+        index[key] = [entry dictionaryValue];
+    }];
+
+    NSError *error;
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:index
+                                                              format:NSPropertyListBinaryFormat_v1_0
+                                                             options:0
+                                                               error:&error];
+    if (error) {
+        UA_LERR(@"Unable to serialize asset index: %@", error.localizedDescription);
+        return;
+    }
+
+    if (![data writeToURL:self.indexURL options:NSDataWritingAtomic error:&error]) {
+        UA_LERR(@"Unable to write asset index: %@", error.localizedDescription);
+    }
+}
+
+#pragma mark -
+#pragma mark Utilities
+
+- (BOOL)createAssetsDirectory {
+    BOOL isDirectory;
+    if ([[NSFileManager defaultManager] fileExistsAtPath:self.assetsURL.path isDirectory:&isDirectory] && isDirectory) {
+        return YES;
+    }
+
+    NSError *error;
+    [[NSFileManager defaultManager] createDirectoryAtURL:self.assetsURL withIntermediateDirectories:YES attributes:nil error:&error];
+    if (error) {
+        UA_LERR(@"Unable to create assets directory at %@", self.assetsURL);
+        return NO;
+    }
+    return YES;
+}
+
+// Assets used to be stored in a directory per schedule. The directories are only removed once,
+// so later launches don't have to list the root directory.
+- (void)removeLegacyScheduleDirectoriesIfNeeded {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    if ([fileManager fileExistsAtPath:self.migratedURL.path]) {
+        return;
+    }
+
+    NSArray *contents = [fileManager contentsOfDirectoryAtPath:self.rootURL.path error:nil];
+    for (NSString *filename in contents) {
+        if ([filename isEqualToString:UAInAppMessageAssetStoreAssetsDirectoryName] ||
+            [filename isEqualToString:UAInAppMessageAssetStoreIndexFileName]) {
+            continue;
+        }
+        [fileManager removeItemAtPath:[self.rootURL.path stringByAppendingPathComponent:filename] error:nil];
+    }
+
+    if (![fileManager createFileAtPath:self.migratedURL.path contents:[NSData data] attributes:nil]) {
+        UA_LERR(@"Unable to mark asset directory %@ as migrated", self.rootURL);
+    }
+}
+
+@end
@@ -3,6 +3,7 @@
 #import <Foundation/Foundation.h>
 
 #import "UAInAppMessageAssets.h"
+#import "UAInAppMessageAssetStore+Internal.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -11,15 +12,55 @@ NS_ASSUME_NONNULL_BEGIN
 /**
  * Factory method.
  *
- * @param rootURL Root URL in which to store assets.
+ * @param scheduleID The schedule ID.
+ * @param store The shared asset store.
  */
-+ (instancetype)assets:(NSURL *)rootURL;
++ (instancetype)assetsWithScheduleID:(NSString *)scheduleID store:(UAInAppMessageAssetStore *)store;
 
 /**
- * Clear assets from cache
+ * Records that an asset was downloaded to its cache URL.
+ *
+ * @param assetURL URL from which the data was fetched.
+ * @param validators The response headers used to revalidate the asset, or `nil` if not available.
+ */
+- (void)assetCached:(NSURL *)assetURL validators:(nullable NSDictionary<NSString *, NSString *> *)validators;
+
+/**
+ * Records that a cached asset was revalidated with the remote server.
+ *
+ * @param assetURL URL from which the data was fetched.
+ */
+- (void)assetValidated:(NSURL *)assetURL;
+
+/**
+ * Returns the response headers used to revalidate a cached asset.
+ *
+ * @param assetURL URL from which the data was fetched.
+ * @return The validators, or `nil` if none are stored for the asset.
+ */
+- (nullable NSDictionary<NSString *, NSString *> *)validatorsForAsset:(NSURL *)assetURL;
+
+/**
+ * Returns the last time a cached asset was downloaded or revalidated.
+ *
+ * @param assetURL URL from which the data was fetched.
+ * @return The date, or `nil` if the asset is not cached.
+ */
+- (nullable NSDate *)lastValidatedForAsset:(NSURL *)assetURL;
+
+/**
+ * Clear the schedule's assets from cache. Assets that are still referenced
+ * by other schedules are kept.
  */
 - (void)clearAssets;
 
+/**
+ * Drops the schedule's references to assets that were cached for a previous version of
+ * the schedule and not looked up through this instance. Assets that the current version
+ * uses, and assets still referenced by other schedules, are kept.
+ */
+- (void)removeStaleAssets;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -5,71 +5,86 @@
 
 @interface UAInAppMessageAssets()
 
-@property (nonatomic, strong) NSURL *rootURL;
+@property (nonatomic, copy) NSString *scheduleID;
+@property (nonatomic, strong) UAInAppMessageAssetStore *store;
+@property (atomic, assign, getter=isCleared) BOOL cleared;
+@property (nonatomic, strong) NSMutableSet<NSString *> *referencedKeys;
 
 @end
 
 @implementation UAInAppMessageAssets
 
-+ (instancetype)assets:(NSURL *)rootURL {
-    return [[self alloc] initWithRootURL:rootURL];
++ (instancetype)assetsWithScheduleID:(NSString *)scheduleID store:(UAInAppMessageAssetStore *)store {
+    return [[self alloc] initWithScheduleID:scheduleID store:store];
 }
 
-- (instancetype)initWithRootURL:(NSURL *)rootURL {
+- (instancetype)initWithScheduleID:(NSString *)scheduleID store:(UAInAppMessageAssetStore *)store {
     self = [super init];
     if (self) {
-        self.rootURL = rootURL;
-        
-        if (![self createAssetsDirectory]) {
-            return nil;
-        }
+        self.scheduleID = scheduleID;
+        self.store = store;
+        self.referencedKeys = [NSMutableSet set];
     }
     return self;
 }
 
-- (BOOL)assetsDirectoryExists {
-    return [[NSFileManager defaultManager] fileExistsAtPath:[self.rootURL path]];
+- (nullable NSURL *)getCacheURL:(NSURL *)assetURL {
+    if (self.isCleared) {
+        return nil;
+    }
+
+    NSString *key = [UAInAppMessageAssetStore keyForAssetURL:assetURL];
+    [self referenceKey:key];
+    return [self.store fileURLForKey:key scheduleID:self.scheduleID];
 }
 
-- (BOOL)createAssetsDirectory {
-    NSError *error;
-    [[NSFileManager defaultManager] createDirectoryAtURL:self.rootURL withIntermediateDirectories:YES attributes:nil error:&error];
-    if (error) {
-        UA_LERR(@"Unable to create assets directory at %@", self.rootURL);
+- (BOOL)isCached:(NSURL *)assetURL {
+    if (self.isCleared) {
         return NO;
     }
-    return YES;
+
+    NSString *key = [UAInAppMessageAssetStore keyForAssetURL:assetURL];
+    [self referenceKey:key];
+    return [self.store isCachedForKey:key scheduleID:self.scheduleID];
 }
 
-- (nullable NSURL *)getCacheURL:(NSURL *)assetURL {
-    if (![self assetsDirectoryExists]) {
-        return nil;
-    }
-    
-    NSString *assetFilename = [UAUtils sha256HashWithString:[assetURL absoluteString]];
+- (void)assetCached:(NSURL *)assetURL validators:(nullable NSDictionary<NSString *, NSString *> *)validators {
+    [self.store assetCachedForKey:[UAInAppMessageAssetStore keyForAssetURL:assetURL] validators:validators];
+}
 
-    NSURL *cacheURL = [self.rootURL URLByAppendingPathComponent:assetFilename];
-    
-    return cacheURL;
+- (void)assetValidated:(NSURL *)assetURL {
+    [self.store assetValidatedForKey:[UAInAppMessageAssetStore keyForAssetURL:assetURL]];
 }
 
-- (BOOL)isCached:(NSURL *)assetURL {
-    NSURL *cachedURL = [self getCacheURL:assetURL];
-    if (!cachedURL) {
-        return NO;
+- (nullable NSDictionary<NSString *, NSString *> *)validatorsForAsset:(NSURL *)assetURL {
+    return [self.store validatorsForKey:[UAInAppMessageAssetStore keyForAssetURL:assetURL]];
+}
+
+- (nullable NSDate *)lastValidatedForAsset:(NSURL *)assetURL {
+    return [self.store lastValidatedForKey:[UAInAppMessageAssetStore keyForAssetURL:assetURL]];
+}
+
+- (void)clearAssets {
+    self.cleared = YES;
+    [self.store removeReferencesForScheduleID:self.scheduleID];
+}
+
+- (void)removeStaleAssets {
+    if (self.isCleared) {
+        return;
+    }
+
+    NSSet *keys;
+    @synchronized (self.referencedKeys) {
+        keys = [self.referencedKeys copy];
     }
-    BOOL isCached = [[NSFileManager defaultManager] fileExistsAtPath:[cachedURL path]];
-    return isCached;
+    [self.store removeReferencesForScheduleID:self.scheduleID exceptKeys:keys];
 }
 
--(void)clearAssets {
-    // remove cache directory and its contents
-    if ([self assetsDirectoryExists]) {
-        NSError *error;
-        [[NSFileManager defaultManager] removeItemAtURL:self.rootURL error:&error];
-        if (error) {
-            UA_LERR(@"Unable to remove assets directory at %@", self.rootURL);
-        }
+// Tracks the assets this version of the schedule uses
+- (void)referenceKey:(NSString *)key {
+    @synchronized (self.referencedKeys) {
+        [self.referencedKeys addObject:key];
     }
 }
 
@@ -39,6 +39,7 @@ NSString *const UABannerStyleFileName = @"UAInAppMessageBannerStyle";
             self.bannerController = [UAInAppMessageBannerController bannerControllerWithDisplayContent:displayContent
                                                                                              mediaView:mediaView
                                                                                                  style:self.style];
+            [self.bannerController prepareViews];
         }
         completionHandler(result);
     }];
@@ -27,22 +27,33 @@ NSString *const UAInAppMessageBannerContentViewNibName = @"UAInAppMessageBannerC
 
 @implementation UAInAppMessageBannerContentView
 
+/**
+ * The content nib, cached so successive banners instantiate it without reading it from the bundle again.
+ */
++ (UINib *)nib {
+    static UINib *nib;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        nib = [UINib nibWithNibName:UAInAppMessageBannerContentViewNibName bundle:[UAAutomationResources bundle]];
+    });
+    return nib;
+}
+
 + (nullable instancetype)contentViewWithLayout:(UAInAppMessageBannerContentLayoutType)contentLayout
                                     headerView:(nullable UAInAppMessageTextView *)headerView
                                       bodyView:(nullable UAInAppMessageTextView *)bodyView
                                      mediaView:(nullable UAInAppMessageMediaView *)mediaView {
 
-    NSString *nibName = UAInAppMessageBannerContentViewNibName;
-    NSBundle *bundle = [UAAutomationResources bundle];
+    NSArray *views = [[self nib] instantiateWithOwner:nil options:nil];
 
     UAInAppMessageBannerContentView *view;
     // Left and right IAM views are firstObject and lastObject, respectively.
     switch (contentLayout) {
         case UAInAppMessageBannerContentLayoutTypeMediaLeft:
-            view = [[bundle loadNibNamed:nibName owner:nil options:nil] firstObject];
+            view = [views firstObject];
             break;
         case UAInAppMessageBannerContentLayoutTypeMediaRight:
-            view = [[bundle loadNibNamed:nibName owner:nil options:nil] lastObject];
+            view = [views lastObject];
             break;
     }
 
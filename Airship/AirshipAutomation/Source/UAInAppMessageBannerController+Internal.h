@@ -27,6 +27,13 @@ NS_ASSUME_NONNULL_BEGIN
                                          mediaView:(nullable UAInAppMessageMediaView *)mediaView
                                              style:(nullable UAInAppMessageBannerStyle *)style;
 
+/**
+ * Builds the banner view hierarchy so showing the banner only needs to attach and animate it.
+ * Called automatically when the banner is shown if it has not been called already.
+ * Must be called on the main queue.
+ */
+- (void)prepareViews;
+
 /**
  * The method to show the banner controller.
  *
@@ -124,9 +124,8 @@ static double const MinimumSwipeVelocity = 100.0;
     }
 }
 
-- (void)showWithParentView:(UIView *)parentView completionHandler:(void (^)(UAInAppMessageResolution * _Nonnull))completionHandler {
-    if (self.isShowing) {
-        UA_LTRACE(@"In-app message banner has already been displayed");
+- (void)prepareViews {
+    if (self.bannerView) {
         return;
     }
 
@@ -160,10 +159,6 @@ static double const MinimumSwipeVelocity = 100.0;
                                                                   bannerContentView:bannerContentView
                                                                          buttonView:buttonView
                                                                               style:self.style];
-    [parentView addSubview:self.bannerView];
-    [self addInitialConstraintsToParentView:parentView
-                                 bannerView:self.bannerView
-                                  placement:self.displayContent.placement];
 
     // Apply style padding to banner container
     [UAInAppMessageUtils applyPaddingToView:self.bannerView.containerView padding:self.style.additionalPadding replace:NO];
@@ -176,6 +171,20 @@ static double const MinimumSwipeVelocity = 100.0;
 
     // Apply style padding to banner button view
     [UAInAppMessageUtils applyPaddingToView:self.mediaView.mediaContainer padding:self.style.mediaStyle.additionalPadding replace:NO];
+}
+
+- (void)showWithParentView:(UIView *)parentView completionHandler:(void (^)(UAInAppMessageResolution * _Nonnull))completionHandler {
+    if (self.isShowing) {
+        UA_LTRACE(@"In-app message banner has already been displayed");
+        return;
+    }
+
+    [self prepareViews];
+
+    [parentView addSubview:self.bannerView];
+    [self addInitialConstraintsToParentView:parentView
+                                 bannerView:self.bannerView
+                                  placement:self.displayContent.placement];
 
     self.showCompletionHandler = completionHandler;
 
@@ -25,20 +25,9 @@ NSString *const UABannerMaxWidthKey = @"maxWidth";
         return style;
     }
 
-    NSString *path = [[NSBundle mainBundle] pathForResource:file ofType:@"plist"];
-
-    if (!path) {
-        return style;
-
-    }
-
-    NSDictionary *normalizedBannerStyleDict;
-
-    NSDictionary *bannerStyleDict = [[NSDictionary alloc] initWithContentsOfFile:path];
-
-    if (bannerStyleDict) {
-        normalizedBannerStyleDict = [UAInAppMessageUtils normalizeStyleDictionary:bannerStyleDict];
+    NSDictionary *normalizedBannerStyleDict = [UAInAppMessageUtils styleDictionaryWithContentsOfFile:file];
 
+    if (normalizedBannerStyleDict) {
         id maxWidthObj = normalizedBannerStyleDict[UABannerMaxWidthKey];
         if (maxWidthObj) {
             if ([maxWidthObj isKindOfClass:[NSNumber class]]) {
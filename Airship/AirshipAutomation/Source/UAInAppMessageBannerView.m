@@ -36,26 +36,41 @@ static CGFloat const ShadowOpacity = 0.5;
 
 @property (strong, nonatomic) NSLayoutConstraint *absoluteHeightConstraint;
 
+// Mask shared across layout passes, its path is only rebuilt when the container frame changes
+@property (nonatomic, strong) CAShapeLayer *maskLayer;
+@property (nonatomic, assign) CGRect roundedFrame;
+
 @end
 
 @implementation UAInAppMessageBannerView
 
+/**
+ * The banner nib, cached so successive banners instantiate it without reading it from the bundle again.
+ */
++ (UINib *)nib {
+    static UINib *nib;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        nib = [UINib nibWithNibName:UAInAppMessageBannerViewNibName bundle:[UAAutomationResources bundle]];
+    });
+    return nib;
+}
+
 + (instancetype)bannerMessageViewWithDisplayContent:(UAInAppMessageBannerDisplayContent *)displayContent
                                   bannerContentView:(UAInAppMessageBannerContentView *)contentView
                                          buttonView:(nullable UAInAppMessageButtonView *)buttonView
                                               style:(UAInAppMessageBannerStyle *)style {
 
-    NSString *nibName = UAInAppMessageBannerViewNibName;
-    NSBundle *bundle = [UAAutomationResources bundle];
+    NSArray *views = [[self nib] instantiateWithOwner:nil options:nil];
 
     // Top and bottom banner views are firstObject and lastObject, respectively.
     UAInAppMessageBannerView *view;
     switch (displayContent.placement) {
         case UAInAppMessageBannerPlacementTop:
-            view = [[bundle loadNibNamed:nibName owner:nil options:nil] firstObject];
+            view = [views firstObject];
             break;
         case UAInAppMessageBannerPlacementBottom:
-            view = [[bundle loadNibNamed:nibName owner:nil options:nil] lastObject];
+            view = [views lastObject];
             break;
     }
 
@@ -94,6 +109,7 @@ static CGFloat const ShadowOpacity = 0.5;
     // The layer color is set to background color to preserve rounding and shadow
     self.backgroundColor = [UIColor clearColor];
     self.nubCover.backgroundColor = displayContent.backgroundColor;
+    self.containerView.layer.backgroundColor = [displayContent.backgroundColor CGColor];
 
     self.layer.shadowOffset = CGSizeMake(0, shadowOffset);
     self.layer.shadowRadius = ShadowRadius;
@@ -115,16 +131,19 @@ static CGFloat const ShadowOpacity = 0.5;
     [super layoutSubviews];
 
     // Limit absolute banner height to window height - padding
-    self.absoluteHeightConstraint.active = NO;
-    self.absoluteHeightConstraint = [NSLayoutConstraint constraintWithItem:self
-                                                                 attribute:NSLayoutAttributeHeight
-                                                                 relatedBy:NSLayoutRelationLessThanOrEqual
-                                                                    toItem:nil
-                                                                 attribute:NSLayoutAttributeNotAnAttribute
-                                                                multiplier:1
-                                                                  constant:[UAUtils mainWindow].frame.size.height - DefaultBannerHeightPadding];
-
-    self.absoluteHeightConstraint.active = YES;
+    CGFloat maxHeight = [UAUtils mainWindow].frame.size.height - DefaultBannerHeightPadding;
+    if (!self.absoluteHeightConstraint) {
+        self.absoluteHeightConstraint = [NSLayoutConstraint constraintWithItem:self
+                                                                     attribute:NSLayoutAttributeHeight
+                                                                     relatedBy:NSLayoutRelationLessThanOrEqual
+                                                                        toItem:nil
+                                                                     attribute:NSLayoutAttributeNotAnAttribute
+                                                                    multiplier:1
+                                                                      constant:maxHeight];
+        self.absoluteHeightConstraint.active = YES;
+    } else if (self.absoluteHeightConstraint.constant != maxHeight) {
+        self.absoluteHeightConstraint.constant = maxHeight;
+    }
 
     [self applyLayerRounding];
 
@@ -132,15 +151,27 @@ static CGFloat const ShadowOpacity = 0.5;
 }
 
 - (void)applyLayerRounding {
-    CGFloat bannerBorderRadius = self.displayContent.borderRadiusPoints;
-    CAShapeLayer * maskLayer = [CAShapeLayer layer];
-    maskLayer.path = [UIBezierPath bezierPathWithRoundedRect:self.containerView.bounds
-                                           byRoundingCorners:(UIRectCorner)self.rounding
-                                                 cornerRadii:(CGSize){bannerBorderRadius, bannerBorderRadius}].CGPath;
+    CGRect frame = self.containerView.frame;
+    if (self.maskLayer && CGRectEqualToRect(frame, self.roundedFrame)) {
+        return;
+    }
 
-    self.containerView.layer.backgroundColor = [self.displayContent.backgroundColor CGColor];
+    self.roundedFrame = frame;
 
-    self.containerView.layer.mask = maskLayer;
+    if (!self.maskLayer) {
+        self.maskLayer = [CAShapeLayer layer];
+        self.containerView.layer.mask = self.maskLayer;
+    }
+
+    CGFloat bannerBorderRadius = self.displayContent.borderRadiusPoints;
+    UIBezierPath *path = [UIBezierPath bezierPathWithRoundedRect:self.containerView.bounds
+                                               byRoundingCorners:(UIRectCorner)self.rounding
+                                                     cornerRadii:(CGSize){bannerBorderRadius, bannerBorderRadius}];
+    self.maskLayer.path = path.CGPath;
+
+    // An explicit shadow path spares rendering the shadow from the masked content offscreen
+    [path applyTransform:CGAffineTransformMakeTranslation(frame.origin.x, frame.origin.y)];
+    self.layer.shadowPath = path.CGPath;
 }
 
 - (void)setIsBeingTapped:(BOOL)isBeingTapped {
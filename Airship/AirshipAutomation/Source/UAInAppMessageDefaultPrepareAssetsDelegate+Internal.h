@@ -0,0 +1,31 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+#import "UAInAppMessageDefaultPrepareAssetsDelegate.h"
+#import "UAInAppMessageAssetDownloader+Internal.h"
+#import "UAInAppMessageSharedMediaCache+Internal.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface UAInAppMessageDefaultPrepareAssetsDelegate ()
+
+/**
+ * Factory method.
+ *
+ * @param downloader The asset downloader.
+ */
++ (instancetype)delegateWithDownloader:(UAInAppMessageAssetDownloader *)downloader;
+
+/**
+ * Factory method.
+ *
+ * @param downloader The asset downloader.
+ * @param sharedMediaCache The media cache shared with the notification extensions.
+ */
++ (instancetype)delegateWithDownloader:(UAInAppMessageAssetDownloader *)downloader
+                      sharedMediaCache:(nullable UAInAppMessageSharedMediaCache *)sharedMediaCache;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -1,14 +1,47 @@
 /* Copyright Airship and Contributors */
 
-#import "UAInAppMessageDefaultPrepareAssetsDelegate.h"
+#import "UAInAppMessageDefaultPrepareAssetsDelegate+Internal.h"
+#import "UAInAppMessageAssets+Internal.h"
 #import "UAInAppMessageMediaInfo.h"
 #import "UAInAppMessageBannerDisplayContent.h"
 #import "UAInAppMessageFullScreenDisplayContent.h"
 #import "UAInAppMessageModalDisplayContent.h"
 #import "UAAirshipAutomationCoreImport.h"
 
+// Cached assets are revalidated with a conditional request once they are older than this
+static NSTimeInterval const UAInAppMessageDefaultPrepareAssetsRevalidateInterval = 24 * 60 * 60;
+
+@interface UAInAppMessageDefaultPrepareAssetsDelegate ()
+@property (nonatomic, strong) UAInAppMessageAssetDownloader *downloader;
+@property (nonatomic, strong, nullable) UAInAppMessageSharedMediaCache *sharedMediaCache;
+@end
+
 @implementation UAInAppMessageDefaultPrepareAssetsDelegate
 
+- (instancetype)init {
+    return [self initWithDownloader:[UAInAppMessageAssetDownloader shared]
+                   sharedMediaCache:[UAInAppMessageSharedMediaCache sharedCache]];
+}
+
+- (instancetype)initWithDownloader:(UAInAppMessageAssetDownloader *)downloader
+                  sharedMediaCache:(nullable UAInAppMessageSharedMediaCache *)sharedMediaCache {
+    self = [super init];
+    if (self) {
+        self.downloader = downloader;
+        self.sharedMediaCache = sharedMediaCache;
+    }
+    return self;
+}
+
++ (instancetype)delegateWithDownloader:(UAInAppMessageAssetDownloader *)downloader {
+    return [[self alloc] initWithDownloader:downloader sharedMediaCache:nil];
+}
+
++ (instancetype)delegateWithDownloader:(UAInAppMessageAssetDownloader *)downloader
+                      sharedMediaCache:(nullable UAInAppMessageSharedMediaCache *)sharedMediaCache {
+    return [[self alloc] initWithDownloader:downloader sharedMediaCache:sharedMediaCache];
+}
+
 - (void)onSchedule:(nonnull UAInAppMessage *)message assets:(nonnull UAInAppMessageAssets *)assets completionHandler:(nonnull void (^)(UAInAppMessagePrepareResult))completionHandler {
     [self onPrepare:message assets:assets completionHandler:completionHandler];
 }
@@ -21,18 +54,32 @@
         return;
     }
     
-    if ([assets isCached:[NSURL URLWithString:mediaInfo.url]]) {
-        completionHandler(UAInAppMessagePrepareResultSuccess);
-        return;
+    NSURL *mediaURL = [NSURL URLWithString:mediaInfo.url];
+
+    // Only revalidate assets that were downloaded with validators
+    NSDictionary<NSString *, NSString *> *validators;
+    if ([assets isCached:mediaURL]) {
+        validators = [assets validatorsForAsset:mediaURL];
+        NSDate *lastValidated = [assets lastValidatedForAsset:mediaURL];
+        if (!validators || (lastValidated && -[lastValidated timeIntervalSinceNow] < UAInAppMessageDefaultPrepareAssetsRevalidateInterval)) {
+            completionHandler(UAInAppMessagePrepareResultSuccess);
+            return;
+        }
     }
 
-    NSURL *mediaURL = [NSURL URLWithString:mediaInfo.url];
     NSURL *cacheURL = [assets getCacheURL:mediaURL];
     if (!cacheURL) {
-        completionHandler(UAInAppMessagePrepareResultCancel);
+        completionHandler(validators ? UAInAppMessagePrepareResultSuccess : UAInAppMessagePrepareResultCancel);
+        return;
+    }
+
+    // Media already downloaded for a rich push does not need to be downloaded again
+    if (!validators && [self.sharedMediaCache copyCachedFileForURL:mediaURL toURL:cacheURL]) {
+        [assets assetCached:mediaURL validators:nil];
+        completionHandler(UAInAppMessagePrepareResultSuccess);
         return;
     }
-    [self cacheImage:mediaURL cacheURL:cacheURL completionHandler:completionHandler];
+    [self cacheImage:mediaURL cacheURL:cacheURL assets:assets validators:validators completionHandler:completionHandler];
 }
 
 - (UAInAppMessageMediaInfo *)getMediaInfo:(nonnull UAInAppMessage *)message {
@@ -58,26 +105,48 @@
     return nil;
 }
 
-- (void)cacheImage:(NSURL *)assetURL cacheURL:(NSURL *)cacheURL completionHandler:(nonnull void (^)(UAInAppMessagePrepareResult))completionHandler {
-    [[[NSURLSession sharedSession] downloadTaskWithURL:assetURL completionHandler:^(NSURL * _Nullable temporaryFileLocation, NSURLResponse * _Nullable response, NSError * _Nullable error) {
+- (void)cacheImage:(NSURL *)assetURL
+          cacheURL:(NSURL *)cacheURL
+            assets:(UAInAppMessageAssets *)assets
+        validators:(nullable NSDictionary<NSString *, NSString *> *)validators
+ completionHandler:(nonnull void (^)(UAInAppMessagePrepareResult))completionHandler {
+
+    // A failed revalidation falls back to the cached copy
+    BOOL revalidating = validators != nil;
+    void (^failed)(UAInAppMessagePrepareResult) = ^(UAInAppMessagePrepareResult result) {
+        completionHandler(revalidating ? UAInAppMessagePrepareResultSuccess : result);
+    };
+
+    [self.downloader downloadAsset:assetURL validators:validators completionHandler:^(NSURL * _Nullable temporaryFileLocation, NSURLResponse * _Nullable response, NSError * _Nullable error) {
         if (error) {
             UA_LERR(@"Error prefetching media at URL: %@, %@", assetURL, error.localizedDescription);
-            completionHandler(UAInAppMessagePrepareResultCancel);
+
+            // Retry interrupted downloads so they resume where they stopped
+            BOOL canResume = error.userInfo[NSURLSessionDownloadTaskResumeData] != nil;
+            failed(canResume ? UAInAppMessagePrepareResultRetry : UAInAppMessagePrepareResultCancel);
             return;
         }
         
         if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
             NSHTTPURLResponse *httpResponse = (NSHTTPURLResponse *) response;
             NSInteger status = httpResponse.statusCode;
-            if (status >= 500 && status <= 599) {
-                completionHandler(UAInAppMessagePrepareResultRetry);
+            if (status == 304 && revalidating) {
+                UA_LTRACE(@"Media at URL: %@ not modified", assetURL);
+                [assets assetValidated:assetURL];
+                completionHandler(UAInAppMessagePrepareResultSuccess);
                 return;
-            } else if (status != 200) {
-                completionHandler(UAInAppMessagePrepareResultCancel);
+            } else if (status >= 500 && status <= 599) {
+                failed(UAInAppMessagePrepareResultRetry);
+                return;
+            } else if (status != 200 && status != 206) {
+                // Resumed downloads finish with a partial content response
+                failed(UAInAppMessagePrepareResultCancel);
                 return;
             }
         }
         
+        [self.sharedMediaCache storeFile:temporaryFileLocation forURL:assetURL];
+
         NSString *cachedPath = [cacheURL path];
         
         NSFileManager *fm = [NSFileManager defaultManager];
@@ -99,9 +168,10 @@
             completionHandler(UAInAppMessagePrepareResultCancel);
             return;
         }
-        
+
+        [assets assetCached:assetURL validators:[UAInAppMessageAssetDownloader validatorsForResponse:response]];
         completionHandler(UAInAppMessagePrepareResultSuccess);
-    }] resume];
+    }];
 }
 
 @end
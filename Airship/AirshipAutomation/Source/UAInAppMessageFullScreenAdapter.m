@@ -40,6 +40,7 @@ NSString *const UAFullScreenStyleFileName = @"UAInAppMessageFullScreenStyle";
             self.fullScreenController = [UAInAppMessageFullScreenViewController fullScreenControllerWithDisplayContent:displayContent
                                                                                                              mediaView:mediaView
                                                                                                                  style:self.style];
+            [self.fullScreenController prepareViews];
         }
         completionHandler(result);
     }];
@@ -21,20 +21,9 @@ NSString *const UAFullScreenMediaStyleKey = @"mediaStyle";
         return style;
     }
 
-    NSString *path = [[NSBundle mainBundle] pathForResource:file ofType:@"plist"];
-
-    if (!path) {
-        return style;
-    }
-
-    NSDictionary *normalizedFullScreenStyleDict;
-
-    NSDictionary *fullScreenStyleDict = [[NSDictionary alloc] initWithContentsOfFile:path];
-
-    if (fullScreenStyleDict) {
-        normalizedFullScreenStyleDict = [UAInAppMessageUtils normalizeStyleDictionary:fullScreenStyleDict];
-
+    NSDictionary *normalizedFullScreenStyleDict = [UAInAppMessageUtils styleDictionaryWithContentsOfFile:file];
 
+    if (normalizedFullScreenStyleDict) {
         id dismissIconResource = normalizedFullScreenStyleDict[UAFullScreenDismissIconResourceKey];
         if (dismissIconResource) {
             if (![dismissIconResource isKindOfClass:[NSString class]]) {
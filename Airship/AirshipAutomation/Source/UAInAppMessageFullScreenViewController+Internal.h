@@ -27,6 +27,13 @@ NS_ASSUME_NONNULL_BEGIN
                                              mediaView:(nullable UAInAppMessageMediaView *)mediaView
                                                  style:(UAInAppMessageFullScreenStyle *)style;
 
+/**
+ * Builds the full screen's text, button, and close views ahead of display.
+ * Called automatically when the view loads if it has not been called already.
+ * Must be called on the main queue.
+ */
+- (void)prepareViews;
+
 /**
  * The method to show the full screen view controller.
  *
@@ -140,6 +140,16 @@ NSString *const UAInAppMessageFullScreenViewNibName = @"UAInAppMessageFullScreen
  */
 @property (nonatomic, strong) UAInAppMessageButtonView *buttonView;
 
+/**
+ * The full screen's footer button.
+ */
+@property (nonatomic, strong, nullable) UAInAppMessageButton *footerButton;
+
+/**
+ * Whether the full screen's subviews have been built.
+ */
+@property (nonatomic, assign) BOOL viewsPrepared;
+
 /**
  * The full screen's media view.
  */
@@ -174,15 +184,19 @@ NSString *const UAInAppMessageFullScreenViewNibName = @"UAInAppMessageFullScreen
     return self;
 }
 
-#pragma mark -
-#pragma mark View Controller Lifecycle Methods
+- (void)prepareViews {
+    if (self.viewsPrepared) {
+        return;
+    }
 
-- (void)viewDidLoad {
-    [super viewDidLoad];
-    self.view.translatesAutoresizingMaskIntoConstraints = NO;
+    self.viewsPrepared = YES;
 
-    [self.fullScreenWindow addSubview:self.view];
-    [self.fullScreenWindow makeKeyAndVisible];
+    // The header media body layout styles its body with the header style
+    UAInAppMessageFullScreenContentLayoutType normalizedContentLayout = [self normalizeContentLayout:self.displayContent];
+    UAInAppMessageTextStyle *bodyStyle = normalizedContentLayout == UAInAppMessageFullScreenContentLayoutHeaderMediaBody ? self.style.headerStyle : self.style.bodyStyle;
+
+    self.headerTextView = [UAInAppMessageTextView textViewWithTextInfo:self.displayContent.heading style:self.style.headerStyle];
+    self.bodyTextView = [UAInAppMessageTextView textViewWithTextInfo:self.displayContent.body style:bodyStyle];
 
     self.buttonView = [UAInAppMessageButtonView buttonViewWithButtons:self.displayContent.buttons
                                                                layout:self.displayContent.buttonLayout
@@ -191,8 +205,20 @@ NSString *const UAInAppMessageFullScreenViewNibName = @"UAInAppMessageFullScreen
                                                              selector:@selector(buttonTapped:)];
 
     self.closeButton = [self createCloseButton];
+    self.footerButton = [self addFooterButtonWithButtonInfo:self.displayContent.footer];
+}
 
-    UAInAppMessageButton *footerButton = [self addFooterButtonWithButtonInfo:self.displayContent.footer];
+#pragma mark -
+#pragma mark View Controller Lifecycle Methods
+
+- (void)viewDidLoad {
+    [super viewDidLoad];
+    self.view.translatesAutoresizingMaskIntoConstraints = NO;
+
+    [self.fullScreenWindow addSubview:self.view];
+    [self.fullScreenWindow makeKeyAndVisible];
+
+    [self prepareViews];
 
     [self.closeButtonContainer addSubview:self.closeButton];
 
@@ -205,7 +231,6 @@ NSString *const UAInAppMessageFullScreenViewNibName = @"UAInAppMessageFullScreen
     switch (normalizedContentLayout) {
         case UAInAppMessageFullScreenContentLayoutHeaderMediaBody: {
             // Add header
-            self.headerTextView = [UAInAppMessageTextView textViewWithTextInfo:self.displayContent.heading style:self.style.headerStyle];
             if (self.headerTextView) {
                 [self.containerStackView addArrangedSubview:self.headerTextView];
 
@@ -233,8 +258,6 @@ NSString *const UAInAppMessageFullScreenViewNibName = @"UAInAppMessageFullScreen
             // Add media
             [self.containerStackView addArrangedSubview:self.mediaView];
 
-            self.bodyTextView = [UAInAppMessageTextView textViewWithTextInfo:self.displayContent.body style:self.style.headerStyle];
-
             // Add body
             if (self.bodyTextView) {
 
@@ -251,9 +274,6 @@ NSString *const UAInAppMessageFullScreenViewNibName = @"UAInAppMessageFullScreen
             break;
         }
         case UAInAppMessageFullScreenContentLayoutHeaderBodyMedia: {
-            self.headerTextView = [UAInAppMessageTextView textViewWithTextInfo:self.displayContent.heading style:self.style.headerStyle];
-            self.bodyTextView = [UAInAppMessageTextView textViewWithTextInfo:self.displayContent.body style:self.style.bodyStyle];
-
             // Add header
             if (self.headerTextView) {
                 [self.containerStackView addArrangedSubview:self.headerTextView];
@@ -299,13 +319,11 @@ NSString *const UAInAppMessageFullScreenViewNibName = @"UAInAppMessageFullScreen
             [self.containerStackView addArrangedSubview:self.mediaView];
 
             // Add header
-            self.headerTextView = [UAInAppMessageTextView textViewWithTextInfo:self.displayContent.heading style:self.style.headerStyle];
             if (self.headerTextView) {
                 [self.containerStackView addArrangedSubview:self.headerTextView];
             }
 
             // Add body
-            self.bodyTextView = [UAInAppMessageTextView textViewWithTextInfo:self.displayContent.body style:self.style.bodyStyle];
             if (self.bodyTextView) {
                 [self.containerStackView addArrangedSubview:self.bodyTextView];
             }
@@ -343,9 +361,9 @@ NSString *const UAInAppMessageFullScreenViewNibName = @"UAInAppMessageFullScreen
     }
 
     // Explicitly remove footer view from the superview if footer is nil
-    if (footerButton) {
-        [self.footerButtonContainer addSubview:footerButton];
-        [UAViewUtils applyContainerConstraintsToContainer:self.footerButtonContainer containedView:footerButton];
+    if (self.footerButton) {
+        [self.footerButtonContainer addSubview:self.footerButton];
+        [UAViewUtils applyContainerConstraintsToContainer:self.footerButtonContainer containedView:self.footerButton];
     } else {
         [self.footerButtonContainer removeFromSuperview];
     }
@@ -7,6 +7,7 @@
 #import "UAInAppMessageResizableViewController+Internal.h"
 #import "UAInAppMessageSceneManager.h"
 #import "UAAirshipAutomationCoreImport.h"
+#import "UAWebViewPool+Internal.h"
 
 NSString *const UAHTMLStyleFileName = @"UAInAppMessageHTMLStyle";
 
@@ -16,6 +17,7 @@ NSString *const UAHTMLStyleFileName = @"UAInAppMessageHTMLStyle";
 @property (nonatomic, strong) UAInAppMessageHTMLDisplayContent *displayContent;
 @property (nonatomic, strong) UAInAppMessageHTMLViewController *htmlViewController;
 @property (nonatomic, strong) UAInAppMessageResizableViewController *resizableContainerViewController;
+@property (nonatomic, strong, nullable) UAWebView *webView;
 @property (nonatomic, strong) UIWindowScene *scene API_AVAILABLE(ios(13.0));
 @end
 
@@ -54,9 +56,49 @@ NSString *const UAHTMLStyleFileName = @"UAInAppMessageHTMLStyle";
         return;
     }
 
-    self.htmlViewController = [UAInAppMessageHTMLViewController htmlControllerWithDisplayContent:content
-                                                                                           style:self.style];
-    completionHandler(UAInAppMessagePrepareResultSuccess);
+    UA_WEAKIFY(self)
+    [[UADispatcher mainDispatcher] dispatchAsyncIfNecessary:^{
+        UA_STRONGIFY(self)
+        self.webView = [[UAWebViewPool shared] checkOutWebView];
+        self.htmlViewController = [UAInAppMessageHTMLViewController htmlControllerWithDisplayContent:content
+                                                                                               style:self.style
+                                                                                             webView:self.webView];
+        if (!self.style.preloadContent) {
+            completionHandler(UAInAppMessagePrepareResultSuccess);
+            return;
+        }
+
+        [self.htmlViewController preloadWithCompletionHandler:^(BOOL loaded) {
+            UA_STRONGIFY(self)
+            if (loaded) {
+                completionHandler(UAInAppMessagePrepareResultSuccess);
+            } else {
+                UA_LDEBUG(@"Failed to preload HTML in-app message %@, retrying.", content.url);
+                [self returnWebView];
+                completionHandler(UAInAppMessagePrepareResultRetry);
+            }
+        }];
+    }];
+}
+
+- (void)returnWebView {
+    if (self.webView) {
+        [[UAWebViewPool shared] checkInWebView:self.webView];
+        self.webView = nil;
+    }
+
+    self.htmlViewController = nil;
+    self.resizableContainerViewController = nil;
+}
+
+- (void)dealloc {
+    UAWebView *webView = self.webView;
+    if (webView) {
+        // Prepared but never displayed
+        [[UADispatcher mainDispatcher] dispatchAsyncIfNecessary:^{
+            [[UAWebViewPool shared] checkInWebView:webView];
+        }];
+    }
 }
 
 - (BOOL)isReadyToDisplay {
@@ -64,6 +106,11 @@ NSString *const UAHTMLStyleFileName = @"UAInAppMessageHTMLStyle";
         return NO;
     }
 
+    if (self.style.preloadContent && !self.htmlViewController.contentLoaded) {
+        UA_LDEBUG(@"Unable to display message %@, content not loaded.", self.message);
+        return NO;
+    }
+
     if (@available(iOS 13.0, *)) {
         self.scene = [[UAInAppMessageSceneManager shared] sceneForMessage:self.message];
         if (!self.scene) {
@@ -100,10 +147,16 @@ NSString *const UAHTMLStyleFileName = @"UAInAppMessageHTMLStyle";
         [self.resizableContainerViewController showWithScene:self.scene completionHandler:^(UAInAppMessageResolution *result) {
             UA_STRONGIFY(self)
             self.scene = nil;
+            [self returnWebView];
             completionHandler(result);
         }];
     } else {
-        [self.resizableContainerViewController showWithCompletionHandler:completionHandler];
+        UA_WEAKIFY(self)
+        [self.resizableContainerViewController showWithCompletionHandler:^(UAInAppMessageResolution *result) {
+            UA_STRONGIFY(self)
+            [self returnWebView];
+            completionHandler(result);
+        }];
     }
 }
 
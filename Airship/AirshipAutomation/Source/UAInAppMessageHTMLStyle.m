@@ -9,6 +9,7 @@ NSString *const UAHTMLAdditionalPaddingKey = @"additionalPadding";
 NSString *const UAHTMLMaxWidthKey = @"maxWidth";
 NSString *const UAHTMLMaxHeightKey = @"maxHeight";
 NSString *const UAHTMLHideDismissIconKey = @"hideDismissIcon";
+NSString *const UAHTMLPreloadContentKey = @"preloadContent";
 
 @implementation UAInAppMessageHTMLStyle
 
@@ -22,19 +23,9 @@ NSString *const UAHTMLHideDismissIconKey = @"hideDismissIcon";
         return style;
     }
 
-    NSString *path = [[NSBundle mainBundle] pathForResource:file ofType:@"plist"];
-
-    if (!path) {
-        return style;
-
-    }
-
-    NSDictionary *normalizedHTMLStyleDict;
-    NSDictionary *HTMLStyleDict = [[NSDictionary alloc] initWithContentsOfFile:path];
-
-    if (HTMLStyleDict) {
-        normalizedHTMLStyleDict = [UAInAppMessageUtils normalizeStyleDictionary:HTMLStyleDict];
+    NSDictionary *normalizedHTMLStyleDict = [UAInAppMessageUtils styleDictionaryWithContentsOfFile:file];
 
+    if (normalizedHTMLStyleDict) {
         id dismissIconResource = normalizedHTMLStyleDict[UAHTMLDismissIconResourceKey];
         if (dismissIconResource) {
             if (![dismissIconResource isKindOfClass:[NSString class]]) {
@@ -65,6 +56,13 @@ NSString *const UAHTMLHideDismissIconKey = @"hideDismissIcon";
             }
         }
 
+        id preloadContentObj = normalizedHTMLStyleDict[UAHTMLPreloadContentKey];
+        if (preloadContentObj) {
+            if ([preloadContentObj isKindOfClass:[NSNumber class]]) {
+                style.preloadContent = [preloadContentObj boolValue];
+            }
+        }
+
         style.additionalPadding = [UAPadding paddingWithDictionary:normalizedHTMLStyleDict[UAHTMLAdditionalPaddingKey]];
 
         UA_LTRACE(@"In-app HTML style options: %@", [normalizedHTMLStyleDict description]);
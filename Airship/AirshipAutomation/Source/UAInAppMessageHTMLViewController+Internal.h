@@ -3,6 +3,7 @@
 #import "UAInAppMessageHTMLDisplayContent+Internal.h"
 #import "UAInAppMessageHTMLStyle.h"
 #import "UAInAppMessageResizableViewController+Internal.h"
+#import "UAAirshipAutomationCoreImport.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -24,6 +25,11 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (weak, nonatomic) UAInAppMessageResizableViewController *resizableParent;
 
+/**
+ * Whether the HTML content finished loading.
+ */
+@property (nonatomic, readonly) BOOL contentLoaded;
+
 /**
  * The factory method for creating an HTML controller.
  *
@@ -35,6 +41,27 @@ NS_ASSUME_NONNULL_BEGIN
 + (instancetype)htmlControllerWithDisplayContent:(UAInAppMessageHTMLDisplayContent *)displayContent
                                            style:(UAInAppMessageHTMLStyle *)style;
 
+/**
+ * The factory method for creating an HTML controller with a pre-warmed web view.
+ *
+ * @param displayContent The display content.
+ * @param style The HTML view styling.
+ * @param webView The web view to display the message in, or `nil` to use a new web view.
+ *
+ * @return a configured UAInAppMessageHTMLViewController instance.
+ */
++ (instancetype)htmlControllerWithDisplayContent:(UAInAppMessageHTMLDisplayContent *)displayContent
+                                           style:(UAInAppMessageHTMLStyle *)style
+                                         webView:(nullable UAWebView *)webView;
+
+/**
+ * Loads the HTML content before the controller is displayed. Failed loads are not retried.
+ *
+ * @param completionHandler The completion handler, called on the main queue with `YES` once the
+ * content finishes loading, or `NO` if the load failed.
+ */
+- (void)preloadWithCompletionHandler:(void (^)(BOOL loaded))completionHandler;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -50,6 +50,26 @@ NSString *const UAInAppNativeBridgeDismissCommand = @"dismiss";
  */
 @property (nonatomic, copy) NSDictionary *headers;
 
+/**
+ * The pre-warmed web view that replaces the web view from the nib.
+ */
+@property (nonatomic, strong, nullable) UAWebView *pooledWebView;
+
+/**
+ * Whether the HTML content finished loading.
+ */
+@property (nonatomic, assign) BOOL contentLoaded;
+
+/**
+ * Set when the content was loaded before the view appeared.
+ */
+@property (nonatomic, assign) BOOL contentPreloaded;
+
+/**
+ * The pending preload completion handler.
+ */
+@property (nonatomic, copy, nullable) void (^preloadCompletionHandler)(BOOL);
+
 @end
 
 
@@ -57,15 +77,23 @@ NSString *const UAInAppNativeBridgeDismissCommand = @"dismiss";
 
 + (instancetype)htmlControllerWithDisplayContent:(UAInAppMessageHTMLDisplayContent *)displayContent
                                           style:(UAInAppMessageHTMLStyle *)style {
-    return [[self alloc] initWithDisplayContent:displayContent style:style];
+    return [[self alloc] initWithDisplayContent:displayContent style:style webView:nil];
+}
+
++ (instancetype)htmlControllerWithDisplayContent:(UAInAppMessageHTMLDisplayContent *)displayContent
+                                           style:(UAInAppMessageHTMLStyle *)style
+                                         webView:(nullable UAWebView *)webView {
+    return [[self alloc] initWithDisplayContent:displayContent style:style webView:webView];
 }
 
 - (instancetype)initWithDisplayContent:(UAInAppMessageHTMLDisplayContent *)displayContent
-                                 style:(UAInAppMessageHTMLStyle *)style {
+                                 style:(UAInAppMessageHTMLStyle *)style
+                               webView:(nullable UAWebView *)webView {
     self = [self initWithNibName:@"UAInAppMessageHTMLViewController" bundle:[UAAutomationResources bundle]];
 
     if (self) {
         self.displayContent = displayContent;
+        self.pooledWebView = webView;
 
         self.style = style;
 
@@ -89,12 +117,41 @@ NSString *const UAInAppNativeBridgeDismissCommand = @"dismiss";
 
 -(void)viewWillAppear:(BOOL)animated {
     [super viewWillAppear:animated];
+
+    if (self.contentPreloaded) {
+        self.contentPreloaded = NO;
+        return;
+    }
+
     [self load];
 }
 
+- (void)preloadWithCompletionHandler:(void (^)(BOOL))completionHandler {
+    [self loadViewIfNeeded];
+    [self.view layoutIfNeeded];
+
+    self.preloadCompletionHandler = completionHandler;
+    [self load];
+}
+
+- (void)completePreload:(BOOL)loaded {
+    void (^completionHandler)(BOOL) = self.preloadCompletionHandler;
+    if (!completionHandler) {
+        return;
+    }
+
+    self.preloadCompletionHandler = nil;
+    self.contentPreloaded = loaded;
+    completionHandler(loaded);
+}
+
 - (void)viewDidLoad {
     [super viewDidLoad];
 
+    if (self.pooledWebView) {
+        [self replaceWebView:self.pooledWebView];
+    }
+
     self.nativeBridge = [UANativeBridge nativeBridge];
     self.nativeBridge.forwardNavigationDelegate = self;
     self.nativeBridge.javaScriptCommandDelegate = self;
@@ -127,6 +184,15 @@ NSString *const UAInAppNativeBridgeDismissCommand = @"dismiss";
 
 }
 
+- (void)replaceWebView:(UAWebView *)webView {
+    // Keep the nib's view ordering so the loading indicator and close button stay on top
+    [self.containerView insertSubview:webView aboveSubview:self.webView];
+    [UAViewUtils applyContainerConstraintsToContainer:self.containerView containedView:webView];
+    [self.webView removeFromSuperview];
+    self.webView = webView;
+    self.pooledWebView = nil;
+}
+
 - (void)dealloc {
     [[NSNotificationCenter defaultCenter] removeObserver:self name:UIWindowDidBecomeVisibleNotification object:nil];
     [[NSNotificationCenter defaultCenter] removeObserver:self name:UIWindowDidBecomeHiddenNotification object:nil];
@@ -173,6 +239,7 @@ NSString *const UAInAppNativeBridgeDismissCommand = @"dismiss";
 - (void)loadRequestWithDefaultTimeoutInterval:(NSMutableURLRequest *)request {
     [request setTimeoutInterval:30];
 
+    self.contentLoaded = NO;
     [self.webView stopLoading];
     [self.webView loadRequest:request];
     [self showOverlay];
@@ -231,9 +298,21 @@ NSString *const UAInAppNativeBridgeDismissCommand = @"dismiss";
 
 - (void)webView:(WKWebView *)webView didFinishNavigation:(null_unspecified WKNavigation *)navigation {
     [self hideOverlay];
+    self.contentLoaded = YES;
+    [self completePreload:YES];
+}
+
+- (void)webView:(WKWebView *)webView didFailProvisionalNavigation:(null_unspecified WKNavigation *)navigation withError:(nonnull NSError *)error {
+    [self completePreload:NO];
 }
 
 - (void)webView:(WKWebView *)webView didFailNavigation:(null_unspecified WKNavigation *)navigation withError:(nonnull NSError *)error {
+    if (self.preloadCompletionHandler) {
+        // The adapter retries the prepare
+        [self completePreload:NO];
+        return;
+    }
+
     UA_WEAKIFY(self);
 
     // Wait twenty seconds, try again if necessary
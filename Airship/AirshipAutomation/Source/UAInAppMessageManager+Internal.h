@@ -21,6 +21,12 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)executionReadinessChanged;
 
+/**
+ * Called when execution readiness changed for prepared schedules that were waiting on a display coordinator.
+ * @param scheduleIDs The schedule IDs, in the order they should be attempted.
+ */
+- (void)executionReadinessChangedForScheduleIDs:(NSArray<NSString *> *)scheduleIDs;
+
 /**
  * Called to cancel schedules.
  * @param scheduleID The schedule ID.
@@ -125,10 +131,10 @@ NS_ASSUME_NONNULL_BEGIN
 /**
  * Called when a message is scheduled.
  * @param message The message.
- * @param scheduleID The schedule ID.
+ * @param schedule The schedule.
  */
 - (void)messageScheduled:(UAInAppMessage *)message
-              scheduleID:(NSString *)scheduleID;
+                schedule:(UASchedule *)schedule;
 
 @end
 
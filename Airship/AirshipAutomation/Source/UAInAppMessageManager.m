@@ -18,12 +18,30 @@
 #import "UARetriablePipeline+Internal.h"
 #import "UAAirshipAutomationCoreImport.h"
 #import "UAAutomationEngine+Internal.h"
+#import "UAScheduleTimeline+Internal.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
 NSString *const UAInAppMessageManagerDisplayIntervalKey = @"UAInAppMessageManagerDisplayInterval";
 NSString *const UAInAppMessageDisplayCoordinatorIsReadyKey = @"isReady";
 
+// Max number of messages that can prepare assets and adapters at the same time
+static NSInteger const UAInAppMessageManagerMaxConcurrentPrepares = 3;
+
+// Timeline stage result for a prepare result
+static NSString *UAInAppMessagePrepareResultName(UAInAppMessagePrepareResult result) {
+    switch (result) {
+        case UAInAppMessagePrepareResultSuccess:
+            return @"success";
+        case UAInAppMessagePrepareResultRetry:
+            return @"retry";
+        case UAInAppMessagePrepareResultCancel:
+            return @"cancel";
+        case UAInAppMessagePrepareResultInvalidate:
+            return @"invalidate";
+    }
+}
+
 @interface UAInAppMessageScheduleData : NSObject
 
 @property(nonatomic, strong, nonnull) id<UAInAppMessageAdapterProtocol> adapter;
@@ -82,6 +100,7 @@ NSString *const UAInAppMessageDisplayCoordinatorIsReadyKey = @"isReady";
 @property(nonatomic, strong) UAAnalytics *analytics;
 @property(nonatomic, strong) UAInAppMessageAssetManager *assetManager;
 @property(nonatomic, strong) NSMapTable *displayCoordinatorReadyListeners;
+@property(nonatomic, strong) NSMapTable<id, NSMutableOrderedSet<NSString *> *> *displayCoordinatorReadyQueues;
 
 @end
 
@@ -128,13 +147,14 @@ NSString *const UAInAppMessageDisplayCoordinatorIsReadyKey = @"isReady";
 
         self.scheduleData = [NSMutableDictionary dictionary];
         self.adapterFactories = [NSMutableDictionary dictionary];
-        self.prepareSchedulePipeline = [UARetriablePipeline pipeline];
+        self.prepareSchedulePipeline = [UARetriablePipeline pipelineWithMaxConcurrentOperationCount:UAInAppMessageManagerMaxConcurrentPrepares];
         self.immediateDisplayCoordinator = [UAInAppMessageImmediateDisplayCoordinator coordinator];
 
         self.defaultDisplayCoordinator.displayInterval = self.displayInterval;
         [self setDefaultAdapterFactories];
 
         self.displayCoordinatorReadyListeners = [NSMapTable weakToStrongObjectsMapTable];
+        self.displayCoordinatorReadyQueues = [NSMapTable weakToStrongObjectsMapTable];
     }
 
     return self;
@@ -195,10 +215,25 @@ NSString *const UAInAppMessageDisplayCoordinatorIsReadyKey = @"isReady";
     return factory(message);
 }
 
+- (nullable UAInAppMessageScheduleData *)scheduleDataForScheduleID:(NSString *)scheduleID {
+    // Schedules prepare concurrently, so the data can be set from any thread
+    @synchronized (self.scheduleData) {
+        return self.scheduleData[scheduleID];
+    }
+}
+
+- (void)setScheduleData:(nullable UAInAppMessageScheduleData *)data forScheduleID:(NSString *)scheduleID {
+    @synchronized (self.scheduleData) {
+        self.scheduleData[scheduleID] = data;
+    }
+}
+
 - (void)scheduleExecutionAborted:(NSString *)scheduleID {
-    UAInAppMessageScheduleData *data = self.scheduleData[scheduleID];
-    if (data) {
-        [self.assetManager onDisplayFinished:data.message scheduleID:scheduleID];
+    [self removeScheduleIDFromReadyQueues:scheduleID];
+
+    // The schedule is prepared again, so its assets are kept for the next version
+    if ([self scheduleDataForScheduleID:scheduleID]) {
+        [self.assetManager onScheduleInvalidated:scheduleID];
     }
 }
 
@@ -206,7 +241,11 @@ NSString *const UAInAppMessageDisplayCoordinatorIsReadyKey = @"isReady";
                                       scheduleID:(NSString *)scheduleID
                                     resultHandler:(UARetriableCompletionHandler)resultHandler {
     return [UARetriable retriableWithRunBlock:^(UARetriableCompletionHandler _Nonnull handler) {
+        [[UAScheduleTimelineRecorder shared] beginStage:UAScheduleTimelineStageAssets scheduleID:scheduleID];
         [self.assetManager onPrepareMessage:message scheduleID:scheduleID completionHandler:^(UAInAppMessagePrepareResult result) {
+            [[UAScheduleTimelineRecorder shared] endStage:UAScheduleTimelineStageAssets
+                                               scheduleID:scheduleID
+                                                   result:UAInAppMessagePrepareResultName(result)];
             switch (result) {
                 case UAInAppMessagePrepareResultSuccess:
                     handler(UARetriableResultSuccess);
@@ -234,8 +273,12 @@ NSString *const UAInAppMessageDisplayCoordinatorIsReadyKey = @"isReady";
         UA_STRONGIFY(self)
         [self.assetManager assetsForScheduleID:scheduleID completionHandler:^(UAInAppMessageAssets *assets) {
             [self.dispatcher dispatchAsync:^{
+                [[UAScheduleTimelineRecorder shared] beginStage:UAScheduleTimelineStageAdapterPrepare scheduleID:scheduleID];
                 [adapter prepareWithAssets:assets completionHandler:^void(UAInAppMessagePrepareResult prepareResult) {
                     UA_LDEBUG(@"Prepare result: %ld schedule: %@", (unsigned long)prepareResult, scheduleID);
+                    [[UAScheduleTimelineRecorder shared] endStage:UAScheduleTimelineStageAdapterPrepare
+                                                       scheduleID:scheduleID
+                                                           result:UAInAppMessagePrepareResultName(prepareResult)];
                     switch (prepareResult) {
                         case UAInAppMessagePrepareResultSuccess:
                             handler(UARetriableResultSuccess);
@@ -289,6 +332,7 @@ NSString *const UAInAppMessageDisplayCoordinatorIsReadyKey = @"isReady";
             case UARetriableResultSuccess:
                 return;
             case UARetriableResultRetry:
+            case UARetriableResultServerError:
                 prepareResult = UAAutomationSchedulePrepareResultInvalidate;
                 break;
             case UARetriableResultCancel:
@@ -309,12 +353,14 @@ NSString *const UAInAppMessageDisplayCoordinatorIsReadyKey = @"isReady";
         switch (result) {
             case UARetriableResultSuccess:
                 prepareResult = UAAutomationSchedulePrepareResultContinue;
-                self.scheduleData[scheduleID] = [UAInAppMessageScheduleData dataWithAdapter:adapter
-                                                                                 scheduleID:scheduleID
-                                                                                    message:message
-                                                                         displayCoordinator:displayCoordinator];
+                [self setScheduleData:[UAInAppMessageScheduleData dataWithAdapter:adapter
+                                                                       scheduleID:scheduleID
+                                                                          message:message
+                                                               displayCoordinator:displayCoordinator]
+                        forScheduleID:scheduleID];
                 break;
             case UARetriableResultRetry:
+            case UARetriableResultServerError:
                 prepareResult = UAAutomationSchedulePrepareResultInvalidate;
                 break;
             case UARetriableResultCancel:
@@ -323,7 +369,7 @@ NSString *const UAInAppMessageDisplayCoordinatorIsReadyKey = @"isReady";
                 break;
             case UARetriableResultInvalidate:
                 prepareResult = UAAutomationSchedulePrepareResultInvalidate;
-                [self.assetManager onDisplayFinished:message scheduleID:scheduleID];
+                [self.assetManager onScheduleInvalidated:scheduleID];
                 break;
         }
         completionHandler(prepareResult);
@@ -347,7 +393,7 @@ NSString *const UAInAppMessageDisplayCoordinatorIsReadyKey = @"isReady";
 - (UAAutomationScheduleReadyResult)isReadyToDisplay:(NSString *)scheduleID {
     UA_LTRACE(@"Checking if schedule %@ is ready to execute.", scheduleID);
 
-    UAInAppMessageScheduleData *data = self.scheduleData[scheduleID];
+    UAInAppMessageScheduleData *data = [self scheduleDataForScheduleID:scheduleID];
     if (!data) {
         UA_LERR("No data for schedule: %@", scheduleID);
         return UAAutomationScheduleReadyResultInvalidate;
@@ -355,14 +401,22 @@ NSString *const UAInAppMessageDisplayCoordinatorIsReadyKey = @"isReady";
 
     NSObject<UAInAppMessageDisplayCoordinator> *displayCoordinator = (NSObject<UAInAppMessageDisplayCoordinator>*)data.displayCoordinator;
 
+    // Measures from the first check until the schedule is ready
+    [[UAScheduleTimelineRecorder shared] beginStage:UAScheduleTimelineStageReady scheduleID:scheduleID];
+
     // If display coordinator puts back pressure on display, check again when it's ready
     if (![displayCoordinator isReady]) {
         UA_LTRACE(@"Display coordinator %@ not ready. Retrying schedule %@ later.", displayCoordinator, scheduleID);
 
+        // Keep the prepared schedule queued so it is handed off as soon as the coordinator is ready
+        [self enqueueScheduleID:scheduleID displayCoordinator:displayCoordinator];
+
+        UA_WEAKIFY(self)
         __block UADisposable *disposable = [displayCoordinator observeAtKeyPath:UAInAppMessageDisplayCoordinatorIsReadyKey withBlock:^(id value) {
+            UA_STRONGIFY(self)
             if ([value boolValue]) {
-                [self.executionDelegate executionReadinessChanged];
                 [disposable dispose];
+                [self.executionDelegate executionReadinessChangedForScheduleIDs:[self dequeueScheduleIDsForDisplayCoordinator:displayCoordinator]];
             }
         }];
 
@@ -381,13 +435,41 @@ NSString *const UAInAppMessageDisplayCoordinatorIsReadyKey = @"isReady";
     }
 
     UA_LTRACE(@"Schedule %@ ready!", scheduleID);
+    [[UAScheduleTimelineRecorder shared] endStage:UAScheduleTimelineStageReady scheduleID:scheduleID result:nil];
     return UAAutomationScheduleReadyResultContinue;
 }
 
+- (void)enqueueScheduleID:(NSString *)scheduleID displayCoordinator:(id<UAInAppMessageDisplayCoordinator>)displayCoordinator {
+    @synchronized (self.displayCoordinatorReadyQueues) {
+        NSMutableOrderedSet *queue = [self.displayCoordinatorReadyQueues objectForKey:displayCoordinator];
+        if (!queue) {
+            queue = [NSMutableOrderedSet orderedSet];
+            [self.displayCoordinatorReadyQueues setObject:queue forKey:displayCoordinator];
+        }
+        [queue addObject:scheduleID];
+    }
+}
+
+- (NSArray<NSString *> *)dequeueScheduleIDsForDisplayCoordinator:(id<UAInAppMessageDisplayCoordinator>)displayCoordinator {
+    @synchronized (self.displayCoordinatorReadyQueues) {
+        NSArray *scheduleIDs = [[self.displayCoordinatorReadyQueues objectForKey:displayCoordinator] array] ?: @[];
+        [self.displayCoordinatorReadyQueues removeObjectForKey:displayCoordinator];
+        return scheduleIDs;
+    }
+}
+
+- (void)removeScheduleIDFromReadyQueues:(NSString *)scheduleID {
+    @synchronized (self.displayCoordinatorReadyQueues) {
+        for (NSMutableOrderedSet *queue in self.displayCoordinatorReadyQueues.objectEnumerator) {
+            [queue removeObject:scheduleID];
+        }
+    }
+}
+
 - (void)displayMessageWithScheduleID:(NSString *)scheduleID
                    completionHandler:(void (^)(void))completionHandler {
 
-    UAInAppMessageScheduleData *scheduleData = self.scheduleData[scheduleID];
+    UAInAppMessageScheduleData *scheduleData = [self scheduleDataForScheduleID:scheduleID];
     if (!scheduleData) {
         completionHandler();
         return;
@@ -397,6 +479,8 @@ NSString *const UAInAppMessageDisplayCoordinatorIsReadyKey = @"isReady";
     id<UAInAppMessageAdapterProtocol> adapter = scheduleData.adapter;
     id<UAInAppMessageDisplayCoordinator> displayCoordinator = scheduleData.displayCoordinator;
 
+    [self removeScheduleIDFromReadyQueues:scheduleID];
+
     // Notify delegate that the message is about to be displayed
     id<UAInAppMessagingDelegate> delegate = self.delegate;
     if ([delegate respondsToSelector:@selector(messageWillBeDisplayed:scheduleID:)]) {
@@ -455,7 +539,7 @@ NSString *const UAInAppMessageDisplayCoordinatorIsReadyKey = @"isReady";
             }];
         }
 
-        [self.scheduleData removeObjectForKey:scheduleID];
+        [self setScheduleData:nil forScheduleID:scheduleID];
 
         // Notify delegate that the message has finished displaying
         id<UAInAppMessagingDelegate> delegate = self.delegate;
@@ -473,28 +557,35 @@ NSString *const UAInAppMessageDisplayCoordinatorIsReadyKey = @"isReady";
         completionHandler();
     };
 
+    UAScheduleTimelineRecorder *timelineRecorder = [UAScheduleTimelineRecorder shared];
+    [timelineRecorder beginStage:UAScheduleTimelineStageDisplay scheduleID:scheduleID];
     [adapter display:displayCompletionHandler];
+    [timelineRecorder endStage:UAScheduleTimelineStageDisplay scheduleID:scheduleID result:nil];
+    [timelineRecorder finishTimelineWithScheduleID:scheduleID outcome:UAScheduleTimelineOutcomeDisplayed];
 }
 
 - (void)messageScheduled:(UAInAppMessage *)message
-              scheduleID:(NSString *)scheduleID {
-    [self.assetManager onMessageScheduled:message scheduleID:scheduleID];
+                schedule:(UASchedule *)schedule {
+    [self.assetManager onMessageScheduled:message schedule:schedule];
 }
 
 - (void)messageExpired:(UAInAppMessage *)message
             scheduleID:(NSString *)scheduleID
         expirationDate:(NSDate *)date {
+    [self removeScheduleIDFromReadyQueues:scheduleID];
     [self.assetManager onScheduleFinished:scheduleID];
 }
 
 - (void)messageCancelled:(UAInAppMessage *)message
               scheduleID:(NSString *)scheduleID {
+    [self removeScheduleIDFromReadyQueues:scheduleID];
     [self.assetManager onScheduleFinished:scheduleID];
 
 }
 
 - (void)messageLimitReached:(UAInAppMessage *)message
                  scheduleID:(NSString *)scheduleID {
+    [self removeScheduleIDFromReadyQueues:scheduleID];
     [self.assetManager onScheduleFinished:scheduleID];
 }
 
@@ -48,6 +48,14 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (instancetype)mediaViewWithMediaInfo:(UAInAppMessageMediaInfo *)mediaInfo imageData:(NSData *)imageData;
 
+/**
+ * Factory method for creating an in-app message media view with a decoded image.
+ *
+ * @param mediaInfo The media info.
+ * @param image The image.
+ */
++ (instancetype)mediaViewWithMediaInfo:(UAInAppMessageMediaInfo *)mediaInfo image:(nullable UIImage *)image;
+
 
 
 @end
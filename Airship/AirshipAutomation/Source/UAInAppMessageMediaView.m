@@ -2,16 +2,19 @@
 
 #import "UAInAppMessageMediaView+Internal.h"
 #import "AVFoundation/AVFoundation.h"
+#import <AVKit/AVKit.h>
 #import "UAInAppMessageUtils+Internal.h"
 #import "UAAirshipAutomationCoreImport.h"
 #import "UIImage+UAAdditions+Internal.h"
+#import "UAWebViewPool+Internal.h"
 NS_ASSUME_NONNULL_BEGIN
 
 static CGFloat const DefaultVideoHeightPadding = 60;
 
 @interface UAInAppMessageMediaView()
 @property (nonatomic, strong, nullable) UIImageView *imageView;
-@property (nonatomic, strong, nullable) WKWebView *webView;
+@property (nonatomic, strong, nullable) UAWebView *webView;
+@property (nonatomic, strong, nullable) AVPlayerViewController *playerViewController;
 
 @property (nonatomic, strong) UAInAppMessageMediaInfo *mediaInfo;
 
@@ -32,11 +35,20 @@ static CGFloat const DefaultVideoHeightPadding = 60;
     return [[self alloc] initWithMediaInfo:mediaInfo imageData:imageData];
 }
 
++ (instancetype)mediaViewWithMediaInfo:(UAInAppMessageMediaInfo *)mediaInfo image:(nullable UIImage *)image {
+    return [[self alloc] initWithMediaInfo:mediaInfo image:image isImage:YES];
+}
+
 - (instancetype)initWithMediaInfo:(UAInAppMessageMediaInfo *)mediaInfo imageData:(nullable NSData *)imageData {
+    UIImage *image = imageData ? [UIImage fancyImageWithData:imageData] : nil;
+    return [self initWithMediaInfo:mediaInfo image:image isImage:imageData != nil];
+}
+
+- (instancetype)initWithMediaInfo:(UAInAppMessageMediaInfo *)mediaInfo image:(nullable UIImage *)image isImage:(BOOL)isImage {
     self = [super init];
 
     if (self) {
-        if (imageData) {
+        if (isImage) {
             self.translatesAutoresizingMaskIntoConstraints = NO;
             self.webView = nil;
             self.mediaContainer = [[UIView alloc] init];
@@ -48,12 +60,13 @@ static CGFloat const DefaultVideoHeightPadding = 60;
             self.imageView = [[UIImageView alloc] initWithFrame:self.frame];
             [self.mediaContainer addSubview:self.imageView];
 
-            UIImage *image = [UIImage fancyImageWithData:imageData];
             [self.imageView setImage:image];
             [UAViewUtils applyContainerConstraintsToContainer:self.mediaContainer containedView:self.imageView];
 
             // Apply style padding
             [UAInAppMessageUtils applyPaddingToView:self.mediaContainer padding:self.style.additionalPadding replace:NO];
+        } else if (mediaInfo.type == UAInAppMessageMediaInfoTypeVideo) {
+            [self setUpPlayerMediaView:mediaInfo];
         } else {
             [self setUpWebBasedMediaView:mediaInfo];
             [self.webView setBackgroundColor:[UIColor blackColor]];
@@ -64,7 +77,7 @@ static CGFloat const DefaultVideoHeightPadding = 60;
     return self;
 }
 
-- (void)setUpWebBasedMediaView:(UAInAppMessageMediaInfo *)mediaInfo {
+- (void)setUpMediaContainer:(UAInAppMessageMediaInfo *)mediaInfo {
     self.translatesAutoresizingMaskIntoConstraints = NO;
     self.mediaInfo = mediaInfo;
 
@@ -75,12 +88,13 @@ static CGFloat const DefaultVideoHeightPadding = 60;
     self.mediaContainer.opaque = NO;
     [self addSubview:self.mediaContainer];
     [UAViewUtils applyContainerConstraintsToContainer:self containedView:self.mediaContainer];
+}
 
-    WKWebViewConfiguration *config = [[WKWebViewConfiguration alloc] init];
-    config.allowsInlineMediaPlayback = YES;
-    config.allowsPictureInPictureMediaPlayback = YES;
+- (void)setUpWebBasedMediaView:(UAInAppMessageMediaInfo *)mediaInfo {
+    [self setUpMediaContainer:mediaInfo];
 
-    self.webView = [[WKWebView alloc] initWithFrame:self.frame configuration:config];
+    // Pooled web views share a pre-warmed content process
+    self.webView = [[UAWebViewPool shared] checkOutWebView];
     [self.webView.scrollView setScrollEnabled:NO];
 
     [self.mediaContainer addSubview:self.webView];
@@ -89,6 +103,49 @@ static CGFloat const DefaultVideoHeightPadding = 60;
 
     // Apply style padding
     [UAInAppMessageUtils applyPaddingToView:self.mediaContainer padding:self.style.additionalPadding replace:NO];
+
+    // Start loading while the message is prepared instead of when it is displayed
+    if (mediaInfo.type == UAInAppMessageMediaInfoTypeYouTube) {
+        NSString *urlString = [NSString stringWithFormat:@"%@%@", mediaInfo.url, @"?playsinline=1"];
+        NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:urlString]];
+        [self.webView loadRequest:request];
+    }
+}
+
+- (void)setUpPlayerMediaView:(UAInAppMessageMediaInfo *)mediaInfo {
+    [self setUpMediaContainer:mediaInfo];
+
+    // Direct video URLs play natively, and start buffering while the message is prepared
+    self.playerViewController = [[AVPlayerViewController alloc] init];
+    self.playerViewController.player = [AVPlayer playerWithURL:[NSURL URLWithString:mediaInfo.url]];
+    self.playerViewController.view.backgroundColor = [UIColor blackColor];
+
+    [self.mediaContainer addSubview:self.playerViewController.view];
+
+    [UAViewUtils applyContainerConstraintsToContainer:self.mediaContainer containedView:self.playerViewController.view];
+
+    // Apply style padding
+    [UAInAppMessageUtils applyPaddingToView:self.mediaContainer padding:self.style.additionalPadding replace:NO];
+}
+
+- (void)didMoveToWindow {
+    [super didMoveToWindow];
+
+    if (!self.window || !self.playerViewController || self.playerViewController.parentViewController) {
+        return;
+    }
+
+    // The player controller needs a parent to present its full screen playback
+    UIResponder *responder = self.nextResponder;
+    while (responder && ![responder isKindOfClass:[UIViewController class]]) {
+        responder = responder.nextResponder;
+    }
+
+    UIViewController *parentViewController = (UIViewController *)responder;
+    if (parentViewController) {
+        [parentViewController addChildViewController:self.playerViewController];
+        [self.playerViewController didMoveToParentViewController:parentViewController];
+    }
 }
 
 - (void)didMoveToSuperview {
@@ -99,17 +156,10 @@ static CGFloat const DefaultVideoHeightPadding = 60;
     }
 
     switch (self.mediaInfo.type) {
-        case UAInAppMessageMediaInfoTypeVideo: {
-            NSString *html = [NSString stringWithFormat:@"<body style=\"margin:0\"><video playsinline controls height=\"100%%\" width=\"100%%\" src=\"%@\"></video></body>", self.mediaInfo.url];
-            [self.webView loadHTMLString:html baseURL:[NSURL URLWithString:self.mediaInfo.url]];
-            break;
-        }
-        case UAInAppMessageMediaInfoTypeYouTube: {
-            NSString *urlString = [NSString stringWithFormat:@"%@%@", self.mediaInfo.url, @"?playsinline=1"];
-            NSURLRequest *request = [NSURLRequest requestWithURL:[NSURL URLWithString:urlString]];
-            [self.webView loadRequest:request];
+        case UAInAppMessageMediaInfoTypeVideo:
+        case UAInAppMessageMediaInfoTypeYouTube:
+            // Loaded when the media view was created
             break;
-        }
         case UAInAppMessageMediaInfoTypeImage: {
             if (!self.imageView) {
                 // Skip setting aspect constraints as these are handled by webview
@@ -153,6 +203,16 @@ static CGFloat const DefaultVideoHeightPadding = 60;
 - (void)dealloc {
     [[NSNotificationCenter defaultCenter] removeObserver:self.videoWindowResignedKey];
     [[NSNotificationCenter defaultCenter] removeObserver:self.modalWindowResignedKey];
+
+    if (self.webView) {
+        [[UAWebViewPool shared] checkInWebView:self.webView];
+    }
+
+    if (self.playerViewController) {
+        [self.playerViewController.player pause];
+        [self.playerViewController willMoveToParentViewController:nil];
+        [self.playerViewController removeFromParentViewController];
+    }
 }
 
 -(void)layoutSubviews {
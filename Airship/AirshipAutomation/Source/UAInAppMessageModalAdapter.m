@@ -44,6 +44,7 @@ NSString *const UAModalStyleFileName = @"UAInAppMessageModalStyle";
             self.modalController = [UAInAppMessageModalViewController modalControllerWithDisplayContent:displayContent
                                                                                               mediaView:mediaView
                                                                                                   style:self.style];
+            [self.modalController prepareViews];
         }
         completionHandler(result);
     }];
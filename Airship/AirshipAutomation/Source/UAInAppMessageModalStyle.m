@@ -25,19 +25,9 @@ NSString *const UAModalMaxHeightKey = @"maxHeight";
         return style;
     }
 
-    NSString *path = [[NSBundle mainBundle] pathForResource:file ofType:@"plist"];
-
-    if (!path) {
-        return style;
-
-    }
-
-    NSDictionary *normalizedModalStyleDict;
-    NSDictionary *modalStyleDict = [[NSDictionary alloc] initWithContentsOfFile:path];
-
-    if (modalStyleDict) {
-        normalizedModalStyleDict = [UAInAppMessageUtils normalizeStyleDictionary:modalStyleDict];
+    NSDictionary *normalizedModalStyleDict = [UAInAppMessageUtils styleDictionaryWithContentsOfFile:file];
 
+    if (normalizedModalStyleDict) {
         id dismissIconResource = normalizedModalStyleDict[UAModalDismissIconResourceKey];
         if (dismissIconResource) {
             if (![dismissIconResource isKindOfClass:[NSString class]]) {
@@ -43,6 +43,12 @@ NS_ASSUME_NONNULL_BEGIN
                                         mediaView:(nullable UAInAppMessageMediaView *)mediaView
                                             style:(nullable UAInAppMessageModalStyle *)style;
 
+/**
+ * Loads the modal view and builds its content ahead of display.
+ * Must be called on the main queue.
+ */
+- (void)prepareViews;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -137,6 +137,11 @@ static CGFloat const ModalCloseButtonViewWidth = 46.0;
     return closeButton;
 }
 
+- (void)prepareViews {
+    // The modal content does not depend on its window, so the nib and subviews can be loaded early
+    [self loadViewIfNeeded];
+}
+
 #pragma mark -
 #pragma mark Core Functionality
 
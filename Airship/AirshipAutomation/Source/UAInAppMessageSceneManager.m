@@ -8,13 +8,19 @@
 @end
 
 @implementation UAInAppMessageSceneManager
-static UAInAppMessageSceneManager *shared_;
-
-+ (void)load {
-    shared_ = [UAInAppMessageSceneManager managerWithNotificationCenter:[NSNotificationCenter defaultCenter]];
-}
 
 + (instancetype)shared {
+    static UAInAppMessageSceneManager *shared_;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        shared_ = [UAInAppMessageSceneManager managerWithNotificationCenter:[NSNotificationCenter defaultCenter]];
+
+        // Created on first use, so pick up any scenes that connected before then
+        if (@available(iOS 13.0, tvOS 13.0, *)) {
+            [shared_.scenes addObjectsFromArray:[UIApplication sharedApplication].connectedScenes.allObjects];
+        }
+    });
+
     return shared_;
 }
 
@@ -47,7 +53,9 @@ static UAInAppMessageSceneManager *shared_;
 }
 
 - (void)sceneAdded:(NSNotification *)notification API_AVAILABLE(ios(13.0)) {
-    [self.scenes addObject:notification.object];
+    if (![self.scenes containsObject:notification.object]) {
+        [self.scenes addObject:notification.object];
+    }
 }
 
 - (void)sceneRemoved:(NSNotification *)notification API_AVAILABLE(ios(13.0))  {
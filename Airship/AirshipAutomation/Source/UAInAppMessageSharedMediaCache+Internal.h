@@ -0,0 +1,57 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Info.plist key for the app group whose container holds the shared media cache. The app and
+ * its notification extensions must all set the same group to share downloaded media.
+ */
+extern NSString * const UAInAppMessageSharedMediaCacheAppGroupKey;
+
+/**
+ * App side of the media cache shared with the notification service extension through an app
+ * group container, so rich push media is not downloaded again for in-app messages.
+ *
+ * The layout must match `UAMediaAttachmentCache` in the service extension: entries are stored
+ * under the SHA-256 hash of the media URL with the URL's path extension, and expire after 7 days.
+ */
+@interface UAInAppMessageSharedMediaCache : NSObject
+
+/**
+ * Factory method.
+ *
+ * @return A cache for the app group set in the main bundle's Info.plist, or `nil` if no app
+ * group is set or its container is not available.
+ */
++ (nullable instancetype)sharedCache;
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param directoryURL The cache directory.
+ * @return A cache instance.
+ */
++ (instancetype)cacheWithDirectoryURL:(NSURL *)directoryURL;
+
+/**
+ * Copies a cached file for a media URL.
+ *
+ * @param mediaURL The media URL.
+ * @param destinationURL The destination. Any existing file is replaced.
+ * @return `YES` if the media was cached and copied, otherwise `NO`.
+ */
+- (BOOL)copyCachedFileForURL:(NSURL *)mediaURL toURL:(NSURL *)destinationURL;
+
+/**
+ * Stores a copy of a downloaded file for a media URL.
+ *
+ * @param fileURL The downloaded file.
+ * @param mediaURL The media URL.
+ */
+- (void)storeFile:(NSURL *)fileURL forURL:(NSURL *)mediaURL;
+
+@end
+
+NS_ASSUME_NONNULL_END
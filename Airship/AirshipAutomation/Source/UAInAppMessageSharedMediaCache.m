@@ -0,0 +1,122 @@
+/* Copyright Airship and Contributors */
+
+#import "UAInAppMessageSharedMediaCache+Internal.h"
+#import "UAAirshipAutomationCoreImport.h"
+
+NSString * const UAInAppMessageSharedMediaCacheAppGroupKey = @"UAMediaCacheAppGroup";
+
+// Must match the extension side of the cache
+static NSString * const UAInAppMessageSharedMediaCacheDirectory = @"Library/Caches/com.urbanairship.shared_media";
+static NSTimeInterval const UAInAppMessageSharedMediaCacheMaxAge = 7 * 24 * 60 * 60;
+
+@interface UAInAppMessageSharedMediaCache ()
+@property (nonatomic, strong) NSURL *directoryURL;
+@end
+
+@implementation UAInAppMessageSharedMediaCache
+
+- (instancetype)initWithDirectoryURL:(NSURL *)directoryURL {
+    self = [super init];
+    if (self) {
+        self.directoryURL = directoryURL;
+    }
+    return self;
+}
+
++ (nullable instancetype)sharedCache {
+    id appGroup = [[NSBundle mainBundle] objectForInfoDictionaryKey:UAInAppMessageSharedMediaCacheAppGroupKey];
+    if (![appGroup isKindOfClass:[NSString class]] || ![appGroup length]) {
+        return nil;
+    }
+
+    NSURL *containerURL = [[NSFileManager defaultManager] containerURLForSecurityApplicationGroupIdentifier:appGroup];
+    if (!containerURL) {
+        UA_LERR(@"Unable to access app group container: %@", appGroup);
+        return nil;
+    }
+
+    return [[self alloc] initWithDirectoryURL:[containerURL URLByAppendingPathComponent:UAInAppMessageSharedMediaCacheDirectory isDirectory:YES]];
+}
+
++ (instancetype)cacheWithDirectoryURL:(NSURL *)directoryURL {
+    return [[self alloc] initWithDirectoryURL:directoryURL];
+}
+
+- (NSURL *)entryURLForURL:(NSURL *)mediaURL {
+    NSString *name = [UAUtils sha256HashWithString:mediaURL.absoluteString];
+
+    NSString *extension = mediaURL.pathExtension.lowercaseString;
+    if (extension.length) {
+        name = [name stringByAppendingPathExtension:extension];
+    }
+
+    return [self.directoryURL URLByAppendingPathComponent:name];
+}
+
+- (BOOL)isExpired:(NSURL *)entryURL {
+    NSDate *modified;
+    if (![entryURL getResourceValue:&modified forKey:NSURLContentModificationDateKey error:nil] || !modified) {
+        return YES;
+    }
+
+    return -[modified timeIntervalSinceNow] > UAInAppMessageSharedMediaCacheMaxAge;
+}
+
+- (BOOL)copyCachedFileForURL:(NSURL *)mediaURL toURL:(NSURL *)destinationURL {
+    NSFileManager *fm = [NSFileManager defaultManager];
+    NSURL *entryURL = [self entryURLForURL:mediaURL];
+
+    if (![fm fileExistsAtPath:entryURL.path] || [self isExpired:entryURL]) {
+        return NO;
+    }
+
+    [fm removeItemAtURL:destinationURL error:nil];
+
+    NSError *error;
+    if (![fm copyItemAtURL:entryURL toURL:destinationURL error:&error]) {
+        UA_LERR(@"Unable to copy shared media for %@: %@", mediaURL, error);
+        return NO;
+    }
+
+    UA_LTRACE(@"Using shared media for %@", mediaURL);
+    return YES;
+}
+
+- (void)storeFile:(NSURL *)fileURL forURL:(NSURL *)mediaURL {
+    NSFileManager *fm = [NSFileManager defaultManager];
+    [fm createDirectoryAtURL:self.directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+
+    [self removeExpiredEntries];
+
+    // Copy next to the entry and then swap it in so other processes never read a partial file
+    NSURL *entryURL = [self entryURLForURL:mediaURL];
+    NSURL *stagingURL = [self.directoryURL URLByAppendingPathComponent:[NSString stringWithFormat:@".%@", [NSUUID UUID].UUIDString]];
+
+    NSError *error;
+    if (![fm copyItemAtURL:fileURL toURL:stagingURL error:&error]) {
+        UA_LERR(@"Unable to store shared media for %@: %@", mediaURL, error);
+        return;
+    }
+
+    // rename replaces any existing entry atomically
+    if (rename(stagingURL.fileSystemRepresentation, entryURL.fileSystemRepresentation) != 0) {
+        UA_LERR(@"Unable to store shared media for %@: %s", mediaURL, strerror(errno));
+        [fm removeItemAtURL:stagingURL error:nil];
+    }
+}
+
+- (void)removeExpiredEntries {
+    NSFileManager *fm = [NSFileManager defaultManager];
+    NSArray<NSURL *> *entries = [fm contentsOfDirectoryAtURL:self.directoryURL
+                                  includingPropertiesForKeys:@[NSURLContentModificationDateKey]
+                                                     options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                       error:nil];
+
+    for (NSURL *entryURL in entries) {
+        if ([self isExpired:entryURL]) {
+            [fm removeItemAtURL:entryURL error:nil];
+        }
+    }
+}
+
+@end
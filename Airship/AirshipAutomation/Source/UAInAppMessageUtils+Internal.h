@@ -76,9 +76,11 @@
 /**
  * Prepares in-app message to display.
  *
+ * Cached images are decoded and downsampled to the screen size on a background queue.
+ *
  * @param media media info object for this message
  * @param assets the assets for this message
- * @param completionHandler the completion handler to be called when media is ready.
+ * @param completionHandler the completion handler to be called on the main queue when media is ready.
  */
 + (void)prepareMediaView:(UAInAppMessageMediaInfo *)media assets:(UAInAppMessageAssets *)assets completionHandler:(void (^)(UAInAppMessagePrepareResult, UAInAppMessageMediaView *))completionHandler;
 
@@ -98,6 +100,15 @@
  */
 + (NSDictionary *)normalizeStyleDictionary:(NSDictionary *)keyedValues;
 
+/**
+ * Loads and normalizes a style plist from the main bundle. Results are cached, so each
+ * plist is only read and normalized once per process.
+ *
+ * @param file The plist file name, without the extension.
+ * @return The normalized dictionary of style values, or `nil` if the plist could not be loaded.
+ */
++ (nullable NSDictionary *)styleDictionaryWithContentsOfFile:(nullable NSString *)file;
+
 
 /**
  * Checks if binary data represents a gif.
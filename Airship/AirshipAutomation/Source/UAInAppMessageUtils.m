@@ -3,6 +3,7 @@
 #import "UAInAppMessageUtils+Internal.h"
 #import "UAInAppMessageButtonView+Internal.h"
 #import "UAInAppMessageAssets.h"
+#import "UIImage+UAAdditions+Internal.h"
 #import "UAAirshipAutomationCoreImport.h"
 
 NSString *const UADefaultSerifFont = @"Times New Roman";
@@ -11,8 +12,72 @@ NSString *const UAInAppMessageAdapterCacheName = @"UAInAppMessageAdapterCache";
 static CGFloat const CloseButtonWidth = 30;
 static CGFloat const CloseButtonHeight = 30;
 
+// Maximum number of resolved fonts and text attributes kept in memory
+static NSUInteger const UAInAppMessageTextCacheLimit = 100;
+
+// Estimated size of a resolved font, text attributes or style entry
+static NSUInteger const UAInAppMessageTextCacheEstimatedEntrySize = 512;
+
 @implementation UAInAppMessageUtils
 
++ (NSCache *)cacheWithName:(NSString *)name {
+    NSCache *cache = [[NSCache alloc] init];
+    cache.name = name;
+    cache.countLimit = UAInAppMessageTextCacheLimit;
+    [[UAMemoryPressureCoordinator shared] registerCache:cache
+                                               priority:UAMemoryPressurePriorityLow
+                                     estimatedEntrySize:UAInAppMessageTextCacheEstimatedEntrySize];
+    return cache;
+}
+
+/**
+ * Resolved font family names, keyed by the requested font families.
+ */
++ (NSCache<NSArray *, NSString *> *)fontFamilyCache {
+    static NSCache *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [self cacheWithName:@"com.urbanairship.iam.font_families"];
+    });
+    return cache;
+}
+
+/**
+ * Fonts, keyed by family, traits and size.
+ */
++ (NSCache<NSString *, UIFont *> *)fontCache {
+    static NSCache *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [self cacheWithName:@"com.urbanairship.iam.fonts"];
+    });
+    return cache;
+}
+
+/**
+ * Text attributes, keyed by the text info and text style values they are built from.
+ */
++ (NSCache<NSString *, NSDictionary *> *)textAttributesCache {
+    static NSCache *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [self cacheWithName:@"com.urbanairship.iam.text_attributes"];
+    });
+    return cache;
+}
+
+/**
+ * Normalized style plists, keyed by bundle path and file name. Missing plists are stored as `NSNull`.
+ */
++ (NSCache<NSString *, id> *)styleDictionaryCache {
+    static NSCache *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [self cacheWithName:@"com.urbanairship.iam.styles"];
+    });
+    return cache;
+}
+
 + (void)applyButtonInfo:(UAInAppMessageButtonInfo *)buttonInfo style:(UAInAppMessageButtonStyle *)style button:(UAInAppMessageButton *)button buttonMargin:(CGFloat)buttonMargin  {
     button.backgroundColor = buttonInfo.backgroundColor;
 
@@ -221,6 +286,27 @@ static CGFloat const CloseButtonHeight = 30;
     return normalizedValues;
 }
 
++ (NSDictionary *)styleDictionaryWithContentsOfFile:(NSString *)file {
+    if (!file) {
+        return nil;
+    }
+
+    NSBundle *bundle = [NSBundle mainBundle];
+    NSString *key = [NSString stringWithFormat:@"%@|%@", bundle.bundlePath, file];
+
+    id cached = [[self styleDictionaryCache] objectForKey:key];
+    if (cached) {
+        return cached == [NSNull null] ? nil : cached;
+    }
+
+    NSString *path = [bundle pathForResource:file ofType:@"plist"];
+    NSDictionary *styleDict = path ? [[NSDictionary alloc] initWithContentsOfFile:path] : nil;
+    NSDictionary *normalizedStyleDict = styleDict ? [[self normalizeStyleDictionary:styleDict] copy] : nil;
+
+    [[self styleDictionaryCache] setObject:normalizedStyleDict ?: [NSNull null] forKey:key];
+    return normalizedStyleDict;
+}
+
 #pragma mark -
 #pragma mark Helpers
 
@@ -248,6 +334,28 @@ static CGFloat const CloseButtonHeight = 30;
 #endif
 
 + (NSDictionary *)attributesWithTextInfo:(UAInAppMessageTextInfo *)textInfo textStyle:(UAInAppMessageTextStyle *)style {
+    // The scaled font depends on the content size category, so it is part of the key
+    NSString *key = [NSString stringWithFormat:@"%@|%lu|%f|%@|%lu|%@|%@|%@",
+                     [textInfo.fontFamilies componentsJoinedByString:@","],
+                     (unsigned long)textInfo.style,
+                     textInfo.sizePoints,
+                     textInfo.color,
+                     (unsigned long)textInfo.alignment,
+                     style.letterSpacing,
+                     style.lineSpacing,
+                     [UIApplication sharedApplication].preferredContentSizeCategory];
+
+    NSDictionary *cached = [[self textAttributesCache] objectForKey:key];
+    if (cached) {
+        return cached;
+    }
+
+    NSDictionary *attributes = [self buildAttributesWithTextInfo:textInfo textStyle:style];
+    [[self textAttributesCache] setObject:attributes forKey:key];
+    return attributes;
+}
+
++ (NSDictionary *)buildAttributesWithTextInfo:(UAInAppMessageTextInfo *)textInfo textStyle:(UAInAppMessageTextStyle *)style {
     NSMutableDictionary *attributes = [NSMutableDictionary dictionary];
 
     // Font and font style
@@ -279,9 +387,9 @@ static CGFloat const CloseButtonHeight = 30;
         [attributes setObject:paragraphStyle forKey:NSParagraphStyleAttributeName];
     }
 
-    [attributes setObject:paragraphStyle forKey:NSParagraphStyleAttributeName];
+    [attributes setObject:[paragraphStyle copy] forKey:NSParagraphStyleAttributeName];
 
-    return attributes;
+    return [attributes copy];
 }
 
 + (NSTextAlignment)alignmentWithTextInfo:(UAInAppMessageTextInfo *)textInfo {
@@ -310,15 +418,41 @@ static CGFloat const CloseButtonHeight = 30;
         traits = traits | UIFontDescriptorTraitItalic;
     }
 
+    NSString *key = [NSString stringWithFormat:@"%@|%u|%f", fontFamily, traits, textInfo.sizePoints];
+    UIFont *font = [[self fontCache] objectForKey:key];
+    if (font) {
+        return font;
+    }
+
     id attributes = @{ UIFontDescriptorFamilyAttribute: fontFamily,
                        UIFontDescriptorTraitsAttribute: @{UIFontSymbolicTrait: [NSNumber numberWithInteger:traits] }};
 
     UIFontDescriptor *fontDescriptor = [UIFontDescriptor fontDescriptorWithFontAttributes:attributes];
 
-    return [UIFont fontWithDescriptor:fontDescriptor size:textInfo.sizePoints];
+    font = [UIFont fontWithDescriptor:fontDescriptor size:textInfo.sizePoints];
+    [[self fontCache] setObject:font forKey:key];
+    return font;
 }
 
 + (NSString *)resolveFontFamily:(NSArray *)fontFamilies {
+    NSArray *key = [fontFamilies copy] ?: @[];
+    NSString *cached = [[self fontFamilyCache] objectForKey:key];
+    if (cached) {
+        return cached;
+    }
+
+    NSString *family = [self findFontFamily:fontFamilies];
+    if (family) {
+        [[self fontFamilyCache] setObject:family forKey:key];
+        return family;
+    }
+
+    // Not cached, so fonts registered later are still found
+    UA_LDEBUG(@"Unable to find any available font families %@. Defaulting to system font.", fontFamilies);
+    return [UIFont systemFontOfSize:[UIFont systemFontSize]].familyName;
+}
+
++ (nullable NSString *)findFontFamily:(NSArray *)fontFamilies {
     for (id fontFamily in fontFamilies) {
         if (![fontFamily isKindOfClass:[NSString class]]) {
             continue;
@@ -339,8 +473,7 @@ static CGFloat const CloseButtonHeight = 30;
         }
     }
 
-    UA_LDEBUG(@"Unable to find any available font families %@. Defaulting to system font.", fontFamilies);
-    return [UIFont systemFontOfSize:[UIFont systemFontSize]].familyName;
+    return nil;
 }
 
 + (void)runActionsForButton:(UAInAppMessageButton *)button {
@@ -379,13 +512,24 @@ static CGFloat const CloseButtonHeight = 30;
     }
 
     NSURL *cacheURL = [assets getCacheURL:mediaURL];
-    NSData *data =  [[NSFileManager defaultManager] contentsAtPath:[cacheURL path]];
-    if (data) {
-        UAInAppMessageMediaView *mediaView = [UAInAppMessageMediaView mediaViewWithMediaInfo:media imageData:data];
-        completionHandler(UAInAppMessagePrepareResultSuccess, mediaView);
-    } else {
-        completionHandler(UAInAppMessagePrepareResultInvalidate, nil);
-    }
+
+    // Media never displays larger than the screen, so decode at most at screen size
+    CGSize screenSize = [UIScreen mainScreen].bounds.size;
+    CGFloat maxPixelSize = MAX(screenSize.width, screenSize.height) * [UIScreen mainScreen].scale;
+
+    [[UADispatcher globalDispatcherForWorkType:UADispatcherWorkTypeDisplay] dispatchAsync:^{
+        NSData *data =  [[NSFileManager defaultManager] contentsAtPath:[cacheURL path]];
+        UIImage *image = data ? [UIImage fancyImageWithData:data maxPixelSize:maxPixelSize] : nil;
+
+        [[UADispatcher mainDispatcher] dispatchAsync:^{
+            if (data) {
+                UAInAppMessageMediaView *mediaView = [UAInAppMessageMediaView mediaViewWithMediaInfo:media image:image];
+                completionHandler(UAInAppMessagePrepareResultSuccess, mediaView);
+            } else {
+                completionHandler(UAInAppMessagePrepareResultInvalidate, nil);
+            }
+        }];
+    }];
 }
 
 + (BOOL)isReadyToDisplayWithMedia:(UAInAppMessageMediaInfo *)media {
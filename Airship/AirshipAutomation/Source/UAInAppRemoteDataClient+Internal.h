@@ -7,6 +7,8 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@class UAFrequencyConstraint;
+
 /**
  * Client delegate.
  */
@@ -21,25 +23,22 @@ NS_ASSUME_NONNULL_BEGIN
 
 
 /**
- * Schedules multiple in-app messages.
+ * Edits existing schedules and saves new schedules in a single transaction.
  *
- * @param schedules The schedule info for the messages.
- * @param completionHandler The completion handler to be called when scheduling completes.
+ * @param edits The edits to apply, keyed by schedule identifier.
+ * @param schedules The new schedules.
+ * @param completionHandler The completion handler with the result.
  */
-- (void)scheduleMultiple:(NSArray<UASchedule *> *)schedules completionHandler:(void (^)(BOOL))completionHandler;
-
+- (void)updateSchedulesWithEdits:(NSDictionary<NSString *, UAScheduleEdits *> *)edits
+                    newSchedules:(NSArray<UASchedule *> *)schedules
+               completionHandler:(void (^)(BOOL))completionHandler;
 
 /**
- * Edits a schedule.
+ * Replaces the frequency constraints. Called before the payload's schedules are updated.
  *
- * @param identifier A schedule identifier.
- * @param edits The edits to apply.
- * @param completionHandler The completion handler with the result.
+ * @param constraints The frequency constraints from the payload.
  */
-- (void)editScheduleWithID:(NSString *)identifier
-                     edits:(UAScheduleEdits *)edits
-         completionHandler:(nullable void (^)(BOOL))completionHandler;
-
+- (void)updateFrequencyConstraints:(NSArray<UAFrequencyConstraint *> *)constraints;
 
 @end
 
@@ -12,9 +12,11 @@
 #import "NSDictionary+UAAdditions.h"
 #import "UAActionSchedule.h"
 #import "UADeferredSchedule+Internal.h"
+#import "UAFrequencyConstraint+Internal.h"
 
 static NSString * const UAInAppMessagesLastPayloadTimeStampKey = @"UAInAppRemoteDataClient.LastPayloadTimeStamp";
 static NSString * const UAInAppMessagesLastPayloadMetadataKey = @"UAInAppRemoteDataClient.LastPayloadMetadata";
+static NSString * const UAInAppMessagesLastUpdatedByIDKey = @"UAInAppRemoteDataClient.LastUpdatedByID";
 
 static NSString * const UAInAppMessagesScheduledNewUserCutoffTimeKey = @"UAInAppRemoteDataClient.ScheduledNewUserCutoffTime";
 static NSString * const UAInAppRemoteDataClientMetadataKey = @"com.urbanairship.iaa.REMOTE_DATA_METADATA";
@@ -22,6 +24,7 @@ static NSString * const UAInAppRemoteDataClientMetadataKey = @"com.urbanairship.
 static NSString * const UAInAppMessages = @"in_app_messages";
 static NSString * const UAInAppMessagesCreatedJSONKey = @"created";
 static NSString * const UAInAppMessagesUpdatedJSONKey = @"last_updated";
+static NSString * const UAInAppMessagesFrequencyConstraintsKey = @"frequency_constraints";
 
 static NSString *const UAScheduleInfoPriorityKey = @"priority";
 static NSString *const UAScheduleInfoLimitKey = @"limit";
@@ -33,6 +36,7 @@ static NSString *const UAScheduleInfoDelayKey = @"delay";
 static NSString *const UAScheduleInfoIntervalKey = @"interval";
 static NSString *const UAScheduleInfoEditGracePeriodKey = @"edit_grace_period";
 static NSString *const UAScheduleInfoAudienceKey = @"audience";
+static NSString *const UAScheduleInfoFrequencyConstraintIDsKey = @"frequency_constraint_ids";
 static NSString *const UAScheduleInfoIDKey = @"id";
 static NSString *const UAScheduleInfoLegacyIDKey = @"message_id";
 static NSString *const UAScheduleInfoTypeKey = @"type";
@@ -83,6 +87,7 @@ static NSString *const UAScheduleInfoDeferredKey = @"deferred";
 
     NSOperationQueue *operationQueue = [[NSOperationQueue alloc] init];
     operationQueue.maxConcurrentOperationCount = 1;
+    operationQueue.qualityOfService = [UADispatcher qualityOfServiceForWorkType:UADispatcherWorkTypeProcessing];
 
     return [[UAInAppRemoteDataClient alloc] initWithRemoteDataProvider:remoteDataProvider
                                                              dataStore:dataStore
@@ -106,10 +111,19 @@ static NSString *const UAScheduleInfoDeferredKey = @"deferred";
     self.remoteDataSubscription = [self.remoteDataProvider subscribeWithTypes:@[UAInAppMessages]
                                                                    block:^(NSArray<UARemoteDataPayload *> * _Nonnull messagePayloads) {
         UA_STRONGIFY(self);
-        [self.operationQueue addOperationWithBlock:^{
+        UAAsyncOperation *operation = [UAAsyncOperation operationWithBlock:^(UAAsyncOperation *operation) {
             UA_STRONGIFY(self);
-            [self processInAppMessageData:[messagePayloads firstObject]];
+            if (!self) {
+                [operation finish];
+                return;
+            }
+
+            [self processInAppMessageData:[messagePayloads firstObject] completionHandler:^{
+                [operation finish];
+            }];
         }];
+
+        [self.operationQueue addOperation:operation];
     }];
 }
 
@@ -131,22 +145,54 @@ static NSString *const UAScheduleInfoDeferredKey = @"deferred";
     }];
 }
 
-- (void)processInAppMessageData:(UARemoteDataPayload *)messagePayload {
+- (void)processInAppMessageData:(UARemoteDataPayload *)messagePayload completionHandler:(void (^)(void))completionHandler {
     NSDate *payloadTimestamp = messagePayload.timestamp;
     NSDictionary *payloadMetadata = messagePayload.metadata ?: @{};
 
     NSDate *lastPayloadTimestamp = [self.dataStore objectForKey:UAInAppMessagesLastPayloadTimeStampKey] ?: [NSDate distantPast];
     NSDictionary *lastPayloadMetadata = self.lastPayloadMetadata;
 
-    NSDictionary *scheduleMetadata = @{ UAInAppRemoteDataClientMetadataKey: payloadMetadata };
-
     BOOL isMetadataCurrent = [lastPayloadMetadata isEqualToDictionary:payloadMetadata];
 
     // Skip if the payload timestamp is same as the last updated timestamp and metadata is current
     if ([payloadTimestamp isEqualToDate:lastPayloadTimestamp] && isMetadataCurrent) {
+        completionHandler();
+        return;
+    }
+
+    if (!self.delegate) {
+        completionHandler();
         return;
     }
 
+    UA_WEAKIFY(self)
+    [self getCurrentRemoteScheduleIDs:^(NSArray<NSString *> *currentScheduleIDs) {
+        // Schedules are delivered on the main queue, parse the messages off of it
+        [[UADispatcher globalDispatcherForWorkType:UADispatcherWorkTypeProcessing] dispatchAsync:^{
+            UA_STRONGIFY(self)
+            if (!self) {
+                completionHandler();
+                return;
+            }
+
+            [self processInAppMessageData:messagePayload
+                       currentScheduleIDs:currentScheduleIDs
+                     lastPayloadTimestamp:lastPayloadTimestamp
+                        isMetadataCurrent:isMetadataCurrent
+                        completionHandler:completionHandler];
+        }];
+    }];
+}
+
+- (void)processInAppMessageData:(UARemoteDataPayload *)messagePayload
+             currentScheduleIDs:(NSArray<NSString *> *)currentScheduleIDs
+           lastPayloadTimestamp:(NSDate *)lastPayloadTimestamp
+              isMetadataCurrent:(BOOL)isMetadataCurrent
+              completionHandler:(void (^)(void))completionHandler {
+    NSDate *payloadTimestamp = messagePayload.timestamp;
+    NSDictionary *payloadMetadata = messagePayload.metadata ?: @{};
+    NSDictionary *scheduleMetadata = @{ UAInAppRemoteDataClientMetadataKey: payloadMetadata };
+
     // Get the in-app message data, if it exists
     NSArray *messages;
     if (!messagePayload.data || !messagePayload.data[UAInAppMessages] || ![messagePayload.data[UAInAppMessages] isKindOfClass:[NSArray class]]) {
@@ -155,15 +201,30 @@ static NSString *const UAScheduleInfoDeferredKey = @"deferred";
         messages = messagePayload.data[UAInAppMessages];
     }
 
-    NSArray<NSString *> *currentScheduleIDs = [self getCurrentRemoteScheduleIDs];
+    // Constraints go first so the updated schedules are checked against them
+    [self.delegate updateFrequencyConstraints:[UAInAppRemoteDataClient parseFrequencyConstraints:messagePayload.data]];
+
     NSMutableArray<NSString *> *scheduleIDs = [NSMutableArray array];
     NSMutableArray<UASchedule *> *newSchedules = [NSMutableArray array];
+    NSMutableDictionary<NSString *, UAScheduleEdits *> *scheduleEdits = [NSMutableDictionary dictionary];
 
-    // Dispatch group
-    dispatch_group_t dispatchGroup = dispatch_group_create();
+    // The raw last updated value of each message in the previous listing, used to skip unchanged
+    // messages without parsing them
+    NSDictionary<NSString *, NSString *> *lastUpdatedByID = isMetadataCurrent ? [self.dataStore objectForKey:UAInAppMessagesLastUpdatedByIDKey] : nil;
+    NSMutableDictionary<NSString *, NSString *> *updatedByID = [NSMutableDictionary dictionaryWithCapacity:messages.count];
 
     // Validate messages and create new schedules
     for (NSDictionary *message in messages) {
+        if (lastUpdatedByID.count && [message isKindOfClass:[NSDictionary class]]) {
+            NSString *scheduleID = [UAInAppRemoteDataClient parseScheduleID:message];
+            id lastUpdated = message[UAInAppMessagesUpdatedJSONKey];
+            if (scheduleID.length && [lastUpdated isKindOfClass:[NSString class]] && [lastUpdatedByID[scheduleID] isEqualToString:lastUpdated]) {
+                [scheduleIDs addObject:scheduleID];
+                updatedByID[scheduleID] = lastUpdated;
+                continue;
+            }
+        }
+
         NSDate *createdTimeStamp = [UAUtils parseISO8601DateFromString:message[UAInAppMessagesCreatedJSONKey]];
         NSDate *lastUpdatedTimeStamp = [UAUtils parseISO8601DateFromString:message[UAInAppMessagesUpdatedJSONKey]];
 
@@ -179,13 +240,15 @@ static NSString *const UAScheduleInfoDeferredKey = @"deferred";
         }
 
         [scheduleIDs addObject:scheduleID];
+        updatedByID[scheduleID] = message[UAInAppMessagesUpdatedJSONKey];
 
         // Ignore any messages that have not updated since the last payload
         if (isMetadataCurrent && [lastPayloadTimestamp compare:lastUpdatedTimeStamp] != NSOrderedAscending) {
             continue;
         }
 
-        if ([createdTimeStamp compare:lastPayloadTimestamp] == NSOrderedDescending) {
+        // Schedules saved by an update that was not fully applied are edited when the payload is retried
+        if ([createdTimeStamp compare:lastPayloadTimestamp] == NSOrderedDescending && ![currentScheduleIDs containsObject:scheduleID]) {
             // New in-app message
             UASchedule *schedule = [UAInAppRemoteDataClient parseScheduleWithJSON:message
                                                                          metadata:scheduleMetadata];
@@ -207,15 +270,7 @@ static NSString *const UAScheduleInfoDeferredKey = @"deferred";
                 continue;
             }
 
-            dispatch_group_enter(dispatchGroup);
-            [self.delegate editScheduleWithID:scheduleID
-                                        edits:edits
-                                       completionHandler:^(BOOL result) {
-                dispatch_group_leave(dispatchGroup);
-                if (result) {
-                    UA_LTRACE("Updated in-app automation: %@", scheduleID);
-                }
-            }];
+            scheduleEdits[scheduleID] = edits;
         }
     }
 
@@ -233,32 +288,35 @@ static NSString *const UAScheduleInfoDeferredKey = @"deferred";
         }];
 
         for (NSString *scheduleID in deletedScheduleIDS) {
-            dispatch_group_enter(dispatchGroup);
-            [self.delegate editScheduleWithID:scheduleID
-                                        edits:edits
-                            completionHandler:^(BOOL result) {
-                dispatch_group_leave(dispatchGroup);
-                if (result) {
-                    UA_LTRACE("Ended in-app automation: %@", scheduleID);
-                }
-            }];
+            scheduleEdits[scheduleID] = edits;
         }
     }
 
-    // New messages
-    if (newSchedules.count) {
-        dispatch_group_enter(dispatchGroup);
-        [self.delegate scheduleMultiple:newSchedules completionHandler:^(BOOL result) {
-            dispatch_group_leave(dispatchGroup);
-        }];
-    }
+    void (^saveState)(void) = ^{
+        self.lastPayloadMetadata = payloadMetadata;
+        [self.dataStore setObject:payloadTimestamp forKey:UAInAppMessagesLastPayloadTimeStampKey];
+        [self.dataStore setObject:updatedByID forKey:UAInAppMessagesLastUpdatedByIDKey];
+        completionHandler();
+    };
 
-    // Wait for everything to finish
-    dispatch_group_wait(dispatchGroup,  DISPATCH_TIME_FOREVER);
+    if (!scheduleEdits.count && !newSchedules.count) {
+        saveState();
+        return;
+    }
 
-    // Save state
-    self.lastPayloadMetadata = payloadMetadata;
-    [self.dataStore setObject:payloadTimestamp forKey:UAInAppMessagesLastPayloadTimeStampKey];
+    // Apply the new schedules, edits, and end dates in a single update
+    [self.delegate updateSchedulesWithEdits:scheduleEdits
+                               newSchedules:newSchedules
+                          completionHandler:^(BOOL result) {
+        if (result) {
+            UA_LTRACE(@"Updated in-app automations. New: %lu, edited: %lu", (unsigned long)newSchedules.count, (unsigned long)scheduleEdits.count);
+            saveState();
+        } else {
+            // Leave the state as is so the payload is processed again
+            UA_LERR(@"Failed to update in-app automations");
+            completionHandler();
+        }
+    }];
 }
 
 - (NSDictionary *)lastPayloadMetadata {
@@ -285,27 +343,20 @@ static NSString *const UAScheduleInfoDeferredKey = @"deferred";
     [self.dataStore setObject:time forKey:UAInAppMessagesScheduledNewUserCutoffTimeKey];
 }
 
-- (NSArray<NSString *> *)getCurrentRemoteScheduleIDs {
-    NSMutableArray *currentScheduleIDs = [NSMutableArray array];
-
-    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+- (void)getCurrentRemoteScheduleIDs:(void (^)(NSArray<NSString *> *))completionHandler {
     UA_WEAKIFY(self)
     [self.delegate getSchedules:^(NSArray<UASchedule *> *schedules) {
         UA_STRONGIFY(self)
+        NSMutableArray *currentScheduleIDs = [NSMutableArray array];
         for (UASchedule *schedule in schedules) {
             if ([self isRemoteSchedule:schedule]) {
                 [currentScheduleIDs addObject:schedule.identifier];
             }
         }
-        dispatch_semaphore_signal(semaphore);
+        completionHandler(currentScheduleIDs);
     }];
-
-    dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
-
-    return currentScheduleIDs;
 }
 
-
 - (BOOL)isRemoteSchedule:(UASchedule *)schedule {
     if (schedule.metadata[UAInAppRemoteDataClientMetadataKey]) {
         return YES;
@@ -371,6 +422,7 @@ static NSString *const UAScheduleInfoDeferredKey = @"deferred";
         builder.editGracePeriod = [[JSON numberForKey:UAScheduleInfoEditGracePeriodKey defaultValue:nil] doubleValue];
         builder.interval = [[JSON numberForKey:UAScheduleInfoIntervalKey defaultValue:nil] doubleValue];
         builder.audience = audience;
+        builder.frequencyConstraintIDs = [UAInAppRemoteDataClient parseFrequencyConstraintIDs:JSON];
 
         if (JSON[UAScheduleInfoStartKey]) {
             builder.start = [UAUtils parseISO8601DateFromString:[JSON stringForKey:UAScheduleInfoStartKey defaultValue:@""]];
@@ -397,6 +449,7 @@ static NSString *const UAScheduleInfoDeferredKey = @"deferred";
         builder.editGracePeriod = [JSON numberForKey:UAScheduleInfoEditGracePeriodKey defaultValue:nil];
         builder.interval = [JSON numberForKey:UAScheduleInfoIntervalKey defaultValue:nil];
         builder.audience = audience;
+        builder.frequencyConstraintIDs = [UAInAppRemoteDataClient parseFrequencyConstraintIDs:JSON] ?: @[];
 
         /*
          * Since we cancel a schedule by setting the end time and start time to the payload's last modified timestamp,
@@ -427,6 +480,34 @@ static NSString *const UAScheduleInfoDeferredKey = @"deferred";
     return scheduleID;
 }
 
++ (NSArray<NSString *> *)parseFrequencyConstraintIDs:(id)JSON {
+    NSArray *constraintIDs = [JSON arrayForKey:UAScheduleInfoFrequencyConstraintIDsKey defaultValue:nil];
+    for (id constraintID in constraintIDs) {
+        if (![constraintID isKindOfClass:[NSString class]]) {
+            UA_LERR(@"Invalid frequency constraint IDs: %@", constraintIDs);
+            return nil;
+        }
+    }
+
+    return constraintIDs.count ? constraintIDs : nil;
+}
+
++ (NSArray<UAFrequencyConstraint *> *)parseFrequencyConstraints:(NSDictionary *)payloadData {
+    NSMutableArray<UAFrequencyConstraint *> *constraints = [NSMutableArray array];
+    for (id constraintJSON in [payloadData arrayForKey:UAInAppMessagesFrequencyConstraintsKey defaultValue:@[]]) {
+        NSError *error;
+        UAFrequencyConstraint *constraint = [UAFrequencyConstraint constraintWithJSON:constraintJSON error:&error];
+        if (!constraint) {
+            UA_LERR(@"Invalid frequency constraint: %@ - %@", constraintJSON, error);
+            continue;
+        }
+
+        [constraints addObject:constraint];
+    }
+
+    return constraints;
+}
+
 + (UAScheduleAudience *)parseAudience:(id)JSON error:(NSError **)error {
     id audienceDict = [JSON dictionaryForKey:UAScheduleInfoAudienceKey defaultValue:nil];
     if (!audienceDict) {
@@ -6,6 +6,11 @@
 
 @interface UALandingPageAction ()
 
+/**
+ * Utility method for parsing a landing page URL from an action value.
+ */
+- (nullable NSURL *)parseURLFromValue:(id)value;
+
 /**
  * Utility method for parsing a landing page URL from action arguments.
  */
@@ -0,0 +1,45 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+#import "UAAirshipAutomationCoreImport.h"
+#import "UAWebViewPool+Internal.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Maximum expected size of a landing page's main document that will be preloaded, in bytes.
+ */
+extern NSUInteger const UALandingPagePreloaderMaxContentLength;
+
+/**
+ * Preloads landing pages from incoming pushes so the page is cached by the time the
+ * notification is opened. Pages are only preloaded on Wi-Fi outside of Low Data Mode.
+ */
+@interface UALandingPagePreloader : NSObject
+
+/**
+ * Factory method.
+ * @return A landing page preloader.
+ */
++ (instancetype)preloader;
+
+/**
+ * Factory method. Used for testing.
+ * @param webViewPool The web view pool.
+ * @param networkMonitor The network monitor.
+ * @return A landing page preloader.
+ */
++ (instancetype)preloaderWithWebViewPool:(UAWebViewPool *)webViewPool
+                          networkMonitor:(UANetworkMonitor *)networkMonitor;
+
+/**
+ * Preloads the landing page of a notification, if it has one.
+ * @param notification The notification.
+ * @param completionHandler The completion handler. Called with `UIBackgroundFetchResultNewData` if a page was loaded.
+ */
+- (void)preloadLandingPageForNotification:(UANotificationContent *)notification
+                        completionHandler:(void (^)(UIBackgroundFetchResult))completionHandler;
+
+@end
+
+NS_ASSUME_NONNULL_END
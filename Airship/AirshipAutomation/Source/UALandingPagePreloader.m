@@ -0,0 +1,74 @@
+/* Copyright Airship and Contributors */
+
+#import "UALandingPagePreloader+Internal.h"
+#import "UALandingPageAction+Internal.h"
+
+NSUInteger const UALandingPagePreloaderMaxContentLength = 2 * 1024 * 1024;
+
+@interface UALandingPagePreloader ()
+@property (nonatomic, strong) UAWebViewPool *webViewPool;
+@property (nonatomic, strong) UANetworkMonitor *networkMonitor;
+@end
+
+@implementation UALandingPagePreloader
+
+- (instancetype)initWithWebViewPool:(UAWebViewPool *)webViewPool
+                     networkMonitor:(UANetworkMonitor *)networkMonitor {
+    self = [super init];
+    if (self) {
+        self.webViewPool = webViewPool;
+        self.networkMonitor = networkMonitor;
+    }
+    return self;
+}
+
++ (instancetype)preloader {
+    return [[self alloc] initWithWebViewPool:[UAWebViewPool shared]
+                              networkMonitor:[UANetworkMonitor shared]];
+}
+
++ (instancetype)preloaderWithWebViewPool:(UAWebViewPool *)webViewPool
+                          networkMonitor:(UANetworkMonitor *)networkMonitor {
+    return [[self alloc] initWithWebViewPool:webViewPool networkMonitor:networkMonitor];
+}
+
+- (nullable NSURL *)landingPageURLForNotification:(UANotificationContent *)notification {
+    NSDictionary *payload = notification.notificationInfo;
+    id value = payload[UALandingPageActionDefaultRegistryName] ?: payload[UALandingPageActionDefaultRegistryAlias];
+    if (!value) {
+        return nil;
+    }
+
+    NSURL *url = [[[UALandingPageAction alloc] init] parseURLFromValue:value];
+    if (!url || ![[UAirship shared].URLAllowList isAllowed:url scope:UAURLAllowListScopeOpenURL]) {
+        return nil;
+    }
+
+    return url;
+}
+
+- (BOOL)isPreloadAllowed {
+    return [self.networkMonitor.connectionType isEqualToString:UAConnectionTypeWifi] && !self.networkMonitor.isConstrained;
+}
+
+- (void)preloadLandingPageForNotification:(UANotificationContent *)notification
+                        completionHandler:(void (^)(UIBackgroundFetchResult))completionHandler {
+    NSURL *url = [self landingPageURLForNotification:notification];
+    if (!url || ![self isPreloadAllowed]) {
+        completionHandler(UIBackgroundFetchResultNoData);
+        return;
+    }
+
+    UA_LDEBUG(@"Preloading landing page %@", url);
+    UA_WEAKIFY(self)
+    [[UADispatcher mainDispatcher] dispatchAsyncIfNecessary:^{
+        UA_STRONGIFY(self)
+        [self.webViewPool preloadURL:url
+                    maxContentLength:UALandingPagePreloaderMaxContentLength
+                   completionHandler:^(BOOL loaded) {
+            completionHandler(loaded ? UIBackgroundFetchResultNewData : UIBackgroundFetchResultNoData);
+        }];
+    }];
+}
+
+@end
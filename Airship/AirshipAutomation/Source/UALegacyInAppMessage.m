@@ -93,8 +93,7 @@
 
 - (NSDictionary *)payload {
 
-    NSDateFormatter *formatter = [UAUtils ISODateFormatterUTCWithDelimiter];
-    NSString *expiry = [formatter stringFromDate:self.expiry];
+    NSString *expiry = self.expiry ? [UAUtils ISODateStringFromDate:self.expiry delimiter:YES] : nil;
 
     NSDictionary *extra = self.extra;
 
@@ -23,7 +23,12 @@ typedef NS_ENUM(NSUInteger, UARetriableResult) {
     /**
      * Represents an invalidation of the retriable chain.
      */
-    UARetriableResultInvalidate = 3
+    UARetriableResultInvalidate = 3,
+    /**
+     * Represents a retry condition caused by a server error. The retriable is retried
+     * with backoff, and the pipeline holds back its other chains until the retry runs.
+     */
+    UARetriableResultServerError = 4
 };
 
 /**
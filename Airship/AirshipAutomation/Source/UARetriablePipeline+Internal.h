@@ -4,11 +4,13 @@
 #import "UARetriable+Internal.h"
 #import "UADispatcher.h"
 #import "UAAsyncOperation.h"
+#import "UADate.h"
 
 /**
  * An interface for running retriables with optional operation dependency semantics,
- * and automatic exponential backoff. Retries will be scheduled using the dispatcher
- * to avoid blocking other operations from executing.
+ * and automatic exponential backoff with full jitter. Retries share a single timer
+ * on the dispatcher to avoid blocking other operations from executing. A server error
+ * holds back every chain in the pipeline until one of them succeeds on retry.
  */
 @interface UARetriablePipeline : NSObject
 
@@ -17,6 +19,17 @@
  */
 + (instancetype)pipeline;
 
+/**
+ * UARetriablePipeline class factory.
+ *
+ * Chains added to the pipeline run concurrently up to the max count, while
+ * the retriables within a single chain always run in order. A retriable gives up
+ * its slot while it backs off, or once it has been running for too long.
+ *
+ * @param maxConcurrentOperationCount The max number of retriables that can run at once.
+ */
++ (instancetype)pipelineWithMaxConcurrentOperationCount:(NSInteger)maxConcurrentOperationCount;
+
 /**
  * UARetriablePipeline class factory. For testing purposes.
  *
@@ -25,6 +38,15 @@
  */
 + (instancetype)pipelineWithQueue:(NSOperationQueue *)queue dispatcher:(UADispatcher *)dispatcher;
 
+/**
+ * UARetriablePipeline class factory. For testing purposes.
+ *
+ * @param queue The NSOperation queue to use.
+ * @param dispatcher The dispatcher used for rescheduling retriables.
+ * @param date The date used for tracking retry dates.
+ */
++ (instancetype)pipelineWithQueue:(NSOperationQueue *)queue dispatcher:(UADispatcher *)dispatcher date:(UADate *)date;
+
 /**
  * Adds a retriable to the queue.
  *
@@ -3,9 +3,24 @@
 #import "UARetriablePipeline+Internal.h"
 #import "UAGlobal.h"
 #import "UAAsyncOperation.h"
+#import "UADate.h"
+
+/**
+ * The shortest delay used for a jittered retry.
+ */
+static const NSTimeInterval UARetriablePipelineMinRetryDelay = 1;
+
+/**
+ * How long a retriable that is still running holds its queue slot. Retriables that back off
+ * release their slot right away, this covers run blocks that wait on their own, such as a
+ * download stuck behind a flaky connection.
+ */
+static const NSTimeInterval UARetriablePipelineSlotTimeout = 30;
 
 @interface UARetriableChain : NSObject
 @property (nonatomic, strong) NSMutableArray *retriables;
+@property (nonatomic, assign) NSTimeInterval backoff;
+@property (nonatomic, strong) NSDate *retryDate;
 @end
 
 @implementation UARetriableChain
@@ -14,29 +29,55 @@
 @interface UARetriablePipeline ()
 @property (nonatomic, strong) NSOperationQueue *queue;
 @property (nonatomic, strong) UADispatcher *dispatcher;
+@property (nonatomic, strong) UADate *date;
+
+// Chains waiting to be retried, sorted by retry date
+@property (nonatomic, strong) NSMutableArray<UARetriableChain *> *pendingChains;
+@property (nonatomic, strong) UADisposable *retryTimer;
+@property (nonatomic, strong) NSDate *retryTimerDate;
+@property (nonatomic, strong) NSDate *lastRetryTimerDate;
+
+// Set while a server error holds back the pipeline
+@property (nonatomic, strong) NSDate *circuitOpenDate;
+@property (nonatomic, strong) UARetriableChain *probeChain;
 @end
 
 @implementation UARetriablePipeline
 
-- (instancetype)initWithQueue:(NSOperationQueue *)queue dispatcher:(UADispatcher *)dispatcher {
+- (instancetype)initWithQueue:(NSOperationQueue *)queue dispatcher:(UADispatcher *)dispatcher date:(UADate *)date {
     self = [super init];
 
     if (self) {
         self.queue = queue;
         self.dispatcher = dispatcher;
+        self.date = date;
+        self.pendingChains = [NSMutableArray array];
     }
 
     return self;
 }
 
+- (void)dealloc {
+    [self.retryTimer dispose];
+}
+
++ (instancetype)pipelineWithQueue:(NSOperationQueue *)queue dispatcher:(UADispatcher *)dispatcher date:(UADate *)date {
+    return [[self alloc] initWithQueue:queue dispatcher:dispatcher date:date];
+}
+
 + (instancetype)pipelineWithQueue:(NSOperationQueue *)queue dispatcher:(UADispatcher *)dispatcher {
-    return [[self alloc] initWithQueue:queue dispatcher:dispatcher];
+    return [self pipelineWithQueue:queue dispatcher:dispatcher date:[[UADate alloc] init]];
 }
 
 + (instancetype)pipeline {
+    return [self pipelineWithMaxConcurrentOperationCount:1];
+}
+
++ (instancetype)pipelineWithMaxConcurrentOperationCount:(NSInteger)maxConcurrentOperationCount {
     NSOperationQueue *queue = [[NSOperationQueue alloc] init];
-    queue.maxConcurrentOperationCount = 1;
-    return [self pipelineWithQueue:queue dispatcher:[UADispatcher globalDispatcher]];
+    queue.maxConcurrentOperationCount = maxConcurrentOperationCount;
+    queue.qualityOfService = [UADispatcher qualityOfServiceForWorkType:UADispatcherWorkTypeProcessing];
+    return [self pipelineWithQueue:queue dispatcher:[UADispatcher globalDispatcherForWorkType:UADispatcherWorkTypeProcessing]];
 }
 
 - (void)addRetriable:(UARetriable *)retriable {
@@ -46,32 +87,55 @@
 - (void)addChainedRetriables:(NSArray<UARetriable *> *)retriables {
     UARetriableChain *chain = [[UARetriableChain alloc] init];
     chain.retriables = [retriables mutableCopy];
-    [self executeChain:chain backoff:0];
+    [self executeChain:chain];
 }
 
-- (void)executeChain:(UARetriableChain *)chain backoff:(NSTimeInterval)backoff {
+- (void)executeChain:(UARetriableChain *)chain {
     if (!chain.retriables.count) {
         return;
     }
 
+    @synchronized (self) {
+        // Hold the chain back until the probe finds out if the server has recovered
+        if (self.circuitOpenDate && chain != self.probeChain) {
+            chain.retryDate = self.circuitOpenDate;
+            [self addPendingChain:chain];
+            [self updateRetryTimer];
+            return;
+        }
+    }
+
     UA_WEAKIFY(self)
     UARetriable *next = [chain.retriables firstObject];
-    NSTimeInterval nextBackoff = backoff == 0 ? next.minBackoffInterval : MIN(backoff * 2, next.maxBackoffInterval);
+    UADispatcher *dispatcher = self.dispatcher;
 
     UAAsyncOperation *operation = [UAAsyncOperation operationWithBlock:^(UAAsyncOperation *operation) {
+        UADisposable *slotTimeout = [dispatcher dispatchAfter:UARetriablePipelineSlotTimeout block:^{
+            [operation finish];
+        }];
+
         UARetriableCompletionHandler handler = ^(UARetriableResult result) {
             UA_STRONGIFY(self)
+            [slotTimeout dispose];
+
             switch(result) {
                 case UARetriableResultRetry:
-                    [self scheduleRetryWithBackoff:nextBackoff chain:chain];
+                    [self scheduleRetryForChain:chain retriable:next openCircuit:NO];
+                    break;
+                case UARetriableResultServerError:
+                    [self scheduleRetryForChain:chain retriable:next openCircuit:YES];
                     break;
                 case UARetriableResultSuccess:
+                    [self closeCircuitForChain:chain];
                     [chain.retriables removeObjectAtIndex:0];
-                    [self executeChain:chain backoff:0];
+                    chain.backoff = 0;
+                    [self executeChain:chain];
                     break;
                 case UARetriableResultCancel:
+                    [self closeCircuitForChain:chain];
                     break;
                 case UARetriableResultInvalidate:
+                    [self closeCircuitForChain:chain];
                     break;
             }
 
@@ -88,12 +152,165 @@
     [self.queue addOperation:operation];
 }
 
-- (void)scheduleRetryWithBackoff:(NSTimeInterval)backoff chain:(UARetriableChain *)chain {
+- (void)scheduleRetryForChain:(UARetriableChain *)chain retriable:(UARetriable *)retriable openCircuit:(BOOL)openCircuit {
+    chain.backoff = chain.backoff == 0 ? retriable.minBackoffInterval : MIN(chain.backoff * 2, retriable.maxBackoffInterval);
+
+    @synchronized (self) {
+        chain.retryDate = [[self now] dateByAddingTimeInterval:[self jitteredDelayForBackoff:chain.backoff]];
+
+        if (chain == self.probeChain) {
+            self.probeChain = nil;
+        }
+
+        if (openCircuit && (!self.circuitOpenDate || [self.circuitOpenDate compare:chain.retryDate] == NSOrderedAscending)) {
+            UA_LDEBUG(@"Server error, holding back retriables until %@", chain.retryDate);
+            self.circuitOpenDate = chain.retryDate;
+        }
+
+        [self addPendingChain:chain];
+        [self updateRetryTimer];
+    }
+}
+
+- (void)closeCircuitForChain:(UARetriableChain *)chain {
+    NSArray<UARetriableChain *> *readyChains;
+
+    @synchronized (self) {
+        if (chain != self.probeChain) {
+            return;
+        }
+
+        UA_LDEBUG(@"Server recovered, resuming retriables");
+        self.probeChain = nil;
+        self.circuitOpenDate = nil;
+        readyChains = [self dequeueReadyChains];
+        [self updateRetryTimer];
+    }
+
+    for (UARetriableChain *readyChain in readyChains) {
+        [self executeChain:readyChain];
+    }
+}
+
+- (void)retryTimerFired:(NSDate *)timerDate {
+    NSArray<UARetriableChain *> *readyChains;
+
+    @synchronized (self) {
+        if ([timerDate isEqualToDate:self.retryTimerDate]) {
+            self.retryTimer = nil;
+            self.retryTimerDate = nil;
+        }
+
+        if (!self.lastRetryTimerDate || [self.lastRetryTimerDate compare:timerDate] == NSOrderedAscending) {
+            self.lastRetryTimerDate = timerDate;
+        }
+
+        readyChains = [self dequeueReadyChains];
+        [self updateRetryTimer];
+    }
+
+    for (UARetriableChain *chain in readyChains) {
+        [self executeChain:chain];
+    }
+}
+
+/**
+ * Removes and returns the chains that are due. While the circuit is open only the
+ * earliest chain is returned, as a probe. Must be called while synchronized.
+ */
+- (NSArray<UARetriableChain *> *)dequeueReadyChains {
+    NSDate *now = [self now];
+    NSMutableArray<UARetriableChain *> *readyChains = [NSMutableArray array];
+
+    if (self.circuitOpenDate) {
+        UARetriableChain *chain = self.pendingChains.firstObject;
+        if (!self.probeChain && chain && [[self circuitRetryDate] compare:now] != NSOrderedDescending) {
+            [self.pendingChains removeObjectAtIndex:0];
+            self.probeChain = chain;
+            [readyChains addObject:chain];
+        }
+        return readyChains;
+    }
+
+    while (self.pendingChains.count && [self.pendingChains.firstObject.retryDate compare:now] != NSOrderedDescending) {
+        [readyChains addObject:self.pendingChains.firstObject];
+        [self.pendingChains removeObjectAtIndex:0];
+    }
+
+    return readyChains;
+}
+
+/**
+ * The date the next probe can run while the circuit is open. Must be called while synchronized.
+ */
+- (NSDate *)circuitRetryDate {
+    return [self.circuitOpenDate laterDate:self.pendingChains.firstObject.retryDate];
+}
+
+/**
+ * Points the single retry timer at the next date a chain can run. Must be called while synchronized.
+ */
+- (void)updateRetryTimer {
+    NSDate *fireDate;
+    if (self.probeChain || !self.pendingChains.count) {
+        fireDate = nil;
+    } else if (self.circuitOpenDate) {
+        fireDate = [self circuitRetryDate];
+    } else {
+        fireDate = self.pendingChains.firstObject.retryDate;
+    }
+
+    if (self.retryTimer && [fireDate isEqualToDate:self.retryTimerDate]) {
+        return;
+    }
+
+    [self.retryTimer dispose];
+    self.retryTimer = nil;
+    self.retryTimerDate = fireDate;
+
+    if (!fireDate) {
+        return;
+    }
+
     UA_WEAKIFY(self)
-    [self.dispatcher dispatchAfter:backoff block:^{
+    self.retryTimer = [self.dispatcher dispatchAfter:MAX(0, [fireDate timeIntervalSinceDate:[self now]]) block:^{
         UA_STRONGIFY(self)
-        [self executeChain:chain backoff:backoff];
+        [self retryTimerFired:fireDate];
+    }];
+}
+
+/**
+ * Inserts a chain into the pending chains, keeping them sorted by retry date. Must be called while synchronized.
+ */
+- (void)addPendingChain:(UARetriableChain *)chain {
+    NSUInteger index = [self.pendingChains indexOfObject:chain
+                                           inSortedRange:NSMakeRange(0, self.pendingChains.count)
+                                                 options:NSBinarySearchingInsertionIndex | NSBinarySearchingLastEqual
+                                         usingComparator:^NSComparisonResult(UARetriableChain *first, UARetriableChain *second) {
+        return [first.retryDate compare:second.retryDate];
     }];
+
+    [self.pendingChains insertObject:chain atIndex:index];
+}
+
+/**
+ * Full jitter: a random delay up to the backoff, so chains that failed together
+ * don't all retry at the same moment.
+ */
+- (NSTimeInterval)jitteredDelayForBackoff:(NSTimeInterval)backoff {
+    NSTimeInterval minDelay = MIN(UARetriablePipelineMinRetryDelay, backoff);
+    return minDelay + (backoff - minDelay) * ((double)arc4random() / UINT32_MAX);
+}
+
+/**
+ * The current date, never earlier than the last retry timer that fired.
+ */
+- (NSDate *)now {
+    NSDate *now = self.date.now;
+    if (self.lastRetryTimerDate && [now compare:self.lastRetryTimerDate] == NSOrderedAscending) {
+        return self.lastRetryTimerDate;
+    }
+    return now;
 }
 
 @end
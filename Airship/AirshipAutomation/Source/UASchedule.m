@@ -31,6 +31,7 @@ NSUInteger const UAScheduleMaxTriggers = 10;
 @property(nonatomic, assign) NSTimeInterval editGracePeriod;
 @property(nonatomic, copy) NSDictionary *metadata;
 @property(nonatomic, strong) UAScheduleAudience *audience;
+@property(nonatomic, copy) NSArray<NSString *> *frequencyConstraintIDs;
 @end
 
 @implementation UASchedule
@@ -76,6 +77,7 @@ NSUInteger const UAScheduleMaxTriggers = 10;
         self.interval = builder.interval;
         self.metadata = builder.metadata ?: @{};
         self.audience = builder.audience;
+        self.frequencyConstraintIDs = builder.frequencyConstraintIDs;
     }
 
     return self;
@@ -142,6 +144,10 @@ NSUInteger const UAScheduleMaxTriggers = 10;
         return NO;
     }
 
+    if (self.frequencyConstraintIDs != schedule.frequencyConstraintIDs && ![self.frequencyConstraintIDs isEqualToArray:schedule.frequencyConstraintIDs]) {
+        return NO;
+    }
+
     return YES;
 }
 
@@ -171,6 +177,7 @@ NSUInteger const UAScheduleMaxTriggers = 10;
     result = 31 * result + [self.data hash];
     result = 31 * result + [self.delay hash];
     result = 31 * result + [self.audience hash];
+    result = 31 * result + [self.frequencyConstraintIDs hash];
     result = 31 * result + self.editGracePeriod;
     result = 31 * result + self.interval;
     result = 31 * result + self.type;
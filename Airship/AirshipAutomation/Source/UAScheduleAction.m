@@ -39,6 +39,10 @@ static NSString * const UAScheduleActionErrorDomain = @"com.urbanairship.schedul
     }
 }
 
+- (UAActionThreadAffinity)threadAffinity {
+    return UAActionThreadAffinityBackground;
+}
+
 - (void)performWithArguments:(UAActionArguments *)arguments
            completionHandler:(UAActionCompletionHandler)completionHandler {
 
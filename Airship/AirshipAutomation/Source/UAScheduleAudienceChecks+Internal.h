@@ -35,4 +35,13 @@
  */
 + (BOOL)checkDisplayAudienceConditions:(UAScheduleAudience *)audience tagGroups:(UATagGroups *)tagGroups;
 
+/**
+ * The current device state version. The version increases whenever any device state that display
+ * audience conditions depend on changes, such as tags, locale, permissions or the app version.
+ * Display audience results are cached against this version.
+ *
+ * @return The device state version.
+ */
++ (NSUInteger)deviceStateVersion;
+
 @end
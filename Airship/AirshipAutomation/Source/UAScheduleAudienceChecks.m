@@ -7,6 +7,11 @@
 #import "UATagSelector+Internal.h"
 #import "UAAirshipAutomationCoreImport.h"
 
+// Cached display audience results, keyed by audience instance, each an array of [device state version, result]
+static NSMapTable<UAScheduleAudience *, NSArray<NSNumber *> *> *audienceResults;
+static NSArray *deviceState;
+static NSUInteger deviceStateVersion;
+
 @implementation UAScheduleAudienceChecks
 
 + (BOOL)checkScheduleAudienceConditions:(UAScheduleAudience *)audience isNewUser:(BOOL)isNewUser {
@@ -43,6 +48,56 @@
         return YES;
     }
 
+    // Tag group results depend on the tag groups passed in, so those audiences are not cached
+    if (audience.tagSelector.containsTagGroups) {
+        return [self evaluateDisplayAudienceConditions:audience tagGroups:tagGroups];
+    }
+
+    NSUInteger version = [self deviceStateVersion];
+
+    @synchronized (self) {
+        NSArray<NSNumber *> *cached = [audienceResults objectForKey:audience];
+        if (cached && [cached[0] unsignedIntegerValue] == version) {
+            return [cached[1] boolValue];
+        }
+    }
+
+    BOOL result = [self evaluateDisplayAudienceConditions:audience tagGroups:tagGroups];
+
+    @synchronized (self) {
+        if (!audienceResults) {
+            // Keyed by identity, schedules hold on to the same audience between checks
+            audienceResults = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality
+                                                    valueOptions:NSPointerFunctionsStrongMemory];
+        }
+        [audienceResults setObject:@[@(version), @(result)] forKey:audience];
+    }
+
+    return result;
+}
+
++ (NSUInteger)deviceStateVersion {
+    // Cheap reads of everything the display conditions depend on. The channel hands back the
+    // same tag set until the tags change, so comparing it is usually a pointer check.
+    NSArray *currentState = @[@([UAirship shared].isDataCollectionEnabled),
+                              @([UAirship shared].locationProvider.isLocationOptedIn),
+                              @([self isNotificationsOptedIn]),
+                              [UAirship channel].tagSet ?: [NSNull null],
+                              [NSLocale currentLocale].localeIdentifier ?: [NSNull null],
+                              [UAirship shared].applicationMetrics.currentAppVersion ?: [NSNull null]];
+
+    @synchronized (self) {
+        if (![currentState isEqualToArray:deviceState]) {
+            deviceState = currentState;
+            deviceStateVersion++;
+        }
+
+        return deviceStateVersion;
+    }
+}
+
++ (BOOL)evaluateDisplayAudienceConditions:(UAScheduleAudience *)audience tagGroups:(UATagGroups *)tagGroups {
+
     // Data collection enabled
     BOOL isDataCollectionEnabled = [UAirship shared].isDataCollectionEnabled;
     
@@ -74,7 +129,7 @@
             return NO;
         }
 
-        if (![audience.tagSelector apply:[UAirship channel].tags tagGroups:tagGroups]) {
+        if (![audience.tagSelector applyToTagSet:[UAirship channel].tagSet tagGroups:tagGroups]) {
             return NO;
         }
     }
@@ -140,6 +140,12 @@ extern NSUInteger const UAScheduleDataVersion;
  */
 @property (nullable, nonatomic, retain, readonly) NSDate *executionStateChangeDate;
 
+/**
+ * The date after which the finished schedule can be deleted. Kept up to date as the execution
+ * state, end date and edit grace period change. Nil unless the schedule is finished.
+ */
+@property (nullable, nonatomic, retain, readonly) NSDate *purgeAfter;
+
 /**
  * The delayed execution date. This delay date takes precedent over the delay in seconds.
  */
@@ -170,6 +176,43 @@ extern NSUInteger const UAScheduleDataVersion;
  */
 @property (nullable, nonatomic, retain) NSString *audience;
 
+/**
+ * The JSON encoded frequency constraint IDs.
+ */
+@property (nullable, nonatomic, retain) NSString *frequencyConstraintIDs;
+
+/**
+ * The schedule's data as a binary property list. Only set when the store uses binary
+ * encoding, in which case `data` is nil.
+ */
+@property (nullable, nonatomic, retain) NSData *binaryData;
+
+/**
+ * The decoded schedule data JSON, read from `binaryData` if set, otherwise from `data`.
+ */
+@property (nullable, nonatomic, readonly) id dataJSON;
+
+/**
+ * Encodes a JSON object as a binary property list.
+ *
+ * @param JSON The JSON object.
+ * @return The binary property list, or nil if the JSON can't be represented as one (e.g. it contains nulls).
+ */
++ (nullable NSData *)binaryDataWithJSON:(id)JSON;
+
+/**
+ * Decodes stored JSON data that is either a binary property list or serialized JSON.
+ *
+ * @param data The stored data.
+ * @return The JSON object, or nil if the data is invalid.
+ */
++ (nullable id)JSONWithStoredData:(NSData *)data;
+
+/**
+ * Recomputes the purge date from the execution state, end date and edit grace period.
+ */
+- (void)updatePurgeAfter;
+
 /**
  * Whether the schedule has exceeded its limit.
  */
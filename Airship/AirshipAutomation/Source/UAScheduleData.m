@@ -1,14 +1,19 @@
 /* Copyright Airship and Contributors */
 
 #import "UAScheduleData+Internal.h"
+#import "UAAirshipAutomationCoreImport.h"
 #import "UAJSONSerialization.h"
 #import "UAScheduleTriggerData+Internal.h"
 
 // Data version - for migration
 NSUInteger const UAScheduleDataVersion = 3;
 
+// Header of a binary property list
+static char const UAScheduleDataBinaryPlistHeader[] = "bplist";
+
 @interface UAScheduleData()
 @property (nullable, nonatomic, retain) NSDate *executionStateChangeDate;
+@property (nullable, nonatomic, retain) NSDate *purgeAfter;
 @end
 
 @implementation UAScheduleData
@@ -32,12 +37,80 @@ NSUInteger const UAScheduleDataVersion = 3;
 @dynamic editGracePeriod;
 @dynamic triggerContext;
 @dynamic audience;
+@dynamic frequencyConstraintIDs;
+@dynamic binaryData;
+@dynamic purgeAfter;
 
 -(void)setExecutionState:(NSNumber *)executionState {
     [self willChangeValueForKey:@"executionState"];
     [self setPrimitiveValue:executionState forKey:@"executionState"];
     [self didChangeValueForKey:@"executionState"];
     [self setExecutionStateChangeDate:[NSDate date]];
+    [self updatePurgeAfter];
+}
+
+- (void)setEnd:(NSDate *)end {
+    [self willChangeValueForKey:@"end"];
+    [self setPrimitiveValue:end forKey:@"end"];
+    [self didChangeValueForKey:@"end"];
+    [self updatePurgeAfter];
+}
+
+- (void)setEditGracePeriod:(NSNumber *)editGracePeriod {
+    [self willChangeValueForKey:@"editGracePeriod"];
+    [self setPrimitiveValue:editGracePeriod forKey:@"editGracePeriod"];
+    [self didChangeValueForKey:@"editGracePeriod"];
+    [self updatePurgeAfter];
+}
+
+- (void)updatePurgeAfter {
+    NSDate *purgeAfter;
+
+    if ([self.executionState intValue] == UAScheduleStateFinished) {
+        if (self.editGracePeriod == nil) {
+            // If grace period is unset - use the executionStateChangeDate to avoid unnecessarily keeping schedules around until distant future.
+            purgeAfter = self.executionStateChangeDate;
+        } else {
+            // If the grace period is set - follow the end date behavior outlined in the specification.
+            purgeAfter = [self.end dateByAddingTimeInterval:[self.editGracePeriod doubleValue]];
+        }
+    }
+
+    if (purgeAfter != self.purgeAfter && ![purgeAfter isEqualToDate:self.purgeAfter]) {
+        self.purgeAfter = purgeAfter;
+    }
+}
+
++ (NSData *)binaryDataWithJSON:(id)JSON {
+    if (!JSON || ![NSPropertyListSerialization propertyList:JSON isValidForFormat:NSPropertyListBinaryFormat_v1_0]) {
+        return nil;
+    }
+
+    return [NSPropertyListSerialization dataWithPropertyList:JSON
+                                                      format:NSPropertyListBinaryFormat_v1_0
+                                                     options:0
+                                                       error:nil];
+}
+
++ (id)JSONWithStoredData:(NSData *)data {
+    NSUInteger headerLength = sizeof(UAScheduleDataBinaryPlistHeader) - 1;
+    if (data.length >= headerLength && memcmp(data.bytes, UAScheduleDataBinaryPlistHeader, headerLength) == 0) {
+        return [NSPropertyListSerialization propertyListWithData:data
+                                                         options:NSPropertyListMutableContainers
+                                                          format:nil
+                                                           error:nil];
+    }
+
+    return [NSJSONSerialization JSONObjectWithData:data options:NSJSONReadingMutableContainers error:nil];
+}
+
+- (id)dataJSON {
+    NSData *binaryData = self.binaryData;
+    if (binaryData) {
+        return [UAScheduleData JSONWithStoredData:binaryData];
+    }
+
+    return [NSJSONSerialization objectWithString:self.data];
 }
 
 - (BOOL)isOverLimit {
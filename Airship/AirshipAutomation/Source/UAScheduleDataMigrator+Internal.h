@@ -16,6 +16,21 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (void)migrateSchedules:(NSArray<UAScheduleData *> *)schedules;
 
+/**
+ * Migrates a batch of schedule datas.
+ * @param schedules The array of schedule data to migrate.
+ * @param migratedScheduleIDs The IDs of the schedules migrated so far. Updated with the IDs of the
+ * migrated schedules, and used to keep migrated IDs unique across batches.
+ */
++ (void)migrateSchedules:(NSArray<UAScheduleData *> *)schedules migratedScheduleIDs:(NSMutableArray<NSString *> *)migratedScheduleIDs;
+
+/**
+ * Converts the JSON schedule data and trigger predicates to binary property lists. Data that
+ * can't be represented as a property list is left as JSON.
+ * @param schedules The array of schedule data to convert.
+ */
++ (void)migrateSchedulesToBinaryEncoding:(NSArray<UAScheduleData *> *)schedules;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -3,6 +3,8 @@
 #import "UAScheduleDataMigrator+Internal.h"
 #import "UAAirshipAutomationCoreImport.h"
 #import "UASchedule+Internal.h"
+#import "UAScheduleTriggerData+Internal.h"
+#import "UAScheduleDelayData+Internal.h"
 
 // These constants are re-defined here to keep them isolated from
 // any changes in the IAM payload definitions.
@@ -21,9 +23,10 @@ NSString *const UAScheduleMetadataOriginalMessageIDKey = @"com.urbanairship.orig
 @implementation UAScheduleDataMigrator
 
 + (void)migrateSchedules:(NSArray<UAScheduleData *> *)schedules {
+    [self migrateSchedules:schedules migratedScheduleIDs:[NSMutableArray array]];
+}
 
-    NSMutableArray *migratedScheduleIDs = [NSMutableArray array];
-
++ (void)migrateSchedules:(NSArray<UAScheduleData *> *)schedules migratedScheduleIDs:(NSMutableArray<NSString *> *)migratedScheduleIDs {
     for (UAScheduleData *scheduleData in schedules) {
         int oldVersion = [scheduleData.dataVersion intValue];
 
@@ -135,6 +138,34 @@ NSString *const UAScheduleMetadataOriginalMessageIDKey = @"com.urbanairship.orig
     }
 }
 
++ (void)migrateSchedulesToBinaryEncoding:(NSArray<UAScheduleData *> *)schedules {
+    for (UAScheduleData *scheduleData in schedules) {
+        NSData *binaryData = [UAScheduleData binaryDataWithJSON:[NSJSONSerialization objectWithString:scheduleData.data]];
+        if (binaryData) {
+            scheduleData.binaryData = binaryData;
+            scheduleData.data = nil;
+        }
+
+        NSMutableSet<UAScheduleTriggerData *> *triggers = [NSMutableSet setWithSet:scheduleData.triggers];
+        if (scheduleData.delay.cancellationTriggers) {
+            [triggers unionSet:scheduleData.delay.cancellationTriggers];
+        }
+
+        for (UAScheduleTriggerData *triggerData in triggers) {
+            if (!triggerData.predicateData) {
+                continue;
+            }
+
+            NSData *binaryPredicateData = [UAScheduleData binaryDataWithJSON:[UAScheduleData JSONWithStoredData:triggerData.predicateData]];
+            if (binaryPredicateData && ![binaryPredicateData isEqualToData:triggerData.predicateData]) {
+                triggerData.predicateData = binaryPredicateData;
+            }
+        }
+    }
+
+    UA_LTRACE(@"Converted %lu schedules to binary encoding", (unsigned long)schedules.count);
+}
+
 + (NSString *)generateUniqueID:(NSString *)identifier identifiers:(NSArray<NSString *> *)identifiers {
     NSString *unique = identifier;
     NSUInteger i = 0;
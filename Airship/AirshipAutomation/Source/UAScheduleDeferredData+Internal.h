@@ -28,6 +28,11 @@ typedef NS_ENUM(NSUInteger, UAScheduleDeferredDataErrorCode) {
  */
 @property(nonatomic, readonly, getter=isRetriableOnTimeout) BOOL retriableOnTimeout;
 
+/**
+ * Flag for resolving the URL ahead of time when the schedule's trigger is about to be met.
+ */
+@property(nonatomic, readonly, getter=isSpeculative) BOOL speculative;
+
 /**
  * Factory method.
  * @param URL The URL.
@@ -35,6 +40,16 @@ typedef NS_ENUM(NSUInteger, UAScheduleDeferredDataErrorCode) {
  */
 +(instancetype)deferredDataWithURL:(NSURL *)URL
                 retriableOnTimeout:(BOOL)retriableOnTimeout;
+
+/**
+ * Factory method.
+ * @param URL The URL.
+ * @param retriableOnTimeout `YES` to retry on timeout, otherwise `NO`.
+ * @param speculative `YES` to resolve ahead of the trigger, otherwise `NO`.
+ */
++(instancetype)deferredDataWithURL:(NSURL *)URL
+                retriableOnTimeout:(BOOL)retriableOnTimeout
+                       speculative:(BOOL)speculative;
 /**
  * Class factory method for constructing deferred data from JSON.
  *
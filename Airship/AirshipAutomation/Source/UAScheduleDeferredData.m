@@ -7,26 +7,36 @@ NSString *const UAScheduleDeferredDataErrorDomain = @"com.urbanairship.deferred_
 
 NSString *const UAScheduleDeferredDataURLKey = @"url";
 NSString *const UAScheduleDeferredDataRetryOnTimeoutKey = @"retry_on_timeout";
+NSString *const UAScheduleDeferredDataSpeculativeKey = @"speculative";
 
 @interface UAScheduleDeferredData()
 @property(nonatomic, copy) NSURL *URL;
 @property(nonatomic, assign) BOOL retriableOnTimeout;
+@property(nonatomic, assign) BOOL speculative;
 @end
 
 @implementation UAScheduleDeferredData
 - (instancetype)initWithURL:(NSURL *)URL
-         retriableOnTimeout:(BOOL)retriableOnTimeout {
+         retriableOnTimeout:(BOOL)retriableOnTimeout
+                speculative:(BOOL)speculative {
     self = [super init];
     if (self) {
         self.URL = URL;
         self.retriableOnTimeout = retriableOnTimeout;
+        self.speculative = speculative;
     }
     return self;
 }
 
 + (instancetype)deferredDataWithURL:(NSURL *)URL
                 retriableOnTimeout:(BOOL)retriableOnTimeout {
-    return [[self alloc] initWithURL:URL retriableOnTimeout:retriableOnTimeout];
+    return [[self alloc] initWithURL:URL retriableOnTimeout:retriableOnTimeout speculative:NO];
+}
+
++ (instancetype)deferredDataWithURL:(NSURL *)URL
+                retriableOnTimeout:(BOOL)retriableOnTimeout
+                       speculative:(BOOL)speculative {
+    return [[self alloc] initWithURL:URL retriableOnTimeout:retriableOnTimeout speculative:speculative];
 }
 
 + (nullable instancetype)deferredDataWithJSON:(id)JSON
@@ -55,15 +65,23 @@ NSString *const UAScheduleDeferredDataRetryOnTimeoutKey = @"retry_on_timeout";
     }
 
     BOOL retryOnTimeout = [[JSON numberForKey:UAScheduleDeferredDataRetryOnTimeoutKey defaultValue:@(YES)] boolValue];
+    BOOL speculative = [[JSON numberForKey:UAScheduleDeferredDataSpeculativeKey defaultValue:@(NO)] boolValue];
     return [UAScheduleDeferredData deferredDataWithURL:[NSURL URLWithString:URLString]
-                                    retriableOnTimeout:retryOnTimeout];
+                                    retriableOnTimeout:retryOnTimeout
+                                           speculative:speculative];
 }
 
 - (NSDictionary *)toJSON {
-    return @{
-        UAScheduleDeferredDataURLKey: [self.URL absoluteString],
-        UAScheduleDeferredDataRetryOnTimeoutKey: @(self.retriableOnTimeout)
-    };
+    NSMutableDictionary *JSON = [NSMutableDictionary dictionary];
+    JSON[UAScheduleDeferredDataURLKey] = [self.URL absoluteString];
+    JSON[UAScheduleDeferredDataRetryOnTimeoutKey] = @(self.retriableOnTimeout);
+
+    // Only written when set so existing payloads are unchanged
+    if (self.speculative) {
+        JSON[UAScheduleDeferredDataSpeculativeKey] = @(YES);
+    }
+
+    return [JSON copy];
 }
 
 - (BOOL)isEqual:(id)other {
@@ -79,13 +97,14 @@ NSString *const UAScheduleDeferredDataRetryOnTimeoutKey = @"retry_on_timeout";
 }
 
 - (BOOL)isEqualToDeferredData:(nullable UAScheduleDeferredData *)other {
-    return [self.URL isEqual:other.URL] && self.retriableOnTimeout == other.retriableOnTimeout;
+    return [self.URL isEqual:other.URL] && self.retriableOnTimeout == other.retriableOnTimeout && self.speculative == other.speculative;
 }
 
 - (NSUInteger)hash {
     NSUInteger result = 1;
     result = 31 * result + [self.URL hash];
     result = 31 * result + self.retriableOnTimeout;
+    result = 31 * result + self.speculative;
     return result;
 }
 
@@ -19,6 +19,7 @@
 @property(nonatomic, strong, nullable) NSNumber *interval;
 @property(nonatomic, copy, nullable) NSDictionary *metadata;
 @property(nonatomic, strong, nullable) UAScheduleAudience *audience;
+@property(nonatomic, copy, nullable) NSArray<NSString *> *frequencyConstraintIDs;
 @end
 
 @implementation UAScheduleEdits
@@ -41,6 +42,7 @@
         self.interval = builder.interval;
         self.metadata = builder.metadata;
         self.audience = builder.audience;
+        self.frequencyConstraintIDs = builder.frequencyConstraintIDs;
     }
 
     return self;
@@ -102,7 +104,8 @@
             "Edit Grace Period: %@\n"
             "Interval: %@\n"
             "Metadata: %@\n"
-            "Audience: %@",
+            "Audience: %@\n"
+            "Frequency Constraint IDs: %@",
             self.data,
             self.type,
             self.priority,
@@ -112,7 +115,8 @@
             self.editGracePeriod,
             self.interval,
             self.metadata,
-            self.audience];
+            self.audience,
+            self.frequencyConstraintIDs];
 }
 
 @end
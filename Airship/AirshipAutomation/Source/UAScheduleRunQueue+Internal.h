@@ -0,0 +1,77 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+@class UASchedule;
+@class UAScheduleTriggerContext;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A schedule waiting in the run queue.
+ */
+@interface UAScheduleRunQueueEntry : NSObject
+
+/**
+ * The schedule.
+ */
+@property (nonatomic, readonly) UASchedule *schedule;
+
+/**
+ * The context of the trigger that triggered the schedule.
+ */
+@property (nonatomic, readonly, nullable) UAScheduleTriggerContext *triggerContext;
+
+@end
+
+/**
+ * Binary heap of schedules ordered by priority in ascending order, then by the order they
+ * were added. A schedule is queued at most once.
+ *
+ * Thread safe.
+ */
+@interface UAScheduleRunQueue : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Schedule Run Queue Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The number of queued schedules.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+///---------------------------------------------------------------------------------------
+/// @name Schedule Run Queue Factory
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method.
+ *
+ * @return A new run queue.
+ */
++ (instancetype)runQueue;
+
+///---------------------------------------------------------------------------------------
+/// @name Schedule Run Queue Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Adds a schedule. Ignored if the schedule is already queued.
+ *
+ * @param schedule The schedule.
+ * @param triggerContext The trigger context.
+ * @return `YES` if the schedule was added, otherwise `NO`.
+ */
+- (BOOL)addSchedule:(UASchedule *)schedule triggerContext:(nullable UAScheduleTriggerContext *)triggerContext;
+
+/**
+ * Removes and returns the schedule with the lowest priority value.
+ *
+ * @return The next entry, or nil if the queue is empty.
+ */
+- (nullable UAScheduleRunQueueEntry *)popEntry;
+
+@end
+
+NS_ASSUME_NONNULL_END
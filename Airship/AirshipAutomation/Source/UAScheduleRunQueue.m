@@ -0,0 +1,132 @@
+/* Copyright Airship and Contributors */
+
+#import "UAScheduleRunQueue+Internal.h"
+#import "UASchedule.h"
+
+@interface UAScheduleRunQueueEntry ()
+@property (nonatomic, strong) UASchedule *schedule;
+@property (nonatomic, strong, nullable) UAScheduleTriggerContext *triggerContext;
+@property (nonatomic, assign) NSUInteger sequence;
+@end
+
+@implementation UAScheduleRunQueueEntry
+@end
+
+@interface UAScheduleRunQueue ()
+@property (nonatomic, strong) NSMutableArray<UAScheduleRunQueueEntry *> *heap;
+@property (nonatomic, strong) NSMutableSet<NSString *> *identifiers;
+@property (nonatomic, assign) NSUInteger nextSequence;
+@end
+
+@implementation UAScheduleRunQueue
+
+- (instancetype)init {
+    self = [super init];
+
+    if (self) {
+        self.heap = [NSMutableArray array];
+        self.identifiers = [NSMutableSet set];
+    }
+
+    return self;
+}
+
++ (instancetype)runQueue {
+    return [[UAScheduleRunQueue alloc] init];
+}
+
+- (NSUInteger)count {
+    @synchronized (self) {
+        return self.heap.count;
+    }
+}
+
+- (BOOL)addSchedule:(UASchedule *)schedule triggerContext:(UAScheduleTriggerContext *)triggerContext {
+    @synchronized (self) {
+        if ([self.identifiers containsObject:schedule.identifier]) {
+            return NO;
+        }
+
+        UAScheduleRunQueueEntry *entry = [[UAScheduleRunQueueEntry alloc] init];
+        entry.schedule = schedule;
+        entry.triggerContext = triggerContext;
+        entry.sequence = self.nextSequence++;
+
+        [self.identifiers addObject:schedule.identifier];
+        [self.heap addObject:entry];
+        [self siftUp:self.heap.count - 1];
+        return YES;
+    }
+}
+
+- (UAScheduleRunQueueEntry *)popEntry {
+    @synchronized (self) {
+        if (!self.heap.count) {
+            return nil;
+        }
+
+        UAScheduleRunQueueEntry *entry = self.heap.firstObject;
+        UAScheduleRunQueueEntry *last = self.heap.lastObject;
+        [self.heap removeLastObject];
+
+        if (self.heap.count) {
+            self.heap[0] = last;
+            [self siftDown:0];
+        }
+
+        [self.identifiers removeObject:entry.schedule.identifier];
+        return entry;
+    }
+}
+
+#pragma mark -
+#pragma mark Heap
+
+- (BOOL)entryAtIndex:(NSUInteger)index precedesEntryAtIndex:(NSUInteger)otherIndex {
+    UAScheduleRunQueueEntry *entry = self.heap[index];
+    UAScheduleRunQueueEntry *other = self.heap[otherIndex];
+
+    if (entry.schedule.priority != other.schedule.priority) {
+        return entry.schedule.priority < other.schedule.priority;
+    }
+
+    return entry.sequence < other.sequence;
+}
+
+- (void)siftUp:(NSUInteger)index {
+    while (index > 0) {
+        NSUInteger parent = (index - 1) / 2;
+        if (![self entryAtIndex:index precedesEntryAtIndex:parent]) {
+            return;
+        }
+
+        [self.heap exchangeObjectAtIndex:index withObjectAtIndex:parent];
+        index = parent;
+    }
+}
+
+- (void)siftDown:(NSUInteger)index {
+    NSUInteger count = self.heap.count;
+    while (YES) {
+        NSUInteger left = index * 2 + 1;
+        NSUInteger right = left + 1;
+        NSUInteger first = index;
+
+        if (left < count && [self entryAtIndex:left precedesEntryAtIndex:first]) {
+            first = left;
+        }
+
+        if (right < count && [self entryAtIndex:right precedesEntryAtIndex:first]) {
+            first = right;
+        }
+
+        if (first == index) {
+            return;
+        }
+
+        [self.heap exchangeObjectAtIndex:index withObjectAtIndex:first];
+        index = first;
+    }
+}
+
+@end
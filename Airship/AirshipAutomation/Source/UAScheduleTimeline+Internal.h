@@ -0,0 +1,108 @@
+/* Copyright Airship and Contributors */
+
+#import "UAScheduleTimeline.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Records schedule timelines. Each stage is recorded as an `os_signpost` interval in the
+ * `com.urbanairship` subsystem's `Automation` category, so it shows up in Instruments, and is
+ * kept in the schedule's timeline and the per stage metrics.
+ *
+ * A schedule has at most one timeline in progress. Timelines finish with an outcome and the
+ * most recent ones are kept in memory.
+ */
+@interface UAScheduleTimelineRecorder : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Schedule Timeline Recorder Internal Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The delegate, notified when a timeline finishes.
+ */
+@property (nonatomic, weak, nullable) id<UAScheduleTimelineDelegate> delegate;
+
+/**
+ * The most recently finished timelines, newest first.
+ */
+@property (nonatomic, copy, readonly) NSArray<UAScheduleTimeline *> *recentTimelines;
+
+/**
+ * The aggregate metrics, keyed by stage name.
+ */
+@property (nonatomic, copy, readonly) NSDictionary<NSString *, UAScheduleStageMetrics *> *stageMetrics;
+
+///---------------------------------------------------------------------------------------
+/// @name Schedule Timeline Recorder Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * The shared recorder.
+ */
++ (instancetype)shared;
+
+/**
+ * Starts a new timeline for the schedule, replacing any timeline in progress.
+ *
+ * @param scheduleID The schedule ID.
+ */
+- (void)beginTimelineWithScheduleID:(NSString *)scheduleID;
+
+/**
+ * Begins measuring a stage. Starts a timeline if the schedule does not have one in progress.
+ * Ignored if the stage is already in progress.
+ *
+ * @param stage The stage name.
+ * @param scheduleID The schedule ID.
+ */
+- (void)beginStage:(NSString *)stage scheduleID:(NSString *)scheduleID;
+
+/**
+ * Ends a stage started with `beginStage:scheduleID:`. Ignored if the stage is not in progress.
+ *
+ * @param stage The stage name.
+ * @param scheduleID The schedule ID.
+ * @param result The stage result.
+ */
+- (void)endStage:(NSString *)stage scheduleID:(NSString *)scheduleID result:(nullable NSString *)result;
+
+/**
+ * Records a stage that was measured by the caller. Starts a timeline if the schedule does not
+ * have one in progress.
+ *
+ * @param stage The stage name.
+ * @param scheduleID The schedule ID.
+ * @param duration The stage duration, in seconds.
+ * @param result The stage result.
+ */
+- (void)recordStage:(NSString *)stage
+         scheduleID:(NSString *)scheduleID
+           duration:(NSTimeInterval)duration
+             result:(nullable NSString *)result;
+
+/**
+ * Finishes the schedule's timeline and notifies the delegate. Stages still in progress are dropped.
+ * Ignored if the schedule does not have a timeline in progress.
+ *
+ * @param scheduleID The schedule ID.
+ * @param outcome The outcome.
+ */
+- (void)finishTimelineWithScheduleID:(NSString *)scheduleID outcome:(NSString *)outcome;
+
+/**
+ * Gets the schedule's timeline in progress, or its most recently finished timeline.
+ *
+ * @param scheduleID The schedule ID.
+ * @return The timeline, or `nil` if the schedule has none.
+ */
+- (nullable UAScheduleTimeline *)timelineForScheduleID:(NSString *)scheduleID;
+
+/**
+ * Clears all timelines and metrics.
+ */
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,330 @@
+/* Copyright Airship and Contributors */
+
+#import "UAScheduleTimeline+Internal.h"
+#import "UAAirshipAutomationCoreImport.h"
+
+#import <os/signpost.h>
+
+NSString *const UAScheduleTimelineStageTrigger = @"trigger";
+NSString *const UAScheduleTimelineStageAudience = @"audience";
+NSString *const UAScheduleTimelineStageTagLookup = @"tag_lookup";
+NSString *const UAScheduleTimelineStageAssets = @"assets";
+NSString *const UAScheduleTimelineStageAdapterPrepare = @"adapter_prepare";
+NSString *const UAScheduleTimelineStageReady = @"ready";
+NSString *const UAScheduleTimelineStageDisplay = @"display";
+
+NSString *const UAScheduleTimelineOutcomeDisplayed = @"displayed";
+NSString *const UAScheduleTimelineOutcomeExecuted = @"executed";
+NSString *const UAScheduleTimelineOutcomeCancelled = @"cancelled";
+NSString *const UAScheduleTimelineOutcomeSkipped = @"skipped";
+NSString *const UAScheduleTimelineOutcomePenalized = @"penalized";
+
+// Number of finished timelines kept in memory
+static NSUInteger const UAScheduleTimelineRecorderMaxTimelines = 50;
+
+@interface UAScheduleTimelineStage ()
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, assign) NSTimeInterval duration;
+@property (nonatomic, copy, nullable) NSString *result;
+@end
+
+@implementation UAScheduleTimelineStage
+
++ (instancetype)stageWithName:(NSString *)name duration:(NSTimeInterval)duration result:(nullable NSString *)result {
+    UAScheduleTimelineStage *stage = [[self alloc] init];
+    stage.name = name;
+    stage.duration = duration;
+    stage.result = result;
+    return stage;
+}
+
+- (NSString *)description {
+    if (self.result) {
+        return [NSString stringWithFormat:@"%@ (%@): %.1fms", self.name, self.result, self.duration * 1000];
+    }
+    return [NSString stringWithFormat:@"%@: %.1fms", self.name, self.duration * 1000];
+}
+
+@end
+
+@interface UAScheduleTimeline ()
+@property (nonatomic, copy) NSString *scheduleID;
+@property (nonatomic, strong) NSDate *startDate;
+@property (nonatomic, copy) NSArray<UAScheduleTimelineStage *> *stages;
+@property (nonatomic, copy, nullable) NSString *outcome;
+@property (nonatomic, assign) NSTimeInterval startUptime;
+@property (nonatomic, assign) NSTimeInterval finishUptime;
+
+/**
+ * Stages in progress, mapped to their start uptime and signpost ID. Only set on timelines in progress.
+ */
+@property (nonatomic, strong, nullable) NSMutableDictionary<NSString *, NSArray<NSNumber *> *> *openStages;
+@end
+
+@implementation UAScheduleTimeline
+
++ (instancetype)timelineWithScheduleID:(NSString *)scheduleID {
+    UAScheduleTimeline *timeline = [[self alloc] init];
+    timeline.scheduleID = scheduleID;
+    timeline.startDate = [NSDate date];
+    timeline.startUptime = [NSProcessInfo processInfo].systemUptime;
+    timeline.stages = @[];
+    timeline.openStages = [NSMutableDictionary dictionary];
+    return timeline;
+}
+
+- (UAScheduleTimeline *)snapshot {
+    UAScheduleTimeline *snapshot = [[UAScheduleTimeline alloc] init];
+    snapshot.scheduleID = self.scheduleID;
+    snapshot.startDate = self.startDate;
+    snapshot.stages = self.stages;
+    snapshot.outcome = self.outcome;
+    snapshot.startUptime = self.startUptime;
+    snapshot.finishUptime = self.finishUptime;
+    return snapshot;
+}
+
+- (NSTimeInterval)duration {
+    NSTimeInterval end = self.finishUptime ?: [NSProcessInfo processInfo].systemUptime;
+    return end - self.startUptime;
+}
+
+- (NSString *)description {
+    NSString *stages = [[self.stages valueForKey:@"description"] componentsJoinedByString:@", "];
+    return [NSString stringWithFormat:@"Schedule %@ %@ after %.1fms: %@", self.scheduleID, self.outcome ?: @"in progress", self.duration * 1000, stages];
+}
+
+@end
+
+@interface UAScheduleStageMetrics ()
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, assign) NSUInteger count;
+@property (nonatomic, assign) NSTimeInterval totalDuration;
+@property (nonatomic, assign) NSTimeInterval maxDuration;
+@end
+
+@implementation UAScheduleStageMetrics
+
++ (instancetype)metricsWithName:(NSString *)name count:(NSUInteger)count totalDuration:(NSTimeInterval)totalDuration maxDuration:(NSTimeInterval)maxDuration {
+    UAScheduleStageMetrics *metrics = [[self alloc] init];
+    metrics.name = name;
+    metrics.count = count;
+    metrics.totalDuration = totalDuration;
+    metrics.maxDuration = maxDuration;
+    return metrics;
+}
+
+- (NSTimeInterval)averageDuration {
+    return self.count ? self.totalDuration / self.count : 0;
+}
+
+- (UAScheduleStageMetrics *)metricsByAddingDuration:(NSTimeInterval)duration {
+    return [UAScheduleStageMetrics metricsWithName:self.name
+                                             count:self.count + 1
+                                     totalDuration:self.totalDuration + duration
+                                       maxDuration:MAX(self.maxDuration, duration)];
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"%@: %lu, avg %.1fms, max %.1fms", self.name, (unsigned long)self.count, self.averageDuration * 1000, self.maxDuration * 1000];
+}
+
+@end
+
+@interface UAScheduleTimelineRecorder ()
+@property (nonatomic, strong) NSMutableDictionary<NSString *, UAScheduleTimeline *> *activeTimelines;
+@property (nonatomic, strong) NSMutableArray<UAScheduleTimeline *> *finishedTimelines;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, UAScheduleStageMetrics *> *metrics;
+@property (nonatomic, strong) os_log_t log;
+@end
+
+@implementation UAScheduleTimelineRecorder
+
+- (instancetype)init {
+    self = [super init];
+
+    if (self) {
+        self.activeTimelines = [NSMutableDictionary dictionary];
+        self.finishedTimelines = [NSMutableArray array];
+        self.metrics = [NSMutableDictionary dictionary];
+        self.log = os_log_create("com.urbanairship", "Automation");
+    }
+
+    return self;
+}
+
++ (instancetype)shared {
+    static UAScheduleTimelineRecorder *shared;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        shared = [[self alloc] init];
+    });
+
+    return shared;
+}
+
+- (void)beginTimelineWithScheduleID:(NSString *)scheduleID {
+    @synchronized (self) {
+        self.activeTimelines[scheduleID] = [UAScheduleTimeline timelineWithScheduleID:scheduleID];
+    }
+}
+
+/**
+ * Gets the timeline in progress, starting one if needed. Must be called while synchronized.
+ */
+- (UAScheduleTimeline *)activeTimelineForScheduleID:(NSString *)scheduleID {
+    UAScheduleTimeline *timeline = self.activeTimelines[scheduleID];
+    if (!timeline) {
+        timeline = [UAScheduleTimeline timelineWithScheduleID:scheduleID];
+        self.activeTimelines[scheduleID] = timeline;
+    }
+    return timeline;
+}
+
+/**
+ * Adds a finished stage to a timeline. Must be called while synchronized.
+ */
+- (void)addStage:(UAScheduleTimelineStage *)stage toTimeline:(UAScheduleTimeline *)timeline {
+    timeline.stages = [timeline.stages arrayByAddingObject:stage];
+
+    UAScheduleStageMetrics *metrics = self.metrics[stage.name] ?: [UAScheduleStageMetrics metricsWithName:stage.name count:0 totalDuration:0 maxDuration:0];
+    self.metrics[stage.name] = [metrics metricsByAddingDuration:stage.duration];
+}
+
+/**
+ * Reports a stage duration to the shared metrics registry. Called outside of the lock.
+ */
+- (void)recordStageMetric:(NSString *)stage duration:(NSTimeInterval)duration {
+    [[UAMetricsRegistry shared] recordDuration:duration forMetric:[UAMetricAutomationStagePrefix stringByAppendingString:stage]];
+}
+
+- (void)beginStage:(NSString *)stage scheduleID:(NSString *)scheduleID {
+    os_signpost_id_t signpostID = 0;
+
+    @synchronized (self) {
+        UAScheduleTimeline *timeline = [self activeTimelineForScheduleID:scheduleID];
+        if (timeline.openStages[stage]) {
+            return;
+        }
+
+        if (@available(iOS 12.0, tvOS 12.0, *)) {
+            signpostID = os_signpost_id_generate(self.log);
+        }
+
+        timeline.openStages[stage] = @[@([NSProcessInfo processInfo].systemUptime), @(signpostID)];
+    }
+
+    if (@available(iOS 12.0, tvOS 12.0, *)) {
+        os_signpost_interval_begin(self.log, signpostID, "Schedule Stage", "%{public}@ %{public}@", stage, scheduleID);
+    }
+}
+
+- (void)endStage:(NSString *)stage scheduleID:(NSString *)scheduleID result:(nullable NSString *)result {
+    NSArray<NSNumber *> *openStage;
+    NSTimeInterval duration;
+
+    @synchronized (self) {
+        UAScheduleTimeline *timeline = self.activeTimelines[scheduleID];
+        openStage = timeline.openStages[stage];
+        if (!openStage) {
+            return;
+        }
+        [timeline.openStages removeObjectForKey:stage];
+
+        duration = [NSProcessInfo processInfo].systemUptime - [openStage[0] doubleValue];
+        [self addStage:[UAScheduleTimelineStage stageWithName:stage duration:duration result:result] toTimeline:timeline];
+    }
+
+    [self recordStageMetric:stage duration:duration];
+
+    if (@available(iOS 12.0, tvOS 12.0, *)) {
+        os_signpost_interval_end(self.log, [openStage[1] unsignedLongLongValue], "Schedule Stage", "%{public}@ %{public}@ %{public}@", stage, scheduleID, result ?: @"");
+    }
+}
+
+- (void)recordStage:(NSString *)stage
+         scheduleID:(NSString *)scheduleID
+           duration:(NSTimeInterval)duration
+             result:(nullable NSString *)result {
+
+    @synchronized (self) {
+        UAScheduleTimeline *timeline = [self activeTimelineForScheduleID:scheduleID];
+        [self addStage:[UAScheduleTimelineStage stageWithName:stage duration:duration result:result] toTimeline:timeline];
+    }
+
+    [self recordStageMetric:stage duration:duration];
+
+    if (@available(iOS 12.0, tvOS 12.0, *)) {
+        os_signpost_event_emit(self.log, OS_SIGNPOST_ID_EXCLUSIVE, "Schedule Stage", "%{public}@ %{public}@ %.1fms", stage, scheduleID, duration * 1000);
+    }
+}
+
+- (void)finishTimelineWithScheduleID:(NSString *)scheduleID outcome:(NSString *)outcome {
+    UAScheduleTimeline *timeline;
+
+    @synchronized (self) {
+        timeline = self.activeTimelines[scheduleID];
+        if (!timeline) {
+            return;
+        }
+        [self.activeTimelines removeObjectForKey:scheduleID];
+
+        timeline.outcome = outcome;
+        timeline.finishUptime = [NSProcessInfo processInfo].systemUptime;
+        timeline.openStages = nil;
+
+        [self.finishedTimelines insertObject:timeline atIndex:0];
+        if (self.finishedTimelines.count > UAScheduleTimelineRecorderMaxTimelines) {
+            [self.finishedTimelines removeLastObject];
+        }
+    }
+
+    if (@available(iOS 12.0, tvOS 12.0, *)) {
+        os_signpost_event_emit(self.log, OS_SIGNPOST_ID_EXCLUSIVE, "Schedule Timeline", "%{public}@ %{public}@ %.1fms", scheduleID, outcome, timeline.duration * 1000);
+    }
+
+    UA_LDEBUG(@"%@", timeline);
+
+    [[UADispatcher mainDispatcher] dispatchAsync:^{
+        [self.delegate scheduleTimelineFinished:timeline];
+    }];
+}
+
+- (nullable UAScheduleTimeline *)timelineForScheduleID:(NSString *)scheduleID {
+    @synchronized (self) {
+        UAScheduleTimeline *active = self.activeTimelines[scheduleID];
+        if (active) {
+            return [active snapshot];
+        }
+
+        for (UAScheduleTimeline *timeline in self.finishedTimelines) {
+            if ([timeline.scheduleID isEqualToString:scheduleID]) {
+                return timeline;
+            }
+        }
+
+        return nil;
+    }
+}
+
+- (NSArray<UAScheduleTimeline *> *)recentTimelines {
+    @synchronized (self) {
+        return [self.finishedTimelines copy];
+    }
+}
+
+- (NSDictionary<NSString *, UAScheduleStageMetrics *> *)stageMetrics {
+    @synchronized (self) {
+        return [self.metrics copy];
+    }
+}
+
+- (void)reset {
+    @synchronized (self) {
+        [self.activeTimelines removeAllObjects];
+        [self.finishedTimelines removeAllObjects];
+        [self.metrics removeAllObjects];
+    }
+}
+
+@end
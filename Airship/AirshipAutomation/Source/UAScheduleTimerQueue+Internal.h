@@ -0,0 +1,70 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+@class UATimerScheduler;
+@class UADate;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Multiplexes schedule delay and interval timers onto a single timer armed for the earliest
+ * deadline. Timers are keyed by schedule identifier, so adding a timer for a schedule
+ * replaces its previous timer and cancelling is a dictionary removal.
+ *
+ * Not thread safe. All methods must be called on the main queue.
+ */
+@interface UAScheduleTimerQueue : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Schedule Timer Queue Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The number of pending timers.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+///---------------------------------------------------------------------------------------
+/// @name Schedule Timer Queue Factory
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method.
+ *
+ * @param timerScheduler The timer scheduler used to schedule the underlying timer.
+ * @param date The date used to compute deadlines.
+ * @return A new timer queue.
+ */
++ (instancetype)timerQueueWithTimerScheduler:(UATimerScheduler *)timerScheduler date:(UADate *)date;
+
+///---------------------------------------------------------------------------------------
+/// @name Schedule Timer Queue Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Adds a timer, replacing any pending timer with the same identifier.
+ *
+ * @param identifier The schedule identifier.
+ * @param timeInterval The time interval until the timer fires.
+ * @param block The block to call when the timer fires.
+ */
+- (void)addTimerWithIdentifier:(NSString *)identifier
+                  timeInterval:(NSTimeInterval)timeInterval
+                         block:(void (^)(NSString *identifier))block;
+
+/**
+ * Cancels the pending timers for the identifiers.
+ *
+ * @param identifiers The schedule identifiers.
+ */
+- (void)cancelTimersWithIdentifiers:(NSSet<NSString *> *)identifiers;
+
+/**
+ * Cancels all pending timers.
+ */
+- (void)cancelAllTimers;
+
+@end
+
+NS_ASSUME_NONNULL_END
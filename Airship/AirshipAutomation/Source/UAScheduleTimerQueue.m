@@ -0,0 +1,150 @@
+/* Copyright Airship and Contributors */
+
+#import "UAScheduleTimerQueue+Internal.h"
+#import "UATimerScheduler+Internal.h"
+#import "UAAirshipAutomationCoreImport.h"
+
+// Shortest interval the underlying timer is armed for
+static NSTimeInterval const UAScheduleTimerQueueMinInterval = 0.1;
+
+@interface UAScheduleTimerEntry : NSObject
+@property (nonatomic, strong) NSDate *deadline;
+@property (nonatomic, copy) void (^block)(NSString *);
+@end
+
+@implementation UAScheduleTimerEntry
+@end
+
+@interface UAScheduleTimerQueue ()
+@property (nonatomic, strong) UATimerScheduler *timerScheduler;
+@property (nonatomic, strong) UADate *date;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, UAScheduleTimerEntry *> *entries;
+@property (nonatomic, strong, nullable) NSTimer *timer;
+@property (nonatomic, strong, nullable) NSDate *armedDeadline;
+@end
+
+@implementation UAScheduleTimerQueue
+
+- (instancetype)initWithTimerScheduler:(UATimerScheduler *)timerScheduler date:(UADate *)date {
+    self = [super init];
+
+    if (self) {
+        self.timerScheduler = timerScheduler;
+        self.date = date;
+        self.entries = [NSMutableDictionary dictionary];
+    }
+
+    return self;
+}
+
++ (instancetype)timerQueueWithTimerScheduler:(UATimerScheduler *)timerScheduler date:(UADate *)date {
+    return [[UAScheduleTimerQueue alloc] initWithTimerScheduler:timerScheduler date:date];
+}
+
+- (void)dealloc {
+    [self.timer invalidate];
+}
+
+- (NSUInteger)count {
+    return self.entries.count;
+}
+
+- (void)addTimerWithIdentifier:(NSString *)identifier
+                  timeInterval:(NSTimeInterval)timeInterval
+                         block:(void (^)(NSString *))block {
+    UAScheduleTimerEntry *entry = [[UAScheduleTimerEntry alloc] init];
+    entry.deadline = [self.date.now dateByAddingTimeInterval:MAX(timeInterval, 0)];
+    entry.block = block;
+
+    UAScheduleTimerEntry *previous = self.entries[identifier];
+    self.entries[identifier] = entry;
+
+    // Only rearm if the earliest deadline may have changed
+    if (!self.armedDeadline || [entry.deadline compare:self.armedDeadline] == NSOrderedAscending ||
+        (previous && [previous.deadline isEqualToDate:self.armedDeadline])) {
+        [self rearm];
+    }
+}
+
+- (void)cancelTimersWithIdentifiers:(NSSet<NSString *> *)identifiers {
+    BOOL removedEarliest = NO;
+    for (NSString *identifier in identifiers) {
+        UAScheduleTimerEntry *entry = self.entries[identifier];
+        if (!entry) {
+            continue;
+        }
+
+        removedEarliest = removedEarliest || [entry.deadline isEqualToDate:self.armedDeadline];
+        [self.entries removeObjectForKey:identifier];
+    }
+
+    if (removedEarliest) {
+        [self rearm];
+    }
+}
+
+- (void)cancelAllTimers {
+    [self.entries removeAllObjects];
+    [self rearm];
+}
+
+/**
+ * Arms the underlying timer for the earliest pending deadline.
+ */
+- (void)rearm {
+    [self.timer invalidate];
+    self.timer = nil;
+    self.armedDeadline = nil;
+
+    NSDate *earliest;
+    for (UAScheduleTimerEntry *entry in self.entries.allValues) {
+        if (!earliest || [entry.deadline compare:earliest] == NSOrderedAscending) {
+            earliest = entry.deadline;
+        }
+    }
+
+    if (!earliest) {
+        return;
+    }
+
+    NSTimeInterval interval = MAX([earliest timeIntervalSinceDate:self.date.now], UAScheduleTimerQueueMinInterval);
+    NSTimer *timer = [NSTimer timerWithTimeInterval:interval
+                                             target:self
+                                           selector:@selector(timerFired:)
+                                           userInfo:nil
+                                            repeats:NO];
+
+    // Set before scheduling, the scheduler may fire the timer immediately
+    self.timer = timer;
+    self.armedDeadline = earliest;
+
+    UA_LTRACE(@"Arming automation timer for %f seconds, pending timers: %lu", interval, (unsigned long)self.entries.count);
+    [self.timerScheduler scheduleTimer:timer];
+}
+
+- (void)timerFired:(NSTimer *)timer {
+    if (timer != self.timer) {
+        return;
+    }
+
+    // The timer firing means its deadline was reached, even if the clock disagrees
+    NSDate *now = self.date.now;
+    NSDate *cutoff = [self.armedDeadline compare:now] == NSOrderedDescending ? self.armedDeadline : now;
+
+    NSMutableDictionary<NSString *, UAScheduleTimerEntry *> *due = [NSMutableDictionary dictionary];
+    for (NSString *identifier in self.entries.allKeys) {
+        UAScheduleTimerEntry *entry = self.entries[identifier];
+        if ([entry.deadline compare:cutoff] != NSOrderedDescending) {
+            due[identifier] = entry;
+            [self.entries removeObjectForKey:identifier];
+        }
+    }
+
+    [self rearm];
+
+    for (NSString *identifier in due) {
+        due[identifier].block(identifier);
+    }
+}
+
+@end
@@ -36,6 +36,31 @@ NS_ASSUME_NONNULL_BEGIN
 + (instancetype)triggerContextWithTrigger:(UAScheduleTrigger *)trigger
                                     event:(nullable id)event;
 
+/**
+ * Factory method to create a trigger context from compact data.
+ *
+ * The trigger is restored without its predicate.
+ *
+ * @param data The data returned by `compactDataWithMaxEventSize:`.
+ * @return A schedule trigger context, or nil if the data is not valid compact data.
+ */
++ (nullable instancetype)triggerContextWithCompactData:(NSData *)data;
+
+///---------------------------------------------------------------------------------------
+/// @name Schedule Trigger Context Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Encodes the trigger type, the trigger goal and the event as compact JSON data.
+ *
+ * Events whose JSON is larger than the max size are stored without their custom event
+ * properties, or dropped if that is still too large.
+ *
+ * @param maxEventSize The max size in bytes of the retained event JSON.
+ * @return The compact data.
+ */
+- (nullable NSData *)compactDataWithMaxEventSize:(NSUInteger)maxEventSize;
+
 @end
 
 NS_ASSUME_NONNULL_END
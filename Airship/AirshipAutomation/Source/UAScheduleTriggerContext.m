@@ -2,11 +2,20 @@
 
 #import "UAScheduleTriggerContext+Internal.h"
 #import "UAScheduleTrigger+Internal.h"
-#import "NSJSONSerialization+UAAdditions.h"
+#import "UAAirshipAutomationCoreImport.h"
 
 static NSString *const UAScheduleTriggerContextTriggerKey = @"trigger";
 static NSString *const UAScheduleTriggerContextEventKey = @"event";
 
+// Compact data keys
+static NSString *const UAScheduleTriggerContextTypeKey = @"type";
+static NSString *const UAScheduleTriggerContextGoalKey = @"goal";
+static NSString *const UAScheduleTriggerContextEventTypeKey = @"event_type";
+
+// Compact data event types
+static NSString *const UAScheduleTriggerContextEventTypeFull = @"full";
+static NSString *const UAScheduleTriggerContextEventTypeWithoutProperties = @"no_properties";
+
 @interface UAScheduleTriggerContext()
 @property(nonatomic, strong) UAScheduleTrigger *trigger;
 @property(nonatomic, strong) id event;
@@ -29,6 +38,62 @@ static NSString *const UAScheduleTriggerContextEventKey = @"event";
     return [[UAScheduleTriggerContext alloc] initWithTrigger:trigger event:event];
 }
 
+- (NSData *)compactDataWithMaxEventSize:(NSUInteger)maxEventSize {
+    if (!self.trigger) {
+        return nil;
+    }
+
+    NSMutableDictionary *json = [NSMutableDictionary dictionary];
+    json[UAScheduleTriggerContextTypeKey] = @(self.trigger.type);
+    json[UAScheduleTriggerContextGoalKey] = self.trigger.goal;
+
+    NSString *eventJSON = self.event ? [NSJSONSerialization stringWithObject:self.event acceptingFragments:YES] : nil;
+    NSString *eventType = UAScheduleTriggerContextEventTypeFull;
+
+    // Custom event properties are the bulk of most events, drop them before dropping the event
+    if ([eventJSON lengthOfBytesUsingEncoding:NSUTF8StringEncoding] > maxEventSize && [self.event isKindOfClass:[NSDictionary class]] && self.event[UACustomEventPropertiesKey]) {
+        NSMutableDictionary *event = [self.event mutableCopy];
+        [event removeObjectForKey:UACustomEventPropertiesKey];
+        eventJSON = [NSJSONSerialization stringWithObject:event];
+        eventType = UAScheduleTriggerContextEventTypeWithoutProperties;
+    }
+
+    if ([eventJSON lengthOfBytesUsingEncoding:NSUTF8StringEncoding] > maxEventSize) {
+        UA_LDEBUG(@"Trigger context event exceeds %lu bytes, dropping it", (unsigned long)maxEventSize);
+        eventJSON = nil;
+    }
+
+    if (eventJSON) {
+        json[UAScheduleTriggerContextEventKey] = eventJSON;
+        json[UAScheduleTriggerContextEventTypeKey] = eventType;
+    }
+
+    return [NSJSONSerialization dataWithJSONObject:json options:0 error:nil];
+}
+
++ (instancetype)triggerContextWithCompactData:(NSData *)data {
+    id json = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+    if (![json isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+
+    id type = json[UAScheduleTriggerContextTypeKey];
+    id goal = json[UAScheduleTriggerContextGoalKey];
+    if (![type isKindOfClass:[NSNumber class]] || ![goal isKindOfClass:[NSNumber class]]) {
+        return nil;
+    }
+
+    id event;
+    id eventJSON = json[UAScheduleTriggerContextEventKey];
+    if ([eventJSON isKindOfClass:[NSString class]]) {
+        event = [NSJSONSerialization objectWithString:eventJSON
+                                              options:NSJSONReadingMutableContainers | NSJSONReadingAllowFragments];
+    }
+
+    UAScheduleTrigger *trigger = [UAScheduleTrigger triggerWithType:[type integerValue] goal:goal predicate:nil];
+    return [[UAScheduleTriggerContext alloc] initWithTrigger:trigger event:event];
+}
+
 - (BOOL)isEqualToTriggerContext:(UAScheduleTriggerContext *)triggerContext {
     if (!triggerContext) {
         return NO;
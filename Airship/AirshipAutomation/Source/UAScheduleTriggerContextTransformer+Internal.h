@@ -1,10 +1,32 @@
-
 #import <Foundation/Foundation.h>
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ * Default max size in bytes of the event JSON retained in a stored trigger context.
+ */
+extern NSUInteger const UAScheduleTriggerContextTransformerDefaultMaxEventSize;
+
+/**
+ * Transforms trigger contexts to compact JSON data. Data archived with `NSKeyedArchiver` by
+ * older versions is still decoded.
+ */
 @interface UAScheduleTriggerContextTransformer : NSValueTransformer
 
+/**
+ * The max size in bytes of the event JSON retained in a stored trigger context.
+ * Defaults to `UAScheduleTriggerContextTransformerDefaultMaxEventSize`.
+ */
+@property (atomic, assign) NSUInteger maxEventSize;
+
+/**
+ * Factory method.
+ *
+ * @param maxEventSize The max size in bytes of the retained event JSON.
+ * @return A trigger context transformer.
+ */
++ (instancetype)transformerWithMaxEventSize:(NSUInteger)maxEventSize;
+
 @end
 
 NS_ASSUME_NONNULL_END
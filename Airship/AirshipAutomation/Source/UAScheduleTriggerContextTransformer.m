@@ -5,8 +5,26 @@
 #import "UAScheduleTrigger+Internal.h"
 #import "UAAirshipAutomationCoreImport.h"
 
+NSUInteger const UAScheduleTriggerContextTransformerDefaultMaxEventSize = 4096;
+
 @implementation UAScheduleTriggerContextTransformer
 
+- (instancetype)init {
+    self = [super init];
+
+    if (self) {
+        self.maxEventSize = UAScheduleTriggerContextTransformerDefaultMaxEventSize;
+    }
+
+    return self;
+}
+
++ (instancetype)transformerWithMaxEventSize:(NSUInteger)maxEventSize {
+    UAScheduleTriggerContextTransformer *transformer = [[UAScheduleTriggerContextTransformer alloc] init];
+    transformer.maxEventSize = maxEventSize;
+    return transformer;
+}
+
 + (Class)transformedValueClass {
     return [NSData class];
 }
@@ -16,19 +34,29 @@
 }
 
 - (id)transformedValue:(id)value {
-    NSError *error = nil;
-    id result = [NSKeyedArchiver archivedDataWithRootObject:value
-                                      requiringSecureCoding:YES
-                                                      error:&error];
+    if (![value isKindOfClass:[UAScheduleTriggerContext class]]) {
+        return nil;
+    }
 
-    if (error) {
-        UA_LERR(@"Failed to transform value: %@, error: %@", value, error);
+    id result = [value compactDataWithMaxEventSize:self.maxEventSize];
+    if (!result) {
+        UA_LERR(@"Failed to transform value: %@", value);
     }
 
     return result;
 }
 
 - (id)reverseTransformedValue:(id)value {
+    if (![value isKindOfClass:[NSData class]]) {
+        return nil;
+    }
+
+    // Compact data is a JSON object, anything else is a keyed archive from an older version
+    const char *bytes = [value bytes];
+    if ([value length] && bytes[0] == '{') {
+        return [UAScheduleTriggerContext triggerContextWithCompactData:value];
+    }
+
     NSError *error = nil;
     id result = [NSKeyedUnarchiver unarchivedObjectOfClass:[UAScheduleTriggerContext class]
                                                   fromData:value
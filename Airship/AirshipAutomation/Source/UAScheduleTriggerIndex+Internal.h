@@ -0,0 +1,98 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+#import "UAScheduleTrigger.h"
+
+@class UAJSONPredicate;
+@class UASchedule;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * In-memory index of the trigger types, and for custom event, region and screen triggers the
+ * event names, region IDs and screen names, that have at least one stored trigger. The index may report candidates that no longer
+ * exist, but never misses a stored trigger, so it can be used to skip store lookups for
+ * events that cannot match anything.
+ *
+ * Until the first rebuild finishes every event is reported as a candidate.
+ */
+@interface UAScheduleTriggerIndex : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Schedule Trigger Index Factory
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method.
+ *
+ * @return A new trigger index.
+ */
++ (instancetype)triggerIndex;
+
+///---------------------------------------------------------------------------------------
+/// @name Schedule Trigger Index Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Adds a trigger to the index.
+ *
+ * @param type The trigger type.
+ * @param predicate The trigger's predicate.
+ */
+- (void)addTriggerWithType:(UAScheduleTriggerType)type predicate:(nullable UAJSONPredicate *)predicate;
+
+/**
+ * Adds the triggers and cancellation triggers of the schedules to the index.
+ *
+ * @param schedules The schedules.
+ */
+- (void)addSchedules:(NSArray<UASchedule *> *)schedules;
+
+/**
+ * Starts a rebuild. Triggers added after this call are kept when the rebuild finishes.
+ *
+ * @return The rebuild identifier to pass to `finishRebuild:withIndex:`.
+ */
+- (NSUInteger)beginRebuild;
+
+/**
+ * Replaces the index with the contents of a freshly built index. Ignored if a newer
+ * rebuild has started since.
+ *
+ * @param rebuildID The identifier returned by `beginRebuild`.
+ * @param index An index built from every stored trigger.
+ */
+- (void)finishRebuild:(NSUInteger)rebuildID withIndex:(UAScheduleTriggerIndex *)index;
+
+/**
+ * Checks if any trigger might match the event.
+ *
+ * @param type The trigger type.
+ * @param argument The event argument the trigger predicates are evaluated against.
+ * @return `YES` if a trigger might match, `NO` if none can.
+ */
+- (BOOL)hasCandidatesForType:(UAScheduleTriggerType)type argument:(nullable id)argument;
+
+/**
+ * The lowercased match keys a trigger predicate requires. Match keys are the event name for
+ * custom event triggers, the region ID for region triggers and the screen name for screen
+ * triggers. An event whose lowercased match key is not in the set can not match the predicate.
+ *
+ * @param type The trigger type.
+ * @param predicate The predicate.
+ * @return The set of match keys, or nil if the predicate may match any event of the type.
+ */
++ (nullable NSSet<NSString *> *)matchKeysForType:(UAScheduleTriggerType)type predicate:(UAJSONPredicate *)predicate;
+
+/**
+ * The lowercased match key of a trigger event argument.
+ *
+ * @param type The trigger type.
+ * @param argument The event argument.
+ * @return The match key, or nil if the trigger type is not indexed or the event has no key.
+ */
++ (nullable NSString *)matchKeyForType:(UAScheduleTriggerType)type argument:(nullable id)argument;
+
+@end
+
+NS_ASSUME_NONNULL_END
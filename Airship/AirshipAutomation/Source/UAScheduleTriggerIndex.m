@@ -0,0 +1,238 @@
+/* Copyright Airship and Contributors */
+
+#import "UAScheduleTriggerIndex+Internal.h"
+#import "UASchedule.h"
+#import "UAScheduleDelay.h"
+#import "UAAirshipAutomationCoreImport.h"
+
+// Bucket entry for triggers that may match any event of their type
+static NSString *const UAScheduleTriggerIndexAnyName = @"*";
+
+// Predicate JSON keys
+static NSString *const UAScheduleTriggerIndexKeyKey = @"key";
+static NSString *const UAScheduleTriggerIndexScopeKey = @"scope";
+static NSString *const UAScheduleTriggerIndexValueKey = @"value";
+static NSString *const UAScheduleTriggerIndexEqualsKey = @"equals";
+
+@interface UAScheduleTriggerIndex ()
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSMutableSet<NSString *> *> *buckets;
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSMutableSet<NSString *> *> *additions;
+@property (nonatomic, assign) NSUInteger rebuildID;
+@property (nonatomic, assign) BOOL loaded;
+@end
+
+@implementation UAScheduleTriggerIndex
+
+- (instancetype)init {
+    self = [super init];
+
+    if (self) {
+        self.buckets = [NSMutableDictionary dictionary];
+        self.additions = [NSMutableDictionary dictionary];
+    }
+
+    return self;
+}
+
++ (instancetype)triggerIndex {
+    return [[UAScheduleTriggerIndex alloc] init];
+}
+
+- (void)addTriggerWithType:(UAScheduleTriggerType)type predicate:(UAJSONPredicate *)predicate {
+    NSSet<NSString *> *names = predicate ? [UAScheduleTriggerIndex matchKeysForType:type predicate:predicate] : nil;
+    if (!names) {
+        names = [NSSet setWithObject:UAScheduleTriggerIndexAnyName];
+    }
+
+    @synchronized (self) {
+        [UAScheduleTriggerIndex addNames:names type:type toBuckets:self.buckets];
+        [UAScheduleTriggerIndex addNames:names type:type toBuckets:self.additions];
+    }
+}
+
+- (void)addSchedules:(NSArray<UASchedule *> *)schedules {
+    for (UASchedule *schedule in schedules) {
+        for (UAScheduleTrigger *trigger in schedule.triggers) {
+            [self addTriggerWithType:trigger.type predicate:trigger.predicate];
+        }
+
+        for (UAScheduleTrigger *trigger in schedule.delay.cancellationTriggers) {
+            [self addTriggerWithType:trigger.type predicate:trigger.predicate];
+        }
+    }
+}
+
+- (NSUInteger)beginRebuild {
+    @synchronized (self) {
+        [self.additions removeAllObjects];
+        return ++self.rebuildID;
+    }
+}
+
+- (void)finishRebuild:(NSUInteger)rebuildID withIndex:(UAScheduleTriggerIndex *)index {
+    NSMutableDictionary *buckets = [NSMutableDictionary dictionary];
+    @synchronized (index) {
+        for (NSNumber *type in index.buckets) {
+            [UAScheduleTriggerIndex addNames:index.buckets[type] type:type.integerValue toBuckets:buckets];
+        }
+    }
+
+    @synchronized (self) {
+        if (rebuildID != self.rebuildID) {
+            return;
+        }
+
+        for (NSNumber *type in self.additions) {
+            [UAScheduleTriggerIndex addNames:self.additions[type] type:type.integerValue toBuckets:buckets];
+        }
+
+        self.buckets = buckets;
+        self.loaded = YES;
+    }
+}
+
+- (BOOL)hasCandidatesForType:(UAScheduleTriggerType)type argument:(id)argument {
+    @synchronized (self) {
+        if (!self.loaded) {
+            return YES;
+        }
+
+        NSSet<NSString *> *names = self.buckets[@(type)];
+        if (!names.count) {
+            return NO;
+        }
+
+        if ([names containsObject:UAScheduleTriggerIndexAnyName]) {
+            return YES;
+        }
+
+        NSString *name = [UAScheduleTriggerIndex matchKeyForType:type argument:argument];
+        if (!name) {
+            return YES;
+        }
+
+        return [names containsObject:name];
+    }
+}
+
++ (NSSet<NSString *> *)matchKeysForType:(UAScheduleTriggerType)type predicate:(UAJSONPredicate *)predicate {
+    NSArray<NSString *> *path = [self matchKeyPathForType:type];
+    return path ? [self matchKeysFromJSON:predicate.payload path:path] : nil;
+}
+
++ (NSString *)matchKeyForType:(UAScheduleTriggerType)type argument:(id)argument {
+    NSArray<NSString *> *path = [self matchKeyPathForType:type];
+    if (!path) {
+        return nil;
+    }
+
+    id value = argument;
+    for (NSString *component in path) {
+        value = [value isKindOfClass:[NSDictionary class]] ? value[component] : nil;
+    }
+
+    return [value isKindOfClass:[NSString class]] ? [value lowercaseString] : nil;
+}
+
+#pragma mark -
+#pragma mark Helpers
+
+/**
+ * The path of the event argument value that identifies the event for a trigger type. Custom
+ * events are identified by their name, region events by their region ID and screen events are
+ * the screen name itself.
+ *
+ * @param type The trigger type.
+ * @return The path, or nil if the trigger type is not indexed by value.
+ */
++ (nullable NSArray<NSString *> *)matchKeyPathForType:(UAScheduleTriggerType)type {
+    switch (type) {
+        case UAScheduleTriggerCustomEventCount:
+        case UAScheduleTriggerCustomEventValue:
+            return @[UACustomEventNameKey];
+        case UAScheduleTriggerRegionEnter:
+        case UAScheduleTriggerRegionExit:
+            return @[UARegionIDKey];
+        case UAScheduleTriggerScreen:
+            return @[];
+        default:
+            return nil;
+    }
+}
+
++ (void)addNames:(NSSet<NSString *> *)names
+            type:(UAScheduleTriggerType)type
+       toBuckets:(NSMutableDictionary<NSNumber *, NSMutableSet<NSString *> *> *)buckets {
+    NSMutableSet *bucket = buckets[@(type)];
+    if (!bucket) {
+        bucket = [NSMutableSet set];
+        buckets[@(type)] = bucket;
+    }
+
+    [bucket unionSet:names];
+}
+
+/**
+ * Extracts the values a predicate requires at a path of the event argument. Values are
+ * lowercased so case insensitive matchers are covered.
+ *
+ * @param json The predicate JSON.
+ * @param path The argument path, the matcher's scope followed by its key.
+ * @return The set of values, or nil if the predicate may match any value.
+ */
++ (nullable NSSet<NSString *> *)matchKeysFromJSON:(id)json path:(NSArray<NSString *> *)path {
+    if (![json isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+
+    NSArray *andPredicates = json[@"and"];
+    if ([andPredicates isKindOfClass:[NSArray class]]) {
+        // Any subpredicate that pins the name restricts the whole predicate
+        for (id subpredicate in andPredicates) {
+            NSSet *names = [self matchKeysFromJSON:subpredicate path:path];
+            if (names) {
+                return names;
+            }
+        }
+        return nil;
+    }
+
+    NSArray *orPredicates = json[@"or"];
+    if ([orPredicates isKindOfClass:[NSArray class]]) {
+        // Every subpredicate needs to pin the name
+        NSMutableSet *names = [NSMutableSet set];
+        for (id subpredicate in orPredicates) {
+            NSSet *subpredicateNames = [self matchKeysFromJSON:subpredicate path:path];
+            if (!subpredicateNames) {
+                return nil;
+            }
+            [names unionSet:subpredicateNames];
+        }
+        return names.count ? names : nil;
+    }
+
+    id scope = json[UAScheduleTriggerIndexScopeKey];
+    id key = json[UAScheduleTriggerIndexKeyKey];
+    if ((scope && ![scope isKindOfClass:[NSArray class]]) || (key && ![key isKindOfClass:[NSString class]])) {
+        return nil;
+    }
+
+    NSMutableArray *matcherPath = [NSMutableArray arrayWithArray:scope ?: @[]];
+    if (key) {
+        [matcherPath addObject:key];
+    }
+
+    if (![matcherPath isEqualToArray:path]) {
+        return nil;
+    }
+
+    id value = json[UAScheduleTriggerIndexValueKey];
+    id name = [value isKindOfClass:[NSDictionary class]] ? value[UAScheduleTriggerIndexEqualsKey] : nil;
+    if (![name isKindOfClass:[NSString class]]) {
+        return nil;
+    }
+
+    return [NSSet setWithObject:[name lowercaseString]];
+}
+
+@end
@@ -65,6 +65,16 @@ typedef NS_ENUM(NSInteger, UATagSelectorErrorCode) {
  */
 - (BOOL)apply:(NSArray<NSString *> *)tags tagGroups:(nullable UATagGroups *)tagGroups;
 
+/**
+ * Applies the tag selector to a set of tags. Prefer this over `apply:tagGroups:` when
+ * the tags are already a set, each tag check is then a hash lookup.
+ *
+ * @param tags The set of tags.
+ * @param tagGroups The tag groups.
+ * @return YES if the tag selector matches the tags, otherwise NO.
+ */
+- (BOOL)applyToTagSet:(NSSet<NSString *> *)tags tagGroups:(nullable UATagGroups *)tagGroups;
+
 /**
  * Indicates whether the tag selector contains tag groups.
  *
@@ -209,21 +209,25 @@ NSString * const UATagSelectorErrorDomain = @"com.urbanairship.in_app_message_ta
 }
 
 - (BOOL)apply:(NSArray<NSString *> *)tags tagGroups:(UATagGroups *)tagGroups  {
+    return [self applyToTagSet:[NSSet setWithArray:tags] tagGroups:tagGroups];
+}
+
+- (BOOL)applyToTagSet:(NSSet<NSString *> *)tags tagGroups:(UATagGroups *)tagGroups {
     switch (self.type) {
         case UATagSelectorTypeTag:
             if (self.group) {
-                NSSet *groupTags = tagGroups.tags[self.group];
+                id groupTags = tagGroups.tags[self.group];
                 return [groupTags containsObject:self.tag];
             }
 
             return [tags containsObject:self.tag];
             
         case UATagSelectorTypeNOT:
-            return ![self.selectors[0] apply:tags tagGroups:tagGroups];
+            return ![self.selectors[0] applyToTagSet:tags tagGroups:tagGroups];
             
         case UATagSelectorTypeAND:
             for (UATagSelector *selector in self.selectors) {
-                if (![selector apply:tags tagGroups:tagGroups]) {
+                if (![selector applyToTagSet:tags tagGroups:tagGroups]) {
                     return NO;
                 }
             }
@@ -231,7 +235,7 @@ NSString * const UATagSelectorErrorDomain = @"com.urbanairship.in_app_message_ta
             
         case UATagSelectorTypeOR:
             for (UATagSelector *selector in self.selectors) {
-                if ([selector apply:tags tagGroups:tagGroups]) {
+                if ([selector applyToTagSet:tags tagGroups:tagGroups]) {
                     return YES;
                 }
             }
@@ -0,0 +1,72 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+#if !TARGET_OS_TV
+#import "UAAirshipAutomationCoreImport.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A small pool of pre-warmed web views.
+ *
+ * Creating a web view spins up its content process, which is a noticeable delay
+ * right before a message is shown. The pool creates web views ahead of time, with the same
+ * configuration as any other `UAWebView`. Must be used on the main queue.
+ */
+@interface UAWebViewPool : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Web View Pool Factories
+///---------------------------------------------------------------------------------------
+
+/**
+ * Gets the shared instance.
+ * @return the shared instance.
+ */
++ (instancetype)shared;
+
+///---------------------------------------------------------------------------------------
+/// @name Web View Pool Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Checks out a web view. A pre-warmed web view is returned if available, otherwise a new one
+ * is created. The pool is refilled asynchronously.
+ *
+ * @return A web view.
+ */
+- (UAWebView *)checkOutWebView;
+
+/**
+ * Returns a web view to the pool. The web view is reset and removed from its superview.
+ * If the pool is full the web view is released.
+ *
+ * @param webView The web view.
+ */
+- (void)checkInWebView:(UAWebView *)webView;
+
+/**
+ * Fills the pool if it has no spare web views.
+ */
+- (void)prewarm;
+
+/**
+ * Loads a page in a spare web view so its resources are in the shared web view cache before
+ * the page is shown. The web view is returned to the pool once the page loads, fails or times out.
+ * Only one page is preloaded at a time, and pages whose main document is larger than the
+ * content length limit are cancelled.
+ *
+ * @param url The page URL.
+ * @param maxContentLength The maximum expected content length of the main document, in bytes.
+ * @param completionHandler The completion handler. Called with `YES` if the page loaded.
+ */
+- (void)preloadURL:(NSURL *)url
+  maxContentLength:(NSUInteger)maxContentLength
+ completionHandler:(void (^)(BOOL loaded))completionHandler;
+
+@end
+
+NS_ASSUME_NONNULL_END
+
+#endif
@@ -0,0 +1,201 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+#if !TARGET_OS_TV
+
+#import "UAWebViewPool+Internal.h"
+
+// Max number of idle web views kept by the pool
+static NSUInteger const UAWebViewPoolMaxSize = 2;
+
+// Estimated in-process size of an idle web view
+static NSUInteger const UAWebViewPoolEstimatedWebViewSize = 1024 * 1024;
+
+// Time a preload is given before it is cancelled
+static NSTimeInterval const UAWebViewPoolPreloadTimeout = 30;
+
+/**
+ * Navigation delegate for a single page preload.
+ */
+@interface UAWebViewPreload : NSObject <WKNavigationDelegate>
+@property (nonatomic, strong) UAWebView *webView;
+@property (nonatomic, assign) NSUInteger maxContentLength;
+@property (nonatomic, copy, nullable) void (^completionHandler)(BOOL);
+@property (nonatomic, strong, nullable) UADisposable *timeout;
+@end
+
+@implementation UAWebViewPreload
+
+- (void)finish:(BOOL)loaded {
+    void (^completionHandler)(BOOL) = self.completionHandler;
+    if (!completionHandler) {
+        return;
+    }
+
+    self.completionHandler = nil;
+    [self.timeout dispose];
+    self.timeout = nil;
+    completionHandler(loaded);
+}
+
+- (void)webView:(WKWebView *)webView decidePolicyForNavigationResponse:(WKNavigationResponse *)navigationResponse
+                                                      decisionHandler:(void (^)(WKNavigationResponsePolicy))decisionHandler {
+    long long expectedLength = navigationResponse.response.expectedContentLength;
+    if (navigationResponse.isForMainFrame && expectedLength > (long long)self.maxContentLength) {
+        UA_LDEBUG(@"Skipping preload of %@, content length %lld is over the limit", navigationResponse.response.URL, expectedLength);
+        decisionHandler(WKNavigationResponsePolicyCancel);
+        [self finish:NO];
+        return;
+    }
+
+    decisionHandler(WKNavigationResponsePolicyAllow);
+}
+
+- (void)webView:(WKWebView *)webView didFinishNavigation:(null_unspecified WKNavigation *)navigation {
+    [self finish:YES];
+}
+
+- (void)webView:(WKWebView *)webView didFailProvisionalNavigation:(null_unspecified WKNavigation *)navigation withError:(NSError *)error {
+    [self finish:NO];
+}
+
+- (void)webView:(WKWebView *)webView didFailNavigation:(null_unspecified WKNavigation *)navigation withError:(NSError *)error {
+    [self finish:NO];
+}
+
+@end
+
+@interface UAWebViewPool()
+@property (nonatomic, strong) NSMutableArray<UAWebView *> *webViews;
+@property (nonatomic, assign) BOOL prewarmScheduled;
+@property (nonatomic, strong, nullable) UAWebViewPreload *preload;
+@end
+
+@implementation UAWebViewPool
+
++ (instancetype)shared {
+    static dispatch_once_t onceToken;
+    static UAWebViewPool *shared;
+    dispatch_once(&onceToken, ^{
+        shared = [[self alloc] init];
+    });
+    return shared;
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        self.webViews = [NSMutableArray array];
+
+        UA_WEAKIFY(self)
+        [[UAMemoryPressureCoordinator shared] registerHandlerWithName:@"com.urbanairship.web_view_pool"
+                                                             priority:UAMemoryPressurePriorityNormal
+                                                              handler:^NSUInteger(UAMemoryPressureLevel level) {
+            UA_STRONGIFY(self)
+            NSUInteger count = self.webViews.count;
+            [self.webViews removeAllObjects];
+            return count * UAWebViewPoolEstimatedWebViewSize;
+        }];
+    }
+    return self;
+}
+
+- (UAWebView *)checkOutWebView {
+    UAWebView *webView = self.webViews.lastObject;
+    if (webView) {
+        [self.webViews removeLastObject];
+    } else {
+        UA_LTRACE(@"Web view pool is empty, creating a web view");
+        webView = [self createWebView];
+    }
+
+    [self schedulePrewarm];
+    return webView;
+}
+
+- (void)checkInWebView:(UAWebView *)webView {
+    [webView stopLoading];
+    webView.navigationDelegate = nil;
+    webView.UIDelegate = nil;
+    [webView removeFromSuperview];
+
+    if (self.webViews.count >= UAWebViewPoolMaxSize || [self.webViews containsObject:webView]) {
+        return;
+    }
+
+    // Drop the previous page so its scripts and media stop running
+    [webView loadHTMLString:@"" baseURL:nil];
+    [webView.scrollView setZoomScale:0 animated:NO];
+    [webView.scrollView setScrollEnabled:YES];
+    webView.backgroundColor = nil;
+    webView.scrollView.backgroundColor = nil;
+    [self.webViews addObject:webView];
+}
+
+- (void)prewarm {
+    if (!self.webViews.count) {
+        [self.webViews addObject:[self createWebView]];
+    }
+}
+
+- (void)preloadURL:(NSURL *)url
+  maxContentLength:(NSUInteger)maxContentLength
+ completionHandler:(void (^)(BOOL))completionHandler {
+    if (self.preload) {
+        UA_LTRACE(@"Preload already in progress, skipping %@", url);
+        completionHandler(NO);
+        return;
+    }
+
+    // Use a new web view so a prewarmed one is still available if the page is opened mid-load
+    UAWebViewPreload *preload = [[UAWebViewPreload alloc] init];
+    preload.webView = [self createWebView];
+    preload.maxContentLength = maxContentLength;
+    preload.webView.navigationDelegate = preload;
+
+    UA_WEAKIFY(self)
+    preload.completionHandler = ^(BOOL loaded) {
+        UA_STRONGIFY(self)
+        UA_LTRACE(@"Preload of %@ finished, loaded: %d", url, loaded);
+        UAWebView *webView = self.preload.webView;
+        self.preload = nil;
+        [self checkInWebView:webView];
+        completionHandler(loaded);
+    };
+
+    UA_WEAKIFY(preload)
+    preload.timeout = [[UADispatcher mainDispatcher] dispatchAfter:UAWebViewPoolPreloadTimeout block:^{
+        UA_STRONGIFY(preload)
+        [preload finish:NO];
+    }];
+
+    self.preload = preload;
+    [preload.webView loadRequest:[NSURLRequest requestWithURL:url]];
+}
+
+- (void)schedulePrewarm {
+    if (self.prewarmScheduled) {
+        return;
+    }
+
+    self.prewarmScheduled = YES;
+
+    // Refill on the next run loop so checking out never waits on a second web view
+    UA_WEAKIFY(self)
+    [[UADispatcher mainDispatcher] dispatchAsync:^{
+        UA_STRONGIFY(self)
+        self.prewarmScheduled = NO;
+        [self prewarm];
+    }];
+}
+
+- (UAWebView *)createWebView {
+    UAWebView *webView = [[UAWebView alloc] initWithFrame:[[UIScreen mainScreen] bounds]];
+    webView.translatesAutoresizingMaskIntoConstraints = NO;
+    return webView;
+}
+
+@end
+
+#endif
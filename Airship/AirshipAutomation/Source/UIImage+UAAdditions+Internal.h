@@ -16,5 +16,17 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (UIImage *)fancyImageWithData:(NSData *)data;
 
+/**
+ * Image factory method that supports animated data and downsamples to a max size.
+ *
+ * The image is fully decoded before returning, so this is best called off the main queue.
+ *
+ * @param data The data.
+ * @param maxPixelSize The max width or height of the decoded image in pixels, or 0 to decode at full size.
+ * @return The animated image if it is a gif, otherwise the still frame will be loaded. `nil` if
+ * the data could not be decoded.
+ */
++ (nullable UIImage *)fancyImageWithData:(NSData *)data maxPixelSize:(CGFloat)maxPixelSize;
+
 NS_ASSUME_NONNULL_END
 @end
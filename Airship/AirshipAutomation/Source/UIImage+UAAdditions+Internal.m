@@ -5,6 +5,32 @@
 
 @implementation UIImage (UAAdditions)
 
++ (nullable UIImage *)imageAtIndex:(size_t)index source:(CGImageSourceRef)source maxPixelSize:(CGFloat)maxPixelSize {
+    NSMutableDictionary *options = [NSMutableDictionary dictionary];
+
+    // Decode now instead of when the image is first drawn
+    options[(NSString *)kCGImageSourceShouldCacheImmediately] = @YES;
+
+    CGImageRef imageRef;
+    if (maxPixelSize > 0) {
+        // Thumbnails are only ever scaled down, never up
+        options[(NSString *)kCGImageSourceCreateThumbnailFromImageAlways] = @YES;
+        options[(NSString *)kCGImageSourceCreateThumbnailWithTransform] = @YES;
+        options[(NSString *)kCGImageSourceThumbnailMaxPixelSize] = @(maxPixelSize);
+        imageRef = CGImageSourceCreateThumbnailAtIndex(source, index, (__bridge CFDictionaryRef)options);
+    } else {
+        imageRef = CGImageSourceCreateImageAtIndex(source, index, (__bridge CFDictionaryRef)options);
+    }
+
+    if (!imageRef) {
+        return nil;
+    }
+
+    UIImage *image = [UIImage imageWithCGImage:imageRef];
+    CGImageRelease(imageRef);
+    return image;
+}
+
 + (NSTimeInterval)durationFromProperties:(CFDictionaryRef)properties {
     NSTimeInterval duration = 0;
 
@@ -21,13 +47,13 @@
     return duration;
 }
 
-+ (UIImage *)animatedImageWithImageSource:(CGImageSourceRef)source {
++ (UIImage *)animatedImageWithImageSource:(CGImageSourceRef)source maxPixelSize:(CGFloat)maxPixelSize {
     NSMutableArray *images = [NSMutableArray array];
     NSTimeInterval fullDuration = 0;
 
     for (int i = 0; i < CGImageSourceGetCount(source); i++) {
-        CGImageRef imageRef = CGImageSourceCreateImageAtIndex(source, i, NULL);
-        if (!imageRef) {
+        UIImage *image = [self imageAtIndex:i source:source maxPixelSize:maxPixelSize];
+        if (!image) {
             continue;
         }
 
@@ -37,10 +63,7 @@
             CFRelease(properties);
         }
 
-        UIImage *image = [UIImage imageWithCGImage:imageRef];
-        CGImageRelease(imageRef);
-
-        if (image && duration) {
+        if (duration) {
             fullDuration += duration;
 
             // Fill in frames for every centisecond
@@ -55,18 +78,25 @@
 }
 
 + (UIImage *)fancyImageWithData:(NSData *)data {
+    return [self fancyImageWithData:data maxPixelSize:0];
+}
+
++ (nullable UIImage *)fancyImageWithData:(NSData *)data maxPixelSize:(CGFloat)maxPixelSize {
     CGImageSourceRef source = CGImageSourceCreateWithData((CFDataRef) data, NULL);
+    if (!source) {
+        return nil;
+    }
 
     UIImage *image;
-    if (source && CGImageSourceGetCount(source) > 1) {
-        image = [self animatedImageWithImageSource:source];
-    } else {
+    if (CGImageSourceGetCount(source) > 1) {
+        image = [self animatedImageWithImageSource:source maxPixelSize:maxPixelSize];
+    } else if (maxPixelSize <= 0) {
         image = [self imageWithData:data];
+    } else {
+        image = [self imageAtIndex:0 source:source maxPixelSize:maxPixelSize];
     }
 
-    if (source) {
-        CFRelease(source);
-    }
+    CFRelease(source);
 
     return image;
 }
@@ -3,71 +3,157 @@
 #import "NSManagedObjectContext+UAAdditions.h"
 #import "UAUtils+Internal.h"
 #import "UAGlobal.h"
+#import "UAStartupMetrics+Internal.h"
+#import "UAMetricsRegistry.h"
+
+#import <objc/runtime.h>
+
+static const void *UAManagedObjectContextModelURLKey = &UAManagedObjectContextModelURLKey;
+static const void *UAManagedObjectContextStoreLoaderKey = &UAManagedObjectContextStoreLoaderKey;
 
 @implementation NSManagedObjectContext (UAAdditions)
 
-NSString *const UAManagedContextStoreDirectory = @"com.urbanairship.no-backup";
++ (NSManagedObjectModel *)managedObjectModelForURL:(NSURL *)modelURL {
+    static NSMutableDictionary<NSURL *, NSManagedObjectModel *> *models;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        models = [NSMutableDictionary dictionary];
+    });
+
+    @synchronized (models) {
+        NSManagedObjectModel *model = models[modelURL];
+        if (!model) {
+            model = [[NSManagedObjectModel alloc] initWithContentsOfURL:modelURL];
+            if (model) {
+                models[modelURL] = model;
+            }
+        }
+
+        return model;
+    }
+}
 
 + (NSManagedObjectContext *)managedObjectContextForModelURL:(NSURL *)modelURL
                                            concurrencyType:(NSManagedObjectContextConcurrencyType)concurrencyType {
 
-    NSManagedObjectModel *mom = [[NSManagedObjectModel alloc] initWithContentsOfURL:modelURL];
+    NSManagedObjectModel *mom = [self managedObjectModelForURL:modelURL];
     NSPersistentStoreCoordinator *psc = [[NSPersistentStoreCoordinator alloc] initWithManagedObjectModel:mom];
     NSManagedObjectContext *moc = [[NSManagedObjectContext alloc] initWithConcurrencyType:concurrencyType];
     [moc setPersistentStoreCoordinator:psc];
     return moc;
 }
 
-- (void)addPersistentSqlStore:(NSString *)storeName
-            completionHandler:(nonnull void(^)(NSPersistentStore *, NSError *))completionHandler {
++ (NSManagedObjectContext *)lazyManagedObjectContextForModelURL:(NSURL *)modelURL
+                                                    storeLoader:(void (^)(NSManagedObjectContext *))storeLoader {
+    NSManagedObjectContext *moc = [[NSManagedObjectContext alloc] initWithConcurrencyType:NSPrivateQueueConcurrencyType];
+    objc_setAssociatedObject(moc, UAManagedObjectContextModelURLKey, modelURL, OBJC_ASSOCIATION_COPY);
+    objc_setAssociatedObject(moc, UAManagedObjectContextStoreLoaderKey, storeLoader, OBJC_ASSOCIATION_COPY);
+    return moc;
+}
 
-    [self performBlock:^{
+/**
+ * Sets up the coordinator and stores of a lazy context. Must be called on the context's queue.
+ */
+- (void)loadPersistentStoresIfNeeded {
+    void (^storeLoader)(NSManagedObjectContext *) = objc_getAssociatedObject(self, UAManagedObjectContextStoreLoaderKey);
+    if (!storeLoader) {
+        return;
+    }
 
+    if (!self.persistentStoreCoordinator) {
+        NSURL *modelURL = objc_getAssociatedObject(self, UAManagedObjectContextModelURLKey);
+        NSManagedObjectModel *mom = [NSManagedObjectContext managedObjectModelForURL:modelURL];
+        if (!mom) {
+            UA_LERR(@"Unable to load managed object model: %@", modelURL);
+            return;
+        }
 
-        NSFileManager *fileManager = [NSFileManager defaultManager];
-        NSURL *libraryDirectoryURL = [[fileManager URLsForDirectory:NSLibraryDirectory inDomains:NSUserDomainMask] lastObject];
-        NSURL *cachesDirectoryURL = [[fileManager URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask] lastObject];
-        NSURL *libraryStoreDirectoryURL = [libraryDirectoryURL URLByAppendingPathComponent:UAManagedContextStoreDirectory];
-        NSURL *cachesStoreDirectoryURL = [cachesDirectoryURL URLByAppendingPathComponent:UAManagedContextStoreDirectory];
+        self.persistentStoreCoordinator = [[NSPersistentStoreCoordinator alloc] initWithManagedObjectModel:mom];
+    }
 
-        NSURL *storeURL;
+    if (!self.persistentStoreCoordinator.persistentStores.count) {
+        storeLoader(self);
+    }
+}
 
-        // Create the store directory if it doesn't exist
-        if ([fileManager fileExistsAtPath:[libraryStoreDirectoryURL path]]) {
-            storeURL = [libraryStoreDirectoryURL URLByAppendingPathComponent:storeName];
-        } else if ([fileManager fileExistsAtPath:[cachesStoreDirectoryURL path]]) {
-            storeURL = [cachesStoreDirectoryURL URLByAppendingPathComponent:storeName];
-        } else {
-            NSError *error = nil;
-            if ([fileManager createDirectoryAtURL:libraryStoreDirectoryURL withIntermediateDirectories:YES attributes:nil error:&error]) {
-                storeURL = [libraryStoreDirectoryURL URLByAppendingPathComponent:storeName];
-                [UAUtils addSkipBackupAttributeToItemAtURL:libraryStoreDirectoryURL];
-            } else if ([fileManager createDirectoryAtURL:cachesStoreDirectoryURL withIntermediateDirectories:YES attributes:nil error:&error]) {
-                storeURL = [cachesStoreDirectoryURL URLByAppendingPathComponent:storeName];
-                [UAUtils addSkipBackupAttributeToItemAtURL:cachesStoreDirectoryURL];
-            } else {
-                completionHandler(nil, error);
-                return;
-            }
+- (nullable NSPersistentStore *)addPersistentSqlStore:(NSString *)storeName error:(NSError **)error {
+    return [self addPersistentSqlStore:storeName options:nil error:error];
+}
+
+- (nullable NSPersistentStore *)addPersistentSqlStore:(NSString *)storeName
+                                              options:(nullable NSDictionary *)additionalOptions
+                                                error:(NSError **)error {
+    NSURL *storeDirectoryURL = [UAUtils noBackupDirectoryURL:error];
+    if (!storeDirectoryURL) {
+        return nil;
+    }
+
+    NSURL *storeURL = [storeDirectoryURL URLByAppendingPathComponent:storeName];
+
+    for (NSPersistentStore *store in self.persistentStoreCoordinator.persistentStores) {
+        if ([store.URL isEqual:storeURL] && [store.type isEqualToString:NSSQLiteStoreType]) {
+            return store;
         }
+    }
 
-        for (NSPersistentStore *store in self.persistentStoreCoordinator.persistentStores) {
-            if ([store.URL isEqual:storeURL] && [store.type isEqualToString:NSSQLiteStoreType]) {
-                completionHandler(store, nil);
-                return;
-            }
+    NSMutableDictionary *options = [NSMutableDictionary dictionaryWithDictionary:additionalOptions ?: @{}];
+    options[NSMigratePersistentStoresAutomaticallyOption] = @YES;
+    options[NSInferMappingModelAutomaticallyOption] = @YES;
+
+    __block NSPersistentStore *store;
+    __block NSError *storeError;
+    NSString *name = [NSString stringWithFormat:@"Core Data Store %@", storeName];
+    [[UAStartupMetrics shared] measure:name block:^{
+        store = [self.persistentStoreCoordinator addPersistentStoreWithType:NSSQLiteStoreType
+                                                              configuration:nil
+                                                                        URL:storeURL
+                                                                    options:options
+                                                                      error:&storeError];
+    }];
+
+    if (!store && error) {
+        *error = storeError;
+    }
+
+    if (store) {
+        [NSManagedObjectContext registerStoreSizeMetricForStoreURL:storeURL];
+    }
+
+    return store;
+}
+
+/**
+ * Registers a gauge for the on-disk size of a SQLite store, including its journal files.
+ */
++ (void)registerStoreSizeMetricForStoreURL:(NSURL *)storeURL {
+    NSString *name = [UAMetricCoreDataStorePrefix stringByAppendingString:storeURL.lastPathComponent];
+    [[UAMetricsRegistry shared] registerGaugeForMetric:name block:^double{
+        unsigned long long bytes = 0;
+        for (NSString *suffix in @[@"", @"-wal", @"-shm"]) {
+            NSString *path = [storeURL.path stringByAppendingString:suffix];
+            bytes += [[NSFileManager defaultManager] attributesOfItemAtPath:path error:nil].fileSize;
         }
+        return bytes;
+    }];
+}
 
-        NSDictionary *options = @{ NSMigratePersistentStoresAutomaticallyOption : @YES,
-                                   NSInferMappingModelAutomaticallyOption : @YES };
-        NSError *error = nil;
+- (nullable NSPersistentStore *)addPersistentInMemoryStore:(NSString *)storeName error:(NSError **)error {
+    NSDictionary *options = @{ NSMigratePersistentStoresAutomaticallyOption : @YES,
+                               NSInferMappingModelAutomaticallyOption : @YES };
+
+    return [self.persistentStoreCoordinator addPersistentStoreWithType:NSInMemoryStoreType
+                                                         configuration:nil
+                                                                   URL:nil
+                                                               options:options
+                                                                 error:error];
+}
 
-        NSPersistentStore *result = [self.persistentStoreCoordinator addPersistentStoreWithType:NSSQLiteStoreType
-                                                                                  configuration:nil
-                                                                                            URL:storeURL
-                                                                                        options:options
-                                                                                          error:&error];
+- (void)addPersistentSqlStore:(NSString *)storeName
+            completionHandler:(nonnull void(^)(NSPersistentStore *, NSError *))completionHandler {
 
+    [self performBlock:^{
+        NSError *error = nil;
+        NSPersistentStore *result = [self addPersistentSqlStore:storeName error:&error];
         completionHandler(result, error);
     }];
 }
@@ -75,20 +161,15 @@ NSString *const UAManagedContextStoreDirectory = @"com.urbanairship.no-backup";
 - (void)addPersistentInMemoryStore:(NSString *)storeName
                  completionHandler:(nonnull void(^)(NSPersistentStore *, NSError *))completionHandler {
 
-    NSDictionary *options = @{ NSMigratePersistentStoresAutomaticallyOption : @YES,
-                               NSInferMappingModelAutomaticallyOption : @YES };
     NSError *error = nil;
-    NSPersistentStore *result = [self.persistentStoreCoordinator addPersistentStoreWithType:NSInMemoryStoreType
-                                                                              configuration:nil
-                                                                                        URL:nil
-                                                                                    options:options
-                                                                                      error:&error];
-
+    NSPersistentStore *result = [self addPersistentInMemoryStore:storeName error:&error];
     completionHandler(result, error);
 }
 
 - (void)safePerformBlock:(void (^)(BOOL))block {
     [self performBlock:^{
+        [self loadPersistentStoresIfNeeded];
+
         if (self.persistentStoreCoordinator.persistentStores.count) {
             block(YES);
         } else {
@@ -3,9 +3,34 @@
 #import "NSString+UALocalizationAdditions.h"
 #import "UAirship.h"
 #import "UAirshipCoreResources.h"
+#import "UALocaleManager+Internal.h"
 
 @implementation NSString (UALocalizationAdditions)
 
+/**
+ * Resolved strings keyed by table, module bundle and fallback locale. Missing strings are stored as NSNull.
+ * The tables are dropped whenever the device or SDK locale changes.
+ */
++ (NSMutableDictionary<NSString *, NSMutableDictionary<NSString *, id> *> *)localizedStringTables {
+    static NSMutableDictionary *tables;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        tables = [NSMutableDictionary dictionary];
+
+        void (^clear)(NSNotification *) = ^(NSNotification *notification) {
+            @synchronized (tables) {
+                [tables removeAllObjects];
+            }
+        };
+
+        NSNotificationCenter *notificationCenter = [NSNotificationCenter defaultCenter];
+        [notificationCenter addObserverForName:NSCurrentLocaleDidChangeNotification object:nil queue:nil usingBlock:clear];
+        [notificationCenter addObserverForName:UALocaleUpdatedEvent object:nil queue:nil usingBlock:clear];
+    });
+
+    return tables;
+}
+
 - (nullable NSString *)sanitizedLocalizedStringWithTable:(NSString *)table
                                            primaryBundle:(NSBundle *)primaryBundle
                                          secondaryBundle:(NSBundle *)secondaryBundle
@@ -35,7 +60,35 @@
 }
 
 - (NSString *)localizedStringWithTable:(NSString *)table moduleBundle:(NSBundle *)moduleBundle defaultValue:(NSString *)defaultValue fallbackLocale:(NSString *)fallbackLocale {
+    NSMutableDictionary *tables = [NSString localizedStringTables];
+    NSString *tableKey = [NSString stringWithFormat:@"%@|%@|%@", table, moduleBundle.bundlePath, fallbackLocale];
+
+    id cached;
+    @synchronized (tables) {
+        cached = tables[tableKey][self];
+    }
+
+    if (cached) {
+        return cached == [NSNull null] ? defaultValue : cached;
+    }
+
+    NSString *string = [self resolveLocalizedStringWithTable:table moduleBundle:moduleBundle fallbackLocale:fallbackLocale];
+
+    @synchronized (tables) {
+        NSMutableDictionary *strings = tables[tableKey];
+        if (!strings) {
+            strings = [NSMutableDictionary dictionary];
+            tables[tableKey] = strings;
+        }
+        strings[self] = string ?: [NSNull null];
+    }
 
+    // If the bundle wasn't loaded correctly, it's possible the result value could be nil.
+    // Convert to the key as a last resort in this case.
+    return string ?: defaultValue;
+}
+
+- (nullable NSString *)resolveLocalizedStringWithTable:(NSString *)table moduleBundle:(NSBundle *)moduleBundle fallbackLocale:(NSString *)fallbackLocale {
     NSBundle *mainBundle = [NSBundle mainBundle];
     NSBundle *coreBundle = [UAirshipCoreResources bundle];
 
@@ -58,9 +111,7 @@
         }
     }
 
-    // If the bundle wasn't loaded correctly, it's possible the result value could be nil.
-    // Convert to the key as a last resort in this case.
-    return string ?: defaultValue;
+    return string;
 }
 
 - (NSString *)localizedStringWithTable:(NSString *)table moduleBundle:(NSBundle *)moduleBundle defaultValue:(NSString *)defaultValue {
@@ -4,6 +4,7 @@
 #import "UARequestSession.h"
 #import "UARuntimeConfig.h"
 #import "UAirship.h"
+#import "UAUtils.h"
 
 NSUInteger const UAAPIClientStatusUnavailable = 0;
 NSString * const UAAPIClientErrorDomain = @"com.urbanairship.api_client";
@@ -11,6 +12,7 @@ NSString * const UAAPIClientErrorDomain = @"com.urbanairship.api_client";
 @interface UAAPIClient()
 @property (nonatomic, strong) UARuntimeConfig *config;
 @property (nonatomic, strong) UARequestSession *session;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSMutableArray<UARequestCompletionHandler> *> *inFlightRequests;
 @end
 
 @implementation UAAPIClient
@@ -22,12 +24,57 @@ NSString * const UAAPIClientErrorDomain = @"com.urbanairship.api_client";
         self.config = config;
         self.session = session;
         self.enabled = YES;
+        self.inFlightRequests = [NSMutableDictionary dictionary];
     }
 
     return self;
 }
 
+- (void)dataTaskWithRequest:(UARequest *)request
+                 requestKey:(NSString *)requestKey
+                 retryWhere:(UARequestRetryBlock)retryBlock
+          completionHandler:(UARequestCompletionHandler)completionHandler {
+
+    if (!requestKey) {
+        [self.session dataTaskWithRequest:request retryWhere:retryBlock completionHandler:completionHandler];
+        return;
+    }
+
+    @synchronized (self.inFlightRequests) {
+        NSMutableArray *handlers = self.inFlightRequests[requestKey];
+        if (handlers) {
+            UA_LTRACE(@"Attaching to in-flight request %@", requestKey);
+            [handlers addObject:completionHandler];
+            return;
+        }
+
+        self.inFlightRequests[requestKey] = [NSMutableArray arrayWithObject:completionHandler];
+    }
+
+    [self.session dataTaskWithRequest:request retryWhere:retryBlock completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+        NSArray<UARequestCompletionHandler> *handlers;
+        @synchronized (self.inFlightRequests) {
+            handlers = self.inFlightRequests[requestKey];
+            [self.inFlightRequests removeObjectForKey:requestKey];
+        }
+
+        for (UARequestCompletionHandler handler in handlers) {
+            handler(data, response, error);
+        }
+    }];
+}
+
++ (NSString *)requestKeyForRequest:(UARequest *)request {
+    NSString *body = [request.body base64EncodedStringWithOptions:0] ?: @"";
+    return [NSString stringWithFormat:@"%@ %@ %@", request.method, request.URL.absoluteString, [UAUtils sha256HashWithString:body]];
+}
+
 - (void)cancelAllRequests {
+    // Cancelled requests never complete, so new requests must not attach to them
+    @synchronized (self.inFlightRequests) {
+        [self.inFlightRequests removeAllObjects];
+    }
+
     [self.session cancelAllRequests];
 }
 
@@ -3,9 +3,62 @@
 #import "UAAPNSRegistration+Internal.h"
 #import "UANotificationCategory.h"
 
+// How long fetched notification settings are reused before asking the notification center again
+static NSTimeInterval const UANotificationSettingsCacheTime = 1;
+
+typedef void (^UAAuthorizedSettingsCompletionHandler)(UAAuthorizedNotificationSettings, UAAuthorizationStatus);
+
+@interface UAAPNSRegistration()
+@property (nonatomic, copy, nullable) NSSet<UNNotificationCategory *> *registeredCategories;
+@property (nonatomic, strong, nullable) NSMutableArray<UAAuthorizedSettingsCompletionHandler> *pendingSettingsHandlers;
+@property (nonatomic, strong, nullable) NSDate *settingsFetchDate;
+@property (nonatomic, assign) UAAuthorizedNotificationSettings cachedAuthorizedSettings;
+@property (nonatomic, assign) UAAuthorizationStatus cachedAuthorizationStatus;
+@end
+
 @implementation UAAPNSRegistration
 
 -(void)getAuthorizedSettingsWithCompletionHandler:(void (^)(UAAuthorizedNotificationSettings, UAAuthorizationStatus))completionHandler {
+    BOOL cached = NO;
+    UAAuthorizedNotificationSettings authorizedSettings;
+    UAAuthorizationStatus status;
+
+    @synchronized (self) {
+        if (self.settingsFetchDate && -[self.settingsFetchDate timeIntervalSinceNow] < UANotificationSettingsCacheTime) {
+            cached = YES;
+            authorizedSettings = self.cachedAuthorizedSettings;
+            status = self.cachedAuthorizationStatus;
+        } else if (self.pendingSettingsHandlers) {
+            // Join the request already in flight
+            [self.pendingSettingsHandlers addObject:completionHandler];
+            return;
+        } else {
+            self.pendingSettingsHandlers = [NSMutableArray arrayWithObject:completionHandler];
+        }
+    }
+
+    if (cached) {
+        completionHandler(authorizedSettings, status);
+        return;
+    }
+
+    [self fetchAuthorizedSettingsWithCompletionHandler:^(UAAuthorizedNotificationSettings authorizedSettings, UAAuthorizationStatus status) {
+        NSArray<UAAuthorizedSettingsCompletionHandler> *handlers;
+        @synchronized (self) {
+            handlers = self.pendingSettingsHandlers;
+            self.pendingSettingsHandlers = nil;
+        }
+
+        for (UAAuthorizedSettingsCompletionHandler handler in handlers) {
+            handler(authorizedSettings, status);
+        }
+    }];
+}
+
+/**
+ * Always queries the notification center, and caches the result for later settings requests.
+ */
+- (void)fetchAuthorizedSettingsWithCompletionHandler:(UAAuthorizedSettingsCompletionHandler)completionHandler {
     [[UNUserNotificationCenter currentNotificationCenter] getNotificationSettingsWithCompletionHandler:^(UNNotificationSettings * _Nonnull notificationSettings) {
 
         UAAuthorizationStatus authorizationStatus = [self uaStatus:notificationSettings.authorizationStatus];
@@ -49,6 +102,12 @@
         }
 #endif
 
+        @synchronized (self) {
+            self.cachedAuthorizedSettings = authorizedSettings;
+            self.cachedAuthorizationStatus = authorizationStatus;
+            self.settingsFetchDate = [NSDate date];
+        }
+
         completionHandler(authorizedSettings, authorizationStatus);
     }];
 }
@@ -142,7 +201,15 @@
         }
     }
 
-    [[UNUserNotificationCenter currentNotificationCenter] setNotificationCategories:[NSSet setWithSet:normalizedCategories]];
+    NSSet *categorySet = [NSSet setWithSet:normalizedCategories];
+
+    // Setting categories is a round trip to the notification daemon, so skip it when nothing changed
+    @synchronized (self) {
+        if (![self.registeredCategories isEqualToSet:categorySet]) {
+            [[UNUserNotificationCenter currentNotificationCenter] setNotificationCategories:categorySet];
+            self.registeredCategories = categorySet;
+        }
+    }
 #endif
 
     UNAuthorizationOptions normalizedOptions = [self normalizedOptions:options];
@@ -155,7 +222,8 @@
             UA_LERR(@"requestAuthorizationWithOptions failed with error: %@", error);
         }
 
-        [self getAuthorizedSettingsWithCompletionHandler:^(UAAuthorizedNotificationSettings authorizedSettings, UAAuthorizationStatus status) {
+        // The request may have changed the settings, so skip the cache
+        [self fetchAuthorizedSettingsWithCompletionHandler:^(UAAuthorizedNotificationSettings authorizedSettings, UAAuthorizationStatus status) {
             if (completionHandler) {
                 completionHandler(granted, authorizedSettings, status);
             }
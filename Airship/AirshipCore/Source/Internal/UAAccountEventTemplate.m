@@ -54,13 +54,13 @@
 - (UACustomEvent *)createEvent {
     UACustomEvent *event = [UACustomEvent eventWithName:self.eventName];
 
-    NSMutableDictionary *propertyDictionary = [NSMutableDictionary dictionary];
+    UACustomEventPropertiesBuilder *properties = [[UACustomEventPropertiesBuilder alloc] init];
     
     if (self.eventValue) {
         [event setEventValue:self.eventValue];
-        [propertyDictionary setValue:@YES forKey:kUAAccountEventTemplateLifetimeValue];
+        [properties setBool:YES forKey:kUAAccountEventTemplateLifetimeValue];
     } else {
-        [propertyDictionary setValue:@NO forKey:kUAAccountEventTemplateLifetimeValue];
+        [properties setBool:NO forKey:kUAAccountEventTemplateLifetimeValue];
     }
 
     if (self.transactionID) {
@@ -68,12 +68,12 @@
     }
 
     if (self.category) {
-        [propertyDictionary setValue:self.category forKey:kUAAccountEventTemplateCategory];
+        [properties setString:self.category forKey:kUAAccountEventTemplateCategory];
     }
 
     event.templateType = kUAAccountEventTemplate;
     
-    event.properties = propertyDictionary;
+    [event setPropertiesWithBuilder:properties];
 
     return event;
 }
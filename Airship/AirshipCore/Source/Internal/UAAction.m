@@ -21,17 +21,30 @@
 
 #pragma mark internal methods
 
++ (UADispatcher *)backgroundDispatcher {
+    static UADispatcher *dispatcher;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        dispatcher = [UADispatcher serialDispatcher:QOS_CLASS_USER_INITIATED];
+    });
+
+    return dispatcher;
+}
+
 - (void)runWithArguments:(UAActionArguments *)arguments
        completionHandler:(UAActionCompletionHandler)completionHandler {
 
     // If no completion handler was passed, use an empty block in its place
     completionHandler = completionHandler ?: ^(UAActionResult *result) {};
     
-    // Make sure the initial acceptsArguments/willPerform/perform is executed on the main queue
-    [[UADispatcher mainDispatcher] dispatchAsyncIfNecessary:^{
+    // Make sure the initial acceptsArguments/willPerform/perform is executed on the queue the action expects
+    UADispatcher *dispatcher = self.threadAffinity == UAActionThreadAffinityBackground ? [UAAction backgroundDispatcher] : [UADispatcher mainDispatcher];
+    [dispatcher dispatchAsyncIfNecessary:^{
         if (![self acceptsArguments:arguments]) {
             UA_LDEBUG(@"Action %@ rejected arguments %@.", [self description], [arguments description]);
-            completionHandler([UAActionResult rejectedArgumentsResult]);
+            [[UADispatcher mainDispatcher] dispatchAsyncIfNecessary:^{
+                completionHandler([UAActionResult rejectedArgumentsResult]);
+            }];
         } else {
             UA_LDEBUG(@"Action %@ performing with arguments %@.", [self description], [arguments description]);
             [self willPerformWithArguments:arguments];
@@ -78,6 +91,10 @@
     //override
 }
 
+- (UAActionThreadAffinity)threadAffinity {
+    return UAActionThreadAffinityMain;
+}
+
 #pragma mark factory methods
 
 + (instancetype)actionWithBlock:(UAActionBlock)actionBlock {
@@ -14,9 +14,9 @@ NS_ASSUME_NONNULL_BEGIN
 ///---------------------------------------------------------------------------------------
 
 /**
- * Map of names to action entries
+ * Immutable snapshot of names to action entries. Replaced whenever names are registered or removed.
  */
-@property (nonatomic, strong) NSMutableDictionary *registeredActionEntries;
+@property (atomic, copy) NSDictionary<NSString *, UAActionRegistryEntry *> *registeredActionEntries;
 
 /**
  * Registers default actions.
@@ -16,7 +16,7 @@ NSString *const UAActionRegistryPredicateClassKey = @"predicate";
 - (instancetype)init {
     self = [super init];
     if (self) {
-        self.registeredActionEntries = [[NSMutableDictionary alloc] init];
+        self.registeredActionEntries = @{};
     }
     return self;
 }
@@ -107,11 +107,13 @@ NSString *const UAActionRegistryPredicateClassKey = @"predicate";
         return NO;
     }
 
-    for (NSString *name in names) {
-        [self removeName:name];
-        [entry.mutableNames addObject:name];
-        [self.registeredActionEntries setValue:entry forKey:name];
-    }
+    [self updateEntries:^(NSMutableDictionary *entries) {
+        for (NSString *name in names) {
+            [self removeName:name entries:entries];
+            [entry.mutableNames addObject:name];
+            entries[name] = entry;
+        }
+    }];
 
     return YES;
 }
@@ -121,11 +123,9 @@ NSString *const UAActionRegistryPredicateClassKey = @"predicate";
         return YES;
     }
 
-    UAActionRegistryEntry *entry = [self registryEntryWithName:name];
-    if (entry) {
-        [entry.mutableNames removeObject:name];
-        [self.registeredActionEntries removeObjectForKey:name];
-    }
+    [self updateEntries:^(NSMutableDictionary *entries) {
+        [self removeName:name entries:entries];
+    }];
 
     return YES;
 }
@@ -135,11 +135,12 @@ NSString *const UAActionRegistryPredicateClassKey = @"predicate";
         return YES;
     }
 
-    UAActionRegistryEntry *entry = [self registryEntryWithName:name];
-
-    for (NSString *entryName in entry.mutableNames) {
-        [self.registeredActionEntries removeObjectForKey:entryName];
-    }
+    [self updateEntries:^(NSMutableDictionary *entries) {
+        UAActionRegistryEntry *entry = entries[name];
+        for (NSString *entryName in entry.mutableNames) {
+            [entries removeObjectForKey:entryName];
+        }
+    }];
 
     return YES;
 }
@@ -150,16 +151,45 @@ NSString *const UAActionRegistryPredicateClassKey = @"predicate";
         return NO;
     }
 
-    UAActionRegistryEntry *entry = [self registryEntryWithName:entryName];
+    if (!entryName) {
+        return NO;
+    }
 
-    if (entry && name) {
-        [self removeName:name];
-        [entry.mutableNames addObject:name];
-        [self.registeredActionEntries setValue:entry forKey:name];
-        return YES;
+    __block BOOL added = NO;
+    [self updateEntries:^(NSMutableDictionary *entries) {
+        UAActionRegistryEntry *entry = entries[entryName];
+        if (entry) {
+            [self removeName:name entries:entries];
+            [entry.mutableNames addObject:name];
+            entries[name] = entry;
+            added = YES;
+        }
+    }];
+
+    return added;
+}
+
+/**
+ * Removes a name from the entries and from its entry's names. Must be called from an update block.
+ */
+- (void)removeName:(NSString *)name entries:(NSMutableDictionary *)entries {
+    UAActionRegistryEntry *entry = entries[name];
+    if (entry) {
+        [entry.mutableNames removeObject:name];
+        [entries removeObjectForKey:name];
     }
+}
 
-    return NO;
+/**
+ * Applies changes to a copy of the entries and publishes it as the new snapshot. Lookups
+ * read the snapshot without taking the lock.
+ */
+- (void)updateEntries:(void (^)(NSMutableDictionary *))block {
+    @synchronized (self) {
+        NSMutableDictionary *entries = [self.registeredActionEntries mutableCopy];
+        block(entries);
+        self.registeredActionEntries = entries;
+    }
 }
 
 - (UAActionRegistryEntry *)registryEntryWithName:(NSString *)name {
@@ -167,12 +197,22 @@ NSString *const UAActionRegistryPredicateClassKey = @"predicate";
         return nil;
     }
 
-    return [self.registeredActionEntries valueForKey:name];
+    return self.registeredActionEntries[name];
+}
+
+- (BOOL)isBackgroundSafeForActionNames:(NSArray<NSString *> *)names situation:(UASituation)situation {
+    for (NSString *name in names) {
+        UAActionRegistryEntry *entry = [self registryEntryWithName:name];
+        if (entry && [entry threadAffinityForSituation:situation] == UAActionThreadAffinityMain) {
+            return NO;
+        }
+    }
+
+    return YES;
 }
 
 - (NSSet *)registeredEntries {
-    NSMutableDictionary *entries = [NSMutableDictionary dictionaryWithDictionary:self.registeredActionEntries];
-    return [NSSet setWithArray:[entries allValues]];
+    return [NSSet setWithArray:[self.registeredActionEntries allValues]];
 }
 
 - (BOOL)addSituationOverride:(UASituation)situation
@@ -35,17 +35,24 @@
 
 - (UAAction *)action
 {
-    if (_action == nil)
-    {
-        _action = [[self.actionClass alloc] init];
+    // Entries are read off the main queue when actions run in the background
+    @synchronized (self) {
+        if (_action == nil)
+        {
+            _action = [[self.actionClass alloc] init];
+        }
+        return _action;
     }
-    return _action;
 }
 
 - (UAAction *)actionForSituation:(UASituation)situation {
     return [self.situationOverrides objectForKey:[NSNumber numberWithInteger:situation]] ?: self.action;
 }
 
+- (UAActionThreadAffinity)threadAffinityForSituation:(UASituation)situation {
+    return [self actionForSituation:situation].threadAffinity;
+}
+
 - (void)addSituationOverride:(UASituation)situation withAction:(UAAction *)action {
     if (action) {
         [self.situationOverrides setObject:action forKey:@(situation)];
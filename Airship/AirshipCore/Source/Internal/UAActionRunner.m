@@ -105,6 +105,28 @@ completionHandler:(UAActionCompletionHandler)completionHandler {
     [action runWithArguments:arguments completionHandler:completionHandler];
 }
 
+/**
+ * Orders the entries so background actions are started before main queue actions. Main queue
+ * actions run inline when the runner is called on the main queue, so starting them first would
+ * delay the background actions until they finish.
+ */
++ (NSArray<UAActionRegistryEntry *> *)executionPlanForEntries:(NSSet<UAActionRegistryEntry *> *)entries
+                                                    situation:(UASituation)situation {
+    NSMutableArray<UAActionRegistryEntry *> *backgroundEntries = [NSMutableArray array];
+    NSMutableArray<UAActionRegistryEntry *> *mainEntries = [NSMutableArray array];
+
+    for (UAActionRegistryEntry *entry in entries) {
+        if ([entry threadAffinityForSituation:situation] == UAActionThreadAffinityBackground) {
+            [backgroundEntries addObject:entry];
+        } else {
+            [mainEntries addObject:entry];
+        }
+    }
+
+    UA_LTRACE(@"Running %lu background and %lu main queue actions", (unsigned long)backgroundEntries.count, (unsigned long)mainEntries.count);
+    return [backgroundEntries arrayByAddingObjectsFromArray:mainEntries];
+}
+
 + (void)runActionsWithActionValues:(NSDictionary *)actionValues
                          situation:(UASituation)situation
                           metadata:(NSDictionary *)metadata
@@ -132,7 +154,7 @@ completionHandler:(UAActionCompletionHandler)completionHandler {
         }
     }
 
-    for (UAActionRegistryEntry *entry in actionEntries) {
+    for (UAActionRegistryEntry *entry in [self executionPlanForEntries:actionEntries situation:situation]) {
         __block NSUInteger completions = 0;
         UAActionCompletionHandler handler = ^(UAActionResult *result) {
             @synchronized(self) {
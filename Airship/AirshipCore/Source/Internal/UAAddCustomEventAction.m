@@ -26,6 +26,10 @@ NSString * const UAAddCustomEventActionDefaultRegistryName = @"add_custom_event_
     }
 }
 
+- (UAActionThreadAffinity)threadAffinity {
+    return UAActionThreadAffinityBackground;
+}
+
 - (void)performWithArguments:(UAActionArguments *)arguments
            completionHandler:(UAActionCompletionHandler)completionHandler {
 
@@ -16,6 +16,7 @@
 @class UARegionEvent;
 @class UAPreferenceDataStore;
 @class UARuntimeConfig;
+@class UADisposable;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -100,6 +101,21 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)cancelUpload;
 
+/**
+ * Adds a batch of events in a single write to the event store.
+ *
+ * @param events The events.
+ */
+- (void)addEvents:(NSArray<UAEvent *> *)events;
+
+/**
+ * Writes any pending events and uploads the stored events now. Used by background work.
+ *
+ * @param completionHandler Called once the upload has finished.
+ * @return A disposable that cancels the upload, or nil if no upload was started.
+ */
+- (nullable UADisposable *)uploadEventsWithCompletionHandler:(void (^)(BOOL success))completionHandler;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -19,7 +19,8 @@
 #import "UAirship.h"
 #import "UAPush+Internal.h"
 #import "UAChannel.h"
-#import "UALocaleManager.h"
+#import "UALocaleManager+Internal.h"
+#import "UAEventLimiter+Internal.h"
 
 #define kUAAssociatedIdentifiers @"UAAssociatedIdentifiers"
 
@@ -31,12 +32,20 @@
 @property (nonatomic, strong) NSNotificationCenter *notificationCenter;
 @property (nonatomic, strong) UADate *date;
 @property (nonatomic, strong) UADispatcher *dispatcher;
+@property (nonatomic, strong) UADispatcher *eventDispatcher;
 @property (nonatomic, strong) NSMutableArray<NSString *> *SDKExtensions;
 @property (nonatomic, strong) NSMutableArray<UAAnalyticsHeadersBlock> *headerBlocks;
 @property (nonatomic, strong) UALocaleManager *localeManager;
 @property (nonatomic, strong) UAAppStateTracker *appStateTracker;
 @property (nonatomic, assign) BOOL handledFirstForegroundTransition;
 
+// Region events waiting out the debounce window, only accessed on the dispatcher
+@property (nonatomic, strong) NSMutableArray<UARegionEvent *> *pendingRegionEvents;
+
+// Headers that only change with the locale, time zone, channel ID or SDK extensions
+@property (nonatomic, copy, nullable) NSDictionary *cachedHeaders;
+@property (nonatomic, copy, nullable) NSString *cachedHeadersChannelID;
+
 // Screen tracking state
 @property (nonatomic, copy) NSString *currentScreen;
 @property (nonatomic, copy) NSString *previousScreen;
@@ -47,9 +56,16 @@
 NSString *const UACustomEventAdded = @"UACustomEventAdded";
 
 NSString *const UARegionEventAdded = @"UARegionEventAdded";
+NSString *const UARegionEventsAdded = @"UARegionEventsAdded";
 NSString *const UAScreenTracked = @"UAScreenTracked";
 NSString *const UAScreenKey = @"screen";
 NSString *const UAEventKey = @"event";
+NSString *const UAEventsKey = @"events";
+
+NSTimeInterval const UAAnalyticsRegionEventDebounceInterval = 10;
+
+// Event sampling and rate limits in the analytics remote config
+static NSString * const UAAnalyticsRemoteConfigEventLimitsKey = @"event_limits";
 
 @implementation UAAnalytics
 
@@ -60,6 +76,7 @@ NSString *const UAEventKey = @"event";
             notificationCenter:(NSNotificationCenter *)notificationCenter
                           date:(UADate *)date
                     dispatcher:(UADispatcher *)dispatcher
+               eventDispatcher:(UADispatcher *)eventDispatcher
                  localeManager:(UALocaleManager *)localeManager
                appStateTracker:(UAAppStateTracker *)appStateTracker {
 
@@ -74,10 +91,12 @@ NSString *const UAEventKey = @"event";
         self.notificationCenter = notificationCenter;
         self.date = date;
         self.dispatcher = dispatcher;
+        self.eventDispatcher = eventDispatcher;
         self.localeManager = localeManager;
         self.appStateTracker = appStateTracker;
         self.SDKExtensions = [NSMutableArray array];
         self.headerBlocks = [NSMutableArray array];
+        self.pendingRegionEvents = [NSMutableArray array];
 
         // Default analytics value
         if (![self.dataStore objectForKey:kUAAnalyticsEnabled]) {
@@ -109,6 +128,21 @@ NSString *const UAEventKey = @"event";
                                         name:UAApplicationWillTerminateNotification
                                       object:nil];
 
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(invalidateCachedHeaders)
+                                        name:UALocaleUpdatedEvent
+                                      object:nil];
+
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(invalidateCachedHeaders)
+                                        name:NSCurrentLocaleDidChangeNotification
+                                      object:nil];
+
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(invalidateCachedHeaders)
+                                        name:NSSystemTimeZoneDidChangeNotification
+                                      object:nil];
+
         if (!self.isEnabled) {
             [self.eventManager deleteAllEvents];
         }
@@ -134,6 +168,7 @@ NSString *const UAEventKey = @"event";
                      notificationCenter:[NSNotificationCenter defaultCenter]
                                    date:[[UADate alloc] init]
                              dispatcher:[UADispatcher mainDispatcher]
+                        eventDispatcher:[UADispatcher serialDispatcherForWorkType:UADispatcherWorkTypeProcessing]
                           localeManager:localeManager
                         appStateTracker:[UAAppStateTracker shared]];
 }
@@ -155,6 +190,7 @@ NSString *const UAEventKey = @"event";
                      notificationCenter:notificationCenter
                                    date:date
                              dispatcher:dispatcher
+                        eventDispatcher:dispatcher
                           localeManager:localeManager
                         appStateTracker:appStateTracker];
 }
@@ -194,6 +230,7 @@ NSString *const UAEventKey = @"event";
 
     // add app_background event
     [self addEvent:[UAAppBackgroundEvent event]];
+    [self savePendingEvents];
 
     [self startSession];
     self.conversionSendID = nil;
@@ -203,6 +240,16 @@ NSString *const UAEventKey = @"event";
 - (void)applicationWillTerminate {
     UA_LTRACE(@"Application is terminating.");
     [self stopTrackingScreen];
+    [self savePendingEvents];
+}
+
+- (void)savePendingEvents {
+    // Dispatch after any events that are still being added
+    UA_WEAKIFY(self)
+    [self.dispatcher dispatchAsync:^{
+        UA_STRONGIFY(self)
+        [self.eventManager savePendingEvents];
+    }];
 }
 
 
@@ -210,44 +257,160 @@ NSString *const UAEventKey = @"event";
 #pragma mark Analytics
 
 - (void)addEvent:(UAEvent *)event {
-    if (!event.isValid) {
-        UA_LERR(@"Dropping invalid event %@.", event);
-        return;
-    }
+    [self addEvent:event completionHandler:nil];
+}
 
+- (void)addEvent:(UAEvent *)event completionHandler:(nullable void (^)(BOOL accepted))completionHandler {
+    // Only cheap state is read on the caller's thread, validation and serialization run on the event queue
     if (!self.isEnabled || !self.isDataCollectionEnabled) {
         UA_LTRACE(@"Analytics disabled, ignoring event: %@", event.eventType);
+        [self finishAddingEventWithResult:NO completionHandler:completionHandler];
         return;
     }
 
     NSString *sessionID = self.sessionID;
 
     UA_WEAKIFY(self)
-    [self.dispatcher dispatchAsync:^{
+    [self.eventDispatcher dispatchAsync:^{
         UA_STRONGIFY(self)
+        if (!event.isValid) {
+            UA_LERR(@"Dropping invalid event %@.", event);
+            [self finishAddingEventWithResult:NO completionHandler:completionHandler];
+            return;
+        }
 
-        UA_LDEBUG(@"Adding %@ event %@.", event.eventType, event.eventID);
-        [self.eventManager addEvent:event sessionID:sessionID];
-        UA_LTRACE(@"Event added: %@.", event);
+        // The serialized event is cached, so the store reuses it
+        [event JSONDataWithSessionID:sessionID];
 
-        if (self.eventConsumer) {
-            [self.eventConsumer eventAdded:event];
+        [self.dispatcher dispatchAsync:^{
+            UA_STRONGIFY(self)
+            [self addValidatedEvent:event sessionID:sessionID];
+            if (completionHandler) {
+                completionHandler(YES);
+            }
+        }];
+    }];
+}
+
+- (void)finishAddingEventWithResult:(BOOL)accepted completionHandler:(nullable void (^)(BOOL accepted))completionHandler {
+    if (completionHandler) {
+        [self.dispatcher dispatchAsync:^{
+            completionHandler(accepted);
+        }];
+    }
+}
+
+- (void)addValidatedEvent:(UAEvent *)event sessionID:(NSString *)sessionID {
+    UA_LDEBUG(@"Adding %@ event %@.", event.eventType, event.eventID);
+    [self.eventManager addEvent:event sessionID:sessionID];
+    UA_LTRACE(@"Event added: %@.", event);
+
+    if (self.eventConsumer) {
+        [self.eventConsumer eventAdded:event];
+    }
+
+    if ([event isKindOfClass:[UACustomEvent class]]) {
+        [self.notificationCenter postNotificationName:UACustomEventAdded
+                                               object:self
+                                             userInfo:@{UAEventKey: event}];
+    }
+
+    if ([event isKindOfClass:[UARegionEvent class]]) {
+        [self.notificationCenter postNotificationName:UARegionEventAdded
+                                               object:self
+                                             userInfo:@{UAEventKey: event}];
+    }
+}
+
+
+- (void)addEvents:(NSArray<UAEvent *> *)events {
+    if (!self.isEnabled || !self.isDataCollectionEnabled) {
+        UA_LTRACE(@"Analytics disabled, ignoring %lu events", (unsigned long)events.count);
+        return;
+    }
+
+    NSString *sessionID = self.sessionID;
+
+    UA_WEAKIFY(self)
+    [self.eventDispatcher dispatchAsync:^{
+        NSMutableArray<UAEvent *> *validEvents = [NSMutableArray arrayWithCapacity:events.count];
+        for (UAEvent *event in events) {
+            if (event.isValid) {
+                [event JSONDataWithSessionID:sessionID];
+                [validEvents addObject:event];
+            } else {
+                UA_LERR(@"Dropping invalid event %@.", event);
+            }
         }
 
-        if ([event isKindOfClass:[UACustomEvent class]]) {
-            [self.notificationCenter postNotificationName:UACustomEventAdded
-                                                   object:self
-                                                 userInfo:@{UAEventKey: event}];
+        if (!validEvents.count) {
+            return;
         }
 
-        if ([event isKindOfClass:[UARegionEvent class]]) {
-            [self.notificationCenter postNotificationName:UARegionEventAdded
-                                                   object:self
-                                                 userInfo:@{UAEventKey: event}];
+        UA_STRONGIFY(self)
+        [self.dispatcher dispatchAsync:^{
+            UA_STRONGIFY(self)
+
+            UA_LDEBUG(@"Adding %lu events.", (unsigned long)validEvents.count);
+            [self.eventManager addEvents:validEvents sessionID:sessionID];
+
+            if (self.eventConsumer) {
+                for (UAEvent *event in validEvents) {
+                    [self.eventConsumer eventAdded:event];
+                }
+            }
+        }];
+    }];
+}
+
+- (void)addRegionEvents:(NSArray<UARegionEvent *> *)events {
+    if (!events.count) {
+        return;
+    }
+
+    UA_WEAKIFY(self)
+    [self.dispatcher dispatchAsync:^{
+        UA_STRONGIFY(self)
+        BOOL flushNeeded = self.pendingRegionEvents.count == 0;
+        [self.pendingRegionEvents addObjectsFromArray:events];
+
+        if (flushNeeded) {
+            [self.dispatcher dispatchAfter:UAAnalyticsRegionEventDebounceInterval block:^{
+                UA_STRONGIFY(self)
+                [self flushRegionEvents];
+            }];
         }
     }];
 }
 
+/**
+ * Adds the coalesced pending region events. Must be called on the dispatcher.
+ */
+- (void)flushRegionEvents {
+    NSArray<UARegionEvent *> *events = [UARegionEvent coalescedRegionEvents:self.pendingRegionEvents];
+    [self.pendingRegionEvents removeAllObjects];
+
+    if (!self.isEnabled) {
+        UA_LTRACE(@"Analytics disabled, ignoring %lu region events", (unsigned long)events.count);
+        return;
+    }
+
+    NSMutableArray<UARegionEvent *> *validEvents = [NSMutableArray arrayWithCapacity:events.count];
+    for (UARegionEvent *event in events) {
+        if (event.isValid) {
+            [validEvents addObject:event];
+        }
+    }
+
+    if (!validEvents.count) {
+        return;
+    }
+
+    [self addEvents:validEvents];
+    [self.notificationCenter postNotificationName:UARegionEventsAdded
+                                           object:self
+                                         userInfo:@{UAEventsKey: [validEvents copy]}];
+}
 
 - (void)launchedFromNotification:(NSDictionary *)notification {
     if (!notification) {
@@ -350,6 +513,11 @@ NSString *const UAEventKey = @"event";
     [self.eventManager scheduleUpload];
 }
 
+- (UADisposable *)uploadEventsWithCompletionHandler:(void (^)(BOOL success))completionHandler {
+    [self.eventManager savePendingEvents];
+    return [self.eventManager uploadEventsWithCompletionHandler:completionHandler];
+}
+
 - (void)onComponentEnableChange {
     [self updateEventManagerUploadsEnabled];
     if (self.componentEnabled) {
@@ -361,10 +529,18 @@ NSString *const UAEventKey = @"event";
     }
 }
 
+- (void)applyRemoteConfig:(nullable id)config {
+    id eventLimits = [config isKindOfClass:[NSDictionary class]] ? config[UAAnalyticsRemoteConfigEventLimitsKey] : nil;
+    [self.eventManager.eventLimiter applyRulesFromJSON:eventLimits];
+}
+
 - (void)registerSDKExtension:(UASDKExtension)extension version:(NSString *)version {
     NSString *sanitizedVersion = [version stringByReplacingOccurrencesOfString:@"," withString:@""];
     NSString *name = [UAAnalytics nameForSDKExtension:extension];
-    [self.SDKExtensions addObject:[NSString stringWithFormat:@"%@:%@", name, sanitizedVersion]];
+    @synchronized (self) {
+        [self.SDKExtensions addObject:[NSString stringWithFormat:@"%@:%@", name, sanitizedVersion]];
+        self.cachedHeaders = nil;
+    }
 }
 
 + (NSString *)nameForSDKExtension:(UASDKExtension)extension {
@@ -385,6 +561,31 @@ NSString *const UAEventKey = @"event";
 }
 
 - (NSDictionary *)analyticsHeaders {
+    NSString *channelID = self.channel.identifier;
+    NSMutableDictionary *headers;
+
+    @synchronized (self) {
+        BOOL channelChanged = channelID != self.cachedHeadersChannelID && ![channelID isEqualToString:self.cachedHeadersChannelID];
+        if (!self.cachedHeaders || channelChanged) {
+            self.cachedHeaders = [self buildHeadersWithChannelID:channelID];
+            self.cachedHeadersChannelID = channelID;
+        }
+
+        headers = [self.cachedHeaders mutableCopy];
+    }
+
+    // Header extenders, not cached since they can change at any time
+    for (UAAnalyticsHeadersBlock block in self.headerBlocks) {
+        NSDictionary<NSString *, NSString *> *result = block();
+        if (result) {
+            [headers addEntriesFromDictionary:result];
+        }
+    }
+
+    return headers;
+}
+
+- (NSDictionary *)buildHeadersWithChannelID:(NSString *)channelID {
     NSMutableDictionary *headers = [NSMutableDictionary dictionary];
 
     // Device info
@@ -405,7 +606,7 @@ NSString *const UAEventKey = @"event";
     [headers setValue:[currentLocale objectForKey:NSLocaleVariantCode] forKey:@"X-UA-Locale-Variant"];
 
     // Airship identifiers
-    [headers setValue:self.channel.identifier forKey:@"X-UA-Channel-ID"];
+    [headers setValue:channelID forKey:@"X-UA-Channel-ID"];
     [headers setValue:self.config.appKey forKey:@"X-UA-App-Key"];
 
     // SDK Version
@@ -416,17 +617,15 @@ NSString *const UAEventKey = @"event";
         [headers setValue:[self.SDKExtensions componentsJoinedByString:@", "] forKey:@"X-UA-Frameworks"];
     }
 
-    // Header extenders
-    for (UAAnalyticsHeadersBlock block in self.headerBlocks) {
-        NSDictionary<NSString *, NSString *> *result = block();
-        if (result) {
-            [headers addEntriesFromDictionary:result];
-        }
-    }
-
     return headers;
 }
 
+- (void)invalidateCachedHeaders {
+    @synchronized (self) {
+        self.cachedHeaders = nil;
+    }
+}
+
 - (void)addAnalyticsHeadersBlock:(nonnull UAAnalyticsHeadersBlock)headersBlock {
     [self.headerBlocks addObject:headersBlock];
 }
@@ -16,9 +16,14 @@
 #import "UARuntimeConfig.h"
 #import "UAActionRunner.h"
 #import "UAActionRegistry+Internal.h"
+#import "UARemoteNotificationBudget+Internal.h"
+#import "UAWorkScheduler+Internal.h"
 
 #define kUANotificationActionKey @"com.urbanairship.interactive_actions"
 
+// The system allows about 30 seconds to handle a remote notification, keep a margin for the app
+#define kUARemoteNotificationTimeLimit 25
+
 @implementation UAAppIntegration
 
 #pragma mark -
@@ -64,7 +69,11 @@
 
         case UIApplicationStateBackground:
         case UIApplicationStateInactive:
-            // Background push
+            // Background push, the wake up gets its own work budget unless a background window is still running
+            if (application.applicationState == UIApplicationStateBackground) {
+                [[UAWorkScheduler shared] beginWindowWithLaunchType:UAWorkLaunchTypeSilentPush];
+            }
+
             [self handleIncomingNotification:[UANotificationContent notificationWithNotificationInfo:userInfo]
                       foregroundPresentation:NO
                            completionHandler:completionHandler];
@@ -190,10 +199,19 @@
                  completionHandler:(void (^)(UIBackgroundFetchResult))completionHandler {
     UA_LINFO(@"Received notification: %@", notificationContent);
 
-    dispatch_group_t dispatchGroup = dispatch_group_create();
-    __block NSMutableArray *fetchResults = [NSMutableArray array];
+    UARemoteNotificationBudget *budget = [UARemoteNotificationBudget budgetWithTimeLimit:kUARemoteNotificationTimeLimit];
     BOOL foreground = [UIApplication sharedApplication].applicationState == UIApplicationStateActive;
 
+    // Actions then push
+    [budget addTaskWithName:@"Actions" priority:UAPushableComponentPriorityHigh task:^(void (^completionHandler)(UIBackgroundFetchResult)) {
+        [self runActionsForRemoteNotification:notificationContent foregroundPresentation:foregroundPresentation completionHandler:^(UIBackgroundFetchResult actionsResult) {
+            // UAPush
+            [[UAirship push] handleRemoteNotification:notificationContent foreground:foreground completionHandler:^(UIBackgroundFetchResult pushResult) {
+                completionHandler([UAUtils mergeFetchResults:@[@(actionsResult), @(pushResult)]]);
+            }];
+        }];
+    }];
+
     // Pushable components
     for (UAComponent *component in [UAirship shared].components) {
          if (![component conformsToProtocol:@protocol(UAPushableComponent)]) {
@@ -201,37 +219,22 @@
          }
 
          UAComponent<UAPushableComponent> *pushable = (UAComponent<UAPushableComponent> *)component;
-         if ([pushable respondsToSelector:@selector(receivedRemoteNotification:completionHandler:)]) {
-             dispatch_group_enter(dispatchGroup);
-             [pushable receivedRemoteNotification:notificationContent completionHandler:^(UIBackgroundFetchResult fetchResult) {
-                 @synchronized (fetchResults) {
-                     [fetchResults addObject:@(fetchResult)];
-                 }
-                 dispatch_group_leave(dispatchGroup);
-             }];
+         if (![pushable respondsToSelector:@selector(receivedRemoteNotification:completionHandler:)]) {
+             continue;
          }
-    }
 
-    // Actions then push
-    dispatch_group_enter(dispatchGroup);
-    [self runActionsForRemoteNotification:notificationContent foregroundPresentation:foregroundPresentation completionHandler:^(UIBackgroundFetchResult result) {
-        @synchronized (fetchResults) {
-            [fetchResults addObject:@(result)];
-        }
+         UAPushableComponentPriority priority = UAPushableComponentPriorityDefault;
+         if ([pushable respondsToSelector:@selector(priorityForRemoteNotification:)]) {
+             priority = [pushable priorityForRemoteNotification:notificationContent];
+         }
 
-        // UAPush
-        [[UAirship push] handleRemoteNotification:notificationContent foreground:foreground completionHandler:^(UIBackgroundFetchResult result) {
-            @synchronized (fetchResults) {
-                [fetchResults addObject:@(result)];
-            }
-            dispatch_group_leave(dispatchGroup);
-        }];
-    }];
+         [budget addTaskWithName:NSStringFromClass([pushable class]) priority:priority task:^(void (^completionHandler)(UIBackgroundFetchResult)) {
+             [pushable receivedRemoteNotification:notificationContent completionHandler:completionHandler];
+         }];
+    }
 
-    dispatch_group_notify(dispatchGroup, dispatch_get_main_queue(), ^{
-        // all processing of incoming notification is complete
-        completionHandler([UAUtils mergeFetchResults:fetchResults]);
-    });
+    // All processing of incoming notification is complete, or the time ran out
+    [budget runWithCompletionHandler:completionHandler];
 }
 
 #pragma mark -
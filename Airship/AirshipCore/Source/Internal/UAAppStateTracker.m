@@ -17,17 +17,27 @@ NSString *const UAApplicationLaunchOptionsRemoteNotificationKey = @"com.urbanair
 @property (nonatomic, strong) id<UAAppStateTrackerAdapter> adapter;
 @property (nonatomic, strong) NSNotificationCenter *notificationCenter;
 @property (nonatomic, assign) BOOL isForegrounded;
+
+/**
+ * The last known state, updated on the main queue and readable from any thread.
+ */
+@property (atomic, assign) UAApplicationState cachedState;
 @end
 
 @implementation UAAppStateTracker
 
-static UAAppStateTracker *shared_;
++ (instancetype)shared {
+    static UAAppStateTracker *shared_;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        shared_ = [[UAAppStateTracker alloc] init];
 
-+ (void)load {
-    shared_ = [[UAAppStateTracker alloc] init];
-}
+        // Created lazily, so launch may already be over. Pick up the current state when it is safe to read.
+        if ([NSThread isMainThread]) {
+            [shared_ state];
+        }
+    });
 
-+ (instancetype)shared {
     return shared_;
 }
 
@@ -38,6 +48,9 @@ static UAAppStateTracker *shared_;
         self.notificationCenter = notificationCenter;
         self.adapter = adapter;
         self.adapter.stateTrackerDelegate = self;
+
+        // UIApplication might not exist yet, so assume background until launch finishes
+        self.cachedState = UAApplicationStateBackground;
     }
 
     return self;
@@ -48,6 +61,8 @@ static UAAppStateTracker *shared_;
 }
 
 - (void)applicationDidFinishLaunching:(NSDictionary *)remoteNotification {
+    self.cachedState = self.adapter.state;
+
     NSDictionary *userInfo = remoteNotification == nil ? nil : @{ UAApplicationLaunchOptionsRemoteNotificationKey : remoteNotification };
     [self.notificationCenter postNotificationName:UAApplicationDidFinishLaunchingNotification
                                            object:nil
@@ -55,6 +70,7 @@ static UAAppStateTracker *shared_;
 }
 
 - (void)applicationDidBecomeActive {
+    self.cachedState = UAApplicationStateActive;
     [self.notificationCenter postNotificationName:UAApplicationDidBecomeActiveNotification object:nil];
 
     if (!self.isForegrounded) {
@@ -64,10 +80,12 @@ static UAAppStateTracker *shared_;
 }
 
 - (void)applicationWillEnterForeground {
+    self.cachedState = UAApplicationStateInactive;
     [self.notificationCenter postNotificationName:UAApplicationWillEnterForegroundNotification object:nil];
 }
 
 - (void)applicationDidEnterBackground {
+    self.cachedState = UAApplicationStateBackground;
     [self.notificationCenter postNotificationName:UAApplicationDidEnterBackgroundNotification object:nil];
 
     if (self.isForegrounded) {
@@ -77,6 +95,7 @@ static UAAppStateTracker *shared_;
 }
 
 - (void)applicationWillResignActive {
+    self.cachedState = UAApplicationStateInactive;
     [self.notificationCenter postNotificationName:UAApplicationWillResignActiveNotification object:nil];
 }
 
@@ -85,7 +104,14 @@ static UAAppStateTracker *shared_;
 }
 
 - (UAApplicationState)state {
-    return self.adapter.state;
+    // Off the main queue, return the last known state instead of touching UIApplication
+    if (![NSThread isMainThread]) {
+        return self.cachedState;
+    }
+
+    UAApplicationState state = self.adapter.state;
+    self.cachedState = state;
+    return state;
 }
 
 @end
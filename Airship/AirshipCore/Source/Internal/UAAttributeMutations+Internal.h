@@ -18,7 +18,7 @@ NS_ASSUME_NONNULL_BEGIN
 ///
 
 /**
- The collection of all current mutations comprising a mutations object. Used for mutation compression, conversion into pending mutations and testing.
+ The collection of all current mutations comprising a mutations object, at most one per attribute. Used for mutation compression, conversion into pending mutations and testing.
 */
 @property(nonatomic, strong, readonly) NSMutableArray<NSDictionary *> *mutationsPayload;
 
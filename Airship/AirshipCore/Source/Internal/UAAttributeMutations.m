@@ -8,6 +8,14 @@
 
 NSInteger const UAAttributeMaxStringLength = 1024;
 
+@interface UAAttributeMutations ()
+
+/**
+ * The mutation in the payload for each attribute, keyed by attribute name.
+ */
+@property(nonatomic, strong) NSMutableDictionary<NSString *, NSDictionary *> *mutationsByAttribute;
+@end
+
 @implementation UAAttributeMutations
 
 + (instancetype)mutations {
@@ -19,6 +27,7 @@ NSInteger const UAAttributeMaxStringLength = 1024;
 
     if (self) {
         _mutationsPayload = [NSMutableArray array];
+        _mutationsByAttribute = [NSMutableDictionary dictionary];
     }
     return self;
 }
@@ -38,7 +47,7 @@ NSInteger const UAAttributeMaxStringLength = 1024;
         UAAttributeNameKey : normalizedKey
     };
 
-    [self.mutationsPayload addObject:mutationBody];
+    [self addMutation:mutationBody forAttribute:normalizedKey];
 }
 
 - (void)setNumber:(NSNumber *)number forAttribute:(NSString *)attribute {
@@ -55,7 +64,7 @@ NSInteger const UAAttributeMaxStringLength = 1024;
         UAAttributeNameKey : normalizedKey
     };
 
-    [self.mutationsPayload addObject:mutationBody];
+    [self addMutation:mutationBody forAttribute:normalizedKey];
 }
 
 - (void)setDate:(NSDate *)date forAttribute:(NSString *)attribute; {
@@ -66,15 +75,14 @@ NSInteger const UAAttributeMaxStringLength = 1024;
         return;
     }
     
-    NSDateFormatter *isoDateFormatter = [UAUtils ISODateFormatterUTCWithDelimiter];
-    NSString *dateAsISOString = [isoDateFormatter stringFromDate:date];
+    NSString *dateAsISOString = [UAUtils ISODateStringFromDate:date delimiter:YES];
     NSDictionary *mutationBody = @{
         UAAttributeActionKey : UAAttributeSetActionKey,
         UAAttributeValueKey : dateAsISOString,
         UAAttributeNameKey : normalizedKey
     };
 
-    [self.mutationsPayload addObject:mutationBody];
+    [self addMutation:mutationBody forAttribute:normalizedKey];
 }
 
 - (void)removeAttribute:(NSString *)attribute {
@@ -90,7 +98,21 @@ NSInteger const UAAttributeMaxStringLength = 1024;
         UAAttributeNameKey : normalizedKey
     };
 
-    [self.mutationsPayload addObject:mutationBody];
+    [self addMutation:mutationBody forAttribute:normalizedKey];
+}
+
+/**
+ * Adds a mutation to the payload. The last write to an attribute wins, so any earlier mutation
+ * of the attribute is replaced and the attribute moves to the end.
+ */
+- (void)addMutation:(NSDictionary *)mutation forAttribute:(NSString *)attribute {
+    NSDictionary *previous = self.mutationsByAttribute[attribute];
+    if (previous) {
+        [self.mutationsPayload removeObjectIdenticalTo:previous];
+    }
+
+    [self.mutationsPayload addObject:mutation];
+    self.mutationsByAttribute[attribute] = mutation;
 }
 
 - (nullable NSString *)normalizeAttributeString:(NSString *)string {
@@ -0,0 +1,31 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+#import "UAAttributePendingMutations.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Attribute payload keys.
+ */
+extern NSString *const UAAttributeNameKey;
+
+/**
+ Immutable attribute mutations, timestamped and ready for upload.
+*/
+@interface UAAttributePendingMutations ()
+
+///---------------------------------------------------------------------------------------
+/// @name Attribute Pending Mutations Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ Generates a pending mutations object from an already timestamped mutations payload.
+ @param mutationsPayload The mutations payload, at most one entry per attribute.
+ @return A UAAttributePendingMutations instance.
+*/
++ (instancetype)pendingMutationsWithPayload:(NSArray<NSDictionary *> *)mutationsPayload;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -3,11 +3,41 @@
 #import <Foundation/Foundation.h>
 #import "UAUtils.h"
 #import "UAChannel.h"
-#import "UAAttributePendingMutations.h"
+#import "UAAttributePendingMutations+Internal.h"
 #import "UAAttributeMutations+Internal.h"
 #import "UADate.h"
 
 NSString *const UAAttributeMutationsCodableKey = @"com.urbanairship.attributes";
+NSString *const UAAttributeMutationsCompactCodableKey = @"com.urbanairship.attributes.compact";
+
+// Version of the compact encoding
+static uint8_t const UAAttributeCompactEncodingVersion = 1;
+
+// Marks a missing string table index
+static uint32_t const UAAttributeCompactNoIndex = UINT32_MAX;
+
+typedef NS_ENUM(uint8_t, UAAttributeCompactAction) {
+    UAAttributeCompactActionSet = 0,
+    UAAttributeCompactActionRemove = 1,
+};
+
+typedef NS_ENUM(uint8_t, UAAttributeCompactValueType) {
+    UAAttributeCompactValueTypeNone = 0,
+    UAAttributeCompactValueTypeString = 1,
+    UAAttributeCompactValueTypeInteger = 2,
+    UAAttributeCompactValueTypeDouble = 3,
+    UAAttributeCompactValueTypeBoolean = 4,
+};
+
+/**
+ * Bounds checked reader over a compact encoding.
+ */
+typedef struct {
+    const uint8_t *bytes;
+    NSUInteger length;
+    NSUInteger offset;
+    BOOL failed;
+} UAAttributeCompactReader;
 
 /**
  Attribute keys as defined in the specification
@@ -28,10 +58,265 @@ NSString *const UAAttributeRemoveActionKey = @"remove";
 
 @implementation UAAttributePendingMutations
 
+#pragma mark -
+#pragma mark Compact Encoding
+
+static void UAAttributeCompactAppendUInt8(NSMutableData *data, uint8_t value) {
+    [data appendBytes:&value length:sizeof(value)];
+}
+
+static void UAAttributeCompactAppendUInt32(NSMutableData *data, uint32_t value) {
+    value = CFSwapInt32HostToLittle(value);
+    [data appendBytes:&value length:sizeof(value)];
+}
+
+static void UAAttributeCompactAppendUInt64(NSMutableData *data, uint64_t value) {
+    value = CFSwapInt64HostToLittle(value);
+    [data appendBytes:&value length:sizeof(value)];
+}
+
+static BOOL UAAttributeCompactRead(UAAttributeCompactReader *reader, void *value, NSUInteger length) {
+    if (reader->failed || reader->length - reader->offset < length) {
+        reader->failed = YES;
+        return NO;
+    }
+
+    memcpy(value, reader->bytes + reader->offset, length);
+    reader->offset += length;
+    return YES;
+}
+
+static uint8_t UAAttributeCompactReadUInt8(UAAttributeCompactReader *reader) {
+    uint8_t value = 0;
+    UAAttributeCompactRead(reader, &value, sizeof(value));
+    return value;
+}
+
+static uint32_t UAAttributeCompactReadUInt32(UAAttributeCompactReader *reader) {
+    uint32_t value = 0;
+    UAAttributeCompactRead(reader, &value, sizeof(value));
+    return CFSwapInt32LittleToHost(value);
+}
+
+static uint64_t UAAttributeCompactReadUInt64(UAAttributeCompactReader *reader) {
+    uint64_t value = 0;
+    UAAttributeCompactRead(reader, &value, sizeof(value));
+    return CFSwapInt64LittleToHost(value);
+}
+
+/**
+ * Encodes a mutations payload as a string table followed by typed mutations:
+ *
+ * version (u8) | string count (u32) | strings (u32 UTF-8 length, bytes) |
+ * mutation count (u32) | mutations (u8 action, u32 name, u32 timestamp, u8 value type, value)
+ *
+ * Names, timestamps and string values are stored once in the string table and referenced by
+ * index, numbers are stored as 8 bytes and booleans as 1. Returns nil if the payload holds
+ * anything the encoding can not represent.
+ */
++ (nullable NSData *)compactEncodingOfMutationsPayload:(NSArray<NSDictionary *> *)mutationsPayload {
+    static NSSet<NSString *> *supportedKeys;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        supportedKeys = [NSSet setWithArray:@[UAAttributeActionKey, UAAttributeNameKey, UAAttributeValueKey, UAAttributeTimestampKey]];
+    });
+
+    NSMutableArray<NSString *> *strings = [NSMutableArray array];
+    NSMutableDictionary<NSString *, NSNumber *> *stringIndexes = [NSMutableDictionary dictionary];
+    uint32_t (^indexOfString)(NSString *) = ^uint32_t(NSString *string) {
+        NSNumber *index = stringIndexes[string];
+        if (!index) {
+            index = @(strings.count);
+            stringIndexes[string] = index;
+            [strings addObject:string];
+        }
+        return index.unsignedIntValue;
+    };
+
+    NSMutableData *mutationsData = [NSMutableData data];
+    for (NSDictionary *mutation in mutationsPayload) {
+        if (![mutation isKindOfClass:[NSDictionary class]]) {
+            return nil;
+        }
+
+        for (id key in mutation) {
+            if (![supportedKeys containsObject:key]) {
+                return nil;
+            }
+        }
+
+        id action = mutation[UAAttributeActionKey];
+        id name = mutation[UAAttributeNameKey];
+        id timestamp = mutation[UAAttributeTimestampKey];
+        id value = mutation[UAAttributeValueKey];
+
+        if (![name isKindOfClass:[NSString class]] || (timestamp && ![timestamp isKindOfClass:[NSString class]])) {
+            return nil;
+        }
+
+        if ([action isEqual:UAAttributeSetActionKey]) {
+            UAAttributeCompactAppendUInt8(mutationsData, UAAttributeCompactActionSet);
+        } else if ([action isEqual:UAAttributeRemoveActionKey]) {
+            UAAttributeCompactAppendUInt8(mutationsData, UAAttributeCompactActionRemove);
+        } else {
+            return nil;
+        }
+
+        UAAttributeCompactAppendUInt32(mutationsData, indexOfString(name));
+        UAAttributeCompactAppendUInt32(mutationsData, timestamp ? indexOfString(timestamp) : UAAttributeCompactNoIndex);
+
+        if (!value) {
+            UAAttributeCompactAppendUInt8(mutationsData, UAAttributeCompactValueTypeNone);
+        } else if ([value isKindOfClass:[NSString class]]) {
+            UAAttributeCompactAppendUInt8(mutationsData, UAAttributeCompactValueTypeString);
+            UAAttributeCompactAppendUInt32(mutationsData, indexOfString(value));
+        } else if ([value isKindOfClass:[NSNumber class]]) {
+            NSNumber *number = value;
+            if (CFGetTypeID((__bridge CFTypeRef)number) == CFBooleanGetTypeID()) {
+                UAAttributeCompactAppendUInt8(mutationsData, UAAttributeCompactValueTypeBoolean);
+                UAAttributeCompactAppendUInt8(mutationsData, number.boolValue ? 1 : 0);
+            } else if (CFNumberIsFloatType((__bridge CFNumberRef)number)) {
+                double doubleValue = number.doubleValue;
+                uint64_t bits;
+                memcpy(&bits, &doubleValue, sizeof(bits));
+                UAAttributeCompactAppendUInt8(mutationsData, UAAttributeCompactValueTypeDouble);
+                UAAttributeCompactAppendUInt64(mutationsData, bits);
+            } else if (strcmp(number.objCType, @encode(unsigned long long)) == 0 && number.unsignedLongLongValue > INT64_MAX) {
+                return nil;
+            } else {
+                UAAttributeCompactAppendUInt8(mutationsData, UAAttributeCompactValueTypeInteger);
+                UAAttributeCompactAppendUInt64(mutationsData, (uint64_t)number.longLongValue);
+            }
+        } else {
+            return nil;
+        }
+    }
+
+    NSMutableData *data = [NSMutableData data];
+    UAAttributeCompactAppendUInt8(data, UAAttributeCompactEncodingVersion);
+    UAAttributeCompactAppendUInt32(data, (uint32_t)strings.count);
+    for (NSString *string in strings) {
+        NSData *stringData = [string dataUsingEncoding:NSUTF8StringEncoding];
+        UAAttributeCompactAppendUInt32(data, (uint32_t)stringData.length);
+        [data appendData:stringData];
+    }
+
+    UAAttributeCompactAppendUInt32(data, (uint32_t)mutationsPayload.count);
+    [data appendData:mutationsData];
+
+    return data;
+}
+
+/**
+ * Decodes a compact encoding, or returns nil if it is malformed.
+ */
++ (nullable NSArray<NSDictionary *> *)mutationsPayloadWithCompactEncoding:(NSData *)data {
+    UAAttributeCompactReader reader = { data.bytes, data.length, 0, NO };
+
+    if (UAAttributeCompactReadUInt8(&reader) != UAAttributeCompactEncodingVersion) {
+        return nil;
+    }
+
+    uint32_t stringCount = UAAttributeCompactReadUInt32(&reader);
+    NSMutableArray<NSString *> *strings = [NSMutableArray array];
+    for (uint32_t i = 0; i < stringCount && !reader.failed; i++) {
+        uint32_t length = UAAttributeCompactReadUInt32(&reader);
+        if (reader.failed || reader.length - reader.offset < length) {
+            return nil;
+        }
+
+        NSString *string = [[NSString alloc] initWithBytes:reader.bytes + reader.offset length:length encoding:NSUTF8StringEncoding];
+        if (!string) {
+            return nil;
+        }
+
+        [strings addObject:string];
+        reader.offset += length;
+    }
+
+    NSString * (^stringAtIndex)(uint32_t) = ^NSString *(uint32_t index) {
+        return index < strings.count ? strings[index] : nil;
+    };
+
+    uint32_t mutationCount = UAAttributeCompactReadUInt32(&reader);
+    NSMutableArray<NSDictionary *> *mutationsPayload = [NSMutableArray array];
+    for (uint32_t i = 0; i < mutationCount && !reader.failed; i++) {
+        NSMutableDictionary *mutation = [NSMutableDictionary dictionaryWithCapacity:4];
+
+        switch (UAAttributeCompactReadUInt8(&reader)) {
+            case UAAttributeCompactActionSet:
+                mutation[UAAttributeActionKey] = UAAttributeSetActionKey;
+                break;
+            case UAAttributeCompactActionRemove:
+                mutation[UAAttributeActionKey] = UAAttributeRemoveActionKey;
+                break;
+            default:
+                return nil;
+        }
+
+        NSString *name = stringAtIndex(UAAttributeCompactReadUInt32(&reader));
+        if (!name) {
+            return nil;
+        }
+        mutation[UAAttributeNameKey] = name;
+
+        uint32_t timestampIndex = UAAttributeCompactReadUInt32(&reader);
+        if (timestampIndex != UAAttributeCompactNoIndex) {
+            NSString *timestamp = stringAtIndex(timestampIndex);
+            if (!timestamp) {
+                return nil;
+            }
+            mutation[UAAttributeTimestampKey] = timestamp;
+        }
+
+        switch (UAAttributeCompactReadUInt8(&reader)) {
+            case UAAttributeCompactValueTypeNone:
+                break;
+            case UAAttributeCompactValueTypeString: {
+                NSString *value = stringAtIndex(UAAttributeCompactReadUInt32(&reader));
+                if (!value) {
+                    return nil;
+                }
+                mutation[UAAttributeValueKey] = value;
+                break;
+            }
+            case UAAttributeCompactValueTypeInteger:
+                mutation[UAAttributeValueKey] = @((int64_t)UAAttributeCompactReadUInt64(&reader));
+                break;
+            case UAAttributeCompactValueTypeDouble: {
+                uint64_t bits = UAAttributeCompactReadUInt64(&reader);
+                double value;
+                memcpy(&value, &bits, sizeof(value));
+                mutation[UAAttributeValueKey] = @(value);
+                break;
+            }
+            case UAAttributeCompactValueTypeBoolean:
+                mutation[UAAttributeValueKey] = UAAttributeCompactReadUInt8(&reader) ? @YES : @NO;
+                break;
+            default:
+                return nil;
+        }
+
+        if (reader.failed) {
+            return nil;
+        }
+
+        [mutationsPayload addObject:[mutation copy]];
+    }
+
+    return reader.failed ? nil : [mutationsPayload copy];
+}
+
+#pragma mark -
+
 + (instancetype)pendingMutationsWithMutations:(UAAttributeMutations *)mutations date:(UADate *)date {
     return [[UAAttributePendingMutations alloc] initWithMutations:mutations date:date];
 }
 
++ (instancetype)pendingMutationsWithPayload:(NSArray<NSDictionary *> *)mutationsPayload {
+    return [[UAAttributePendingMutations alloc] initWithPendingMutationsPayload:mutationsPayload];
+}
+
 - (instancetype)initWithMutations:(UAAttributeMutations *)mutations date:(UADate *)date {
     self = [super init];
 
@@ -56,21 +341,35 @@ NSString *const UAAttributeRemoveActionKey = @"remove";
     self = [super init];
 
     if (self) {
-        self.mutationsPayload = [coder decodeObjectForKey:UAAttributeMutationsCodableKey];
+        NSData *compactData = [coder decodeObjectForKey:UAAttributeMutationsCompactCodableKey];
+        if (compactData) {
+            self.mutationsPayload = [UAAttributePendingMutations mutationsPayloadWithCompactEncoding:compactData];
+            if (!self.mutationsPayload) {
+                UA_LERR(@"Unable to decode attribute mutations, dropping them.");
+                self.mutationsPayload = @[];
+            }
+        } else {
+            self.mutationsPayload = [coder decodeObjectForKey:UAAttributeMutationsCodableKey];
+        }
     }
 
     return self;
 }
 
 - (void)encodeWithCoder:(NSCoder *)coder {
-    [coder encodeObject:self.mutationsPayload forKey:UAAttributeMutationsCodableKey];
+    // Fall back to archiving the payload as is if it can not be encoded compactly
+    NSData *compactData = [UAAttributePendingMutations compactEncodingOfMutationsPayload:self.mutationsPayload];
+    if (compactData) {
+        [coder encodeObject:compactData forKey:UAAttributeMutationsCompactCodableKey];
+    } else {
+        [coder encodeObject:self.mutationsPayload forKey:UAAttributeMutationsCodableKey];
+    }
 }
 
 + (NSArray <NSDictionary *>*)mutationsPayload:(UAAttributeMutations *)mutations timestampedWithDate:(UADate *)date {
     NSMutableArray *mutableArr = [NSMutableArray arrayWithArray:mutations.mutationsPayload];
 
-    NSDateFormatter *isoDateFormatter = [UAUtils ISODateFormatterUTCWithDelimiter];
-    NSString *timestamp = [isoDateFormatter stringFromDate:date.now];
+    NSString *timestamp = [UAUtils ISODateStringFromDate:date.now delimiter:YES];
 
     for (int i = 0; i < mutableArr.count; i++) {
         NSDictionary *payload = mutableArr[i];
@@ -119,20 +418,19 @@ NSString *const UAAttributeRemoveActionKey = @"remove";
 
 + (NSArray<NSDictionary *> *)collapseMutationsArray:(NSArray<NSDictionary *> *)mutations {
     NSMutableArray *result = [NSMutableArray array];
+    NSMutableSet<NSString *> *attributeNames = [NSMutableSet set];
 
     for (id mutation in [mutations reverseObjectEnumerator]) {
         NSString *attributeName = mutation[UAAttributeNameKey];
-        NSPredicate *keyPredicate = [NSPredicate predicateWithFormat:@"key == %@", attributeName];
-
-        NSArray *filtered = [result filteredArrayUsingPredicate:keyPredicate];
 
         // Only add latest instance of any key operation
-        if (filtered.count == 0) {
-            [result insertObject:mutation atIndex:0];
+        if (![attributeNames containsObject:attributeName]) {
+            [attributeNames addObject:attributeName];
+            [result addObject:mutation];
         }
     }
 
-    return [result copy];
+    return [[result reverseObjectEnumerator] allObjects];
 }
 
 - (nullable NSDictionary *)payload {
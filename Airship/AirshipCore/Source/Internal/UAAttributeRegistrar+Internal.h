@@ -6,6 +6,7 @@
 #import "UARuntimeConfig+Internal.h"
 #import "UAPreferenceDataStore.h"
 #import "UAAttributeAPIClient+Internal.h"
+#import "UADispatcher.h"
 
 
 NS_ASSUME_NONNULL_BEGIN
@@ -61,6 +62,39 @@ NS_ASSUME_NONNULL_BEGIN
                        persistentQueue:(UAPersistentQueue *)persistentQueue
                            application:(UIApplication *)application;
 
+/**
+ * Factory method to create an attribute registrar for testing.
+ * @param APIClient The attributes API client.
+ * @param persistentQueue The queue.
+ * @param application The application.
+ * @param dispatcher The dispatcher used to wait out the batch delay.
+ * @param batchDelay How long an update waits for more mutations before uploading.
+ * @return A new attributes registrar instance.
+ */
++ (instancetype)registrarWithAPIClient:(UAAttributeAPIClient *)APIClient
+                       persistentQueue:(UAPersistentQueue *)persistentQueue
+                           application:(UIApplication *)application
+                            dispatcher:(UADispatcher *)dispatcher
+                            batchDelay:(NSTimeInterval)batchDelay;
+
+/**
+ * Factory method to create an attribute registrar for testing.
+ * @param APIClient The attributes API client.
+ * @param persistentQueue The queue.
+ * @param application The application.
+ * @param dispatcher The dispatcher used to wait out the batch delay.
+ * @param batchDelay How long an update waits for more mutations before uploading.
+ * @param maxBatchDelay How long mutations saved during the wait can keep extending it. The wait is not
+ * extended if this is not greater than the batch delay.
+ * @return A new attributes registrar instance.
+ */
++ (instancetype)registrarWithAPIClient:(UAAttributeAPIClient *)APIClient
+                       persistentQueue:(UAPersistentQueue *)persistentQueue
+                           application:(UIApplication *)application
+                            dispatcher:(UADispatcher *)dispatcher
+                            batchDelay:(NSTimeInterval)batchDelay
+                         maxBatchDelay:(NSTimeInterval)maxBatchDelay;
+
 /**
  Method to save pending mutations for asynchronous upload.
  @param mutations The channel attribute mutations to save.
@@ -81,7 +115,8 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)setIdentifier:(nullable NSString *)identifier clearPendingOnChange:(BOOL)clearPendingOnChange;
 
 /**
- * Update attributes
+ * Update attributes. Pending mutations are collapsed and uploaded in a single request. Mutations saved
+ * shortly after the update starts are included in the same request.
  */
 - (void)updateAttributes;
 
@@ -4,12 +4,22 @@
 #import "UAPersistentQueue+Internal.h"
 #import "UAAttributeAPIClient+Internal.h"
 #import "UAAttributeMutations+Internal.h"
-#import "UAAttributePendingMutations.h"
+#import "UAAttributePendingMutations+Internal.h"
+#import "UAMetricsRegistry.h"
 #import "UAUtils.h"
 
 static NSString *const ChannelPersistentQueueKey = @"com.urbanairship.channel_attributes.registrar_persistent_queue_key";
 static NSString *const NamedUserPersistentQueueKey = @"com.urbanairship.named_user_attributes.registrar_persistent_queue_key";
 
+// Time to wait for more mutations so a burst of changes is uploaded in a single request
+static NSTimeInterval const UAAttributeRegistrarBatchDelay = 1;
+
+// Longest a burst of changes can keep pushing the upload back, so frequently updated attributes still upload
+static NSTimeInterval const UAAttributeRegistrarMaxBatchDelay = 5;
+
+// Number of appended mutations kept in the queue before it is rewritten with the reduced attributes
+static NSUInteger const UAAttributeRegistrarCompactionThreshold = 32;
+
 @interface UAAttributeRegistrar()
 @property(nonatomic, strong) UAPersistentQueue *pendingAttributeMutationsQueue;
 @property(nonatomic, strong) UAAttributeAPIClient *client;
@@ -17,6 +27,35 @@ static NSString *const NamedUserPersistentQueueKey = @"com.urbanairship.named_us
 @property(nonatomic, strong) UIApplication *application;
 @property(atomic, copy) NSString *identifier;
 @property(atomic, assign) BOOL updating;
+@property(nonatomic, strong) UADispatcher *dispatcher;
+@property(nonatomic, assign) NSTimeInterval batchDelay;
+@property(nonatomic, assign) NSTimeInterval maxBatchDelay;
+@property(atomic, strong, nullable) UADisposable *batchDisposable;
+
+/**
+ * How long the scheduled upload has waited so far.
+ */
+@property(atomic, assign) NSTimeInterval batchWait;
+
+/**
+ * Whether mutations were saved since the batch delay started. Must be accessed while synchronized on self.
+ */
+@property(nonatomic, assign) BOOL savedDuringBatch;
+
+/**
+ * The latest pending mutation for each attribute, keyed by attribute name.
+ */
+@property(nonatomic, strong, nullable) NSMutableDictionary<NSString *, NSDictionary *> *pendingAttributes;
+
+/**
+ * The pending attribute names, ordered by when they were last written.
+ */
+@property(nonatomic, strong, nullable) NSMutableOrderedSet<NSString *> *pendingAttributeNames;
+
+/**
+ * The number of mutations in the persisted queue.
+ */
+@property(nonatomic, assign) NSUInteger loggedMutationCount;
 @end
 
 @implementation UAAttributeRegistrar
@@ -29,9 +68,14 @@ static NSString *const NamedUserPersistentQueueKey = @"com.urbanairship.named_us
     UAPersistentQueue *queue = [UAPersistentQueue persistentQueueWithDataStore:dataStore
                                                                            key:ChannelPersistentQueueKey];
 
-    return [[UAAttributeRegistrar alloc] initWithAPIClient:[UAAttributeAPIClient channelClientWithConfig:config]
-                                           persistentQueue:queue
-                                               application:[UIApplication sharedApplication]];
+    UAAttributeRegistrar *registrar = [[UAAttributeRegistrar alloc] initWithAPIClient:[UAAttributeAPIClient channelClientWithConfig:config]
+                                                                      persistentQueue:queue
+                                                                          application:[UIApplication sharedApplication]
+                                                                           dispatcher:[UADispatcher globalDispatcherForWorkType:UADispatcherWorkTypeUpload]
+                                                                           batchDelay:UAAttributeRegistrarBatchDelay
+                                                                        maxBatchDelay:UAAttributeRegistrarMaxBatchDelay];
+    [registrar registerPendingMutationsMetric:UAMetricChannelPendingAttributeMutations];
+    return registrar;
 }
 
 + (instancetype)namedUserRegistrarWithConfig:(UARuntimeConfig *)config
@@ -40,9 +84,14 @@ static NSString *const NamedUserPersistentQueueKey = @"com.urbanairship.named_us
     UAPersistentQueue *queue = [UAPersistentQueue persistentQueueWithDataStore:dataStore
                                                                            key:NamedUserPersistentQueueKey];
 
-    return [[UAAttributeRegistrar alloc] initWithAPIClient:[UAAttributeAPIClient namedUserClientWithConfig:config]
-                                           persistentQueue:queue
-                                               application:[UIApplication sharedApplication]];
+    UAAttributeRegistrar *registrar = [[UAAttributeRegistrar alloc] initWithAPIClient:[UAAttributeAPIClient namedUserClientWithConfig:config]
+                                                                      persistentQueue:queue
+                                                                          application:[UIApplication sharedApplication]
+                                                                           dispatcher:[UADispatcher globalDispatcherForWorkType:UADispatcherWorkTypeUpload]
+                                                                           batchDelay:UAAttributeRegistrarBatchDelay
+                                                                        maxBatchDelay:UAAttributeRegistrarMaxBatchDelay];
+    [registrar registerPendingMutationsMetric:UAMetricNamedUserPendingAttributeMutations];
+    return registrar;
 }
 
 + (instancetype)registrarWithAPIClient:(UAAttributeAPIClient *)APIClient
@@ -50,15 +99,51 @@ static NSString *const NamedUserPersistentQueueKey = @"com.urbanairship.named_us
                            application:(UIApplication *)application {
     return [[UAAttributeRegistrar alloc] initWithAPIClient:APIClient
                                            persistentQueue:persistentQueue
-                                               application:application];
+                                               application:application
+                                                dispatcher:[UADispatcher globalDispatcherForWorkType:UADispatcherWorkTypeUpload]
+                                                batchDelay:0
+                                             maxBatchDelay:0];
+}
+
++ (instancetype)registrarWithAPIClient:(UAAttributeAPIClient *)APIClient
+                       persistentQueue:(UAPersistentQueue *)persistentQueue
+                           application:(UIApplication *)application
+                            dispatcher:(UADispatcher *)dispatcher
+                            batchDelay:(NSTimeInterval)batchDelay {
+    return [[UAAttributeRegistrar alloc] initWithAPIClient:APIClient
+                                           persistentQueue:persistentQueue
+                                               application:application
+                                                dispatcher:dispatcher
+                                                batchDelay:batchDelay
+                                             maxBatchDelay:batchDelay];
+}
+
++ (instancetype)registrarWithAPIClient:(UAAttributeAPIClient *)APIClient
+                       persistentQueue:(UAPersistentQueue *)persistentQueue
+                           application:(UIApplication *)application
+                            dispatcher:(UADispatcher *)dispatcher
+                            batchDelay:(NSTimeInterval)batchDelay
+                         maxBatchDelay:(NSTimeInterval)maxBatchDelay {
+    return [[UAAttributeRegistrar alloc] initWithAPIClient:APIClient
+                                           persistentQueue:persistentQueue
+                                               application:application
+                                                dispatcher:dispatcher
+                                                batchDelay:batchDelay
+                                             maxBatchDelay:maxBatchDelay];
 }
 
 - (instancetype)initWithAPIClient:(UAAttributeAPIClient *)APIClient
                   persistentQueue:(UAPersistentQueue *)persistentQueue
-                      application:(UIApplication *)application {
+                      application:(UIApplication *)application
+                       dispatcher:(UADispatcher *)dispatcher
+                       batchDelay:(NSTimeInterval)batchDelay
+                    maxBatchDelay:(NSTimeInterval)maxBatchDelay {
     self = [super init];
     if (self) {
         self.application = application;
+        self.dispatcher = dispatcher;
+        self.batchDelay = batchDelay;
+        self.maxBatchDelay = maxBatchDelay;
         self.client = APIClient;
         self.pendingAttributeMutationsQueue = persistentQueue;
         self.enabled = YES;
@@ -67,27 +152,129 @@ static NSString *const NamedUserPersistentQueueKey = @"com.urbanairship.named_us
     return self;
 }
 
+- (void)registerPendingMutationsMetric:(NSString *)name {
+    UA_WEAKIFY(self)
+    [[UAMetricsRegistry shared] registerGaugeForMetric:name block:^double{
+        UA_STRONGIFY(self)
+        @synchronized (self) {
+            [self loadIfNeeded];
+            return self.pendingAttributeNames.count;
+        }
+    }];
+}
+
+#pragma mark -
+#pragma mark Reduced Attributes
+
+/**
+ * Loads the reduced attributes from the persisted queue. Must be called while synchronized on self.
+ */
+- (void)loadIfNeeded {
+    if (self.pendingAttributes) {
+        return;
+    }
+
+    self.pendingAttributes = [NSMutableDictionary dictionary];
+    self.pendingAttributeNames = [NSMutableOrderedSet orderedSet];
+
+    NSArray<UAAttributePendingMutations *> *mutations = (NSArray<UAAttributePendingMutations *> *)[self.pendingAttributeMutationsQueue objects];
+    for (UAAttributePendingMutations *mutation in mutations) {
+        [self foldMutations:mutation];
+    }
+
+    self.loggedMutationCount = mutations.count;
+    [self compactIfNeeded:0];
+}
+
+/**
+ * Must be called while synchronized on self.
+ */
+- (void)foldMutations:(UAAttributePendingMutations *)mutations {
+    for (NSDictionary *mutation in mutations.mutationsPayload) {
+        NSString *name = mutation[UAAttributeNameKey];
+        if (!name) {
+            continue;
+        }
+
+        // Last write wins, and moves the attribute to the end
+        self.pendingAttributes[name] = mutation;
+        [self.pendingAttributeNames removeObject:name];
+        [self.pendingAttributeNames addObject:name];
+    }
+}
+
+/**
+ * Must be called while synchronized on self.
+ */
+- (nullable UAAttributePendingMutations *)currentMutations {
+    [self loadIfNeeded];
+
+    if (!self.pendingAttributeNames.count) {
+        return nil;
+    }
+
+    NSMutableArray<NSDictionary *> *payload = [NSMutableArray arrayWithCapacity:self.pendingAttributeNames.count];
+    for (NSString *name in self.pendingAttributeNames) {
+        [payload addObject:self.pendingAttributes[name]];
+    }
+
+    return [UAAttributePendingMutations pendingMutationsWithPayload:payload];
+}
+
+/**
+ * Rewrites the persisted queue with the reduced attributes once it has grown more than
+ * `threshold` mutations past them. Must be called while synchronized on self.
+ */
+- (void)compactIfNeeded:(NSUInteger)threshold {
+    UAAttributePendingMutations *mutations = [self currentMutations];
+    NSUInteger count = mutations ? 1 : 0;
+    if (self.loggedMutationCount <= count + threshold) {
+        return;
+    }
+
+    if (mutations) {
+        [self.pendingAttributeMutationsQueue setObjects:@[mutations]];
+    } else {
+        [self.pendingAttributeMutationsQueue clear];
+    }
+
+    self.loggedMutationCount = count;
+}
+
+#pragma mark -
+#pragma mark Pending Mutations
+
 - (void)savePendingMutations:(UAAttributePendingMutations *)mutations {
     if (mutations.mutationsPayload.count == 0) {
         UA_LTRACE(@"UAAttributeRegistrar - Attribute mutation compression resulted in no mutations, skipping save.");
         return;
     }
 
-    [self.pendingAttributeMutationsQueue addObject:mutations];
+    @synchronized (self) {
+        [self loadIfNeeded];
+        [self foldMutations:mutations];
+        self.savedDuringBatch = YES;
+
+        // Append to the queue, and only rewrite it once it has drifted far enough from the reduced attributes
+        [self.pendingAttributeMutationsQueue addObject:mutations];
+        self.loggedMutationCount++;
+        [self compactIfNeeded:UAAttributeRegistrarCompactionThreshold];
+    }
 }
 
 - (void)clearPendingMutations {
-    [self.pendingAttributeMutationsQueue clear];
+    @synchronized (self) {
+        [self.pendingAttributeMutationsQueue clear];
+        self.pendingAttributes = nil;
+        self.pendingAttributeNames = nil;
+        self.loggedMutationCount = 0;
+    }
 }
 
 - (void)collapseQueuedPendingMutations {
-    [self.pendingAttributeMutationsQueue collapse:^NSArray<id<NSCoding>> * (NSArray<id<NSCoding>> *mutations) {
-        if (mutations.count == 0) {
-            return mutations;
-        }
-
-        return @[[UAAttributePendingMutations collapseMutations:(NSArray<UAAttributePendingMutations *>*)mutations]];
-    }];
+    @synchronized (self) {
+        [self compactIfNeeded:0];
+    }
 }
 
 - (void)updateAttributes {
@@ -112,16 +299,67 @@ static NSString *const NamedUserPersistentQueueKey = @"com.urbanairship.named_us
         return;
     }
 
-    [self uploadNextMutationWithBackgroundTaskIdentifier:backgroundTaskIdentifier];
+    if (self.batchDelay <= 0) {
+        [self uploadNextMutationWithBackgroundTaskIdentifier:backgroundTaskIdentifier];
+        return;
+    }
+
+    @synchronized (self) {
+        self.savedDuringBatch = NO;
+    }
+
+    self.batchWait = 0;
+    [self scheduleBatchedUploadWithBackgroundTaskIdentifier:backgroundTaskIdentifier];
+}
+
+/**
+ * Waits out the batch delay before uploading. Mutations saved during the delay are collapsed into
+ * the same upload, and push it back by another delay until the max batch delay is reached.
+ */
+- (void)scheduleBatchedUploadWithBackgroundTaskIdentifier:(UIBackgroundTaskIdentifier)backgroundTaskIdentifier {
+    UA_WEAKIFY(self);
+    self.batchDisposable = [self.dispatcher dispatchAfter:self.batchDelay block:^{
+        UA_STRONGIFY(self);
+        self.batchDisposable = nil;
+        self.batchWait += self.batchDelay;
+
+        BOOL extend = NO;
+        @synchronized (self) {
+            if (self.savedDuringBatch && self.batchWait + self.batchDelay <= self.maxBatchDelay) {
+                self.savedDuringBatch = NO;
+                extend = YES;
+            }
+        }
+
+        if (extend) {
+            UA_LTRACE(@"Attributes changed during the batch delay, delaying upload");
+            [self scheduleBatchedUploadWithBackgroundTaskIdentifier:backgroundTaskIdentifier];
+        } else {
+            [self uploadNextMutationWithBackgroundTaskIdentifier:backgroundTaskIdentifier];
+        }
+    }];
 }
 
 - (void)popPendingMutations:(UAAttributePendingMutations *)mutations
                  identifier:(NSString *)identifier {
     @synchronized (self) {
-        // Pop the mutation if it is what we expect and the identifier has not changed
-        if ([mutations isEqual:self.pendingAttributeMutationsQueue.peekObject] && [identifier isEqualToString:self.identifier]) {
-            [self.pendingAttributeMutationsQueue popObject];
+        // Only pop if the identifier has not changed
+        if (![identifier isEqualToString:self.identifier]) {
+            return;
+        }
+
+        [self loadIfNeeded];
+
+        // Drop the uploaded attributes, unless they were written again during the upload
+        for (NSDictionary *mutation in mutations.mutationsPayload) {
+            NSString *name = mutation[UAAttributeNameKey];
+            if (name && [self.pendingAttributes[name] isEqualToDictionary:mutation]) {
+                [self.pendingAttributes removeObjectForKey:name];
+                [self.pendingAttributeNames removeObject:name];
+            }
         }
+
+        [self compactIfNeeded:0];
     }
 }
 
@@ -130,11 +368,9 @@ static NSString *const NamedUserPersistentQueueKey = @"com.urbanairship.named_us
     NSString *identifier;
 
     @synchronized (self) {
-        // collapse mutations
-        [self collapseQueuedPendingMutations];
-
-        // peek mutations
-        mutations = (UAAttributePendingMutations *)[self.pendingAttributeMutationsQueue peekObject];
+        // compact and peek mutations
+        [self compactIfNeeded:0];
+        mutations = [self currentMutations];
         identifier = self.identifier;
     }
 
@@ -174,6 +410,8 @@ static NSString *const NamedUserPersistentQueueKey = @"com.urbanairship.named_us
         UA_STRONGIFY(self);
 
         UA_LTRACE(@"Attribute background task expired.");
+        [self.batchDisposable dispose];
+        self.batchDisposable = nil;
         [self.client cancelAllRequests];
 
         [self endUploading:backgroundTaskIdentifier];
@@ -216,8 +454,9 @@ static NSString *const NamedUserPersistentQueueKey = @"com.urbanairship.named_us
 }
 
 - (UAAttributePendingMutations *)pendingMutations {
-    NSArray *combined = [self.pendingAttributeMutationsQueue objects];
-    return [UAAttributePendingMutations collapseMutations:combined];
+    @synchronized (self) {
+        return [self currentMutations] ?: [UAAttributePendingMutations pendingMutationsWithPayload:@[]];
+    }
 }
 
 @end
@@ -0,0 +1,42 @@
+/* Copyright Airship and Contributors */
+
+#import "UABackgroundWorkScheduler.h"
+
+@class UAWorkScheduler;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface UABackgroundWorkScheduler ()
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param notificationCenter The notification center.
+ * @param permittedIdentifiers The task identifiers the app permits.
+ * @param workScheduler The work scheduler the work is submitted to.
+ * @return A scheduler instance.
+ */
++ (instancetype)schedulerWithNotificationCenter:(NSNotificationCenter *)notificationCenter
+                           permittedIdentifiers:(NSArray<NSString *> *)permittedIdentifiers
+                                  workScheduler:(UAWorkScheduler *)workScheduler;
+
+/**
+ * Registers the background tasks with the system. Must be called before the app finishes launching.
+ * Does nothing if the app does not permit the task identifiers or the OS does not support them.
+ */
+- (void)registerTasks;
+
+/**
+ * Runs all the work of a type. The completion handler is called once, when all the work has
+ * finished or the returned disposable is disposed. Work deferred because the budget is spent
+ * counts as finished, and the next background task is requested for it.
+ *
+ * @param type The work type.
+ * @param completionHandler The completion handler, with `YES` if all the work succeeded.
+ * @return A disposable that stops the work.
+ */
+- (UADisposable *)performWorkWithType:(UABackgroundWorkType)type completionHandler:(void (^)(BOOL success))completionHandler;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,311 @@
+/* Copyright Airship and Contributors */
+
+#import "UABackgroundWorkScheduler+Internal.h"
+#import "UAAppStateTracker.h"
+#import "UADispatcher.h"
+#import "UAGlobal.h"
+#import "UAWorkScheduler+Internal.h"
+
+#if !TARGET_OS_TV
+#import <BackgroundTasks/BackgroundTasks.h>
+#endif
+
+NSString *const UABackgroundRefreshTaskIdentifier = @"com.urbanairship.refresh";
+NSString *const UABackgroundProcessingTaskIdentifier = @"com.urbanairship.processing";
+
+// Earliest delays before the system runs the next window, once the app is backgrounded
+static NSTimeInterval const UABackgroundRefreshDelay = 15 * 60;
+static NSTimeInterval const UABackgroundProcessingDelay = 60 * 60;
+
+@interface UABackgroundWorkScheduler ()
+@property (nonatomic, strong) NSNotificationCenter *notificationCenter;
+@property (nonatomic, copy) NSArray<NSString *> *permittedIdentifiers;
+@property (nonatomic, strong) UAWorkScheduler *workScheduler;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, UABackgroundWorkBlock> *refreshWork;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, UABackgroundWorkBlock> *processingWork;
+@property (nonatomic, assign) BOOL tasksRegistered;
+@end
+
+@implementation UABackgroundWorkScheduler
+
+- (instancetype)initWithNotificationCenter:(NSNotificationCenter *)notificationCenter
+                      permittedIdentifiers:(NSArray<NSString *> *)permittedIdentifiers
+                             workScheduler:(UAWorkScheduler *)workScheduler {
+    self = [super init];
+
+    if (self) {
+        self.notificationCenter = notificationCenter;
+        self.permittedIdentifiers = permittedIdentifiers;
+        self.workScheduler = workScheduler;
+        self.refreshWork = [NSMutableDictionary dictionary];
+        self.processingWork = [NSMutableDictionary dictionary];
+    }
+
+    return self;
+}
+
++ (instancetype)shared {
+    static dispatch_once_t onceToken;
+    static UABackgroundWorkScheduler *_shared;
+    dispatch_once(&onceToken, ^{
+        NSArray *identifiers = [[NSBundle mainBundle] objectForInfoDictionaryKey:@"BGTaskSchedulerPermittedIdentifiers"];
+        _shared = [self schedulerWithNotificationCenter:[NSNotificationCenter defaultCenter]
+                                   permittedIdentifiers:[identifiers isKindOfClass:[NSArray class]] ? identifiers : @[]
+                                          workScheduler:[UAWorkScheduler shared]];
+    });
+
+    return _shared;
+}
+
++ (instancetype)schedulerWithNotificationCenter:(NSNotificationCenter *)notificationCenter
+                           permittedIdentifiers:(NSArray<NSString *> *)permittedIdentifiers
+                                  workScheduler:(UAWorkScheduler *)workScheduler {
+    return [[self alloc] initWithNotificationCenter:notificationCenter
+                               permittedIdentifiers:permittedIdentifiers
+                                      workScheduler:workScheduler];
+}
+
+- (void)dealloc {
+    [self.notificationCenter removeObserver:self];
+}
+
+- (NSMutableDictionary<NSString *, UABackgroundWorkBlock> *)workWithType:(UABackgroundWorkType)type {
+    return type == UABackgroundWorkTypeProcessing ? self.processingWork : self.refreshWork;
+}
+
+- (void)registerWorkWithName:(NSString *)name type:(UABackgroundWorkType)type block:(UABackgroundWorkBlock)block {
+    @synchronized (self) {
+        [self workWithType:type][name] = [block copy];
+    }
+}
+
+- (UADisposable *)performWorkWithType:(UABackgroundWorkType)type completionHandler:(void (^)(BOOL success))completionHandler {
+    NSDictionary<NSString *, UABackgroundWorkBlock> *work;
+    @synchronized (self) {
+        work = [[self workWithType:type] copy];
+    }
+
+    // Refreshes are deferred to the next window once the budget is spent, processing work is skipped
+    UAWorkPriority priority = type == UABackgroundWorkTypeProcessing ? UAWorkPriorityLow : UAWorkPriorityDefault;
+
+    __block BOOL finished = NO;
+    __block BOOL succeeded = YES;
+    __block BOOL deferred = NO;
+    NSMutableArray<UADisposable *> *disposables = [NSMutableArray array];
+
+    void (^finish)(BOOL) = ^(BOOL success) {
+        @synchronized (disposables) {
+            if (finished) {
+                return;
+            }
+            finished = YES;
+        }
+        completionHandler(success);
+    };
+
+    dispatch_group_t group = dispatch_group_create();
+    for (NSString *name in work) {
+        UABackgroundWorkBlock block = work[name];
+        dispatch_group_enter(group);
+
+        __block BOOL left = NO;
+        void (^leave)(BOOL) = ^(BOOL success) {
+            @synchronized (disposables) {
+                if (left) {
+                    return;
+                }
+                left = YES;
+                succeeded = succeeded && success;
+            }
+            dispatch_group_leave(group);
+        };
+
+        // Deferred work is removed from the scheduler and runs again in the next background task,
+        // so it does not hold up this one. It may be deferred before the disposable is returned.
+        __block UADisposable *disposable;
+        __block BOOL jobDeferred = NO;
+
+        UADisposable *submitted = [self.workScheduler submitWorkWithName:name
+                                                                priority:priority
+                                                                deadline:0
+                                                              dispatcher:nil
+                                                                   block:^UADisposable *(void (^workCompletionHandler)(void)) {
+            return block(^(BOOL success) {
+                workCompletionHandler();
+                leave(success);
+            });
+        } dropHandler:^{
+            leave(YES);
+        } deferHandler:^{
+            UADisposable *deferredDisposable;
+            @synchronized (disposables) {
+                deferred = YES;
+                jobDeferred = YES;
+                deferredDisposable = disposable;
+            }
+
+            [deferredDisposable dispose];
+            leave(YES);
+        }];
+
+        BOOL disposeNow;
+        @synchronized (disposables) {
+            disposable = submitted;
+            disposeNow = jobDeferred;
+            if (!jobDeferred && submitted) {
+                [disposables addObject:submitted];
+            }
+        }
+
+        if (disposeNow) {
+            [submitted dispose];
+        }
+    }
+
+    UA_WEAKIFY(self)
+    dispatch_group_notify(group, dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        UA_STRONGIFY(self)
+        BOOL success;
+        BOOL reschedule;
+        @synchronized (disposables) {
+            success = succeeded;
+            reschedule = deferred;
+        }
+
+        if (reschedule) {
+            [self rescheduleWorkWithType:type];
+        }
+
+        finish(success);
+    });
+
+    return [UADisposable disposableWithBlock:^{
+        // Finish first so work completing as it is disposed does not report success
+        finish(NO);
+
+        NSArray<UADisposable *> *pending;
+        @synchronized (disposables) {
+            pending = [disposables copy];
+            [disposables removeAllObjects];
+        }
+
+        for (UADisposable *disposable in pending) {
+            [disposable dispose];
+        }
+    }];
+}
+
+- (void)rescheduleWorkWithType:(UABackgroundWorkType)type {
+#if !TARGET_OS_TV
+    if (@available(iOS 13.0, *)) {
+        UA_LDEBUG(@"Background work deferred, scheduling the next window");
+        [self submitRequestWithType:type];
+    }
+#endif
+}
+
+#pragma mark -
+#pragma mark Background Tasks
+
+- (void)registerTasks {
+#if !TARGET_OS_TV
+    if (@available(iOS 13.0, *)) {
+        @synchronized (self) {
+            if (self.tasksRegistered) {
+                return;
+            }
+            self.tasksRegistered = YES;
+        }
+
+        BOOL registered = NO;
+        UA_WEAKIFY(self)
+        if ([self.permittedIdentifiers containsObject:UABackgroundRefreshTaskIdentifier]) {
+            registered = [[BGTaskScheduler sharedScheduler] registerForTaskWithIdentifier:UABackgroundRefreshTaskIdentifier usingQueue:nil launchHandler:^(BGTask *task) {
+                UA_STRONGIFY(self)
+                [self handleTask:task type:UABackgroundWorkTypeRefresh];
+            }] || registered;
+        }
+
+        if ([self.permittedIdentifiers containsObject:UABackgroundProcessingTaskIdentifier]) {
+            registered = [[BGTaskScheduler sharedScheduler] registerForTaskWithIdentifier:UABackgroundProcessingTaskIdentifier usingQueue:nil launchHandler:^(BGTask *task) {
+                UA_STRONGIFY(self)
+                [self handleTask:task type:UABackgroundWorkTypeProcessing];
+            }] || registered;
+        }
+
+        if (!registered) {
+            UA_LDEBUG(@"Background task identifiers not permitted, deferred work will only run in background tasks");
+            return;
+        }
+
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(applicationDidEnterBackground)
+                                        name:UAApplicationDidEnterBackgroundNotification
+                                      object:nil];
+    }
+#endif
+}
+
+#if !TARGET_OS_TV
+- (void)applicationDidEnterBackground API_AVAILABLE(ios(13.0)) {
+    // Submitting requests can block, keep it off the main queue
+    [[UADispatcher globalDispatcher:QOS_CLASS_UTILITY] dispatchAsync:^{
+        [self submitRequestWithType:UABackgroundWorkTypeRefresh];
+        [self submitRequestWithType:UABackgroundWorkTypeProcessing];
+    }];
+}
+
+- (void)submitRequestWithType:(UABackgroundWorkType)type API_AVAILABLE(ios(13.0)) {
+    @synchronized (self) {
+        if (![self workWithType:type].count) {
+            return;
+        }
+    }
+
+    BGTaskRequest *request;
+    if (type == UABackgroundWorkTypeProcessing) {
+        if (![self.permittedIdentifiers containsObject:UABackgroundProcessingTaskIdentifier]) {
+            return;
+        }
+
+        BGProcessingTaskRequest *processingRequest = [[BGProcessingTaskRequest alloc] initWithIdentifier:UABackgroundProcessingTaskIdentifier];
+        processingRequest.requiresNetworkConnectivity = YES;
+        processingRequest.earliestBeginDate = [NSDate dateWithTimeIntervalSinceNow:UABackgroundProcessingDelay];
+        request = processingRequest;
+    } else {
+        if (![self.permittedIdentifiers containsObject:UABackgroundRefreshTaskIdentifier]) {
+            return;
+        }
+
+        request = [[BGAppRefreshTaskRequest alloc] initWithIdentifier:UABackgroundRefreshTaskIdentifier];
+        request.earliestBeginDate = [NSDate dateWithTimeIntervalSinceNow:UABackgroundRefreshDelay];
+    }
+
+    NSError *error;
+    if (![[BGTaskScheduler sharedScheduler] submitTaskRequest:request error:&error]) {
+        UA_LDEBUG(@"Unable to schedule background task %@: %@", request.identifier, error);
+    }
+}
+
+- (void)handleTask:(BGTask *)task type:(UABackgroundWorkType)type API_AVAILABLE(ios(13.0)) {
+    UA_LTRACE(@"Running background task %@", task.identifier);
+
+    // Requests are one-shot, schedule the next window before running this one
+    [self submitRequestWithType:type];
+
+    UAWorkLaunchType launchType = type == UABackgroundWorkTypeProcessing ? UAWorkLaunchTypeBackgroundProcessing : UAWorkLaunchTypeBackgroundFetch;
+    [self.workScheduler beginWindowWithLaunchType:launchType];
+
+    UADisposable *disposable = [self performWorkWithType:type completionHandler:^(BOOL success) {
+        UA_LTRACE(@"Background task %@ finished: %d", task.identifier, success);
+        [task setTaskCompletedWithSuccess:success];
+    }];
+
+    task.expirationHandler = ^{
+        UA_LTRACE(@"Background task %@ expired", task.identifier);
+        [disposable dispose];
+    };
+}
+#endif
+
+@end
@@ -10,6 +10,9 @@
 #import "UADate.h"
 #import "UAAppStateTracker.h"
 #import "UALocaleManager+Internal.h"
+#import "UATagEditor+Internal.h"
+#import "UANetworkMonitor.h"
+#import "UANetworkWindow.h"
 
 NSString *const UAChannelTagsSettingsKey = @"com.urbanairship.channel.tags";
 
@@ -33,6 +36,8 @@ NSString *const UAChannelUpdatedEventChannelKey = @"com.urbanairship.channel.ide
 
 NSString *const UAChannelCreationOnForeground = @"com.urbanairship.channel.creation_on_foreground";
 
+static NSTimeInterval const UAChannelExtenderTimeout = 10;
+
 @interface UAChannel ()
 @property (nonatomic, strong) UAPreferenceDataStore *dataStore;
 @property (nonatomic, strong) NSNotificationCenter *notificationCenter;
@@ -44,6 +49,30 @@ NSString *const UAChannelCreationOnForeground = @"com.urbanairship.channel.creat
 @property (nonatomic, assign) BOOL shouldPerformChannelRegistrationOnForeground;
 @property (nonatomic, strong) NSMutableArray<UAChannelRegistrationExtenderBlock> *registrationExtenderBlocks;
 @property (nonatomic, strong) UADate *date;
+@property (nonatomic, strong, nullable) NSOrderedSet<NSString *> *cachedTags;
+@property (nonatomic, strong, nullable) NSSet<NSString *> *cachedTagSet;
+
+/**
+ * The last payload built by the extenders. Cleared whenever one of the payload inputs changes.
+ */
+@property (nonatomic, strong, nullable) UAChannelRegistrationPayload *cachedPayload;
+
+/**
+ * Set when the last registration attempt failed, so it is retried when the network returns.
+ */
+@property (atomic, assign) BOOL registrationFailedSinceUpdate;
+
+/**
+ * Incremented each time the cached payload is invalidated, so a payload that was being built
+ * while an input changed is not cached.
+ */
+@property (nonatomic, assign) NSUInteger payloadGeneration;
+
+/**
+ * The last fields each extender changed, keyed by the extender's index. Reused when an
+ * extender times out.
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSNumber *, NSDictionary *> *extenderFragments;
 @end
 
 @implementation UAChannel
@@ -70,6 +99,7 @@ NSString *const UAChannelCreationOnForeground = @"com.urbanairship.channel.creat
 
         self.channelTagRegistrationEnabled = YES;
         self.registrationExtenderBlocks = [NSMutableArray array];
+        self.extenderFragments = [NSMutableDictionary dictionary];
 
         self.tagGroupsRegistrar.delegate = self;
         [self.tagGroupsRegistrar setIdentifier:self.identifier clearPendingOnChange:NO];
@@ -157,12 +187,23 @@ NSString *const UAChannelCreationOnForeground = @"com.urbanairship.channel.creat
                                   object:nil];
     
     [self.notificationCenter addObserver:self
-                                selector:@selector(localeUpdated)
-                                    name:UALocaleUpdatedEvent
+                                selector:@selector(deviceContextChanged)
+                                    name:UADeviceContextChangedEvent
+                                  object:nil];
+
+    [self.notificationCenter addObserver:self
+                                selector:@selector(networkConnectivityChanged)
+                                    name:UANetworkConnectivityChangedEvent
+                                  object:nil];
+
+    [self.notificationCenter addObserver:self
+                                selector:@selector(networkWindowOpened)
+                                    name:UANetworkWindowOpenedEvent
                                   object:nil];
 }
 
 - (void)reset {
+    [self invalidateCachedPayload];
     [self.channelRegistrar resetChannel];
 }
 
@@ -184,7 +225,7 @@ NSString *const UAChannelCreationOnForeground = @"com.urbanairship.channel.creat
 - (void)applicationDidTransitionToForeground {
     if (self.shouldPerformChannelRegistrationOnForeground) {
         UA_LTRACE(@"Application did become active. Updating registration.");
-        [self updateRegistration];
+        [self refreshRegistration];
     }
 }
 
@@ -195,7 +236,30 @@ NSString *const UAChannelCreationOnForeground = @"com.urbanairship.channel.creat
     // Create a channel if we do not have a channel ID
     if (!self.identifier) {
         UA_LTRACE(@"Application entered the background without a channel ID. Updating registration.");
-        [self updateRegistration];
+        [self refreshRegistration];
+    }
+}
+
+- (void)networkConnectivityChanged {
+    if (self.registrationFailedSinceUpdate && [UANetworkMonitor shared].isConnected) {
+        UA_LTRACE(@"Network connectivity restored. Retrying registration.");
+        self.registrationFailedSinceUpdate = NO;
+        [self refreshRegistration];
+    }
+}
+
+- (void)networkWindowOpened {
+    if (!self.componentEnabled || !self.identifier) {
+        return;
+    }
+
+    // Flush pending mutations while the radio is already awake
+    if (self.tagGroupsRegistrar.pendingMutations.count) {
+        [self.tagGroupsRegistrar updateTagGroups];
+    }
+
+    if (self.attributeRegistrar.pendingMutations) {
+        [self.attributeRegistrar updateAttributes];
     }
 }
 
@@ -207,21 +271,79 @@ NSString *const UAChannelCreationOnForeground = @"com.urbanairship.channel.creat
 #pragma mark -
 #pragma mark Channel Tags
 
+/**
+ * The current tags. Loaded from the data store once, then kept in memory. Must be called
+ * while synchronized on self.
+ */
+- (NSOrderedSet<NSString *> *)currentTags {
+    if (!self.cachedTags) {
+        NSArray *storedTags = [self.dataStore objectForKey:UAChannelTagsSettingsKey];
+        self.cachedTags = [NSOrderedSet orderedSetWithArray:storedTags ?: @[]];
+    }
+
+    return self.cachedTags;
+}
+
+/**
+ * Saves the tags. Must be called while synchronized on self.
+ */
+- (void)storeTags:(NSOrderedSet<NSString *> *)tags {
+    self.cachedTags = tags;
+    self.cachedTagSet = nil;
+    [self.dataStore setObject:tags.array forKey:UAChannelTagsSettingsKey];
+    [self invalidateCachedPayload];
+}
+
 - (NSArray *)tags {
-    NSArray *currentTags = [self.dataStore objectForKey:UAChannelTagsSettingsKey];
-    if (!currentTags) {
-        currentTags = [NSArray array];
+    @synchronized (self) {
+        return [self currentTags].array;
     }
-    return currentTags;
 }
 
-- (void)setTags:(NSArray *)tags {
+- (NSSet<NSString *> *)tagSet {
+    @synchronized (self) {
+        if (!self.cachedTagSet) {
+            self.cachedTagSet = [[self currentTags].set copy];
+        }
+
+        return self.cachedTagSet;
+    }
+}
+
+/**
+ * Applies tag edits without updating the registration.
+ *
+ * @return YES if the tags changed, otherwise NO.
+ */
+- (BOOL)applyTagEdits:(void (^)(UATagEditor *editor))editorBlock {
     if (!self.isDataCollectionEnabled) {
-        UA_LWARN(@"Unable to modify channel tags %@ when data collection is disabled.", [tags description]);
-        return;
+        UA_LWARN(@"Unable to modify channel tags when data collection is disabled.");
+        return NO;
     }
 
-    [self.dataStore setObject:[UATagUtils normalizeTags:tags] forKey:UAChannelTagsSettingsKey];
+    @synchronized (self) {
+        UATagEditor *editor = [UATagEditor editorWithTags:[self currentTags]];
+        editorBlock(editor);
+
+        if (!editor.isModified) {
+            return NO;
+        }
+
+        [self storeTags:editor.tags];
+        return YES;
+    }
+}
+
+- (void)editTags:(void (^)(UATagEditor *))editorBlock {
+    if ([self applyTagEdits:editorBlock]) {
+        [self updateRegistration];
+    }
+}
+
+- (void)setTags:(NSArray *)tags {
+    [self applyTagEdits:^(UATagEditor *editor) {
+        [editor setTags:tags];
+    }];
 }
 
 - (void)addTag:(NSString *)tag {
@@ -229,9 +351,9 @@ NSString *const UAChannelCreationOnForeground = @"com.urbanairship.channel.creat
 }
 
 - (void)addTags:(NSArray *)tags {
-    NSMutableSet *updatedTags = [NSMutableSet setWithArray:self.tags];
-    [updatedTags addObjectsFromArray:tags];
-    [self setTags:[updatedTags allObjects]];
+    [self applyTagEdits:^(UATagEditor *editor) {
+        [editor addTags:tags];
+    }];
 }
 
 - (void)removeTag:(NSString *)tag {
@@ -239,14 +361,9 @@ NSString *const UAChannelCreationOnForeground = @"com.urbanairship.channel.creat
 }
 
 - (void)removeTags:(NSArray *)tags {
-    if (!self.isDataCollectionEnabled) {
-        UA_LWARN(@"Unable to modify channel tags %@ when data collection is disabled.", [tags description]);
-        return;
-    }
-
-    NSMutableArray *mutableTags = [NSMutableArray arrayWithArray:self.tags];
-    [mutableTags removeObjectsInArray:tags];
-    [self.dataStore setObject:mutableTags forKey:UAChannelTagsSettingsKey];
+    [self applyTagEdits:^(UATagEditor *editor) {
+        [editor removeTags:tags];
+    }];
 }
 
 #pragma mark -
@@ -328,6 +445,12 @@ NSString *const UAChannelCreationOnForeground = @"com.urbanairship.channel.creat
 }
 
 - (void)updateRegistrationForcefully:(BOOL)forcefully {
+    // Components call this when something they add to the payload changes
+    [self invalidateCachedPayload];
+    [self performRegistrationForcefully:forcefully];
+}
+
+- (void)performRegistrationForcefully:(BOOL)forcefully {
     if (!self.componentEnabled) {
         return;
     }
@@ -342,11 +465,32 @@ NSString *const UAChannelCreationOnForeground = @"com.urbanairship.channel.creat
 }
 
 - (void)updateRegistration {
+    [self invalidateCachedPayload];
+    [self refreshRegistration];
+}
+
+/**
+ * Updates the registration without invalidating the cached payload. Used when nothing
+ * the payload is built from is known to have changed.
+ */
+- (void)refreshRegistration {
     if (self.identifier) {
         [self.attributeRegistrar updateAttributes];
         [self.tagGroupsRegistrar updateTagGroups];
     }
-    [self updateRegistrationForcefully:NO];
+    [self performRegistrationForcefully:NO];
+}
+
+- (void)invalidateCachedPayload {
+    @synchronized (self) {
+        self.payloadGeneration++;
+        self.cachedPayload = nil;
+    }
+}
+
+- (void)setChannelTagRegistrationEnabled:(BOOL)channelTagRegistrationEnabled {
+    _channelTagRegistrationEnabled = channelTagRegistrationEnabled;
+    [self invalidateCachedPayload];
 }
 
 - (NSArray<UATagGroupsMutation *> *)pendingTagGroups {
@@ -366,6 +510,21 @@ NSString *const UAChannelCreationOnForeground = @"com.urbanairship.channel.creat
 - (void)createChannelPayload:(void (^)(UAChannelRegistrationPayload *))completionHandler
                   dispatcher:(nullable UADispatcher *)dispatcher {
 
+    NSUInteger generation;
+    UAChannelRegistrationPayload *cachedPayload;
+    @synchronized (self) {
+        generation = self.payloadGeneration;
+        cachedPayload = [self.cachedPayload copy];
+    }
+
+    if (cachedPayload) {
+        UA_LTRACE(@"Channel registration inputs are unchanged, reusing the last payload.");
+        [dispatcher dispatchAsync:^{
+            completionHandler(cachedPayload);
+        }];
+        return;
+    }
+
     UAChannelRegistrationPayload *payload = [[UAChannelRegistrationPayload alloc] init];
     
     NSLocale *currentLocale = [self.localeManager currentLocale];
@@ -390,8 +549,14 @@ NSString *const UAChannelCreationOnForeground = @"com.urbanairship.channel.creat
         payload.carrier = [UAUtils carrierName];
     }
 
-    id extendersCopy = [self.registrationExtenderBlocks mutableCopy];
-    [UAChannel extendPayload:payload extenders:extendersCopy completionHandler:^(UAChannelRegistrationPayload *payload) {
+    NSArray *extendersCopy = [self.registrationExtenderBlocks copy];
+    [self extendPayload:payload extenders:extendersCopy completionHandler:^(UAChannelRegistrationPayload *payload) {
+        @synchronized (self) {
+            if (generation == self.payloadGeneration) {
+                self.cachedPayload = [payload copy];
+            }
+        }
+
         [dispatcher dispatchAsync:^{
             completionHandler(payload);
         }];
@@ -400,6 +565,7 @@ NSString *const UAChannelCreationOnForeground = @"com.urbanairship.channel.creat
 
 - (void)registrationSucceeded {
     UA_LINFO(@"Channel registration updated successfully.");
+    self.registrationFailedSinceUpdate = NO;
 
     NSString *channelID = self.identifier;
 
@@ -415,6 +581,7 @@ NSString *const UAChannelCreationOnForeground = @"com.urbanairship.channel.creat
 
 - (void)registrationFailed {
     UA_LINFO(@"Channel registration failed.");
+    self.registrationFailedSinceUpdate = YES;
 
     [self.notificationCenter postNotificationName:UAChannelRegistrationFailedEvent
                                            object:self
@@ -476,7 +643,9 @@ NSString *const UAChannelCreationOnForeground = @"com.urbanairship.channel.creat
 
     if (!self.isDataCollectionEnabled) {
         // Clear channel tags and pending mutations
-        [self.dataStore setObject:@[] forKey:UAChannelTagsSettingsKey];
+        @synchronized (self) {
+            [self storeTags:[NSOrderedSet orderedSet]];
+        }
         [self.attributeRegistrar clearPendingMutations];
         [self.tagGroupsRegistrar clearPendingMutations];
     }
@@ -486,31 +655,87 @@ NSString *const UAChannelCreationOnForeground = @"com.urbanairship.channel.creat
 
 - (void)addChannelExtenderBlock:(UAChannelRegistrationExtenderBlock)extender {
     [self.registrationExtenderBlocks addObject:extender];
+    [self invalidateCachedPayload];
 }
 
 /**
- * Helper method to extend the CRA payload sequentially with extender blocks.
+ * Helper method to extend the CRA payload with extender blocks.
+ *
+ * The extenders run concurrently, each on its own copy of the payload. The fields each one
+ * changes are merged in registration order once they have all finished. An extender that
+ * does not finish within the timeout contributes the fields it changed last time instead.
+ *
  * @param payload The CRA payload.
- * @param remainingExtenderBlocks The remaining extender blocks.
- * @param completionHandler The completion handler.
+ * @param extenders The extender blocks.
+ * @param completionHandler The completion handler. Called on the main queue.
  */
-+ (void)extendPayload:(UAChannelRegistrationPayload *)payload
-            extenders:(NSMutableArray<UAChannelRegistrationExtenderBlock> *)remainingExtenderBlocks
+- (void)extendPayload:(UAChannelRegistrationPayload *)payload
+            extenders:(NSArray<UAChannelRegistrationExtenderBlock> *)extenders
     completionHandler:(void (^)(UAChannelRegistrationPayload *))completionHandler {
 
-    if (!remainingExtenderBlocks.count) {
+    if (!extenders.count) {
         completionHandler(payload);
         return;
     }
 
-    UAChannelRegistrationExtenderBlock block = remainingExtenderBlocks.firstObject;
-    [remainingExtenderBlocks removeObjectAtIndex:0];
+    dispatch_group_t group = dispatch_group_create();
+    NSMutableArray<NSDictionary *> *fragments = [NSMutableArray arrayWithCapacity:extenders.count];
+
+    for (NSUInteger i = 0; i < extenders.count; i++) {
+        [fragments addObject:@{}];
+    }
+
+    [extenders enumerateObjectsUsingBlock:^(UAChannelRegistrationExtenderBlock block, NSUInteger index, BOOL *stop) {
+        dispatch_group_enter(group);
+
+        __block BOOL finished = NO;
+        __block UADisposable *timeout;
+        void (^finish)(NSDictionary *, BOOL) = ^(NSDictionary *fragment, BOOL timedOut) {
+            @synchronized (fragments) {
+                if (finished) {
+                    return;
+                }
+
+                finished = YES;
+                fragments[index] = fragment ?: @{};
+            }
+
+            if (timedOut) {
+                UA_LDEBUG(@"Channel registration extender %lu timed out, reusing its last fields.", (unsigned long)index);
+            } else {
+                [timeout dispose];
+            }
+
+            dispatch_group_leave(group);
+        };
+
+        timeout = [[UADispatcher mainDispatcher] dispatchAfter:UAChannelExtenderTimeout block:^{
+            NSDictionary *lastFragment;
+            @synchronized (self) {
+                lastFragment = self.extenderFragments[@(index)];
+            }
+            finish(lastFragment, YES);
+        }];
 
-    [[UADispatcher mainDispatcher] dispatchAsyncIfNecessary:^{
-        block(payload, ^(UAChannelRegistrationPayload *payload) {
-                [self extendPayload:payload extenders:remainingExtenderBlocks completionHandler:completionHandler];
-        });
+        UAChannelRegistrationPayload *fragmentPayload = [payload copy];
+        [[UADispatcher mainDispatcher] dispatchAsyncIfNecessary:^{
+            block(fragmentPayload, ^(UAChannelRegistrationPayload *extendedPayload) {
+                NSDictionary *fragment = [extendedPayload fieldsChangedFromPayload:payload];
+                @synchronized (self) {
+                    self.extenderFragments[@(index)] = fragment;
+                }
+                finish(fragment, NO);
+            });
+        }];
     }];
+
+    dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+        UAChannelRegistrationPayload *extendedPayload = [payload copy];
+        for (NSDictionary *fragment in fragments) {
+            [extendedPayload applyFields:fragment];
+        }
+        completionHandler(extendedPayload);
+    });
 }
 
 #pragma mark -
@@ -527,9 +752,9 @@ NSString *const UAChannelCreationOnForeground = @"com.urbanairship.channel.creat
 }
 
 #pragma mark -
-#pragma mark Locale update
+#pragma mark Device context update
 
-- (void)localeUpdated {
+- (void)deviceContextChanged {
     [self updateRegistrationForcefully:NO];
 }
 
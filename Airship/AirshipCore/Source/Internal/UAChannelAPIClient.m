@@ -35,11 +35,12 @@ NSString * const UAChannelAPIClientErrorDomain = @"com.urbanairship.channel_api_
         builder.username = self.config.appKey;
         builder.password = self.config.appSecret;
         builder.body = [payload asJSONData];
+        builder.priority = NSURLSessionTaskPriorityHigh;
         [builder setValue:@"application/vnd.urbanairship+json; version=3;" forHeader:@"Accept"];
         [builder setValue:@"application/json" forHeader:@"Content-Type"];
     }];
 
-    [self.session dataTaskWithRequest:request retryWhere:^BOOL(NSData *data, NSURLResponse *response) {
+    [self dataTaskWithRequest:request requestKey:[UAAPIClient requestKeyForRequest:request] retryWhere:^BOOL(NSData *data, NSURLResponse *response) {
         return [response hasRetriableStatus];
     } completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
         NSHTTPURLResponse *httpResponse = [self castResponse:response error:&error];
@@ -85,11 +86,12 @@ NSString * const UAChannelAPIClientErrorDomain = @"com.urbanairship.channel_api_
         builder.username = self.config.appKey;
         builder.password = self.config.appSecret;
         builder.body = [payload asJSONData];
+        builder.priority = NSURLSessionTaskPriorityHigh;
         [builder setValue:@"application/vnd.urbanairship+json; version=3;" forHeader:@"Accept"];
         [builder setValue:@"application/json" forHeader:@"Content-Type"];
     }];
 
-    [self.session dataTaskWithRequest:request retryWhere:^BOOL(NSData *data, NSURLResponse *response) {
+    [self dataTaskWithRequest:request requestKey:[UAAPIClient requestKeyForRequest:request] retryWhere:^BOOL(NSData *data, NSURLResponse *response) {
         return [response hasRetriableStatus];
     } completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
         NSHTTPURLResponse *httpResponse = [self castResponse:response error:&error];
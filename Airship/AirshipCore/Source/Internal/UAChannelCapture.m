@@ -6,22 +6,32 @@
 #import "UAPreferenceDataStore+Internal.h"
 #import "UAAppStateTracker.h"
 #import "UADate.h"
+#import "UAActionRunner.h"
+#import "UAShareAction.h"
+
+// Used as the knock ring buffer size, so it needs to be a constant expression
+#define kUAChannelCaptureKnocksToTriggerChannelCapture 6
 
-static NSUInteger const UAChannelCaptureKnocksToTriggerChannelCapture = 6;
 static NSTimeInterval const UAChannelCaptureKnocksMaxTimeSeconds = 30;
 static NSTimeInterval const UAChannelCaptureKnocksPasteboardExpirationSeconds = 60;
 
+NSString *const UAChannelCaptureDeepLinkScheme = @"uairship";
+NSString *const UAChannelCaptureDeepLinkHost = @"channel_capture";
+
 @interface UAChannelCapture()
 @property (nonatomic, strong) UAChannel *channel;
 @property (nonatomic, strong) UARuntimeConfig *config;
 @property (nonatomic, strong) NSNotificationCenter *notificationCenter;
 @property (nonatomic, strong) UADate *date;
 
-@property (nonatomic, strong) NSMutableArray<NSDate *> *knockTimes;
 @property (nonatomic, strong) UAPreferenceDataStore *dataStore;
 @end
 
-@implementation UAChannelCapture
+@implementation UAChannelCapture {
+    // Ring buffer of the most recent foreground times
+    NSTimeInterval _knockTimes[kUAChannelCaptureKnocksToTriggerChannelCapture];
+    NSUInteger _knockCount;
+}
 
 - (instancetype)initWithConfig:(UARuntimeConfig *)config
                        channel:(UAChannel *)channel
@@ -36,7 +46,6 @@ static NSTimeInterval const UAChannelCaptureKnocksPasteboardExpirationSeconds =
         self.notificationCenter = notificationCenter;
         self.date = date;
 
-        self.knockTimes = [NSMutableArray array];
         self.enabled = config.channelCaptureEnabled;
 
         [self.notificationCenter addObserver:self
@@ -74,31 +83,55 @@ static NSTimeInterval const UAChannelCaptureKnocksPasteboardExpirationSeconds =
     if (!self.enabled) {
         return;
     }
-    
-    // save time of transition
-    if (self.knockTimes.count >= UAChannelCaptureKnocksToTriggerChannelCapture) {
-        [self.knockTimes removeObjectAtIndex:0];
-    }
-    [self.knockTimes addObject:[self.date now]];
-    
-    if (self.knockTimes.count < UAChannelCaptureKnocksToTriggerChannelCapture) {
+
+    // Record the knock, overwriting the oldest one once the buffer is full
+    NSTimeInterval now = [self.date now].timeIntervalSinceReferenceDate;
+    _knockTimes[_knockCount % kUAChannelCaptureKnocksToTriggerChannelCapture] = now;
+    _knockCount++;
+
+    if (_knockCount < kUAChannelCaptureKnocksToTriggerChannelCapture) {
         return;
-    };
-    
-    if ([self.knockTimes[UAChannelCaptureKnocksToTriggerChannelCapture - 1] timeIntervalSinceDate:self.knockTimes[0]] > UAChannelCaptureKnocksMaxTimeSeconds) {
+    }
+
+    // The slot after the newest knock holds the oldest one
+    NSTimeInterval oldest = _knockTimes[_knockCount % kUAChannelCaptureKnocksToTriggerChannelCapture];
+    if (now - oldest > UAChannelCaptureKnocksMaxTimeSeconds) {
         return;
-    };
-         
-    [self.knockTimes removeAllObjects];
+    }
 
+    _knockCount = 0;
+
+    // Only touch the pasteboard once the knock pattern shows the user asked for it
+    UA_LDEBUG(@"Setting pasteboard with channel identifier = %@", self.channel.identifier);
+    [[UIPasteboard generalPasteboard] setItems:@[@{UIPasteboardTypeAutomatic: [self capturedChannelString]}]
+                                       options:@{UIPasteboardOptionExpirationDate: [[self.date now] dateByAddingTimeInterval:UAChannelCaptureKnocksPasteboardExpirationSeconds]}];
+}
+
+- (BOOL)handleDeepLink:(NSURL *)url {
+    if (![url.scheme isEqualToString:UAChannelCaptureDeepLinkScheme] || ![url.host isEqualToString:UAChannelCaptureDeepLinkHost]) {
+        return NO;
+    }
+
+    if (!self.enabled) {
+        UA_LDEBUG(@"Channel capture is disabled, ignoring deep link %@", url);
+        return YES;
+    }
+
+    // Let the user pick where the channel goes instead of writing it to the pasteboard
+    UA_LDEBUG(@"Sharing channel identifier = %@", self.channel.identifier);
+    [UAActionRunner runActionWithName:UAShareActionDefaultRegistryName
+                                value:[self capturedChannelString]
+                            situation:UASituationManualInvocation];
+    return YES;
+}
+
+- (NSString *)capturedChannelString {
     if (!self.channel.identifier) {
         UA_LDEBUG(@"The channel ID does not exist.");
+        return @"ua:";
     }
 
-    UA_LDEBUG(@"Setting pasteboard with channel identifier = %@", self.channel.identifier);
-    NSString *channelForPasteboard = (self.channel.identifier) ? [NSString stringWithFormat:@"ua:%@", self.channel.identifier] : @"ua:";
-    [[UIPasteboard generalPasteboard] setItems:@[@{UIPasteboardTypeAutomatic: channelForPasteboard}]
-                                       options:@{UIPasteboardOptionExpirationDate: [[self.date now] dateByAddingTimeInterval:UAChannelCaptureKnocksPasteboardExpirationSeconds]}];
+    return [NSString stringWithFormat:@"ua:%@", self.channel.identifier];
 }
 
 @end
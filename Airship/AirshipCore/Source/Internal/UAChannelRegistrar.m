@@ -9,12 +9,16 @@
 #import "UAPreferenceDataStore+Internal.h"
 #import "UADate.h"
 #import "UADispatcher.h"
+#import "UAStartupMetrics+Internal.h"
 
 NSTimeInterval const k24HoursInSeconds = 24 * 60 * 60;
 
 NSString *const UAChannelRegistrarChannelIDKey = @"UAChannelID";
 NSString *const UALastSuccessfulUpdateKey = @"last-update-key";
 NSString *const UALastSuccessfulPayloadKey = @"payload-key";
+NSString *const UALastSuccessfulPayloadHashKey = @"payload-hash-key";
+
+static NSString *const UAChannelRegistrarFirstRegistrationInterval = @"First Channel Registration";
 
 @interface UAChannelRegistrar ()
 
@@ -33,6 +37,12 @@ NSString *const UALastSuccessfulPayloadKey = @"payload-key";
  */
 @property (nonatomic, strong, nullable) UAChannelRegistrationPayload *lastSuccessfulPayload;
 
+/**
+ * The content hash of the last successful payload. Compared against new payloads so the stored
+ * payload does not need to be decoded to decide whether to update.
+ */
+@property (nonatomic, copy, nullable) NSString *lastSuccessfulPayloadHash;
+
 /**
  * The date of the last successful update.
  */
@@ -149,6 +159,7 @@ UARuntimeConfig *config;
 
             // Proceed with registration
             self.isRegistrationInProgress = YES;
+            [[UAStartupMetrics shared] beginInterval:UAChannelRegistrarFirstRegistrationInterval];
             if (!self.channelID) {
                 [self createChannelWithPayload:payload];
             } else {
@@ -186,12 +197,13 @@ UARuntimeConfig *config;
 - (BOOL)shouldUpdateRegistration:(UAChannelRegistrationPayload *)payload {
     NSTimeInterval timeSinceLastUpdate = [[self.date now] timeIntervalSinceDate:self.lastSuccessfulUpdateDate];
 
-    if (self.lastSuccessfulPayload == nil) {
+    NSString *lastPayloadHash = self.lastSuccessfulPayloadHash;
+    if (lastPayloadHash == nil) {
         UA_LTRACE(@"Should update registration. Last payload is nil.");
         return true;
     }
 
-    if (![payload isEqualToPayload:self.lastSuccessfulPayload]) {
+    if (![[payload contentHash] isEqualToString:lastPayloadHash]) {
         UA_LTRACE(@"Should update registration. Channel registration payload has changed.");
         return true;
     }
@@ -276,6 +288,7 @@ UARuntimeConfig *config;
 // Must be called on main queue
 - (void)failedWithPayload:(UAChannelRegistrationPayload *)payload {
     self.isRegistrationInProgress = NO;
+    [[UAStartupMetrics shared] endInterval:UAChannelRegistrarFirstRegistrationInterval];
     [self.delegate registrationFailed];
     [self endRegistrationBackgroundTask];
 }
@@ -284,6 +297,7 @@ UARuntimeConfig *config;
 - (void)succeededWithPayload:(UAChannelRegistrationPayload *)payload {
     self.lastSuccessfulPayload = payload;
     self.lastSuccessfulUpdateDate = [self.date now];
+    [[UAStartupMetrics shared] endInterval:UAChannelRegistrarFirstRegistrationInterval];
 
     id<UAChannelRegistrarDelegate> delegate = self.delegate;
     [delegate registrationSucceeded];
@@ -332,6 +346,25 @@ UARuntimeConfig *config;
 
 - (void)setLastSuccessfulPayload:(UAChannelRegistrationPayload *)payload {
     [self.dataStore setObject:payload.asJSONData forKey:UALastSuccessfulPayloadKey];
+    self.lastSuccessfulPayloadHash = [payload contentHash];
+}
+
+- (NSString *)lastSuccessfulPayloadHash {
+    NSString *payloadHash = [self.dataStore stringForKey:UALastSuccessfulPayloadHashKey];
+
+    // Payloads stored before the hash was tracked
+    if (!payloadHash) {
+        payloadHash = [self.lastSuccessfulPayload contentHash];
+        if (payloadHash) {
+            [self.dataStore setObject:payloadHash forKey:UALastSuccessfulPayloadHashKey];
+        }
+    }
+
+    return payloadHash;
+}
+
+- (void)setLastSuccessfulPayloadHash:(NSString *)payloadHash {
+    [self.dataStore setObject:payloadHash forKey:UALastSuccessfulPayloadHashKey];
 }
 
 - (NSDate *)lastSuccessfulUpdateDate {
@@ -63,12 +63,32 @@ extern NSString *const UABackgroundEnabledJSONKey;
  */
 - (BOOL)isEqualToPayload:(nullable UAChannelRegistrationPayload *)payload;
 
+/**
+ * A hash of the payload's contents. Payloads with equal contents have equal hashes.
+ * @return The content hash.
+ */
+- (NSString *)contentHash;
+
 /**
  * The UAChannelRegistrationPayload as an NSDictionary.
  * @return The payload as an NSDictionary.
  */
 - (NSDictionary *)payloadDictionary;
 
+/**
+ * The fields that differ from another payload, keyed by property name. Fields that were
+ * cleared are set to `NSNull`.
+ * @param payload The payload to compare with.
+ * @return The changed fields.
+ */
+- (NSDictionary<NSString *, id> *)fieldsChangedFromPayload:(UAChannelRegistrationPayload *)payload;
+
+/**
+ * Applies fields returned from `fieldsChangedFromPayload:` to the payload.
+ * @param fields The fields to apply.
+ */
+- (void)applyFields:(NSDictionary<NSString *, id> *)fields;
+
 /**
  * Creates a new payload with the minimal amount required and optional data for an update.
  * @param lastPayload The last payload.
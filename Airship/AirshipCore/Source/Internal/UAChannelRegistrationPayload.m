@@ -3,6 +3,7 @@
 #import "UAChannelRegistrationPayload+Internal.h"
 #import "UAJSONSerialization.h"
 #import "UAGlobal.h"
+#import "UAUtils.h"
 
 NSString *const UAChannelIOSPlatform= @"ios";
 
@@ -103,6 +104,15 @@ NSString *const UABackgroundEnabledJSONKey = @"background";
                                              error:nil];
 }
 
+- (NSString *)contentHash {
+    // Sorted keys so equal payloads always serialize the same way
+    NSData *data = [UAJSONSerialization dataWithJSONObject:[self payloadDictionary]
+                                                   options:NSJSONWritingSortedKeys
+                                                     error:nil];
+
+    return [UAUtils sha256HashWithString:[[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding]];
+}
+
 - (NSDictionary *)payloadDictionary {
     NSMutableDictionary *payloadDictionary = [NSMutableDictionary dictionary];
 
@@ -155,6 +165,41 @@ NSString *const UABackgroundEnabledJSONKey = @"background";
     return payloadDictionary;
 }
 
++ (NSArray<NSString *> *)fieldKeys {
+    static NSArray<NSString *> *keys;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        keys = @[@"userID", @"deviceID", @"accengageDeviceID", @"optedIn", @"backgroundEnabled",
+                 @"pushAddress", @"namedUserId", @"setTags", @"tags", @"quietTime", @"quietTimeTimeZone",
+                 @"timeZone", @"language", @"country", @"badge", @"locationSettings", @"appVersion",
+                 @"SDKVersion", @"deviceModel", @"deviceOS", @"carrier"];
+    });
+
+    return keys;
+}
+
+- (NSDictionary<NSString *, id> *)fieldsChangedFromPayload:(UAChannelRegistrationPayload *)payload {
+    NSMutableDictionary<NSString *, id> *fields = [NSMutableDictionary dictionary];
+
+    for (NSString *key in [UAChannelRegistrationPayload fieldKeys]) {
+        id value = [self valueForKey:key];
+        id otherValue = [payload valueForKey:key];
+
+        if (value != otherValue && ![value isEqual:otherValue]) {
+            fields[key] = value ?: [NSNull null];
+        }
+    }
+
+    return fields;
+}
+
+- (void)applyFields:(NSDictionary<NSString *, id> *)fields {
+    for (NSString *key in fields) {
+        id value = fields[key];
+        [self setValue:(value == [NSNull null] ? nil : value) forKey:key];
+    }
+}
+
 - (id)copyWithZone:(NSZone *)zone {
     UAChannelRegistrationPayload *copy = [[[self class] alloc] init];
 
@@ -2,46 +2,125 @@
 
 #import "UAColorUtils.h"
 #import "UAGlobal.h"
+#import "UAMemoryPressureCoordinator.h"
+
+// Maximum number of parsed colors kept in memory
+static NSUInteger const UAColorUtilsCacheLimit = 64;
+
+// Estimated size of a parsed color
+static NSUInteger const UAColorUtilsEstimatedEntrySize = 64;
+
+static inline BOOL UAColorUtilsIsWhitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+static inline int UAColorUtilsHexDigitValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+
+    return -1;
+}
 
 @implementation UAColorUtils
 
+/**
+ * Parsed colors, keyed by the hex string they were parsed from.
+ */
++ (NSCache<NSString *, UIColor *> *)colorCache {
+    static NSCache *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [[NSCache alloc] init];
+        cache.name = @"com.urbanairship.colors";
+        cache.countLimit = UAColorUtilsCacheLimit;
+        [[UAMemoryPressureCoordinator shared] registerCache:cache
+                                                   priority:UAMemoryPressurePriorityLow
+                                         estimatedEntrySize:UAColorUtilsEstimatedEntrySize];
+    });
+    return cache;
+}
+
 + (UIColor *)colorWithHexString:(NSString *)hexString {
 
     if (!hexString) {
         return nil;
     }
 
-    hexString = [hexString stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+    UIColor *color = [[self colorCache] objectForKey:hexString];
+    if (color) {
+        return color;
+    }
 
-    if ([hexString hasPrefix:@"#"]) {
-        hexString = [hexString substringFromIndex:1];
+    color = [self parseHexString:hexString];
+    if (color) {
+        [[self colorCache] setObject:color forKey:hexString];
     }
 
-    NSUInteger width = 8 * (hexString.length /2);
-    if (width != 32 && width != 24) {
-        UA_LERR(@"Invalid hex color string: %@ (must be 24 or 32 bits wide)", hexString);
-        return nil;
+    return color;
+}
+
+/**
+ * Parses a hex color string directly from its UTF-8 bytes. Surrounding whitespace
+ * and a leading `#` are ignored, and exactly 6 or 8 hex digits are required.
+ */
++ (nullable UIColor *)parseHexString:(NSString *)hexString {
+    const char *bytes = CFStringGetCStringPtr((__bridge CFStringRef)hexString, kCFStringEncodingUTF8);
+
+    // Valid hex strings are short, anything that does not fit is not a color
+    char buffer[64];
+    if (!bytes) {
+        if (![hexString getCString:buffer maxLength:sizeof(buffer) encoding:NSUTF8StringEncoding]) {
+            UA_LERR(@"Invalid hex color string: %@", hexString);
+            return nil;
+        }
+        bytes = buffer;
     }
 
-    unsigned int component = 0;
+    const char *cursor = bytes;
+    while (UAColorUtilsIsWhitespace(*cursor)) {
+        cursor++;
+    }
+
+    if (*cursor == '#') {
+        cursor++;
+    }
 
-    NSScanner *scanner = [NSScanner scannerWithString:hexString];
+    uint32_t component = 0;
+    NSUInteger digits = 0;
+    int value;
+    while (digits < 8 && (value = UAColorUtilsHexDigitValue(*cursor)) >= 0) {
+        component = (component << 4) | (uint32_t)value;
+        digits++;
+        cursor++;
+    }
 
-    if (![scanner scanHexInt:&component]) {
-        UA_LERR(@"Unable to scan hexString: %@", hexString);
+    while (UAColorUtilsIsWhitespace(*cursor)) {
+        cursor++;
+    }
+
+    if (*cursor != '\0' || (digits != 6 && digits != 8)) {
+        UA_LERR(@"Invalid hex color string: %@ (must be 24 or 32 bits wide)", hexString);
         return nil;
-    };
+    }
 
     CGFloat red = ((component & 0xFF0000) >> 16)/255.0;
     CGFloat green = ((component & 0xFF00) >> 8)/255.0;
     CGFloat blue = (component & 0xFF)/255.0;
-    CGFloat alpha = (width == 24) ? 1.0 : ((component & 0xFF000000) >> 24)/255.0;
-    
-    UIColor *color = [UIColor colorWithRed:red
+    CGFloat alpha = (digits == 6) ? 1.0 : ((component & 0xFF000000) >> 24)/255.0;
+
+    return [UIColor colorWithRed:red
                            green:green
                             blue:blue
                            alpha:alpha];
-    return color;
 }
 
 + (NSString *)hexStringWithColor:(UIColor *)color {
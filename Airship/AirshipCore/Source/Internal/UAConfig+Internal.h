@@ -50,6 +50,17 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (BOOL)isProductionProvisioningProfile:(NSString *)profilePath;
 
+/**
+ * Creates a config from a plist, reusing a snapshot of the normalized values when the plist,
+ * the app version and the provisioning profile have not changed since the snapshot was written.
+ * The snapshot is rewritten whenever it is missing or stale.
+ *
+ * @param path The plist path.
+ * @param snapshotURL The snapshot file URL, or `nil` to always parse the plist.
+ * @return A config.
+ */
++ (instancetype)configWithContentsOfFile:(NSString *)path snapshotURL:(nullable NSURL *)snapshotURL;
+
 /*
  * Converts string keys from the old ALL_CAPS format to the new property name format. Transforms
  * boolean strings (YES/NO) into NSNumber BOOLs if the target property is a primitive char type. Transforms
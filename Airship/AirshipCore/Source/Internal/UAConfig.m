@@ -2,7 +2,7 @@
 
 #import <objc/runtime.h>
 
-#import "UAConfig.h"
+#import "UAConfig+Internal.h"
 #import "UAGlobal.h"
 
 NSString *const UACloudSiteEUConfigName = @"EU";
@@ -19,13 +19,20 @@ NSString *const UALogLevelInfoName = @"INFO";
 NSString *const UALogLevelDebugName = @"DEBUG";
 NSString *const UALogLevelTraceName = @"TRACE";
 
-@interface UAConfig()
+NSString *const UAQualityOfServiceKeySuffix = @"QualityOfService";
+NSString *const UAQualityOfServiceBackgroundName = @"BACKGROUND";
+NSString *const UAQualityOfServiceUtilityName = @"UTILITY";
+NSString *const UAQualityOfServiceDefaultName = @"DEFAULT";
+NSString *const UAQualityOfServiceUserInitiatedName = @"USER_INITIATED";
+NSString *const UAQualityOfServiceUserInteractiveName = @"USER_INTERACTIVE";
 
-@property (nonatomic, copy, nullable) NSString *profilePath;
-@property (nonatomic, assign) BOOL defaultDetectProvisioningMode;
-@property (nonatomic, strong) NSNumber *usesProductionPushServer;
+static NSString *const UAConfigSnapshotFileName = @"AirshipConfig.snapshot";
+static NSString *const UAConfigSnapshotKey = @"key";
+static NSString *const UAConfigSnapshotValuesKey = @"values";
+static NSString *const UAConfigSnapshotProductionKey = @"production";
 
-@end
+// Bump when the normalization rules change so existing snapshots are discarded
+static NSUInteger const UAConfigSnapshotVersion = 1;
 @implementation UAConfig
 
 @synthesize inProduction = _inProduction;
@@ -56,7 +63,12 @@ NSString *const UALogLevelTraceName = @"TRACE";
         self.customConfig = @{};
         self.channelCreationDelayEnabled = NO;
         self.extendedBroadcastsEnabled = NO;
+        self.lazyMessageCenterEnabled = NO;
         self.defaultDetectProvisioningMode = YES;
+        self.uploadQualityOfService = NSQualityOfServiceUtility;
+        self.processingQualityOfService = NSQualityOfServiceUtility;
+        self.maintenanceQualityOfService = NSQualityOfServiceBackground;
+        self.displayQualityOfService = NSQualityOfServiceUserInitiated;
     }
 
     return self;
@@ -96,9 +108,14 @@ NSString *const UALogLevelTraceName = @"TRACE";
         _customConfig = config.customConfig;
         _channelCreationDelayEnabled = config.channelCreationDelayEnabled;
         _extendedBroadcastsEnabled = config.extendedBroadcastsEnabled;
+        _lazyMessageCenterEnabled = config.lazyMessageCenterEnabled;
         _defaultDetectProvisioningMode = config.defaultDetectProvisioningMode;
         _messageCenterStyleConfig = config.messageCenterStyleConfig;
         _itunesID = config.itunesID;
+        _uploadQualityOfService = config.uploadQualityOfService;
+        _processingQualityOfService = config.processingQualityOfService;
+        _maintenanceQualityOfService = config.maintenanceQualityOfService;
+        _displayQualityOfService = config.displayQualityOfService;
     }
 
     return config;
@@ -134,10 +151,12 @@ NSString *const UALogLevelTraceName = @"TRACE";
             "Custom Config: %@\n"
             "Delay Channel Creation: %d\n"
             "Extended broadcasts: %d\n"
+            "Lazy Message Center: %d\n"
             "Default Message Center Style Config File: %@\n"
             "Use iTunes ID: %@\n"
             "Site:  %ld\n"
-            "DataCollectionOptInEnabled:  %d\n",
+            "DataCollectionOptInEnabled:  %d\n"
+            "Quality of Service (upload, processing, maintenance, display): %ld, %ld, %ld, %ld\n",
             self.inProduction,
             _inProduction,
             self.appKey,
@@ -167,18 +186,26 @@ NSString *const UALogLevelTraceName = @"TRACE";
             self.customConfig,
             self.channelCreationDelayEnabled,
             self.extendedBroadcastsEnabled,
+            self.lazyMessageCenterEnabled,
             self.messageCenterStyleConfig,
             self.itunesID,
             (long) self.site,
-            self.dataCollectionOptInEnabled];
+            self.dataCollectionOptInEnabled,
+            (long)self.uploadQualityOfService,
+            (long)self.processingQualityOfService,
+            (long)self.maintenanceQualityOfService,
+            (long)self.displayQualityOfService];
 }
 
 #pragma mark -
 #pragma Factory Methods
 
 + (instancetype)defaultConfig {
-    return [self configWithContentsOfFile:
-            [[NSBundle mainBundle] pathForResource:@"AirshipConfig" ofType:@"plist"]];
+    NSURL *cachesURL = [[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask].lastObject;
+    NSURL *snapshotURL = [[cachesURL URLByAppendingPathComponent:@"com.urbanairship"] URLByAppendingPathComponent:UAConfigSnapshotFileName];
+
+    return [self configWithContentsOfFile:[[NSBundle mainBundle] pathForResource:@"AirshipConfig" ofType:@"plist"]
+                              snapshotURL:snapshotURL];
 }
 
 + (instancetype)configWithContentsOfFile:(NSString *)path {
@@ -199,6 +226,88 @@ NSString *const UALogLevelTraceName = @"TRACE";
     return [[self alloc] init];
 }
 
++ (instancetype)configWithContentsOfFile:(NSString *)path snapshotURL:(nullable NSURL *)snapshotURL {
+    if (!path || !snapshotURL) {
+        return [self configWithContentsOfFile:path];
+    }
+
+    UAConfig *config = [self config];
+    NSArray *snapshotKey = [config snapshotKeyForPath:path];
+
+    NSData *data = [NSData dataWithContentsOfURL:snapshotURL options:NSDataReadingMappedIfSafe error:nil];
+    NSDictionary *snapshot = data ? [NSPropertyListSerialization propertyListWithData:data
+                                                                              options:NSPropertyListImmutable
+                                                                               format:nil
+                                                                                error:nil] : nil;
+
+    if ([snapshot isKindOfClass:[NSDictionary class]] && [snapshot[UAConfigSnapshotKey] isEqual:snapshotKey]) {
+        NSDictionary *values = snapshot[UAConfigSnapshotValuesKey];
+        if ([values isKindOfClass:[NSDictionary class]]) {
+            UA_LTRACE(@"Loaded config from snapshot: %@", values);
+            [config setValuesForKeysWithDictionary:values];
+
+            NSNumber *production = snapshot[UAConfigSnapshotProductionKey];
+            if ([production isKindOfClass:[NSNumber class]]) {
+                config.usesProductionPushServer = production;
+            }
+
+            return config;
+        }
+    }
+
+    NSDictionary *configDict = [[NSDictionary alloc] initWithContentsOfFile:path];
+    NSDictionary *normalizedDictionary = [UAConfig normalizeDictionary:configDict];
+    [config setValuesForKeysWithDictionary:normalizedDictionary];
+    UA_LTRACE(@"Config options: %@", [normalizedDictionary description]);
+
+    NSMutableDictionary *updatedSnapshot = [NSMutableDictionary dictionary];
+    updatedSnapshot[UAConfigSnapshotKey] = snapshotKey;
+    updatedSnapshot[UAConfigSnapshotValuesKey] = normalizedDictionary;
+
+    // The provisioning profile scan is the most expensive part of loading, and it
+    // is needed during takeOff anyway
+    if (config.detectProvisioningMode) {
+        updatedSnapshot[UAConfigSnapshotProductionKey] = config.usesProductionPushServer;
+    }
+
+    NSError *error;
+    NSData *snapshotData = [NSPropertyListSerialization dataWithPropertyList:updatedSnapshot
+                                                                      format:NSPropertyListBinaryFormat_v1_0
+                                                                     options:0
+                                                                       error:&error];
+    [[NSFileManager defaultManager] createDirectoryAtURL:[snapshotURL URLByDeletingLastPathComponent]
+                             withIntermediateDirectories:YES
+                                              attributes:nil
+                                                   error:nil];
+
+    if (!snapshotData || ![snapshotData writeToURL:snapshotURL options:NSDataWritingAtomic error:&error]) {
+        UA_LDEBUG(@"Unable to write config snapshot: %@", error);
+    }
+
+    return config;
+}
+
+/**
+ * Identifies the inputs a snapshot was built from: the plist, the app version and the
+ * provisioning profile.
+ */
+- (NSArray *)snapshotKeyForPath:(NSString *)path {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSDictionary *info = [NSBundle mainBundle].infoDictionary;
+
+    NSDictionary *plistAttributes = [fileManager attributesOfItemAtPath:path error:nil];
+    NSDictionary *profileAttributes = self.profilePath ? [fileManager attributesOfItemAtPath:self.profilePath error:nil] : nil;
+
+    return @[@(UAConfigSnapshotVersion),
+             path,
+             @([plistAttributes.fileModificationDate timeIntervalSince1970]),
+             @(plistAttributes.fileSize),
+             info[@"CFBundleShortVersionString"] ?: @"",
+             info[@"CFBundleVersion"] ?: @"",
+             self.profilePath ?: @"",
+             @([profileAttributes.fileModificationDate timeIntervalSince1970])];
+}
+
 #pragma mark -
 #pragma Resolved values
 
@@ -368,6 +477,25 @@ NSString *const UALogLevelTraceName = @"TRACE";
             }
         }
 
+        if ([key hasSuffix:UAQualityOfServiceKeySuffix]) {
+            id value = keyedValues[key];
+            if ([value isKindOfClass:[NSString class]]) {
+                NSDictionary *names = @{ UAQualityOfServiceBackgroundName : @(NSQualityOfServiceBackground),
+                                         UAQualityOfServiceUtilityName : @(NSQualityOfServiceUtility),
+                                         UAQualityOfServiceDefaultName : @(NSQualityOfServiceDefault),
+                                         UAQualityOfServiceUserInitiatedName : @(NSQualityOfServiceUserInitiated),
+                                         UAQualityOfServiceUserInteractiveName : @(NSQualityOfServiceUserInteractive) };
+
+                NSNumber *qualityOfService = names[[value uppercaseString]];
+                if (qualityOfService) {
+                    newKeyedValues[key] = qualityOfService;
+                } else {
+                    UA_LWARN(@"Invalid quality of service %@ for %@", value, key);
+                }
+                continue;
+            }
+        }
+
         NSString *realKey = [oldKeyMap objectForKey:key] ?: key;
         id value = [keyedValues objectForKey:key];
 
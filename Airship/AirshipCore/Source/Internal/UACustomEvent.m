@@ -4,6 +4,14 @@
 #import "UAAnalytics.h"
 #import "UAirship.h"
 #import "NSJSONSerialization+UAAdditions.h"
+#import "UACustomEventPropertiesBuilder+Internal.h"
+
+@interface UACustomEvent ()
+// Serialized size of the properties, measured once per properties change
+@property (nonatomic, strong, nullable) NSNumber *propertiesSize;
+// Properties set from a builder, only turned into a dictionary if read
+@property (nonatomic, copy, nullable) NSData *propertiesJSONData;
+@end
 
 @implementation UACustomEvent
 
@@ -67,6 +75,46 @@ NSString *const UACustomEventTemplateTypeKey = @"template_type";
     }
 }
 
+- (void)setProperties:(NSDictionary *)properties {
+    @synchronized (self) {
+        _properties = [properties copy];
+        self.propertiesJSONData = nil;
+        self.propertiesSize = nil;
+    }
+}
+
+- (void)setPropertiesWithBuilder:(UACustomEventPropertiesBuilder *)builder {
+    @synchronized (self) {
+        _properties = nil;
+        self.propertiesJSONData = [builder JSONData];
+        self.propertiesSize = @(self.propertiesJSONData.length);
+    }
+}
+
+- (NSDictionary *)properties {
+    @synchronized (self) {
+        if (!_properties && self.propertiesJSONData) {
+            _properties = [NSJSONSerialization JSONObjectWithData:self.propertiesJSONData options:0 error:nil];
+        }
+        return _properties ?: @{};
+    }
+}
+
+- (nullable NSNumber *)measurePropertiesSize {
+    @synchronized (self) {
+        if (!self.propertiesSize) {
+            NSError *error;
+            NSData *propertyData = [NSJSONSerialization dataWithJSONObject:self.properties options:0 error:&error];
+            if (error) {
+                UA_LERR(@"Event properties serialization error %@", error);
+                return nil;
+            }
+            self.propertiesSize = @(propertyData.length);
+        }
+        return self.propertiesSize;
+    }
+}
+
 - (BOOL)isValid {
     BOOL isValid = YES;
 
@@ -108,14 +156,11 @@ NSString *const UACustomEventTemplateTypeKey = @"template_type";
         }
     }
     
-    NSError *error;
-    NSData *propertyData = [NSJSONSerialization dataWithJSONObject:self.properties options:0 error:&error];
-  
-    if (error) {
-        UA_LERR(@"Event properties serialization error %@", error);
+    NSNumber *propertiesSize = [self measurePropertiesSize];
+    if (!propertiesSize) {
         isValid = NO;
-    } else if (propertyData.length > UACustomEventMaxPropertiesSize) {
-        UA_LERR(@"Event properties (%lu bytes) are larger than the maximum size of %lu bytes.", (unsigned long) propertyData.length, (unsigned long)UACustomEventMaxPropertiesSize);
+    } else if (propertiesSize.unsignedIntegerValue > UACustomEventMaxPropertiesSize) {
+        UA_LERR(@"Event properties (%lu bytes) are larger than the maximum size of %lu bytes.", (unsigned long)propertiesSize.unsignedIntegerValue, (unsigned long)UACustomEventMaxPropertiesSize);
         isValid = NO;
     }
 
@@ -127,7 +172,30 @@ NSString *const UACustomEventTemplateTypeKey = @"template_type";
     self.interactionType = UAInteractionMCRAP;
 }
 
+- (NSDictionary *)serializableData {
+    @synchronized (self) {
+        if (!self.propertiesJSONData) {
+            return self.data;
+        }
+    }
+
+    NSMutableDictionary *dictionary = [self dataWithoutProperties];
+    @synchronized (self) {
+        [dictionary setValue:self.propertiesJSONData forKey:UACustomEventPropertiesKey];
+    }
+    return dictionary;
+}
+
 - (NSDictionary *)data {
+    NSMutableDictionary *dictionary = [self dataWithoutProperties];
+
+    // Properties
+    [dictionary setValue:self.properties forKey:UACustomEventPropertiesKey];
+
+    return dictionary.copy;
+}
+
+- (NSMutableDictionary *)dataWithoutProperties {
     NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
 
     // Event name
@@ -167,10 +235,7 @@ NSString *const UACustomEventTemplateTypeKey = @"template_type";
         [dictionary setValue:@([number longLongValue]) forKey:UACustomEventValueKey];
     }
 
-    // Properties
-    [dictionary setValue:self.properties forKey:UACustomEventPropertiesKey];
-
-    return dictionary.copy;
+    return dictionary;
 }
 
 - (NSDictionary *)payload {
@@ -0,0 +1,22 @@
+/* Copyright Airship and Contributors */
+
+#import "UACustomEventPropertiesBuilder.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface UACustomEventPropertiesBuilder ()
+
+///---------------------------------------------------------------------------------------
+/// @name Custom Event Properties Builder Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * The properties as a serialized JSON object.
+ *
+ * @return The JSON data.
+ */
+- (NSData *)JSONData;
+
+@end
+
+NS_ASSUME_NONNULL_END
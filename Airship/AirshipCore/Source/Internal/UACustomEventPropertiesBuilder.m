@@ -0,0 +1,172 @@
+/* Copyright Airship and Contributors */
+
+#import "UACustomEventPropertiesBuilder+Internal.h"
+#import "UAGlobal.h"
+
+static char const UAHexDigits[] = "0123456789abcdef";
+
+@interface UACustomEventPropertiesBuilder ()
+// The comma separated "key":value members, without the enclosing braces
+@property (nonatomic, strong) NSMutableData *buffer;
+@property (nonatomic, strong) NSMutableSet<NSString *> *keys;
+@end
+
+@implementation UACustomEventPropertiesBuilder
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        self.buffer = [NSMutableData dataWithCapacity:256];
+        self.keys = [NSMutableSet set];
+    }
+    return self;
+}
+
+- (NSUInteger)count {
+    return self.keys.count;
+}
+
+- (void)setString:(NSString *)value forKey:(NSString *)key {
+    if ([self beginValueForKey:key]) {
+        [self appendString:value];
+    }
+}
+
+- (void)setInteger:(NSInteger)value forKey:(NSString *)key {
+    if ([self beginValueForKey:key]) {
+        [self appendFormat:"%ld", (long)value];
+    }
+}
+
+- (void)setDouble:(double)value forKey:(NSString *)key {
+    if (isnan(value) || isinf(value)) {
+        UA_LERR(@"Ignoring property %@, value is not a finite number.", key);
+        return;
+    }
+
+    if ([self beginValueForKey:key]) {
+        [self appendFormat:"%.17g", value];
+    }
+}
+
+- (void)setBool:(BOOL)value forKey:(NSString *)key {
+    if ([self beginValueForKey:key]) {
+        [self appendFormat:"%s", value ? "true" : "false"];
+    }
+}
+
+- (void)setNumber:(NSNumber *)value forKey:(NSString *)key {
+    if (CFGetTypeID((__bridge CFTypeRef)value) == CFBooleanGetTypeID()) {
+        [self setBool:value.boolValue forKey:key];
+    } else if (CFNumberIsFloatType((__bridge CFNumberRef)value)) {
+        [self setDouble:value.doubleValue forKey:key];
+    } else if (strcmp(value.objCType, @encode(unsigned long long)) == 0) {
+        if ([self beginValueForKey:key]) {
+            [self appendFormat:"%llu", value.unsignedLongLongValue];
+        }
+    } else if ([self beginValueForKey:key]) {
+        [self appendFormat:"%lld", value.longLongValue];
+    }
+}
+
+- (void)setStrings:(NSArray<NSString *> *)values forKey:(NSString *)key {
+    if (![self beginValueForKey:key]) {
+        return;
+    }
+
+    [self.buffer appendBytes:"[" length:1];
+    [values enumerateObjectsUsingBlock:^(NSString *value, NSUInteger idx, BOOL *stop) {
+        if (idx) {
+            [self.buffer appendBytes:"," length:1];
+        }
+        [self appendString:value];
+    }];
+    [self.buffer appendBytes:"]" length:1];
+}
+
+- (NSData *)JSONData {
+    NSMutableData *data = [NSMutableData dataWithCapacity:self.buffer.length + 2];
+    [data appendBytes:"{" length:1];
+    [data appendData:self.buffer];
+    [data appendBytes:"}" length:1];
+    return data;
+}
+
+#pragma mark -
+#pragma mark Writing
+
+// Writes the member separator and key. Returns NO if the key has already been set.
+- (BOOL)beginValueForKey:(NSString *)key {
+    if ([self.keys containsObject:key]) {
+        UA_LERR(@"Ignoring property %@, the key has already been set.", key);
+        return NO;
+    }
+
+    if (self.keys.count) {
+        [self.buffer appendBytes:"," length:1];
+    }
+    [self.keys addObject:key];
+
+    [self appendString:key];
+    [self.buffer appendBytes:":" length:1];
+    return YES;
+}
+
+- (void)appendFormat:(const char *)format, ... {
+    char value[32];
+
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(value, sizeof(value), format, args);
+    va_end(args);
+
+    [self.buffer appendBytes:value length:(NSUInteger)MIN(MAX(length, 0), (int)sizeof(value) - 1)];
+}
+
+// Writes a JSON string, escaping quotes, backslashes and control characters. Everything else is
+// written as UTF-8.
+- (void)appendString:(NSString *)string {
+    const unsigned char *bytes = (const unsigned char *)string.UTF8String;
+    NSUInteger length = bytes ? strlen((const char *)bytes) : 0;
+
+    [self.buffer appendBytes:"\"" length:1];
+
+    NSUInteger runStart = 0;
+    for (NSUInteger i = 0; i < length; i++) {
+        unsigned char c = bytes[i];
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        [self.buffer appendBytes:bytes + runStart length:i - runStart];
+        runStart = i + 1;
+
+        switch (c) {
+            case '"':
+                [self.buffer appendBytes:"\\\"" length:2];
+                break;
+            case '\\':
+                [self.buffer appendBytes:"\\\\" length:2];
+                break;
+            case '\n':
+                [self.buffer appendBytes:"\\n" length:2];
+                break;
+            case '\r':
+                [self.buffer appendBytes:"\\r" length:2];
+                break;
+            case '\t':
+                [self.buffer appendBytes:"\\t" length:2];
+                break;
+            default: {
+                char escaped[6] = {'\\', 'u', '0', '0', UAHexDigits[c >> 4], UAHexDigits[c & 0xF]};
+                [self.buffer appendBytes:escaped length:sizeof(escaped)];
+                break;
+            }
+        }
+    }
+
+    [self.buffer appendBytes:bytes + runStart length:length - runStart];
+    [self.buffer appendBytes:"\"" length:1];
+}
+
+@end
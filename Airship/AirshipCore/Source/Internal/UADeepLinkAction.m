@@ -2,6 +2,7 @@
 
 #import "UADeepLinkAction.h"
 #import "UAirship.h"
+#import "UAChannelCapture.h"
 
 @implementation UADeepLinkAction
 
@@ -24,6 +25,13 @@ NSString * const UADeepLinkActionDefaultRegistryAlias = @"^d";
 - (void)performWithArguments:(UAActionArguments *)arguments completionHandler:(UAActionCompletionHandler)completionHandler{
     NSURL *url = [UAOpenExternalURLAction parseURLFromArguments:arguments];
 
+#if !TARGET_OS_TV
+    if ([[UAirship shared].channelCapture handleDeepLink:url]) {
+        completionHandler([UAActionResult resultWithValue:url.absoluteString]);
+        return;
+    }
+#endif
+
     id strongDelegate = [UAirship shared].deepLinkDelegate;
     if ([strongDelegate respondsToSelector:@selector(receivedDeepLink:completionHandler:)]) {
         [strongDelegate receivedDeepLink:url completionHandler:^{
@@ -0,0 +1,87 @@
+/* Copyright Airship and Contributors */
+
+#import "UADispatchTimer.h"
+#import "UAGlobal.h"
+
+@interface UADispatchTimer ()
+@property (nonatomic, strong) dispatch_source_t source;
+@property (nonatomic, copy) void (^block)(void);
+@property (atomic, strong, nullable) NSDate *fireDate;
+@property (nonatomic, assign) dispatch_time_t deadline;
+@end
+
+@implementation UADispatchTimer
+
+- (instancetype)initWithQueue:(dispatch_queue_t)queue block:(void (^)(void))block {
+    self = [super init];
+
+    if (self) {
+        self.block = block;
+        self.deadline = DISPATCH_TIME_FOREVER;
+        self.source = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, queue);
+        dispatch_source_set_timer(self.source, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+
+        UA_WEAKIFY(self)
+        dispatch_source_set_event_handler(self.source, ^{
+            UA_STRONGIFY(self)
+            [self fire];
+        });
+
+        dispatch_resume(self.source);
+    }
+
+    return self;
+}
+
++ (instancetype)timerWithQueue:(dispatch_queue_t)queue block:(void (^)(void))block {
+    return [[self alloc] initWithQueue:queue block:block];
+}
+
+- (void)dealloc {
+    dispatch_source_cancel(_source);
+}
+
+- (void)fire {
+    @synchronized (self) {
+        // An event from an earlier schedule can still be delivered after a cancel or a reschedule
+        if (self.deadline == DISPATCH_TIME_FOREVER || dispatch_time(DISPATCH_TIME_NOW, 0) < self.deadline) {
+            return;
+        }
+
+        self.deadline = DISPATCH_TIME_FOREVER;
+        self.fireDate = nil;
+    }
+
+    self.block();
+}
+
+- (void)scheduleWithDelay:(NSTimeInterval)delay {
+    delay = MAX(delay, 0);
+
+    @synchronized (self) {
+        self.deadline = dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC));
+        self.fireDate = [NSDate dateWithTimeIntervalSinceNow:delay];
+        dispatch_source_set_timer(self.source, self.deadline, DISPATCH_TIME_FOREVER, 0);
+    }
+}
+
+- (BOOL)scheduleIfEarlierWithDelay:(NSTimeInterval)delay {
+    @synchronized (self) {
+        if (self.fireDate && [self.fireDate timeIntervalSinceNow] <= delay) {
+            return NO;
+        }
+
+        [self scheduleWithDelay:delay];
+        return YES;
+    }
+}
+
+- (void)cancel {
+    @synchronized (self) {
+        self.deadline = DISPATCH_TIME_FOREVER;
+        self.fireDate = nil;
+        dispatch_source_set_timer(self.source, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+    }
+}
+
+@end
@@ -10,12 +10,61 @@ static void *UADispatcherQueueSpecificKey = "com.urbanairsip.dispatcher.queue_sp
 @interface UADispatcher()
 @property (nonatomic, strong) dispatch_queue_t queue;
 @property (nonatomic, copy) NSString *context;
+
+/**
+ * The latest block for each coalescing key that still has a dispatch pending.
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, void (^)(void)> *coalescedBlocks;
 @end
 
 @implementation UADispatcher
 
 static UADispatcher *mainDispatcher;
 static NSMutableDictionary *globalDispatchers;
+static NSMutableDictionary<NSNumber *, NSNumber *> *workTypeQualityOfService;
+
++ (NSMutableDictionary<NSNumber *, NSNumber *> *)workTypeQualityOfService {
+    static dispatch_once_t workTypeOnceToken;
+
+    dispatch_once(&workTypeOnceToken, ^{
+        workTypeQualityOfService = [@{ @(UADispatcherWorkTypeUpload) : @(NSQualityOfServiceUtility),
+                                       @(UADispatcherWorkTypeProcessing) : @(NSQualityOfServiceUtility),
+                                       @(UADispatcherWorkTypeMaintenance) : @(NSQualityOfServiceBackground),
+                                       @(UADispatcherWorkTypeDisplay) : @(NSQualityOfServiceUserInitiated) } mutableCopy];
+    });
+
+    return workTypeQualityOfService;
+}
+
++ (void)setQualityOfService:(NSQualityOfService)qualityOfService forWorkType:(UADispatcherWorkType)workType {
+    NSMutableDictionary *values = [self workTypeQualityOfService];
+    @synchronized (values) {
+        values[@(workType)] = @(qualityOfService);
+    }
+}
+
++ (NSQualityOfService)qualityOfServiceForWorkType:(UADispatcherWorkType)workType {
+    NSMutableDictionary *values = [self workTypeQualityOfService];
+    @synchronized (values) {
+        return [values[@(workType)] integerValue];
+    }
+}
+
++ (dispatch_qos_class_t)qosClassForWorkType:(UADispatcherWorkType)workType {
+    switch ([self qualityOfServiceForWorkType:workType]) {
+        case NSQualityOfServiceUserInteractive:
+            return QOS_CLASS_USER_INTERACTIVE;
+        case NSQualityOfServiceUserInitiated:
+            return QOS_CLASS_USER_INITIATED;
+        case NSQualityOfServiceUtility:
+            return QOS_CLASS_UTILITY;
+        case NSQualityOfServiceBackground:
+            return QOS_CLASS_BACKGROUND;
+        case NSQualityOfServiceDefault:
+        default:
+            return QOS_CLASS_DEFAULT;
+    }
+}
 
 - (instancetype)initWithQueue:(dispatch_queue_t)queue {
     self = [super init];
@@ -70,6 +119,14 @@ static NSMutableDictionary *globalDispatchers;
     return [self dispatcherWithQueue:queue];
 }
 
++ (instancetype)globalDispatcherForWorkType:(UADispatcherWorkType)workType {
+    return [self globalDispatcher:[self qosClassForWorkType:workType]];
+}
+
++ (instancetype)serialDispatcherForWorkType:(UADispatcherWorkType)workType {
+    return [self serialDispatcher:[self qosClassForWorkType:workType]];
+}
+
 + (instancetype)serialDispatcher {
     return [self serialDispatcher:QOS_CLASS_DEFAULT];
 }
@@ -98,20 +155,59 @@ static NSMutableDictionary *globalDispatchers;
     dispatch_async(self.queue, block);
 }
 
+- (void)dispatchAsync:(void (^)(void))block workType:(UADispatcherWorkType)workType {
+    dispatch_qos_class_t qos = [UADispatcher qosClassForWorkType:workType];
+    dispatch_async(self.queue, dispatch_block_create_with_qos_class(DISPATCH_BLOCK_ENFORCE_QOS_CLASS, qos, 0, block));
+}
+
+- (void)dispatchAsync:(void (^)(void))block coalescingKey:(NSString *)key {
+    @synchronized (self) {
+        if (!self.coalescedBlocks) {
+            self.coalescedBlocks = [NSMutableDictionary dictionary];
+        }
+
+        // Already dispatched, the pending dispatch will run the latest block
+        BOOL pending = self.coalescedBlocks[key] != nil;
+        self.coalescedBlocks[key] = block;
+        if (pending) {
+            return;
+        }
+    }
+
+    [self dispatchAsync:^{
+        void (^latest)(void);
+        @synchronized (self) {
+            latest = self.coalescedBlocks[key];
+            [self.coalescedBlocks removeObjectForKey:key];
+        }
+
+        latest();
+    }];
+}
+
 - (UADisposable *)dispatchAfter:(NSTimeInterval)delay block:(void (^)(void))block {
     if (delay < 0) {
         delay = 0;
     }
 
-    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.queue, block);
+    // A one-shot timer source, so disposing cancels the source instead of leaving a wakeup behind
+    dispatch_source_t timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.queue);
+    dispatch_source_set_timer(timer, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), DISPATCH_TIME_FOREVER, 0);
+    dispatch_source_set_event_handler(timer, ^{
+        dispatch_source_cancel(timer);
+        block();
+    });
+    dispatch_resume(timer);
 
     return [UADisposable disposableWithBlock:^{
-        if (!dispatch_block_testcancel(block)) {
-            dispatch_block_cancel(block);
-        }
+        dispatch_source_cancel(timer);
     }];
 }
 
+- (UADispatchTimer *)timerWithBlock:(void (^)(void))block {
+    return [UADispatchTimer timerWithQueue:self.queue block:block];
+}
+
 - (BOOL)isCurrentQueue {
     return dispatch_get_specific(UADispatcherQueueSpecificKey) == (__bridge void *)(self);
 }
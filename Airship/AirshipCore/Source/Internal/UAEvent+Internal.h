@@ -22,7 +22,7 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, copy) NSString *eventID;
 
 /**
- * The JSON event size in bytes.
+ * The JSON event size in bytes. Uses the cached serialized event when available.
  */
 @property (nonatomic, readonly) NSUInteger jsonEventSize;
 
@@ -45,6 +45,25 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (NSString *)notificationAuthorization;
 
+/**
+ * The event serialized for storage and upload, with the session ID added to the event data.
+ *
+ * The event is serialized the first time this is called and the result is reused afterwards,
+ * so the event should not be modified once it has been added to analytics.
+ *
+ * @param sessionID The session ID.
+ * @return The serialized event, or nil if the event data is not valid JSON.
+ */
+- (nullable NSData *)JSONDataWithSessionID:(nullable NSString *)sessionID;
+
+/**
+ * The event data used when serializing the event. NSData values are treated as already
+ * serialized JSON and are written as is. Defaults to `data`.
+ *
+ * @return The event data to serialize.
+ */
+- (NSDictionary *)serializableData;
+
 
 @end
 
@@ -5,6 +5,11 @@
 #import "UAirship.h"
 #import "UAJSONSerialization.h"
 
+@interface UAEvent ()
+@property (nonatomic, copy, nullable) NSData *cachedJSONData;
+@property (nonatomic, copy, nullable) NSString *cachedJSONSessionID;
+@end
+
 @implementation UAEvent
 
 - (instancetype)init {
@@ -92,17 +97,62 @@
 }
 
 - (NSUInteger)jsonEventSize {
-    NSMutableDictionary *eventDictionary = [NSMutableDictionary dictionary];
-    [eventDictionary setValue:self.eventType forKey:@"type"];
-    [eventDictionary setValue:self.time forKey:@"time"];
-    [eventDictionary setValue:self.eventID forKey:@"event_id"];
-    [eventDictionary setValue:self.data forKey:@"data"];
+    @synchronized (self) {
+        if (self.cachedJSONData) {
+            return self.cachedJSONData.length;
+        }
+    }
 
-    NSData *jsonData = [UAJSONSerialization dataWithJSONObject:eventDictionary
-                                                       options:0
-                                                         error:nil];
+    return [self JSONDataWithSessionID:nil].length;
+}
+
+- (NSData *)JSONDataWithSessionID:(NSString *)sessionID {
+    @synchronized (self) {
+        if (self.cachedJSONData && (self.cachedJSONSessionID == sessionID || [self.cachedJSONSessionID isEqualToString:sessionID])) {
+            return self.cachedJSONData;
+        }
+
+        NSMutableDictionary *data = [NSMutableDictionary dictionaryWithDictionary:[self serializableData]];
+        [data setValue:sessionID forKey:@"session_id"];
+
+        // Already serialized values are swapped for placeholders and spliced back in after encoding
+        NSMutableDictionary<NSString *, NSData *> *fragments = [NSMutableDictionary dictionary];
+        for (NSString *key in data.allKeys) {
+            if ([data[key] isKindOfClass:[NSData class]]) {
+                NSString *placeholder = [NSUUID UUID].UUIDString;
+                fragments[placeholder] = data[key];
+                data[key] = placeholder;
+            }
+        }
+
+        NSMutableDictionary *eventDictionary = [NSMutableDictionary dictionary];
+        [eventDictionary setValue:self.eventType forKey:@"type"];
+        [eventDictionary setValue:self.time forKey:@"time"];
+        [eventDictionary setValue:self.eventID forKey:@"event_id"];
+        [eventDictionary setValue:data forKey:@"data"];
+
+        NSError *error;
+        NSData *jsonData = [UAJSONSerialization dataWithJSONObject:eventDictionary options:0 error:&error];
+        if (error) {
+            UA_LERR(@"Unable to serialize event %@. %@", self.eventID, error);
+        } else if (fragments.count) {
+            NSMutableData *splicedData = [jsonData mutableCopy];
+            for (NSString *placeholder in fragments) {
+                NSData *quotedPlaceholder = [[NSString stringWithFormat:@"\"%@\"", placeholder] dataUsingEncoding:NSUTF8StringEncoding];
+                NSRange range = [splicedData rangeOfData:quotedPlaceholder options:0 range:NSMakeRange(0, splicedData.length)];
+                [splicedData replaceBytesInRange:range withBytes:fragments[placeholder].bytes length:fragments[placeholder].length];
+            }
+            jsonData = splicedData;
+        }
+
+        self.cachedJSONData = jsonData;
+        self.cachedJSONSessionID = sessionID;
+        return jsonData;
+    }
+}
 
-    return [jsonData length];
+- (NSDictionary *)serializableData {
+    return self.data;
 }
 
 - (NSDictionary *)data {
@@ -57,6 +57,15 @@ extern NSString * const UAEventAPIClientErrorDomain;
  */
 -(void)uploadEvents:(NSArray *)events headers:(NSDictionary<NSString *, NSString *> *)headers completionHandler:(void (^)(NSDictionary * _Nullable, NSError * _Nullable))completionHandler;
 
+/**
+ * Uploads pre-serialized analytic events. The request body is assembled by
+ * joining the payloads into a JSON array without re-parsing them.
+ * @param payloads The JSON encoded events to upload.
+ * @param headers The event headers.
+ * @param completionHandler A completion handler.
+ */
+-(void)uploadEventPayloads:(NSArray<NSData *> *)payloads headers:(NSDictionary<NSString *, NSString *> *)headers completionHandler:(void (^)(NSDictionary * _Nullable, NSError * _Nullable))completionHandler;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -3,7 +3,7 @@
 #import <UIKit/UIKit.h>
 
 #import "UAEventAPIClient+Internal.h"
-#import "NSJSONSerialization+UAAdditions.h"
+#import "UARequest+Internal.h"
 #import "UAJSONSerialization.h"
 #import "UAAnalytics+Internal.h"
 
@@ -20,13 +20,25 @@ NSString * const UAEventAPIClientErrorDomain = @"com.urbanairship.event_api_clie
 }
 
 -(void)uploadEvents:(NSArray *)events headers:(NSDictionary *)headers completionHandler:(void (^)(NSDictionary * _Nullable responseHeaders, NSError * _Nullable error))completionHandler {
-    UARequest *request = [self requestWithEvents:events headers:headers];
+    NSMutableArray<NSData *> *payloads = [NSMutableArray arrayWithCapacity:events.count];
+    for (id event in events) {
+        NSData *payload = [UAJSONSerialization dataWithJSONObject:event options:0 error:nil];
+        if (payload) {
+            [payloads addObject:payload];
+        }
+    }
+
+    [self uploadEventPayloads:payloads headers:headers completionHandler:completionHandler];
+}
+
+-(void)uploadEventPayloads:(NSArray<NSData *> *)payloads headers:(NSDictionary *)headers completionHandler:(void (^)(NSDictionary * _Nullable responseHeaders, NSError * _Nullable error))completionHandler {
+    NSData *body = [UAEventAPIClient bodyWithEventPayloads:payloads];
+    UARequest *request = [self requestWithBody:body headers:headers];
 
     if (uaLogLevel >= UALogLevelTrace) {
-        UA_LTRACE(@"Sending analytics events with IDs: %@", [events valueForKey:@"event_id"]);
         UA_LTRACE(@"Sending to server: %@", self.config.analyticsURL);
         UA_LTRACE(@"Sending analytics headers: %@", [request.headers descriptionWithLocale:nil indent:1]);
-        UA_LTRACE(@"Sending analytics body: %@", [NSJSONSerialization stringWithObject:events options:NSJSONWritingPrettyPrinted]);
+        UA_LTRACE(@"Sending analytics body: %@", [[NSString alloc] initWithData:body encoding:NSUTF8StringEncoding]);
     }
 
     // Perform the upload
@@ -41,14 +53,36 @@ NSString * const UAEventAPIClientErrorDomain = @"com.urbanairship.event_api_clie
     }];
 }
 
-- (UARequest *)requestWithEvents:(NSArray *)events headers:(NSDictionary<NSString *, NSString *> *)headers {
++ (NSData *)bodyWithEventPayloads:(NSArray<NSData *> *)payloads {
+    NSUInteger length = 2 + (payloads.count ? payloads.count - 1 : 0);
+    for (NSData *payload in payloads) {
+        length += payload.length;
+    }
+
+    NSMutableData *body = [NSMutableData dataWithCapacity:length];
+    [body appendBytes:"[" length:1];
+    [payloads enumerateObjectsUsingBlock:^(NSData *payload, NSUInteger idx, BOOL *stop) {
+        if (idx) {
+            [body appendBytes:"," length:1];
+        }
+        [body appendData:payload];
+    }];
+    [body appendBytes:"]" length:1];
+
+    return body;
+}
+
+- (UARequest *)requestWithBody:(NSData *)body headers:(NSDictionary<NSString *, NSString *> *)headers {
     UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
         builder.URL = [NSURL URLWithString:[NSString stringWithFormat:@"%@%@", self.config.analyticsURL, @"/warp9/"]];
         builder.method = @"POST";
 
         // Body
         builder.compressBody = YES;
-        builder.body = [UAJSONSerialization dataWithJSONObject:events options:0 error:nil];
+        builder.streamBody = YES;
+        builder.priority = NSURLSessionTaskPriorityLow;
+        builder.trafficClass = UARequestTrafficClassDeferrable;
+        builder.body = body;
 
         // Headers
         [builder addHeaders:headers];
@@ -1,53 +1,65 @@
 /* Copyright Airship and Contributors */
 
 #import <Foundation/Foundation.h>
-#import <CoreData/CoreData.h>
+
+NS_ASSUME_NONNULL_BEGIN
 
 /**
- * CoreData class representing the backing data for
- * a UAEvent.
+ * Model object representing a stored event.
  *
  * This class should not ordinarily be used directly.
  */
-@interface UAEventData : NSManagedObject
+@interface UAEventData : NSObject
 
 ///---------------------------------------------------------------------------------------
 /// @name Event Data Internal Properties
 ///---------------------------------------------------------------------------------------
 
 /**
- * The event's session ID.
+ * The event's position in the event store. Store IDs increase monotonically.
  */
-@property (nullable, nonatomic, retain) NSString *sessionID;
+@property (nonatomic, readonly) NSUInteger storeID;
 
 /**
- * The event's Data.
+ * The event's identifier.
  */
-@property (nullable, nonatomic, retain) NSData *data;
+@property (nonatomic, readonly, copy) NSString *identifier;
 
 /**
- * The event's creation time.
+ * The event's session ID.
  */
-@property (nullable, nonatomic, retain) NSString *time;
+@property (nullable, nonatomic, readonly, copy) NSString *sessionID;
 
 /**
- * The event's time.
+ * The event's upload payload. A ready-to-send JSON event with the session ID included.
  */
-@property (nullable, nonatomic, retain) NSNumber *bytes;
+@property (nonatomic, readonly, copy) NSData *payload;
 
 /**
- * The event's type.
+ * The event's size in bytes.
  */
-@property (nullable, nonatomic, retain) NSString *type;
+@property (nonatomic, readonly) NSUInteger bytes;
 
-/**
- * The event's identifier.
- */
-@property (nullable, nonatomic, retain) NSString *identifier;
+///---------------------------------------------------------------------------------------
+/// @name Event Data Internal Methods
+///---------------------------------------------------------------------------------------
 
 /**
- * The event's store date.
+ * Factory method.
+ *
+ * @param storeID The store ID.
+ * @param identifier The event ID.
+ * @param sessionID The session ID.
+ * @param payload The event payload.
+ * @param bytes The event size.
+ * @return A UAEventData instance.
  */
-@property (nullable, nonatomic, retain) NSDate *storeDate;
++ (instancetype)eventDataWithStoreID:(NSUInteger)storeID
+                          identifier:(NSString *)identifier
+                           sessionID:(nullable NSString *)sessionID
+                             payload:(NSData *)payload
+                               bytes:(NSUInteger)bytes;
 
 @end
+
+NS_ASSUME_NONNULL_END
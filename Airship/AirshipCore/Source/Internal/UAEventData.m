@@ -2,14 +2,49 @@
 
 #import "UAEventData+Internal.h"
 
+@interface UAEventData ()
+@property (nonatomic, assign) NSUInteger storeID;
+@property (nonatomic, copy) NSString *identifier;
+@property (nonatomic, copy, nullable) NSString *sessionID;
+@property (nonatomic, copy) NSData *payload;
+@property (nonatomic, assign) NSUInteger bytes;
+@end
+
 @implementation UAEventData
 
-@dynamic sessionID;
-@dynamic data;
-@dynamic bytes;
-@dynamic time;
-@dynamic type;
-@dynamic storeDate;
-@dynamic identifier;
+- (instancetype)initWithStoreID:(NSUInteger)storeID
+                     identifier:(NSString *)identifier
+                      sessionID:(NSString *)sessionID
+                        payload:(NSData *)payload
+                          bytes:(NSUInteger)bytes {
+    self = [super init];
+
+    if (self) {
+        self.storeID = storeID;
+        self.identifier = identifier;
+        self.sessionID = sessionID;
+        self.payload = payload;
+        self.bytes = bytes;
+    }
+
+    return self;
+}
+
++ (instancetype)eventDataWithStoreID:(NSUInteger)storeID
+                          identifier:(NSString *)identifier
+                           sessionID:(NSString *)sessionID
+                             payload:(NSData *)payload
+                               bytes:(NSUInteger)bytes {
+    return [[self alloc] initWithStoreID:storeID
+                              identifier:identifier
+                               sessionID:sessionID
+                                 payload:payload
+                                   bytes:bytes];
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"UAEventData(storeID=%lu, identifier=%@, bytes=%lu)",
+            (unsigned long)self.storeID, self.identifier, (unsigned long)self.bytes];
+}
 
 @end
@@ -0,0 +1,58 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+#import "UADate.h"
+
+@class UAEvent;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Caps the volume of chatty event types before they are stored.
+ *
+ * Rules are keyed by event type. Each rule can sample the events of its type and rate limit them
+ * with a token bucket that refills at `rate` events per second up to `burst` events. Event types
+ * without a rule are always accepted. Rules are parsed from JSON, usually the `event_limits` of
+ * the analytics remote config:
+ *
+ *     {
+ *       "screen_tracking": { "rate": 0.5, "burst": 20 },
+ *       "enhanced_custom_event": { "sample_rate": 0.25 }
+ *     }
+ */
+@interface UAEventLimiter : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Event Limiter Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method.
+ */
++ (instancetype)limiter;
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param date The date, used to refill the token buckets.
+ */
++ (instancetype)limiterWithDate:(UADate *)date;
+
+/**
+ * Replaces the rules. Invalid rules are logged and ignored.
+ *
+ * @param json The rules JSON, or nil to remove all rules.
+ */
+- (void)applyRulesFromJSON:(nullable id)json;
+
+/**
+ * Checks if an event should be stored, taking a token from its rate limit if it has one.
+ *
+ * @param event The event.
+ * @return `YES` if the event should be stored, otherwise `NO`.
+ */
+- (BOOL)acceptEvent:(UAEvent *)event;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,135 @@
+/* Copyright Airship and Contributors */
+
+#import "UAEventLimiter+Internal.h"
+#import "UAEvent.h"
+#import "UAGlobal.h"
+
+static NSString * const UAEventLimitRateKey = @"rate";
+static NSString * const UAEventLimitBurstKey = @"burst";
+static NSString * const UAEventLimitSampleRateKey = @"sample_rate";
+
+@interface UAEventLimitRule : NSObject
+@property (nonatomic, assign) double sampleRate;
+@property (nonatomic, assign) double rate;
+@property (nonatomic, assign) double burst;
+@property (nonatomic, assign) double tokens;
+@property (nonatomic, strong, nullable) NSDate *lastRefill;
+@end
+
+@implementation UAEventLimitRule
+
++ (nullable instancetype)ruleWithJSON:(id)json {
+    if (![json isKindOfClass:[NSDictionary class]]) {
+        return nil;
+    }
+
+    id sampleRate = json[UAEventLimitSampleRateKey];
+    id rate = json[UAEventLimitRateKey];
+    id burst = json[UAEventLimitBurstKey];
+
+    if ((sampleRate && ![sampleRate isKindOfClass:[NSNumber class]]) ||
+        (rate && ![rate isKindOfClass:[NSNumber class]]) ||
+        (burst && ![burst isKindOfClass:[NSNumber class]])) {
+        return nil;
+    }
+
+    UAEventLimitRule *rule = [[self alloc] init];
+    rule.sampleRate = sampleRate ? MIN(MAX([sampleRate doubleValue], 0), 1) : 1;
+    rule.rate = rate ? MAX([rate doubleValue], 0) : -1;
+    rule.burst = burst ? MAX([burst doubleValue], 1) : MAX(rule.rate, 1);
+    rule.tokens = rule.burst;
+    return rule;
+}
+
+- (BOOL)acceptAtDate:(NSDate *)date {
+    if (self.sampleRate < 1 && (double)arc4random() / UINT32_MAX >= self.sampleRate) {
+        return NO;
+    }
+
+    // No rate limit
+    if (self.rate < 0) {
+        return YES;
+    }
+
+    if (self.lastRefill) {
+        NSTimeInterval elapsed = MAX([date timeIntervalSinceDate:self.lastRefill], 0);
+        self.tokens = MIN(self.burst, self.tokens + elapsed * self.rate);
+    }
+    self.lastRefill = date;
+
+    if (self.tokens < 1) {
+        return NO;
+    }
+
+    self.tokens -= 1;
+    return YES;
+}
+
+@end
+
+@interface UAEventLimiter ()
+@property (nonatomic, strong) UADate *date;
+@property (nonatomic, copy) NSDictionary<NSString *, UAEventLimitRule *> *rules;
+@end
+
+@implementation UAEventLimiter
+
+- (instancetype)initWithDate:(UADate *)date {
+    self = [super init];
+    if (self) {
+        self.date = date;
+        self.rules = @{};
+    }
+    return self;
+}
+
++ (instancetype)limiter {
+    return [[self alloc] initWithDate:[[UADate alloc] init]];
+}
+
++ (instancetype)limiterWithDate:(UADate *)date {
+    return [[self alloc] initWithDate:date];
+}
+
+- (void)applyRulesFromJSON:(id)json {
+    NSMutableDictionary<NSString *, UAEventLimitRule *> *rules = [NSMutableDictionary dictionary];
+
+    if (json && ![json isKindOfClass:[NSDictionary class]]) {
+        UA_LERR(@"Invalid event limits: %@", json);
+    } else {
+        for (NSString *eventType in json) {
+            UAEventLimitRule *rule = [UAEventLimitRule ruleWithJSON:json[eventType]];
+            if (!rule) {
+                UA_LERR(@"Invalid event limit for %@: %@", eventType, json[eventType]);
+                continue;
+            }
+            rules[eventType] = rule;
+        }
+    }
+
+    @synchronized (self) {
+        // Remote config is reapplied on every refresh, keep the buckets running
+        [rules enumerateKeysAndObjectsUsingBlock:^(NSString *eventType, UAEventLimitRule *rule, BOOL *stop) {
+            UAEventLimitRule *existing = self.rules[eventType];
+            if (existing.lastRefill) {
+                rule.tokens = MIN(existing.tokens, rule.burst);
+                rule.lastRefill = existing.lastRefill;
+            }
+        }];
+
+        self.rules = rules;
+    }
+}
+
+- (BOOL)acceptEvent:(UAEvent *)event {
+    @synchronized (self) {
+        UAEventLimitRule *rule = self.rules[event.eventType];
+        if (!rule) {
+            return YES;
+        }
+
+        return [rule acceptAtDate:self.date.now];
+    }
+}
+
+@end
@@ -9,6 +9,11 @@
 @class UAPreferenceDataStore;
 @class UAEventAPIClient;
 @class UAEventStore;
+@class UAEventLimiter;
+@class UADisposable;
+@class UATaskQueue;
+@class UANetworkMonitor;
+@class UAExtensionEventJournal;
 
 /**
  * Delegate protocol for the event manager.
@@ -41,11 +46,15 @@
 #define kMinBatchIntervalSeconds (NSTimeInterval)60        // local min of 60s
 #define kMaxBatchIntervalSeconds (NSTimeInterval)7*24*3600  // local max of 7 days
 
+// Number of extra batches that can be uploaded back to back when draining a backlog
+#define kMaxDrainBatches (NSUInteger)20                  // local max of 20, disabled unless the server allows it
+
 // Data store keys
 #define kMaxTotalDBSizeUserDefaultsKey @"X-UA-Max-Total"
 #define kMaxBatchSizeUserDefaultsKey @"X-UA-Max-Batch"
 #define kMaxWaitUserDefaultsKey @"X-UA-Max-Wait"
 #define kMinBatchIntervalUserDefaultsKey @"X-UA-Min-Batch-Interval"
+#define kMaxDrainBatchesUserDefaultsKey @"X-UA-Max-Drain-Batches"
 
 ///---------------------------------------------------------------------------------------
 /// @name Event Manager Internal Properties
@@ -67,6 +76,17 @@
  */
 @property (nonatomic, weak) id<UAEventManagerDelegate> delegate;
 
+/**
+ * The sampling and rate limits applied to events before they are stored.
+ */
+@property (nonatomic, strong) UAEventLimiter *eventLimiter;
+
+/**
+ * The journal of events recorded by the app extensions. Its events are moved into the
+ * event store on launch and when the app comes to the foreground. `nil` when no app group is set.
+ */
+@property (nonatomic, strong, nullable) UAExtensionEventJournal *eventJournal;
+
 
 ///---------------------------------------------------------------------------------------
 /// @name Event Manager Internal Methods
@@ -90,9 +110,10 @@
  * @param channel The channel instance.
  * @param eventStore The event data store.
  * @param client The event api client.
- * @param queue The operation queue.
+ * @param queue The task queue.
  * @param notificationCenter The notification center.
  * @param appStateTracker The app state tracker..
+ * @param networkMonitor The network monitor.
  * @return UAEventManager instance.
  */
 + (instancetype)eventManagerWithConfig:(UARuntimeConfig *)config
@@ -100,9 +121,10 @@
                                channel:(UAChannel *)channel
                             eventStore:(UAEventStore *)eventStore
                                 client:(UAEventAPIClient *)client
-                                 queue:(NSOperationQueue *)queue
+                                 queue:(UATaskQueue *)queue
                     notificationCenter:(NSNotificationCenter *)notificationCenter
-                       appStateTracker:(UAAppStateTracker *)appStateTracker;
+                       appStateTracker:(UAAppStateTracker *)appStateTracker
+                        networkMonitor:(UANetworkMonitor *)networkMonitor;
 
 /**
  * Adds an analytic event to be batched and uploaded to Airship.
@@ -112,6 +134,25 @@
  */
 - (void)addEvent:(UAEvent *)event sessionID:(NSString *)sessionID;
 
+/**
+ * Adds a batch of analytic events, written to the event store in a single transaction.
+ *
+ * @param events The analytic events.
+ * @param sessionID The analytic session ID.
+ */
+- (void)addEvents:(NSArray<UAEvent *> *)events sessionID:(NSString *)sessionID;
+
+/**
+ * Moves the events recorded by the app extensions into the event store. The events are
+ * discarded if uploads are disabled.
+ */
+- (void)ingestExtensionEvents;
+
+/**
+ * Writes any buffered events to the event store immediately.
+ */
+- (void)savePendingEvents;
+
 /**
  * Deletes all events and cancels any uploads in progress.
  */
@@ -127,4 +168,12 @@
  */
 - (void)cancelUpload;
 
+/**
+ * Uploads the stored events now, without the batch interval delays. Used by background work.
+ *
+ * @param completionHandler Called once the upload has finished, with `NO` if it was cancelled.
+ * @return A disposable that cancels the upload, or nil if no upload was started.
+ */
+- (UADisposable *)uploadEventsWithCompletionHandler:(void (^)(BOOL success))completionHandler;
+
 @end
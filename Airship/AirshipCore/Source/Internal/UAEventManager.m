@@ -5,15 +5,20 @@
 #import "UAPreferenceDataStore+Internal.h"
 #import "UAEventStore+Internal.h"
 #import "UAEventData+Internal.h"
-#import "UAAsyncOperation.h"
+#import "UATaskQueue.h"
 #import "UAEventAPIClient+Internal.h"
 #import "UAEvent+Internal.h"
 #import "UARuntimeConfig.h"
 #import "UAChannel.h"
 #import "UAirship.h"
-#import "NSOperationQueue+UAAdditions.h"
 #import "UADispatcher.h"
 #import "UAAppStateTracker.h"
+#import "UAMetricsRegistry.h"
+#import "UAEventLimiter+Internal.h"
+#import "UADisposable.h"
+#import "UANetworkMonitor.h"
+#import "UANetworkWindow.h"
+#import "UAExtensionEventJournal+Internal.h"
 
 @interface UAEventManager()
 
@@ -24,16 +29,43 @@
 @property (nonatomic, strong, nonnull) NSNotificationCenter *notificationCenter;
 @property (nonatomic, strong, nonnull) UAAppStateTracker *appStateTracker;
 @property (nonatomic, strong, nonnull) UAChannel *channel;
+@property (nonatomic, strong, nonnull) UANetworkMonitor *networkMonitor;
 
 @property (nonatomic, assign) NSUInteger maxTotalDBSize;
 @property (nonatomic, assign) NSUInteger maxBatchSize;
 @property (nonatomic, assign) NSUInteger minBatchInterval;
+@property (nonatomic, assign) NSUInteger maxDrainBatches;
 
 @property (atomic, strong) NSDate *earliestForegroundSendTime;
 @property (atomic, strong, nonnull) NSDate *lastSendTime;
-@property (nonatomic, strong, nonnull) NSOperationQueue *queue;
+@property (nonatomic, strong, nonnull) UATaskQueue *queue;
 @property (atomic, strong, nullable) NSDate *nextUploadDate;
 
+/**
+ * Set when an upload was skipped or failed while offline, so it resumes once the network returns.
+ */
+@property (atomic, assign) BOOL heldForConnectivity;
+
+/**
+ * When uploads started being held for Low Data Mode.
+ */
+@property (atomic, strong, nullable) NSDate *lowDataModeHoldDate;
+
+/**
+ * The earliest upload date requested since the last scheduling dispatch.
+ */
+@property (nonatomic, strong, nullable) NSDate *requestedUploadDate;
+
+/**
+ * Serial dispatcher the uploads are scheduled on.
+ */
+@property (nonatomic, strong, nonnull) UADispatcher *scheduleDispatcher;
+
+/**
+ * Serial dispatcher the extension event journal is collected on.
+ */
+@property (nonatomic, strong, nonnull) UADispatcher *journalDispatcher;
+
 @end
 
 static NSTimeInterval const FailedUploadRetryDelay = 60;
@@ -41,6 +73,10 @@ static NSTimeInterval const InitialForegroundUploadDelay = 15;
 static NSTimeInterval const HighPriorityUploadDelay = 1;
 static NSTimeInterval const BackgroundUploadDelay = 5;
 static NSTimeInterval const BackgroundLowPriorityEventUploadInterval = 900;
+static NSTimeInterval const LowDataModeMaxUploadDeferral = 3600;
+
+// Coalescing key for the dispatch that schedules uploads
+static NSString * const UAEventManagerScheduleUploadKey = @"com.urbanairship.event_manager.schedule_upload";
 
 @implementation UAEventManager
 
@@ -49,9 +85,10 @@ static NSTimeInterval const BackgroundLowPriorityEventUploadInterval = 900;
                        channel:(UAChannel *)channel
                     eventStore:(UAEventStore *)eventStore
                         client:(UAEventAPIClient *)client
-                         queue:(NSOperationQueue *)queue
+                         queue:(UATaskQueue *)queue
             notificationCenter:(NSNotificationCenter *)notificationCenter
-               appStateTracker:(UAAppStateTracker *)appStateTracker {
+               appStateTracker:(UAAppStateTracker *)appStateTracker
+                networkMonitor:(UANetworkMonitor *)networkMonitor {
 
     self = [super init];
 
@@ -64,6 +101,10 @@ static NSTimeInterval const BackgroundLowPriorityEventUploadInterval = 900;
         self.queue = queue;
         self.notificationCenter = notificationCenter;
         self.appStateTracker = appStateTracker;
+        self.networkMonitor = networkMonitor;
+        self.scheduleDispatcher = [UADispatcher serialDispatcherForWorkType:UADispatcherWorkTypeUpload];
+        self.journalDispatcher = [UADispatcher serialDispatcherForWorkType:UADispatcherWorkTypeProcessing];
+        self.eventLimiter = [UAEventLimiter limiter];
 
         _uploadsEnabled = YES;
 
@@ -86,6 +127,16 @@ static NSTimeInterval const BackgroundLowPriorityEventUploadInterval = 900;
                                     selector:@selector(applicationDidEnterBackground)
                                         name:UAApplicationDidEnterBackgroundNotification
                                       object:nil];
+
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(networkConnectivityChanged)
+                                        name:UANetworkConnectivityChangedEvent
+                                      object:nil];
+
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(networkWindowOpened)
+                                        name:UANetworkWindowOpenedEvent
+                                      object:nil];
     }
 
     return self;
@@ -102,18 +153,21 @@ static NSTimeInterval const BackgroundLowPriorityEventUploadInterval = 900;
     UAEventStore *eventStore = [UAEventStore eventStoreWithConfig:config];
     UAEventAPIClient *client = [UAEventAPIClient clientWithConfig:config];
 
-    NSOperationQueue *queue = [[NSOperationQueue alloc] init];
-    queue.maxConcurrentOperationCount = 1;
-
-    return [[self alloc] initWithConfig:config
-                              dataStore:dataStore
-                                channel:channel
-                             eventStore:eventStore
-                                 client:client
-                                  queue:queue
-                     notificationCenter:[NSNotificationCenter defaultCenter]
-                        appStateTracker:[UAAppStateTracker shared]];
-
+    UAEventManager *eventManager = [[self alloc] initWithConfig:config
+                                                      dataStore:dataStore
+                                                        channel:channel
+                                                     eventStore:eventStore
+                                                         client:client
+                                                          queue:[UATaskQueue serialQueue]
+                                             notificationCenter:[NSNotificationCenter defaultCenter]
+                                                appStateTracker:[UAAppStateTracker shared]
+                                                 networkMonitor:[UANetworkMonitor shared]];
+
+    // Events may have been recorded by the extensions while the app was not running
+    eventManager.eventJournal = [UAExtensionEventJournal journal];
+    [eventManager scheduleExtensionEventIngest];
+
+    return eventManager;
 }
 
 + (instancetype)eventManagerWithConfig:(UARuntimeConfig *)config
@@ -121,9 +175,10 @@ static NSTimeInterval const BackgroundLowPriorityEventUploadInterval = 900;
                                channel:(UAChannel *)channel
                             eventStore:(UAEventStore *)eventStore
                                 client:(UAEventAPIClient *)client
-                                 queue:(NSOperationQueue *)queue
+                                 queue:(UATaskQueue *)queue
                     notificationCenter:(NSNotificationCenter *)notificationCenter
-                       appStateTracker:(UAAppStateTracker *)appStateTracker {
+                       appStateTracker:(UAAppStateTracker *)appStateTracker
+                        networkMonitor:(UANetworkMonitor *)networkMonitor {
 
     return [[self alloc] initWithConfig:config
                               dataStore:dataStore
@@ -132,7 +187,8 @@ static NSTimeInterval const BackgroundLowPriorityEventUploadInterval = 900;
                                  client:client
                                   queue:queue
                      notificationCenter:notificationCenter
-                        appStateTracker:appStateTracker];
+                        appStateTracker:appStateTracker
+                         networkMonitor:networkMonitor];
 }
 
 - (void)setUploadsEnabled:(BOOL)uploadsEnabled {
@@ -151,6 +207,7 @@ static NSTimeInterval const BackgroundLowPriorityEventUploadInterval = 900;
 
 - (void)applicationWillEnterForeground {
     [self cancelUpload];
+    [self scheduleExtensionEventIngest];
 
     // Reset the initial delay
     self.earliestForegroundSendTime = [NSDate dateWithTimeIntervalSinceNow:InitialForegroundUploadDelay];
@@ -160,6 +217,34 @@ static NSTimeInterval const BackgroundLowPriorityEventUploadInterval = 900;
     [self scheduleUploadWithDelay:BackgroundUploadDelay];
 }
 
+- (void)networkConnectivityChanged {
+    if (self.heldForConnectivity && self.networkMonitor.isConnected && !self.networkMonitor.isConstrained) {
+        UA_LTRACE(@"Network connectivity restored, resuming event uploads.");
+        self.heldForConnectivity = NO;
+        [self scheduleUpload];
+    }
+}
+
+- (void)networkWindowOpened {
+    if (!self.uploadsEnabled || self.heldForConnectivity) {
+        return;
+    }
+
+    // Only pull forward an upload that is already waiting, and never inside the batch or initial delays
+    NSDate *nextUploadDate = self.nextUploadDate;
+    if (!nextUploadDate || [nextUploadDate timeIntervalSinceNow] <= 1) {
+        return;
+    }
+
+    NSTimeInterval timeSinceLastSend = [[NSDate date] timeIntervalSinceDate:self.lastSendTime];
+    if (timeSinceLastSend < self.minBatchInterval || [self.earliestForegroundSendTime timeIntervalSinceNow] > 0) {
+        return;
+    }
+
+    UA_LTRACE(@"Network window opened, uploading pending events early.");
+    [self scheduleUploadWithDelay:0];
+}
+
 #pragma mark -
 #pragma mark Preferences
 
@@ -188,6 +273,10 @@ static NSTimeInterval const BackgroundLowPriorityEventUploadInterval = 900;
     if (minBatchValue) {
         self.minBatchInterval = (NSUInteger)[minBatchValue integerValue];
     }
+
+    // Missing means the server does not allow draining, so always update it
+    id maxDrainValue = [responseHeaders objectForKey:@"X-UA-Max-Drain-Batches"];
+    self.maxDrainBatches = (NSUInteger)MAX([maxDrainValue integerValue], 0);
 }
 
 - (void)setMaxTotalDBSize:(NSUInteger)maxTotalDBSize {
@@ -217,10 +306,25 @@ static NSTimeInterval const BackgroundLowPriorityEventUploadInterval = 900;
     return [UAEventManager clampValue:value min:kMinBatchIntervalSeconds max:kMaxBatchIntervalSeconds];
 }
 
+- (void)setMaxDrainBatches:(NSUInteger)maxDrainBatches {
+    [self.dataStore setInteger:maxDrainBatches forKey:kMaxDrainBatchesUserDefaultsKey];
+}
+
+- (NSUInteger)maxDrainBatches {
+    NSUInteger value = (NSUInteger)[self.dataStore integerForKey:kMaxDrainBatchesUserDefaultsKey];
+    return [UAEventManager clampValue:value min:0 max:kMaxDrainBatches];
+}
+
 #pragma mark -
 #pragma mark Events
 
 - (void)addEvent:(UAEvent *)event sessionID:(NSString *)sessionID {
+    if (![self.eventLimiter acceptEvent:event]) {
+        UA_LTRACE(@"Event %@ dropped by the %@ event limits", event.eventID, event.eventType);
+        [[UAMetricsRegistry shared] incrementCounter:UAMetricEventsLimited by:1];
+        return;
+    }
+
     [self.eventStore saveEvent:event sessionID:sessionID];
 
     if (!self.uploadsEnabled) {
@@ -250,6 +354,61 @@ static NSTimeInterval const BackgroundLowPriorityEventUploadInterval = 900;
     }
 }
 
+- (void)addEvents:(NSArray<UAEvent *> *)events sessionID:(NSString *)sessionID {
+    NSUInteger limited = 0;
+    for (UAEvent *event in events) {
+        if (![self.eventLimiter acceptEvent:event]) {
+            limited++;
+            continue;
+        }
+        [self.eventStore saveEvent:event sessionID:sessionID];
+    }
+
+    if (limited) {
+        UA_LTRACE(@"%lu events dropped by the event limits", (unsigned long)limited);
+        [[UAMetricsRegistry shared] incrementCounter:UAMetricEventsLimited by:limited];
+    }
+
+    [self.eventStore savePendingEvents];
+
+    if (self.uploadsEnabled) {
+        [self scheduleUpload];
+    }
+}
+
+- (void)scheduleExtensionEventIngest {
+    if (!self.eventJournal) {
+        return;
+    }
+
+    UA_WEAKIFY(self)
+    [self.journalDispatcher dispatchAsync:^{
+        UA_STRONGIFY(self)
+        [self ingestExtensionEvents];
+    }];
+}
+
+- (void)ingestExtensionEvents {
+    NSArray<UAEvent *> *events = [self.eventJournal collectEvents];
+    if (!events.count) {
+        return;
+    }
+
+    if (!self.uploadsEnabled) {
+        UA_LDEBUG(@"Uploads disabled, discarding %lu events recorded by the extensions", (unsigned long)events.count);
+        return;
+    }
+
+    UA_LDEBUG(@"Collected %lu events recorded by the extensions", (unsigned long)events.count);
+
+    // Recorded outside of an app session
+    [self addEvents:events sessionID:nil];
+}
+
+- (void)savePendingEvents {
+    [self.eventStore savePendingEvents];
+}
+
 - (void)deleteAllEvents {
     [self.eventStore deleteAllEvents];
     [self cancelUpload];
@@ -259,7 +418,7 @@ static NSTimeInterval const BackgroundLowPriorityEventUploadInterval = 900;
 #pragma mark Event upload
 
 - (void)cancelUpload {
-    [self.queue cancelAllOperations];
+    [self.queue cancelAllTasks];
     [self.client cancelAllRequests];
     self.nextUploadDate = nil;
 }
@@ -294,18 +453,32 @@ static NSTimeInterval const BackgroundLowPriorityEventUploadInterval = 900;
         return;
     }
 
-    UA_LTRACE(@"Enqueuing attempt to schedule event upload with delay on main queue.");
+    UA_LTRACE(@"Enqueuing attempt to schedule event upload with delay.");
+
+    // Requests made before the scheduling dispatch runs collapse into the earliest one
+    NSDate *requestedDate = [NSDate dateWithTimeIntervalSinceNow:delay];
+    @synchronized (self) {
+        if (!self.requestedUploadDate || [requestedDate compare:self.requestedUploadDate] == NSOrderedAscending) {
+            self.requestedUploadDate = requestedDate;
+        }
+    }
 
     UA_WEAKIFY(self);
-    [[UADispatcher mainDispatcher] dispatchAsync:^{
+    [self.scheduleDispatcher dispatchAsync:^{
         UA_STRONGIFY(self);
-        if (!self.uploadsEnabled) {
+        NSDate *uploadDate;
+        @synchronized (self) {
+            uploadDate = self.requestedUploadDate;
+            self.requestedUploadDate = nil;
+        }
+
+        if (!uploadDate || !self.uploadsEnabled) {
             return;
         }
 
+        NSTimeInterval delay = MAX([uploadDate timeIntervalSinceNow], 0);
         UA_LTRACE(@"Attempting to schedule event upload with delay: %f seconds.", delay);
 
-        NSDate *uploadDate = [NSDate dateWithTimeIntervalSinceNow:delay];
         NSTimeInterval timeDifference = [self.nextUploadDate timeIntervalSinceDate:uploadDate];
         if (self.nextUploadDate && timeDifference >= 0 && timeDifference <= 1) {
             UA_LTRACE("Upload already scheduled for an earlier time.");
@@ -313,24 +486,56 @@ static NSTimeInterval const BackgroundLowPriorityEventUploadInterval = 900;
         }
 
         if (self.nextUploadDate) {
-            [self.queue cancelAllOperations];
+            [self.queue cancelAllTasks];
             self.nextUploadDate = nil;
         }
 
         UA_LTRACE(@"Scheduling upload.");
-        if ([self enqueueUploadOperationWithDelay:delay]) {
+        if ([self enqueueUploadTaskWithDelay:delay]) {
             self.nextUploadDate = uploadDate;
         }
+    } coalescingKey:UAEventManagerScheduleUploadKey];
+}
+
+- (UADisposable *)uploadEventsWithCompletionHandler:(void (^)(BOOL success))completionHandler {
+    if (!self.uploadsEnabled) {
+        completionHandler(YES);
+        return nil;
+    }
+
+    UATask *task = [self uploadTask];
+    UA_WEAKIFY(task);
+    task.completionBlock = ^{
+        UA_STRONGIFY(task);
+        completionHandler(!task.isCancelled);
+    };
+
+    if (![self.queue addBackgroundTask:task delay:0]) {
+        completionHandler(NO);
+        return nil;
+    }
+
+    // Cancelling keeps the batches that were already uploaded deleted
+    UA_WEAKIFY(self);
+    return [UADisposable disposableWithBlock:^{
+        UA_STRONGIFY(self);
+        UA_STRONGIFY(task);
+        [task cancel];
+        [self.client cancelAllRequests];
     }];
 }
 
-- (BOOL)enqueueUploadOperationWithDelay:(NSTimeInterval)delay {
+- (BOOL)enqueueUploadTaskWithDelay:(NSTimeInterval)delay {
+    return [self.queue addBackgroundTask:[self uploadTask] delay:delay];
+}
 
+- (UATask *)uploadTask {
     UA_WEAKIFY(self);
 
-    UAAsyncOperation *operation = [UAAsyncOperation operationWithBlock:^(UAAsyncOperation *operation) {
+    UATask *task = [UATask taskWithBlock:^(UATask *task) {
         UA_STRONGIFY(self);
         if (!self.uploadsEnabled) {
+            [task finish];
             return;
         }
 
@@ -340,87 +545,142 @@ static NSTimeInterval const BackgroundLowPriorityEventUploadInterval = 900;
 
         if (!self.channel.identifier) {
             UA_LTRACE("No Channel ID. Skipping analytic upload.");
-            [operation finish];
+            [task finish];
             return;
         }
 
-        // Clean up store
+        // Clean up store, even while uploads are held so the store stays within its size limit offline
         [self.eventStore trimEventsToStoreSize:self.maxTotalDBSize];
 
+        if ([self holdForConnectivity]) {
+            [task finish];
+            return;
+        }
+
         // Fetch events
         [self.eventStore fetchEventsWithMaxBatchSize:self.maxBatchSize completionHandler:^(NSArray<UAEventData *> *result) {
 
             // Make sure we are not cancelled
-            if (operation.isCancelled) {
-                [operation finish];
+            if (task.isCancelled) {
+                [task finish];
                 return;
             }
 
             if (!result.count) {
-                [operation finish];
+                [task finish];
                 return;
             }
 
-            NSMutableArray *preparedEvents = [NSMutableArray arrayWithCapacity:result.count];
+            UA_STRONGIFY(self);
+            [self uploadBatch:result drainedBatches:0 task:task];
+        }];
+    }];
 
-            for (UAEventData *eventData in result) {
-                NSMutableDictionary *eventBody = [NSMutableDictionary dictionary];
-                [eventBody setValue:eventData.identifier forKey:@"event_id"];
-                [eventBody setValue:eventData.time forKey:@"time"];
-                [eventBody setValue:eventData.type forKey:@"type"];
+    return task;
+}
 
-                NSError *error = nil;
-                NSMutableDictionary *data = [[NSJSONSerialization JSONObjectWithData:eventData.data options:0 error:&error] mutableCopy];
-                if (error) {
-                    UA_LERR(@"Failed to deserialize event %@: %@", eventData, error);
-                    [[eventData managedObjectContext] deleteObject:eventData];
-                }
+/**
+ * Uploads a batch of events. While a backlog larger than a batch remains and the server allows
+ * draining, the next batch is read during the upload and sent right after it, all within the
+ * task's background task.
+ */
+- (void)uploadBatch:(NSArray<UAEventData *> *)batch
+     drainedBatches:(NSUInteger)drainedBatches
+               task:(UATask *)task {
+
+    NSUInteger lastStoreID = batch.lastObject.storeID;
+    NSUInteger batchBytes = [[batch valueForKeyPath:@"@sum.bytes"] unsignedIntegerValue];
+    BOOL drain = drainedBatches < self.maxDrainBatches && self.eventStore.storeSize > batchBytes + self.maxBatchSize;
+
+    dispatch_group_t group = dispatch_group_create();
+    __block NSArray<UAEventData *> *nextBatch;
+    __block BOOL uploaded = NO;
+
+    if (drain) {
+        dispatch_group_enter(group);
+        [self.eventStore fetchEventsWithMaxBatchSize:self.maxBatchSize afterStoreID:lastStoreID completionHandler:^(NSArray<UAEventData *> *result) {
+            nextBatch = result;
+            dispatch_group_leave(group);
+        }];
+    }
 
-                [data setValue:eventData.sessionID forKey:@"session_id"];
-                [eventBody setValue:data forKey:@"data"];
+    UA_LTRACE("Uploading events.");
 
-                [preparedEvents addObject:eventBody];
-            }
+    NSDictionary *headers = [self.delegate analyticsHeaders] ?: @{};
+    NSTimeInterval uploadStart = [NSProcessInfo processInfo].systemUptime;
 
-            // Make sure we are not cancelled
-            if (operation.isCancelled) {
-                [operation finish];
-                return;
-            }
+    dispatch_group_enter(group);
+    UA_WEAKIFY(self);
+    [self.client uploadEventPayloads:[batch valueForKey:@"payload"] headers:headers completionHandler:^(NSDictionary * _Nullable responseHeaders, NSError * _Nullable error) {
+        UA_STRONGIFY(self);
+        self.lastSendTime = [NSDate date];
 
-            UA_LTRACE("Uploading events.");
+        UAMetricsRegistry *metrics = [UAMetricsRegistry shared];
+        [[metrics durationHistogramWithName:UAMetricEventUploadDuration] recordValue:[NSProcessInfo processInfo].systemUptime - uploadStart];
+        [metrics incrementCounter:error ? UAMetricEventUploadFailures : UAMetricEventUploads by:1];
 
-            // Make sure the event upload request is queueed and on the main thread as it needs to access application state
-            [[UADispatcher mainDispatcher] dispatchAsync: ^{
-                // Make sure we are still not cancelled
-                if (operation.isCancelled) {
-                    [operation finish];
-                    return;
-                }
+        if (!error) {
+            UA_LTRACE(@"Analytic upload success");
+            [self.eventStore deleteEventsUpToStoreID:lastStoreID];
+            [self updateAnalyticsParametersWithResponseHeaders:responseHeaders];
+            uploaded = YES;
+        } else {
+            UA_LTRACE(@"Analytics upload request failed: %@", error);
+            if (![self holdForConnectivity]) {
+                [self scheduleUploadWithDelay:FailedUploadRetryDelay];
+            }
+        }
 
-                NSDictionary *headers = [self.delegate analyticsHeaders] ?: @{};
-
-                UA_STRONGIFY(self);
-                [self.client uploadEvents:preparedEvents headers:headers completionHandler:^(NSDictionary * _Nullable responseHeaders, NSError * _Nullable error) {
-                    UA_STRONGIFY(self);
-                    self.lastSendTime = [NSDate date];
-
-                    if (!error) {
-                        UA_LTRACE(@"Analytic upload success");
-                        [self.eventStore deleteEventsWithIDs:[preparedEvents valueForKey:@"event_id"]];
-                        [self updateAnalyticsParametersWithResponseHeaders:responseHeaders];
-                    } else {
-                        UA_LTRACE(@"Analytics upload request failed: %@", error);
-                        [self scheduleUploadWithDelay:FailedUploadRetryDelay];
-                    }
-
-                    [operation finish];
-                }];
-            }];
-        }];
+        dispatch_group_leave(group);
     }];
 
-    return [self.queue addBackgroundOperation:operation delay:delay];
+    dispatch_group_notify(group, dispatch_get_global_queue([UADispatcher qosClassForWorkType:UADispatcherWorkTypeUpload], 0), ^{
+        UA_STRONGIFY(self);
+        if (!uploaded || !nextBatch.count || task.isCancelled || !self.uploadsEnabled) {
+            [task finish];
+            return;
+        }
+
+        UA_LTRACE(@"Draining event backlog, batch %lu", (unsigned long)drainedBatches + 1);
+        [self uploadBatch:nextBatch drainedBatches:drainedBatches + 1 task:task];
+    });
+}
+
+/**
+ * Checks whether uploads should wait for the network. Analytics is deferrable traffic, so it also
+ * waits out Low Data Mode, up to a maximum deferral or until a full batch is pending. The held flag
+ * is set before checking so a connectivity change that lands in between still resumes the upload.
+ *
+ * @return `YES` if the upload should be held.
+ */
+- (BOOL)holdForConnectivity {
+    self.heldForConnectivity = YES;
+    if (!self.networkMonitor.isConnected) {
+        UA_LTRACE(@"No network connectivity, holding event uploads.");
+        return YES;
+    }
+
+    if (self.networkMonitor.isConstrained) {
+        NSDate *now = [NSDate date];
+        if (!self.lowDataModeHoldDate) {
+            self.lowDataModeHoldDate = now;
+        }
+
+        NSTimeInterval heldTime = [now timeIntervalSinceDate:self.lowDataModeHoldDate];
+        if (heldTime < LowDataModeMaxUploadDeferral && self.eventStore.storeSize < self.maxBatchSize) {
+            UA_LTRACE(@"Low Data Mode enabled, holding event uploads.");
+
+            // Upload once the maximum deferral passes even if Low Data Mode stays on
+            [self scheduleUploadWithDelay:LowDataModeMaxUploadDeferral - heldTime];
+            return YES;
+        }
+
+        UA_LTRACE(@"Low Data Mode enabled, uploading deferred events.");
+    }
+
+    self.lowDataModeHoldDate = nil;
+    self.heldForConnectivity = NO;
+    return NO;
 }
 
 #pragma mark -
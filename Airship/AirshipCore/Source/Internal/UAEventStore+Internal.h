@@ -7,7 +7,8 @@
 @class UARuntimeConfig;
 
 /**
- * Storage access for analytic events.
+ * Storage access for analytic events. Events are kept in an append-only SQLite log
+ * ordered by store ID.
  */
 @interface UAEventStore : NSObject
 
@@ -24,7 +25,8 @@
 + (instancetype)eventStoreWithConfig:(UARuntimeConfig *)config;
 
 /**
- * Saves an event.
+ * Saves an event. Events saved within a short window are buffered and
+ * written to the store in a single save.
  *
  * @param event The event to store.
  * @param sessionID The event's session ID.
@@ -32,14 +34,45 @@
 - (void)saveEvent:(UAEvent *)event sessionID:(NSString *)sessionID;
 
 /**
- * Fetches a batch of events.
+ * Writes any buffered events to the store immediately.
+ */
+- (void)savePendingEvents;
+
+/**
+ * The size of the stored events in bytes, as of the last store operation.
+ */
+@property (nonatomic, readonly) NSUInteger storeSize;
+
+/**
+ * Fetches a batch of events, oldest first, starting after a store ID. Used to read the next
+ * batch while the previous one is still uploading.
+ *
+ * @param maxBatchSize The max event batch size in bytes.
+ * @param storeID Only events with a greater store ID are fetched.
+ * @param completionHandler A completion handler with the event data.
+ */
+- (void)fetchEventsWithMaxBatchSize:(NSUInteger)maxBatchSize
+                       afterStoreID:(NSUInteger)storeID
+                  completionHandler:(void (^)(NSArray<UAEventData *> *))completionHandler;
+
+/**
+ * Fetches a batch of events, oldest first. The batch is bounded by the combined
+ * size of the events, so only the events that will be uploaded are loaded.
  *
- * @param maxBatchSize The max event batch size.
+ * @param maxBatchSize The max event batch size in bytes.
  * @param completionHandler A completion handler with the event data.
  */
 - (void)fetchEventsWithMaxBatchSize:(NSUInteger)maxBatchSize
                   completionHandler:(void (^)(NSArray<UAEventData *> *))completionHandler;
 
+/**
+ * Deletes every event up to and including the given store ID. Used to remove an
+ * uploaded batch with a single range delete.
+ *
+ * @param storeID The store ID of the last event to delete.
+ */
+- (void)deleteEventsUpToStoreID:(NSUInteger)storeID;
+
 /**
  * Deletes a set of events.
  *
@@ -48,7 +81,8 @@
 - (void)deleteEventsWithIDs:(NSArray<NSString *> *)eventIds;
 
 /**
- * Deletes event session until the underlying store is below a given size.
+ * Deletes events until the underlying store is below a given size. Low priority events are
+ * deleted first, then normal and finally high priority events, oldest first within each priority.
  * @param bytes The desired size in bytes for the store size.
  */
 - (void)trimEventsToStoreSize:(NSUInteger)bytes;
@@ -58,4 +92,9 @@
  */
 - (void)deleteAllEvents;
 
+/**
+ * Blocks until all pending store operations have finished. Useful for testing.
+ */
+- (void)waitForIdle;
+
 @end
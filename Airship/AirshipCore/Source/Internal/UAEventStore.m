@@ -1,25 +1,50 @@
 /* Copyright Airship and Contributors */
 
 #import "UAEventData+Internal.h"
-#import "NSJSONSerialization+UAAdditions.h"
 
 #import "UAEventStore+Internal.h"
 #import "NSManagedObjectContext+UAAdditions.h"
 #import <CoreData/CoreData.h>
+#import <UIKit/UIKit.h>
 #import "UARuntimeConfig.h"
 #import "UAEvent.h"
 #import "UAirship.h"
 #import "UASQLite+Internal.h"
 #import "UAJSONSerialization.h"
 #import "UAirshipCoreResources.h"
+#import "UADispatcher.h"
+#import "UAUtils+Internal.h"
+#import "UAMetricsRegistry.h"
 
-NSString *const UAEventStoreFileFormat = @"Events-%@.sqlite";
+NSString *const UAEventStoreFileFormat = @"EventLog-%@.sqlite";
+NSString *const UAEventStoreCoreDataFileFormat = @"Events-%@.sqlite";
 NSString *const UAEventDataEntityName = @"UAEventData";
 
-@interface UAEventStore ()
-@property (nonatomic, strong) NSManagedObjectContext *managedContext;
-@property (nonatomic, copy) NSString *storeName;
+// Number of event rows read per page when building an upload batch or trimming
+static NSUInteger const UAEventStoreFetchPageSize = 100;
+
+// Events saved within this window are written in a single transaction
+static NSTimeInterval const UAEventStoreWriteCoalescingWindow = 0.5;
+
+// Max number of events held in memory while the store can't be opened
+static NSUInteger const UAEventStoreSpillLimit = 500;
 
+@interface UAEventStore ()
+@property (nonatomic, copy) NSString *appKey;
+@property (nonatomic, strong) UASQLite *db;
+@property (nonatomic, assign) NSUInteger storeSize;
+@property (nonatomic, strong) UADispatcher *dispatcher;
+@property (nonatomic, strong) UADispatcher *pendingEventsDispatcher;
+@property (nonatomic, strong) NSMutableArray<NSDictionary *> *pendingEvents;
+@property (nonatomic, strong) UADisposable *pendingEventsDisposable;
+
+/**
+ * Events that could not be written because the store was unavailable, oldest first. Only
+ * accessed on the store's dispatcher.
+ */
+@property (nonatomic, strong) NSMutableArray<NSDictionary *> *spilledEvents;
+@property (nonatomic, strong) UAMetricHistogram *flushDurationHistogram;
+@property (nonatomic, strong) UAMetricCounter *writeCounter;
 @end
 
 @implementation UAEventStore
@@ -28,147 +53,550 @@ NSString *const UAEventDataEntityName = @"UAEventData";
     self = [super init];
 
     if (self) {
-        self.storeName = [NSString stringWithFormat:UAEventStoreFileFormat, config.appKey];
-        NSURL *modelURL = [[UAirshipCoreResources bundle] URLForResource:@"UAEvents" withExtension:@"momd"];
-        self.managedContext = [NSManagedObjectContext managedObjectContextForModelURL:modelURL
-                                                                      concurrencyType:NSPrivateQueueConcurrencyType];
-
-        [self addPersistentStore];
+        self.appKey = config.appKey;
+        self.pendingEvents = [NSMutableArray array];
+        self.spilledEvents = [NSMutableArray array];
+        self.dispatcher = [UADispatcher serialDispatcherForWorkType:UADispatcherWorkTypeProcessing];
+        self.pendingEventsDispatcher = [UADispatcher globalDispatcherForWorkType:UADispatcherWorkTypeProcessing];
+
+        [self.dispatcher dispatchAsync:^{
+            [self openDatabaseIfNeeded];
+        }];
+
+        UAMetricsRegistry *metrics = [UAMetricsRegistry shared];
+        self.flushDurationHistogram = [metrics durationHistogramWithName:UAMetricEventStoreFlushDuration];
+        self.writeCounter = [metrics counterWithName:UAMetricEventStoreWrites];
+
+        UA_WEAKIFY(self)
+        [metrics registerGaugeForMetric:UAMetricEventStoreSize block:^double{
+            UA_STRONGIFY(self)
+            return self.storeSize;
+        }];
+
+        // The store is file protected, so it can't be opened while the device is locked
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(protectedDataAvailable)
+                                                     name:UIApplicationProtectedDataDidBecomeAvailable
+                                                   object:nil];
     }
 
     return self;
 }
 
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
 + (instancetype)eventStoreWithConfig:(UARuntimeConfig *)config {
     return [[UAEventStore alloc] initWithConfig:config];
 }
 
-- (void)addPersistentStore {
-    UA_WEAKIFY(self);
-    [self.managedContext addPersistentSqlStore:self.storeName completionHandler:^(NSPersistentStore *store, NSError *error) {
-        UA_STRONGIFY(self)
-        if (!store) {
-            UA_LERR(@"Failed to create analytics persistent store: %@", error);
-            return;
+#pragma mark -
+#pragma mark Database
+
+/**
+ * Opens the event log, creating the table and migrating older stores on first use. Opening
+ * can fail while protected data is unavailable, so every operation calls this first.
+ *
+ * Must be called on the store's dispatcher.
+ */
+- (BOOL)openDatabaseIfNeeded {
+    if (self.db) {
+        return YES;
+    }
+
+    NSError *error;
+    NSURL *directoryURL = [UAUtils noBackupDirectoryURL:&error];
+    if (!directoryURL) {
+        UA_LERR(@"Failed to create analytics event store directory: %@", error);
+        return NO;
+    }
+
+    NSString *fileName = [NSString stringWithFormat:UAEventStoreFileFormat, self.appKey];
+    NSString *path = [directoryURL URLByAppendingPathComponent:fileName].path;
+
+    UASQLite *db = [[UASQLite alloc] init];
+    if (![db open:path]) {
+        UA_LERR(@"Failed to open analytics event store: %@", [db lastErrorMessage]);
+        return NO;
+    }
+
+    // Write-ahead logging avoids rewriting the database file on every commit, and with it
+    // normal syncing can only lose the latest commits on power loss, never corrupt the store
+    [db enableWriteAheadLogging];
+    [db setSynchronousMode:UASQLiteSynchronousModeNormal];
+
+    if (![db executeUpdate:@"CREATE TABLE IF NOT EXISTS events (id INTEGER PRIMARY KEY AUTOINCREMENT, event_id TEXT NOT NULL, session_id TEXT, payload BLOB NOT NULL, bytes INTEGER NOT NULL)"]) {
+        UA_LERR(@"Failed to create analytics event table: %@", [db lastErrorMessage]);
+        [db close];
+        return NO;
+    }
+
+    if (![self createStoreSizeTrackingInDatabase:db]) {
+        UA_LERR(@"Failed to create analytics event size tracking: %@", [db lastErrorMessage]);
+        [db close];
+        return NO;
+    }
+
+    if (![self createPriorityLanesInDatabase:db]) {
+        UA_LERR(@"Failed to create analytics event priority lanes: %@", [db lastErrorMessage]);
+        [db close];
+        return NO;
+    }
+
+    self.db = db;
+    [self refreshStoreSize];
+
+    [self migrateCoreDataStoreFromDirectory:directoryURL];
+    [self migrateOldDatabase];
+
+    return YES;
+}
+
+/**
+ * Keeps a persisted running total of the event sizes, maintained by triggers in the
+ * same transaction as every insert and delete, so the store size never needs an
+ * aggregate scan.
+ */
+- (BOOL)createStoreSizeTrackingInDatabase:(UASQLite *)db {
+    if ([db tableExists:@"event_store_size"]) {
+        return YES;
+    }
+
+    [db beginTransaction];
+
+    BOOL success = [db executeUpdate:@"CREATE TABLE event_store_size (bytes INTEGER NOT NULL)"] &&
+    [db executeUpdate:@"INSERT INTO event_store_size (bytes) SELECT IFNULL(SUM(bytes), 0) FROM events"] &&
+    [db executeUpdate:@"CREATE TRIGGER IF NOT EXISTS events_insert_size AFTER INSERT ON events BEGIN UPDATE event_store_size SET bytes = bytes + NEW.bytes; END"] &&
+    [db executeUpdate:@"CREATE TRIGGER IF NOT EXISTS events_delete_size AFTER DELETE ON events BEGIN UPDATE event_store_size SET bytes = bytes - OLD.bytes; END"];
+
+    if (success) {
+        [db commit];
+    } else {
+        [db rollback];
+    }
+
+    return success;
+}
+
+/**
+ * Adds the event priority to the events table, so trimming can remove the lower priority
+ * events first. Events stored before the column existed are treated as normal priority.
+ */
+- (BOOL)createPriorityLanesInDatabase:(UASQLite *)db {
+    if ([db indexExists:@"events_priority"]) {
+        return YES;
+    }
+
+    BOOL hasPriority = NO;
+    for (NSDictionary *column in [db executeQuery:@"PRAGMA table_info(events)"]) {
+        if ([column[@"name"] isEqual:@"priority"]) {
+            hasPriority = YES;
         }
+    }
 
-        [self migrateOldDatabase];
-    }];
+    if (!hasPriority) {
+        NSString *addColumn = [NSString stringWithFormat:@"ALTER TABLE events ADD COLUMN priority INTEGER NOT NULL DEFAULT %ld", (long)UAEventPriorityNormal];
+        if (![db executeUpdate:addColumn]) {
+            return NO;
+        }
+    }
+
+    return [db executeUpdate:@"CREATE INDEX IF NOT EXISTS events_priority ON events (priority, id)"];
+}
 
+/**
+ * Reads the persisted store size. Must be called on the store's dispatcher.
+ */
+- (void)refreshStoreSize {
+    NSArray *result = [self.db executeQuery:@"SELECT bytes FROM event_store_size"];
+    self.storeSize = [[result.firstObject objectForKey:@"bytes"] unsignedIntegerValue];
 }
+
 - (void)protectedDataAvailable {
-    if (!self.managedContext.persistentStoreCoordinator.persistentStores.count) {
-        [self addPersistentStore];
-    }
+    [self.dispatcher dispatchAsync:^{
+        if ([self openDatabaseIfNeeded] && self.spilledEvents.count) {
+            [self writeEvents:@[]];
+        }
+    }];
 }
 
+#pragma mark -
+#pragma mark Store
+
 - (void)saveEvent:(UAEvent *)event sessionID:(NSString *)sessionID {
-    [self.managedContext safePerformBlock:^(BOOL isSafe) {
-        if (!isSafe) {
-            UA_LERR(@"Unable to save event: %@. Persistent store unavailable", event);
+    NSMutableDictionary *pendingEvent = [NSMutableDictionary dictionary];
+    [pendingEvent setValue:event forKey:@"event"];
+    [pendingEvent setValue:sessionID forKey:@"sessionID"];
+
+    @synchronized (self) {
+        [self.pendingEvents addObject:pendingEvent];
+
+        if (!self.pendingEventsDisposable) {
+            UA_WEAKIFY(self)
+            self.pendingEventsDisposable = [self.pendingEventsDispatcher dispatchAfter:UAEventStoreWriteCoalescingWindow block:^{
+                UA_STRONGIFY(self)
+                [self savePendingEvents];
+            }];
+        }
+    }
+}
+
+- (void)savePendingEvents {
+    NSArray<NSDictionary *> *pendingEvents;
+    @synchronized (self) {
+        [self.pendingEventsDisposable dispose];
+        self.pendingEventsDisposable = nil;
+
+        if (!self.pendingEvents.count) {
             return;
         }
 
-        [self storeEventWithID:event.eventID
-                     eventType:event.eventType
-                     eventTime:event.time
-                     eventBody:event.data
-                     sessionID:sessionID];
+        pendingEvents = [self.pendingEvents copy];
+        [self.pendingEvents removeAllObjects];
+    }
 
-        [self.managedContext safeSave];
+    [self.dispatcher dispatchAsync:^{
+        if (![self openDatabaseIfNeeded]) {
+            [self spillEvents:pendingEvents];
+            return;
+        }
+
+        [self writeEvents:pendingEvents];
     }];
 }
 
+/**
+ * Holds events in memory until the store can be opened again, dropping the oldest events
+ * past the spill limit. Must be called on the store's dispatcher.
+ *
+ * @param events The pending events.
+ */
+- (void)spillEvents:(NSArray<NSDictionary *> *)events {
+    [self.spilledEvents addObjectsFromArray:events];
+
+    if (self.spilledEvents.count > UAEventStoreSpillLimit) {
+        NSUInteger dropped = self.spilledEvents.count - UAEventStoreSpillLimit;
+        [self.spilledEvents removeObjectsInRange:NSMakeRange(0, dropped)];
+        UA_LERR(@"Event store unavailable, dropped %lu events", (unsigned long)dropped);
+    }
+
+    UA_LDEBUG(@"Event store unavailable, holding %lu events until it can be opened", (unsigned long)self.spilledEvents.count);
+}
+
+/**
+ * Writes any spilled events followed by the pending events in a single transaction. Must be
+ * called on the store's dispatcher with the database open.
+ *
+ * @param pendingEvents The pending events.
+ */
+- (void)writeEvents:(NSArray<NSDictionary *> *)pendingEvents {
+    NSArray<NSDictionary *> *events = pendingEvents;
+    if (self.spilledEvents.count) {
+        events = [self.spilledEvents arrayByAddingObjectsFromArray:pendingEvents];
+        [self.spilledEvents removeAllObjects];
+    }
+
+    NSTimeInterval start = [NSProcessInfo processInfo].systemUptime;
+    [self.db beginTransaction];
+    for (NSDictionary *pendingEvent in events) {
+        UAEvent *event = pendingEvent[@"event"];
+        NSString *sessionID = pendingEvent[@"sessionID"];
+        [self storeEventWithID:event.eventID
+                     sessionID:sessionID
+                      priority:event.priority
+                       payload:[event JSONDataWithSessionID:sessionID]];
+    }
+    [self.db commit];
+
+    [self.flushDurationHistogram recordValue:[NSProcessInfo processInfo].systemUptime - start];
+    [self.writeCounter incrementBy:events.count];
+}
+
 - (void)fetchEventsWithMaxBatchSize:(NSUInteger)maxBatchSize
                   completionHandler:(void (^)(NSArray<UAEventData *> *))completionHandler {
+    [self fetchEventsWithMaxBatchSize:maxBatchSize afterStoreID:0 completionHandler:completionHandler];
+}
 
+- (void)fetchEventsWithMaxBatchSize:(NSUInteger)maxBatchSize
+                       afterStoreID:(NSUInteger)storeID
+                  completionHandler:(void (^)(NSArray<UAEventData *> *))completionHandler {
+    [self savePendingEvents];
 
-    [self.managedContext safePerformBlock:^(BOOL isSafe) {
-        if (!isSafe) {
+    [self.dispatcher dispatchAsync:^{
+        if (![self openDatabaseIfNeeded]) {
             completionHandler(@[]);
             return;
         }
 
-        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:UAEventDataEntityName];
-        request.sortDescriptors = @[ [NSSortDescriptor sortDescriptorWithKey:@"storeDate" ascending:NO] ];
+        NSMutableArray<UAEventData *> *events = [NSMutableArray array];
+        NSUInteger batchSize = 0;
+        NSUInteger lastStoreID = storeID;
+
+        while (YES) {
+            NSArray *rows = [self.db executeQuery:@"SELECT id, event_id, session_id, payload, bytes FROM events WHERE id > ? ORDER BY id LIMIT ?"
+                                        arguments:@[@(lastStoreID), @(UAEventStoreFetchPageSize)]];
+            if (!rows) {
+                UA_LERR(@"Error fetching events %@", [self.db lastErrorMessage]);
+                completionHandler(@[]);
+                return;
+            }
 
-        NSError *error;
-        NSArray *result = [self.managedContext executeFetchRequest:request error:&error];
+            for (NSDictionary *row in rows) {
+                NSUInteger bytes = [row[@"bytes"] unsignedIntegerValue];
+                if (batchSize + bytes > maxBatchSize && events.count) {
+                    completionHandler(events);
+                    return;
+                }
+
+                batchSize += bytes;
+                lastStoreID = [row[@"id"] unsignedIntegerValue];
+
+                id sessionID = row[@"session_id"];
+                [events addObject:[UAEventData eventDataWithStoreID:lastStoreID
+                                                         identifier:row[@"event_id"]
+                                                          sessionID:[sessionID isKindOfClass:[NSString class]] ? sessionID : nil
+                                                            payload:row[@"payload"]
+                                                              bytes:bytes]];
+            }
 
-        if (error) {
-            UA_LERR(@"Error fetching events %@", error);
-            completionHandler(@[]);
-        } else {
-            completionHandler(result);
-            [self.managedContext safeSave];
+            if (rows.count < UAEventStoreFetchPageSize) {
+                completionHandler(events);
+                return;
+            }
         }
     }];
 }
 
-- (void)deleteEventsWithIDs:(NSArray<NSString *> *)eventIDs {
-    [self.managedContext safePerformBlock:^(BOOL isSafe) {
-        if (!isSafe) {
+- (void)deleteEventsUpToStoreID:(NSUInteger)storeID {
+    [self.dispatcher dispatchAsync:^{
+        if (![self openDatabaseIfNeeded]) {
             return;
         }
 
-        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:UAEventDataEntityName];
-        request.predicate = [NSPredicate predicateWithFormat:@"identifier IN %@", eventIDs];
+        // Store IDs increase monotonically, so every event up to the last uploaded
+        // event was either uploaded or already removed.
+        if (![self.db executeUpdate:@"DELETE FROM events WHERE id <= ?" arguments:@[@(storeID)]]) {
+            UA_LERR(@"Error deleting analytics events %@", [self.db lastErrorMessage]);
+            return;
+        }
 
-        NSError *error;
-        NSBatchDeleteRequest *deleteRequest = [[NSBatchDeleteRequest alloc] initWithFetchRequest:request];
-        [self.managedContext executeRequest:deleteRequest error:&error];
+        [self refreshStoreSize];
+    }];
+}
 
-        if (error) {
-            UA_LERR(@"Error deleting analytics events %@", error);
+- (void)deleteEventsWithIDs:(NSArray<NSString *> *)eventIDs {
+    if (!eventIDs.count) {
+        return;
+    }
+
+    [self.dispatcher dispatchAsync:^{
+        if (![self openDatabaseIfNeeded]) {
+            return;
+        }
+
+        NSMutableArray *placeholders = [NSMutableArray arrayWithCapacity:eventIDs.count];
+        for (NSUInteger i = 0; i < eventIDs.count; i++) {
+            [placeholders addObject:@"?"];
+        }
+        NSString *inClause = [placeholders componentsJoinedByString:@", "];
+
+        NSString *deleteQuery = [NSString stringWithFormat:@"DELETE FROM events WHERE event_id IN (%@)", inClause];
+        if (![self.db executeUpdate:deleteQuery arguments:eventIDs]) {
+            UA_LERR(@"Error deleting analytics events %@", [self.db lastErrorMessage]);
             return;
         }
 
-        [self.managedContext safeSave];
+        [self refreshStoreSize];
     }];
 }
 
 - (void)deleteAllEvents {
-    [self.managedContext safePerformBlock:^(BOOL isSafe) {
-        if (!isSafe) {
-            return;
-        }
+    @synchronized (self) {
+        [self.pendingEventsDisposable dispose];
+        self.pendingEventsDisposable = nil;
+        [self.pendingEvents removeAllObjects];
+    }
 
-        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:UAEventDataEntityName];
+    [self.dispatcher dispatchAsync:^{
+        [self.spilledEvents removeAllObjects];
 
-        NSError *error;
-        NSBatchDeleteRequest *deleteRequest = [[NSBatchDeleteRequest alloc] initWithFetchRequest:request];
-        [self.managedContext executeRequest:deleteRequest error:&error];
+        if (![self openDatabaseIfNeeded]) {
+            return;
+        }
 
-        if (error) {
-            UA_LERR(@"Error deleting analytics events %@", error);
+        if (![self.db executeUpdate:@"DELETE FROM events"]) {
+            UA_LERR(@"Error deleting analytics events %@", [self.db lastErrorMessage]);
             return;
         }
 
-        [self.managedContext safeSave];
+        [self refreshStoreSize];
     }];
 }
 
 - (void)trimEventsToStoreSize:(NSUInteger)maxSize {
-    [self.managedContext safePerformBlock:^(BOOL isSafe) {
-        if (!isSafe) {
+    [self savePendingEvents];
+
+    [self.dispatcher dispatchAsync:^{
+        if (![self openDatabaseIfNeeded]) {
             return;
         }
 
-        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:UAEventDataEntityName];
-        request.sortDescriptors = @[ [NSSortDescriptor sortDescriptorWithKey:@"storeDate" ascending:NO] ];
-        request.predicate = [NSPredicate predicateWithFormat:@"@sum.bytes >= %ld", (unsigned long)maxSize];
+        // Common case, the store is under the limit
+        if (self.storeSize <= maxSize) {
+            return;
+        }
+
+        // Oldest events go first, one priority lane at a time, so a flood of low priority
+        // events never pushes out the higher priority ones
+        NSUInteger excess = self.storeSize - maxSize;
+        NSUInteger removed = 0;
+
+        for (NSNumber *priority in @[@(UAEventPriorityLow), @(UAEventPriorityNormal), @(UAEventPriorityHigh)]) {
+            removed += [self trimEventsWithPriority:priority bytes:excess - removed];
+            if (removed >= excess) {
+                break;
+            }
+        }
+
+        [self refreshStoreSize];
+    } workType:UADispatcherWorkTypeMaintenance];
+}
+
+/**
+ * Removes the oldest events of a priority until at least the given bytes are removed or the
+ * lane is empty. Must be called on the store's dispatcher.
+ *
+ * @return The bytes removed.
+ */
+- (NSUInteger)trimEventsWithPriority:(NSNumber *)priority bytes:(NSUInteger)bytes {
+    NSUInteger removed = 0;
+    NSUInteger cutoffStoreID = 0;
+
+    // Find the newest event in the lane that needs to be removed
+    while (removed < bytes) {
+        NSArray *rows = [self.db executeQuery:@"SELECT id, bytes FROM events WHERE priority = ? AND id > ? ORDER BY id LIMIT ?"
+                                    arguments:@[priority, @(cutoffStoreID), @(UAEventStoreFetchPageSize)]];
+
+        for (NSDictionary *row in rows) {
+            removed += [row[@"bytes"] unsignedIntegerValue];
+            cutoffStoreID = [row[@"id"] unsignedIntegerValue];
+            if (removed >= bytes) {
+                break;
+            }
+        }
+
+        if (rows.count < UAEventStoreFetchPageSize) {
+            break;
+        }
+    }
 
-        NSBatchDeleteRequest *deleteRequest = [[NSBatchDeleteRequest alloc] initWithFetchRequest:request];
+    if (!cutoffStoreID) {
+        return 0;
+    }
 
+    if (![self.db executeUpdate:@"DELETE FROM events WHERE priority = ? AND id <= ?" arguments:@[priority, @(cutoffStoreID)]]) {
+        UA_LERR(@"Error trimming analytic event store %@", [self.db lastErrorMessage]);
+        return 0;
+    }
+
+    return removed;
+}
+
+- (void)waitForIdle {
+    [self.dispatcher dispatchSync:^{}];
+}
+
+#pragma mark -
+#pragma mark Migration
+
+/**
+ * Moves any events from the Core Data event store into the event log. The Core Data store is
+ * only removed once its events are committed, otherwise it is kept for the next launch.
+ */
+- (void)migrateCoreDataStoreFromDirectory:(NSURL *)directoryURL {
+    NSString *storeName = [NSString stringWithFormat:UAEventStoreCoreDataFileFormat, self.appKey];
+    NSURL *storeURL = [directoryURL URLByAppendingPathComponent:storeName];
+
+    if (![[NSFileManager defaultManager] fileExistsAtPath:storeURL.path]) {
+        return;
+    }
+
+    UA_LTRACE(@"Migrating Core Data analytic store.");
+
+    NSURL *modelURL = [[UAirshipCoreResources bundle] URLForResource:@"UAEvents" withExtension:@"momd"];
+    NSManagedObjectContext *context = [NSManagedObjectContext managedObjectContextForModelURL:modelURL
+                                                                              concurrencyType:NSPrivateQueueConcurrencyType];
+
+    __block BOOL migrated = NO;
+    [context performBlockAndWait:^{
+        NSDictionary *options = @{ NSMigratePersistentStoresAutomaticallyOption : @YES,
+                                   NSInferMappingModelAutomaticallyOption : @YES };
         NSError *error;
-        [self.managedContext executeRequest:deleteRequest error:&error];
+
+        NSPersistentStore *store = [context.persistentStoreCoordinator addPersistentStoreWithType:NSSQLiteStoreType
+                                                                                    configuration:nil
+                                                                                              URL:storeURL
+                                                                                          options:options
+                                                                                            error:&error];
+        if (!store) {
+            UA_LERR(@"Unable to open Core Data analytic store: %@", error);
+            return;
+        }
+
+        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:UAEventDataEntityName];
+        request.sortDescriptors = @[ [NSSortDescriptor sortDescriptorWithKey:@"storeDate" ascending:YES] ];
+        request.resultType = NSDictionaryResultType;
+        request.fetchBatchSize = UAEventStoreFetchPageSize;
+
+        NSArray<NSDictionary *> *events = [context executeFetchRequest:request error:&error];
         if (error) {
-            UA_LERR(@"Error trimming analytic event store %@", error);
+            UA_LERR(@"Unable to migrate Core Data analytic store: %@", error);
+            [context.persistentStoreCoordinator removePersistentStore:store error:nil];
             return;
         }
 
-        [self.managedContext safeSave];
+        [self.db beginTransaction];
+        for (NSDictionary *event in events) {
+            NSData *payload = event[@"payload"];
+            if (payload) {
+                [self storeEventWithID:event[@"identifier"] sessionID:event[@"sessionID"] payload:payload];
+                continue;
+            }
+
+            NSData *data = event[@"data"];
+            id body = data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:nil] : nil;
+            if (![body isKindOfClass:[NSDictionary class]]) {
+                UA_LERR(@"Unable to migrate event %@", event[@"identifier"]);
+                continue;
+            }
+
+            [self storeEventWithID:event[@"identifier"]
+                         eventType:event[@"type"]
+                         eventTime:event[@"time"]
+                         eventBody:body
+                         sessionID:event[@"sessionID"]];
+        }
+        migrated = [self.db commit];
+        if (!migrated) {
+            UA_LERR(@"Unable to migrate Core Data analytic store: %@", [self.db lastErrorMessage]);
+            [self.db rollback];
+        }
+
+        [context.persistentStoreCoordinator removePersistentStore:store error:nil];
     }];
+
+    // Keep the store so the next launch retries, nothing was committed
+    if (!migrated) {
+        [self refreshStoreSize];
+        return;
+    }
+
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    for (NSString *suffix in @[@"", @"-wal", @"-shm"]) {
+        NSString *path = [storeURL.path stringByAppendingString:suffix];
+        [fileManager removeItemAtPath:path error:nil];
+    }
 }
 
 - (void)migrateOldDatabase {
@@ -198,7 +626,9 @@ NSString *const UAEventDataEntityName = @"UAEventData";
 
         // begin delete
         [db beginTransaction];
+        [self.db beginTransaction];
 
+        NSMutableArray *deleteArguments = [NSMutableArray arrayWithCapacity:events.count];
         for (id event in events) {
             NSError *error = nil;
             id data = [NSPropertyListSerialization
@@ -218,11 +648,14 @@ NSString *const UAEventDataEntityName = @"UAEventData";
                          eventBody:data
                          sessionID:event[@"session_id"]];
 
-            // delete
-            [db executeUpdate:@"DELETE FROM analytics WHERE event_id = ?", [event objectForKey:@"event_id"]];
+            [deleteArguments addObject:@[[event objectForKey:@"event_id"]]];
         }
 
+        // delete
+        [db executeUpdate:@"DELETE FROM analytics WHERE event_id = ?" argumentsBatch:deleteArguments];
+
         // commit delete
+        [self.db commit];
         [db commit];
 
 
@@ -230,31 +663,48 @@ NSString *const UAEventDataEntityName = @"UAEventData";
 
     [db close];
     [[NSFileManager defaultManager] removeItemAtPath:writableDBPath error:nil];
-
-    [self.managedContext safeSave];
 }
 
+#pragma mark -
+#pragma mark Helpers
+
 - (void)storeEventWithID:(NSString *)eventID eventType:(NSString *)eventType eventTime:(NSString *)eventTime eventBody:(id)eventBody sessionID:(NSString *)sessionID {
+    NSMutableDictionary *data = [NSMutableDictionary dictionaryWithDictionary:eventBody];
+    [data setValue:sessionID forKey:@"session_id"];
+
+    NSMutableDictionary *payload = [NSMutableDictionary dictionary];
+    [payload setValue:eventID forKey:@"event_id"];
+    [payload setValue:eventTime forKey:@"time"];
+    [payload setValue:eventType forKey:@"type"];
+    [payload setValue:data forKey:@"data"];
+
     NSError *error;
-    id json = [UAJSONSerialization dataWithJSONObject:eventBody options:0 error:&error];
+    NSData *json = [UAJSONSerialization dataWithJSONObject:payload options:0 error:&error];
     if (error) {
         UA_LERR(@"Unable to save event. %@", error);
         return;
     }
 
-    UAEventData *eventData = [NSEntityDescription insertNewObjectForEntityForName:UAEventDataEntityName
-                                                           inManagedObjectContext:self.managedContext];
+    [self storeEventWithID:eventID sessionID:sessionID payload:json];
+}
+
+- (void)storeEventWithID:(NSString *)eventID sessionID:(NSString *)sessionID payload:(NSData *)payload {
+    [self storeEventWithID:eventID sessionID:sessionID priority:UAEventPriorityNormal payload:payload];
+}
 
-    eventData.sessionID = sessionID;
-    eventData.type = eventType;
-    eventData.time = eventTime;
-    eventData.identifier = eventID;
-    eventData.data = json;
-    eventData.storeDate = [NSDate date];
+- (void)storeEventWithID:(NSString *)eventID sessionID:(NSString *)sessionID priority:(UAEventPriority)priority payload:(NSData *)payload {
+    if (!eventID || !payload) {
+        return;
+    }
 
-    // Approximate size
-    eventData.bytes = @(eventData.sessionID.length + eventData.type.length + eventData.time.length + eventData.identifier.length + eventData.data.length);
+    if (![self.db executeUpdate:@"INSERT INTO events (event_id, session_id, payload, bytes, priority) VALUES (?, ?, ?, ?, ?)"
+                      arguments:@[eventID, sessionID ?: [NSNull null], payload, @(payload.length), @(priority)]]) {
+        UA_LERR(@"Unable to save event %@: %@", eventID, [self.db lastErrorMessage]);
+        return;
+    }
 
+    // Mirrors the insert trigger so the cached size stays current without a read
+    self.storeSize += payload.length;
     UA_LTRACE(@"Event saved: %@", eventID);
 }
 
@@ -0,0 +1,35 @@
+/* Copyright Airship and Contributors */
+
+#import "UAExtensionEventJournal.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Max size of the journal file.
+ */
+extern NSUInteger const UAExtensionEventJournalMaxSize;
+
+@interface UAExtensionEventJournal ()
+
+///---------------------------------------------------------------------------------------
+/// @name Extension Event Journal Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param directoryURL The directory holding the journal.
+ * @return A journal.
+ */
++ (instancetype)journalWithDirectoryURL:(NSURL *)directoryURL;
+
+/**
+ * Reads the recorded events and clears the journal.
+ *
+ * @return The recorded events, in the order they were recorded.
+ */
+- (NSArray<UAEvent *> *)collectEvents;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,181 @@
+/* Copyright Airship and Contributors */
+
+#import "UAExtensionEventJournal+Internal.h"
+#import "UAExtensionStateSnapshot+Internal.h"
+#import "UAEvent+Internal.h"
+#import "UAJSONSerialization.h"
+#import "UAGlobal.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+NSUInteger const UAExtensionEventJournalMaxSize = 256 * 1024;
+
+static NSString * const UAExtensionEventJournalFile = @"events";
+
+static NSString * const UAExtensionEventJournalEventIDKey = @"event_id";
+static NSString * const UAExtensionEventJournalTypeKey = @"type";
+static NSString * const UAExtensionEventJournalTimeKey = @"time";
+static NSString * const UAExtensionEventJournalDataKey = @"data";
+
+/**
+ * An event read back from the journal.
+ */
+@interface UAExtensionJournalEvent : UAEvent
+@property (nonatomic, copy) NSString *journaledEventType;
+@end
+
+@implementation UAExtensionJournalEvent
+
+- (NSString *)eventType {
+    return self.journaledEventType;
+}
+
+@end
+
+@interface UAExtensionEventJournal ()
+@property (nonatomic, strong) NSURL *directoryURL;
+@property (nonatomic, strong) NSURL *journalURL;
+@end
+
+@implementation UAExtensionEventJournal
+
+- (instancetype)initWithDirectoryURL:(NSURL *)directoryURL {
+    self = [super init];
+    if (self) {
+        self.directoryURL = directoryURL;
+        self.journalURL = [directoryURL URLByAppendingPathComponent:UAExtensionEventJournalFile];
+    }
+    return self;
+}
+
++ (nullable instancetype)journal {
+    NSURL *directoryURL = [UAExtensionStateSnapshot sharedDirectoryURL];
+    if (!directoryURL) {
+        return nil;
+    }
+
+    return [[self alloc] initWithDirectoryURL:directoryURL];
+}
+
++ (instancetype)journalWithDirectoryURL:(NSURL *)directoryURL {
+    return [[self alloc] initWithDirectoryURL:directoryURL];
+}
+
+- (BOOL)recordEvent:(UAEvent *)event {
+    if (!event.isValid) {
+        UA_LERR(@"Dropping invalid event %@", event);
+        return NO;
+    }
+
+    NSMutableDictionary *entry = [NSMutableDictionary dictionary];
+    [entry setValue:event.eventID forKey:UAExtensionEventJournalEventIDKey];
+    [entry setValue:event.eventType forKey:UAExtensionEventJournalTypeKey];
+    [entry setValue:event.time forKey:UAExtensionEventJournalTimeKey];
+    [entry setValue:event.data forKey:UAExtensionEventJournalDataKey];
+
+    NSError *error;
+    NSData *json = [UAJSONSerialization dataWithJSONObject:entry options:0 error:&error];
+    if (!json) {
+        UA_LERR(@"Unable to serialize event %@: %@", event.eventID, error);
+        return NO;
+    }
+
+    NSMutableData *line = [json mutableCopy];
+    [line appendBytes:"\n" length:1];
+
+    @synchronized (self) {
+        if (![[NSFileManager defaultManager] createDirectoryAtURL:self.directoryURL withIntermediateDirectories:YES attributes:nil error:&error]) {
+            UA_LERR(@"Unable to create event journal directory: %@", error);
+            return NO;
+        }
+
+        // O_APPEND keeps each line whole when the app and several extensions write at once
+        int fd = open(self.journalURL.fileSystemRepresentation, O_WRONLY | O_APPEND | O_CREAT, 0644);
+        if (fd < 0) {
+            UA_LERR(@"Unable to open event journal: %s", strerror(errno));
+            return NO;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) == 0 && (NSUInteger)info.st_size + line.length > UAExtensionEventJournalMaxSize) {
+            UA_LDEBUG(@"Event journal is full, dropping event %@", event.eventID);
+            close(fd);
+            return NO;
+        }
+
+        ssize_t written = write(fd, line.bytes, line.length);
+        close(fd);
+
+        if (written != (ssize_t)line.length) {
+            UA_LERR(@"Unable to write to event journal: %s", strerror(errno));
+            return NO;
+        }
+    }
+
+    UA_LTRACE(@"Recorded event %@ in the extension event journal", event.eventID);
+    return YES;
+}
+
+- (NSArray<UAEvent *> *)collectEvents {
+    NSData *data;
+
+    @synchronized (self) {
+        if (![[NSFileManager defaultManager] fileExistsAtPath:self.journalURL.path]) {
+            return @[];
+        }
+
+        // Move the journal aside first so events recorded while reading go to a new journal
+        NSURL *collectingURL = [self.directoryURL URLByAppendingPathComponent:[NSString stringWithFormat:@".%@", [NSUUID UUID].UUIDString]];
+        if (rename(self.journalURL.fileSystemRepresentation, collectingURL.fileSystemRepresentation) != 0) {
+            UA_LERR(@"Unable to collect extension events: %s", strerror(errno));
+            return @[];
+        }
+
+        data = [NSData dataWithContentsOfURL:collectingURL options:NSDataReadingMappedIfSafe error:nil];
+        [[NSFileManager defaultManager] removeItemAtURL:collectingURL error:nil];
+    }
+
+    NSMutableArray<UAEvent *> *events = [NSMutableArray array];
+    const char *bytes = data.bytes;
+    NSUInteger start = 0;
+
+    // One JSON object per line
+    for (NSUInteger i = 0; i < data.length; i++) {
+        if (bytes[i] != '\n') {
+            continue;
+        }
+
+        NSData *line = [data subdataWithRange:NSMakeRange(start, i - start)];
+        start = i + 1;
+
+        id entry = line.length ? [NSJSONSerialization JSONObjectWithData:line options:0 error:nil] : nil;
+        UAEvent *event = [entry isKindOfClass:[NSDictionary class]] ? [self eventFromEntry:entry] : nil;
+        if (event) {
+            [events addObject:event];
+        }
+    }
+
+    return events;
+}
+
+- (nullable UAEvent *)eventFromEntry:(NSDictionary *)entry {
+    id eventID = entry[UAExtensionEventJournalEventIDKey];
+    id type = entry[UAExtensionEventJournalTypeKey];
+    id time = entry[UAExtensionEventJournalTimeKey];
+    id data = entry[UAExtensionEventJournalDataKey];
+
+    if (![eventID isKindOfClass:[NSString class]] || ![type isKindOfClass:[NSString class]] || ![time isKindOfClass:[NSString class]]) {
+        return nil;
+    }
+
+    // Keep the extension's ID and time so the event matches when it was recorded
+    UAExtensionJournalEvent *event = [[UAExtensionJournalEvent alloc] init];
+    event.journaledEventType = type;
+    event.eventID = eventID;
+    event.time = time;
+    event.eventData = [data isKindOfClass:[NSDictionary class]] ? data : @{};
+    return event;
+}
+
+@end
@@ -0,0 +1,93 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+@class UARuntimeConfig;
+@class UAChannel;
+@class UAAnalytics;
+@class UAMetricsRegistry;
+@class UADispatcher;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Info.plist key for the app group shared with the notification extensions. When not set, the
+ * media cache app group `UAMediaCacheAppGroup` is used.
+ */
+extern NSString * const UAExtensionStateAppGroupKey;
+
+/**
+ * App side of the state shared with the notification extensions through an app group container,
+ * so extensions can read the channel ID and config without taking off.
+ *
+ * The state is written as a small binary property list next to a delivery receipt log. The layout
+ * must match `UAExtensionState` in the service extension. The snapshot is replaced atomically
+ * whenever the channel is created or updated and when the app comes to the foreground.
+ *
+ * The receipts the extension appended are collected on launch and on foreground, and added to
+ * analytics as push received events in a single batch. Receipts the extension already uploaded
+ * are only counted.
+ */
+@interface UAExtensionStateSnapshot : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Extension State Snapshot Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * The directory in the app group container that holds the state shared with the extensions.
+ *
+ * @return The directory URL, or `nil` if no app group is set in the main bundle's Info.plist or
+ * its container is not available.
+ */
++ (nullable NSURL *)sharedDirectoryURL;
+
+/**
+ * Factory method.
+ *
+ * @param config The runtime config.
+ * @param channel The channel.
+ * @param analytics The analytics instance.
+ * @return A snapshot writer for the app group set in the main bundle's Info.plist, or `nil` if
+ * no app group is set or its container is not available.
+ */
++ (nullable instancetype)snapshotWithConfig:(UARuntimeConfig *)config
+                                    channel:(UAChannel *)channel
+                                  analytics:(UAAnalytics *)analytics;
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param config The runtime config.
+ * @param channel The channel.
+ * @param analytics The analytics instance.
+ * @param directoryURL The directory holding the shared state.
+ * @param notificationCenter The notification center.
+ * @param metrics The metrics registry.
+ * @param dispatcher The serial dispatcher the files are accessed on.
+ * @return A snapshot writer.
+ */
++ (instancetype)snapshotWithConfig:(UARuntimeConfig *)config
+                           channel:(UAChannel *)channel
+                         analytics:(UAAnalytics *)analytics
+                      directoryURL:(NSURL *)directoryURL
+                notificationCenter:(NSNotificationCenter *)notificationCenter
+                           metrics:(UAMetricsRegistry *)metrics
+                        dispatcher:(UADispatcher *)dispatcher;
+
+/**
+ * Writes the current state for the extensions. Must be called on the dispatcher.
+ */
+- (void)writeSnapshot;
+
+/**
+ * Collects the delivery receipts recorded by the extensions and clears the receipt log. Must be
+ * called on the dispatcher.
+ *
+ * @return The number of deliveries collected, including the ones already uploaded.
+ */
+- (NSUInteger)collectDeliveries;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,304 @@
+/* Copyright Airship and Contributors */
+
+#import "UAExtensionStateSnapshot+Internal.h"
+#import "UARuntimeConfig.h"
+#import "UAChannel.h"
+#import "UAAnalytics+Internal.h"
+#import "UAEventManager+Internal.h"
+#import "UAEvent+Internal.h"
+#import "UAPushReceivedEvent+Internal.h"
+#import "UAChannelNotificationCenterEvents.h"
+#import "UAAppStateTracker.h"
+#import "UAMetricsRegistry.h"
+#import "UADispatcher.h"
+#import "UAGlobal.h"
+
+NSString * const UAExtensionStateAppGroupKey = @"UAAppGroup";
+
+// Must match the extension side of the state
+static NSString * const UAExtensionStateMediaCacheAppGroupKey = @"UAMediaCacheAppGroup";
+static NSString * const UAExtensionStateDirectory = @"Library/Application Support/com.urbanairship.extension_state";
+static NSString * const UAExtensionStateSnapshotFile = @"state.plist";
+static NSString * const UAExtensionStateDeliveriesFile = @"deliveries";
+static NSInteger const UAExtensionStateVersion = 1;
+
+static NSString * const UAExtensionStateVersionKey = @"version";
+static NSString * const UAExtensionStateDateKey = @"date";
+static NSString * const UAExtensionStateChannelIDKey = @"channel_id";
+static NSString * const UAExtensionStateAppKeyKey = @"app_key";
+static NSString * const UAExtensionStateDeviceAPIURLKey = @"device_api_url";
+static NSString * const UAExtensionStateAnalyticsURLKey = @"analytics_url";
+static NSString * const UAExtensionStateAnalyticsEnabledKey = @"analytics_enabled";
+static NSString * const UAExtensionStateAnalyticsHeadersKey = @"analytics_headers";
+
+static NSString * const UAExtensionStateReceiptEventIDKey = @"event_id";
+static NSString * const UAExtensionStateReceiptTimeKey = @"time";
+static NSString * const UAExtensionStateReceiptPushIDKey = @"push_id";
+static NSString * const UAExtensionStateReceiptMetadataKey = @"metadata";
+static NSString * const UAExtensionStateReceiptUploadedKey = @"uploaded";
+
+@interface UAExtensionStateSnapshot ()
+@property (nonatomic, strong) UARuntimeConfig *config;
+@property (nonatomic, strong) UAChannel *channel;
+@property (nonatomic, strong) UAAnalytics *analytics;
+@property (nonatomic, strong) NSURL *directoryURL;
+@property (nonatomic, strong) NSNotificationCenter *notificationCenter;
+@property (nonatomic, strong) UAMetricsRegistry *metrics;
+@property (nonatomic, strong) UADispatcher *dispatcher;
+@end
+
+@implementation UAExtensionStateSnapshot
+
+- (instancetype)initWithConfig:(UARuntimeConfig *)config
+                       channel:(UAChannel *)channel
+                     analytics:(UAAnalytics *)analytics
+                  directoryURL:(NSURL *)directoryURL
+            notificationCenter:(NSNotificationCenter *)notificationCenter
+                       metrics:(UAMetricsRegistry *)metrics
+                    dispatcher:(UADispatcher *)dispatcher {
+    self = [super init];
+
+    if (self) {
+        self.config = config;
+        self.channel = channel;
+        self.analytics = analytics;
+        self.directoryURL = directoryURL;
+        self.notificationCenter = notificationCenter;
+        self.metrics = metrics;
+        self.dispatcher = dispatcher;
+
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(channelChanged)
+                                        name:UAChannelCreatedEvent
+                                      object:nil];
+
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(channelChanged)
+                                        name:UAChannelUpdatedEvent
+                                      object:nil];
+
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(applicationDidTransitionToForeground)
+                                        name:UAApplicationDidTransitionToForeground
+                                      object:nil];
+
+        // The config may have changed since the last launch, and receipts may have been
+        // recorded while the app was not running
+        [self applicationDidTransitionToForeground];
+    }
+
+    return self;
+}
+
++ (nullable NSURL *)sharedDirectoryURL {
+    NSBundle *bundle = [NSBundle mainBundle];
+    id appGroup = [bundle objectForInfoDictionaryKey:UAExtensionStateAppGroupKey] ?: [bundle objectForInfoDictionaryKey:UAExtensionStateMediaCacheAppGroupKey];
+    if (![appGroup isKindOfClass:[NSString class]] || ![appGroup length]) {
+        return nil;
+    }
+
+    NSURL *containerURL = [[NSFileManager defaultManager] containerURLForSecurityApplicationGroupIdentifier:appGroup];
+    if (!containerURL) {
+        UA_LERR(@"Unable to access app group container: %@", appGroup);
+        return nil;
+    }
+
+    return [containerURL URLByAppendingPathComponent:UAExtensionStateDirectory isDirectory:YES];
+}
+
++ (nullable instancetype)snapshotWithConfig:(UARuntimeConfig *)config
+                                    channel:(UAChannel *)channel
+                                  analytics:(UAAnalytics *)analytics {
+    NSURL *directoryURL = [self sharedDirectoryURL];
+    if (!directoryURL) {
+        return nil;
+    }
+
+    return [[self alloc] initWithConfig:config
+                                channel:channel
+                              analytics:analytics
+                           directoryURL:directoryURL
+                     notificationCenter:[NSNotificationCenter defaultCenter]
+                                metrics:[UAMetricsRegistry shared]
+                             dispatcher:[UADispatcher serialDispatcher:QOS_CLASS_UTILITY]];
+}
+
++ (instancetype)snapshotWithConfig:(UARuntimeConfig *)config
+                           channel:(UAChannel *)channel
+                         analytics:(UAAnalytics *)analytics
+                      directoryURL:(NSURL *)directoryURL
+                notificationCenter:(NSNotificationCenter *)notificationCenter
+                           metrics:(UAMetricsRegistry *)metrics
+                        dispatcher:(UADispatcher *)dispatcher {
+    return [[self alloc] initWithConfig:config
+                                channel:channel
+                              analytics:analytics
+                           directoryURL:directoryURL
+                     notificationCenter:notificationCenter
+                                metrics:metrics
+                             dispatcher:dispatcher];
+}
+
+- (void)dealloc {
+    [self.notificationCenter removeObserver:self];
+}
+
+- (void)channelChanged {
+    UA_WEAKIFY(self)
+    [self.dispatcher dispatchAsync:^{
+        UA_STRONGIFY(self)
+        [self writeSnapshot];
+    }];
+}
+
+- (void)applicationDidTransitionToForeground {
+    UA_WEAKIFY(self)
+    [self.dispatcher dispatchAsync:^{
+        UA_STRONGIFY(self)
+        // Analytics settings may have changed while in the background
+        [self writeSnapshot];
+        [self collectDeliveries];
+    }];
+}
+
+- (void)writeSnapshot {
+    NSMutableDictionary *state = [NSMutableDictionary dictionary];
+    state[UAExtensionStateVersionKey] = @(UAExtensionStateVersion);
+    state[UAExtensionStateDateKey] = [NSDate date];
+    state[UAExtensionStateChannelIDKey] = self.channel.identifier;
+    state[UAExtensionStateAppKeyKey] = self.config.appKey;
+    state[UAExtensionStateDeviceAPIURLKey] = self.config.deviceAPIURL;
+    state[UAExtensionStateAnalyticsURLKey] = self.config.analyticsURL;
+    state[UAExtensionStateAnalyticsEnabledKey] = @(self.analytics.isEnabled);
+
+    // Lets the extension upload receipts with the same headers as the app
+    if (self.analytics.isEnabled) {
+        state[UAExtensionStateAnalyticsHeadersKey] = [self.analytics analyticsHeaders];
+    }
+
+    NSError *error;
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:state
+                                                              format:NSPropertyListBinaryFormat_v1_0
+                                                             options:0
+                                                               error:&error];
+    if (!data) {
+        UA_LERR(@"Unable to serialize extension state: %@", error);
+        return;
+    }
+
+    if (![[NSFileManager defaultManager] createDirectoryAtURL:self.directoryURL withIntermediateDirectories:YES attributes:nil error:&error]) {
+        UA_LERR(@"Unable to create extension state directory: %@", error);
+        return;
+    }
+
+    // Written atomically so the extensions never map a partial snapshot
+    NSURL *snapshotURL = [self.directoryURL URLByAppendingPathComponent:UAExtensionStateSnapshotFile];
+    if (![data writeToURL:snapshotURL options:NSDataWritingAtomic error:&error]) {
+        UA_LERR(@"Unable to write extension state: %@", error);
+        return;
+    }
+
+    UA_LTRACE(@"Wrote extension state for channel %@", self.channel.identifier);
+}
+
+- (NSUInteger)collectDeliveries {
+    NSFileManager *fm = [NSFileManager defaultManager];
+    NSURL *deliveriesURL = [self.directoryURL URLByAppendingPathComponent:UAExtensionStateDeliveriesFile];
+    if (![fm fileExistsAtPath:deliveriesURL.path]) {
+        return 0;
+    }
+
+    // Move the log aside first so deliveries recorded while reading go to a new log
+    NSURL *collectingURL = [self.directoryURL URLByAppendingPathComponent:[NSString stringWithFormat:@".%@", [NSUUID UUID].UUIDString]];
+    if (rename(deliveriesURL.fileSystemRepresentation, collectingURL.fileSystemRepresentation) != 0) {
+        UA_LERR(@"Unable to collect extension deliveries: %s", strerror(errno));
+        return 0;
+    }
+
+    NSData *data = [NSData dataWithContentsOfURL:collectingURL options:NSDataReadingMappedIfSafe error:nil];
+    [fm removeItemAtURL:collectingURL error:nil];
+
+    NSArray<NSDictionary *> *receipts = [self receiptsFromData:data];
+    if (!receipts.count) {
+        return 0;
+    }
+
+    // Receipts are followed by an upload marker once the extension uploaded them itself
+    NSMutableSet<NSString *> *uploadedIDs = [NSMutableSet set];
+    for (NSDictionary *receipt in receipts) {
+        if ([receipt[UAExtensionStateReceiptUploadedKey] isKindOfClass:[NSString class]]) {
+            [uploadedIDs addObject:receipt[UAExtensionStateReceiptUploadedKey]];
+        }
+    }
+
+    NSMutableArray<UAEvent *> *events = [NSMutableArray array];
+    NSUInteger count = 0;
+    for (NSDictionary *receipt in receipts) {
+        NSString *eventID = receipt[UAExtensionStateReceiptEventIDKey];
+        if (![eventID isKindOfClass:[NSString class]]) {
+            continue;
+        }
+
+        count++;
+        if ([uploadedIDs containsObject:eventID]) {
+            continue;
+        }
+
+        UAEvent *event = [self pushReceivedEventFromReceipt:receipt];
+        if (event) {
+            [events addObject:event];
+        }
+    }
+
+    UA_LDEBUG(@"Collected %lu deliveries recorded by the notification extensions, %lu already uploaded",
+              (unsigned long)count, (unsigned long)(count - events.count));
+
+    [self.metrics incrementCounter:UAMetricPushExtensionDeliveries by:count];
+    if (events.count) {
+        [self.analytics addEvents:events];
+    }
+
+    return count;
+}
+
+- (NSArray<NSDictionary *> *)receiptsFromData:(NSData *)data {
+    NSMutableArray<NSDictionary *> *receipts = [NSMutableArray array];
+    const char *bytes = data.bytes;
+    NSUInteger start = 0;
+
+    // One JSON object per line
+    for (NSUInteger i = 0; i < data.length; i++) {
+        if (bytes[i] != '\n') {
+            continue;
+        }
+
+        NSData *line = [data subdataWithRange:NSMakeRange(start, i - start)];
+        start = i + 1;
+
+        id receipt = line.length ? [NSJSONSerialization JSONObjectWithData:line options:0 error:nil] : nil;
+        if ([receipt isKindOfClass:[NSDictionary class]]) {
+            [receipts addObject:receipt];
+        }
+    }
+
+    return receipts;
+}
+
+- (nullable UAEvent *)pushReceivedEventFromReceipt:(NSDictionary *)receipt {
+    NSMutableDictionary *notification = [NSMutableDictionary dictionary];
+    [notification setValue:receipt[UAExtensionStateReceiptPushIDKey] forKey:@"_"];
+    [notification setValue:receipt[UAExtensionStateReceiptMetadataKey] forKey:kUAPushMetadata];
+
+    id time = receipt[UAExtensionStateReceiptTimeKey];
+    if (![time isKindOfClass:[NSString class]]) {
+        return nil;
+    }
+
+    // Keep the extension's ID and time so the event matches the receipt
+    UAPushReceivedEvent *event = [UAPushReceivedEvent eventWithNotification:notification];
+    event.eventID = receipt[UAExtensionStateReceiptEventIDKey];
+    event.time = time;
+    return event;
+}
+
+@end
@@ -0,0 +1,32 @@
+/* Copyright Airship and Contributors */
+
+#import "UAForegroundWorkScheduler.h"
+
+@class UAWorkScheduler;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Delay before the first work item runs, leaving the app time to draw its first frame.
+ */
+extern NSTimeInterval const UAForegroundWorkInitialDelay;
+
+/**
+ * Gap between work items.
+ */
+extern NSTimeInterval const UAForegroundWorkStaggerInterval;
+
+@interface UAForegroundWorkScheduler ()
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param dispatcher The dispatcher that paces the work.
+ * @param workScheduler The work scheduler the work is submitted to.
+ * @return A scheduler instance.
+ */
++ (instancetype)schedulerWithDispatcher:(UADispatcher *)dispatcher workScheduler:(UAWorkScheduler *)workScheduler;
+
+@end
+
+NS_ASSUME_NONNULL_END
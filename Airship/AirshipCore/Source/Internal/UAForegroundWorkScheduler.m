@@ -0,0 +1,146 @@
+/* Copyright Airship and Contributors */
+
+#import "UAForegroundWorkScheduler+Internal.h"
+#import "UAGlobal.h"
+#import "UAWorkScheduler+Internal.h"
+
+NSTimeInterval const UAForegroundWorkInitialDelay = 0.5;
+NSTimeInterval const UAForegroundWorkStaggerInterval = 0.1;
+
+@interface UAForegroundWork : NSObject
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, assign) UAForegroundWorkPriority priority;
+@property (nonatomic, strong) UADispatcher *dispatcher;
+@property (nonatomic, copy) void (^block)(void);
+@end
+
+@implementation UAForegroundWork
+@end
+
+@interface UAForegroundWorkScheduler ()
+@property (nonatomic, strong) UADispatcher *dispatcher;
+@property (nonatomic, strong) UAWorkScheduler *workScheduler;
+@property (nonatomic, strong) NSMutableArray<UAForegroundWork *> *pendingWork;
+@property (nonatomic, assign) BOOL isRunScheduled;
+@end
+
+@implementation UAForegroundWorkScheduler
+
+- (instancetype)initWithDispatcher:(UADispatcher *)dispatcher workScheduler:(UAWorkScheduler *)workScheduler {
+    self = [super init];
+
+    if (self) {
+        self.dispatcher = dispatcher;
+        self.workScheduler = workScheduler;
+        self.pendingWork = [NSMutableArray array];
+    }
+
+    return self;
+}
+
++ (instancetype)shared {
+    static dispatch_once_t onceToken;
+    static UAForegroundWorkScheduler *_shared;
+    dispatch_once(&onceToken, ^{
+        _shared = [self schedulerWithDispatcher:[UADispatcher mainDispatcher] workScheduler:[UAWorkScheduler shared]];
+    });
+
+    return _shared;
+}
+
++ (instancetype)schedulerWithDispatcher:(UADispatcher *)dispatcher workScheduler:(UAWorkScheduler *)workScheduler {
+    return [[self alloc] initWithDispatcher:dispatcher workScheduler:workScheduler];
+}
+
+- (void)scheduleWorkWithName:(NSString *)name
+                    priority:(UAForegroundWorkPriority)priority
+                  dispatcher:(UADispatcher *)dispatcher
+                       block:(void (^)(void))block {
+    @synchronized (self) {
+        UAForegroundWork *work;
+        for (UAForegroundWork *pending in self.pendingWork) {
+            if ([pending.name isEqualToString:name]) {
+                work = pending;
+                break;
+            }
+        }
+
+        if (!work) {
+            work = [[UAForegroundWork alloc] init];
+            work.name = name;
+            [self.pendingWork addObject:work];
+        }
+
+        work.priority = priority;
+        work.dispatcher = dispatcher;
+        work.block = block;
+
+        if (self.isRunScheduled) {
+            return;
+        }
+        self.isRunScheduled = YES;
+    }
+
+    UA_WEAKIFY(self)
+    [self.dispatcher dispatchAfter:UAForegroundWorkInitialDelay block:^{
+        UA_STRONGIFY(self)
+        [self runNextWork];
+    }];
+}
+
++ (UAWorkPriority)workPriorityForPriority:(UAForegroundWorkPriority)priority {
+    switch (priority) {
+        case UAForegroundWorkPriorityHigh:
+            return UAWorkPriorityHigh;
+        case UAForegroundWorkPriorityDefault:
+            return UAWorkPriorityDefault;
+        case UAForegroundWorkPriorityLow:
+            return UAWorkPriorityLow;
+    }
+}
+
+- (void)runNextWork {
+    UAForegroundWork *next;
+    BOOL hasMore;
+    @synchronized (self) {
+        // First scheduled wins among equal priorities
+        for (UAForegroundWork *work in self.pendingWork) {
+            if (!next || work.priority < next.priority) {
+                next = work;
+            }
+        }
+
+        if (next) {
+            [self.pendingWork removeObject:next];
+        }
+
+        hasMore = self.pendingWork.count > 0;
+        self.isRunScheduled = hasMore;
+    }
+
+    if (next) {
+        UA_LTRACE(@"Running foreground work %@", next.name);
+
+        // The work counts against the launch's work budget
+        void (^block)(void) = next.block;
+        [self.workScheduler submitWorkWithName:next.name
+                                      priority:[UAForegroundWorkScheduler workPriorityForPriority:next.priority]
+                                      deadline:0
+                                    dispatcher:next.dispatcher
+                                         block:^UADisposable *(void (^completionHandler)(void)) {
+            block();
+            completionHandler();
+            return nil;
+        } dropHandler:nil];
+    }
+
+    if (hasMore) {
+        UA_WEAKIFY(self)
+        [self.dispatcher dispatchAfter:UAForegroundWorkStaggerInterval block:^{
+            UA_STRONGIFY(self)
+            [self runNextWork];
+        }];
+    }
+}
+
+@end
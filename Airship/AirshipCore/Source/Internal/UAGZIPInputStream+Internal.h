@@ -0,0 +1,31 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * An input stream that GZIP compresses data incrementally as the stream is read.
+ *
+ * Each read deflates directly into the reader's buffer, so no compressed data is held in
+ * memory and no thread is needed to feed the stream. Reads never block, and nothing is
+ * compressed past what the reader asked for if the stream is closed before it is fully read.
+ */
+@interface UAGZIPInputStream : NSInputStream
+
+///---------------------------------------------------------------------------------------
+/// @name GZIP Input Stream Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Creates an input stream that produces the GZIP compressed data.
+ *
+ * @param data The uncompressed data.
+ * @param compressionLevel The zlib compression level, 0-9 or -1 for the default level.
+ * @return An unopened input stream.
+ */
++ (instancetype)inputStreamWithData:(NSData *)data compressionLevel:(NSInteger)compressionLevel;
+
+@end
+
+NS_ASSUME_NONNULL_END
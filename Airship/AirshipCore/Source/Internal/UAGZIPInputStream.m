@@ -0,0 +1,193 @@
+/* Copyright Airship and Contributors */
+
+#import <zlib.h>
+
+#import "UAGZIPInputStream+Internal.h"
+#import "UAGlobal.h"
+
+@interface UAGZIPInputStream () {
+    z_stream _strm;
+    BOOL _deflateInitialized;
+    NSStreamStatus _status;
+}
+
+@property (nonatomic, copy) NSData *data;
+@property (nonatomic, assign) int compressionLevel;
+@property (nonatomic, strong, nullable) NSError *error;
+@property (nonatomic, weak, nullable) id<NSStreamDelegate> streamDelegate;
+@end
+
+@implementation UAGZIPInputStream
+
+- (instancetype)initWithData:(NSData *)data compressionLevel:(NSInteger)compressionLevel {
+    self = [super init];
+
+    if (self) {
+        self.data = data;
+        self.compressionLevel = (int)compressionLevel;
+        _status = NSStreamStatusNotOpen;
+    }
+
+    return self;
+}
+
++ (instancetype)inputStreamWithData:(NSData *)data compressionLevel:(NSInteger)compressionLevel {
+    return [[self alloc] initWithData:data compressionLevel:compressionLevel];
+}
+
+- (void)dealloc {
+    [self endDeflate];
+}
+
+#pragma mark -
+#pragma mark NSStream
+
+- (void)open {
+    if (_status != NSStreamStatusNotOpen) {
+        return;
+    }
+
+    if (!self.data.length) {
+        _status = NSStreamStatusAtEnd;
+        return;
+    }
+
+    _strm.zalloc = Z_NULL;
+    _strm.zfree = Z_NULL;
+    _strm.opaque = Z_NULL;
+    _strm.total_out = 0;
+    _strm.next_in = (Bytef *)self.data.bytes;
+    _strm.avail_in = (uInt)self.data.length;
+
+    int status = deflateInit2(&_strm, self.compressionLevel, Z_DEFLATED, (15+16), 8, Z_DEFAULT_STRATEGY);
+    if (status != Z_OK) {
+        [self failWithStatus:status];
+        return;
+    }
+
+    _deflateInitialized = YES;
+    _status = NSStreamStatusOpen;
+}
+
+- (void)close {
+    if (_status == NSStreamStatusOpen || _status == NSStreamStatusReading) {
+        UA_LDEBUG(@"GZIP input stream closed before all data was read");
+    }
+
+    [self endDeflate];
+    _status = NSStreamStatusClosed;
+}
+
+- (NSStreamStatus)streamStatus {
+    return _status;
+}
+
+- (nullable NSError *)streamError {
+    return self.error;
+}
+
+- (nullable id<NSStreamDelegate>)delegate {
+    return self.streamDelegate ?: self;
+}
+
+- (void)setDelegate:(nullable id<NSStreamDelegate>)delegate {
+    self.streamDelegate = delegate;
+}
+
+- (nullable id)propertyForKey:(NSStreamPropertyKey)key {
+    return nil;
+}
+
+- (BOOL)setProperty:(nullable id)property forKey:(NSStreamPropertyKey)key {
+    return NO;
+}
+
+// Reads never block, so there are no stream events to schedule
+- (void)scheduleInRunLoop:(NSRunLoop *)runLoop forMode:(NSRunLoopMode)mode {
+}
+
+- (void)removeFromRunLoop:(NSRunLoop *)runLoop forMode:(NSRunLoopMode)mode {
+}
+
+#pragma mark -
+#pragma mark NSInputStream
+
+- (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)length {
+    if (_status == NSStreamStatusAtEnd) {
+        return 0;
+    }
+
+    if ((_status != NSStreamStatusOpen && _status != NSStreamStatusReading) || !length) {
+        return _status == NSStreamStatusError || _status == NSStreamStatusClosed ? -1 : 0;
+    }
+
+    _status = NSStreamStatusReading;
+
+    // Deflates straight into the caller's buffer, only as much as was asked for
+    _strm.next_out = buffer;
+    _strm.avail_out = (uInt)MIN(length, (NSUInteger)UINT_MAX);
+    uInt available = _strm.avail_out;
+
+    // Returning 0 would end the stream, keep going until there is output
+    int status;
+    do {
+        status = deflate(&_strm, Z_FINISH);
+    } while (status == Z_OK && _strm.avail_out == available);
+
+    if (status != Z_OK && status != Z_STREAM_END) {
+        [self failWithStatus:status];
+        return -1;
+    }
+
+    NSInteger read = (NSInteger)(available - _strm.avail_out);
+
+    if (status == Z_STREAM_END) {
+        [self endDeflate];
+        _status = NSStreamStatusAtEnd;
+    } else {
+        _status = NSStreamStatusOpen;
+    }
+
+    return read;
+}
+
+- (BOOL)getBuffer:(uint8_t **)buffer length:(NSUInteger *)length {
+    return NO;
+}
+
+- (BOOL)hasBytesAvailable {
+    return _status == NSStreamStatusOpen || _status == NSStreamStatusReading;
+}
+
+#pragma mark -
+#pragma mark CFReadStream
+
+// NSURLSession reads the body through CFReadStream, which calls these on NSInputStream subclasses
+- (void)_scheduleInCFRunLoop:(CFRunLoopRef)runLoop forMode:(CFStringRef)mode {
+}
+
+- (void)_unscheduleFromCFRunLoop:(CFRunLoopRef)runLoop forMode:(CFStringRef)mode {
+}
+
+- (BOOL)_setCFClientFlags:(CFOptionFlags)flags callback:(CFReadStreamClientCallBack)callback context:(CFStreamClientContext *)context {
+    return NO;
+}
+
+#pragma mark -
+#pragma mark Deflate
+
+- (void)failWithStatus:(int)status {
+    UA_LERR(@"Failed to GZIP compress stream: %d", status);
+    [self endDeflate];
+    self.error = [NSError errorWithDomain:NSPOSIXErrorDomain code:EIO userInfo:nil];
+    _status = NSStreamStatusError;
+}
+
+- (void)endDeflate {
+    if (_deflateInitialized) {
+        deflateEnd(&_strm);
+        _deflateInitialized = NO;
+    }
+}
+
+@end
@@ -8,6 +8,9 @@
 @property (nonatomic, copy) NSArray *scope;
 @property (nonatomic, strong) UAJSONValueMatcher *valueMatcher;
 @property (nonatomic, copy) NSNumber *ignoreCase;
+
+// The scope followed by the key, built once at init
+@property (nonatomic, copy) NSArray<NSString *> *paths;
 @end
 
 NSString *const UAJSONMatcherKey = @"key";
@@ -26,6 +29,12 @@ NSString * const UAJSONMatcherErrorDomain = @"com.urbanairship.json_matcher";
         self.key = key;
         self.scope = scope;
         self.ignoreCase = ignoreCase;
+
+        NSMutableArray *paths = [NSMutableArray arrayWithArray:scope ?: @[]];
+        if (key) {
+            [paths addObject:key];
+        }
+        self.paths = paths;
     }
 
     return self;
@@ -41,26 +50,13 @@ NSString * const UAJSONMatcherErrorDomain = @"com.urbanairship.json_matcher";
 }
 
 - (BOOL)evaluateObject:(id)value {
-    if (self.ignoreCase) {
-        return [self evaluateObject:value ignoreCase:[self.ignoreCase boolValue]];
-    } else {
-        return [self evaluateObject:value ignoreCase:NO];
-    }
+    return [self evaluateObject:value ignoreCase:[self.ignoreCase boolValue]];
 }
 
 - (BOOL)evaluateObject:(id)value ignoreCase:(BOOL)ignoreCase {
     id object = value;
-    
-    NSMutableArray *paths = [NSMutableArray array];
-    if (self.scope) {
-        [paths addObjectsFromArray:self.scope];
-    }
-
-    if (self.key) {
-        [paths addObject:self.key];
-    }
 
-    for (NSString *path in paths) {
+    for (NSString *path in self.paths) {
         if (![object isKindOfClass:[NSDictionary class]]) {
             object = nil;
             break;
@@ -3,7 +3,18 @@
 #import "UAJSONPredicate.h"
 #import "UAJSONMatcher.h"
 
+/**
+ * The predicate type, resolved once so evaluation does not compare type strings.
+ */
+typedef NS_ENUM(NSInteger, UAJSONPredicateEvaluationType) {
+    UAJSONPredicateEvaluationTypeMatcher,
+    UAJSONPredicateEvaluationTypeAnd,
+    UAJSONPredicateEvaluationTypeOr,
+    UAJSONPredicateEvaluationTypeNot
+};
+
 @interface UAJSONPredicate()
+@property (nonatomic, assign) UAJSONPredicateEvaluationType evaluationType;
 @property (nonatomic, copy) NSString *type;
 @property (nonatomic, copy) NSArray *subpredicates;
 @property (nonatomic, strong) UAJSONMatcher *jsonMatcher;
@@ -27,6 +38,16 @@ NSString * const UAJSONPredicateErrorDomain = @"com.urbanairship.json_predicate"
         self.type = type;
         self.jsonMatcher = jsonMatcher;
         self.subpredicates = subpredicates;
+
+        if ([type isEqualToString:UAJSONPredicateAndType]) {
+            self.evaluationType = UAJSONPredicateEvaluationTypeAnd;
+        } else if ([type isEqualToString:UAJSONPredicateOrType]) {
+            self.evaluationType = UAJSONPredicateEvaluationTypeOr;
+        } else if ([type isEqualToString:UAJSONPredicateNotType]) {
+            self.evaluationType = UAJSONPredicateEvaluationTypeNot;
+        } else {
+            self.evaluationType = UAJSONPredicateEvaluationTypeMatcher;
+        }
     }
 
     return self;
@@ -46,34 +67,31 @@ NSString * const UAJSONPredicateErrorDomain = @"com.urbanairship.json_predicate"
 }
 
 - (BOOL)evaluateObject:(id)object {
-    // And
-    if ([self.type isEqualToString:UAJSONPredicateAndType]) {
-        for (UAJSONPredicate *predicate in self.subpredicates) {
-            if (![predicate evaluateObject:object]) {
-                return NO;
+    switch (self.evaluationType) {
+        case UAJSONPredicateEvaluationTypeAnd:
+            for (UAJSONPredicate *predicate in self.subpredicates) {
+                if (![predicate evaluateObject:object]) {
+                    return NO;
+                }
             }
-        }
-        return YES;
-    }
+            return YES;
 
-    // Or
-    if ([self.type isEqualToString:UAJSONPredicateOrType]) {
-        for (UAJSONPredicate *predicate in self.subpredicates) {
-            if ([predicate evaluateObject:object]) {
-                return YES;
+        case UAJSONPredicateEvaluationTypeOr:
+            for (UAJSONPredicate *predicate in self.subpredicates) {
+                if ([predicate evaluateObject:object]) {
+                    return YES;
+                }
             }
-        }
-        return NO;
-    }
+            return NO;
 
-    // Not
-    if ([self.type isEqualToString:UAJSONPredicateNotType]) {
-        // The factory methods prevent NOT from ever having more than 1 predicate
-        return ![[self.subpredicates firstObject] evaluateObject:object];
-    }
+        case UAJSONPredicateEvaluationTypeNot:
+            // The factory methods prevent NOT from ever having more than 1 predicate
+            return ![[self.subpredicates firstObject] evaluateObject:object];
 
-    // Matcher
-    return [self.jsonMatcher evaluateObject:object];
+        case UAJSONPredicateEvaluationTypeMatcher:
+        default:
+            return [self.jsonMatcher evaluateObject:object];
+    }
 }
 
 + (instancetype)predicateWithJSONMatcher:(UAJSONMatcher *)matcher {
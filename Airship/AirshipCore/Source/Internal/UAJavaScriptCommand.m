@@ -1,65 +1,186 @@
 /* Copyright Airship and Contributors */
 
 #import "UAJavaScriptCommand.h"
-#import "NSString+UAURLEncoding.h"
+
+// Decoded components up to this size are decoded on the stack
+#define kUAJavaScriptCommandStackBufferSize 256
+
+static NSRange const UAJavaScriptCommandNotFound = { NSNotFound, 0 };
 
 @interface UAJavaScriptCommand()
 @property (nonatomic, copy, nullable) NSString *name;
-@property (nonatomic, strong, nullable) NSArray<NSString *> *arguments;
-@property (nonatomic, strong, nullable) NSDictionary *options;
 @property (nonatomic, strong) NSURL *URL;
-@end
 
-@implementation UAJavaScriptCommand
+// Byte ranges into the URL's UTF-8 representation, decoded on first access
+@property (nonatomic, assign) NSRange pathRange;
+@property (nonatomic, assign) NSRange queryRange;
+@end
 
-+ (instancetype)commandForURL:(NSURL *)URL {
+@implementation UAJavaScriptCommand {
+    NSArray<NSString *> *_arguments;
+    NSDictionary *_options;
+}
 
-    NSURLComponents *components = [NSURLComponents componentsWithURL:URL resolvingAgainstBaseURL:NO];
-    NSString *encodedUrlPath = components.percentEncodedPath;
-    if ([encodedUrlPath hasPrefix:@"/"]) {
-        encodedUrlPath = [encodedUrlPath substringFromIndex:1]; //trim the leading slash
+/**
+ * Percent-decodes a component of a UTF-8 buffer. Falls back to the encoded component if it
+ * does not decode to valid UTF-8, and returns an empty string for an empty range.
+ */
+static NSString *UAJavaScriptCommandDecode(const char *bytes, NSRange range) {
+    const char *component = bytes + range.location;
+    if (!memchr(component, '%', range.length)) {
+        return [[NSString alloc] initWithBytes:component length:range.length encoding:NSUTF8StringEncoding] ?: @"";
     }
 
-    // Put the arguments into an array
-    // NOTE: we special case an empty array as componentsSeparatedByString
-    // returns an array with a copy of the input in the first position when passed
-    // a string without any delimiters
-    NSArray *arguments;
-    if (encodedUrlPath.length) {
-        NSArray *encodedArguments = [encodedUrlPath componentsSeparatedByString:@"/"];
-        NSMutableArray *decodedArguments = [NSMutableArray arrayWithCapacity:encodedArguments.count];
-
-        for (NSString *encodedArgument in encodedArguments) {
-            [decodedArguments addObject:[encodedArgument urlDecodedString]];
+    char stackBuffer[kUAJavaScriptCommandStackBufferSize];
+    char *buffer = range.length <= sizeof(stackBuffer) ? stackBuffer : malloc(range.length);
+    NSUInteger decodedLength = 0;
+
+    for (NSUInteger i = 0; i < range.length; i++) {
+        char c = component[i];
+        if (c == '%' && i + 2 < range.length && isxdigit(component[i + 1]) && isxdigit(component[i + 2])) {
+            char hex[3] = { component[i + 1], component[i + 2], '\0' };
+            buffer[decodedLength++] = (char)strtol(hex, NULL, 16);
+            i += 2;
+        } else {
+            buffer[decodedLength++] = c;
         }
+    }
 
-        arguments = [decodedArguments copy];
-    } else {
-        arguments = [NSArray array];//empty
+    NSString *decoded = [[NSString alloc] initWithBytes:buffer length:decodedLength encoding:NSUTF8StringEncoding];
+    if (buffer != stackBuffer) {
+        free(buffer);
     }
 
-    // Dictionary of options - primitive parsing, so external docs should mention the limitations
-    NSMutableDictionary* options = [NSMutableDictionary dictionary];
-
-    for (NSURLQueryItem *queryItem in components.queryItems) {
-        NSString *key = queryItem.name;
-        id value = queryItem.value ?: [NSNull null];
-        if (key && value) {
-            NSMutableArray *values = [options valueForKey:key];
-            if (!values) {
-                values = [NSMutableArray array];
-                [options setObject:values forKey:key];
-            }
-            [values addObject:value];
+    return decoded ?: ([[NSString alloc] initWithBytes:component length:range.length encoding:NSUTF8StringEncoding] ?: @"");
+}
+
+/**
+ * Returns the index of the first of the terminators at or after start, or end if none is found.
+ */
+static NSUInteger UAJavaScriptCommandScan(const char *bytes, NSUInteger start, NSUInteger end, const char *terminators) {
+    for (NSUInteger i = start; i < end; i++) {
+        if (strchr(terminators, bytes[i])) {
+            return i;
         }
     }
+    return end;
+}
 
++ (instancetype)commandForURL:(NSURL *)URL {
     UAJavaScriptCommand *command = [[UAJavaScriptCommand alloc] init];
-    command.name = URL.host;
-    command.arguments = arguments;
-    command.options = options;
     command.URL = URL;
+    command.pathRange = UAJavaScriptCommandNotFound;
+    command.queryRange = UAJavaScriptCommandNotFound;
+
+    // A single pass over scheme://name/arg/arg?key=value#fragment. Only the name is decoded
+    // up front, arguments and options are decoded when first read.
+    const char *bytes = URL.absoluteString.UTF8String;
+    if (!bytes) {
+        return command;
+    }
+
+    NSUInteger length = strlen(bytes);
+    NSUInteger end = UAJavaScriptCommandScan(bytes, 0, length, "#");
+
+    const char *separator = strstr(bytes, "://");
+    if (!separator || (NSUInteger)(separator - bytes) >= end) {
+        return command;
+    }
+
+    NSUInteger hostStart = (separator - bytes) + 3;
+    NSUInteger hostEnd = UAJavaScriptCommandScan(bytes, hostStart, end, "/?");
+    if (hostEnd > hostStart) {
+        command.name = UAJavaScriptCommandDecode(bytes, NSMakeRange(hostStart, hostEnd - hostStart));
+    }
+
+    NSUInteger queryStart = UAJavaScriptCommandScan(bytes, hostEnd, end, "?");
+
+    // Trim the leading slash
+    NSUInteger pathStart = (hostEnd < queryStart && bytes[hostEnd] == '/') ? hostEnd + 1 : hostEnd;
+    command.pathRange = NSMakeRange(pathStart, queryStart - pathStart);
+
+    if (queryStart < end) {
+        command.queryRange = NSMakeRange(queryStart + 1, end - queryStart - 1);
+    }
+
     return command;
 }
 
+- (nullable NSArray<NSString *> *)arguments {
+    @synchronized (self) {
+        if (!_arguments) {
+            _arguments = [self decodeArguments];
+        }
+        return _arguments;
+    }
+}
+
+- (nullable NSDictionary *)options {
+    @synchronized (self) {
+        if (!_options) {
+            _options = [self decodeOptions];
+        }
+        return _options;
+    }
+}
+
+- (NSArray<NSString *> *)decodeArguments {
+    NSRange range = self.pathRange;
+    const char *bytes = self.URL.absoluteString.UTF8String;
+    if (range.location == NSNotFound || !range.length || !bytes) {
+        return @[];
+    }
+
+    NSMutableArray *arguments = [NSMutableArray array];
+    NSUInteger end = NSMaxRange(range);
+    NSUInteger start = range.location;
+    while (YES) {
+        NSUInteger argumentEnd = UAJavaScriptCommandScan(bytes, start, end, "/");
+        [arguments addObject:UAJavaScriptCommandDecode(bytes, NSMakeRange(start, argumentEnd - start))];
+        if (argumentEnd == end) {
+            break;
+        }
+        start = argumentEnd + 1;
+    }
+
+    return [arguments copy];
+}
+
+// Dictionary of options - primitive parsing, so external docs should mention the limitations
+- (NSDictionary *)decodeOptions {
+    NSRange range = self.queryRange;
+    const char *bytes = self.URL.absoluteString.UTF8String;
+    if (range.location == NSNotFound || !range.length || !bytes) {
+        return @{};
+    }
+
+    NSMutableDictionary *options = [NSMutableDictionary dictionary];
+    NSUInteger end = NSMaxRange(range);
+    NSUInteger start = range.location;
+    while (YES) {
+        NSUInteger itemEnd = UAJavaScriptCommandScan(bytes, start, end, "&");
+        NSUInteger nameEnd = UAJavaScriptCommandScan(bytes, start, itemEnd, "=");
+
+        NSString *key = UAJavaScriptCommandDecode(bytes, NSMakeRange(start, nameEnd - start));
+        id value = [NSNull null];
+        if (nameEnd < itemEnd) {
+            value = UAJavaScriptCommandDecode(bytes, NSMakeRange(nameEnd + 1, itemEnd - nameEnd - 1));
+        }
+
+        NSMutableArray *values = options[key];
+        if (!values) {
+            values = [NSMutableArray array];
+            options[key] = values;
+        }
+        [values addObject:value];
+
+        if (itemEnd == end) {
+            break;
+        }
+        start = itemEnd + 1;
+    }
+
+    return options;
+}
+
 @end
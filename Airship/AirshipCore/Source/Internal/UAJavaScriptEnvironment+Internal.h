@@ -0,0 +1,33 @@
+/* Copyright Airship and Contributors */
+
+#import "UAJavaScriptEnvironment.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * The name of the JavaScript function defined by the library script.
+ */
+extern NSString *const UAJavaScriptEnvironmentLibraryFunction;
+
+@interface UAJavaScriptEnvironment()
+
+/**
+ * The static part of the environment. Defines a function that creates the `UAirship`
+ * JavaScript instance from the getter values. The script is built once and does not
+ * expose any values by itself.
+ *
+ * @return The library script.
+ */
++ (NSString *)library;
+
+/**
+ * Builds the script that creates the `UAirship` JavaScript instance from the getter
+ * values. Requires the library script to be loaded in the page.
+ *
+ * @return The values script.
+ */
+- (NSString *)buildValues;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -1,7 +1,6 @@
 /* Copyright Airship and Contributors */
 
-#import "UAJavaScriptEnvironment.h"
-#import "NSString+UAURLEncoding.h"
+#import "UAJavaScriptEnvironment+Internal.h"
 #import "UAGlobal.h"
 #import "UAirship.h"
 #import "UAChannel.h"
@@ -9,8 +8,10 @@
 #import "UARuntimeConfig.h"
 #import "UAirshipCoreResources.h"
 
+NSString *const UAJavaScriptEnvironmentLibraryFunction = @"_UAirshipLibrary";
+
 @interface UAJavaScriptEnvironment()
-@property (nonatomic) NSMutableSet *extensions;
+@property (nonatomic) NSMutableDictionary<NSString *, id> *values;
 @end
 
 @implementation UAJavaScriptEnvironment
@@ -18,7 +19,7 @@
 - (instancetype)init {
     self = [super init];
     if (self) {
-        self.extensions = [NSMutableSet set];
+        self.values = [NSMutableDictionary dictionary];
     }
     return self;
 }
@@ -33,65 +34,75 @@
 }
 
 - (void)addNumberGetter:(NSString *)methodName value:(NSNumber *)value {
-    NSString *extension = [NSString stringWithFormat:@"_UAirship.%@ = function() {return %@;};", methodName, value ?: @(-1)];
-    [self.extensions addObject:extension];
+    // NaN and infinity are not valid JSON
+    if (!value || ![NSJSONSerialization isValidJSONObject:@[value]]) {
+        value = @(-1);
+    }
+
+    self.values[methodName] = value;
 }
 
 - (void)addStringGetter:(NSString *)methodName value:(NSString *)value {
-    NSString *extension;
-    if (!value) {
-        extension = [NSString stringWithFormat:@"_UAirship.%@ = function() {return null;};", methodName];
-    } else {
-        NSString *encodedValue = [value urlEncodedString];
-        extension = [NSString stringWithFormat:@"_UAirship.%@ = function() {return decodeURIComponent(\"%@\");};", methodName, encodedValue];
-    }
-    [self.extensions addObject:extension];
+    self.values[methodName] = value ?: [NSNull null];
 }
 
 - (void)addDictionaryGetter:(NSString *)methodName value:(NSDictionary *)value {
-    NSString *extension;
-    
     if (!value || ![NSJSONSerialization isValidJSONObject:value]) {
-        extension = [NSString stringWithFormat:@"_UAirship.%@ = function() {return null;};", methodName];
-        [self.extensions addObject:extension];
+        self.values[methodName] = [NSNull null];
         return;
     }
-    
-    NSError *error;
-    NSData *jsonData = [NSJSONSerialization dataWithJSONObject:value options:NSJSONWritingPrettyPrinted error:&error];
-  
-    if (error) {
-        extension = [NSString stringWithFormat:@"_UAirship.%@ = function() {return null;};", methodName];
-        [self.extensions addObject:extension];
-        return;
-    }
-    
-    NSString *jsonString = [[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding];
-    extension = [NSString stringWithFormat:@"_UAirship.%@ = function() {return %@;};", methodName, jsonString];
-    
-    [self.extensions addObject:extension];
-}
 
-- (NSString *)build {
-    NSString *js = @"var _UAirship = {};";
-
-    for (NSString *extension in self.extensions) {
-        js = [js stringByAppendingString:extension];
-    }
+    self.values[methodName] = value;
+}
 
-    NSString *path = [[UAirshipCoreResources bundle] pathForResource:@"UANativeBridge" ofType:@""];
-    if (path) {
-        NSString *bridge = [NSString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:nil];
-        if (bridge) {
-            js = [js stringByAppendingString:bridge];
++ (NSString *)library {
+    static dispatch_once_t onceToken;
+    static NSString *library;
+    dispatch_once(&onceToken, ^{
+        NSString *bridge = @"";
+        NSString *path = [[UAirshipCoreResources bundle] pathForResource:@"UANativeBridge" ofType:@""];
+        if (path) {
+            bridge = [NSString stringWithContentsOfFile:path encoding:NSUTF8StringEncoding error:nil];
+            if (!bridge) {
+                UA_LIMPERR(@"UANativeBridge resource file is not decodable.");
+                bridge = @"";
+            }
         } else {
-            UA_LIMPERR(@"UANativeBridge resource file is not decodable.");
+            UA_LIMPERR(@"UANativeBridge resource file is missing.");
         }
-    } else {
-        UA_LIMPERR(@"UANativeBridge resource file is missing.");
+
+        // Each getter returns a fresh copy of its value so pages can't modify it for later callers
+        library = [NSString stringWithFormat:@"var %@ = function(values) {"
+                   "var _UAirship = {};"
+                   "Object.keys(values).forEach(function(name) {"
+                   "var value = JSON.stringify(values[name]);"
+                   "_UAirship[name] = function() {return JSON.parse(value);};"
+                   "});"
+                   "%@\n};", UAJavaScriptEnvironmentLibraryFunction, bridge];
+    });
+
+    return library;
+}
+
+- (NSString *)buildValues {
+    NSError *error;
+    NSData *jsonData = [NSJSONSerialization dataWithJSONObject:self.values options:0 error:&error];
+    NSString *json = jsonData ? [[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding] : nil;
+
+    if (!json) {
+        UA_LERR(@"Unable to serialize JavaScript environment values: %@", error);
+        json = @"{}";
     }
 
-    return js;
+    // Line and paragraph separators are valid in JSON but not in older JavaScript string literals
+    json = [json stringByReplacingOccurrencesOfString:@"\u2028" withString:@"\\u2028"];
+    json = [json stringByReplacingOccurrencesOfString:@"\u2029" withString:@"\\u2029"];
+
+    return [NSString stringWithFormat:@"%@(%@);", UAJavaScriptEnvironmentLibraryFunction, json];
+}
+
+- (NSString *)build {
+    return [[UAJavaScriptEnvironment library] stringByAppendingString:[self buildValues]];
 }
 
 @end
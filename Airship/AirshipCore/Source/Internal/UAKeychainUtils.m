@@ -11,6 +11,13 @@ NSString * const UAKeychainDeviceIDKey = @"com.urbanairship.deviceID";
 
 static NSString *cachedDeviceID_ = nil;
 
+// Keychain reads are slow, so credentials are cached per identifier for the life of the process.
+// Misses are not cached, the credentials may be created by another process or an app update.
+static NSMutableDictionary<NSString *, NSDictionary *> *cachedCredentials_ = nil;
+
+// Bumped whenever credentials are written or deleted, so a read that raced a write is not cached
+static NSUInteger credentialsGeneration_ = 0;
+
 @interface UAKeychainUtils()
 + (NSMutableDictionary *)searchDictionaryWithIdentifier:(NSString *)identifier;
 
@@ -40,6 +47,7 @@ static NSString *cachedDeviceID_ = nil;
     [userDictionary setObject:passwordData forKey:(__bridge id)kSecValueData];
 
     OSStatus status = SecItemAdd((__bridge CFDictionaryRef)userDictionary, NULL);
+    [self invalidateCachedCredentials:identifier];
 
     if (status == errSecSuccess) {
         return YES;
@@ -51,6 +59,7 @@ static NSString *cachedDeviceID_ = nil;
 + (void)deleteKeychainValue:(NSString *)identifier {
     NSMutableDictionary *searchDictionary = [UAKeychainUtils searchDictionaryWithIdentifier:identifier];
     SecItemDelete((__bridge CFDictionaryRef)searchDictionary);
+    [self invalidateCachedCredentials:identifier];
 }
 
 + (BOOL)updateKeychainValueForUsername:(NSString *)username 
@@ -69,6 +78,7 @@ static NSString *cachedDeviceID_ = nil;
 
     OSStatus status = SecItemUpdate((__bridge CFDictionaryRef)searchDictionary,
                                     (__bridge CFDictionaryRef)updateDictionary);
+    [self invalidateCachedCredentials:identifier];
 
     if (status == errSecSuccess) {
         return YES;
@@ -83,12 +93,22 @@ static NSString *cachedDeviceID_ = nil;
  * @return The results dictionary with the username stored under the kSecAttrAccount key,
  * and the password stored under kSecValueData.
  */
-+ (NSDictionary *)getUserCredentials:(NSString *)identifier {
++ (nullable NSDictionary *)getUserCredentials:(NSString *)identifier {
     if (!identifier) {
         UA_LERR(@"Unable to get user credentials. The identifier for the keychain is nil.");
         return nil;
     }
 
+    NSUInteger generation;
+    @synchronized ([UAKeychainUtils class]) {
+        NSDictionary *cached = cachedCredentials_[identifier];
+        if (cached) {
+            return cached;
+        }
+
+        generation = credentialsGeneration_;
+    }
+
     NSMutableDictionary *searchQuery = [UAKeychainUtils searchDictionaryWithIdentifier:identifier];
 
     // Add search attributes
@@ -125,12 +145,53 @@ static NSString *cachedDeviceID_ = nil;
             }
         }
 
+        [self cacheCredentials:resultDict identifier:identifier generation:generation];
         return resultDict;
     }
 
     return nil;
 }
 
++ (nullable NSDictionary *)getCachedUserCredentials:(NSString *)identifier {
+    @synchronized ([UAKeychainUtils class]) {
+        return cachedCredentials_[identifier];
+    }
+}
+
++ (nullable NSString *)getCachedUsername:(NSString *)identifier {
+    return [[[self getCachedUserCredentials:identifier] objectForKey:(__bridge id)kSecAttrAccount] copy];
+}
+
++ (nullable NSString *)getCachedPassword:(NSString *)identifier {
+    NSData *passwordData = [[self getCachedUserCredentials:identifier] valueForKey:(__bridge id)kSecValueData];
+    return passwordData ? [[NSString alloc] initWithData:passwordData encoding:NSUTF8StringEncoding] : nil;
+}
+
++ (void)cacheCredentials:(NSDictionary *)credentials identifier:(NSString *)identifier generation:(NSUInteger)generation {
+    @synchronized ([UAKeychainUtils class]) {
+        // The credentials were written or deleted while they were read
+        if (generation != credentialsGeneration_) {
+            return;
+        }
+
+        if (!cachedCredentials_) {
+            cachedCredentials_ = [NSMutableDictionary dictionary];
+        }
+        cachedCredentials_[identifier] = credentials;
+    }
+}
+
++ (void)invalidateCachedCredentials:(NSString *)identifier {
+    if (!identifier) {
+        return;
+    }
+
+    @synchronized ([UAKeychainUtils class]) {
+        credentialsGeneration_++;
+        [cachedCredentials_ removeObjectForKey:identifier];
+    }
+}
+
 + (NSString *)getPassword:(NSString *)identifier {
     NSDictionary *credentials = [self getUserCredentials:identifier];
     if (credentials) {
@@ -189,9 +250,10 @@ static NSString *cachedDeviceID_ = nil;
 // Note: Due to the unpredictability of the keychain after unlocking the device, this method should only be called
 // on a background queue.
 + (NSString *)getDeviceID {
-
-    if (cachedDeviceID_) {
-        return cachedDeviceID_;
+    @synchronized ([UAKeychainUtils class]) {
+        if (cachedDeviceID_) {
+            return cachedDeviceID_;
+        }
     }
 
     //Get password next
@@ -251,7 +313,9 @@ static NSString *cachedDeviceID_ = nil;
         UA_LDEBUG(@"Generated new Device ID: %@", deviceID);
     }
 
-    cachedDeviceID_ = [deviceID copy];
+    @synchronized ([UAKeychainUtils class]) {
+        cachedDeviceID_ = [deviceID copy];
+    }
 
     return deviceID;
 }
@@ -2,6 +2,7 @@
 
 #import "UALocaleManager.h"
 #import "UAPreferenceDataStore.h"
+#import "UADispatcher.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -26,6 +27,24 @@ NS_ASSUME_NONNULL_BEGIN
 extern NSString *const UALocaleUpdatedEvent;
 extern NSString *const UALocaleUpdatedEventLocaleKey;
 
+/**
+ * NSNotification event when the device context (the locale or the time zone) has changed and
+ * settled. Bursts of locale and time zone changes are coalesced into a single event, so components
+ * that refresh on context changes should observe this instead of the individual notifications.
+ */
+extern NSString *const UADeviceContextChangedEvent;
+
+/**
+ * Factory method. Used for testing.
+ * @param dataStore The shared preference data store.
+ * @param notificationCenter The notification center.
+ * @param dispatcher The dispatcher used to debounce the device context changes.
+ * @return A new locale manager instance.
+ */
++ (instancetype)localeManagerWithDataStore:(UAPreferenceDataStore *)dataStore
+                        notificationCenter:(NSNotificationCenter *)notificationCenter
+                                dispatcher:(UADispatcher *)dispatcher;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -1,30 +1,67 @@
 /* Copyright Airship and Contributors */
 
 #import "UALocaleManager+Internal.h"
+#import "UAGlobal.h"
 
 NSString *const UALocaleUpdatedEventLocaleKey = @"com.urbanairship.locale.locale";
 NSString *const UALocaleUpdatedEvent = @"com.urbanairship.locale.locale_updated";
+NSString *const UADeviceContextChangedEvent = @"com.urbanairship.locale.device_context_changed";
+
+// How long the locale and time zone have to stay unchanged before the context change is posted
+static NSTimeInterval const UADeviceContextChangeDebounceInterval = 2;
 
 @interface UALocaleManager()
 @property (nonatomic, strong) UAPreferenceDataStore *dataStore;
 @property (nonatomic, strong) NSNotificationCenter *notificationCenter;
+@property (nonatomic, strong) UADispatcher *dispatcher;
+@property (nonatomic, strong) UADisposable *pendingContextChange;
 @end
 
 @implementation UALocaleManager
 
 + (instancetype)localeManagerWithDataStore:(UAPreferenceDataStore *)dataStore {
-    return [[UALocaleManager alloc] initWithDataStore:dataStore notificationCenter:[NSNotificationCenter defaultCenter]];
+    return [[UALocaleManager alloc] initWithDataStore:dataStore
+                                   notificationCenter:[NSNotificationCenter defaultCenter]
+                                           dispatcher:[UADispatcher mainDispatcher]];
+}
+
++ (instancetype)localeManagerWithDataStore:(UAPreferenceDataStore *)dataStore
+                        notificationCenter:(NSNotificationCenter *)notificationCenter
+                                dispatcher:(UADispatcher *)dispatcher {
+    return [[UALocaleManager alloc] initWithDataStore:dataStore notificationCenter:notificationCenter dispatcher:dispatcher];
 }
 
 - (instancetype)initWithDataStore:(UAPreferenceDataStore *)dataStore notificationCenter:(NSNotificationCenter *)notificationCenter {
+    return [self initWithDataStore:dataStore notificationCenter:notificationCenter dispatcher:[UADispatcher mainDispatcher]];
+}
+
+- (instancetype)initWithDataStore:(UAPreferenceDataStore *)dataStore
+               notificationCenter:(NSNotificationCenter *)notificationCenter
+                       dispatcher:(UADispatcher *)dispatcher {
     self = [super init];
     if (self) {
         self.dataStore = dataStore;
         self.notificationCenter = notificationCenter;
+        self.dispatcher = dispatcher;
+
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(deviceContextChanged)
+                                        name:NSCurrentLocaleDidChangeNotification
+                                      object:nil];
+
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(deviceContextChanged)
+                                        name:NSSystemTimeZoneDidChangeNotification
+                                      object:nil];
     }
     return self;
 }
 
+- (void)dealloc {
+    [self.notificationCenter removeObserver:self];
+    [self.pendingContextChange dispose];
+}
+
 - (void)setCurrentLocale:(NSLocale *)currentLocale {
     if ([self.currentLocale isEqual:currentLocale]) {
         return;
@@ -39,6 +76,7 @@ NSString *const UALocaleUpdatedEvent = @"com.urbanairship.locale.locale_updated"
     
     NSDictionary *localeDictionary = [NSDictionary dictionaryWithObject:currentLocale forKey:UALocaleUpdatedEventLocaleKey];
     [self.notificationCenter postNotificationName:UALocaleUpdatedEvent object:localeDictionary];
+    [self deviceContextChanged];
 }
 
 - (NSLocale *)currentLocale {
@@ -56,7 +94,25 @@ NSString *const UALocaleUpdatedEvent = @"com.urbanairship.locale.locale_updated"
     NSLocale *defaultLocale = [NSLocale autoupdatingCurrentLocale];
     NSDictionary *localeDictionary = [NSDictionary dictionaryWithObject:defaultLocale forKey:UALocaleUpdatedEventLocaleKey];
     [self.notificationCenter postNotificationName:UALocaleUpdatedEvent object:localeDictionary];
+    [self deviceContextChanged];
 }
 
+// Restarts the quiet period on every change so a burst results in a single context change event
+- (void)deviceContextChanged {
+    @synchronized (self) {
+        [self.pendingContextChange dispose];
+
+        UA_WEAKIFY(self)
+        self.pendingContextChange = [self.dispatcher dispatchAfter:UADeviceContextChangeDebounceInterval block:^{
+            UA_STRONGIFY(self)
+            @synchronized (self) {
+                self.pendingContextChange = nil;
+            }
+
+            UA_LTRACE(@"Device context changed");
+            [self.notificationCenter postNotificationName:UADeviceContextChangedEvent object:nil];
+        }];
+    }
+}
 
 @end
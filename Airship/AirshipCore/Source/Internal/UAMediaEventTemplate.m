@@ -96,53 +96,53 @@
 - (UACustomEvent *)createEvent {
     UACustomEvent *event = [UACustomEvent eventWithName:self.eventName];
 
-    NSMutableDictionary *propertyDictionary = [NSMutableDictionary dictionary];
+    UACustomEventPropertiesBuilder *properties = [[UACustomEventPropertiesBuilder alloc] init];
     
     if (self.eventValue) {
         [event setEventValue:self.eventValue];
-        [propertyDictionary setValue:@YES forKey:kUAMediaEventTemplateLifetimeValue];
+        [properties setBool:YES forKey:kUAMediaEventTemplateLifetimeValue];
     } else {
-        [propertyDictionary setValue:@NO forKey:kUAMediaEventTemplateLifetimeValue];
+        [properties setBool:NO forKey:kUAMediaEventTemplateLifetimeValue];
     }
 
     if (self.identifier) {
-        [propertyDictionary setValue:self.identifier forKey:kUAMediaEventTemplateIdentifier];
+        [properties setString:self.identifier forKey:kUAMediaEventTemplateIdentifier];
     }
 
     if (self.category) {
-        [propertyDictionary setValue:self.category forKey:kUAMediaEventTemplateCategory];
+        [properties setString:self.category forKey:kUAMediaEventTemplateCategory];
     }
 
     if (self.eventDescription) {
-        [propertyDictionary setValue:self.eventDescription forKey:kUAMediaEventTemplateDescription];
+        [properties setString:self.eventDescription forKey:kUAMediaEventTemplateDescription];
     }
 
     if (self.type) {
-        [propertyDictionary setValue:self.type forKey:kUAMediaEventTemplateType];
+        [properties setString:self.type forKey:kUAMediaEventTemplateType];
     }
 
     if (self.featureSet) {
-        [propertyDictionary setValue:@(self.isFeature) forKey:kUAMediaEventTemplateFeature];
+        [properties setBool:self.isFeature forKey:kUAMediaEventTemplateFeature];
     }
 
     if (self.author) {
-        [propertyDictionary setValue:self.author forKey:kUAMediaEventTemplateAuthor];
+        [properties setString:self.author forKey:kUAMediaEventTemplateAuthor];
     }
 
     if (self.publishedDate) {
-        [propertyDictionary setValue:self.publishedDate forKey:kUAMediaEventTemplatePublishedDate];
+        [properties setString:self.publishedDate forKey:kUAMediaEventTemplatePublishedDate];
     }
 
     if (self.source) {
-        [propertyDictionary setValue:self.source forKey:kUAMediaEventTemplateSource];
+        [properties setString:self.source forKey:kUAMediaEventTemplateSource];
     }
 
     if (self.medium) {
-        [propertyDictionary setValue:self.medium forKey:kUAMediaEventTemplateMedium];
+        [properties setString:self.medium forKey:kUAMediaEventTemplateMedium];
     }
 
     event.templateType = kUAMediaEventTemplate;
-    event.properties = propertyDictionary;
+    [event setPropertiesWithBuilder:properties];
     return event;
 }
 
@@ -0,0 +1,25 @@
+/* Copyright Airship and Contributors */
+
+#import "UAMemoryPressureCoordinator.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface UAMemoryPressureCoordinator ()
+
+///---------------------------------------------------------------------------------------
+/// @name Memory Pressure Coordinator Internal Factory
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param notificationCenter The notification center to observe memory warnings on.
+ * @param monitorsMemoryPressure Whether to listen for system memory pressure events.
+ * @return A memory pressure coordinator.
+ */
++ (instancetype)coordinatorWithNotificationCenter:(NSNotificationCenter *)notificationCenter
+                           monitorsMemoryPressure:(BOOL)monitorsMemoryPressure;
+
+@end
+
+NS_ASSUME_NONNULL_END
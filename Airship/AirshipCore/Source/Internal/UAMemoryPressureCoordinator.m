@@ -0,0 +1,190 @@
+/* Copyright Airship and Contributors */
+
+#import <UIKit/UIKit.h>
+
+#import "UAMemoryPressureCoordinator+Internal.h"
+#import "UADisposable.h"
+#import "UAGlobal.h"
+#import "UAMetricsRegistry.h"
+
+/**
+ * A registered memory pressure handler.
+ */
+@interface UAMemoryPressureEntry : NSObject
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, assign) UAMemoryPressurePriority priority;
+@property (nonatomic, copy) UAMemoryPressureHandler handler;
+@end
+
+@implementation UAMemoryPressureEntry
+@end
+
+/**
+ * Counts the objects removed from a cache while it is emptied.
+ */
+@interface UAMemoryPressureCacheCounter : NSObject <NSCacheDelegate>
+@property (nonatomic, assign) NSUInteger count;
+@end
+
+@implementation UAMemoryPressureCacheCounter
+
+- (void)cache:(NSCache *)cache willEvictObject:(id)obj {
+    self.count++;
+}
+
+@end
+
+@interface UAMemoryPressureCoordinator ()
+@property (nonatomic, strong) NSNotificationCenter *notificationCenter;
+@property (nonatomic, strong) NSMutableArray<UAMemoryPressureEntry *> *entries;
+@property (nonatomic, strong, nullable) dispatch_source_t memoryPressureSource;
+@end
+
+@implementation UAMemoryPressureCoordinator
+
+- (instancetype)initWithNotificationCenter:(NSNotificationCenter *)notificationCenter
+                    monitorsMemoryPressure:(BOOL)monitorsMemoryPressure {
+    self = [super init];
+
+    if (self) {
+        self.notificationCenter = notificationCenter;
+        self.entries = [NSMutableArray array];
+
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(didReceiveMemoryWarning)
+                                        name:UIApplicationDidReceiveMemoryWarningNotification
+                                      object:nil];
+
+        if (monitorsMemoryPressure) {
+            [self startMonitoringMemoryPressure];
+        }
+    }
+
+    return self;
+}
+
++ (instancetype)shared {
+    static dispatch_once_t onceToken;
+    static UAMemoryPressureCoordinator *shared;
+    dispatch_once(&onceToken, ^{
+        shared = [[self alloc] initWithNotificationCenter:[NSNotificationCenter defaultCenter]
+                                   monitorsMemoryPressure:YES];
+    });
+    return shared;
+}
+
++ (instancetype)coordinatorWithNotificationCenter:(NSNotificationCenter *)notificationCenter
+                           monitorsMemoryPressure:(BOOL)monitorsMemoryPressure {
+    return [[self alloc] initWithNotificationCenter:notificationCenter monitorsMemoryPressure:monitorsMemoryPressure];
+}
+
+- (void)dealloc {
+    [self.notificationCenter removeObserver:self];
+
+    if (self.memoryPressureSource) {
+        dispatch_source_cancel(self.memoryPressureSource);
+    }
+}
+
+/**
+ * Listens for system memory pressure events. Unlike memory warnings these are also delivered
+ * to app extensions, which run with much tighter memory limits.
+ */
+- (void)startMonitoringMemoryPressure {
+    dispatch_source_t source = dispatch_source_create(DISPATCH_SOURCE_TYPE_MEMORYPRESSURE,
+                                                      0,
+                                                      DISPATCH_MEMORYPRESSURE_WARN | DISPATCH_MEMORYPRESSURE_CRITICAL,
+                                                      dispatch_get_main_queue());
+
+    UA_WEAKIFY(self)
+    dispatch_source_set_event_handler(source, ^{
+        UA_STRONGIFY(self)
+        unsigned long pressure = dispatch_source_get_data(source);
+        if (pressure & DISPATCH_MEMORYPRESSURE_CRITICAL) {
+            [self purgeWithLevel:UAMemoryPressureLevelCritical];
+        } else if (pressure & DISPATCH_MEMORYPRESSURE_WARN) {
+            [self purgeWithLevel:UAMemoryPressureLevelWarning];
+        }
+    });
+
+    dispatch_resume(source);
+    self.memoryPressureSource = source;
+}
+
+- (void)didReceiveMemoryWarning {
+    [self purgeWithLevel:UAMemoryPressureLevelCritical];
+}
+
+- (UADisposable *)registerHandlerWithName:(NSString *)name
+                                 priority:(UAMemoryPressurePriority)priority
+                                  handler:(UAMemoryPressureHandler)handler {
+    UAMemoryPressureEntry *entry = [[UAMemoryPressureEntry alloc] init];
+    entry.name = name;
+    entry.priority = priority;
+    entry.handler = handler;
+
+    @synchronized (self.entries) {
+        [self.entries addObject:entry];
+    }
+
+    UA_WEAKIFY(self)
+    return [UADisposable disposableWithBlock:^{
+        UA_STRONGIFY(self)
+        @synchronized (self.entries) {
+            [self.entries removeObjectIdenticalTo:entry];
+        }
+    }];
+}
+
+- (UADisposable *)registerCache:(NSCache *)cache
+                       priority:(UAMemoryPressurePriority)priority
+             estimatedEntrySize:(NSUInteger)entrySize {
+    NSString *name = cache.name.length ? cache.name : NSStringFromClass([cache class]);
+
+    return [self registerHandlerWithName:name priority:priority handler:^NSUInteger(UAMemoryPressureLevel level) {
+        UAMemoryPressureCacheCounter *counter = [[UAMemoryPressureCacheCounter alloc] init];
+        id<NSCacheDelegate> delegate = cache.delegate;
+        cache.delegate = counter;
+        [cache removeAllObjects];
+        cache.delegate = delegate;
+        return counter.count * entrySize;
+    }];
+}
+
+- (NSUInteger)purgeWithLevel:(UAMemoryPressureLevel)level {
+    NSArray<UAMemoryPressureEntry *> *entries;
+    @synchronized (self.entries) {
+        entries = [self.entries copy];
+    }
+
+    // Stable sort, so handlers with the same priority run in registration order
+    entries = [entries sortedArrayWithOptions:NSSortStable usingComparator:^NSComparisonResult(UAMemoryPressureEntry *a, UAMemoryPressureEntry *b) {
+        if (a.priority == b.priority) {
+            return NSOrderedSame;
+        }
+        return a.priority < b.priority ? NSOrderedAscending : NSOrderedDescending;
+    }];
+
+    UAMemoryPressurePriority maxPriority = level == UAMemoryPressureLevelCritical ? UAMemoryPressurePriorityHigh : UAMemoryPressurePriorityNormal;
+
+    NSUInteger reclaimed = 0;
+    for (UAMemoryPressureEntry *entry in entries) {
+        if (entry.priority > maxPriority) {
+            break;
+        }
+
+        NSUInteger bytes = entry.handler(level);
+        UA_LTRACE(@"Memory pressure handler %@ reclaimed %lu bytes", entry.name, (unsigned long)bytes);
+        reclaimed += bytes;
+    }
+
+    UA_LDEBUG(@"Memory pressure level %lu, reclaimed %lu bytes", (unsigned long)level, (unsigned long)reclaimed);
+
+    UAMetricsRegistry *metrics = [UAMetricsRegistry shared];
+    [metrics incrementCounter:UAMetricMemoryPressureEvents by:1];
+    [metrics incrementCounter:UAMetricMemoryPressureReclaimedBytes by:(int64_t)reclaimed];
+
+    return reclaimed;
+}
+
+@end
@@ -0,0 +1,30 @@
+/* Copyright Airship and Contributors */
+
+#import "UAMetricsRegistry.h"
+
+@class UADispatcher;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface UAMetricsRegistry ()
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @return A metrics registry instance.
+ */
++ (instancetype)metricsRegistry;
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param notificationCenter The notification center.
+ * @param exportDispatcher The dispatcher exporters are called on.
+ * @return A metrics registry instance.
+ */
++ (instancetype)metricsRegistryWithNotificationCenter:(NSNotificationCenter *)notificationCenter
+                                     exportDispatcher:(UADispatcher *)exportDispatcher;
+
+@end
+
+NS_ASSUME_NONNULL_END
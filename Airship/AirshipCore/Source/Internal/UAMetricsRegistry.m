@@ -0,0 +1,612 @@
+/* Copyright Airship and Contributors */
+
+#import "UAMetricsRegistry+Internal.h"
+#import "UAAppStateTracker.h"
+#import "UADispatcher.h"
+
+#import <stdatomic.h>
+
+NSString *const UAMetricEventStoreSize = @"analytics.event_store.bytes";
+NSString *const UAMetricEventStoreFlushDuration = @"analytics.event_store.flush";
+NSString *const UAMetricEventStoreWrites = @"analytics.event_store.writes";
+NSString *const UAMetricEventUploadDuration = @"analytics.upload";
+NSString *const UAMetricEventUploads = @"analytics.uploads";
+NSString *const UAMetricEventUploadFailures = @"analytics.upload_failures";
+NSString *const UAMetricEventsLimited = @"analytics.events_limited";
+NSString *const UAMetricChannelPendingTagMutations = @"channel.pending_tag_mutations";
+NSString *const UAMetricNamedUserPendingTagMutations = @"named_user.pending_tag_mutations";
+NSString *const UAMetricChannelPendingAttributeMutations = @"channel.pending_attribute_mutations";
+NSString *const UAMetricNamedUserPendingAttributeMutations = @"named_user.pending_attribute_mutations";
+NSString *const UAMetricRemoteDataRefreshDuration = @"remote_data.refresh";
+NSString *const UAMetricRemoteDataRefreshes = @"remote_data.refreshes";
+NSString *const UAMetricRemoteDataRefreshFailures = @"remote_data.refresh_failures";
+NSString *const UAMetricRemoteDataBytes = @"remote_data.bytes";
+NSString *const UAMetricNetworkRequestDuration = @"network.request";
+NSString *const UAMetricNetworkRequests = @"network.requests";
+NSString *const UAMetricNetworkRequestErrors = @"network.request_errors";
+NSString *const UAMetricNetworkRequestRetries = @"network.request_retries";
+NSString *const UAMetricPushExtensionDeliveries = @"push.extension_deliveries";
+NSString *const UAMetricAutomationTriggerEvaluationDuration = @"automation.trigger_evaluation";
+NSString *const UAMetricAutomationTriggerEvents = @"automation.trigger_events";
+NSString *const UAMetricAutomationStagePrefix = @"automation.stage.";
+NSString *const UAMetricMessageCenterIconFetches = @"message_center.icon_fetches";
+NSString *const UAMetricMessageCenterIconCacheLoads = @"message_center.icon_cache_loads";
+NSString *const UAMetricMessageCenterStoreRelocationDuration = @"message_center.store_relocation";
+NSString *const UAMetricMemoryPressureEvents = @"memory.pressure_events";
+NSString *const UAMetricMemoryPressureReclaimedBytes = @"memory.reclaimed_bytes";
+NSString *const UAMetricCoreDataStorePrefix = @"core_data.";
+NSString *const UAMetricWorkPrefix = @"work.";
+NSString *const UAMetricWorkDeferred = @"work_scheduler.deferred";
+NSString *const UAMetricWorkDropped = @"work_scheduler.dropped";
+NSString *const UAMetricWorkBudgetRemaining = @"work_scheduler.budget_remaining";
+
+// Number of recent values kept per metric for percentiles
+static NSUInteger const UAMetricSampleCount = 100;
+
+// Doubles are stored in atomic integers by their bit pattern
+static inline uint64_t UAMetricBitsFromDouble(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static inline double UAMetricDoubleFromBits(uint64_t bits) {
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+@interface UAMetric ()
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, assign) UAMetricType type;
+@property (nonatomic, assign) double value;
+@property (nonatomic, assign) NSUInteger count;
+@property (nonatomic, assign) double total;
+@property (nonatomic, assign) double maxValue;
+@property (nonatomic, strong) NSDate *lastUpdated;
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *samples;
++ (instancetype)metricWithName:(NSString *)name type:(UAMetricType)type;
+- (void)addValue:(double)value;
+@end
+
+@implementation UAMetric
+
+- (instancetype)initWithName:(NSString *)name type:(UAMetricType)type {
+    self = [super init];
+
+    if (self) {
+        self.name = name;
+        self.type = type;
+        self.samples = [NSMutableArray array];
+        self.lastUpdated = [NSDate date];
+    }
+
+    return self;
+}
+
++ (instancetype)metricWithName:(NSString *)name type:(UAMetricType)type {
+    return [[self alloc] initWithName:name type:type];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    UAMetric *copy = [[UAMetric allocWithZone:zone] initWithName:self.name type:self.type];
+    copy.value = self.value;
+    copy.count = self.count;
+    copy.total = self.total;
+    copy.maxValue = self.maxValue;
+    copy.lastUpdated = self.lastUpdated;
+    copy.samples = [self.samples mutableCopy];
+    return copy;
+}
+
+- (double)average {
+    return self.count ? self.total / self.count : 0;
+}
+
+- (double)percentile:(double)percentile {
+    if (!self.samples.count) {
+        return 0;
+    }
+
+    // Nearest rank
+    NSArray<NSNumber *> *sorted = [self.samples sortedArrayUsingSelector:@selector(compare:)];
+    double clamped = MIN(MAX(percentile, 0), 100);
+    NSUInteger rank = (NSUInteger)ceil(clamped / 100 * sorted.count);
+    return sorted[MAX(rank, 1) - 1].doubleValue;
+}
+
+- (void)addValue:(double)value {
+    self.count++;
+    self.total += value;
+    self.value = self.type == UAMetricTypeCounter ? self.total : value;
+    self.maxValue = self.count == 1 ? value : MAX(self.maxValue, value);
+    self.lastUpdated = [NSDate date];
+
+    [self.samples addObject:@(value)];
+    if (self.samples.count > UAMetricSampleCount) {
+        [self.samples removeObjectAtIndex:0];
+    }
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<UAMetric %@: value=%f count=%lu average=%f max=%f>",
+            self.name, self.value, (unsigned long)self.count, self.average, self.maxValue];
+}
+
+@end
+
+@interface UAMetricCounter ()
+@property (nonatomic, copy) NSString *name;
++ (instancetype)counterWithName:(NSString *)name;
+- (void)reset;
+- (UAMetric *)metricSnapshot;
+@end
+
+@implementation UAMetricCounter {
+    _Atomic(int64_t) _value;
+    _Atomic(int64_t) _updateCount;
+}
+
+- (instancetype)initWithName:(NSString *)name {
+    self = [super init];
+
+    if (self) {
+        self.name = name;
+        atomic_init(&_value, 0);
+        atomic_init(&_updateCount, 0);
+    }
+
+    return self;
+}
+
++ (instancetype)counterWithName:(NSString *)name {
+    return [[self alloc] initWithName:name];
+}
+
+- (int64_t)value {
+    return atomic_load_explicit(&_value, memory_order_relaxed);
+}
+
+- (int64_t)updateCount {
+    return atomic_load_explicit(&_updateCount, memory_order_relaxed);
+}
+
+- (void)increment {
+    [self incrementBy:1];
+}
+
+- (void)incrementBy:(int64_t)amount {
+    atomic_fetch_add_explicit(&_value, amount, memory_order_relaxed);
+    atomic_fetch_add_explicit(&_updateCount, 1, memory_order_relaxed);
+}
+
+- (void)reset {
+    atomic_store_explicit(&_value, 0, memory_order_relaxed);
+    atomic_store_explicit(&_updateCount, 0, memory_order_relaxed);
+}
+
+- (UAMetric *)metricSnapshot {
+    UAMetric *metric = [UAMetric metricWithName:self.name type:UAMetricTypeCounter];
+    metric.value = self.value;
+    metric.total = metric.value;
+    metric.maxValue = metric.value;
+    metric.count = (NSUInteger)self.updateCount;
+    return metric;
+}
+
+@end
+
+@interface UAMetricHistogram ()
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, copy) NSArray<NSNumber *> *bucketBounds;
++ (instancetype)histogramWithName:(NSString *)name bucketBounds:(NSArray<NSNumber *> *)bucketBounds;
+- (void)reset;
+@end
+
+@implementation UAMetricHistogram {
+    double *_bounds;
+    NSUInteger _boundCount;
+    _Atomic(uint64_t) *_buckets;
+    _Atomic(uint64_t) _count;
+    _Atomic(uint64_t) _sumBits;
+    _Atomic(uint64_t) _maxBits;
+}
+
+- (instancetype)initWithName:(NSString *)name bucketBounds:(NSArray<NSNumber *> *)bucketBounds {
+    self = [super init];
+
+    if (self) {
+        self.name = name;
+        self.bucketBounds = [bucketBounds sortedArrayUsingSelector:@selector(compare:)];
+
+        _boundCount = self.bucketBounds.count;
+        _bounds = calloc(MAX(_boundCount, 1), sizeof(double));
+        for (NSUInteger i = 0; i < _boundCount; i++) {
+            _bounds[i] = self.bucketBounds[i].doubleValue;
+        }
+
+        // One extra bucket for values above the last bound
+        _buckets = calloc(_boundCount + 1, sizeof(_Atomic(uint64_t)));
+        for (NSUInteger i = 0; i <= _boundCount; i++) {
+            atomic_init(&_buckets[i], 0);
+        }
+
+        atomic_init(&_count, 0);
+        atomic_init(&_sumBits, UAMetricBitsFromDouble(0));
+        atomic_init(&_maxBits, UAMetricBitsFromDouble(0));
+    }
+
+    return self;
+}
+
++ (instancetype)histogramWithName:(NSString *)name bucketBounds:(NSArray<NSNumber *> *)bucketBounds {
+    return [[self alloc] initWithName:name bucketBounds:bucketBounds];
+}
+
++ (NSArray<NSNumber *> *)durationBucketBounds {
+    return @[@0.005, @0.01, @0.025, @0.05, @0.1, @0.25, @0.5, @1, @2.5, @5, @10];
+}
+
+- (void)dealloc {
+    free(_bounds);
+    free(_buckets);
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    UAMetricHistogram *copy = [[UAMetricHistogram allocWithZone:zone] initWithName:self.name bucketBounds:self.bucketBounds];
+    for (NSUInteger i = 0; i <= _boundCount; i++) {
+        atomic_store_explicit(&copy->_buckets[i], atomic_load_explicit(&_buckets[i], memory_order_relaxed), memory_order_relaxed);
+    }
+    atomic_store_explicit(&copy->_count, atomic_load_explicit(&_count, memory_order_relaxed), memory_order_relaxed);
+    atomic_store_explicit(&copy->_sumBits, atomic_load_explicit(&_sumBits, memory_order_relaxed), memory_order_relaxed);
+    atomic_store_explicit(&copy->_maxBits, atomic_load_explicit(&_maxBits, memory_order_relaxed), memory_order_relaxed);
+    return copy;
+}
+
+- (NSArray<NSNumber *> *)bucketCounts {
+    NSMutableArray *counts = [NSMutableArray arrayWithCapacity:_boundCount + 1];
+    for (NSUInteger i = 0; i <= _boundCount; i++) {
+        [counts addObject:@(atomic_load_explicit(&_buckets[i], memory_order_relaxed))];
+    }
+    return counts;
+}
+
+- (uint64_t)count {
+    return atomic_load_explicit(&_count, memory_order_relaxed);
+}
+
+- (double)sum {
+    return UAMetricDoubleFromBits(atomic_load_explicit(&_sumBits, memory_order_relaxed));
+}
+
+- (double)maxValue {
+    return UAMetricDoubleFromBits(atomic_load_explicit(&_maxBits, memory_order_relaxed));
+}
+
+- (double)average {
+    uint64_t count = self.count;
+    return count ? self.sum / count : 0;
+}
+
+- (void)recordValue:(double)value {
+    NSUInteger index = 0;
+    while (index < _boundCount && value > _bounds[index]) {
+        index++;
+    }
+
+    atomic_fetch_add_explicit(&_buckets[index], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&_count, 1, memory_order_relaxed);
+
+    uint64_t sumBits = atomic_load_explicit(&_sumBits, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(&_sumBits, &sumBits,
+                                                  UAMetricBitsFromDouble(UAMetricDoubleFromBits(sumBits) + value),
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+
+    uint64_t maxBits = atomic_load_explicit(&_maxBits, memory_order_relaxed);
+    while (value > UAMetricDoubleFromBits(maxBits) &&
+           !atomic_compare_exchange_weak_explicit(&_maxBits, &maxBits, UAMetricBitsFromDouble(value),
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+- (double)percentile:(double)percentile {
+    NSArray<NSNumber *> *counts = self.bucketCounts;
+
+    uint64_t total = 0;
+    for (NSNumber *count in counts) {
+        total += count.unsignedLongLongValue;
+    }
+
+    if (!total) {
+        return 0;
+    }
+
+    double clamped = MIN(MAX(percentile, 0), 100);
+    uint64_t rank = MAX((uint64_t)ceil(clamped / 100 * total), 1);
+
+    uint64_t cumulative = 0;
+    for (NSUInteger i = 0; i < _boundCount; i++) {
+        cumulative += counts[i].unsignedLongLongValue;
+        if (cumulative >= rank) {
+            return MIN(_bounds[i], self.maxValue);
+        }
+    }
+
+    return self.maxValue;
+}
+
+- (void)reset {
+    for (NSUInteger i = 0; i <= _boundCount; i++) {
+        atomic_store_explicit(&_buckets[i], 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&_count, 0, memory_order_relaxed);
+    atomic_store_explicit(&_sumBits, UAMetricBitsFromDouble(0), memory_order_relaxed);
+    atomic_store_explicit(&_maxBits, UAMetricBitsFromDouble(0), memory_order_relaxed);
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<UAMetricHistogram %@: count=%llu average=%f max=%f buckets=%@>",
+            self.name, self.count, self.average, self.maxValue, [self.bucketCounts componentsJoinedByString:@","]];
+}
+
+@end
+
+@interface UAMetricsSnapshot ()
+@property (nonatomic, strong) NSDate *date;
+@property (nonatomic, copy) NSArray<UAMetric *> *metrics;
+@property (nonatomic, copy) NSArray<UAMetricHistogram *> *histograms;
++ (instancetype)snapshotWithMetrics:(NSArray<UAMetric *> *)metrics histograms:(NSArray<UAMetricHistogram *> *)histograms;
+@end
+
+@implementation UAMetricsSnapshot
+
++ (instancetype)snapshotWithMetrics:(NSArray<UAMetric *> *)metrics histograms:(NSArray<UAMetricHistogram *> *)histograms {
+    UAMetricsSnapshot *snapshot = [[self alloc] init];
+    snapshot.date = [NSDate date];
+    snapshot.metrics = metrics;
+    snapshot.histograms = histograms;
+    return snapshot;
+}
+
+@end
+
+@interface UAMetricsRegistry ()
+@property (nonatomic, strong) NSMutableDictionary<NSString *, UAMetric *> *metricsByName;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, double (^)(void)> *gaugeBlocks;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, UAMetricCounter *> *counters;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, UAMetricHistogram *> *histogramsByName;
+@property (nonatomic, strong) NSHashTable<id<UAMetricsExporter>> *exporters;
+@property (nonatomic, strong) NSNotificationCenter *notificationCenter;
+@property (nonatomic, strong) UADispatcher *exportDispatcher;
+@end
+
+@implementation UAMetricsRegistry
+
+- (instancetype)initWithNotificationCenter:(NSNotificationCenter *)notificationCenter
+                          exportDispatcher:(UADispatcher *)exportDispatcher {
+    self = [super init];
+
+    if (self) {
+        self.metricsByName = [NSMutableDictionary dictionary];
+        self.gaugeBlocks = [NSMutableDictionary dictionary];
+        self.counters = [NSMutableDictionary dictionary];
+        self.histogramsByName = [NSMutableDictionary dictionary];
+        self.exporters = [NSHashTable weakObjectsHashTable];
+        self.notificationCenter = notificationCenter;
+        self.exportDispatcher = exportDispatcher;
+
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(exportMetrics)
+                                        name:UAApplicationDidEnterBackgroundNotification
+                                      object:nil];
+    }
+
+    return self;
+}
+
+- (void)dealloc {
+    [self.notificationCenter removeObserver:self];
+}
+
++ (instancetype)shared {
+    static dispatch_once_t onceToken;
+    static UAMetricsRegistry *_shared;
+    dispatch_once(&onceToken, ^{
+        _shared = [self metricsRegistry];
+    });
+
+    return _shared;
+}
+
++ (instancetype)metricsRegistry {
+    return [self metricsRegistryWithNotificationCenter:[NSNotificationCenter defaultCenter]
+                                      exportDispatcher:[UADispatcher globalDispatcherForWorkType:UADispatcherWorkTypeUpload]];
+}
+
++ (instancetype)metricsRegistryWithNotificationCenter:(NSNotificationCenter *)notificationCenter
+                                     exportDispatcher:(UADispatcher *)exportDispatcher {
+    return [[self alloc] initWithNotificationCenter:notificationCenter exportDispatcher:exportDispatcher];
+}
+
+- (NSArray<UAMetric *> *)metrics {
+    [self sampleGauges];
+
+    @synchronized (self) {
+        NSMutableArray<UAMetric *> *snapshots = [NSMutableArray arrayWithCapacity:self.metricsByName.count + self.counters.count];
+        for (UAMetric *metric in self.metricsByName.allValues) {
+            [snapshots addObject:[metric copy]];
+        }
+
+        for (UAMetricCounter *counter in self.counters.allValues) {
+            [snapshots addObject:[counter metricSnapshot]];
+        }
+
+        [snapshots sortUsingComparator:^NSComparisonResult(UAMetric *first, UAMetric *second) {
+            return [first.name compare:second.name];
+        }];
+
+        return snapshots;
+    }
+}
+
+- (NSArray<UAMetricHistogram *> *)histograms {
+    @synchronized (self) {
+        NSMutableArray *snapshots = [NSMutableArray arrayWithCapacity:self.histogramsByName.count];
+        for (NSString *name in [self.histogramsByName.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+            [snapshots addObject:[self.histogramsByName[name] copy]];
+        }
+
+        return snapshots;
+    }
+}
+
+- (nullable UAMetric *)metricWithName:(NSString *)name {
+    double (^block)(void);
+    @synchronized (self) {
+        block = self.gaugeBlocks[name];
+    }
+
+    if (block) {
+        [self setGauge:block() forMetric:name];
+    }
+
+    @synchronized (self) {
+        UAMetricCounter *counter = self.counters[name];
+        return counter ? [counter metricSnapshot] : [self.metricsByName[name] copy];
+    }
+}
+
+- (void)setGauge:(double)value forMetric:(NSString *)name {
+    [self recordValue:value forMetric:name type:UAMetricTypeGauge];
+}
+
+- (void)registerGaugeForMetric:(NSString *)name block:(double (^)(void))block {
+    @synchronized (self) {
+        self.gaugeBlocks[name] = block;
+    }
+}
+
+- (UAMetricCounter *)counterWithName:(NSString *)name {
+    @synchronized (self) {
+        UAMetricCounter *counter = self.counters[name];
+        if (!counter) {
+            counter = [UAMetricCounter counterWithName:name];
+            self.counters[name] = counter;
+        }
+
+        return counter;
+    }
+}
+
+- (UAMetricHistogram *)histogramWithName:(NSString *)name bucketBounds:(NSArray<NSNumber *> *)bucketBounds {
+    @synchronized (self) {
+        UAMetricHistogram *histogram = self.histogramsByName[name];
+        if (!histogram) {
+            histogram = [UAMetricHistogram histogramWithName:name bucketBounds:bucketBounds];
+            self.histogramsByName[name] = histogram;
+        }
+
+        return histogram;
+    }
+}
+
+- (UAMetricHistogram *)durationHistogramWithName:(NSString *)name {
+    return [self histogramWithName:name bucketBounds:[UAMetricHistogram durationBucketBounds]];
+}
+
+- (void)incrementCounter:(NSString *)name by:(int64_t)amount {
+    [[self counterWithName:name] incrementBy:amount];
+
+    id<UAMetricsRegistryDelegate> delegate = self.delegate;
+    if ([delegate respondsToSelector:@selector(metricsRegistry:didRecordValue:forMetric:type:)]) {
+        [delegate metricsRegistry:self didRecordValue:amount forMetric:name type:UAMetricTypeCounter];
+    }
+}
+
+- (void)recordDuration:(NSTimeInterval)duration forMetric:(NSString *)name {
+    [self recordValue:duration forMetric:name type:UAMetricTypeTimer];
+}
+
+- (UAMetricsSnapshot *)snapshot {
+    NSArray<UAMetric *> *metrics = self.metrics;
+    return [UAMetricsSnapshot snapshotWithMetrics:metrics histograms:self.histograms];
+}
+
+- (void)addExporter:(id<UAMetricsExporter>)exporter {
+    @synchronized (self) {
+        [self.exporters addObject:exporter];
+    }
+}
+
+- (void)removeExporter:(id<UAMetricsExporter>)exporter {
+    @synchronized (self) {
+        [self.exporters removeObject:exporter];
+    }
+}
+
+- (void)exportMetrics {
+    NSArray<id<UAMetricsExporter>> *exporters;
+    @synchronized (self) {
+        exporters = self.exporters.allObjects;
+    }
+
+    if (!exporters.count) {
+        return;
+    }
+
+    [self.exportDispatcher dispatchAsync:^{
+        UAMetricsSnapshot *snapshot = [self snapshot];
+        for (id<UAMetricsExporter> exporter in exporters) {
+            [exporter exportMetricsSnapshot:snapshot];
+        }
+    }];
+}
+
+- (void)reset {
+    @synchronized (self) {
+        [self.metricsByName removeAllObjects];
+
+        for (UAMetricCounter *counter in self.counters.allValues) {
+            [counter reset];
+        }
+
+        for (UAMetricHistogram *histogram in self.histogramsByName.allValues) {
+            [histogram reset];
+        }
+    }
+}
+
+- (void)recordValue:(double)value forMetric:(NSString *)name type:(UAMetricType)type {
+    @synchronized (self) {
+        UAMetric *metric = self.metricsByName[name];
+        if (!metric || metric.type != type) {
+            metric = [UAMetric metricWithName:name type:type];
+            self.metricsByName[name] = metric;
+        }
+
+        [metric addValue:value];
+    }
+
+    id<UAMetricsRegistryDelegate> delegate = self.delegate;
+    if ([delegate respondsToSelector:@selector(metricsRegistry:didRecordValue:forMetric:type:)]) {
+        [delegate metricsRegistry:self didRecordValue:value forMetric:name type:type];
+    }
+}
+
+/**
+ * Samples the registered gauges. The blocks are called outside of the lock since they
+ * read from other components.
+ */
+- (void)sampleGauges {
+    NSDictionary<NSString *, double (^)(void)> *gaugeBlocks;
+    @synchronized (self) {
+        gaugeBlocks = [self.gaugeBlocks copy];
+    }
+
+    for (NSString *name in gaugeBlocks) {
+        [self setGauge:gaugeBlocks[name]() forMetric:name];
+    }
+}
+
+@end
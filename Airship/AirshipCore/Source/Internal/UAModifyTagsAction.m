@@ -103,6 +103,10 @@ NSString *const UAModifyTagsDeviceKey = @"device";
     completionHandler([UAActionResult emptyResult]);
 }
 
+- (UAActionThreadAffinity)threadAffinity {
+    return UAActionThreadAffinityBackground;
+}
+
 - (BOOL)areTagGroupsValid:(id)tagGroups {
     if (![tagGroups isKindOfClass:[NSDictionary class]]) {
         return NO;
@@ -3,6 +3,8 @@
 #import "UANSDictionaryValueTransformer.h"
 #import "UAGlobal.h"
 
+static NSString * const UAKeyedArchiverKey = @"$archiver";
+
 @implementation UANSDictionaryValueTransformer
 
 + (Class)transformedValueClass {
@@ -14,10 +16,24 @@
 }
 
 - (id)transformedValue:(id)value {
+    if (!value) {
+        return nil;
+    }
+
+    // Binary plists are much cheaper to decode than keyed archives. Values that are not
+    // property lists (e.g. containing NSNull) fall back to a keyed archive.
+    id result = [NSPropertyListSerialization dataWithPropertyList:value
+                                                           format:NSPropertyListBinaryFormat_v1_0
+                                                          options:0
+                                                            error:nil];
+    if (result) {
+        return result;
+    }
+
     NSError *error = nil;
-    id result = [NSKeyedArchiver archivedDataWithRootObject:value
-                                      requiringSecureCoding:YES
-                                                      error:&error];
+    result = [NSKeyedArchiver archivedDataWithRootObject:value
+                                   requiringSecureCoding:YES
+                                                   error:&error];
 
     if (error) {
         UA_LERR(@"Failed to transform value: %@, error: %@", value, error);
@@ -27,6 +43,20 @@
 }
 
 - (id)reverseTransformedValue:(id)value {
+    if (!value) {
+        return nil;
+    }
+
+    // Keyed archives are binary plists too, so check for the archiver marker
+    id plist = [NSPropertyListSerialization propertyListWithData:value
+                                                         options:NSPropertyListImmutable
+                                                          format:nil
+                                                           error:nil];
+
+    if ([plist isKindOfClass:[NSDictionary class]] && !plist[UAKeyedArchiverKey]) {
+        return plist;
+    }
+
     NSError *error = nil;
     id result = [NSKeyedUnarchiver unarchivedObjectOfClass:[NSDictionary class]
                                                   fromData:value
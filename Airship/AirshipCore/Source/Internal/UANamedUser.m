@@ -9,6 +9,7 @@
 #import "UAAttributePendingMutations.h"
 #import "UAAttributeRegistrar+Internal.h"
 #import "UADate.h"
+#import "UANetworkWindow.h"
 
 #define kUAMaxNamedUserIDLength 128
 
@@ -38,6 +39,16 @@ NSString *const UANamedUserIdentifierChangedNotificationIdentifierKey = @"identi
 @property (nonatomic, strong) UAAttributeRegistrar *attributeRegistrar;
 @property (nonatomic, strong) NSNotificationCenter *notificationCenter;
 
+/**
+ * Depth of nested identity updates. Uploads are held while greater than zero.
+ */
+@property (nonatomic, assign) NSUInteger identityUpdateDepth;
+
+/**
+ * Whether the identifier changed during the current identity update.
+ */
+@property (nonatomic, assign) BOOL identityUpdateChangedIdentifier;
+
 @end
 
 @implementation UANamedUser
@@ -71,6 +82,11 @@ NSString *const UANamedUserIdentifierChangedNotificationIdentifierKey = @"identi
                                     selector:@selector(channelCreated:)
                                         name:UAChannelCreatedEvent
                                       object:nil];
+
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(networkWindowOpened)
+                                        name:UANetworkWindowOpenedEvent
+                                      object:nil];
         UA_WEAKIFY(self)
         [self.channel addChannelExtenderBlock:^(UAChannelRegistrationPayload *payload, UAChannelRegistrationExtenderCompletionHandler completionHandler) {
             UA_STRONGIFY(self)
@@ -189,15 +205,14 @@ NSString *const UANamedUserIdentifierChangedNotificationIdentifierKey = @"identi
         // Update the change token.
         self.changeToken = [NSUUID UUID].UUIDString;
 
-        // Update named user.
-        [self updateNamedUserAssociation];
-
         [self.tagGroupsRegistrar setIdentifier:trimmedID clearPendingOnChange:YES];
         [self.attributeRegistrar setIdentifier:trimmedID clearPendingOnChange:YES];
 
-        // Identifier is non-null. Update CRA.
-        if (self.identifier) {
-            [self.channel updateRegistration];
+        if (self.identityUpdateDepth) {
+            // Uploaded once the identity update finishes
+            self.identityUpdateChangedIdentifier = YES;
+        } else {
+            [self uploadIdentifierChange];
         }
 
         // Notify observers that the identifier has changed.
@@ -212,6 +227,37 @@ NSString *const UANamedUserIdentifierChangedNotificationIdentifierKey = @"identi
     }
 }
 
+- (void)uploadIdentifierChange {
+    // Update named user.
+    [self updateNamedUserAssociation];
+
+    // Identifier is non-null. Update CRA.
+    if (self.identifier) {
+        [self.channel updateRegistration];
+    }
+}
+
+- (void)performIdentityUpdate:(void (^)(void))block {
+    self.identityUpdateDepth++;
+    block();
+    self.identityUpdateDepth--;
+
+    if (self.identityUpdateDepth) {
+        return;
+    }
+
+    if (self.identityUpdateChangedIdentifier) {
+        self.identityUpdateChangedIdentifier = NO;
+        [self uploadIdentifierChange];
+    }
+
+    // Everything pending for the named user goes up in one tag and one attribute upload
+    if (self.identifier) {
+        [self.tagGroupsRegistrar updateTagGroups];
+        [self.attributeRegistrar updateAttributes];
+    }
+}
+
 - (void)setChangeToken:(NSString *)uuidString {
     [self.dataStore setValue:uuidString forKey:UANamedUserChangeTokenKey];
 }
@@ -311,7 +357,12 @@ NSString *const UANamedUserIdentifierChangedNotificationIdentifierKey = @"identi
         UA_LERR(@"Can't update tags without first setting a named user identifier.");
         return;
     }
-    
+
+    if (self.identityUpdateDepth) {
+        // Uploaded once the identity update finishes
+        return;
+    }
+
     [self.tagGroupsRegistrar updateTagGroups];
 }
 
@@ -334,6 +385,20 @@ NSString *const UANamedUserIdentifierChangedNotificationIdentifierKey = @"identi
     }
 }
 
+- (void)networkWindowOpened {
+    if (!self.componentEnabled || !self.identifier) {
+        return;
+    }
+
+    if (self.tagGroupsRegistrar.pendingMutations.count) {
+        [self.tagGroupsRegistrar updateTagGroups];
+    }
+
+    if (self.attributeRegistrar.pendingMutations) {
+        [self.attributeRegistrar updateAttributes];
+    }
+}
+
 - (void)uploadedTagGroupsMutation:(UATagGroupsMutation *)mutation identifier:(NSString *)identifier {
     [[NSNotificationCenter defaultCenter] postNotificationName:UANamedUserUploadedTagGroupMutationNotification
                                                         object:nil
@@ -407,7 +472,10 @@ NSString *const UANamedUserIdentifierChangedNotificationIdentifierKey = @"identi
     UAAttributePendingMutations *pendingMutations = [UAAttributePendingMutations pendingMutationsWithMutations:mutations
                                                                                                           date:self.date];
     [self.attributeRegistrar savePendingMutations:pendingMutations];
-    [self.attributeRegistrar updateAttributes];
+
+    if (!self.identityUpdateDepth) {
+        [self.attributeRegistrar updateAttributes];
+    }
 }
 
 @end
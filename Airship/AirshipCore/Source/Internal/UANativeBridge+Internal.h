@@ -15,6 +15,14 @@ API_UNAVAILABLE(tvos)
 + (instancetype)nativeBridgeWithActionHandler:(UANativeBridgeActionHandler *)actionHandler
             javaScriptEnvironmentFactoryBlock:(UAJavaScriptEnvironment *(^)(void))javaScriptEnvironmentFactoryBlock;
 
+/**
+ * The user script that loads the static part of the JavaScript environment. Web views
+ * with the script installed only receive the environment values on each navigation.
+ *
+ * @return The shared library user script.
+ */
++ (WKUserScript *)libraryUserScript;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -11,13 +11,34 @@
 #import "UAJavaScriptCommand.h"
 #import "NSString+UAURLEncoding.h"
 #import "UANativeBridgeActionHandler+Internal.h"
+#import "UAJavaScriptEnvironment+Internal.h"
 
 NSString *const UANativeBridgeUAirshipScheme = @"uairship";
 NSString *const UANativeBridgeCloseCommand = @"close";
+NSString *const UANativeBridgeMultiCommand = @"multi";
+NSString *const UANativeBridgeScriptMessageHandlerName = @"uairship";
+NSString *const UANativeBridgeScriptMessageCommandsKey = @"commands";
 
-@interface UANativeBridge()
+/**
+ * Forwards script messages to the native bridge. The user content controller retains its
+ * message handlers, so the bridge is held weakly.
+ */
+@interface UANativeBridgeScriptMessageHandler : NSObject <WKScriptMessageHandler>
+@property (nonatomic, weak) id<WKScriptMessageHandler> bridge;
+@end
+
+@implementation UANativeBridgeScriptMessageHandler
+
+- (void)userContentController:(WKUserContentController *)userContentController didReceiveScriptMessage:(WKScriptMessage *)message {
+    [self.bridge userContentController:userContentController didReceiveScriptMessage:message];
+}
+
+@end
+
+@interface UANativeBridge() <WKScriptMessageHandler>
 @property (nonatomic, strong, nonnull) UANativeBridgeActionHandler *actionHandler;
 @property (nonatomic, copy, nonnull) UAJavaScriptEnvironment *(^javaScriptEnvironmentFactoryBlock)(void);
+@property (nonatomic, strong, nonnull) UANativeBridgeScriptMessageHandler *scriptMessageHandler;
 @end
 
 @implementation UANativeBridge
@@ -31,6 +52,8 @@ NSString *const UANativeBridgeCloseCommand = @"close";
     if (self) {
         self.actionHandler = actionHandler;
         self.javaScriptEnvironmentFactoryBlock = javaScriptEnvironmentFactoryBlock;
+        self.scriptMessageHandler = [[UANativeBridgeScriptMessageHandler alloc] init];
+        self.scriptMessageHandler.bridge = self;
     }
 
     return self;
@@ -49,6 +72,17 @@ NSString *const UANativeBridgeCloseCommand = @"close";
     return [[self alloc] initWithActionHandler:actionHandler javaScriptEnvironmentFactoryBlock:javaScriptEnvironmentFactoryBlock];
 }
 
++ (WKUserScript *)libraryUserScript {
+    static dispatch_once_t onceToken;
+    static WKUserScript *userScript;
+    dispatch_once(&onceToken, ^{
+        userScript = [[WKUserScript alloc] initWithSource:[UAJavaScriptEnvironment library]
+                                            injectionTime:WKUserScriptInjectionTimeAtDocumentStart
+                                         forMainFrameOnly:YES];
+    });
+    return userScript;
+}
+
 /**
  * Decide whether to allow or cancel a navigation.
  *
@@ -230,10 +264,69 @@ NSString *const UANativeBridgeCloseCommand = @"close";
         [nativeBridgeExtensionDelegate extendJavaScriptEnvironment:js webView:webView];
     }
 
+    // Route commands from this page to this bridge. Web views may be reused by other bridges.
+    WKUserContentController *userContentController = webView.configuration.userContentController;
+    [userContentController removeScriptMessageHandlerForName:UANativeBridgeScriptMessageHandlerName];
+    [userContentController addScriptMessageHandler:self.scriptMessageHandler name:UANativeBridgeScriptMessageHandlerName];
+
+    WKUserScript *libraryUserScript = [UANativeBridge libraryUserScript];
+    if ([userContentController.userScripts containsObject:libraryUserScript]) {
+        [webView evaluateJavaScript:[js buildValues] completionHandler:nil];
+        return;
+    }
+
     [webView evaluateJavaScript:[js build] completionHandler:nil];
+
+    // Later navigations only need the values
+    [userContentController addUserScript:libraryUserScript];
+}
+
+#pragma mark WKScriptMessageHandler
+
+- (void)userContentController:(WKUserContentController *)userContentController didReceiveScriptMessage:(WKScriptMessage *)message {
+    WKWebView *webView = message.webView;
+    if (!webView || ![self isAllowed:webView.URL]) {
+        UA_LDEBUG(@"URL %@ is not allowed, ignoring native bridge message", webView.URL);
+        return;
+    }
+
+    id commands = [message.body isKindOfClass:[NSDictionary class]] ? message.body[UANativeBridgeScriptMessageCommandsKey] : nil;
+    if (![commands isKindOfClass:[NSArray class]]) {
+        UA_LERR(@"Invalid native bridge message: %@", message.body);
+        return;
+    }
+
+    [self handleAirshipCommandURLStrings:commands webView:webView];
+}
+
+/**
+ * Handles a batch of command URL strings in order. Nested batches are ignored.
+ */
+- (void)handleAirshipCommandURLStrings:(NSArray *)commandURLStrings webView:(WKWebView *)webView {
+    for (id commandURLString in commandURLStrings) {
+        NSURL *commandURL = [commandURLString isKindOfClass:[NSString class]] ? [NSURL URLWithString:commandURLString] : nil;
+        if (![commandURL.scheme isEqualToString:UANativeBridgeUAirshipScheme]) {
+            UA_LERR(@"Invalid native bridge command: %@", commandURLString);
+            continue;
+        }
+
+        UAJavaScriptCommand *command = [UAJavaScriptCommand commandForURL:commandURL];
+        if ([command.name isEqualToString:UANativeBridgeMultiCommand]) {
+            UA_LERR(@"Nested native bridge command batch: %@", commandURLString);
+            continue;
+        }
+
+        [self handleAirshipCommand:command webView:webView];
+    }
 }
 
 - (void)handleAirshipCommand:(UAJavaScriptCommand *)command webView:(WKWebView *)webView {
+    // Batch of encoded commands, uairship://multi/<command>/<command>
+    if ([command.name isEqualToString:UANativeBridgeMultiCommand]) {
+        [self handleAirshipCommandURLStrings:command.arguments webView:webView];
+        return;
+    }
+
     // Close
     if ([command.name isEqualToString:UANativeBridgeCloseCommand]) {
         [self.nativeBridgeDelegate close];
@@ -0,0 +1,39 @@
+/* Copyright Airship and Contributors */
+
+#import "UANetworkMetrics.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * URL protocol property key for a request body's length before compression.
+ */
+extern NSString * const UANetworkMetricsUncompressedBodyLengthKey;
+
+@interface UANetworkMetrics () <NSURLSessionTaskDelegate>
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @return A network metrics instance.
+ */
++ (instancetype)networkMetrics;
+
+/**
+ * Records the metrics for a finished request.
+ *
+ * @param metrics The task metrics.
+ * @param task The task.
+ */
+- (void)recordMetrics:(NSURLSessionTaskMetrics *)metrics task:(NSURLSessionTask *)task;
+
+/**
+ * Returns the endpoint for a URL.
+ *
+ * @param URL The URL.
+ * @return The endpoint.
+ */
++ (NSString *)endpointForURL:(nullable NSURL *)URL;
+
+@end
+
+NS_ASSUME_NONNULL_END
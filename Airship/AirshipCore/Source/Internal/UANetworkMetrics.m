@@ -0,0 +1,268 @@
+/* Copyright Airship and Contributors */
+
+#import "UANetworkMetrics+Internal.h"
+#import "UAMetricsRegistry.h"
+
+NSString * const UANetworkMetricsUncompressedBodyLengthKey = @"com.urbanairship.network_metrics.uncompressed_body_length";
+
+// Number of recent request latencies kept per endpoint for percentiles
+static NSUInteger const UANetworkMetricsLatencySampleCount = 100;
+
+// Path components at least this long that contain a digit are treated as resource identifiers
+static NSUInteger const UANetworkMetricsIdentifierMinLength = 16;
+
+@interface UANetworkEndpointMetrics ()
+@property (nonatomic, copy) NSString *endpoint;
+@property (nonatomic, assign) NSUInteger requestCount;
+@property (nonatomic, assign) NSUInteger reusedConnectionCount;
+@property (nonatomic, assign) int64_t bytesSent;
+@property (nonatomic, assign) int64_t bytesReceived;
+@property (nonatomic, assign) int64_t uncompressedRequestBytes;
+@property (nonatomic, assign) int64_t compressedRequestBytes;
+@property (nonatomic, assign) int64_t decodedResponseBytes;
+@property (nonatomic, assign) int64_t encodedResponseBytes;
+@property (nonatomic, assign) NSTimeInterval totalDNSTime;
+@property (nonatomic, assign) NSUInteger DNSCount;
+@property (nonatomic, assign) NSTimeInterval totalTLSTime;
+@property (nonatomic, assign) NSUInteger TLSCount;
+@property (nonatomic, assign) NSTimeInterval totalTimeToFirstByte;
+@property (nonatomic, assign) NSUInteger timeToFirstByteCount;
+@property (nonatomic, assign) NSTimeInterval totalTransferTime;
+@property (nonatomic, assign) NSUInteger transferCount;
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *latencies;
+@end
+
+@implementation UANetworkEndpointMetrics
+
+- (instancetype)initWithEndpoint:(NSString *)endpoint {
+    self = [super init];
+
+    if (self) {
+        self.endpoint = endpoint;
+        self.latencies = [NSMutableArray array];
+    }
+
+    return self;
+}
+
++ (instancetype)metricsWithEndpoint:(NSString *)endpoint {
+    return [[self alloc] initWithEndpoint:endpoint];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    UANetworkEndpointMetrics *copy = [[UANetworkEndpointMetrics allocWithZone:zone] initWithEndpoint:self.endpoint];
+    copy.requestCount = self.requestCount;
+    copy.reusedConnectionCount = self.reusedConnectionCount;
+    copy.bytesSent = self.bytesSent;
+    copy.bytesReceived = self.bytesReceived;
+    copy.uncompressedRequestBytes = self.uncompressedRequestBytes;
+    copy.compressedRequestBytes = self.compressedRequestBytes;
+    copy.decodedResponseBytes = self.decodedResponseBytes;
+    copy.encodedResponseBytes = self.encodedResponseBytes;
+    copy.totalDNSTime = self.totalDNSTime;
+    copy.DNSCount = self.DNSCount;
+    copy.totalTLSTime = self.totalTLSTime;
+    copy.TLSCount = self.TLSCount;
+    copy.totalTimeToFirstByte = self.totalTimeToFirstByte;
+    copy.timeToFirstByteCount = self.timeToFirstByteCount;
+    copy.totalTransferTime = self.totalTransferTime;
+    copy.transferCount = self.transferCount;
+    copy.latencies = [self.latencies mutableCopy];
+    return copy;
+}
+
+- (double)connectionReuseRate {
+    return self.requestCount ? (double)self.reusedConnectionCount / self.requestCount : 0;
+}
+
+- (double)requestCompressionRatio {
+    return self.compressedRequestBytes ? (double)self.uncompressedRequestBytes / self.compressedRequestBytes : 0;
+}
+
+- (double)responseCompressionRatio {
+    return self.encodedResponseBytes ? (double)self.decodedResponseBytes / self.encodedResponseBytes : 0;
+}
+
+- (NSTimeInterval)averageDNSTime {
+    return self.DNSCount ? self.totalDNSTime / self.DNSCount : 0;
+}
+
+- (NSTimeInterval)averageTLSTime {
+    return self.TLSCount ? self.totalTLSTime / self.TLSCount : 0;
+}
+
+- (NSTimeInterval)averageTimeToFirstByte {
+    return self.timeToFirstByteCount ? self.totalTimeToFirstByte / self.timeToFirstByteCount : 0;
+}
+
+- (NSTimeInterval)averageTransferTime {
+    return self.transferCount ? self.totalTransferTime / self.transferCount : 0;
+}
+
+- (NSTimeInterval)latencyPercentile:(double)percentile {
+    if (!self.latencies.count) {
+        return 0;
+    }
+
+    // Nearest rank
+    NSArray<NSNumber *> *sorted = [self.latencies sortedArrayUsingSelector:@selector(compare:)];
+    double clamped = MIN(MAX(percentile, 0), 100);
+    NSUInteger rank = (NSUInteger)ceil(clamped / 100 * sorted.count);
+    return sorted[MAX(rank, 1) - 1].doubleValue;
+}
+
+- (void)addMetrics:(NSURLSessionTaskMetrics *)metrics task:(NSURLSessionTask *)task {
+    self.requestCount++;
+    self.bytesSent += task.countOfBytesSent;
+    self.bytesReceived += task.countOfBytesReceived;
+
+    NSNumber *uncompressedLength = [NSURLProtocol propertyForKey:UANetworkMetricsUncompressedBodyLengthKey inRequest:task.originalRequest];
+    if (uncompressedLength && task.countOfBytesSent > 0) {
+        self.uncompressedRequestBytes += uncompressedLength.longLongValue;
+        self.compressedRequestBytes += task.countOfBytesSent;
+    }
+
+    [self.latencies addObject:@(metrics.taskInterval.duration)];
+    if (self.latencies.count > UANetworkMetricsLatencySampleCount) {
+        [self.latencies removeObjectAtIndex:0];
+    }
+
+    // The last transaction is the one that loaded the response
+    NSURLSessionTaskTransactionMetrics *transaction = metrics.transactionMetrics.lastObject;
+    if (!transaction) {
+        return;
+    }
+
+    if (transaction.isReusedConnection) {
+        self.reusedConnectionCount++;
+    }
+
+    if (@available(iOS 13.0, tvOS 13.0, *)) {
+        if (transaction.countOfResponseBodyBytesReceived > 0) {
+            self.encodedResponseBytes += transaction.countOfResponseBodyBytesReceived;
+            self.decodedResponseBytes += transaction.countOfResponseBodyBytesAfterDecoding;
+        }
+    }
+
+    if (transaction.domainLookupStartDate && transaction.domainLookupEndDate) {
+        self.totalDNSTime += [transaction.domainLookupEndDate timeIntervalSinceDate:transaction.domainLookupStartDate];
+        self.DNSCount++;
+    }
+
+    if (transaction.secureConnectionStartDate && transaction.secureConnectionEndDate) {
+        self.totalTLSTime += [transaction.secureConnectionEndDate timeIntervalSinceDate:transaction.secureConnectionStartDate];
+        self.TLSCount++;
+    }
+
+    if (transaction.requestStartDate && transaction.responseStartDate) {
+        self.totalTimeToFirstByte += [transaction.responseStartDate timeIntervalSinceDate:transaction.requestStartDate];
+        self.timeToFirstByteCount++;
+    }
+
+    if (transaction.responseStartDate && transaction.responseEndDate) {
+        self.totalTransferTime += [transaction.responseEndDate timeIntervalSinceDate:transaction.responseStartDate];
+        self.transferCount++;
+    }
+}
+
+@end
+
+@interface UANetworkMetrics ()
+@property (nonatomic, strong) NSMutableDictionary<NSString *, UANetworkEndpointMetrics *> *metricsByEndpoint;
+@property (nonatomic, strong) UAMetricHistogram *requestDurationHistogram;
+@end
+
+@implementation UANetworkMetrics
+
+- (instancetype)init {
+    self = [super init];
+
+    if (self) {
+        self.metricsByEndpoint = [NSMutableDictionary dictionary];
+        self.requestDurationHistogram = [[UAMetricsRegistry shared] durationHistogramWithName:UAMetricNetworkRequestDuration];
+    }
+
+    return self;
+}
+
++ (instancetype)shared {
+    static dispatch_once_t onceToken;
+    static UANetworkMetrics *_shared;
+    dispatch_once(&onceToken, ^{
+        _shared = [self networkMetrics];
+    });
+
+    return _shared;
+}
+
++ (instancetype)networkMetrics {
+    return [[self alloc] init];
+}
+
+- (NSArray<UANetworkEndpointMetrics *> *)endpointMetrics {
+    @synchronized (self) {
+        NSMutableArray *snapshots = [NSMutableArray arrayWithCapacity:self.metricsByEndpoint.count];
+        for (NSString *endpoint in [self.metricsByEndpoint.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+            [snapshots addObject:[self.metricsByEndpoint[endpoint] copy]];
+        }
+
+        return snapshots;
+    }
+}
+
+- (void)reset {
+    @synchronized (self) {
+        [self.metricsByEndpoint removeAllObjects];
+    }
+}
+
+- (void)recordMetrics:(NSURLSessionTaskMetrics *)metrics task:(NSURLSessionTask *)task {
+    NSString *endpoint = [UANetworkMetrics endpointForURL:task.originalRequest.URL];
+
+    @synchronized (self) {
+        UANetworkEndpointMetrics *endpointMetrics = self.metricsByEndpoint[endpoint];
+        if (!endpointMetrics) {
+            endpointMetrics = [UANetworkEndpointMetrics metricsWithEndpoint:endpoint];
+            self.metricsByEndpoint[endpoint] = endpointMetrics;
+        }
+
+        [endpointMetrics addMetrics:metrics task:task];
+    }
+
+    [self.requestDurationHistogram recordValue:metrics.taskInterval.duration];
+
+    id<UANetworkMetricsDelegate> delegate = self.delegate;
+    if ([delegate respondsToSelector:@selector(networkMetrics:didCollectMetrics:forEndpoint:)]) {
+        [delegate networkMetrics:self didCollectMetrics:metrics forEndpoint:endpoint];
+    }
+}
+
++ (NSString *)endpointForURL:(NSURL *)URL {
+    if (!URL.host) {
+        return URL.absoluteString ?: @"";
+    }
+
+    NSMutableArray *components = [NSMutableArray arrayWithObject:URL.host];
+    NSCharacterSet *digits = [NSCharacterSet decimalDigitCharacterSet];
+
+    for (NSString *component in URL.pathComponents) {
+        if ([component isEqualToString:@"/"]) {
+            continue;
+        }
+
+        BOOL isUUID = [[NSUUID alloc] initWithUUIDString:component] != nil;
+        BOOL isIdentifier = component.length >= UANetworkMetricsIdentifierMinLength && [component rangeOfCharacterFromSet:digits].location != NSNotFound;
+        [components addObject:(isUUID || isIdentifier) ? @"*" : component];
+    }
+
+    return [components componentsJoinedByString:@"/"];
+}
+
+#pragma mark -
+#pragma mark NSURLSessionTaskDelegate
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics {
+    [self recordMetrics:metrics task:task];
+}
+
+@end
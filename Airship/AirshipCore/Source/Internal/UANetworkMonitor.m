@@ -0,0 +1,163 @@
+/* Copyright Airship and Contributors */
+
+#import "UANetworkMonitor.h"
+#import "UAGlobal.h"
+#import "UAUtils.h"
+#import "UADispatcher.h"
+
+#import <Network/Network.h>
+#import <SystemConfiguration/SystemConfiguration.h>
+#include <netinet/in.h>
+
+NSString *const UANetworkConnectivityChangedEvent = @"com.urbanairship.network.connectivity_changed";
+
+@interface UANetworkMonitor ()
+@property (nonatomic, strong) NSNotificationCenter *notificationCenter;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) id pathMonitor;
+@property (atomic, assign) BOOL hasPath;
+@property (atomic, assign, getter=isConnected) BOOL connected;
+@property (atomic, assign, getter=isExpensive) BOOL expensive;
+@property (atomic, assign, getter=isConstrained) BOOL constrained;
+@property (atomic, copy) NSString *pathConnectionType;
+@end
+
+@implementation UANetworkMonitor
+
+- (instancetype)initWithNotificationCenter:(NSNotificationCenter *)notificationCenter {
+    self = [super init];
+
+    if (self) {
+        self.notificationCenter = notificationCenter;
+        self.connected = YES;
+        self.queue = dispatch_queue_create("com.urbanairship.network_monitor", DISPATCH_QUEUE_SERIAL);
+
+        if (@available(iOS 12.0, tvOS 12.0, *)) {
+            [self startPathMonitor];
+        }
+    }
+
+    return self;
+}
+
++ (instancetype)shared {
+    static dispatch_once_t onceToken;
+    static UANetworkMonitor *_shared;
+    dispatch_once(&onceToken, ^{
+        _shared = [[self alloc] initWithNotificationCenter:[NSNotificationCenter defaultCenter]];
+    });
+
+    return _shared;
+}
+
+- (void)dealloc {
+    if (@available(iOS 12.0, tvOS 12.0, *)) {
+        if (self.pathMonitor) {
+            nw_path_monitor_cancel(self.pathMonitor);
+        }
+    }
+}
+
+- (NSString *)connectionType {
+    if (self.hasPath) {
+        return self.pathConnectionType;
+    }
+
+    return [UANetworkMonitor reachabilityConnectionType];
+}
+
+- (void)startPathMonitor API_AVAILABLE(ios(12.0), tvos(12.0)) {
+    nw_path_monitor_t monitor = nw_path_monitor_create();
+    nw_path_monitor_set_queue(monitor, self.queue);
+
+    UA_WEAKIFY(self)
+    nw_path_monitor_set_update_handler(monitor, ^(nw_path_t path) {
+        UA_STRONGIFY(self)
+        [self updateWithPath:path];
+    });
+
+    nw_path_monitor_start(monitor);
+    self.pathMonitor = monitor;
+}
+
+/**
+ * Caches the new path. Called on the monitor queue.
+ */
+- (void)updateWithPath:(nw_path_t)path API_AVAILABLE(ios(12.0), tvos(12.0)) {
+    BOOL connected = nw_path_get_status(path) == nw_path_status_satisfied;
+    BOOL expensive = nw_path_is_expensive(path);
+    BOOL constrained = NO;
+    if (@available(iOS 13.0, tvOS 13.0, *)) {
+        constrained = nw_path_is_constrained(path);
+    }
+
+    BOOL changed = connected != self.connected || expensive != self.expensive || constrained != self.constrained;
+
+    NSString *connectionType = UAConnectionTypeNone;
+    if (connected) {
+        connectionType = nw_path_uses_interface_type(path, nw_interface_type_cellular) ? UAConnectionTypeCell : UAConnectionTypeWifi;
+    }
+
+    self.pathConnectionType = connectionType;
+    self.expensive = expensive;
+    self.constrained = constrained;
+    self.connected = connected;
+    self.hasPath = YES;
+
+    if (changed) {
+        UA_LDEBUG(@"Network path changed, connected: %d expensive: %d constrained: %d", connected, expensive, constrained);
+        [[UADispatcher mainDispatcher] dispatchAsync:^{
+            [self.notificationCenter postNotificationName:UANetworkConnectivityChangedEvent object:self];
+        }];
+    }
+}
+
+/**
+ * Checks the connection type with a one off reachability check. Used until the path
+ * monitor delivers its first path, or before iOS and tvOS 12.
+ */
++ (NSString *)reachabilityConnectionType {
+    SCNetworkReachabilityFlags flags;
+    SCNetworkReachabilityRef reachabilityRef;
+
+    struct sockaddr_in zeroAddress;
+
+    // Put sizeof(zeroAddress) number of 0-bytes at address &zeroAddress
+    bzero(&zeroAddress, sizeof(zeroAddress));
+
+    // Set length of sockaddr_in struct
+    zeroAddress.sin_len = sizeof(zeroAddress);
+
+    // Set address family to internetwork: UDP, TCP, etc.
+    zeroAddress.sin_family = AF_INET;
+
+    reachabilityRef = SCNetworkReachabilityCreateWithAddress(kCFAllocatorDefault, (const struct sockaddr*)&zeroAddress);
+    Boolean success = SCNetworkReachabilityGetFlags(reachabilityRef, &flags);
+    CFRelease(reachabilityRef);
+
+    // Return early if flags don't return, a connection is required, or the network is unreachable
+    if (!success || (flags & kSCNetworkReachabilityFlagsReachable) == 0) {
+        return UAConnectionTypeNone;
+    }
+
+    NSString *connectionType = UAConnectionTypeNone;
+
+    if ((flags & kSCNetworkReachabilityFlagsConnectionRequired) == 0) {
+        connectionType = UAConnectionTypeWifi;
+    }
+
+    if ((((flags & kSCNetworkReachabilityFlagsConnectionOnDemand ) != 0) ||
+         (flags & kSCNetworkReachabilityFlagsConnectionOnTraffic) != 0)) {
+        if ((flags & kSCNetworkReachabilityFlagsInterventionRequired) == 0) {
+            connectionType = UAConnectionTypeWifi;
+        }
+    }
+
+    if ((flags & kSCNetworkReachabilityFlagsIsWWAN) == kSCNetworkReachabilityFlagsIsWWAN) {
+        connectionType = UAConnectionTypeCell;
+    }
+
+    return connectionType;
+}
+
+@end
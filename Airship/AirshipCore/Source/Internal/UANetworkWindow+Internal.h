@@ -0,0 +1,30 @@
+/* Copyright Airship and Contributors */
+
+#import "UANetworkWindow.h"
+#import "UADate.h"
+#import "UADispatcher.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * How long a window stays open after it opens, roughly the radio's high power tail.
+ */
+extern NSTimeInterval const UANetworkWindowDuration;
+
+@interface UANetworkWindow ()
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param notificationCenter The notification center.
+ * @param date The date.
+ * @param dispatcher The dispatcher the opened event is posted on.
+ * @return A network window instance.
+ */
++ (instancetype)windowWithNotificationCenter:(NSNotificationCenter *)notificationCenter
+                                        date:(UADate *)date
+                                  dispatcher:(UADispatcher *)dispatcher;
+
+@end
+
+NS_ASSUME_NONNULL_END
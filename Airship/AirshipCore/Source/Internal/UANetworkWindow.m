@@ -0,0 +1,80 @@
+/* Copyright Airship and Contributors */
+
+#import "UANetworkWindow+Internal.h"
+#import "UAGlobal.h"
+
+NSString *const UANetworkWindowOpenedEvent = @"com.urbanairship.network.window_opened";
+
+NSTimeInterval const UANetworkWindowDuration = 10;
+
+@interface UANetworkWindow ()
+@property (nonatomic, strong) NSNotificationCenter *notificationCenter;
+@property (nonatomic, strong) UADate *date;
+@property (nonatomic, strong) UADispatcher *dispatcher;
+@property (nonatomic, strong, nullable) NSDate *openedDate;
+@end
+
+@implementation UANetworkWindow
+
+- (instancetype)initWithNotificationCenter:(NSNotificationCenter *)notificationCenter
+                                      date:(UADate *)date
+                                dispatcher:(UADispatcher *)dispatcher {
+    self = [super init];
+
+    if (self) {
+        self.notificationCenter = notificationCenter;
+        self.date = date;
+        self.dispatcher = dispatcher;
+    }
+
+    return self;
+}
+
++ (instancetype)shared {
+    static dispatch_once_t onceToken;
+    static UANetworkWindow *_shared;
+    dispatch_once(&onceToken, ^{
+        _shared = [self windowWithNotificationCenter:[NSNotificationCenter defaultCenter]
+                                                date:[[UADate alloc] init]
+                                          dispatcher:[UADispatcher mainDispatcher]];
+    });
+
+    return _shared;
+}
+
++ (instancetype)windowWithNotificationCenter:(NSNotificationCenter *)notificationCenter
+                                        date:(UADate *)date
+                                  dispatcher:(UADispatcher *)dispatcher {
+    return [[self alloc] initWithNotificationCenter:notificationCenter date:date dispatcher:dispatcher];
+}
+
+- (BOOL)isOpen {
+    @synchronized (self) {
+        return [self isOpenAt:self.date.now];
+    }
+}
+
+- (BOOL)isOpenAt:(NSDate *)date {
+    return self.openedDate && [date timeIntervalSinceDate:self.openedDate] < UANetworkWindowDuration;
+}
+
+- (void)requestStarted {
+    NSDate *now = self.date.now;
+
+    @synchronized (self) {
+        if ([self isOpenAt:now]) {
+            return;
+        }
+
+        self.openedDate = now;
+    }
+
+    UA_LTRACE(@"Network window opened");
+
+    // Posted async so requests sent by observers are not started from within another request
+    [self.dispatcher dispatchAsync:^{
+        [self.notificationCenter postNotificationName:UANetworkWindowOpenedEvent object:self];
+    }];
+}
+
+@end
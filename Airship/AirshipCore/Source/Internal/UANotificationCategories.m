@@ -8,6 +8,7 @@
 #import "UANotificationAction.h"
 #import "UATextInputNotificationAction.h"
 #import "UAirshipCoreResources.h"
+#import "UALocaleManager+Internal.h"
 
 @implementation UANotificationCategories
 
@@ -20,8 +21,41 @@
         return [NSSet set];
     }
 
-    return [self createCategoriesFromFile:[[UAirshipCoreResources bundle] pathForResource:@"UANotificationCategories" ofType:@"plist"]
-                              requireAuth:requireAuth];
+    NSMutableDictionary<NSNumber *, NSSet *> *cache = [self defaultCategoriesCache];
+    @synchronized (cache) {
+        NSSet *categories = cache[@(requireAuth)];
+        if (!categories) {
+            categories = [[self createCategoriesFromFile:[[UAirshipCoreResources bundle] pathForResource:@"UANotificationCategories" ofType:@"plist"]
+                                             requireAuth:requireAuth] copy];
+            cache[@(requireAuth)] = categories;
+        }
+
+        return categories;
+    }
+}
+
+/**
+ * Default categories keyed by whether background actions require authorization. The action
+ * titles are localized, so the cache is dropped whenever the device or SDK locale changes.
+ */
++ (NSMutableDictionary<NSNumber *, NSSet *> *)defaultCategoriesCache {
+    static NSMutableDictionary *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [NSMutableDictionary dictionary];
+
+        void (^clear)(NSNotification *) = ^(NSNotification *notification) {
+            @synchronized (cache) {
+                [cache removeAllObjects];
+            }
+        };
+
+        NSNotificationCenter *notificationCenter = [NSNotificationCenter defaultCenter];
+        [notificationCenter addObserverForName:NSCurrentLocaleDidChangeNotification object:nil queue:nil usingBlock:clear];
+        [notificationCenter addObserverForName:UALocaleUpdatedEvent object:nil queue:nil usingBlock:clear];
+    });
+
+    return cache;
 }
 
 + (NSSet *)createCategoriesFromFile:(NSString *)path {
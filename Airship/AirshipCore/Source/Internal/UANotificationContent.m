@@ -3,8 +3,12 @@
 #import "UANotificationContent.h"
 #import "NSString+UALocalizationAdditions.h"
 #import <UserNotifications/UserNotifications.h>
+#import <stdatomic.h>
 
-@interface UANotificationContent()
+@interface UANotificationContent() {
+    // Set once the payload fields have been read; checked without the lock on the fast path
+    atomic_bool _parsed;
+}
 @property (nonatomic, copy, nullable) NSString *alertTitle;
 @property (nonatomic, copy, nullable) NSString *alertBody;
 @property (nonatomic, copy, nullable) NSString *sound;
@@ -16,97 +20,200 @@
 @property (nonatomic, copy, nullable) NSString *targetContentIdentifier;
 @property (nonatomic, copy, nullable) NSString *categoryIdentifier;
 @property (nonatomic, copy, nullable) NSString *launchImage;
+@property (nonatomic, copy, nullable) NSDictionary *localizationKeys;
 @property (nonatomic, copy, nonnull) NSDictionary *notificationInfo;
 @property (nonatomic, strong, nullable) UNNotification *notification;
 @end
 
 @implementation UANotificationContent
 
+@synthesize alertTitle = _alertTitle;
+@synthesize alertBody = _alertBody;
+@synthesize sound = _sound;
+@synthesize badge = _badge;
+@synthesize contentAvailable = _contentAvailable;
+@synthesize summaryArgument = _summaryArgument;
+@synthesize summaryArgumentCount = _summaryArgumentCount;
+@synthesize threadIdentifier = _threadIdentifier;
+@synthesize targetContentIdentifier = _targetContentIdentifier;
+@synthesize categoryIdentifier = _categoryIdentifier;
+@synthesize launchImage = _launchImage;
+@synthesize localizationKeys = _localizationKeys;
+
 - (instancetype)initWithNotificationInfo:(nonnull NSDictionary *)notificationInfo {
     self = [super init];
     if (self) {
-        NSDictionary *apsDict = [notificationInfo objectForKey:@"aps"];
-        if (apsDict) {
-            // Alert
-            id alert = [apsDict objectForKey:@"alert"];
-            if (alert) {
-                if ([alert isKindOfClass:[NSString class]])  {
+        // Fields are parsed on first access, most notifications only need a few of them
+        self.notificationInfo = notificationInfo;
+        atomic_init(&_parsed, false);
+    }
+
+    return self;
+}
+
+- (instancetype)initWithUNNotification:(UNNotification *)notification {
+    self = [super init];
+    if (self) {
+#if !TARGET_OS_TV   // userInfo not available on tvOS
+        self.notificationInfo = notification.request.content.userInfo;
+#endif
+        self.notification = notification;
+        atomic_init(&_parsed, false);
+    }
+    
+    return self;
+}
+
+- (void)parseIfNeeded {
+    if (atomic_load_explicit(&_parsed, memory_order_acquire)) {
+        return;
+    }
 
-                    // Alert Body
-                    self.alertBody = apsDict[@"alert"];
+    @synchronized (self) {
+        if (atomic_load_explicit(&_parsed, memory_order_relaxed)) {
+            return;
+        }
 
-                } else if ([alert isKindOfClass:[NSDictionary class]]) {
+        if (self.notification) {
+            [self parseNotification:self.notification];
+        } else {
+            [self parseNotificationInfo:self.notificationInfo];
+        }
 
-                    // Alert Title
-                    self.alertTitle = alert[@"title"];
+        _localizationKeys = [self parseLocalizationKeys];
+
+        atomic_store_explicit(&_parsed, true, memory_order_release);
+    }
+}
 
-                    // Alert Body
-                    self.alertBody = alert[@"body"];
+- (void)parseNotificationInfo:(NSDictionary *)notificationInfo {
+    NSDictionary *apsDict = [notificationInfo objectForKey:@"aps"];
+    if (apsDict) {
+        // Alert
+        id alert = [apsDict objectForKey:@"alert"];
+        if (alert) {
+            if ([alert isKindOfClass:[NSString class]])  {
 
-                    // Launch Image
-                    self.launchImage = alert[@"launch-image"];
+                // Alert Body
+                _alertBody = [apsDict[@"alert"] copy];
 
-                    // Summary Arg
-                    self.summaryArgument = alert[@"summary-arg"];
+            } else if ([alert isKindOfClass:[NSDictionary class]]) {
 
-                    // Summary Arg Count
-                    self.summaryArgumentCount = alert[@"summary-arg-count"];
-                }
-            }
+                // Alert Title
+                _alertTitle = [alert[@"title"] copy];
 
-            // Badge
-            self.badge = apsDict[@"badge"];
+                // Alert Body
+                _alertBody = [alert[@"body"] copy];
 
-            // Sound
-            self.sound = apsDict[@"sound"];
+                // Launch Image
+                _launchImage = [alert[@"launch-image"] copy];
 
-            // Category
-            self.categoryIdentifier = apsDict[@"category"];
+                // Summary Arg
+                _summaryArgument = [alert[@"summary-arg"] copy];
 
-            // Thread
-            self.threadIdentifier = apsDict[@"thread-id"];
-            
-            //Target content identifier
-            self.targetContentIdentifier = apsDict[@"target-content-id"];
+                // Summary Arg Count
+                _summaryArgumentCount = alert[@"summary-arg-count"];
+            }
         }
 
-        // Original notification
-        self.notificationInfo = notificationInfo;
-    }
+        // Badge
+        _badge = apsDict[@"badge"];
 
-    return self;
-}
+        // Sound
+        _sound = [apsDict[@"sound"] copy];
 
+        // Category
+        _categoryIdentifier = [apsDict[@"category"] copy];
 
-- (instancetype)initWithUNNotification:(UNNotification *)notification {
-    self = [super init];
-    if (self) {
+        // Thread
+        _threadIdentifier = [apsDict[@"thread-id"] copy];
+
+        //Target content identifier
+        _targetContentIdentifier = [apsDict[@"target-content-id"] copy];
+    }
+}
+
+- (void)parseNotification:(UNNotification *)notification {
 #if !TARGET_OS_TV   // body, title, category and userInfo not available on tvOS
-        self.alertBody = notification.request.content.body;
-        self.alertTitle = notification.request.content.title;
-        self.categoryIdentifier = notification.request.content.categoryIdentifier;
-        self.notificationInfo = notification.request.content.userInfo;
-        self.threadIdentifier = notification.request.content.threadIdentifier;
-        if (@available(iOS 12.0, *)) {
-            self.summaryArgument = notification.request.content.summaryArgument;
-            self.summaryArgumentCount = [NSNumber numberWithUnsignedLong:notification.request.content.summaryArgumentCount];
-        }
-        if (@available(iOS 13.0, *)) {
-            self.targetContentIdentifier = notification.request.content.targetContentIdentifier;
-        }
+    _alertBody = [notification.request.content.body copy];
+    _alertTitle = [notification.request.content.title copy];
+    _categoryIdentifier = [notification.request.content.categoryIdentifier copy];
+    _threadIdentifier = [notification.request.content.threadIdentifier copy];
+    if (@available(iOS 12.0, *)) {
+        _summaryArgument = [notification.request.content.summaryArgument copy];
+        _summaryArgumentCount = [NSNumber numberWithUnsignedLong:notification.request.content.summaryArgumentCount];
+    }
+    if (@available(iOS 13.0, *)) {
+        _targetContentIdentifier = [notification.request.content.targetContentIdentifier copy];
+    }
 #endif
-        self.badge = notification.request.content.badge;
-        self.notification = notification;
-
+    _badge = notification.request.content.badge;
 
-        NSDictionary *apsDict = [self.notificationInfo objectForKey:@"aps"];
-        if (apsDict) {
-            // Sound
-            self.sound = apsDict[@"sound"];
-        }
+    NSDictionary *apsDict = [self.notificationInfo objectForKey:@"aps"];
+    if (apsDict) {
+        // Sound
+        _sound = [apsDict[@"sound"] copy];
     }
-    
-    return self;
+}
+
+- (NSString *)alertTitle {
+    [self parseIfNeeded];
+    return _alertTitle;
+}
+
+- (NSString *)alertBody {
+    [self parseIfNeeded];
+    return _alertBody;
+}
+
+- (NSString *)sound {
+    [self parseIfNeeded];
+    return _sound;
+}
+
+- (NSNumber *)badge {
+    [self parseIfNeeded];
+    return _badge;
+}
+
+- (NSNumber *)contentAvailable {
+    [self parseIfNeeded];
+    return _contentAvailable;
+}
+
+- (NSString *)summaryArgument {
+    [self parseIfNeeded];
+    return _summaryArgument;
+}
+
+- (NSNumber *)summaryArgumentCount {
+    [self parseIfNeeded];
+    return _summaryArgumentCount;
+}
+
+- (NSString *)threadIdentifier {
+    [self parseIfNeeded];
+    return _threadIdentifier;
+}
+
+- (NSString *)targetContentIdentifier {
+    [self parseIfNeeded];
+    return _targetContentIdentifier;
+}
+
+- (NSString *)categoryIdentifier {
+    [self parseIfNeeded];
+    return _categoryIdentifier;
+}
+
+- (NSString *)launchImage {
+    [self parseIfNeeded];
+    return _launchImage;
+}
+
+- (NSDictionary *)localizationKeys {
+    [self parseIfNeeded];
+    return _localizationKeys;
 }
 
 + (instancetype)notificationWithNotificationInfo:(nonnull NSDictionary *)notificationInfo {
@@ -118,7 +225,7 @@
     return notificationContent;
 }
 
--(NSDictionary *)localizationKeys {
+- (NSDictionary *)parseLocalizationKeys {
     if (self.notificationInfo[@"aps"] && self.notificationInfo[@"aps"][@"alert"]) {
 
         // Alert
@@ -126,15 +233,6 @@
         if ([alert isKindOfClass:[NSDictionary class]]) {
             NSMutableDictionary *localizationKeys = [NSMutableDictionary dictionary];
 
-            // Alert Title
-            self.alertTitle = alert[@"title"];
-
-            // Alert Body
-            self.alertBody = alert[@"body"];
-
-            // Launch Image
-            self.launchImage = alert[@"launch-image"];
-
             // Localization Keys
             if (alert[@"title-loc-key"]) {
                 localizationKeys[@"title-loc-key"] = alert[@"title-loc-key"];
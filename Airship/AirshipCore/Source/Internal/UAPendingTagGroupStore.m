@@ -2,6 +2,7 @@
 
 #import "UAPendingTagGroupStore+Internal.h"
 #import "UAPersistentQueue+Internal.h"
+#import "UAGlobal.h"
 
 #define kUATagGroupsSentMutationsDefaultMaxAge 60 * 60 * 24 // 1 Day
 
@@ -15,6 +16,12 @@
 #define kUAPendingChannelTagGroupsMutationsKey @"com.urbanairship.tag_groups.pending_channel_tag_groups_mutations"
 #define kUAPendingNamedUserTagGroupsMutationsKey @"com.urbanairship.tag_groups.pending_named_user_tag_groups_mutations"
 
+// Most tags that can be pending across all groups. Mutations past this are dropped.
+#define kUAPendingTagGroupsMaxTagCount 5000
+
+// Number of mutations the persisted log may grow past the collapsed state before it is rewritten
+#define kUAPendingTagGroupsCompactionThreshold 32
+
 // Max record age
 #define kUATagGroupsSentMutationsMaxAgeKey @"com;urbanairship.tag_groups.transaction_records.max_age"
 
@@ -26,6 +33,29 @@ NSString * const UATagGroupsNamedUserStoreKey = @"named_user";
 @property (nonatomic, copy) NSString *storeKey;
 @property (nonatomic, strong) UAPreferenceDataStore *dataStore;
 @property (nonatomic, strong) UAPersistentQueue *pendingTagGroupsMutations;
+
+/**
+ * The pending mutations collapsed by group. Loaded from the queue once, then updated as
+ * mutations are added and popped.
+ */
+@property (nonatomic, strong, nullable) NSMutableDictionary<NSString *, NSMutableSet *> *addTagGroups;
+@property (nonatomic, strong, nullable) NSMutableDictionary<NSString *, NSMutableSet *> *removeTagGroups;
+@property (nonatomic, strong, nullable) NSMutableDictionary<NSString *, NSMutableSet *> *setTagGroups;
+
+/**
+ * The collapsed mutations. Rebuilt from the collapsed state when it changes.
+ */
+@property (nonatomic, copy, nullable) NSArray<UATagGroupsMutation *> *collapsedMutations;
+
+/**
+ * The number of tags in the collapsed state. Adjusted by the groups each mutation touches.
+ */
+@property (nonatomic, assign) NSUInteger collapsedTagCount;
+
+/**
+ * The number of mutations in the persisted queue.
+ */
+@property (nonatomic, assign) NSUInteger loggedMutationCount;
 @end
 
 @implementation UAPendingTagGroupStore
@@ -103,7 +133,9 @@ NSString * const UATagGroupsNamedUserStoreKey = @"named_user";
     }
     
     if (mutations.count) {
-        [self.pendingTagGroupsMutations addObjects:mutations];
+        for (UATagGroupsMutation *mutation in mutations) {
+            [self addPendingMutation:mutation];
+        }
         [self.dataStore removeObjectForKey:mutationsKey];
     }
 }
@@ -116,30 +148,187 @@ NSString * const UATagGroupsNamedUserStoreKey = @"named_user";
     [self.dataStore setDouble:maxAge forKey:kUATagGroupsSentMutationsMaxAgeKey];
 }
 
+#pragma mark -
+#pragma mark Collapsed State
+
+/**
+ * Loads the collapsed state from the persisted queue. Must be called while synchronized on self.
+ */
+- (void)loadIfNeeded {
+    if (self.addTagGroups) {
+        return;
+    }
+
+    self.addTagGroups = [NSMutableDictionary dictionary];
+    self.removeTagGroups = [NSMutableDictionary dictionary];
+    self.setTagGroups = [NSMutableDictionary dictionary];
+    self.collapsedTagCount = 0;
+
+    NSArray<UATagGroupsMutation *> *mutations = (NSArray<UATagGroupsMutation *> *)[self.pendingTagGroupsMutations objects];
+    for (UATagGroupsMutation *mutation in mutations) {
+        [self foldMutation:mutation];
+    }
+
+    self.loggedMutationCount = mutations.count;
+    [self compactIfNeeded:0];
+}
+
+/**
+ * Must be called while synchronized on self.
+ */
+- (void)foldMutation:(UATagGroupsMutation *)mutation {
+    NSSet<NSString *> *groups = [mutation groups];
+    NSUInteger previousCount = [self collapsedTagCountForGroups:groups];
+
+    [mutation foldIntoAddTagGroups:self.addTagGroups
+                   removeTagGroups:self.removeTagGroups
+                      setTagGroups:self.setTagGroups];
+
+    self.collapsedTagCount = self.collapsedTagCount - previousCount + [self collapsedTagCountForGroups:groups];
+    self.collapsedMutations = nil;
+}
+
+/**
+ * Must be called while synchronized on self.
+ */
+- (NSUInteger)collapsedTagCountForGroups:(NSSet<NSString *> *)groups {
+    NSUInteger count = 0;
+    for (NSString *group in groups) {
+        count += [self.addTagGroups[group] count] + [self.removeTagGroups[group] count] + [self.setTagGroups[group] count];
+    }
+    return count;
+}
+
+/**
+ * Must be called while synchronized on self.
+ */
+- (NSUInteger)tagCountOfTagGroups:(NSDictionary<NSString *, NSSet *> *)tagGroups {
+    NSUInteger count = 0;
+    for (NSString *group in tagGroups) {
+        count += [tagGroups[group] count];
+    }
+    return count;
+}
+
+/**
+ * The number of mutations the collapsed state builds, without building them. Must be called
+ * while synchronized on self.
+ */
+- (NSUInteger)collapsedMutationCount {
+    NSUInteger count = self.setTagGroups.count ? 1 : 0;
+    if (self.addTagGroups.count || self.removeTagGroups.count) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Must be called while synchronized on self.
+ */
+- (NSArray<UATagGroupsMutation *> *)currentMutations {
+    [self loadIfNeeded];
+
+    if (!self.collapsedMutations) {
+        self.collapsedMutations = [UATagGroupsMutation mutationsWithAddTagGroups:self.addTagGroups
+                                                                 removeTagGroups:self.removeTagGroups
+                                                                    setTagGroups:self.setTagGroups];
+    }
+
+    return self.collapsedMutations;
+}
+
+/**
+ * Rewrites the persisted queue with the collapsed mutations once it has grown more than
+ * `threshold` mutations past them. Must be called while synchronized on self.
+ */
+- (void)compactIfNeeded:(NSUInteger)threshold {
+    if (self.loggedMutationCount <= [self collapsedMutationCount] + threshold) {
+        return;
+    }
+
+    NSArray<UATagGroupsMutation *> *mutations = [self currentMutations];
+    if (mutations.count) {
+        [self.pendingTagGroupsMutations setObjects:mutations];
+    } else {
+        [self.pendingTagGroupsMutations clear];
+    }
+
+    self.loggedMutationCount = mutations.count;
+}
+
+#pragma mark -
+#pragma mark Pending Mutations
+
 - (NSArray<UATagGroupsMutation *> *)pendingMutations {
-    return (NSArray<UATagGroupsMutation *>*)[self.pendingTagGroupsMutations objects];
+    @synchronized (self) {
+        return [self currentMutations];
+    }
 }
 
 - (void)addPendingMutation:(UATagGroupsMutation *)mutation {
-    [self.pendingTagGroupsMutations addObject:mutation];
+    @synchronized (self) {
+        [self loadIfNeeded];
+
+        if (self.collapsedTagCount + [mutation tagCount] > kUAPendingTagGroupsMaxTagCount) {
+            UA_LERR(@"Too many pending tag group changes, dropping mutation: %@", mutation.payload);
+            return;
+        }
+
+        [self foldMutation:mutation];
+
+        // Append to the log, and only rewrite it once it has drifted far enough from the collapsed state
+        [self.pendingTagGroupsMutations addObject:mutation];
+        self.loggedMutationCount++;
+        [self compactIfNeeded:kUAPendingTagGroupsCompactionThreshold];
+    }
 }
 
 - (UATagGroupsMutation *)peekPendingMutation {
-    return (UATagGroupsMutation *)[self.pendingTagGroupsMutations peekObject];
+    @synchronized (self) {
+        return [self currentMutations].firstObject;
+    }
 }
 
 - (UATagGroupsMutation *)popPendingMutation {
-    return (UATagGroupsMutation *)[self.pendingTagGroupsMutations popObject];
+    @synchronized (self) {
+        UATagGroupsMutation *mutation = [self currentMutations].firstObject;
+        if (!mutation) {
+            return nil;
+        }
+
+        // The set mutation always comes first
+        if (self.setTagGroups.count) {
+            self.collapsedTagCount -= [self tagCountOfTagGroups:self.setTagGroups];
+            [self.setTagGroups removeAllObjects];
+        } else {
+            self.collapsedTagCount -= [self tagCountOfTagGroups:self.addTagGroups] + [self tagCountOfTagGroups:self.removeTagGroups];
+            [self.addTagGroups removeAllObjects];
+            [self.removeTagGroups removeAllObjects];
+        }
+
+        self.collapsedMutations = nil;
+        [self compactIfNeeded:0];
+
+        return mutation;
+    }
 }
 
 - (void)collapsePendingMutations {
-    [self.pendingTagGroupsMutations collapse:^(NSArray<id<NSCoding>>* objects) {
-        return [UATagGroupsMutation collapseMutations:(NSArray<UATagGroupsMutation *>*)objects];
-    }];
+    @synchronized (self) {
+        [self compactIfNeeded:0];
+    }
 }
 
 - (void)clearPendingMutations {
-    [self.pendingTagGroupsMutations clear];
+    @synchronized (self) {
+        [self.pendingTagGroupsMutations clear];
+        self.addTagGroups = nil;
+        self.removeTagGroups = nil;
+        self.setTagGroups = nil;
+        self.collapsedMutations = nil;
+        self.collapsedTagCount = 0;
+        self.loggedMutationCount = 0;
+    }
 }
 
 @end
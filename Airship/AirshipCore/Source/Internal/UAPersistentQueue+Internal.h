@@ -6,9 +6,14 @@
 NS_ASSUME_NONNULL_BEGIN
 
 /**
- * A queue which serializes to a preference data store objects that conform to the
- * NSCoding protocol. Useful for sequentially feeding data to API clients, or other
- * queue-like operations that also require persistence. This class is thread-safe.
+ * A persistent queue of objects that conform to the NSCoding protocol. Useful for
+ * sequentially feeding data to API clients, or other queue-like operations that also
+ * require persistence. This class is thread-safe.
+ *
+ * The queue is mirrored in memory and changes are appended to a journal file, so adding,
+ * peeking and popping do not re-archive the whole queue. If the journal cannot be written
+ * the queue is archived under the key in the preference data store instead. An archive
+ * under the key takes precedence over the journal and is migrated to a journal on first access.
  */
 @interface UAPersistentQueue : NSObject
 
@@ -20,6 +25,17 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (instancetype)persistentQueueWithDataStore:(UAPreferenceDataStore *)dataStore key:(NSString *)key;
 
+/**
+ * UAPersistentQueue class factory method. Used for testing.
+ *
+ * @param dataStore A preference dataStore.
+ * @param key A key string used to differentiate the queue in the data store.
+ * @param directoryURL The directory for the journal file.
+ */
++ (instancetype)persistentQueueWithDataStore:(UAPreferenceDataStore *)dataStore
+                                         key:(NSString *)key
+                                directoryURL:(NSURL *)directoryURL;
+
 /**
  * Adds an object to the queue.
  *
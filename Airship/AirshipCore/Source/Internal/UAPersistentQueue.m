@@ -1,70 +1,110 @@
 /* Copyright Airship and Contributors */
 
 #import "UAPersistentQueue+Internal.h"
+#import "UAUtils+Internal.h"
+#import "UAGlobal.h"
+
+static NSString * const UAPersistentQueueDirectory = @"UAPersistentQueues";
+static NSString * const UAPersistentQueueJournalExtension = @"journal";
+
+// Number of records the journal may grow past the queue before it is compacted
+static NSUInteger const UAPersistentQueueCompactionThreshold = 64;
+
+// Record header: 1 byte op, 4 byte little-endian payload length
+static NSUInteger const UAPersistentQueueRecordHeaderLength = 5;
+
+typedef NS_ENUM(uint8_t, UAPersistentQueueRecordOp) {
+    // Appends the archived object
+    UAPersistentQueueRecordOpAdd = 1,
+
+    // Removes the top-most object
+    UAPersistentQueueRecordOpPop = 2,
+
+    // Replaces the queue with the archived array
+    UAPersistentQueueRecordOpSnapshot = 3,
+};
 
 @interface UAPersistentQueue ()
 @property (nonatomic, strong) UAPreferenceDataStore *dataStore;
 @property (nonatomic, copy) NSString *key;
+@property (nonatomic, strong, nullable) NSURL *directoryURL;
+@property (nonatomic, strong, nullable) NSMutableArray<id<NSCoding>> *items;
+@property (nonatomic, strong, nullable) NSFileHandle *fileHandle;
+@property (nonatomic, assign) NSUInteger recordCount;
 @end
 
 @implementation UAPersistentQueue
 
-- (instancetype)initWithDataStore:(UAPreferenceDataStore *)dataStore key:(NSString *)key {
+- (instancetype)initWithDataStore:(UAPreferenceDataStore *)dataStore key:(NSString *)key directoryURL:(nullable NSURL *)directoryURL {
     self = [super init];
 
     if (self) {
         self.dataStore = dataStore;
         self.key = key;
+        self.directoryURL = directoryURL;
     }
 
     return self;
 }
 
+- (void)dealloc {
+    [self.fileHandle closeFile];
+}
+
 + (instancetype)persistentQueueWithDataStore:(UAPreferenceDataStore *)dataStore key:(NSString *)key {
-    return [[self alloc] initWithDataStore:dataStore key:key];
+    NSError *error = nil;
+    NSURL *directoryURL = [[UAUtils noBackupDirectoryURL:&error] URLByAppendingPathComponent:UAPersistentQueueDirectory];
+    if (!directoryURL) {
+        UA_LERR(@"Unable to resolve persistent queue directory, falling back to the data store: %@", error);
+    }
+
+    return [[self alloc] initWithDataStore:dataStore key:key directoryURL:directoryURL];
+}
+
++ (instancetype)persistentQueueWithDataStore:(UAPreferenceDataStore *)dataStore
+                                         key:(NSString *)key
+                                directoryURL:(NSURL *)directoryURL {
+    return [[self alloc] initWithDataStore:dataStore key:key directoryURL:directoryURL];
 }
 
 - (void)addObject:(id<NSCoding>)object {
     @synchronized(self) {
-        NSMutableArray<id<NSCoding>> *objects = [[self objects] mutableCopy];
-        [objects addObject:object];
-        [self setObjects:objects];
+        [self loadIfNeeded];
+        [self.items addObject:object];
+        [self appendRecord:UAPersistentQueueRecordOpAdd object:object];
     }
 }
 
 - (void)addObjects:(NSArray<id<NSCoding>> *)objects {
     @synchronized(self) {
-        NSArray<id<NSCoding>> *newObjects = [self objects];
-        newObjects = [newObjects arrayByAddingObjectsFromArray:objects];
-        [self setObjects:newObjects];
+        [self loadIfNeeded];
+        for (id<NSCoding> object in objects) {
+            [self.items addObject:object];
+            [self appendRecord:UAPersistentQueueRecordOpAdd object:object];
+        }
     }
 }
 
 - (nullable id<NSCoding>)peekObject {
     @synchronized(self) {
-        NSArray<id<NSCoding>> *objects = [self objects];
-
-        if (!objects.count) {
-            return nil;
-        }
-
-        return objects[0];
+        [self loadIfNeeded];
+        return self.items.firstObject;
     }
 }
 
 - (nullable id<NSCoding>)popObject {
     @synchronized(self) {
-        NSMutableArray<id<NSCoding>> *objects = [[self objects] mutableCopy];
+        [self loadIfNeeded];
 
-        if (!objects.count) {
+        if (!self.items.count) {
             return nil;
         }
 
-        id<NSCoding> object = objects[0];
-        [objects removeObjectAtIndex:0];
+        id<NSCoding> object = self.items[0];
+        [self.items removeObjectAtIndex:0];
 
-        if (objects.count) {
-            [self setObjects:objects];
+        if (self.items.count) {
+            [self appendRecord:UAPersistentQueueRecordOpPop object:nil];
         } else {
             [self clear];
         }
@@ -75,26 +115,29 @@
 
 - (NSArray<id<NSCoding>> *)objects {
     @synchronized(self) {
-        NSData *encodedItems = [self.dataStore objectForKey:self.key];
-
-        if (!encodedItems) {
-            return @[];
-        }
-
-        return [NSKeyedUnarchiver unarchiveObjectWithData:encodedItems];
+        [self loadIfNeeded];
+        return [self.items copy];
     }
 }
 
 - (void)setObjects:(NSArray<id<NSCoding>> *)objects {
     @synchronized(self) {
-        NSData *encodedObjects = [NSKeyedArchiver archivedDataWithRootObject:objects];
-        [self.dataStore setObject:encodedObjects forKey:self.key];
+        self.items = [objects mutableCopy];
+        [self writeSnapshot];
     }
 }
 
 - (void)clear {
     @synchronized(self) {
+        self.items = [NSMutableArray array];
+        [self closeJournal];
         [self.dataStore removeObjectForKey:self.key];
+        self.recordCount = 0;
+
+        NSURL *journalURL = [self journalURL];
+        if (journalURL) {
+            [[NSFileManager defaultManager] removeItemAtURL:journalURL error:nil];
+        }
     }
 }
 
@@ -105,4 +148,220 @@
     }
 }
 
+#pragma mark -
+#pragma mark Journal
+
+- (nullable NSURL *)journalURL {
+    if (!self.directoryURL) {
+        return nil;
+    }
+
+    NSString *name = [[self.dataStore.keyPrefix ?: @"" stringByAppendingString:self.key] stringByAppendingPathExtension:UAPersistentQueueJournalExtension];
+    return [self.directoryURL URLByAppendingPathComponent:name];
+}
+
+- (void)loadIfNeeded {
+    if (self.items) {
+        return;
+    }
+
+    self.items = [NSMutableArray array];
+
+    NSURL *journalURL = [self journalURL];
+    id value = [self.dataStore objectForKey:self.key];
+
+    if ([value isKindOfClass:[NSData class]]) {
+        // Queue archived in the data store, either from before the journal or written when
+        // the journal failed. It is always newer than any journal left on disk.
+        NSArray *objects = [NSKeyedUnarchiver unarchiveObjectWithData:value];
+        if ([objects isKindOfClass:[NSArray class]]) {
+            [self.items addObjectsFromArray:objects];
+        }
+
+        if (journalURL) {
+            UA_LTRACE(@"Migrating persistent queue %@ to a journal", self.key);
+            [self writeSnapshot];
+        }
+    } else {
+        if (value) {
+            // Marker left by older versions
+            [self.dataStore removeObjectForKey:self.key];
+        }
+
+        if (journalURL && [[NSFileManager defaultManager] fileExistsAtPath:journalURL.path]) {
+            [self readJournal:journalURL];
+        }
+    }
+}
+
+- (void)readJournal:(NSURL *)journalURL {
+    NSData *data = [NSData dataWithContentsOfURL:journalURL];
+    const uint8_t *bytes = data.bytes;
+    NSUInteger offset = 0;
+
+    while (offset + UAPersistentQueueRecordHeaderLength <= data.length) {
+        uint8_t op = bytes[offset];
+        uint32_t length = 0;
+        memcpy(&length, bytes + offset + 1, sizeof(length));
+        length = CFSwapInt32LittleToHost(length);
+
+        NSUInteger payloadOffset = offset + UAPersistentQueueRecordHeaderLength;
+        if (payloadOffset + length > data.length) {
+            // Partial record from an interrupted write
+            UA_LDEBUG(@"Ignoring truncated record in persistent queue %@", self.key);
+            break;
+        }
+
+        NSData *payload = [data subdataWithRange:NSMakeRange(payloadOffset, length)];
+
+        switch (op) {
+            case UAPersistentQueueRecordOpAdd: {
+                id object = [NSKeyedUnarchiver unarchiveObjectWithData:payload];
+                if (object) {
+                    [self.items addObject:object];
+                }
+                break;
+            }
+            case UAPersistentQueueRecordOpPop:
+                if (self.items.count) {
+                    [self.items removeObjectAtIndex:0];
+                }
+                break;
+            case UAPersistentQueueRecordOpSnapshot: {
+                NSArray *objects = length ? [NSKeyedUnarchiver unarchiveObjectWithData:payload] : nil;
+                [self.items removeAllObjects];
+                if ([objects isKindOfClass:[NSArray class]]) {
+                    [self.items addObjectsFromArray:objects];
+                }
+                break;
+            }
+            default:
+                UA_LERR(@"Unknown record %d in persistent queue %@", op, self.key);
+                break;
+        }
+
+        self.recordCount++;
+        offset = payloadOffset + length;
+    }
+}
+
+- (NSData *)recordWithOp:(UAPersistentQueueRecordOp)op payload:(nullable NSData *)payload {
+    uint32_t length = CFSwapInt32HostToLittle((uint32_t)payload.length);
+
+    NSMutableData *record = [NSMutableData dataWithCapacity:UAPersistentQueueRecordHeaderLength + payload.length];
+    [record appendBytes:&op length:sizeof(op)];
+    [record appendBytes:&length length:sizeof(length)];
+    if (payload) {
+        [record appendData:payload];
+    }
+
+    return record;
+}
+
+- (void)appendRecord:(UAPersistentQueueRecordOp)op object:(nullable id<NSCoding>)object {
+    NSURL *journalURL = [self journalURL];
+    if (!journalURL) {
+        [self writeSnapshot];
+        return;
+    }
+
+    // Start the journal with a snapshot if it does not hold the queue yet, e.g. after
+    // falling back to the data store
+    if (!self.recordCount || self.recordCount > self.items.count * 2 + UAPersistentQueueCompactionThreshold) {
+        [self writeSnapshot];
+        return;
+    }
+
+    if (!self.fileHandle) {
+        NSFileManager *fileManager = [NSFileManager defaultManager];
+        if (![fileManager fileExistsAtPath:journalURL.path]) {
+            [fileManager createDirectoryAtURL:self.directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+            [fileManager createFileAtPath:journalURL.path contents:nil attributes:nil];
+        }
+
+        NSError *error = nil;
+        self.fileHandle = [NSFileHandle fileHandleForWritingToURL:journalURL error:&error];
+        if (!self.fileHandle) {
+            UA_LERR(@"Unable to open journal for persistent queue %@: %@", self.key, error);
+            [self writeToDataStore];
+            return;
+        }
+
+        [self.fileHandle seekToEndOfFile];
+    }
+
+    NSData *payload = object ? [NSKeyedArchiver archivedDataWithRootObject:object] : nil;
+    NSError *error = nil;
+    if (![self appendData:[self recordWithOp:op payload:payload] error:&error]) {
+        UA_LERR(@"Unable to append to journal for persistent queue %@: %@", self.key, error);
+        [self writeToDataStore];
+        return;
+    }
+
+    self.recordCount++;
+}
+
+- (BOOL)appendData:(NSData *)data error:(NSError **)error {
+    if (@available(iOS 13.0, tvOS 13.0, *)) {
+        return [self.fileHandle writeData:data error:error];
+    }
+
+    // Older file handle API raises on failure
+    @try {
+        [self.fileHandle writeData:data];
+        return YES;
+    } @catch (NSException *exception) {
+        if (error) {
+            *error = [NSError errorWithDomain:NSCocoaErrorDomain
+                                         code:NSFileWriteUnknownError
+                                     userInfo:@{ NSLocalizedDescriptionKey : exception.reason ?: exception.name }];
+        }
+        return NO;
+    }
+}
+
+- (void)writeSnapshot {
+    NSURL *journalURL = [self journalURL];
+
+    if (!journalURL) {
+        [self writeToDataStore];
+        return;
+    }
+
+    [self closeJournal];
+
+    NSData *payload = [NSKeyedArchiver archivedDataWithRootObject:self.items];
+    NSData *record = [self recordWithOp:UAPersistentQueueRecordOpSnapshot payload:payload];
+
+    NSError *error = nil;
+    [[NSFileManager defaultManager] createDirectoryAtURL:self.directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+    if (![record writeToURL:journalURL options:NSDataWritingAtomic error:&error]) {
+        UA_LERR(@"Unable to write journal for persistent queue %@: %@", self.key, error);
+        [self writeToDataStore];
+        return;
+    }
+
+    self.recordCount = 1;
+    [self.dataStore removeObjectForKey:self.key];
+}
+
+- (void)writeToDataStore {
+    [self closeJournal];
+    self.recordCount = 0;
+
+    NSData *encodedObjects = [NSKeyedArchiver archivedDataWithRootObject:self.items];
+    [self.dataStore setObject:encodedObjects forKey:self.key];
+
+    // The archive takes precedence on load, the next write starts a new journal from it
+    NSURL *journalURL = [self journalURL];
+    if (journalURL) {
+        [[NSFileManager defaultManager] removeItemAtURL:journalURL error:nil];
+    }
+}
+
+- (void)closeJournal {
+    [self.fileHandle closeFile];
+    self.fileHandle = nil;
+}
+
 @end
@@ -7,6 +7,15 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface UAPreferenceDataStore ()
 
+///---------------------------------------------------------------------------------------
+/// @name Preference Data Store Internal Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The prefix applied to all keys.
+ */
+@property (nonatomic, copy, readonly) NSString *keyPrefix;
+
 ///---------------------------------------------------------------------------------------
 /// @name Preference Data Store Internal Methods
 ///---------------------------------------------------------------------------------------
@@ -17,6 +26,12 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)migrateUnprefixedKeys:(NSArray *)keys;
 
+/**
+ * Writes any pending changes from all data stores to the database. Changes are otherwise
+ * written shortly after they are made, or when the app enters the background.
+ */
+- (void)synchronize;
+
 NS_ASSUME_NONNULL_END
 
 @end
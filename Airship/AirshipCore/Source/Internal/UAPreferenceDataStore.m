@@ -1,36 +1,249 @@
 /* Copyright Airship and Contributors */
 
 #import "UAPreferenceDataStore+Internal.h"
+#import "UAAppStateTracker.h"
+#import "UADispatcher.h"
+#import "UAPreferenceDatabase+Internal.h"
+#import "UAGlobal.h"
+
+// How long writes are held before they are written to the database
+static NSTimeInterval const UAPreferenceDataStoreWriteBackDelay = 0.5;
+
+/**
+ * Prefixed key to value caches shared by all data stores, since data stores with the same
+ * prefix may exist at the same time. The cache holds every stored value once loaded.
+ *
+ * Values for a prefix are read from NSUserDefaults until they are migrated into the database.
+ * On tvOS, which does not keep local storage between launches, values stay in NSUserDefaults.
+ */
+static NSMutableDictionary<NSString *, id> *cachedValues;
+static NSMutableDictionary<NSString *, id> *pendingWrites;
+static NSMutableSet<NSString *> *migratedPrefixes;
+static BOOL cacheLoaded;
+static BOOL writeBackScheduled;
 
 @interface UAPreferenceDataStore()
 @property (nonatomic, strong) NSUserDefaults *defaults;
 @property (nonatomic, copy) NSString *keyPrefix;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSString *> *prefixedKeys;
 @end
 
 
 @implementation UAPreferenceDataStore
 
++ (void)initialize {
+    if (self != [UAPreferenceDataStore class]) {
+        return;
+    }
+
+    cachedValues = [NSMutableDictionary dictionary];
+    pendingWrites = [NSMutableDictionary dictionary];
+    migratedPrefixes = [NSMutableSet set];
+
+    NSNotificationCenter *notificationCenter = [NSNotificationCenter defaultCenter];
+    for (NSNotificationName name in @[UAApplicationDidEnterBackgroundNotification, UAApplicationWillTerminateNotification]) {
+        [notificationCenter addObserverForName:name object:nil queue:nil usingBlock:^(NSNotification *notification) {
+            [self writeBack];
+        }];
+    }
+}
+
 + (instancetype)preferenceDataStoreWithKeyPrefix:(NSString *)keyPrefix {
     UAPreferenceDataStore *dataStore = [[UAPreferenceDataStore alloc] init];
     dataStore.defaults = [NSUserDefaults standardUserDefaults];
     dataStore.keyPrefix = keyPrefix;
+    dataStore.prefixedKeys = [NSMutableDictionary dictionary];
+    [dataStore migrateDefaultsIfNeeded];
     return dataStore;
 }
 
+/**
+ * Whether the values for the key prefix are stored in the database.
+ */
+- (BOOL)isMigrated {
+    @synchronized ([UAPreferenceDataStore class]) {
+        return [migratedPrefixes containsObject:self.keyPrefix];
+    }
+}
+
+/**
+ * Moves values for the key prefix from NSUserDefaults into the database, once per prefix. Retried
+ * on every read until the migration is committed.
+ *
+ * @return `YES` if the values for the key prefix are stored in the database, otherwise `NO`.
+ */
+- (BOOL)migrateDefaultsIfNeeded {
+#if TARGET_OS_TV
+    return NO;
+#else
+    if ([self isMigrated]) {
+        return YES;
+    }
+
+    UAPreferenceDatabase *database = [UAPreferenceDatabase sharedDatabase];
+    if (![database hasMigratedPrefix:self.keyPrefix]) {
+        NSMutableDictionary *values = [NSMutableDictionary dictionary];
+        NSDictionary *defaultsValues = [self.defaults dictionaryRepresentation];
+        for (NSString *key in defaultsValues) {
+            if ([key hasPrefix:self.keyPrefix]) {
+                values[key] = defaultsValues[key];
+            }
+        }
+
+        if (![database migrateValues:values prefix:self.keyPrefix]) {
+            return NO;
+        }
+
+        UA_LTRACE(@"Migrated %lu preferences with prefix %@ from NSUserDefaults", (unsigned long)values.count, self.keyPrefix);
+
+        @synchronized ([UAPreferenceDataStore class]) {
+            if (cacheLoaded) {
+                // Values already in the database were kept
+                for (NSString *key in values) {
+                    if (!cachedValues[key]) {
+                        cachedValues[key] = values[key];
+                    }
+                }
+            }
+        }
+
+        for (NSString *key in values) {
+            [self.defaults removeObjectForKey:key];
+        }
+    }
+
+    @synchronized ([UAPreferenceDataStore class]) {
+        [migratedPrefixes addObject:self.keyPrefix];
+    }
+
+    return YES;
+#endif
+}
+
 - (NSString *)prefixKey:(nonnull NSString *)key {
-    return [self.keyPrefix stringByAppendingString:key];
+    @synchronized (self.prefixedKeys) {
+        NSString *prefixedKey = self.prefixedKeys[key];
+        if (!prefixedKey) {
+            prefixedKey = [self.keyPrefix stringByAppendingString:key];
+            self.prefixedKeys[key] = prefixedKey;
+        }
+        return prefixedKey;
+    }
+}
+
+#pragma mark -
+#pragma mark Cache
+
+- (nullable id)cachedObjectForKey:(NSString *)key {
+    NSString *prefixedKey = [self prefixKey:key];
+
+    if (![self migrateDefaultsIfNeeded]) {
+        id value;
+        @synchronized ([UAPreferenceDataStore class]) {
+            value = pendingWrites[prefixedKey];
+        }
+
+        // Read outside of the lock, the defaults may post change notifications
+        value = value ?: [self.defaults objectForKey:prefixedKey];
+        return value == [NSNull null] ? nil : value;
+    }
+
+    @synchronized ([UAPreferenceDataStore class]) {
+        if (!cacheLoaded) {
+            // Retried on the next read if the database is unavailable
+            NSDictionary *values = [[UAPreferenceDatabase sharedDatabase] loadValues];
+            if (values) {
+                [cachedValues addEntriesFromDictionary:values];
+                cacheLoaded = YES;
+            }
+        }
+
+        id value = pendingWrites[prefixedKey] ?: cachedValues[prefixedKey];
+        return value == [NSNull null] ? nil : value;
+    }
 }
 
+- (void)cacheObject:(nullable id)value forKey:(NSString *)key {
+    NSString *prefixedKey = [self prefixKey:key];
+
+    // A removed value must not come back from the defaults, before or through the migration
+    if (!value && ![self isMigrated]) {
+        [self.defaults removeObjectForKey:prefixedKey];
+    }
+
+    @synchronized ([UAPreferenceDataStore class]) {
+        pendingWrites[prefixedKey] = [value conformsToProtocol:@protocol(NSCopying)] ? [value copy] : (value ?: [NSNull null]);
+
+        if (!writeBackScheduled) {
+            writeBackScheduled = YES;
+            [[UADispatcher globalDispatcher:QOS_CLASS_UTILITY] dispatchAfter:UAPreferenceDataStoreWriteBackDelay block:^{
+                [UAPreferenceDataStore writeBack];
+            }];
+        }
+    }
+}
+
++ (void)writeBack {
+    NSDictionary<NSString *, id> *writes;
+    @synchronized (self) {
+        writeBackScheduled = NO;
+        if (!pendingWrites.count) {
+            return;
+        }
+
+        writes = [pendingWrites copy];
+        [pendingWrites removeAllObjects];
+
+        for (NSString *prefixedKey in writes) {
+            if (writes[prefixedKey] == [NSNull null]) {
+                [cachedValues removeObjectForKey:prefixedKey];
+            } else {
+                cachedValues[prefixedKey] = writes[prefixedKey];
+            }
+        }
+    }
+
+#if TARGET_OS_TV
+    NSUserDefaults *defaults = [NSUserDefaults standardUserDefaults];
+    for (NSString *prefixedKey in writes) {
+        id value = writes[prefixedKey];
+        if (value == [NSNull null]) {
+            [defaults removeObjectForKey:prefixedKey];
+        } else {
+            [defaults setObject:value forKey:prefixedKey];
+        }
+    }
+#else
+    if (![[UAPreferenceDatabase sharedDatabase] writeValues:writes]) {
+        // Keep the writes for the next write-back, unless they were replaced since
+        @synchronized (self) {
+            for (NSString *prefixedKey in writes) {
+                if (!pendingWrites[prefixedKey]) {
+                    pendingWrites[prefixedKey] = writes[prefixedKey];
+                }
+            }
+        }
+    }
+#endif
+}
+
+- (void)synchronize {
+    [UAPreferenceDataStore writeBack];
+}
+
+#pragma mark -
+#pragma mark Values
+
 - (id)valueForKey:(NSString *)key {
-    return [self.defaults valueForKey:[self prefixKey:key]];
+    return [self cachedObjectForKey:key];
 }
 
 - (void)setValue:(id)value forKey:(NSString *)key {
-    [self.defaults setValue:value forKey:[self prefixKey:key]];
+    [self cacheObject:value forKey:key];
 }
 
 - (void)removeObjectForKey:(NSString *)key {
-    [self.defaults removeObjectForKey:[self prefixKey:key]];
+    [self cacheObject:nil forKey:key];
 }
 
 - (BOOL)keyExists:(NSString *)key {
@@ -38,39 +251,62 @@
 }
 
 - (id)objectForKey:(NSString *)key {
-    return [self.defaults objectForKey:[self prefixKey:key]];
+    return [self cachedObjectForKey:key];
+}
+
+- (nullable id)objectForKey:(NSString *)key ofClass:(Class)class {
+    id value = [self cachedObjectForKey:key];
+    return [value isKindOfClass:class] ? value : nil;
 }
 
 - (NSString *)stringForKey:(NSString *)key {
-    return [self.defaults stringForKey:[self prefixKey:key]];
+    id value = [self cachedObjectForKey:key];
+    if ([value isKindOfClass:[NSNumber class]]) {
+        return [value stringValue];
+    }
+    return [value isKindOfClass:[NSString class]] ? value : nil;
 }
 
 - (NSArray *)arrayForKey:(NSString *)key {
-    return [self.defaults arrayForKey:[self prefixKey:key]];
+    return [self objectForKey:key ofClass:[NSArray class]];
 }
 
 - (NSDictionary *)dictionaryForKey:(NSString *)key {
-    return [self.defaults dictionaryForKey:[self prefixKey:key]];
+    return [self objectForKey:key ofClass:[NSDictionary class]];
 }
 
 - (NSData *)dataForKey:(NSString *)key {
-    return [self.defaults dataForKey:[self prefixKey:key]];
+    return [self objectForKey:key ofClass:[NSData class]];
 }
 
 - (NSArray *)stringArrayForKey:(NSString *)key {
-    return [self.defaults stringArrayForKey:[self prefixKey:key]];
+    NSArray *array = [self arrayForKey:key];
+    for (id value in array) {
+        if (![value isKindOfClass:[NSString class]]) {
+            return nil;
+        }
+    }
+    return array;
+}
+
+- (nullable id)numericValueForKey:(NSString *)key {
+    id value = [self cachedObjectForKey:key];
+    if ([value isKindOfClass:[NSNumber class]] || [value isKindOfClass:[NSString class]]) {
+        return value;
+    }
+    return nil;
 }
 
 - (NSInteger)integerForKey:(NSString *)key {
-    return [self.defaults integerForKey:[self prefixKey:key]];
+    return [[self numericValueForKey:key] integerValue];
 }
 
 - (float)floatForKey:(NSString *)key {
-    return [self.defaults floatForKey:[self prefixKey:key]];
+    return [[self numericValueForKey:key] floatValue];
 }
 
 - (double)doubleForKey:(NSString *)key {
-    return [self.defaults doubleForKey:[self prefixKey:key]];
+    return [[self numericValueForKey:key] doubleValue];
 }
 
 - (double)doubleForKey:(NSString *)key defaultValue:(double)defaultValue {
@@ -82,7 +318,7 @@
 }
 
 - (BOOL)boolForKey:(NSString *)key {
-    return [self.defaults boolForKey:[self prefixKey:key]];
+    return [[self numericValueForKey:key] boolValue];
 }
 
 - (BOOL)boolForKey:(NSString *)key defaultValue:(BOOL)defaultValue {
@@ -94,31 +330,43 @@
 }
 
 - (NSURL *)URLForKey:(NSString *)key {
-    return [self.defaults URLForKey:[self prefixKey:key]];
+    id value = [self cachedObjectForKey:key];
+
+    // Stored archived, matching -[NSUserDefaults setURL:forKey:]
+    if ([value isKindOfClass:[NSData class]]) {
+        id url = [NSKeyedUnarchiver unarchiveObjectWithData:value];
+        return [url isKindOfClass:[NSURL class]] ? url : nil;
+    }
+
+    if ([value isKindOfClass:[NSString class]]) {
+        return [NSURL fileURLWithPath:[value stringByExpandingTildeInPath]];
+    }
+
+    return nil;
 }
 
 - (void)setInteger:(NSInteger)value forKey:(NSString *)key {
-    [self.defaults setInteger:value forKey:[self prefixKey:key]];
+    [self cacheObject:@(value) forKey:key];
 }
 
 - (void)setFloat:(float)value forKey:(NSString *)key {
-    [self.defaults setFloat:value forKey:[self prefixKey:key]];
+    [self cacheObject:@(value) forKey:key];
 }
 
 - (void)setDouble:(double)value forKey:(NSString *)key {
-    [self.defaults setDouble:value forKey:[self prefixKey:key]];
+    [self cacheObject:@(value) forKey:key];
 }
 
 - (void)setBool:(BOOL)value forKey:(NSString *)key {
-    [self.defaults setBool:value forKey:[self prefixKey:key]];
+    [self cacheObject:@(value) forKey:key];
 }
 
 - (void)setURL:(NSURL *)value forKey:(NSString *)key {
-    [self.defaults setURL:value forKey:[self prefixKey:key]];
+    [self cacheObject:value ? [NSKeyedArchiver archivedDataWithRootObject:value] : nil forKey:key];
 }
 
 - (void)setObject:(id)value forKey:(NSString *)key {
-    [self.defaults setObject:value forKey:[self prefixKey:key]];
+    [self cacheObject:value forKey:key];
 }
 
 - (void)migrateUnprefixedKeys:(NSArray *)keys {
@@ -126,18 +374,34 @@
     for (NSString *key in keys) {
         id value = [self.defaults objectForKey:key];
         if (value) {
-            [self.defaults setValue:value forKey:[self prefixKey:key]];
+            [self cacheObject:value forKey:key];
             [self.defaults removeObjectForKey:key];
         }
     }
 }
 
 - (void)removeAll {
-    for (NSString *key in [[self.defaults dictionaryRepresentation] allKeys]) {
-        if ([key hasPrefix:self.keyPrefix]) {
-            [self.defaults removeObjectForKey:key];
+    @synchronized ([UAPreferenceDataStore class]) {
+        for (NSMutableDictionary *values in @[cachedValues, pendingWrites]) {
+            for (NSString *key in values.allKeys) {
+                if ([key hasPrefix:self.keyPrefix]) {
+                    [values removeObjectForKey:key];
+                }
+            }
         }
     }
+
+    if (![self isMigrated]) {
+        for (NSString *key in [[self.defaults dictionaryRepresentation] allKeys]) {
+            if ([key hasPrefix:self.keyPrefix]) {
+                [self.defaults removeObjectForKey:key];
+            }
+        }
+    }
+
+#if !TARGET_OS_TV
+    [[UAPreferenceDatabase sharedDatabase] removeValuesWithPrefix:self.keyPrefix];
+#endif
 }
 
 @end
@@ -0,0 +1,74 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * SQLite backed key-value storage for preference data stores, kept apart from the app's
+ * NSUserDefaults. Values must be property list objects. This class is thread-safe.
+ *
+ * Not used on tvOS, which does not keep local storage between launches.
+ */
+@interface UAPreferenceDatabase : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Preference Database Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * The shared database, stored in the application support directory.
+ */
++ (instancetype)sharedDatabase;
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param path The database path.
+ */
++ (instancetype)databaseWithPath:(NSString *)path;
+
+/**
+ * Loads all values.
+ *
+ * @return The stored values, or `nil` if the database could not be opened.
+ */
+- (nullable NSDictionary<NSString *, id> *)loadValues;
+
+/**
+ * Writes values in a single transaction.
+ *
+ * @param values The values to write. `NSNull` removes the key.
+ * @return `YES` if the values were written, otherwise `NO`.
+ */
+- (BOOL)writeValues:(NSDictionary<NSString *, id> *)values;
+
+/**
+ * Removes all values for keys that start with the prefix.
+ *
+ * @param prefix The key prefix.
+ * @return `YES` if the values were removed, otherwise `NO`.
+ */
+- (BOOL)removeValuesWithPrefix:(NSString *)prefix;
+
+/**
+ * Checks if values for a key prefix have been migrated into the database.
+ *
+ * @param prefix The key prefix.
+ * @return `YES` if the prefix has been migrated, otherwise `NO`.
+ */
+- (BOOL)hasMigratedPrefix:(NSString *)prefix;
+
+/**
+ * Writes migrated values and marks the key prefix as migrated in a single transaction. Values
+ * for keys that are already stored are not migrated.
+ *
+ * @param values The migrated values.
+ * @param prefix The key prefix.
+ * @return `YES` if the values were written, otherwise `NO`.
+ */
+- (BOOL)migrateValues:(NSDictionary<NSString *, id> *)values prefix:(NSString *)prefix;
+
+@end
+
+NS_ASSUME_NONNULL_END
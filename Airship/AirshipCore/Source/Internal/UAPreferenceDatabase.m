@@ -0,0 +1,202 @@
+/* Copyright Airship and Contributors */
+
+#import "UAPreferenceDatabase+Internal.h"
+#import "UASQLite+Internal.h"
+#import "UAGlobal.h"
+
+static NSString * const UAPreferenceDatabaseDirectory = @"com.urbanairship";
+static NSString * const UAPreferenceDatabaseFileName = @"Preferences.sqlite";
+
+@interface UAPreferenceDatabase ()
+@property (nonatomic, copy) NSString *path;
+@property (nonatomic, strong, nullable) UASQLite *db;
+@end
+
+@implementation UAPreferenceDatabase
+
+- (instancetype)initWithPath:(NSString *)path {
+    self = [super init];
+
+    if (self) {
+        self.path = path;
+    }
+
+    return self;
+}
+
++ (instancetype)sharedDatabase {
+    static UAPreferenceDatabase *sharedDatabase;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSURL *supportURL = [[[NSFileManager defaultManager] URLsForDirectory:NSApplicationSupportDirectory inDomains:NSUserDomainMask] lastObject];
+        NSURL *directoryURL = [supportURL URLByAppendingPathComponent:UAPreferenceDatabaseDirectory];
+        sharedDatabase = [self databaseWithPath:[directoryURL URLByAppendingPathComponent:UAPreferenceDatabaseFileName].path];
+    });
+
+    return sharedDatabase;
+}
+
++ (instancetype)databaseWithPath:(NSString *)path {
+    return [[self alloc] initWithPath:path];
+}
+
+/**
+ * Opens the database, creating the tables on first use. Opening can fail while protected
+ * data is unavailable, so every operation calls this first.
+ */
+- (BOOL)openDatabaseIfNeeded {
+    if (self.db) {
+        return YES;
+    }
+
+    NSError *error;
+    NSString *directory = [self.path stringByDeletingLastPathComponent];
+    if (![[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:&error]) {
+        UA_LERR(@"Failed to create preference database directory: %@", error);
+        return NO;
+    }
+
+    UASQLite *db = [[UASQLite alloc] init];
+    if (![db open:self.path]) {
+        UA_LERR(@"Failed to open preference database: %@", [db lastErrorMessage]);
+        return NO;
+    }
+
+    // Write-ahead logging avoids rewriting the database file on every commit, and with it
+    // normal syncing can only lose the latest commits on power loss, never corrupt the store
+    [db enableWriteAheadLogging];
+    [db setSynchronousMode:UASQLiteSynchronousModeNormal];
+
+    if (![db executeUpdate:@"CREATE TABLE IF NOT EXISTS preferences (key TEXT PRIMARY KEY, value BLOB NOT NULL)"] ||
+        ![db executeUpdate:@"CREATE TABLE IF NOT EXISTS migrated_prefixes (prefix TEXT PRIMARY KEY)"]) {
+        UA_LERR(@"Failed to create preference tables: %@", [db lastErrorMessage]);
+        [db close];
+        return NO;
+    }
+
+    self.db = db;
+    return YES;
+}
+
+- (nullable NSDictionary<NSString *, id> *)loadValues {
+    @synchronized (self) {
+        if (![self openDatabaseIfNeeded]) {
+            return nil;
+        }
+
+        NSArray *rows = [self.db executeQuery:@"SELECT key, value FROM preferences"];
+        if (!rows) {
+            UA_LERR(@"Failed to load preferences: %@", [self.db lastErrorMessage]);
+            return nil;
+        }
+
+        NSMutableDictionary *values = [NSMutableDictionary dictionaryWithCapacity:rows.count];
+        for (NSDictionary *row in rows) {
+            id value = [NSPropertyListSerialization propertyListWithData:row[@"value"]
+                                                                 options:NSPropertyListImmutable
+                                                                  format:nil
+                                                                   error:nil];
+            if (value) {
+                values[row[@"key"]] = value;
+            }
+        }
+
+        return values;
+    }
+}
+
+- (BOOL)writeValues:(NSDictionary<NSString *, id> *)values {
+    @synchronized (self) {
+        if (![self openDatabaseIfNeeded]) {
+            return NO;
+        }
+
+        [self.db beginTransaction];
+        if (![self writeValuesInTransaction:values replace:YES]) {
+            UA_LERR(@"Failed to write preferences: %@", [self.db lastErrorMessage]);
+            [self.db rollback];
+            return NO;
+        }
+
+        return [self.db commit];
+    }
+}
+
+/**
+ * Writes values in the open transaction.
+ *
+ * @param values The values to write. `NSNull` removes the key.
+ * @param replace Whether values replace existing rows, otherwise existing rows are kept.
+ */
+- (BOOL)writeValuesInTransaction:(NSDictionary<NSString *, id> *)values replace:(BOOL)replace {
+    NSString *insert = replace ? @"INSERT OR REPLACE INTO preferences (key, value) VALUES (?, ?)" : @"INSERT OR IGNORE INTO preferences (key, value) VALUES (?, ?)";
+
+    for (NSString *key in values) {
+        id value = values[key];
+
+        if (value == [NSNull null]) {
+            if (![self.db executeUpdate:@"DELETE FROM preferences WHERE key = ?", key]) {
+                return NO;
+            }
+            continue;
+        }
+
+        NSError *error;
+        NSData *data = [NSPropertyListSerialization dataWithPropertyList:value
+                                                                  format:NSPropertyListBinaryFormat_v1_0
+                                                                 options:0
+                                                                   error:&error];
+        if (!data) {
+            UA_LERR(@"Unable to store non-property list value for key %@: %@", key, error);
+            continue;
+        }
+
+        if (![self.db executeUpdate:insert, key, data]) {
+            return NO;
+        }
+    }
+
+    return YES;
+}
+
+- (BOOL)removeValuesWithPrefix:(NSString *)prefix {
+    @synchronized (self) {
+        if (![self openDatabaseIfNeeded]) {
+            return NO;
+        }
+
+        // substr instead of LIKE, prefixes may contain wildcard characters
+        return [self.db executeUpdate:@"DELETE FROM preferences WHERE substr(key, 1, ?) = ?", @(prefix.length), prefix];
+    }
+}
+
+- (BOOL)hasMigratedPrefix:(NSString *)prefix {
+    @synchronized (self) {
+        if (![self openDatabaseIfNeeded]) {
+            return NO;
+        }
+
+        return [self.db executeQuery:@"SELECT prefix FROM migrated_prefixes WHERE prefix = ?", prefix].count > 0;
+    }
+}
+
+- (BOOL)migrateValues:(NSDictionary<NSString *, id> *)values prefix:(NSString *)prefix {
+    @synchronized (self) {
+        if (![self openDatabaseIfNeeded]) {
+            return NO;
+        }
+
+        [self.db beginTransaction];
+        // Rows written since the migration was attempted are newer than the migrated values
+        if (![self writeValuesInTransaction:values replace:NO] ||
+            ![self.db executeUpdate:@"INSERT OR REPLACE INTO migrated_prefixes (prefix) VALUES (?)", prefix]) {
+            UA_LERR(@"Failed to migrate preferences: %@", [self.db lastErrorMessage]);
+            [self.db rollback];
+            return NO;
+        }
+
+        return [self.db commit];
+    }
+}
+
+@end
@@ -72,6 +72,13 @@ NSString *const UAForegroundPresentationkey = @"foreground_presentation";
 @property (nonatomic, strong) UARuntimeConfig *config;
 @property (nonatomic, strong) UAChannel<UAExtendableChannelRegistration> *channel;
 @property (nonatomic, strong) UAAppStateTracker *appStateTracker;
+
+/**
+ * The last combined categories and the default categories they were built from. Cleared
+ * whenever the custom or Accengage categories change.
+ */
+@property (nonatomic, copy, nullable) NSSet<UANotificationCategory *> *cachedCombinedCategories;
+@property (nonatomic, strong, nullable) NSSet<UANotificationCategory *> *cachedDefaultCategories;
 @end
 
 @implementation UAPush
@@ -400,7 +407,36 @@ NSString *const UAForegroundPresentationkey = @"foreground_presentation";
 }
 
 - (void)setCustomCategories:(NSSet<UANotificationCategory *> *)categories {
-    _customCategories = [categories filteredSetUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(id evaluatedObject, NSDictionary *bindings) {
+    @synchronized (self) {
+        _customCategories = [self filteredCustomCategories:categories];
+        self.cachedCombinedCategories = nil;
+    }
+
+    self.shouldUpdateAPNSRegistration = YES;
+}
+
+- (void)addCustomCategories:(NSSet<UANotificationCategory *> *)categories {
+    @synchronized (self) {
+        NSSet *added = [self filteredCustomCategories:categories];
+        NSSet *addedIdentifiers = [added valueForKey:@"identifier"];
+
+        // Added categories replace existing categories with the same identifier
+        NSMutableSet *merged = [NSMutableSet setWithSet:added];
+        for (UANotificationCategory *category in _customCategories) {
+            if (![addedIdentifiers containsObject:category.identifier]) {
+                [merged addObject:category];
+            }
+        }
+
+        _customCategories = [merged copy];
+        self.cachedCombinedCategories = nil;
+    }
+
+    self.shouldUpdateAPNSRegistration = YES;
+}
+
+- (NSSet<UANotificationCategory *> *)filteredCustomCategories:(NSSet<UANotificationCategory *> *)categories {
+    return [categories filteredSetUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(id evaluatedObject, NSDictionary *bindings) {
         UANotificationCategory *category = evaluatedObject;
         if ([category.identifier hasPrefix:@"ua_"]) {
             UA_LWARN(@"Ignoring category %@, only Airship notification categories are allowed to have prefix ua_.", category.identifier);
@@ -409,8 +445,13 @@ NSString *const UAForegroundPresentationkey = @"foreground_presentation";
 
         return YES;
     }]];
+}
 
-    self.shouldUpdateAPNSRegistration = YES;
+- (void)setAccengageCategories:(NSSet<UANotificationCategory *> *)accengageCategories {
+    @synchronized (self) {
+        _accengageCategories = [accengageCategories copy];
+        self.cachedCombinedCategories = nil;
+    }
 }
 
 - (void)setRequireAuthorizationForDefaultCategories:(BOOL)requireAuthorizationForDefaultCategories {
@@ -419,10 +460,20 @@ NSString *const UAForegroundPresentationkey = @"foreground_presentation";
 }
 
 - (NSSet<UANotificationCategory *> *)combinedCategories {
-    NSMutableSet *categories = [NSMutableSet setWithSet:[UANotificationCategories defaultCategoriesWithRequireAuth:self.requireAuthorizationForDefaultCategories]];
-    [categories unionSet:self.customCategories];
-    [categories unionSet:self.accengageCategories];
-    return categories;
+    // The default categories are cached, so the same instance means nothing needs rebuilding
+    NSSet *defaultCategories = [UANotificationCategories defaultCategoriesWithRequireAuth:self.requireAuthorizationForDefaultCategories];
+
+    @synchronized (self) {
+        if (!self.cachedCombinedCategories || self.cachedDefaultCategories != defaultCategories) {
+            NSMutableSet *categories = [NSMutableSet setWithSet:defaultCategories];
+            [categories unionSet:self.customCategories];
+            [categories unionSet:self.accengageCategories];
+            self.cachedCombinedCategories = categories;
+            self.cachedDefaultCategories = defaultCategories;
+        }
+
+        return self.cachedCombinedCategories;
+    }
 }
 
 - (NSDictionary *)quietTime {
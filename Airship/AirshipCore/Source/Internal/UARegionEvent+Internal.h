@@ -60,6 +60,15 @@ extern NSString * const UARegionBoundaryEventExitValue;
  */
 + (BOOL)regionEventCharacterCountIsValid:(nullable NSString *)string;
 
+/**
+ * Coalesces a burst of region events. An enter and exit for the same region cancel each
+ * other out, and repeated boundary events for a region are dropped. Order is preserved.
+ *
+ * @param events The region events, oldest first.
+ * @return The coalesced region events.
+ */
++ (NSArray<UARegionEvent *> *)coalescedRegionEvents:(NSArray<UARegionEvent *> *)events;
+
 
 @end
 
@@ -6,6 +6,11 @@
 #import "UACircularRegion+Internal.h"
 #import "UAGlobal.h"
 
+@interface UARegionEvent ()
+@property (nonatomic, copy, nullable) NSDictionary *cachedData;
+@property (nonatomic, copy, nullable) NSDictionary *cachedPayload;
+@end
+
 @implementation UARegionEvent
 
 static NSString * const UARegionEventType = @"region_event";
@@ -71,7 +76,42 @@ NSString * const UACircularRegionRadiusKey = @"radius";
     return regionEvent;
 }
 
+- (void)setProximityRegion:(UAProximityRegion *)proximityRegion {
+    @synchronized (self) {
+        _proximityRegion = proximityRegion;
+        self.cachedData = nil;
+        self.cachedPayload = nil;
+    }
+}
+
+- (void)setCircularRegion:(UACircularRegion *)circularRegion {
+    @synchronized (self) {
+        _circularRegion = circularRegion;
+        self.cachedData = nil;
+        self.cachedPayload = nil;
+    }
+}
+
+// The data and payload are built once, region events are read by both analytics and automation
 - (NSDictionary *)data {
+    @synchronized (self) {
+        if (!self.cachedData) {
+            self.cachedData = [self buildData];
+        }
+        return self.cachedData;
+    }
+}
+
+- (NSDictionary *)payload {
+    @synchronized (self) {
+        if (!self.cachedPayload) {
+            self.cachedPayload = [self buildPayload];
+        }
+        return self.cachedPayload;
+    }
+}
+
+- (NSDictionary *)buildData {
     NSMutableDictionary *dictionary = [NSMutableDictionary dictionary];
     NSMutableDictionary *proximityDictionary;
     NSMutableDictionary *circularRegionDictionary;;
@@ -120,7 +160,7 @@ NSString * const UACircularRegionRadiusKey = @"radius";
 }
 
 
-- (NSDictionary *)payload {
+- (NSDictionary *)buildPayload {
     /*
      * We are unable to use the event.data for automation because we modify some
      * values to be stringified versions before we store the event to be sent to
@@ -205,6 +245,26 @@ NSString * const UACircularRegionRadiusKey = @"radius";
     return YES;
 }
 
++ (NSArray<UARegionEvent *> *)coalescedRegionEvents:(NSArray<UARegionEvent *> *)events {
+    NSMutableArray<UARegionEvent *> *coalesced = [NSMutableArray arrayWithCapacity:events.count];
+    NSMutableDictionary<NSString *, UARegionEvent *> *lastEvents = [NSMutableDictionary dictionary];
+
+    for (UARegionEvent *event in events) {
+        UARegionEvent *lastEvent = lastEvents[event.regionID];
+
+        if (!lastEvent) {
+            [coalesced addObject:event];
+            lastEvents[event.regionID] = event;
+        } else if (lastEvent.boundaryEvent != event.boundaryEvent) {
+            // Flapping across the boundary, neither crossing happened as far as anyone cares
+            [coalesced removeObjectIdenticalTo:lastEvent];
+            [lastEvents removeObjectForKey:event.regionID];
+        }
+    }
+
+    return [coalesced copy];
+}
+
 + (BOOL)regionEventCharacterCountIsValid:(NSString *)string {
     if (!string || string.length > UARegionEventMaxCharacters || string.length < UARegionEventMinCharacters) {
         return NO;
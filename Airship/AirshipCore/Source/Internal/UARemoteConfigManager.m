@@ -20,6 +20,10 @@ NSString * const UARemoteConfigDisableKey = @"disable_features";
 @property (nonatomic, strong) UARemoteConfigModuleAdapter *moduleAdapter;
 @property (nonatomic, strong) UARemoteDataManager *remoteDataManager;
 @property (nonatomic, strong) UAApplicationMetrics *applicationMetrics;
+
+// Last applied state per module, so unchanged modules are not pushed to their components again
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *moduleEnabledStates;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSData *> *moduleConfigFingerprints;
 @end
 
 @implementation UARemoteConfigManager
@@ -52,6 +56,8 @@ NSString * const UARemoteConfigDisableKey = @"disable_features";
         self.remoteDataManager = remoteDataManager;
         self.applicationMetrics = applicationMetrics;
         self.moduleAdapter = moduleAdapter;
+        self.moduleEnabledStates = [NSMutableDictionary dictionary];
+        self.moduleConfigFingerprints = [NSMutableDictionary dictionary];
 
         self.remoteDataSubscription = [remoteDataManager subscribeWithTypes:@[UAAppConfigCommon, UAAppConfigIOS]
                                                                                block:^(NSArray<UARemoteDataPayload *> *remoteConfig) {
@@ -120,26 +126,61 @@ NSString * const UARemoteConfigDisableKey = @"disable_features";
 
     // Disable modules
     for (NSString *moduleID in disableModuleNames) {
-        [self.moduleAdapter setComponentsEnabled:NO forModuleName:moduleID];
+        [self setComponentsEnabled:NO forModuleName:moduleID];
     }
 
     // Enable modules
     NSMutableSet<NSString *> *enableModulesNames = [NSMutableSet setWithArray:kUARemoteConfigModuleAllModules];
     [enableModulesNames minusSet:disableModuleNames];
     for (NSString *moduleID in enableModulesNames) {
-        [self.moduleAdapter setComponentsEnabled:YES forModuleName:moduleID];
+        [self setComponentsEnabled:YES forModuleName:moduleID];
     }
 
     // Update remote data refresh interval
     self.remoteDataManager.remoteDataRefreshInterval = remoteDataRefreshInterval;
 }
 
+- (void)setComponentsEnabled:(BOOL)enabled forModuleName:(NSString *)moduleName {
+    NSNumber *state = @(enabled);
+    if ([self.moduleEnabledStates[moduleName] isEqual:state]) {
+        return;
+    }
+
+    self.moduleEnabledStates[moduleName] = state;
+    [self.moduleAdapter setComponentsEnabled:enabled forModuleName:moduleName];
+}
+
 - (void)applyConfigsFromRemoteData:(NSDictionary *)data {
     for (NSString *moduleName in kUARemoteConfigModuleAllModules) {
-        [self.moduleAdapter applyConfig:data[moduleName] forModuleName:moduleName];
+        id config = data[moduleName];
+        NSData *fingerprint = [UARemoteConfigManager fingerprintForConfig:config];
+
+        // Configs that can't be fingerprinted are always applied
+        if (fingerprint && [self.moduleConfigFingerprints[moduleName] isEqual:fingerprint]) {
+            continue;
+        }
+
+        [self.moduleAdapter applyConfig:config forModuleName:moduleName];
+        self.moduleConfigFingerprints[moduleName] = fingerprint;
     }
 }
 
+/**
+ * Returns a stable fingerprint for a module config, the JSON serialization with sorted keys.
+ *
+ * @param config The module config.
+ * @return The fingerprint, or nil if the config is not valid JSON.
+ */
++ (nullable NSData *)fingerprintForConfig:(nullable id)config {
+    // Wrapped so configs that are plain strings or numbers serialize too
+    id wrapped = @[config ?: [NSNull null]];
+    if (![NSJSONSerialization isValidJSONObject:wrapped]) {
+        return nil;
+    }
+
+    return [NSJSONSerialization dataWithJSONObject:wrapped options:NSJSONWritingSortedKeys error:nil];
+}
+
 + (NSArray<UARemoteConfigDisableInfo *> *)filterDisableInfos:(NSArray<UARemoteConfigDisableInfo *> *)disableInfos
                                                   sdkVersion:(NSString *)sdkVersion
                                                   appVersion:(NSString *)appVersion {
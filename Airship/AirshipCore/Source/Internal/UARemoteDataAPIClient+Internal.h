@@ -29,6 +29,12 @@ typedef NS_ENUM(NSInteger, UARemoteDataAPIClientError) {
  */
 extern NSString * const UARemoteDataAPIClientErrorDomain;
 
+/**
+ * Error user info key for the number of seconds the server asked the client to wait
+ * before the next request, from the `Retry-After` header.
+ */
+extern NSString * const UARemoteDataAPIClientRetryAfterKey;
+
 @interface UARemoteDataAPIClient : UAAPIClient
 
 ///---------------------------------------------------------------------------------------
@@ -75,6 +81,28 @@ extern NSString * const UARemoteDataAPIClientErrorDomain;
  */
 - (void)clearLastModifiedTime;
 
+/**
+ * The max age in seconds from the `Cache-Control` header of the last response, or
+ * 0 if the response did not allow caching.
+ */
+@property (nonatomic, readonly) NSTimeInterval cacheMaxAge;
+
+/**
+ * Returns the max age from a response's `Cache-Control` header.
+ *
+ * @param response The response.
+ * @return The max age in seconds, or 0 if the response did not allow caching.
+ */
++ (NSTimeInterval)cacheMaxAgeForResponse:(NSHTTPURLResponse *)response;
+
+/**
+ * Returns the delay from a response's `Retry-After` header.
+ *
+ * @param response The response.
+ * @return The delay in seconds, or 0 if the response did not have a valid header.
+ */
++ (NSTimeInterval)retryAfterForResponse:(NSURLResponse *)response;
+
 @end
 
 NS_ASSUME_NONNULL_END
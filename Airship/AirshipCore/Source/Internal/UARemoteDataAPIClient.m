@@ -7,6 +7,7 @@
 #import "NSURLResponse+UAAdditions.h"
 #import "UAirshipVersion.h"
 #import "UAirship.h"
+#import "UAMetricsRegistry.h"
 
 @interface UARemoteDataAPIClient()
 @property (nonatomic, strong) UAPreferenceDataStore *dataStore;
@@ -17,8 +18,13 @@
 
 NSString * const kRemoteDataPath = @"api/remote-data/app";
 NSString * const kUALastRemoteDataModifiedTime = @"UALastRemoteDataModifiedTime";
+NSString * const kUARemoteDataCacheMaxAge = @"UARemoteDataCacheMaxAge";
+
+// Server provided refresh delays are capped so a bad header can't disable refreshes
+static NSTimeInterval const UARemoteDataAPIClientMaxRefreshDelay = 24 * 60 * 60;
 
 NSString * const UARemoteDataAPIClientErrorDomain = @"com.urbanairship.remote_data_api_client";
+NSString * const UARemoteDataAPIClientRetryAfterKey = @"com.urbanairship.remote_data_api_client.retry_after";
 
 - (UARemoteDataAPIClient *)initWithConfig:(UARuntimeConfig *)config
                                 dataStore:(UAPreferenceDataStore *)dataStore
@@ -64,7 +70,8 @@ NSString * const UARemoteDataAPIClientErrorDomain = @"com.urbanairship.remote_da
     }];
 
     [self.session dataTaskWithRequest:refreshRequest retryWhere:^BOOL(NSData * _Nullable data, NSURLResponse * _Nullable response) {
-        return [response hasRetriableStatus];
+        // Let the caller wait out a Retry-After instead of retrying on the session's backoff
+        return [response hasRetriableStatus] && ![UARemoteDataAPIClient retryAfterForResponse:response];
     } completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
         if (![response isKindOfClass:[NSHTTPURLResponse class]]) {
             refreshCompletionHandler(nil, error);
@@ -76,10 +83,12 @@ NSString * const UARemoteDataAPIClientErrorDomain = @"com.urbanairship.remote_da
         // Failure
         if (httpResponse.statusCode != 200  && httpResponse.statusCode != 304) {
             [UAUtils logFailedRequest:refreshRequest withMessage:@"Refresh remote data failed" withError:error withResponse:httpResponse];
-            refreshCompletionHandler(nil, [self unsuccessfulStatusError]);
+            refreshCompletionHandler(nil, [self unsuccessfulStatusErrorWithRetryAfter:[UARemoteDataAPIClient retryAfterForResponse:httpResponse]]);
             return;
         }
-        
+
+        [self.dataStore setDouble:[UARemoteDataAPIClient cacheMaxAgeForResponse:httpResponse] forKey:kUARemoteDataCacheMaxAge];
+
         // 304, no changes
         if (httpResponse.statusCode == 304) {
             refreshCompletionHandler(nil, nil);
@@ -96,13 +105,15 @@ NSString * const UARemoteDataAPIClientErrorDomain = @"com.urbanairship.remote_da
         }
         
         // Success
+        [[UAMetricsRegistry shared] incrementCounter:UAMetricRemoteDataBytes by:data.length];
+
         NSDictionary *headers = httpResponse.allHeaderFields;
         NSString *lastModified = [headers objectForKey:@"Last-Modified"];
         
         // Parse the response
         NSError *parseError;
         NSDictionary *jsonResponse = [NSJSONSerialization JSONObjectWithData:data options:NSJSONReadingAllowFragments error:&parseError];
-        
+
         if (parseError) {
             UA_LERR(@"Unable to parse remote data body: %@ Error: %@", data, parseError);
             refreshCompletionHandler(nil, parseError);
@@ -110,9 +121,9 @@ NSString * const UARemoteDataAPIClientErrorDomain = @"com.urbanairship.remote_da
         }
 
         UA_LTRACE(@"Retrieved remote data with status: %ld jsonResponse: %@", (unsigned long)httpResponse.statusCode, jsonResponse);
-        
+
         NSArray *remoteData = [jsonResponse objectForKey:@"payloads"];
-        
+
         [self.dataStore setValue:lastModified forKey:kUALastRemoteDataModifiedTime];
 
         refreshCompletionHandler(remoteData, nil);
@@ -121,12 +132,83 @@ NSString * const UARemoteDataAPIClientErrorDomain = @"com.urbanairship.remote_da
     return disposable;
 }
 
-- (NSError *)unsuccessfulStatusError {
+- (NSTimeInterval)cacheMaxAge {
+    return [self.dataStore doubleForKey:kUARemoteDataCacheMaxAge];
+}
+
++ (NSTimeInterval)cacheMaxAgeForResponse:(NSHTTPURLResponse *)response {
+    NSString *cacheControl = [UARemoteDataAPIClient headerValue:@"Cache-Control" response:response];
+    if (!cacheControl) {
+        return 0;
+    }
+
+    NSTimeInterval maxAge = 0;
+    for (NSString *component in [cacheControl componentsSeparatedByString:@","]) {
+        NSString *directive = [[component stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]] lowercaseString];
+        if ([directive isEqualToString:@"no-cache"] || [directive isEqualToString:@"no-store"]) {
+            return 0;
+        }
+
+        if ([directive hasPrefix:@"max-age="]) {
+            maxAge = [[directive substringFromIndex:@"max-age=".length] doubleValue];
+        }
+    }
+
+    return MIN(MAX(maxAge, 0), UARemoteDataAPIClientMaxRefreshDelay);
+}
+
++ (NSTimeInterval)retryAfterForResponse:(NSURLResponse *)response {
+    if (![response isKindOfClass:[NSHTTPURLResponse class]]) {
+        return 0;
+    }
+
+    NSString *retryAfter = [UARemoteDataAPIClient headerValue:@"Retry-After" response:(NSHTTPURLResponse *)response];
+    retryAfter = [retryAfter stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceCharacterSet]];
+    if (!retryAfter.length) {
+        return 0;
+    }
+
+    NSTimeInterval delay = 0;
+    NSCharacterSet *nonDigits = [[NSCharacterSet decimalDigitCharacterSet] invertedSet];
+    if ([retryAfter rangeOfCharacterFromSet:nonDigits].location == NSNotFound) {
+        delay = [retryAfter doubleValue];
+    } else {
+        // HTTP date
+        NSDateFormatter *formatter = [[NSDateFormatter alloc] init];
+        formatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+        formatter.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+        formatter.dateFormat = @"EEE, dd MMM yyyy HH:mm:ss zzz";
+        NSDate *date = [formatter dateFromString:retryAfter];
+        delay = date ? [date timeIntervalSinceNow] : 0;
+    }
+
+    return MIN(MAX(delay, 0), UARemoteDataAPIClientMaxRefreshDelay);
+}
+
++ (nullable NSString *)headerValue:(NSString *)name response:(NSHTTPURLResponse *)response {
+    // Header names are case insensitive
+    NSDictionary *headers = response.allHeaderFields;
+    for (NSString *key in headers) {
+        if ([key isKindOfClass:[NSString class]] && [key caseInsensitiveCompare:name] == NSOrderedSame) {
+            id value = headers[key];
+            return [value isKindOfClass:[NSString class]] ? value : nil;
+        }
+    }
+
+    return nil;
+}
+
+- (NSError *)unsuccessfulStatusErrorWithRetryAfter:(NSTimeInterval)retryAfter {
     NSString *msg = [NSString stringWithFormat:@"Remote data client encountered an unsuccessful status"];
 
+    NSMutableDictionary *userInfo = [NSMutableDictionary dictionaryWithObject:msg forKey:NSLocalizedDescriptionKey];
+    if (retryAfter > 0) {
+        userInfo[UARemoteDataAPIClientRetryAfterKey] = @(retryAfter);
+    }
+
     NSError *error = [NSError errorWithDomain:UARemoteDataAPIClientErrorDomain
                                          code:UARemoteDataAPIClientErrorUnsuccessfulStatus
-                                     userInfo:@{NSLocalizedDescriptionKey:msg}];
+                                     userInfo:userInfo];
 
     return error;
 }
@@ -148,6 +230,7 @@ NSString * const UARemoteDataAPIClientErrorDomain = @"com.urbanairship.remote_da
 
         builder.URL = [self createRemoteDataURL:[self.localeManager currentLocale]];
         builder.method = @"GET";
+        builder.trafficClass = UARequestTrafficClassDeferrable;
         
         NSString *lastModified = [self.dataStore stringForKey:kUALastRemoteDataModifiedTime];
         
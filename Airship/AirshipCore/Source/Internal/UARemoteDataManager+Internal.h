@@ -23,7 +23,9 @@ NS_ASSUME_NONNULL_BEGIN
 ///---------------------------------------------------------------------------------------
 
 /**
- * Refresh the remote data from the cloud, with completion handler
+ * Refresh the remote data from the cloud, with completion handler. A refresh requested while
+ * another is in progress joins it instead of making a new request. Refreshes are skipped while
+ * waiting out a `Retry-After` from the server.
  *
  * @param completionHandler Optional completion handler called when refresh is complete, with result.
  */
@@ -51,6 +53,13 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, assign) NSUInteger remoteDataRefreshInterval;
 
+/**
+ * The max amount of time in seconds to wait before refreshing from a refresh push. Each device
+ * waits a fixed fraction of it, which spreads out the requests when the push goes to
+ * a whole audience. Must stay well under the background fetch time limit. Defaults to 15 seconds.
+ */
+@property (nonatomic, assign) NSTimeInterval maxPushRefreshJitter;
+
 /**
  * The metadata used to fetch the most recent payload.
  */
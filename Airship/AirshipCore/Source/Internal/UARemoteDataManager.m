@@ -10,15 +10,25 @@
 #import "UAUtils+Internal.h"
 #import "UAAppStateTracker.h"
 #import "UALocaleManager+Internal.h"
+#import "UAMetricsRegistry.h"
+#import "UAForegroundWorkScheduler.h"
+#import "UANetworkMonitor.h"
 
 NSString * const kUACoreDataStoreName = @"RemoteData-%@.sqlite";
 NSString * const UARemoteDataRefreshIntervalKey = @"remotedata.REFRESH_INTERVAL";
 NSString * const UARemoteDataLastRefreshTimeKey = @"remotedata.LAST_REFRESH_TIME";
 NSString * const UARemoteDataLastRefreshMetadataKey = @"remotedata.LAST_REFRESH_METADATA";
 NSString * const UARemoteDataLastRefreshAppVersionKey = @"remotedata.LAST_REFRESH_APP_VERSION";
+NSString * const UARemoteDataLastPayloadHashesKey = @"remotedata.LAST_PAYLOAD_HASHES";
 NSString * const UARemoteDataRefreshPayloadKey = @"com.urbanairship.remote-data.update";
+NSString * const UARemoteDataRetryAfterDateKey = @"remotedata.RETRY_AFTER_DATE";
+NSString * const UARemoteDataPushRefreshJitterKey = @"remotedata.PUSH_REFRESH_JITTER";
 
 NSInteger const UARemoteDataRefreshIntervalDefault = 0;
+NSTimeInterval const UARemoteDataMaxPushRefreshJitterDefault = 15;
+
+// Minimum refresh interval while Low Data Mode is enabled
+static NSTimeInterval const UARemoteDataLowDataModeRefreshInterval = 3600;
 
 @interface UARemoteDataSubscription : NSObject
 
@@ -84,7 +94,20 @@ NSInteger const UARemoteDataRefreshIntervalDefault = 0;
 @property (nonatomic, strong) NSNotificationCenter *notificationCenter;
 @property (nonatomic, strong) UAAppStateTracker *appStateTracker;
 @property (nonatomic, strong) UALocaleManager *localeManager;
+@property (nonatomic, strong) NSMutableArray<void (^)(BOOL)> *refreshCompletionHandlers;
+@property (nonatomic, copy, nullable) NSDictionary *refreshMetadata;
+@property (nonatomic, assign) BOOL refreshAgain;
 
+/**
+ * Immutable payloads keyed by type, matching what is in the remote data store. Each payload keeps
+ * its own timestamp. `nil` until a refresh stores data or the store is read once on cold start.
+ */
+@property (nonatomic, copy, nullable) NSDictionary<NSString *, NSArray<UARemoteDataPayload *> *> *snapshot;
+
+/**
+ * Subscriptions waiting on the cold start snapshot load. `nil` when no load is in flight.
+ */
+@property (nonatomic, strong, nullable) NSMutableArray<UARemoteDataSubscription *> *snapshotSubscriptions;
 @end
 
 @implementation UARemoteDataManager
@@ -110,11 +133,13 @@ NSInteger const UARemoteDataRefreshIntervalDefault = 0;
         self.remoteDataAPIClient = remoteDataAPIClient;
         self.appStateTracker = appStateTracker;
         self.localeManager = localeManager;
+        self.refreshCompletionHandlers = [NSMutableArray array];
+        self.maxPushRefreshJitter = UARemoteDataMaxPushRefreshJitterDefault;
 
-        // Register for locale change notification
+        // Register for the settled locale and time zone changes
         [self.notificationCenter addObserver:self
                                     selector:@selector(localeRefresh)
-                                        name:UALocaleUpdatedEvent
+                                        name:UADeviceContextChangedEvent
                                       object:nil];
 
         [self.notificationCenter addObserver:self
@@ -122,6 +147,11 @@ NSInteger const UARemoteDataRefreshIntervalDefault = 0;
                                         name:UAApplicationDidTransitionToForeground
                                       object:nil];
 
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(networkConnectivityChanged)
+                                        name:UANetworkConnectivityChangedEvent
+                                      object:nil];
+
         if ([self shouldRefresh]) {
             [self refresh];
         }
@@ -188,6 +218,50 @@ NSInteger const UARemoteDataRefreshIntervalDefault = 0;
     [self.dataStore setObject:metadata forKey:UARemoteDataLastRefreshMetadataKey];
 }
 
+- (nullable NSDictionary<NSString *, NSString *> *)lastPayloadHashes {
+    return [self.dataStore objectForKey:UARemoteDataLastPayloadHashesKey];
+}
+
+- (void)setLastPayloadHashes:(nullable NSDictionary<NSString *, NSString *> *)payloadHashes {
+    if (payloadHashes) {
+        [self.dataStore setObject:payloadHashes forKey:UARemoteDataLastPayloadHashesKey];
+    } else {
+        [self.dataStore removeObjectForKey:UARemoteDataLastPayloadHashesKey];
+    }
+}
+
+/**
+ * Hashes the content of each payload type. A type with multiple payloads gets a single hash.
+ *
+ * @param payloads The payloads.
+ * @return The content hashes by payload type. Types that could not be hashed are omitted.
+ */
+- (NSDictionary<NSString *, NSString *> *)hashesForPayloads:(NSArray<UARemoteDataPayload *> *)payloads {
+    NSMutableDictionary<NSString *, NSMutableArray *> *contentsByType = [NSMutableDictionary dictionary];
+    for (UARemoteDataPayload *payload in payloads) {
+        NSMutableArray *contents = contentsByType[payload.type];
+        if (!contents) {
+            contents = [NSMutableArray array];
+            contentsByType[payload.type] = contents;
+        }
+
+        [contents addObject:@{ @"timestamp" : @(payload.timestamp.timeIntervalSince1970),
+                               @"data" : payload.data ?: @{},
+                               @"metadata" : payload.metadata ?: @{} }];
+    }
+
+    NSMutableDictionary<NSString *, NSString *> *hashes = [NSMutableDictionary dictionary];
+    for (NSString *type in contentsByType) {
+        NSData *json = [NSJSONSerialization dataWithJSONObject:contentsByType[type] options:NSJSONWritingSortedKeys error:nil];
+        NSString *jsonString = json ? [[NSString alloc] initWithData:json encoding:NSUTF8StringEncoding] : nil;
+        if (jsonString) {
+            hashes[type] = [UAUtils sha256HashWithString:jsonString];
+        }
+    }
+
+    return hashes;
+}
+
 - (void)setRemoteDataRefreshInterval:(NSUInteger)remoteDataRefreshInterval {
     // save in the data store
     [self.dataStore setInteger:remoteDataRefreshInterval forKey:UARemoteDataRefreshIntervalKey];
@@ -215,7 +289,7 @@ NSInteger const UARemoteDataRefreshIntervalDefault = 0;
 
 
     // give subscriber any remote data we have already received
-    [self fetchRemoteDataFromCacheAndNotifySubscriber:subscription];
+    [self notifySubscriberFromSnapshot:subscription];
 
     // return subscription object
     return disposable;
@@ -227,8 +301,15 @@ NSInteger const UARemoteDataRefreshIntervalDefault = 0;
 - (void)applicationWillEnterForeground {
     UA_LTRACE(@"Application will enter foreground.");
 
-    // refresh the data from the cloud
-    [self foregroundRefresh];
+    // refresh the data from the cloud once the app has drawn its first frame
+    UA_WEAKIFY(self)
+    [[UAForegroundWorkScheduler shared] scheduleWorkWithName:@"com.urbanairship.remote_data.foreground_refresh"
+                                                    priority:UAForegroundWorkPriorityDefault
+                                                  dispatcher:self.dispatcher
+                                                       block:^{
+        UA_STRONGIFY(self)
+        [self foregroundRefresh];
+    }];
 }
 
 // foregroundRefresh refreshes only if the time since the last refresh is greater than the minimum foreground refresh interval
@@ -236,6 +317,13 @@ NSInteger const UARemoteDataRefreshIntervalDefault = 0;
     [self foregroundRefreshWithCompletionHandler:nil];
 }
 
+- (void)networkConnectivityChanged {
+    // A refresh that failed while offline is retried once the network returns
+    if ([UANetworkMonitor shared].isConnected && [self shouldRefresh]) {
+        [self refresh];
+    }
+}
+
 - (void)localeRefresh {
     if ([self shouldRefresh]) {
         // if app locale has changed, force a refresh
@@ -265,7 +353,19 @@ NSInteger const UARemoteDataRefreshIntervalDefault = 0;
         return false;
     }
 
-    if (self.remoteDataRefreshInterval <= timeSinceLastRefresh) {
+    if ([self isWaitingForRetryAfter]) {
+        return false;
+    }
+
+    // The server may ask for a longer interval than the configured one
+    NSTimeInterval refreshInterval = MAX(self.remoteDataRefreshInterval, self.remoteDataAPIClient.cacheMaxAge);
+
+    // Remote data is deferrable traffic, it refreshes less often while Low Data Mode is enabled
+    if ([UANetworkMonitor shared].isConstrained) {
+        refreshInterval = MAX(refreshInterval, UARemoteDataLowDataModeRefreshInterval);
+    }
+
+    if (refreshInterval <= timeSinceLastRefresh) {
         return true;
     }
 
@@ -287,10 +387,23 @@ completionHandler:(void(^)(BOOL success))completionHandler {
     // The result from this can be empty if any expected fields are missing from JSON
     NSArray<UARemoteDataPayload *> *payloads = [UARemoteDataPayload remoteDataPayloadsFromJSON:remoteData metadata:metadata];
 
+    NSDictionary<NSString *, NSString *> *payloadHashes = [self hashesForPayloads:payloads];
+    NSDictionary<NSString *, NSString *> *lastPayloadHashes = self.lastPayloadHashes;
+
+    // Types that are new, changed or removed since the last refresh
+    NSMutableSet<NSString *> *changedTypes = [NSMutableSet setWithArray:[payloads valueForKey:@"type"]];
+    [changedTypes addObjectsFromArray:lastPayloadHashes.allKeys];
+    for (NSString *type in payloadHashes) {
+        if ([payloadHashes[type] isEqualToString:lastPayloadHashes[type]]) {
+            [changedTypes removeObject:type];
+        }
+    }
+
     UA_WEAKIFY(self);
-    [self.remoteDataStore overwriteCachedRemoteDataWithResponse:payloads completionHandler:^(BOOL success) {
+    void (^storeCompletionHandler)(BOOL) = ^(BOOL success) {
         UA_STRONGIFY(self);
         if (!success) {
+            self.lastPayloadHashes = nil;
             [self.remoteDataAPIClient clearLastModifiedTime];
             if (completionHandler) {
                 completionHandler(NO);
@@ -298,31 +411,89 @@ completionHandler:(void(^)(BOOL success))completionHandler {
             return;
         }
 
+        self.lastPayloadHashes = payloadHashes;
         [self.dataStore setObject:lastModified forKey:UARemoteDataLastRefreshTimeKey];
         self.lastMetadata = metadata;
 
+        // The response holds every type, so it replaces the snapshot whole
+        NSDictionary<NSString *, NSArray<UARemoteDataPayload *> *> *payloadsByType = [UARemoteDataManager indexPayloadsByType:payloads];
+        @synchronized (self) {
+            self.snapshot = payloadsByType;
+        }
+
         // notify remote data subscribers
-        [self notifySubscribersWithRemoteData:payloads completionHandler:^{
+        [self notifySubscribersWithPayloadsByType:payloadsByType changedTypes:changedTypes completionHandler:^{
             if (completionHandler) {
                 completionHandler(YES);
             }
         }];
-    }];
+    };
+
+    if (!lastPayloadHashes) {
+        // Nothing is known about the stored data, replace all of it
+        [self.remoteDataStore overwriteCachedRemoteDataWithResponse:payloads completionHandler:storeCompletionHandler];
+    } else if (changedTypes.count) {
+        NSArray *changedPayloads = [payloads filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"(type IN %@)", changedTypes]];
+        [self.remoteDataStore updateCachedRemoteDataWithPayloads:changedPayloads
+                                                  replacingTypes:changedTypes
+                                               completionHandler:storeCompletionHandler];
+    } else {
+        UA_LTRACE(@"Remote data unchanged");
+        storeCompletionHandler(YES);
+    }
 }
 
 - (void)refreshWithCompletionHandler:(void(^)(BOOL success))completionHandler {
+    NSDictionary *metadata = [self createMetadata:[self.localeManager currentLocale]];
+
+    // Single flight, concurrent refreshes share the in-flight fetch
+    @synchronized (self.refreshCompletionHandlers) {
+        [self.refreshCompletionHandlers addObject:completionHandler ?: ^(BOOL success) {}];
+        if (self.refreshCompletionHandlers.count > 1) {
+            UA_LTRACE(@"Remote data refresh already in progress");
+
+            // The in-flight fetch is for stale metadata, fetch again once it finishes
+            if (![metadata isEqualToDictionary:self.refreshMetadata]) {
+                self.refreshAgain = YES;
+            }
+            return;
+        }
+
+        self.refreshMetadata = metadata;
+    }
+
+    [self fetchRemoteData];
+}
+
+- (void)fetchRemoteData {
+    if ([self isWaitingForRetryAfter]) {
+        UA_LDEBUG(@"Remote data refresh skipped, waiting for retry after");
+        [self finishRefresh:NO];
+        return;
+    }
 
     if (![self isLastMetadataCurrent]) {
         [self.remoteDataAPIClient clearLastModifiedTime];
     }
 
+    NSTimeInterval start = [NSProcessInfo processInfo].systemUptime;
+    void (^recordRefresh)(BOOL) = ^(BOOL success) {
+        UAMetricsRegistry *metrics = [UAMetricsRegistry shared];
+        [[metrics durationHistogramWithName:UAMetricRemoteDataRefreshDuration] recordValue:[NSProcessInfo processInfo].systemUptime - start];
+        [metrics incrementCounter:success ? UAMetricRemoteDataRefreshes : UAMetricRemoteDataRefreshFailures by:1];
+    };
+
     UA_WEAKIFY(self);
     [self.remoteDataAPIClient fetchRemoteData:^(NSArray<NSDictionary *> * _Nullable remoteDatas, NSError * _Nullable error) {
         UA_STRONGIFY(self)
         if (error) {
-            if (completionHandler) {
-                completionHandler(NO);
+            NSNumber *retryAfter = error.userInfo[UARemoteDataAPIClientRetryAfterKey];
+            if (retryAfter) {
+                [self.dataStore setObject:[self.date.now dateByAddingTimeInterval:retryAfter.doubleValue]
+                                   forKey:UARemoteDataRetryAfterDateKey];
             }
+            recordRefresh(NO);
+            [self finishRefresh:NO];
         } else {
             // New remote data
             if (remoteDatas) {
@@ -331,17 +502,55 @@ completionHandler:(void(^)(BOOL success))completionHandler {
 
                 NSDictionary *metadata = [self createMetadata:[self.localeManager currentLocale]];
 
-                [self onNewData:remoteDatas metadata:metadata lastModified:[NSDate date] completionHandler:completionHandler];
+                UA_WEAKIFY(self);
+                [self onNewData:remoteDatas metadata:metadata lastModified:[NSDate date] completionHandler:^(BOOL success) {
+                    UA_STRONGIFY(self)
+                    recordRefresh(success);
+                    [self finishRefresh:success];
+                }];
             } else {
                 // Up to date
-                if (completionHandler) {
-                    completionHandler(YES);
-                }
+                recordRefresh(YES);
+                [self finishRefresh:YES];
             }
         }
     }];
 }
 
+/**
+ * Finishes the in-flight refresh, calling every completion handler that joined it.
+ *
+ * @param success The refresh result.
+ */
+- (void)finishRefresh:(BOOL)success {
+    NSArray<void (^)(BOOL)> *completionHandlers;
+    @synchronized (self.refreshCompletionHandlers) {
+        if (self.refreshAgain) {
+            self.refreshAgain = NO;
+            self.refreshMetadata = [self createMetadata:[self.localeManager currentLocale]];
+            completionHandlers = nil;
+        } else {
+            completionHandlers = [self.refreshCompletionHandlers copy];
+            [self.refreshCompletionHandlers removeAllObjects];
+            self.refreshMetadata = nil;
+        }
+    }
+
+    if (!completionHandlers) {
+        [self fetchRemoteData];
+        return;
+    }
+
+    for (void (^completionHandler)(BOOL) in completionHandlers) {
+        completionHandler(success);
+    }
+}
+
+- (BOOL)isWaitingForRetryAfter {
+    NSDate *retryAfterDate = [self.dataStore objectForKey:UARemoteDataRetryAfterDateKey];
+    return retryAfterDate && [retryAfterDate compare:self.date.now] == NSOrderedDescending;
+}
+
 -(BOOL)isLastAppVersionCurrent {
     NSString *appVersionAtTimeOfLastRefresh = ([self.dataStore objectForKey:UARemoteDataLastRefreshAppVersionKey]);
     NSString *currentAppVersion = [UAUtils bundleShortVersionString];
@@ -379,33 +588,31 @@ completionHandler:(void(^)(BOOL success))completionHandler {
 /**
  * Notifies all subscriptions of new remote data
  *
- * @param remoteDataPayloads Remote data from which to notify subscribers. Data must be filtered for each subscriber.
+ * @param payloadsByType The remote data keyed by type. Subscribers are handed the same immutable slices.
+ * @param changedTypes The payload types that changed. Subscriptions to other types are not notified.
  * @param completionHandler Optional completion handler.
  */
-- (void)notifySubscribersWithRemoteData:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads completionHandler:(void (^)(void))completionHandler {
-    NSArray *subscriptions = [self.subscriptions copy];
+- (void)notifySubscribersWithPayloadsByType:(NSDictionary<NSString *, NSArray<UARemoteDataPayload *> *> *)payloadsByType
+                               changedTypes:(NSSet<NSString *> *)changedTypes
+                          completionHandler:(void (^)(void))completionHandler {
+    NSArray *subscriptions;
+    @synchronized(self.subscriptions) {
+        subscriptions = [self.subscriptions copy];
+    }
 
     dispatch_group_t dispatchGroup = dispatch_group_create();
 
     // notify each subscription
     for (UARemoteDataSubscription *subscription in subscriptions) {
-        dispatch_group_enter(dispatchGroup);
+        if (![changedTypes intersectsSet:[NSSet setWithArray:subscription.payloadTypes]]) {
+            continue;
+        }
 
-        NSPredicate *predicate = [NSPredicate predicateWithFormat:@"(type IN %@)", subscription.payloadTypes];
-        NSArray *filteredPayloads = [remoteDataPayloads filteredArrayUsingPredicate:predicate];
+        NSArray<UARemoteDataPayload *> *payloads = [UARemoteDataManager payloadsForTypes:subscription.payloadTypes
+                                                                          payloadsByType:payloadsByType];
 
-        NSArray *sorted = [filteredPayloads sortedArrayUsingComparator:^NSComparisonResult(id  _Nonnull obj1, id  _Nonnull obj2) {
-            UARemoteDataPayload *payload1 = (UARemoteDataPayload *)obj1;
-            UARemoteDataPayload *payload2 = (UARemoteDataPayload *)obj2;
-            NSUInteger indexObj1 = [subscription.payloadTypes indexOfObject:payload1.type];
-            NSUInteger indexObj2 = [subscription.payloadTypes indexOfObject:payload2.type];
-            if (indexObj1 == indexObj2) {
-                return NSOrderedSame;
-            }
-            return indexObj1 > indexObj2 ? NSOrderedDescending : NSOrderedAscending;
-        }];
-
-        [subscription notifyRemoteData:sorted dispatcher:self.dispatcher completionHandler:^{
+        dispatch_group_enter(dispatchGroup);
+        [subscription notifyRemoteData:payloads dispatcher:self.dispatcher completionHandler:^{
             dispatch_group_leave(dispatchGroup);
         }];
     }
@@ -419,17 +626,95 @@ completionHandler:(void(^)(BOOL success))completionHandler {
 }
 
 /**
- * Notifies a single remote data subscriber by prefetching on the private
- * context and then notifying on the main context.
+ * Groups payloads by type, keeping their order.
+ *
+ * @param payloads The payloads.
+ * @return Immutable arrays of payloads keyed by type.
+ */
++ (NSDictionary<NSString *, NSArray<UARemoteDataPayload *> *> *)indexPayloadsByType:(NSArray<UARemoteDataPayload *> *)payloads {
+    NSMutableDictionary<NSString *, NSMutableArray<UARemoteDataPayload *> *> *mutableIndex = [NSMutableDictionary dictionary];
+    for (UARemoteDataPayload *payload in payloads) {
+        NSMutableArray *typePayloads = mutableIndex[payload.type];
+        if (!typePayloads) {
+            typePayloads = [NSMutableArray array];
+            mutableIndex[payload.type] = typePayloads;
+        }
+        [typePayloads addObject:payload];
+    }
+
+    NSMutableDictionary<NSString *, NSArray<UARemoteDataPayload *> *> *index = [NSMutableDictionary dictionaryWithCapacity:mutableIndex.count];
+    for (NSString *type in mutableIndex) {
+        index[type] = [mutableIndex[type] copy];
+    }
+
+    return index;
+}
+
+/**
+ * Gets the payloads for a subscription's types, in the order of the types.
+ *
+ * @param types The subscription's payload types.
+ * @param payloadsByType The payloads keyed by type.
+ * @return The payloads. A subscription to a single type gets the indexed array without a copy.
+ */
++ (NSArray<UARemoteDataPayload *> *)payloadsForTypes:(NSArray<NSString *> *)types
+                                     payloadsByType:(NSDictionary<NSString *, NSArray<UARemoteDataPayload *> *> *)payloadsByType {
+    if (types.count == 1) {
+        return payloadsByType[types.firstObject] ?: @[];
+    }
+
+    NSMutableArray<UARemoteDataPayload *> *payloads = [NSMutableArray array];
+    for (NSString *type in types) {
+        NSArray *typePayloads = payloadsByType[type];
+        if (typePayloads) {
+            [payloads addObjectsFromArray:typePayloads];
+        }
+    }
+
+    return payloads;
+}
+
+/**
+ * Notifies a new subscriber with the remote data already received. Served from the snapshot,
+ * so the store is only read the first time.
  *
  * @param subscription The subscriber's subscription
  */
-- (void)fetchRemoteDataFromCacheAndNotifySubscriber:(UARemoteDataSubscription *)subscription {
-    // only send remote data newer than cached last modified timestamps
-    NSPredicate *fetchPredicate = [NSPredicate predicateWithFormat:@"(type IN %@)", subscription.payloadTypes];
+- (void)notifySubscriberFromSnapshot:(UARemoteDataSubscription *)subscription {
+    NSDictionary<NSString *, NSArray<UARemoteDataPayload *> *> *snapshot;
+    @synchronized (self) {
+        snapshot = self.snapshot;
+        if (!snapshot) {
+            // Subscribers that attach during the load wait for it instead of starting their own
+            BOOL loading = self.snapshotSubscriptions != nil;
+            if (!loading) {
+                self.snapshotSubscriptions = [NSMutableArray array];
+            }
+            [self.snapshotSubscriptions addObject:subscription];
+
+            if (loading) {
+                return;
+            }
+        }
+    }
+
+    if (snapshot) {
+        [subscription notifyRemoteData:[UARemoteDataManager payloadsForTypes:subscription.payloadTypes payloadsByType:snapshot]
+                            dispatcher:self.dispatcher
+                     completionHandler:nil];
+        return;
+    }
 
+    [self loadSnapshot];
+}
+
+/**
+ * Reads the remote data store into the snapshot on the private context, then notifies the
+ * subscriptions that were waiting on it.
+ */
+- (void)loadSnapshot {
     UA_WEAKIFY(self);
-    [self.remoteDataStore fetchRemoteDataFromCacheWithPredicate:fetchPredicate completionHandler:^(NSArray<UARemoteDataStorePayload *> *payloads) {
+    [self.remoteDataStore fetchRemoteDataFromCacheWithPredicate:nil completionHandler:^(NSArray<UARemoteDataStorePayload *> *payloads) {
         UA_STRONGIFY(self);
         NSMutableArray<UARemoteDataPayload *> *remoteDataPayloads = [NSMutableArray arrayWithCapacity:payloads.count];
 
@@ -438,24 +723,76 @@ completionHandler:(void(^)(BOOL success))completionHandler {
             [remoteDataPayloads addObject:remoteData];
         }
 
-        [subscription notifyRemoteData:remoteDataPayloads dispatcher:self.dispatcher completionHandler:nil];
+        NSDictionary<NSString *, NSArray<UARemoteDataPayload *> *> *loaded = [UARemoteDataManager indexPayloadsByType:remoteDataPayloads];
+        NSDictionary<NSString *, NSArray<UARemoteDataPayload *> *> *snapshot;
+        NSArray<UARemoteDataSubscription *> *subscriptions;
+
+        @synchronized (self) {
+            // A refresh that finished during the load has newer data. An empty read is not kept,
+            // it may be a store that failed to open.
+            if (!self.snapshot && loaded.count) {
+                self.snapshot = loaded;
+            }
+
+            snapshot = self.snapshot ?: loaded;
+            subscriptions = self.snapshotSubscriptions;
+            self.snapshotSubscriptions = nil;
+        }
+
+        for (UARemoteDataSubscription *subscription in subscriptions) {
+            [subscription notifyRemoteData:[UARemoteDataManager payloadsForTypes:subscription.payloadTypes payloadsByType:snapshot]
+                                dispatcher:self.dispatcher
+                         completionHandler:nil];
+        }
     }];
 }
 
 #pragma mark -
 #pragma mark UAPushableComponent
 
+-(UAPushableComponentPriority)priorityForRemoteNotification:(UANotificationContent *)notification {
+    // A refresh that does not fit in the background time happens on the next foreground instead
+    return UAPushableComponentPriorityLow;
+}
+
 -(void)receivedRemoteNotification:(UANotificationContent *)notification completionHandler:(void (^)(UIBackgroundFetchResult))completionHandler {
     if (!notification.notificationInfo[UARemoteDataRefreshPayloadKey]) {
         completionHandler(UIBackgroundFetchResultNoData);
         return;
     }
 
-    [self refreshWithCompletionHandler:^(BOOL success) {
-        completionHandler(success ? UIBackgroundFetchResultNewData : UIBackgroundFetchResultFailed);
+    if ([self isWaitingForRetryAfter]) {
+        completionHandler(UIBackgroundFetchResultNoData);
+        return;
+    }
+
+    // The refresh push may go to the whole audience at once, spread the requests out
+    NSTimeInterval delay = self.maxPushRefreshJitter * [self pushRefreshJitter];
+    UA_LTRACE(@"Refreshing remote data from push in %g seconds", delay);
+
+    UA_WEAKIFY(self)
+    [self.dispatcher dispatchAfter:delay block:^{
+        UA_STRONGIFY(self)
+        [self refreshWithCompletionHandler:^(BOOL success) {
+            completionHandler(success ? UIBackgroundFetchResultNewData : UIBackgroundFetchResultFailed);
+        }];
     }];
 }
 
+/**
+ * The fraction of the max push refresh jitter to wait. The value is picked once per
+ * device so the device always refreshes at the same point in the window.
+ *
+ * @return A value between 0 and 1.
+ */
+- (double)pushRefreshJitter {
+    if (![self.dataStore keyExists:UARemoteDataPushRefreshJitterKey]) {
+        [self.dataStore setDouble:(double)arc4random_uniform(1000) / 1000 forKey:UARemoteDataPushRefreshJitterKey];
+    }
+
+    return [self.dataStore doubleForKey:UARemoteDataPushRefreshJitterKey];
+}
+
 #pragma mark -
 
 @end
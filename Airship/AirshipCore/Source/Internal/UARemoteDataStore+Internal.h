@@ -47,6 +47,18 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)overwriteCachedRemoteDataWithResponse:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads
                  completionHandler:(void(^)(BOOL))completionHandler;
 
+/**
+ * Replaces the stored remote data of the given types with the payloads. Payloads of
+ * other types are left untouched.
+ *
+ * @param remoteDataPayloads The new payloads. Each payload's type must be in `payloadTypes`.
+ * @param payloadTypes The payload types to replace.
+ * @param completionHandler The completion handler with the sync result.
+ */
+- (void)updateCachedRemoteDataWithPayloads:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads
+                            replacingTypes:(NSSet<NSString *> *)payloadTypes
+                         completionHandler:(void(^)(BOOL))completionHandler;
+
 /**
  * Fetches remote data with a specified predicate on the background context.
  *
@@ -27,20 +27,13 @@
         self.finished = NO;
         
         NSURL *modelURL = [[UAirshipCoreResources bundle] URLForResource:@"UARemoteData" withExtension:@"momd"];
-        self.managedContext = [NSManagedObjectContext managedObjectContextForModelURL:modelURL
-                                                                      concurrencyType:NSPrivateQueueConcurrencyType];
-        
-        [self.managedContext addPersistentSqlStore:self.storeName completionHandler:^(NSPersistentStore *store, NSError *error) {
-            if (!store) {
+        self.managedContext = [NSManagedObjectContext lazyManagedObjectContextForModelURL:modelURL
+                                                                              storeLoader:^(NSManagedObjectContext *context) {
+            NSError *error = nil;
+            if (![context addPersistentSqlStore:storeName error:&error]) {
                 UA_LERR(@"Failed to create remote data persistent store: %@", error);
-                return;
             }
         }];
-        
-        [[NSNotificationCenter defaultCenter] addObserver:self
-                                                 selector:@selector(protectedDataAvailable)
-                                                     name:UIApplicationProtectedDataDidBecomeAvailable
-                                                   object:nil];
     }
     return self;
 }
@@ -53,17 +46,6 @@
     return [[self alloc] initWithName:storeName inMemory:NO];
 }
 
-- (void)protectedDataAvailable {
-    if (!self.managedContext.persistentStoreCoordinator.persistentStores.count) {
-        [self.managedContext addPersistentSqlStore:self.storeName completionHandler:^(NSPersistentStore *store, NSError *error) {
-            if (!store) {
-                UA_LERR(@"Failed to create remote data persistent store: %@", error);
-                return;
-            }
-        }];
-    }
-}
-
 - (void)safePerformBlock:(void (^)(BOOL))block {
     @synchronized(self) {
         if (!self.finished) {
@@ -125,6 +107,35 @@
     }];
 }
 
+- (void)updateCachedRemoteDataWithPayloads:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads
+                            replacingTypes:(NSSet<NSString *> *)payloadTypes
+                         completionHandler:(void(^)(BOOL))completionHandler {
+    [self safePerformBlock:^(BOOL isSafe) {
+        if (!isSafe) {
+            completionHandler(NO);
+            return;
+        }
+
+        // Delete the stored remote data for the replaced types
+        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:kUARemoteDataDBEntityName];
+        request.predicate = [NSPredicate predicateWithFormat:@"type IN %@", payloadTypes];
+        NSBatchDeleteRequest *deleteRequest = [[NSBatchDeleteRequest alloc] initWithFetchRequest:request];
+        NSError *error;
+        [self.managedContext executeRequest:deleteRequest error:&error];
+
+        if (error) {
+            UA_LERR(@"Error deleting remote data types %@: %@", payloadTypes, error);
+            completionHandler(NO);
+            return;
+        }
+
+        for (UARemoteDataPayload *remoteDataPayload in remoteDataPayloads) {
+            [self addRemoteDataStorePayloadFromRemoteData:remoteDataPayload];
+        }
+
+        completionHandler([self.managedContext safeSave]);
+    }];
+}
 
 - (void)addRemoteDataStorePayloadFromRemoteData:(UARemoteDataPayload *)remoteDataPayload {
     // create the NSManagedObject
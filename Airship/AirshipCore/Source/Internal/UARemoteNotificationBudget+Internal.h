@@ -0,0 +1,74 @@
+/* Copyright Airship and Contributors */
+
+#import <UIKit/UIKit.h>
+
+#import "UAPushableComponent.h"
+
+@class UADispatcher;
+@class UADate;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A unit of remote notification handling. The block must call the completion handler with
+ * its fetch result.
+ */
+typedef void (^UARemoteNotificationBudgetTask)(void (^completionHandler)(UIBackgroundFetchResult));
+
+/**
+ * Runs the work for a remote notification within the time the system allows for it, so a slow
+ * component cannot hold the background fetch completion handler past the deadline.
+ *
+ * All tasks start together, higher priorities first. Low priority tasks are skipped if half of
+ * the budget is already spent when the budget runs, and are no longer waited on once half of the
+ * budget is spent. Once the time limit passes the completion handler is called with the results
+ * that are in, and late results are ignored. Each task's duration is logged at debug level.
+ */
+@interface UARemoteNotificationBudget : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Remote Notification Budget Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method. The elapsed time is measured from when the budget is created.
+ *
+ * @param timeLimit The time limit in seconds.
+ * @return A budget instance.
+ */
++ (instancetype)budgetWithTimeLimit:(NSTimeInterval)timeLimit;
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param timeLimit The time limit in seconds.
+ * @param dispatcher The dispatcher. Task completions are handled on it.
+ * @param date The date.
+ * @return A budget instance.
+ */
++ (instancetype)budgetWithTimeLimit:(NSTimeInterval)timeLimit
+                         dispatcher:(UADispatcher *)dispatcher
+                               date:(UADate *)date;
+
+/**
+ * Adds a task. Must be called before `runWithCompletionHandler:`.
+ *
+ * @param name The task name used when reporting timings.
+ * @param priority The task priority.
+ * @param task The task.
+ */
+- (void)addTaskWithName:(NSString *)name
+               priority:(UAPushableComponentPriority)priority
+                   task:(UARemoteNotificationBudgetTask)task;
+
+/**
+ * Starts the tasks.
+ *
+ * @param completionHandler Called on the dispatcher with the merged fetch results, once every
+ * task that is still waited on finished or the time limit passed.
+ */
+- (void)runWithCompletionHandler:(void (^)(UIBackgroundFetchResult))completionHandler;
+
+@end
+
+NS_ASSUME_NONNULL_END
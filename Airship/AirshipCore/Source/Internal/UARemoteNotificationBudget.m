@@ -0,0 +1,177 @@
+/* Copyright Airship and Contributors */
+
+#import "UARemoteNotificationBudget+Internal.h"
+#import "UADispatcher.h"
+#import "UADate.h"
+#import "UAUtils+Internal.h"
+#import "UAGlobal.h"
+
+/**
+ * The state of a single task. Only accessed on the dispatcher.
+ */
+@interface UARemoteNotificationBudgetEntry : NSObject
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, assign) UAPushableComponentPriority priority;
+@property (nonatomic, copy) UARemoteNotificationBudgetTask task;
+@property (nonatomic, strong, nullable) NSDate *startDate;
+@property (nonatomic, assign) NSTimeInterval duration;
+@property (nonatomic, assign) UIBackgroundFetchResult result;
+@property (nonatomic, assign) BOOL finished;
+@property (nonatomic, assign) BOOL skipped;
+@end
+
+@implementation UARemoteNotificationBudgetEntry
+@end
+
+@interface UARemoteNotificationBudget ()
+@property (nonatomic, assign) NSTimeInterval timeLimit;
+@property (nonatomic, strong) UADispatcher *dispatcher;
+@property (nonatomic, strong) UADate *date;
+@property (nonatomic, strong) NSDate *startDate;
+@property (nonatomic, strong) NSMutableArray<UARemoteNotificationBudgetEntry *> *entries;
+@property (nonatomic, copy, nullable) void (^completionHandler)(UIBackgroundFetchResult);
+
+/**
+ * Whether low priority tasks are still waited on. Only accessed on the dispatcher.
+ */
+@property (nonatomic, assign) BOOL waitingOnLowPriority;
+@end
+
+@implementation UARemoteNotificationBudget
+
+- (instancetype)initWithTimeLimit:(NSTimeInterval)timeLimit dispatcher:(UADispatcher *)dispatcher date:(UADate *)date {
+    self = [super init];
+    if (self) {
+        self.timeLimit = timeLimit;
+        self.dispatcher = dispatcher;
+        self.date = date;
+        self.startDate = [date now];
+        self.entries = [NSMutableArray array];
+        self.waitingOnLowPriority = YES;
+    }
+    return self;
+}
+
++ (instancetype)budgetWithTimeLimit:(NSTimeInterval)timeLimit {
+    return [[self alloc] initWithTimeLimit:timeLimit dispatcher:[UADispatcher mainDispatcher] date:[[UADate alloc] init]];
+}
+
++ (instancetype)budgetWithTimeLimit:(NSTimeInterval)timeLimit dispatcher:(UADispatcher *)dispatcher date:(UADate *)date {
+    return [[self alloc] initWithTimeLimit:timeLimit dispatcher:dispatcher date:date];
+}
+
+- (void)addTaskWithName:(NSString *)name priority:(UAPushableComponentPriority)priority task:(UARemoteNotificationBudgetTask)task {
+    UARemoteNotificationBudgetEntry *entry = [[UARemoteNotificationBudgetEntry alloc] init];
+    entry.name = name;
+    entry.priority = priority;
+    entry.task = task;
+    [self.entries addObject:entry];
+}
+
+- (NSTimeInterval)elapsedTime {
+    return [[self.date now] timeIntervalSinceDate:self.startDate];
+}
+
+- (void)runWithCompletionHandler:(void (^)(UIBackgroundFetchResult))completionHandler {
+    // The pending blocks keep the budget alive until it finishes, at the latest at the time limit
+    [self.dispatcher dispatchAsyncIfNecessary:^{
+        self.completionHandler = completionHandler;
+
+        NSTimeInterval elapsed = [self elapsedTime];
+        NSTimeInterval lowPriorityLimit = self.timeLimit / 2;
+
+        // Stable sort, so equal priorities keep the order they were added in
+        NSArray<UARemoteNotificationBudgetEntry *> *entries = [self.entries sortedArrayWithOptions:NSSortStable
+                                                                                    usingComparator:^NSComparisonResult(UARemoteNotificationBudgetEntry *entry1, UARemoteNotificationBudgetEntry *entry2) {
+            if (entry1.priority == entry2.priority) {
+                return NSOrderedSame;
+            }
+            return entry1.priority > entry2.priority ? NSOrderedAscending : NSOrderedDescending;
+        }];
+
+        if (elapsed >= lowPriorityLimit) {
+            self.waitingOnLowPriority = NO;
+        } else {
+            [self.dispatcher dispatchAfter:lowPriorityLimit - elapsed block:^{
+                self.waitingOnLowPriority = NO;
+                [self finishIfDone];
+            }];
+        }
+
+        [self.dispatcher dispatchAfter:MAX(self.timeLimit - elapsed, 0) block:^{
+            [self finish];
+        }];
+
+        for (UARemoteNotificationBudgetEntry *entry in entries) {
+            if (entry.priority == UAPushableComponentPriorityLow && !self.waitingOnLowPriority) {
+                entry.skipped = YES;
+                continue;
+            }
+
+            [self startEntry:entry];
+        }
+
+        [self finishIfDone];
+    }];
+}
+
+- (void)startEntry:(UARemoteNotificationBudgetEntry *)entry {
+    entry.startDate = [self.date now];
+
+    entry.task(^(UIBackgroundFetchResult result) {
+        [self.dispatcher dispatchAsyncIfNecessary:^{
+            if (entry.finished || !self.completionHandler) {
+                return;
+            }
+
+            entry.finished = YES;
+            entry.result = result;
+            entry.duration = [[self.date now] timeIntervalSinceDate:entry.startDate];
+            [self finishIfDone];
+        }];
+    });
+}
+
+- (void)finishIfDone {
+    for (UARemoteNotificationBudgetEntry *entry in self.entries) {
+        if (entry.finished || entry.skipped) {
+            continue;
+        }
+
+        if (entry.priority == UAPushableComponentPriorityLow && !self.waitingOnLowPriority) {
+            continue;
+        }
+
+        return;
+    }
+
+    [self finish];
+}
+
+- (void)finish {
+    void (^completionHandler)(UIBackgroundFetchResult) = self.completionHandler;
+    if (!completionHandler) {
+        return;
+    }
+
+    // The timers stay scheduled and do nothing once the handler is cleared
+    self.completionHandler = nil;
+
+    NSMutableArray *fetchResults = [NSMutableArray array];
+    NSMutableArray<NSString *> *timings = [NSMutableArray array];
+    for (UARemoteNotificationBudgetEntry *entry in self.entries) {
+        if (entry.skipped) {
+            [timings addObject:[NSString stringWithFormat:@"%@: deferred", entry.name]];
+        } else if (entry.finished) {
+            [fetchResults addObject:@(entry.result)];
+            [timings addObject:[NSString stringWithFormat:@"%@: %.3fs", entry.name, entry.duration]];
+        } else {
+            [timings addObject:[NSString stringWithFormat:@"%@: unfinished", entry.name]];
+        }
+    }
+
+    UA_LDEBUG(@"Remote notification handled in %.3fs (%@)", [self elapsedTime], [timings componentsJoinedByString:@", "]);
+    completionHandler([UAUtils mergeFetchResults:fetchResults]);
+}
+
+@end
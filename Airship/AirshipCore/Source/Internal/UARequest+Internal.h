@@ -0,0 +1,47 @@
+/* Copyright Airship and Contributors */
+
+#import "UARequest.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface UARequestBuilder ()
+
+/**
+ * Flag to compress the body incrementally while it is sent instead of up front. Only
+ * applies when `compressBody` is enabled. Streamed requests expose the body
+ * through `bodyStream` instead of `body`.
+ */
+@property (nonatomic, assign) BOOL streamBody;
+
+/**
+ * The GZIP compression level, 0-9. Defaults to -1, the zlib default level.
+ */
+@property (nonatomic, assign) NSInteger compressionLevel;
+
+@end
+
+@interface UARequest ()
+
+/**
+ * The body length before compression, or 0 if the body is not compressed.
+ */
+@property (nonatomic, readonly) NSUInteger uncompressedBodyLength;
+
+/**
+ * Creates a copy of the request with a gzip compressed body, for hosts that rejected the
+ * request's content encoding.
+ *
+ * @return A gzip request, or nil if the request is not compressed with another encoding.
+ */
+- (nullable UARequest *)requestWithFallbackEncoding;
+
+/**
+ * Creates a new stream for the request body if the body is streamed. Each call
+ * returns a new, unopened stream so the request can be retried.
+ * @return A body stream, or nil if the body is not streamed.
+ */
+- (nullable NSInputStream *)bodyStream;
+
+@end
+
+NS_ASSUME_NONNULL_END
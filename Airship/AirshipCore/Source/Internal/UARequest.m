@@ -1,12 +1,15 @@
 /* Copyright Airship and Contributors */
 
 #import <zlib.h>
+#import <compression.h>
 
-#import "UARequest.h"
+#import "UARequest+Internal.h"
 #import "UAirship.h"
 #import "UADisposable.h"
 #import "UARuntimeConfig.h"
 #import "UADelayOperation+Internal.h"
+#import "UAGZIPInputStream+Internal.h"
+#import "UARequestEncodingPolicy+Internal.h"
 
 @interface UARequestBuilder()
 @property (nonatomic, strong) NSMutableDictionary *headers;
@@ -18,6 +21,9 @@
 
     if (self) {
         self.headers = [NSMutableDictionary dictionary];
+        self.compressionLevel = Z_DEFAULT_COMPRESSION;
+        self.priority = NSURLSessionTaskPriorityDefault;
+        self.trafficClass = UARequestTrafficClassCritical;
     }
 
     return self;
@@ -38,6 +44,16 @@
 @property (nonatomic, copy) NSURL *URL;
 @property (nonatomic, copy) NSDictionary *headers;
 @property (nonatomic, copy, nullable) NSData *body;
+@property (nonatomic, copy, nullable) NSData *streamData;
+@property (nonatomic, assign) NSInteger compressionLevel;
+@property (nonatomic, assign) float priority;
+@property (nonatomic, assign) UARequestTrafficClass trafficClass;
+@property (nonatomic, assign) NSUInteger uncompressedBodyLength;
+
+/**
+ * The uncompressed body, kept when the body uses an encoding the host may reject.
+ */
+@property (nonatomic, copy, nullable) NSData *fallbackBody;
 @end
 
 @implementation UARequest
@@ -65,22 +81,62 @@
             [headers addEntriesFromDictionary:builder.headers];
         }
 
+        self.compressionLevel = builder.compressionLevel;
+        self.priority = builder.priority;
+        self.trafficClass = builder.trafficClass;
+
         if (builder.body) {
-            if (builder.compressBody) {
-                self.body = [UARequest gzipCompress:builder.body];
-                headers[@"Content-Encoding"] = @"gzip";
+            if (builder.compressBody && builder.streamBody) {
+                self.streamData = builder.body;
+                headers[@"Content-Encoding"] = UARequestEncodingGzip;
+            } else if (builder.compressBody) {
+                NSString *encoding = [[UARequestEncodingPolicy sharedPolicy] requestEncodingForHost:builder.URL.host];
+                NSData *encoded = [encoding isEqualToString:UARequestEncodingBrotli] ? [UARequest brotliCompress:builder.body] : nil;
+
+                if (encoded) {
+                    self.body = encoded;
+                    self.fallbackBody = builder.body;
+                    headers[@"Content-Encoding"] = UARequestEncodingBrotli;
+                } else {
+                    self.body = [UARequest gzipCompress:builder.body level:(int)builder.compressionLevel];
+                    headers[@"Content-Encoding"] = UARequestEncodingGzip;
+                }
             } else {
                 self.body = builder.body;
             }
         }
 
 
+        if (builder.body && builder.compressBody) {
+            self.uncompressedBodyLength = builder.body.length;
+        }
+
         self.headers = headers;
     }
 
     return self;
 }
 
+- (UARequest *)requestWithFallbackEncoding {
+    if (!self.fallbackBody) {
+        return nil;
+    }
+
+    NSMutableDictionary *headers = [self.headers mutableCopy];
+    headers[@"Content-Encoding"] = UARequestEncodingGzip;
+
+    UARequest *request = [[UARequest alloc] init];
+    request.method = self.method;
+    request.URL = self.URL;
+    request.headers = headers;
+    request.body = [UARequest gzipCompress:self.fallbackBody level:(int)self.compressionLevel];
+    request.compressionLevel = self.compressionLevel;
+    request.priority = self.priority;
+    request.trafficClass = self.trafficClass;
+    request.uncompressedBodyLength = self.uncompressedBodyLength;
+    return request;
+}
+
 + (instancetype)requestWithBuilder:(UARequestBuilder *)builder {
     return [[self alloc] initWithBuilder:builder];
 }
@@ -96,7 +152,38 @@
     return [[UARequest alloc] initWithBuilder:builder];
 }
 
-+ (NSData *)gzipCompress:(NSData *)uncompressedData {
+- (NSInputStream *)bodyStream {
+    if (!self.streamData) {
+        return nil;
+    }
+
+    return [UAGZIPInputStream inputStreamWithData:self.streamData compressionLevel:self.compressionLevel];
+}
+
++ (nullable NSData *)brotliCompress:(NSData *)uncompressedData {
+    if (@available(iOS 15.0, tvOS 15.0, *)) {
+        if (!uncompressedData.length) {
+            return nil;
+        }
+
+        // Brotli output is never much larger than its input, anything past that is a failure
+        size_t capacity = uncompressedData.length + 1024;
+        NSMutableData *compressed = [NSMutableData dataWithLength:capacity];
+        size_t length = compression_encode_buffer(compressed.mutableBytes, capacity,
+                                                  uncompressedData.bytes, uncompressedData.length,
+                                                  NULL, COMPRESSION_BROTLI);
+        if (!length) {
+            return nil;
+        }
+
+        [compressed setLength:length];
+        return compressed;
+    }
+
+    return nil;
+}
+
++ (NSData *)gzipCompress:(NSData *)uncompressedData level:(int)level {
 
     if ([uncompressedData length] == 0) {
         return nil;
@@ -113,7 +200,7 @@
     strm.next_in=(Bytef *)[uncompressedData bytes];
     strm.avail_in = (uInt)[uncompressedData length];
 
-    if (deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, (15+16), 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    if (deflateInit2(&strm, level, Z_DEFLATED, (15+16), 8, Z_DEFAULT_STRATEGY) != Z_OK) {
         return nil;
     }
 
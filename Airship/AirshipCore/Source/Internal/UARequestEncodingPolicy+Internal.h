@@ -0,0 +1,86 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * The gzip content encoding.
+ */
+extern NSString * const UARequestEncodingGzip;
+
+/**
+ * The brotli content encoding.
+ */
+extern NSString * const UARequestEncodingBrotli;
+
+/**
+ * Negotiates the content encodings used with each host.
+ *
+ * Responses are decoded by the URL loading system, so the policy only advertises the encodings it
+ * can decode. Request bodies are gzip compressed unless a host listed a better encoding in the
+ * `Accept-Encoding` header of a previous response (RFC 7694) and the OS can produce it. Hosts that
+ * reject an encoding with a 415 response fall back to gzip.
+ */
+@interface UARequestEncodingPolicy : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Request Encoding Policy Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The `Accept-Encoding` header value sent with every request.
+ */
+@property (nonatomic, readonly) NSString *acceptEncoding;
+
+///---------------------------------------------------------------------------------------
+/// @name Request Encoding Policy Factories
+///---------------------------------------------------------------------------------------
+
+/**
+ * The policy shared by all requests.
+ *
+ * @return The shared policy.
+ */
++ (instancetype)sharedPolicy;
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @return A request encoding policy.
+ */
++ (instancetype)policy;
+
+///---------------------------------------------------------------------------------------
+/// @name Request Encoding Policy Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Returns the encoding to compress request bodies sent to a host with.
+ *
+ * @param host The host.
+ * @return `UARequestEncodingBrotli` if the host accepts it and it is available, otherwise `UARequestEncodingGzip`.
+ */
+- (NSString *)requestEncodingForHost:(nullable NSString *)host;
+
+/**
+ * Updates the encodings a host accepts from its response's `Accept-Encoding` header. Responses
+ * without the header leave the host's encodings unchanged.
+ *
+ * @param response The response.
+ * @param host The host.
+ */
+- (void)updateWithResponse:(nullable NSURLResponse *)response host:(nullable NSString *)host;
+
+/**
+ * Records that a host rejected an encoding. The encoding is not used with the host again
+ * until the host advertises it.
+ *
+ * @param encoding The encoding.
+ * @param host The host.
+ */
+- (void)recordUnsupportedEncoding:(NSString *)encoding forHost:(nullable NSString *)host;
+
+@end
+
+NS_ASSUME_NONNULL_END
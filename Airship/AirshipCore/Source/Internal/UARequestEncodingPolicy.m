@@ -0,0 +1,129 @@
+/* Copyright Airship and Contributors */
+
+#import "UARequestEncodingPolicy+Internal.h"
+#import "UAGlobal.h"
+
+NSString * const UARequestEncodingGzip = @"gzip";
+NSString * const UARequestEncodingBrotli = @"br";
+
+// Encodings the URL loading system decodes on every supported OS version
+static NSString * const UARequestEncodingPolicyAcceptEncoding = @"br;q=1.0, gzip;q=0.8, deflate;q=0.5";
+
+@interface UARequestEncodingPolicy ()
+@property (nonatomic, copy) NSString *acceptEncoding;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSSet<NSString *> *> *hostEncodings;
+@end
+
+@implementation UARequestEncodingPolicy
+
+- (instancetype)init {
+    self = [super init];
+
+    if (self) {
+        self.acceptEncoding = UARequestEncodingPolicyAcceptEncoding;
+        self.hostEncodings = [NSMutableDictionary dictionary];
+    }
+
+    return self;
+}
+
++ (instancetype)sharedPolicy {
+    static dispatch_once_t onceToken;
+    static UARequestEncodingPolicy *_policy;
+    dispatch_once(&onceToken, ^{
+        _policy = [self policy];
+    });
+
+    return _policy;
+}
+
++ (instancetype)policy {
+    return [[self alloc] init];
+}
+
++ (BOOL)isBrotliAvailable {
+    if (@available(iOS 15.0, tvOS 15.0, *)) {
+        return YES;
+    }
+
+    return NO;
+}
+
+- (NSString *)requestEncodingForHost:(NSString *)host {
+    if (!host) {
+        return UARequestEncodingGzip;
+    }
+
+    NSSet<NSString *> *encodings;
+    @synchronized (self) {
+        encodings = self.hostEncodings[host];
+    }
+
+    if ([encodings containsObject:UARequestEncodingBrotli] && [UARequestEncodingPolicy isBrotliAvailable]) {
+        return UARequestEncodingBrotli;
+    }
+
+    return UARequestEncodingGzip;
+}
+
+- (void)updateWithResponse:(NSURLResponse *)response host:(NSString *)host {
+    if (!host || ![response isKindOfClass:[NSHTTPURLResponse class]]) {
+        return;
+    }
+
+    NSString *header = [(NSHTTPURLResponse *)response allHeaderFields][@"Accept-Encoding"];
+    if (![header isKindOfClass:[NSString class]]) {
+        return;
+    }
+
+    NSSet<NSString *> *encodings = [UARequestEncodingPolicy encodingsFromHeader:header];
+
+    @synchronized (self) {
+        if (![self.hostEncodings[host] isEqualToSet:encodings]) {
+            UA_LTRACE(@"Host %@ accepts request encodings %@", host, encodings);
+            self.hostEncodings[host] = encodings;
+        }
+    }
+}
+
+- (void)recordUnsupportedEncoding:(NSString *)encoding forHost:(NSString *)host {
+    if (!host) {
+        return;
+    }
+
+    @synchronized (self) {
+        NSMutableSet<NSString *> *encodings = [self.hostEncodings[host] mutableCopy];
+        [encodings removeObject:encoding];
+        self.hostEncodings[host] = encodings ?: [NSSet set];
+    }
+}
+
++ (NSSet<NSString *> *)encodingsFromHeader:(NSString *)header {
+    NSMutableSet<NSString *> *encodings = [NSMutableSet set];
+    NSCharacterSet *whitespace = [NSCharacterSet whitespaceCharacterSet];
+
+    // e.g. "br, gzip;q=0.8, identity;q=0"
+    for (NSString *item in [header componentsSeparatedByString:@","]) {
+        NSArray<NSString *> *parameters = [item componentsSeparatedByString:@";"];
+        NSString *encoding = [parameters.firstObject stringByTrimmingCharactersInSet:whitespace].lowercaseString;
+        if (!encoding.length) {
+            continue;
+        }
+
+        BOOL rejected = NO;
+        for (NSUInteger i = 1; i < parameters.count; i++) {
+            NSString *parameter = [[parameters[i] stringByTrimmingCharactersInSet:whitespace] stringByReplacingOccurrencesOfString:@" " withString:@""];
+            if ([parameter hasPrefix:@"q="] && [parameter substringFromIndex:2].doubleValue <= 0) {
+                rejected = YES;
+            }
+        }
+
+        if (!rejected) {
+            [encodings addObject:encoding];
+        }
+    }
+
+    return encodings;
+}
+
+@end
@@ -0,0 +1,122 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+#import "UADate.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Decides when and how often failed requests are retried.
+ *
+ * Retries are spread out with full jitter backoff so devices that failed at the same time do not
+ * retry in lockstep. The policy also tracks consecutive failures per endpoint, the URL's host and
+ * path. Once an endpoint reaches the failure threshold its circuit opens and requests to it are
+ * short-circuited until the open interval has passed. The first request after that probes the
+ * endpoint; a success closes the circuit and a failure opens it again.
+ */
+@interface UARequestRetryPolicy : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Request Retry Policy Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The upper bound of the delay before the first retry.
+ */
+@property (nonatomic, readonly) NSTimeInterval initialDelay;
+
+/**
+ * The upper bound of the delay between retries.
+ */
+@property (nonatomic, readonly) NSTimeInterval maxDelay;
+
+/**
+ * The maximum number of attempts for a request, including the initial attempt.
+ */
+@property (nonatomic, readonly) NSUInteger maxAttempts;
+
+/**
+ * The number of consecutive failures for an endpoint that opens its circuit.
+ */
+@property (nonatomic, readonly) NSUInteger failureThreshold;
+
+/**
+ * How long an endpoint's circuit stays open.
+ */
+@property (nonatomic, readonly) NSTimeInterval circuitOpenInterval;
+
+///---------------------------------------------------------------------------------------
+/// @name Request Retry Policy Factories
+///---------------------------------------------------------------------------------------
+
+/**
+ * The policy shared by all request sessions.
+ *
+ * @return The shared policy.
+ */
++ (instancetype)sharedPolicy;
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param initialDelay The upper bound of the delay before the first retry.
+ * @param maxDelay The upper bound of the delay between retries.
+ * @param maxAttempts The maximum number of attempts for a request.
+ * @param failureThreshold The number of consecutive failures that opens an endpoint's circuit.
+ * @param circuitOpenInterval How long an endpoint's circuit stays open.
+ * @param date The UADate instance.
+ * @return A request retry policy.
+ */
++ (instancetype)policyWithInitialDelay:(NSTimeInterval)initialDelay
+                              maxDelay:(NSTimeInterval)maxDelay
+                           maxAttempts:(NSUInteger)maxAttempts
+                      failureThreshold:(NSUInteger)failureThreshold
+                   circuitOpenInterval:(NSTimeInterval)circuitOpenInterval
+                                  date:(UADate *)date;
+
+///---------------------------------------------------------------------------------------
+/// @name Request Retry Policy Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Checks if a request should be retried.
+ *
+ * @param attempt The number of attempts made so far.
+ * @return `YES` if another attempt is allowed, otherwise `NO`.
+ */
+- (BOOL)shouldRetryAfterAttempt:(NSUInteger)attempt;
+
+/**
+ * Returns a random delay between 0 and the capped exponential backoff for the attempt.
+ *
+ * @param attempt The number of attempts made so far.
+ * @return The delay before the next attempt.
+ */
+- (NSTimeInterval)retryDelayAfterAttempt:(NSUInteger)attempt;
+
+/**
+ * Checks if requests to an endpoint should be short-circuited.
+ *
+ * @param URL The request URL.
+ * @return `YES` if the endpoint's circuit is open, otherwise `NO`.
+ */
+- (BOOL)isCircuitOpenForURL:(nullable NSURL *)URL;
+
+/**
+ * Records a successful response from an endpoint. Closes the endpoint's circuit.
+ *
+ * @param URL The request URL.
+ */
+- (void)recordSuccessForURL:(nullable NSURL *)URL;
+
+/**
+ * Records a failed response from an endpoint. Opens the endpoint's circuit once the failure
+ * threshold is reached.
+ *
+ * @param URL The request URL.
+ */
+- (void)recordFailureForURL:(nullable NSURL *)URL;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,155 @@
+/* Copyright Airship and Contributors */
+
+#import "UARequestRetryPolicy+Internal.h"
+#import "UAGlobal.h"
+
+static NSTimeInterval const UARequestRetryPolicyInitialDelay = 30;
+static NSTimeInterval const UARequestRetryPolicyMaxDelay = 3000;
+static NSUInteger const UARequestRetryPolicyMaxAttempts = 8;
+static NSUInteger const UARequestRetryPolicyFailureThreshold = 5;
+static NSTimeInterval const UARequestRetryPolicyCircuitOpenInterval = 300;
+
+@interface UARequestRetryPolicy()
+@property (nonatomic, assign) NSTimeInterval initialDelay;
+@property (nonatomic, assign) NSTimeInterval maxDelay;
+@property (nonatomic, assign) NSUInteger maxAttempts;
+@property (nonatomic, assign) NSUInteger failureThreshold;
+@property (nonatomic, assign) NSTimeInterval circuitOpenInterval;
+@property (nonatomic, strong) UADate *date;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *failureCounts;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSDate *> *circuitOpenDates;
+@end
+
+@implementation UARequestRetryPolicy
+
+- (instancetype)initWithInitialDelay:(NSTimeInterval)initialDelay
+                            maxDelay:(NSTimeInterval)maxDelay
+                         maxAttempts:(NSUInteger)maxAttempts
+                    failureThreshold:(NSUInteger)failureThreshold
+                 circuitOpenInterval:(NSTimeInterval)circuitOpenInterval
+                                date:(UADate *)date {
+    self = [super init];
+
+    if (self) {
+        self.initialDelay = initialDelay;
+        self.maxDelay = maxDelay;
+        self.maxAttempts = maxAttempts;
+        self.failureThreshold = failureThreshold;
+        self.circuitOpenInterval = circuitOpenInterval;
+        self.date = date;
+        self.failureCounts = [NSMutableDictionary dictionary];
+        self.circuitOpenDates = [NSMutableDictionary dictionary];
+    }
+
+    return self;
+}
+
++ (instancetype)sharedPolicy {
+    static dispatch_once_t onceToken;
+    static UARequestRetryPolicy *_policy;
+    dispatch_once(&onceToken, ^{
+        _policy = [self policyWithInitialDelay:UARequestRetryPolicyInitialDelay
+                                      maxDelay:UARequestRetryPolicyMaxDelay
+                                   maxAttempts:UARequestRetryPolicyMaxAttempts
+                              failureThreshold:UARequestRetryPolicyFailureThreshold
+                           circuitOpenInterval:UARequestRetryPolicyCircuitOpenInterval
+                                          date:[[UADate alloc] init]];
+    });
+
+    return _policy;
+}
+
++ (instancetype)policyWithInitialDelay:(NSTimeInterval)initialDelay
+                              maxDelay:(NSTimeInterval)maxDelay
+                           maxAttempts:(NSUInteger)maxAttempts
+                      failureThreshold:(NSUInteger)failureThreshold
+                   circuitOpenInterval:(NSTimeInterval)circuitOpenInterval
+                                  date:(UADate *)date {
+
+    return [[self alloc] initWithInitialDelay:initialDelay
+                                     maxDelay:maxDelay
+                                  maxAttempts:maxAttempts
+                             failureThreshold:failureThreshold
+                          circuitOpenInterval:circuitOpenInterval
+                                         date:date];
+}
+
+- (BOOL)shouldRetryAfterAttempt:(NSUInteger)attempt {
+    return attempt < self.maxAttempts;
+}
+
+- (NSTimeInterval)retryDelayAfterAttempt:(NSUInteger)attempt {
+    // Full jitter: a uniform delay between 0 and the capped exponential backoff
+    NSUInteger exponent = MIN(MAX(attempt, 1) - 1, 32);
+    NSTimeInterval backOff = MIN(self.initialDelay * pow(2, exponent), self.maxDelay);
+    return backOff * ((double)arc4random() / UINT32_MAX);
+}
+
+/**
+ * Circuits are tracked per endpoint, so a failing API does not short-circuit the other APIs
+ * on the same host.
+ */
++ (nullable NSString *)endpointForURL:(nullable NSURL *)URL {
+    if (!URL.host) {
+        return nil;
+    }
+
+    return [URL.host stringByAppendingString:URL.path ?: @""];
+}
+
+- (BOOL)isCircuitOpenForURL:(NSURL *)URL {
+    NSString *endpoint = [UARequestRetryPolicy endpointForURL:URL];
+    if (!endpoint) {
+        return NO;
+    }
+
+    @synchronized (self) {
+        NSDate *openDate = self.circuitOpenDates[endpoint];
+        if (!openDate) {
+            return NO;
+        }
+
+        // Once the open interval passes, let a request through to probe the endpoint
+        if ([self.date.now timeIntervalSinceDate:openDate] >= self.circuitOpenInterval) {
+            [self.circuitOpenDates removeObjectForKey:endpoint];
+            return NO;
+        }
+
+        return YES;
+    }
+}
+
+- (void)recordSuccessForURL:(NSURL *)URL {
+    NSString *endpoint = [UARequestRetryPolicy endpointForURL:URL];
+    if (!endpoint) {
+        return;
+    }
+
+    @synchronized (self) {
+        if (self.failureCounts[endpoint].unsignedIntegerValue >= self.failureThreshold) {
+            UA_LDEBUG(@"Closing request circuit for %@", endpoint);
+        }
+
+        [self.failureCounts removeObjectForKey:endpoint];
+        [self.circuitOpenDates removeObjectForKey:endpoint];
+    }
+}
+
+- (void)recordFailureForURL:(NSURL *)URL {
+    NSString *endpoint = [UARequestRetryPolicy endpointForURL:URL];
+    if (!endpoint) {
+        return;
+    }
+
+    @synchronized (self) {
+        NSUInteger failures = self.failureCounts[endpoint].unsignedIntegerValue + 1;
+        self.failureCounts[endpoint] = @(failures);
+
+        if (failures >= self.failureThreshold) {
+            UA_LDEBUG(@"Opening request circuit for %@ after %lu failures", endpoint, (unsigned long)failures);
+            self.circuitOpenDates[endpoint] = self.date.now;
+        }
+    }
+}
+
+@end
@@ -0,0 +1,25 @@
+/* Copyright Airship and Contributors */
+
+#import "UARequestSession.h"
+#import "UARequestRetryPolicy+Internal.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface UARequestSession ()
+
+/**
+ * UARequestSession factory method. Used for testing.
+ * @param config The UARuntimeConfig instance.
+ * @param session A NSURLSession instance.
+ * @param queue The task queue requests and retries run on.
+ * @param retryPolicy The retry policy.
+ * @return A UARequestSession instance.
+ */
++ (instancetype)sessionWithConfig:(UARuntimeConfig *)config
+                     NSURLSession:(NSURLSession *)session
+                            queue:(UATaskQueue *)queue
+                      retryPolicy:(UARequestRetryPolicy *)retryPolicy;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -1,40 +1,83 @@
 /* Copyright Airship and Contributors */
 
 
-#import "UARequestSession.h"
-#import "UAURLRequestOperation+Internal.h"
-#import "UADelayOperation+Internal.h"
+#import "UARequestSession+Internal.h"
+#import "UATaskQueue.h"
 #import "UARuntimeConfig.h"
 #import "UAirship.h"
+#import "UADispatcher.h"
+#import "UANetworkMetrics+Internal.h"
+#import "UAMetricsRegistry.h"
+#import "UANetworkWindow.h"
+#import "UALocaleManager+Internal.h"
+#import "UARequest+Internal.h"
+#import "UARequestEncodingPolicy+Internal.h"
+
+NSString * const UARequestSessionErrorDomain = @"com.urbanairship.request_session";
 
 @interface UARequestSession()
 @property(nonatomic, strong) NSURLSession *session;
-@property(nonatomic, strong) NSOperationQueue *queue;
+@property(nonatomic, strong) UATaskQueue *queue;
 @property(nonatomic, strong) NSMutableDictionary *headers;
+@property(nonatomic, copy) NSString *appKey;
+
+/**
+ * The session headers merged with the user agent, or nil until the next request builds them.
+ */
+@property(atomic, copy, nullable) NSDictionary *cachedHeaders;
+@property(nonatomic, strong) UARequestRetryPolicy *retryPolicy;
+@property(nonatomic, strong) UARequestEncodingPolicy *encodingPolicy;
+@property(nonatomic, strong) UAMetricCounter *requestCounter;
+@property(nonatomic, strong) UAMetricCounter *requestErrorCounter;
+@property(nonatomic, strong) UAMetricCounter *requestRetryCounter;
 @end
 
-static NSTimeInterval const InitialDelay = 30;
-static NSTimeInterval const MaxBackOff = 3000;
+static NSInteger const MaxConnectionsPerHost = 2;
+static NSInteger const UnsupportedMediaTypeStatus = 415;
 
 @implementation UARequestSession
 
-- (instancetype)initWithConfig:(UARuntimeConfig *)config session:(NSURLSession *)session queue:(NSOperationQueue *)queue {
+- (instancetype)initWithConfig:(UARuntimeConfig *)config
+                       session:(NSURLSession *)session
+                         queue:(UATaskQueue *)queue
+                   retryPolicy:(UARequestRetryPolicy *)retryPolicy {
     self = [super init];
 
     if (self) {
         self.headers = [NSMutableDictionary dictionary];
+        self.appKey = config.appKey;
         self.session = session;
         self.queue = queue;
-
-        [self setValue:@"gzip;q=1.0, compress;q=0.5" forHeader:@"Accept-Encoding"];
-        [self setValue:[UARequestSession userAgentWithAppKey:config.appKey] forHeader:@"User-Agent"];
+        self.retryPolicy = retryPolicy;
+        self.encodingPolicy = [UARequestEncodingPolicy sharedPolicy];
+
+        UAMetricsRegistry *metrics = [UAMetricsRegistry shared];
+        self.requestCounter = [metrics counterWithName:UAMetricNetworkRequests];
+        self.requestErrorCounter = [metrics counterWithName:UAMetricNetworkRequestErrors];
+        self.requestRetryCounter = [metrics counterWithName:UAMetricNetworkRequestRetries];
+
+        [self setValue:self.encodingPolicy.acceptEncoding forHeader:@"Accept-Encoding"];
+
+        // The user agent includes the locale
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(invalidateCachedHeaders)
+                                                     name:UALocaleUpdatedEvent
+                                                   object:nil];
+
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(invalidateCachedHeaders)
+                                                     name:NSCurrentLocaleDidChangeNotification
+                                                   object:nil];
     }
 
     return self;
 }
 
-+ (instancetype)sessionWithConfig:(UARuntimeConfig *)config {
+- (void)dealloc {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
 
++ (NSURLSession *)sharedURLSession {
     static dispatch_once_t onceToken;
     static NSURLSession *_session;
     dispatch_once(&onceToken, ^{
@@ -48,28 +91,69 @@ static NSTimeInterval const MaxBackOff = 3000;
         // Force min 1.2 even though our backend will always negotiate 1.2+
         sessionConfig.TLSMinimumSupportedProtocol = kTLSProtocol12;
 
-        _session = [NSURLSession sessionWithConfiguration:sessionConfig delegate:nil delegateQueue:nil];
+        // All API clients share this session so requests to the same host are multiplexed on a
+        // single HTTP/2 connection and TLS sessions are resumed instead of renegotiated. Keep the
+        // connection count low so requests are not spread over new connections.
+        sessionConfig.HTTPMaximumConnectionsPerHost = MaxConnectionsPerHost;
+        sessionConfig.HTTPShouldUsePipelining = YES;
+
+        // Requests use completion handlers, the delegate only collects task metrics
+        _session = [NSURLSession sessionWithConfiguration:sessionConfig delegate:[UANetworkMetrics shared] delegateQueue:nil];
     });
 
-    NSOperationQueue *queue = [[NSOperationQueue alloc] init];
-    queue.maxConcurrentOperationCount = 1;
+    return _session;
+}
 
-    return [[UARequestSession alloc] initWithConfig:config session:_session queue:queue];
++ (instancetype)sessionWithConfig:(UARuntimeConfig *)config {
+    return [self sessionWithConfig:config NSURLSession:[self sharedURLSession]];
 }
 
 + (instancetype)sessionWithConfig:(UARuntimeConfig *)config NSURLSession:(NSURLSession *)session {
-    NSOperationQueue *queue = [[NSOperationQueue alloc] init];
-    queue.maxConcurrentOperationCount = 1;
+    return [self sessionWithConfig:config NSURLSession:session queue:[UATaskQueue serialQueue]];
+}
 
-    return [[UARequestSession alloc] initWithConfig:config session:session queue:queue];
++ (instancetype)sessionWithConfig:(UARuntimeConfig *)config NSURLSession:(NSURLSession *)session queue:(UATaskQueue *)queue {
+    return [self sessionWithConfig:config NSURLSession:session queue:queue retryPolicy:[UARequestRetryPolicy sharedPolicy]];
 }
 
-+ (instancetype)sessionWithConfig:(UARuntimeConfig *)config NSURLSession:(NSURLSession *)session queue:(NSOperationQueue *)queue {
-    return [[UARequestSession alloc] initWithConfig:config session:session queue:queue];
++ (instancetype)sessionWithConfig:(UARuntimeConfig *)config
+                     NSURLSession:(NSURLSession *)session
+                            queue:(UATaskQueue *)queue
+                      retryPolicy:(UARequestRetryPolicy *)retryPolicy {
+    return [[UARequestSession alloc] initWithConfig:config session:session queue:queue retryPolicy:retryPolicy];
 }
 
 - (void)setValue:(id)value forHeader:(NSString *)field {
-    [self.headers setValue:value forKey:field];
+    @synchronized (self) {
+        [self.headers setValue:value forKey:field];
+        self.cachedHeaders = nil;
+    }
+}
+
+- (void)invalidateCachedHeaders {
+    self.cachedHeaders = nil;
+}
+
+/**
+ * The headers sent with every request. Built once and reused until the locale or the
+ * session headers change.
+ */
+- (NSDictionary *)sessionHeaders {
+    NSDictionary *headers = self.cachedHeaders;
+    if (headers) {
+        return headers;
+    }
+
+    @synchronized (self) {
+        if (!self.cachedHeaders) {
+            NSMutableDictionary *sessionHeaders = [NSMutableDictionary dictionary];
+            sessionHeaders[@"User-Agent"] = [UARequestSession userAgentWithAppKey:self.appKey];
+            [sessionHeaders addEntriesFromDictionary:self.headers];
+            self.cachedHeaders = sessionHeaders;
+        }
+
+        return self.cachedHeaders;
+    }
 }
 
 - (void)dataTaskWithRequest:(UARequest *)request
@@ -82,64 +166,150 @@ static NSTimeInterval const MaxBackOff = 3000;
                  retryWhere:(UARequestRetryBlock)retryBlock
           completionHandler:(UARequestCompletionHandler)completionHandler {
 
-    // Create the URLRequest
+    if ([self.retryPolicy isCircuitOpenForURL:request.URL]) {
+        UA_LDEBUG(@"Skipping request to %@, the endpoint is failing", request.URL);
+        NSError *error = [NSError errorWithDomain:UARequestSessionErrorDomain
+                                             code:UARequestSessionErrorCodeCircuitOpen
+                                         userInfo:@{NSLocalizedDescriptionKey : @"Endpoint circuit is open"}];
+
+        [[UADispatcher globalDispatcherForWorkType:UADispatcherWorkTypeUpload] dispatchAsync:^{
+            completionHandler(nil, nil, error);
+        }];
+        return;
+    }
+
+    UATask *task = [self taskWithRequest:request
+                                 attempt:1
+                              retryWhere:retryBlock
+                       completionHandler:completionHandler];
+
+    [self.queue addTask:task];
+}
+
+- (NSURLRequest *)URLRequestWithRequest:(UARequest *)request {
     NSMutableURLRequest *urlRequest = [NSMutableURLRequest requestWithURL:request.URL];
     [urlRequest setHTTPShouldHandleCookies:NO];
     [urlRequest setHTTPMethod:request.method];
-    [urlRequest setHTTPBody:request.body];
 
-    // Session Headers
-    for (NSString *key in self.headers) {
-        [urlRequest setValue:self.headers[key] forHTTPHeaderField:key];
+    // Let the system fail fast instead of using data the user asked to save
+    if (@available(iOS 13.0, tvOS 13.0, *)) {
+        urlRequest.allowsConstrainedNetworkAccess = request.trafficClass == UARequestTrafficClassCritical;
+        urlRequest.allowsExpensiveNetworkAccess = request.trafficClass != UARequestTrafficClassPrefetch;
     }
 
-    // Request Headers
-    for (NSString *key in request.headers) {
-        [urlRequest setValue:request.headers[key] forHTTPHeaderField:key];
+    // Streamed bodies need a new stream for every attempt
+    NSInputStream *bodyStream = [request bodyStream];
+    if (bodyStream) {
+        [urlRequest setHTTPBodyStream:bodyStream];
+    } else {
+        [urlRequest setHTTPBody:request.body];
     }
 
-    NSOperation *operation = [self operationWithRequest:urlRequest
-                                             retryDelay:InitialDelay
-                                             retryWhere:retryBlock
-                                      completionHandler:completionHandler];
+    // Session headers, overridden by the request headers
+    NSMutableDictionary *headers = [[self sessionHeaders] mutableCopy];
+    [headers addEntriesFromDictionary:request.headers];
+    urlRequest.allHTTPHeaderFields = headers;
 
-    [self.queue addOperation:operation];
+    // Lets the network metrics compare the body size before and after compression
+    if (request.uncompressedBodyLength) {
+        [NSURLProtocol setProperty:@(request.uncompressedBodyLength) forKey:UANetworkMetricsUncompressedBodyLengthKey inRequest:urlRequest];
+    }
+
+    return urlRequest;
 }
 
 - (void)cancelAllRequests {
-    [self.queue cancelAllOperations];
+    [self.queue cancelAllTasks];
+}
+
+- (UATask *)taskWithRequest:(UARequest *)request
+                    attempt:(NSUInteger)attempt
+                 retryWhere:(BOOL (^)(NSData *data, NSURLResponse *response))retryBlock
+          completionHandler:(void (^)(NSData *data, NSURLResponse *response, NSError *error))completionHandler {
+
+    return [UATask taskWithBlock:^(UATask *task) {
+        NSURLSessionTask *dataTask = [self.session dataTaskWithRequest:[self URLRequestWithRequest:request]
+                                                     completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+            if (!task.isCancelled) {
+                [self handleResponseWithRequest:request
+                                        attempt:attempt
+                                           data:data
+                                       response:response
+                                          error:error
+                                     retryWhere:retryBlock
+                              completionHandler:completionHandler];
+            }
+
+            [task finish];
+        }];
+
+        dataTask.priority = request.priority;
+        task.cancelBlock = ^{
+            [dataTask cancel];
+        };
+
+        [[UANetworkWindow shared] requestStarted];
+        [dataTask resume];
+    }];
 }
 
-- (NSOperation *)operationWithRequest:(NSURLRequest *)request
-                           retryDelay:(NSTimeInterval)retryDelay
-                           retryWhere:(BOOL (^)(NSData *data, NSURLResponse *response))retryBlock
-                    completionHandler:(void (^)(NSData *data, NSURLResponse *response, NSError *error))completionHandler {
+- (void)handleResponseWithRequest:(UARequest *)request
+                          attempt:(NSUInteger)attempt
+                             data:(NSData *)data
+                         response:(NSURLResponse *)response
+                            error:(NSError *)error
+                       retryWhere:(BOOL (^)(NSData *data, NSURLResponse *response))retryBlock
+                completionHandler:(void (^)(NSData *data, NSURLResponse *response, NSError *error))completionHandler {
+    NSString *host = request.URL.host;
+
+    [self.requestCounter increment];
+    if (error) {
+        [self.requestErrorCounter increment];
+    }
 
+    [self.encodingPolicy updateWithResponse:response host:host];
+
+    // Resend with gzip if the host rejected the body's encoding
+    UARequest *fallbackRequest = [request requestWithFallbackEncoding];
+    BOOL unsupportedMediaType = [response isKindOfClass:[NSHTTPURLResponse class]] && [(NSHTTPURLResponse *)response statusCode] == UnsupportedMediaTypeStatus;
+    if (fallbackRequest && unsupportedMediaType) {
+        UA_LDEBUG(@"Host %@ rejected %@ encoding, falling back to gzip", host, request.headers[@"Content-Encoding"]);
+        [self.encodingPolicy recordUnsupportedEncoding:request.headers[@"Content-Encoding"] forHost:host];
+        [self.queue addTask:[self taskWithRequest:fallbackRequest
+                                          attempt:attempt
+                                       retryWhere:retryBlock
+                                completionHandler:completionHandler]];
+        return;
+    }
 
-    UAURLRequestOperation *operation = [UAURLRequestOperation operationWithRequest:request
-                                                                           session:self.session
-                                                                 completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
+    if (error || !retryBlock || !retryBlock(data, response)) {
+        // Only a successful status shows the endpoint is healthy, other final responses leave the circuit as is
+        NSInteger status = [response isKindOfClass:[NSHTTPURLResponse class]] ? [(NSHTTPURLResponse *)response statusCode] : 0;
+        if (!error && status >= 200 && status <= 299) {
+            [self.retryPolicy recordSuccessForURL:request.URL];
+        }
 
-        if (!error && retryBlock && retryBlock(data, response)) {
-            UADelayOperation *delayOperation = [UADelayOperation operationWithDelayInSeconds:retryDelay];
-            NSOperation *retryOperation = [self operationWithRequest:request
-                                                          retryDelay:MIN(retryDelay * 2, MaxBackOff)
-                                                          retryWhere:retryBlock
-                                                   completionHandler:completionHandler];
+        completionHandler(data, response, error);
+        return;
+    }
 
-            [retryOperation addDependency:delayOperation];
+    [self.retryPolicy recordFailureForURL:request.URL];
 
-            [self.queue addOperation:delayOperation];
-            [self.queue addOperation:retryOperation];
+    // Give up once the attempts run out or the endpoint is failing for everyone
+    if (![self.retryPolicy shouldRetryAfterAttempt:attempt] || [self.retryPolicy isCircuitOpenForURL:request.URL]) {
+        UA_LDEBUG(@"Not retrying request to %@ after %lu attempts", host, (unsigned long)attempt);
+        completionHandler(data, response, error);
+        return;
+    }
 
-            return;
-        } else {
-            completionHandler(data, response, error);
-        }
+    [self.requestRetryCounter increment];
 
-    }];
-    
-    return operation;
+    UATask *retryTask = [self taskWithRequest:request
+                                      attempt:attempt + 1
+                                   retryWhere:retryBlock
+                            completionHandler:completionHandler];
+
+    [self.queue addTask:retryTask delay:[self.retryPolicy retryDelayAfterAttempt:attempt]];
 }
 
 
@@ -171,16 +171,16 @@
 - (UACustomEvent *)createEvent {
     UACustomEvent *event = [UACustomEvent eventWithName:self.eventName];
 
-    NSMutableDictionary *propertyDictionary = [NSMutableDictionary dictionary];
+    UACustomEventPropertiesBuilder *properties = [[UACustomEventPropertiesBuilder alloc] init];
     
     if (self.eventValue) {
         [event setEventValue:self.eventValue];
     }
 
     if (self.eventValue && [self.eventName isEqualToString:kUAPurchasedEvent]) {
-        [propertyDictionary setValue:@YES forKey:kUARetailEventTemplateLifetimeValue];
+        [properties setBool:YES forKey:kUARetailEventTemplateLifetimeValue];
     } else {
-       [propertyDictionary setValue:@NO forKey:kUARetailEventTemplateLifetimeValue];
+       [properties setBool:NO forKey:kUARetailEventTemplateLifetimeValue];
     }
 
     if (self.transactionID) {
@@ -188,34 +188,34 @@
     }
 
     if (self.identifier) {
-        [propertyDictionary setValue:self.identifier forKey:kUARetailEventTemplateIdentifier];
+        [properties setString:self.identifier forKey:kUARetailEventTemplateIdentifier];
     }
 
     if (self.category) {
-        [propertyDictionary setValue:self.category forKey:kUARetailEventTemplateCategory];
+        [properties setString:self.category forKey:kUARetailEventTemplateCategory];
     }
 
     if (self.eventDescription) {
-        [propertyDictionary setValue:self.eventDescription forKey:kUARetailEventTemplateDescription];
+        [properties setString:self.eventDescription forKey:kUARetailEventTemplateDescription];
     }
 
     if (self.brand) {
-        [propertyDictionary setValue:self.brand forKey:kUARetailEventTemplateBrand];
+        [properties setString:self.brand forKey:kUARetailEventTemplateBrand];
     }
 
     if (self.newItemSet) {
-        [propertyDictionary setValue:@(self.isNewItem) forKey:kUARetailEventTemplateNewItem];
+        [properties setBool:self.isNewItem forKey:kUARetailEventTemplateNewItem];
     }
     if (self.source) {
-        [propertyDictionary setValue:self.source forKey:kUARetailEventTemplateSource];
+        [properties setString:self.source forKey:kUARetailEventTemplateSource];
     }
 
     if (self.medium) {
-        [propertyDictionary setValue:self.medium forKey:kUARetailEventTemplateMedium];
+        [properties setString:self.medium forKey:kUARetailEventTemplateMedium];
     }
 
     event.templateType = kUARetailEventTemplate;
-    event.properties = propertyDictionary;
+    [event setPropertiesWithBuilder:properties];
     
     return event;
 }
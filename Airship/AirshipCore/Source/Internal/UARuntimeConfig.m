@@ -21,9 +21,14 @@
 @property (nonatomic, assign, getter=isChannelCaptureEnabled) BOOL channelCaptureEnabled;
 @property (nonatomic, assign, getter=isChannelCreationDelayEnabled) BOOL channelCreationDelayEnabled;
 @property (nonatomic, assign, getter=isExtendedBroadcastsEnabled) BOOL extendedBroadcastsEnabled;
+@property (nonatomic, assign, getter=isLazyMessageCenterEnabled) BOOL lazyMessageCenterEnabled;
 @property (nonatomic, copy) NSDictionary *customConfig;
 @property (nonatomic, assign) BOOL requestAuthorizationToUseNotifications;
 @property (nonatomic, assign, getter=isDataCollectionOptInEnabled) BOOL dataCollectionOptInEnabled;
+@property (nonatomic, assign) NSQualityOfService uploadQualityOfService;
+@property (nonatomic, assign) NSQualityOfService processingQualityOfService;
+@property (nonatomic, assign) NSQualityOfService maintenanceQualityOfService;
+@property (nonatomic, assign) NSQualityOfService displayQualityOfService;
 
 @property (nonatomic, copy) NSString *deviceAPIURL;
 @property (nonatomic, copy) NSString *analyticsURL;
@@ -79,9 +84,14 @@ NSString *const UARuntimeConfigEURemoteDataAPIURL = @"https://remote-data.asnapi
         self.customConfig = config.customConfig;
         self.channelCreationDelayEnabled = config.channelCreationDelayEnabled;
         self.extendedBroadcastsEnabled = config.extendedBroadcastsEnabled;
+        self.lazyMessageCenterEnabled = config.lazyMessageCenterEnabled;
         self.messageCenterStyleConfig = config.messageCenterStyleConfig;
         self.itunesID = config.itunesID;
         self.dataCollectionOptInEnabled = config.dataCollectionOptInEnabled;
+        self.uploadQualityOfService = config.uploadQualityOfService;
+        self.processingQualityOfService = config.processingQualityOfService;
+        self.maintenanceQualityOfService = config.maintenanceQualityOfService;
+        self.displayQualityOfService = config.displayQualityOfService;
     }
 
     return self;
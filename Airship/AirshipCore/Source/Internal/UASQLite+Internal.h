@@ -5,7 +5,29 @@
 NS_ASSUME_NONNULL_BEGIN
 
 /**
- * Interface wrapping sqlite database operations
+ * SQLite synchronous modes.
+ */
+typedef NS_ENUM(NSInteger, UASQLiteSynchronousMode) {
+    /**
+     * No syncs. Fastest, but a power loss can corrupt the database.
+     */
+    UASQLiteSynchronousModeOff = 0,
+
+    /**
+     * Syncs at critical moments. Safe from corruption in WAL mode, a power loss may roll back
+     * the latest transactions.
+     */
+    UASQLiteSynchronousModeNormal = 1,
+
+    /**
+     * Syncs on every commit. SQLite's default.
+     */
+    UASQLiteSynchronousModeFull = 2,
+};
+
+/**
+ * Interface wrapping sqlite database operations. Prepared statements are cached by SQL
+ * text for the lifetime of the connection.
  */
 @interface UASQLite : NSObject
 
@@ -43,6 +65,22 @@ NS_ASSUME_NONNULL_BEGIN
 - (BOOL)open:(NSString *)aDBPath;
 
 
+/**
+ * Switches the open DB to write-ahead logging, so commits append to a log instead of
+ * rewriting pages and readers do not block writers.
+ *
+ * @return YES if the DB is in WAL mode, NO otherwise
+ */
+- (BOOL)enableWriteAheadLogging;
+
+/**
+ * Sets the synchronous mode of the open DB.
+ *
+ * @param mode The synchronous mode.
+ * @return YES if successful NO if unsuccessful
+ */
+- (BOOL)setSynchronousMode:(UASQLiteSynchronousMode)mode;
+
 /**
  * Closes the sqlite DB
  */
@@ -97,6 +135,16 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (BOOL)executeUpdate:(NSString *)sql arguments:(nullable NSArray *)args;
 
+/**
+ * Executes an update once per argument array, reusing a single prepared statement. Wrap the
+ * call in a transaction to write all rows in one commit.
+ *
+ * @param sql Database string
+ * @param argumentsBatch Array of argument arrays
+ * @return YES if all updates succeeded, NO if an update failed. Updates before the failure are not rolled back.
+ */
+- (BOOL)executeUpdate:(NSString *)sql argumentsBatch:(NSArray<NSArray *> *)argumentsBatch;
+
 /**
  * Executes commit transaction on database
  *
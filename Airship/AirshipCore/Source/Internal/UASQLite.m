@@ -5,8 +5,12 @@
 
 #import <sqlite3.h>
 
+// Statements beyond this count are finalized after use instead of cached
+static NSUInteger const UASQLiteStatementCacheLimit = 32;
+
 @interface UASQLite ()
 @property(nonatomic, assign) sqlite3 *db;
+@property(nonatomic, strong) NSMutableDictionary<NSString *, NSValue *> *cachedStatements;
 @end
 
 
@@ -18,13 +22,14 @@
         self.busyRetryTimeout = 1;
         self.dbPath = nil;
         self.db = nil;
+        self.cachedStatements = [NSMutableDictionary dictionary];
     }
 
     return self;
 }
 
 - (instancetype)initWithDBPath:(NSString *)aDBPath {
-    self = [super init];
+    self = [self init];
     if (self) {
         [self open:aDBPath];
     }
@@ -49,9 +54,21 @@
     return YES;
 }
 
+- (BOOL)enableWriteAheadLogging {
+    NSArray *result = [self executeQuery:@"PRAGMA journal_mode=WAL"];
+    return [[result.firstObject[@"journal_mode"] lowercaseString] isEqualToString:@"wal"];
+}
+
+- (BOOL)setSynchronousMode:(UASQLiteSynchronousMode)mode {
+    return [self executeUpdate:[NSString stringWithFormat:@"PRAGMA synchronous=%ld", (long)mode]];
+}
+
 - (void)close {
     if (self.db == nil) return;
 
+    // Open statements keep the connection busy
+    [self finalizeCachedStatements];
+
     int numOfRetries = 0;
     int rc;
 
@@ -109,6 +126,42 @@
     return NO;
 }
 
+- (nullable sqlite3_stmt *)statementForSql:(NSString *)sql cached:(BOOL *)cached {
+    sqlite3_stmt *stmt = [self.cachedStatements[sql] pointerValue];
+    if (stmt) {
+        *cached = YES;
+        return stmt;
+    }
+
+    if (![self prepareSql:sql inStatament:&stmt]) {
+        return NULL;
+    }
+
+    *cached = self.cachedStatements.count < UASQLiteStatementCacheLimit;
+    if (*cached) {
+        self.cachedStatements[sql] = [NSValue valueWithPointer:stmt];
+    }
+
+    return stmt;
+}
+
+- (void)finishStatement:(sqlite3_stmt *)stmt cached:(BOOL)cached {
+    if (cached) {
+        // Resetting releases any read lock held by the statement
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+    } else {
+        sqlite3_finalize(stmt);
+    }
+}
+
+- (void)finalizeCachedStatements {
+    for (NSValue *value in self.cachedStatements.allValues) {
+        sqlite3_finalize([value pointerValue]);
+    }
+    [self.cachedStatements removeAllObjects];
+}
+
 - (BOOL)executeStatament:(sqlite3_stmt *)stmt {
     int numOfRetries = 0;
     int rc;
@@ -147,6 +200,10 @@
             sqlite3_bind_int64(stmt, idx, [obj longValue]);
         } else if (!strcmp([obj objCType], @encode(long))) {
             sqlite3_bind_int64(stmt, idx, [obj longValue]);
+        } else if (!strcmp([obj objCType], @encode(long long))) {
+            sqlite3_bind_int64(stmt, idx, [obj longLongValue]);
+        } else if (!strcmp([obj objCType], @encode(unsigned long)) || !strcmp([obj objCType], @encode(unsigned long long))) {
+            sqlite3_bind_int64(stmt, idx, (sqlite3_int64)[obj unsignedLongLongValue]);
         } else if (!strcmp([obj objCType], @encode(float))) {
             sqlite3_bind_double(stmt, idx, [obj floatValue]);
         } else if (!strcmp([obj objCType], @encode(double))) {
@@ -193,7 +250,7 @@
         return([NSNull null]);
 
     if (columnType == SQLITE_INTEGER)
-        return [NSNumber numberWithInt:sqlite3_column_int(stmt, (int)index)];
+        return [NSNumber numberWithLongLong:sqlite3_column_int64(stmt, (int)index)];
 
     if (columnType == SQLITE_FLOAT)
         return [NSNumber numberWithDouble:sqlite3_column_double(stmt, (int)index)];
@@ -250,9 +307,10 @@
 }
 
 - (NSArray *)executeQuery:(NSString *)sql arguments:(NSArray *)args {
-    sqlite3_stmt *sqlStmt;
+    BOOL cached;
+    sqlite3_stmt *sqlStmt = [self statementForSql:sql cached:&cached];
 
-    if (![self prepareSql:sql inStatament:(&sqlStmt)])
+    if (!sqlStmt)
         return nil;
 
     int i = 1;
@@ -261,7 +319,7 @@
         [self bindObject:[args objectAtIndex:(NSUInteger)(i - 1)] toColumn:i inStatament:sqlStmt];
 
     NSArray *result = [self convertResultSet:sqlStmt];
-    sqlite3_finalize(sqlStmt);
+    [self finishStatement:sqlStmt cached:cached];
 
     return result;
 }
@@ -292,19 +350,38 @@
 }
 
 - (BOOL)executeUpdate:(NSString *)sql arguments:(NSArray *)args {
-    sqlite3_stmt *sqlStmt;
+    return [self executeUpdate:sql argumentsBatch:@[args ?: @[]]];
+}
 
-    if (![self prepareSql:sql inStatament:(&sqlStmt)])
+- (BOOL)executeUpdate:(NSString *)sql argumentsBatch:(NSArray<NSArray *> *)argumentsBatch {
+    BOOL cached;
+    sqlite3_stmt *sqlStmt = [self statementForSql:sql cached:&cached];
+
+    if (!sqlStmt)
         return NO;
 
-    int i = 1;
     int queryParamCount = sqlite3_bind_parameter_count(sqlStmt);
-    for (; i<=queryParamCount; i++)
-        [self bindObject:[args objectAtIndex:(NSUInteger)(i - 1)] toColumn:i inStatament:sqlStmt];
+    BOOL success = YES;
 
-    BOOL success = [self executeStatament:sqlStmt];
+    for (NSArray *args in argumentsBatch) {
+        if (args.count < (NSUInteger)queryParamCount) {
+            UA_LDEBUG(@"Update failed. Expected %d arguments, got %lu.", queryParamCount, (unsigned long)args.count);
+            success = NO;
+            break;
+        }
+
+        for (int i = 1; i<=queryParamCount; i++)
+            [self bindObject:[args objectAtIndex:(NSUInteger)(i - 1)] toColumn:i inStatament:sqlStmt];
+
+        if (![self executeStatament:sqlStmt]) {
+            success = NO;
+            break;
+        }
+
+        sqlite3_reset(sqlStmt);
+    }
 
-    sqlite3_finalize(sqlStmt);
+    [self finishStatement:sqlStmt cached:cached];
     return success;
 }
 
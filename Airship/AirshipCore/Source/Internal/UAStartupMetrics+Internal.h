@@ -0,0 +1,80 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A measured startup step.
+ */
+@interface UAStartupMeasurement : NSObject
+
+/**
+ * The step name.
+ */
+@property (nonatomic, copy, readonly) NSString *name;
+
+/**
+ * How long the step took, in seconds.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval duration;
+
+@end
+
+/**
+ * Measures the steps of takeOff. Each step is recorded as an `os_signpost` interval in the
+ * `com.urbanairship` subsystem's `Startup` category, so it shows up in Instruments, and is
+ * kept in a report for the current launch.
+ */
+@interface UAStartupMetrics : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Startup Metrics Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * The shared startup metrics.
+ */
++ (instancetype)shared;
+
+/**
+ * Runs and measures a startup step.
+ *
+ * @param name The step name.
+ * @param block The step.
+ */
+- (void)measure:(NSString *)name block:(void (^)(void))block;
+
+/**
+ * Begins measuring a step that finishes asynchronously. Only the first interval with a given
+ * name is measured per launch, later calls are ignored.
+ *
+ * @param name The step name.
+ */
+- (void)beginInterval:(NSString *)name;
+
+/**
+ * Ends an interval started with `beginInterval:`. Ignored if the interval is not in progress.
+ *
+ * @param name The step name.
+ */
+- (void)endInterval:(NSString *)name;
+
+/**
+ * A one line summary of the measured steps, for logging.
+ */
+@property (nonatomic, copy, readonly) NSString *summary;
+
+/**
+ * The measured steps, in the order they finished.
+ */
+@property (nonatomic, copy, readonly) NSArray<UAStartupMeasurement *> *measurements;
+
+/**
+ * Clears the measured steps.
+ */
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,135 @@
+/* Copyright Airship and Contributors */
+
+#import "UAStartupMetrics+Internal.h"
+
+#import <os/signpost.h>
+
+@interface UAStartupMeasurement ()
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, assign) NSTimeInterval duration;
+@end
+
+@implementation UAStartupMeasurement
+
++ (instancetype)measurementWithName:(NSString *)name duration:(NSTimeInterval)duration {
+    UAStartupMeasurement *measurement = [[self alloc] init];
+    measurement.name = name;
+    measurement.duration = duration;
+    return measurement;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"%@: %.1fms", self.name, self.duration * 1000];
+}
+
+@end
+
+@interface UAStartupMetrics ()
+@property (nonatomic, strong) NSMutableArray<UAStartupMeasurement *> *recordedMeasurements;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSArray<NSNumber *> *> *openIntervals;
+@property (nonatomic, strong) NSMutableSet<NSString *> *startedIntervals;
+@property (nonatomic, strong) os_log_t log;
+@end
+
+@implementation UAStartupMetrics
+
+- (instancetype)init {
+    self = [super init];
+
+    if (self) {
+        self.recordedMeasurements = [NSMutableArray array];
+        self.openIntervals = [NSMutableDictionary dictionary];
+        self.startedIntervals = [NSMutableSet set];
+        self.log = os_log_create("com.urbanairship", "Startup");
+    }
+
+    return self;
+}
+
++ (instancetype)shared {
+    static UAStartupMetrics *shared;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        shared = [[self alloc] init];
+    });
+
+    return shared;
+}
+
+- (void)measure:(NSString *)name block:(void (^)(void))block {
+    NSTimeInterval start = [NSProcessInfo processInfo].systemUptime;
+
+    if (@available(iOS 12.0, tvOS 12.0, *)) {
+        os_signpost_id_t signpostID = os_signpost_id_generate(self.log);
+        os_signpost_interval_begin(self.log, signpostID, "Startup", "%{public}@", name);
+        block();
+        os_signpost_interval_end(self.log, signpostID, "Startup", "%{public}@", name);
+    } else {
+        block();
+    }
+
+    NSTimeInterval duration = [NSProcessInfo processInfo].systemUptime - start;
+    @synchronized (self) {
+        [self.recordedMeasurements addObject:[UAStartupMeasurement measurementWithName:name duration:duration]];
+    }
+}
+
+- (void)beginInterval:(NSString *)name {
+    os_signpost_id_t signpostID = 0;
+
+    @synchronized (self) {
+        if ([self.startedIntervals containsObject:name]) {
+            return;
+        }
+        [self.startedIntervals addObject:name];
+
+        if (@available(iOS 12.0, tvOS 12.0, *)) {
+            signpostID = os_signpost_id_generate(self.log);
+        }
+
+        self.openIntervals[name] = @[@([NSProcessInfo processInfo].systemUptime), @(signpostID)];
+    }
+
+    if (@available(iOS 12.0, tvOS 12.0, *)) {
+        os_signpost_interval_begin(self.log, signpostID, "Startup", "%{public}@", name);
+    }
+}
+
+- (void)endInterval:(NSString *)name {
+    NSArray<NSNumber *> *interval;
+
+    @synchronized (self) {
+        interval = self.openIntervals[name];
+        if (!interval) {
+            return;
+        }
+        [self.openIntervals removeObjectForKey:name];
+
+        NSTimeInterval duration = [NSProcessInfo processInfo].systemUptime - [interval[0] doubleValue];
+        [self.recordedMeasurements addObject:[UAStartupMeasurement measurementWithName:name duration:duration]];
+    }
+
+    if (@available(iOS 12.0, tvOS 12.0, *)) {
+        os_signpost_interval_end(self.log, [interval[1] unsignedLongLongValue], "Startup", "%{public}@", name);
+    }
+}
+
+- (NSString *)summary {
+    return [[self.measurements valueForKey:@"description"] componentsJoinedByString:@", "];
+}
+
+- (NSArray<UAStartupMeasurement *> *)measurements {
+    @synchronized (self) {
+        return [self.recordedMeasurements copy];
+    }
+}
+
+- (void)reset {
+    @synchronized (self) {
+        [self.recordedMeasurements removeAllObjects];
+        [self.openIntervals removeAllObjects];
+        [self.startedIntervals removeAllObjects];
+    }
+}
+
+@end
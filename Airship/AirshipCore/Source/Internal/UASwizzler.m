@@ -4,9 +4,22 @@
 #import "UASwizzler+Internal.h"
 #import <objc/runtime.h>
 
-@interface UASwizzler()
+/**
+ * An original implementation, keyed by its selector.
+ */
+typedef struct {
+    SEL selector;
+    IMP implementation;
+} UASwizzlerOriginalMethod;
+
+@interface UASwizzler() {
+    // Only a handful of selectors are swizzled per class, so a linear scan comparing
+    // selector pointers beats hashing a selector string on every forwarded call
+    UASwizzlerOriginalMethod *_originalMethods;
+    NSUInteger _originalMethodCount;
+    NSUInteger _originalMethodCapacity;
+}
 @property (nonatomic, assign) Class class;
-@property (nonatomic, strong) NSMutableDictionary *originalMethods;
 @end
 
 @implementation UASwizzler
@@ -16,12 +29,15 @@
 
     if (self) {
         self.class = class;
-        self.originalMethods = [NSMutableDictionary dictionary];
     }
 
     return self;
 }
 
+- (void)dealloc {
+    free(_originalMethods);
+}
+
 + (instancetype)swizzlerForClass:(Class)class {
     return [[UASwizzler alloc] initWithClass:class];
 }
@@ -55,10 +71,10 @@
 }
 
 - (void)unswizzle {
-    for (NSString *selectorString in [self.originalMethods allKeys]) {
-        SEL selector = NSSelectorFromString(selectorString);
+    for (NSUInteger i = 0; i < _originalMethodCount; i++) {
+        SEL selector = _originalMethods[i].selector;
         Method method = class_getInstanceMethod(self.class, selector);
-        IMP originalImplementation = [self originalImplementation:selector];
+        IMP originalImplementation = _originalMethods[i].implementation;
 
         if (originalImplementation) {
             UA_LTRACE(@"Unswizzling implementation for %@ class %@", NSStringFromSelector(selector), self.class);
@@ -66,25 +82,40 @@
         }
     }
 
-    [self.originalMethods removeAllObjects];
+    _originalMethodCount = 0;
 }
 
 - (void)storeOriginalImplementation:(IMP)implementation selector:(SEL)selector {
-    NSString *selectorString = NSStringFromSelector(selector);
-    self.originalMethods[selectorString] = [NSValue valueWithPointer:implementation];
+    for (NSUInteger i = 0; i < _originalMethodCount; i++) {
+        if (sel_isEqual(_originalMethods[i].selector, selector)) {
+            _originalMethods[i].implementation = implementation;
+            return;
+        }
+    }
+
+    if (_originalMethodCount == _originalMethodCapacity) {
+        _originalMethodCapacity = _originalMethodCapacity ? _originalMethodCapacity * 2 : 4;
+        _originalMethods = reallocf(_originalMethods, _originalMethodCapacity * sizeof(UASwizzlerOriginalMethod));
+        if (!_originalMethods) {
+            _originalMethodCount = 0;
+            _originalMethodCapacity = 0;
+            return;
+        }
+    }
+
+    _originalMethods[_originalMethodCount].selector = selector;
+    _originalMethods[_originalMethodCount].implementation = implementation;
+    _originalMethodCount++;
 }
 
 - (IMP)originalImplementation:(SEL)selector {
-    NSString *selectorString = NSStringFromSelector(selector);
-
-    NSValue *value = self.originalMethods[selectorString];
-    if (!value) {
-        return nil;
+    for (NSUInteger i = 0; i < _originalMethodCount; i++) {
+        if (sel_isEqual(_originalMethods[i].selector, selector)) {
+            return _originalMethods[i].implementation;
+        }
     }
 
-    IMP implementation;
-    [value getValue:&implementation];
-    return implementation;
+    return nil;
 }
 
 @end
@@ -0,0 +1,40 @@
+/* Copyright Airship and Contributors */
+
+#import "UATagEditor.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*
+ * SDK-private extensions to UATagEditor
+ */
+@interface UATagEditor ()
+
+///---------------------------------------------------------------------------------------
+/// @name Tag Editor Internal Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The edited tags.
+ */
+@property (nonatomic, readonly) NSOrderedSet<NSString *> *tags;
+
+/**
+ * Whether any edit changed the tags.
+ */
+@property (nonatomic, readonly, getter=isModified) BOOL modified;
+
+///---------------------------------------------------------------------------------------
+/// @name Tag Editor Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method.
+ *
+ * @param tags The current tags.
+ * @return A tag editor instance.
+ */
++ (instancetype)editorWithTags:(NSOrderedSet<NSString *> *)tags;
+
+@end
+
+NS_ASSUME_NONNULL_END
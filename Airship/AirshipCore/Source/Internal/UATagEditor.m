@@ -0,0 +1,61 @@
+/* Copyright Airship and Contributors */
+
+#import "UATagEditor+Internal.h"
+#import "UATagUtils+Internal.h"
+
+@interface UATagEditor ()
+@property (nonatomic, strong) NSMutableOrderedSet<NSString *> *editedTags;
+@property (nonatomic, copy) NSOrderedSet<NSString *> *originalTags;
+@end
+
+@implementation UATagEditor
+
+- (instancetype)initWithTags:(NSOrderedSet<NSString *> *)tags {
+    self = [super init];
+
+    if (self) {
+        self.originalTags = tags;
+        self.editedTags = [tags mutableCopy];
+    }
+
+    return self;
+}
+
++ (instancetype)editorWithTags:(NSOrderedSet<NSString *> *)tags {
+    return [[self alloc] initWithTags:tags];
+}
+
+- (void)addTag:(NSString *)tag {
+    [self addTags:@[tag]];
+}
+
+- (void)addTags:(NSArray<NSString *> *)tags {
+    [self.editedTags addObjectsFromArray:[UATagUtils normalizeTags:tags]];
+}
+
+- (void)removeTag:(NSString *)tag {
+    [self removeTags:@[tag]];
+}
+
+- (void)removeTags:(NSArray<NSString *> *)tags {
+    [self.editedTags removeObjectsInArray:tags];
+}
+
+- (void)setTags:(NSArray<NSString *> *)tags {
+    [self.editedTags removeAllObjects];
+    [self addTags:tags];
+}
+
+- (void)removeAllTags {
+    [self.editedTags removeAllObjects];
+}
+
+- (NSOrderedSet<NSString *> *)tags {
+    return [self.editedTags copy];
+}
+
+- (BOOL)isModified {
+    return ![self.editedTags isEqualToOrderedSet:self.originalTags];
+}
+
+@end
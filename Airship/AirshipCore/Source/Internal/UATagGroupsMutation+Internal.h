@@ -32,6 +32,39 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (NSDictionary *)applyToTagGroups:(NSDictionary *)tagGroups;
 
+/**
+ * Folds the mutation into collapsed tag group state. Only the groups in the mutation are touched.
+ *
+ * @param addTagGroups The collapsed tags to add, by group.
+ * @param removeTagGroups The collapsed tags to remove, by group.
+ * @param setTagGroups The collapsed tags to set, by group.
+ */
+- (void)foldIntoAddTagGroups:(NSMutableDictionary<NSString *, NSMutableSet *> *)addTagGroups
+             removeTagGroups:(NSMutableDictionary<NSString *, NSMutableSet *> *)removeTagGroups
+                setTagGroups:(NSMutableDictionary<NSString *, NSMutableSet *> *)setTagGroups;
+
+/**
+ * Builds the collapsed mutations for collapsed tag group state. The set mutation, if any, comes first.
+ *
+ * @param addTagGroups The collapsed tags to add, by group.
+ * @param removeTagGroups The collapsed tags to remove, by group.
+ * @param setTagGroups The collapsed tags to set, by group.
+ * @return An array of at most two mutations.
+ */
++ (NSArray<UATagGroupsMutation *> *)mutationsWithAddTagGroups:(NSDictionary<NSString *, NSSet *> *)addTagGroups
+                                              removeTagGroups:(NSDictionary<NSString *, NSSet *> *)removeTagGroups
+                                                 setTagGroups:(NSDictionary<NSString *, NSSet *> *)setTagGroups;
+
+/**
+ * The number of tags in the mutation, across all of its groups.
+ */
+- (NSUInteger)tagCount;
+
+/**
+ * The groups the mutation adds to, removes from or sets.
+ */
+- (NSSet<NSString *> *)groups;
+
 /**
  * Compares tag group mutations for equality by payload value.
  *
@@ -141,90 +141,135 @@
     NSMutableDictionary *setTagGroups = [NSMutableDictionary dictionary];
 
     for (UATagGroupsMutation *mutation in mutations) {
+        [mutation foldIntoAddTagGroups:addTagGroups removeTagGroups:removeTagGroups setTagGroups:setTagGroups];
+    }
 
-        // Add tags
-        for (NSString *group in mutation.addTagGroups) {
+    return [UATagGroupsMutation mutationsWithAddTagGroups:addTagGroups
+                                          removeTagGroups:removeTagGroups
+                                             setTagGroups:setTagGroups];
+}
 
-            NSMutableSet *tags = [mutation.addTagGroups[group] mutableCopy];
+- (void)foldIntoAddTagGroups:(NSMutableDictionary<NSString *, NSMutableSet *> *)addTagGroups
+             removeTagGroups:(NSMutableDictionary<NSString *, NSMutableSet *> *)removeTagGroups
+                setTagGroups:(NSMutableDictionary<NSString *, NSMutableSet *> *)setTagGroups {
 
-            // Add to the set tag groups if we can
-            if (setTagGroups[group]) {
-                [setTagGroups[group] unionSet:tags];
-                continue;
-            }
+    // Add tags
+    for (NSString *group in self.addTagGroups) {
 
-            // Remove from remove tag groups
-            [removeTagGroups[group] minusSet:tags];
-            if (![removeTagGroups[group] count]) {
-                [removeTagGroups removeObjectForKey:group];
-            }
+        NSMutableSet *tags = [self mutableTagSet:self.addTagGroups[group]];
 
-            // Add to the add tag groups
-            if (!addTagGroups[group]) {
-                addTagGroups[group] = tags;
-            } else {
-                [addTagGroups[group] unionSet:tags];
-            }
+        // Add to the set tag groups if we can
+        if (setTagGroups[group]) {
+            [setTagGroups[group] unionSet:tags];
+            continue;
         }
 
-        // Remove tags
-        for (NSString *group in mutation.removeTagGroups) {
-            NSMutableSet *tags = [mutation.removeTagGroups[group] mutableCopy];
+        // Remove from remove tag groups
+        [removeTagGroups[group] minusSet:tags];
+        if (![removeTagGroups[group] count]) {
+            [removeTagGroups removeObjectForKey:group];
+        }
 
-            // Remove to the set tag groups if we can
-            if (setTagGroups[group]) {
-                [setTagGroups[group] minusSet:tags];
-                break;
-            }
+        // Add to the add tag groups
+        if (!addTagGroups[group]) {
+            addTagGroups[group] = tags;
+        } else {
+            [addTagGroups[group] unionSet:tags];
+        }
+    }
 
-            // Remove from add tag groups
-            [addTagGroups[group] minusSet:tags];
-            if (![addTagGroups[group] count]) {
-                [addTagGroups removeObjectForKey:group];
-            }
+    // Remove tags
+    for (NSString *group in self.removeTagGroups) {
+        NSMutableSet *tags = [self mutableTagSet:self.removeTagGroups[group]];
 
-            // Add to the remove tag groups
-            if (!removeTagGroups[group]) {
-                removeTagGroups[group] = tags;
-            } else {
-                [removeTagGroups[group] unionSet:tags];
-            }
+        // Remove to the set tag groups if we can
+        if (setTagGroups[group]) {
+            [setTagGroups[group] minusSet:tags];
+            continue;
         }
 
-        // Set tags
-        for (NSString *group in mutation.setTagGroups) {
+        // Remove from add tag groups
+        [addTagGroups[group] minusSet:tags];
+        if (![addTagGroups[group] count]) {
+            [addTagGroups removeObjectForKey:group];
+        }
 
-            NSMutableSet *tags = [mutation.setTagGroups[group] mutableCopy];
+        // Add to the remove tag groups
+        if (!removeTagGroups[group]) {
+            removeTagGroups[group] = tags;
+        } else {
+            [removeTagGroups[group] unionSet:tags];
+        }
+    }
 
-            // Add to the set tags group
-            setTagGroups[group] = tags;
+    // Set tags
+    for (NSString *group in self.setTagGroups) {
 
-            // Remove from the other groups
-            [removeTagGroups removeObjectForKey:group];
-            [addTagGroups removeObjectForKey:group];
-        }
+        NSMutableSet *tags = [self mutableTagSet:self.setTagGroups[group]];
+
+        // Add to the set tags group
+        setTagGroups[group] = tags;
+
+        // Remove from the other groups
+        [removeTagGroups removeObjectForKey:group];
+        [addTagGroups removeObjectForKey:group];
     }
+}
 
++ (NSArray<UATagGroupsMutation *> *)mutationsWithAddTagGroups:(NSDictionary<NSString *, NSSet *> *)addTagGroups
+                                              removeTagGroups:(NSDictionary<NSString *, NSSet *> *)removeTagGroups
+                                                 setTagGroups:(NSDictionary<NSString *, NSSet *> *)setTagGroups {
     NSMutableArray *collapsedMutations = [NSMutableArray array];
 
     // Set must be a separate mutation
     if (setTagGroups.count) {
         UATagGroupsMutation *mutation = [[UATagGroupsMutation alloc] init];
-        mutation.setTagGroups = setTagGroups;
+        mutation.setTagGroups = [UATagGroupsMutation snapshotOfTagGroups:setTagGroups];
         [collapsedMutations addObject:mutation];
     }
 
     // Add and remove can be collapsed into one mutation
     if (addTagGroups.count || removeTagGroups.count) {
         UATagGroupsMutation *mutation = [[UATagGroupsMutation alloc] init];
-        mutation.removeTagGroups = removeTagGroups;
-        mutation.addTagGroups = addTagGroups;
+        mutation.removeTagGroups = [UATagGroupsMutation snapshotOfTagGroups:removeTagGroups];
+        mutation.addTagGroups = [UATagGroupsMutation snapshotOfTagGroups:addTagGroups];
         [collapsedMutations addObject:mutation];
     }
 
     return [collapsedMutations copy];
 }
 
+/**
+ * Copies a dictionary of tag groups so later changes to its mutable sets are not shared.
+ * @param tagGroups A tag group.
+ * @returns A copy with immutable sets.
+ */
++ (NSDictionary *)snapshotOfTagGroups:(NSDictionary<NSString *, NSSet *> *)tagGroups {
+    NSMutableDictionary *snapshot = [NSMutableDictionary dictionaryWithCapacity:tagGroups.count];
+    for (NSString *group in tagGroups) {
+        snapshot[group] = [tagGroups[group] copy];
+    }
+    return snapshot;
+}
+
+- (NSUInteger)tagCount {
+    NSUInteger count = 0;
+    for (NSDictionary *tagGroups in @[self.addTagGroups ?: @{}, self.removeTagGroups ?: @{}, self.setTagGroups ?: @{}]) {
+        for (NSString *group in tagGroups) {
+            count += [tagGroups[group] count];
+        }
+    }
+    return count;
+}
+
+- (NSSet<NSString *> *)groups {
+    NSMutableSet *groups = [NSMutableSet set];
+    [groups addObjectsFromArray:self.addTagGroups.allKeys ?: @[]];
+    [groups addObjectsFromArray:self.removeTagGroups.allKeys ?: @[]];
+    [groups addObjectsFromArray:self.setTagGroups.allKeys ?: @[]];
+    return groups;
+}
+
 /**
  * Normalizes a dictionary of tag groups. Converts any arrays to sets.
  * @param tagGroups A tag group.
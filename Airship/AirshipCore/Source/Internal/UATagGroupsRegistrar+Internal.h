@@ -8,6 +8,7 @@
 #import "UATagGroupsAPIClient+Internal.h"
 #import "UAComponent+Internal.h"
 #import "UATagGroupsMutation+Internal.h"
+#import "UADispatcher.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -65,6 +66,21 @@ NS_ASSUME_NONNULL_BEGIN
                                                  apiClient:(UATagGroupsAPIClient *)apiClient
                                                application:(UIApplication *)application;
 
+/**
+ * Factory method to create a tag groups registrar. Used for testing.
+ * @param pendingTagGroupStore The pending tag group store.
+ * @param apiClient The internal tag groups API client.
+ * @param application The application.
+ * @param dispatcher The dispatcher used to wait out the batch delay.
+ * @param batchDelay How long an update waits for more mutations before uploading.
+ * @return A new tag groups registrar instance.
+ */
++ (instancetype)tagGroupsRegistrarWithPendingTagGroupStore:(UAPendingTagGroupStore *)pendingTagGroupStore
+                                                 apiClient:(UATagGroupsAPIClient *)apiClient
+                                               application:(UIApplication *)application
+                                                dispatcher:(UADispatcher *)dispatcher
+                                                batchDelay:(NSTimeInterval)batchDelay;
+
 /**
  * Factory method to create a channel tag groups registrar.
  * @param config The runtime config.
@@ -82,7 +98,9 @@ NS_ASSUME_NONNULL_BEGIN
 + (instancetype)namedUserTagGroupsRegistrarWithConfig:(UARuntimeConfig *)config dataStore:(UAPreferenceDataStore *)dataStore;
 
 /**
- * Update the tag groups.
+ * Update the tag groups. Pending mutations are collapsed before uploading, so all pending adds and
+ * removes are uploaded in a single request. Mutations made shortly after the update starts are
+ * included in the same upload.
  */
 - (void)updateTagGroups;
 
@@ -7,6 +7,10 @@
 #import "UATagUtils+Internal.h"
 #import "UAAsyncOperation.h"
 #import "UAPendingTagGroupStore+Internal.h"
+#import "UAMetricsRegistry.h"
+
+// Time to wait for more mutations so a burst of changes is uploaded together
+static NSTimeInterval const UATagGroupsRegistrarBatchDelay = 1;
 
 @interface UATagGroupsRegistrar()
 
@@ -35,6 +39,21 @@
  */
 @property (atomic, assign) BOOL updating;
 
+/**
+ * The dispatcher used to wait out the batch delay.
+ */
+@property (nonatomic, strong) UADispatcher *dispatcher;
+
+/**
+ * How long an update waits for more mutations before uploading.
+ */
+@property (nonatomic, assign) NSTimeInterval batchDelay;
+
+/**
+ * Disposable for the pending batch upload.
+ */
+@property (atomic, strong, nullable) UADisposable *batchDisposable;
+
 @end
 
 @implementation UATagGroupsRegistrar
@@ -43,13 +62,17 @@
 
 - (instancetype)initWithPendingTagGroupStore:(UAPendingTagGroupStore *)pendingTagGroupStore
                                    apiClient:(UATagGroupsAPIClient *)apiClient
-                                 application:application {
+                                 application:(UIApplication *)application
+                                  dispatcher:(UADispatcher *)dispatcher
+                                  batchDelay:(NSTimeInterval)batchDelay {
     
     self = [super init];
 
     if (self) {
         self.enabled = YES;
         self.application = application;
+        self.dispatcher = dispatcher;
+        self.batchDelay = batchDelay;
         self.pendingTagGroupStore = pendingTagGroupStore;
         self.tagGroupsAPIClient = apiClient;
     }
@@ -61,9 +84,24 @@
                                                  apiClient:(UATagGroupsAPIClient *)client
                                                application:(UIApplication *)application {
 
-    return [[self alloc] initWithPendingTagGroupStore:(UAPendingTagGroupStore *)pendingTagGroupStore
+    return [[self alloc] initWithPendingTagGroupStore:pendingTagGroupStore
                                             apiClient:client
-                                          application:application];
+                                          application:application
+                                           dispatcher:[UADispatcher globalDispatcherForWorkType:UADispatcherWorkTypeUpload]
+                                           batchDelay:0];
+}
+
++ (instancetype)tagGroupsRegistrarWithPendingTagGroupStore:(UAPendingTagGroupStore *)pendingTagGroupStore
+                                                 apiClient:(UATagGroupsAPIClient *)client
+                                               application:(UIApplication *)application
+                                                dispatcher:(UADispatcher *)dispatcher
+                                                batchDelay:(NSTimeInterval)batchDelay {
+
+    return [[self alloc] initWithPendingTagGroupStore:pendingTagGroupStore
+                                            apiClient:client
+                                          application:application
+                                           dispatcher:dispatcher
+                                           batchDelay:batchDelay];
 }
 
 + (instancetype)channelTagGroupsRegistrarWithConfig:(UARuntimeConfig *)config dataStore:(UAPreferenceDataStore *)dataStore {
@@ -71,9 +109,13 @@
     UAPendingTagGroupStore *pendingTagGroupStore = [UAPendingTagGroupStore channelHistoryWithDataStore:dataStore];
     UATagGroupsAPIClient *client =  [UATagGroupsAPIClient channelClientWithConfig:config];
 
-    return [[self alloc] initWithPendingTagGroupStore:pendingTagGroupStore
-                                            apiClient:client
-                                          application:[UIApplication sharedApplication]];
+    UATagGroupsRegistrar *registrar = [[self alloc] initWithPendingTagGroupStore:pendingTagGroupStore
+                                                                       apiClient:client
+                                                                     application:[UIApplication sharedApplication]
+                                                                      dispatcher:[UADispatcher globalDispatcherForWorkType:UADispatcherWorkTypeUpload]
+                                                                      batchDelay:UATagGroupsRegistrarBatchDelay];
+    [registrar registerPendingMutationsMetric:UAMetricChannelPendingTagMutations];
+    return registrar;
 }
 
 + (instancetype)namedUserTagGroupsRegistrarWithConfig:(UARuntimeConfig *)config dataStore:(UAPreferenceDataStore *)dataStore {
@@ -81,9 +123,21 @@
     UAPendingTagGroupStore *pendingTagGroupStore = [UAPendingTagGroupStore namedUserHistoryWithDataStore:dataStore];
     UATagGroupsAPIClient *client =  [UATagGroupsAPIClient namedUserClientWithConfig:config];
 
-    return [[self alloc] initWithPendingTagGroupStore:pendingTagGroupStore
-                                            apiClient:client
-                                          application:[UIApplication sharedApplication]];
+    UATagGroupsRegistrar *registrar = [[self alloc] initWithPendingTagGroupStore:pendingTagGroupStore
+                                                                       apiClient:client
+                                                                     application:[UIApplication sharedApplication]
+                                                                      dispatcher:[UADispatcher globalDispatcherForWorkType:UADispatcherWorkTypeUpload]
+                                                                      batchDelay:UATagGroupsRegistrarBatchDelay];
+    [registrar registerPendingMutationsMetric:UAMetricNamedUserPendingTagMutations];
+    return registrar;
+}
+
+- (void)registerPendingMutationsMetric:(NSString *)name {
+    UA_WEAKIFY(self)
+    [[UAMetricsRegistry shared] registerGaugeForMetric:name block:^double{
+        UA_STRONGIFY(self)
+        return self.pendingTagGroupStore.pendingMutations.count;
+    }];
 }
 
 - (void)updateTagGroups {
@@ -107,8 +161,19 @@
         [self endUploading:backgroundTaskIdentifier];
         return;
     }
-    
-    [self uploadNextTagGroupMutationWithBackgroundTaskIdentifier:backgroundTaskIdentifier];
+
+    if (self.batchDelay <= 0) {
+        [self uploadNextTagGroupMutationWithBackgroundTaskIdentifier:backgroundTaskIdentifier];
+        return;
+    }
+
+    // Mutations made during the delay are collapsed into the same upload
+    UA_WEAKIFY(self);
+    self.batchDisposable = [self.dispatcher dispatchAfter:self.batchDelay block:^{
+        UA_STRONGIFY(self);
+        self.batchDisposable = nil;
+        [self uploadNextTagGroupMutationWithBackgroundTaskIdentifier:backgroundTaskIdentifier];
+    }];
 }
 
 - (void)popPendingMutation:(UATagGroupsMutation *)mutation identifier:(NSString *)identifier {
@@ -168,6 +233,8 @@
         UA_STRONGIFY(self);
 
         UA_LTRACE(@"Tag groups background task expired.");
+        [self.batchDisposable dispose];
+        self.batchDisposable = nil;
         [self.tagGroupsAPIClient cancelAllRequests];
 
         [self endUploading:backgroundTaskIdentifier];
@@ -9,7 +9,7 @@
 @implementation UATagUtils
 
 + (NSArray *)normalizeTags:(NSArray *)tags {
-    NSMutableSet *normalizedTags = [NSMutableSet set];
+    NSMutableOrderedSet *normalizedTags = [NSMutableOrderedSet orderedSet];
 
     for (NSString *tag in tags) {
 
@@ -22,7 +22,7 @@
         }
     }
 
-    return [normalizedTags allObjects];
+    return [normalizedTags array];
 }
 
 + (NSString *)normalizeTagGroupID:(NSString *)tagGroup {
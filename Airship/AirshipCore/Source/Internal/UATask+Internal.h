@@ -0,0 +1,34 @@
+/* Copyright Airship and Contributors */
+
+#import "UATask.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface UATask ()
+
+/**
+ * Calls the block once all of the task's dependencies have finished, or once the task is
+ * cancelled. Called right away if the task is already ready.
+ *
+ * @param block The block.
+ */
+- (void)onReady:(void (^)(void))block;
+
+/**
+ * Calls the block once the task has finished. Called right away if the task already finished.
+ *
+ * @param block The block.
+ */
+- (void)onFinish:(void (^)(void))block;
+
+/**
+ * Calls the block once the task is cancelled. Called right away if the task is already
+ * cancelled, and never if the task finishes first.
+ *
+ * @param block The block.
+ */
+- (void)onCancel:(void (^)(void))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,251 @@
+/* Copyright Airship and Contributors */
+
+#import "UATask+Internal.h"
+
+#import <os/lock.h>
+
+typedef NS_ENUM(NSUInteger, UATaskState) {
+    UATaskStatePending,
+    UATaskStateExecuting,
+    UATaskStateFinished,
+};
+
+@interface UATask () {
+    os_unfair_lock _lock;
+    BOOL _cancelled;
+}
+
+@property (nonatomic, copy) UATaskBlock block;
+@property (nonatomic, assign) UATaskState state;
+@property (nonatomic, assign) NSUInteger pendingDependencies;
+@property (nonatomic, strong) NSMutableArray<void (^)(void)> *readyBlocks;
+@property (nonatomic, strong) NSMutableArray<void (^)(void)> *finishBlocks;
+@property (nonatomic, strong) NSMutableArray<void (^)(void)> *cancelBlocks;
+@end
+
+@implementation UATask
+
+@synthesize cancelBlock = _cancelBlock;
+@synthesize completionBlock = _completionBlock;
+
+- (instancetype)initWithBlock:(UATaskBlock)block {
+    self = [super init];
+
+    if (self) {
+        _lock = OS_UNFAIR_LOCK_INIT;
+        self.block = block;
+        self.readyBlocks = [NSMutableArray array];
+        self.finishBlocks = [NSMutableArray array];
+        self.cancelBlocks = [NSMutableArray array];
+    }
+
+    return self;
+}
+
++ (instancetype)taskWithBlock:(UATaskBlock)block {
+    return [[self alloc] initWithBlock:block];
+}
+
+- (BOOL)isCancelled {
+    os_unfair_lock_lock(&_lock);
+    BOOL cancelled = _cancelled;
+    os_unfair_lock_unlock(&_lock);
+    return cancelled;
+}
+
+- (BOOL)isFinished {
+    os_unfair_lock_lock(&_lock);
+    BOOL finished = self.state == UATaskStateFinished;
+    os_unfair_lock_unlock(&_lock);
+    return finished;
+}
+
+- (void (^)(void))cancelBlock {
+    os_unfair_lock_lock(&_lock);
+    void (^block)(void) = _cancelBlock;
+    os_unfair_lock_unlock(&_lock);
+    return block;
+}
+
+- (void)setCancelBlock:(void (^)(void))cancelBlock {
+    BOOL cancelled;
+    os_unfair_lock_lock(&_lock);
+    cancelled = _cancelled && self.state == UATaskStateExecuting;
+    _cancelBlock = cancelled ? nil : [cancelBlock copy];
+    os_unfair_lock_unlock(&_lock);
+
+    // Cancelled before the work could set its cancel block
+    if (cancelled && cancelBlock) {
+        cancelBlock();
+    }
+}
+
+- (void (^)(void))completionBlock {
+    os_unfair_lock_lock(&_lock);
+    void (^block)(void) = _completionBlock;
+    os_unfair_lock_unlock(&_lock);
+    return block;
+}
+
+- (void)setCompletionBlock:(void (^)(void))completionBlock {
+    os_unfair_lock_lock(&_lock);
+    _completionBlock = [completionBlock copy];
+    os_unfair_lock_unlock(&_lock);
+}
+
+- (void)addDependency:(UATask *)task {
+    os_unfair_lock_lock(&_lock);
+    self.pendingDependencies++;
+    os_unfair_lock_unlock(&_lock);
+
+    [task onFinish:^{
+        [self dependencyFinished];
+    }];
+}
+
+- (void)dependencyFinished {
+    NSArray<void (^)(void)> *readyBlocks;
+
+    os_unfair_lock_lock(&_lock);
+    self.pendingDependencies--;
+    if (!self.pendingDependencies) {
+        readyBlocks = [self.readyBlocks copy];
+        [self.readyBlocks removeAllObjects];
+    }
+    os_unfair_lock_unlock(&_lock);
+
+    for (void (^block)(void) in readyBlocks) {
+        block();
+    }
+}
+
+- (void)onReady:(void (^)(void))block {
+    os_unfair_lock_lock(&_lock);
+    BOOL ready = !self.pendingDependencies || _cancelled;
+    if (!ready) {
+        [self.readyBlocks addObject:[block copy]];
+    }
+    os_unfair_lock_unlock(&_lock);
+
+    if (ready) {
+        block();
+    }
+}
+
+- (void)onFinish:(void (^)(void))block {
+    os_unfair_lock_lock(&_lock);
+    BOOL finished = self.state == UATaskStateFinished;
+    if (!finished) {
+        [self.finishBlocks addObject:[block copy]];
+    }
+    os_unfair_lock_unlock(&_lock);
+
+    if (finished) {
+        block();
+    }
+}
+
+- (void)onCancel:(void (^)(void))block {
+    os_unfair_lock_lock(&_lock);
+    BOOL cancelled = _cancelled;
+    BOOL finished = self.state == UATaskStateFinished;
+    if (!cancelled && !finished) {
+        [self.cancelBlocks addObject:[block copy]];
+    }
+    os_unfair_lock_unlock(&_lock);
+
+    if (cancelled && !finished) {
+        block();
+    }
+}
+
+- (void)start {
+    UATaskBlock block;
+    BOOL cancelled;
+
+    os_unfair_lock_lock(&_lock);
+    if (self.state != UATaskStatePending) {
+        os_unfair_lock_unlock(&_lock);
+        return;
+    }
+
+    self.state = UATaskStateExecuting;
+    cancelled = _cancelled;
+    block = self.block;
+    self.block = nil;
+    os_unfair_lock_unlock(&_lock);
+
+    if (cancelled || !block) {
+        [self finish];
+        return;
+    }
+
+    // Run outside of the lock, the block may finish or cancel the task inline
+    block(self);
+}
+
+- (void)cancel {
+    void (^cancelBlock)(void);
+    NSArray<void (^)(void)> *readyBlocks;
+    NSArray<void (^)(void)> *cancelBlocks;
+
+    os_unfair_lock_lock(&_lock);
+    if (_cancelled || self.state == UATaskStateFinished) {
+        os_unfair_lock_unlock(&_lock);
+        return;
+    }
+
+    _cancelled = YES;
+    cancelBlock = _cancelBlock;
+    _cancelBlock = nil;
+
+    // A cancelled task no longer waits on its dependencies
+    readyBlocks = [self.readyBlocks copy];
+    [self.readyBlocks removeAllObjects];
+    cancelBlocks = [self.cancelBlocks copy];
+    [self.cancelBlocks removeAllObjects];
+    os_unfair_lock_unlock(&_lock);
+
+    if (cancelBlock) {
+        cancelBlock();
+    }
+
+    for (void (^block)(void) in cancelBlocks) {
+        block();
+    }
+
+    for (void (^block)(void) in readyBlocks) {
+        block();
+    }
+}
+
+- (void)finish {
+    void (^completionBlock)(void);
+    NSArray<void (^)(void)> *finishBlocks;
+
+    os_unfair_lock_lock(&_lock);
+    if (self.state == UATaskStateFinished) {
+        os_unfair_lock_unlock(&_lock);
+        return;
+    }
+
+    self.state = UATaskStateFinished;
+    self.block = nil;
+    _cancelBlock = nil;
+    completionBlock = _completionBlock;
+    _completionBlock = nil;
+    finishBlocks = [self.finishBlocks copy];
+    [self.finishBlocks removeAllObjects];
+    [self.cancelBlocks removeAllObjects];
+    os_unfair_lock_unlock(&_lock);
+
+    if (completionBlock) {
+        completionBlock();
+    }
+
+    for (void (^block)(void) in finishBlocks) {
+        block();
+    }
+}
+
+@end
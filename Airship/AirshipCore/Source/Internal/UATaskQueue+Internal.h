@@ -0,0 +1,20 @@
+/* Copyright Airship and Contributors */
+
+#import "UATaskQueue.h"
+#import "UADispatcher.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface UATaskQueue ()
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param dispatcher The dispatcher the tasks start on. Must be serial.
+ * @return A task queue instance.
+ */
++ (instancetype)queueWithDispatcher:(UADispatcher *)dispatcher;
+
+@end
+
+NS_ASSUME_NONNULL_END
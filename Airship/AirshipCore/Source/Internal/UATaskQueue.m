@@ -0,0 +1,209 @@
+/* Copyright Airship and Contributors */
+
+#import <UIKit/UIKit.h>
+#import "UATaskQueue+Internal.h"
+#import "UATask+Internal.h"
+#import "UAGlobal.h"
+
+@interface UATaskQueueEntry : NSObject
+@property (nonatomic, strong) UATask *task;
+@property (nonatomic, assign) NSTimeInterval delay;
+@end
+
+@implementation UATaskQueueEntry
+@end
+
+@interface UATaskQueue ()
+@property (nonatomic, strong) UADispatcher *dispatcher;
+@property (nonatomic, strong) NSMutableArray<UATaskQueueEntry *> *entries;
+@property (nonatomic, strong) UATask *currentTask;
+@property (nonatomic, strong) UADisposable *delayDisposable;
+@end
+
+@implementation UATaskQueue
+
+- (instancetype)initWithDispatcher:(UADispatcher *)dispatcher {
+    self = [super init];
+
+    if (self) {
+        self.dispatcher = dispatcher;
+        self.entries = [NSMutableArray array];
+    }
+
+    return self;
+}
+
++ (instancetype)serialQueue {
+    return [self queueWithDispatcher:[UADispatcher serialDispatcher:QOS_CLASS_UTILITY]];
+}
+
++ (instancetype)queueWithDispatcher:(UADispatcher *)dispatcher {
+    return [[self alloc] initWithDispatcher:dispatcher];
+}
+
+- (void)addTask:(UATask *)task {
+    [self addTask:task delay:0];
+}
+
+- (void)addTask:(UATask *)task delay:(NSTimeInterval)delay {
+    UATaskQueueEntry *entry = [[UATaskQueueEntry alloc] init];
+    entry.task = task;
+    entry.delay = delay;
+
+    @synchronized (self) {
+        [self.entries addObject:entry];
+    }
+
+    UA_WEAKIFY(self)
+    [self.dispatcher dispatchAsync:^{
+        UA_STRONGIFY(self)
+        [self startNextTask];
+    }];
+}
+
+- (BOOL)addBackgroundTask:(UATask *)task delay:(NSTimeInterval)delay {
+    __block UIBackgroundTaskIdentifier backgroundTask = UIBackgroundTaskInvalid;
+
+    // Called from both the expiration handler and the task finishing, only ends the task once
+    void (^endBackgroundTask)(void) = ^{
+        UIBackgroundTaskIdentifier identifier;
+        @synchronized (task) {
+            identifier = backgroundTask;
+            backgroundTask = UIBackgroundTaskInvalid;
+        }
+
+        if (identifier != UIBackgroundTaskInvalid) {
+            [[UIApplication sharedApplication] endBackgroundTask:identifier];
+        }
+    };
+
+    UIBackgroundTaskIdentifier identifier = [[UIApplication sharedApplication] beginBackgroundTaskWithExpirationHandler:^{
+        [task cancel];
+        endBackgroundTask();
+    }];
+
+    if (identifier == UIBackgroundTaskInvalid) {
+        return NO;
+    }
+
+    @synchronized (task) {
+        backgroundTask = identifier;
+    }
+
+    [task onFinish:endBackgroundTask];
+
+    [self addTask:task delay:delay];
+    return YES;
+}
+
+- (void)cancelAllTasks {
+    NSArray<UATaskQueueEntry *> *pending;
+    UATask *current;
+    UADisposable *delayDisposable;
+
+    @synchronized (self) {
+        pending = [self.entries copy];
+        [self.entries removeAllObjects];
+        current = self.currentTask;
+        delayDisposable = self.delayDisposable;
+        self.delayDisposable = nil;
+    }
+
+    // Start the cancelled tasks so they finish and call their completion blocks
+    for (UATaskQueueEntry *entry in pending) {
+        [entry.task cancel];
+        [entry.task start];
+    }
+
+    [current cancel];
+    if (delayDisposable) {
+        [delayDisposable dispose];
+        [current start];
+    }
+}
+
+- (void)startNextTask {
+    UATaskQueueEntry *entry;
+
+    @synchronized (self) {
+        if (self.currentTask || !self.entries.count) {
+            return;
+        }
+
+        entry = self.entries.firstObject;
+        [self.entries removeObjectAtIndex:0];
+        self.currentTask = entry.task;
+    }
+
+    UATask *task = entry.task;
+
+    UA_WEAKIFY(self)
+    [task onFinish:^{
+        UA_STRONGIFY(self)
+        [self taskFinished:task];
+    }];
+
+    void (^startTask)(void) = ^{
+        [task onReady:^{
+            UA_STRONGIFY(self)
+            [self.dispatcher dispatchAsync:^{
+                [task start];
+            }];
+        }];
+    };
+
+    if (entry.delay <= 0 || task.isCancelled) {
+        startTask();
+        return;
+    }
+
+    UADisposable *delayDisposable = [self.dispatcher dispatchAfter:entry.delay block:startTask];
+    @synchronized (self) {
+        if (self.currentTask == task && !task.isFinished) {
+            self.delayDisposable = delayDisposable;
+        }
+    }
+
+    // Cancelling the task on its own, e.g. when its background time expires, skips the delay
+    [task onCancel:^{
+        UA_STRONGIFY(self)
+        [self cancelDelayForTask:task];
+    }];
+}
+
+- (void)cancelDelayForTask:(UATask *)task {
+    UADisposable *delayDisposable;
+
+    @synchronized (self) {
+        if (self.currentTask != task) {
+            return;
+        }
+
+        delayDisposable = self.delayDisposable;
+        self.delayDisposable = nil;
+    }
+
+    if (delayDisposable) {
+        [delayDisposable dispose];
+        [task start];
+    }
+}
+
+- (void)taskFinished:(UATask *)task {
+    @synchronized (self) {
+        if (self.currentTask != task) {
+            return;
+        }
+
+        self.currentTask = nil;
+        self.delayDisposable = nil;
+    }
+
+    UA_WEAKIFY(self)
+    [self.dispatcher dispatchAsync:^{
+        UA_STRONGIFY(self)
+        [self startNextTask];
+    }];
+}
+
+@end
@@ -9,6 +9,14 @@
  */
 typedef BOOL (^UAURLAllowListMatcher)(NSURL *);
 
+/**
+ * Block mapping a URL component to a match status
+ */
+typedef BOOL (^UAURLAllowListComponentMatcher)(NSString *);
+
+// Number of recent URL decisions to remember
+static NSUInteger const UAURLAllowListDecisionCacheLimit = 64;
+
 @interface UAURLAllowListEntry : NSObject
 
 @property(nonatomic, assign) UAURLAllowListScope scope;
@@ -47,6 +55,10 @@ typedef BOOL (^UAURLAllowListMatcher)(NSURL *);
  * Regex that matches valid URL allow list pattern entries
  */
 @property(nonatomic, strong) NSRegularExpression *validPatternExpression;
+/**
+ * Matched scopes of recently checked URLs, keyed by absolute string. Cleared when entries change.
+ */
+@property(nonatomic, strong) NSCache<NSString *, NSNumber *> *decisionCache;
 
 @end
 
@@ -56,6 +68,8 @@ typedef BOOL (^UAURLAllowListMatcher)(NSURL *);
     self = [super init];
     if (self) {
         self.entries = [NSMutableSet set];
+        self.decisionCache = [[NSCache alloc] init];
+        self.decisionCache.countLimit = UAURLAllowListDecisionCacheLimit;
     }
     return self;
 }
@@ -121,7 +135,8 @@ typedef BOOL (^UAURLAllowListMatcher)(NSURL *);
 }
 
 /**
- * Generates matcher that compares a URL component (scheme/host/path) with a supplied regex
+ * Generates matcher that compares a URL component (scheme/host/path) with a supplied regex.
+ * The regex is compiled once, when the entry is added.
  */
 - (UAURLAllowListMatcher)matcherForURLComponent:(NSString *)componentKey withRegexString:(nonnull NSString *)regexString {
 
@@ -132,27 +147,46 @@ typedef BOOL (^UAURLAllowListMatcher)(NSURL *);
         regexString = [regexString stringByAppendingString:@"$"];
     }
 
+    NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:regexString
+                                                                           options:0
+                                                                             error:nil];
+
+    return [self matcherForURLComponent:componentKey componentMatcher:^BOOL(NSString *component) {
+        NSRange matchRange = [regex rangeOfFirstMatchInString:component options:0 range:NSMakeRange(0, component.length)];
+        return matchRange.location != NSNotFound;
+    }];
+}
+
+/**
+ * Generates matcher that extracts a URL component (scheme/host/path) and applies the component matcher.
+ */
+- (UAURLAllowListMatcher)matcherForURLComponent:(NSString *)componentKey componentMatcher:(UAURLAllowListComponentMatcher)componentMatcher {
+    BOOL isPath = [componentKey isEqualToString:@"path"];
+
     return ^BOOL(NSURL *URL){
-        NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:regexString
-                                                                               options:0
-                                                                                 error:nil];
-        // NSRegularExpression chokes on nil input strings, so in that case convert it into an empty string
         NSString *component;
 
         // The NSURL path property silently strips trailing slashes
-        if ([componentKey isEqualToString:@"path"]) {
+        if (isPath) {
             component = [self cfPathForURL:URL];
         } else {
             component = [URL valueForKey:componentKey];
         }
 
-        component = component ?: @"";
-
-        NSRange matchRange = [regex rangeOfFirstMatchInString:component options:0 range:NSMakeRange(0, component.length)];
-        return matchRange.location != NSNotFound;
+        // NSRegularExpression chokes on nil input strings, so in that case convert it into an empty string
+        return componentMatcher(component ?: @"");
     };
 }
 
+/**
+ * Generates matcher that requires the URL component to equal the string.
+ */
+- (UAURLAllowListMatcher)matcherForURLComponent:(NSString *)componentKey equalTo:(NSString *)value {
+    return [self matcherForURLComponent:componentKey componentMatcher:^BOOL(NSString *component) {
+        return [component isEqualToString:value];
+    }];
+}
+
 - (UAURLAllowListMatcher)schemeMatcherForPattern:(NSString *)pattern {
 
     NSURL *URL = [NSURL URLWithString:pattern];
@@ -167,15 +201,15 @@ typedef BOOL (^UAURLAllowListMatcher)(NSURL *);
     // NSURL won't parse strings with an actual asterisk for the scheme
     scheme = [scheme stringByReplacingOccurrencesOfString:@"WILDCARD" withString:@"*"];
 
-    NSString *schemeRegexString;
-
     if (!scheme || !scheme.length || [scheme isEqualToString:@"*"]) {
-        schemeRegexString = @".*";
-    } else {
-        schemeRegexString = [self escapeRegexString:scheme escapingWildcards:NO];
+        return [self wildcardMatcher];
     }
 
-    return [self matcherForURLComponent:@"scheme" withRegexString:schemeRegexString];
+    if (![scheme containsString:@"*"]) {
+        return [self matcherForURLComponent:@"scheme" equalTo:scheme];
+    }
+
+    return [self matcherForURLComponent:@"scheme" withRegexString:[self escapeRegexString:scheme escapingWildcards:NO]];
 }
 
 - (UAURLAllowListMatcher)hostMatcherForPattern:(NSString *)pattern {
@@ -188,18 +222,21 @@ typedef BOOL (^UAURLAllowListMatcher)(NSURL *);
 
     NSString *host = URL.host;
 
-    NSString *hostRegexString;
-
     if (!host || [host isEqualToString:@"*"]) {
-        hostRegexString = @".*";
-    } else if ([host hasPrefix:@"*."]) {
-        hostRegexString = [@"(.*\\.)?" stringByAppendingString:[self escapeRegexString:[host substringFromIndex:2]
-                                                                     escapingWildcards:YES]];
-    } else {
-        hostRegexString = [self escapeRegexString:host escapingWildcards:YES];
+        return [self wildcardMatcher];
     }
 
-    return [self matcherForURLComponent:@"host" withRegexString:hostRegexString];
+    // Wildcards are only allowed as a leading `*.`, anything else is matched literally
+    if ([host hasPrefix:@"*."]) {
+        NSString *domain = [host substringFromIndex:2];
+        NSString *suffix = [@"." stringByAppendingString:domain];
+
+        return [self matcherForURLComponent:@"host" componentMatcher:^BOOL(NSString *component) {
+            return [component isEqualToString:domain] || [component hasSuffix:suffix];
+        }];
+    }
+
+    return [self matcherForURLComponent:@"host" equalTo:host];
 }
 
 - (UAURLAllowListMatcher)pathMatcherForPattern:(NSString *)pattern {
@@ -213,15 +250,15 @@ typedef BOOL (^UAURLAllowListMatcher)(NSURL *);
     // The NSURL path property silently strips trailing slashes
     NSString *path = [self cfPathForURL:URL];
 
-    NSString *pathRegexString;
-
     if (!path || !path.length || [path isEqualToString:@"/*"]) {
-        pathRegexString = @".*";
-    } else {
-        pathRegexString = [self escapeRegexString:path escapingWildcards:NO];
+        return [self wildcardMatcher];
+    }
+
+    if (![path containsString:@"*"]) {
+        return [self matcherForURLComponent:@"path" equalTo:path];
     }
 
-    return [self matcherForURLComponent:@"path" withRegexString:pathRegexString];
+    return [self matcherForURLComponent:@"path" withRegexString:[self escapeRegexString:path escapingWildcards:NO]];
 }
 
 - (UAURLAllowListMatcher)wildcardMatcher {
@@ -231,6 +268,10 @@ typedef BOOL (^UAURLAllowListMatcher)(NSURL *);
 }
 
 - (NSRegularExpression *)patternValidator:(NSString *)pattern {
+    if (self.validPatternExpression) {
+        return self.validPatternExpression;
+    }
+
     /**
      * Regular expression to match the scheme.
      * <scheme> := '*' | <valid scheme characters, `*` will match 0 or more characters>
@@ -261,11 +302,11 @@ typedef BOOL (^UAURLAllowListMatcher)(NSURL *);
                                          schemeRegexString,
                                          schemeRegexString, pathRegexString];
 
-    NSRegularExpression *validPatternExpression = [NSRegularExpression regularExpressionWithPattern:validPatternRegexString
+    self.validPatternExpression = [NSRegularExpression regularExpressionWithPattern:validPatternRegexString
                                                                             options:NSRegularExpressionUseUnicodeWordBoundaries
                                                                               error:nil];
 
-    return validPatternExpression;
+    return self.validPatternExpression;
 }
 
 - (BOOL)validatePattern:(NSString *)pattern {
@@ -304,6 +345,7 @@ typedef BOOL (^UAURLAllowListMatcher)(NSURL *);
     // If we have just a wildcard, match anything
     if ([patternString isEqualToString:@"*"]) {
         [self.entries addObject:[UAURLAllowListEntry entryWithMatcher:[self wildcardMatcher] scope:scope]];
+        [self.decisionCache removeAllObjects];
         return YES;
     }
 
@@ -321,13 +363,11 @@ typedef BOOL (^UAURLAllowListMatcher)(NSURL *);
     // The matcher that is stored in the URL allow list encompasses matching each component.
     // A URL matches if an only if all components match.
     UAURLAllowListMatcher patternMatcher = ^BOOL(NSURL *URL) {
-        BOOL matchedScheme = schemeMatcher(URL);
-        BOOL matchedHost = hostMatcher(URL);
-        BOOL matchedPath = pathMatcher(URL);
-        return matchedScheme && matchedHost && matchedPath;
+        return schemeMatcher(URL) && hostMatcher(URL) && pathMatcher(URL);
     };
 
     [self.entries addObject:[UAURLAllowListEntry entryWithMatcher:[patternMatcher copy] scope:scope]];
+    [self.decisionCache removeAllObjects];
 
     return YES;
 }
@@ -340,11 +380,21 @@ typedef BOOL (^UAURLAllowListMatcher)(NSURL *);
     BOOL match = NO;
     
     
+    NSString *cacheKey = URL.absoluteString;
+    NSNumber *cachedScope = cacheKey ? [self.decisionCache objectForKey:cacheKey] : nil;
     NSUInteger matchedScope = 0;
-    
-    for (UAURLAllowListEntry *entry in self.entries) {
-        if (entry.matcher(URL)) {
-            matchedScope |= entry.scope;
+
+    if (cachedScope) {
+        matchedScope = cachedScope.unsignedIntegerValue;
+    } else {
+        for (UAURLAllowListEntry *entry in self.entries) {
+            if (entry.matcher(URL)) {
+                matchedScope |= entry.scope;
+            }
+        }
+
+        if (cacheKey) {
+            [self.decisionCache setObject:@(matchedScope) forKey:cacheKey];
         }
     }
     
@@ -18,6 +18,18 @@ NS_ASSUME_NONNULL_BEGIN
 + (instancetype)operationWithRequest:(NSURLRequest *)request
                              session:(NSURLSession *)session
                    completionHandler:(void (^)(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error))completionHandler;
+
+/**
+ * UAURLRequestOperation factory method.
+ * @param request The request to perform.
+ * @param priority The task priority, 0.0-1.0.
+ * @param session The url session to peform the request in.
+ * @param completionHandler A completion handler to call once the request is finished.
+ */
++ (instancetype)operationWithRequest:(NSURLRequest *)request
+                            priority:(float)priority
+                             session:(NSURLSession *)session
+                   completionHandler:(void (^)(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error))completionHandler;
 @end
 
 NS_ASSUME_NONNULL_END
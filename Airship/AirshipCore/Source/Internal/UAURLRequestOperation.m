@@ -8,6 +8,7 @@
 @property (nonatomic, copy) NSURLSessionTask *task;
 @property (nonatomic, strong) NSURLSession *session;
 @property (nonatomic, copy) NSURLRequest *request;
+@property (nonatomic, assign) float priority;
 @property (nonatomic, copy) void (^completionHandler)(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error);
 @end
 
@@ -15,6 +16,7 @@
 
 
 - (instancetype)initWithRequest:(NSURLRequest *)request
+                       priority:(float)priority
                        sesssion:(NSURLSession *)session
               completionHandler:(void (^)(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error))completionHandler {
 
@@ -22,6 +24,7 @@
     if (self) {
         self.session = session;
         self.request = request;
+        self.priority = priority;
         self.completionHandler = completionHandler;
     }
     return self;
@@ -31,7 +34,21 @@
                             session:(NSURLSession *)session
                    completionHandler:(void (^)(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error))completionHandler {
 
-    return [[UAURLRequestOperation alloc] initWithRequest:request sesssion:session completionHandler:completionHandler];
+    return [self operationWithRequest:request
+                             priority:NSURLSessionTaskPriorityDefault
+                              session:session
+                    completionHandler:completionHandler];
+}
+
++ (instancetype)operationWithRequest:(NSURLRequest *)request
+                            priority:(float)priority
+                             session:(NSURLSession *)session
+                   completionHandler:(void (^)(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error))completionHandler {
+
+    return [[UAURLRequestOperation alloc] initWithRequest:request
+                                                 priority:priority
+                                                 sesssion:session
+                                        completionHandler:completionHandler];
 }
 
 - (void)startAsyncOperation {
@@ -45,6 +62,7 @@
         [self finish];
     }];
 
+    self.task.priority = self.priority;
     [self.task resume];
 }
 
@@ -22,6 +22,19 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (void)getDeviceID:(void (^)(NSString *))completionHandler dispatcher:(nullable UADispatcher *)dispatcher;
 
+///---------------------------------------------------------------------------------------
+/// @name Storage
+///---------------------------------------------------------------------------------------
+
+/**
+ * Gets the Airship no backup directory, creating it if needed. The directory is
+ * created in the library directory, falling back to the caches directory.
+ *
+ * @param error The error if the directory could not be created.
+ * @return The directory URL, or nil if the directory could not be created.
+ */
++ (nullable NSURL *)noBackupDirectoryURL:(NSError **)error;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -15,13 +15,13 @@
 #import "UARuntimeConfig.h"
 #import "UAKeychainUtils.h"
 #import "UARequest.h"
+#import "UANetworkMonitor.h"
 
 // C includes
 #include <sys/types.h>
 #include <sys/sysctl.h>
 #include <sys/xattr.h>
 #include <sys/utsname.h>
-#include <netinet/in.h>
 
 #if !TARGET_OS_TV   // CoreTelephony not supported in tvOS
 #import <CoreTelephony/CTTelephonyNetworkInfo.h>
@@ -34,48 +34,11 @@ NSString * const UAConnectionTypeNone = @"none";
 NSString * const UAConnectionTypeCell = @"cell";
 NSString * const UAConnectionTypeWifi = @"wifi";
 
-+ (NSString *)connectionType {
-    SCNetworkReachabilityFlags flags;
-    SCNetworkReachabilityRef reachabilityRef;
-
-    struct sockaddr_in zeroAddress;
-
-    // Put sizeof(zeroAddress) number of 0-bytes at address &zeroAddress
-    bzero(&zeroAddress, sizeof(zeroAddress));
-
-    // Set length of sockaddr_in struct
-    zeroAddress.sin_len = sizeof(zeroAddress);
-
-    // Set address family to internetwork: UDP, TCP, etc.
-    zeroAddress.sin_family = AF_INET;
+static NSString * const UANoBackupDirectory = @"com.urbanairship.no-backup";
+static NSString * const UAISO8601ParsingFormatterKey = @"com.urbanairship.iso8601_parsing_formatter";
 
-    reachabilityRef = SCNetworkReachabilityCreateWithAddress(kCFAllocatorDefault, (const struct sockaddr*)&zeroAddress);
-    Boolean success = SCNetworkReachabilityGetFlags(reachabilityRef, &flags);
-    CFRelease(reachabilityRef);
-
-    // Return early if flags don't return, a connection is required, or the network is unreachable
-    if (!success || (flags & kSCNetworkReachabilityFlagsReachable) == 0) {
-        return UAConnectionTypeNone;
-    }
-
-    NSString *connectionType = UAConnectionTypeNone;
-
-    if ((flags & kSCNetworkReachabilityFlagsConnectionRequired) == 0) {
-        connectionType = UAConnectionTypeWifi;
-    }
-
-    if ((((flags & kSCNetworkReachabilityFlagsConnectionOnDemand ) != 0) ||
-         (flags & kSCNetworkReachabilityFlagsConnectionOnTraffic) != 0)) {
-        if ((flags & kSCNetworkReachabilityFlagsInterventionRequired) == 0) {
-            connectionType = UAConnectionTypeWifi;
-        }
-    }
-
-    if ((flags & kSCNetworkReachabilityFlagsIsWWAN) == kSCNetworkReachabilityFlagsIsWWAN) {
-        connectionType = UAConnectionTypeCell;
-    }
-
-    return connectionType;
++ (NSString *)connectionType {
+    return [UANetworkMonitor shared].connectionType;
 }
 
 + (nullable NSString *)nilIfEmpty:(nullable NSString *)str {
@@ -210,10 +173,128 @@ NSString * const UAConnectionTypeWifi = @"wifi";
     return dateFormatter;
 }
 
++ (NSString *)ISODateStringFromDate:(NSDate *)date delimiter:(BOOL)delimiter {
+    int64_t seconds = (int64_t)floor(date.timeIntervalSince1970);
+    int64_t days = seconds / 86400;
+    int64_t secondsOfDay = seconds % 86400;
+    if (secondsOfDay < 0) {
+        secondsOfDay += 86400;
+        days -= 1;
+    }
+
+    // Civil date from days since the epoch, see http://howardhinnant.github.io/date_algorithms.html
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t dayOfEra = days - era * 146097;
+    int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int64_t monthPrime = (5 * dayOfYear + 2) / 153;
+    int64_t day = dayOfYear - (153 * monthPrime + 2) / 5 + 1;
+    int64_t month = monthPrime < 10 ? monthPrime + 3 : monthPrime - 9;
+    int64_t year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+
+    return [NSString stringWithFormat:@"%04lld-%02lld-%02lld%c%02lld:%02lld:%02lld",
+            year, month, day, delimiter ? 'T' : ' ',
+            secondsOfDay / 3600, (secondsOfDay % 3600) / 60, secondsOfDay % 60];
+}
+
+/**
+ * Reads a fixed number of digits, returning -1 if any character is not a digit.
+ */
+static NSInteger UAReadDigits(const unichar *characters, NSUInteger offset, NSUInteger count) {
+    NSInteger value = 0;
+    for (NSUInteger i = offset; i < offset + count; i++) {
+        if (characters[i] < '0' || characters[i] > '9') {
+            return -1;
+        }
+        value = value * 10 + (characters[i] - '0');
+    }
+    return value;
+}
+
+/**
+ * Parses the exact `yyyy[-MM[-dd[(T| )HH[:mm[:ss[.SSS]]]]]]` shapes without a date formatter.
+ * Returns nil for anything else so the caller can fall back to NSDateFormatter.
+ */
++ (nullable NSDate *)fastParseISO8601DateFromString:(NSString *)timestamp {
+    // Length of each supported shape: yyyy, yyyy-MM, yyyy-MM-dd, +HH, +:mm, +:ss, +.SSS
+    NSUInteger length = timestamp.length;
+    if (length != 4 && length != 7 && length != 10 && length != 13 && length != 16 && length != 19 && length != 23) {
+        return nil;
+    }
+
+    unichar characters[23];
+    [timestamp getCharacters:characters range:NSMakeRange(0, length)];
+
+    NSInteger year = UAReadDigits(characters, 0, 4);
+    NSInteger month = 1, day = 1, hour = 0, minute = 0, second = 0, millisecond = 0;
+
+    if (length >= 7) {
+        month = characters[4] == '-' ? UAReadDigits(characters, 5, 2) : -1;
+    }
+
+    if (length >= 10) {
+        day = characters[7] == '-' ? UAReadDigits(characters, 8, 2) : -1;
+    }
+
+    if (length >= 13) {
+        hour = (characters[10] == 'T' || characters[10] == ' ') ? UAReadDigits(characters, 11, 2) : -1;
+    }
+
+    if (length >= 16) {
+        minute = characters[13] == ':' ? UAReadDigits(characters, 14, 2) : -1;
+    }
+
+    if (length >= 19) {
+        second = characters[16] == ':' ? UAReadDigits(characters, 17, 2) : -1;
+    }
+
+    if (length == 23) {
+        millisecond = characters[19] == '.' ? UAReadDigits(characters, 20, 3) : -1;
+    }
+
+    if (year < 0 || month < 1 || month > 12 || day < 1 || hour < 0 || hour > 23 ||
+        minute < 0 || minute > 59 || second < 0 || second > 59 || millisecond < 0) {
+        return nil;
+    }
+
+    BOOL leapYear = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    static const NSInteger daysInMonth[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (day > daysInMonth[month - 1] + (month == 2 && leapYear ? 1 : 0)) {
+        return nil;
+    }
+
+    // Days since the epoch from a civil date, see http://howardhinnant.github.io/date_algorithms.html
+    int64_t y = month <= 2 ? year - 1 : year;
+    int64_t era = (y >= 0 ? y : y - 399) / 400;
+    int64_t yearOfEra = y - era * 400;
+    int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    int64_t days = era * 146097 + dayOfEra - 719468;
+
+    NSTimeInterval interval = days * 86400 + hour * 3600 + minute * 60 + second + millisecond / 1000.0;
+    return [NSDate dateWithTimeIntervalSince1970:interval];
+}
+
 + (NSDate *)parseISO8601DateFromString:(NSString *)timestamp {
-    NSDateFormatter* dateFormatter = [[NSDateFormatter alloc] init];
-    dateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
-    dateFormatter.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+    if (![timestamp isKindOfClass:[NSString class]]) {
+        return nil;
+    }
+
+    NSDate *date = [self fastParseISO8601DateFromString:timestamp];
+    if (date) {
+        return date;
+    }
+
+    // Formatters are expensive to create and not safe to share across threads, so keep one per thread
+    NSMutableDictionary *threadDictionary = [NSThread currentThread].threadDictionary;
+    NSDateFormatter *dateFormatter = threadDictionary[UAISO8601ParsingFormatterKey];
+    if (!dateFormatter) {
+        dateFormatter = [[NSDateFormatter alloc] init];
+        dateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+        dateFormatter.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+        threadDictionary[UAISO8601ParsingFormatterKey] = dateFormatter;
+    }
 
     // All the various formats
     NSArray *formats = @[@"yyyy-MM-dd'T'HH:mm:ss.SSS",
@@ -229,7 +310,7 @@ NSString * const UAConnectionTypeWifi = @"wifi";
 
     for (NSString *format in formats) {
         dateFormatter.dateFormat = format;
-        NSDate *date = [dateFormatter dateFromString:timestamp];
+        date = [dateFormatter dateFromString:timestamp];
         if (date) {
             return date;
         }
@@ -238,6 +319,34 @@ NSString * const UAConnectionTypeWifi = @"wifi";
     return nil;
 }
 
++ (NSURL *)noBackupDirectoryURL:(NSError **)error {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSURL *libraryDirectoryURL = [[fileManager URLsForDirectory:NSLibraryDirectory inDomains:NSUserDomainMask] lastObject];
+    NSURL *cachesDirectoryURL = [[fileManager URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask] lastObject];
+    NSURL *libraryStoreDirectoryURL = [libraryDirectoryURL URLByAppendingPathComponent:UANoBackupDirectory];
+    NSURL *cachesStoreDirectoryURL = [cachesDirectoryURL URLByAppendingPathComponent:UANoBackupDirectory];
+
+    if ([fileManager fileExistsAtPath:[libraryStoreDirectoryURL path]]) {
+        return libraryStoreDirectoryURL;
+    }
+
+    if ([fileManager fileExistsAtPath:[cachesStoreDirectoryURL path]]) {
+        return cachesStoreDirectoryURL;
+    }
+
+    if ([fileManager createDirectoryAtURL:libraryStoreDirectoryURL withIntermediateDirectories:YES attributes:nil error:error]) {
+        [UAUtils addSkipBackupAttributeToItemAtURL:libraryStoreDirectoryURL];
+        return libraryStoreDirectoryURL;
+    }
+
+    if ([fileManager createDirectoryAtURL:cachesStoreDirectoryURL withIntermediateDirectories:YES attributes:nil error:error]) {
+        [UAUtils addSkipBackupAttributeToItemAtURL:cachesStoreDirectoryURL];
+        return cachesStoreDirectoryURL;
+    }
+
+    return nil;
+}
+
 + (BOOL)addSkipBackupAttributeToItemAtURL:(NSURL *)url {
     if (![[NSFileManager defaultManager] fileExistsAtPath: [url path]]) {
         return NO;
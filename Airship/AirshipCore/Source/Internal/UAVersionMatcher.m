@@ -18,8 +18,84 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
 @property(nonatomic, assign) UAVersionMatcherConstraintType constraintType;
 @property(nonatomic, copy) NSDictionary *parsedConstraint;
 
+// Numeric components of the range bounds, parsed once so evaluation only compares integers
+@property(nonatomic, strong, nullable) NSData *startComponents;
+@property(nonatomic, strong, nullable) NSData *endComponents;
+
 @end
 
+// Longest version string compared without allocating
+#define MAX_STACK_VERSION_LENGTH 64
+
+/**
+ * Parses a version string into its numeric components, matching `UAUtils compareVersion:toVersion:`
+ * which reads each dot separated component with `integerValue`.
+ *
+ * @return The number of components written, at most `length + 1`.
+ */
+static NSUInteger UAParseVersionComponents(const unichar *characters, NSUInteger length, NSInteger *components) {
+    NSUInteger count = 0;
+    NSUInteger index = 0;
+
+    while (YES) {
+        NSInteger value = 0;
+        BOOL negative = NO;
+        BOOL parsing = YES;
+
+        if (index < length && (characters[index] == '-' || characters[index] == '+')) {
+            negative = characters[index] == '-';
+            index++;
+        }
+
+        for (; index < length && characters[index] != '.'; index++) {
+            // integerValue stops at the first non-digit
+            if (parsing && characters[index] >= '0' && characters[index] <= '9') {
+                value = value * 10 + (characters[index] - '0');
+            } else {
+                parsing = NO;
+            }
+        }
+
+        components[count++] = negative ? -value : value;
+
+        if (index >= length) {
+            return count;
+        }
+
+        // Skip the separator
+        index++;
+    }
+}
+
+static NSComparisonResult UACompareVersionComponents(const NSInteger *components1, NSUInteger count1,
+                                                     const NSInteger *components2, NSUInteger count2) {
+    for (NSUInteger index = 0; index < MAX(count1, count2); index++) {
+        NSInteger component1 = index < count1 ? components1[index] : 0;
+        NSInteger component2 = index < count2 ? components2[index] : 0;
+        if (component1 < component2) {
+            return NSOrderedAscending;
+        } else if (component1 > component2) {
+            return NSOrderedDescending;
+        }
+    }
+
+    return NSOrderedSame;
+}
+
+static NSData *UAVersionComponentsData(NSString *version) {
+    NSUInteger length = version.length;
+    unichar *characters = malloc(sizeof(unichar) * MAX(length, 1));
+    NSInteger *components = malloc(sizeof(NSInteger) * (length + 1));
+
+    [version getCharacters:characters range:NSMakeRange(0, length)];
+    NSUInteger count = UAParseVersionComponents(characters, length, components);
+    NSData *data = [NSData dataWithBytes:components length:sizeof(NSInteger) * count];
+
+    free(characters);
+    free(components);
+    return data;
+}
+
 
 @implementation UAVersionMatcher
 
@@ -34,6 +110,29 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
 }
 
 + (nullable instancetype)matcherWithVersionConstraint:(NSString *)versionConstraint {
+    // Matchers are immutable, so one instance is shared per constraint string
+    static NSCache *matcherCache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        matcherCache = [[NSCache alloc] init];
+        matcherCache.countLimit = 256;
+    });
+
+    if (!versionConstraint) {
+        return nil;
+    }
+
+    id cached = [matcherCache objectForKey:versionConstraint];
+    if (cached) {
+        return cached == [NSNull null] ? nil : cached;
+    }
+
+    UAVersionMatcher *matcher = [self parseMatcherWithVersionConstraint:versionConstraint];
+    [matcherCache setObject:matcher ?: [NSNull null] forKey:versionConstraint];
+    return matcher;
+}
+
++ (nullable instancetype)parseMatcherWithVersionConstraint:(NSString *)versionConstraint {
     NSString *strippedVersionConstraint = [self removeWhitespace:versionConstraint];
     
     UAVersionMatcher *matcher = [[UAVersionMatcher alloc] init];
@@ -57,6 +156,11 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
     if (parsedConstraint) {
         matcher.constraintType = UAVersionMatcherConstraintTypeVersionRange;
         matcher.parsedConstraint = parsedConstraint;
+
+        id startOfRange = parsedConstraint[@"startOfRange"];
+        id endOfRange = parsedConstraint[@"endOfRange"];
+        matcher.startComponents = [startOfRange isKindOfClass:[NSString class]] ? UAVersionComponentsData(startOfRange) : nil;
+        matcher.endComponents = [endOfRange isKindOfClass:[NSString class]] ? UAVersionComponentsData(endOfRange) : nil;
         return matcher;
     }
     
@@ -67,6 +171,10 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherConstraintType) {
 #pragma mark Evaluate version against constraint
 
 - (BOOL)evaluateObject:(id)value {
+    if (![value isKindOfClass:[NSString class]]) {
+        return NO;
+    }
+
     NSString *checkVersion = [[self class] removeWhitespace:value];
 
     switch (self.constraintType) {
@@ -295,11 +403,28 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherRangeBoundary) {
     if (self.constraintType != UAVersionMatcherConstraintTypeVersionRange) {
         return NO;
     }
-    
+
+    NSUInteger length = checkVersion.length;
+    if (length > MAX_STACK_VERSION_LENGTH) {
+        NSData *components = UAVersionComponentsData(checkVersion);
+        return [self versionComponentsMatchRange:components.bytes count:components.length / sizeof(NSInteger)];
+    }
+
+    unichar characters[MAX_STACK_VERSION_LENGTH];
+    NSInteger components[MAX_STACK_VERSION_LENGTH + 1];
+    [checkVersion getCharacters:characters range:NSMakeRange(0, length)];
+    NSUInteger count = UAParseVersionComponents(characters, length, components);
+
+    return [self versionComponentsMatchRange:components count:count];
+}
+
+- (BOOL)versionComponentsMatchRange:(const NSInteger *)components count:(NSUInteger)count {
     UAVersionMatcherRangeBoundary startBoundary = [self.parsedConstraint[@"startBoundary"] integerValue];
-    NSString *startOfRange = self.parsedConstraint[@"startOfRange"];
     if (startBoundary != UAVersionMatcherRangeBoundaryInfinite) {
-        NSComparisonResult result = [UAUtils compareVersion:startOfRange toVersion:checkVersion];
+        NSComparisonResult result = UACompareVersionComponents(self.startComponents.bytes,
+                                                               self.startComponents.length / sizeof(NSInteger),
+                                                               components,
+                                                               count);
         switch (startBoundary) {
             case UAVersionMatcherRangeBoundaryInclusive:
                 if (result != NSOrderedAscending && result != NSOrderedSame) {
@@ -317,9 +442,11 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherRangeBoundary) {
     }
     
     UAVersionMatcherRangeBoundary endBoundary = [self.parsedConstraint[@"endBoundary"] integerValue];
-    NSString *endOfRange = self.parsedConstraint[@"endOfRange"];
     if (endBoundary != UAVersionMatcherRangeBoundaryInfinite) {
-        NSComparisonResult result = [UAUtils compareVersion:checkVersion toVersion:endOfRange];
+        NSComparisonResult result = UACompareVersionComponents(components,
+                                                               count,
+                                                               self.endComponents.bytes,
+                                                               self.endComponents.length / sizeof(NSInteger));
         switch (endBoundary) {
             case UAVersionMatcherRangeBoundaryInclusive:
                 if (result != NSOrderedAscending && result != NSOrderedSame) {
@@ -343,21 +470,40 @@ typedef NS_ENUM(NSInteger,UAVersionMatcherRangeBoundary) {
 #pragma mark Utility methods
 
 + (NSArray<NSTextCheckingResult *> *)getMatchesForPattern:(NSString *)pattern onString:(NSString *)string {
-    NSError *error = NULL;
-    NSRegularExpression *regex = [NSRegularExpression regularExpressionWithPattern:pattern
-                                                                           options:NSRegularExpressionCaseInsensitive
-                                                                             error:NULL];
-    
-    if (error) {
-        UA_LERR(@"Error creating regular expression - %@",error);
-        return nil;
+    // Only the three constant patterns above are used, so the compiled expressions are kept forever
+    static NSMutableDictionary<NSString *, NSRegularExpression *> *expressions;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        expressions = [NSMutableDictionary dictionary];
+    });
+
+    NSRegularExpression *regex;
+    @synchronized (expressions) {
+        regex = expressions[pattern];
+        if (!regex) {
+            NSError *error = nil;
+            regex = [NSRegularExpression regularExpressionWithPattern:pattern
+                                                              options:NSRegularExpressionCaseInsensitive
+                                                                error:&error];
+            if (error) {
+                UA_LERR(@"Error creating regular expression - %@",error);
+                return nil;
+            }
+
+            expressions[pattern] = regex;
+        }
     }
-    
+
     NSArray<NSTextCheckingResult *> *matches = [regex matchesInString:string options:0 range:NSMakeRange(0, [string length])];
     return matches;
 }
 
 + (NSString *)removeWhitespace:(NSString *)sourceString {
+    // Constraints and versions rarely contain whitespace, skip the regex replacement when there is none
+    if ([sourceString rangeOfCharacterFromSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]].location == NSNotFound) {
+        return sourceString;
+    }
+
     NSString *destString = [sourceString stringByReplacingOccurrencesOfString:@"\\s"
                                                                    withString:@""
                                                                       options:NSRegularExpressionSearch
@@ -5,6 +5,7 @@
 #if !TARGET_OS_TV
 
 #import "UAWebView.h"
+#import "UANativeBridge+Internal.h"
 #import "UAirship.h"
 #import "UARuntimeConfig.h"
 #import "UAUtils.h"
@@ -12,13 +13,30 @@
 // Had to create this class because Interface Builder doesn't directly support WKWebView
 @implementation UAWebView
 
++ (WKWebViewConfiguration *)defaultConfiguration {
+    // A single process pool is shared by all Airship web views
+    static dispatch_once_t onceToken;
+    static WKProcessPool *processPool;
+    dispatch_once(&onceToken, ^{
+        processPool = [[WKProcessPool alloc] init];
+    });
+
+    WKWebViewConfiguration *configuration = [WKWebViewConfiguration new];
+    configuration.processPool = processPool;
+    [configuration.userContentController addUserScript:[UANativeBridge libraryUserScript]];
+    return configuration;
+}
+
+- (instancetype)initWithFrame:(CGRect)frame {
+    return [super initWithFrame:frame configuration:[UAWebView defaultConfiguration]];
+}
+
 - (instancetype)initWithCoder:(NSCoder *)coder {
     // An initial frame for initialization must be set, but it will be overridden
     // below by the autolayout constraints set in interface builder.
     CGRect frame = [[UIScreen mainScreen] bounds];
-    WKWebViewConfiguration *myConfiguration = [WKWebViewConfiguration new];
     
-    self = [super initWithFrame:frame configuration:myConfiguration];
+    self = [super initWithFrame:frame configuration:[UAWebView defaultConfiguration]];
     
     // Apply constraints from interface builder.
     self.translatesAutoresizingMaskIntoConstraints = NO;
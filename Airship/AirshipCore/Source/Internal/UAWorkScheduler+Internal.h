@@ -0,0 +1,77 @@
+/* Copyright Airship and Contributors */
+
+#import "UAWorkScheduler.h"
+
+@class UADate;
+@class UAMetricsRegistry;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Seconds of work each launch type allows.
+ */
+extern NSTimeInterval const UAWorkForegroundBudget;
+extern NSTimeInterval const UAWorkBackgroundFetchBudget;
+extern NSTimeInterval const UAWorkSilentPushBudget;
+extern NSTimeInterval const UAWorkExtensionBudget;
+extern NSTimeInterval const UAWorkBackgroundProcessingBudget;
+
+/**
+ * Number of jobs that run at once in the foreground, and in every other launch type.
+ */
+extern NSUInteger const UAWorkForegroundMaxRunningJobs;
+extern NSUInteger const UAWorkBackgroundMaxRunningJobs;
+
+@interface UAWorkScheduler ()
+
+///---------------------------------------------------------------------------------------
+/// @name Work Scheduler Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param launchType The initial launch type.
+ * @param notificationCenter The notification center to observe foreground transitions on.
+ * @param date The date.
+ * @param metrics The metrics registry job durations are recorded in.
+ * @return A scheduler instance.
+ */
++ (instancetype)schedulerWithLaunchType:(UAWorkLaunchType)launchType
+                     notificationCenter:(NSNotificationCenter *)notificationCenter
+                                   date:(UADate *)date
+                                metrics:(UAMetricsRegistry *)metrics;
+
+/**
+ * Starts a new budget window, such as when a background task or a silent push wakes the app up.
+ * Deferred work is resubmitted to the new window. A background window that still has work running
+ * is kept as is, only a foreground transition replaces it.
+ *
+ * @param launchType The launch type.
+ */
+- (void)beginWindowWithLaunchType:(UAWorkLaunchType)launchType;
+
+/**
+ * Submits work, with a handler called each time the work is deferred to the next window.
+ *
+ * @param name The work name, used for logging and metrics.
+ * @param priority The work priority.
+ * @param deadline Seconds from now after which the work is dropped if it has not started, or 0 for no deadline.
+ * @param dispatcher The dispatcher the work runs on, or `nil` to run it on the thread that starts it.
+ * @param block The work block.
+ * @param dropHandler Called if the work is dropped instead of run.
+ * @param deferHandler Called if the work is deferred because the budget is spent. May be called
+ * before this method returns.
+ * @return A disposable that cancels the work.
+ */
+- (UADisposable *)submitWorkWithName:(NSString *)name
+                            priority:(UAWorkPriority)priority
+                            deadline:(NSTimeInterval)deadline
+                          dispatcher:(nullable UADispatcher *)dispatcher
+                               block:(UAWorkBlock)block
+                         dropHandler:(nullable void (^)(void))dropHandler
+                        deferHandler:(nullable void (^)(void))deferHandler;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,462 @@
+/* Copyright Airship and Contributors */
+
+#import "UAWorkScheduler+Internal.h"
+#import "UAAppStateTracker.h"
+#import "UADate.h"
+#import "UAGlobal.h"
+#import "UAMetricsRegistry.h"
+
+NSTimeInterval const UAWorkForegroundBudget = 60;
+NSTimeInterval const UAWorkBackgroundFetchBudget = 25;
+NSTimeInterval const UAWorkSilentPushBudget = 20;
+NSTimeInterval const UAWorkExtensionBudget = 5;
+NSTimeInterval const UAWorkBackgroundProcessingBudget = 120;
+
+NSUInteger const UAWorkForegroundMaxRunningJobs = 4;
+NSUInteger const UAWorkBackgroundMaxRunningJobs = 2;
+
+/**
+ * A submitted job.
+ */
+@interface UAWorkJob : NSObject
+@property (nonatomic, copy) NSString *name;
+@property (nonatomic, assign) UAWorkPriority priority;
+@property (nonatomic, strong, nullable) NSDate *deadline;
+@property (nonatomic, strong, nullable) UADispatcher *dispatcher;
+@property (nonatomic, copy) UAWorkBlock block;
+@property (nonatomic, copy, nullable) void (^dropHandler)(void);
+@property (nonatomic, copy, nullable) void (^deferHandler)(void);
+
+// Submission order, breaks ties between equal priorities and deadlines
+@property (nonatomic, assign) NSUInteger sequence;
+
+// The window the job started in, it is only charged to that window
+@property (nonatomic, assign) NSUInteger window;
+@property (nonatomic, strong, nullable) NSDate *startDate;
+@property (nonatomic, strong, nullable) UADisposable *disposable;
+@property (nonatomic, assign) BOOL blockReturned;
+@property (nonatomic, assign) BOOL disposed;
+@property (nonatomic, assign) BOOL finished;
+@end
+
+@implementation UAWorkJob
+
+- (BOOL)runsBefore:(UAWorkJob *)job {
+    if (self.priority != job.priority) {
+        return self.priority < job.priority;
+    }
+
+    if (self.deadline || job.deadline) {
+        if (!job.deadline) {
+            return YES;
+        }
+
+        if (!self.deadline) {
+            return NO;
+        }
+
+        NSComparisonResult result = [self.deadline compare:job.deadline];
+        if (result != NSOrderedSame) {
+            return result == NSOrderedAscending;
+        }
+    }
+
+    return self.sequence < job.sequence;
+}
+
+@end
+
+@interface UAWorkScheduler ()
+@property (nonatomic, assign) UAWorkLaunchType launchType;
+@property (nonatomic, strong) NSNotificationCenter *notificationCenter;
+@property (nonatomic, strong) UADate *date;
+@property (nonatomic, strong) UAMetricsRegistry *metrics;
+@property (nonatomic, strong) NSMutableArray<UAWorkJob *> *pendingJobs;
+@property (nonatomic, strong) NSMutableArray<UAWorkJob *> *deferredJobs;
+@property (nonatomic, strong) NSMutableArray<UAWorkJob *> *runningJobs;
+@property (nonatomic, assign) NSUInteger window;
+@property (nonatomic, assign) NSUInteger sequence;
+
+// Time charged to the current window by finished jobs
+@property (nonatomic, assign) NSTimeInterval spent;
+@end
+
+@implementation UAWorkScheduler
+
+- (instancetype)initWithLaunchType:(UAWorkLaunchType)launchType
+                notificationCenter:(NSNotificationCenter *)notificationCenter
+                              date:(UADate *)date
+                           metrics:(UAMetricsRegistry *)metrics {
+    self = [super init];
+
+    if (self) {
+        self.launchType = launchType;
+        self.notificationCenter = notificationCenter;
+        self.date = date;
+        self.metrics = metrics;
+        self.pendingJobs = [NSMutableArray array];
+        self.deferredJobs = [NSMutableArray array];
+        self.runningJobs = [NSMutableArray array];
+
+        [self.notificationCenter addObserver:self
+                                    selector:@selector(applicationWillEnterForeground)
+                                        name:UAApplicationWillEnterForegroundNotification
+                                      object:nil];
+    }
+
+    return self;
+}
+
++ (instancetype)shared {
+    static dispatch_once_t onceToken;
+    static UAWorkScheduler *_shared;
+    dispatch_once(&onceToken, ^{
+        UAWorkLaunchType launchType;
+        if ([[NSBundle mainBundle].bundlePath hasSuffix:@".appex"]) {
+            launchType = UAWorkLaunchTypeExtension;
+        } else if ([UAAppStateTracker shared].state == UAApplicationStateBackground) {
+            launchType = UAWorkLaunchTypeBackgroundFetch;
+        } else {
+            launchType = UAWorkLaunchTypeForeground;
+        }
+
+        _shared = [self schedulerWithLaunchType:launchType
+                             notificationCenter:[NSNotificationCenter defaultCenter]
+                                           date:[[UADate alloc] init]
+                                        metrics:[UAMetricsRegistry shared]];
+
+        UAWorkScheduler *scheduler = _shared;
+        [[UAMetricsRegistry shared] registerGaugeForMetric:UAMetricWorkBudgetRemaining block:^double{
+            return scheduler.remainingBudget;
+        }];
+    });
+
+    return _shared;
+}
+
++ (instancetype)schedulerWithLaunchType:(UAWorkLaunchType)launchType
+                     notificationCenter:(NSNotificationCenter *)notificationCenter
+                                   date:(UADate *)date
+                                metrics:(UAMetricsRegistry *)metrics {
+    return [[self alloc] initWithLaunchType:launchType notificationCenter:notificationCenter date:date metrics:metrics];
+}
+
+- (void)dealloc {
+    [self.notificationCenter removeObserver:self];
+}
+
+- (void)applicationWillEnterForeground {
+    [self beginWindowWithLaunchType:UAWorkLaunchTypeForeground];
+}
+
+#pragma mark -
+#pragma mark Budget
+
++ (NSTimeInterval)budgetForLaunchType:(UAWorkLaunchType)launchType {
+    switch (launchType) {
+        case UAWorkLaunchTypeForeground:
+            return UAWorkForegroundBudget;
+        case UAWorkLaunchTypeBackgroundFetch:
+            return UAWorkBackgroundFetchBudget;
+        case UAWorkLaunchTypeSilentPush:
+            return UAWorkSilentPushBudget;
+        case UAWorkLaunchTypeExtension:
+            return UAWorkExtensionBudget;
+        case UAWorkLaunchTypeBackgroundProcessing:
+            return UAWorkBackgroundProcessingBudget;
+    }
+}
+
++ (NSString *)nameForLaunchType:(UAWorkLaunchType)launchType {
+    switch (launchType) {
+        case UAWorkLaunchTypeForeground:
+            return @"foreground";
+        case UAWorkLaunchTypeBackgroundFetch:
+            return @"background fetch";
+        case UAWorkLaunchTypeSilentPush:
+            return @"silent push";
+        case UAWorkLaunchTypeExtension:
+            return @"extension";
+        case UAWorkLaunchTypeBackgroundProcessing:
+            return @"background processing";
+    }
+}
+
+/**
+ * The time spent in the current window, including the time the running jobs have run so far.
+ * Must be called while synchronized on self.
+ */
+- (NSTimeInterval)spentAtDate:(NSDate *)date {
+    NSTimeInterval spent = self.spent;
+    for (UAWorkJob *job in self.runningJobs) {
+        if (job.window == self.window) {
+            spent += MAX(0, [date timeIntervalSinceDate:job.startDate]);
+        }
+    }
+    return spent;
+}
+
+/**
+ * Must be called while synchronized on self.
+ */
+- (BOOL)hasRunningJobsInCurrentWindow {
+    for (UAWorkJob *job in self.runningJobs) {
+        if (job.window == self.window) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+- (NSTimeInterval)remainingBudget {
+    @synchronized (self) {
+        NSTimeInterval budget = [UAWorkScheduler budgetForLaunchType:self.launchType];
+        return MAX(0, budget - [self spentAtDate:self.date.now]);
+    }
+}
+
+- (void)beginWindowWithLaunchType:(UAWorkLaunchType)launchType {
+    @synchronized (self) {
+        // Restarting a window that is still running work would hand it a second budget
+        if (launchType != UAWorkLaunchTypeForeground && [self hasRunningJobsInCurrentWindow]) {
+            UA_LDEBUG(@"Work window active, not starting a %@ window", [UAWorkScheduler nameForLaunchType:launchType]);
+            return;
+        }
+
+        self.launchType = launchType;
+        self.window++;
+        self.spent = 0;
+
+        [self.pendingJobs addObjectsFromArray:self.deferredJobs];
+        [self.deferredJobs removeAllObjects];
+    }
+
+    UA_LDEBUG(@"Starting %@ work window", [UAWorkScheduler nameForLaunchType:launchType]);
+    [self runPendingJobs];
+}
+
+#pragma mark -
+#pragma mark Jobs
+
+- (UADisposable *)submitWorkWithName:(NSString *)name
+                            priority:(UAWorkPriority)priority
+                            deadline:(NSTimeInterval)deadline
+                          dispatcher:(nullable UADispatcher *)dispatcher
+                               block:(UAWorkBlock)block
+                         dropHandler:(nullable void (^)(void))dropHandler {
+    return [self submitWorkWithName:name
+                           priority:priority
+                           deadline:deadline
+                         dispatcher:dispatcher
+                              block:block
+                        dropHandler:dropHandler
+                       deferHandler:nil];
+}
+
+- (UADisposable *)submitWorkWithName:(NSString *)name
+                            priority:(UAWorkPriority)priority
+                            deadline:(NSTimeInterval)deadline
+                          dispatcher:(nullable UADispatcher *)dispatcher
+                               block:(UAWorkBlock)block
+                         dropHandler:(nullable void (^)(void))dropHandler
+                        deferHandler:(nullable void (^)(void))deferHandler {
+    UAWorkJob *job = [[UAWorkJob alloc] init];
+    job.name = name;
+    job.priority = priority;
+    job.deadline = deadline > 0 ? [self.date.now dateByAddingTimeInterval:deadline] : nil;
+    job.dispatcher = dispatcher;
+    job.block = block;
+    job.dropHandler = dropHandler;
+    job.deferHandler = deferHandler;
+
+    @synchronized (self) {
+        job.sequence = self.sequence++;
+        [self.pendingJobs addObject:job];
+    }
+
+    [self runPendingJobs];
+
+    UA_WEAKIFY(self)
+    return [UADisposable disposableWithBlock:^{
+        UA_STRONGIFY(self)
+        [self disposeJob:job];
+    }];
+}
+
+/**
+ * Must be called while synchronized on self.
+ */
+- (nullable UAWorkJob *)nextPendingJob {
+    UAWorkJob *next;
+    for (UAWorkJob *job in self.pendingJobs) {
+        if (!next || [job runsBefore:next]) {
+            next = job;
+        }
+    }
+    return next;
+}
+
+/**
+ * Starts pending jobs while there is room for them, dropping or deferring the ones the budget
+ * no longer allows.
+ */
+- (void)runPendingJobs {
+    NSMutableArray<UAWorkJob *> *started = [NSMutableArray array];
+    NSMutableArray<UAWorkJob *> *dropped = [NSMutableArray array];
+    NSMutableArray<UAWorkJob *> *deferred = [NSMutableArray array];
+
+    @synchronized (self) {
+        NSDate *now = self.date.now;
+        NSTimeInterval budget = [UAWorkScheduler budgetForLaunchType:self.launchType];
+        NSUInteger maxRunningJobs = self.launchType == UAWorkLaunchTypeForeground ? UAWorkForegroundMaxRunningJobs : UAWorkBackgroundMaxRunningJobs;
+
+        while (self.runningJobs.count < maxRunningJobs) {
+            UAWorkJob *job = [self nextPendingJob];
+            if (!job) {
+                break;
+            }
+
+            [self.pendingJobs removeObjectIdenticalTo:job];
+
+            if (job.deadline && [job.deadline compare:now] == NSOrderedAscending) {
+                [dropped addObject:job];
+                continue;
+            }
+
+            if (job.priority != UAWorkPriorityHigh && [self spentAtDate:now] >= budget) {
+                if (job.priority == UAWorkPriorityLow) {
+                    [dropped addObject:job];
+                } else {
+                    [self.deferredJobs addObject:job];
+                    [deferred addObject:job];
+                }
+                continue;
+            }
+
+            job.window = self.window;
+            job.startDate = now;
+            [self.runningJobs addObject:job];
+            [started addObject:job];
+        }
+    }
+
+    if (deferred.count) {
+        UA_LDEBUG(@"Work budget spent, deferring %lu jobs", (unsigned long)deferred.count);
+        [[self.metrics counterWithName:UAMetricWorkDeferred] incrementBy:deferred.count];
+    }
+
+    for (UAWorkJob *job in deferred) {
+        if (job.deferHandler) {
+            job.deferHandler();
+        }
+    }
+
+    for (UAWorkJob *job in dropped) {
+        UA_LDEBUG(@"Dropping work %@", job.name);
+        [self.metrics incrementCounter:UAMetricWorkDropped by:1];
+        @synchronized (self) {
+            job.finished = YES;
+        }
+
+        if (job.dropHandler) {
+            job.dropHandler();
+        }
+    }
+
+    for (UAWorkJob *job in started) {
+        [self startJob:job];
+    }
+}
+
+- (void)startJob:(UAWorkJob *)job {
+    UA_LTRACE(@"Starting work %@", job.name);
+
+    UA_WEAKIFY(self)
+    void (^run)(void) = ^{
+        UA_STRONGIFY(self)
+        UADisposable *disposable = job.block(^{
+            [self finishJob:job];
+        });
+
+        // The job may have been disposed while it was starting
+        BOOL dispose = NO;
+        @synchronized (self) {
+            job.blockReturned = YES;
+            if (job.disposed) {
+                dispose = YES;
+            } else if (!job.finished) {
+                job.disposable = disposable;
+            }
+        }
+
+        if (dispose) {
+            [disposable dispose];
+            [self finishJob:job];
+        }
+    };
+
+    if (job.dispatcher) {
+        [job.dispatcher dispatchAsync:run];
+    } else {
+        run();
+    }
+}
+
+- (void)finishJob:(UAWorkJob *)job {
+    NSTimeInterval duration;
+    @synchronized (self) {
+        if (job.finished) {
+            return;
+        }
+
+        job.finished = YES;
+        job.disposable = nil;
+        [self.runningJobs removeObjectIdenticalTo:job];
+
+        duration = MAX(0, [self.date.now timeIntervalSinceDate:job.startDate]);
+        if (job.window == self.window) {
+            self.spent += duration;
+        }
+    }
+
+    UA_LTRACE(@"Finished work %@ in %.3f seconds", job.name, duration);
+    [self.metrics recordDuration:duration forMetric:[UAMetricWorkPrefix stringByAppendingString:job.name]];
+
+    [self runPendingJobs];
+}
+
+- (void)disposeJob:(UAWorkJob *)job {
+    UADisposable *disposable;
+    @synchronized (self) {
+        if (job.finished || job.disposed) {
+            return;
+        }
+
+        job.disposed = YES;
+
+        if (!job.startDate) {
+            // Not started yet
+            [self.pendingJobs removeObjectIdenticalTo:job];
+            [self.deferredJobs removeObjectIdenticalTo:job];
+            job.finished = YES;
+            return;
+        }
+
+        // Still starting, the job is disposed once its block returns
+        if (!job.blockReturned) {
+            return;
+        }
+
+        disposable = job.disposable;
+    }
+
+    // Work without a disposable can not be stopped, it keeps running until it finishes
+    if (!disposable) {
+        return;
+    }
+
+    [disposable dispose];
+    [self finishJob:job];
+}
+
+@end
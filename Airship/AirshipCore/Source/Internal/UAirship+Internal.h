@@ -4,6 +4,7 @@
 
 @class UAPreferenceDataStore;
 @class UAChannelCapture;
+@class UAExtensionStateSnapshot;
 @class UARemoteConfigManager;
 
 @interface UAirship()
@@ -23,6 +24,7 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong) UAURLAllowList *URLAllowList;
 @property (nonatomic, strong) UAPreferenceDataStore *dataStore;
 @property (nonatomic, strong) UAChannelCapture *channelCapture;
+@property (nonatomic, strong, nullable) UAExtensionStateSnapshot *extensionStateSnapshot;
 @property (nonatomic, copy) NSArray<UAComponent *> *components;
 @property (nonatomic, copy) NSDictionary<NSString *, UAComponent *> *componentClassMap;
 @property (nonatomic, strong) id<UALocationProvider> locationProvider;
@@ -29,9 +29,13 @@
 #import "UAAccengageModuleLoaderFactory.h"
 #import "UADebugLibraryModuleLoaderFactory.h"
 #import "UALocaleManager+Internal.h"
+#import "UAStartupMetrics+Internal.h"
+#import "UABackgroundWorkScheduler+Internal.h"
+#import "UADispatcher.h"
 
 #if !TARGET_OS_TV
 #import "UAChannelCapture+Internal.h"
+#import "UAExtensionStateSnapshot+Internal.h"
 #endif
 
 // Notifications
@@ -92,11 +96,19 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
     uaLoudImpErrorLoggingEnabled = enabled;
 }
 
-+ (void)load {
-    [[NSNotificationCenter defaultCenter] addObserver:[UAirship class]
-                                             selector:@selector(applicationDidFinishLaunching:)
-                                                 name:UAApplicationDidFinishLaunchingNotification
-                                               object:nil];
+/**
+ * Starts app state tracking and observes the launch notification. Done from takeOff rather than +load so
+ * processes that link the SDK without taking off, such as app extensions, do no work before main.
+ */
++ (void)observeLaunch {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        [[NSNotificationCenter defaultCenter] addObserver:[UAirship class]
+                                                 selector:@selector(applicationDidFinishLaunching:)
+                                                     name:UAApplicationDidFinishLaunchingNotification
+                                                   object:nil];
+        [UAAppStateTracker shared];
+    });
 }
 
 #pragma mark -
@@ -118,105 +130,132 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
             [self.dataStore setBool:!(config.isDataCollectionOptInEnabled) forKey:UAirshipDataCollectionEnabledKey];
         }
 
+        UAStartupMetrics *metrics = [UAStartupMetrics shared];
+
         self.actionRegistry = [UAActionRegistry defaultRegistry];
         self.URLAllowList = [UAURLAllowList allowListWithConfig:config];
         self.applicationMetrics = [UAApplicationMetrics applicationMetricsWithDataStore:self.dataStore];
         self.sharedLocaleManager = [UALocaleManager localeManagerWithDataStore:self.dataStore];
 
-        self.sharedChannel = [UAChannel channelWithDataStore:self.dataStore
-                                                      config:self.config
-                                               localeManager:self.sharedLocaleManager];
-
+        [metrics measure:@"Channel" block:^{
+            self.sharedChannel = [UAChannel channelWithDataStore:self.dataStore
+                                                          config:self.config
+                                                   localeManager:self.sharedLocaleManager];
+        }];
         [components addObject:self.sharedChannel];
 
-        self.sharedAnalytics = [UAAnalytics analyticsWithConfig:self.config
-                                                      dataStore:self.dataStore
-                                                        channel:self.sharedChannel
-                                                  localeManager:self.sharedLocaleManager];
+        [metrics measure:@"Analytics" block:^{
+            self.sharedAnalytics = [UAAnalytics analyticsWithConfig:self.config
+                                                          dataStore:self.dataStore
+                                                            channel:self.sharedChannel
+                                                      localeManager:self.sharedLocaleManager];
+        }];
         [components addObject:self.sharedAnalytics];
 
-
-        self.sharedPush = [UAPush pushWithConfig:self.config
-                                       dataStore:self.dataStore
-                                         channel:self.sharedChannel
-                                       analytics:self.sharedAnalytics];
+        [metrics measure:@"Push" block:^{
+            self.sharedPush = [UAPush pushWithConfig:self.config
+                                           dataStore:self.dataStore
+                                             channel:self.sharedChannel
+                                           analytics:self.sharedAnalytics];
+        }];
         [components addObject:self.sharedPush];
 
-        
-        self.sharedNamedUser = [UANamedUser namedUserWithChannel:self.sharedChannel
-                                                          config:self.config
-                                                       dataStore:self.dataStore];
+        [metrics measure:@"Named User" block:^{
+            self.sharedNamedUser = [UANamedUser namedUserWithChannel:self.sharedChannel
+                                                              config:self.config
+                                                           dataStore:self.dataStore];
+        }];
         [components addObject:self.sharedNamedUser];
 
-        self.sharedRemoteDataManager = [UARemoteDataManager remoteDataManagerWithConfig:self.config
-                                                                              dataStore:self.dataStore
-                                                                          localeManager:self.sharedLocaleManager];
+        [metrics measure:@"Remote Data" block:^{
+            self.sharedRemoteDataManager = [UARemoteDataManager remoteDataManagerWithConfig:self.config
+                                                                                  dataStore:self.dataStore
+                                                                              localeManager:self.sharedLocaleManager];
+            self.sharedRemoteConfigManager = [UARemoteConfigManager remoteConfigManagerWithRemoteDataManager:self.sharedRemoteDataManager
+                                                                                          applicationMetrics:self.applicationMetrics];
+        }];
         [components addObject:self.sharedRemoteDataManager];
 
-        self.sharedRemoteConfigManager = [UARemoteConfigManager remoteConfigManagerWithRemoteDataManager:self.sharedRemoteDataManager
-                                                                                      applicationMetrics:self.applicationMetrics];
-        
 #if !TARGET_OS_TV
         // UIPasteboard is not available in tvOS
         self.channelCapture = [UAChannelCapture channelCaptureWithConfig:self.config
                                                                  channel:self.sharedChannel
                                                                dataStore:self.dataStore];
+
+        // Shares the channel ID and config with the notification extensions
+        self.extensionStateSnapshot = [UAExtensionStateSnapshot snapshotWithConfig:self.config
+                                                                            channel:self.sharedChannel
+                                                                          analytics:self.sharedAnalytics];
 #endif
 
         NSMutableArray<id<UAModuleLoader>> *loaders = [NSMutableArray array];
 
-        id<UAModuleLoader, UALocationProviderLoader> locationLoader = [UAirship locationLoaderWithDataStore:self.dataStore
-                                                                                                    channel:self.sharedChannel
-                                                                                                  analytics:self.sharedAnalytics];
-        if (locationLoader) {
-            [loaders addObject:locationLoader];
-            self.locationProvider = locationLoader.locationProvider;
-        }
+        [metrics measure:@"Location Module" block:^{
+            id<UAModuleLoader, UALocationProviderLoader> locationLoader = [UAirship locationLoaderWithDataStore:self.dataStore
+                                                                                                        channel:self.sharedChannel
+                                                                                                      analytics:self.sharedAnalytics];
+            if (locationLoader) {
+                [loaders addObject:locationLoader];
+                self.locationProvider = locationLoader.locationProvider;
+            }
+        }];
 
-        id<UAModuleLoader> automationLoader = [UAirship automationModuleLoaderWithDataStore:self.dataStore
-                                                                                     config:self.config
-                                                                                    channel:self.sharedChannel
-                                                                                  namedUser:self.sharedNamedUser
-                                                                                  analytics:self.sharedAnalytics
-                                                                          remoteDataManager:self.sharedRemoteDataManager];
-        if (automationLoader) {
-            [loaders addObject:automationLoader];
-        }
-        
-        id<UAModuleLoader> messageCenterLoader = [UAirship messageCenterLoaderWithDataStore:self.dataStore
-                                                                                     config:self.config
-                                                                                    channel:self.sharedChannel];
-        if (messageCenterLoader) {
-            [loaders addObject:messageCenterLoader];
-        }
+        [metrics measure:@"Automation Module" block:^{
+            id<UAModuleLoader> automationLoader = [UAirship automationModuleLoaderWithDataStore:self.dataStore
+                                                                                         config:self.config
+                                                                                        channel:self.sharedChannel
+                                                                                      namedUser:self.sharedNamedUser
+                                                                                      analytics:self.sharedAnalytics
+                                                                              remoteDataManager:self.sharedRemoteDataManager];
+            if (automationLoader) {
+                [loaders addObject:automationLoader];
+            }
+        }];
 
-        id<UAModuleLoader> accengageLoader = [UAirship accengageModuleLoaderWithDataStore:self.dataStore
-                                                                                  channel:self.sharedChannel
-                                                                                     push:self.sharedPush
-                                                                                analytics:self.sharedAnalytics];
-        if (accengageLoader) {
-            [loaders addObject:accengageLoader];
-        }
+        [metrics measure:@"Message Center Module" block:^{
+            id<UAModuleLoader> messageCenterLoader = [UAirship messageCenterLoaderWithDataStore:self.dataStore
+                                                                                         config:self.config
+                                                                                        channel:self.sharedChannel];
+            if (messageCenterLoader) {
+                [loaders addObject:messageCenterLoader];
+            }
+        }];
 
-        id<UAModuleLoader> extendedActionsLoader = [UAirship extendedActionsModuleLoader];
-        if (extendedActionsLoader) {
-            [loaders addObject:extendedActionsLoader];
-        }
+        [metrics measure:@"Accengage Module" block:^{
+            id<UAModuleLoader> accengageLoader = [UAirship accengageModuleLoaderWithDataStore:self.dataStore
+                                                                                      channel:self.sharedChannel
+                                                                                         push:self.sharedPush
+                                                                                    analytics:self.sharedAnalytics];
+            if (accengageLoader) {
+                [loaders addObject:accengageLoader];
+            }
+        }];
 
-        id<UAModuleLoader> debugLibraryLoader = [UAirship debugLibraryModuleLoaderWithAnalytics:self.sharedAnalytics];
-        if (debugLibraryLoader) {
-            [loaders addObject:debugLibraryLoader];
-        }
+        [metrics measure:@"Extended Actions Module" block:^{
+            id<UAModuleLoader> extendedActionsLoader = [UAirship extendedActionsModuleLoader];
+            if (extendedActionsLoader) {
+                [loaders addObject:extendedActionsLoader];
+            }
+        }];
 
-        for (id<UAModuleLoader> loader in loaders) {
-            if ([loader respondsToSelector:@selector(components)]) {
-                [components addObjectsFromArray:[loader components]];
+        [metrics measure:@"Debug Module" block:^{
+            id<UAModuleLoader> debugLibraryLoader = [UAirship debugLibraryModuleLoaderWithAnalytics:self.sharedAnalytics];
+            if (debugLibraryLoader) {
+                [loaders addObject:debugLibraryLoader];
             }
+        }];
+
+        [metrics measure:@"Module Actions" block:^{
+            for (id<UAModuleLoader> loader in loaders) {
+                if ([loader respondsToSelector:@selector(components)]) {
+                    [components addObjectsFromArray:[loader components]];
+                }
 
-            if ([loader respondsToSelector:@selector(registerActions:)]) {
-                [loader registerActions:self.actionRegistry];
+                if ([loader respondsToSelector:@selector(registerActions:)]) {
+                    [loader registerActions:self.actionRegistry];
+                }
             }
-        }
+        }];
 
         self.components = components;
 
@@ -238,7 +277,12 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
         return;
     }
 
-    [UAirship takeOff:[UAConfig defaultConfig]];
+    __block UAConfig *config;
+    [[UAStartupMetrics shared] measure:@"Config Loading" block:^{
+        config = [UAConfig defaultConfig];
+    }];
+
+    [UAirship takeOff:config];
 }
 
 + (void)takeOff:(UAConfig *)config {
@@ -253,7 +297,11 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
     }
 
     dispatch_once(&takeOffPred_, ^{
-        [UAirship executeUnsafeTakeOff:[config copy]];
+        UAStartupMetrics *metrics = [UAStartupMetrics shared];
+        [metrics measure:@"TakeOff" block:^{
+            [UAirship executeUnsafeTakeOff:[config copy]];
+        }];
+        UA_LDEBUG(@"Airship startup: %@", metrics.summary);
     });
     
     if ([UAirship shared].config.isExtendedBroadcastsEnabled) {
@@ -282,7 +330,12 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
         return;
     }
 
-    UARuntimeConfig *runtimeConfig = [UARuntimeConfig runtimeConfigWithConfig:config];
+    [UAirship observeLaunch];
+
+    __block UARuntimeConfig *runtimeConfig;
+    [[UAStartupMetrics shared] measure:@"Config Validation" block:^{
+        runtimeConfig = [UARuntimeConfig runtimeConfigWithConfig:config];
+    }];
 
     // Ensure that app credentials are valid
     if (!runtimeConfig) {
@@ -293,6 +346,12 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
 
     [UAirship setLogLevel:runtimeConfig.logLevel];
 
+    // Before any component creates its queues
+    [UADispatcher setQualityOfService:runtimeConfig.uploadQualityOfService forWorkType:UADispatcherWorkTypeUpload];
+    [UADispatcher setQualityOfService:runtimeConfig.processingQualityOfService forWorkType:UADispatcherWorkTypeProcessing];
+    [UADispatcher setQualityOfService:runtimeConfig.maintenanceQualityOfService forWorkType:UADispatcherWorkTypeMaintenance];
+    [UADispatcher setQualityOfService:runtimeConfig.displayQualityOfService forWorkType:UADispatcherWorkTypeDisplay];
+
     if (runtimeConfig.inProduction) {
         [UAirship setLoudImpErrorLogging:NO];
     }
@@ -332,8 +391,14 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
     } dispatcher:[UADispatcher mainDispatcher]];
 
     // Create Airship
-    [UAirship setSharedAirship:[[UAirship alloc] initWithRuntimeConfig:runtimeConfig
-                                                             dataStore:dataStore]];
+    [[UAStartupMetrics shared] measure:@"Components" block:^{
+        [UAirship setSharedAirship:[[UAirship alloc] initWithRuntimeConfig:runtimeConfig
+                                                                 dataStore:dataStore]];
+    }];
+
+    // The background tasks have to be registered before the app finishes launching
+    [sharedAirship_ registerBackgroundWork];
+    [[UABackgroundWorkScheduler shared] registerTasks];
 
     // Save the version
     if ([[UAirshipVersion get] isEqualToString:@"0.0.0"]) {
@@ -348,15 +413,19 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
         }
     }
 
-    // Validate any setup issues
+    // Validate any setup issues. Validation only logs, so it waits until launch finishes.
     if (!runtimeConfig.inProduction) {
-        [sharedAirship_ validate];
+        [[UADispatcher mainDispatcher] dispatchAsync:^{
+            [sharedAirship_ validate];
+        }];
     }
 
     // Automatic setup
     if (sharedAirship_.config.automaticSetupEnabled) {
         UA_LINFO(@"Automatic setup enabled.");
-        [UAAutoIntegration integrate];
+        [[UAStartupMetrics shared] measure:@"Auto Integration" block:^{
+            [UAAutoIntegration integrate];
+        }];
     }
 
     if (!handledLaunch_) {
@@ -509,6 +578,43 @@ BOOL uaLoudImpErrorLoggingEnabled = YES;
 }
 
 
+/**
+ * Batches the uploads and refreshes that normally run in the short background task after the
+ * app is backgrounded into the scheduled background windows. The channel and named user upload
+ * in their own background tasks, so their work only starts the uploads.
+ */
+- (void)registerBackgroundWork {
+    UABackgroundWorkScheduler *scheduler = [UABackgroundWorkScheduler shared];
+
+    UA_WEAKIFY(self)
+    [scheduler registerWorkWithName:@"analytics" type:UABackgroundWorkTypeRefresh block:^UADisposable *(void (^completionHandler)(BOOL)) {
+        UA_STRONGIFY(self)
+        if (!self) {
+            completionHandler(YES);
+            return nil;
+        }
+        return [self.sharedAnalytics uploadEventsWithCompletionHandler:completionHandler];
+    }];
+
+    [scheduler registerWorkWithName:@"registration" type:UABackgroundWorkTypeRefresh block:^UADisposable *(void (^completionHandler)(BOOL)) {
+        UA_STRONGIFY(self)
+        [self.sharedChannel updateRegistration];
+        [self.sharedNamedUser update];
+        completionHandler(YES);
+        return nil;
+    }];
+
+    [scheduler registerWorkWithName:@"remote_data" type:UABackgroundWorkTypeRefresh block:^UADisposable *(void (^completionHandler)(BOOL)) {
+        UA_STRONGIFY(self)
+        if (!self) {
+            completionHandler(YES);
+            return nil;
+        }
+        [self.sharedRemoteDataManager refreshWithCompletionHandler:completionHandler];
+        return nil;
+    }];
+}
+
 - (UAComponent *)componentForClassName:(NSString *)className {
     return self.componentClassMap[className];
 }
@@ -32,6 +32,7 @@
 #import "UAAttributePendingMutations.h"
 #import "UAAttributes.h"
 #import "UAAutomationModuleLoaderFactory.h"
+#import "UABackgroundWorkScheduler.h"
 #import "UABespokeCloseView.h"
 #import "UABeveledLoadingIndicator.h"
 #import "UAChannel.h"
@@ -43,9 +44,11 @@
 #import "UAComponent.h"
 #import "UAConfig.h"
 #import "UACustomEvent.h"
+#import "UACustomEventPropertiesBuilder.h"
 #import "UADate.h"
 #import "UADebugLibraryModuleLoaderFactory.h"
 #import "UADeepLinkAction.h"
+#import "UADispatchTimer.h"
 #import "UADispatcher.h"
 #import "UADisposable.h"
 #import "UAEnableFeatureAction.h"
@@ -53,7 +56,9 @@
 #import "UAExtendableAnalyticsHeaders.h"
 #import "UAExtendableChannelRegistration.h"
 #import "UAExtendedActionsModuleLoaderFactory.h"
+#import "UAExtensionEventJournal.h"
 #import "UAFetchDeviceInfoAction.h"
+#import "UAForegroundWorkScheduler.h"
 #import "UAGlobal.h"
 #import "UAInstallAttributionEvent.h"
 #import "UAJSONMatcher.h"
@@ -68,7 +73,9 @@
 #import "UALocationModuleLoaderFactory.h"
 #import "UALocationProvider.h"
 #import "UAMediaEventTemplate.h"
+#import "UAMemoryPressureCoordinator.h"
 #import "UAMessageCenterModuleLoaderFactory.h"
+#import "UAMetricsRegistry.h"
 #import "UAModifyTagsAction.h"
 #import "UAModuleLoader.h"
 #import "UANSDictionaryValueTransformer.h"
@@ -77,6 +84,9 @@
 #import "UANativeBridge.h"
 #import "UANativeBridgeDelegate.h"
 #import "UANativeBridgeExtensionDelegate.h"
+#import "UANetworkMetrics.h"
+#import "UANetworkMonitor.h"
+#import "UANetworkWindow.h"
 #import "UANotificationAction.h"
 #import "UANotificationCategories.h"
 #import "UANotificationCategory.h"
@@ -101,8 +111,11 @@
 #import "UASemaphore.h"
 #import "UAShareAction.h"
 #import "UASystemVersion.h"
+#import "UATagEditor.h"
 #import "UATagGroups.h"
 #import "UATagGroupsMutation.h"
+#import "UATask.h"
+#import "UATaskQueue.h"
 #import "UATextInputNotificationAction.h"
 #import "UAURLAllowList.h"
 #import "UAUtils.h"
@@ -110,6 +123,7 @@
 #import "UAViewUtils.h"
 #import "UAWalletAction.h"
 #import "UAWebView.h"
+#import "UAWorkScheduler.h"
 #import "UA_Base64.h"
 #import "UAirship.h"
 #import "UAirshipCoreResources.h"
@@ -16,6 +16,20 @@ NS_ASSUME_NONNULL_BEGIN
 + (instancetype)managedObjectContextForModelURL:(NSURL *)modelURL
                                 concurrencyType:(NSManagedObjectContextConcurrencyType)concurrencyType;
 
+/**
+ * Creates a private queue managed object context that defers loading the model and adding its
+ * persistent stores until the first `safePerformBlock:`. Nothing is read from disk until then.
+ * If the loader fails to add a store, for instance while protected data is unavailable, it is
+ * called again on the next `safePerformBlock:`.
+ *
+ * @param modelURL The url to coredata model. Models are loaded once per URL and shared.
+ * @param storeLoader Called on the context's queue to add the persistent stores, using
+ * `addPersistentSqlStore:error:` or `addPersistentInMemoryStore:error:`.
+ * @return A managed object context.
+ */
++ (instancetype)lazyManagedObjectContextForModelURL:(NSURL *)modelURL
+                                        storeLoader:(void (^)(NSManagedObjectContext *context))storeLoader;
+
 
 /**
  * Attempts to add a persistent sql store to the managed object. The store will be created
@@ -36,6 +50,39 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)addPersistentInMemoryStore:(NSString *)storeName
             completionHandler:(nonnull void(^)(NSPersistentStore *, NSError *))completionHandler;
 
+/**
+ * Adds a persistent sql store to the managed object in an Airship no backup directory.
+ * Must be called on the context's queue.
+ *
+ * @param storeName The store name.
+ * @param error The error, if the store could not be added.
+ * @return The store, or `nil` if the store could not be added.
+ */
+- (nullable NSPersistentStore *)addPersistentSqlStore:(NSString *)storeName error:(NSError **)error;
+
+/**
+ * Adds a persistent sql store to the managed object in an Airship no backup directory.
+ * Must be called on the context's queue.
+ *
+ * @param storeName The store name.
+ * @param options Additional store options, such as `NSSQLiteManualVacuumOption`. Automatic
+ * migration is always enabled.
+ * @param error The error, if the store could not be added.
+ * @return The store, or `nil` if the store could not be added.
+ */
+- (nullable NSPersistentStore *)addPersistentSqlStore:(NSString *)storeName
+                                              options:(nullable NSDictionary *)options
+                                                error:(NSError **)error;
+
+/**
+ * Adds an in-memory store to the managed object. Must be called on the context's queue.
+ *
+ * @param storeName The store name.
+ * @param error The error, if the store could not be added.
+ * @return The store, or `nil` if the store could not be added.
+ */
+- (nullable NSPersistentStore *)addPersistentInMemoryStore:(NSString *)storeName error:(NSError **)error;
+
 /**
  * Calls `context save` but first checks if it has a persistent store.
  * @return `YES` if the context was able to save, otherwise `NO`.
@@ -45,6 +92,7 @@ NS_ASSUME_NONNULL_BEGIN
 /**
  * Performs a block with the passed in boolean indicating if it's safe to perform
  * operations. Safe is determined by checking if the context has any persistent stores.
+ * Lazy contexts load their stores first if needed.
  * @param block A block to perform.
  */
 - (void)safePerformBlock:(void (^)(BOOL))block;
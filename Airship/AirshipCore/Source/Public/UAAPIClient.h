@@ -55,6 +55,31 @@ extern NSUInteger const UAAPIClientStatusUnavailable;
  */
 - (instancetype)initWithConfig:(UARuntimeConfig *)config session:(UARequestSession *)session;
 
+/**
+ * Performs a request. If a request with the same key is already in flight, the completion handler
+ * is attached to it instead, and called with that request's result.
+ *
+ * @param request The request.
+ * @param requestKey The key identifying identical requests, or `nil` to always perform the request.
+ * See `requestKeyForRequest:`.
+ * @param retryBlock An optional block that decides if the request should be retried. Only the block of
+ * the request that is performed is used.
+ * @param completionHandler A callback to be invoked once the request is completed.
+ */
+- (void)dataTaskWithRequest:(UARequest *)request
+                 requestKey:(nullable NSString *)requestKey
+                 retryWhere:(nullable UARequestRetryBlock)retryBlock
+          completionHandler:(UARequestCompletionHandler)completionHandler;
+
+/**
+ * Returns a key derived from the request method, URL and body. Requests with the same key are identical.
+ * Streamed bodies are not part of the key.
+ *
+ * @param request The request.
+ * @return The request key.
+ */
++ (NSString *)requestKeyForRequest:(UARequest *)request;
+
 /**
  * Cancels all in-flight API requests.
  */
@@ -23,6 +23,23 @@ typedef void (^UAActionCompletionHandler)(UAActionResult *);
  */
 typedef void (^UAActionBlock)(UAActionArguments *, UAActionCompletionHandler completionHandler);
 
+/**
+ * Represents the thread an action is performed on.
+ */
+typedef NS_ENUM(NSUInteger, UAActionThreadAffinity) {
+    /**
+     * The action is performed on the main queue.
+     */
+    UAActionThreadAffinityMain,
+
+    /**
+     * The action does not touch the UI and may be performed on a background queue.
+     * Background actions are performed serially with each other, but concurrently
+     * with main queue actions.
+     */
+    UAActionThreadAffinityBackground
+};
+
 /**
  * Base class for actions, which defines a modular unit of work.
  */
@@ -77,6 +94,18 @@ typedef void (^UAActionBlock)(UAActionArguments *, UAActionCompletionHandler com
 - (void)performWithArguments:(UAActionArguments *)arguments
            completionHandler:(UAActionCompletionHandler)completionHandler;
 
+/**
+ * The thread the action's acceptsArguments:, willPerformWithArguments: and
+ * performWithArguments:completionHandler: are called on. The didPerformWithArguments:withResult:
+ * and the final completion handler are always called on the main queue.
+ *
+ * Subclasses that do not interact with the UI can override this method to return
+ * `UAActionThreadAffinityBackground`. Defaults to `UAActionThreadAffinityMain`.
+ *
+ * @return The action's thread affinity.
+ */
+- (UAActionThreadAffinity)threadAffinity;
+
 ///---------------------------------------------------------------------------------------
 /// @name Action Factories
 ///---------------------------------------------------------------------------------------
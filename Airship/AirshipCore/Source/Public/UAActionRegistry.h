@@ -164,6 +164,17 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (nullable UAActionRegistryEntry *)registryEntryWithName:(NSString *)name;
 
+/**
+ * Checks if all of the registered actions for the names can run off the main queue in the
+ * given situation, i.e. none of them has `UAActionThreadAffinityMain`. Names that are not
+ * registered are ignored, as they are never run.
+ *
+ * @param names The action names or aliases.
+ * @param situation The situation the actions will run in.
+ * @return `YES` if the actions can run off the main queue, otherwise `NO`.
+ */
+- (BOOL)isBackgroundSafeForActionNames:(NSArray<NSString *> *)names situation:(UASituation)situation;
+
 /**
  * Registers actions from a plist.
  */
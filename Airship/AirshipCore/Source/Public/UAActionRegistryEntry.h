@@ -59,6 +59,13 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (UAAction *)actionForSituation:(UASituation)situation;
 
+/**
+ * Returns the thread affinity of the action for the situation.
+ * @param situation The specified UASituation enum value
+ * @return The thread affinity of the action for the situation.
+ */
+- (UAActionThreadAffinity)threadAffinityForSituation:(UASituation)situation;
+
 @end
 
 NS_ASSUME_NONNULL_END
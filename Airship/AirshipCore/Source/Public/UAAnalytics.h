@@ -5,6 +5,7 @@
 #import "UAAnalyticsEventConsumerProtocol.h"
 
 @class UAEvent;
+@class UARegionEvent;
 @class UAAssociatedIdentifiers;
 
 NS_ASSUME_NONNULL_BEGIN
@@ -42,8 +43,15 @@ typedef NS_ENUM(NSUInteger, UASDKExtension) {
 
 extern NSString *const UACustomEventAdded;
 extern NSString *const UARegionEventAdded;
+extern NSString *const UARegionEventsAdded;
 extern NSString *const UAScreenTracked;
 extern NSString *const UAEventKey;
+extern NSString *const UAEventsKey;
+
+/**
+ * How long `addRegionEvents:` holds region events before adding them, in seconds.
+ */
+extern NSTimeInterval const UAAnalyticsRegionEventDebounceInterval;
 extern NSString *const UAScreenKey;
 
 /**
@@ -107,6 +115,26 @@ extern NSString *const UAScreenKey;
  */
 - (void)addEvent:(UAEvent *)event;
 
+/**
+ * Triggers an analytics event. The event is validated and serialized off the calling thread,
+ * so it should not be modified after this call.
+ *
+ * @param event The event to be triggered
+ * @param completionHandler Called on the main queue with whether the event was accepted. Events are
+ * rejected when they are invalid or when analytics is disabled.
+ */
+- (void)addEvent:(UAEvent *)event completionHandler:(nullable void (^)(BOOL accepted))completionHandler;
+
+/**
+ * Adds region events in batches. Events are held for `UAAnalyticsRegionEventDebounceInterval`
+ * after the first one, then an enter and exit of the same region within that window cancel each
+ * other out and the remaining events are added in a single write and automation pass. Use for
+ * sources that produce bursts of events, like dense beacon deployments.
+ *
+ * @param events The region events, oldest first.
+ */
+- (void)addRegionEvents:(NSArray<UARegionEvent *> *)events;
+
 /**
  * Associates identifiers with the device. This call will add a special event
  * that will be batched and sent up with our other analytics events. Previous
@@ -67,7 +67,8 @@ extern NSString *const UAApplicationLaunchOptionsRemoteNotificationKey;
 @interface UAAppStateTracker : NSObject
 
 /**
- * The current application state.
+ * The current application state. Safe to read from any thread. Off the main queue, the last state
+ * reported by the application lifecycle notifications is returned.
  */
 @property(nonatomic, readonly) UAApplicationState state;
 
@@ -0,0 +1,69 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+#import "UADisposable.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Background work types.
+ */
+typedef NS_ENUM(NSUInteger, UABackgroundWorkType) {
+    /**
+     * Short work, such as uploads and refreshes. Runs in an app refresh task.
+     */
+    UABackgroundWorkTypeRefresh,
+
+    /**
+     * Longer work that needs the network, such as asset prefetches. Runs in a processing task.
+     */
+    UABackgroundWorkTypeProcessing,
+};
+
+/**
+ * A background work block. The block must call the completion handler once the work has finished.
+ * The returned disposable, if any, is disposed when the background window expires. Work should
+ * keep the progress it has made so far, so the next window picks up where it left off.
+ */
+typedef UADisposable * _Nullable (^UABackgroundWorkBlock)(void (^completionHandler)(BOOL success));
+
+/**
+ * The app refresh task identifier. Add it to `BGTaskSchedulerPermittedIdentifiers` in the app's
+ * Info.plist to run refresh work in the background.
+ */
+extern NSString *const UABackgroundRefreshTaskIdentifier;
+
+/**
+ * The processing task identifier. Add it to `BGTaskSchedulerPermittedIdentifiers` in the app's
+ * Info.plist to run processing work in the background.
+ */
+extern NSString *const UABackgroundProcessingTaskIdentifier;
+
+/**
+ * Batches the SDK's deferred work into scheduled background windows.
+ *
+ * On iOS 13+, when the app's Info.plist permits the task identifiers, the work is run by
+ * `BGAppRefreshTask` and `BGProcessingTask` instead of only in the few seconds a background task
+ * gives the app after it is backgrounded. Each window runs all the work of its type together.
+ * @note For internal use only. :nodoc:
+ */
+@interface UABackgroundWorkScheduler : NSObject
+
+/**
+ * The shared scheduler.
+ */
++ (instancetype)shared;
+
+/**
+ * Registers work to run in each background window of the given type. Work registered with the
+ * same name replaces the previous work.
+ *
+ * @param name The work name.
+ * @param type The work type.
+ * @param block The work block.
+ */
+- (void)registerWorkWithName:(NSString *)name type:(UABackgroundWorkType)type block:(UABackgroundWorkBlock)block;
+
+@end
+
+NS_ASSUME_NONNULL_END
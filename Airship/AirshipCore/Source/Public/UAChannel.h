@@ -4,6 +4,7 @@
 #import "UAChannelNotificationCenterEvents.h"
 #import "UAAttributeMutations.h"
 #import "UATagGroupsMutation.h"
+#import "UATagEditor.h"
 #import "UAAttributePendingMutations.h"
 
 NS_ASSUME_NONNULL_BEGIN
@@ -78,6 +79,13 @@ extern NSString *const UAChannelUploadedAudienceMutationNotificationDateKey;
  */
 @property (nonatomic, copy) NSArray<NSString *> *tags;
 
+/**
+ * The device tags as a set, for fast membership checks. The set is a snapshot that is
+ * only rebuilt when the tags change.
+ * @note For internal use only. :nodoc:
+ */
+@property (nonatomic, readonly) NSSet<NSString *> *tagSet;
+
 /**
  * Allows setting tags from the device. Tags can be set from either the server or the device, but
  * not both (without synchronizing the data), so use this flag to explicitly enable or disable
@@ -136,6 +144,13 @@ extern NSString *const UAChannelUploadedAudienceMutationNotificationDateKey;
  */
 - (void)removeTags:(NSArray<NSString *> *)tags;
 
+/**
+ * Edits the device tags. All of the edits made in the block are saved together, and the
+ * registration is updated once afterwards if the tags changed.
+ *
+ * @param editorBlock A block that edits the tags.
+ */
+- (void)editTags:(void (^)(UATagEditor *editor))editorBlock;
 
 ///---------------------------------------------------------------------------------------
 /// @name Tag Groups
@@ -4,10 +4,22 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ * The deep link scheme handled by channel capture.
+ */
+extern NSString *const UAChannelCaptureDeepLinkScheme;
+
+/**
+ * The deep link host handled by channel capture.
+ */
+extern NSString *const UAChannelCaptureDeepLinkHost;
+
 /**
  * Channel Capture copies the channelId to the device clipboard after a specific number of
- * knocks (app foregrounds) within a specific timeframe. Channel Capture can be enabled
- * or disabled in Airship Config.
+ * knocks (app foregrounds) within a specific timeframe. The pasteboard is only written once
+ * the knocks are detected. Alternatively, the `uairship://channel_capture` deep link shares
+ * the channelId through the share sheet without touching the pasteboard. Channel Capture can
+ * be enabled or disabled in Airship Config.
  */
 API_UNAVAILABLE(tvos)
 @interface UAChannelCapture : NSObject
@@ -22,6 +34,16 @@ API_UNAVAILABLE(tvos)
  */
 @property (nonatomic, assign) BOOL enabled;
 
+/**
+ * Handles the `uairship://channel_capture` deep link by presenting the share sheet with the
+ * channelId. Call this from the app's URL handling if deep links are not routed through the
+ * deep link action.
+ *
+ * @param url The deep link.
+ * @return `YES` if the deep link is a channel capture deep link, otherwise `NO`.
+ */
+- (BOOL)handleDeepLink:(NSURL *)url;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -215,6 +215,15 @@ typedef NS_ENUM(NSUInteger, UACloudSite) {
  */
 @property (nonatomic, assign, getter=isExtendedBroadcastsEnabled) BOOL extendedBroadcastsEnabled;
 
+/**
+ * Flag indicating whether lazy Message Center is enabled. If set to `YES` the Message Center
+ * user will not be created and the inbox will not be loaded or refreshed until the Message Center
+ * is first accessed or a Message Center push is received.
+ *
+ * Defaults to `NO`.
+ */
+@property (nonatomic, assign, getter=isLazyMessageCenterEnabled) BOOL lazyMessageCenterEnabled;
+
 /**
  * Dictionary of custom config values.
  */
@@ -229,6 +238,38 @@ typedef NS_ENUM(NSUInteger, UACloudSite) {
  */
 @property (nonatomic, assign) BOOL requestAuthorizationToUseNotifications;
 
+/**
+ * The quality of service for SDK network uploads, such as events, tags, attributes and
+ * Message Center sync. In the plist, use `BACKGROUND`, `UTILITY`, `DEFAULT`, `USER_INITIATED`
+ * or `USER_INTERACTIVE`.
+ *
+ * Defaults to `NSQualityOfServiceUtility`.
+ */
+@property (nonatomic, assign) NSQualityOfService uploadQualityOfService;
+
+/**
+ * The quality of service for SDK work that is not on the display path, such as event store writes,
+ * automation evaluation and remote data processing.
+ *
+ * Defaults to `NSQualityOfServiceUtility`.
+ */
+@property (nonatomic, assign) NSQualityOfService processingQualityOfService;
+
+/**
+ * The quality of service for SDK garbage collection and store trimming.
+ *
+ * Defaults to `NSQualityOfServiceBackground`.
+ */
+@property (nonatomic, assign) NSQualityOfService maintenanceQualityOfService;
+
+/**
+ * The quality of service for SDK work the UI is waiting on, such as preparing an in-app message
+ * for display.
+ *
+ * Defaults to `NSQualityOfServiceUserInitiated`.
+ */
+@property (nonatomic, assign) NSQualityOfService displayQualityOfService;
+
 ///---------------------------------------------------------------------------------------
 /// @name Internal Configuration Options
 ///---------------------------------------------------------------------------------------
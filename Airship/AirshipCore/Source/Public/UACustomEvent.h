@@ -2,6 +2,7 @@
 
 #import <Foundation/Foundation.h>
 #import "UAEvent.h"
+#import "UACustomEventPropertiesBuilder.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -118,6 +119,14 @@ extern NSString *const UACustomEventInteractionTypeKey;
  */
 - (void)setInteractionFromMessageCenterMessage:(NSString *)messageID;
 
+/**
+ * Sets the event's properties from a builder, replacing any existing properties. The properties
+ * are written to the event as JSON without creating a dictionary, unless `properties` is read.
+ *
+ * @param builder The properties builder.
+ */
+- (void)setPropertiesWithBuilder:(UACustomEventPropertiesBuilder *)builder;
+
 /**
  * Adds the event to analytics.
  */
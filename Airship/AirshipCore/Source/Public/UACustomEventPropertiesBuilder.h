@@ -0,0 +1,79 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Builds custom event properties from typed values.
+ *
+ * Values are written straight to JSON as they are set, so tracking an event built from the
+ * builder does not create any intermediate property dictionaries. Use with
+ * `[UACustomEvent setPropertiesWithBuilder:]`. Each key can only be set once.
+ */
+@interface UACustomEventPropertiesBuilder : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Custom Event Properties Builder Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The number of properties set.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+///---------------------------------------------------------------------------------------
+/// @name Custom Event Properties Builder Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Sets a string property.
+ *
+ * @param value The value.
+ * @param key The key.
+ */
+- (void)setString:(NSString *)value forKey:(NSString *)key;
+
+/**
+ * Sets an integer property.
+ *
+ * @param value The value.
+ * @param key The key.
+ */
+- (void)setInteger:(NSInteger)value forKey:(NSString *)key;
+
+/**
+ * Sets a double property. NaN and infinite values are ignored.
+ *
+ * @param value The value.
+ * @param key The key.
+ */
+- (void)setDouble:(double)value forKey:(NSString *)key;
+
+/**
+ * Sets a boolean property.
+ *
+ * @param value The value.
+ * @param key The key.
+ */
+- (void)setBool:(BOOL)value forKey:(NSString *)key;
+
+/**
+ * Sets a number property. Boolean numbers are written as booleans.
+ *
+ * @param value The value.
+ * @param key The key.
+ */
+- (void)setNumber:(NSNumber *)value forKey:(NSString *)key;
+
+/**
+ * Sets a string array property.
+ *
+ * @param values The values.
+ * @param key The key.
+ */
+- (void)setStrings:(NSArray<NSString *> *)values forKey:(NSString *)key;
+
+@end
+
+NS_ASSUME_NONNULL_END
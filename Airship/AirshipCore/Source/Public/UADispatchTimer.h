@@ -0,0 +1,51 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A reusable timer backed by a dispatch source. The timer can be rescheduled in place,
+ * and cancelling it disarms the source so the queue is not woken up for cancelled work.
+ * The block runs at most once per schedule.
+ * @note For internal use only. :nodoc:
+ */
+@interface UADispatchTimer : NSObject
+
+/**
+ * The date the timer will fire, or nil if it is not scheduled.
+ */
+@property (atomic, readonly, nullable) NSDate *fireDate;
+
+/**
+ * Factory method.
+ *
+ * @param queue The queue the block is called on.
+ * @param block The block to call when the timer fires.
+ * @return A timer that is not scheduled.
+ */
++ (instancetype)timerWithQueue:(dispatch_queue_t)queue block:(void (^)(void))block;
+
+/**
+ * Schedules the timer, replacing any earlier schedule.
+ *
+ * @param delay The delay in seconds. A delay <= 0 fires as soon as possible.
+ */
+- (void)scheduleWithDelay:(NSTimeInterval)delay;
+
+/**
+ * Schedules the timer unless it is already scheduled to fire sooner.
+ *
+ * @param delay The delay in seconds.
+ * @return `YES` if the timer was scheduled, `NO` if it was left as is.
+ */
+- (BOOL)scheduleIfEarlierWithDelay:(NSTimeInterval)delay;
+
+/**
+ * Cancels the timer. It can be scheduled again later.
+ */
+- (void)cancel;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -3,6 +3,35 @@
 
 #import <Foundation/Foundation.h>
 #import "UADisposable.h"
+#import "UADispatchTimer.h"
+
+/**
+ * The kinds of work the SDK dispatches. Each kind runs at its own quality of service,
+ * configurable with the matching `UAConfig` option.
+ * @note For internal use only. :nodoc:
+ */
+typedef NS_ENUM(NSUInteger, UADispatcherWorkType) {
+    /**
+     * Network uploads, such as events, tags, attributes and inbox sync. Defaults to utility.
+     */
+    UADispatcherWorkTypeUpload,
+
+    /**
+     * Work that is not on the display path, such as event store writes, automation
+     * evaluation and remote data processing. Defaults to utility.
+     */
+    UADispatcherWorkTypeProcessing,
+
+    /**
+     * Garbage collection and store trimming. Defaults to background.
+     */
+    UADispatcherWorkTypeMaintenance,
+
+    /**
+     * Work the UI is waiting on, such as preparing a message for display. Defaults to user initiated.
+     */
+    UADispatcherWorkTypeDisplay,
+};
 
 /**
  * Utility class that wraps a dispatch queue and related GCD calls
@@ -33,6 +62,46 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (instancetype)globalDispatcher:(dispatch_qos_class_t)qos;
 
+/**
+ * Shared dispatcher that dispatches on a global concurrent queue with the QOS for the work type.
+ *
+ * @param workType The work type.
+ */
++ (instancetype)globalDispatcherForWorkType:(UADispatcherWorkType)workType;
+
+/**
+ * Dispatcher that dispatches on a private serial queue with the QOS for the work type.
+ *
+ * @param workType The work type.
+ */
++ (instancetype)serialDispatcherForWorkType:(UADispatcherWorkType)workType;
+
+/**
+ * Sets the quality of service for a work type. Only dispatchers and queues created afterwards
+ * pick up the change, so this should be set before takeOff. `UAirship` applies the `UAConfig`
+ * values during takeOff.
+ *
+ * @param qualityOfService The quality of service.
+ * @param workType The work type.
+ */
++ (void)setQualityOfService:(NSQualityOfService)qualityOfService forWorkType:(UADispatcherWorkType)workType;
+
+/**
+ * Gets the quality of service for a work type, for use with `NSOperationQueue`.
+ *
+ * @param workType The work type.
+ * @return The quality of service.
+ */
++ (NSQualityOfService)qualityOfServiceForWorkType:(UADispatcherWorkType)workType;
+
+/**
+ * Gets the QOS class for a work type, for use with GCD calls that take a queue.
+ *
+ * @param workType The work type.
+ * @return The QOS class.
+ */
++ (dispatch_qos_class_t)qosClassForWorkType:(UADispatcherWorkType)workType;
+
 /**
  * Dispatcher that dispatches on a private serial queue with standard QOS.
  */
@@ -47,19 +116,47 @@ NS_ASSUME_NONNULL_BEGIN
 
 /**
  * Dispatches after a delay. If the delay <= 0, the block will
- * be dispatched asynchronously instead.
+ * be dispatched as soon as possible. Disposing the returned disposable
+ * cancels the block if it has not run yet.
  *
  * @param delay The delay in seconds.
  * @param block The block to dispatch.
  */
 - (UADisposable *)dispatchAfter:(NSTimeInterval)delay block:(void (^)(void))block;
 
+/**
+ * Creates a timer that calls the block on the associated queue. The timer can be
+ * rescheduled and cancelled without creating new dispatches.
+ *
+ * @param block The block to call when the timer fires.
+ * @return A timer that is not scheduled.
+ */
+- (UADispatchTimer *)timerWithBlock:(void (^)(void))block;
+
+/**
+ * Dispatches a block asynchronously, collapsing it with any block dispatched
+ * with the same key that has not run yet. Only the latest block for the key runs.
+ *
+ * @param block The block to dispatch.
+ * @param key The coalescing key.
+ */
+- (void)dispatchAsync:(void (^)(void))block coalescingKey:(NSString *)key;
+
 /**
  * Dispatches a block asynchronously.
  * @param block The block to dispatch.
  */
 - (void)dispatchAsync:(void (^)(void))block;
 
+/**
+ * Dispatches a block asynchronously at the QOS for the work type instead of the queue's QOS.
+ * Lets a serial queue run occasional maintenance below its usual QOS.
+ *
+ * @param block The block to dispatch.
+ * @param workType The work type.
+ */
+- (void)dispatchAsync:(void (^)(void))block workType:(UADispatcherWorkType)workType;
+
 /**
  * Dispatches a block synchronously.
  * @param block The block to dispatch.
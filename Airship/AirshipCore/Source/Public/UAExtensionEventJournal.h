@@ -0,0 +1,49 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+@class UAEvent;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Append-only journal of analytics events recorded by app extensions.
+ *
+ * Notification service and content extensions and widgets can record events without taking off.
+ * Each event is appended as a line of JSON to a file in the app group container shared with the
+ * app, without a Core Data stack. The app moves the events into its event store when it comes to
+ * the foreground and uploads them with its own batches.
+ *
+ * The app group is read from the `UAAppGroup` Info.plist key, falling back to
+ * `UAMediaCacheAppGroup`. The extension and the app must use the same app group.
+ */
+@interface UAExtensionEventJournal : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Extension Event Journal Factories
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method.
+ *
+ * @return A journal for the app group set in the main bundle's Info.plist, or `nil` if no app
+ * group is set or its container is not available.
+ */
++ (nullable instancetype)journal;
+
+///---------------------------------------------------------------------------------------
+/// @name Extension Event Journal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Appends an event to the journal. Safe to call from any thread. Events are dropped once the
+ * journal reaches its size limit, until the app collects them.
+ *
+ * @param event The event.
+ * @return `YES` if the event was recorded, otherwise `NO`.
+ */
+- (BOOL)recordEvent:(UAEvent *)event;
+
+@end
+
+NS_ASSUME_NONNULL_END
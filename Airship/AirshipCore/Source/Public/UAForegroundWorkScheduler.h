@@ -0,0 +1,58 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+#import "UADispatcher.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Foreground work priorities. Higher priority work runs first.
+ */
+typedef NS_ENUM(NSUInteger, UAForegroundWorkPriority) {
+    /**
+     * Work the user may notice if late, such as rescheduling timers.
+     */
+    UAForegroundWorkPriorityHigh,
+
+    /**
+     * Default priority.
+     */
+    UAForegroundWorkPriorityDefault,
+
+    /**
+     * Work that can wait, such as refreshing content that is not on screen.
+     */
+    UAForegroundWorkPriorityLow,
+};
+
+/**
+ * Staggers the SDK's work after the app comes to the foreground.
+ *
+ * Work is held until the app has had time to draw its first frame, then run one item at a time
+ * in priority order, with a short gap between items so the main queue stays responsive.
+ * @note For internal use only. :nodoc:
+ */
+@interface UAForegroundWorkScheduler : NSObject
+
+/**
+ * The shared scheduler.
+ */
++ (instancetype)shared;
+
+/**
+ * Schedules work to run after the first frame. Work scheduled with the same name before it runs
+ * replaces the previous work, keeping its place in the queue.
+ *
+ * @param name The work name.
+ * @param priority The work priority.
+ * @param dispatcher The dispatcher the work runs on.
+ * @param block The work block.
+ */
+- (void)scheduleWorkWithName:(NSString *)name
+                    priority:(UAForegroundWorkPriority)priority
+                  dispatcher:(UADispatcher *)dispatcher
+                       block:(void (^)(void))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -43,7 +43,8 @@ NS_ASSUME_NONNULL_BEGIN
                          forIdentifier:(NSString *)identifier;
 
 /**
- * Get the key chain's password.
+ * Get the key chain's password. Credentials are cached in memory after the first read, and the
+ * cache is invalidated when the key chain is created, updated or deleted through this class.
  * @param identifier The identifier for the key chain.
  * @return The password as an NSString or nil if an error occurred.
  */
@@ -56,6 +57,22 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (nullable NSString *)getUsername:(NSString *)identifier;
 
+/**
+ * Get the key chain's password if it has already been read by this process. Never reads the keychain,
+ * so it is safe to call while protected data is unavailable.
+ * @param identifier The identifier for the key chain.
+ * @return The cached password, or nil if it has not been read or does not exist.
+ */
++ (nullable NSString *)getCachedPassword:(NSString *)identifier;
+
+/**
+ * Get the key chain's username if it has already been read by this process. Never reads the keychain,
+ * so it is safe to call while protected data is unavailable.
+ * @param identifier The identifier for the key chain.
+ * @return The cached username, or nil if it has not been read or does not exist.
+ */
++ (nullable NSString *)getCachedUsername:(NSString *)identifier;
+
 /**
  * Gets the device ID, creating or refreshing if necessary. Device IDs will be regenerated if a
  * device change is detected (though UAUser IDs remain the same in that case).
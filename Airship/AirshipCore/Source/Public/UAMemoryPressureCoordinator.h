@@ -0,0 +1,113 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+@class UADisposable;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Memory pressure levels.
+ */
+typedef NS_ENUM(NSUInteger, UAMemoryPressureLevel) {
+    /**
+     * The system is low on memory. Only low and normal priority handlers are purged.
+     */
+    UAMemoryPressureLevelWarning,
+
+    /**
+     * The system is critically low on memory or sent a memory warning. Every handler is purged.
+     */
+    UAMemoryPressureLevelCritical,
+};
+
+/**
+ * Memory pressure handler priorities. Lower priorities are purged first.
+ */
+typedef NS_ENUM(NSUInteger, UAMemoryPressurePriority) {
+    /**
+     * Memory that is cheap to rebuild, such as parsed colors or fonts.
+     */
+    UAMemoryPressurePriorityLow,
+
+    /**
+     * Memory that takes some work to rebuild, such as pooled views.
+     */
+    UAMemoryPressurePriorityNormal,
+
+    /**
+     * Memory that is expensive to rebuild, such as objects decoded from a store. Only purged
+     * under critical pressure.
+     */
+    UAMemoryPressurePriorityHigh,
+};
+
+/**
+ * Purges memory for a memory pressure level.
+ *
+ * @param level The memory pressure level.
+ * @return The estimated number of bytes reclaimed.
+ */
+typedef NSUInteger (^UAMemoryPressureHandler)(UAMemoryPressureLevel level);
+
+/**
+ * Coordinates how SDK caches respond to memory pressure. Caches register a handler and are
+ * purged in priority order on memory warnings and on memory pressure events, and the
+ * reclaimed bytes are reported through the metrics registry.
+ *
+ * Handlers are called on the main queue.
+ */
+@interface UAMemoryPressureCoordinator : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Memory Pressure Coordinator Factory
+///---------------------------------------------------------------------------------------
+
+/**
+ * The shared coordinator.
+ *
+ * @return The shared coordinator.
+ */
++ (instancetype)shared;
+
+///---------------------------------------------------------------------------------------
+/// @name Memory Pressure Coordinator Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Registers a memory pressure handler.
+ *
+ * @param name The handler name, used for logging.
+ * @param priority The handler priority.
+ * @param handler The handler.
+ * @return A disposable that removes the handler.
+ */
+- (UADisposable *)registerHandlerWithName:(NSString *)name
+                                 priority:(UAMemoryPressurePriority)priority
+                                  handler:(UAMemoryPressureHandler)handler;
+
+/**
+ * Registers a cache to be emptied under memory pressure. The cache is retained until the
+ * returned disposable is disposed.
+ *
+ * @param cache The cache.
+ * @param priority The cache priority.
+ * @param entrySize The estimated size in bytes of a cache entry, used to report reclaimed bytes.
+ * @return A disposable that removes the cache.
+ */
+- (UADisposable *)registerCache:(NSCache *)cache
+                       priority:(UAMemoryPressurePriority)priority
+             estimatedEntrySize:(NSUInteger)entrySize;
+
+/**
+ * Purges the handlers for a memory pressure level in priority order. Must be called on the
+ * main queue.
+ *
+ * @param level The memory pressure level.
+ * @return The estimated number of bytes reclaimed.
+ */
+- (NSUInteger)purgeWithLevel:(UAMemoryPressureLevel)level;
+
+@end
+
+NS_ASSUME_NONNULL_END
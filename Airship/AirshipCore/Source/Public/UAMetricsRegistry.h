@@ -0,0 +1,588 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class UAMetricsRegistry;
+
+/**
+ * Metric types.
+ */
+typedef NS_ENUM(NSUInteger, UAMetricType) {
+    /**
+     * A value sampled at a point in time, such as a store size.
+     */
+    UAMetricTypeGauge,
+
+    /**
+     * A running total, such as bytes downloaded.
+     */
+    UAMetricTypeCounter,
+
+    /**
+     * A duration in seconds, such as how long a refresh took.
+     */
+    UAMetricTypeTimer,
+};
+
+/**
+ * Size of the analytics event store in bytes. Gauge.
+ */
+extern NSString *const UAMetricEventStoreSize;
+
+/**
+ * Time taken to write a batch of pending events to the event store. Histogram.
+ */
+extern NSString *const UAMetricEventStoreFlushDuration;
+
+/**
+ * Number of events written to the event store. Counter.
+ */
+extern NSString *const UAMetricEventStoreWrites;
+
+/**
+ * Time taken to upload a batch of events. Histogram.
+ */
+extern NSString *const UAMetricEventUploadDuration;
+
+/**
+ * Number of event batches uploaded. Counter.
+ */
+extern NSString *const UAMetricEventUploads;
+
+/**
+ * Number of event batch uploads that failed. Counter.
+ */
+extern NSString *const UAMetricEventUploadFailures;
+
+/**
+ * Number of events dropped by the event sampling and rate limits. Counter.
+ */
+extern NSString *const UAMetricEventsLimited;
+
+/**
+ * Number of pending channel tag group mutations. Gauge.
+ */
+extern NSString *const UAMetricChannelPendingTagMutations;
+
+/**
+ * Number of pending named user tag group mutations. Gauge.
+ */
+extern NSString *const UAMetricNamedUserPendingTagMutations;
+
+/**
+ * Number of pending channel attribute mutations. Gauge.
+ */
+extern NSString *const UAMetricChannelPendingAttributeMutations;
+
+/**
+ * Number of pending named user attribute mutations. Gauge.
+ */
+extern NSString *const UAMetricNamedUserPendingAttributeMutations;
+
+/**
+ * Time taken to refresh remote data, from request to subscribers being notified. Histogram.
+ */
+extern NSString *const UAMetricRemoteDataRefreshDuration;
+
+/**
+ * Number of remote data refreshes. Counter.
+ */
+extern NSString *const UAMetricRemoteDataRefreshes;
+
+/**
+ * Number of remote data refreshes that failed. Counter.
+ */
+extern NSString *const UAMetricRemoteDataRefreshFailures;
+
+/**
+ * Remote data response bytes received. Counter.
+ */
+extern NSString *const UAMetricRemoteDataBytes;
+
+/**
+ * Duration of a request made to Airship. Histogram.
+ */
+extern NSString *const UAMetricNetworkRequestDuration;
+
+/**
+ * Number of request attempts made to Airship, including retries. Counter.
+ */
+extern NSString *const UAMetricNetworkRequests;
+
+/**
+ * Number of request attempts that failed without a response. Counter.
+ */
+extern NSString *const UAMetricNetworkRequestErrors;
+
+/**
+ * Number of request retries. Counter.
+ */
+extern NSString *const UAMetricNetworkRequestRetries;
+
+/**
+ * Number of notifications the notification service extension recorded as delivered. Counter.
+ */
+extern NSString *const UAMetricPushExtensionDeliveries;
+
+/**
+ * Time taken to evaluate the active triggers against a batch of events. Histogram.
+ */
+extern NSString *const UAMetricAutomationTriggerEvaluationDuration;
+
+/**
+ * Number of events evaluated against automation triggers. Counter.
+ */
+extern NSString *const UAMetricAutomationTriggerEvents;
+
+/**
+ * Prefix of the in-app automation stage metrics, followed by the stage name. Timer.
+ */
+extern NSString *const UAMetricAutomationStagePrefix;
+
+/**
+ * Number of Message Center list icons fetched from the network. Counter.
+ */
+extern NSString *const UAMetricMessageCenterIconFetches;
+
+/**
+ * Number of Message Center list icons loaded from the disk cache instead of the network. Counter.
+ */
+extern NSString *const UAMetricMessageCenterIconCacheLoads;
+
+/**
+ * Time taken to move the Message Center inbox database out of its legacy location. Histogram.
+ */
+extern NSString *const UAMetricMessageCenterStoreRelocationDuration;
+
+/**
+ * Number of memory pressure events handled by the memory pressure coordinator. Counter.
+ */
+extern NSString *const UAMetricMemoryPressureEvents;
+
+/**
+ * Estimated bytes reclaimed by the memory pressure coordinator. Counter.
+ */
+extern NSString *const UAMetricMemoryPressureReclaimedBytes;
+
+/**
+ * Prefix of the Core Data store size metrics, followed by the store file name. Gauge.
+ */
+extern NSString *const UAMetricCoreDataStorePrefix;
+
+/**
+ * Prefix of the work scheduler job metrics, followed by the job name. Timer.
+ */
+extern NSString *const UAMetricWorkPrefix;
+
+/**
+ * Number of jobs the work scheduler deferred to the next launch because the budget was spent. Counter.
+ */
+extern NSString *const UAMetricWorkDeferred;
+
+/**
+ * Number of jobs the work scheduler dropped because the budget was spent or their deadline passed. Counter.
+ */
+extern NSString *const UAMetricWorkDropped;
+
+/**
+ * Seconds left in the work scheduler's budget for the current launch. Gauge.
+ */
+extern NSString *const UAMetricWorkBudgetRemaining;
+
+/**
+ * A snapshot of a metric.
+ */
+@interface UAMetric : NSObject <NSCopying>
+
+///---------------------------------------------------------------------------------------
+/// @name Metric Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The metric name.
+ */
+@property (nonatomic, readonly) NSString *name;
+
+/**
+ * The metric type.
+ */
+@property (nonatomic, readonly) UAMetricType type;
+
+/**
+ * The current value. The latest sample for gauges and timers, the running total for counters.
+ */
+@property (nonatomic, readonly) double value;
+
+/**
+ * The number of values recorded.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ * The sum of the values recorded.
+ */
+@property (nonatomic, readonly) double total;
+
+/**
+ * The largest value recorded.
+ */
+@property (nonatomic, readonly) double maxValue;
+
+/**
+ * The average of the values recorded.
+ */
+@property (nonatomic, readonly) double average;
+
+/**
+ * When the last value was recorded.
+ */
+@property (nonatomic, readonly) NSDate *lastUpdated;
+
+///---------------------------------------------------------------------------------------
+/// @name Metric Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Returns a percentile over the most recent values.
+ *
+ * @param percentile The percentile, 0-100.
+ * @return The value at the percentile.
+ */
+- (double)percentile:(double)percentile;
+
+@end
+
+/**
+ * A counter backed by an atomic integer, so it can be incremented on hot paths without
+ * taking a lock. Instances are owned by the registry and can be kept by the caller.
+ */
+@interface UAMetricCounter : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Metric Counter Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The counter name.
+ */
+@property (nonatomic, readonly) NSString *name;
+
+/**
+ * The current total.
+ */
+@property (nonatomic, readonly) int64_t value;
+
+/**
+ * The number of increments.
+ */
+@property (nonatomic, readonly) int64_t updateCount;
+
+///---------------------------------------------------------------------------------------
+/// @name Metric Counter Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Increments the counter by one.
+ */
+- (void)increment;
+
+/**
+ * Increments the counter.
+ *
+ * @param amount The increment.
+ */
+- (void)incrementBy:(int64_t)amount;
+
+@end
+
+/**
+ * A histogram with fixed bucket bounds, backed by atomic bucket counts so values can be
+ * recorded on hot paths without taking a lock. Instances are owned by the registry and can
+ * be kept by the caller. Copies are frozen snapshots.
+ */
+@interface UAMetricHistogram : NSObject <NSCopying>
+
+///---------------------------------------------------------------------------------------
+/// @name Metric Histogram Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The histogram name.
+ */
+@property (nonatomic, readonly) NSString *name;
+
+/**
+ * The inclusive upper bound of each bucket, ascending. Values above the last bound are
+ * counted in an extra overflow bucket.
+ */
+@property (nonatomic, readonly) NSArray<NSNumber *> *bucketBounds;
+
+/**
+ * The number of values in each bucket. Has one more element than `bucketBounds`, the
+ * overflow bucket.
+ */
+@property (nonatomic, readonly) NSArray<NSNumber *> *bucketCounts;
+
+/**
+ * The number of values recorded.
+ */
+@property (nonatomic, readonly) uint64_t count;
+
+/**
+ * The sum of the values recorded.
+ */
+@property (nonatomic, readonly) double sum;
+
+/**
+ * The largest value recorded.
+ */
+@property (nonatomic, readonly) double maxValue;
+
+/**
+ * The average of the values recorded.
+ */
+@property (nonatomic, readonly) double average;
+
+///---------------------------------------------------------------------------------------
+/// @name Metric Histogram Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * The default bucket bounds for durations, from 5 milliseconds to 10 seconds.
+ *
+ * @return The bucket bounds in seconds.
+ */
++ (NSArray<NSNumber *> *)durationBucketBounds;
+
+/**
+ * Records a value.
+ *
+ * @param value The value.
+ */
+- (void)recordValue:(double)value;
+
+/**
+ * Estimates a percentile as the upper bound of the bucket that contains it, capped at the
+ * largest value recorded.
+ *
+ * @param percentile The percentile, 0-100.
+ * @return The estimated value, or 0 if nothing has been recorded.
+ */
+- (double)percentile:(double)percentile;
+
+@end
+
+/**
+ * A point in time snapshot of every metric in the registry.
+ */
+@interface UAMetricsSnapshot : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Metrics Snapshot Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * When the snapshot was taken.
+ */
+@property (nonatomic, readonly) NSDate *date;
+
+/**
+ * The gauges, counters and timers, sorted by name.
+ */
+@property (nonatomic, readonly) NSArray<UAMetric *> *metrics;
+
+/**
+ * Frozen copies of the histograms, sorted by name.
+ */
+@property (nonatomic, readonly) NSArray<UAMetricHistogram *> *histograms;
+
+@end
+
+/**
+ * Exports metrics snapshots to an observability backend.
+ */
+@protocol UAMetricsExporter <NSObject>
+
+@required
+
+/**
+ * Called with a snapshot when the metrics are exported. Called on a background queue.
+ *
+ * @param snapshot The metrics snapshot.
+ */
+- (void)exportMetricsSnapshot:(UAMetricsSnapshot *)snapshot;
+
+@end
+
+/**
+ * Metrics registry delegate.
+ */
+@protocol UAMetricsRegistryDelegate <NSObject>
+
+@optional
+
+/**
+ * Called when a value is recorded through the registry. Called on the thread that recorded
+ * the value. Counters and histograms updated directly are only reported through snapshots.
+ *
+ * @param registry The metrics registry.
+ * @param value The recorded value. For counters, the increment.
+ * @param name The metric name.
+ * @param type The metric type.
+ */
+- (void)metricsRegistry:(UAMetricsRegistry *)registry
+         didRecordValue:(double)value
+              forMetric:(NSString *)name
+                   type:(UAMetricType)type;
+
+@end
+
+/**
+ * A registry of SDK performance metrics, shared by the SDK modules.
+ *
+ * Gauges that are cheap to compute on demand are registered with a block and sampled
+ * each time `metrics` is read. Every sample is reported to the delegate, so an exporter
+ * that polls `metrics` receives those gauges as well.
+ *
+ * Counters and histograms are lock free once created. Hot paths should look them up once
+ * and keep them.
+ *
+ * Metrics can be pulled with `snapshot`, or pushed to the registered exporters with
+ * `exportMetrics`. The registry also exports whenever the app enters the background.
+ */
+@interface UAMetricsRegistry : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Metrics Registry Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The delegate. Use it to forward metrics to an APM tool.
+ */
+@property (nonatomic, weak, nullable) id<UAMetricsRegistryDelegate> delegate;
+
+/**
+ * Snapshots of every gauge, counter and timer, sorted by name. Sampled gauges are refreshed first.
+ */
+@property (nonatomic, readonly) NSArray<UAMetric *> *metrics;
+
+/**
+ * Frozen copies of every histogram, sorted by name.
+ */
+@property (nonatomic, readonly) NSArray<UAMetricHistogram *> *histograms;
+
+///---------------------------------------------------------------------------------------
+/// @name Metrics Registry Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * The shared metrics registry.
+ *
+ * @return The shared metrics registry.
+ */
++ (instancetype)shared;
+
+/**
+ * Returns a snapshot of a metric.
+ *
+ * @param name The metric name.
+ * @return The metric, or `nil` if nothing has been recorded for it.
+ */
+- (nullable UAMetric *)metricWithName:(NSString *)name;
+
+/**
+ * Records a gauge value.
+ *
+ * @param value The value.
+ * @param name The metric name.
+ */
+- (void)setGauge:(double)value forMetric:(NSString *)name;
+
+/**
+ * Registers a gauge that is sampled whenever the metrics are read, replacing any block
+ * registered for the same name. The block may be called on any thread.
+ *
+ * @param name The metric name.
+ * @param block Returns the current value.
+ */
+- (void)registerGaugeForMetric:(NSString *)name block:(double (^)(void))block;
+
+/**
+ * Returns the counter with a name, creating it if needed.
+ *
+ * @param name The counter name.
+ * @return The counter.
+ */
+- (UAMetricCounter *)counterWithName:(NSString *)name;
+
+/**
+ * Returns the histogram with a name, creating it with the given bucket bounds if needed.
+ * An existing histogram keeps its original bounds.
+ *
+ * @param name The histogram name.
+ * @param bucketBounds The ascending, inclusive bucket upper bounds.
+ * @return The histogram.
+ */
+- (UAMetricHistogram *)histogramWithName:(NSString *)name bucketBounds:(NSArray<NSNumber *> *)bucketBounds;
+
+/**
+ * Returns the histogram with a name, creating it with the default duration buckets if needed.
+ *
+ * @param name The histogram name.
+ * @return The histogram.
+ */
+- (UAMetricHistogram *)durationHistogramWithName:(NSString *)name;
+
+/**
+ * Increments a counter.
+ *
+ * @param name The counter name.
+ * @param amount The increment.
+ */
+- (void)incrementCounter:(NSString *)name by:(int64_t)amount;
+
+/**
+ * Records a duration.
+ *
+ * @param duration The duration in seconds.
+ * @param name The metric name.
+ */
+- (void)recordDuration:(NSTimeInterval)duration forMetric:(NSString *)name;
+
+/**
+ * Takes a snapshot of every metric. Sampled gauges are refreshed first.
+ *
+ * @return The snapshot.
+ */
+- (UAMetricsSnapshot *)snapshot;
+
+/**
+ * Adds an exporter. Exporters are held weakly.
+ *
+ * @param exporter The exporter.
+ */
+- (void)addExporter:(id<UAMetricsExporter>)exporter;
+
+/**
+ * Removes an exporter.
+ *
+ * @param exporter The exporter.
+ */
+- (void)removeExporter:(id<UAMetricsExporter>)exporter;
+
+/**
+ * Takes a snapshot and hands it to every exporter on a background queue.
+ */
+- (void)exportMetrics;
+
+/**
+ * Clears the recorded values. Registered gauges stay registered, and counters and
+ * histograms are zeroed rather than removed so references kept by callers stay valid.
+ */
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
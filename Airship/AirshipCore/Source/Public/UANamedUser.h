@@ -101,6 +101,18 @@ extern NSString *const UANamedUserIdentifierChangedNotificationIdentifierKey;
  */
 - (void)forceUpdate;
 
+/**
+ * Applies the named user ID, tag and attribute changes made in the block as a single update.
+ *
+ * Within the block, set the `identifier` and change tags and attributes as usual. Nothing is
+ * uploaded until the block returns. Then the association and channel registration are updated
+ * once if the identifier changed, and all pending tags and attributes are uploaded together.
+ * Tag and attribute changes made in the block apply to the new identifier.
+ *
+ * @param block The block that makes the changes.
+ */
+- (void)performIdentityUpdate:(void (^)(void))block;
+
 /**
  * Add tags to named user tags. To update the server,
  * make all of your changes, then call `updateTags`.
@@ -0,0 +1,152 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class UANetworkMetrics;
+
+/**
+ * Aggregated metrics for the requests made to a single Airship endpoint.
+ */
+@interface UANetworkEndpointMetrics : NSObject <NSCopying>
+
+///---------------------------------------------------------------------------------------
+/// @name Network Endpoint Metrics Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The endpoint, the request host and path. Path components that identify a resource,
+ * such as a channel ID, are replaced with `*`.
+ */
+@property (nonatomic, readonly) NSString *endpoint;
+
+/**
+ * The number of requests made.
+ */
+@property (nonatomic, readonly) NSUInteger requestCount;
+
+/**
+ * The number of requests that reused an existing connection.
+ */
+@property (nonatomic, readonly) NSUInteger reusedConnectionCount;
+
+/**
+ * The fraction of requests that reused an existing connection, 0.0-1.0.
+ */
+@property (nonatomic, readonly) double connectionReuseRate;
+
+/**
+ * The total number of bytes sent.
+ */
+@property (nonatomic, readonly) int64_t bytesSent;
+
+/**
+ * The total number of bytes received.
+ */
+@property (nonatomic, readonly) int64_t bytesReceived;
+
+/**
+ * The ratio of the uncompressed to the sent size of compressed request bodies, or 0 if no
+ * bodies were compressed.
+ */
+@property (nonatomic, readonly) double requestCompressionRatio;
+
+/**
+ * The ratio of the decoded to the received size of response bodies, or 0 if no bodies were
+ * received. Always 0 before iOS and tvOS 13.
+ */
+@property (nonatomic, readonly) double responseCompressionRatio;
+
+/**
+ * The average DNS lookup time of requests that performed a lookup.
+ */
+@property (nonatomic, readonly) NSTimeInterval averageDNSTime;
+
+/**
+ * The average TLS handshake time of requests that performed a handshake.
+ */
+@property (nonatomic, readonly) NSTimeInterval averageTLSTime;
+
+/**
+ * The average time from sending the request to receiving the first response byte.
+ */
+@property (nonatomic, readonly) NSTimeInterval averageTimeToFirstByte;
+
+/**
+ * The average time spent receiving the response.
+ */
+@property (nonatomic, readonly) NSTimeInterval averageTransferTime;
+
+///---------------------------------------------------------------------------------------
+/// @name Network Endpoint Metrics Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Returns a request latency percentile over the most recent requests.
+ *
+ * @param percentile The percentile, 0-100.
+ * @return The latency, or 0 if no requests have been made.
+ */
+- (NSTimeInterval)latencyPercentile:(double)percentile;
+
+@end
+
+/**
+ * Network metrics delegate.
+ */
+@protocol UANetworkMetricsDelegate <NSObject>
+
+@optional
+
+/**
+ * Called when metrics are collected for a request. Called on a background queue.
+ *
+ * @param networkMetrics The network metrics instance.
+ * @param metrics The request's task metrics.
+ * @param endpoint The request endpoint.
+ */
+- (void)networkMetrics:(UANetworkMetrics *)networkMetrics
+     didCollectMetrics:(NSURLSessionTaskMetrics *)metrics
+           forEndpoint:(NSString *)endpoint;
+
+@end
+
+/**
+ * Collects metrics for the requests the SDK makes to Airship.
+ */
+@interface UANetworkMetrics : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Network Metrics Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The delegate.
+ */
+@property (nonatomic, weak, nullable) id<UANetworkMetricsDelegate> delegate;
+
+/**
+ * Snapshots of the metrics for each endpoint requested since launch or the last reset.
+ */
+@property (nonatomic, readonly) NSArray<UANetworkEndpointMetrics *> *endpointMetrics;
+
+///---------------------------------------------------------------------------------------
+/// @name Network Metrics Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * The shared network metrics instance.
+ *
+ * @return The shared network metrics instance.
+ */
++ (instancetype)shared;
+
+/**
+ * Clears all collected metrics.
+ */
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
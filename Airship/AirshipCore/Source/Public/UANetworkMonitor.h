@@ -0,0 +1,53 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * NSNotification event when network connectivity is lost or restored, or when the path
+ * becomes or stops being expensive or constrained. The event is posted on the main queue.
+ */
+extern NSString *const UANetworkConnectivityChangedEvent;
+
+/**
+ * Tracks the device's network path.
+ *
+ * On iOS and tvOS 12+ the path is pushed by `NWPathMonitor` and cached, so reading it is cheap.
+ * On older versions the connection type falls back to a reachability check and the
+ * monitor always reports being connected.
+ * @note For internal use only. :nodoc:
+ */
+@interface UANetworkMonitor : NSObject
+
+/**
+ * The shared network monitor.
+ */
++ (instancetype)shared;
+
+/**
+ * Whether the current path can be used. `YES` until the first path update is received, so
+ * callers never hold work without a later change event to resume it.
+ */
+@property (nonatomic, readonly, getter=isConnected) BOOL connected;
+
+/**
+ * Whether the current path uses an interface the system considers expensive, such as
+ * cellular or a personal hotspot.
+ */
+@property (nonatomic, readonly, getter=isExpensive) BOOL expensive;
+
+/**
+ * Whether the current path is in Low Data Mode. Always `NO` before iOS and tvOS 13.
+ */
+@property (nonatomic, readonly, getter=isConstrained) BOOL constrained;
+
+/**
+ * The current connection type, one of `UAConnectionTypeNone`, `UAConnectionTypeCell`
+ * or `UAConnectionTypeWifi`.
+ */
+@property (nonatomic, readonly) NSString *connectionType;
+
+@end
+
+NS_ASSUME_NONNULL_END
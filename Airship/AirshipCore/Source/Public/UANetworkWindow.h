@@ -0,0 +1,40 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * NSNotification event when a network window opens. The event is posted on the main queue.
+ */
+extern NSString *const UANetworkWindowOpenedEvent;
+
+/**
+ * Tracks when the SDK's requests wake the radio.
+ *
+ * Every wake keeps the cellular radio in a high power state for several seconds after the last
+ * request. The first request after a quiet period opens a window and posts `UANetworkWindowOpenedEvent`
+ * so components with deferrable work, such as pending mutations or analytics, can send it while the
+ * radio is already awake instead of waking it again later.
+ * @note For internal use only. :nodoc:
+ */
+@interface UANetworkWindow : NSObject
+
+/**
+ * The shared network window.
+ */
++ (instancetype)shared;
+
+/**
+ * Records that a request is going out, opening a window if none is open.
+ */
+- (void)requestStarted;
+
+/**
+ * Whether a window is currently open.
+ */
+@property (nonatomic, readonly, getter=isOpen) BOOL open;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -77,6 +77,8 @@ NS_ASSUME_NONNULL_BEGIN
 /**
  * Factory method to create the default set of user notification categories.
  * Background user notification actions will default to requiring authorization.
+ *
+ * The default categories are built once and cached until the locale changes.
  * @return A set of user notification categories.
  */
 + (NSSet *)defaultCategories;
@@ -84,6 +86,8 @@ NS_ASSUME_NONNULL_BEGIN
 /**
  * Factory method to create the default set of user notification categories.
  *
+ * The default categories are built once and cached until the locale changes.
+ *
  * @param requireAuth If background actions should default to requiring authorization or not.
  * @return A set of user notification categories.
  */
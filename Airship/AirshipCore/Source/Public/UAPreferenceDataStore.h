@@ -5,8 +5,10 @@
 NS_ASSUME_NONNULL_BEGIN
 
 /**
- * Wrapper around NSUserDefaults that automatically applies a key prefix
- * to all entries.
+ * Key-value store for SDK state that automatically applies a key prefix to all
+ * entries. Values are kept in a dedicated database rather than the app's
+ * NSUserDefaults, and values previously stored in NSUserDefaults under the prefix
+ * are migrated the first time a data store with that prefix is created.
  * @note For internal use only. :nodoc:
  */
 @interface UAPreferenceDataStore : NSObject
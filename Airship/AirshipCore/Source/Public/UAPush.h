@@ -355,6 +355,17 @@ typedef NS_ENUM(NSInteger, UAAuthorizationStatus) {
  */
 @property (nonatomic, copy) NSSet<UANotificationCategory *> *accengageCategories;
 
+/**
+ * Adds custom notification categories, replacing any custom categories with the same
+ * identifier. Airship default notification categories will be unaffected.
+ *
+ * Changes will not take effect until the next time the app registers
+ * with updateRegistration.
+ *
+ * @param categories The categories to add.
+ */
+- (void)addCustomCategories:(NSSet<UANotificationCategory *> *)categories;
+
 ///---------------------------------------------------------------------------------------
 /// @name Autobadge
 ///---------------------------------------------------------------------------------------
@@ -4,6 +4,28 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ * How important a component's remote notification handling is when the background time runs short.
+ * @note For internal use only. :nodoc:
+ */
+typedef NS_ENUM(NSInteger, UAPushableComponentPriority) {
+    /**
+     * Work that can wait for the next foreground. It is skipped when the budget is already
+     * half spent and the notification does not wait on it past that point.
+     */
+    UAPushableComponentPriorityLow = -1,
+
+    /**
+     * Default priority.
+     */
+    UAPushableComponentPriorityDefault = 0,
+
+    /**
+     * Work that should start first.
+     */
+    UAPushableComponentPriorityHigh = 1,
+};
+
 /**
  * Internal protocol to fan out push handling to UAComponents.
  * @note For internal use only. :nodoc:
@@ -19,6 +41,14 @@ NS_ASSUME_NONNULL_BEGIN
  */
 -(void)receivedRemoteNotification:(UANotificationContent *)notification completionHandler:(void (^)(UIBackgroundFetchResult))completionHandler;
 
+/**
+ * Called before `receivedRemoteNotification:completionHandler:` to get the priority of the
+ * component's handling. Defaults to `UAPushableComponentPriorityDefault`.
+ * @param notification The notification.
+ * @return The priority.
+ */
+-(UAPushableComponentPriority)priorityForRemoteNotification:(UANotificationContent *)notification;
+
 /**
  * Called when a notification response is received.
  * @param response The notification response.
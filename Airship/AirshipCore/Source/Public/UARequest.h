@@ -5,6 +5,27 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ * Request traffic classes. The class decides which network paths a request may use.
+ */
+typedef NS_ENUM(NSUInteger, UARequestTrafficClass) {
+    /**
+     * Traffic the SDK cannot work without, such as channel registration. Allowed on every path.
+     */
+    UARequestTrafficClassCritical,
+
+    /**
+     * Traffic that can wait, such as analytics and remote data. Not sent while Low Data Mode is on.
+     */
+    UARequestTrafficClassDeferrable,
+
+    /**
+     * Speculative downloads, such as prefetching content. Not sent on expensive paths or while
+     * Low Data Mode is on.
+     */
+    UARequestTrafficClassPrefetch,
+};
+
 /**
  * The request builder.
  * @note For internal use only. :nodoc:
@@ -41,6 +62,18 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, assign) BOOL compressBody;
 
+/**
+ * The relative priority of the request on its connection, 0.0-1.0. Requests to the same host share
+ * a connection, so a higher priority lets a request go ahead of others in flight. Defaults
+ * to `NSURLSessionTaskPriorityDefault`.
+ */
+@property (nonatomic, assign) float priority;
+
+/**
+ * The request traffic class. Defaults to `UARequestTrafficClassCritical`.
+ */
+@property (nonatomic, assign) UARequestTrafficClass trafficClass;
+
 /**
  * Sets a http request header.
  * @param value The header value.
@@ -82,6 +115,16 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, readonly, nullable) NSData *body;
 
+/**
+ * The request priority.
+ */
+@property (nonatomic, readonly) float priority;
+
+/**
+ * The request traffic class.
+ */
+@property (nonatomic, readonly) UARequestTrafficClass trafficClass;
+
 /**
  * Factory method to create a request.
  * @param builder A UARequestBuilder
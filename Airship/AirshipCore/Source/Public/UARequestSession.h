@@ -3,9 +3,25 @@
 #import <Foundation/Foundation.h>
 #import "UARequest.h"
 #import "UARuntimeConfig.h"
+#import "UATaskQueue.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ * Request session error domain.
+ */
+extern NSString * const UARequestSessionErrorDomain;
+
+/**
+ * Request session error codes.
+ */
+typedef NS_ENUM(NSInteger, UARequestSessionErrorCode) {
+    /**
+     * The request was not sent because the host has been failing and its circuit is open.
+     */
+    UARequestSessionErrorCodeCircuitOpen = 0
+};
+
 typedef void (^UARequestCompletionHandler)(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error);
 typedef BOOL (^UARequestRetryBlock)(NSData * _Nullable data, NSURLResponse * _Nullable response);
 
@@ -16,7 +32,14 @@ typedef BOOL (^UARequestRetryBlock)(NSData * _Nullable data, NSURLResponse * _Nu
 @interface UARequestSession : NSObject
 
 /**
- * UARequestSession factory method.
+ * The URL session shared by all request sessions created with `sessionWithConfig:`. Sharing a single
+ * session lets requests reuse connections and TLS sessions across API clients.
+ * @return The shared NSURLSession instance.
+ */
++ (NSURLSession *)sharedURLSession;
+
+/**
+ * UARequestSession factory method. Requests are performed on the shared URL session.
  * @param config The UARuntimeConfig instance.
  * @return A UARequestSession instance.
  */
@@ -34,10 +57,10 @@ typedef BOOL (^UARequestRetryBlock)(NSData * _Nullable data, NSURLResponse * _Nu
  * UARequestSession factory method.
  * @param config The UARuntimeConfig instance.
  * @param session A NSURLSession instance.
- * @param queue A NSOperation to perform retries on.
+ * @param queue The task queue requests and retries run on.
  * @return A UARequestSession instance.
  */
-+ (instancetype)sessionWithConfig:(UARuntimeConfig *)config NSURLSession:(NSURLSession *)session queue:(NSOperationQueue *)queue;
++ (instancetype)sessionWithConfig:(UARuntimeConfig *)config NSURLSession:(NSURLSession *)session queue:(UATaskQueue *)queue;
 
 /**
  * Sets a http request header for all requests.
@@ -61,7 +84,9 @@ typedef BOOL (^UARequestRetryBlock)(NSData * _Nullable data, NSURLResponse * _Nu
  *
  * @param request The UARequest to perform.
  * @param retryBlock An optional block that will be called before the completion handler to decide if the
- * request should be retried or not.
+ * request should be retried or not. Retries are limited by the shared retry policy. Once it gives up, the
+ * completion handler is called with the last response. Requests to a host that keeps failing are
+ * short-circuited with a `UARequestSessionErrorCodeCircuitOpen` error.
  * @param completionHandler A callback to be invoked once the request is completed.
  */
 - (void)dataTaskWithRequest:(UARequest *)request
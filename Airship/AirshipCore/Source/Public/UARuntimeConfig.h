@@ -132,6 +132,15 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (readonly, getter=isExtendedBroadcastsEnabled) BOOL extendedBroadcastsEnabled;
 
+/**
+ * Flag indicating whether lazy Message Center is enabled. If set to `YES` the Message Center
+ * user will not be created and the inbox will not be loaded or refreshed until the Message Center
+ * is first accessed or a Message Center push is received.
+ *
+ * Defaults to `NO`.
+ */
+@property (readonly, getter=isLazyMessageCenterEnabled) BOOL lazyMessageCenterEnabled;
+
 /**
  * If set to 'YES', the Airship SDK will request authorization to use
  * notifications from the user. Apps that set this flag to `NO` are
@@ -141,6 +150,26 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (readonly) BOOL requestAuthorizationToUseNotifications;
 
+/**
+ * The quality of service for SDK network uploads.
+ */
+@property (readonly) NSQualityOfService uploadQualityOfService;
+
+/**
+ * The quality of service for SDK work that is not on the display path.
+ */
+@property (readonly) NSQualityOfService processingQualityOfService;
+
+/**
+ * The quality of service for SDK garbage collection and store trimming.
+ */
+@property (readonly) NSQualityOfService maintenanceQualityOfService;
+
+/**
+ * The quality of service for SDK work the UI is waiting on.
+ */
+@property (readonly) NSQualityOfService displayQualityOfService;
+
 /**
  * Flag indicating whether data collection needs to be opted in with
  * `UAirship.dataCollectionEnabled`. This flag will only take affect on first run.
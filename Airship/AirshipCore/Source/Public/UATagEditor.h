@@ -0,0 +1,58 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Batches edits to the device tags. Changes are applied together when the edit block returns.
+ */
+@interface UATagEditor : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Tag Editor Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Adds a tag.
+ *
+ * @param tag Tag to be added
+ */
+- (void)addTag:(NSString *)tag;
+
+/**
+ * Adds tags.
+ *
+ * @param tags Array of tags to be added
+ */
+- (void)addTags:(NSArray<NSString *> *)tags;
+
+/**
+ * Removes a tag.
+ *
+ * @param tag Tag to be removed
+ */
+- (void)removeTag:(NSString *)tag;
+
+/**
+ * Removes tags.
+ *
+ * @param tags Array of tags to be removed
+ */
+- (void)removeTags:(NSArray<NSString *> *)tags;
+
+/**
+ * Replaces the tags.
+ *
+ * @param tags Array of tags
+ */
+- (void)setTags:(NSArray<NSString *> *)tags;
+
+/**
+ * Removes all tags.
+ */
+- (void)removeAllTags;
+
+@end
+
+NS_ASSUME_NONNULL_END
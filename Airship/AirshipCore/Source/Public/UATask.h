@@ -0,0 +1,90 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class UATask;
+
+/**
+ * A task block. The block must call `finish` on the task once its work is done.
+ */
+typedef void (^UATaskBlock)(UATask *task);
+
+/**
+ * A lightweight asynchronous task, run by a `UATaskQueue`.
+ *
+ * Unlike `UAAsyncOperation`, a task has no KVO and no operation queue bookkeeping, so it stays
+ * cheap when many small tasks flow. The task is its own cancellation token: the work checks
+ * `isCancelled` between steps, and `cancelBlock` stops any work in flight.
+ * @note For internal use only. :nodoc:
+ */
+@interface UATask : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Task Factory
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method to create a task. Once the work is done, the block must call `finish` on the
+ * passed in task.
+ *
+ * @param block The task block.
+ * @return A task instance.
+ */
++ (instancetype)taskWithBlock:(UATaskBlock)block;
+
+///---------------------------------------------------------------------------------------
+/// @name Task Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * Whether the task has been cancelled.
+ */
+@property (readonly, getter=isCancelled) BOOL cancelled;
+
+/**
+ * Whether the task has finished.
+ */
+@property (readonly, getter=isFinished) BOOL finished;
+
+/**
+ * Block called once when the task is cancelled while its work is in flight.
+ */
+@property (nullable, copy) void (^cancelBlock)(void);
+
+/**
+ * Block called once the task has finished, whether it was cancelled or not.
+ */
+@property (nullable, copy) void (^completionBlock)(void);
+
+///---------------------------------------------------------------------------------------
+/// @name Task Management
+///---------------------------------------------------------------------------------------
+
+/**
+ * Makes the task wait for another task to finish before it starts.
+ *
+ * @param task The task to wait for.
+ */
+- (void)addDependency:(UATask *)task;
+
+/**
+ * Starts the task. A cancelled task finishes without running its block.
+ * Called by the task queue.
+ */
+- (void)start;
+
+/**
+ * Call to finish the task.
+ */
+- (void)finish;
+
+/**
+ * Cancels the task.
+ */
+- (void)cancel;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,65 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+#import "UATask.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Runs tasks one at a time, in the order they are added, on GCD.
+ *
+ * A lightweight replacement for a serial `NSOperationQueue` of `UAAsyncOperation`s. Delays do not
+ * hold a thread, the queue waits on a timer instead.
+ * @note For internal use only. :nodoc:
+ */
+@interface UATaskQueue : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Task Queue Factory
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method to create a serial task queue.
+ *
+ * @return A task queue instance.
+ */
++ (instancetype)serialQueue;
+
+///---------------------------------------------------------------------------------------
+/// @name Task Queue Management
+///---------------------------------------------------------------------------------------
+
+/**
+ * Adds a task to the queue.
+ *
+ * @param task The task.
+ */
+- (void)addTask:(UATask *)task;
+
+/**
+ * Adds a task to the queue. When the task reaches the front of the queue, the queue waits for the
+ * delay before starting it.
+ *
+ * @param task The task.
+ * @param delay The delay in seconds.
+ */
+- (void)addTask:(UATask *)task delay:(NSTimeInterval)delay;
+
+/**
+ * Adds a task to the queue that runs in a background task. The task is cancelled if the
+ * background task expires.
+ *
+ * @param task The task.
+ * @param delay The delay in seconds.
+ * @return `YES` if the task was added, `NO` if the background task could not be started.
+ */
+- (BOOL)addBackgroundTask:(UATask *)task delay:(NSTimeInterval)delay;
+
+/**
+ * Cancels all tasks in the queue, including the running task.
+ */
+- (void)cancelAllTasks;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -126,6 +126,16 @@ extern NSString * const UAConnectionTypeWifi;
  */
 + (NSDateFormatter *)ISODateFormatterUTCWithDelimiter;
 
+/**
+ * Formats a date in UTC as `yyyy-MM-dd'T'HH:mm:ss`, or `yyyy-MM-dd HH:mm:ss` without the
+ * delimiter. Produces the same string as the `ISODateFormatterUTC` formatters without creating one.
+ *
+ * @param date The date.
+ * @param delimiter Whether to separate the date and time with `T`.
+ * @return The formatted date.
+ */
++ (NSString *)ISODateStringFromDate:(NSDate *)date delimiter:(BOOL)delimiter;
+
 /**
  * Parses ISO 8601 date strings. Supports timestamps with just year all
  * the way up to seconds with and without the optional `T` delimeter.
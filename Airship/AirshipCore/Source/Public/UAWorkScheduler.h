@@ -0,0 +1,114 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+#import "UADispatcher.h"
+#import "UADisposable.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * What the app was woken up for. Each launch type has its own work budget.
+ */
+typedef NS_ENUM(NSUInteger, UAWorkLaunchType) {
+    /**
+     * The app is in the foreground.
+     */
+    UAWorkLaunchTypeForeground,
+
+    /**
+     * The app is running in the background, in a background launch or a background refresh task.
+     */
+    UAWorkLaunchTypeBackgroundFetch,
+
+    /**
+     * The app was woken up to handle a silent push.
+     */
+    UAWorkLaunchTypeSilentPush,
+
+    /**
+     * The SDK is running in an app extension.
+     */
+    UAWorkLaunchTypeExtension,
+
+    /**
+     * The app is running a background processing task, which the system gives minutes instead of seconds.
+     */
+    UAWorkLaunchTypeBackgroundProcessing,
+};
+
+/**
+ * Work priorities. Higher priority work runs first.
+ */
+typedef NS_ENUM(NSUInteger, UAWorkPriority) {
+    /**
+     * Work that runs even once the budget is spent, such as uploads that keep the device reachable.
+     */
+    UAWorkPriorityHigh,
+
+    /**
+     * Default priority. Deferred to the next launch once the budget is spent.
+     */
+    UAWorkPriorityDefault,
+
+    /**
+     * Work that can be skipped, such as prefetches. Dropped once the budget is spent.
+     */
+    UAWorkPriorityLow,
+};
+
+/**
+ * A work block. The block must call the completion handler once the work has finished. The
+ * returned disposable, if any, is disposed when the work is cancelled.
+ */
+typedef UADisposable * _Nullable (^UAWorkBlock)(void (^completionHandler)(void));
+
+/**
+ * Runs the SDK's deferrable work within a budget for the current launch.
+ *
+ * Components submit prioritized jobs, optionally with a deadline. Jobs run highest priority first,
+ * earliest deadline first among equal priorities, with a limited number running at once. Every
+ * launch type has a time budget, and each job is charged the time it runs for. Once the budget is
+ * spent, only high priority jobs start: default priority jobs wait for the next launch and low
+ * priority jobs are dropped. Jobs that have not started by their deadline are dropped.
+ *
+ * Each job's duration is recorded through the metrics registry as a `work.<name>` timer.
+ * @note For internal use only. :nodoc:
+ */
+@interface UAWorkScheduler : NSObject
+
+/**
+ * The current launch type.
+ */
+@property (nonatomic, readonly) UAWorkLaunchType launchType;
+
+/**
+ * The part of the current launch's budget that is not spent yet, in seconds.
+ */
+@property (nonatomic, readonly) NSTimeInterval remainingBudget;
+
+/**
+ * The shared scheduler.
+ */
++ (instancetype)shared;
+
+/**
+ * Submits work.
+ *
+ * @param name The work name, used for logging and metrics.
+ * @param priority The work priority.
+ * @param deadline Seconds from now after which the work is dropped if it has not started, or 0 for no deadline.
+ * @param dispatcher The dispatcher the work runs on, or `nil` to run it on the thread that starts it.
+ * @param block The work block.
+ * @param dropHandler Called if the work is dropped instead of run.
+ * @return A disposable that cancels the work.
+ */
+- (UADisposable *)submitWorkWithName:(NSString *)name
+                            priority:(UAWorkPriority)priority
+                            deadline:(NSTimeInterval)deadline
+                          dispatcher:(nullable UADispatcher *)dispatcher
+                               block:(UAWorkBlock)block
+                         dropHandler:(nullable void (^)(void))dropHandler;
+
+@end
+
+NS_ASSUME_NONNULL_END
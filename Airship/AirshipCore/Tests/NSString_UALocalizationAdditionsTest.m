@@ -59,4 +59,22 @@
 }
 
 
+/*
+ Test that repeated lookups return the same string, and that a missing string still
+ resolves to each call's own default value.
+ */
+- (void)testRepeatedLookups {
+    NSBundle *bundle = [UAirshipCoreResources bundle];
+
+    for (int i = 0; i < 2; i++) {
+        NSString *localizedString = [@"ua_notification_button_yes" localizedStringWithTable:@"UrbanAirship"
+                                                                               moduleBundle:bundle];
+        XCTAssertEqualObjects(localizedString, @"Yes");
+    }
+
+    XCTAssertEqualObjects([@"not_a_key" localizedStringWithTable:@"UrbanAirship" moduleBundle:bundle defaultValue:@"howdy"], @"howdy");
+    XCTAssertEqualObjects([@"not_a_key" localizedStringWithTable:@"UrbanAirship" moduleBundle:bundle defaultValue:@"hello"], @"hello");
+    XCTAssertFalse([@"not_a_key" localizedStringExistsInTable:@"UrbanAirship" moduleBundle:bundle]);
+}
+
 @end
@@ -24,6 +24,84 @@
     [self.mockSession verify];
 }
 
+- (void)testDataTaskWithRequestKey {
+    UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.method = @"GET";
+        builder.URL = [NSURL URLWithString:@"https://cool.story"];
+    }];
+
+    // Capture the completion handler of the single request that is made
+    __block UARequestCompletionHandler completionHandler;
+    [[[self.mockSession expect] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        completionHandler = (__bridge UARequestCompletionHandler)arg;
+    }] dataTaskWithRequest:request retryWhere:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    [[self.mockSession reject] dataTaskWithRequest:OCMOCK_ANY retryWhere:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    NSString *key = [UAAPIClient requestKeyForRequest:request];
+    NSURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:200 HTTPVersion:@"1.1" headerFields:@{}];
+
+    __block NSUInteger completions = 0;
+    for (NSUInteger i = 0; i < 3; i++) {
+        [self.client dataTaskWithRequest:request requestKey:key retryWhere:nil completionHandler:^(NSData *data, NSURLResponse *completionResponse, NSError *error) {
+            XCTAssertEqual(response, completionResponse);
+            completions++;
+        }];
+    }
+
+    completionHandler(nil, response, nil);
+
+    XCTAssertEqual(3, completions);
+    [self.mockSession verify];
+}
+
+- (void)testDataTaskWithRequestKeyAfterCompletion {
+    UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.method = @"GET";
+        builder.URL = [NSURL URLWithString:@"https://cool.story"];
+    }];
+
+    __block NSUInteger requests = 0;
+    [[[self.mockSession stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        UARequestCompletionHandler completionHandler = (__bridge UARequestCompletionHandler)arg;
+        requests++;
+        completionHandler(nil, nil, nil);
+    }] dataTaskWithRequest:OCMOCK_ANY retryWhere:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    NSString *key = [UAAPIClient requestKeyForRequest:request];
+    [self.client dataTaskWithRequest:request requestKey:key retryWhere:nil completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {}];
+    [self.client dataTaskWithRequest:request requestKey:key retryWhere:nil completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {}];
+
+    XCTAssertEqual(2, requests);
+}
+
+- (void)testRequestKey {
+    UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.method = @"PUT";
+        builder.URL = [NSURL URLWithString:@"https://cool.story"];
+        builder.body = [@"body" dataUsingEncoding:NSUTF8StringEncoding];
+    }];
+
+    UARequest *same = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.method = @"PUT";
+        builder.URL = [NSURL URLWithString:@"https://cool.story"];
+        builder.body = [@"body" dataUsingEncoding:NSUTF8StringEncoding];
+    }];
+
+    UARequest *different = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.method = @"PUT";
+        builder.URL = [NSURL URLWithString:@"https://cool.story"];
+        builder.body = [@"other body" dataUsingEncoding:NSUTF8StringEncoding];
+    }];
+
+    XCTAssertEqualObjects([UAAPIClient requestKeyForRequest:request], [UAAPIClient requestKeyForRequest:same]);
+    XCTAssertNotEqualObjects([UAAPIClient requestKeyForRequest:request], [UAAPIClient requestKeyForRequest:different]);
+}
+
 - (void)testCastResponse {
     NSURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@"https://cool.story"] statusCode:200 HTTPVersion:@"1.1" headerFields:@{}];
 
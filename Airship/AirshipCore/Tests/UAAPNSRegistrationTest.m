@@ -204,5 +204,53 @@
     }
 }
 
+-(void)testUpdateRegistrationSkipsUnchangedCategories {
+    UANotificationOptions expectedOptions = UANotificationOptionAlert | UANotificationOptionBadge;
+
+    [[self.mockedUserNotificationCenter expect] setNotificationCategories:OCMOCK_ANY];
+    [self.pushRegistration updateRegistrationWithOptions:expectedOptions categories:self.testCategories completionHandler:nil];
+    [self.mockedUserNotificationCenter verify];
+
+    [[self.mockedUserNotificationCenter reject] setNotificationCategories:OCMOCK_ANY];
+    [self.pushRegistration updateRegistrationWithOptions:expectedOptions categories:self.testCategories completionHandler:nil];
+    [self.mockedUserNotificationCenter verify];
+}
+
+-(void)testGetAuthorizedSettingsCoalesced {
+    __block NSUInteger requestCount = 0;
+    __block void (^pendingBlock)(UNNotificationSettings *);
+
+    id mockNotificationSettings = [self mockForClass:[UNNotificationSettings class]];
+    [[[mockNotificationSettings stub] andReturnValue:OCMOCK_VALUE(UNAuthorizationStatusAuthorized)] authorizationStatus];
+    [[[mockNotificationSettings stub] andReturnValue:OCMOCK_VALUE(UNNotificationSettingEnabled)] badgeSetting];
+
+    [[[self.mockedUserNotificationCenter stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+        pendingBlock = (__bridge void (^)(UNNotificationSettings *))arg;
+        requestCount++;
+    }] getNotificationSettingsWithCompletionHandler:OCMOCK_ANY];
+
+    __block NSUInteger callbackCount = 0;
+    for (int i = 0; i < 3; i++) {
+        [self.pushRegistration getAuthorizedSettingsWithCompletionHandler:^(UAAuthorizedNotificationSettings authorizedSettings, UAAuthorizationStatus status) {
+            XCTAssertEqual(UAAuthorizedNotificationSettingsBadge, authorizedSettings & UAAuthorizedNotificationSettingsBadge);
+            callbackCount++;
+        }];
+    }
+
+    XCTAssertEqual(1, requestCount);
+    pendingBlock(mockNotificationSettings);
+    XCTAssertEqual(3, callbackCount);
+
+    // Served from the cache
+    [self.pushRegistration getAuthorizedSettingsWithCompletionHandler:^(UAAuthorizedNotificationSettings authorizedSettings, UAAuthorizationStatus status) {
+        callbackCount++;
+    }];
+
+    XCTAssertEqual(1, requestCount);
+    XCTAssertEqual(4, callbackCount);
+}
+
 @end
 
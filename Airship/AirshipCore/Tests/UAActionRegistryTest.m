@@ -25,7 +25,7 @@
     self.registry = [[UAActionRegistry alloc] init];
 
     // Clear any default actions
-    [self.registry.registeredActionEntries removeAllObjects];
+    self.registry.registeredActionEntries = @{};
 
     self.mockAirship = [self mockForClass:[UAirship class]];
     [UAirship setSharedAirship:self.mockAirship];
@@ -313,5 +313,18 @@
     XCTAssertFalse([self.registry registerActionClass:[NSObject class] name:@"myInvalidActionClass"]);
 }
 
+- (void)testIsBackgroundSafeForActionNames {
+    [self.registry registerActionClass:[UAAddTagsAction class] name:@"add_tags"];
+    [self.registry registerAction:[[UAAction alloc] init] name:@"main"];
+
+    XCTAssertTrue([self.registry isBackgroundSafeForActionNames:@[@"add_tags", @"unregistered"] situation:UASituationAutomation]);
+    XCTAssertFalse([self.registry isBackgroundSafeForActionNames:@[@"add_tags", @"main"] situation:UASituationAutomation]);
+
+    // Situation overrides are used for their situation only
+    [self.registry addSituationOverride:UASituationAutomation forEntryWithName:@"main" action:[[UAAddTagsAction alloc] init]];
+    XCTAssertTrue([self.registry isBackgroundSafeForActionNames:@[@"add_tags", @"main"] situation:UASituationAutomation]);
+    XCTAssertFalse([self.registry isBackgroundSafeForActionNames:@[@"main"] situation:UASituationManualInvocation]);
+}
+
 
 @end
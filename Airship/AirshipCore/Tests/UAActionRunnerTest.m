@@ -6,6 +6,23 @@
 #import "UAActionRegistry.h"
 #import "UAirship+Internal.h"
 
+@interface UABackgroundTestAction : UAAction
+@property (nonatomic, assign) BOOL performedOnMainThread;
+@end
+
+@implementation UABackgroundTestAction
+
+- (UAActionThreadAffinity)threadAffinity {
+    return UAActionThreadAffinityBackground;
+}
+
+- (void)performWithArguments:(UAActionArguments *)arguments completionHandler:(UAActionCompletionHandler)completionHandler {
+    self.performedOnMainThread = [NSThread isMainThread];
+    completionHandler([UAActionResult resultWithValue:@"background"]);
+}
+
+@end
+
 @interface UAActionRunnerTest : UABaseTest
 @property (nonatomic, strong) UAActionRegistry *registry;
 @property (nonatomic, strong) id mockAirship;
@@ -379,6 +396,39 @@ NSString *anotherActionName = @"AnotherActionName";
     XCTAssertEqual(2, actionRunCount, @"Both actions should of ran");
 }
 
+/**
+ * Test background actions are performed off the main queue and their results are aggregated
+ * with the main queue actions.
+ */
+- (void)testRunActionPayloadBackgroundAffinity {
+    UABackgroundTestAction *backgroundAction = [[UABackgroundTestAction alloc] init];
+    [self.registry registerAction:backgroundAction name:actionName];
+
+    __block BOOL mainActionOnMainThread = NO;
+    UAAction *mainAction = [UAAction actionWithBlock:^(UAActionArguments *args, UAActionCompletionHandler completionHandler) {
+        mainActionOnMainThread = [NSThread isMainThread];
+        completionHandler([UAActionResult resultWithValue:@"main"]);
+    }];
+    [self.registry registerAction:mainAction name:anotherActionName];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Completion handler ran"];
+    NSDictionary *actionPayload = @{actionName : @"value", anotherActionName: @"another value"};
+    [UAActionRunner runActionsWithActionValues:actionPayload
+                                     situation:UASituationManualInvocation
+                                      metadata:nil
+                             completionHandler:^(UAActionResult *finalResult) {
+        XCTAssertTrue([NSThread isMainThread]);
+        NSDictionary *resultDictionary = (NSDictionary *)finalResult.value;
+        XCTAssertEqualObjects(@"background", [resultDictionary[actionName] value]);
+        XCTAssertEqualObjects(@"main", [resultDictionary[anotherActionName] value]);
+        [expectation fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    XCTAssertFalse(backgroundAction.performedOnMainThread);
+    XCTAssertTrue(mainActionOnMainThread);
+}
+
 /**
  * Test running a set of actions from a dictionary dedupes entries.
  */
@@ -18,6 +18,7 @@
 #import "UALocaleManager.h"
 #import "UAAppInitEvent+Internal.h"
 #import "UAAppForegroundEvent+Internal.h"
+#import "UAAppBackgroundEvent+Internal.h"
 
 @interface UAAnalyticsTest: UAAirshipBaseTest
 @property (nonatomic, strong) UAAnalytics *analytics;
@@ -238,6 +239,29 @@
     [mockEvent stopMocking];
 }
 
+/**
+ * Tests the add event completion handler reports whether the event was accepted.
+ */
+- (void)testAddEventCompletionHandler {
+    id validEvent = [self mockForClass:[UAEvent class]];
+    [[[validEvent stub] andReturnValue:OCMOCK_VALUE(YES)] isValid];
+
+    id invalidEvent = [self mockForClass:[UAEvent class]];
+    [[[invalidEvent stub] andReturnValue:OCMOCK_VALUE(NO)] isValid];
+
+    NSMutableArray *results = [NSMutableArray array];
+    [self.analytics addEvent:validEvent completionHandler:^(BOOL accepted) {
+        [results addObject:@(accepted)];
+    }];
+    [self.analytics addEvent:invalidEvent completionHandler:^(BOOL accepted) {
+        [results addObject:@(accepted)];
+    }];
+
+    XCTAssertEqualObjects((@[@YES, @NO]), results);
+    [validEvent stopMocking];
+    [invalidEvent stopMocking];
+}
+
 /**
  * Tests adding a valid event when analytics is disabled.
  * Expects adding a valid event when analytics is disabled drops event.
@@ -454,6 +478,32 @@
     [self.mockEventManager verify];
 }
 
+/**
+ * Test terminate writes any buffered events.
+ */
+- (void)testTerminateSavesPendingEvents {
+    [[self.mockEventManager expect] savePendingEvents];
+
+    [self.notificationCenter postNotificationName:UAApplicationWillTerminateNotification object:nil];
+
+    [self.mockEventManager verify];
+}
+
+/**
+ * Test background writes any buffered events after the background event is added.
+ */
+- (void)testBackgroundSavesPendingEvents {
+    [self.mockEventManager setExpectationOrderMatters:YES];
+    [[self.mockEventManager expect] addEvent:[OCMArg checkWithBlock:^BOOL(id obj) {
+        return [obj isKindOfClass:[UAAppBackgroundEvent class]];
+    }] sessionID:OCMOCK_ANY];
+    [[self.mockEventManager expect] savePendingEvents];
+
+    [self.notificationCenter postNotificationName:UAApplicationDidEnterBackgroundNotification object:nil];
+
+    [self.mockEventManager verify];
+}
+
 // Tests that starting a screen tracking event when one is already started adds the event with the correct start and stop times
 - (void)testStartTrackScreenAddEvent {
 
@@ -517,6 +567,46 @@
     [self waitForTestExpectations];
 }
 
+// Tests batched region events are coalesced, then added and forwarded together.
+- (void)testAddRegionEvents {
+    UATestDispatcher *dispatcher = [UATestDispatcher testDispatcher];
+    UAAnalytics *analytics = [UAAnalytics analyticsWithConfig:self.config
+                                                    dataStore:self.dataStore
+                                                      channel:self.mockChannel
+                                                 eventManager:self.mockEventManager
+                                           notificationCenter:self.notificationCenter
+                                                         date:self.testDate
+                                                   dispatcher:dispatcher
+                                                localeManager:self.mockLocaleClass
+                                              appStateTracker:self.mockAppStateTracker];
+
+    UARegionEvent *enter = [UARegionEvent regionEventWithRegionID:@"region" source:@"test" boundaryEvent:UABoundaryEventEnter];
+    UARegionEvent *exit = [UARegionEvent regionEventWithRegionID:@"region" source:@"test" boundaryEvent:UABoundaryEventExit];
+    UARegionEvent *other = [UARegionEvent regionEventWithRegionID:@"other" source:@"test" boundaryEvent:UABoundaryEventEnter];
+
+    __block NSArray *forwarded;
+    [self.notificationCenter addObserverForName:UARegionEventsAdded object:nil queue:nil usingBlock:^(NSNotification * _Nonnull note) {
+        forwarded = note.userInfo[UAEventsKey];
+    }];
+
+    XCTestExpectation *eventsAdded = [self expectationWithDescription:@"Events added"];
+    [[[self.mockEventManager expect] andDo:^(NSInvocation *invocation) {
+        [eventsAdded fulfill];
+    }] addEvents:@[other] sessionID:OCMOCK_ANY];
+
+    [analytics addRegionEvents:@[enter]];
+    [analytics addRegionEvents:@[other, exit]];
+
+    [dispatcher advanceTime:UAAnalyticsRegionEventDebounceInterval - 1];
+    XCTAssertNil(forwarded);
+
+    [dispatcher advanceTime:1];
+    XCTAssertEqualObjects(@[other], forwarded);
+
+    [self waitForTestExpectations];
+    [self.mockEventManager verify];
+}
+
 // Tests forwarding custom events to the analytics delegate.
 - (void)testForwardCustomEvents {
     XCTestExpectation *notificationFired = [self expectationWithDescription:@"Notification event fired"];
@@ -562,6 +652,16 @@
     XCTAssertEqualObjects(@"cordova:1.2.3, unity:5.6.7", headers[@"X-UA-Frameworks"]);
 }
 
+- (void)testAnalyticsHeadersSDKExtensionAfterCached {
+    id headers = [self.eventManagerDelegate analyticsHeaders];
+    XCTAssertNil(headers[@"X-UA-Frameworks"]);
+
+    [self.analytics registerSDKExtension:UASDKExtensionFlutter version:@"4.0.0"];
+
+    headers = [self.eventManagerDelegate analyticsHeaders];
+    XCTAssertEqualObjects(@"flutter:4.0.0", headers[@"X-UA-Frameworks"]);
+}
+
 - (void)testAnalyticsHeaders {
     id headers = [self.eventManagerDelegate analyticsHeaders];
     id expected = @{
@@ -123,4 +123,31 @@
     XCTAssertEqual(UAApplicationStateInactive, self.tracker.state);
 }
 
+- (void)testStateOffMainQueue {
+    // The adapter must not be touched off the main queue
+    [[self.mockAdapter reject] state];
+
+    XCTestExpectation *read = [self expectationWithDescription:@"read state"];
+    NSMutableArray *states = [NSMutableArray array];
+
+    [self.tracker applicationDidBecomeActive];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        [states addObject:@(self.tracker.state)];
+
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self.tracker applicationWillResignActive];
+            [self.tracker applicationDidEnterBackground];
+
+            dispatch_async(dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+                [states addObject:@(self.tracker.state)];
+                [read fulfill];
+            });
+        });
+    });
+
+    [self waitForTestExpectations];
+    XCTAssertEqualObjects((@[@(UAApplicationStateActive), @(UAApplicationStateBackground)]), states);
+    [self.mockAdapter verify];
+}
+
 @end
@@ -11,7 +11,7 @@
 @implementation UAAttributeMutationsTest
 
 /**
- Test add and remove operations on a mutations object result in a payload matching the applied operations
+ Test add and remove operations on a mutations object result in a payload matching the applied operations, with the last operation on an attribute replacing earlier ones
 */
 -(void)testMutationsPayload {
     NSArray *expectedMutations = @[
@@ -20,11 +20,6 @@
             @"key" : @"jam",
             @"value" : @"space"
         },
-        @{
-            @"action" : @"set",
-            @"key" : @"game",
-            @"value" : @"goose"
-        },
         @{
             @"action" : @"set",
             @"key" : @"luggage",
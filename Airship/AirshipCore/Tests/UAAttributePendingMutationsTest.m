@@ -3,7 +3,7 @@
 #import "UABaseTest.h"
 #import "UADate.h"
 #import "UAUtils+Internal.h"
-#import "UAAttributePendingMutations.h"
+#import "UAAttributePendingMutations+Internal.h"
 #import "UAAttributeMutations+Internal.h"
 #import "UATestDate.h"
 
@@ -33,12 +33,6 @@
                 @"timestamp" : timestamp,
                 @"value" : @"space"
             },
-            @{
-                @"action" : @"set",
-                @"key" : @"game",
-                @"timestamp" : timestamp,
-                @"value" : @"goose"
-            },
             @{
                 @"action" : @"remove",
                 @"timestamp" : timestamp,
@@ -154,4 +148,47 @@
     XCTAssertEqualObjects(pendingMutations.payload, expectedPayload);
 }
 
+/**
+ Test archiving and unarchiving preserves the payload
+*/
+-(void)testArchiveRoundTrip {
+    NSArray *payload = @[
+        @{ @"action" : @"set", @"key" : @"jam", @"timestamp" : @"2020-01-01T00:00:00", @"value" : @"space" },
+        @{ @"action" : @"set", @"key" : @"luggage", @"timestamp" : @"2020-01-01T00:00:00", @"value" : @(12345) },
+        @{ @"action" : @"set", @"key" : @"negative", @"timestamp" : @"2020-01-01T00:00:00", @"value" : @(-42) },
+        @{ @"action" : @"set", @"key" : @"not_quite_pi", @"timestamp" : @"2020-01-01T00:00:01", @"value" : @(3.14) },
+        @{ @"action" : @"set", @"key" : @"enabled", @"timestamp" : @"2020-01-01T00:00:01", @"value" : @YES },
+        @{ @"action" : @"remove", @"key" : @"game", @"timestamp" : @"2020-01-01T00:00:01" },
+        @{ @"action" : @"remove", @"key" : @"untimed" }
+    ];
+
+    UAAttributePendingMutations *pendingMutations = [UAAttributePendingMutations pendingMutationsWithPayload:payload];
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:pendingMutations];
+    UAAttributePendingMutations *unarchived = [NSKeyedUnarchiver unarchiveObjectWithData:data];
+
+    XCTAssertEqualObjects(unarchived.mutationsPayload, payload);
+    XCTAssertEqualObjects([NSJSONSerialization dataWithJSONObject:unarchived.payload options:NSJSONWritingSortedKeys error:nil],
+                          [NSJSONSerialization dataWithJSONObject:pendingMutations.payload options:NSJSONWritingSortedKeys error:nil]);
+}
+
+/**
+ Test mutations archived before the compact encoding still unarchive
+*/
+-(void)testUnarchiveLegacyEncoding {
+    NSArray *payload = @[
+        @{ @"action" : @"set", @"key" : @"jam", @"timestamp" : @"2020-01-01T00:00:00", @"value" : @"space" },
+        @{ @"action" : @"remove", @"key" : @"game", @"timestamp" : @"2020-01-01T00:00:00" }
+    ];
+
+    NSKeyedArchiver *archiver = [[NSKeyedArchiver alloc] initRequiringSecureCoding:NO];
+    [archiver encodeObject:payload forKey:@"com.urbanairship.attributes"];
+    [archiver finishEncoding];
+
+    NSKeyedUnarchiver *unarchiver = [[NSKeyedUnarchiver alloc] initForReadingFromData:archiver.encodedData error:nil];
+    unarchiver.requiresSecureCoding = NO;
+    UAAttributePendingMutations *unarchived = [[UAAttributePendingMutations alloc] initWithCoder:unarchiver];
+
+    XCTAssertEqualObjects(unarchived.mutationsPayload, payload);
+}
+
 @end
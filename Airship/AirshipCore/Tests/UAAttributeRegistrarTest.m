@@ -8,6 +8,7 @@
 #import "UAAttributePendingMutations.h"
 #import "UAPersistentQueue+Internal.h"
 #import "UAAttributeMutations.h"
+#import "UATestDispatcher.h"
 
 @interface UAAttributeRegistrarTest : UAAirshipBaseTest
 @property (nonatomic, strong) UAAttributeRegistrar *registrar;
@@ -72,6 +73,100 @@
     XCTAssertNil([self.persistentQueue peekObject]);
 }
 
+- (void)testUpdateAttributesBatchDelay {
+    UATestDispatcher *testDispatcher = [UATestDispatcher testDispatcher];
+    self.registrar = [UAAttributeRegistrar registrarWithAPIClient:self.mockApiClient
+                                                  persistentQueue:self.persistentQueue
+                                                      application:self.mockApplication
+                                                       dispatcher:testDispatcher
+                                                       batchDelay:1];
+    [self.registrar setIdentifier:@"some id" clearPendingOnChange:NO];
+
+    // Background task
+    [[[self.mockApplication stub] andReturnValue:OCMOCK_VALUE((NSUInteger)30)] beginBackgroundTaskWithExpirationHandler:OCMOCK_ANY];
+
+    UAAttributeMutations *breakfastDrink = [UAAttributeMutations mutations];
+    [breakfastDrink setString:@"coffee" forAttribute:@"breakfastDrink"];
+    UAAttributePendingMutations *breakfastMutations = [UAAttributePendingMutations pendingMutationsWithMutations:breakfastDrink
+                                                                                                            date:self.testDate];
+
+    UAAttributeMutations *lunchDrink = [UAAttributeMutations mutations];
+    [lunchDrink setString:@"Code Red" forAttribute:@"lunchDrink"];
+    UAAttributePendingMutations *lunchDrinkMutations = [UAAttributePendingMutations pendingMutationsWithMutations:lunchDrink
+                                                                                                             date:self.testDate];
+
+    UAAttributePendingMutations *expectedMutations = [UAAttributePendingMutations collapseMutations:@[breakfastMutations, lunchDrinkMutations]];
+
+    // Only the batched upload is expected
+    [[[self.mockApiClient expect] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        void (^completionHandler)(NSError *) = (__bridge void (^)(NSError *))arg;
+        completionHandler(nil);
+    }] updateWithIdentifier:self.registrar.identifier attributeMutations:expectedMutations completionHandler:OCMOCK_ANY];
+
+    [[self.mockApiClient reject] updateWithIdentifier:OCMOCK_ANY attributeMutations:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    [[self.mockApplication expect] endBackgroundTask:30];
+
+    // Save and update, then save and update again during the delay
+    [self.registrar savePendingMutations:breakfastMutations];
+    [self.registrar updateAttributes];
+    [self.registrar savePendingMutations:lunchDrinkMutations];
+    [self.registrar updateAttributes];
+
+    [testDispatcher advanceTime:1];
+
+    [self.mockApiClient verify];
+    [self.mockApplication verify];
+    XCTAssertNil([self.persistentQueue peekObject]);
+}
+
+- (void)testUpdateAttributesDebounce {
+    UATestDispatcher *testDispatcher = [UATestDispatcher testDispatcher];
+    self.registrar = [UAAttributeRegistrar registrarWithAPIClient:self.mockApiClient
+                                                  persistentQueue:self.persistentQueue
+                                                      application:self.mockApplication
+                                                       dispatcher:testDispatcher
+                                                       batchDelay:1
+                                                    maxBatchDelay:3];
+    [self.registrar setIdentifier:@"some id" clearPendingOnChange:NO];
+
+    // Background task
+    [[[self.mockApplication stub] andReturnValue:OCMOCK_VALUE((NSUInteger)30)] beginBackgroundTaskWithExpirationHandler:OCMOCK_ANY];
+
+    NSMutableArray<UAAttributePendingMutations *> *pending = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 4; i++) {
+        UAAttributeMutations *mutations = [UAAttributeMutations mutations];
+        [mutations setNumber:@(i) forAttribute:@"counter"];
+        [pending addObject:[UAAttributePendingMutations pendingMutationsWithMutations:mutations date:self.testDate]];
+    }
+
+    // Only the last write is uploaded, once
+    [[[self.mockApiClient expect] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        void (^completionHandler)(NSError *) = (__bridge void (^)(NSError *))arg;
+        completionHandler(nil);
+    }] updateWithIdentifier:self.registrar.identifier attributeMutations:pending.lastObject completionHandler:OCMOCK_ANY];
+
+    [[self.mockApiClient reject] updateWithIdentifier:OCMOCK_ANY attributeMutations:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    [self.registrar savePendingMutations:pending[0]];
+    [self.registrar updateAttributes];
+
+    // Each write during the delay pushes the upload back
+    for (NSUInteger i = 1; i < pending.count; i++) {
+        [testDispatcher advanceTime:0.5];
+        [self.registrar savePendingMutations:pending[i]];
+        [self.registrar updateAttributes];
+        [testDispatcher advanceTime:0.5];
+    }
+
+    [self.mockApiClient verify];
+    XCTAssertNil([self.persistentQueue peekObject]);
+}
+
 - (void)testUpdateAttributesContinuesUploadsAfterSuccess {
     // Background task
     [[[self.mockApplication stub] andReturnValue:OCMOCK_VALUE((NSUInteger)30)] beginBackgroundTaskWithExpirationHandler:OCMOCK_ANY];
@@ -399,5 +494,26 @@
     XCTAssertEqualObjects(expected, self.registrar.pendingMutations);
 }
 
+- (void)testRepeatedWritesAreReduced {
+    for (NSUInteger i = 0; i < 100; i++) {
+        UAAttributeMutations *drink = [UAAttributeMutations mutations];
+        [drink setNumber:@(i) forAttribute:@"drinkCount"];
+        [self.registrar savePendingMutations:[UAAttributePendingMutations pendingMutationsWithMutations:drink date:self.testDate]];
+    }
+
+    UAAttributeMutations *lastDrink = [UAAttributeMutations mutations];
+    [lastDrink setNumber:@(99) forAttribute:@"drinkCount"];
+    UAAttributePendingMutations *expected = [UAAttributePendingMutations pendingMutationsWithMutations:lastDrink date:self.testDate];
+
+    XCTAssertEqualObjects(expected, self.registrar.pendingMutations);
+    XCTAssertLessThanOrEqual(self.persistentQueue.objects.count, 33);
+
+    // Reloading from the queue gives the same reduced attributes
+    UAAttributeRegistrar *reloaded = [UAAttributeRegistrar registrarWithAPIClient:self.mockApiClient
+                                                                  persistentQueue:self.persistentQueue
+                                                                      application:self.mockApplication];
+    XCTAssertEqualObjects(expected, reloaded.pendingMutations);
+    XCTAssertEqualObjects(@[expected], self.persistentQueue.objects);
+}
 
 @end
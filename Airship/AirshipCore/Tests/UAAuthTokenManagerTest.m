@@ -3,6 +3,7 @@
 #import "UAAuthTokenManager+Internal.h"
 #import "UATestDate.h"
 #import "UATestDispatcher.h"
+#import "UAAppStateTracker.h"
 
 @interface UAAuthTokenManagerTest : UABaseTest
 @property(nonatomic, strong) UAAuthTokenManager *manager;
@@ -326,4 +327,51 @@
     XCTAssertNotEqualObjects(firstToken, secondToken);
 }
 
+- (void)expectTokenRequestWithToken:(NSString *)tokenString expiration:(NSDate *)expiration {
+    [[[self.mockClient expect] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:3];
+        void (^completionHandler)(UAAuthToken * _Nullable, NSError * _Nullable) = (__bridge void(^)(UAAuthToken * _Nullable, NSError * _Nullable))arg;
+        completionHandler([UAAuthToken authTokenWithChannelID:self.channelID token:tokenString expiration:expiration], nil);
+    }] tokenWithChannelID:self.channelID completionHandler:OCMOCK_ANY];
+}
+
+- (void)testTokenRefreshedAheadOfExpiration {
+    [self expectTokenRequestWithToken:@"token" expiration:[NSDate dateWithTimeInterval:24 * 60 * 60 sinceDate:self.testDate.now]];
+
+    __block NSString *currentToken;
+    [self.manager tokenWithCompletionHandler:^(NSString * _Nullable token) {
+        currentToken = token;
+    }];
+    XCTAssertEqualObjects(@"token", currentToken);
+
+    // Past the refresh point but before expiration
+    self.testDate.absoluteTime = [NSDate dateWithTimeInterval:20 * 60 * 60 sinceDate:self.testDate.now];
+    [self expectTokenRequestWithToken:@"new token" expiration:[NSDate distantFuture]];
+
+    // The current token is returned while a new one is fetched
+    [self.manager tokenWithCompletionHandler:^(NSString * _Nullable token) {
+        currentToken = token;
+    }];
+    XCTAssertEqualObjects(@"token", currentToken);
+    [self.mockClient verify];
+
+    [[self.mockClient reject] tokenWithChannelID:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    [self.manager tokenWithCompletionHandler:^(NSString * _Nullable token) {
+        currentToken = token;
+    }];
+    XCTAssertEqualObjects(@"new token", currentToken);
+}
+
+- (void)testTokenRefreshedOnForeground {
+    [self expectTokenRequestWithToken:@"token" expiration:[NSDate dateWithTimeInterval:24 * 60 * 60 sinceDate:self.testDate.now]];
+    [self.manager tokenWithCompletionHandler:^(NSString * _Nullable token) {}];
+
+    self.testDate.absoluteTime = [NSDate dateWithTimeInterval:20 * 60 * 60 sinceDate:self.testDate.now];
+    [self expectTokenRequestWithToken:@"new token" expiration:[NSDate distantFuture]];
+
+    [[NSNotificationCenter defaultCenter] postNotificationName:UAApplicationDidTransitionToForeground object:nil];
+    [self.mockClient verify];
+}
+
 @end
@@ -0,0 +1,221 @@
+/* Copyright Airship and Contributors */
+
+#import <CoreData/CoreData.h>
+
+#import "UABenchmarkTest.h"
+#import "UAAutomationEngine+Internal.h"
+#import "UAAutomationStore+Internal.h"
+#import "UAirship+Internal.h"
+#import "UAActionSchedule.h"
+#import "UACustomEvent.h"
+#import "UARegionEvent.h"
+#import "UAJSONPredicate.h"
+#import "UAJSONMatcher.h"
+#import "UAJSONValueMatcher.h"
+#import "UAApplicationMetrics+Internal.h"
+#import "UAMetricsRegistry.h"
+#import "UATestDispatcher.h"
+#import "UATestDate.h"
+#import "UAAppStateTracker.h"
+
+// Distinct event names, screens and regions the schedules are spread over
+static NSUInteger const UABenchmarkTriggerKeys = 50;
+
+// Events of each kind fired per measured iteration
+static NSUInteger const UABenchmarkEventsPerStream = 50;
+
+// High enough that no trigger fires, so every event only updates trigger progress
+static NSUInteger const UABenchmarkTriggerGoal = 1000000;
+
+/**
+ * Benchmarks for the automation hot path. Each benchmark loads schedules into an in-memory store,
+ * then measures streams of custom events, screens and region events going through trigger
+ * evaluation and the trigger progress writes. The average evaluation latency and the number of
+ * store writes are attached to the results.
+ */
+@interface UAAutomationEngineBenchmarkTest : UABenchmarkTest
+@property (nonatomic, strong) UAAutomationEngine *automationEngine;
+@property (nonatomic, strong) UAAutomationStore *testStore;
+@property (nonatomic, strong) NSNotificationCenter *notificationCenter;
+@property (nonatomic, strong) UATestDate *testDate;
+@property (nonatomic, strong) id mockAirship;
+@property (nonatomic, assign) NSUInteger storeWrites;
+@end
+
+@implementation UAAutomationEngineBenchmarkTest
+
+- (void)setUp {
+    [super setUp];
+
+    self.testDate = [[UATestDate alloc] initWithAbsoluteTime:[NSDate date]];
+    self.notificationCenter = [[NSNotificationCenter alloc] init];
+
+    self.mockAirship = [self mockForClass:[UAirship class]];
+    [UAirship setSharedAirship:self.mockAirship];
+    [[[self.mockAirship stub] andReturn:[self mockForClass:[UAApplicationMetrics class]]] applicationMetrics];
+
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(contextDidSave:)
+                                                 name:NSManagedObjectContextDidSaveNotification
+                                               object:nil];
+}
+
+- (void)tearDown {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+
+    [self.automationEngine stop];
+    [self.testStore shutDown];
+    [self.testStore waitForIdle];
+
+    self.automationEngine = nil;
+    self.testStore = nil;
+
+    [super tearDown];
+}
+
+- (void)testTriggerEvaluation100Schedules {
+    [self measureTriggerEvaluationWithScheduleCount:100];
+}
+
+- (void)testTriggerEvaluation1000Schedules {
+    [self measureTriggerEvaluationWithScheduleCount:1000];
+}
+
+- (void)testTriggerEvaluation5000Schedules {
+    [self measureTriggerEvaluationWithScheduleCount:5000];
+}
+
+#pragma mark -
+#pragma mark Helpers
+
+- (void)measureTriggerEvaluationWithScheduleCount:(NSUInteger)scheduleCount {
+    if (@available(iOS 13.0, tvOS 13.0, *)) {
+        [self startEngineWithScheduleCount:scheduleCount];
+
+        UAMetricHistogram *evaluation = [[UAMetricsRegistry shared] durationHistogramWithName:UAMetricAutomationTriggerEvaluationDuration];
+        uint64_t evaluationCount = evaluation.count;
+        double evaluationSum = evaluation.sum;
+        self.storeWrites = 0;
+
+        [self measureWithMetrics:self.benchmarkMetrics block:^{
+            [self fireEventStreams];
+            [self.testStore waitForIdle];
+        }];
+
+        uint64_t evaluations = evaluation.count - evaluationCount;
+        double averageEvaluation = evaluations ? (evaluation.sum - evaluationSum) / evaluations : 0;
+
+        NSString *summary = [NSString stringWithFormat:@"%lu schedules: %llu trigger evaluations, %.1f us average, %lu objects written",
+                             (unsigned long)scheduleCount,
+                             evaluations,
+                             averageEvaluation * 1000000,
+                             (unsigned long)self.storeWrites];
+        [self attachSummaryWithName:@"Trigger evaluation" summary:summary];
+    }
+}
+
+- (void)startEngineWithScheduleCount:(NSUInteger)scheduleCount {
+    UATestDispatcher *dispatcher = [UATestDispatcher testDispatcher];
+
+    self.testStore = [UAAutomationStore automationStoreWithConfig:self.config
+                                                    scheduleLimit:scheduleCount
+                                                         inMemory:YES
+                                                             date:self.testDate];
+
+    UATimerScheduler *timerScheduler = [UATimerScheduler timerSchedulerWithSchedulerBlock:^(NSTimer *timer) {}];
+
+    self.automationEngine = [UAAutomationEngine automationEngineWithAutomationStore:self.testStore
+                                                                    appStateTracker:[self mockForClass:[UAAppStateTracker class]]
+                                                                     timerScheduler:timerScheduler
+                                                                 notificationCenter:self.notificationCenter
+                                                                         dispatcher:dispatcher
+                                                             triggerEventDispatcher:dispatcher
+                                                                        application:[self mockForClass:[UIApplication class]]
+                                                                               date:self.testDate];
+
+    self.automationEngine.delegate = [self mockForProtocol:@protocol(UAAutomationEngineDelegate)];
+    [self.automationEngine start];
+
+    XCTestExpectation *scheduled = [self expectationWithDescription:@"scheduled"];
+    [self.automationEngine scheduleMultiple:[self schedulesWithCount:scheduleCount] completionHandler:^(BOOL result) {
+        XCTAssertTrue(result);
+        [scheduled fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    [self.testStore waitForIdle];
+}
+
+- (NSArray<UASchedule *> *)schedulesWithCount:(NSUInteger)count {
+    NSMutableArray *schedules = [NSMutableArray arrayWithCapacity:count];
+
+    for (NSUInteger i = 0; i < count; i++) {
+        NSUInteger key = i % UABenchmarkTriggerKeys;
+
+        UAScheduleTrigger *trigger;
+        switch (i % 3) {
+            case 0: {
+                UAJSONValueMatcher *valueMatcher = [UAJSONValueMatcher matcherWhereStringEquals:[self eventNameForKey:key]];
+                UAJSONMatcher *jsonMatcher = [UAJSONMatcher matcherWithValueMatcher:valueMatcher scope:@[UACustomEventNameKey]];
+                trigger = [UAScheduleTrigger customEventTriggerWithPredicate:[UAJSONPredicate predicateWithJSONMatcher:jsonMatcher]
+                                                                       count:UABenchmarkTriggerGoal];
+                break;
+            }
+            case 1:
+                trigger = [UAScheduleTrigger screenTriggerForScreenName:[self screenForKey:key] count:UABenchmarkTriggerGoal];
+                break;
+            default:
+                trigger = [UAScheduleTrigger regionEnterTriggerForRegionID:[self regionForKey:key] count:UABenchmarkTriggerGoal];
+                break;
+        }
+
+        [schedules addObject:[UAActionSchedule scheduleWithActions:@{@"benchmark": @(i)}
+                                                      builderBlock:^(UAScheduleBuilder *builder) {
+            builder.triggers = @[trigger];
+        }]];
+    }
+
+    return schedules;
+}
+
+- (void)fireEventStreams {
+    for (NSUInteger i = 0; i < UABenchmarkEventsPerStream; i++) {
+        NSUInteger key = i % UABenchmarkTriggerKeys;
+
+        [self.notificationCenter postNotificationName:UACustomEventAdded
+                                               object:self
+                                             userInfo:@{UAEventKey: [UACustomEvent eventWithName:[self eventNameForKey:key]]}];
+
+        [self.notificationCenter postNotificationName:UAScreenTracked
+                                               object:self
+                                             userInfo:@{UAScreenKey: [self screenForKey:key]}];
+
+        UARegionEvent *regionEvent = [UARegionEvent regionEventWithRegionID:[self regionForKey:key]
+                                                                     source:@"benchmark"
+                                                              boundaryEvent:UABoundaryEventEnter];
+        [self.notificationCenter postNotificationName:UARegionEventAdded
+                                               object:self
+                                             userInfo:@{UAEventKey: regionEvent}];
+    }
+}
+
+- (void)contextDidSave:(NSNotification *)notification {
+    NSUInteger written = [notification.userInfo[NSInsertedObjectsKey] count] + [notification.userInfo[NSUpdatedObjectsKey] count];
+    @synchronized (self) {
+        self.storeWrites += written;
+    }
+}
+
+- (NSString *)eventNameForKey:(NSUInteger)key {
+    return [NSString stringWithFormat:@"event-%lu", (unsigned long)key];
+}
+
+- (NSString *)screenForKey:(NSUInteger)key {
+    return [NSString stringWithFormat:@"screen-%lu", (unsigned long)key];
+}
+
+- (NSString *)regionForKey:(NSUInteger)key {
+    return [NSString stringWithFormat:@"region-%lu", (unsigned long)key];
+}
+
+@end
@@ -10,12 +10,14 @@
 #import "UARuntimeConfig.h"
 #import "UAScheduleDelay.h"
 #import "UAScheduleData+Internal.h"
+#import "UAScheduleTriggerData+Internal.h"
 #import "UAApplicationMetrics+Internal.h"
 #import "UATestDispatcher.h"
 #import "UATestDate.h"
 #import "UAAppStateTracker.h"
 #import "UATestRuntimeConfig.h"
 #import "UAActionSchedule.h"
+#import "UAFrequencyConstraint+Internal.h"
 
 @interface UAAutomationEngineIntegrationTest : UABaseTest
 @property (nonatomic, strong) UAAutomationEngine *automationEngine;
@@ -71,6 +73,7 @@
                                                                      timerScheduler:self.timerScheduler
                                                                  notificationCenter:self.notificationCenter
                                                                          dispatcher:self.dispatcher
+                                                             triggerEventDispatcher:self.dispatcher
                                                                         application:self.mockedApplication
                                                                                date:self.testDate];
 
@@ -134,6 +137,97 @@
     [self waitForTestExpectations];
 }
 
+- (void)testUpdateSchedulesWithEdits {
+    UASchedule *existing = [UAActionSchedule scheduleWithActions:@{@"cool": @"story"}
+                                                    builderBlock:^(UAScheduleBuilder * _Nonnull builder) {
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:2]];
+    }];
+
+    UASchedule *new = [UAActionSchedule scheduleWithActions:@{@"cool": @"story"}
+                                               builderBlock:^(UAScheduleBuilder * _Nonnull builder) {
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:2]];
+    }];
+
+    [self.automationEngine schedule:existing completionHandler:nil];
+
+    UAScheduleEdits *edits = [UAScheduleEdits editsWithBuilderBlock:^(UAScheduleEditsBuilder *builder) {
+        builder.priority = @(10);
+    }];
+
+    XCTestExpectation *updated = [self expectationWithDescription:@"schedules updated"];
+    [self.automationEngine updateSchedulesWithEdits:@{ existing.identifier: edits, @"not found": edits }
+                                       newSchedules:@[new]
+                                  completionHandler:^(BOOL result) {
+        XCTAssertTrue(result);
+        [updated fulfill];
+    }];
+
+    [self waitForTestExpectations];
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched schedules"];
+    [self.automationEngine getSchedules:^(NSArray<UASchedule *> *schedules) {
+        XCTAssertEqual(2, schedules.count);
+        for (UASchedule *schedule in schedules) {
+            if ([schedule.identifier isEqualToString:existing.identifier]) {
+                XCTAssertEqual(10, schedule.priority);
+            }
+        }
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
+- (void)testUpdateSchedulesWithEditsOverLimit {
+    UASchedule *existing = [UAActionSchedule scheduleWithActions:@{@"cool": @"story"}
+                                                    builderBlock:^(UAScheduleBuilder * _Nonnull builder) {
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:2]];
+    }];
+
+    [self.automationEngine schedule:existing completionHandler:nil];
+
+    NSMutableArray *newSchedules = [NSMutableArray array];
+    for (int i = 0; i < UAAUTOMATIONENGINETESTS_SCHEDULE_LIMIT; i++) {
+        [newSchedules addObject:[UAActionSchedule scheduleWithActions:@{@"cool": @"story"}
+                                                         builderBlock:^(UAScheduleBuilder * _Nonnull builder) {
+            builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:2]];
+        }]];
+    }
+
+    UAScheduleEdits *edits = [UAScheduleEdits editsWithBuilderBlock:^(UAScheduleEditsBuilder *builder) {
+        builder.priority = @(10);
+    }];
+
+    XCTestExpectation *updated = [self expectationWithDescription:@"schedules partially updated"];
+    [self.automationEngine updateSchedulesWithEdits:@{ existing.identifier: edits }
+                                       newSchedules:newSchedules
+                                  completionHandler:^(BOOL result) {
+        XCTAssertFalse(result);
+        [updated fulfill];
+    }];
+
+    [self waitForTestExpectations];
+
+    // Edits are applied even though the new schedules are over the limit
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched schedule"];
+    [self.automationEngine getScheduleWithID:existing.identifier type:UAScheduleTypeActions completionHandler:^(UASchedule *schedule) {
+        XCTAssertNotNil(schedule);
+        XCTAssertEqual(10, schedule.priority);
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+
+    // New schedules are saved up to the limit
+    XCTestExpectation *fetchedAll = [self expectationWithDescription:@"fetched schedules"];
+    [self.automationEngine getSchedules:^(NSArray<UASchedule *> *schedules) {
+        XCTAssertEqual(UAAUTOMATIONENGINETESTS_SCHEDULE_LIMIT, schedules.count);
+        [fetchedAll fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
 - (void)testScheduleInvalidActionInfo {
     XCTestExpectation *testExpectation = [self expectationWithDescription:@"scheduled action"];
 
@@ -183,6 +277,39 @@
     [self waitForTestExpectations];
 }
 
+- (void)testScheduleAfterCancelAtLimit {
+    NSMutableArray<UASchedule *> *schedules = [NSMutableArray array];
+    for (int i = 0; i < UAAUTOMATIONENGINETESTS_SCHEDULE_LIMIT; i++) {
+        [schedules addObject:[self foregroundSchedule]];
+    }
+
+    XCTestExpectation *scheduled = [self expectationWithDescription:@"scheduled"];
+    [self.automationEngine scheduleMultiple:schedules completionHandler:^(BOOL result) {
+        XCTAssertTrue(result);
+        [scheduled fulfill];
+    }];
+
+    [self waitForTestExpectations];
+
+    [self.automationEngine cancelScheduleWithID:schedules.firstObject.identifier completionHandler:nil];
+    [self.testStore waitForIdle];
+
+    XCTestExpectation *counted = [self expectationWithDescription:@"counted"];
+    [self.testStore getScheduleCount:^(NSNumber *count) {
+        XCTAssertEqualObjects(@(UAAUTOMATIONENGINETESTS_SCHEDULE_LIMIT - 1), count);
+        [counted fulfill];
+    }];
+
+    // Freed a slot under the limit
+    XCTestExpectation *rescheduled = [self expectationWithDescription:@"rescheduled"];
+    [self.automationEngine schedule:[self foregroundSchedule] completionHandler:^(BOOL result) {
+        XCTAssertTrue(result);
+        [rescheduled fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
 - (void)testPriority {
     NSArray *testPriorityLevels = @[@5, @-2, @0, @-10];
 
@@ -241,6 +368,44 @@
     XCTAssertEqualObjects(executedPriorityLevel, expectedPriorityLevel);
 }
 
+- (void)testStalledPrepareReleasesItsSlot {
+    XCTestExpectation *firstPrepares = [self expectationWithDescription:@"first prepares"];
+    firstPrepares.expectedFulfillmentCount = 4;
+    XCTestExpectation *lastPrepare = [self expectationWithDescription:@"last prepare"];
+
+    // Prepares never finish, as when the delegate is backing off before a retry
+    __block NSUInteger prepareCount = 0;
+    [[[self.mockDelegate stub] andDo:^(NSInvocation *invocation) {
+        @synchronized (self) {
+            prepareCount++;
+            if (prepareCount <= 4) {
+                [firstPrepares fulfill];
+            } else {
+                [lastPrepare fulfill];
+            }
+        }
+    }] prepareSchedule:OCMOCK_ANY triggerContext:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    for (int i = 0; i < 5; i++) {
+        UASchedule *schedule = [UAActionSchedule scheduleWithActions:@{}
+                                                        builderBlock:^(UAScheduleBuilder * _Nonnull builder) {
+            builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:1]];
+        }];
+        [self.automationEngine schedule:schedule completionHandler:nil];
+    }
+
+    [self simulateForegroundTransition];
+    [self waitForTestExpectations:@[firstPrepares]];
+
+    @synchronized (self) {
+        XCTAssertEqual(4, prepareCount);
+    }
+
+    // Timing out the stalled prepares starts the queued one
+    [self.dispatcher advanceTime:30];
+    [self waitForTestExpectations:@[lastPrepare]];
+}
+
 - (void)testGetGroups {
     NSMutableArray *expectedFooSchedules = [NSMutableArray array];
 
@@ -322,6 +487,49 @@
     [self waitForTestExpectations];
 }
 
+- (UASchedule *)fetchScheduleWithID:(NSString *)identifier {
+    __block UASchedule *result;
+    XCTestExpectation *fetched = [self expectationWithDescription:@"schedule fetched"];
+    [self.automationEngine getScheduleWithID:identifier type:UAScheduleTypeActions completionHandler:^(UASchedule *schedule) {
+        result = schedule;
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    return result;
+}
+
+- (void)testDecodedSchedulesAreReusedUntilEdited {
+    UASchedule *schedule = [UAActionSchedule scheduleWithActions:@{} builderBlock:^(UAScheduleBuilder *builder) {
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:2]];
+    }];
+
+    XCTestExpectation *scheduled = [self expectationWithDescription:@"scheduled"];
+    [self.automationEngine schedule:schedule completionHandler:^(BOOL result) {
+        [scheduled fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    UASchedule *first = [self fetchScheduleWithID:schedule.identifier];
+    XCTAssertNotNil(first);
+    XCTAssertTrue(first == [self fetchScheduleWithID:schedule.identifier]);
+
+    UAScheduleEdits *edits = [UAScheduleEdits editsWithBuilderBlock:^(UAScheduleEditsBuilder *builder) {
+        builder.priority = @(10);
+    }];
+
+    XCTestExpectation *edited = [self expectationWithDescription:@"edited"];
+    [self.automationEngine editScheduleWithID:schedule.identifier edits:edits completionHandler:^(BOOL result) {
+        XCTAssertTrue(result);
+        [edited fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    UASchedule *editedSchedule = [self fetchScheduleWithID:schedule.identifier];
+    XCTAssertEqual(10, editedSchedule.priority);
+    XCTAssertTrue(editedSchedule == [self fetchScheduleWithID:schedule.identifier]);
+}
+
 - (void)testGetAllUnended {
     NSMutableArray *expectedSchedules = [NSMutableArray array];
 
@@ -426,6 +634,193 @@
     [self waitForTestExpectations];
 }
 
+- (void)testCancelGroupNotifiesDelegateOnce {
+    NSMutableArray<UASchedule *> *schedules = [NSMutableArray array];
+    for (int i = 0; i < 10; i++) {
+        [schedules addObject:[UAActionSchedule scheduleWithActions:@{} builderBlock:^(UAScheduleBuilder *builder) {
+            builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:2]];
+            builder.group = @"foo";
+        }]];
+    }
+
+    [self.automationEngine scheduleMultiple:schedules completionHandler:nil];
+
+    [[self.mockDelegate expect] onSchedulesCancelled:[OCMArg checkWithBlock:^BOOL(NSArray *cancelled) {
+        return [[NSSet setWithArray:cancelled] isEqualToSet:[NSSet setWithArray:schedules]];
+    }]];
+    [[self.mockDelegate reject] onScheduleCancelled:OCMOCK_ANY];
+
+    XCTestExpectation *schedulesCanceled = [self expectationWithDescription:@"schedules canceled"];
+    [self.automationEngine cancelSchedulesWithGroup:@"foo" completionHandler:^(BOOL result) {
+        XCTAssertTrue(result);
+        [schedulesCanceled fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    [self.mockDelegate verify];
+
+    XCTestExpectation *counted = [self expectationWithDescription:@"counted"];
+    [self.testStore getScheduleCount:^(NSNumber *count) {
+        XCTAssertEqualObjects(@(0), count);
+        [counted fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
+- (void)testTriggerProgressSavedAfterInterval {
+    self.testStore.triggerProgressSaveInterval = 0.5;
+    [self saveSchedules:@[[self foregroundSchedule]] store:self.testStore];
+
+    NSMutableArray<NSNumber *> *savedProgress = [NSMutableArray array];
+    XCTestExpectation *saved = [self expectationWithDescription:@"progress saved"];
+    id observer = [[NSNotificationCenter defaultCenter] addObserverForName:NSManagedObjectContextDidSaveNotification
+                                                                    object:nil
+                                                                     queue:nil
+                                                                usingBlock:^(NSNotification *notification) {
+        for (id object in notification.userInfo[NSUpdatedObjectsKey]) {
+            if ([object isKindOfClass:[UAScheduleTriggerData class]]) {
+                [savedProgress addObject:((UAScheduleTriggerData *)object).goalProgress];
+                [saved fulfill];
+            }
+        }
+    }];
+
+    [self setForegroundTriggerProgress:1 store:self.testStore];
+
+    // Progress is held until the interval passes
+    XCTAssertEqual(0, savedProgress.count);
+
+    [self waitForTestExpectations];
+    [[NSNotificationCenter defaultCenter] removeObserver:observer];
+    XCTAssertEqualObjects(@[@(1)], savedProgress);
+}
+
+- (void)testTriggerProgressSavedOnBackground {
+    self.testStore.triggerProgressSaveInterval = 60;
+    [self saveSchedules:@[[self foregroundSchedule]] store:self.testStore];
+
+    NSMutableArray<NSNumber *> *savedProgress = [NSMutableArray array];
+    id observer = [[NSNotificationCenter defaultCenter] addObserverForName:NSManagedObjectContextDidSaveNotification
+                                                                    object:nil
+                                                                     queue:nil
+                                                                usingBlock:^(NSNotification *notification) {
+        for (id object in notification.userInfo[NSUpdatedObjectsKey]) {
+            if ([object isKindOfClass:[UAScheduleTriggerData class]]) {
+                [savedProgress addObject:((UAScheduleTriggerData *)object).goalProgress];
+            }
+        }
+    }];
+
+    [self setForegroundTriggerProgress:1 store:self.testStore];
+    XCTAssertEqual(0, savedProgress.count);
+
+    // Backgrounding saves the held progress without waiting for the interval
+    [self simulateBackgroundTransition];
+    [self.testStore waitForIdle];
+
+    [[NSNotificationCenter defaultCenter] removeObserver:observer];
+    XCTAssertEqualObjects(@[@(1)], savedProgress);
+}
+
+- (void)testFailedUpdateKeepsTriggerProgress {
+    self.testStore.triggerProgressSaveInterval = 60;
+    UASchedule *schedule = [self foregroundSchedule];
+    [self saveSchedules:@[schedule] store:self.testStore];
+    [self setForegroundTriggerProgress:1 store:self.testStore];
+
+    // Clearing a required attribute makes the update fail to save
+    XCTestExpectation *updated = [self expectationWithDescription:@"update failed"];
+    [self.testStore updateSchedulesWithIDs:@[schedule.identifier] editBlock:^(NSArray<UAScheduleData *> *scheduleDatas) {
+        scheduleDatas.firstObject.executionState = nil;
+    } newSchedules:@[] completionHandler:^(BOOL saved, NSArray<UASchedule *> *savedSchedules) {
+        XCTAssertFalse(saved);
+        [updated fulfill];
+    }];
+
+    [self waitForTestExpectations];
+
+    NSMutableArray<NSNumber *> *savedProgress = [NSMutableArray array];
+    id observer = [[NSNotificationCenter defaultCenter] addObserverForName:NSManagedObjectContextDidSaveNotification
+                                                                    object:nil
+                                                                     queue:nil
+                                                                usingBlock:^(NSNotification *notification) {
+        for (id object in notification.userInfo[NSUpdatedObjectsKey]) {
+            if ([object isKindOfClass:[UAScheduleTriggerData class]]) {
+                [savedProgress addObject:((UAScheduleTriggerData *)object).goalProgress];
+            }
+        }
+    }];
+
+    // Only the update is reverted, the held progress still saves
+    [self.testStore savePendingTriggerProgress];
+    [self.testStore waitForIdle];
+
+    [[NSNotificationCenter defaultCenter] removeObserver:observer];
+    XCTAssertEqualObjects(@[@(1)], savedProgress);
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched schedule"];
+    [self.testStore getSchedule:schedule.identifier completionHandler:^(UAScheduleData *scheduleData) {
+        XCTAssertEqual(UAScheduleStateIdle, [scheduleData.executionState intValue]);
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
+- (void)testGroupDeleteKeepsTriggerProgress {
+    // Batch deletes only run on SQLite stores
+    UATestRuntimeConfig *config = [UATestRuntimeConfig testConfig];
+    config.appKey = [NSUUID UUID].UUIDString;
+    UAAutomationStore *store = [UAAutomationStore automationStoreWithConfig:config
+                                                              scheduleLimit:UAAUTOMATIONENGINETESTS_SCHEDULE_LIMIT
+                                                                   inMemory:NO
+                                                                       date:self.testDate];
+    store.triggerProgressSaveInterval = 60;
+
+    UASchedule *foo = [UAActionSchedule scheduleWithActions:@{} builderBlock:^(UAScheduleBuilder *builder) {
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:2]];
+        builder.group = @"foo";
+    }];
+
+    UASchedule *bar = [UAActionSchedule scheduleWithActions:@{} builderBlock:^(UAScheduleBuilder *builder) {
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:2]];
+        builder.group = @"bar";
+    }];
+
+    [self saveSchedules:@[foo, bar] store:store];
+    [self setForegroundTriggerProgress:1 store:store];
+
+    XCTestExpectation *deleted = [self expectationWithDescription:@"deleted"];
+    [store deleteSchedulesWithGroup:@"foo" type:nil willDelete:nil completionHandler:^(NSSet<NSString *> *identifiers) {
+        XCTAssertEqualObjects([NSSet setWithObject:foo.identifier], identifiers);
+        [deleted fulfill];
+    }];
+
+    [self waitForTestExpectations];
+
+    [store savePendingTriggerProgress];
+    [store waitForIdle];
+    [store shutDown];
+
+    // The remaining schedule's progress is on disk
+    UAAutomationStore *reopened = [UAAutomationStore automationStoreWithConfig:config
+                                                                 scheduleLimit:UAAUTOMATIONENGINETESTS_SCHEDULE_LIMIT
+                                                                      inMemory:NO
+                                                                          date:self.testDate];
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched triggers"];
+    [reopened getTriggers:^(NSArray<UAScheduleTriggerData *> *triggers) {
+        XCTAssertEqual(1, triggers.count);
+        XCTAssertEqualObjects(bar.identifier, triggers.firstObject.schedule.identifier);
+        XCTAssertEqualObjects(@(1), triggers.firstObject.goalProgress);
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    [reopened shutDown];
+}
+
 - (void)testGetExpiredSchedules {
     NSDate *futureDate = [NSDate dateWithTimeInterval:100 sinceDate:self.testDate.now];
 
@@ -526,6 +921,76 @@
     [self waitForTestExpectations];
 }
 
+- (void)testCleanSchedulesDeletesFinishedSchedulesAfterGracePeriod {
+    NSDate *endDate = [NSDate dateWithTimeInterval:100 sinceDate:self.testDate.now];
+    NSDate *purgeDate = [NSDate dateWithTimeInterval:100 sinceDate:endDate];
+
+    UASchedule *schedule = [UAActionSchedule scheduleWithActions:@{} builderBlock:^(UAScheduleBuilder *builder) {
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:2]];
+        builder.end = endDate;
+        builder.editGracePeriod = 100;
+    }];
+
+    [self.automationEngine schedule:schedule completionHandler:nil];
+    [self.testStore waitForIdle];
+
+    // Expire the schedule, it should be kept until the grace period passes
+    self.testDate.timeOffset = [endDate timeIntervalSinceDate:self.testDate.now] + 1;
+    [self.automationEngine schedule:[self foregroundSchedule] completionHandler:nil];
+    [self.testStore waitForIdle];
+
+    XCTestExpectation *finished = [self expectationWithDescription:@"finished"];
+    [self.testStore getSchedule:schedule.identifier completionHandler:^(UAScheduleData *scheduleData) {
+        XCTAssertEqual(UAScheduleStateFinished, [scheduleData.executionState intValue]);
+        XCTAssertEqualObjects(purgeDate, scheduleData.purgeAfter);
+        [finished fulfill];
+    }];
+
+    [self waitForTestExpectations];
+
+    // Pass the grace period
+    self.testDate.timeOffset += [purgeDate timeIntervalSinceDate:self.testDate.now] + 1;
+    [self.automationEngine schedule:[self foregroundSchedule] completionHandler:nil];
+    [self.testStore waitForIdle];
+
+    XCTestExpectation *deleted = [self expectationWithDescription:@"deleted"];
+    [self.testStore getSchedule:schedule.identifier completionHandler:^(UAScheduleData *scheduleData) {
+        XCTAssertNil(scheduleData);
+        [deleted fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
+- (void)testGetTriggerPredicates {
+    UAJSONValueMatcher *valueMatcher = [UAJSONValueMatcher matcherWhereStringEquals:@"purchase"];
+    UAJSONMatcher *jsonMatcher = [UAJSONMatcher matcherWithValueMatcher:valueMatcher scope:@[UACustomEventNameKey]];
+    UAJSONPredicate *predicate = [UAJSONPredicate predicateWithJSONMatcher:jsonMatcher];
+
+    UASchedule *schedule = [UAActionSchedule scheduleWithActions:@{} builderBlock:^(UAScheduleBuilder *builder) {
+        builder.triggers = @[[UAScheduleTrigger customEventTriggerWithPredicate:predicate count:1],
+                             [UAScheduleTrigger foregroundTriggerWithCount:1]];
+    }];
+
+    [self.automationEngine schedule:schedule completionHandler:nil];
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched"];
+    [self.testStore getTriggerPredicates:^(NSArray<NSDictionary *> *triggerPredicates) {
+        XCTAssertEqual(2, triggerPredicates.count);
+        for (NSDictionary *trigger in triggerPredicates) {
+            if ([trigger[@"type"] integerValue] == UAScheduleTriggerCustomEventCount) {
+                XCTAssertNotNil(trigger[@"predicateData"]);
+            } else {
+                XCTAssertEqual(UAScheduleTriggerAppForeground, [trigger[@"type"] integerValue]);
+                XCTAssertNil(trigger[@"predicateData"]);
+            }
+        }
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
 - (void)testForeground {
     UAScheduleTrigger *trigger = [UAScheduleTrigger foregroundTriggerWithCount:2];
     [self verifyTrigger:trigger triggerFireBlock:^{
@@ -661,6 +1126,24 @@
     }];
 }
 
+- (void)testScreenDelayIgnoresOtherScreens {
+    UAScheduleDelay *delay = [UAScheduleDelay delayWithBuilderBlock:^(UAScheduleDelayBuilder * builder) {
+        builder.screens = @[@"test screen"];
+        builder.regionID = @"region test";
+    }];
+
+    [self verifyDelay:delay fulfillmentBlock:^{
+        [self emitScreenTracked:@"test screen"];
+        [self emitScreenTracked:@"other screen"];
+
+        // Entering the region wakes the schedule, but its screen no longer matches
+        UARegionEvent *regionEnter = [UARegionEvent regionEventWithRegionID:@"region test" source:@"test" boundaryEvent:UABoundaryEventEnter];
+        [self emitEvent:regionEnter];
+
+        [self emitScreenTracked:@"test screen"];
+    }];
+}
+
 - (void)testRegionDelay {
     UAScheduleDelay *delay = [UAScheduleDelay delayWithBuilderBlock:^(UAScheduleDelayBuilder * builder) {
         builder.regionID = @"region test";
@@ -930,6 +1413,68 @@
     }];
 }
 
+- (void)testFrequencyConstraintSkipsPrepare {
+    [self.automationEngine updateFrequencyConstraints:@[[UAFrequencyConstraint constraintWithIdentifier:@"cap" range:100 count:1]]];
+
+    UASchedule *schedule = [UAActionSchedule scheduleWithActions:@{} builderBlock:^(UAScheduleBuilder *builder) {
+        builder.limit = 3;
+        builder.frequencyConstraintIDs = @[@"cap"];
+        UAJSONValueMatcher *valueMatcher = [UAJSONValueMatcher matcherWhereStringEquals:@"purchase"];
+        UAJSONMatcher *jsonMatcher = [UAJSONMatcher matcherWithValueMatcher:valueMatcher scope:@[UACustomEventNameKey]];
+        UAJSONPredicate *predicate = [UAJSONPredicate predicateWithJSONMatcher:jsonMatcher];
+        builder.triggers = @[[UAScheduleTrigger customEventTriggerWithPredicate:predicate count:1]];
+    }];
+
+    [self.automationEngine schedule:schedule completionHandler:nil];
+    [self.testStore waitForIdle];
+
+    __block NSUInteger prepareCount = 0;
+    [[[self.mockDelegate stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        void (^handler)(UAAutomationSchedulePrepareResult) = (__bridge void (^)(UAAutomationSchedulePrepareResult))arg;
+        prepareCount++;
+        handler(UAAutomationSchedulePrepareResultContinue);
+    }] prepareSchedule:OCMOCK_ANY triggerContext:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    [[[self.mockDelegate stub] andReturnValue:OCMOCK_VALUE(UAAutomationScheduleReadyResultContinue)] isScheduleReadyToExecute:OCMOCK_ANY];
+
+    [[[self.mockDelegate stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:3];
+        void (^handler)(void) = (__bridge void (^)(void))arg;
+        handler();
+    }] executeSchedule:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    // First execution counts against the constraint
+    [self emitEvent:[UACustomEvent eventWithName:@"purchase"]];
+    [self.testStore waitForIdle];
+    [self.testStore waitForIdle];
+    XCTAssertEqual(1, prepareCount);
+
+    // Second trigger is capped before it is prepared
+    [self emitEvent:[UACustomEvent eventWithName:@"purchase"]];
+    [self.testStore waitForIdle];
+    [self.testStore waitForIdle];
+    XCTAssertEqual(1, prepareCount);
+
+    XCTestExpectation *checkState = [self expectationWithDescription:@"Checked schedule state"];
+    [self.automationEngine.automationStore getSchedule:schedule.identifier completionHandler:^(UAScheduleData *scheduleData) {
+        XCTAssertEqual(1, [scheduleData.triggeredCount integerValue]);
+        XCTAssertEqual(UAScheduleStateIdle, [scheduleData.executionState intValue]);
+        [checkState fulfill];
+    }];
+
+    [self waitForTestExpectations];
+
+    // Once the window passes the schedule prepares again
+    self.testDate.timeOffset = 101;
+    [self emitEvent:[UACustomEvent eventWithName:@"purchase"]];
+    [self.testStore waitForIdle];
+    [self.testStore waitForIdle];
+    XCTAssertEqual(2, prepareCount);
+}
+
 - (void)verifyPrepareResult:(UAAutomationSchedulePrepareResult)prepareResult verifyWithCompletionHandler:(void (^)(UAScheduleData *))completionHandler {
     // Schedule the action
     UASchedule *schedule = [UAActionSchedule scheduleWithActions:@{} builderBlock:^(UAScheduleBuilder *builder) {
@@ -1271,6 +1816,38 @@
     [self waitForTestExpectations];
 }
 
+- (void)saveSchedules:(NSArray<UASchedule *> *)schedules store:(UAAutomationStore *)store {
+    XCTestExpectation *saved = [self expectationWithDescription:@"saved"];
+    [store saveSchedules:schedules completionHandler:^(BOOL result) {
+        XCTAssertTrue(result);
+        [saved fulfill];
+    }];
+
+    [self waitForTestExpectations:@[saved]];
+}
+
+/**
+ * Sets the progress of every foreground trigger in the store, the way the engine does when processing an event.
+ */
+- (void)setForegroundTriggerProgress:(double)progress store:(UAAutomationStore *)store {
+    XCTestExpectation *updated = [self expectationWithDescription:@"triggers updated"];
+    [store getActiveTriggers:nil type:UAScheduleTriggerAppForeground completionHandler:^(NSArray<UAScheduleTriggerData *> *triggers) {
+        for (UAScheduleTriggerData *trigger in triggers) {
+            trigger.goalProgress = @(progress);
+        }
+        [updated fulfill];
+    }];
+
+    [self waitForTestExpectations:@[updated]];
+    [store waitForIdle];
+}
+
+- (UASchedule *)foregroundSchedule {
+    return [UAActionSchedule scheduleWithActions:@{} builderBlock:^(UAScheduleBuilder *builder) {
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:2]];
+    }];
+}
+
 - (void)emitEvent:(UAEvent *)event {
     if ([event isKindOfClass:[UACustomEvent class]]) {
         [self.notificationCenter postNotificationName:UACustomEventAdded
@@ -0,0 +1,119 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UABackgroundWorkScheduler+Internal.h"
+#import "UATestDate.h"
+#import "UAWorkScheduler+Internal.h"
+#import "UAMetricsRegistry+Internal.h"
+
+@interface UABackgroundWorkSchedulerTest : UABaseTest
+@property (nonatomic, strong) UABackgroundWorkScheduler *scheduler;
+@property (nonatomic, strong) UAWorkScheduler *workScheduler;
+@property (nonatomic, strong) UATestDate *testDate;
+@end
+
+@implementation UABackgroundWorkSchedulerTest
+
+- (void)setUp {
+    [super setUp];
+    self.testDate = [[UATestDate alloc] init];
+    self.workScheduler = [UAWorkScheduler schedulerWithLaunchType:UAWorkLaunchTypeBackgroundFetch
+                                               notificationCenter:[[NSNotificationCenter alloc] init]
+                                                             date:self.testDate
+                                                          metrics:[UAMetricsRegistry metricsRegistry]];
+    self.scheduler = [UABackgroundWorkScheduler schedulerWithNotificationCenter:[[NSNotificationCenter alloc] init]
+                                                           permittedIdentifiers:@[]
+                                                                  workScheduler:self.workScheduler];
+}
+
+- (void)testPerformWork {
+    __block void (^firstCompletion)(BOOL);
+    __block BOOL secondRan = NO;
+    __block BOOL processingRan = NO;
+
+    [self.scheduler registerWorkWithName:@"first" type:UABackgroundWorkTypeRefresh block:^UADisposable *(void (^completionHandler)(BOOL)) {
+        firstCompletion = completionHandler;
+        return nil;
+    }];
+
+    [self.scheduler registerWorkWithName:@"second" type:UABackgroundWorkTypeRefresh block:^UADisposable *(void (^completionHandler)(BOOL)) {
+        secondRan = YES;
+        completionHandler(YES);
+        return nil;
+    }];
+
+    [self.scheduler registerWorkWithName:@"processing" type:UABackgroundWorkTypeProcessing block:^UADisposable *(void (^completionHandler)(BOOL)) {
+        processingRan = YES;
+        completionHandler(YES);
+        return nil;
+    }];
+
+    XCTestExpectation *finished = [self expectationWithDescription:@"work finished"];
+    [self.scheduler performWorkWithType:UABackgroundWorkTypeRefresh completionHandler:^(BOOL success) {
+        XCTAssertFalse(success);
+        [finished fulfill];
+    }];
+
+    XCTAssertTrue(secondRan);
+    XCTAssertFalse(processingRan);
+
+    // Finishes once all the work has finished
+    firstCompletion(NO);
+    [self waitForTestExpectations];
+}
+
+- (void)testDeferredWorkDoesNotHoldUpCompletion {
+    // Spend the budget
+    __block void (^longCompletion)(void);
+    [self.workScheduler submitWorkWithName:@"long" priority:UAWorkPriorityHigh deadline:0 dispatcher:nil block:^UADisposable *(void (^completionHandler)(void)) {
+        longCompletion = completionHandler;
+        return nil;
+    } dropHandler:nil];
+    self.testDate.timeOffset = UAWorkBackgroundFetchBudget;
+    longCompletion();
+
+    __block BOOL ran = NO;
+    [self.scheduler registerWorkWithName:@"work" type:UABackgroundWorkTypeRefresh block:^UADisposable *(void (^completionHandler)(BOOL)) {
+        ran = YES;
+        completionHandler(YES);
+        return nil;
+    }];
+
+    XCTestExpectation *finished = [self expectationWithDescription:@"work finished"];
+    [self.scheduler performWorkWithType:UABackgroundWorkTypeRefresh completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+        [finished fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    XCTAssertFalse(ran);
+
+    // The deferred work is left to the next background task
+    [self.workScheduler beginWindowWithLaunchType:UAWorkLaunchTypeBackgroundFetch];
+    XCTAssertFalse(ran);
+}
+
+- (void)testDisposeStopsWork {
+    __block BOOL disposed = NO;
+    [self.scheduler registerWorkWithName:@"work" type:UABackgroundWorkTypeRefresh block:^UADisposable *(void (^completionHandler)(BOOL)) {
+        return [UADisposable disposableWithBlock:^{
+            disposed = YES;
+            completionHandler(YES);
+        }];
+    }];
+
+    __block NSUInteger calls = 0;
+    __block BOOL result = YES;
+    UADisposable *disposable = [self.scheduler performWorkWithType:UABackgroundWorkTypeRefresh completionHandler:^(BOOL success) {
+        calls++;
+        result = success;
+    }];
+
+    [disposable dispose];
+
+    XCTAssertTrue(disposed);
+    XCTAssertEqual(1, calls);
+    XCTAssertFalse(result);
+}
+
+@end
@@ -0,0 +1,44 @@
+/* Copyright Airship and Contributors */
+
+#import "UAAirshipBaseTest.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Base class for benchmarks. Benchmarks are slow, so they are skipped unless the `UA_BENCHMARKS`
+ * environment variable is set, which `make benchmark` does.
+ */
+@interface UABenchmarkTest : UAAirshipBaseTest
+
+/**
+ * The metrics recorded by every benchmark: clock time, CPU, peak memory and bytes written to storage.
+ */
+@property (nonatomic, readonly) NSArray<XCTMetric *> *benchmarkMetrics API_AVAILABLE(ios(13.0), tvos(13.0));
+
+/**
+ * Measure options for benchmarks that start and stop measuring themselves, so each iteration can
+ * set up its own state.
+ */
+@property (nonatomic, readonly) XCTMeasureOptions *manualMeasureOptions API_AVAILABLE(ios(13.0), tvos(13.0));
+
+/**
+ * Returns a percentile of a set of samples.
+ *
+ * @param percentile The percentile, between 0 and 1.
+ * @param samples The samples.
+ * @param count The number of samples.
+ * @return The percentile, or 0 if there are no samples.
+ */
+- (double)percentile:(double)percentile ofSamples:(double *)samples count:(NSUInteger)count;
+
+/**
+ * Attaches a summary to the test results, in addition to the measured metrics.
+ *
+ * @param name The summary name.
+ * @param summary The summary.
+ */
+- (void)attachSummaryWithName:(NSString *)name summary:(NSString *)summary;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,53 @@
+/* Copyright Airship and Contributors */
+
+#import "UABenchmarkTest.h"
+
+@implementation UABenchmarkTest
+
+- (BOOL)setUpWithError:(NSError **)error {
+    XCTSkipUnless([NSProcessInfo processInfo].environment[@"UA_BENCHMARKS"] != nil, @"Benchmarks only run with UA_BENCHMARKS set");
+
+    if (@available(iOS 13.0, tvOS 13.0, *)) {
+        return YES;
+    }
+
+    XCTSkip(@"Benchmarks require iOS 13");
+    return NO;
+}
+
+- (NSArray<XCTMetric *> *)benchmarkMetrics {
+    return @[[[XCTClockMetric alloc] init],
+             [[XCTCPUMetric alloc] init],
+             [[XCTMemoryMetric alloc] init],
+             [[XCTStorageMetric alloc] init]];
+}
+
+- (XCTMeasureOptions *)manualMeasureOptions {
+    XCTMeasureOptions *options = [XCTMeasureOptions defaultOptions];
+    options.invocationOptions = XCTMeasurementInvocationManuallyStart | XCTMeasurementInvocationManuallyStop;
+    return options;
+}
+
+- (double)percentile:(double)percentile ofSamples:(double *)samples count:(NSUInteger)count {
+    if (!count) {
+        return 0;
+    }
+
+    qsort_b(samples, count, sizeof(double), ^int(const void *first, const void *second) {
+        double a = *(const double *)first;
+        double b = *(const double *)second;
+        return a < b ? -1 : (a > b ? 1 : 0);
+    });
+
+    NSUInteger index = MIN((NSUInteger)(percentile * count), count - 1);
+    return samples[index];
+}
+
+- (void)attachSummaryWithName:(NSString *)name summary:(NSString *)summary {
+    XCTAttachment *attachment = [XCTAttachment attachmentWithString:summary];
+    attachment.name = name;
+    attachment.lifetime = XCTAttachmentLifetimeKeepAlways;
+    [self addAttachment:attachment];
+}
+
+@end
@@ -7,6 +7,8 @@
 #import "UARuntimeConfig.h"
 #import "UAAppStateTracker.h"
 #import "UATestDate.h"
+#import "UAActionRunner.h"
+#import "UAShareAction.h"
 
 @interface UAChannelCaptureTest : UAAirshipBaseTest
 @property(nonatomic, strong) UAChannelCapture *channelCapture;
@@ -230,6 +232,37 @@
     [self verifyChannelIsCapturedAfterKnocks];
 }
 
+/**
+ * Test the channel capture deep link shares the channel without touching the pasteboard.
+ */
+- (void)testDeepLink {
+    [self expectMockPasteboardToBeSet:NO];
+    id mockActionRunner = [self mockForClass:[UAActionRunner class]];
+    [[mockActionRunner expect] runActionWithName:UAShareActionDefaultRegistryName
+                                           value:@"ua:pushChannelID"
+                                       situation:UASituationManualInvocation];
+
+    XCTAssertTrue([self.channelCapture handleDeepLink:[NSURL URLWithString:@"uairship://channel_capture"]]);
+
+    [mockActionRunner verify];
+    [self.mockPasteboard verify];
+}
+
+/**
+ * Test the channel capture deep link is consumed but ignored when channel capture is disabled.
+ */
+- (void)testDeepLinkDisabled {
+    self.channelCapture.enabled = NO;
+    id mockActionRunner = [self mockForClass:[UAActionRunner class]];
+    [[mockActionRunner reject] runActionWithName:OCMOCK_ANY value:OCMOCK_ANY situation:UASituationManualInvocation];
+
+    XCTAssertTrue([self.channelCapture handleDeepLink:[NSURL URLWithString:@"uairship://channel_capture"]]);
+    XCTAssertFalse([self.channelCapture handleDeepLink:[NSURL URLWithString:@"uairship://app_settings"]]);
+    XCTAssertFalse([self.channelCapture handleDeepLink:[NSURL URLWithString:@"https://channel_capture"]]);
+
+    [mockActionRunner verify];
+}
+
 /**
  * Helper method to verify channel capture is captured
  */
@@ -482,6 +482,35 @@
     XCTAssertEqualObjects(self.payload.badge, minPayload.badge);
 }
 
+/**
+ * Test the content hash only changes when the payload contents change.
+ */
+- (void)testContentHash {
+    UAChannelRegistrationPayload *copy = [self.payload copy];
+    XCTAssertEqualObjects([self.payload contentHash], [copy contentHash]);
+
+    copy.language = @"changed";
+    XCTAssertNotEqualObjects([self.payload contentHash], [copy contentHash]);
+}
+
+/**
+ * Test changed fields can be applied to another payload.
+ */
+- (void)testApplyChangedFields {
+    UAChannelRegistrationPayload *changed = [self.payload copy];
+    changed.language = nil;
+    changed.optedIn = !self.payload.optedIn;
+    changed.badge = @(100);
+
+    NSDictionary *fields = [changed fieldsChangedFromPayload:self.payload];
+    XCTAssertEqual(3, fields.count);
+    XCTAssertEqualObjects([NSNull null], fields[@"language"]);
+
+    UAChannelRegistrationPayload *applied = [self.payload copy];
+    [applied applyFields:fields];
+    XCTAssertEqualObjects(changed, applied);
+}
+
 #pragma mark -
 #pragma mark Helpers
 
@@ -130,6 +130,47 @@
     XCTAssertEqualObjects(tagsNoSpaces, self.channel.tags, @"whitespace was not trimmed from tags");
 }
 
+- (void)testTagSet {
+    XCTAssertEqual(0, self.channel.tagSet.count);
+
+    [self.channel setTags:@[@"foo", @"bar"]];
+    NSSet *expected = [NSSet setWithArray:@[@"foo", @"bar"]];
+    XCTAssertEqualObjects(expected, self.channel.tagSet);
+
+    // Snapshot is reused until the tags change
+    XCTAssertEqual(self.channel.tagSet, self.channel.tagSet);
+
+    [self.channel addTag:@"baz"];
+    XCTAssertTrue([self.channel.tagSet containsObject:@"baz"]);
+}
+
+/**
+ * Test editing tags saves the edits together and updates the registration once.
+ */
+- (void)testEditTags {
+    [self.dataStore setBool:YES forKey:UAirshipDataCollectionEnabledKey];
+    self.channel.tags = @[@"a", @"b"];
+
+    [[self.mockChannelRegistrar expect] registerForcefully:NO];
+    [self.channel editTags:^(UATagEditor *editor) {
+        [editor addTag:@"c"];
+        [editor removeTag:@"a"];
+        [editor addTags:@[@"  d  ", @"b"]];
+    }];
+
+    NSArray *expected = @[@"b", @"c", @"d"];
+    XCTAssertEqualObjects(expected, self.channel.tags);
+    XCTAssertEqualObjects(expected, [self.dataStore objectForKey:UAChannelTagsSettingsKey]);
+    [self.mockChannelRegistrar verify];
+
+    // Edits that do not change the tags do not update the registration
+    [[self.mockChannelRegistrar reject] registerForcefully:NO];
+    [self.channel editTags:^(UATagEditor *editor) {
+        [editor addTag:@"b"];
+    }];
+    [self.mockChannelRegistrar verify];
+}
+
 /**
  * Tests tag setting when tag consists entirely of whitespace
  */
@@ -529,22 +570,28 @@
 }
 
 /**
- * Test extending CRA payloads.
+ * Test extending CRA payloads merges the fields from every extender, in registration order.
  */
 - (void)testExtendingPayload {
     [self.channel addChannelExtenderBlock:^(UAChannelRegistrationPayload *payload, UAChannelRegistrationExtenderCompletionHandler completionHandler) {
         payload.pushAddress = @"WHAT!";
+        payload.namedUserId = @"first";
         completionHandler(payload);
     }];
 
     [self.channel addChannelExtenderBlock:^(UAChannelRegistrationPayload *payload, UAChannelRegistrationExtenderCompletionHandler completionHandler) {
-        payload.pushAddress = [NSString stringWithFormat:@"%@ %@", payload.pushAddress, @"OK!"];
+        // Extenders run concurrently, each against its own copy
+        XCTAssertNil(payload.pushAddress);
+        payload.namedUserId = @"second";
+        payload.badge = @(1);
         completionHandler(payload);
     }];
 
     XCTestExpectation *createdPayload = [self expectationWithDescription:@"create payload"];
     [self.channel createChannelPayload:^(UAChannelRegistrationPayload * _Nonnull payload) {
-        XCTAssertEqualObjects(@"WHAT! OK!", payload.pushAddress);
+        XCTAssertEqualObjects(@"WHAT!", payload.pushAddress);
+        XCTAssertEqualObjects(@"second", payload.namedUserId);
+        XCTAssertEqualObjects(@(1), payload.badge);
         [createdPayload fulfill];
     } dispatcher:[UATestDispatcher testDispatcher]];
 
@@ -565,13 +612,14 @@
     __block BOOL isMainThread;
     [self.channel addChannelExtenderBlock:^(UAChannelRegistrationPayload *payload, UAChannelRegistrationExtenderCompletionHandler completionHandler) {
         isMainThread = [NSThread currentThread].isMainThread;
-        payload.pushAddress = [NSString stringWithFormat:@"%@ %@", payload.pushAddress, @"OK!"];
+        payload.namedUserId = @"OK!";
         completionHandler(payload);
     }];
 
     XCTestExpectation *createdPayload = [self expectationWithDescription:@"create payload"];
     [self.channel createChannelPayload:^(UAChannelRegistrationPayload * _Nonnull payload) {
-        XCTAssertEqualObjects(@"WHAT! OK!", payload.pushAddress);
+        XCTAssertEqualObjects(@"WHAT!", payload.pushAddress);
+        XCTAssertEqualObjects(@"OK!", payload.namedUserId);
         [createdPayload fulfill];
     } dispatcher:[UATestDispatcher testDispatcher]];
 
@@ -579,6 +627,44 @@
     XCTAssertTrue(isMainThread);
 }
 
+/**
+ * Test the extenders are skipped until one of the payload inputs changes.
+ */
+- (void)testPayloadReusedUntilInputsChange {
+    [self.dataStore setBool:YES forKey:UAirshipDataCollectionEnabledKey];
+
+    __block NSUInteger extenderCalls = 0;
+    [self.channel addChannelExtenderBlock:^(UAChannelRegistrationPayload *payload, UAChannelRegistrationExtenderCompletionHandler completionHandler) {
+        extenderCalls++;
+        completionHandler(payload);
+    }];
+
+    UAChannelRegistrationPayload * (^createPayload)(void) = ^{
+        __block UAChannelRegistrationPayload *result;
+        XCTestExpectation *createdPayload = [self expectationWithDescription:@"create payload"];
+        [self.channel createChannelPayload:^(UAChannelRegistrationPayload * _Nonnull payload) {
+            result = payload;
+            [createdPayload fulfill];
+        } dispatcher:[UATestDispatcher testDispatcher]];
+        [self waitForTestExpectations];
+        return result;
+    };
+
+    UAChannelRegistrationPayload *payload = createPayload();
+    XCTAssertEqual(1, extenderCalls);
+
+    XCTAssertEqualObjects(payload, createPayload());
+    XCTAssertEqual(1, extenderCalls);
+
+    self.channel.tags = @[@"new tag"];
+    XCTAssertEqualObjects(@[@"new tag"], createPayload().tags);
+    XCTAssertEqual(2, extenderCalls);
+
+    [self.channel updateRegistration];
+    createPayload();
+    XCTAssertEqual(3, extenderCalls);
+}
+
 - (void)testDeviceIDChanged {
     [[self.mockChannelRegistrar expect] resetChannel];
     [self.notificationCenter postNotificationName:UADeviceIDChangedNotification object:nil];
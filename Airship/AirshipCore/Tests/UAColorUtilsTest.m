@@ -91,4 +91,26 @@
     XCTAssertNil(c);
 }
 
+/**
+ * Test that surrounding whitespace is ignored and invalid digits are rejected.
+ */
+- (void)testWhitespaceAndInvalidDigits {
+    UIColor *c = [UAColorUtils colorWithHexString:@"  #ff0000\n"];
+    XCTAssertEqualObjects([UAColorUtils hexStringWithColor:c], @"#ffff0000");
+
+    XCTAssertNil([UAColorUtils colorWithHexString:@"#ff00gg"]);
+    XCTAssertNil([UAColorUtils colorWithHexString:@"#ff 0000"]);
+    XCTAssertNil([UAColorUtils colorWithHexString:@""]);
+}
+
+/**
+ * Test that repeated lookups of the same string reuse the parsed color.
+ */
+- (void)testParsedColorsAreCached {
+    UIColor *first = [UAColorUtils colorWithHexString:@"#ff336699"];
+    UIColor *second = [UAColorUtils colorWithHexString:[NSString stringWithFormat:@"#ff33%@", @"6699"]];
+    XCTAssertNotNil(first);
+    XCTAssertTrue(first == second);
+}
+
 @end
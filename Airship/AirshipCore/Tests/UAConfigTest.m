@@ -319,10 +319,15 @@
     XCTAssertTrue(copy.customConfig == config.customConfig);
     XCTAssertTrue(copy.channelCreationDelayEnabled == config.channelCreationDelayEnabled);
     XCTAssertTrue(copy.extendedBroadcastsEnabled == config.extendedBroadcastsEnabled);
+    XCTAssertTrue(copy.lazyMessageCenterEnabled == config.lazyMessageCenterEnabled);
     XCTAssertTrue(copy.defaultDetectProvisioningMode == config.defaultDetectProvisioningMode);
     XCTAssertTrue(copy.messageCenterStyleConfig == config.messageCenterStyleConfig);
     XCTAssertTrue(copy.itunesID == config.itunesID);
     XCTAssertTrue(copy.requestAuthorizationToUseNotifications == config.requestAuthorizationToUseNotifications);
+    XCTAssertTrue(copy.uploadQualityOfService == config.uploadQualityOfService);
+    XCTAssertTrue(copy.processingQualityOfService == config.processingQualityOfService);
+    XCTAssertTrue(copy.maintenanceQualityOfService == config.maintenanceQualityOfService);
+    XCTAssertTrue(copy.displayQualityOfService == config.displayQualityOfService);
 }
 
 - (void) testInitialConfig {
@@ -347,8 +352,60 @@
     XCTAssertEqual(config.customConfig.count, 0);
     XCTAssertFalse(config.channelCreationDelayEnabled);
     XCTAssertFalse(config.extendedBroadcastsEnabled);
+    XCTAssertFalse(config.lazyMessageCenterEnabled);
     XCTAssertTrue(config.defaultDetectProvisioningMode);
     XCTAssertTrue(config.requestAuthorizationToUseNotifications);
+    XCTAssertEqual(NSQualityOfServiceUtility, config.uploadQualityOfService);
+    XCTAssertEqual(NSQualityOfServiceUtility, config.processingQualityOfService);
+    XCTAssertEqual(NSQualityOfServiceBackground, config.maintenanceQualityOfService);
+    XCTAssertEqual(NSQualityOfServiceUserInitiated, config.displayQualityOfService);
+}
+
+- (void)testQualityOfServiceParsing {
+    NSDictionary *normalized = [UAConfig normalizeDictionary:@{ @"uploadQualityOfService" : @"background",
+                                                                @"displayQualityOfService" : @"USER_INTERACTIVE",
+                                                                @"processingQualityOfService" : @(NSQualityOfServiceDefault),
+                                                                @"maintenanceQualityOfService" : @"not a qos" }];
+
+    UAConfig *config = [UAConfig config];
+    [config setValuesForKeysWithDictionary:normalized];
+
+    XCTAssertEqual(NSQualityOfServiceBackground, config.uploadQualityOfService);
+    XCTAssertEqual(NSQualityOfServiceUserInteractive, config.displayQualityOfService);
+    XCTAssertEqual(NSQualityOfServiceDefault, config.processingQualityOfService);
+
+    // Invalid names keep the default
+    XCTAssertEqual(NSQualityOfServiceBackground, config.maintenanceQualityOfService);
+}
+
+- (void)testSnapshot {
+    NSURL *directoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    NSURL *plistURL = [directoryURL URLByAppendingPathComponent:@"AirshipConfig.plist"];
+    NSURL *snapshotURL = [directoryURL URLByAppendingPathComponent:@"AirshipConfig.snapshot"];
+    [[NSFileManager defaultManager] createDirectoryAtURL:directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+
+    NSString *validPath = [[NSBundle bundleForClass:[self class]] pathForResource:@"AirshipConfig-Valid" ofType:@"plist"];
+    [[NSFileManager defaultManager] copyItemAtPath:validPath toPath:plistURL.path error:nil];
+
+    UAConfig *config = [UAConfig configWithContentsOfFile:plistURL.path snapshotURL:snapshotURL];
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:snapshotURL.path]);
+
+    // Loading again uses the snapshot and matches the parsed config
+    UAConfig *snapshotConfig = [UAConfig configWithContentsOfFile:plistURL.path snapshotURL:snapshotURL];
+    XCTAssertEqualObjects(config.description, snapshotConfig.description);
+
+    // Changing the plist invalidates the snapshot
+    NSMutableDictionary *values = [NSMutableDictionary dictionaryWithContentsOfURL:plistURL];
+    values[@"developmentAppKey"] = @"0123456789012345678901";
+    [values writeToURL:plistURL atomically:YES];
+    [[NSFileManager defaultManager] setAttributes:@{NSFileModificationDate : [NSDate dateWithTimeIntervalSinceNow:10]}
+                                     ofItemAtPath:plistURL.path
+                                            error:nil];
+
+    UAConfig *updatedConfig = [UAConfig configWithContentsOfFile:plistURL.path snapshotURL:snapshotURL];
+    XCTAssertEqualObjects(@"0123456789012345678901", updatedConfig.developmentAppKey);
+
+    [[NSFileManager defaultManager] removeItemAtURL:directoryURL error:nil];
 }
 
 @end
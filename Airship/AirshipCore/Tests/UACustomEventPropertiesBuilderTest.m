@@ -0,0 +1,74 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UACustomEventPropertiesBuilder+Internal.h"
+#import "UACustomEvent+Internal.h"
+#import "UAEvent+Internal.h"
+#import "UAAnalytics.h"
+#import "UAirship+Internal.h"
+
+@interface UACustomEventPropertiesBuilderTest : UABaseTest
+@property (nonatomic, strong) UACustomEventPropertiesBuilder *builder;
+@end
+
+@implementation UACustomEventPropertiesBuilderTest
+
+- (void)setUp {
+    [super setUp];
+    self.builder = [[UACustomEventPropertiesBuilder alloc] init];
+}
+
+- (void)testJSONData {
+    [self.builder setString:@"quote \" slash \\ newline \n tab \t bell \a ü" forKey:@"string"];
+    [self.builder setInteger:-42 forKey:@"integer"];
+    [self.builder setDouble:1.5 forKey:@"double"];
+    [self.builder setBool:YES forKey:@"bool"];
+    [self.builder setNumber:@NO forKey:@"number bool"];
+    [self.builder setNumber:@(123456789012) forKey:@"number"];
+    [self.builder setStrings:@[@"a", @"b"] forKey:@"strings"];
+
+    // Ignored
+    [self.builder setDouble:NAN forKey:@"nan"];
+    [self.builder setString:@"duplicate" forKey:@"string"];
+
+    NSDictionary *expected = @{@"string": @"quote \" slash \\ newline \n tab \t bell \a ü",
+                               @"integer": @(-42),
+                               @"double": @(1.5),
+                               @"bool": @YES,
+                               @"number bool": @NO,
+                               @"number": @(123456789012),
+                               @"strings": @[@"a", @"b"]};
+
+    NSDictionary *parsed = [NSJSONSerialization JSONObjectWithData:[self.builder JSONData] options:0 error:nil];
+    XCTAssertEqualObjects(expected, parsed);
+    XCTAssertEqual(7, self.builder.count);
+}
+
+- (void)testEmpty {
+    XCTAssertEqualObjects([@"{}" dataUsingEncoding:NSUTF8StringEncoding], [self.builder JSONData]);
+}
+
+- (void)testEventSerialization {
+    id analytics = [self mockForClass:[UAAnalytics class]];
+    id airship = [self mockForClass:[UAirship class]];
+    [[[airship stub] andReturn:analytics] sharedAnalytics];
+    [UAirship setSharedAirship:airship];
+
+    [self.builder setString:@"shoes" forKey:@"category"];
+    [self.builder setBool:YES forKey:@"ltv"];
+
+    UACustomEvent *event = [UACustomEvent eventWithName:@"purchased"];
+    [event setPropertiesWithBuilder:self.builder];
+    XCTAssertTrue(event.isValid);
+
+    NSDictionary *payload = [NSJSONSerialization JSONObjectWithData:[event JSONDataWithSessionID:@"session"] options:0 error:nil];
+    NSDictionary *expectedData = @{@"event_name": @"purchased",
+                                   @"session_id": @"session",
+                                   @"properties": @{@"category": @"shoes", @"ltv": @YES}};
+    XCTAssertEqualObjects(expectedData, payload[@"data"]);
+
+    // The properties are still readable as a dictionary
+    XCTAssertEqualObjects(@"shoes", event.properties[@"category"]);
+}
+
+@end
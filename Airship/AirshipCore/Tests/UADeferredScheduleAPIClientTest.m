@@ -640,4 +640,160 @@
     [self waitForTestExpectations];
 }
 
+- (void)testResolveURLCachesResult {
+    NSURL *URL = [NSURL URLWithString:@"https://cool.story/neat"];
+    UAScheduleTrigger *trigger = [UAScheduleTrigger foregroundTriggerWithCount:1];
+    UAScheduleTriggerContext *triggerContext = [UAScheduleTriggerContext triggerContextWithTrigger:trigger event:@"event"];
+    UAAttributePendingMutations *attributeOverrides = [UAAttributePendingMutations pendingMutationsWithMutations:[UAAttributeMutations mutations]
+                                                                                                             date:[[UADate alloc] init]];
+
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@""] statusCode:200 HTTPVersion:nil headerFields:nil];
+    NSData *responseData = [NSJSONSerialization dataWithJSONObject:@{@"audience_match": @(YES)} options:0 error:nil];
+
+    [[[self.mockAuthManager stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+
+        void (^handler)(NSString * _Nullable) = (__bridge void (^_Nonnull)(NSString * _Nullable))arg;
+        handler(@"token");
+    }] tokenWithCompletionHandler:OCMOCK_ANY];
+
+    [[[self.mockSession expect] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        UARequestCompletionHandler completionHandler = (__bridge UARequestCompletionHandler)arg;
+        completionHandler(responseData, response, nil);
+    }] dataTaskWithRequest:OCMOCK_ANY retryWhere:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    __block UADeferredScheduleResult *firstResult;
+    [self.client resolveURL:URL
+                  channelID:@"channelID"
+             triggerContext:triggerContext
+               tagOverrides:@[]
+         attributeOverrides:attributeOverrides
+          completionHandler:^(UADeferredScheduleResult * _Nullable result, NSError * _Nullable error) {
+        firstResult = result;
+    }];
+
+    XCTAssertNotNil(firstResult);
+    [self.mockSession verify];
+
+    // An identical request is served from the cache
+    [[self.mockSession reject] dataTaskWithRequest:OCMOCK_ANY retryWhere:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    XCTestExpectation *resultResolved = [self expectationWithDescription:@"Result resolved"];
+    [self.client resolveURL:URL
+                  channelID:@"channelID"
+             triggerContext:triggerContext
+               tagOverrides:@[]
+         attributeOverrides:attributeOverrides
+          completionHandler:^(UADeferredScheduleResult * _Nullable result, NSError * _Nullable error) {
+        XCTAssertEqual(firstResult, result);
+        XCTAssertNil(error);
+        [resultResolved fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    [self.mockSession verify];
+}
+
+/**
+ * Test a speculative result is used when the trigger fires.
+ */
+- (void)testPrefetchURL {
+    NSURL *URL = [NSURL URLWithString:@"https://cool.story/neat"];
+    UAScheduleTrigger *trigger = [UAScheduleTrigger foregroundTriggerWithCount:3];
+    UAAttributePendingMutations *attributeOverrides = [UAAttributePendingMutations pendingMutationsWithMutations:[UAAttributeMutations mutations]
+                                                                                                             date:[[UADate alloc] init]];
+
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@""] statusCode:200 HTTPVersion:nil headerFields:nil];
+    NSData *responseData = [NSJSONSerialization dataWithJSONObject:@{@"audience_match": @(YES)} options:0 error:nil];
+
+    [[[self.mockAuthManager stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+
+        void (^handler)(NSString * _Nullable) = (__bridge void (^_Nonnull)(NSString * _Nullable))arg;
+        handler(@"token");
+    }] tokenWithCompletionHandler:OCMOCK_ANY];
+
+    [[[self.mockSession expect] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        UARequestCompletionHandler completionHandler = (__bridge UARequestCompletionHandler)arg;
+        completionHandler(responseData, response, nil);
+    }] dataTaskWithRequest:[OCMArg checkWithBlock:^BOOL(id obj) {
+        UARequest *request = obj;
+        NSDictionary *body = [NSJSONSerialization JSONObjectWithData:request.body options:NSJSONReadingAllowFragments error:nil];
+        return [body[@"trigger"] isEqual:@{@"type": trigger.typeName, @"goal" : trigger.goal}];
+    }] retryWhere:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    [self.client prefetchURL:URL
+                   channelID:@"channelID"
+              triggerContext:[UAScheduleTriggerContext triggerContextWithTrigger:trigger event:nil]
+                tagOverrides:@[]
+          attributeOverrides:attributeOverrides];
+
+    [self.mockSession verify];
+
+    // The triggering event resolves from the speculative result
+    [[self.mockSession reject] dataTaskWithRequest:OCMOCK_ANY retryWhere:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    XCTestExpectation *resultResolved = [self expectationWithDescription:@"Result resolved"];
+    [self.client resolveURL:URL
+                  channelID:@"channelID"
+             triggerContext:[UAScheduleTriggerContext triggerContextWithTrigger:trigger event:@{@"name": @"event"}]
+               tagOverrides:@[]
+         attributeOverrides:attributeOverrides
+          completionHandler:^(UADeferredScheduleResult * _Nullable result, NSError * _Nullable error) {
+        XCTAssertTrue(result.isAudienceMatch);
+        XCTAssertNil(error);
+        [resultResolved fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    [self.mockSession verify];
+}
+
+/**
+ * Test regular results are not reused for a different triggering event.
+ */
+- (void)testResolveURLDoesNotReuseOtherEvents {
+    NSURL *URL = [NSURL URLWithString:@"https://cool.story/neat"];
+    UAScheduleTrigger *trigger = [UAScheduleTrigger foregroundTriggerWithCount:1];
+    UAAttributePendingMutations *attributeOverrides = [UAAttributePendingMutations pendingMutationsWithMutations:[UAAttributeMutations mutations]
+                                                                                                             date:[[UADate alloc] init]];
+
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@""] statusCode:200 HTTPVersion:nil headerFields:nil];
+    NSData *responseData = [NSJSONSerialization dataWithJSONObject:@{@"audience_match": @(YES)} options:0 error:nil];
+
+    [[[self.mockAuthManager stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+
+        void (^handler)(NSString * _Nullable) = (__bridge void (^_Nonnull)(NSString * _Nullable))arg;
+        handler(@"token");
+    }] tokenWithCompletionHandler:OCMOCK_ANY];
+
+    __block NSUInteger requestCount = 0;
+    [[[self.mockSession stub] andDo:^(NSInvocation *invocation) {
+        requestCount++;
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        UARequestCompletionHandler completionHandler = (__bridge UARequestCompletionHandler)arg;
+        completionHandler(responseData, response, nil);
+    }] dataTaskWithRequest:OCMOCK_ANY retryWhere:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    for (NSString *event in @[@"first", @"second", @"first"]) {
+        [self.client resolveURL:URL
+                      channelID:@"channelID"
+                 triggerContext:[UAScheduleTriggerContext triggerContextWithTrigger:trigger event:event]
+                   tagOverrides:@[]
+             attributeOverrides:attributeOverrides
+              completionHandler:^(UADeferredScheduleResult * _Nullable result, NSError * _Nullable error) {}];
+    }
+
+    XCTAssertEqual(2, requestCount);
+}
+
 @end
@@ -0,0 +1,113 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UADispatcher.h"
+
+@interface UADispatcherTest : UABaseTest
+@property (nonatomic, strong) UADispatcher *dispatcher;
+@end
+
+@implementation UADispatcherTest
+
+- (void)setUp {
+    [super setUp];
+    self.dispatcher = [UADispatcher serialDispatcher];
+}
+
+- (void)testDispatchAfterDisposed {
+    UADisposable *disposable = [self.dispatcher dispatchAfter:0.1 block:^{
+        XCTFail(@"Disposed block should not run");
+    }];
+    [disposable dispose];
+
+    XCTestExpectation *finished = [self expectationWithDescription:@"finished"];
+    [self.dispatcher dispatchAfter:0.2 block:^{
+        [finished fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
+- (void)testCoalescedDispatchRunsLatestBlock {
+    NSMutableArray *values = [NSMutableArray array];
+    XCTestExpectation *finished = [self expectationWithDescription:@"finished"];
+
+    // Hold the queue so all three dispatches are pending at once
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    [self.dispatcher dispatchAsync:^{
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+    }];
+
+    for (NSUInteger i = 0; i < 3; i++) {
+        [self.dispatcher dispatchAsync:^{
+            [values addObject:@(i)];
+        } coalescingKey:@"key"];
+    }
+
+    dispatch_semaphore_signal(semaphore);
+
+    [self.dispatcher dispatchAsync:^{
+        [finished fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    XCTAssertEqualObjects(@[@(2)], values);
+}
+
+- (void)testWorkTypeQualityOfService {
+    NSQualityOfService previous = [UADispatcher qualityOfServiceForWorkType:UADispatcherWorkTypeUpload];
+
+    [UADispatcher setQualityOfService:NSQualityOfServiceBackground forWorkType:UADispatcherWorkTypeUpload];
+    XCTAssertEqual(NSQualityOfServiceBackground, [UADispatcher qualityOfServiceForWorkType:UADispatcherWorkTypeUpload]);
+    XCTAssertEqual(QOS_CLASS_BACKGROUND, [UADispatcher qosClassForWorkType:UADispatcherWorkTypeUpload]);
+    XCTAssertEqual([UADispatcher globalDispatcher:QOS_CLASS_BACKGROUND], [UADispatcher globalDispatcherForWorkType:UADispatcherWorkTypeUpload]);
+
+    [UADispatcher setQualityOfService:previous forWorkType:UADispatcherWorkTypeUpload];
+}
+
+- (void)testDispatchWithWorkType {
+    XCTestExpectation *ran = [self expectationWithDescription:@"ran"];
+    [self.dispatcher dispatchAsync:^{
+        XCTAssertEqual(QOS_CLASS_BACKGROUND, qos_class_self());
+        [ran fulfill];
+    } workType:UADispatcherWorkTypeMaintenance];
+
+    [self waitForTestExpectations];
+}
+
+- (void)testTimerReschedule {
+    __block NSUInteger fireCount = 0;
+    XCTestExpectation *fired = [self expectationWithDescription:@"fired"];
+
+    UADispatchTimer *timer = [self.dispatcher timerWithBlock:^{
+        fireCount++;
+        [fired fulfill];
+    }];
+
+    [timer scheduleWithDelay:10];
+    XCTAssertTrue([timer scheduleIfEarlierWithDelay:0.1]);
+    XCTAssertFalse([timer scheduleIfEarlierWithDelay:5]);
+
+    [self waitForTestExpectations];
+    XCTAssertEqual(1, fireCount);
+    XCTAssertNil(timer.fireDate);
+}
+
+- (void)testTimerCancel {
+    UADispatchTimer *timer = [self.dispatcher timerWithBlock:^{
+        XCTFail(@"Cancelled timer should not fire");
+    }];
+
+    [timer scheduleWithDelay:0.1];
+    [timer cancel];
+    XCTAssertNil(timer.fireDate);
+
+    XCTestExpectation *finished = [self expectationWithDescription:@"finished"];
+    [self.dispatcher dispatchAfter:0.2 block:^{
+        [finished fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
+@end
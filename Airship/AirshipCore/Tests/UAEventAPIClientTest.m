@@ -2,6 +2,7 @@
 
 #import "UAAirshipBaseTest.h"
 #import "UAEventAPIClient+Internal.h"
+#import "UARequest+Internal.h"
 #import "UARuntimeConfig.h"
 #import "UAirship+Internal.h"
 #import "UAPush+Internal.h"
@@ -48,7 +49,7 @@
         }
 
         // check the body is set
-        if (!request.body.length) {
+        if (![request bodyStream]) {
             return NO;
         }
 
@@ -70,6 +71,32 @@
 }
 
 
+/**
+ * Test the request body is the payloads joined into a JSON array.
+ */
+- (void)testUploadEventPayloadsBody {
+    NSArray<NSData *> *payloads = @[[@"{\"event_id\":\"one\"}" dataUsingEncoding:NSUTF8StringEncoding],
+                                    [@"{\"event_id\":\"two\"}" dataUsingEncoding:NSUTF8StringEncoding]];
+
+    UARequest *expected = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.compressBody = YES;
+        builder.body = [@"[{\"event_id\":\"one\"},{\"event_id\":\"two\"}]" dataUsingEncoding:NSUTF8StringEncoding];
+    }];
+
+    BOOL (^checkRequestBlock)(id obj) = ^(id obj) {
+        UARequest *request = obj;
+        return [[self readStream:[request bodyStream]] isEqualToData:expected.body];
+    };
+
+    [(UARequestSession *)[self.mockSession expect] dataTaskWithRequest:[OCMArg checkWithBlock:checkRequestBlock]
+                                                     completionHandler:OCMOCK_ANY];
+
+    [self.client uploadEventPayloads:payloads headers:@{}
+                   completionHandler:^(NSDictionary *responseHeaders, NSError *error) {}];
+
+    [self.mockSession verify];
+}
+
 /**
  * Test that a successful event upload passes the response headers with no errors
  */
@@ -154,4 +181,18 @@
     [self waitForTestExpectations];
 }
 
+- (NSData *)readStream:(NSInputStream *)stream {
+    NSMutableData *data = [NSMutableData data];
+    uint8_t buffer[1024];
+
+    [stream open];
+    NSInteger read;
+    while ((read = [stream read:buffer maxLength:sizeof(buffer)]) > 0) {
+        [data appendBytes:buffer length:(NSUInteger)read];
+    }
+    [stream close];
+
+    return data;
+}
+
 @end
@@ -0,0 +1,68 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAEventLimiter+Internal.h"
+#import "UACustomEvent.h"
+#import "UARegionEvent.h"
+#import "UATestDate.h"
+
+@interface UAEventLimiterTest : UABaseTest
+@property (nonatomic, strong) UAEventLimiter *limiter;
+@property (nonatomic, strong) UATestDate *testDate;
+@end
+
+@implementation UAEventLimiterTest
+
+- (void)setUp {
+    [super setUp];
+    self.testDate = [[UATestDate alloc] initWithAbsoluteTime:[NSDate dateWithTimeIntervalSince1970:0]];
+    self.limiter = [UAEventLimiter limiterWithDate:self.testDate];
+}
+
+- (void)testNoRules {
+    UACustomEvent *event = [UACustomEvent eventWithName:@"event"];
+    for (NSUInteger i = 0; i < 100; i++) {
+        XCTAssertTrue([self.limiter acceptEvent:event]);
+    }
+}
+
+- (void)testRateLimit {
+    [self.limiter applyRulesFromJSON:@{@"enhanced_custom_event": @{@"rate": @(1), @"burst": @(2)}}];
+    UACustomEvent *event = [UACustomEvent eventWithName:@"event"];
+
+    // Burst
+    XCTAssertTrue([self.limiter acceptEvent:event]);
+    XCTAssertTrue([self.limiter acceptEvent:event]);
+    XCTAssertFalse([self.limiter acceptEvent:event]);
+
+    // Refills at the rate
+    self.testDate.absoluteTime = [NSDate dateWithTimeIntervalSince1970:1];
+    XCTAssertTrue([self.limiter acceptEvent:event]);
+    XCTAssertFalse([self.limiter acceptEvent:event]);
+
+    // Reapplying the rules keeps the bucket
+    [self.limiter applyRulesFromJSON:@{@"enhanced_custom_event": @{@"rate": @(1), @"burst": @(2)}}];
+    XCTAssertFalse([self.limiter acceptEvent:event]);
+
+    // Other event types are not limited
+    UARegionEvent *regionEvent = [UARegionEvent regionEventWithRegionID:@"region" source:@"source" boundaryEvent:UABoundaryEventEnter];
+    XCTAssertTrue([self.limiter acceptEvent:regionEvent]);
+}
+
+- (void)testSampling {
+    [self.limiter applyRulesFromJSON:@{@"enhanced_custom_event": @{@"sample_rate": @(0)}}];
+    XCTAssertFalse([self.limiter acceptEvent:[UACustomEvent eventWithName:@"event"]]);
+
+    [self.limiter applyRulesFromJSON:@{@"enhanced_custom_event": @{@"sample_rate": @(1)}}];
+    XCTAssertTrue([self.limiter acceptEvent:[UACustomEvent eventWithName:@"event"]]);
+}
+
+- (void)testInvalidRules {
+    [self.limiter applyRulesFromJSON:@{@"enhanced_custom_event": @{@"rate": @"fast"}}];
+    XCTAssertTrue([self.limiter acceptEvent:[UACustomEvent eventWithName:@"event"]]);
+
+    [self.limiter applyRulesFromJSON:@[]];
+    XCTAssertTrue([self.limiter acceptEvent:[UACustomEvent eventWithName:@"event"]]);
+}
+
+@end
@@ -8,26 +8,13 @@
 #import "UAPreferenceDataStore+Internal.h"
 #import "UARuntimeConfig.h"
 #import "UACustomEvent.h"
-#import "NSOperationQueue+UAAdditions.h"
+#import "UATaskQueue.h"
 #import "UARegionEvent.h"
-#import "UAAsyncOperation.h"
 #import "UAirship+Internal.h"
 #import "UAChannel.h"
 #import "UAAppStateTracker.h"
-
-/**
- * Test event data class to work around not being able to mock UAEventData
- */
-@interface UAEventTestData : NSObject
-@property (nullable, nonatomic, copy) NSString *sessionID;
-@property (nullable, nonatomic, copy) NSData *data;
-@property (nullable, nonatomic, copy) NSString *time;
-@property (nullable, nonatomic, copy) NSString *type;
-@property (nullable, nonatomic, copy) NSString *identifier;
-@end
-
-@implementation UAEventTestData
-@end
+#import "UANetworkMonitor.h"
+#import "UAExtensionEventJournal+Internal.h"
 
 @interface UAEventManagerTest : UAAirshipBaseTest
 @property (nonatomic, strong) UAEventManager *eventManager;
@@ -40,6 +27,8 @@
 @property (nonatomic, strong) id mockAirship;
 @property (nonatomic, strong) id mockChannel;
 @property (nonatomic, strong) id mockDelegate;
+@property (nonatomic, strong) id mockNetworkMonitor;
+@property (atomic, assign) BOOL connected;
 
 @end
 
@@ -50,7 +39,7 @@
 
     self.mockClient = [self mockForClass:[UAEventAPIClient class]];
     self.mockStore = [self mockForClass:[UAEventStore class]];
-    self.mockQueue = [self mockForClass:[NSOperationQueue class]];
+    self.mockQueue = [self mockForClass:[UATaskQueue class]];
 
     self.mockChannel = [self mockForClass:[UAChannel class]];
 
@@ -61,6 +50,13 @@
     // Set up a mocked application
     self.mockAppStateTracker = [self mockForClass:[UAAppStateTracker class]];
 
+    self.connected = YES;
+    self.mockNetworkMonitor = [self mockForClass:[UANetworkMonitor class]];
+    [[[self.mockNetworkMonitor stub] andDo:^(NSInvocation *invocation) {
+        BOOL connected = self.connected;
+        [invocation setReturnValue:&connected];
+    }] isConnected];
+
     self.notificationCenter = [[NSNotificationCenter alloc] init];
     self.eventManager = [UAEventManager eventManagerWithConfig:self.config
                                                      dataStore:self.dataStore
@@ -69,7 +65,8 @@
                                                         client:self.mockClient
                                                          queue:self.mockQueue
                                             notificationCenter:self.notificationCenter
-                                               appStateTracker:self.mockAppStateTracker];
+                                               appStateTracker:self.mockAppStateTracker
+                                                networkMonitor:self.mockNetworkMonitor];
 
     self.mockDelegate = [self mockForProtocol:@protocol(UAEventManagerDelegate)];
     self.eventManager.delegate = self.mockDelegate;
@@ -105,7 +102,7 @@
         BOOL result = YES;
         [invocation setReturnValue:&result];
 
-    }] ignoringNonObjectArgs] addBackgroundOperation:OCMOCK_ANY delay:0];
+    }] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
 
 
     [[self.mockStore expect] saveEvent:event sessionID:@"story"];
@@ -131,7 +128,7 @@
     self.eventManager.uploadsEnabled = NO;
 
     // expectations
-    [[[self.mockQueue reject] ignoringNonObjectArgs] addBackgroundOperation:OCMOCK_ANY delay:0];
+    [[[self.mockQueue reject] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
 
     UACustomEvent *event = [UACustomEvent eventWithName:@"cool"];
 
@@ -145,6 +142,60 @@
     [self.mockQueue verify];
 }
 
+/**
+ * Test adding a batch of events writes them in one flush.
+ */
+- (void)testAddEvents {
+    self.eventManager.uploadsEnabled = NO;
+
+    UACustomEvent *first = [UACustomEvent eventWithName:@"first"];
+    UACustomEvent *second = [UACustomEvent eventWithName:@"second"];
+
+    [[self.mockStore expect] saveEvent:first sessionID:@"story"];
+    [[self.mockStore expect] saveEvent:second sessionID:@"story"];
+    [[self.mockStore expect] savePendingEvents];
+
+    [self.eventManager addEvents:@[first, second] sessionID:@"story"];
+
+    [self.mockStore verify];
+}
+
+/**
+ * Test events recorded by the extensions are added to the store without a session.
+ */
+- (void)testIngestExtensionEvents {
+    UACustomEvent *event = [UACustomEvent eventWithName:@"extension"];
+    id mockJournal = [self mockForClass:[UAExtensionEventJournal class]];
+    [[[mockJournal expect] andReturn:@[event]] collectEvents];
+    self.eventManager.eventJournal = mockJournal;
+
+    [[self.mockStore expect] saveEvent:event sessionID:nil];
+    [[self.mockStore expect] savePendingEvents];
+
+    [self.eventManager ingestExtensionEvents];
+
+    [mockJournal verify];
+    [self.mockStore verify];
+}
+
+/**
+ * Test events recorded by the extensions are discarded when uploads are disabled.
+ */
+- (void)testIngestExtensionEventsUploadsDisabled {
+    self.eventManager.uploadsEnabled = NO;
+
+    id mockJournal = [self mockForClass:[UAExtensionEventJournal class]];
+    [[[mockJournal expect] andReturn:@[[UACustomEvent eventWithName:@"extension"]]] collectEvents];
+    self.eventManager.eventJournal = mockJournal;
+
+    [[self.mockStore reject] saveEvent:OCMOCK_ANY sessionID:nil];
+
+    [self.eventManager ingestExtensionEvents];
+
+    [mockJournal verify];
+    [self.mockStore verify];
+}
+
 /**
  * Test adding an event in the background defaults to 5 second delay.
  */
@@ -167,7 +218,7 @@
         BOOL result = YES;
         [invocation setReturnValue:&result];
 
-    }] ignoringNonObjectArgs] addBackgroundOperation:OCMOCK_ANY delay:0];
+    }] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
 
 
     [[self.mockStore expect] saveEvent:event sessionID:@"story"];
@@ -196,7 +247,7 @@
     // expectations
     UACustomEvent *event = [UACustomEvent eventWithName:@"cool"];
 
-    [[[self.mockQueue reject] ignoringNonObjectArgs] addBackgroundOperation:OCMOCK_ANY delay:0];
+    [[[self.mockQueue reject] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
 
     [[self.mockStore expect] saveEvent:event sessionID:@"story"];
 
@@ -225,7 +276,7 @@
         BOOL result = YES;
         [invocation setReturnValue:&result];
 
-    }] ignoringNonObjectArgs] addBackgroundOperation:OCMOCK_ANY delay:0];
+    }] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
 
 
     [[self.mockStore expect] saveEvent:event sessionID:@"story"];
@@ -256,7 +307,7 @@
         BOOL result = YES;
         [invocation setReturnValue:&result];
 
-    }] ignoringNonObjectArgs] addBackgroundOperation:OCMOCK_ANY delay:0];
+    }] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
 
     [self.notificationCenter postNotificationName:UAApplicationDidEnterBackgroundNotification object:nil];
 
@@ -274,7 +325,7 @@
     self.eventManager.uploadsEnabled = NO;
 
     // expectations
-    [[[self.mockQueue reject] ignoringNonObjectArgs] addBackgroundOperation:OCMOCK_ANY delay:0];
+    [[[self.mockQueue reject] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
 
     [self.notificationCenter postNotificationName:UAApplicationDidEnterBackgroundNotification
                                            object:nil];
@@ -298,7 +349,7 @@
         BOOL result = YES;
         [invocation setReturnValue:&result];
 
-    }] ignoringNonObjectArgs] addBackgroundOperation:OCMOCK_ANY delay:0];
+    }] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
 
     [self.notificationCenter postNotificationName:UAChannelCreatedEvent
                                            object:nil];
@@ -310,14 +361,14 @@
 }
 
 /**
- * Test scheduling an upload with an earlier time will cancel the current operations.
+ * Test scheduling an upload with an earlier time will cancel the current tasks.
  */
 - (void)testRescheduleUpload {
     // Add a normal priority event (delay 15ish seconds)
     [self testAddEvent];
 
     // Make sure it cancels the previous attempt
-    [[self.mockQueue expect] cancelAllOperations];
+    [[self.mockQueue expect] cancelAllTasks];
 
     // Add a high priority event (delay 5ish seconds)
     [self testAddHighPriorityEvent];
@@ -334,27 +385,27 @@
 
     XCTestExpectation *expectation = [self expectationWithDescription:@"Wait for async"];
 
-    // Run the operation as when added
+    // Run the task as when added
     [[[[self.mockQueue expect] andDo:^(NSInvocation *invocation) {
-        // Start the operation
-        __weak NSOperation *operation = nil;
-        [invocation getArgument:&operation atIndex:2];
-        [operation start];
+        // Start the task
+        __weak UATask *task = nil;
+        [invocation getArgument:&task atIndex:2];
+        [task start];
 
         [expectation fulfill];
 
         BOOL result = YES;
         [invocation setReturnValue:&result];
-    }] ignoringNonObjectArgs] addBackgroundOperation:OCMOCK_ANY delay:0];
+    }] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
 
 
     // Set  up a mock event data
-    UAEventTestData *eventData = [[UAEventTestData alloc] init];
-    eventData.type = @"mock_event";
-    eventData.time = @"100";
-    eventData.identifier = @"mock_event_id";
-    eventData.sessionID = @"mock_event_session";
-    eventData.data = [NSJSONSerialization dataWithJSONObject:@{@"cool": @"story"} options:0 error:nil];
+    NSData *payload = [NSJSONSerialization dataWithJSONObject:@{@"event_id": @"mock_event_id"} options:0 error:nil];
+    UAEventData *eventData = [UAEventData eventDataWithStoreID:10
+                                                    identifier:@"mock_event_id"
+                                                     sessionID:@"mock_event_session"
+                                                       payload:payload
+                                                         bytes:payload.length];
 
     // Stub the event store to return the data
     [[[[self.mockStore expect] andDo:^(NSInvocation *invocation) {
@@ -378,41 +429,84 @@
         // Return a successful response
         returnBlock(@{@"foo" : @"bar"}, nil);
         [clientCalled fulfill];
-    }] uploadEvents:[OCMArg checkWithBlock:^BOOL(id obj) {
-        NSArray *events = (NSArray *)obj;
-        if (events.count != 1) {
-            return NO;
-        }
+    }] uploadEventPayloads:@[payload] headers:headers completionHandler:OCMOCK_ANY];
+
+    // Expect the store to delete the batch
+    [[self.mockStore expect] deleteEventsUpToStoreID:10];
+
+    // Start the upload
+    [self.eventManager scheduleUpload];
 
-        if (![events[0][@"event_id"] isEqualToString:@"mock_event_id"]) {
-            return NO;
-        }
+    [self waitForTestExpectations];
 
-        if (![events[0][@"time"] isEqualToString:@"100"]) {
-            return NO;
-        }
+    [self.mockQueue verify];
+    [self.mockClient verify];
+    [self.mockStore verify];
+}
 
-        if (![events[0][@"type"] isEqualToString:@"mock_event"]) {
-            return NO;
-        }
+/**
+ * Test a large backlog is drained with back to back uploads when the server allows it.
+ */
+- (void)testUploadDrainsBacklog {
+    [[[self.mockChannel stub] andReturn:@"channel ID"] identifier];
+    [self.dataStore setInteger:1 forKey:kMaxDrainBatchesUserDefaultsKey];
+    [[[self.mockStore stub] andReturnValue:OCMOCK_VALUE((NSUInteger)kMaxTotalDBSizeBytes)] storeSize];
+    [[[self.mockDelegate stub] andReturn:@{}] analyticsHeaders];
 
-        NSDictionary *expectedData = @{@"cool": @"story", @"session_id": @"mock_event_session"};
-        if (![events[0][@"data"] isEqual:expectedData]) {
-            return NO;
-        }
+    [[[[self.mockQueue expect] andDo:^(NSInvocation *invocation) {
+        __weak UATask *task = nil;
+        [invocation getArgument:&task atIndex:2];
+        [task start];
 
-        return YES;
-    }] headers:headers completionHandler:OCMOCK_ANY];
+        BOOL result = YES;
+        [invocation setReturnValue:&result];
+    }] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
 
-    // Expect the store to delete the event
-    [[self.mockStore expect] deleteEventsWithIDs:@[@"mock_event_id"]];
+    NSData *firstPayload = [NSJSONSerialization dataWithJSONObject:@{@"event_id": @"first"} options:0 error:nil];
+    UAEventData *first = [UAEventData eventDataWithStoreID:10 identifier:@"first" sessionID:@"session" payload:firstPayload bytes:firstPayload.length];
+
+    NSData *secondPayload = [NSJSONSerialization dataWithJSONObject:@{@"event_id": @"second"} options:0 error:nil];
+    UAEventData *second = [UAEventData eventDataWithStoreID:20 identifier:@"second" sessionID:@"session" payload:secondPayload bytes:secondPayload.length];
+
+    [[[[self.mockStore expect] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:3];
+        void (^returnBlock)(NSArray *result)= (__bridge void (^)(NSArray *))arg;
+        returnBlock(@[first]);
+    }] ignoringNonObjectArgs] fetchEventsWithMaxBatchSize:0 completionHandler:OCMOCK_ANY];
+
+    // The next batch is read after the first batch
+    [[[[self.mockStore expect] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        void (^returnBlock)(NSArray *result)= (__bridge void (^)(NSArray *))arg;
+        returnBlock(@[second]);
+    }] ignoringNonObjectArgs] fetchEventsWithMaxBatchSize:0 afterStoreID:10 completionHandler:OCMOCK_ANY];
+
+    XCTestExpectation *secondUploaded = [self expectationWithDescription:@"second batch uploaded"];
+
+    [[[self.mockClient expect] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        void (^returnBlock)(NSDictionary *, NSError *)= (__bridge void (^)(NSDictionary *, NSError *))arg;
+        returnBlock(@{@"X-UA-Max-Drain-Batches" : @"1"}, nil);
+    }] uploadEventPayloads:@[firstPayload] headers:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    [[[self.mockClient expect] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        void (^returnBlock)(NSDictionary *, NSError *)= (__bridge void (^)(NSDictionary *, NSError *))arg;
+        returnBlock(@{@"X-UA-Max-Drain-Batches" : @"1"}, nil);
+        [secondUploaded fulfill];
+    }] uploadEventPayloads:@[secondPayload] headers:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    [[self.mockStore expect] deleteEventsUpToStoreID:10];
+    [[self.mockStore expect] deleteEventsUpToStoreID:20];
 
-    // Start the upload
     [self.eventManager scheduleUpload];
 
     [self waitForTestExpectations];
 
-    [self.mockQueue verify];
     [self.mockClient verify];
     [self.mockStore verify];
 }
@@ -428,14 +522,14 @@
     [[[self.mockChannel stub] andReturn:@"channel ID"] identifier];
 
     // expectations
-    // Run the operation as when added
-    [[[self.mockQueue reject] ignoringNonObjectArgs] addBackgroundOperation:OCMOCK_ANY delay:0];
+    // Run the task as when added
+    [[[self.mockQueue reject] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
 
     // Reject any calls to the store
     [[[self.mockStore reject] ignoringNonObjectArgs] fetchEventsWithMaxBatchSize:0 completionHandler:OCMOCK_ANY];
 
     // Reject any calls to the client
-    [[self.mockClient reject] uploadEvents:OCMOCK_ANY headers:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    [[self.mockClient reject] uploadEventPayloads:OCMOCK_ANY headers:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
     // test
     [self.eventManager scheduleUpload];
@@ -457,14 +551,14 @@
 
     // Initial request
     [[[[self.mockQueue expect] andDo:^(NSInvocation *invocation) {
-        // Start the operation
-        __weak NSOperation *operation = nil;
-        [invocation getArgument:&operation atIndex:2];
-        [operation start];
+        // Start the task
+        __weak UATask *task = nil;
+        [invocation getArgument:&task atIndex:2];
+        [task start];
 
         BOOL result = YES;
         [invocation setReturnValue:&result];
-    }] ignoringNonObjectArgs] addBackgroundOperation:OCMOCK_ANY delay:0];
+    }] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
 
 
     // Retry request
@@ -476,16 +570,16 @@
 
         BOOL result = YES;
         [invocation setReturnValue:&result];
-    }] ignoringNonObjectArgs] addBackgroundOperation:OCMOCK_ANY delay:0];
+    }] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
 
 
     // Set  up a mock event data
-    UAEventTestData *eventData = [[UAEventTestData alloc] init];
-    eventData.type = @"mock_event";
-    eventData.time = @"100";
-    eventData.identifier = @"mock_event_id";
-    eventData.sessionID = @"mock_event_session";
-    eventData.data = [NSJSONSerialization dataWithJSONObject:@{@"cool": @"story"} options:0 error:nil];
+    NSData *payload = [NSJSONSerialization dataWithJSONObject:@{@"event_id": @"mock_event_id"} options:0 error:nil];
+    UAEventData *eventData = [UAEventData eventDataWithStoreID:10
+                                                    identifier:@"mock_event_id"
+                                                     sessionID:@"mock_event_session"
+                                                       payload:payload
+                                                         bytes:payload.length];
 
     // Stub the event store to return the data
     [[[[self.mockStore expect] andDo:^(NSInvocation *invocation) {
@@ -504,10 +598,10 @@
 
         // Return an error
         returnBlock(nil, [NSError errorWithDomain:NSCocoaErrorDomain code:0 userInfo:@{}]);
-    }] uploadEvents:OCMOCK_ANY headers:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    }] uploadEventPayloads:OCMOCK_ANY headers:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
     // Expect the store to delete the event
-    [[self.mockStore reject] deleteEventsWithIDs:OCMOCK_ANY];
+    [[[self.mockStore reject] ignoringNonObjectArgs] deleteEventsUpToStoreID:0];
 
     // Start the upload
     [self.eventManager scheduleUpload];
@@ -532,23 +626,23 @@
     XCTestExpectation *expectation = [self expectationWithDescription:@"Wait for async"];
 
 
-    // Run the operation as when added
+    // Run the task as when added
     [[[[self.mockQueue expect] andDo:^(NSInvocation *invocation) {
-        // Start the operation
-        __weak NSOperation *operation = nil;
-        [invocation getArgument:&operation atIndex:2];
-        [operation start];
+        // Start the task
+        __weak UATask *task = nil;
+        [invocation getArgument:&task atIndex:2];
+        [task start];
 
         [expectation fulfill];
 
         BOOL result = YES;
         [invocation setReturnValue:&result];
-    }] ignoringNonObjectArgs] addBackgroundOperation:OCMOCK_ANY delay:0];
+    }] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
 
 
     // Reject store and client calls
     [[[self.mockStore reject] ignoringNonObjectArgs] fetchEventsWithMaxBatchSize:0 completionHandler:OCMOCK_ANY];
-    [[self.mockClient reject] uploadEvents:OCMOCK_ANY headers:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    [[self.mockClient reject] uploadEventPayloads:OCMOCK_ANY headers:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
     // Start the upload
     [self.eventManager scheduleUpload];
@@ -560,15 +654,131 @@
     [self.mockStore verify];
 }
 
+/**
+ * Test uploads are held while offline and resume once connectivity is restored, and the store
+ * is trimmed in the meantime.
+ */
+- (void)testUploadHeldWhileOffline {
+    [[[self.mockChannel stub] andReturn:@"channel ID"] identifier];
+    self.connected = NO;
+
+    XCTestExpectation *held = [self expectationWithDescription:@"Upload held"];
+    [[[[self.mockQueue expect] andDo:^(NSInvocation *invocation) {
+        __weak UATask *task = nil;
+        [invocation getArgument:&task atIndex:2];
+        [task start];
+
+        [held fulfill];
+
+        BOOL result = YES;
+        [invocation setReturnValue:&result];
+    }] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
+
+    [[[self.mockStore reject] ignoringNonObjectArgs] fetchEventsWithMaxBatchSize:0 completionHandler:OCMOCK_ANY];
+
+    // The store is still trimmed while uploads are held
+    [[[self.mockStore expect] ignoringNonObjectArgs] trimEventsToStoreSize:0];
+
+    [self.eventManager scheduleUpload];
+    [self waitForTestExpectations];
+    [self.mockQueue verify];
+
+    // Restoring connectivity schedules the upload again
+    XCTestExpectation *resumed = [self expectationWithDescription:@"Upload resumed"];
+    [[[[self.mockQueue expect] andDo:^(NSInvocation *invocation) {
+        [resumed fulfill];
+
+        BOOL result = YES;
+        [invocation setReturnValue:&result];
+    }] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
+
+    self.connected = YES;
+    [self.notificationCenter postNotificationName:UANetworkConnectivityChangedEvent object:nil];
+
+    [self waitForTestExpectations];
+    [self.mockQueue verify];
+    [self.mockStore verify];
+}
+
+/**
+ * Test uploads are deferred in Low Data Mode, with an upload scheduled for the maximum deferral.
+ */
+- (void)testUploadDeferredInLowDataMode {
+    [[[self.mockChannel stub] andReturn:@"channel ID"] identifier];
+    [[[self.mockNetworkMonitor stub] andReturnValue:@YES] isConstrained];
+    [[[self.mockStore stub] andReturnValue:@((NSUInteger)100)] storeSize];
+
+    XCTestExpectation *held = [self expectationWithDescription:@"Upload held"];
+    [[[[self.mockQueue expect] andDo:^(NSInvocation *invocation) {
+        __weak UATask *task = nil;
+        [invocation getArgument:&task atIndex:2];
+        [task start];
+
+        [held fulfill];
+
+        BOOL result = YES;
+        [invocation setReturnValue:&result];
+    }] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
+
+    [[[self.mockStore reject] ignoringNonObjectArgs] fetchEventsWithMaxBatchSize:0 completionHandler:OCMOCK_ANY];
+
+    [self.eventManager scheduleUpload];
+    [self waitForTestExpectations];
+    [self.mockQueue verify];
+
+    // The deferred upload is scheduled even though Low Data Mode stays on
+    XCTestExpectation *deferred = [self expectationWithDescription:@"Deferred upload scheduled"];
+    __block NSTimeInterval delay = 0;
+    [[[[self.mockQueue expect] andDo:^(NSInvocation *invocation) {
+        [invocation getArgument:&delay atIndex:3];
+        [deferred fulfill];
+
+        BOOL result = YES;
+        [invocation setReturnValue:&result];
+    }] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
+
+    [self waitForTestExpectations];
+    XCTAssertEqualWithAccuracy(3600, delay, 1);
+    [self.mockStore verify];
+}
+
+/**
+ * Test a full batch is uploaded in Low Data Mode.
+ */
+- (void)testFullBatchUploadsInLowDataMode {
+    [[[self.mockChannel stub] andReturn:@"channel ID"] identifier];
+    [[[self.mockNetworkMonitor stub] andReturnValue:@YES] isConstrained];
+    [[[self.mockStore stub] andReturnValue:@(NSUIntegerMax)] storeSize];
+
+    [[[[self.mockQueue stub] andDo:^(NSInvocation *invocation) {
+        __weak UATask *task = nil;
+        [invocation getArgument:&task atIndex:2];
+        [task start];
+
+        BOOL result = YES;
+        [invocation setReturnValue:&result];
+    }] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"Events fetched"];
+    [[[[self.mockStore expect] andDo:^(NSInvocation *invocation) {
+        [fetched fulfill];
+    }] ignoringNonObjectArgs] fetchEventsWithMaxBatchSize:0 completionHandler:OCMOCK_ANY];
+
+    [self.eventManager scheduleUpload];
+
+    [self waitForTestExpectations];
+    [self.mockStore verify];
+}
+
 - (void)testEnableSchedulesUploadWhenCurrentlyDisabled {
     // setup
     self.eventManager.uploadsEnabled = NO;
 
     // expectations
-    XCTestExpectation *expectUpload = [self expectationWithDescription:@"Expect upload via [self.queue addBackgroundOperation:delay:]"];
+    XCTestExpectation *expectUpload = [self expectationWithDescription:@"Expect upload via [self.queue addBackgroundTask:delay:]"];
     [[[[self.mockQueue expect] andDo:^(NSInvocation *invocation) {
         [expectUpload fulfill];
-    }] ignoringNonObjectArgs] addBackgroundOperation:OCMOCK_ANY delay:0];
+    }] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
 
     // test
     self.eventManager.uploadsEnabled = YES;
@@ -583,10 +793,10 @@
     self.eventManager.uploadsEnabled = YES;
 
     // expectations
-    XCTestExpectation *expectCancel = [self expectationWithDescription:@"Expect cancel via [self.queue addBackgroundOperation:delay:]"];
+    XCTestExpectation *expectCancel = [self expectationWithDescription:@"Expect cancel via [self.queue addBackgroundTask:delay:]"];
     [[[self.mockQueue expect] andDo:^(NSInvocation *invocation) {
         [expectCancel fulfill];
-    }] cancelAllOperations];
+    }] cancelAllTasks];
 
     // test
     self.eventManager.uploadsEnabled = NO;
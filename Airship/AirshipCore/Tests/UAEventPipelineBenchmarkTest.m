@@ -0,0 +1,381 @@
+/* Copyright Airship and Contributors */
+
+#import <QuartzCore/QuartzCore.h>
+
+#import "UABenchmarkTest.h"
+#import "UAEventStore+Internal.h"
+#import "UAEventManager+Internal.h"
+#import "UAEventAPIClient+Internal.h"
+#import "UACustomEvent.h"
+#import "UARegionEvent.h"
+#import "UAScreenTrackingEvent+Internal.h"
+#import "UAAppStateTracker.h"
+#import "UATaskQueue.h"
+#import "UAChannel.h"
+#import "UANetworkMonitor.h"
+
+/**
+ * Benchmarks for the analytics pipeline: saving events to the event store, reading upload batches,
+ * trimming, and the event manager preparing and uploading batches to a mocked API client.
+ *
+ * Each benchmark uses a synthetic mix of custom events with properties, screen tracking events and
+ * region events. Besides the clock, CPU, peak memory and storage metrics, the throughput and the
+ * p50 / p99 latencies are attached to the results.
+ */
+@interface UAEventPipelineBenchmarkTest : UABenchmarkTest
+@property (nonatomic, strong) UAEventStore *eventStore;
+@property (nonatomic, assign) NSUInteger uploadedEvents;
+@property (nonatomic, assign) NSUInteger uploadedBatches;
+@end
+
+@implementation UAEventPipelineBenchmarkTest
+
+- (void)setUp {
+    [super setUp];
+    self.eventStore = [UAEventStore eventStoreWithConfig:self.config];
+}
+
+- (void)tearDown {
+    [self.eventStore deleteAllEvents];
+    [self.eventStore waitForIdle];
+    [super tearDown];
+}
+
+- (void)testSave1kEvents {
+    [self measureSaveWithEventCount:1000];
+}
+
+- (void)testSave10kEvents {
+    [self measureSaveWithEventCount:10000];
+}
+
+- (void)testSave50kEvents {
+    [self measureSaveWithEventCount:50000];
+}
+
+- (void)testFetch1kEvents {
+    [self measureFetchWithEventCount:1000];
+}
+
+- (void)testFetch10kEvents {
+    [self measureFetchWithEventCount:10000];
+}
+
+- (void)testFetch50kEvents {
+    [self measureFetchWithEventCount:50000];
+}
+
+- (void)testTrim1kEvents {
+    [self measureTrimWithEventCount:1000];
+}
+
+- (void)testTrim10kEvents {
+    [self measureTrimWithEventCount:10000];
+}
+
+- (void)testTrim50kEvents {
+    [self measureTrimWithEventCount:50000];
+}
+
+- (void)testUpload1kEvents {
+    [self measureUploadWithEventCount:1000];
+}
+
+- (void)testUpload10kEvents {
+    [self measureUploadWithEventCount:10000];
+}
+
+- (void)testUpload50kEvents {
+    [self measureUploadWithEventCount:50000];
+}
+
+#pragma mark -
+#pragma mark Benchmarks
+
+- (void)measureSaveWithEventCount:(NSUInteger)eventCount {
+    if (@available(iOS 13.0, tvOS 13.0, *)) {
+        NSArray<UAEvent *> *events = [self eventMixWithCount:eventCount];
+        double *latencies = malloc(eventCount * sizeof(double));
+        __block NSTimeInterval elapsed = 0;
+        __block NSUInteger iterations = 0;
+
+        [self measureWithMetrics:self.benchmarkMetrics options:self.manualMeasureOptions block:^{
+            [self.eventStore deleteAllEvents];
+            [self.eventStore waitForIdle];
+
+            [self startMeasuring];
+            CFTimeInterval start = CACurrentMediaTime();
+            for (NSUInteger i = 0; i < eventCount; i++) {
+                CFTimeInterval eventStart = CACurrentMediaTime();
+                [self.eventStore saveEvent:events[i] sessionID:@"benchmark"];
+                latencies[i] = CACurrentMediaTime() - eventStart;
+            }
+
+            [self.eventStore savePendingEvents];
+            [self.eventStore waitForIdle];
+            elapsed += CACurrentMediaTime() - start;
+            iterations++;
+            [self stopMeasuring];
+        }];
+
+        [self attachSummaryWithName:@"Save"
+                            summary:[self summaryWithEventCount:eventCount * iterations
+                                                        elapsed:elapsed
+                                                      latencies:latencies
+                                                          count:eventCount
+                                                   latencyLabel:@"saveEvent:"]];
+        free(latencies);
+    }
+}
+
+- (void)measureFetchWithEventCount:(NSUInteger)eventCount {
+    if (@available(iOS 13.0, tvOS 13.0, *)) {
+        [self fillStoreWithEventCount:eventCount];
+
+        double *latencies = malloc(eventCount * sizeof(double));
+        __block NSUInteger latencyCount = 0;
+        __block NSTimeInterval elapsed = 0;
+        __block NSUInteger fetched = 0;
+
+        [self measureWithMetrics:self.benchmarkMetrics block:^{
+            latencyCount = 0;
+            CFTimeInterval start = CACurrentMediaTime();
+
+            // Walks the whole store in upload sized batches
+            NSUInteger lastStoreID = 0;
+            while (YES) {
+                CFTimeInterval batchStart = CACurrentMediaTime();
+                NSArray<UAEventData *> *batch = [self fetchBatchAfterStoreID:lastStoreID];
+                if (!batch.count) {
+                    break;
+                }
+
+                // Per event latency is the batch read time spread over its events
+                double perEvent = (CACurrentMediaTime() - batchStart) / batch.count;
+                for (NSUInteger i = 0; i < batch.count && latencyCount < eventCount; i++) {
+                    latencies[latencyCount++] = perEvent;
+                }
+
+                fetched += batch.count;
+                lastStoreID = batch.lastObject.storeID;
+            }
+
+            elapsed += CACurrentMediaTime() - start;
+        }];
+
+        [self attachSummaryWithName:@"Fetch"
+                            summary:[self summaryWithEventCount:fetched
+                                                        elapsed:elapsed
+                                                      latencies:latencies
+                                                          count:latencyCount
+                                                   latencyLabel:@"fetch per event"]];
+        free(latencies);
+    }
+}
+
+- (void)measureTrimWithEventCount:(NSUInteger)eventCount {
+    if (@available(iOS 13.0, tvOS 13.0, *)) {
+        __block NSTimeInterval elapsed = 0;
+        __block NSUInteger trimmed = 0;
+
+        [self measureWithMetrics:self.benchmarkMetrics options:self.manualMeasureOptions block:^{
+            [self.eventStore deleteAllEvents];
+            [self fillStoreWithEventCount:eventCount];
+
+            // Trims half of the store, oldest and lowest priority first
+            [self startMeasuring];
+            CFTimeInterval start = CACurrentMediaTime();
+            [self.eventStore trimEventsToStoreSize:self.eventStore.storeSize / 2];
+            [self.eventStore waitForIdle];
+            elapsed += CACurrentMediaTime() - start;
+            trimmed += eventCount / 2;
+            [self stopMeasuring];
+        }];
+
+        [self attachSummaryWithName:@"Trim"
+                            summary:[NSString stringWithFormat:@"%lu events: %.0f events/s trimmed",
+                                     (unsigned long)eventCount,
+                                     elapsed ? trimmed / elapsed : 0]];
+    }
+}
+
+- (void)measureUploadWithEventCount:(NSUInteger)eventCount {
+    if (@available(iOS 13.0, tvOS 13.0, *)) {
+        UAEventManager *eventManager = [self eventManager];
+
+        double *latencies = malloc(eventCount * sizeof(double));
+        __block NSUInteger latencyCount = 0;
+        __block NSTimeInterval elapsed = 0;
+        __block NSUInteger uploaded = 0;
+        __block NSUInteger batches = 0;
+
+        [self measureWithMetrics:self.benchmarkMetrics options:self.manualMeasureOptions block:^{
+            latencyCount = 0;
+            [self.eventStore deleteAllEvents];
+            [self fillStoreWithEventCount:eventCount];
+
+            [self startMeasuring];
+            CFTimeInterval start = CACurrentMediaTime();
+
+            // Each upload drains up to the max drain batches, keep going until the store is empty
+            while (self.eventStore.storeSize) {
+                CFTimeInterval uploadStart = CACurrentMediaTime();
+                NSUInteger uploadedBefore = uploaded;
+
+                dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+                [eventManager uploadEventsWithCompletionHandler:^(BOOL success) {
+                    dispatch_semaphore_signal(semaphore);
+                }];
+                dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+                [self.eventStore waitForIdle];
+
+                @synchronized (self) {
+                    uploaded += self.uploadedEvents;
+                    batches += self.uploadedBatches;
+                    self.uploadedEvents = 0;
+                    self.uploadedBatches = 0;
+                }
+
+                NSUInteger events = uploaded - uploadedBefore;
+                if (!events) {
+                    break;
+                }
+
+                double perEvent = (CACurrentMediaTime() - uploadStart) / events;
+                for (NSUInteger i = 0; i < events && latencyCount < eventCount; i++) {
+                    latencies[latencyCount++] = perEvent;
+                }
+            }
+
+            elapsed += CACurrentMediaTime() - start;
+            [self stopMeasuring];
+        }];
+
+        NSString *summary = [self summaryWithEventCount:uploaded
+                                                elapsed:elapsed
+                                              latencies:latencies
+                                                  count:latencyCount
+                                           latencyLabel:@"upload per event"];
+        [self attachSummaryWithName:@"Upload"
+                            summary:[summary stringByAppendingFormat:@", %lu batches", (unsigned long)batches]];
+        free(latencies);
+    }
+}
+
+#pragma mark -
+#pragma mark Helpers
+
+- (UAEventManager *)eventManager {
+    // Upload the largest batches and drain as much as allowed, like a device with a large backlog
+    [self.dataStore setInteger:kMaxBatchSizeBytes forKey:kMaxBatchSizeUserDefaultsKey];
+    [self.dataStore setInteger:kMaxDrainBatches forKey:kMaxDrainBatchesUserDefaultsKey];
+
+    id mockChannel = [self mockForClass:[UAChannel class]];
+    [[[mockChannel stub] andReturn:@"channel ID"] identifier];
+
+    // Runs the upload task right away instead of in a UIKit background task
+    id mockQueue = [self mockForClass:[UATaskQueue class]];
+    [[[[mockQueue stub] andDo:^(NSInvocation *invocation) {
+        __unsafe_unretained UATask *task = nil;
+        [invocation getArgument:&task atIndex:2];
+        [task start];
+
+        BOOL result = YES;
+        [invocation setReturnValue:&result];
+    }] ignoringNonObjectArgs] addBackgroundTask:OCMOCK_ANY delay:0];
+
+    id mockClient = [self mockForClass:[UAEventAPIClient class]];
+    [[[mockClient stub] andDo:^(NSInvocation *invocation) {
+        __unsafe_unretained NSArray *payloads = nil;
+        [invocation getArgument:&payloads atIndex:2];
+
+        @synchronized (self) {
+            self.uploadedEvents += payloads.count;
+            self.uploadedBatches++;
+        }
+
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        void (^completionHandler)(NSDictionary *, NSError *) = (__bridge void (^)(NSDictionary *, NSError *))arg;
+        completionHandler(@{@"X-UA-Max-Drain-Batches": [@(kMaxDrainBatches) stringValue]}, nil);
+    }] uploadEventPayloads:OCMOCK_ANY headers:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    id mockNetworkMonitor = [self mockForClass:[UANetworkMonitor class]];
+    [[[mockNetworkMonitor stub] andReturnValue:@YES] isConnected];
+
+    return [UAEventManager eventManagerWithConfig:self.config
+                                        dataStore:self.dataStore
+                                          channel:mockChannel
+                                       eventStore:self.eventStore
+                                           client:mockClient
+                                            queue:mockQueue
+                               notificationCenter:[[NSNotificationCenter alloc] init]
+                                  appStateTracker:[self mockForClass:[UAAppStateTracker class]]
+                                   networkMonitor:mockNetworkMonitor];
+}
+
+/**
+ * A synthetic event mix: 60% custom events with properties, 25% screen tracking and 15% region events.
+ */
+- (NSArray<UAEvent *> *)eventMixWithCount:(NSUInteger)count {
+    NSMutableArray<UAEvent *> *events = [NSMutableArray arrayWithCapacity:count];
+
+    for (NSUInteger i = 0; i < count; i++) {
+        NSUInteger bucket = i % 20;
+
+        if (bucket < 12) {
+            UACustomEvent *event = [UACustomEvent eventWithName:[NSString stringWithFormat:@"event-%lu", (unsigned long)(i % 40)]
+                                                          value:@(i % 100)];
+            event.properties = @{@"product_id": [NSString stringWithFormat:@"product-%lu", (unsigned long)i],
+                                 @"category": @"benchmark",
+                                 @"quantity": @(i % 5 + 1),
+                                 @"on_sale": @(i % 2 == 0)};
+            [events addObject:event];
+        } else if (bucket < 17) {
+            [events addObject:[UAScreenTrackingEvent eventWithScreen:[NSString stringWithFormat:@"screen-%lu", (unsigned long)(i % 25)]
+                                                      previousScreen:@"home"
+                                                           startTime:0
+                                                            stopTime:(NSTimeInterval)(i % 30 + 1)]];
+        } else {
+            [events addObject:[UARegionEvent regionEventWithRegionID:[NSString stringWithFormat:@"region-%lu", (unsigned long)(i % 10)]
+                                                              source:@"benchmark"
+                                                       boundaryEvent:i % 2 ? UABoundaryEventEnter : UABoundaryEventExit]];
+        }
+    }
+
+    return events;
+}
+
+- (void)fillStoreWithEventCount:(NSUInteger)eventCount {
+    for (UAEvent *event in [self eventMixWithCount:eventCount]) {
+        [self.eventStore saveEvent:event sessionID:@"benchmark"];
+    }
+
+    [self.eventStore savePendingEvents];
+    [self.eventStore waitForIdle];
+}
+
+- (NSArray<UAEventData *> *)fetchBatchAfterStoreID:(NSUInteger)storeID {
+    __block NSArray<UAEventData *> *batch;
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    [self.eventStore fetchEventsWithMaxBatchSize:kMaxBatchSizeBytes afterStoreID:storeID completionHandler:^(NSArray<UAEventData *> *result) {
+        batch = result;
+        dispatch_semaphore_signal(semaphore);
+    }];
+    dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+    return batch;
+}
+
+- (NSString *)summaryWithEventCount:(NSUInteger)eventCount
+                            elapsed:(NSTimeInterval)elapsed
+                          latencies:(double *)latencies
+                              count:(NSUInteger)count
+                       latencyLabel:(NSString *)latencyLabel {
+    return [NSString stringWithFormat:@"%.0f events/s, %@ p50 %.1f us, p99 %.1f us",
+            elapsed ? eventCount / elapsed : 0,
+            latencyLabel,
+            [self percentile:0.5 ofSamples:latencies count:count] * 1000000,
+            [self percentile:0.99 ofSamples:latencies count:count] * 1000000];
+}
+
+@end
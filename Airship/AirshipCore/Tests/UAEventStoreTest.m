@@ -0,0 +1,264 @@
+/* Copyright Airship and Contributors */
+
+#import "UAAirshipBaseTest.h"
+#import "UAEventStore+Internal.h"
+#import "UACustomEvent.h"
+#import "UAUtils+Internal.h"
+
+@interface UAEventStoreTest : UAAirshipBaseTest
+@property (nonatomic, strong) UAEventStore *eventStore;
+@end
+
+@implementation UAEventStoreTest
+
+- (void)setUp {
+    [super setUp];
+    self.eventStore = [UAEventStore eventStoreWithConfig:self.config];
+}
+
+- (void)tearDown {
+    [self.eventStore deleteAllEvents];
+    [self.eventStore waitForIdle];
+    [super tearDown];
+}
+
+- (void)testSaveAndFetch {
+    UACustomEvent *first = [UACustomEvent eventWithName:@"first"];
+    UACustomEvent *second = [UACustomEvent eventWithName:@"second"];
+    [self.eventStore saveEvent:first sessionID:@"session"];
+    [self.eventStore saveEvent:second sessionID:@"session"];
+
+    NSArray<UAEventData *> *events = [self fetchEventsWithMaxBatchSize:NSUIntegerMax];
+    XCTAssertEqual(2, events.count);
+    XCTAssertEqualObjects(first.eventID, events[0].identifier);
+    XCTAssertEqualObjects(second.eventID, events[1].identifier);
+    XCTAssertTrue(events[0].storeID < events[1].storeID);
+
+    NSDictionary *payload = [NSJSONSerialization JSONObjectWithData:events[0].payload options:0 error:nil];
+    XCTAssertEqualObjects(first.eventID, payload[@"event_id"]);
+    XCTAssertEqualObjects(first.eventType, payload[@"type"]);
+    XCTAssertEqualObjects(@"session", payload[@"data"][@"session_id"]);
+    XCTAssertEqual(events[0].payload.length, events[0].bytes);
+}
+
+- (void)testFetchHonorsMaxBatchSize {
+    for (NSUInteger i = 0; i < 150; i++) {
+        [self.eventStore saveEvent:[UACustomEvent eventWithName:@"event"] sessionID:@"session"];
+    }
+
+    NSArray<UAEventData *> *all = [self fetchEventsWithMaxBatchSize:NSUIntegerMax];
+    XCTAssertEqual(150, all.count);
+
+    NSUInteger maxBatchSize = all[0].bytes + all[1].bytes + all[2].bytes;
+    NSArray<UAEventData *> *batch = [self fetchEventsWithMaxBatchSize:maxBatchSize];
+    XCTAssertEqual(3, batch.count);
+    XCTAssertEqualObjects(all[0].identifier, batch[0].identifier);
+
+    // At least one event is always returned
+    XCTAssertEqual(1, [self fetchEventsWithMaxBatchSize:1].count);
+}
+
+- (void)testDeleteEventsUpToStoreID {
+    for (NSUInteger i = 0; i < 5; i++) {
+        [self.eventStore saveEvent:[UACustomEvent eventWithName:@"event"] sessionID:@"session"];
+    }
+
+    NSArray<UAEventData *> *events = [self fetchEventsWithMaxBatchSize:NSUIntegerMax];
+    [self.eventStore deleteEventsUpToStoreID:events[2].storeID];
+
+    NSArray<UAEventData *> *remaining = [self fetchEventsWithMaxBatchSize:NSUIntegerMax];
+    XCTAssertEqual(2, remaining.count);
+    XCTAssertEqualObjects(events[3].identifier, remaining[0].identifier);
+}
+
+- (void)testDeleteEventsWithIDs {
+    UACustomEvent *first = [UACustomEvent eventWithName:@"first"];
+    UACustomEvent *second = [UACustomEvent eventWithName:@"second"];
+    [self.eventStore saveEvent:first sessionID:@"session"];
+    [self.eventStore saveEvent:second sessionID:@"session"];
+    [self.eventStore savePendingEvents];
+
+    [self.eventStore deleteEventsWithIDs:@[first.eventID]];
+
+    NSArray<UAEventData *> *remaining = [self fetchEventsWithMaxBatchSize:NSUIntegerMax];
+    XCTAssertEqual(1, remaining.count);
+    XCTAssertEqualObjects(second.eventID, remaining[0].identifier);
+}
+
+- (void)testTrimRemovesOldestEvents {
+    for (NSUInteger i = 0; i < 10; i++) {
+        [self.eventStore saveEvent:[UACustomEvent eventWithName:@"event"] sessionID:@"session"];
+    }
+
+    NSArray<UAEventData *> *events = [self fetchEventsWithMaxBatchSize:NSUIntegerMax];
+    NSUInteger maxSize = events[6].bytes + events[7].bytes + events[8].bytes + events[9].bytes;
+    [self.eventStore trimEventsToStoreSize:maxSize];
+
+    NSArray<UAEventData *> *remaining = [self fetchEventsWithMaxBatchSize:NSUIntegerMax];
+    XCTAssertEqual(4, remaining.count);
+    XCTAssertEqualObjects(events[6].identifier, remaining[0].identifier);
+}
+
+- (void)testTrimRemovesLowerPriorityEventsFirst {
+    UACustomEvent *important = [UACustomEvent eventWithName:@"important"];
+    id mockImportant = [self partialMockForObject:important];
+    [[[mockImportant stub] andReturnValue:OCMOCK_VALUE((UAEventPriority)UAEventPriorityHigh)] priority];
+    [self.eventStore saveEvent:mockImportant sessionID:@"session"];
+
+    for (NSUInteger i = 0; i < 10; i++) {
+        [self.eventStore saveEvent:[UACustomEvent eventWithName:@"event"] sessionID:@"session"];
+    }
+
+    // The high priority event is the oldest but outlives the normal priority flood
+    NSArray<UAEventData *> *events = [self fetchEventsWithMaxBatchSize:NSUIntegerMax];
+    NSUInteger maxSize = events[0].bytes + events[10].bytes;
+    [self.eventStore trimEventsToStoreSize:maxSize];
+
+    NSArray<UAEventData *> *remaining = [self fetchEventsWithMaxBatchSize:NSUIntegerMax];
+    XCTAssertEqual(2, remaining.count);
+    XCTAssertEqualObjects(important.eventID, remaining[0].identifier);
+    XCTAssertEqualObjects(events[10].identifier, remaining[1].identifier);
+}
+
+- (void)testTrimUsesPersistedStoreSize {
+    for (NSUInteger i = 0; i < 10; i++) {
+        [self.eventStore saveEvent:[UACustomEvent eventWithName:@"event"] sessionID:@"session"];
+    }
+
+    NSArray<UAEventData *> *events = [self fetchEventsWithMaxBatchSize:NSUIntegerMax];
+    [self.eventStore deleteEventsUpToStoreID:events[1].storeID];
+    [self.eventStore waitForIdle];
+
+    // A new store reads the running size written alongside the inserts and deletes
+    self.eventStore = [UAEventStore eventStoreWithConfig:self.config];
+    NSUInteger maxSize = events[7].bytes + events[8].bytes + events[9].bytes;
+    [self.eventStore trimEventsToStoreSize:maxSize];
+
+    NSArray<UAEventData *> *remaining = [self fetchEventsWithMaxBatchSize:NSUIntegerMax];
+    XCTAssertEqual(3, remaining.count);
+    XCTAssertEqualObjects(events[7].identifier, remaining[0].identifier);
+}
+
+- (void)testDeleteAllEvents {
+    [self.eventStore saveEvent:[UACustomEvent eventWithName:@"event"] sessionID:@"session"];
+    [self.eventStore savePendingEvents];
+    [self.eventStore saveEvent:[UACustomEvent eventWithName:@"event"] sessionID:@"session"];
+
+    [self.eventStore deleteAllEvents];
+
+    XCTAssertEqual(0, [self fetchEventsWithMaxBatchSize:NSUIntegerMax].count);
+}
+
+- (void)testEventsSpillWhileStoreUnavailable {
+    id mockUtils = [self makeStoreUnavailable];
+
+    UACustomEvent *first = [UACustomEvent eventWithName:@"first"];
+    UACustomEvent *second = [UACustomEvent eventWithName:@"second"];
+    [self.eventStore saveEvent:first sessionID:@"session"];
+    [self.eventStore savePendingEvents];
+    [self.eventStore saveEvent:second sessionID:@"session"];
+    [self.eventStore savePendingEvents];
+
+    XCTAssertEqual(0, [self fetchEventsWithMaxBatchSize:NSUIntegerMax].count);
+    XCTAssertEqual(0, self.eventStore.storeSize);
+
+    // Spilled events are written ahead of events saved once the store opens
+    [mockUtils stopMocking];
+    UACustomEvent *third = [UACustomEvent eventWithName:@"third"];
+    [self.eventStore saveEvent:third sessionID:@"session"];
+
+    NSArray<UAEventData *> *events = [self fetchEventsWithMaxBatchSize:NSUIntegerMax];
+    XCTAssertEqual(3, events.count);
+    XCTAssertEqualObjects(first.eventID, events[0].identifier);
+    XCTAssertEqualObjects(second.eventID, events[1].identifier);
+    XCTAssertEqualObjects(third.eventID, events[2].identifier);
+}
+
+- (void)testSpillDropsOldestEventsPastLimit {
+    id mockUtils = [self makeStoreUnavailable];
+
+    NSMutableArray<UACustomEvent *> *saved = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 510; i++) {
+        UACustomEvent *event = [UACustomEvent eventWithName:@"event"];
+        [saved addObject:event];
+        [self.eventStore saveEvent:event sessionID:@"session"];
+
+        // Spill in several writes
+        if (i % 100 == 99) {
+            [self.eventStore savePendingEvents];
+        }
+    }
+    [self.eventStore savePendingEvents];
+    [self.eventStore waitForIdle];
+
+    [mockUtils stopMocking];
+
+    NSArray<UAEventData *> *events = [self fetchEventsWithMaxBatchSize:NSUIntegerMax];
+    XCTAssertEqual(500, events.count);
+    XCTAssertEqualObjects(saved[10].eventID, events.firstObject.identifier);
+    XCTAssertEqualObjects(saved.lastObject.eventID, events.lastObject.identifier);
+}
+
+- (void)testProtectedDataAvailableWritesSpilledEvents {
+    id mockUtils = [self makeStoreUnavailable];
+
+    UACustomEvent *event = [UACustomEvent eventWithName:@"event"];
+    [self.eventStore saveEvent:event sessionID:@"session"];
+    [self.eventStore savePendingEvents];
+    [self.eventStore waitForIdle];
+    XCTAssertEqual(0, self.eventStore.storeSize);
+
+    [mockUtils stopMocking];
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationProtectedDataDidBecomeAvailable object:nil];
+    [self.eventStore waitForIdle];
+
+    // Written without waiting for the next store operation
+    XCTAssertTrue(self.eventStore.storeSize > 0);
+
+    NSArray<UAEventData *> *events = [self fetchEventsWithMaxBatchSize:NSUIntegerMax];
+    XCTAssertEqual(1, events.count);
+    XCTAssertEqualObjects(event.eventID, events[0].identifier);
+}
+
+- (void)testDeleteAllEventsClearsSpilledEvents {
+    id mockUtils = [self makeStoreUnavailable];
+
+    [self.eventStore saveEvent:[UACustomEvent eventWithName:@"event"] sessionID:@"session"];
+    [self.eventStore savePendingEvents];
+    [self.eventStore deleteAllEvents];
+    [self.eventStore waitForIdle];
+
+    [mockUtils stopMocking];
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationProtectedDataDidBecomeAvailable object:nil];
+    [self.eventStore waitForIdle];
+
+    XCTAssertEqual(0, self.eventStore.storeSize);
+    XCTAssertEqual(0, [self fetchEventsWithMaxBatchSize:NSUIntegerMax].count);
+}
+
+/**
+ * Replaces the event store with one that can't open its database, like while protected
+ * data is unavailable. Stop mocking the returned mock to make the database available again.
+ */
+- (id)makeStoreUnavailable {
+    id mockUtils = [self mockForClass:[UAUtils class]];
+    [[[mockUtils stub] andReturn:nil] noBackupDirectoryURL:[OCMArg anyObjectRef]];
+
+    self.eventStore = [UAEventStore eventStoreWithConfig:self.config];
+    [self.eventStore waitForIdle];
+    return mockUtils;
+}
+
+- (NSArray<UAEventData *> *)fetchEventsWithMaxBatchSize:(NSUInteger)maxBatchSize {
+    __block NSArray<UAEventData *> *result;
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched events"];
+    [self.eventStore fetchEventsWithMaxBatchSize:maxBatchSize completionHandler:^(NSArray<UAEventData *> *events) {
+        result = events;
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    return result;
+}
+
+@end
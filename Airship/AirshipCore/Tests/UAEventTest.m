@@ -296,4 +296,22 @@
     XCTAssertEqualObjects(event.notificationAuthorization, @"not_determined");
 }
 
+- (void)testJSONDataWithSessionID {
+    id notification = @{ @"_": @"push ID" };
+    UAPushReceivedEvent *event = [UAPushReceivedEvent eventWithNotification:notification];
+
+    NSData *json = [event JSONDataWithSessionID:@"session"];
+    NSDictionary *payload = [NSJSONSerialization JSONObjectWithData:json options:0 error:nil];
+
+    NSDictionary *expected = @{@"event_id": event.eventID,
+                               @"time": event.time,
+                               @"type": @"push_received",
+                               @"data": @{@"push_id": @"push ID", @"session_id": @"session"}};
+    XCTAssertEqualObjects(expected, payload);
+
+    // Serialized once and reused
+    XCTAssertTrue(json == [event JSONDataWithSessionID:@"session"]);
+    XCTAssertEqual(json.length, event.jsonEventSize);
+}
+
 @end
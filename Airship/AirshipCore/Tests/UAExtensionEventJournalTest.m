@@ -0,0 +1,82 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAExtensionEventJournal+Internal.h"
+#import "UAEvent+Internal.h"
+#import "UACustomEvent.h"
+
+@interface UAExtensionEventJournalTest : UABaseTest
+@property (nonatomic, strong) UAExtensionEventJournal *journal;
+@property (nonatomic, strong) NSURL *directoryURL;
+@end
+
+@implementation UAExtensionEventJournalTest
+
+- (void)setUp {
+    [super setUp];
+    self.directoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString isDirectory:YES];
+    self.journal = [UAExtensionEventJournal journalWithDirectoryURL:self.directoryURL];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtURL:self.directoryURL error:nil];
+    [super tearDown];
+}
+
+/**
+ * Test recorded events are collected with their type, ID, time and data, and the journal is cleared.
+ */
+- (void)testRecordAndCollect {
+    UACustomEvent *first = [UACustomEvent eventWithName:@"first"];
+    UACustomEvent *second = [UACustomEvent eventWithName:@"second" value:@(10)];
+
+    XCTAssertTrue([self.journal recordEvent:first]);
+    XCTAssertTrue([self.journal recordEvent:second]);
+
+    NSArray<UAEvent *> *events = [self.journal collectEvents];
+    XCTAssertEqual(2, events.count);
+
+    for (NSUInteger i = 0; i < events.count; i++) {
+        UAEvent *expected = @[first, second][i];
+        XCTAssertEqualObjects(expected.eventType, events[i].eventType);
+        XCTAssertEqualObjects(expected.eventID, events[i].eventID);
+        XCTAssertEqualObjects(expected.time, events[i].time);
+        XCTAssertEqualObjects(expected.data, events[i].data);
+    }
+
+    XCTAssertEqual(0, [self.journal collectEvents].count);
+}
+
+/**
+ * Test events are dropped once the journal is full.
+ */
+- (void)testMaxSize {
+    UACustomEvent *event = [UACustomEvent eventWithName:[@"" stringByPaddingToLength:200 withString:@"a" startingAtIndex:0]];
+
+    NSUInteger recorded = 0;
+    while ([self.journal recordEvent:event]) {
+        recorded++;
+        XCTAssertLessThan(recorded, UAExtensionEventJournalMaxSize);
+    }
+
+    XCTAssertEqual(recorded, [self.journal collectEvents].count);
+    XCTAssertTrue([self.journal recordEvent:event]);
+}
+
+/**
+ * Test lines that can't be parsed are skipped.
+ */
+- (void)testCorruptLinesSkipped {
+    UACustomEvent *event = [UACustomEvent eventWithName:@"event"];
+    XCTAssertTrue([self.journal recordEvent:event]);
+
+    NSFileHandle *handle = [NSFileHandle fileHandleForWritingToURL:[self.directoryURL URLByAppendingPathComponent:@"events"] error:nil];
+    [handle seekToEndOfFile];
+    [handle writeData:[@"{\"event_id\": \n[]\n" dataUsingEncoding:NSUTF8StringEncoding]];
+    [handle closeFile];
+
+    XCTAssertTrue([self.journal recordEvent:event]);
+    XCTAssertEqual(2, [self.journal collectEvents].count);
+}
+
+@end
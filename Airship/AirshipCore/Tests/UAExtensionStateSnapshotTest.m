@@ -0,0 +1,105 @@
+/* Copyright Airship and Contributors */
+
+#import "UAAirshipBaseTest.h"
+#import "UAExtensionStateSnapshot+Internal.h"
+#import "UAMetricsRegistry+Internal.h"
+#import "UAChannel.h"
+#import "UAAnalytics+Internal.h"
+#import "UAEvent+Internal.h"
+#import "UAChannelNotificationCenterEvents.h"
+#import "UARuntimeConfig.h"
+#import "UAAppStateTracker.h"
+#import "UATestDispatcher.h"
+
+@interface UAExtensionStateSnapshotTest : UAAirshipBaseTest
+@property (nonatomic, strong) UAExtensionStateSnapshot *snapshot;
+@property (nonatomic, strong) UAMetricsRegistry *metrics;
+@property (nonatomic, strong) NSNotificationCenter *notificationCenter;
+@property (nonatomic, strong) NSURL *directoryURL;
+@property (nonatomic, copy) NSString *channelID;
+@property (nonatomic, strong) id mockChannel;
+@property (nonatomic, strong) id mockAnalytics;
+@end
+
+@implementation UAExtensionStateSnapshotTest
+
+- (void)setUp {
+    [super setUp];
+
+    self.mockChannel = [self mockForClass:[UAChannel class]];
+    [[[self.mockChannel stub] andDo:^(NSInvocation *invocation) {
+        NSString *channelID = self.channelID;
+        [invocation setReturnValue:&channelID];
+    }] identifier];
+
+    self.mockAnalytics = [self mockForClass:[UAAnalytics class]];
+    [[[self.mockAnalytics stub] andReturnValue:@YES] isEnabled];
+    [[[self.mockAnalytics stub] andReturn:@{@"X-UA-App-Key": @"appKey"}] analyticsHeaders];
+
+    self.directoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString isDirectory:YES];
+    self.notificationCenter = [[NSNotificationCenter alloc] init];
+    self.metrics = [UAMetricsRegistry metricsRegistryWithNotificationCenter:self.notificationCenter
+                                                           exportDispatcher:[UATestDispatcher testDispatcher]];
+
+    self.snapshot = [UAExtensionStateSnapshot snapshotWithConfig:self.config
+                                                         channel:self.mockChannel
+                                                       analytics:self.mockAnalytics
+                                                    directoryURL:self.directoryURL
+                                              notificationCenter:self.notificationCenter
+                                                         metrics:self.metrics
+                                                      dispatcher:[UATestDispatcher testDispatcher]];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtURL:self.directoryURL error:nil];
+    [super tearDown];
+}
+
+- (NSDictionary *)readState {
+    NSData *data = [NSData dataWithContentsOfURL:[self.directoryURL URLByAppendingPathComponent:@"state.plist"]];
+    return data ? [NSPropertyListSerialization propertyListWithData:data options:0 format:NULL error:nil] : nil;
+}
+
+- (void)testWriteOnChannelUpdate {
+    NSDictionary *state = [self readState];
+    XCTAssertEqualObjects(@1, state[@"version"]);
+    XCTAssertEqualObjects(self.config.appKey, state[@"app_key"]);
+    XCTAssertEqualObjects(self.config.deviceAPIURL, state[@"device_api_url"]);
+    XCTAssertEqualObjects(@YES, state[@"analytics_enabled"]);
+    XCTAssertEqualObjects(@{@"X-UA-App-Key": @"appKey"}, state[@"analytics_headers"]);
+    XCTAssertNil(state[@"channel_id"]);
+
+    self.channelID = @"channel";
+    [self.notificationCenter postNotificationName:UAChannelCreatedEvent object:nil];
+    XCTAssertEqualObjects(@"channel", [self readState][@"channel_id"]);
+
+    self.channelID = @"updated";
+    [self.notificationCenter postNotificationName:UAChannelUpdatedEvent object:nil];
+    XCTAssertEqualObjects(@"updated", [self readState][@"channel_id"]);
+}
+
+- (void)testCollectDeliveriesOnForeground {
+    NSString *log = @"{\"event_id\":\"one\",\"time\":\"100.000000\",\"push_id\":\"push one\"}\n"
+                    @"{\"event_id\":\"two\",\"time\":\"200.000000\",\"push_id\":\"push two\"}\n"
+                    @"{\"uploaded\":\"two\"}\n";
+    [[log dataUsingEncoding:NSUTF8StringEncoding] writeToURL:[self.directoryURL URLByAppendingPathComponent:@"deliveries"] atomically:YES];
+
+    // Only the receipt the extension did not upload is added, keeping its ID and time
+    [[self.mockAnalytics expect] addEvents:[OCMArg checkWithBlock:^BOOL(NSArray<UAEvent *> *events) {
+        UAEvent *event = events.firstObject;
+        return events.count == 1 &&
+            [event.eventType isEqualToString:@"push_received"] &&
+            [event.eventID isEqualToString:@"one"] &&
+            [event.time isEqualToString:@"100.000000"] &&
+            [event.data[@"push_id"] isEqualToString:@"push one"];
+    }]];
+
+    [self.notificationCenter postNotificationName:UAApplicationDidTransitionToForeground object:nil];
+    [self.mockAnalytics verify];
+    XCTAssertEqual(2, [self.metrics metricWithName:UAMetricPushExtensionDeliveries].value);
+
+    // The log is cleared once collected
+    XCTAssertEqual(0, [self.snapshot collectDeliveries]);
+}
+
+@end
@@ -0,0 +1,66 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAForegroundWorkScheduler+Internal.h"
+#import "UATestDispatcher.h"
+#import "UATestDate.h"
+#import "UAWorkScheduler+Internal.h"
+#import "UAMetricsRegistry+Internal.h"
+
+@interface UAForegroundWorkSchedulerTest : UABaseTest
+@property (nonatomic, strong) UATestDispatcher *testDispatcher;
+@property (nonatomic, strong) UAForegroundWorkScheduler *scheduler;
+@property (nonatomic, strong) NSMutableArray<NSString *> *ran;
+@end
+
+@implementation UAForegroundWorkSchedulerTest
+
+- (void)setUp {
+    [super setUp];
+    self.testDispatcher = [UATestDispatcher testDispatcher];
+    UAWorkScheduler *workScheduler = [UAWorkScheduler schedulerWithLaunchType:UAWorkLaunchTypeForeground
+                                                           notificationCenter:[[NSNotificationCenter alloc] init]
+                                                                         date:[[UATestDate alloc] init]
+                                                                      metrics:[UAMetricsRegistry metricsRegistry]];
+    self.scheduler = [UAForegroundWorkScheduler schedulerWithDispatcher:self.testDispatcher workScheduler:workScheduler];
+    self.ran = [NSMutableArray array];
+}
+
+- (void)scheduleWorkWithName:(NSString *)name priority:(UAForegroundWorkPriority)priority {
+    [self.scheduler scheduleWorkWithName:name priority:priority dispatcher:self.testDispatcher block:^{
+        [self.ran addObject:name];
+    }];
+}
+
+- (void)testWorkIsStaggeredInPriorityOrder {
+    [self scheduleWorkWithName:@"low" priority:UAForegroundWorkPriorityLow];
+    [self scheduleWorkWithName:@"default" priority:UAForegroundWorkPriorityDefault];
+    [self scheduleWorkWithName:@"high" priority:UAForegroundWorkPriorityHigh];
+
+    // Nothing runs before the first frame
+    XCTAssertEqual(0, self.ran.count);
+
+    [self.testDispatcher advanceTime:UAForegroundWorkInitialDelay];
+    XCTAssertEqualObjects(@[@"high"], self.ran);
+
+    [self.testDispatcher advanceTime:UAForegroundWorkStaggerInterval];
+    XCTAssertEqualObjects((@[@"high", @"default"]), self.ran);
+
+    [self.testDispatcher advanceTime:UAForegroundWorkStaggerInterval];
+    XCTAssertEqualObjects((@[@"high", @"default", @"low"]), self.ran);
+}
+
+- (void)testWorkWithTheSameNameIsCoalesced {
+    __block NSUInteger firstRuns = 0;
+    [self.scheduler scheduleWorkWithName:@"work" priority:UAForegroundWorkPriorityDefault dispatcher:self.testDispatcher block:^{
+        firstRuns++;
+    }];
+    [self scheduleWorkWithName:@"work" priority:UAForegroundWorkPriorityDefault];
+
+    [self.testDispatcher advanceTime:UAForegroundWorkInitialDelay + UAForegroundWorkStaggerInterval];
+
+    XCTAssertEqual(0, firstRuns);
+    XCTAssertEqualObjects(@[@"work"], self.ran);
+}
+
+@end
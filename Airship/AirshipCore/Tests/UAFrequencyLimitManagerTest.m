@@ -0,0 +1,102 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAFrequencyLimitManager+Internal.h"
+#import "UAFrequencyConstraint+Internal.h"
+#import "UAAutomationStore+Internal.h"
+#import "UATestDate.h"
+#import "UATestRuntimeConfig.h"
+
+@interface UAFrequencyLimitManagerTest : UABaseTest
+@property (nonatomic, strong) UAAutomationStore *store;
+@property (nonatomic, strong) UATestDate *testDate;
+@property (nonatomic, strong) UAFrequencyLimitManager *manager;
+@end
+
+@implementation UAFrequencyLimitManagerTest
+
+- (void)setUp {
+    [super setUp];
+    self.testDate = [[UATestDate alloc] initWithAbsoluteTime:[NSDate date]];
+    self.store = [UAAutomationStore automationStoreWithConfig:[UATestRuntimeConfig testConfig]
+                                                scheduleLimit:100
+                                                     inMemory:YES
+                                                         date:self.testDate];
+    self.manager = [UAFrequencyLimitManager managerWithAutomationStore:self.store date:self.testDate];
+    [self.store waitForIdle];
+}
+
+- (void)tearDown {
+    [self.store shutDown];
+    [self.store waitForIdle];
+    [super tearDown];
+}
+
+- (void)testSlidingWindow {
+    [self.manager updateConstraints:@[[UAFrequencyConstraint constraintWithIdentifier:@"foo" range:10 count:2]]];
+
+    XCTAssertTrue([self.manager checkAndIncrement:@[@"foo"]]);
+    self.testDate.timeOffset = 5;
+    XCTAssertTrue([self.manager checkAndIncrement:@[@"foo"]]);
+    XCTAssertTrue([self.manager isOverLimit:@[@"foo"]]);
+    XCTAssertFalse([self.manager checkAndIncrement:@[@"foo"]]);
+
+    // The first occurrence slides out of the window
+    self.testDate.timeOffset = 10;
+    XCTAssertFalse([self.manager isOverLimit:@[@"foo"]]);
+    XCTAssertTrue([self.manager checkAndIncrement:@[@"foo"]]);
+    XCTAssertTrue([self.manager isOverLimit:@[@"foo"]]);
+}
+
+- (void)testOverLimitIfAnyConstraintIsOver {
+    [self.manager updateConstraints:@[[UAFrequencyConstraint constraintWithIdentifier:@"foo" range:10 count:1],
+                                      [UAFrequencyConstraint constraintWithIdentifier:@"bar" range:10 count:5]]];
+
+    XCTAssertTrue([self.manager checkAndIncrement:@[@"foo"]]);
+    XCTAssertTrue([self.manager isOverLimit:@[@"bar", @"foo"]]);
+
+    // Nothing is counted when over the limit
+    XCTAssertFalse([self.manager checkAndIncrement:@[@"bar", @"foo"]]);
+    XCTAssertFalse([self.manager isOverLimit:@[@"bar"]]);
+
+    // Unknown constraints never limit
+    XCTAssertFalse([self.manager isOverLimit:@[@"baz"]]);
+    XCTAssertTrue([self.manager checkAndIncrement:@[@"baz"]]);
+    XCTAssertTrue([self.manager checkAndIncrement:nil]);
+}
+
+- (void)testOccurrencesPersist {
+    [self.manager updateConstraints:@[[UAFrequencyConstraint constraintWithIdentifier:@"foo" range:10 count:1]]];
+    XCTAssertTrue([self.manager checkAndIncrement:@[@"foo"]]);
+    [self.store waitForIdle];
+
+    UAFrequencyLimitManager *reloaded = [UAFrequencyLimitManager managerWithAutomationStore:self.store date:self.testDate];
+    [self.store waitForIdle];
+    XCTAssertTrue([reloaded isOverLimit:@[@"foo"]]);
+
+    self.testDate.timeOffset = 11;
+    reloaded = [UAFrequencyLimitManager managerWithAutomationStore:self.store date:self.testDate];
+    [self.store waitForIdle];
+    XCTAssertFalse([reloaded isOverLimit:@[@"foo"]]);
+}
+
+- (void)testRangeChangeResetsOccurrences {
+    [self.manager updateConstraints:@[[UAFrequencyConstraint constraintWithIdentifier:@"foo" range:10 count:1],
+                                      [UAFrequencyConstraint constraintWithIdentifier:@"bar" range:10 count:1]]];
+    XCTAssertTrue([self.manager checkAndIncrement:@[@"foo", @"bar"]]);
+
+    // A new count keeps the occurrences, a new range drops them
+    [self.manager updateConstraints:@[[UAFrequencyConstraint constraintWithIdentifier:@"foo" range:20 count:1],
+                                      [UAFrequencyConstraint constraintWithIdentifier:@"bar" range:10 count:2]]];
+    XCTAssertFalse([self.manager isOverLimit:@[@"foo"]]);
+    XCTAssertTrue([self.manager checkAndIncrement:@[@"bar"]]);
+    XCTAssertTrue([self.manager isOverLimit:@[@"bar"]]);
+    [self.store waitForIdle];
+
+    UAFrequencyLimitManager *reloaded = [UAFrequencyLimitManager managerWithAutomationStore:self.store date:self.testDate];
+    [self.store waitForIdle];
+    XCTAssertFalse([reloaded isOverLimit:@[@"foo"]]);
+    XCTAssertTrue([reloaded isOverLimit:@[@"bar"]]);
+}
+
+@end
@@ -131,4 +131,37 @@
     XCTAssertEqualObjects(@[mutation2], [self.historian attributeHistoryNewerThan:date]);
 }
 
+- (void)postChannelTagMutation:(UATagGroupsMutation *)mutation date:(NSDate *)date {
+    [[NSNotificationCenter defaultCenter] postNotificationName:UAChannelUploadedTagGroupMutationNotification
+                                                        object:nil
+                                                      userInfo:@{UAChannelUploadedAudienceMutationNotificationMutationKey:mutation,
+                                                                 UAChannelUploadedAudienceMutationNotificationDateKey:date,
+                                                                 UAChannelUploadedAudienceMutationNotificationIdentifierKey:@"identifier"}];
+}
+
+- (void)testOrderedTagHistory {
+    NSMutableArray *mutations = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 10; i++) {
+        UATagGroupsMutation *mutation = [UATagGroupsMutation mutationToAddTags:@[[@(i) stringValue]] group:@"group"];
+        [mutations addObject:mutation];
+        [self postChannelTagMutation:mutation date:[NSDate dateWithTimeIntervalSinceNow:(i * 60.0) - 600]];
+    }
+
+    XCTAssertEqualObjects([mutations subarrayWithRange:NSMakeRange(7, 3)], [self.historian tagHistoryNewerThan:[NSDate dateWithTimeIntervalSinceNow:-150]]);
+    XCTAssertEqualObjects(mutations, [self.historian tagHistoryNewerThan:[NSDate distantPast]]);
+    XCTAssertEqualObjects(@[], [self.historian tagHistoryNewerThan:[NSDate distantFuture]]);
+}
+
+- (void)testMaxRecordAge {
+    self.historian.maxRecordAge = 60 * 5;
+
+    UATagGroupsMutation *mutation1 = [UATagGroupsMutation mutationToSetTags:@[@"baz", @"boz"] group:@"group1"];
+    UATagGroupsMutation *mutation2 = [UATagGroupsMutation mutationToSetTags:@[@"bleep", @"bloop"] group:@"group2"];
+
+    [self postChannelTagMutation:mutation1 date:[NSDate dateWithTimeIntervalSinceNow:-60 * 10]];
+    [self postChannelTagMutation:mutation2 date:[NSDate dateWithTimeIntervalSinceNow:-60]];
+
+    XCTAssertEqualObjects(@[mutation2], [self.historian tagHistoryNewerThan:[NSDate distantPast]]);
+}
+
 @end
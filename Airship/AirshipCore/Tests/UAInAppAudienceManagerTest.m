@@ -220,29 +220,30 @@
                                                                                     status:200
                                                                      lastModifiedTimestamp:@"2018-03-02T22:56:09"];
 
+    UATagGroupsLookupResponse *refreshedResponse = [UATagGroupsLookupResponse responseWithTagGroups:responseTagGroups
+                                                                                             status:200
+                                                                              lastModifiedTimestamp:@"2018-03-02T23:56:09"];
+
+    NSDate *cacheRefreshDate = [NSDate dateWithTimeIntervalSinceNow:(-20 * 60)];
+
     [[[self.mockCache expect] andReturn:response] response];
     [[[self.mockCache expect] andReturn:self.requestedTagGroups] requestedTagGroups];
-    [[[self.mockCache expect] andReturn:[NSDate distantPast]] refreshDate];
+    [[[self.mockCache expect] andReturn:cacheRefreshDate] refreshDate];
     [[[self.mockCache expect] andReturnValue:@(YES)] needsRefresh];
+    [[[self.mockCache expect] andReturnValue:@(NO)] isStale];
 
     XCTestExpectation *apiFetchCompleted = [self expectationWithDescription:@"API fetch completed"];
 
-    [[self.mockCache expect] setResponse:response];
+    [[self.mockCache expect] setResponse:refreshedResponse];
 
     [[[self.mockAPIClient expect] andDo:^(NSInvocation *invocation) {
         void *arg;
         [invocation getArgument:&arg atIndex:5];
         void (^completionHandler)(UATagGroupsLookupResponse *) = (__bridge void(^)(UATagGroupsLookupResponse *))arg;
-        [[[self.mockCache expect] andReturn:response] response];
-        completionHandler(response);
+        completionHandler(refreshedResponse);
         [apiFetchCompleted fulfill];
     }] lookupTagGroupsWithChannelID:OCMOCK_ANY requestedTagGroups:OCMOCK_ANY cachedResponse:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
-    NSDate *cacheRefreshDate = [NSDate date];
-
-    [[[self.mockCache expect] andReturn:cacheRefreshDate] refreshDate];
-    [[[self.mockCache expect] andReturnValue:@(NO)] isStale];
-
     self.testDate.absoluteTime = [NSDate date];
 
     NSArray *localHistory = @[
@@ -256,6 +257,7 @@
 
     XCTestExpectation *fetchCompleted = [self expectationWithDescription:@"fetch completed"];
 
+    // The cached response is returned while the cache refreshes in the background
     [self.manager getTagGroups:self.requestedTagGroups completionHandler:^(UATagGroups * _Nonnull tagGroups, NSError * _Nonnull error) {
         XCTAssertEqualObjects(tagGroups, expectedTagGroups);
         XCTAssertNil(error);
@@ -268,6 +270,36 @@
     [self.mockAPIClient verify];
 }
 
+- (void)testGetTagsCacheRefreshMergesRequestedTagGroups {
+    UATagGroups *cachedTagGroups = [UATagGroups tagGroupsWithTags:@{@"bleep": @[@"bloop"]}];
+    UATagGroupsLookupResponse *response = [UATagGroupsLookupResponse responseWithTagGroups:cachedTagGroups
+                                                                                    status:200
+                                                                     lastModifiedTimestamp:@"2018-03-02T22:56:09"];
+
+    [[[self.mockCache stub] andReturn:response] response];
+    [[[self.mockCache stub] andReturn:cachedTagGroups] requestedTagGroups];
+    [[[self.mockCache stub] andReturn:[NSDate date]] refreshDate];
+
+    UATagGroups *expectedRequest = [self.requestedTagGroups merge:cachedTagGroups];
+
+    XCTestExpectation *apiFetchCompleted = [self expectationWithDescription:@"API fetch completed"];
+    [[[self.mockAPIClient expect] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:5];
+        void (^completionHandler)(UATagGroupsLookupResponse *) = (__bridge void(^)(UATagGroupsLookupResponse *))arg;
+        completionHandler(nil);
+        [apiFetchCompleted fulfill];
+    }] lookupTagGroupsWithChannelID:OCMOCK_ANY requestedTagGroups:expectedRequest cachedResponse:response completionHandler:OCMOCK_ANY];
+
+    XCTestExpectation *fetchCompleted = [self expectationWithDescription:@"fetch completed"];
+    [self.manager getTagGroups:self.requestedTagGroups completionHandler:^(UATagGroups * _Nonnull tagGroups, NSError * _Nonnull error) {
+        [fetchCompleted fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    [self.mockAPIClient verify];
+}
+
 - (void)testGetTagsCacheErrorMissingResponse {
     UATagGroups *responseTagGroups = [UATagGroups tagGroupsWithTags:@{@"foo": @[@"bar"]}];
 
@@ -279,6 +311,7 @@
     [[[self.mockCache expect] andReturn:self.requestedTagGroups] requestedTagGroups];
     [[[self.mockCache expect] andReturn:[NSDate distantPast]] refreshDate];
     [[[self.mockCache expect] andReturnValue:@(YES)] needsRefresh];
+    [[[self.mockCache expect] andReturnValue:@(YES)] isStale];
 
     XCTestExpectation *apiFetchCompleted = [self expectationWithDescription:@"API fetch completed"];
 
@@ -318,6 +351,7 @@
     [[[self.mockCache expect] andReturn:self.requestedTagGroups] requestedTagGroups];
     [[[self.mockCache expect] andReturn:[NSDate distantPast]] refreshDate];
     [[[self.mockCache expect] andReturnValue:@(YES)] needsRefresh];
+    [[[self.mockCache expect] andReturnValue:@(YES)] isStale];
 
     XCTestExpectation *apiFetchCompleted = [self expectationWithDescription:@"API fetch completed"];
 
@@ -426,6 +460,45 @@
     XCTAssertEqualObjects([UATagGroupsMutation collapseMutations:expected], self.manager.tagOverrides);
 }
 
+- (void)testTagOverridesCached {
+    self.testDate.absoluteTime = [NSDate date];
+
+    __block NSUInteger historyReads = 0;
+    NSArray *localHistory = @[[UATagGroupsMutation mutationToAddTags:@[@"one"] group:@"foo"]];
+    [[[[self.mockHistorian stub] andDo:^(NSInvocation *invocation) {
+        historyReads++;
+    }] andReturn:localHistory] tagHistoryNewerThan:OCMOCK_ANY];
+
+    __block NSUInteger version = 0;
+    [[[self.mockHistorian stub] andDo:^(NSInvocation *invocation) {
+        [invocation setReturnValue:&version];
+    }] version];
+
+    // The only record expires with the override window
+    [[[self.mockHistorian stub] andReturn:self.testDate.absoluteTime] oldestTagRecordDateNewerThan:OCMOCK_ANY];
+
+    NSArray *expected = [UATagGroupsMutation collapseMutations:localHistory];
+    XCTAssertEqualObjects(expected, self.manager.tagOverrides);
+    XCTAssertEqualObjects(expected, self.manager.tagOverrides);
+    XCTAssertEqual(1, historyReads);
+
+    // History changed
+    version++;
+    XCTAssertEqualObjects(expected, self.manager.tagOverrides);
+    XCTAssertEqual(2, historyReads);
+
+    // Pending mutations changed
+    NSArray *pendingChannel = @[[UATagGroupsMutation mutationToAddTags:@[@"two"] group:@"foo"]];
+    [[[self.mockChannel stub] andReturn:pendingChannel] pendingTagGroups];
+    XCTAssertEqualObjects([UATagGroupsMutation collapseMutations:[localHistory arrayByAddingObjectsFromArray:pendingChannel]], self.manager.tagOverrides);
+    XCTAssertEqual(3, historyReads);
+
+    // Record aged out of the window
+    self.testDate.timeOffset = self.manager.preferLocalTagDataTime;
+    [self.manager tagOverrides];
+    XCTAssertEqual(4, historyReads);
+}
+
 - (void)testAttributeOverrides {
     self.testDate.absoluteTime = [NSDate date];
 
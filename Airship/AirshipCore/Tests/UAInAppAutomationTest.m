@@ -263,6 +263,43 @@
     [self.mockAudienceManager verify];
 }
 
+- (void)testSpeculativeDeferredNearlyMet {
+    [[[self.mockChannel stub] andReturn:@"channel ID"] identifier];
+
+    UAScheduleTrigger *trigger = [UAScheduleTrigger foregroundTriggerWithCount:2];
+    UAScheduleTriggerContext *triggerContext = [UAScheduleTriggerContext triggerContextWithTrigger:trigger event:nil];
+    UAScheduleDeferredData *deferred = [UAScheduleDeferredData deferredDataWithURL:[NSURL URLWithString:@"https://airship.com"]
+                                                                retriableOnTimeout:YES
+                                                                       speculative:YES];
+
+    UASchedule *schedule = [UADeferredSchedule scheduleWithDeferredData:deferred builderBlock:^(UAScheduleBuilder *builder) {
+        builder.triggers = @[trigger];
+        builder.identifier = @"schedule ID";
+    }];
+
+    [[[self.mockAudienceManager stub] andReturn:@[]] tagOverrides];
+    [[[self.mockAudienceManager stub] andReturn:nil] attributeOverrides];
+
+    [[self.mockDeferredClient expect] prefetchURL:deferred.URL
+                                        channelID:@"channel ID"
+                                   triggerContext:triggerContext
+                                     tagOverrides:@[]
+                               attributeOverrides:OCMOCK_ANY];
+
+    [self.engineDelegate onScheduleTriggerNearlyMet:schedule triggerContext:triggerContext];
+    [self.mockDeferredClient verify];
+
+    // Schedules that did not opt in are resolved when triggered
+    UASchedule *regular = [UADeferredSchedule scheduleWithDeferredData:[UAScheduleDeferredData deferredDataWithURL:deferred.URL retriableOnTimeout:YES]
+                                                          builderBlock:^(UAScheduleBuilder *builder) {
+        builder.triggers = @[trigger];
+    }];
+
+    [[self.mockDeferredClient reject] prefetchURL:OCMOCK_ANY channelID:OCMOCK_ANY triggerContext:OCMOCK_ANY tagOverrides:OCMOCK_ANY attributeOverrides:OCMOCK_ANY];
+    [self.engineDelegate onScheduleTriggerNearlyMet:regular triggerContext:triggerContext];
+    [self.mockDeferredClient verify];
+}
+
 - (void)testPrepareDeferredTimedOut {
     [[[self.mockChannel stub] andReturn:@"channel ID"] identifier];
 
@@ -678,6 +715,38 @@
     [mockActionRunner verify];
 }
 
+- (void)testExecuteBackgroundSafeActionsOffMainQueue {
+    UASchedule *schedule = [UAActionSchedule scheduleWithActions:@{@"foo": @"bar"} builderBlock:^(UAScheduleBuilder *builder) {
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:1]];
+        builder.identifier = @"schedule ID";
+    }];
+
+    id mockRegistry = [self mockForClass:[UAActionRegistry class]];
+    [[[mockRegistry stub] andReturnValue:@(YES)] isBackgroundSafeForActionNames:@[@"foo"] situation:UASituationAutomation];
+    [[[self.mockAirship stub] andReturn:mockRegistry] actionRegistry];
+
+    __block BOOL ranOnMainThread = YES;
+    id mockActionRunner = [self mockForClass:[UAActionRunner class]];
+    [[mockActionRunner expect] runActionsWithActionValues:schedule.data
+                                                situation:UASituationAutomation
+                                                 metadata:nil
+                                        completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
+        ranOnMainThread = [NSThread isMainThread];
+        void (^handler)(UAActionResult *) = obj;
+        handler([UAActionResult emptyResult]);
+        return YES;
+    }]];
+
+    XCTestExpectation *executeFinished = [self expectationWithDescription:@"execute finished"];
+    [self.engineDelegate executeSchedule:schedule completionHandler:^{
+        [executeFinished fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    [mockActionRunner verify];
+    XCTAssertFalse(ranOnMainThread);
+}
+
 - (void)testCancelScheduleWithID {
     [[[self.mockAutomationEngine expect] andDo:^(NSInvocation *invocation) {
         void *arg;
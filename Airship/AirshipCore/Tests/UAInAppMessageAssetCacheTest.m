@@ -46,24 +46,21 @@
  * and after one has been created.
  */
 - (void)testGetAssets {
-    // STUB
-    __block NSURL *expectedRootURL1 = [self expectedRootURL:self.scheduleId1];
-    
     // EXPECTATIONS
     __block int factoryCallCount = 0;
     [[[self.mockAssetsClass stub] andDo:^(NSInvocation *invocation) {
         factoryCallCount++;
         void *arg;
         [invocation getArgument:&arg atIndex:2];
-        NSURL *rootURL = (__bridge NSURL *)arg;
+        NSString *scheduleID = (__bridge NSString *)arg;
         UAInAppMessageAssets *assets;
-        if ([rootURL isEqual:expectedRootURL1]) {
+        if ([scheduleID isEqualToString:self.scheduleId1]) {
             assets = self.mockAssets1;
         } else {
             assets = nil;
         }
         [invocation setReturnValue:(void *)&assets];
-    }] assets:OCMOCK_ANY];
+    }] assetsWithScheduleID:OCMOCK_ANY store:OCMOCK_ANY];
     
     // TEST
     UAInAppMessageAssets *assets = [self.assetCache assetsForScheduleId:self.scheduleId1];
@@ -90,39 +87,32 @@
 
 /**
  * Test the getAssets() call when there are two UAInAppMessageAssets instances
- * created to make sure they have different root URLs.
+ * created to make sure each schedule gets its own instance.
  */
-- (void)testAssetsHavePerScheduleRoots {
-    // SETUP
-    __block NSURL *expectedRootURL1 = [self expectedRootURL:self.scheduleId1];
-    __block NSURL *expectedRootURL2 = [self expectedRootURL:self.scheduleId2];
-    XCTAssertNotEqualObjects(expectedRootURL1, expectedRootURL2);
-
+- (void)testAssetsArePerSchedule {
     // EXPECTATIONS
-    __block NSURL *expectedRootURL = expectedRootURL1;
     __block int factoryCallCount = 0;
     [[[self.mockAssetsClass stub] andDo:^(NSInvocation *invocation) {
         factoryCallCount++;
         void *arg;
         [invocation getArgument:&arg atIndex:2];
-        NSURL *rootURL = (__bridge NSURL *)arg;
+        NSString *scheduleID = (__bridge NSString *)arg;
         UAInAppMessageAssets *assets;
-        if ([rootURL isEqual:expectedRootURL1]) {
+        if ([scheduleID isEqualToString:self.scheduleId1]) {
             assets = self.mockAssets1;
-        } else if ([rootURL isEqual:expectedRootURL2]) {
+        } else if ([scheduleID isEqualToString:self.scheduleId2]) {
             assets = self.mockAssets2;
         } else {
             assets = nil;
         }
         [invocation setReturnValue:(void *)&assets];
-    }] assets:OCMOCK_ANY];
+    }] assetsWithScheduleID:OCMOCK_ANY store:OCMOCK_ANY];
     
     // TEST
     UAInAppMessageAssets *assets1 = [self.assetCache assetsForScheduleId:self.scheduleId1];
     XCTAssertNotNil(assets1);
     XCTAssertEqualObjects(self.mockAssets1, assets1);
 
-    expectedRootURL = expectedRootURL2;
     UAInAppMessageAssets *assets2 = [self.assetCache assetsForScheduleId:self.scheduleId2];
     XCTAssertNotNil(assets2);
     XCTAssertEqual(self.mockAssets2, assets2);
@@ -141,27 +131,23 @@
  * those assets will no longer exist.
  */
 - (void)testClearAssets {
-    // SETUP
-    __block NSURL *expectedRootURL1 = [self expectedRootURL:self.scheduleId1];
-    __block NSURL *expectedRootURL2 = [self expectedRootURL:self.scheduleId2];
-    
     // EXPECTATIONS
     __block int factoryCallCount = 0;
     [[[self.mockAssetsClass stub] andDo:^(NSInvocation *invocation) {
         factoryCallCount++;
         void *arg;
         [invocation getArgument:&arg atIndex:2];
-        NSURL *rootURL = (__bridge NSURL *)arg;
+        NSString *scheduleID = (__bridge NSString *)arg;
         UAInAppMessageAssets *assets;
-        if ([rootURL isEqual:expectedRootURL1]) {
+        if ([scheduleID isEqualToString:self.scheduleId1]) {
             assets = self.mockAssets1;
-        } else if ([rootURL isEqual:expectedRootURL2]) {
+        } else if ([scheduleID isEqualToString:self.scheduleId2]) {
             assets = self.mockAssets2;
         } else {
             assets = nil;
         }
         [invocation setReturnValue:(void *)&assets];
-    }] assets:OCMOCK_ANY];
+    }] assetsWithScheduleID:OCMOCK_ANY store:OCMOCK_ANY];
     
     // TEST
     UAInAppMessageAssets *assets1 = [self.assetCache assetsForScheduleId:self.scheduleId1];
@@ -242,27 +228,23 @@
  * UAInAppMessageAssets instance's clearAssets() method.
  */
 - (void)testReleaseOneSchedulesAssetsAndWipe {
-    // SETUP
-    __block NSURL *expectedRootURL1 = [self expectedRootURL:self.scheduleId1];
-    __block NSURL *expectedRootURL2 = [self expectedRootURL:self.scheduleId2];
-    
     // EXPECTATIONS
     __block int factoryCallCount = 0;
     [[[self.mockAssetsClass stub] andDo:^(NSInvocation *invocation) {
         factoryCallCount++;
         void *arg;
         [invocation getArgument:&arg atIndex:2];
-        NSURL *rootURL = (__bridge NSURL *)arg;
+        NSString *scheduleID = (__bridge NSString *)arg;
         UAInAppMessageAssets *assets;
-        if ([rootURL isEqual:expectedRootURL1]) {
+        if ([scheduleID isEqualToString:self.scheduleId1]) {
             assets = self.mockAssets1;
-        } else if ([rootURL isEqual:expectedRootURL2]) {
+        } else if ([scheduleID isEqualToString:self.scheduleId2]) {
             assets = self.mockAssets2;
         } else {
             assets = nil;
         }
         [invocation setReturnValue:(void *)&assets];
-    }] assets:OCMOCK_ANY];
+    }] assetsWithScheduleID:OCMOCK_ANY store:OCMOCK_ANY];
 
     // TEST
     UAInAppMessageAssets *assets1 = [self.assetCache assetsForScheduleId:self.scheduleId1];
@@ -311,27 +293,23 @@
  * methods if the wipeFromDisk is `NO`.
  */
 - (void)testReleaseOneSchedulesAssetsAndDontWipe {
-    // SETUP
-    __block NSURL *expectedRootURL1 = [self expectedRootURL:self.scheduleId1];
-    __block NSURL *expectedRootURL2 = [self expectedRootURL:self.scheduleId2];
-    
     // EXPECTATIONS
     __block int factoryCallCount = 0;
     [[[self.mockAssetsClass stub] andDo:^(NSInvocation *invocation) {
         factoryCallCount++;
         void *arg;
         [invocation getArgument:&arg atIndex:2];
-        NSURL *rootURL = (__bridge NSURL *)arg;
+        NSString *scheduleID = (__bridge NSString *)arg;
         UAInAppMessageAssets *assets;
-        if ([rootURL isEqual:expectedRootURL1]) {
+        if ([scheduleID isEqualToString:self.scheduleId1]) {
             assets = self.mockAssets1;
-        } else if ([rootURL isEqual:expectedRootURL2]) {
+        } else if ([scheduleID isEqualToString:self.scheduleId2]) {
             assets = self.mockAssets2;
         } else {
             assets = nil;
         }
         [invocation setReturnValue:(void *)&assets];
-    }] assets:OCMOCK_ANY];
+    }] assetsWithScheduleID:OCMOCK_ANY store:OCMOCK_ANY];
 
     // TEST
     UAInAppMessageAssets *assets1 = [self.assetCache assetsForScheduleId:self.scheduleId1];
@@ -379,27 +357,23 @@
  * method. It should also work if the schedule is not already active
  */
 - (void)testReleaseOneSchedulesAssetsAndWipeWhenAssetsIsntActive {
-    // SETUP
-    __block NSURL *expectedRootURL1 = [self expectedRootURL:self.scheduleId1];
-    __block NSURL *expectedRootURL2 = [self expectedRootURL:self.scheduleId2];
-    
     // EXPECTATIONS
     __block int factoryCallCount = 0;
     [[[self.mockAssetsClass stub] andDo:^(NSInvocation *invocation) {
         factoryCallCount++;
         void *arg;
         [invocation getArgument:&arg atIndex:2];
-        NSURL *rootURL = (__bridge NSURL *)arg;
+        NSString *scheduleID = (__bridge NSString *)arg;
         UAInAppMessageAssets *assets;
-        if ([rootURL isEqual:expectedRootURL1]) {
+        if ([scheduleID isEqualToString:self.scheduleId1]) {
             assets = self.mockAssets1;
-        } else if ([rootURL isEqual:expectedRootURL2]) {
+        } else if ([scheduleID isEqualToString:self.scheduleId2]) {
             assets = self.mockAssets2;
         } else {
             assets = nil;
         }
         [invocation setReturnValue:(void *)&assets];
-    }] assets:OCMOCK_ANY];
+    }] assetsWithScheduleID:OCMOCK_ANY store:OCMOCK_ANY];
     
     // EXPECTATIONS
     __block int clearCallCount1 = 0;
@@ -427,13 +401,4 @@
     inTest = NO;
 }
 
-- (NSURL *)expectedRootURL:(NSString *)scheduleId {
-    NSArray *cachePaths = NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES);
-    NSString *cacheDirectory = [cachePaths objectAtIndex:0];
-    NSString *assetCachePath = [cacheDirectory stringByAppendingPathComponent:@"com.urbanairship.iamassetcache"];
-    NSString *scheduleCachePath = [assetCachePath stringByAppendingPathComponent:scheduleId];
-
-    return [NSURL fileURLWithPath:scheduleCachePath];
-}
-
 @end
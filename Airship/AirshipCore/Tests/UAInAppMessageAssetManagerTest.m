@@ -7,6 +7,7 @@
 #import "UARemoteDataManager+Internal.h"
 #import "UAUtils+Internal.h"
 #import "UAAsyncOperation.h"
+#import "UAInAppMessageSchedule.h"
 
 @interface UAInAppMessageAssetManagerTest : UABaseTest
 @property (nonatomic, strong) UAInAppMessageAssetManager *assetManager;
@@ -18,6 +19,7 @@
 @property (nonatomic, strong) id mockAssetCache;
 @property (nonatomic, strong) id mockAssets;
 @property (nonatomic, strong) id mockRemoteDataManager;
+@property (nonatomic, strong) id mockUtils;
 
 @end
 
@@ -39,6 +41,10 @@
     self.mockAssetCache = [self mockForClass:[UAInAppMessageAssetCache class]];
     self.mockAssets = [self mockForClass:[UAInAppMessageAssets class]];
 
+    // Prefetches on schedule wait for Wi-Fi
+    self.mockUtils = [self mockForClass:[UAUtils class]];
+    [[[self.mockUtils stub] andReturn:UAConnectionTypeWifi] connectionType];
+
     // Create a UAInAppMessageAssetManager
     self.assetManager = [UAInAppMessageAssetManager assetManagerWithAssetCache:self.mockAssetCache operationQueue:self.mockQueue];
 
@@ -79,7 +85,7 @@
         prepareBlock(UAInAppMessagePrepareResultSuccess);
     }] onSchedule:message assets:self.mockAssets completionHandler:OCMOCK_ANY];
 
-    [self.assetManager onMessageScheduled:message scheduleID:scheduleID];
+    [self.assetManager onMessageScheduled:message schedule:[self scheduleWithMessage:message scheduleID:scheduleID]];
 
     [self.mockPrepareAssetDelegate verify];
     [self.mockCachePolicyDelegate verify];
@@ -102,7 +108,7 @@
     [[self.mockAssetCache reject] releaseAssets:OCMOCK_ANY wipeFromDisk:YES];
     [[self.mockPrepareAssetDelegate reject] onSchedule:OCMOCK_ANY assets:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
-    [self.assetManager onMessageScheduled:message scheduleID:scheduleID];
+    [self.assetManager onMessageScheduled:message schedule:[self scheduleWithMessage:message scheduleID:scheduleID]];
 
     [self.mockPrepareAssetDelegate verify];
     [self.mockCachePolicyDelegate verify];
@@ -127,7 +133,7 @@
     [[self.mockAssetCache reject] releaseAssets:OCMOCK_ANY wipeFromDisk:YES];
     [[self.mockPrepareAssetDelegate reject] onSchedule:OCMOCK_ANY assets:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
-    [self.assetManager onMessageScheduled:message scheduleID:scheduleID];
+    [self.assetManager onMessageScheduled:message schedule:[self scheduleWithMessage:message scheduleID:scheduleID]];
 
     [self.mockPrepareAssetDelegate verify];
     [self.mockCachePolicyDelegate verify];
@@ -310,6 +316,13 @@
     [self.mockAssetCache verify];
 }
 
+- (UASchedule *)scheduleWithMessage:(UAInAppMessage *)message scheduleID:(NSString *)scheduleID {
+    return [UAInAppMessageSchedule scheduleWithMessage:message builderBlock:^(UAScheduleBuilder *builder) {
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:1]];
+        builder.identifier = scheduleID;
+    }];
+}
+
 - (UAInAppMessage *)messageWithMediaURL:(NSString *)mediaURL {
     return [UAInAppMessage messageWithBuilderBlock:^(UAInAppMessageBuilder * _Nonnull builder) {
         builder.displayContent = [UAInAppMessageBannerDisplayContent displayContentWithBuilderBlock:^(UAInAppMessageBannerDisplayContentBuilder *builder) {
@@ -0,0 +1,121 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAInAppMessageAssetPrefetchScheduler+Internal.h"
+#import "UAInAppMessageAssetCache+Internal.h"
+#import "UAInAppMessageSchedule.h"
+#import "UAInAppMessageCustomDisplayContent.h"
+#import "UAUtils+Internal.h"
+
+@interface UAInAppMessageAssetPrefetchSchedulerTest : UABaseTest
+@property (nonatomic, strong) UAInAppMessageAssetPrefetchScheduler *scheduler;
+@property (nonatomic, strong) NSNotificationCenter *notificationCenter;
+@property (nonatomic, strong) id mockAssetCache;
+@property (nonatomic, strong) id mockProcessInfo;
+@property (nonatomic, strong) id mockUtils;
+@property (nonatomic, copy) NSString *connectionType;
+@property (nonatomic, assign) NSUInteger cachedSize;
+@end
+
+@implementation UAInAppMessageAssetPrefetchSchedulerTest
+
+- (void)setUp {
+    [super setUp];
+
+    self.connectionType = UAConnectionTypeWifi;
+    self.mockUtils = [self mockForClass:[UAUtils class]];
+    [[[self.mockUtils stub] andDo:^(NSInvocation *invocation) {
+        NSString *connectionType = self.connectionType;
+        [invocation setReturnValue:&connectionType];
+    }] connectionType];
+
+    self.mockAssetCache = [self mockForClass:[UAInAppMessageAssetCache class]];
+    [[[self.mockAssetCache stub] andDo:^(NSInvocation *invocation) {
+        NSUInteger cachedSize = self.cachedSize;
+        [invocation setReturnValue:&cachedSize];
+    }] cachedSize];
+
+    self.mockProcessInfo = [self mockForClass:[NSProcessInfo class]];
+    [[[self.mockProcessInfo stub] andReturnValue:@(NO)] isLowPowerModeEnabled];
+
+    self.notificationCenter = [[NSNotificationCenter alloc] init];
+    self.scheduler = [UAInAppMessageAssetPrefetchScheduler schedulerWithAssetCache:self.mockAssetCache
+                                                                notificationCenter:self.notificationCenter
+                                                                       processInfo:self.mockProcessInfo];
+}
+
+- (void)testPrefetchOrder {
+    NSMutableArray *prefetched = [NSMutableArray array];
+    __block void (^finishRunning)(void);
+
+    UAInAppMessageAssetPrefetchBlock (^prefetch)(NSString *) = ^(NSString *scheduleID) {
+        return ^(void (^completionHandler)(void)) {
+            [prefetched addObject:scheduleID];
+            finishRunning = completionHandler;
+        };
+    };
+
+    // The first prefetch starts right away and holds the others until it finishes
+    [self.scheduler schedulePrefetchForSchedule:[self scheduleWithID:@"running" priority:0 trigger:[UAScheduleTrigger appInitTriggerWithCount:1]]
+                                          block:prefetch(@"running")];
+    [self.scheduler schedulePrefetchForSchedule:[self scheduleWithID:@"low" priority:5 trigger:[UAScheduleTrigger appInitTriggerWithCount:1]]
+                                          block:prefetch(@"low")];
+    [self.scheduler schedulePrefetchForSchedule:[self scheduleWithID:@"unlikely" priority:0 trigger:[UAScheduleTrigger screenTriggerForScreenName:@"screen" count:1]]
+                                          block:prefetch(@"unlikely")];
+    [self.scheduler schedulePrefetchForSchedule:[self scheduleWithID:@"likely" priority:0 trigger:[UAScheduleTrigger foregroundTriggerWithCount:1]]
+                                          block:prefetch(@"likely")];
+
+    XCTAssertEqualObjects(@[@"running"], prefetched);
+    XCTAssertEqual(3, self.scheduler.pendingCount);
+
+    while (finishRunning) {
+        void (^finish)(void) = finishRunning;
+        finishRunning = nil;
+        finish();
+    }
+
+    NSArray *expected = @[@"running", @"likely", @"unlikely", @"low"];
+    XCTAssertEqualObjects(expected, prefetched);
+}
+
+- (void)testPrefetchDeferred {
+    __block NSUInteger prefetchCount = 0;
+    UAInAppMessageAssetPrefetchBlock block = ^(void (^completionHandler)(void)) {
+        prefetchCount++;
+        completionHandler();
+    };
+
+    // Cellular
+    self.connectionType = UAConnectionTypeCell;
+    [self.scheduler schedulePrefetchForSchedule:[self scheduleWithID:@"foo" priority:0 trigger:[UAScheduleTrigger foregroundTriggerWithCount:1]] block:block];
+    XCTAssertEqual(0, prefetchCount);
+
+    // Over the storage budget
+    self.connectionType = UAConnectionTypeWifi;
+    self.cachedSize = self.scheduler.storageBudget;
+    [self.notificationCenter postNotificationName:UAApplicationDidBecomeActiveNotification object:nil];
+    XCTAssertEqual(0, prefetchCount);
+
+    // Cancelled prefetches never run
+    [self.scheduler schedulePrefetchForSchedule:[self scheduleWithID:@"bar" priority:0 trigger:[UAScheduleTrigger foregroundTriggerWithCount:1]] block:block];
+    [self.scheduler cancelPrefetchForScheduleID:@"bar"];
+
+    self.cachedSize = 0;
+    [self.notificationCenter postNotificationName:UAApplicationDidBecomeActiveNotification object:nil];
+    XCTAssertEqual(1, prefetchCount);
+    XCTAssertEqual(0, self.scheduler.pendingCount);
+}
+
+- (UASchedule *)scheduleWithID:(NSString *)scheduleID priority:(NSInteger)priority trigger:(UAScheduleTrigger *)trigger {
+    UAInAppMessage *message = [UAInAppMessage messageWithBuilderBlock:^(UAInAppMessageBuilder *builder) {
+        builder.displayContent = [UAInAppMessageCustomDisplayContent displayContentWithValue:@{}];
+    }];
+
+    return [UAInAppMessageSchedule scheduleWithMessage:message builderBlock:^(UAScheduleBuilder *builder) {
+        builder.triggers = @[trigger];
+        builder.identifier = scheduleID;
+        builder.priority = priority;
+    }];
+}
+
+@end
@@ -0,0 +1,141 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAInAppMessageAssetStore+Internal.h"
+
+@interface UAInAppMessageAssetStoreTest : UABaseTest
+@property (nonatomic, strong) NSURL *rootURL;
+@property (nonatomic, strong) UAInAppMessageAssetStore *store;
+@property (nonatomic, strong) NSData *assetData;
+@end
+
+@implementation UAInAppMessageAssetStoreTest
+
+- (void)setUp {
+    [super setUp];
+
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"com.urbanairship.test.iamassetstore"];
+    self.rootURL = [NSURL fileURLWithPath:path];
+    [[NSFileManager defaultManager] removeItemAtURL:self.rootURL error:nil];
+
+    self.assetData = [@"asset" dataUsingEncoding:NSUTF8StringEncoding];
+    self.store = [UAInAppMessageAssetStore storeWithRootURL:self.rootURL maxCacheSize:NSUIntegerMax];
+    XCTAssertNotNil(self.store);
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtURL:self.rootURL error:nil];
+    [super tearDown];
+}
+
+/**
+ * Test schedules referencing the same asset share a single file.
+ */
+- (void)testAssetsAreSharedAcrossSchedules {
+    NSString *key = [UAInAppMessageAssetStore keyForAssetURL:[NSURL URLWithString:@"https://example.com/hero.png"]];
+
+    NSURL *fileURL1 = [self.store fileURLForKey:key scheduleID:@"schedule-1"];
+    NSURL *fileURL2 = [self.store fileURLForKey:key scheduleID:@"schedule-2"];
+    XCTAssertEqualObjects(fileURL1, fileURL2);
+
+    [self.assetData writeToURL:fileURL1 atomically:YES];
+    XCTAssertTrue([self.store isCachedForKey:key scheduleID:@"schedule-2"]);
+    XCTAssertEqual(self.assetData.length, self.store.totalSize);
+
+    // Still referenced by the second schedule
+    [self.store removeReferencesForScheduleID:@"schedule-1"];
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:fileURL1.path]);
+
+    [self.store removeReferencesForScheduleID:@"schedule-2"];
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:fileURL1.path]);
+    XCTAssertEqual(0, self.store.totalSize);
+}
+
+/**
+ * Test a new version of a schedule keeps the assets it still uses.
+ */
+- (void)testRemoveReferencesExceptKeys {
+    NSString *unchanged = [self cacheAsset:@"https://example.com/hero.png" scheduleID:@"schedule-1"];
+    NSString *replaced = [self cacheAsset:@"https://example.com/old.png" scheduleID:@"schedule-1"];
+
+    [self.store removeReferencesForScheduleID:@"schedule-1" exceptKeys:[NSSet setWithObject:unchanged]];
+
+    XCTAssertTrue([self.store isCachedForKey:unchanged scheduleID:@"schedule-1"]);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[self.store fileURLForKey:replaced scheduleID:@"schedule-1"].path]);
+    XCTAssertEqual(self.assetData.length, self.store.totalSize);
+}
+
+/**
+ * Test the least recently used inactive assets are evicted when over the max size.
+ */
+- (void)testEvictsLeastRecentlyUsed {
+    self.store.maxCacheSize = self.assetData.length * 2;
+
+    NSString *first = [self cacheAsset:@"https://example.com/1.png" scheduleID:@"schedule-1"];
+    NSString *second = [self cacheAsset:@"https://example.com/2.png" scheduleID:@"schedule-2"];
+
+    // Active schedules are never evicted
+    [self.store activateScheduleID:@"schedule-1"];
+
+    [self cacheAsset:@"https://example.com/3.png" scheduleID:@"schedule-3"];
+
+    XCTAssertTrue([self.store isCachedForKey:first scheduleID:@"schedule-1"]);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[self.store fileURLForKey:second scheduleID:@"schedule-2"].path]);
+    XCTAssertEqual(self.assetData.length * 2, self.store.totalSize);
+}
+
+/**
+ * Test the index survives recreating the store.
+ */
+- (void)testIndexIsPersisted {
+    NSString *key = [self cacheAsset:@"https://example.com/hero.png" scheduleID:@"schedule-1"];
+
+    UAInAppMessageAssetStore *store = [UAInAppMessageAssetStore storeWithRootURL:self.rootURL maxCacheSize:NSUIntegerMax];
+    XCTAssertEqual(self.assetData.length, store.totalSize);
+    XCTAssertTrue([store isCachedForKey:key scheduleID:@"schedule-1"]);
+
+    [store removeReferencesForScheduleID:@"schedule-1"];
+    XCTAssertEqual(0, store.totalSize);
+}
+
+/**
+ * Test asset files removed while the app was not running are dropped from the index on load.
+ */
+- (void)testMissingFilesDroppedOnLoad {
+    NSString *key = [self cacheAsset:@"https://example.com/hero.png" scheduleID:@"schedule-1"];
+    [[NSFileManager defaultManager] removeItemAtURL:[self.store fileURLForKey:key scheduleID:@"schedule-1"] error:nil];
+
+    UAInAppMessageAssetStore *store = [UAInAppMessageAssetStore storeWithRootURL:self.rootURL maxCacheSize:NSUIntegerMax];
+    XCTAssertEqual(0, store.totalSize);
+    XCTAssertFalse([store isCachedForKey:key scheduleID:@"schedule-1"]);
+}
+
+/**
+ * Test the legacy per schedule directories are removed the first time the store opens its directory.
+ */
+- (void)testLegacyScheduleDirectoriesRemovedOnce {
+    [[NSFileManager defaultManager] removeItemAtURL:self.rootURL error:nil];
+
+    NSURL *legacyURL = [self.rootURL URLByAppendingPathComponent:@"schedule-1"];
+    [[NSFileManager defaultManager] createDirectoryAtURL:legacyURL withIntermediateDirectories:YES attributes:nil error:nil];
+
+    UAInAppMessageAssetStore *store = [UAInAppMessageAssetStore storeWithRootURL:self.rootURL maxCacheSize:NSUIntegerMax];
+    XCTAssertNotNil(store);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:legacyURL.path]);
+
+    // Already migrated, the directory is not listed again
+    [[NSFileManager defaultManager] createDirectoryAtURL:legacyURL withIntermediateDirectories:YES attributes:nil error:nil];
+    store = [UAInAppMessageAssetStore storeWithRootURL:self.rootURL maxCacheSize:NSUIntegerMax];
+    XCTAssertNotNil(store);
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:legacyURL.path]);
+}
+
+- (NSString *)cacheAsset:(NSString *)assetURL scheduleID:(NSString *)scheduleID {
+    NSString *key = [UAInAppMessageAssetStore keyForAssetURL:[NSURL URLWithString:assetURL]];
+    NSURL *fileURL = [self.store fileURLForKey:key scheduleID:scheduleID];
+    [self.assetData writeToURL:fileURL atomically:YES];
+    XCTAssertTrue([self.store isCachedForKey:key scheduleID:scheduleID]);
+    return key;
+}
+
+@end
@@ -2,11 +2,13 @@
 
 #import "UABaseTest.h"
 #import "UAInAppMessageAssets+Internal.h"
+#import "UAInAppMessageAssetStore+Internal.h"
 
 @interface UAInAppMessageAssetsTest : UABaseTest
 
 @property (nonatomic, copy) NSString *assetCachePath;
 @property (nonatomic, strong) NSURL *rootURL;
+@property (nonatomic, strong) UAInAppMessageAssetStore *store;
 @property (nonatomic, strong) UAInAppMessageAssets *assets;
 
 @end
@@ -22,7 +24,10 @@
     
     self.rootURL = [NSURL fileURLWithPath:self.assetCachePath];
     
-    self.assets = [UAInAppMessageAssets assets:self.rootURL];
+    self.store = [UAInAppMessageAssetStore storeWithRootURL:self.rootURL maxCacheSize:NSUIntegerMax];
+    XCTAssertNotNil(self.store);
+
+    self.assets = [UAInAppMessageAssets assetsWithScheduleID:@"schedule-id" store:self.store];
     XCTAssertNotNil(self.assets);
 }
 
@@ -35,16 +40,16 @@
 #pragma mark -
 #pragma mark Tests
 
-// Fail gracefully when an asset instance is created with a bad root url
-- (void)testCreateAssetsBadRootDirectory {
+// Fail gracefully when a store is created with a bad root url
+- (void)testCreateStoreBadRootDirectory {
     // SETUP
     NSURL *badRootURL = [NSURL URLWithString:@"/badroot"];
     
     // TEST
-    UAInAppMessageAssets *assets = [UAInAppMessageAssets assets:badRootURL];
+    UAInAppMessageAssetStore *store = [UAInAppMessageAssetStore storeWithRootURL:badRootURL maxCacheSize:NSUIntegerMax];
     
     // VERIFY
-    XCTAssertNil(assets);
+    XCTAssertNil(store);
 }
 
 /**
@@ -55,7 +60,7 @@
     self.assets = nil;
     
     // TEST
-    self.assets = [UAInAppMessageAssets assets:self.rootURL];
+    self.assets = [UAInAppMessageAssets assetsWithScheduleID:@"schedule-id" store:self.store];
     
     // VERIFY
     XCTAssertNotNil(self.assets);
@@ -63,7 +68,7 @@
 
 /**
  * Get several cache URLs and make sure they are unique and a part
- * of the provided root
+ * of the store's assets directory
  */
 - (void)testGetCacheURL {
     // SETUP
@@ -88,7 +93,7 @@
     XCTAssertNotNil(rootURL1);
     XCTAssertNotNil(rootURL2);
     XCTAssertEqualObjects(rootURL1, rootURL2);
-    XCTAssertEqualObjects([self.rootURL path], [rootURL1 path]);
+    XCTAssertEqualObjects([[self.rootURL URLByAppendingPathComponent:@"assets"] path], [rootURL1 path]);
 }
 
 - (void)testClearAssetsNoAssets {
@@ -96,7 +101,8 @@
     [self.assets clearAssets];
     
     // VERIFY
-    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[self.rootURL path]]);
+    XCTAssertEqual(0, self.store.totalSize);
+    XCTAssertNil([self.assets getCacheURL:[NSURL URLWithString:@"https://www.google.com/"]]);
 }
 
 - (void)testClearAssetsTwice {
@@ -104,13 +110,13 @@
     [self.assets clearAssets];
     
     // VERIFY
-    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[self.rootURL path]]);
+    XCTAssertEqual(0, self.store.totalSize);
 
     // TEST
     [self.assets clearAssets];
     
     // VERIFY
-    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[self.rootURL path]]);
+    XCTAssertEqual(0, self.store.totalSize);
 }
 
 - (void)testClearAssetsSomeAssetsAreCached {
@@ -153,16 +159,13 @@
     XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[mediaCacheURL path]]);
     XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[alternateMediaCacheURL path]]);
 
-    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[self.rootURL path]]);
+    XCTAssertEqual(0, self.store.totalSize);
 }
 
 - (void)testClearAssetsThenAddAssets {
     // SETUP
     [self.assets clearAssets];
     
-    // VERIFY
-    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[self.rootURL path]]);
-    
     // Get file system URLs for test images
     NSBundle *bundle = [NSBundle bundleForClass:[self class]];
     NSURL *mediaURL = [bundle URLForResource:@"airship" withExtension:@"jpg"];
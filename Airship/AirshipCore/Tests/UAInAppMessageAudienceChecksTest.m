@@ -226,8 +226,9 @@
     NSMutableArray<NSString *> *tags = [NSMutableArray array];
     
     [[[self.mockChannel stub] andDo:^(NSInvocation *invocation) {
-        [invocation setReturnValue:(void *)&tags];
-    }] tags];
+        NSSet * __autoreleasing tagSet = [NSSet setWithArray:tags];
+        [invocation setReturnValue:(void *)&tagSet];
+    }] tagSet];
 
     UAScheduleAudience *audience = [UAScheduleAudience audienceWithBuilderBlock:^(UAScheduleAudienceBuilder * _Nonnull builder) {
         builder.tagSelector = [UATagSelector tag:@"expected tag"];
@@ -240,6 +241,26 @@
     XCTAssertTrue([UAScheduleAudienceChecks checkDisplayAudienceConditions:audience]);
 }
 
+- (void)testCachedResultInvalidatedByDeviceState {
+    __block NSSet *tagSet = [NSSet set];
+    [[[self.mockChannel stub] andDo:^(NSInvocation *invocation) {
+        [invocation setReturnValue:(void *)&tagSet];
+    }] tagSet];
+
+    UAScheduleAudience *audience = [UAScheduleAudience audienceWithBuilderBlock:^(UAScheduleAudienceBuilder * _Nonnull builder) {
+        builder.tagSelector = [UATagSelector tag:@"expected tag"];
+    }];
+
+    NSUInteger version = [UAScheduleAudienceChecks deviceStateVersion];
+    XCTAssertFalse([UAScheduleAudienceChecks checkDisplayAudienceConditions:audience]);
+    XCTAssertFalse([UAScheduleAudienceChecks checkDisplayAudienceConditions:audience]);
+    XCTAssertEqual(version, [UAScheduleAudienceChecks deviceStateVersion]);
+
+    tagSet = [NSSet setWithObject:@"expected tag"];
+    XCTAssertTrue([UAScheduleAudienceChecks checkDisplayAudienceConditions:audience]);
+    XCTAssertGreaterThan([UAScheduleAudienceChecks deviceStateVersion], version);
+}
+
 - (void)testTagSelectorWhenDataCollectionDisabled {
     self.isDataCollectionEnabled = NO;
 
@@ -247,8 +268,9 @@
     NSMutableArray<NSString *> *tags = [NSMutableArray array];
 
     [[[self.mockChannel stub] andDo:^(NSInvocation *invocation) {
-        [invocation setReturnValue:(void *)&tags];
-    }] tags];
+        NSSet * __autoreleasing tagSet = [NSSet setWithArray:tags];
+        [invocation setReturnValue:(void *)&tagSet];
+    }] tagSet];
 
     UAScheduleAudience *audience = [UAScheduleAudience audienceWithBuilderBlock:^(UAScheduleAudienceBuilder * _Nonnull builder) {
         builder.tagSelector = [UATagSelector tag:@"expected tag"];
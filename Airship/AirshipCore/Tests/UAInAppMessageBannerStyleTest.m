@@ -6,6 +6,7 @@
 #import "UAInAppMessageManager.h"
 #import "UAInAppMessageBannerAdapter.h"
 #import "UAInAppMessageBannerStyle.h"
+#import "UAInAppMessageUtils+Internal.h"
 
 @interface UAInAppMessageBannerStyleTest : UABaseTest
 
@@ -67,4 +68,19 @@
     XCTAssertEqualObjects(@26, validStyle.maxWidth);
 }
 
+- (void)testStyleFileIsCached {
+    NSDictionary *first = [UAInAppMessageUtils styleDictionaryWithContentsOfFile:@"Valid-UAInAppMessageBannerStyle"];
+    NSDictionary *second = [UAInAppMessageUtils styleDictionaryWithContentsOfFile:@"Valid-UAInAppMessageBannerStyle"];
+    XCTAssertNotNil(first);
+    XCTAssertTrue(first == second);
+
+    // Styles built from the cached plist are still separate objects
+    UAInAppMessageBannerStyle *style = [UAInAppMessageBannerStyle styleWithContentsOfFile:@"Valid-UAInAppMessageBannerStyle"];
+    UAInAppMessageBannerStyle *otherStyle = [UAInAppMessageBannerStyle styleWithContentsOfFile:@"Valid-UAInAppMessageBannerStyle"];
+    XCTAssertFalse(style == otherStyle);
+    XCTAssertEqualObjects(style.additionalPadding.top, otherStyle.additionalPadding.top);
+
+    XCTAssertNil([UAInAppMessageUtils styleDictionaryWithContentsOfFile:@"Missing-UAInAppMessageBannerStyle"]);
+}
+
 @end
@@ -1,7 +1,8 @@
 //* Copyright Airship and Contributors */
 
 #import "UABaseTest.h"
-#import "UAInAppMessageDefaultPrepareAssetsDelegate.h"
+#import "UAInAppMessageDefaultPrepareAssetsDelegate+Internal.h"
+#import "UAInAppMessageAssets+Internal.h"
 #import "UAInAppMessage+Internal.h"
 #import "UAInAppMessageBannerDisplayContent.h"
 
@@ -199,10 +200,10 @@
  */
 - (void)testOnPrepare5XXHTTPResponse {
     id mockURLSession = [self mockForClass:[NSURLSession class]];
-    [[[mockURLSession stub] andReturn:mockURLSession] sharedSession];
+    self.delegate = [UAInAppMessageDefaultPrepareAssetsDelegate delegateWithDownloader:[UAInAppMessageAssetDownloader downloaderWithSession:mockURLSession]];
     __block void (^completionHandler)(NSURL * _Nullable location, NSURLResponse * _Nullable response, NSError * _Nullable error);
     id mockDownloadTask = [self mockForClass:[NSURLSessionDownloadTask class]];
-    [[[mockURLSession stub] andReturn:mockDownloadTask] downloadTaskWithURL:OCMOCK_ANY completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
+    [[[mockURLSession stub] andReturn:mockDownloadTask] downloadTaskWithRequest:OCMOCK_ANY completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
         completionHandler = obj;
         return YES;
     }]];
@@ -244,10 +245,10 @@
  */
 - (void)testOnPrepareNon200HTTPResponse {
     id mockURLSession = [self mockForClass:[NSURLSession class]];
-    [[[mockURLSession stub] andReturn:mockURLSession] sharedSession];
+    self.delegate = [UAInAppMessageDefaultPrepareAssetsDelegate delegateWithDownloader:[UAInAppMessageAssetDownloader downloaderWithSession:mockURLSession]];
     __block void (^completionHandler)(NSURL * _Nullable location, NSURLResponse * _Nullable response, NSError * _Nullable error);
     id mockDownloadTask = [self mockForClass:[NSURLSessionDownloadTask class]];
-    [[[mockURLSession stub] andReturn:mockDownloadTask] downloadTaskWithURL:OCMOCK_ANY completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
+    [[[mockURLSession stub] andReturn:mockDownloadTask] downloadTaskWithRequest:OCMOCK_ANY completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
         completionHandler = obj;
         return YES;
     }]];
@@ -290,10 +291,10 @@
 - (void)testOnPrepareErrorRemovingPreviouslyCachedFile {
     // SETUP
     id mockURLSession = [self mockForClass:[NSURLSession class]];
-    [[[mockURLSession stub] andReturn:mockURLSession] sharedSession];
+    self.delegate = [UAInAppMessageDefaultPrepareAssetsDelegate delegateWithDownloader:[UAInAppMessageAssetDownloader downloaderWithSession:mockURLSession]];
     __block void (^completionHandler)(NSURL * _Nullable location, NSURLResponse * _Nullable response, NSError * _Nullable error);
     id mockDownloadTask = [self mockForClass:[NSURLSessionDownloadTask class]];
-    [[[mockURLSession stub] andReturn:mockDownloadTask] downloadTaskWithURL:OCMOCK_ANY completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
+    [[[mockURLSession stub] andReturn:mockDownloadTask] downloadTaskWithRequest:OCMOCK_ANY completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
         completionHandler = obj;
         return YES;
     }]];
@@ -343,10 +344,10 @@
 - (void)testOnPrepareErrorMovingFileToCache {
     // SETUP
     id mockURLSession = [self mockForClass:[NSURLSession class]];
-    [[[mockURLSession stub] andReturn:mockURLSession] sharedSession];
+    self.delegate = [UAInAppMessageDefaultPrepareAssetsDelegate delegateWithDownloader:[UAInAppMessageAssetDownloader downloaderWithSession:mockURLSession]];
     __block void (^completionHandler)(NSURL * _Nullable location, NSURLResponse * _Nullable response, NSError * _Nullable error);
     id mockDownloadTask = [self mockForClass:[NSURLSessionDownloadTask class]];
-    [[[mockURLSession stub] andReturn:mockDownloadTask] downloadTaskWithURL:OCMOCK_ANY completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
+    [[[mockURLSession stub] andReturn:mockDownloadTask] downloadTaskWithRequest:OCMOCK_ANY completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
         completionHandler = obj;
         return YES;
     }]];
@@ -396,8 +397,8 @@
 - (void)testOnPrepareAssetsCannotGenerateCacheURL {
     // SETUP
     id mockURLSession = [self mockForClass:[NSURLSession class]];
-    [[mockURLSession reject] sharedSession];
-    [[mockURLSession reject] downloadTaskWithURL:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    [[mockURLSession reject] downloadTaskWithRequest:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    self.delegate = [UAInAppMessageDefaultPrepareAssetsDelegate delegateWithDownloader:[UAInAppMessageAssetDownloader downloaderWithSession:mockURLSession]];
 
     // EXPECTATIONS
     [[[self.mockAssets expect] andReturn:nil] getCacheURL:[OCMArg checkWithBlock:^BOOL(id obj) {
@@ -426,6 +427,126 @@
     XCTAssertEqual([listOfFiles count],0);
 }
 
+/**
+ * test onPrepare:assets: revalidates a stale cached asset and keeps it on a 304 response.
+ */
+- (void)testOnPrepareRevalidatesStaleAsset {
+    // SETUP
+    id mockURLSession = [self mockForClass:[NSURLSession class]];
+    self.delegate = [UAInAppMessageDefaultPrepareAssetsDelegate delegateWithDownloader:[UAInAppMessageAssetDownloader downloaderWithSession:mockURLSession]];
+    __block void (^completionHandler)(NSURL * _Nullable location, NSURLResponse * _Nullable response, NSError * _Nullable error);
+    id mockDownloadTask = [self mockForClass:[NSURLSessionDownloadTask class]];
+    [[[mockURLSession expect] andReturn:mockDownloadTask] downloadTaskWithRequest:[OCMArg checkWithBlock:^BOOL(id obj) {
+        NSURLRequest *request = obj;
+        return [[request valueForHTTPHeaderField:@"If-None-Match"] isEqualToString:@"some-etag"];
+    }] completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
+        completionHandler = obj;
+        return YES;
+    }]];
+    id mockURLResponse = [self mockForClass:[NSHTTPURLResponse class]];
+    [[[mockURLResponse stub] andReturnValue:OCMOCK_VALUE(304)] statusCode];
+    [[[mockDownloadTask stub] andDo:^(NSInvocation *invocation) {
+        completionHandler(nil, mockURLResponse, nil);
+    }] resume];
+
+    [[[self.mockAssets stub] andReturnValue:OCMOCK_VALUE(YES)] isCached:self.mediaURL];
+    [[[self.mockAssets stub] andReturn:@{@"ETag": @"some-etag"}] validatorsForAsset:self.mediaURL];
+    [[[self.mockAssets stub] andReturn:[NSDate distantPast]] lastValidatedForAsset:self.mediaURL];
+    [[[self.mockAssets stub] andReturn:self.cachedAssetURL] getCacheURL:self.mediaURL];
+
+    // EXPECTATIONS
+    [[self.mockAssets expect] assetValidated:self.mediaURL];
+
+    // TEST
+    XCTestExpectation *onPrepareComplete = [self expectationWithDescription:@"onPrepare completionHandler called"];
+    [self.delegate onPrepare:self.messageWithMedia assets:self.mockAssets completionHandler:^(UAInAppMessagePrepareResult result) {
+        XCTAssertEqual(result, UAInAppMessagePrepareResultSuccess);
+        [onPrepareComplete fulfill];
+    }];
+
+    [self waitForTestExpectations];
+
+    // VERIFY
+    [self.mockAssets verify];
+    [mockURLSession verify];
+}
+
+/**
+ * test onPrepare:assets: retries an interrupted download and resumes it on the next attempt.
+ */
+- (void)testOnPrepareResumesInterruptedDownload {
+    // SETUP
+    id mockURLSession = [self mockForClass:[NSURLSession class]];
+    self.delegate = [UAInAppMessageDefaultPrepareAssetsDelegate delegateWithDownloader:[UAInAppMessageAssetDownloader downloaderWithSession:mockURLSession]];
+    NSData *resumeData = [@"resume" dataUsingEncoding:NSUTF8StringEncoding];
+
+    __block void (^completionHandler)(NSURL * _Nullable location, NSURLResponse * _Nullable response, NSError * _Nullable error);
+    id mockDownloadTask = [self mockForClass:[NSURLSessionDownloadTask class]];
+    [[[mockURLSession stub] andReturn:mockDownloadTask] downloadTaskWithRequest:OCMOCK_ANY completionHandler:[OCMArg checkWithBlock:^BOOL(id obj) {
+        completionHandler = obj;
+        return YES;
+    }]];
+    [[[mockDownloadTask stub] andDo:^(NSInvocation *invocation) {
+        NSError *error = [NSError errorWithDomain:NSURLErrorDomain
+                                             code:NSURLErrorNetworkConnectionLost
+                                         userInfo:@{NSURLSessionDownloadTaskResumeData : resumeData}];
+        completionHandler(nil, nil, error);
+    }] resume];
+
+    [[[self.mockAssets stub] andReturn:self.cachedAssetURL] getCacheURL:self.mediaURL];
+
+    // TEST
+    XCTestExpectation *onPrepareComplete = [self expectationWithDescription:@"onPrepare completionHandler called"];
+    [self.delegate onPrepare:self.messageWithMedia assets:self.mockAssets completionHandler:^(UAInAppMessagePrepareResult result) {
+        XCTAssertEqual(result, UAInAppMessagePrepareResultRetry);
+        [onPrepareComplete fulfill];
+    }];
+
+    [self waitForTestExpectations];
+
+    // EXPECTATIONS
+    [[[mockURLSession expect] andReturn:[self mockForClass:[NSURLSessionDownloadTask class]]] downloadTaskWithResumeData:resumeData completionHandler:OCMOCK_ANY];
+
+    // TEST
+    [self.delegate onPrepare:self.messageWithMedia assets:self.mockAssets completionHandler:^(UAInAppMessagePrepareResult result) {}];
+
+    // VERIFY
+    [mockURLSession verify];
+}
+
+/**
+ * Test media already in the shared media cache is not downloaded again.
+ */
+- (void)testOnPrepareUsesSharedMediaCache {
+    // SETUP
+    NSURL *sharedDirectoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    UAInAppMessageSharedMediaCache *sharedMediaCache = [UAInAppMessageSharedMediaCache cacheWithDirectoryURL:sharedDirectoryURL];
+    [sharedMediaCache storeFile:self.mediaURL forURL:self.mediaURL];
+
+    id mockURLSession = [self strictMockForClass:[NSURLSession class]];
+    self.delegate = [UAInAppMessageDefaultPrepareAssetsDelegate delegateWithDownloader:[UAInAppMessageAssetDownloader downloaderWithSession:mockURLSession]
+                                                                      sharedMediaCache:sharedMediaCache];
+
+    [[[self.mockAssets stub] andReturn:self.cachedAssetURL] getCacheURL:self.mediaURL];
+
+    // EXPECTATIONS
+    [[self.mockAssets expect] assetCached:self.mediaURL validators:nil];
+
+    // TEST
+    XCTestExpectation *onPrepareComplete = [self expectationWithDescription:@"onPrepare completionHandler called"];
+    [self.delegate onPrepare:self.messageWithMedia assets:self.mockAssets completionHandler:^(UAInAppMessagePrepareResult result) {
+        XCTAssertEqual(result, UAInAppMessagePrepareResultSuccess);
+        [onPrepareComplete fulfill];
+    }];
+
+    [self waitForTestExpectations];
+
+    // VERIFY
+    [self.mockAssets verify];
+    XCTAssertTrue([[NSFileManager defaultManager] contentsEqualAtPath:self.cachedAssetURL.path andPath:self.mediaURL.path]);
+
+    [[NSFileManager defaultManager] removeItemAtURL:sharedDirectoryURL error:nil];
+}
 
 #pragma mark -
 #pragma mark Utilities
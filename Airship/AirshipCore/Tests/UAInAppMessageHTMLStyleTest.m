@@ -36,5 +36,6 @@
     XCTAssertEqualObjects(@28, validStyle.maxWidth);
     XCTAssertEqualObjects(@29, validStyle.maxHeight);
     XCTAssertTrue(validStyle.hideDismissIcon);
+    XCTAssertTrue(validStyle.preloadContent);
 }
 @end
@@ -277,6 +277,39 @@ NSString * const UAInAppMessageManagerTestScheduleID = @"schedule ID";
     XCTAssertEqual(UAAutomationScheduleReadyResultNotReady, [self.manager isReadyToDisplay:UAInAppMessageManagerTestScheduleID]);
 }
 
+- (void)testCoordinatorReadyQueue {
+    [self testPrepare];
+
+    __block UAAnonymousKVOBlock readyBlock;
+    [[[[self.mockDefaultDisplayCoordinator stub] andReturn:[UADisposable disposableWithBlock:^{}]] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:3];
+        readyBlock = [(__bridge UAAnonymousKVOBlock)arg copy];
+    }] observeAtKeyPath:UAInAppMessageDisplayCoordinatorIsReadyKey withBlock:OCMOCK_ANY];
+
+    id mockExecutionDelegate = [self mockForProtocol:@protocol(UAInAppMessagingExecutionDelegate)];
+    self.manager.executionDelegate = mockExecutionDelegate;
+
+    [[[self.mockAdapter stub] andReturnValue:@(YES)] isReadyToDisplay];
+    [[[self.mockDefaultDisplayCoordinator stub] andReturnValue:@(NO)] isReady];
+    XCTAssertEqual(UAAutomationScheduleReadyResultNotReady, [self.manager isReadyToDisplay:UAInAppMessageManagerTestScheduleID]);
+    XCTAssertEqual(UAAutomationScheduleReadyResultNotReady, [self.manager isReadyToDisplay:UAInAppMessageManagerTestScheduleID]);
+
+    // Only the queued schedules are handed back, once each
+    [[mockExecutionDelegate expect] executionReadinessChangedForScheduleIDs:@[UAInAppMessageManagerTestScheduleID]];
+    readyBlock(@(YES));
+    [mockExecutionDelegate verify];
+
+    // Cancelled schedules are dropped from the queue
+    XCTAssertEqual(UAAutomationScheduleReadyResultNotReady, [self.manager isReadyToDisplay:UAInAppMessageManagerTestScheduleID]);
+    [[self.mockAssetManager stub] onScheduleFinished:UAInAppMessageManagerTestScheduleID];
+    [self.manager messageCancelled:self.message scheduleID:UAInAppMessageManagerTestScheduleID];
+
+    [[mockExecutionDelegate expect] executionReadinessChangedForScheduleIDs:@[]];
+    readyBlock(@(YES));
+    [mockExecutionDelegate verify];
+}
+
 - (void)testIsReadyToDisplayAdapterNotReady {
     [self testPrepare];
 
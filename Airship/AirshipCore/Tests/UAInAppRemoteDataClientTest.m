@@ -16,6 +16,7 @@
 #import "UAInappMessageSchedule.h"
 #import "UADeferredSchedule+Internal.h"
 #import "UAInAppMessageCustomDisplayContent.h"
+#import "UAFrequencyConstraint+Internal.h"
 
 @interface UAInAppRemoteDataClientTest : UAAirshipBaseTest
 @property (nonatomic,strong) UAInAppRemoteDataClient *remoteDataClient;
@@ -119,7 +120,7 @@
     [[[self.mockDelegate expect] andDo:^(NSInvocation *invocation) {
         callsToScheduleMessages++;
         void *arg;
-        [invocation getArgument:&arg atIndex:2];
+        [invocation getArgument:&arg atIndex:3];
         NSArray<UASchedule *> *schedules = (__bridge NSArray<UASchedule *> *)arg;
 
         for (UASchedule *schedule in schedules) {
@@ -128,12 +129,12 @@
 
         XCTAssertEqual(schedules.count, expectedNumberOfSchedules);
 
-        [invocation getArgument:&arg atIndex:3];
+        [invocation getArgument:&arg atIndex:4];
         void (^completionHandler)(BOOL) = (__bridge void (^)(BOOL))arg;
 
         [self.allSchedules addObjectsFromArray:schedules];
         completionHandler(YES);
-    }] scheduleMultiple:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    }] updateSchedulesWithEdits:OCMOCK_ANY newSchedules:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
     // test
     self.publishBlock(@[inAppRemoteDataPayload]);
@@ -144,16 +145,17 @@
     XCTAssertEqual(callsToScheduleMessages, 1);
 
     XCTestExpectation *editCalled = [self expectationWithDescription:@"Edit call should be made for metadata change"];
+    NSString *scheduleID = self.allSchedules[0].identifier;
     [[[self.mockDelegate expect] andDo:^(NSInvocation *invocation) {
         void *arg;
         [invocation getArgument:&arg atIndex:4];
-        void (^completionHandler)(UASchedule *) = (__bridge void (^)(UASchedule *))arg;
-        completionHandler(self.allSchedules[0]);
+        void (^completionHandler)(BOOL) = (__bridge void (^)(BOOL))arg;
+        completionHandler(YES);
         [editCalled fulfill];
-    }] editScheduleWithID:self.allSchedules[0].identifier edits:[OCMArg checkWithBlock:^BOOL(id obj) {
-        UAScheduleEdits *edits = obj;
-        return [edits.metadata isEqualToDictionary:expectedSceduleMetadataB];
-    }] completionHandler:OCMOCK_ANY];
+    }] updateSchedulesWithEdits:[OCMArg checkWithBlock:^BOOL(id obj) {
+        NSDictionary<NSString *, UAScheduleEdits *> *edits = obj;
+        return edits.count == 1 && [edits[scheduleID].metadata isEqualToDictionary:expectedSceduleMetadataB];
+    }] newSchedules:@[] completionHandler:OCMOCK_ANY];
 
     // setup to same message with metadata B
     inAppRemoteDataPayload = [[UARemoteDataPayload alloc] initWithType:@"in_app_messages"
@@ -171,8 +173,58 @@
 }
 
 
+- (void)testFrequencyConstraints {
+    NSDictionary *message = @{@"message": @{
+                                      @"name": @"Simple Message",
+                                      @"message_id": [NSUUID UUID].UUIDString,
+                                      @"display_type": @"banner",
+                                      @"display": @{
+                                              @"body" : @{
+                                                      @"text" : @"hi there"
+                                              },
+                                      },
+    },
+                              @"created": @"2017-12-04T19:07:54.564",
+                              @"last_updated": @"2017-12-04T19:07:54.564",
+                              @"frequency_constraint_ids": @[@"daily"],
+                              @"triggers": @[
+                                      @{
+                                          @"type":@"app_init",
+                                          @"goal":@1
+                                      }
+                              ]
+    };
+
+    NSDictionary *data = @{@"in_app_messages": @[message],
+                           @"frequency_constraints": @[@{@"id": @"daily", @"range": @86400, @"boundary": @2},
+                                                       @{@"id": @"invalid"}]};
+
+    UARemoteDataPayload *payload = [[UARemoteDataPayload alloc] initWithType:@"in_app_messages"
+                                                                   timestamp:[NSDate date]
+                                                                        data:data
+                                                                    metadata:@{}];
+
+    NSArray *expectedConstraints = @[[UAFrequencyConstraint constraintWithIdentifier:@"daily" range:86400 count:2]];
+    [[self.mockDelegate expect] updateFrequencyConstraints:expectedConstraints];
+
+    [[[self.mockDelegate expect] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        void (^completionHandler)(BOOL) = (__bridge void (^)(BOOL))arg;
+        completionHandler(YES);
+    }] updateSchedulesWithEdits:OCMOCK_ANY newSchedules:[OCMArg checkWithBlock:^BOOL(id obj) {
+        NSArray<UASchedule *> *schedules = obj;
+        return schedules.count == 1 && [schedules[0].frequencyConstraintIDs isEqualToArray:@[@"daily"]];
+    }] completionHandler:OCMOCK_ANY];
+
+    self.publishBlock(@[payload]);
+    [self.queue waitUntilAllOperationsAreFinished];
+
+    [self.mockDelegate verifyWithDelay:1];
+}
+
 - (void)testMissingInAppMessageRemoteData {
-    [[self.mockDelegate reject] scheduleMultiple:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    [[self.mockDelegate reject] updateSchedulesWithEdits:OCMOCK_ANY newSchedules:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
     self.publishBlock(@[]);
     [self.queue waitUntilAllOperationsAreFinished];
@@ -184,7 +236,7 @@
                                                                                        data:@{@"in_app_messages":@[]}
                                                                                    metadata:@{@"cool" : @"story"}];
 
-    [[self.mockDelegate reject] scheduleMultiple:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+    [[self.mockDelegate reject] updateSchedulesWithEdits:OCMOCK_ANY newSchedules:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
     self.publishBlock(@[inAppRemoteDataPayload]);
     [self.queue waitUntilAllOperationsAreFinished];
@@ -226,17 +278,17 @@
         callsToScheduleMessages++;
 
         void *arg;
-        [invocation getArgument:&arg atIndex:2];
+        [invocation getArgument:&arg atIndex:3];
         NSArray<UASchedule *> *schedules = (__bridge NSArray<UASchedule *> *)arg;
 
         XCTAssertEqual(schedules.count, 1);
 
-        [invocation getArgument:&arg atIndex:3];
-        void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
+        [invocation getArgument:&arg atIndex:4];
+        void (^completionHandler)(BOOL) = (__bridge void (^)(BOOL))arg;
 
         [self.allSchedules addObjectsFromArray:schedules];
-        completionHandler(self.allSchedules);
-    }] scheduleMultiple:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+        completionHandler(YES);
+    }] updateSchedulesWithEdits:OCMOCK_ANY newSchedules:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
     // test
     self.publishBlock(@[inAppRemoteDataPayload]);
@@ -284,17 +336,17 @@
         callsToScheduleMessages++;
 
         void *arg;
-        [invocation getArgument:&arg atIndex:2];
+        [invocation getArgument:&arg atIndex:3];
         NSArray<UASchedule *> *schedules = (__bridge NSArray<UASchedule *> *)arg;
 
         XCTAssertEqual(schedules.count, expectedNumberOfScheduleInfos);
 
-        [invocation getArgument:&arg atIndex:3];
-        void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
+        [invocation getArgument:&arg atIndex:4];
+        void (^completionHandler)(BOOL) = (__bridge void (^)(BOOL))arg;
 
         [self.allSchedules addObjectsFromArray:schedules];
-        completionHandler(self.allSchedules);
-    }] scheduleMultiple:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+        completionHandler(YES);
+    }] updateSchedulesWithEdits:OCMOCK_ANY newSchedules:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
     // test
     self.publishBlock(@[inAppRemoteDataPayload]);
@@ -312,6 +364,72 @@
     XCTAssertEqual(callsToScheduleMessages,1);
 }
 
+- (void)testFailedUpdateIsRetried {
+    // setup
+    NSDictionary *simpleMessage = @{@"message": @{
+                                            @"name": @"Simple Message",
+                                            @"message_id": [NSUUID UUID].UUIDString,
+                                            @"push_id": [NSUUID UUID].UUIDString,
+                                            @"display_type": @"banner",
+                                            @"display": @{
+                                                    @"body" : @{
+                                                            @"text" : @"hi there"
+                                                    },
+                                            },
+    },
+                                    @"created": @"2017-12-04T19:07:54.564",
+                                    @"last_updated": @"2017-12-04T19:07:54.564",
+                                    @"triggers": @[
+                                            @{
+                                                @"type":@"app_init",
+                                                @"goal":@1
+                                            }
+                                    ]
+    };
+
+    UARemoteDataPayload *inAppRemoteDataPayload = [[UARemoteDataPayload alloc] initWithType:@"in_app_messages"
+                                                                                  timestamp:[NSDate date]
+                                                                                       data:@{@"in_app_messages":@[simpleMessage]}
+                                                                                   metadata:@{@"cool" : @"story"}];
+
+    // expectations
+    __block NSUInteger callsToScheduleMessages = 0;
+    __block BOOL updateResult = NO;
+    [[[self.mockDelegate stub] andDo:^(NSInvocation *invocation) {
+        callsToScheduleMessages++;
+
+        void *arg;
+        [invocation getArgument:&arg atIndex:3];
+        NSArray<UASchedule *> *schedules = (__bridge NSArray<UASchedule *> *)arg;
+        XCTAssertEqual(1, schedules.count);
+
+        [invocation getArgument:&arg atIndex:4];
+        void (^completionHandler)(BOOL) = (__bridge void (^)(BOOL))arg;
+
+        if (updateResult) {
+            [self.allSchedules addObjectsFromArray:schedules];
+        }
+        completionHandler(updateResult);
+    }] updateSchedulesWithEdits:OCMOCK_ANY newSchedules:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    // test
+    self.publishBlock(@[inAppRemoteDataPayload]);
+    [self.queue waitUntilAllOperationsAreFinished];
+
+    // verify the state is not saved
+    XCTAssertEqual(1, callsToScheduleMessages);
+    XCTAssertNil([self.dataStore objectForKey:@"UAInAppRemoteDataClient.LastPayloadTimeStamp"]);
+
+    // test the same payload is processed again
+    updateResult = YES;
+    self.publishBlock(@[inAppRemoteDataPayload]);
+    [self.queue waitUntilAllOperationsAreFinished];
+
+    // verify
+    XCTAssertEqual(2, callsToScheduleMessages);
+    XCTAssertEqualObjects(inAppRemoteDataPayload.timestamp, [self.dataStore objectForKey:@"UAInAppRemoteDataClient.LastPayloadTimeStamp"]);
+}
+
 - (void)testSameMessageSentTwice {
     // setup
     NSString *messageID = [NSUUID UUID].UUIDString;
@@ -348,18 +466,18 @@
         callsToScheduleMessages++;
 
         void *arg;
-        [invocation getArgument:&arg atIndex:2];
+        [invocation getArgument:&arg atIndex:3];
         NSArray<UASchedule *> *schedules = (__bridge NSArray<UASchedule *> *)arg;
 
         XCTAssertEqual(schedules.count, expectedNumberOfScheduleInfos);
 
-        [invocation getArgument:&arg atIndex:3];
-        void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
+        [invocation getArgument:&arg atIndex:4];
+        void (^completionHandler)(BOOL) = (__bridge void (^)(BOOL))arg;
 
         [self.allSchedules addObjectsFromArray:schedules];
 
-        completionHandler(self.allSchedules);
-    }] scheduleMultiple:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+        completionHandler(YES);
+    }] updateSchedulesWithEdits:OCMOCK_ANY newSchedules:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
 
     // test
@@ -442,36 +560,26 @@
     [[[self.mockDelegate stub] andDo:^(NSInvocation *invocation) {
         void *arg;
         [invocation getArgument:&arg atIndex:2];
-        NSArray<UASchedule *> *schedules = (__bridge NSArray<UASchedule *> *)arg;
+        NSDictionary<NSString *, UAScheduleEdits *> *scheduleEdits = (__bridge NSDictionary<NSString *, UAScheduleEdits *> *)arg;
 
-        scheduledMessages += schedules.count;
+        for (UAScheduleEdits *edits in scheduleEdits.allValues) {
+            if ([edits.end isEqualToDate:inAppRemoteDataPayload.timestamp]) {
+                cancelledMessages += 1;
+            } else {
+                editedMessages += 1;
+            }
+        }
 
         [invocation getArgument:&arg atIndex:3];
-        void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
+        NSArray<UASchedule *> *schedules = (__bridge NSArray<UASchedule *> *)arg;
 
+        scheduledMessages += schedules.count;
         [self.allSchedules addObjectsFromArray:schedules];
 
-        completionHandler(self.allSchedules);
-    }] scheduleMultiple:OCMOCK_ANY completionHandler:OCMOCK_ANY];
-
-    [[[self.mockDelegate stub] andDo:^(NSInvocation *invocation) {
-        void *arg;
-
-        [invocation getArgument:&arg atIndex:2];
-        NSString *scheduleID = (__bridge NSString *)arg;
-
-        [invocation getArgument:&arg atIndex:3];
-        UAScheduleEdits *edits = (__bridge UAScheduleEdits *)arg;
-        if ([edits.end isEqualToDate:inAppRemoteDataPayload.timestamp]) {
-            cancelledMessages += 1;
-        } else {
-            editedMessages += 1;
-        }
-
         [invocation getArgument:&arg atIndex:4];
-        void (^completionHandler)(UASchedule *) = (__bridge void (^)(UASchedule *))arg;
-        completionHandler([self getScheduleForScheduleId:scheduleID]);
-    }] editScheduleWithID:OCMOCK_ANY edits:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+        void (^completionHandler)(BOOL) = (__bridge void (^)(BOOL))arg;
+        completionHandler(YES);
+    }] updateSchedulesWithEdits:OCMOCK_ANY newSchedules:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
     // test
     self.publishBlock(@[inAppRemoteDataPayload]);
@@ -565,12 +673,20 @@
     [[[self.mockDelegate stub] andDo:^(NSInvocation *invocation) {
         void *arg;
         [invocation getArgument:&arg atIndex:2];
-        NSArray<UASchedule *> *schedules = (__bridge NSArray<UASchedule *> *)arg;
+        NSDictionary<NSString *, UAScheduleEdits *> *scheduleEdits = (__bridge NSDictionary<NSString *, UAScheduleEdits *> *)arg;
 
-        scheduledMessages += schedules.count;
+        for (UAScheduleEdits *edits in scheduleEdits.allValues) {
+            if ([edits.end isEqualToDate:inAppRemoteDataPayload.timestamp]) {
+                cancelledMessages += 1;
+            } else if (edits.priority) {
+                editedMessages += 1;
+            }
+        }
 
         [invocation getArgument:&arg atIndex:3];
-        void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
+        NSArray<UASchedule *> *schedules = (__bridge NSArray<UASchedule *> *)arg;
+
+        scheduledMessages += schedules.count;
 
         for (UASchedule *schedule in schedules) {
             [self.allSchedules addObject:schedule];
@@ -580,24 +696,11 @@
                 schedule2 = schedule;
             }
         }
-        completionHandler(self.allSchedules);
-    }] scheduleMultiple:OCMOCK_ANY completionHandler:OCMOCK_ANY];
-
-    [[[self.mockDelegate stub] andDo:^(NSInvocation *invocation) {
-        void *arg;
-
-        [invocation getArgument:&arg atIndex:3];
-        UAScheduleEdits *edits = (__bridge UAScheduleEdits *)arg;
-        if ([edits.end isEqualToDate:inAppRemoteDataPayload.timestamp]) {
-            cancelledMessages += 1;
-        } else if (edits.priority) {
-            editedMessages += 1;
-        }
 
         [invocation getArgument:&arg atIndex:4];
-        void (^completionHandler)(UASchedule *) = (__bridge void (^)(UASchedule *))arg;
-        completionHandler(nil); // REVISIT - return schedule
-    }] editScheduleWithID:OCMOCK_ANY edits:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+        void (^completionHandler)(BOOL) = (__bridge void (^)(BOOL))arg;
+        completionHandler(YES);
+    }] updateSchedulesWithEdits:OCMOCK_ANY newSchedules:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
     // test
     self.publishBlock(@[inAppRemoteDataPayload]);
@@ -690,29 +793,23 @@
     __block NSUInteger scheduledMessages = 0;
     __block NSUInteger cancelledMessages = 0;
 
-    // expectations
-    [[[self.mockDelegate expect] andDo:^(NSInvocation *invocation) {
+    [[[self.mockDelegate stub] andDo:^(NSInvocation *invocation) {
         void *arg;
         [invocation getArgument:&arg atIndex:2];
-        NSArray<UASchedule *> *schedules = (__bridge NSArray<UASchedule *> *)arg;
+        NSDictionary<NSString *, UAScheduleEdits *> *scheduleEdits = (__bridge NSDictionary<NSString *, UAScheduleEdits *> *)arg;
 
-        scheduledMessages += schedules.count;
+        cancelledMessages += scheduleEdits.count;
 
         [invocation getArgument:&arg atIndex:3];
-        void (^completionHandler)(NSArray<UASchedule *> *) = (__bridge void (^)(NSArray<UASchedule *> *))arg;
+        NSArray<UASchedule *> *schedules = (__bridge NSArray<UASchedule *> *)arg;
 
+        scheduledMessages += schedules.count;
         [self.allSchedules addObjectsFromArray:schedules];
 
-        completionHandler(self.allSchedules);
-    }] scheduleMultiple:OCMOCK_ANY completionHandler:OCMOCK_ANY];
-
-    [[[self.mockDelegate stub] andDo:^(NSInvocation *invocation) {
-        cancelledMessages += 1;
-        void *arg;
         [invocation getArgument:&arg atIndex:4];
-        void (^completionHandler)(UASchedule *) = (__bridge void (^)(UASchedule *))arg;
-        completionHandler(nil);
-    }] editScheduleWithID:OCMOCK_ANY edits:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+        void (^completionHandler)(BOOL) = (__bridge void (^)(BOOL))arg;
+        completionHandler(YES);
+    }] updateSchedulesWithEdits:OCMOCK_ANY newSchedules:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
     // test
     self.publishBlock(@[inAppRemoteDataPayload]);
@@ -892,11 +989,11 @@
     XCTestExpectation *scheduled = [self expectationWithDescription:@"scheduled"];
     [[[self.mockDelegate expect] andDo:^(NSInvocation *invocation) {
         void *arg;
-        [invocation getArgument:&arg atIndex:3];
+        [invocation getArgument:&arg atIndex:4];
         void (^completionHandler)(BOOL) = (__bridge void (^)(BOOL))arg;
         completionHandler(YES);
         [scheduled fulfill];
-    }] scheduleMultiple:@[expected] completionHandler:OCMOCK_ANY];
+    }] updateSchedulesWithEdits:OCMOCK_ANY newSchedules:@[expected] completionHandler:OCMOCK_ANY];
 
     self.publishBlock(@[inAppRemoteDataPayload]);
     [self waitForTestExpectations];
@@ -966,11 +1063,11 @@
     XCTestExpectation *scheduled = [self expectationWithDescription:@"scheduled"];
     [[[self.mockDelegate expect] andDo:^(NSInvocation *invocation) {
         void *arg;
-        [invocation getArgument:&arg atIndex:3];
+        [invocation getArgument:&arg atIndex:4];
         void (^completionHandler)(BOOL) = (__bridge void (^)(BOOL))arg;
         completionHandler(YES);
         [scheduled fulfill];
-    }] scheduleMultiple:@[expected] completionHandler:OCMOCK_ANY];
+    }] updateSchedulesWithEdits:OCMOCK_ANY newSchedules:@[expected] completionHandler:OCMOCK_ANY];
 
     self.publishBlock(@[inAppRemoteDataPayload]);
     [self waitForTestExpectations];
@@ -1023,11 +1120,11 @@
     XCTestExpectation *scheduled = [self expectationWithDescription:@"scheduled"];
     [[[self.mockDelegate expect] andDo:^(NSInvocation *invocation) {
         void *arg;
-        [invocation getArgument:&arg atIndex:3];
+        [invocation getArgument:&arg atIndex:4];
         void (^completionHandler)(BOOL) = (__bridge void (^)(BOOL))arg;
         completionHandler(YES);
         [scheduled fulfill];
-    }] scheduleMultiple:@[expected] completionHandler:OCMOCK_ANY];
+    }] updateSchedulesWithEdits:OCMOCK_ANY newSchedules:@[expected] completionHandler:OCMOCK_ANY];
 
     self.publishBlock(@[inAppRemoteDataPayload]);
     [self waitForTestExpectations];
@@ -1089,26 +1186,16 @@
     XCTestExpectation *scheduled = [self expectationWithDescription:@"scheduled"];
     [[[self.mockDelegate expect] andDo:^(NSInvocation *invocation) {
         void *arg;
-        [invocation getArgument:&arg atIndex:3];
+        [invocation getArgument:&arg atIndex:4];
         void (^completionHandler)(BOOL) = (__bridge void (^)(BOOL))arg;
         completionHandler(YES);
         [scheduled fulfill];
-    }] scheduleMultiple:@[expected] completionHandler:OCMOCK_ANY];
+    }] updateSchedulesWithEdits:OCMOCK_ANY newSchedules:@[expected] completionHandler:OCMOCK_ANY];
 
     self.publishBlock(@[inAppRemoteDataPayload]);
     [self waitForTestExpectations];
     [self.mockDelegate verify];
 }
 
-
-- (UASchedule *)getScheduleForScheduleId:(NSString *)scheduleId {
-    for (UASchedule *schedule in self.allSchedules) {
-        if ([scheduleId isEqualToString:schedule.identifier]) {
-            return schedule;
-        }
-    }
-    return nil;
-}
-
 @end
 
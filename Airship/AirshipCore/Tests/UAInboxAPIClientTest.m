@@ -87,12 +87,17 @@
     }] retryWhere:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
     // Make call
-    [self.inboxAPIClient retrieveMessageListOnSuccess:^(NSUInteger status, NSArray * _Nullable messages) {
-        XCTAssertEqualObjects(messages[0], @"someMessage", @"Messages should match messages from the response");
+    __block NSArray *messages;
+    [self.inboxAPIClient retrieveMessageListOnSuccess:^(NSUInteger status, UAInboxMessageListResponse * _Nullable response) {
+        XCTAssertEqual(1, response.count);
+        [response enumerateMessagesWithChunkSize:10 usingBlock:^(NSArray *chunk) {
+            messages = chunk;
+        }];
     } onFailure:^() {
         XCTFail(@"Should not be called");
     }];
 
+    XCTAssertEqualObjects(@[@"someMessage"], messages, @"Messages should match messages from the response");
     [self.mockSession verify];
 }
 
@@ -125,7 +130,7 @@
     }]  retryWhere:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
     __block BOOL failed = NO;
-    [self.inboxAPIClient retrieveMessageListOnSuccess:^(NSUInteger status, NSArray * _Nullable messages) {
+    [self.inboxAPIClient retrieveMessageListOnSuccess:^(NSUInteger status, UAInboxMessageListResponse * _Nullable response) {
         XCTFail(@"Should not be called");
     } onFailure:^() {
         failed = YES;
@@ -157,7 +162,7 @@
     }] dataTaskWithRequest:OCMOCK_ANY retryWhere:OCMOCK_ANY completionHandler:OCMOCK_ANY];
 
     __block BOOL failed = NO;
-    [self.inboxAPIClient retrieveMessageListOnSuccess:^(NSUInteger status, NSArray * _Nullable messages) {
+    [self.inboxAPIClient retrieveMessageListOnSuccess:^(NSUInteger status, UAInboxMessageListResponse * _Nullable response) {
         XCTFail(@"Should not be called");
     } onFailure:^() {
         failed = YES;
@@ -329,9 +334,9 @@
     XCTestExpectation *expectationForRefreshSucceeded = [self expectationWithDescription:@"UAInboxClientMessageRetrievalSuccessBlock executed"];
     
     // test
-    [self.inboxAPIClient retrieveMessageListOnSuccess:^(NSUInteger status, NSArray * _Nullable messages) {
+    [self.inboxAPIClient retrieveMessageListOnSuccess:^(NSUInteger status, UAInboxMessageListResponse * _Nullable response) {
         XCTAssertEqual(status,0);
-        XCTAssertFalse(messages.count);
+        XCTAssertNil(response);
         
         [expectationForRefreshSucceeded fulfill];
     } onFailure:^() {
@@ -0,0 +1,147 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAInboxMessageBodyCache+Internal.h"
+#import "UAInboxMessage+Internal.h"
+#import "UAUser.h"
+#import "UAUserData+Internal.h"
+
+@interface UAInboxMessageBodyCacheTest : UABaseTest
+@property (nonatomic, strong) id mockUser;
+@property (nonatomic, strong) id mockSession;
+@property (nonatomic, strong) UAUserData *userData;
+@property (nonatomic, strong) NSURL *directoryURL;
+@property (nonatomic, strong) NSMutableArray<NSURL *> *requestedURLs;
+@property (nonatomic, strong) UAInboxMessageBodyCache *cache;
+@end
+
+@implementation UAInboxMessageBodyCacheTest
+
+- (void)setUp {
+    [super setUp];
+
+    self.userData = [UAUserData dataWithUsername:@"username" password:@"password"];
+    self.mockUser = [self mockForClass:[UAUser class]];
+    [[[self.mockUser stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+        void (^completionHandler)(UAUserData *) = (__bridge void (^)(UAUserData *))arg;
+
+        [invocation getArgument:&arg atIndex:3];
+        dispatch_queue_t queue = (__bridge dispatch_queue_t)arg;
+
+        UAUserData *userData = self.userData;
+        dispatch_async(queue, ^{
+            completionHandler(userData);
+        });
+    }] getUserData:OCMOCK_ANY queue:OCMOCK_ANY];
+
+    self.requestedURLs = [NSMutableArray array];
+    self.mockSession = [self mockForClass:[UARequestSession class]];
+    [[[self.mockSession stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+        UARequest *request = (__bridge UARequest *)arg;
+
+        [invocation getArgument:&arg atIndex:3];
+        UARequestCompletionHandler completionHandler = (__bridge UARequestCompletionHandler)arg;
+
+        [self.requestedURLs addObject:request.URL];
+        NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL
+                                                                  statusCode:200
+                                                                 HTTPVersion:nil
+                                                                headerFields:@{@"Content-Type": @"text/html; charset=utf-8"}];
+        completionHandler([request.URL.absoluteString dataUsingEncoding:NSUTF8StringEncoding], response, nil);
+    }] dataTaskWithRequest:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    self.directoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    self.cache = [UAInboxMessageBodyCache cacheWithUser:self.mockUser session:self.mockSession directoryURL:self.directoryURL];
+    self.cache.requiresWiFi = NO;
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtURL:self.directoryURL error:nil];
+    [super tearDown];
+}
+
+- (UAInboxMessage *)messageWithID:(NSString *)messageID unread:(BOOL)unread sent:(NSTimeInterval)sent {
+    return [UAInboxMessage messageWithBuilderBlock:^(UAInboxMessageBuilder *builder) {
+        builder.messageID = messageID;
+        builder.messageBodyURL = [NSURL URLWithString:[NSString stringWithFormat:@"https://example.com/%@", messageID]];
+        builder.unread = unread;
+        builder.messageSent = [NSDate dateWithTimeIntervalSince1970:sent];
+    }];
+}
+
+- (NSCachedURLResponse *)cachedBodyForMessage:(UAInboxMessage *)message {
+    __block NSCachedURLResponse *result;
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched cached body"];
+    [self.cache cachedBodyForMessage:message completionHandler:^(NSCachedURLResponse *cachedResponse) {
+        result = cachedResponse;
+        [fetched fulfill];
+    }];
+    [self waitForTestExpectations];
+    return result;
+}
+
+/**
+ * Test only the newest unread messages are prefetched.
+ */
+- (void)testPrefetchNewestUnreadMessages {
+    UAInboxMessage *oldest = [self messageWithID:@"oldest" unread:YES sent:1];
+    UAInboxMessage *read = [self messageWithID:@"read" unread:NO sent:2];
+    UAInboxMessage *newest = [self messageWithID:@"newest" unread:YES sent:3];
+
+    self.cache.maxMessageCount = 1;
+    [self.cache prefetchMessages:@[oldest, read, newest]];
+    [self.cache waitForIdle];
+
+    XCTAssertEqualObjects(@[newest.messageBodyURL], self.requestedURLs);
+
+    NSCachedURLResponse *cachedResponse = [self cachedBodyForMessage:newest];
+    XCTAssertEqualObjects([newest.messageBodyURL.absoluteString dataUsingEncoding:NSUTF8StringEncoding], cachedResponse.data);
+    XCTAssertEqualObjects(@"text/html", cachedResponse.response.MIMEType);
+
+    XCTAssertNil([self cachedBodyForMessage:oldest]);
+    XCTAssertNil([self cachedBodyForMessage:read]);
+
+    // Prefetching again does not refetch cached bodies, and drops bodies that are no longer needed
+    [self.requestedURLs removeAllObjects];
+    self.cache.maxMessageCount = 10;
+    [self.cache prefetchMessages:@[oldest]];
+    [self.cache waitForIdle];
+
+    XCTAssertEqualObjects(@[oldest.messageBodyURL], self.requestedURLs);
+    XCTAssertNil([self cachedBodyForMessage:newest]);
+    XCTAssertNotNil([self cachedBodyForMessage:oldest]);
+}
+
+/**
+ * Test bodies are not prefetched past the size limit.
+ */
+- (void)testPrefetchSizeLimit {
+    UAInboxMessage *message = [self messageWithID:@"message" unread:YES sent:1];
+
+    self.cache.maxTotalBytes = 1;
+    [self.cache prefetchMessages:@[message]];
+    [self.cache waitForIdle];
+
+    XCTAssertEqual(1, self.requestedURLs.count);
+    XCTAssertNil([self cachedBodyForMessage:message]);
+}
+
+/**
+ * Test bodies prefetched for one user are not returned for another.
+ */
+- (void)testCachedBodiesAreUserScoped {
+    UAInboxMessage *message = [self messageWithID:@"message" unread:YES sent:1];
+
+    [self.cache prefetchMessages:@[message]];
+    [self.cache waitForIdle];
+    XCTAssertNotNil([self cachedBodyForMessage:message]);
+
+    self.userData = [UAUserData dataWithUsername:@"other" password:@"password"];
+    XCTAssertNil([self cachedBodyForMessage:message]);
+}
+
+@end
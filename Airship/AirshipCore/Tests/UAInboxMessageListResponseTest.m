@@ -0,0 +1,83 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAInboxMessageListResponse+Internal.h"
+
+@interface UAInboxMessageListResponseTest : UABaseTest
+@end
+
+@implementation UAInboxMessageListResponseTest
+
+- (UAInboxMessageListResponse *)responseWithString:(NSString *)string {
+    return [UAInboxMessageListResponse responseWithData:[string dataUsingEncoding:NSUTF8StringEncoding]];
+}
+
+- (NSArray *)messagesInResponse:(UAInboxMessageListResponse *)response chunkSize:(NSUInteger)chunkSize chunkCount:(NSUInteger *)chunkCount {
+    NSMutableArray *messages = [NSMutableArray array];
+    __block NSUInteger count = 0;
+    [response enumerateMessagesWithChunkSize:chunkSize usingBlock:^(NSArray *chunk) {
+        XCTAssertLessThanOrEqual(chunk.count, chunkSize);
+        [messages addObjectsFromArray:chunk];
+        count++;
+    }];
+
+    if (chunkCount) {
+        *chunkCount = count;
+    }
+    return messages;
+}
+
+- (void)testMessages {
+    NSString *body = @"{ \"ok\": true, \"other\": {\"messages\": [\"nested\"], \"s\": \"]}\\\"\"}, "
+                     "\"messages\" : [ {\"message_id\": \"a\", \"extra\": {\"k\": \"v [\"}}, {\"message_id\": \"b\"}, 3, null ], "
+                     "\"trailing\": [1, 2] }";
+
+    UAInboxMessageListResponse *response = [self responseWithString:body];
+    XCTAssertEqual(4, response.count);
+
+    NSUInteger chunkCount = 0;
+    NSArray *messages = [self messagesInResponse:response chunkSize:3 chunkCount:&chunkCount];
+    XCTAssertEqual(2, chunkCount);
+
+    NSArray *expected = @[ @{ @"message_id": @"a", @"extra": @{ @"k": @"v [" } }, @{ @"message_id": @"b" }, @3, [NSNull null] ];
+    XCTAssertEqualObjects(expected, messages);
+}
+
+- (void)testMatchesJSONSerialization {
+    NSMutableArray *messages = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 25; i++) {
+        [messages addObject:@{ @"message_id": [NSString stringWithFormat:@"message-%lu", (unsigned long)i],
+                               @"title": @"tïtle \"quoted\" \\ {",
+                               @"extra": @{ @"list": @[@1, @2.5, @YES], @"empty": @{} } }];
+    }
+
+    NSData *data = [NSJSONSerialization dataWithJSONObject:@{ @"messages": messages, @"ok": @YES } options:NSJSONWritingPrettyPrinted error:nil];
+    UAInboxMessageListResponse *response = [UAInboxMessageListResponse responseWithData:data];
+    XCTAssertEqualObjects(messages, [self messagesInResponse:response chunkSize:10 chunkCount:nil]);
+}
+
+- (void)testEmptyMessages {
+    UAInboxMessageListResponse *response = [self responseWithString:@"{\"messages\":[]}"];
+    XCTAssertNotNil(response);
+    XCTAssertEqual(0, response.count);
+    XCTAssertEqualObjects(@[], [self messagesInResponse:response chunkSize:10 chunkCount:nil]);
+}
+
+- (void)testInvalidMessageSkipped {
+    UAInboxMessageListResponse *response = [self responseWithString:@"{\"messages\":[{\"message_id\": \"a\"}, {\"message_id\" \"b\"}]}"];
+    XCTAssertEqual(2, response.count);
+    XCTAssertEqualObjects(@[@{ @"message_id": @"a" }], [self messagesInResponse:response chunkSize:10 chunkCount:nil]);
+}
+
+- (void)testInvalidResponse {
+    XCTAssertNil([self responseWithString:@""]);
+    XCTAssertNil([self responseWithString:@"[]"]);
+    XCTAssertNil([self responseWithString:@"{\"ok\": true}"]);
+    XCTAssertNil([self responseWithString:@"{\"messages\": {}}"]);
+    XCTAssertNil([self responseWithString:@"{\"messages\": null}"]);
+    XCTAssertNil([self responseWithString:@"{\"messages\": [{\"message_id\": \"a\"}"]);
+    XCTAssertNil([self responseWithString:@"{\"messages\": [], \"ok\": tr"]);
+    XCTAssertNil([self responseWithString:@"{\"messages\": [\"unterminated]}"]);
+}
+
+@end
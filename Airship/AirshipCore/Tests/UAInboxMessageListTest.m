@@ -33,6 +33,7 @@
 @property (nonatomic, strong) NSNotificationCenter *notificationCenter;
 @property (nonatomic, strong) UAInboxStore *testStore;
 @property (nonatomic, strong) UATestDate *testDate;
+@property (nonatomic, strong) UATestDispatcher *testDispatcher;
 
 @end
 
@@ -65,12 +66,13 @@
     self.mockMessageListNotificationObserver = [self mockForProtocol:@protocol(UAInboxMessageListMockNotificationObserver)];
 
     self.notificationCenter = [[NSNotificationCenter alloc] init];
+    self.testDispatcher = [UATestDispatcher testDispatcher];
     self.messageList = [UAInboxMessageList messageListWithUser:self.mockUser
                                                         client:self.mockInboxAPIClient
                                                         config:self.config
                                                     inboxStore:self.testStore
                                             notificationCenter:self.notificationCenter
-                                                    dispatcher:[UATestDispatcher testDispatcher]
+                                                    dispatcher:self.testDispatcher
                                                           date:self.testDate];
 
     //inject the API client
@@ -114,7 +116,7 @@
         void *arg;
         [invocation getArgument:&arg atIndex:2];
         UAInboxClientMessageRetrievalSuccessBlock successBlock = (__bridge UAInboxClientMessageRetrievalSuccessBlock) arg;
-        successBlock(304, @[]);
+        successBlock(304, nil);
     }] retrieveMessageListOnSuccess:[OCMArg any] onFailure:[OCMArg any]];
 
     [[[self.mockMessageListNotificationObserver stub] andDo:^(NSInvocation *invocation) {
@@ -220,6 +222,178 @@
     XCTAssertEqual(0, self.messageList.messages.count);
 }
 
+/**
+ * Test the updated notification describes what changed since the previous update.
+ */
+- (void)testUpdatedNotificationChangeSet {
+    XCTestExpectation *inboxSynced = [self expectationWithDescription:@"inboxSynced"];
+    [self.testStore syncMessagesWithResponse:@[[self createMessageDictionaryWithMessageID:@"messageID"]]
+                            completionHandler:^(BOOL success) {
+                                [inboxSynced fulfill];
+                            }];
+    [self waitForTestExpectations];
+
+    [[[self.mockInboxAPIClient stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:3];
+        UAInboxClientFailureBlock failureBlock = (__bridge UAInboxClientFailureBlock) arg;
+        failureBlock();
+    }] retrieveMessageListOnSuccess:[OCMArg any] onFailure:[OCMArg any]];
+
+    __block NSDictionary *userInfo;
+    id observer = [self.notificationCenter addObserverForName:UAInboxMessageListUpdatedNotification
+                                                       object:nil
+                                                        queue:nil
+                                                   usingBlock:^(NSNotification *notification) {
+        userInfo = notification.userInfo;
+    }];
+
+    // First refresh inserts the message
+    XCTestExpectation *refreshed = [self expectationWithDescription:@"refreshed"];
+    [self.messageList retrieveMessageListWithSuccessBlock:nil withFailureBlock:^{
+        [refreshed fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    XCTAssertEqualObjects(@[@"messageID"], userInfo[UAInboxMessageListInsertedMessageIDsKey]);
+    XCTAssertEqual(0, [userInfo[UAInboxMessageListUpdatedMessageIDsKey] count]);
+
+    // Refreshing again without changes is a no-op
+    refreshed = [self expectationWithDescription:@"refreshed again"];
+    [self.messageList retrieveMessageListWithSuccessBlock:nil withFailureBlock:^{
+        [refreshed fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    XCTAssertEqual(0, [userInfo[UAInboxMessageListInsertedMessageIDsKey] count]);
+    XCTAssertEqual(0, [userInfo[UAInboxMessageListRemovedMessageIDsKey] count]);
+    XCTAssertEqual(0, [userInfo[UAInboxMessageListUpdatedMessageIDsKey] count]);
+
+    [self.notificationCenter removeObserver:observer];
+}
+
+/**
+ * Test messages marked read in quick succession are synced in a single request.
+ */
+- (void)testMarkMessagesReadCoalescesSync {
+    NSMutableArray *response = [NSMutableArray array];
+    for (NSString *messageID in @[@"first", @"second"]) {
+        NSMutableDictionary *payload = [[self createMessageDictionaryWithMessageID:messageID] mutableCopy];
+        payload[@"unread"] = @"1";
+        payload[@"message_url"] = [NSString stringWithFormat:@"http://someMessageUrl/%@", messageID];
+        [response addObject:payload];
+    }
+
+    XCTestExpectation *inboxSynced = [self expectationWithDescription:@"inboxSynced"];
+    [self.testStore syncMessagesWithResponse:response completionHandler:^(BOOL success) {
+        [inboxSynced fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    [[[self.mockInboxAPIClient stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:3];
+        UAInboxClientFailureBlock failureBlock = (__bridge UAInboxClientFailureBlock) arg;
+        failureBlock();
+    }] retrieveMessageListOnSuccess:[OCMArg any] onFailure:[OCMArg any]];
+
+    XCTestExpectation *loaded = [self expectationWithDescription:@"loaded"];
+    [self.messageList retrieveMessageListWithSuccessBlock:nil withFailureBlock:^{
+        [loaded fulfill];
+    }];
+    [self waitForTestExpectations];
+    XCTAssertEqual(2, self.messageList.messages.count);
+
+    [[self.mockInboxAPIClient reject] performBatchDeleteForMessageURLs:OCMOCK_ANY onSuccess:OCMOCK_ANY onFailure:OCMOCK_ANY];
+
+    __block NSUInteger requestCount = 0;
+    __block NSArray *syncedURLs;
+    [[[self.mockInboxAPIClient stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+        syncedURLs = (__bridge NSArray *)arg;
+        requestCount++;
+
+        [invocation getArgument:&arg atIndex:3];
+        UAInboxClientSuccessBlock successBlock = (__bridge UAInboxClientSuccessBlock)arg;
+        successBlock();
+    }] performBatchMarkAsReadForMessageURLs:OCMOCK_ANY onSuccess:OCMOCK_ANY onFailure:OCMOCK_ANY];
+
+    for (UAInboxMessage *message in self.messageList.messages) {
+        XCTestExpectation *marked = [self expectationWithDescription:@"marked read"];
+        [self.messageList markMessagesRead:@[message] completionHandler:^{
+            [marked fulfill];
+        }];
+        [self waitForTestExpectations];
+    }
+
+    // Nothing is sent until the changes settle
+    [self.testStore waitForIdle];
+    XCTAssertEqual(0, requestCount);
+
+    [self.testDispatcher advanceTime:3];
+    [self.testStore waitForIdle];
+
+    XCTAssertEqual(1, requestCount);
+    XCTAssertEqual(2, syncedURLs.count);
+}
+
+/**
+ * Test the typed message queries.
+ */
+- (void)testTypedQueries {
+    self.testDate.absoluteTime = [NSDate dateWithTimeIntervalSince1970:0];
+
+    NSMutableDictionary *promo = [[self createMessageDictionaryWithMessageID:@"promo" expiry:[NSDate dateWithTimeIntervalSince1970:100]] mutableCopy];
+    promo[@"title"] = @"Café Deals";
+    promo[@"unread"] = @"1";
+    promo[@"extra"] = @{@"tab": @"promo"};
+
+    NSMutableDictionary *news = [[self createMessageDictionaryWithMessageID:@"news" expiry:[NSDate dateWithTimeIntervalSince1970:50]] mutableCopy];
+    news[@"title"] = @"Weekly news";
+    news[@"extra"] = @{@"tab": @"news"};
+
+    NSDictionary *other = [self createMessageDictionaryWithMessageID:@"other"];
+
+    XCTestExpectation *inboxSynced = [self expectationWithDescription:@"inboxSynced"];
+    [self.testStore syncMessagesWithResponse:@[promo, news, other] completionHandler:^(BOOL success) {
+        [inboxSynced fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    [[[self.mockInboxAPIClient stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:3];
+        UAInboxClientFailureBlock failureBlock = (__bridge UAInboxClientFailureBlock) arg;
+        failureBlock();
+    }] retrieveMessageListOnSuccess:[OCMArg any] onFailure:[OCMArg any]];
+
+    XCTestExpectation *refreshed = [self expectationWithDescription:@"refreshed"];
+    [self.messageList retrieveMessageListWithSuccessBlock:nil withFailureBlock:^{
+        [refreshed fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    NSArray *unreadIDs = [[self.messageList unreadMessages] valueForKey:@"messageID"];
+    XCTAssertEqualObjects(@[@"promo"], unreadIDs);
+
+    NSArray *tabIDs = [[self.messageList messagesWithExtraKey:@"tab" value:nil] valueForKey:@"messageID"];
+    XCTAssertEqualObjects([NSSet setWithArray:(@[@"promo", @"news"])], [NSSet setWithArray:tabIDs]);
+
+    NSArray *newsIDs = [[self.messageList messagesWithExtraKey:@"tab" value:@"news"] valueForKey:@"messageID"];
+    XCTAssertEqualObjects(@[@"news"], newsIDs);
+    XCTAssertEqual(0, [self.messageList messagesWithExtraKey:@"missing" value:nil].count);
+
+    NSArray *expiringIDs = [[self.messageList messagesExpiringBeforeDate:[NSDate dateWithTimeIntervalSince1970:100]] valueForKey:@"messageID"];
+    XCTAssertEqualObjects(@[@"news"], expiringIDs);
+    expiringIDs = [[self.messageList messagesExpiringBeforeDate:[NSDate distantFuture]] valueForKey:@"messageID"];
+    XCTAssertEqualObjects((@[@"news", @"promo"]), expiringIDs);
+
+    NSArray *searchIDs = [[self.messageList messagesWithTitleContainingText:@"cafe"] valueForKey:@"messageID"];
+    XCTAssertEqualObjects(@[@"promo"], searchIDs);
+    XCTAssertEqual(3, [self.messageList messagesWithTitleContainingText:@""].count);
+}
+
 /**
  * Helper method for substituting UAAutoDisposable for UADisposable in test.
  */
@@ -90,6 +90,101 @@
 
 }
 
+- (void)testSyncUnchangedMessagesDoesNotUpdate {
+    NSArray *messages = @[ [self createMessageDictionaryWithMessageID:@"message-0"],
+                           [self createMessageDictionaryWithMessageID:@"message-1"]];
+
+    XCTestExpectation *firstSync = [self expectationWithDescription:@"first sync"];
+    [self.inboxStore syncMessagesWithResponse:messages completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+        [firstSync fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    __block NSUInteger updatedCount = 0;
+    id observer = [[NSNotificationCenter defaultCenter] addObserverForName:NSManagedObjectContextDidSaveNotification
+                                                                    object:nil
+                                                                     queue:nil
+                                                                usingBlock:^(NSNotification *notification) {
+        updatedCount += [notification.userInfo[NSUpdatedObjectsKey] count];
+    }];
+
+    // Syncing the same response again leaves the stored messages untouched
+    XCTestExpectation *secondSync = [self expectationWithDescription:@"second sync"];
+    [self.inboxStore syncMessagesWithResponse:messages completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+        [secondSync fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    [[NSNotificationCenter defaultCenter] removeObserver:observer];
+    XCTAssertEqual(0, updatedCount);
+}
+
+- (void)testSyncMessageListResponse {
+    NSMutableArray *messages = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 120; i++) {
+        [messages addObject:[self createMessageDictionaryWithMessageID:[NSString stringWithFormat:@"message-%03lu", (unsigned long)i]]];
+    }
+
+    // Spans several sync chunks
+    NSData *data = [NSJSONSerialization dataWithJSONObject:@{ @"messages": messages } options:0 error:nil];
+    XCTestExpectation *firstSync = [self expectationWithDescription:@"first sync"];
+    [self.inboxStore syncMessagesWithMessageListResponse:[UAInboxMessageListResponse responseWithData:data] completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+        [firstSync fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    // Messages missing from a later response are removed
+    NSArray *remaining = [messages subarrayWithRange:NSMakeRange(60, 60)];
+    data = [NSJSONSerialization dataWithJSONObject:@{ @"messages": remaining } options:0 error:nil];
+    XCTestExpectation *secondSync = [self expectationWithDescription:@"second sync"];
+    [self.inboxStore syncMessagesWithMessageListResponse:[UAInboxMessageListResponse responseWithData:data] completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+        [secondSync fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched messages"];
+    [self.inboxStore fetchMessagesWithPredicate:nil completionHandler:^(NSArray<UAInboxMessageData *> *stored) {
+        NSArray *messageIDs = [[stored valueForKey:@"messageID"] sortedArrayUsingSelector:@selector(compare:)];
+        XCTAssertEqualObjects([remaining valueForKey:@"message_id"], messageIDs);
+        XCTAssertEqualObjects(@{@"someKey":@"someValue"}, stored.firstObject.extra);
+        [fetched fulfill];
+    }];
+    [self waitForTestExpectations];
+}
+
+- (void)testDeleteExpiredMessages {
+    NSMutableDictionary *expired = [[self createMessageDictionaryWithMessageID:@"expired"] mutableCopy];
+    expired[@"message_expiry"] = @"2014-08-13 00:16:22";
+
+    NSMutableDictionary *unexpired = [[self createMessageDictionaryWithMessageID:@"unexpired"] mutableCopy];
+    unexpired[@"message_expiry"] = @"2016-08-13 00:16:22";
+
+    NSArray *messages = @[expired, unexpired, [self createMessageDictionaryWithMessageID:@"no-expiry"]];
+    [self.inboxStore syncMessagesWithResponse:messages completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+    }];
+
+    XCTestExpectation *deleted = [self expectationWithDescription:@"deleted expired messages"];
+    NSDate *date = [UAUtils parseISO8601DateFromString:@"2015-08-13 00:16:22"];
+    [self.inboxStore deleteMessagesExpiredBeforeDate:date completionHandler:^(NSUInteger count) {
+        XCTAssertEqual(1, count);
+        [deleted fulfill];
+    }];
+
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched messages"];
+    [self.inboxStore fetchMessagesWithPredicate:nil completionHandler:^(NSArray<UAInboxMessageData *> *messages) {
+        NSArray *messageIDs = [[messages valueForKey:@"messageID"] sortedArrayUsingSelector:@selector(compare:)];
+        XCTAssertEqualObjects((@[@"no-expiry", @"unexpired"]), messageIDs);
+        [fetched fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
 - (NSDictionary *)createMessageDictionaryWithMessageID:(NSString *)messageID {
     return @{@"message_id": messageID,
              @"title": @"someTitle",
@@ -40,4 +40,32 @@
     XCTAssertEqualObjects(command.options[@"query argument"][0], @"^");
 }
 
+- (void)testCommandForURLNoArguments {
+    UAJavaScriptCommand *command = [UAJavaScriptCommand commandForURL:[NSURL URLWithString:@"uairship://close"]];
+    XCTAssertEqualObjects(command.name, @"close");
+    XCTAssertEqualObjects(command.arguments, @[]);
+    XCTAssertEqualObjects(command.options, @{});
+}
+
+- (void)testCommandForURLEmptyArgumentsAndFragment {
+    NSURL *URL = [NSURL URLWithString:@"uairship://whatever/one//three/?key=a%3Db&empty=#fragment?not=query"];
+    UAJavaScriptCommand *command = [UAJavaScriptCommand commandForURL:URL];
+
+    NSArray *expectedArguments = @[@"one", @"", @"three", @""];
+    XCTAssertEqualObjects(command.arguments, expectedArguments);
+    NSDictionary *expectedOptions = @{ @"key": @[@"a=b"], @"empty": @[@""] };
+    XCTAssertEqualObjects(command.options, expectedOptions);
+    XCTAssertEqualObjects(command.URL, URL);
+}
+
+- (void)testCommandForURLMultibyteArguments {
+    NSURL *URL = [NSURL URLWithString:@"uairship://whatever/%E2%9C%93/%E2%9C?%F0%9F%99%82=%20"];
+    UAJavaScriptCommand *command = [UAJavaScriptCommand commandForURL:URL];
+
+    // Invalid UTF-8 is left encoded
+    NSArray *expectedArguments = @[@"✓", @"%E2%9C"];
+    XCTAssertEqualObjects(command.arguments, expectedArguments);
+    XCTAssertEqualObjects(command.options[@"🙂"], @[@" "]);
+}
+
 @end
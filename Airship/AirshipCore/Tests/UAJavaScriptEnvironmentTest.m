@@ -2,7 +2,7 @@
 
 #import <JavaScriptCore/JavaScriptCore.h>
 #import "UAAirshipBaseTest.h"
-#import "UAJavaScriptEnvironment.h"
+#import "UAJavaScriptEnvironment+Internal.h"
 #import "UAirship+Internal.h"
 #import "UAChannel.h"
 #import "UANamedUser.h"
@@ -155,4 +155,23 @@
     XCTAssertEqualObjects(@"done", finishResult);
 }
 
+/**
+ * Test the library only exposes values once the values script runs.
+ */
+- (void)testLibraryAndValues {
+    UAJavaScriptEnvironment *environment = [[UAJavaScriptEnvironment alloc] init];
+    [environment addStringGetter:@"string" value:@"oh hi!"];
+    [environment addDictionaryGetter:@"dictionary" value:@{@"hey":@"there"}];
+
+    [self.jsc evaluateScript:[UAJavaScriptEnvironment library]];
+    XCTAssertTrue([self.jsc evaluateScript:@"typeof UAirship === 'undefined'"].toBool);
+
+    [self.jsc evaluateScript:[environment buildValues]];
+    XCTAssertEqualObjects(@"oh hi!", [self.jsc evaluateScript:@"UAirship.string()"].toString);
+
+    // Getters return a copy
+    [self.jsc evaluateScript:@"UAirship.dictionary().hey = 'changed'"];
+    XCTAssertEqualObjects(@{@"hey":@"there"}, [self.jsc evaluateScript:@"UAirship.dictionary()"].toDictionary);
+}
+
 @end
@@ -0,0 +1,101 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UALandingPagePreloader+Internal.h"
+#import "UALandingPageAction.h"
+#import "UAirship+Internal.h"
+
+@interface UALandingPagePreloaderTest : UABaseTest
+@property (nonatomic, strong) id mockAirship;
+@property (nonatomic, strong) id mockURLAllowList;
+@property (nonatomic, strong) id mockWebViewPool;
+@property (nonatomic, strong) id mockNetworkMonitor;
+@property (nonatomic, strong) UALandingPagePreloader *preloader;
+@end
+
+@implementation UALandingPagePreloaderTest
+
+- (void)setUp {
+    [super setUp];
+    self.mockURLAllowList = [self mockForClass:[UAURLAllowList class]];
+    [[[self.mockURLAllowList stub] andReturnValue:@(YES)] isAllowed:OCMOCK_ANY scope:UAURLAllowListScopeOpenURL];
+
+    self.mockAirship = [self mockForClass:[UAirship class]];
+    [[[self.mockAirship stub] andReturn:self.mockURLAllowList] URLAllowList];
+    [UAirship setSharedAirship:self.mockAirship];
+
+    self.mockWebViewPool = [self mockForClass:[UAWebViewPool class]];
+    self.mockNetworkMonitor = [self mockForClass:[UANetworkMonitor class]];
+    self.preloader = [UALandingPagePreloader preloaderWithWebViewPool:self.mockWebViewPool
+                                                       networkMonitor:self.mockNetworkMonitor];
+}
+
+- (UANotificationContent *)notificationWithPayload:(NSDictionary *)payload {
+    return [UANotificationContent notificationWithNotificationInfo:payload];
+}
+
+- (UIBackgroundFetchResult)preloadNotification:(UANotificationContent *)notification {
+    __block UIBackgroundFetchResult fetchResult = UIBackgroundFetchResultFailed;
+    XCTestExpectation *finished = [self expectationWithDescription:@"preload finished"];
+    [self.preloader preloadLandingPageForNotification:notification completionHandler:^(UIBackgroundFetchResult result) {
+        fetchResult = result;
+        [finished fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    return fetchResult;
+}
+
+/**
+ * Test a landing page is preloaded on Wi-Fi.
+ */
+- (void)testPreloadOnWifi {
+    [[[self.mockNetworkMonitor stub] andReturn:UAConnectionTypeWifi] connectionType];
+    [[[self.mockWebViewPool expect] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:4];
+        void (^handler)(BOOL) = (__bridge void (^)(BOOL))arg;
+        handler(YES);
+    }] preloadURL:[NSURL URLWithString:@"https://www.airship.com"]
+        maxContentLength:UALandingPagePreloaderMaxContentLength
+       completionHandler:OCMOCK_ANY];
+
+    UANotificationContent *notification = [self notificationWithPayload:@{ UALandingPageActionDefaultRegistryAlias: @"www.airship.com" }];
+    XCTAssertEqual(UIBackgroundFetchResultNewData, [self preloadNotification:notification]);
+    [self.mockWebViewPool verify];
+}
+
+/**
+ * Test landing pages are not preloaded on cellular or in Low Data Mode.
+ */
+- (void)testPreloadRequiresUnconstrainedWifi {
+    [[self.mockWebViewPool reject] preloadURL:OCMOCK_ANY maxContentLength:UALandingPagePreloaderMaxContentLength completionHandler:OCMOCK_ANY];
+    UANotificationContent *notification = [self notificationWithPayload:@{ UALandingPageActionDefaultRegistryName: @"https://www.airship.com" }];
+
+    [[[self.mockNetworkMonitor stub] andReturn:UAConnectionTypeCell] connectionType];
+    XCTAssertEqual(UIBackgroundFetchResultNoData, [self preloadNotification:notification]);
+
+    [self.mockNetworkMonitor stopMocking];
+    self.mockNetworkMonitor = [self mockForClass:[UANetworkMonitor class]];
+    [[[self.mockNetworkMonitor stub] andReturn:UAConnectionTypeWifi] connectionType];
+    [[[self.mockNetworkMonitor stub] andReturnValue:@(YES)] isConstrained];
+    self.preloader = [UALandingPagePreloader preloaderWithWebViewPool:self.mockWebViewPool
+                                                       networkMonitor:self.mockNetworkMonitor];
+    XCTAssertEqual(UIBackgroundFetchResultNoData, [self preloadNotification:notification]);
+
+    [self.mockWebViewPool verify];
+}
+
+/**
+ * Test notifications without a landing page are ignored.
+ */
+- (void)testNoLandingPage {
+    [[[self.mockNetworkMonitor stub] andReturn:UAConnectionTypeWifi] connectionType];
+    [[self.mockWebViewPool reject] preloadURL:OCMOCK_ANY maxContentLength:UALandingPagePreloaderMaxContentLength completionHandler:OCMOCK_ANY];
+
+    UANotificationContent *notification = [self notificationWithPayload:@{ @"aps": @{ @"alert": @"hi" } }];
+    XCTAssertEqual(UIBackgroundFetchResultNoData, [self preloadNotification:notification]);
+    [self.mockWebViewPool verify];
+}
+
+@end
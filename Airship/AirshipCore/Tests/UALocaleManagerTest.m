@@ -3,6 +3,7 @@
 #import "UAAirshipBaseTest.h"
 #import "UALocaleManager+Internal.h"
 #import "UAPreferenceDataStore+Internal.h"
+#import "UATestDispatcher.h"
 
 @interface UALocaleManagerTest : UAAirshipBaseTest
 @property (nonatomic, strong) UALocaleManager *localeManager;
@@ -72,4 +73,30 @@
     XCTAssertEqual(self.localeManager.currentLocale.currencyCode, [NSLocale autoupdatingCurrentLocale].currencyCode);
     [self.mockNotificationCenter verify];
 }
+
+- (void)testDeviceContextChangesCoalesced {
+    NSNotificationCenter *notificationCenter = [[NSNotificationCenter alloc] init];
+    UATestDispatcher *dispatcher = [UATestDispatcher testDispatcher];
+    UALocaleManager *localeManager = [UALocaleManager localeManagerWithDataStore:self.dataStore
+                                                              notificationCenter:notificationCenter
+                                                                      dispatcher:dispatcher];
+
+    __block NSUInteger changeCount = 0;
+    id observer = [notificationCenter addObserverForName:UADeviceContextChangedEvent object:nil queue:nil usingBlock:^(NSNotification *notification) {
+        changeCount++;
+    }];
+
+    localeManager.currentLocale = [NSLocale localeWithLocaleIdentifier:@"fr"];
+    [dispatcher advanceTime:1];
+    [notificationCenter postNotificationName:NSSystemTimeZoneDidChangeNotification object:nil];
+    [dispatcher advanceTime:1];
+    [notificationCenter postNotificationName:NSCurrentLocaleDidChangeNotification object:nil];
+    XCTAssertEqual(0, changeCount);
+
+    [dispatcher advanceTime:2];
+    XCTAssertEqual(1, changeCount);
+
+    [notificationCenter removeObserver:observer];
+}
+
 @end
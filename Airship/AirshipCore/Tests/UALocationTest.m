@@ -553,6 +553,64 @@
 }
 
 
+/**
+ * Test location updates close in time or distance to the last recorded location
+ * do not generate location events.
+ */
+- (void)testLocationEventFilters {
+    self.location.lastRecordedLocation = [UALocationTest createLocationWithLat:45.5231 lon:122.6765 accuracy:100.0 age:-600];
+
+    [[self.mockAnalytics reject] addEvent:OCMOCK_ANY];
+
+    // Too soon
+    CLLocation *soon = [UALocationTest createLocationWithLat:45.5331 lon:122.6765 accuracy:100.0 age:-570];
+    [self.location locationManager:self.mockLocationManager didUpdateLocations:@[soon]];
+
+    // Too close
+    CLLocation *close = [UALocationTest createLocationWithLat:45.5232 lon:122.6765 accuracy:100.0 age:-300];
+    [self.location locationManager:self.mockLocationManager didUpdateLocations:@[close]];
+
+    [self.mockAnalytics verify];
+}
+
+/**
+ * Test a more accurate location update generates a location event even if it is close to the last recorded location.
+ */
+- (void)testLocationEventAccuracyImprovement {
+    self.location.lastRecordedLocation = [UALocationTest createLocationWithLat:45.5231 lon:122.6765 accuracy:100.0 age:-600];
+
+    CLLocation *accurate = [UALocationTest createLocationWithLat:45.5232 lon:122.6765 accuracy:10.0 age:-570];
+    [[self.mockAnalytics expect] addEvent:OCMOCK_ANY];
+    [self.location locationManager:self.mockLocationManager didUpdateLocations:@[accurate]];
+
+    [self.mockAnalytics verify];
+    XCTAssertEqualObjects(accurate, self.location.lastRecordedLocation);
+}
+
+/**
+ * Test adaptive sampling backs off while the device is stationary.
+ */
+- (void)testAdaptiveSampling {
+    self.location.adaptiveSamplingEnabled = YES;
+    self.location.lastRecordedLocation = [UALocationTest createLocationWithLat:45.5231 lon:122.6765 accuracy:500.0 age:-3600];
+
+    // Within the accuracy of the last recorded location
+    CLLocation *bounce = [UALocationTest createLocationWithLat:45.5251 lon:122.6765 accuracy:500.0 age:-3540];
+    [self.location locationManager:self.mockLocationManager didUpdateLocations:@[bounce]];
+    XCTAssertEqual(1, self.location.stationaryCount);
+
+    // Moved, but the interval backed off to two minutes
+    CLLocation *moved = [UALocationTest createLocationWithLat:45.5731 lon:122.6765 accuracy:500.0 age:-3500];
+    [self.location locationManager:self.mockLocationManager didUpdateLocations:@[moved]];
+    XCTAssertNotEqualObjects(moved, self.location.lastRecordedLocation);
+
+    // Moved after the interval
+    moved = [UALocationTest createLocationWithLat:45.5731 lon:122.6765 accuracy:500.0 age:-3400];
+    [self.location locationManager:self.mockLocationManager didUpdateLocations:@[moved]];
+    XCTAssertEqualObjects(moved, self.location.lastRecordedLocation);
+    XCTAssertEqual(0, self.location.stationaryCount);
+}
+
 /**
  * Test enabling location updates when significant change is unavailable.
  */
@@ -0,0 +1,77 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "NSManagedObjectContext+UAAdditions.h"
+#import "UAirshipCoreResources.h"
+
+@interface UAManagedObjectContextAdditionsTest : UABaseTest
+@property (nonatomic, strong) NSURL *modelURL;
+@end
+
+@implementation UAManagedObjectContextAdditionsTest
+
+- (void)setUp {
+    [super setUp];
+    self.modelURL = [[UAirshipCoreResources bundle] URLForResource:@"UARemoteData" withExtension:@"momd"];
+}
+
+- (void)testLazyContextLoadsStoresOnFirstUse {
+    __block NSUInteger loadCount = 0;
+    NSManagedObjectContext *context = [NSManagedObjectContext lazyManagedObjectContextForModelURL:self.modelURL
+                                                                                      storeLoader:^(NSManagedObjectContext *context) {
+        loadCount++;
+        [context addPersistentInMemoryStore:@"test" error:nil];
+    }];
+
+    [context performBlockAndWait:^{}];
+    XCTAssertEqual(0, loadCount);
+    XCTAssertNil(context.persistentStoreCoordinator);
+
+    XCTestExpectation *performed = [self expectationWithDescription:@"performed"];
+    [context safePerformBlock:^(BOOL isSafe) {
+        XCTAssertTrue(isSafe);
+        [performed fulfill];
+    }];
+    [context safePerformBlock:^(BOOL isSafe) {}];
+    [context performBlockAndWait:^{}];
+
+    [self waitForTestExpectations];
+    XCTAssertEqual(1, loadCount);
+}
+
+- (void)testLazyContextRetriesFailedLoad {
+    __block NSUInteger loadCount = 0;
+    NSManagedObjectContext *context = [NSManagedObjectContext lazyManagedObjectContextForModelURL:self.modelURL
+                                                                                      storeLoader:^(NSManagedObjectContext *context) {
+        // Fails the first time
+        if (loadCount++) {
+            [context addPersistentInMemoryStore:@"test" error:nil];
+        }
+    }];
+
+    XCTestExpectation *unsafe = [self expectationWithDescription:@"unsafe"];
+    [context safePerformBlock:^(BOOL isSafe) {
+        XCTAssertFalse(isSafe);
+        [unsafe fulfill];
+    }];
+
+    XCTestExpectation *safe = [self expectationWithDescription:@"safe"];
+    [context safePerformBlock:^(BOOL isSafe) {
+        XCTAssertTrue(isSafe);
+        [safe fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    XCTAssertEqual(2, loadCount);
+}
+
+- (void)testModelsAreShared {
+    NSManagedObjectContext *first = [NSManagedObjectContext managedObjectContextForModelURL:self.modelURL
+                                                                            concurrencyType:NSPrivateQueueConcurrencyType];
+    NSManagedObjectContext *second = [NSManagedObjectContext managedObjectContextForModelURL:self.modelURL
+                                                                             concurrencyType:NSPrivateQueueConcurrencyType];
+
+    XCTAssertEqual(first.persistentStoreCoordinator.managedObjectModel, second.persistentStoreCoordinator.managedObjectModel);
+}
+
+@end
@@ -0,0 +1,74 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAMemoryPressureCoordinator+Internal.h"
+
+@interface UAMemoryPressureCoordinatorTest : UABaseTest
+@property (nonatomic, strong) NSNotificationCenter *notificationCenter;
+@property (nonatomic, strong) UAMemoryPressureCoordinator *coordinator;
+@end
+
+@implementation UAMemoryPressureCoordinatorTest
+
+- (void)setUp {
+    [super setUp];
+    self.notificationCenter = [[NSNotificationCenter alloc] init];
+    self.coordinator = [UAMemoryPressureCoordinator coordinatorWithNotificationCenter:self.notificationCenter
+                                                               monitorsMemoryPressure:NO];
+}
+
+- (void)testPurgeOrder {
+    NSMutableArray *purged = [NSMutableArray array];
+
+    [self.coordinator registerHandlerWithName:@"high" priority:UAMemoryPressurePriorityHigh handler:^NSUInteger(UAMemoryPressureLevel level) {
+        [purged addObject:@"high"];
+        return 100;
+    }];
+
+    [self.coordinator registerHandlerWithName:@"low" priority:UAMemoryPressurePriorityLow handler:^NSUInteger(UAMemoryPressureLevel level) {
+        [purged addObject:@"low"];
+        return 1;
+    }];
+
+    [self.coordinator registerHandlerWithName:@"normal" priority:UAMemoryPressurePriorityNormal handler:^NSUInteger(UAMemoryPressureLevel level) {
+        [purged addObject:@"normal"];
+        return 10;
+    }];
+
+    // Warnings leave high priority memory alone
+    XCTAssertEqual(11, [self.coordinator purgeWithLevel:UAMemoryPressureLevelWarning]);
+    XCTAssertEqualObjects((@[@"low", @"normal"]), purged);
+
+    [purged removeAllObjects];
+    XCTAssertEqual(111, [self.coordinator purgeWithLevel:UAMemoryPressureLevelCritical]);
+    XCTAssertEqualObjects((@[@"low", @"normal", @"high"]), purged);
+}
+
+- (void)testMemoryWarning {
+    __block UAMemoryPressureLevel purgedLevel = UAMemoryPressureLevelWarning;
+    [self.coordinator registerHandlerWithName:@"handler" priority:UAMemoryPressurePriorityHigh handler:^NSUInteger(UAMemoryPressureLevel level) {
+        purgedLevel = level;
+        return 0;
+    }];
+
+    [self.notificationCenter postNotificationName:UIApplicationDidReceiveMemoryWarningNotification object:nil];
+    XCTAssertEqual(UAMemoryPressureLevelCritical, purgedLevel);
+}
+
+- (void)testRegisterCache {
+    NSCache *cache = [[NSCache alloc] init];
+    [cache setObject:@"one" forKey:@"one"];
+    [cache setObject:@"two" forKey:@"two"];
+
+    UADisposable *disposable = [self.coordinator registerCache:cache priority:UAMemoryPressurePriorityLow estimatedEntrySize:10];
+
+    XCTAssertEqual(20, [self.coordinator purgeWithLevel:UAMemoryPressureLevelWarning]);
+    XCTAssertNil([cache objectForKey:@"one"]);
+
+    [cache setObject:@"one" forKey:@"one"];
+    [disposable dispose];
+    XCTAssertEqual(0, [self.coordinator purgeWithLevel:UAMemoryPressureLevelCritical]);
+    XCTAssertNotNil([cache objectForKey:@"one"]);
+}
+
+@end
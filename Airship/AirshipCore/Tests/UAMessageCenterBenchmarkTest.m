@@ -0,0 +1,303 @@
+/* Copyright Airship and Contributors */
+
+#import <QuartzCore/QuartzCore.h>
+
+#import "UABenchmarkTest.h"
+#import "UAInboxStore+Internal.h"
+#import "UAInboxMessageList+Internal.h"
+#import "UAInboxAPIClient+Internal.h"
+#import "UAMessageCenter.h"
+#import "UAMessageCenterResources.h"
+#import "UADefaultMessageCenterListViewController.h"
+#import "UAMetricsRegistry.h"
+#import "UATestDispatcher.h"
+#import "UATestDate.h"
+
+// Frame budget at 60 fps
+static CFTimeInterval const UABenchmarkFrameDuration = 1.0 / 60;
+
+// Distance scrolled per frame, about the speed of a fling
+static CGFloat const UABenchmarkScrollStep = 40;
+
+@interface UAInboxMessageList()
+- (void)refreshInboxWithCompletionHandler:(void (^)(void))completionHandler;
+@end
+
+@interface UADefaultMessageCenterListViewController()
+@property (nonatomic, weak) UITableView *messageTable;
+@end
+
+/**
+ * Benchmarks for inbox-heavy Message Centers with 50, 500 and 2000 messages: syncing a message list
+ * response into the inbox store, loading the saved messages into the message list, and scrolling
+ * the default list view controller.
+ *
+ * Scrolling is driven frame by frame, so the hitch ratio is estimated from the time each frame
+ * takes to lay out past the 60 fps budget. The scroll summary also has the icon fetch counts.
+ */
+@interface UAMessageCenterBenchmarkTest : UABenchmarkTest
+@property (nonatomic, strong) UAInboxStore *inboxStore;
+@property (nonatomic, strong) UAInboxMessageList *messageList;
+@end
+
+@implementation UAMessageCenterBenchmarkTest
+
+- (void)setUp {
+    [super setUp];
+    self.inboxStore = [UAInboxStore storeWithName:@"UAMessageCenterBenchmarkTest" inMemory:YES];
+}
+
+- (void)tearDown {
+    [self.inboxStore shutDown];
+    [self.inboxStore waitForIdle];
+    [super tearDown];
+}
+
+- (void)testSync50Messages {
+    [self measureSyncWithMessageCount:50];
+}
+
+- (void)testSync500Messages {
+    [self measureSyncWithMessageCount:500];
+}
+
+- (void)testSync2000Messages {
+    [self measureSyncWithMessageCount:2000];
+}
+
+- (void)testUnchangedSync2000Messages {
+    [self measureUnchangedSyncWithMessageCount:2000];
+}
+
+- (void)testRefreshInbox50Messages {
+    [self measureRefreshWithMessageCount:50];
+}
+
+- (void)testRefreshInbox500Messages {
+    [self measureRefreshWithMessageCount:500];
+}
+
+- (void)testRefreshInbox2000Messages {
+    [self measureRefreshWithMessageCount:2000];
+}
+
+- (void)testListScroll50Messages {
+    [self measureListScrollWithMessageCount:50];
+}
+
+- (void)testListScroll500Messages {
+    [self measureListScrollWithMessageCount:500];
+}
+
+- (void)testListScroll2000Messages {
+    [self measureListScrollWithMessageCount:2000];
+}
+
+#pragma mark -
+#pragma mark Benchmarks
+
+- (void)measureSyncWithMessageCount:(NSUInteger)messageCount {
+    if (@available(iOS 13.0, tvOS 13.0, *)) {
+        NSArray *response = [self responseWithMessageCount:messageCount];
+        __block NSTimeInterval elapsed = 0;
+        __block NSUInteger iterations = 0;
+
+        [self measureWithMetrics:self.benchmarkMetrics options:self.manualMeasureOptions block:^{
+            [self.inboxStore shutDown];
+            [self.inboxStore waitForIdle];
+            self.inboxStore = [UAInboxStore storeWithName:@"UAMessageCenterBenchmarkTest" inMemory:YES];
+
+            [self startMeasuring];
+            CFTimeInterval start = CACurrentMediaTime();
+            [self syncResponse:response];
+            elapsed += CACurrentMediaTime() - start;
+            iterations++;
+            [self stopMeasuring];
+        }];
+
+        [self attachSummaryWithName:@"Sync" summary:[self summaryWithMessageCount:messageCount elapsed:elapsed iterations:iterations]];
+    }
+}
+
+- (void)measureUnchangedSyncWithMessageCount:(NSUInteger)messageCount {
+    if (@available(iOS 13.0, tvOS 13.0, *)) {
+        NSArray *response = [self responseWithMessageCount:messageCount];
+        [self syncResponse:response];
+
+        __block NSTimeInterval elapsed = 0;
+        __block NSUInteger iterations = 0;
+
+        [self measureWithMetrics:self.benchmarkMetrics block:^{
+            CFTimeInterval start = CACurrentMediaTime();
+            [self syncResponse:response];
+            elapsed += CACurrentMediaTime() - start;
+            iterations++;
+        }];
+
+        [self attachSummaryWithName:@"Unchanged sync" summary:[self summaryWithMessageCount:messageCount elapsed:elapsed iterations:iterations]];
+    }
+}
+
+- (void)measureRefreshWithMessageCount:(NSUInteger)messageCount {
+    if (@available(iOS 13.0, tvOS 13.0, *)) {
+        [self syncResponse:[self responseWithMessageCount:messageCount]];
+        [self createMessageList];
+
+        __block NSTimeInterval elapsed = 0;
+        __block NSUInteger iterations = 0;
+
+        [self measureWithMetrics:self.benchmarkMetrics block:^{
+            CFTimeInterval start = CACurrentMediaTime();
+            [self refreshMessageList];
+            elapsed += CACurrentMediaTime() - start;
+            iterations++;
+        }];
+
+        XCTAssertEqual(messageCount, self.messageList.messages.count);
+        [self attachSummaryWithName:@"Refresh inbox" summary:[self summaryWithMessageCount:messageCount elapsed:elapsed iterations:iterations]];
+    }
+}
+
+- (void)measureListScrollWithMessageCount:(NSUInteger)messageCount {
+    if (@available(iOS 13.0, tvOS 13.0, *)) {
+        [self syncResponse:[self responseWithMessageCount:messageCount]];
+        [self createMessageList];
+        [self refreshMessageList];
+
+        id mockMessageCenter = [self mockForClass:[UAMessageCenter class]];
+        [[[mockMessageCenter stub] andReturn:mockMessageCenter] shared];
+        [[[mockMessageCenter stub] andReturn:self.messageList] messageList];
+
+        UADefaultMessageCenterListViewController *listViewController = [[UADefaultMessageCenterListViewController alloc] initWithNibName:@"UADefaultMessageCenterListViewController"
+                                                                                                                                  bundle:[UAMessageCenterResources bundle]];
+        UIWindow *window = [[UIWindow alloc] initWithFrame:CGRectMake(0, 0, 375, 812)];
+        window.rootViewController = [[UINavigationController alloc] initWithRootViewController:listViewController];
+        window.hidden = NO;
+
+        UITableView *messageTable = listViewController.messageTable;
+        [messageTable reloadData];
+        [window layoutIfNeeded];
+
+        UAMetricCounter *iconFetches = [[UAMetricsRegistry shared] counterWithName:UAMetricMessageCenterIconFetches];
+        UAMetricCounter *iconCacheLoads = [[UAMetricsRegistry shared] counterWithName:UAMetricMessageCenterIconCacheLoads];
+        int64_t fetchCount = iconFetches.value;
+        int64_t cacheLoadCount = iconCacheLoads.value;
+
+        NSUInteger maxFrames = (NSUInteger)ceil(messageTable.contentSize.height / UABenchmarkScrollStep) + 1;
+        double *frameDurations = malloc(maxFrames * sizeof(double));
+        __block NSUInteger frameCount = 0;
+        __block CFTimeInterval scrollTime = 0;
+        __block CFTimeInterval hitchTime = 0;
+
+        [self measureWithMetrics:self.benchmarkMetrics options:self.manualMeasureOptions block:^{
+            [messageTable setContentOffset:CGPointZero animated:NO];
+            [messageTable layoutIfNeeded];
+            frameCount = 0;
+
+            [self startMeasuring];
+            CGFloat maxOffset = MAX(0, messageTable.contentSize.height - CGRectGetHeight(messageTable.bounds));
+            for (CGFloat offset = 0; offset < maxOffset && frameCount < maxFrames; offset += UABenchmarkScrollStep) {
+                CFTimeInterval frameStart = CACurrentMediaTime();
+                [messageTable setContentOffset:CGPointMake(0, MIN(offset + UABenchmarkScrollStep, maxOffset)) animated:NO];
+                [messageTable layoutIfNeeded];
+
+                // Lets the icon loads and cancellations queued on the main queue run with the frame
+                [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate date]];
+
+                CFTimeInterval frameDuration = CACurrentMediaTime() - frameStart;
+                frameDurations[frameCount++] = frameDuration;
+                scrollTime += MAX(frameDuration, UABenchmarkFrameDuration);
+                hitchTime += MAX(0, frameDuration - UABenchmarkFrameDuration);
+            }
+            [self stopMeasuring];
+        }];
+
+        // Icon fetches start on a background queue
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.25]];
+
+        NSString *summary = [NSString stringWithFormat:@"%lu messages: hitch ratio %.1f ms/s, frame p50 %.2f ms, p99 %.2f ms, %lld icon fetches, %lld icon cache loads",
+                             (unsigned long)messageCount,
+                             scrollTime ? hitchTime * 1000 / scrollTime : 0,
+                             [self percentile:0.5 ofSamples:frameDurations count:frameCount] * 1000,
+                             [self percentile:0.99 ofSamples:frameDurations count:frameCount] * 1000,
+                             iconFetches.value - fetchCount,
+                             iconCacheLoads.value - cacheLoadCount];
+        [self attachSummaryWithName:@"List scroll" summary:summary];
+
+        free(frameDurations);
+        window.hidden = YES;
+    }
+}
+
+#pragma mark -
+#pragma mark Helpers
+
+- (void)createMessageList {
+    self.messageList = [UAInboxMessageList messageListWithUser:[self mockForClass:[UAUser class]]
+                                                        client:[self mockForClass:[UAInboxAPIClient class]]
+                                                        config:self.config
+                                                    inboxStore:self.inboxStore
+                                            notificationCenter:[[NSNotificationCenter alloc] init]
+                                                    dispatcher:[UATestDispatcher testDispatcher]
+                                                          date:[[UATestDate alloc] init]];
+}
+
+- (void)syncResponse:(NSArray *)response {
+    XCTestExpectation *synced = [self expectationWithDescription:@"synced"];
+    [self.inboxStore syncMessagesWithResponse:response completionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+        [synced fulfill];
+    }];
+    [self waitForTestExpectations];
+}
+
+- (void)refreshMessageList {
+    XCTestExpectation *refreshed = [self expectationWithDescription:@"refreshed"];
+    [self.messageList refreshInboxWithCompletionHandler:^{
+        [refreshed fulfill];
+    }];
+    [self waitForTestExpectations];
+}
+
+/**
+ * Generates a message list response, as returned by the inbox API.
+ *
+ * @param messageCount The number of messages.
+ * @return The messages JSON.
+ */
+- (NSArray *)responseWithMessageCount:(NSUInteger)messageCount {
+    NSMutableArray *messages = [NSMutableArray arrayWithCapacity:messageCount];
+
+    for (NSUInteger i = 0; i < messageCount; i++) {
+        NSString *messageID = [NSString stringWithFormat:@"message-%lu", (unsigned long)i];
+        NSString *messageURL = [NSString stringWithFormat:@"https://device-api.urbanairship.com/api/user/user-id/messages/message/%@/", messageID];
+
+        [messages addObject:@{
+            @"message_id": messageID,
+            @"title": [NSString stringWithFormat:@"Your weekly picks, issue %lu", (unsigned long)i],
+            @"content_type": @"text/html",
+            @"extra": @{ @"campaign": [NSString stringWithFormat:@"campaign-%lu", (unsigned long)(i % 50)], @"category": @"newsletter" },
+            @"message_body_url": [messageURL stringByAppendingString:@"body/"],
+            @"message_url": messageURL,
+            @"message_reporting": @{ @"message_id": messageID, @"group_id": @"benchmark" },
+            @"unread": @(i % 3 != 0),
+            @"message_sent": @"2020-06-01 12:00:00",
+            @"message_expiry": @"2030-06-01 12:00:00",
+
+            // Fetches to an invalid host fail right away, so every icon stays uncached
+            @"icons": @{ @"list_icon": [NSString stringWithFormat:@"https://icons.invalid/%@.png", messageID] }
+        }];
+    }
+
+    return messages;
+}
+
+- (NSString *)summaryWithMessageCount:(NSUInteger)messageCount elapsed:(NSTimeInterval)elapsed iterations:(NSUInteger)iterations {
+    double average = iterations ? elapsed / iterations : 0;
+    return [NSString stringWithFormat:@"%lu messages: %.1f ms, %.1f us per message",
+            (unsigned long)messageCount,
+            average * 1000,
+            messageCount ? average / messageCount * 1000000 : 0];
+}
+
+@end
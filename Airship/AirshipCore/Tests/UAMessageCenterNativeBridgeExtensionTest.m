@@ -4,7 +4,7 @@
 #import "UAMessageCenterNativeBridgeExtension.h"
 #import "UAirship+Internal.h"
 #import "UAInboxMessageList.h"
-#import "UAUser.h"
+#import "UAUser+Internal.h"
 #import "UAInboxMessage.h"
 #import "UAActionArguments.h"
 #import "UAUserData+Internal.h"
@@ -48,8 +48,9 @@
 
     // Mock the message
     id message = [self mockForClass:[UAInboxMessage class]];
+    NSString *messageID = [NSUUID UUID].UUIDString;
     NSDate *messageSent = [NSDate date];
-    [[[message stub] andReturn:@"messageID"] messageID];
+    [[[message stub] andReturn:messageID] messageID];
     [[[message stub] andReturn:@"messageTitle"] title];
     [[[message stub] andReturn:messageSent] messageSent];
     [[[message stub] andReturnValue:@(YES)] unread];
@@ -59,7 +60,8 @@
 
     // Add user credentials
     UAUserData *userData = [UAUserData dataWithUsername:@"username" password:@"password"];
-    [[[self.mockUser stub] andReturn:userData] getUserDataSync];
+    [[[self.mockUser stub] andReturn:userData] getCachedUserData];
+    [[self.mockUser reject] getUserDataSync];
 
     NSString *messageSentString = [[UAUtils ISODateFormatterUTC] stringFromDate:messageSent];
     double messageSentMS = [messageSent timeIntervalSince1970] * 1000;
@@ -67,7 +69,7 @@
     // Expect the environment changes
     id javaScriptEnvironment = [self mockForClass:[UAJavaScriptEnvironment class]];
     [[javaScriptEnvironment expect] addStringGetter:@"getUserId" value:@"username"];
-    [[javaScriptEnvironment expect] addStringGetter:@"getMessageId" value:@"messageID"];
+    [[javaScriptEnvironment expect] addStringGetter:@"getMessageId" value:messageID];
     [[javaScriptEnvironment expect] addStringGetter:@"getMessageTitle" value:@"messageTitle"];
     [[javaScriptEnvironment expect] addStringGetter:@"getMessageSentDate" value:messageSentString];
     [[javaScriptEnvironment expect] addNumberGetter:@"getMessageSentDateMS" value:@(messageSentMS)];
@@ -79,6 +81,67 @@
     [javaScriptEnvironment verify];
 }
 
+/**
+ * Test user data loaded ahead of navigation is used for the environment.
+ */
+- (void)testLoadUserData {
+    NSURL *URL = [NSURL URLWithString:@"https://foo.urbanairship.com/whatever.html"];
+    [[[self.mockWKWebView stub] andReturn:URL] URL];
+
+    id message = [self mockForClass:[UAInboxMessage class]];
+    [[[message stub] andReturn:[NSUUID UUID].UUIDString] messageID];
+    [[[self.mockMessageList stub] andReturn:message] messageForBodyURL:URL];
+
+    UAUserData *userData = [UAUserData dataWithUsername:@"username" password:@"password"];
+    [[[self.mockUser stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+        void (^completionHandler)(UAUserData *) = (__bridge void (^)(UAUserData *))arg;
+        completionHandler(userData);
+    }] getUserData:OCMOCK_ANY dispatcher:OCMOCK_ANY];
+    [[self.mockUser reject] getCachedUserData];
+    [[self.mockUser reject] getUserDataSync];
+
+    XCTestExpectation *loaded = [self expectationWithDescription:@"loaded"];
+    [self.extension loadUserDataWithCompletionHandler:^{
+        [loaded fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    id javaScriptEnvironment = [self mockForClass:[UAJavaScriptEnvironment class]];
+    [[javaScriptEnvironment expect] addStringGetter:@"getUserId" value:@"username"];
+    [self.extension extendJavaScriptEnvironment:javaScriptEnvironment webView:self.mockWKWebView];
+    [javaScriptEnvironment verify];
+}
+
+/**
+ * Test the message values are reused when the same message is opened again.
+ */
+- (void)testMessageEnvironmentCached {
+    NSURL *URL = [NSURL URLWithString:@"https://foo.urbanairship.com/whatever.html"];
+    [[[self.mockWKWebView stub] andReturn:URL] URL];
+
+    NSString *messageID = [NSUUID UUID].UUIDString;
+    id message = [self mockForClass:[UAInboxMessage class]];
+    [[[message stub] andReturn:messageID] messageID];
+    [[[message stub] andReturn:@"messageTitle"] title];
+    [[[message stub] andReturn:[NSDate date]] messageSent];
+    [[[self.mockMessageList expect] andReturn:message] messageForBodyURL:URL];
+
+    [self.extension extendJavaScriptEnvironment:[UAJavaScriptEnvironment defaultEnvironment] webView:self.mockWKWebView];
+    [self.mockMessageList verify];
+
+    // A second lookup for the same message should not touch the message fields again
+    id reopened = [self strictMockForClass:[UAInboxMessage class]];
+    [[[reopened stub] andReturn:messageID] messageID];
+    [[[self.mockMessageList stub] andReturn:reopened] messageForBodyURL:URL];
+
+    id javaScriptEnvironment = [self mockForClass:[UAJavaScriptEnvironment class]];
+    [[javaScriptEnvironment expect] addStringGetter:@"getMessageTitle" value:@"messageTitle"];
+    [self.extension extendJavaScriptEnvironment:javaScriptEnvironment webView:self.mockWKWebView];
+    [javaScriptEnvironment verify];
+}
+
 /**
  * Test the action metadata includes the message if the web view's URL maps to a message.
  */
@@ -6,6 +6,8 @@
 #import "UAUser.h"
 #import "UAInboxMessageList.h"
 #import "UAComponent+Internal.h"
+#import "UAUser+Internal.h"
+#import "UAInboxMessageList+Internal.h"
 
 @interface UAMessageCenterTest : UAAirshipBaseTest
 @property (nonatomic, strong) id mockDefaultUI;
@@ -106,4 +108,40 @@
     [self.mockMessageList verify];
 }
 
+- (void)testLazyMessageCenter {
+    [[self.mockUser expect] setCreationDeferred:YES];
+    [[self.mockMessageList reject] loadSavedMessages];
+    UAMessageCenter *messageCenter = [UAMessageCenter messageCenterWithDataStore:self.dataStore
+                                                                            user:self.mockUser
+                                                                     messageList:self.mockMessageList
+                                                                       defaultUI:self.mockDefaultUI
+                                                              notificationCenter:self.notificationCenter
+                                                                     lazyEnabled:YES];
+    [self.mockUser verify];
+    [self.mockMessageList verify];
+
+    // Non Message Center pushes do not activate it
+    UANotificationContent *notification = [UANotificationContent notificationWithNotificationInfo:@{}];
+    [messageCenter receivedRemoteNotification:notification completionHandler:^(UIBackgroundFetchResult result) {}];
+    [self.mockMessageList verify];
+
+    [self.mockMessageList stopMocking];
+    self.mockMessageList = [self mockForClass:[UAInboxMessageList class]];
+    [[self.mockUser expect] setCreationDeferred:NO];
+    [[self.mockMessageList expect] loadSavedMessages];
+    [[self.mockMessageList expect] retrieveMessageListWithSuccessBlock:OCMOCK_ANY withFailureBlock:OCMOCK_ANY];
+
+    notification = [UANotificationContent notificationWithNotificationInfo:@{ @"_uamid": @"message id" }];
+    messageCenter = [UAMessageCenter messageCenterWithDataStore:self.dataStore
+                                                           user:self.mockUser
+                                                    messageList:self.mockMessageList
+                                                      defaultUI:self.mockDefaultUI
+                                             notificationCenter:self.notificationCenter
+                                                    lazyEnabled:YES];
+    [messageCenter receivedRemoteNotification:notification completionHandler:^(UIBackgroundFetchResult result) {}];
+
+    [self.mockUser verify];
+    [self.mockMessageList verify];
+}
+
 @end
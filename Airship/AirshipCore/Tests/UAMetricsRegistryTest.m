@@ -0,0 +1,135 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAMetricsRegistry+Internal.h"
+#import "UATestDispatcher.h"
+
+@interface UAMetricsRegistryTest : UABaseTest
+@property (nonatomic, strong) UAMetricsRegistry *registry;
+@property (nonatomic, strong) NSNotificationCenter *notificationCenter;
+@property (nonatomic, strong) id mockDelegate;
+@end
+
+@implementation UAMetricsRegistryTest
+
+- (void)setUp {
+    [super setUp];
+    self.notificationCenter = [[NSNotificationCenter alloc] init];
+    self.registry = [UAMetricsRegistry metricsRegistryWithNotificationCenter:self.notificationCenter
+                                                            exportDispatcher:[UATestDispatcher testDispatcher]];
+    self.mockDelegate = [self mockForProtocol:@protocol(UAMetricsRegistryDelegate)];
+    self.registry.delegate = self.mockDelegate;
+}
+
+- (void)testRecordValues {
+    [[self.mockDelegate expect] metricsRegistry:self.registry didRecordValue:2 forMetric:@"timer" type:UAMetricTypeTimer];
+    [[self.mockDelegate expect] metricsRegistry:self.registry didRecordValue:10 forMetric:@"counter" type:UAMetricTypeCounter];
+
+    for (NSUInteger i = 1; i <= 4; i++) {
+        [self.registry recordDuration:i forMetric:@"timer"];
+    }
+
+    [self.registry incrementCounter:@"counter" by:10];
+    [self.registry incrementCounter:@"counter" by:5];
+
+    [self.registry setGauge:3 forMetric:@"gauge"];
+    [self.registry setGauge:1 forMetric:@"gauge"];
+
+    [self.mockDelegate verify];
+
+    UAMetric *timer = [self.registry metricWithName:@"timer"];
+    XCTAssertEqual(UAMetricTypeTimer, timer.type);
+    XCTAssertEqual(4, timer.value);
+    XCTAssertEqual(4, timer.count);
+    XCTAssertEqual(2.5, timer.average);
+    XCTAssertEqual(4, timer.maxValue);
+    XCTAssertEqual(2, [timer percentile:50]);
+    XCTAssertEqual(4, [timer percentile:99]);
+
+    UAMetric *counter = [self.registry metricWithName:@"counter"];
+    XCTAssertEqual(15, counter.value);
+    XCTAssertEqual(2, counter.count);
+
+    UAMetric *gauge = [self.registry metricWithName:@"gauge"];
+    XCTAssertEqual(1, gauge.value);
+    XCTAssertEqual(3, gauge.maxValue);
+
+    NSArray *names = [self.registry.metrics valueForKey:@"name"];
+    NSArray *expected = @[@"counter", @"gauge", @"timer"];
+    XCTAssertEqualObjects(expected, names);
+
+    // Counters are zeroed on reset but keep their instance
+    [self.registry reset];
+    XCTAssertEqualObjects(@[@"counter"], [self.registry.metrics valueForKey:@"name"]);
+    XCTAssertEqual(0, [self.registry metricWithName:@"counter"].value);
+}
+
+- (void)testHistogram {
+    UAMetricHistogram *histogram = [self.registry histogramWithName:@"histogram" bucketBounds:@[@1, @2, @4]];
+    XCTAssertEqual(histogram, [self.registry histogramWithName:@"histogram" bucketBounds:@[@10]]);
+
+    [histogram recordValue:0.5];
+    [histogram recordValue:1.5];
+    [histogram recordValue:1.5];
+    [histogram recordValue:3];
+    [histogram recordValue:8];
+
+    NSArray *expectedCounts = @[@1, @2, @1, @1];
+    XCTAssertEqualObjects(expectedCounts, histogram.bucketCounts);
+    XCTAssertEqual(5, histogram.count);
+    XCTAssertEqual(14.5, histogram.sum);
+    XCTAssertEqual(8, histogram.maxValue);
+    XCTAssertEqual(2, [histogram percentile:50]);
+    XCTAssertEqual(8, [histogram percentile:99]);
+
+    // Copies are frozen
+    UAMetricHistogram *copy = [histogram copy];
+    [histogram recordValue:1];
+    XCTAssertEqual(5, copy.count);
+    XCTAssertEqual(6, histogram.count);
+
+    [self.registry reset];
+    XCTAssertEqual(0, histogram.count);
+    XCTAssertEqual(0, histogram.maxValue);
+    XCTAssertEqual(histogram, self.registry.histograms.firstObject);
+}
+
+- (void)testExportOnBackground {
+    id mockExporter = [self mockForProtocol:@protocol(UAMetricsExporter)];
+    [self.registry addExporter:mockExporter];
+    [[self.registry counterWithName:@"counter"] incrementBy:3];
+    [[self.registry durationHistogramWithName:@"histogram"] recordValue:0.2];
+
+    [[mockExporter expect] exportMetricsSnapshot:[OCMArg checkWithBlock:^BOOL(UAMetricsSnapshot *snapshot) {
+        return snapshot.metrics.firstObject.value == 3 && snapshot.histograms.firstObject.count == 1;
+    }]];
+
+    [self.notificationCenter postNotificationName:UAApplicationDidEnterBackgroundNotification object:nil];
+    [mockExporter verify];
+
+    // Removed exporters are no longer called
+    [self.registry removeExporter:mockExporter];
+    [[mockExporter reject] exportMetricsSnapshot:OCMOCK_ANY];
+    [self.registry exportMetrics];
+    [mockExporter verify];
+}
+
+- (void)testSampledGauge {
+    __block double value = 5;
+    [self.registry registerGaugeForMetric:@"sampled" block:^double{
+        return value;
+    }];
+
+    [[self.mockDelegate expect] metricsRegistry:self.registry didRecordValue:5 forMetric:@"sampled" type:UAMetricTypeGauge];
+    XCTAssertEqual(5, self.registry.metrics.firstObject.value);
+    [self.mockDelegate verify];
+
+    // Sampled gauges survive a reset
+    [self.registry reset];
+    value = 7;
+    UAMetric *sampled = [self.registry metricWithName:@"sampled"];
+    XCTAssertEqual(7, sampled.value);
+    XCTAssertEqual(1, sampled.count);
+}
+
+@end
@@ -0,0 +1,34 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UANSDictionaryValueTransformer.h"
+
+@interface UANSDictionaryValueTransformerTest : UABaseTest
+@property (nonatomic, strong) UANSDictionaryValueTransformer *transformer;
+@end
+
+@implementation UANSDictionaryValueTransformerTest
+
+- (void)setUp {
+    [super setUp];
+    self.transformer = [[UANSDictionaryValueTransformer alloc] init];
+}
+
+- (void)testTransformPropertyList {
+    NSDictionary *value = @{ @"cool": @"story", @"neat": @[@1, @2], @"nested": @{ @"date": [NSDate dateWithTimeIntervalSince1970:100] } };
+
+    NSData *data = [self.transformer transformedValue:value];
+    NSString *header = [[NSString alloc] initWithData:[data subdataWithRange:NSMakeRange(0, 6)] encoding:NSASCIIStringEncoding];
+    XCTAssertEqualObjects(@"bplist", header);
+
+    XCTAssertEqualObjects(value, [self.transformer reverseTransformedValue:data]);
+}
+
+- (void)testReverseTransformKeyedArchive {
+    NSDictionary *value = @{ @"cool": @"story" };
+    NSData *archive = [NSKeyedArchiver archivedDataWithRootObject:value requiringSecureCoding:YES error:nil];
+
+    XCTAssertEqualObjects(value, [self.transformer reverseTransformedValue:archive]);
+}
+
+@end
@@ -698,6 +698,51 @@ void (^disassociateSuccessDoBlock)(NSInvocation *);
     [self.mockChannel verify];
 }
 
+/**
+ * Test an identity update uploads the association, tags and attributes once, after the block.
+ */
+- (void)testPerformIdentityUpdate {
+    __block NSUInteger registrationUpdates = 0;
+    __block NSUInteger tagUpdates = 0;
+    __block NSUInteger attributeUpdates = 0;
+
+    [[[self.mockChannel stub] andDo:^(NSInvocation *invocation) {
+        registrationUpdates++;
+    }] updateRegistration];
+
+    [[[self.mockTagGroupsRegistrar stub] andDo:^(NSInvocation *invocation) {
+        tagUpdates++;
+    }] updateTagGroups];
+
+    [[[self.mockAttributeRegistrar stub] andDo:^(NSInvocation *invocation) {
+        attributeUpdates++;
+    }] updateAttributes];
+
+    [[self.mockTagGroupsRegistrar expect] setIdentifier:@"a_different_named_user" clearPendingOnChange:YES];
+    [[self.mockAttributeRegistrar expect] setIdentifier:@"a_different_named_user" clearPendingOnChange:YES];
+    [[self.mockAttributeRegistrar expect] savePendingMutations:OCMOCK_ANY];
+
+    [self.namedUser performIdentityUpdate:^{
+        self.namedUser.identifier = @"a_different_named_user";
+        [self.namedUser addTags:@[@"foo"] group:@"group"];
+        [self.namedUser updateTags];
+
+        UAAttributeMutations *mutations = [UAAttributeMutations mutations];
+        [mutations setString:@"string" forAttribute:@"attribute"];
+        [self.namedUser applyAttributeMutations:mutations];
+
+        XCTAssertEqual(0, registrationUpdates);
+        XCTAssertEqual(0, tagUpdates);
+        XCTAssertEqual(0, attributeUpdates);
+    }];
+
+    XCTAssertEqual(1, registrationUpdates);
+    XCTAssertEqual(1, tagUpdates);
+    XCTAssertEqual(1, attributeUpdates);
+    [self.mockTagGroupsRegistrar verify];
+    [self.mockAttributeRegistrar verify];
+}
+
 - (void)testClearNamedUserAttributesOnDataCollectionDisabled {
     // Expect the named user client to disassociate and call the success block
     [[[self.mockedNamedUserClient expect] andDo:disassociateSuccessDoBlock] disassociate:@"someChannel"
@@ -4,6 +4,7 @@
 #import "UANativeBridge+Internal.h"
 #import "UAirship+Internal.h"
 #import "UANativeBridgeActionHandler+Internal.h"
+#import "UAJavaScriptEnvironment+Internal.h"
 
 @interface UANativeBridgeTest : UAAirshipBaseTest
 
@@ -496,6 +497,84 @@
     [self.mockNativeBridgeDelegate verify];
 }
 
+/**
+ * Test batched commands posted through the script message handler are handled in order.
+ */
+- (void)testScriptMessageCommands {
+    NSURL *originatingURL = [NSURL URLWithString:@"https://foo.urbanairship.com/whatever.html"];
+    [[[self.mockWKWebView stub] andReturn:originatingURL] URL];
+
+    id mockMessage = [self mockForClass:[WKScriptMessage class]];
+    [[[mockMessage stub] andReturn:self.mockWKWebView] webView];
+    [[[mockMessage stub] andReturn:@{@"commands": @[@"uairship://foo/bar", @"uairship://close"]}] body];
+
+    [[[self.mockJavaScriptCommandDelegate expect] andReturnValue:@(YES)] performCommand:[OCMArg checkWithBlock:^BOOL(id obj) {
+        UAJavaScriptCommand *command = obj;
+        return [command.name isEqualToString:@"foo"] && [command.arguments isEqualToArray:@[@"bar"]];
+    }] webView:self.mockWKWebView];
+    [[self.mockNativeBridgeDelegate expect] close];
+
+    [(id<WKScriptMessageHandler>)self.nativeBridge userContentController:[[WKUserContentController alloc] init]
+                                                 didReceiveScriptMessage:mockMessage];
+
+    [self.mockJavaScriptCommandDelegate verify];
+    [self.mockNativeBridgeDelegate verify];
+}
+
+/**
+ * Test a uairship://multi navigation runs each batched command in order.
+ */
+- (void)testMultiCommand {
+    NSString *foo = [@"uairship://foo/bar" stringByAddingPercentEncodingWithAllowedCharacters:[NSCharacterSet URLHostAllowedCharacterSet]];
+    NSString *nested = [@"uairship://multi/uairship%3A%2F%2Fclose" stringByAddingPercentEncodingWithAllowedCharacters:[NSCharacterSet URLHostAllowedCharacterSet]];
+    NSString *close = [@"uairship://close" stringByAddingPercentEncodingWithAllowedCharacters:[NSCharacterSet URLHostAllowedCharacterSet]];
+    NSString *multi = [NSString stringWithFormat:@"uairship://multi/%@/%@/%@", foo, nested, close];
+
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:multi]];
+    NSURL *originatingURL = [NSURL URLWithString:@"https://foo.urbanairship.com/whatever.html"];
+
+    id mockWKNavigationAction = [self mockForClass:[WKNavigationAction class]];
+    [[[mockWKNavigationAction stub] andReturn:request] request];
+    id mockWKFrameInfo = [self mockForClass:[WKFrameInfo class]];
+    [[[mockWKNavigationAction stub] andReturn:mockWKFrameInfo] targetFrame];
+    [[[self.mockWKWebView stub] andReturn:originatingURL] URL];
+
+    [[[self.mockJavaScriptCommandDelegate expect] andReturnValue:@(YES)] performCommand:[OCMArg checkWithBlock:^BOOL(id obj) {
+        UAJavaScriptCommand *command = obj;
+        return [command.name isEqualToString:@"foo"] && [command.arguments isEqualToArray:@[@"bar"]];
+    }] webView:self.mockWKWebView];
+
+    // Only the top level close, the nested batch is ignored
+    [[self.mockNativeBridgeDelegate expect] close];
+    [[self.mockNativeBridgeDelegate reject] close];
+
+    [self.nativeBridge webView:self.mockWKWebView decidePolicyForNavigationAction:mockWKNavigationAction decisionHandler:^(WKNavigationActionPolicy delegatePolicy) {
+       XCTAssertEqual(delegatePolicy, WKNavigationActionPolicyCancel);
+    }];
+
+    [self.mockJavaScriptCommandDelegate verify];
+    [self.mockNativeBridgeDelegate verify];
+}
+
+/**
+ * Test script messages from a page that is not allowed are ignored.
+ */
+- (void)testScriptMessageNotAllowed {
+    NSURL *originatingURL = [NSURL URLWithString:@"https://foo.notAllowed.com/whatever.html"];
+    [[[self.mockWKWebView stub] andReturn:originatingURL] URL];
+
+    id mockMessage = [self mockForClass:[WKScriptMessage class]];
+    [[[mockMessage stub] andReturn:self.mockWKWebView] webView];
+    [[[mockMessage stub] andReturn:@{@"commands": @[@"uairship://close"]}] body];
+
+    [[self.mockNativeBridgeDelegate reject] close];
+
+    [(id<WKScriptMessageHandler>)self.nativeBridge userContentController:[[WKUserContentController alloc] init]
+                                                 didReceiveScriptMessage:mockMessage];
+
+    [self.mockNativeBridgeDelegate verify];
+}
+
 /**
  * Test webView:didFinishNavigation: injects the Airship JavaScript environment.
  */
@@ -512,6 +591,28 @@
     [self.mockWKWebView verify];
 }
 
+/**
+ * Test web views with the library user script only receive the environment values.
+ */
+- (void)testInjectJavaScriptEnvironmentValues {
+    NSURL *originatingURL = [NSURL URLWithString:@"https://foo.urbanairship.com/whatever.html"];;
+    [[[self.mockWKWebView stub] andReturn:originatingURL] URL];
+    id mockWKNavigation = [self mockForClass:[WKNavigation class]];
+
+    WKWebViewConfiguration *configuration = [[WKWebViewConfiguration alloc] init];
+    [configuration.userContentController addUserScript:[UANativeBridge libraryUserScript]];
+    [[[self.mockWKWebView stub] andReturn:configuration] configuration];
+
+    [[[self.mockJavaScriptEnvironment stub] andReturn:@"values!"] buildValues];
+    [[self.mockJavaScriptEnvironment reject] build];
+    [[self.mockWKWebView expect] evaluateJavaScript:@"values!" completionHandler:OCMOCK_ANY];
+
+    [self.nativeBridge webView:self.mockWKWebView didFinishNavigation:mockWKNavigation];
+
+    [self.mockWKWebView verify];
+    XCTAssertEqual(1, configuration.userContentController.userScripts.count);
+}
+
 /**
  * Test extending the JavaScript environment with the native bridge extension delegate.
  */
@@ -0,0 +1,106 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UANetworkMetrics+Internal.h"
+
+@interface UANetworkMetricsTest : UABaseTest
+@property (nonatomic, strong) UANetworkMetrics *networkMetrics;
+@property (nonatomic, strong) NSDate *start;
+@end
+
+@implementation UANetworkMetricsTest
+
+- (void)setUp {
+    [super setUp];
+    self.networkMetrics = [UANetworkMetrics networkMetrics];
+    self.start = [NSDate date];
+}
+
+- (id)mockTaskWithURL:(NSString *)URL {
+    id mockTask = [self mockForClass:[NSURLSessionTask class]];
+    [[[mockTask stub] andReturn:[NSURLRequest requestWithURL:[NSURL URLWithString:URL]]] originalRequest];
+    [[[mockTask stub] andReturnValue:OCMOCK_VALUE((int64_t)100)] countOfBytesSent];
+    [[[mockTask stub] andReturnValue:OCMOCK_VALUE((int64_t)200)] countOfBytesReceived];
+    return mockTask;
+}
+
+- (id)mockMetricsWithDuration:(NSTimeInterval)duration reused:(BOOL)reused {
+    id mockTransaction = [self mockForClass:[NSURLSessionTaskTransactionMetrics class]];
+    [[[mockTransaction stub] andReturnValue:OCMOCK_VALUE(reused)] isReusedConnection];
+
+    if (!reused) {
+        [[[mockTransaction stub] andReturn:self.start] domainLookupStartDate];
+        [[[mockTransaction stub] andReturn:[self.start dateByAddingTimeInterval:0.01]] domainLookupEndDate];
+        [[[mockTransaction stub] andReturn:[self.start dateByAddingTimeInterval:0.02]] secureConnectionStartDate];
+        [[[mockTransaction stub] andReturn:[self.start dateByAddingTimeInterval:0.05]] secureConnectionEndDate];
+    }
+
+    [[[mockTransaction stub] andReturn:[self.start dateByAddingTimeInterval:0.05]] requestStartDate];
+    [[[mockTransaction stub] andReturn:[self.start dateByAddingTimeInterval:0.15]] responseStartDate];
+    [[[mockTransaction stub] andReturn:[self.start dateByAddingTimeInterval:0.25]] responseEndDate];
+
+    NSDateInterval *interval = [[NSDateInterval alloc] initWithStartDate:self.start duration:duration];
+
+    id mockMetrics = [self mockForClass:[NSURLSessionTaskMetrics class]];
+    [[[mockMetrics stub] andReturn:@[mockTransaction]] transactionMetrics];
+    [[[mockMetrics stub] andReturn:interval] taskInterval];
+    return mockMetrics;
+}
+
+- (void)testEndpointForURL {
+    XCTAssertEqualObjects(@"device-api.urbanairship.com/api/channels/*",
+                          [UANetworkMetrics endpointForURL:[NSURL URLWithString:@"https://device-api.urbanairship.com/api/channels/9c36e8c7-5a73-47c0-9716-99fd3d4197d5"]]);
+
+    XCTAssertEqualObjects(@"combine.urbanairship.com/warp9",
+                          [UANetworkMetrics endpointForURL:[NSURL URLWithString:@"https://combine.urbanairship.com/warp9/"]]);
+
+    XCTAssertEqualObjects(@"remote-data.urbanairship.com/api/remote-data/app/*/ios",
+                          [UANetworkMetrics endpointForURL:[NSURL URLWithString:@"https://remote-data.urbanairship.com/api/remote-data/app/ISex_TTJRuarzs9-o_Gkhg1/ios?sdk_version=14.0.0"]]);
+}
+
+- (void)testRecordMetrics {
+    NSString *URL = @"https://device-api.urbanairship.com/api/channels/";
+    [self.networkMetrics recordMetrics:[self mockMetricsWithDuration:1 reused:NO] task:[self mockTaskWithURL:URL]];
+    [self.networkMetrics recordMetrics:[self mockMetricsWithDuration:2 reused:YES] task:[self mockTaskWithURL:URL]];
+    [self.networkMetrics recordMetrics:[self mockMetricsWithDuration:3 reused:YES] task:[self mockTaskWithURL:URL]];
+    [self.networkMetrics recordMetrics:[self mockMetricsWithDuration:4 reused:YES] task:[self mockTaskWithURL:URL]];
+
+    XCTAssertEqual(1, self.networkMetrics.endpointMetrics.count);
+
+    UANetworkEndpointMetrics *metrics = self.networkMetrics.endpointMetrics.firstObject;
+    XCTAssertEqualObjects(@"device-api.urbanairship.com/api/channels", metrics.endpoint);
+    XCTAssertEqual(4, metrics.requestCount);
+    XCTAssertEqual(3, metrics.reusedConnectionCount);
+    XCTAssertEqualWithAccuracy(0.75, metrics.connectionReuseRate, 0.001);
+    XCTAssertEqual(400, metrics.bytesSent);
+    XCTAssertEqual(800, metrics.bytesReceived);
+
+    // Only the first request looked up DNS and negotiated TLS
+    XCTAssertEqualWithAccuracy(0.01, metrics.averageDNSTime, 0.001);
+    XCTAssertEqualWithAccuracy(0.03, metrics.averageTLSTime, 0.001);
+    XCTAssertEqualWithAccuracy(0.1, metrics.averageTimeToFirstByte, 0.001);
+    XCTAssertEqualWithAccuracy(0.1, metrics.averageTransferTime, 0.001);
+
+    XCTAssertEqualWithAccuracy(2, [metrics latencyPercentile:50], 0.001);
+    XCTAssertEqualWithAccuracy(4, [metrics latencyPercentile:90], 0.001);
+    XCTAssertEqualWithAccuracy(1, [metrics latencyPercentile:0], 0.001);
+
+    [self.networkMetrics reset];
+    XCTAssertEqual(0, self.networkMetrics.endpointMetrics.count);
+}
+
+- (void)testDelegate {
+    id mockDelegate = [self mockForProtocol:@protocol(UANetworkMetricsDelegate)];
+    self.networkMetrics.delegate = mockDelegate;
+
+    id metrics = [self mockMetricsWithDuration:1 reused:NO];
+    [[mockDelegate expect] networkMetrics:self.networkMetrics
+                        didCollectMetrics:metrics
+                              forEndpoint:@"combine.urbanairship.com/warp9"];
+
+    [self.networkMetrics recordMetrics:metrics task:[self mockTaskWithURL:@"https://combine.urbanairship.com/warp9/"]];
+
+    [mockDelegate verify];
+}
+
+@end
@@ -0,0 +1,59 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UANetworkWindow+Internal.h"
+#import "UATestDate.h"
+#import "UATestDispatcher.h"
+
+@interface UANetworkWindowTest : UABaseTest
+@property (nonatomic, strong) UATestDate *testDate;
+@property (nonatomic, strong) NSNotificationCenter *notificationCenter;
+@property (nonatomic, strong) UANetworkWindow *window;
+@property (nonatomic, assign) NSUInteger openedCount;
+@end
+
+@implementation UANetworkWindowTest
+
+- (void)setUp {
+    [super setUp];
+    self.testDate = [[UATestDate alloc] initWithAbsoluteTime:[NSDate date]];
+    self.notificationCenter = [[NSNotificationCenter alloc] init];
+    self.window = [UANetworkWindow windowWithNotificationCenter:self.notificationCenter
+                                                           date:self.testDate
+                                                     dispatcher:[UATestDispatcher testDispatcher]];
+
+    [self.notificationCenter addObserver:self
+                                selector:@selector(windowOpened)
+                                    name:UANetworkWindowOpenedEvent
+                                  object:nil];
+}
+
+- (void)tearDown {
+    [self.notificationCenter removeObserver:self];
+    [super tearDown];
+}
+
+- (void)windowOpened {
+    self.openedCount++;
+}
+
+- (void)testRequestsShareWindow {
+    XCTAssertFalse(self.window.isOpen);
+
+    [self.window requestStarted];
+    XCTAssertTrue(self.window.isOpen);
+    XCTAssertEqual(1, self.openedCount);
+
+    self.testDate.timeOffset = UANetworkWindowDuration - 1;
+    [self.window requestStarted];
+    XCTAssertEqual(1, self.openedCount);
+
+    self.testDate.timeOffset = UANetworkWindowDuration;
+    XCTAssertFalse(self.window.isOpen);
+
+    [self.window requestStarted];
+    XCTAssertTrue(self.window.isOpen);
+    XCTAssertEqual(2, self.openedCount);
+}
+
+@end
@@ -6,6 +6,7 @@
 #import "UANotificationCategory.h"
 #import "UANotificationAction.h"
 #import "UATextInputNotificationAction.h"
+#import "UALocaleManager+Internal.h"
 
 @interface UANotificationCategoriesTest : UABaseTest
 
@@ -41,6 +42,18 @@
     }
 }
 
+- (void)testDefaultCategoriesCachedUntilLocaleChange {
+    NSSet *categories = [UANotificationCategories defaultCategoriesWithRequireAuth:YES];
+    XCTAssertTrue(categories == [UANotificationCategories defaultCategoriesWithRequireAuth:YES]);
+    XCTAssertFalse(categories == [UANotificationCategories defaultCategoriesWithRequireAuth:NO]);
+
+    [[NSNotificationCenter defaultCenter] postNotificationName:UALocaleUpdatedEvent object:nil];
+
+    NSSet *rebuilt = [UANotificationCategories defaultCategoriesWithRequireAuth:YES];
+    XCTAssertFalse(categories == rebuilt);
+    XCTAssertEqual(categories.count, rebuilt.count);
+}
+
 - (void)testCreateFromPlist {
     NSString *plistPath = [[NSBundle bundleForClass:[self class]] pathForResource:@"CustomNotificationCategories" ofType:@"plist"];
     NSSet *categories = [UANotificationCategories createCategoriesFromFile:plistPath];
@@ -144,4 +144,48 @@
     XCTAssertTrue([notification.notificationInfo isEqualToDictionary:self.notificationWithBody]);
 }
 
+// Tests the payload is parsed the same regardless of which field is read first
+- (void)testNotificationDictionaryLocalizationKeysReadFirst {
+    UANotificationContent *notification = [UANotificationContent notificationWithNotificationInfo:self.notificationWithBody];
+
+    XCTAssertEqualObjects(self.notificationWithBody[@"aps"][@"alert"][@"loc-key"], notification.localizationKeys[@"loc-key"]);
+    XCTAssertEqualObjects(self.notificationWithBody[@"aps"][@"alert"][@"title"], notification.alertTitle);
+    XCTAssertEqualObjects(self.notificationWithBody[@"aps"][@"alert"][@"body"], notification.alertBody);
+    XCTAssertEqualObjects(self.notificationWithBody[@"aps"][@"badge"], notification.badge);
+}
+
+// Tests the alert fields come from the delivered notification, even when the localization keys are read first
+- (void)testUNNotificationLocalizationKeysReadFirst {
+    [self stubNotificationWithTitle:@"localized title" body:@"localized body" userInfo:self.notificationWithBody];
+    UANotificationContent *notification = [UANotificationContent notificationWithUNNotification:self.mockedUNNotification];
+
+    XCTAssertEqualObjects(self.notificationWithBody[@"aps"][@"alert"][@"loc-key"], notification.localizationKeys[@"loc-key"]);
+    XCTAssertEqualObjects(self.notificationWithBody[@"aps"][@"alert"][@"title-loc-key"], notification.localizationKeys[@"title-loc-key"]);
+    XCTAssertEqualObjects(@"localized title", notification.alertTitle);
+    XCTAssertEqualObjects(@"localized body", notification.alertBody);
+}
+
+// Tests the localization keys are still parsed from the payload when the alert fields are read first
+- (void)testUNNotificationAlertReadFirst {
+    [self stubNotificationWithTitle:@"localized title" body:@"localized body" userInfo:self.notificationWithBody];
+    UANotificationContent *notification = [UANotificationContent notificationWithUNNotification:self.mockedUNNotification];
+
+    XCTAssertEqualObjects(@"localized title", notification.alertTitle);
+    XCTAssertEqualObjects(@"localized body", notification.alertBody);
+    XCTAssertEqualObjects(@"category", notification.categoryIdentifier);
+    XCTAssertEqualObjects(self.notificationWithBody[@"aps"][@"sound"], notification.sound);
+    XCTAssertEqualObjects(self.notificationWithBody[@"aps"][@"alert"][@"loc-key"], notification.localizationKeys[@"loc-key"]);
+}
+
+- (void)stubNotificationWithTitle:(NSString *)title body:(NSString *)body userInfo:(NSDictionary *)userInfo {
+    UNMutableNotificationContent *content = [[UNMutableNotificationContent alloc] init];
+    content.title = title;
+    content.body = body;
+    content.categoryIdentifier = @"category";
+    content.userInfo = userInfo;
+
+    UNNotificationRequest *request = [UNNotificationRequest requestWithIdentifier:@"identifier" content:content trigger:nil];
+    [[[self.mockedUNNotification stub] andReturn:request] request];
+}
+
 @end
@@ -32,22 +32,81 @@
     XCTAssertEqualObjects(mutation.payload, fromHistory.payload);
 }
 
-- (void)testAddingPendingMutationsDoesntCollapseMutations {
+- (void)testAddingPendingMutationsCollapsesMutations {
     UATagGroupsMutation *add = [UATagGroupsMutation mutationToAddTags:@[@"tag1"] group:@"group"];
     UATagGroupsMutation *remove = [UATagGroupsMutation mutationToRemoveTags:@[@"tag2", @"tag1"] group:@"group"];
 
     [self.pendingTagGroupStore addPendingMutation:remove];
     [self.pendingTagGroupStore addPendingMutation:add];
 
+    XCTAssertEqual(1, self.pendingTagGroupStore.pendingMutations.count);
+
     UATagGroupsMutation *fromHistory = [self.pendingTagGroupStore popPendingMutation];
 
-    NSDictionary *expected = @{ @"remove": @{ @"group": @[@"tag2", @"tag1"] }};
+    NSDictionary *expected = @{ @"remove": @{ @"group": @[@"tag2"] }, @"add": @{ @"group": @[@"tag1"] } };
     XCTAssertEqualObjects(expected, fromHistory.payload);
+    XCTAssertNil([self.pendingTagGroupStore popPendingMutation]);
+}
 
-    fromHistory = [self.pendingTagGroupStore popPendingMutation];
-    
-    expected = @{ @"add": @{ @"group": @[@"tag1"] }};
-    XCTAssertEqualObjects(expected, fromHistory.payload);
+/**
+ * Test the collapsed state is persisted and restored.
+ */
+- (void)testCollapsedMutationsPersist {
+    [self.pendingTagGroupStore addPendingMutation:[UATagGroupsMutation mutationToSetTags:@[@"tag1"] group:@"group"]];
+    for (NSUInteger i = 0; i < 100; i++) {
+        NSString *tag = [NSString stringWithFormat:@"tag%lu", (unsigned long)(i % 2)];
+        [self.pendingTagGroupStore addPendingMutation:[UATagGroupsMutation mutationToAddTags:@[tag] group:@"other"]];
+        [self.pendingTagGroupStore addPendingMutation:[UATagGroupsMutation mutationToRemoveTags:@[tag] group:@"other"]];
+    }
+
+    UAPendingTagGroupStore *restored = [UAPendingTagGroupStore channelHistoryWithDataStore:self.dataStore];
+    XCTAssertEqual(2, restored.pendingMutations.count);
+
+    NSDictionary *expected = @{ @"set": @{ @"group": @[@"tag1"] } };
+    XCTAssertEqualObjects(expected, [restored popPendingMutation].payload);
+
+    NSDictionary *tagGroups = [[restored popPendingMutation] applyToTagGroups:@{ @"other": @[@"tag0", @"tag1", @"tag2"] }];
+    XCTAssertEqualObjects(@{ @"other": [NSSet setWithObject:@"tag2"] }, tagGroups);
+    XCTAssertNil([restored popPendingMutation]);
+}
+
+/**
+ * Test mutations past the pending tag limit are dropped.
+ */
+- (void)testPendingTagLimit {
+    NSMutableArray *tags = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 5000; i++) {
+        [tags addObject:[NSString stringWithFormat:@"tag%lu", (unsigned long)i]];
+    }
+
+    [self.pendingTagGroupStore addPendingMutation:[UATagGroupsMutation mutationToAddTags:tags group:@"group"]];
+    [self.pendingTagGroupStore addPendingMutation:[UATagGroupsMutation mutationToAddTags:@[@"one more"] group:@"group"]];
+
+    UATagGroupsMutation *pending = [self.pendingTagGroupStore peekPendingMutation];
+    XCTAssertEqual(5000, [pending tagCount]);
+}
+
+/**
+ * Test the pending tag limit tracks the collapsed state as mutations are folded and popped.
+ */
+- (void)testPendingTagLimitTracksCollapsedState {
+    NSMutableArray *tags = [NSMutableArray array];
+    for (NSUInteger i = 0; i < 4999; i++) {
+        [tags addObject:[NSString stringWithFormat:@"tag%lu", (unsigned long)i]];
+    }
+
+    [self.pendingTagGroupStore addPendingMutation:[UATagGroupsMutation mutationToAddTags:tags group:@"group"]];
+
+    // Toggling the same tag does not grow the collapsed state
+    for (NSUInteger i = 0; i < 10; i++) {
+        [self.pendingTagGroupStore addPendingMutation:[UATagGroupsMutation mutationToRemoveTags:@[@"toggle"] group:@"other"]];
+        [self.pendingTagGroupStore addPendingMutation:[UATagGroupsMutation mutationToAddTags:@[@"toggle"] group:@"other"]];
+    }
+    XCTAssertEqual(5000, [[self.pendingTagGroupStore peekPendingMutation] tagCount]);
+
+    [self.pendingTagGroupStore popPendingMutation];
+    [self.pendingTagGroupStore addPendingMutation:[UATagGroupsMutation mutationToAddTags:@[@"one more"] group:@"group"]];
+    XCTAssertEqual(1, [[self.pendingTagGroupStore peekPendingMutation] tagCount]);
 }
 
 - (void)testCollapsePendingMutations {
@@ -101,12 +160,12 @@
 
     UAPendingTagGroupStore *channelTagGroupsMutationHistory = [UAPendingTagGroupStore channelHistoryWithDataStore:self.dataStore];
 
-    UATagGroupsMutation *oldAddRemoveFromHistory = [channelTagGroupsMutationHistory popPendingMutation];
-    NSDictionary *expected = @{ @"add": @{ @"group1": @[@"tag1"] }, @"remove": @{ @"group2": @[@"tag2"] } };
-    XCTAssertEqualObjects(expected, oldAddRemoveFromHistory.payload);
+    // Migrated mutations are collapsed with the rest
+    XCTAssertEqual(1, channelTagGroupsMutationHistory.pendingMutations.count);
 
-    UATagGroupsMutation *oldMutationFromHistory = [channelTagGroupsMutationHistory popPendingMutation];
-    XCTAssertEqualObjects(oldMutation.payload, oldMutationFromHistory.payload);
+    UATagGroupsMutation *fromHistory = [channelTagGroupsMutationHistory popPendingMutation];
+    NSDictionary *expected = @{ @"group1": [NSSet setWithArray:@[@"tag1", @"foo", @"bar"]], @"group2": [NSSet set] };
+    XCTAssertEqualObjects(expected, [fromHistory applyToTagGroups:@{ @"group2": @[@"tag2"] }]);
 }
 
 @end
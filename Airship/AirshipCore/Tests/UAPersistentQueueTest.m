@@ -0,0 +1,117 @@
+/* Copyright Airship and Contributors */
+
+#import "UAAirshipBaseTest.h"
+#import "UAPersistentQueue+Internal.h"
+
+@interface UAPersistentQueueTest : UAAirshipBaseTest
+@property (nonatomic, strong) NSURL *directoryURL;
+@property (nonatomic, strong) UAPersistentQueue *queue;
+@end
+
+@implementation UAPersistentQueueTest
+
+- (void)setUp {
+    [super setUp];
+    self.directoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    self.queue = [self createQueue];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtURL:self.directoryURL error:nil];
+    [super tearDown];
+}
+
+- (UAPersistentQueue *)createQueue {
+    return [UAPersistentQueue persistentQueueWithDataStore:self.dataStore
+                                                       key:@"UAPersistentQueueTest"
+                                              directoryURL:self.directoryURL];
+}
+
+- (void)testAddPeekPop {
+    [self.queue addObject:@"foo"];
+    [self.queue addObjects:@[@"bar", @"baz"]];
+
+    XCTAssertEqualObjects(@"foo", [self.queue peekObject]);
+    XCTAssertEqualObjects(@"foo", [self.queue popObject]);
+    XCTAssertEqualObjects(@"bar", [self.queue popObject]);
+
+    NSArray *expected = @[@"baz"];
+    XCTAssertEqualObjects(expected, [self.queue objects]);
+}
+
+- (void)testPersistence {
+    [self.queue addObjects:@[@"foo", @"bar", @"baz"]];
+    [self.queue popObject];
+    [self.queue addObject:@"qux"];
+
+    NSArray *expected = @[@"bar", @"baz", @"qux"];
+    XCTAssertEqualObjects(expected, [[self createQueue] objects]);
+}
+
+- (void)testSetObjectsAndCollapse {
+    [self.queue addObjects:@[@"foo", @"bar"]];
+    [self.queue setObjects:@[@"baz"]];
+    [self.queue addObject:@"qux"];
+    [self.queue collapse:^NSArray<id<NSCoding>> *(NSArray<id<NSCoding>> *objects) {
+        return [objects arrayByAddingObject:@"quux"];
+    }];
+
+    NSArray *expected = @[@"baz", @"qux", @"quux"];
+    XCTAssertEqualObjects(expected, [self.queue objects]);
+    XCTAssertEqualObjects(expected, [[self createQueue] objects]);
+}
+
+- (void)testClear {
+    [self.queue addObjects:@[@"foo", @"bar"]];
+    [self.queue clear];
+
+    XCTAssertNil([self.queue peekObject]);
+    XCTAssertEqual(0, [[self createQueue] objects].count);
+}
+
+- (void)testCompaction {
+    for (NSUInteger i = 0; i < 500; i++) {
+        [self.queue addObject:@(i)];
+        [self.queue popObject];
+        [self.queue addObject:@(i)];
+    }
+
+    XCTAssertEqual(500, [[self createQueue] objects].count);
+    XCTAssertEqualObjects(@(499), [[[self createQueue] objects] lastObject]);
+}
+
+- (void)testMigratesArchivedQueue {
+    NSArray *legacy = @[@"foo", @"bar"];
+    [self.dataStore setObject:[NSKeyedArchiver archivedDataWithRootObject:legacy] forKey:@"UAPersistentQueueTest"];
+
+    UAPersistentQueue *queue = [self createQueue];
+    XCTAssertEqualObjects(legacy, [queue objects]);
+    XCTAssertFalse([[self.dataStore objectForKey:@"UAPersistentQueueTest"] isKindOfClass:[NSData class]]);
+
+    [queue popObject];
+    NSArray *expected = @[@"bar"];
+    XCTAssertEqualObjects(expected, [[self createQueue] objects]);
+}
+
+- (void)testJournalDoesNotDependOnDataStore {
+    [self.queue addObjects:@[@"foo", @"bar"]];
+    [self.dataStore removeAll];
+
+    NSArray *expected = @[@"foo", @"bar"];
+    XCTAssertEqualObjects(expected, [[self createQueue] objects]);
+}
+
+- (void)testFallsBackToDataStore {
+    // A file in place of the directory makes the journal unwritable
+    [[NSFileManager defaultManager] createFileAtPath:self.directoryURL.path contents:nil attributes:nil];
+
+    [self.queue addObjects:@[@"foo", @"bar"]];
+    [self.queue popObject];
+
+    XCTAssertTrue([[self.dataStore objectForKey:@"UAPersistentQueueTest"] isKindOfClass:[NSData class]]);
+
+    NSArray *expected = @[@"bar"];
+    XCTAssertEqualObjects(expected, [[self createQueue] objects]);
+}
+
+@end
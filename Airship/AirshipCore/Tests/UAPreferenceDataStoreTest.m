@@ -2,6 +2,7 @@
 
 #import "UAAirshipBaseTest.h"
 #import "UAPreferenceDataStore+Internal.h"
+#import "UAPreferenceDatabase+Internal.h"
 
 @interface UAPreferenceDataStoreTest : UAAirshipBaseTest
 
@@ -63,4 +64,45 @@
     XCTAssertNil([self.dataStore objectForKey:@"key"]);
 }
 
+- (void)testWritesAreSharedBetweenDataStores {
+    [self.dataStore setInteger:10 forKey:@"integer"];
+
+    UAPreferenceDataStore *otherDataStore = [UAPreferenceDataStore preferenceDataStoreWithKeyPrefix:self.dataStore.keyPrefix];
+    XCTAssertEqual(10, [otherDataStore integerForKey:@"integer"]);
+
+    [otherDataStore removeObjectForKey:@"integer"];
+    XCTAssertFalse([self.dataStore keyExists:@"integer"]);
+}
+
+- (void)testSynchronize {
+    NSString *prefixedKey = [self.dataStore.keyPrefix stringByAppendingString:@"key"];
+    NSURL *url = [NSURL URLWithString:@"https://airship.com"];
+
+    [self.dataStore setURL:url forKey:@"key"];
+    [self.dataStore synchronize];
+
+    NSData *stored = [[UAPreferenceDatabase sharedDatabase] loadValues][prefixedKey];
+    XCTAssertEqualObjects(url, [NSKeyedUnarchiver unarchiveObjectWithData:stored]);
+    XCTAssertEqualObjects(url, [self.dataStore URLForKey:@"key"]);
+    XCTAssertNil([[NSUserDefaults standardUserDefaults] objectForKey:prefixedKey]);
+}
+
+- (void)testMigrateDefaults {
+    NSString *prefix = [[NSProcessInfo processInfo] globallyUniqueString];
+    NSString *prefixedKey = [prefix stringByAppendingString:@"key"];
+    [[NSUserDefaults standardUserDefaults] setObject:@"value" forKey:prefixedKey];
+
+    UAPreferenceDataStore *dataStore = [UAPreferenceDataStore preferenceDataStoreWithKeyPrefix:prefix];
+    XCTAssertEqualObjects(@"value", [dataStore stringForKey:@"key"]);
+    XCTAssertNil([[NSUserDefaults standardUserDefaults] objectForKey:prefixedKey]);
+
+    // Only migrated once
+    [[NSUserDefaults standardUserDefaults] setObject:@"other value" forKey:prefixedKey];
+    dataStore = [UAPreferenceDataStore preferenceDataStoreWithKeyPrefix:prefix];
+    XCTAssertEqualObjects(@"value", [dataStore stringForKey:@"key"]);
+
+    [dataStore removeAll];
+    [[NSUserDefaults standardUserDefaults] removeObjectForKey:prefixedKey];
+}
+
 @end
@@ -0,0 +1,64 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAPreferenceDatabase+Internal.h"
+
+@interface UAPreferenceDatabaseTest : UABaseTest
+@property (nonatomic, copy) NSString *path;
+@property (nonatomic, strong) UAPreferenceDatabase *database;
+@end
+
+@implementation UAPreferenceDatabaseTest
+
+- (void)setUp {
+    [super setUp];
+    NSString *directory = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    self.path = [directory stringByAppendingPathComponent:@"Preferences.sqlite"];
+    self.database = [UAPreferenceDatabase databaseWithPath:self.path];
+}
+
+- (void)tearDown {
+    [[NSFileManager defaultManager] removeItemAtPath:[self.path stringByDeletingLastPathComponent] error:nil];
+    [super tearDown];
+}
+
+- (void)testWriteValues {
+    NSDictionary *values = @{ @"string": @"value", @"number": @(1), @"array": @[@"a", @"b"], @"data": [NSData data] };
+    XCTAssertTrue([self.database writeValues:values]);
+    XCTAssertEqualObjects(values, [[UAPreferenceDatabase databaseWithPath:self.path] loadValues]);
+
+    XCTAssertTrue([self.database writeValues:@{ @"string": [NSNull null], @"number": @(2) }]);
+
+    NSDictionary *expected = @{ @"number": @(2), @"array": @[@"a", @"b"], @"data": [NSData data] };
+    XCTAssertEqualObjects(expected, [self.database loadValues]);
+}
+
+- (void)testRemoveValuesWithPrefix {
+    [self.database writeValues:@{ @"a_%key": @"value", @"abkey": @"value", @"b.key": @"value" }];
+
+    XCTAssertTrue([self.database removeValuesWithPrefix:@"a_%"]);
+
+    NSDictionary *expected = @{ @"abkey": @"value", @"b.key": @"value" };
+    XCTAssertEqualObjects(expected, [self.database loadValues]);
+}
+
+- (void)testMigrateValues {
+    XCTAssertFalse([self.database hasMigratedPrefix:@"prefix."]);
+
+    XCTAssertTrue([self.database migrateValues:@{ @"prefix.key": @"value" } prefix:@"prefix."]);
+
+    XCTAssertTrue([self.database hasMigratedPrefix:@"prefix."]);
+    XCTAssertFalse([self.database hasMigratedPrefix:@"other."]);
+    XCTAssertEqualObjects(@"value", [self.database loadValues][@"prefix.key"]);
+}
+
+- (void)testMigrateValuesKeepsStoredValues {
+    [self.database writeValues:@{ @"prefix.key": @"newer" }];
+
+    XCTAssertTrue([self.database migrateValues:@{ @"prefix.key": @"stale", @"prefix.other": @"value" } prefix:@"prefix."]);
+
+    NSDictionary *expected = @{ @"prefix.key": @"newer", @"prefix.other": @"value" };
+    XCTAssertEqualObjects(expected, [self.database loadValues]);
+}
+
+@end
@@ -485,6 +485,26 @@ NSString *validDeviceToken = @"0123456789abcdef0123456789abcdef";
                  @"timezone should be able to be cleared in standardUserDefaults");
 }
 
+- (void)testAddCustomCategories {
+    UANotificationCategory *first = [UANotificationCategory categoryWithIdentifier:@"first" actions:@[] intentIdentifiers:@[] options:UANotificationCategoryOptionNone];
+    UANotificationCategory *second = [UANotificationCategory categoryWithIdentifier:@"second" actions:@[] intentIdentifiers:@[] options:UANotificationCategoryOptionNone];
+    UANotificationCategory *replacement = [UANotificationCategory categoryWithIdentifier:@"first" actions:@[] intentIdentifiers:@[] options:UANotificationCategoryOptionCustomDismissAction];
+    UANotificationCategory *airship = [UANotificationCategory categoryWithIdentifier:@"ua_category" actions:@[] intentIdentifiers:@[] options:UANotificationCategoryOptionNone];
+
+    self.push.customCategories = [NSSet setWithObject:first];
+    NSSet *combined = self.push.combinedCategories;
+    XCTAssertTrue([combined containsObject:first]);
+
+    self.push.shouldUpdateAPNSRegistration = NO;
+    [self.push addCustomCategories:[NSSet setWithArray:@[second, replacement, airship]]];
+
+    XCTAssertTrue(self.push.shouldUpdateAPNSRegistration);
+    XCTAssertEqualObjects(([NSSet setWithArray:@[second, replacement]]), self.push.customCategories);
+    XCTAssertTrue([self.push.combinedCategories containsObject:replacement]);
+    XCTAssertFalse([self.push.combinedCategories containsObject:first]);
+    XCTAssertEqual(combined.count + 1, self.push.combinedCategories.count);
+}
+
 /**
  * Test update apns registration when user notifications are enabled.
  */
@@ -75,7 +75,7 @@
     NSNumber *todayTimestamp = [NSNumber numberWithDouble:[[NSDate date] timeIntervalSince1970]];
 
     // Inject time stamps of zero one and two to indicate three timestamps long ago
-    [[NSUserDefaults standardUserDefaults] setObject:@[@0, @1, @2] forKey:[@"mockAppKey" stringByAppendingString:@"RateAppActionPromptCount"]];
+    [dataStore setObject:@[@0, @1, @2] forKey:@"RateAppActionPromptCount"];
 
     // Make sure there are stored timestamps
     NSArray *timestamps = [dataStore arrayForKey:@"RateAppActionPromptCount"];
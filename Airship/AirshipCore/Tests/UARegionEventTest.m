@@ -160,6 +160,37 @@
     XCTAssertEqualObjects(event.proximityRegion.RSSI, [[event.data objectForKey:@"proximity"] objectForKey:@"rssi"], @"Unexpected RSSI.");
 }
 
+/**
+ * Test the payload is built once and rebuilt when a region is set.
+ */
+- (void)testPayloadCached {
+    UARegionEvent *event = [UARegionEvent regionEventWithRegionID:@"region_id" source:@"source" boundaryEvent:UABoundaryEventEnter];
+    NSDictionary *payload = event.payload;
+    XCTAssertTrue(payload == event.payload);
+    XCTAssertTrue(event.data == event.data);
+
+    event.circularRegion = [UACircularRegion circularRegionWithRadius:@11 latitude:@45.5200 longitude:@122.6819];
+    XCTAssertEqualObjects(@11, event.payload[@"circular_region"][@"radius"]);
+    XCTAssertEqualObjects(@"11.0", event.data[@"circular_region"][@"radius"]);
+}
+
+/**
+ * Test enter and exit flapping is coalesced.
+ */
+- (void)testCoalescedRegionEvents {
+    UARegionEvent *enterA = [UARegionEvent regionEventWithRegionID:@"a" source:@"source" boundaryEvent:UABoundaryEventEnter];
+    UARegionEvent *exitA = [UARegionEvent regionEventWithRegionID:@"a" source:@"source" boundaryEvent:UABoundaryEventExit];
+    UARegionEvent *enterAAgain = [UARegionEvent regionEventWithRegionID:@"a" source:@"source" boundaryEvent:UABoundaryEventEnter];
+    UARegionEvent *enterB = [UARegionEvent regionEventWithRegionID:@"b" source:@"source" boundaryEvent:UABoundaryEventEnter];
+    UARegionEvent *enterBAgain = [UARegionEvent regionEventWithRegionID:@"b" source:@"source" boundaryEvent:UABoundaryEventEnter];
+    UARegionEvent *exitC = [UARegionEvent regionEventWithRegionID:@"c" source:@"source" boundaryEvent:UABoundaryEventExit];
+    UARegionEvent *enterC = [UARegionEvent regionEventWithRegionID:@"c" source:@"source" boundaryEvent:UABoundaryEventEnter];
+
+    NSArray *events = @[enterA, enterB, exitA, exitC, enterBAgain, enterC, enterAAgain];
+    NSArray *expected = @[enterB, enterAAgain];
+    XCTAssertEqualObjects(expected, [UARegionEvent coalescedRegionEvents:events]);
+}
+
 /**
  * Test character count validation
  */
@@ -288,6 +288,43 @@
     }
 }
 
+/**
+ * Test republishing the same config only applies the modules that changed.
+ */
+- (void)testUnchangedConfigIsNotReapplied {
+    UARemoteDataPayload *config = [UARemoteConfigManagerTest remoteConfigWithName:@"app_config"
+                                                                           config:@{
+                                                                               kUARemoteConfigModulePush: @{ @"foo": @"bar" },
+                                                                               kUARemoteConfigModuleLocation: @"some config",
+                                                                               @"disable_features": @[@{ @"modules": @[kUARemoteConfigModuleLocation] }]
+                                                                           }];
+
+    self.publishBlock(@[config]);
+    XCTAssertEqual(kUARemoteConfigModuleAllModules.count, self.testModuleAdapter.appliedConfig.count);
+    XCTAssertEqualObjects([NSSet setWithObject:kUARemoteConfigModuleLocation], self.testModuleAdapter.disabledModuleNames);
+
+    [self.testModuleAdapter.appliedConfig removeAllObjects];
+    [self.testModuleAdapter.enabledModuleNames removeAllObjects];
+    [self.testModuleAdapter.disabledModuleNames removeAllObjects];
+
+    self.publishBlock(@[config]);
+    XCTAssertEqual(0, self.testModuleAdapter.appliedConfig.count);
+    XCTAssertEqual(0, self.testModuleAdapter.enabledModuleNames.count);
+    XCTAssertEqual(0, self.testModuleAdapter.disabledModuleNames.count);
+
+    UARemoteDataPayload *updated = [UARemoteConfigManagerTest remoteConfigWithName:@"app_config"
+                                                                            config:@{
+                                                                                kUARemoteConfigModulePush: @{ @"foo": @"baz" },
+                                                                                kUARemoteConfigModuleLocation: @"some config",
+                                                                                @"disable_features": @[]
+                                                                            }];
+
+    self.publishBlock(@[updated]);
+    XCTAssertEqualObjects(@[kUARemoteConfigModulePush], self.testModuleAdapter.appliedConfig.allKeys);
+    XCTAssertEqualObjects([NSSet setWithObject:kUARemoteConfigModuleLocation], self.testModuleAdapter.enabledModuleNames);
+    XCTAssertEqual(0, self.testModuleAdapter.disabledModuleNames.count);
+}
+
 
 + (UARemoteDataPayload *)remoteConfigWithName:(NSString *)name
                                        config:(NSDictionary *)config {
@@ -255,6 +255,53 @@
     [self.mockSession verify];
 }
 
+/**
+ * Test a Retry-After on a failed refresh is passed on instead of retried by the session
+ */
+- (void)testFailedRefreshRemoteDataRetryAfter {
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@""] statusCode:429 HTTPVersion:nil headerFields:@{@"retry-after": @"120"}];
+
+    // Stub the session to return the response
+    [[[self.mockSession stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:3];
+        UARequestRetryBlock retryBlock = (__bridge UARequestRetryBlock)arg;
+        XCTAssertFalse(retryBlock(nil, response));
+
+        [invocation getArgument:&arg atIndex:4];
+        UARequestCompletionHandler completionHandler = (__bridge UARequestCompletionHandler)arg;
+
+        completionHandler(nil, (NSURLResponse *)response, nil);
+    }] dataTaskWithRequest:OCMOCK_ANY retryWhere:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    XCTestExpectation *refreshFinished = [self expectationWithDescription:@"Refresh finished"];
+
+    [self.remoteDataAPIClient fetchRemoteData:^(NSArray<UARemoteDataPayload *> *remoteData, NSError *error) {
+        XCTAssertNil(remoteData);
+        XCTAssertEqual(error.code, UARemoteDataAPIClientErrorUnsuccessfulStatus);
+        XCTAssertEqualObjects(@(120), error.userInfo[UARemoteDataAPIClientRetryAfterKey]);
+        [refreshFinished fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
+/**
+ * Test parsing the Cache-Control max age
+ */
+- (void)testCacheMaxAge {
+    NSHTTPURLResponse *(^response)(NSDictionary *) = ^(NSDictionary *headers) {
+        return [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@""] statusCode:200 HTTPVersion:nil headerFields:headers];
+    };
+
+    XCTAssertEqual(300, [UARemoteDataAPIClient cacheMaxAgeForResponse:response(@{@"Cache-Control": @"public, max-age=300"})]);
+    XCTAssertEqual(0, [UARemoteDataAPIClient cacheMaxAgeForResponse:response(@{@"Cache-Control": @"no-cache, max-age=300"})]);
+    XCTAssertEqual(0, [UARemoteDataAPIClient cacheMaxAgeForResponse:response(@{})]);
+
+    // Capped to a day
+    XCTAssertEqual(86400, [UARemoteDataAPIClient cacheMaxAgeForResponse:response(@{@"Cache-Control": @"max-age=999999"})]);
+}
+
 /**
  * Test refresh the remote data when no remote data returned from cloud
  */
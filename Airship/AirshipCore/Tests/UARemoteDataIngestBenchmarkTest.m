@@ -0,0 +1,432 @@
+/* Copyright Airship and Contributors */
+
+#import <CoreData/CoreData.h>
+#import <QuartzCore/QuartzCore.h>
+
+#import "UABenchmarkTest.h"
+#import "UARemoteDataManager+Internal.h"
+#import "UARemoteDataAPIClient+Internal.h"
+#import "UARemoteDataStore+Internal.h"
+#import "UAInAppRemoteDataClient+Internal.h"
+#import "UAAutomationEngine+Internal.h"
+#import "UAAutomationStore+Internal.h"
+#import "UAirship+Internal.h"
+#import "UAApplicationMetrics+Internal.h"
+#import "UALocaleManager+Internal.h"
+#import "UAChannel.h"
+#import "UAUtils+Internal.h"
+#import "UATestDispatcher.h"
+#import "UATestDate.h"
+#import "UATestAppStateTracker+Internal.h"
+
+static NSString * const UABenchmarkInAppMessagesType = @"in_app_messages";
+
+/**
+ * Benchmarks for ingesting in-app message listings. A generated listing goes through the remote data
+ * manager, the in-memory remote data store, the in-app remote data client and the automation engine
+ * onto an in-memory automation store, the same path a listing from the cloud takes.
+ *
+ * Next to a first ingest, it measures an identical refresh, which should be near-free, and a refresh
+ * where only the listing timestamp changed, which has to check every message without rescheduling any.
+ * The ingest time per message and the number of Core Data saves are attached to the results.
+ */
+@interface UARemoteDataIngestBenchmarkTest : UABenchmarkTest <UAInAppRemoteDataClientDelegate>
+@property (nonatomic, strong) id mockAPIClient;
+@property (nonatomic, strong) id mockLocaleManager;
+@property (nonatomic, strong) id mockChannel;
+@property (nonatomic, strong) id mockAirship;
+@property (nonatomic, strong) UATestDate *testDate;
+@property (nonatomic, strong) UATestDispatcher *testDispatcher;
+@property (nonatomic, strong) UATestAppStateTracker *testAppStateTracker;
+
+@property (nonatomic, strong) UARemoteDataStore *remoteDataStore;
+@property (nonatomic, strong) UARemoteDataManager *remoteDataManager;
+@property (nonatomic, strong) UAAutomationStore *automationStore;
+@property (nonatomic, strong) UAAutomationEngine *automationEngine;
+@property (nonatomic, strong) UAInAppRemoteDataClient *remoteDataClient;
+@property (nonatomic, strong) NSOperationQueue *operationQueue;
+
+@property (nonatomic, copy) NSArray<NSDictionary *> *listing;
+@property (nonatomic, assign) NSUInteger saves;
+@end
+
+@implementation UARemoteDataIngestBenchmarkTest
+
+- (void)setUp {
+    [super setUp];
+
+    self.testDate = [[UATestDate alloc] initWithAbsoluteTime:[NSDate date]];
+    self.testDispatcher = [UATestDispatcher testDispatcher];
+    self.testAppStateTracker = [UATestAppStateTracker shared];
+
+    self.mockAirship = [self mockForClass:[UAirship class]];
+    [UAirship setSharedAirship:self.mockAirship];
+    [[[self.mockAirship stub] andReturn:[self mockForClass:[UAApplicationMetrics class]]] applicationMetrics];
+
+    self.mockLocaleManager = [self mockForClass:[UALocaleManager class]];
+    [[[self.mockLocaleManager stub] andReturn:[NSLocale autoupdatingCurrentLocale]] currentLocale];
+
+    self.mockChannel = [self mockForClass:[UAChannel class]];
+
+    // Returns the current listing for every refresh
+    self.mockAPIClient = [self mockForClass:[UARemoteDataAPIClient class]];
+    [[[self.mockAPIClient stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+        void (^completionHandler)(NSArray<NSDictionary *> *, NSError *) = (__bridge void (^)(NSArray<NSDictionary *> *, NSError *))arg;
+        completionHandler(self.listing, nil);
+    }] fetchRemoteData:OCMOCK_ANY];
+
+    [[NSNotificationCenter defaultCenter] addObserver:self
+                                             selector:@selector(contextDidSave:)
+                                                 name:NSManagedObjectContextDidSaveNotification
+                                               object:nil];
+}
+
+- (void)tearDown {
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+    [self stopPipeline];
+    [super tearDown];
+}
+
+- (void)testIngest100Messages {
+    [self measureIngestWithMessageCount:100];
+}
+
+- (void)testIngest500Messages {
+    [self measureIngestWithMessageCount:500];
+}
+
+- (void)testIngest2000Messages {
+    [self measureIngestWithMessageCount:2000];
+}
+
+- (void)testUnchangedRefresh2000Messages {
+    [self measureRefreshWithMessageCount:2000 newTimestamp:NO];
+}
+
+- (void)testRetimestampedRefresh2000Messages {
+    [self measureRefreshWithMessageCount:2000 newTimestamp:YES];
+}
+
+#pragma mark -
+#pragma mark Benchmarks
+
+- (void)measureIngestWithMessageCount:(NSUInteger)messageCount {
+    if (@available(iOS 13.0, tvOS 13.0, *)) {
+        self.listing = [self listingWithMessageCount:messageCount
+                                           timestamp:self.testDate.now
+                                         lastUpdated:[self.testDate.now dateByAddingTimeInterval:-1]];
+
+        __block NSTimeInterval elapsed = 0;
+        __block NSUInteger iterations = 0;
+        __block NSUInteger saves = 0;
+
+        [self measureWithMetrics:self.benchmarkMetrics options:self.manualMeasureOptions block:^{
+            [self stopPipeline];
+            [self.dataStore removeAll];
+            [self startPipelineWithScheduleLimit:messageCount];
+            self.saves = 0;
+
+            [self startMeasuring];
+            CFTimeInterval start = CACurrentMediaTime();
+            [self refreshAndWait];
+            elapsed += CACurrentMediaTime() - start;
+            iterations++;
+            [self stopMeasuring];
+
+            saves += self.saves;
+        }];
+
+        [self verifyScheduleCount:messageCount];
+        [self attachSummaryWithName:@"Ingest"
+                            summary:[self summaryWithMessageCount:messageCount
+                                                          elapsed:elapsed
+                                                       iterations:iterations
+                                                            saves:saves]];
+    }
+}
+
+- (void)measureRefreshWithMessageCount:(NSUInteger)messageCount newTimestamp:(BOOL)newTimestamp {
+    if (@available(iOS 13.0, tvOS 13.0, *)) {
+        NSDate *lastUpdated = [self.testDate.now dateByAddingTimeInterval:-1];
+        self.listing = [self listingWithMessageCount:messageCount timestamp:self.testDate.now lastUpdated:lastUpdated];
+        [self startPipelineWithScheduleLimit:messageCount];
+        [self refreshAndWait];
+
+        __block NSTimeInterval elapsed = 0;
+        __block NSUInteger iterations = 0;
+        __block NSUInteger saves = 0;
+
+        [self measureWithMetrics:self.benchmarkMetrics options:self.manualMeasureOptions block:^{
+            if (newTimestamp) {
+                // Same messages, but the listing is newer than the last one
+                self.testDate.timeOffset += 60;
+                self.listing = [self listingWithMessageCount:messageCount timestamp:self.testDate.now lastUpdated:lastUpdated];
+            }
+
+            self.saves = 0;
+
+            [self startMeasuring];
+            CFTimeInterval start = CACurrentMediaTime();
+            [self refreshAndWait];
+            elapsed += CACurrentMediaTime() - start;
+            iterations++;
+            [self stopMeasuring];
+
+            saves += self.saves;
+        }];
+
+        if (!newTimestamp) {
+            XCTAssertEqual(0, saves, @"An unchanged refresh should not write to any store");
+        }
+
+        [self verifyScheduleCount:messageCount];
+        [self attachSummaryWithName:newTimestamp ? @"Retimestamped refresh" : @"Unchanged refresh"
+                            summary:[self summaryWithMessageCount:messageCount
+                                                          elapsed:elapsed
+                                                       iterations:iterations
+                                                            saves:saves]];
+    }
+}
+
+#pragma mark -
+#pragma mark UAInAppRemoteDataClientDelegate
+
+- (void)getSchedules:(void (^)(NSArray<UASchedule *> *))completionHandler {
+    [self.automationEngine getSchedules:completionHandler];
+}
+
+- (void)updateSchedulesWithEdits:(NSDictionary<NSString *, UAScheduleEdits *> *)edits
+                    newSchedules:(NSArray<UASchedule *> *)schedules
+               completionHandler:(void (^)(BOOL))completionHandler {
+    [self.automationEngine updateSchedulesWithEdits:edits newSchedules:schedules completionHandler:completionHandler];
+}
+
+- (void)updateFrequencyConstraints:(NSArray<UAFrequencyConstraint *> *)constraints {
+    [self.automationEngine updateFrequencyConstraints:constraints];
+}
+
+#pragma mark -
+#pragma mark Helpers
+
+- (void)startPipelineWithScheduleLimit:(NSUInteger)scheduleLimit {
+    self.remoteDataStore = [UARemoteDataStore storeWithName:@"UARemoteDataIngestBenchmarkTest" inMemory:YES];
+
+    // Created in the background so it does not refresh before the benchmark does
+    self.testAppStateTracker.currentState = UAApplicationStateBackground;
+    self.remoteDataManager = [UARemoteDataManager remoteDataManagerWithConfig:self.config
+                                                                    dataStore:self.dataStore
+                                                              remoteDataStore:self.remoteDataStore
+                                                          remoteDataAPIClient:self.mockAPIClient
+                                                           notificationCenter:[[NSNotificationCenter alloc] init]
+                                                              appStateTracker:self.testAppStateTracker
+                                                                   dispatcher:self.testDispatcher
+                                                                         date:self.testDate
+                                                                localeManager:self.mockLocaleManager];
+    self.testAppStateTracker.currentState = UAApplicationStateActive;
+
+    self.automationStore = [UAAutomationStore automationStoreWithConfig:self.config
+                                                          scheduleLimit:scheduleLimit
+                                                               inMemory:YES
+                                                                   date:self.testDate];
+
+    self.automationEngine = [UAAutomationEngine automationEngineWithAutomationStore:self.automationStore
+                                                                    appStateTracker:[self mockForClass:[UAAppStateTracker class]]
+                                                                     timerScheduler:[UATimerScheduler timerSchedulerWithSchedulerBlock:^(NSTimer *timer) {}]
+                                                                 notificationCenter:[[NSNotificationCenter alloc] init]
+                                                                         dispatcher:self.testDispatcher
+                                                             triggerEventDispatcher:self.testDispatcher
+                                                                        application:[self mockForClass:[UIApplication class]]
+                                                                               date:self.testDate];
+    self.automationEngine.delegate = [self mockForProtocol:@protocol(UAAutomationEngineDelegate)];
+    [self.automationEngine start];
+
+    self.operationQueue = [[NSOperationQueue alloc] init];
+    self.operationQueue.maxConcurrentOperationCount = 1;
+
+    self.remoteDataClient = [UAInAppRemoteDataClient clientWithRemoteDataProvider:self.remoteDataManager
+                                                                        dataStore:self.dataStore
+                                                                          channel:self.mockChannel
+                                                                   operationQueue:self.operationQueue];
+    self.remoteDataClient.delegate = self;
+    [self.remoteDataClient subscribe];
+
+    [self waitForStores];
+}
+
+- (void)stopPipeline {
+    [self.operationQueue waitUntilAllOperationsAreFinished];
+    self.remoteDataClient = nil;
+    self.remoteDataManager = nil;
+
+    [self.automationEngine stop];
+    [self.automationStore shutDown];
+    [self.automationStore waitForIdle];
+    [self.remoteDataStore shutDown];
+    [self.remoteDataStore waitForIdle];
+
+    self.automationEngine = nil;
+    self.automationStore = nil;
+    self.remoteDataStore = nil;
+}
+
+/**
+ * Refreshes remote data, then waits for the in-app remote data client to finish processing
+ * the listing and for both stores to finish writing.
+ */
+- (void)refreshAndWait {
+    XCTestExpectation *refreshed = [self expectationWithDescription:@"refreshed"];
+    [self.remoteDataManager refreshWithCompletionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+        [refreshed fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    // The client processes listings in order on a serial queue
+    XCTestExpectation *processed = [self expectationWithDescription:@"processed"];
+    [self.operationQueue addOperationWithBlock:^{
+        [processed fulfill];
+    }];
+    [self waitForTestExpectations];
+
+    [self waitForStores];
+}
+
+- (void)waitForStores {
+    [self.remoteDataStore waitForIdle];
+    [self.automationStore waitForIdle];
+}
+
+- (void)verifyScheduleCount:(NSUInteger)count {
+    XCTestExpectation *fetched = [self expectationWithDescription:@"fetched"];
+    [self.automationEngine getSchedules:^(NSArray<UASchedule *> *schedules) {
+        XCTAssertEqual(count, schedules.count);
+        [fetched fulfill];
+    }];
+    [self waitForTestExpectations];
+}
+
+- (void)contextDidSave:(NSNotification *)notification {
+    @synchronized (self) {
+        self.saves++;
+    }
+}
+
+/**
+ * Generates an in-app message listing, as returned by the remote data API. Each message is a banner
+ * with buttons, actions, triggers and reporting data, around 1.5KB of JSON like a real campaign.
+ *
+ * @param messageCount The number of messages.
+ * @param timestamp The listing timestamp.
+ * @param lastUpdated The created and last updated time of every message.
+ * @return The remote data JSON.
+ */
+- (NSArray<NSDictionary *> *)listingWithMessageCount:(NSUInteger)messageCount
+                                           timestamp:(NSDate *)timestamp
+                                         lastUpdated:(NSDate *)lastUpdated {
+    NSDateFormatter *formatter = [UAUtils ISODateFormatterUTCWithDelimiter];
+    NSString *updated = [formatter stringFromDate:lastUpdated];
+
+    NSMutableArray *messages = [NSMutableArray arrayWithCapacity:messageCount];
+    for (NSUInteger i = 0; i < messageCount; i++) {
+        NSString *messageID = [NSString stringWithFormat:@"8c5a6c8e-2f5e-4b0a-9d3e-%012lu", (unsigned long)i];
+        NSString *campaign = [NSString stringWithFormat:@"campaign-%lu", (unsigned long)(i % 50)];
+
+        [messages addObject:@{
+            @"id": messageID,
+            @"type": @"in_app_message",
+            @"created": updated,
+            @"last_updated": updated,
+            @"priority": @(i % 10),
+            @"limit": @(1),
+            @"group": campaign,
+            @"end": @"2030-01-01T00:00:00",
+            @"edit_grace_period": @(14),
+            @"triggers": @[
+                @{
+                    @"type": @"custom_event_count",
+                    @"goal": @(1),
+                    @"predicate": @{
+                        @"and": @[@{
+                            @"key": @"event_name",
+                            @"value": @{ @"equals": [NSString stringWithFormat:@"purchase-%lu", (unsigned long)(i % 100)] }
+                        }]
+                    }
+                },
+                @{
+                    @"type": @"screen",
+                    @"goal": @(1),
+                    @"predicate": @{ @"value": @{ @"equals": [NSString stringWithFormat:@"screen-%lu", (unsigned long)(i % 100)] } }
+                }
+            ],
+            @"message": @{
+                @"message_id": messageID,
+                @"name": [NSString stringWithFormat:@"Spring sale %lu", (unsigned long)i],
+                @"display_type": @"banner",
+                @"display": @{
+                    @"heading": @{
+                        @"text": @"Spring sale is on",
+                        @"color": @"#1E1E1E",
+                        @"size": @(18),
+                        @"alignment": @"left",
+                        @"style": @[@"bold"]
+                    },
+                    @"body": @{
+                        @"text": @"Take 20% off everything in the spring collection this weekend only. Tap to browse the new arrivals and find your favorites before they sell out.",
+                        @"color": @"#3C3C3C",
+                        @"size": @(14),
+                        @"alignment": @"left"
+                    },
+                    @"buttons": @[
+                        @{
+                            @"id": @"shop",
+                            @"label": @{ @"text": @"Shop now", @"color": @"#FFFFFF" },
+                            @"background_color": @"#0066CC",
+                            @"border_radius": @(4),
+                            @"behavior": @"dismiss",
+                            @"actions": @{ @"deep_link_action": [NSString stringWithFormat:@"app://shop/collections/spring?campaign=%@", campaign] }
+                        },
+                        @{
+                            @"id": @"later",
+                            @"label": @{ @"text": @"Maybe later", @"color": @"#0066CC" },
+                            @"behavior": @"dismiss"
+                        }
+                    ],
+                    @"placement": @"top",
+                    @"duration": @(15),
+                    @"background_color": @"#FFFFFF",
+                    @"dismiss_button_color": @"#1E1E1E",
+                    @"border_radius": @(8)
+                },
+                @"actions": @{ @"add_tags_action": @[@"spring_sale", campaign] },
+                @"campaigns": @{ @"categories": @[@"seasonal", @"sale"] },
+                @"reporting_context": @{ @"content_types": @[@"in_app_message"], @"experiment_id": campaign },
+                @"source": @"remote-data"
+            }
+        }];
+    }
+
+    return @[@{
+        @"type": UABenchmarkInAppMessagesType,
+        @"timestamp": [formatter stringFromDate:timestamp],
+        @"data": @{ UABenchmarkInAppMessagesType: messages }
+    }];
+}
+
+- (NSString *)summaryWithMessageCount:(NSUInteger)messageCount
+                              elapsed:(NSTimeInterval)elapsed
+                           iterations:(NSUInteger)iterations
+                                saves:(NSUInteger)saves {
+    NSData *json = [NSJSONSerialization dataWithJSONObject:self.listing options:0 error:nil];
+    double average = iterations ? elapsed / iterations : 0;
+
+    return [NSString stringWithFormat:@"%lu messages (%.0f KB listing): %.1f ms per refresh, %.1f us per message, %.1f store saves per refresh",
+            (unsigned long)messageCount,
+            json.length / 1024.0,
+            average * 1000,
+            messageCount ? average / messageCount * 1000000 : 0,
+            iterations ? (double)saves / iterations : 0];
+}
+
+@end
@@ -20,10 +20,18 @@
  */
 @interface UATestRemoteDataStore : UARemoteDataStore
 @property (nonatomic, assign) BOOL failOverwriteCachedRemoteDataWithResponse;
+@property (nonatomic, strong) NSMutableArray<NSSet<NSString *> *> *replacedTypes;
+@property (nonatomic, assign) NSUInteger fetchCount;
 @end
 
 @implementation UATestRemoteDataStore
 
+- (void)fetchRemoteDataFromCacheWithPredicate:(NSPredicate *)predicate
+                            completionHandler:(void (^)(NSArray<UARemoteDataStorePayload *> *))completionHandler {
+    self.fetchCount++;
+    [super fetchRemoteDataFromCacheWithPredicate:predicate completionHandler:completionHandler];
+}
+
 - (void)overwriteCachedRemoteDataWithResponse:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads completionHandler:(void (^)(BOOL))completionHandler {
     if (self.failOverwriteCachedRemoteDataWithResponse) {
         completionHandler(NO);
@@ -32,6 +40,21 @@
     }
 }
 
+- (void)updateCachedRemoteDataWithPayloads:(NSArray<UARemoteDataPayload *> *)remoteDataPayloads
+                            replacingTypes:(NSSet<NSString *> *)payloadTypes
+                         completionHandler:(void (^)(BOOL))completionHandler {
+    if (!self.replacedTypes) {
+        self.replacedTypes = [NSMutableArray array];
+    }
+    [self.replacedTypes addObject:payloadTypes];
+
+    if (self.failOverwriteCachedRemoteDataWithResponse) {
+        completionHandler(NO);
+    } else {
+        [super updateCachedRemoteDataWithPayloads:remoteDataPayloads replacingTypes:payloadTypes completionHandler:completionHandler];
+    }
+}
+
 @end
 
 @interface UARemoteDataManagerTest : UAAirshipBaseTest
@@ -49,6 +72,7 @@
 @property (nonatomic, copy) NSArray<NSDictionary *> *remoteDataFromCloud;
 @property (nonatomic, assign) BOOL expectAPIClientFetch;
 @property (nonatomic, strong) UATestDate *testDate;
+@property (nonatomic, strong) UATestDispatcher *testDispatcher;
 
 @end
 
@@ -64,15 +88,19 @@
 
     self.testStore = [UATestRemoteDataStore storeWithName:@"UARemoteDataManagerTest." inMemory:YES];
     self.testDate = [[UATestDate alloc] initWithAbsoluteTime:[NSDate date]];
+    self.testDispatcher = [UATestDispatcher testDispatcher];
 
     self.mockLocaleManagerClass = [self mockForClass:[UALocaleManager class]];
     [[[self.mockLocaleManagerClass stub] andReturn:[NSLocale autoupdatingCurrentLocale]] currentLocale];
 
+    // Create the manager in the background so it does not start a refresh before the API client is stubbed
+    self.testAppStateTracker = [UATestAppStateTracker shared];
+    self.testAppStateTracker.currentState = UAApplicationStateBackground;
     self.remoteDataManager = [self createManager];
+    self.testAppStateTracker.currentState = UAApplicationStateActive;
+
     self.expectAPIClientFetch = YES;
     self.expectedMetadata = [self.remoteDataManager createMetadata:[NSLocale autoupdatingCurrentLocale]];
-
-    self.testAppStateTracker = [UATestAppStateTracker shared];
 }
 
 - (void)tearDown {
@@ -588,9 +616,124 @@
     [subscription dispose];
 }
 
+// simulate multiple payloads from cloud
+// simulate one changed payload from cloud
+// only the changed payload type should be rewritten to the store and the other subscriber not notified
+- (void)testOnlyChangedTypesAreStored {
+    NSArray<UARemoteDataPayload *> *testPayloads = [self createNPayloadsAndSetupTest:2 metadata:self.expectedMetadata];
+
+    __block NSUInteger unchangedCallbackCount = 0;
+    UADisposable *unchangedSubscription = [self.remoteDataManager subscribeWithTypes:@[testPayloads[0].type] block:^(NSArray<UARemoteDataPayload *> * _Nonnull remoteDataArray) {
+        unchangedCallbackCount++;
+    }];
+
+    [self refresh];
+    [self waitForTestExpectations];
+    XCTAssertEqual(1, unchangedCallbackCount);
+
+    // Unchanged response does not touch the store
+    [self refresh];
+    [self waitForTestExpectations];
+    XCTAssertEqual(0, self.testStore.replacedTypes.count);
+
+    // Change the second payload
+    [self replaceTestPayloads:@[testPayloads[0], [self changePayload:testPayloads[1]]]];
+    [self refresh];
+    [self waitForTestExpectations];
+
+    XCTAssertEqual(1, self.testStore.replacedTypes.count);
+    XCTAssertEqualObjects([NSSet setWithObject:testPayloads[1].type], self.testStore.replacedTypes.firstObject);
+    XCTAssertEqual(1, unchangedCallbackCount);
+
+    [unchangedSubscription dispose];
+}
+
+/**
+ * Test subscribers to the same type share the published payloads.
+ */
+- (void)testSubscribersShareTypePayloads {
+    NSArray<UARemoteDataPayload *> *testPayloads = [self createNPayloadsAndSetupTest:2 metadata:self.expectedMetadata];
+
+    __block NSArray *firstReceived;
+    __block NSArray *secondReceived;
+    XCTestExpectation *firstExpectation = [self expectationWithDescription:@"First subscriber received data"];
+    XCTestExpectation *secondExpectation = [self expectationWithDescription:@"Second subscriber received data"];
+
+    UADisposable *firstSubscription = [self.remoteDataManager subscribeWithTypes:@[testPayloads[1].type] block:^(NSArray<UARemoteDataPayload *> * _Nonnull remoteDataArray) {
+        firstReceived = remoteDataArray;
+        [firstExpectation fulfill];
+    }];
+
+    UADisposable *secondSubscription = [self.remoteDataManager subscribeWithTypes:@[testPayloads[1].type] block:^(NSArray<UARemoteDataPayload *> * _Nonnull remoteDataArray) {
+        secondReceived = remoteDataArray;
+        [secondExpectation fulfill];
+    }];
+
+    [self refresh];
+    [self waitForTestExpectations];
+
+    XCTAssertEqualObjects(@[testPayloads[1]], firstReceived);
+    XCTAssertEqual(firstReceived, secondReceived);
+
+    [firstSubscription dispose];
+    [secondSubscription dispose];
+}
+
 /**
  * Test that the result is sorted by the subscribe order.
  */
+- (void)testSubscribersServedFromSnapshot {
+    NSArray<UARemoteDataPayload *> *testPayloads = [self createNPayloadsAndSetupTest:2 metadata:self.expectedMetadata];
+
+    [self refresh];
+    [self waitForTestExpectations];
+
+    NSUInteger fetchCount = self.testStore.fetchCount;
+
+    for (UARemoteDataPayload *payload in testPayloads) {
+        XCTestExpectation *receivedData = [self expectationWithDescription:@"Received remote data"];
+        UADisposable *subscription = [self.remoteDataManager subscribeWithTypes:@[payload.type] block:^(NSArray<UARemoteDataPayload *> *remoteDataArray) {
+            XCTAssertEqualObjects(@[payload], remoteDataArray);
+            [receivedData fulfill];
+        }];
+
+        [self waitForTestExpectations];
+        [subscription dispose];
+    }
+
+    // The refresh filled the snapshot, the store is not read again
+    XCTAssertEqual(fetchCount, self.testStore.fetchCount);
+}
+
+- (void)testColdStartReadsStoreOnce {
+    NSArray<UARemoteDataPayload *> *testPayloads = [self createNPayloadsAndSetupTest:2 metadata:self.expectedMetadata];
+
+    [self refresh];
+    [self waitForTestExpectations];
+
+    // A new manager over the same store, as on the next launch
+    self.testAppStateTracker.currentState = UAApplicationStateBackground;
+    self.remoteDataManager = [self createManager];
+    self.testAppStateTracker.currentState = UAApplicationStateActive;
+    self.testStore.fetchCount = 0;
+
+    NSMutableArray<UADisposable *> *subscriptions = [NSMutableArray array];
+    for (UARemoteDataPayload *payload in testPayloads) {
+        XCTestExpectation *receivedData = [self expectationWithDescription:@"Received remote data"];
+        [subscriptions addObject:[self.remoteDataManager subscribeWithTypes:@[payload.type] block:^(NSArray<UARemoteDataPayload *> *remoteDataArray) {
+            XCTAssertEqualObjects(@[payload], remoteDataArray);
+            [receivedData fulfill];
+        }]];
+    }
+
+    [self waitForTestExpectations];
+    XCTAssertEqual(1, self.testStore.fetchCount);
+
+    for (UADisposable *subscription in subscriptions) {
+        [subscription dispose];
+    }
+}
+
 - (void)testSortUpdates {
     NSMutableArray<UARemoteDataPayload *> *testPayloads = [[self createNPayloadsAndSetupTest:2 metadata:self.expectedMetadata] mutableCopy];
     NSArray *reversed = [[testPayloads reverseObjectEnumerator] allObjects];
@@ -659,6 +802,101 @@
     [subscription dispose];
 }
 
+/**
+ * Test refreshes requested while a refresh is in progress share its fetch.
+ */
+- (void)testConcurrentRefreshesShareFetch {
+    __block NSUInteger fetchCount = 0;
+    __block void (^fetchCompletionHandler)(NSArray<NSDictionary *> *, NSError *);
+    [[[self.mockAPIClient stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+        fetchCompletionHandler = (__bridge void (^)(NSArray<NSDictionary *> *, NSError *))arg;
+        fetchCount++;
+    }] fetchRemoteData:OCMOCK_ANY];
+
+    [self refresh];
+    [self refresh];
+    XCTAssertEqual(1, fetchCount);
+
+    // Up to date
+    fetchCompletionHandler(nil, nil);
+    [self waitForTestExpectations];
+
+    // A new refresh makes a new request
+    [self refresh];
+    XCTAssertEqual(2, fetchCount);
+    fetchCompletionHandler(nil, nil);
+    [self waitForTestExpectations];
+}
+
+/**
+ * Test refreshes are skipped until the server's Retry-After has passed.
+ */
+- (void)testRetryAfter {
+    __block NSError *error = [NSError errorWithDomain:UARemoteDataAPIClientErrorDomain
+                                                 code:UARemoteDataAPIClientErrorUnsuccessfulStatus
+                                             userInfo:@{ UARemoteDataAPIClientRetryAfterKey : @(60) }];
+    __block NSUInteger fetchCount = 0;
+    [[[self.mockAPIClient stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+        void (^completionHandler)(NSArray<NSDictionary *> *, NSError *) = (__bridge void (^)(NSArray<NSDictionary *> *, NSError *))arg;
+        fetchCount++;
+        completionHandler(nil, error);
+    }] fetchRemoteData:OCMOCK_ANY];
+
+    [self refresh];
+    [self waitForTestExpectations];
+    XCTAssertEqual(1, fetchCount);
+
+    // Still waiting
+    self.testDate.timeOffset = 59;
+
+    XCTestExpectation *skipped = [self expectationWithDescription:@"Refresh skipped"];
+    [self.remoteDataManager refreshWithCompletionHandler:^(BOOL success) {
+        XCTAssertFalse(success);
+        [skipped fulfill];
+    }];
+    [self waitForTestExpectations];
+    XCTAssertEqual(1, fetchCount);
+
+    error = nil;
+    self.testDate.timeOffset = 61;
+
+    XCTestExpectation *refreshed = [self expectationWithDescription:@"Refreshed"];
+    [self.remoteDataManager refreshWithCompletionHandler:^(BOOL success) {
+        XCTAssertTrue(success);
+        [refreshed fulfill];
+    }];
+    [self waitForTestExpectations];
+    XCTAssertEqual(2, fetchCount);
+}
+
+/**
+ * Test refresh pushes wait the device's share of the push refresh jitter before refreshing.
+ */
+- (void)testRefreshPushJitter {
+    [self setUpMockAPIClientToReturnRemoteData:nil error:nil];
+    self.remoteDataManager.maxPushRefreshJitter = 10;
+    [self.dataStore setDouble:0.5 forKey:@"remotedata.PUSH_REFRESH_JITTER"];
+
+    __block UIBackgroundFetchResult fetchResult = UIBackgroundFetchResultFailed;
+    __block BOOL completed = NO;
+    UANotificationContent *notification = [UANotificationContent notificationWithNotificationInfo:@{ @"com.urbanairship.remote-data.update": @(YES) }];
+    [self.remoteDataManager receivedRemoteNotification:notification completionHandler:^(UIBackgroundFetchResult result) {
+        fetchResult = result;
+        completed = YES;
+    }];
+
+    [self.testDispatcher advanceTime:4.9];
+    XCTAssertFalse(completed);
+
+    [self.testDispatcher advanceTime:0.1];
+    XCTAssertTrue(completed);
+    XCTAssertEqual(UIBackgroundFetchResultNewData, fetchResult);
+}
+
 - (void)testSettingRefreshInterval {
     XCTAssertEqual(self.remoteDataManager.remoteDataRefreshInterval,0);
     self.remoteDataManager.remoteDataRefreshInterval = 9999;
@@ -970,7 +1208,7 @@
                                         remoteDataAPIClient:self.mockAPIClient
                                          notificationCenter:[[NSNotificationCenter alloc] init]
                                             appStateTracker:self.testAppStateTracker
-                                                 dispatcher:[UATestDispatcher testDispatcher]
+                                                 dispatcher:self.testDispatcher
                                                        date:self.testDate
                                               localeManager:self.mockLocaleManagerClass];
 }
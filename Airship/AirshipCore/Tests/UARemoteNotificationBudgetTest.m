@@ -0,0 +1,123 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UARemoteNotificationBudget+Internal.h"
+#import "UATestDispatcher.h"
+#import "UATestDate.h"
+
+@interface UARemoteNotificationBudgetTest : UABaseTest
+@property (nonatomic, strong) UATestDispatcher *testDispatcher;
+@property (nonatomic, strong) UATestDate *testDate;
+@property (nonatomic, strong) UARemoteNotificationBudget *budget;
+@end
+
+@implementation UARemoteNotificationBudgetTest
+
+- (void)setUp {
+    [super setUp];
+    self.testDispatcher = [UATestDispatcher testDispatcher];
+    self.testDate = [[UATestDate alloc] initWithAbsoluteTime:[NSDate date]];
+    self.budget = [UARemoteNotificationBudget budgetWithTimeLimit:20 dispatcher:self.testDispatcher date:self.testDate];
+}
+
+- (void)advanceTime:(NSTimeInterval)time {
+    self.testDate.absoluteTime = [self.testDate.absoluteTime dateByAddingTimeInterval:time];
+    [self.testDispatcher advanceTime:time];
+}
+
+/**
+ * Test the results are merged once every task finished.
+ */
+- (void)testRunMergesResults {
+    __block NSMutableArray<NSString *> *started = [NSMutableArray array];
+    [self.budget addTaskWithName:@"default" priority:UAPushableComponentPriorityDefault task:^(void (^completionHandler)(UIBackgroundFetchResult)) {
+        [started addObject:@"default"];
+        completionHandler(UIBackgroundFetchResultNoData);
+    }];
+    [self.budget addTaskWithName:@"high" priority:UAPushableComponentPriorityHigh task:^(void (^completionHandler)(UIBackgroundFetchResult)) {
+        [started addObject:@"high"];
+        completionHandler(UIBackgroundFetchResultNewData);
+    }];
+
+    __block UIBackgroundFetchResult result = UIBackgroundFetchResultFailed;
+    __block NSUInteger calls = 0;
+    [self.budget runWithCompletionHandler:^(UIBackgroundFetchResult fetchResult) {
+        result = fetchResult;
+        calls++;
+    }];
+
+    XCTAssertEqualObjects((@[@"high", @"default"]), started);
+    XCTAssertEqual(UIBackgroundFetchResultNewData, result);
+
+    // The deadline does not call the handler again
+    [self advanceTime:20];
+    XCTAssertEqual(1, calls);
+}
+
+/**
+ * Test the handler is called at the time limit with the results that are in.
+ */
+- (void)testTimeLimit {
+    __block void (^slowCompletionHandler)(UIBackgroundFetchResult);
+    [self.budget addTaskWithName:@"slow" priority:UAPushableComponentPriorityDefault task:^(void (^completionHandler)(UIBackgroundFetchResult)) {
+        slowCompletionHandler = completionHandler;
+    }];
+    [self.budget addTaskWithName:@"fast" priority:UAPushableComponentPriorityDefault task:^(void (^completionHandler)(UIBackgroundFetchResult)) {
+        completionHandler(UIBackgroundFetchResultNewData);
+    }];
+
+    __block NSUInteger calls = 0;
+    __block UIBackgroundFetchResult result = UIBackgroundFetchResultFailed;
+    [self.budget runWithCompletionHandler:^(UIBackgroundFetchResult fetchResult) {
+        result = fetchResult;
+        calls++;
+    }];
+
+    [self advanceTime:19];
+    XCTAssertEqual(0, calls);
+
+    [self advanceTime:1];
+    XCTAssertEqual(1, calls);
+    XCTAssertEqual(UIBackgroundFetchResultNewData, result);
+
+    // Late results are ignored
+    slowCompletionHandler(UIBackgroundFetchResultFailed);
+    XCTAssertEqual(1, calls);
+}
+
+/**
+ * Test low priority tasks are only waited on for half of the budget, and are skipped when
+ * the budget is already half spent.
+ */
+- (void)testLowPriority {
+    [self.budget addTaskWithName:@"low" priority:UAPushableComponentPriorityLow task:^(void (^completionHandler)(UIBackgroundFetchResult)) {}];
+
+    __block NSUInteger calls = 0;
+    [self.budget runWithCompletionHandler:^(UIBackgroundFetchResult fetchResult) {
+        XCTAssertEqual(UIBackgroundFetchResultNoData, fetchResult);
+        calls++;
+    }];
+
+    [self advanceTime:9];
+    XCTAssertEqual(0, calls);
+    [self advanceTime:1];
+    XCTAssertEqual(1, calls);
+
+    // Created earlier, so most of the budget is spent by the time it runs
+    UARemoteNotificationBudget *spentBudget = [UARemoteNotificationBudget budgetWithTimeLimit:20 dispatcher:self.testDispatcher date:self.testDate];
+    [self advanceTime:10];
+
+    __block BOOL lowStarted = NO;
+    [spentBudget addTaskWithName:@"low" priority:UAPushableComponentPriorityLow task:^(void (^completionHandler)(UIBackgroundFetchResult)) {
+        lowStarted = YES;
+    }];
+
+    [spentBudget runWithCompletionHandler:^(UIBackgroundFetchResult fetchResult) {
+        calls++;
+    }];
+
+    XCTAssertFalse(lowStarted);
+    XCTAssertEqual(2, calls);
+}
+
+@end
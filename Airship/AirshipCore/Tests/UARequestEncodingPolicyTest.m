@@ -0,0 +1,69 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UARequestEncodingPolicy+Internal.h"
+
+@interface UARequestEncodingPolicyTest : UABaseTest
+@property (nonatomic, strong) UARequestEncodingPolicy *policy;
+@end
+
+@implementation UARequestEncodingPolicyTest
+
+- (void)setUp {
+    [super setUp];
+    self.policy = [UARequestEncodingPolicy policy];
+}
+
+- (NSHTTPURLResponse *)responseWithAcceptEncoding:(nullable NSString *)acceptEncoding {
+    NSDictionary *headers = acceptEncoding ? @{@"Accept-Encoding": acceptEncoding} : @{};
+    return [[NSHTTPURLResponse alloc] initWithURL:[NSURL URLWithString:@"https://device-api.urbanairship.com"]
+                                       statusCode:200
+                                      HTTPVersion:nil
+                                     headerFields:headers];
+}
+
+- (NSString *)expectedBrotliEncoding {
+    if (@available(iOS 15.0, tvOS 15.0, *)) {
+        return UARequestEncodingBrotli;
+    }
+
+    return UARequestEncodingGzip;
+}
+
+/**
+ * Test hosts default to gzip.
+ */
+- (void)testDefault {
+    XCTAssertEqualObjects(UARequestEncodingGzip, [self.policy requestEncodingForHost:@"host"]);
+    XCTAssertEqualObjects(UARequestEncodingGzip, [self.policy requestEncodingForHost:nil]);
+}
+
+/**
+ * Test brotli is used once a host advertises it.
+ */
+- (void)testAdvertisedEncoding {
+    [self.policy updateWithResponse:[self responseWithAcceptEncoding:@"gzip;q=0.5, BR"] host:@"host"];
+    XCTAssertEqualObjects([self expectedBrotliEncoding], [self.policy requestEncodingForHost:@"host"]);
+    XCTAssertEqualObjects(UARequestEncodingGzip, [self.policy requestEncodingForHost:@"other"]);
+
+    // Responses without the header keep the cached encodings
+    [self.policy updateWithResponse:[self responseWithAcceptEncoding:nil] host:@"host"];
+    XCTAssertEqualObjects([self expectedBrotliEncoding], [self.policy requestEncodingForHost:@"host"]);
+
+    [self.policy updateWithResponse:[self responseWithAcceptEncoding:@"gzip, br; q=0"] host:@"host"];
+    XCTAssertEqualObjects(UARequestEncodingGzip, [self.policy requestEncodingForHost:@"host"]);
+}
+
+/**
+ * Test rejected encodings are not used until advertised again.
+ */
+- (void)testUnsupportedEncoding {
+    [self.policy updateWithResponse:[self responseWithAcceptEncoding:@"br, gzip"] host:@"host"];
+    [self.policy recordUnsupportedEncoding:UARequestEncodingBrotli forHost:@"host"];
+    XCTAssertEqualObjects(UARequestEncodingGzip, [self.policy requestEncodingForHost:@"host"]);
+
+    [self.policy updateWithResponse:[self responseWithAcceptEncoding:@"br"] host:@"host"];
+    XCTAssertEqualObjects([self expectedBrotliEncoding], [self.policy requestEncodingForHost:@"host"]);
+}
+
+@end
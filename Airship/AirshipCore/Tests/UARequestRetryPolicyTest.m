@@ -0,0 +1,77 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UARequestRetryPolicy+Internal.h"
+#import "UATestDate.h"
+
+@interface UARequestRetryPolicyTest : UABaseTest
+@property (nonatomic, strong) UATestDate *testDate;
+@property (nonatomic, strong) UARequestRetryPolicy *policy;
+@end
+
+@implementation UARequestRetryPolicyTest
+
+- (void)setUp {
+    [super setUp];
+
+    self.testDate = [[UATestDate alloc] initWithAbsoluteTime:[NSDate date]];
+    self.policy = [UARequestRetryPolicy policyWithInitialDelay:30
+                                                      maxDelay:100
+                                                   maxAttempts:3
+                                              failureThreshold:2
+                                           circuitOpenInterval:60
+                                                          date:self.testDate];
+}
+
+- (void)testRetryDelay {
+    for (NSUInteger i = 0; i < 100; i++) {
+        NSTimeInterval first = [self.policy retryDelayAfterAttempt:1];
+        XCTAssertGreaterThanOrEqual(first, 0);
+        XCTAssertLessThanOrEqual(first, 30);
+
+        NSTimeInterval second = [self.policy retryDelayAfterAttempt:2];
+        XCTAssertGreaterThanOrEqual(second, 0);
+        XCTAssertLessThanOrEqual(second, 60);
+
+        // Capped at the max delay
+        NSTimeInterval capped = [self.policy retryDelayAfterAttempt:50];
+        XCTAssertGreaterThanOrEqual(capped, 0);
+        XCTAssertLessThanOrEqual(capped, 100);
+    }
+}
+
+- (void)testMaxAttempts {
+    XCTAssertTrue([self.policy shouldRetryAfterAttempt:1]);
+    XCTAssertTrue([self.policy shouldRetryAfterAttempt:2]);
+    XCTAssertFalse([self.policy shouldRetryAfterAttempt:3]);
+}
+
+- (void)testCircuitBreaker {
+    NSURL *URL = [NSURL URLWithString:@"https://airship.com/api/events"];
+
+    [self.policy recordFailureForURL:URL];
+    XCTAssertFalse([self.policy isCircuitOpenForURL:URL]);
+
+    [self.policy recordFailureForURL:URL];
+    XCTAssertTrue([self.policy isCircuitOpenForURL:URL]);
+
+    // Other hosts and other endpoints on the same host are unaffected
+    XCTAssertFalse([self.policy isCircuitOpenForURL:[NSURL URLWithString:@"https://other.airship.com/api/events"]]);
+    XCTAssertFalse([self.policy isCircuitOpenForURL:[NSURL URLWithString:@"https://airship.com/api/channels"]]);
+
+    // Let a probe through once the open interval passes
+    self.testDate.timeOffset = 60;
+    XCTAssertFalse([self.policy isCircuitOpenForURL:URL]);
+
+    // A failed probe opens the circuit again
+    [self.policy recordFailureForURL:URL];
+    XCTAssertTrue([self.policy isCircuitOpenForURL:URL]);
+
+    // A success closes it
+    [self.policy recordSuccessForURL:URL];
+    XCTAssertFalse([self.policy isCircuitOpenForURL:URL]);
+    [self.policy recordFailureForURL:URL];
+    XCTAssertFalse([self.policy isCircuitOpenForURL:URL]);
+}
+
+@end
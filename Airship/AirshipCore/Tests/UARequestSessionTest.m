@@ -1,14 +1,16 @@
 /* Copyright Airship and Contributors */
 
 #import "UAAirshipBaseTest.h"
-#import "UARequestSession.h"
-#import "UAURLRequestOperation+Internal.h"
-#import "UADelayOperation+Internal.h"
+#import "UARequestSession+Internal.h"
+#import "UATaskQueue.h"
+#import "UADate.h"
 
 @interface UARequestSessionTest : UAAirshipBaseTest
 @property (nonatomic, strong) id mockNSURLSession;
 @property (nonatomic, strong) id mockQueue;
 @property (nonatomic, strong) UARequestSession *session;
+@property (nonatomic, strong) UARequestRetryPolicy *retryPolicy;
+@property (nonatomic, assign) NSTimeInterval retryDelay;
 @end
 
 @implementation UARequestSessionTest
@@ -16,22 +18,41 @@
 - (void)setUp {
     [super setUp];
 
-    self.mockQueue = [self mockForClass:[NSOperationQueue class]];
+    self.mockQueue = [self mockForClass:[UATaskQueue class]];
 
-    // Stub the queue to run UAURLRequestOperation immediately
+    // Stub the queue to run tasks immediately
     [[[self.mockQueue stub] andDo:^(NSInvocation *invocation) {
         void *arg;
         [invocation getArgument:&arg atIndex:2];
-        NSOperation *operation = (__bridge NSOperation *)arg;
-        [operation start];
-    }] addOperation:[OCMArg checkWithBlock:^BOOL(id obj) {
-        return [obj isKindOfClass:[UAURLRequestOperation class]];
-    }]];
+        UATask *task = (__bridge UATask *)arg;
+        [task start];
+    }] addTask:OCMOCK_ANY];
+
+    // Record the delay of retries and run them immediately too
+    self.retryDelay = -1;
+    [[[[self.mockQueue stub] andDo:^(NSInvocation *invocation) {
+        NSTimeInterval delay;
+        [invocation getArgument:&delay atIndex:3];
+        self.retryDelay = delay;
+
+        void *arg;
+        [invocation getArgument:&arg atIndex:2];
+        UATask *task = (__bridge UATask *)arg;
+        [task start];
+    }] ignoringNonObjectArgs] addTask:OCMOCK_ANY delay:0];
 
     self.mockNSURLSession = [self mockForClass:[NSURLSession class]];
+    self.retryPolicy = [UARequestRetryPolicy policyWithInitialDelay:30
+                                                           maxDelay:3000
+                                                        maxAttempts:2
+                                                   failureThreshold:2
+                                                circuitOpenInterval:60
+                                                               date:[[UADate alloc] init]];
+
     self.session = [UARequestSession sessionWithConfig:self.config
                                           NSURLSession:self.mockNSURLSession
-                                                 queue:self.mockQueue];
+                                                 queue:self.mockQueue
+                                           retryPolicy:self.retryPolicy];
 }
 
 - (void)testDataTask {
@@ -139,28 +160,158 @@
     // Verify the session was called
     [self.mockNSURLSession verify];
 
-    // Verify a delay was added for 30 seconds
-    [[self.mockQueue expect] addOperation:[OCMArg checkWithBlock:^BOOL(id obj) {
-        if (![obj isKindOfClass:[UADelayOperation class]]) {
-            return NO;
-        }
-
-        UADelayOperation *operation = (UADelayOperation *)obj;
-        return operation.seconds == 30;
-    }]];
-
     completionHandler(nil, nil, nil);
 
-    [self.mockQueue verify];
+    // Verify the retry was added with a jittered delay of up to 30 seconds
+    XCTAssertTrue(self.retryDelay >= 0 && self.retryDelay <= 30);
 
     // Call the captured completion handler with the return data
     XCTAssertTrue(retryBlockCalled);
 }
 
+- (void)testDataTaskRetryMaxAttempts {
+    UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.method = @"POST";
+        builder.URL = [NSURL URLWithString:@"https://airship.test/api"];
+    }];
+
+    // Capture the callback of the latest attempt
+    __block NSUInteger attempts = 0;
+    __block UARequestCompletionHandler completionHandler = nil;
+    [(NSURLSession *)[[self.mockNSURLSession stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:3];
+        completionHandler = (__bridge UARequestCompletionHandler)arg;
+        attempts++;
+    }] dataTaskWithRequest:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:500 HTTPVersion:nil headerFields:nil];
+
+    __block NSUInteger completionCount = 0;
+    [self.session dataTaskWithRequest:request
+                           retryWhere:^BOOL(NSData * _Nullable data, NSURLResponse * _Nullable retryResponse) {
+        return YES;
+    } completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable completionResponse, NSError * _Nullable error) {
+        XCTAssertEqual(response, completionResponse);
+        completionCount++;
+    }];
+
+    completionHandler(nil, response, nil);
+    XCTAssertEqual(2, attempts);
+    XCTAssertEqual(0, completionCount);
+
+    // Gives up after the last attempt with the last response
+    completionHandler(nil, response, nil);
+    XCTAssertEqual(2, attempts);
+    XCTAssertEqual(1, completionCount);
+}
+
+- (void)testCircuitOpen {
+    [self.retryPolicy recordFailureForURL:[NSURL URLWithString:@"https://airship.test/api"]];
+    [self.retryPolicy recordFailureForURL:[NSURL URLWithString:@"https://airship.test/api"]];
+
+    UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.method = @"POST";
+        builder.URL = [NSURL URLWithString:@"https://airship.test/api"];
+    }];
+
+    [[self.mockNSURLSession reject] dataTaskWithRequest:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    XCTestExpectation *completed = [self expectationWithDescription:@"completed"];
+    [self.session dataTaskWithRequest:request completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
+        XCTAssertNil(response);
+        XCTAssertEqualObjects(UARequestSessionErrorDomain, error.domain);
+        XCTAssertEqual(UARequestSessionErrorCodeCircuitOpen, error.code);
+        [completed fulfill];
+    }];
+
+    [self waitForTestExpectations];
+    [self.mockNSURLSession verify];
+}
+
+- (void)testErrorStatusDoesNotCloseCircuit {
+    NSURL *URL = [NSURL URLWithString:@"https://airship.test/api"];
+    UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.method = @"POST";
+        builder.URL = URL;
+    }];
+
+    __block UARequestCompletionHandler completionHandler = nil;
+    [(NSURLSession *)[[self.mockNSURLSession stub] andDo:^(NSInvocation *invocation) {
+        void *arg;
+        [invocation getArgument:&arg atIndex:3];
+        completionHandler = (__bridge UARequestCompletionHandler)arg;
+    }] dataTaskWithRequest:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    [self.retryPolicy recordFailureForURL:URL];
+
+    // A final 400 is not a success
+    [self.session dataTaskWithRequest:request retryWhere:^BOOL(NSData * _Nullable data, NSURLResponse * _Nullable response) {
+        return NO;
+    } completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {}];
+    completionHandler(nil, [[NSHTTPURLResponse alloc] initWithURL:URL statusCode:400 HTTPVersion:nil headerFields:nil], nil);
+
+    [self.retryPolicy recordFailureForURL:URL];
+    XCTAssertTrue([self.retryPolicy isCircuitOpenForURL:URL]);
+}
+
 - (void)testCancel {
-    [[self.mockQueue expect] cancelAllOperations];
+    [[self.mockQueue expect] cancelAllTasks];
     [self.session cancelAllRequests];
 
     [self.mockQueue verify];
 }
+
+- (void)testSharedURLSession {
+    NSURLSession *shared = [UARequestSession sharedURLSession];
+    XCTAssertEqual(shared, [UARequestSession sharedURLSession]);
+    XCTAssertNil(shared.configuration.URLCache);
+    XCTAssertEqual(shared.configuration.HTTPMaximumConnectionsPerHost, 2);
+    XCTAssertTrue(shared.configuration.HTTPShouldUsePipelining);
+}
+
+- (void)testDataTaskPriority {
+    UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+        builder.method = @"POST";
+        builder.URL = [NSURL URLWithString:@"www.urbanairship.com"];
+        builder.priority = NSURLSessionTaskPriorityLow;
+    }];
+
+    id mockTask = [self mockForClass:[NSURLSessionDataTask class]];
+    [[mockTask expect] setPriority:NSURLSessionTaskPriorityLow];
+    [[[self.mockNSURLSession stub] andReturn:mockTask] dataTaskWithRequest:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+    [self.session dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {}];
+
+    [mockTask verify];
+}
+
+- (void)testDataTaskTrafficClass {
+    if (@available(iOS 13.0, tvOS 13.0, *)) {
+        __block NSURLRequest *urlRequest;
+        [[[self.mockNSURLSession stub] andDo:^(NSInvocation *invocation) {
+            void *arg;
+            [invocation getArgument:&arg atIndex:2];
+            urlRequest = (__bridge NSURLRequest *)arg;
+        }] dataTaskWithRequest:OCMOCK_ANY completionHandler:OCMOCK_ANY];
+
+        NSArray *expected = @[@[@(UARequestTrafficClassCritical), @YES, @YES],
+                              @[@(UARequestTrafficClassDeferrable), @NO, @YES],
+                              @[@(UARequestTrafficClassPrefetch), @NO, @NO]];
+
+        for (NSArray *values in expected) {
+            UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder *builder) {
+                builder.method = @"GET";
+                builder.URL = [NSURL URLWithString:@"www.urbanairship.com"];
+                builder.trafficClass = [values[0] unsignedIntegerValue];
+            }];
+
+            [self.session dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {}];
+
+            XCTAssertEqual([values[1] boolValue], urlRequest.allowsConstrainedNetworkAccess);
+            XCTAssertEqual([values[2] boolValue], urlRequest.allowsExpensiveNetworkAccess);
+        }
+    }
+}
+
 @end
@@ -3,10 +3,12 @@
 #import "UABaseTest.h"
 #import "UARetriablePipeline+Internal.h"
 #import "UATestDispatcher.h"
+#import "UATestDate.h"
 
 @interface UARetriablePipelineTest : UABaseTest
 @property (nonatomic, strong) UARetriablePipeline *pipeline;
 @property (nonatomic, strong) UATestDispatcher *testDispatcher;
+@property (nonatomic, strong) UATestDate *testDate;
 @property (nonatomic, strong) NSOperationQueue *queue;
 @end
 
@@ -19,7 +21,8 @@
     self.queue.maxConcurrentOperationCount = 1;
 
     self.testDispatcher = [UATestDispatcher testDispatcher];
-    self.pipeline = [UARetriablePipeline pipelineWithQueue:self.queue dispatcher:self.testDispatcher];
+    self.testDate = [[UATestDate alloc] initWithAbsoluteTime:[NSDate date]];
+    self.pipeline = [UARetriablePipeline pipelineWithQueue:self.queue dispatcher:self.testDispatcher date:self.testDate];
 }
 
 - (void)tearDown {
@@ -87,6 +90,60 @@
     }
 }
 
+- (void)testRetriesShareTimer {
+    __block NSUInteger runCount = 0;
+    UARetriable *retriable = [UARetriable retriableWithRunBlock:^(UARetriableCompletionHandler completionHandler) {
+        runCount++;
+        completionHandler(UARetriableResultRetry);
+    }];
+
+    [self.pipeline addRetriable:retriable];
+    [self.pipeline addRetriable:retriable];
+    [self.queue waitUntilAllOperationsAreFinished];
+
+    XCTAssertEqual(2, runCount);
+    XCTAssertEqual(1, self.testDispatcher.scheduledBlocks.count);
+
+    // Both retries are jittered within the min backoff
+    self.testDate.timeOffset = 30;
+    [self.testDispatcher advanceTime:30];
+    [self.queue waitUntilAllOperationsAreFinished];
+
+    XCTAssertEqual(4, runCount);
+    XCTAssertEqual(1, self.testDispatcher.scheduledBlocks.count);
+}
+
+- (void)testServerErrorHoldsBackPipeline {
+    __block NSUInteger firstRunCount = 0;
+    UARetriable *first = [UARetriable retriableWithRunBlock:^(UARetriableCompletionHandler completionHandler) {
+        firstRunCount++;
+        completionHandler(firstRunCount == 1 ? UARetriableResultServerError : UARetriableResultSuccess);
+    }];
+
+    __block NSUInteger secondRunCount = 0;
+    UARetriable *second = [UARetriable retriableWithRunBlock:^(UARetriableCompletionHandler completionHandler) {
+        secondRunCount++;
+        completionHandler(UARetriableResultSuccess);
+    }];
+
+    [self.pipeline addRetriable:first];
+    [self.queue waitUntilAllOperationsAreFinished];
+
+    [self.pipeline addRetriable:second];
+    [self.queue waitUntilAllOperationsAreFinished];
+
+    XCTAssertEqual(1, firstRunCount);
+    XCTAssertEqual(0, secondRunCount);
+
+    // The retry probes the server, and its success releases the held back chain
+    self.testDate.timeOffset = 30;
+    [self.testDispatcher advanceTime:30];
+    [self.queue waitUntilAllOperationsAreFinished];
+
+    XCTAssertEqual(2, firstRunCount);
+    XCTAssertEqual(1, secondRunCount);
+}
+
 - (void)testCancel {
     XCTestExpectation *firstExecuted = [self expectationWithDescription:@"first executed"];
     UARetriable *first = [UARetriable retriableWithRunBlock:^(UARetriableCompletionHandler completionHandler) {
@@ -108,4 +165,53 @@
     [self.queue waitUntilAllOperationsAreFinished];
 }
 
+- (void)testConcurrentChains {
+    self.queue.maxConcurrentOperationCount = 2;
+
+    dispatch_semaphore_t secondStarted = dispatch_semaphore_create(0);
+    __block BOOL firstObservedSecond = NO;
+
+    XCTestExpectation *firstExecuted = [self expectationWithDescription:@"first executed"];
+    UARetriable *first = [UARetriable retriableWithRunBlock:^(UARetriableCompletionHandler completionHandler) {
+        // Only returns in time if the second chain runs alongside this one
+        firstObservedSecond = dispatch_semaphore_wait(secondStarted, dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC)) == 0;
+        completionHandler(UARetriableResultSuccess);
+        [firstExecuted fulfill];
+    }];
+
+    XCTestExpectation *secondExecuted = [self expectationWithDescription:@"second executed"];
+    UARetriable *second = [UARetriable retriableWithRunBlock:^(UARetriableCompletionHandler completionHandler) {
+        dispatch_semaphore_signal(secondStarted);
+        completionHandler(UARetriableResultSuccess);
+        [secondExecuted fulfill];
+    }];
+
+    [self.pipeline addRetriable:first];
+    [self.pipeline addRetriable:second];
+
+    [self waitForTestExpectations];
+    XCTAssertTrue(firstObservedSecond);
+}
+
+- (void)testStalledRetriableReleasesItsSlot {
+    XCTestExpectation *firstStarted = [self expectationWithDescription:@"first started"];
+    UARetriable *first = [UARetriable retriableWithRunBlock:^(UARetriableCompletionHandler completionHandler) {
+        // Never completes
+        [firstStarted fulfill];
+    }];
+
+    XCTestExpectation *secondExecuted = [self expectationWithDescription:@"second executed"];
+    UARetriable *second = [UARetriable retriableWithRunBlock:^(UARetriableCompletionHandler completionHandler) {
+        completionHandler(UARetriableResultSuccess);
+        [secondExecuted fulfill];
+    }];
+
+    [self.pipeline addRetriable:first];
+    [self.pipeline addRetriable:second];
+    [self waitForTestExpectations:@[firstStarted]];
+
+    [self.testDispatcher advanceTime:30];
+    [self waitForTestExpectations:@[secondExecuted]];
+}
+
 @end
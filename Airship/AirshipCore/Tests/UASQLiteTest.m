@@ -0,0 +1,63 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UASQLite+Internal.h"
+
+@interface UASQLiteTest : UABaseTest
+@property (nonatomic, copy) NSString *path;
+@property (nonatomic, strong) UASQLite *db;
+@end
+
+@implementation UASQLiteTest
+
+- (void)setUp {
+    [super setUp];
+    self.path = [NSTemporaryDirectory() stringByAppendingPathComponent:[NSUUID UUID].UUIDString];
+    self.db = [[UASQLite alloc] initWithDBPath:self.path];
+    XCTAssertTrue([self.db executeUpdate:@"CREATE TABLE items (id INTEGER PRIMARY KEY, name TEXT)"]);
+}
+
+- (void)tearDown {
+    [self.db close];
+    for (NSString *suffix in @[@"", @"-wal", @"-shm"]) {
+        [[NSFileManager defaultManager] removeItemAtPath:[self.path stringByAppendingString:suffix] error:nil];
+    }
+    [super tearDown];
+}
+
+- (void)testRepeatedStatements {
+    for (NSUInteger i = 0; i < 3; i++) {
+        XCTAssertTrue([self.db executeUpdate:@"INSERT INTO items (name) VALUES (?)", [NSString stringWithFormat:@"item %lu", (unsigned long)i]]);
+        NSArray *rows = [self.db executeQuery:@"SELECT name FROM items ORDER BY id"];
+        XCTAssertEqual(i + 1, rows.count);
+        XCTAssertEqualObjects(([NSString stringWithFormat:@"item %lu", (unsigned long)i]), rows.lastObject[@"name"]);
+    }
+}
+
+- (void)testArgumentsBatch {
+    [self.db beginTransaction];
+    XCTAssertTrue([self.db executeUpdate:@"INSERT INTO items (name) VALUES (?)" argumentsBatch:@[@[@"foo"], @[@"bar"], @[[NSNull null]]]]);
+    [self.db commit];
+
+    NSArray *rows = [self.db executeQuery:@"SELECT name FROM items ORDER BY id"];
+    NSArray *expected = @[@{@"name": @"foo"}, @{@"name": @"bar"}, @{@"name": [NSNull null]}];
+    XCTAssertEqualObjects(expected, rows);
+
+    XCTAssertFalse([self.db executeUpdate:@"INSERT INTO items (id, name) VALUES (?, ?)" argumentsBatch:@[@[@"baz"]]]);
+}
+
+- (void)testWriteAheadLogging {
+    XCTAssertTrue([self.db enableWriteAheadLogging]);
+    XCTAssertTrue([self.db setSynchronousMode:UASQLiteSynchronousModeNormal]);
+    XCTAssertEqualObjects(@(UASQLiteSynchronousModeNormal), [self.db executeQuery:@"PRAGMA synchronous"].firstObject[@"synchronous"]);
+}
+
+- (void)testCloseWithCachedStatements {
+    [self.db executeQuery:@"SELECT name FROM items"];
+    [self.db close];
+
+    XCTAssertTrue([self.db open:self.path]);
+    XCTAssertTrue([self.db tableExists:@"items"]);
+}
+
+@end
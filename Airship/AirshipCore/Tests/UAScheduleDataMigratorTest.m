@@ -8,6 +8,7 @@
 #import "UAScheduleDataMigrator+Internal.h"
 #import "UAScheduleData+Internal.h"
 #import "UAAutomationStore+Internal.h"
+#import "UAScheduleTriggerData+Internal.h"
 
 @interface UAScheduleDataMigratorTest : UABaseTest
 @property (nonatomic, strong) NSManagedObjectContext *managedContext;
@@ -265,4 +266,71 @@
     XCTAssertEqualObjects(@"foo#1", fooTwo.identifier);
 }
 
+/**
+ * Keeps app-defined IDs unique across migration batches
+ */
+- (void)testMigrationFromVersion2IDSourceAppDefinedBatches {
+    id message =  @{
+        @"display_type":@"banner",
+        @"display":@{},
+        @"source": @"app-defined",
+    };
+
+    UAScheduleData *foo = [NSEntityDescription insertNewObjectForEntityForName:@"UAScheduleData"
+                                                        inManagedObjectContext:self.managedContext];
+    foo.data = [NSJSONSerialization stringWithObject:message];
+    foo.dataVersion = @(2);
+    foo.identifier = @"some ID";
+    foo.group = @"foo";
+
+    UAScheduleData *fooTwo = [NSEntityDescription insertNewObjectForEntityForName:@"UAScheduleData"
+                                                           inManagedObjectContext:self.managedContext];
+    fooTwo.data = [NSJSONSerialization stringWithObject:message];
+    fooTwo.dataVersion = @(2);
+    fooTwo.identifier = @"some other ID";
+    fooTwo.group = @"foo";
+
+    NSMutableArray *migratedScheduleIDs = [NSMutableArray array];
+    [UAScheduleDataMigrator migrateSchedules:@[foo] migratedScheduleIDs:migratedScheduleIDs];
+    [UAScheduleDataMigrator migrateSchedules:@[fooTwo] migratedScheduleIDs:migratedScheduleIDs];
+
+    XCTAssertEqualObjects(@"foo", foo.identifier);
+    XCTAssertEqualObjects(@"foo#1", fooTwo.identifier);
+    XCTAssertEqualObjects((@[@"foo", @"foo#1"]), migratedScheduleIDs);
+}
+
+/**
+ * Converts JSON schedule data and trigger predicates to binary property lists
+ */
+- (void)testMigrationToBinaryEncoding {
+    id data = @{ @"display_type": @"banner", @"display": @{ @"duration": @(30) } };
+    id predicate = @{ @"value": @{ @"equals": @"purchase" } };
+    id dataWithNull = @{ @"display": [NSNull null] };
+
+    UAScheduleData *scheduleData = [NSEntityDescription insertNewObjectForEntityForName:@"UAScheduleData"
+                                                                 inManagedObjectContext:self.managedContext];
+    scheduleData.data = [NSJSONSerialization stringWithObject:data];
+
+    UAScheduleTriggerData *triggerData = [NSEntityDescription insertNewObjectForEntityForName:@"UAScheduleTriggerData"
+                                                                       inManagedObjectContext:self.managedContext];
+    triggerData.predicateData = [NSJSONSerialization dataWithJSONObject:predicate options:0 error:nil];
+    triggerData.schedule = scheduleData;
+
+    UAScheduleData *nullScheduleData = [NSEntityDescription insertNewObjectForEntityForName:@"UAScheduleData"
+                                                                     inManagedObjectContext:self.managedContext];
+    nullScheduleData.data = [NSJSONSerialization stringWithObject:dataWithNull];
+
+    [UAScheduleDataMigrator migrateSchedulesToBinaryEncoding:@[scheduleData, nullScheduleData]];
+
+    XCTAssertNil(scheduleData.data);
+    XCTAssertNotNil(scheduleData.binaryData);
+    XCTAssertEqualObjects(data, scheduleData.dataJSON);
+    XCTAssertEqualObjects(predicate, [UAScheduleData JSONWithStoredData:triggerData.predicateData]);
+    XCTAssertNotEqualObjects([NSJSONSerialization dataWithJSONObject:predicate options:0 error:nil], triggerData.predicateData);
+
+    // Nulls can't be stored in a property list, so the data stays JSON
+    XCTAssertNil(nullScheduleData.binaryData);
+    XCTAssertEqualObjects(dataWithNull, nullScheduleData.dataJSON);
+}
+
 @end
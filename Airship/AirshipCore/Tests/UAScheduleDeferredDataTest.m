@@ -30,6 +30,19 @@
     XCTAssertNil(error);
     XCTAssertEqualObjects([NSURL URLWithString:@"https://neat.com"], deferred.URL);
     XCTAssertTrue(deferred.retriableOnTimeout);
+    XCTAssertFalse(deferred.isSpeculative);
+}
+
+- (void)testSpeculative {
+    id JSON = @{ @"url": @"https://neat.com", @"retry_on_timeout": @(YES), @"speculative": @(YES) };
+
+    NSError *error;
+
+    UAScheduleDeferredData *deferred = [UAScheduleDeferredData deferredDataWithJSON:JSON error:&error];
+    XCTAssertNil(error);
+    XCTAssertTrue(deferred.isSpeculative);
+    XCTAssertEqualObjects(JSON, [deferred toJSON]);
+    XCTAssertNotEqualObjects(deferred, [UAScheduleDeferredData deferredDataWithURL:deferred.URL retriableOnTimeout:YES]);
 }
 
 - (void)testFromJSONMissingURL {
@@ -0,0 +1,56 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAScheduleRunQueue+Internal.h"
+#import "UAActionSchedule.h"
+
+@interface UAScheduleRunQueueTest : UABaseTest
+@property (nonatomic, strong) UAScheduleRunQueue *runQueue;
+@end
+
+@implementation UAScheduleRunQueueTest
+
+- (void)setUp {
+    [super setUp];
+    self.runQueue = [UAScheduleRunQueue runQueue];
+}
+
+- (void)testPopsByPriorityThenOrder {
+    NSArray *priorities = @[@(5), @(1), @(3), @(1), @(-2), @(3)];
+    NSMutableArray *schedules = [NSMutableArray array];
+    for (NSNumber *priority in priorities) {
+        UASchedule *schedule = [self scheduleWithPriority:priority.integerValue];
+        [schedules addObject:schedule];
+        XCTAssertTrue([self.runQueue addSchedule:schedule triggerContext:nil]);
+    }
+
+    NSMutableArray *popped = [NSMutableArray array];
+    UAScheduleRunQueueEntry *entry;
+    while ((entry = [self.runQueue popEntry])) {
+        [popped addObject:entry.schedule];
+    }
+
+    NSArray *expected = @[schedules[4], schedules[1], schedules[3], schedules[2], schedules[5], schedules[0]];
+    XCTAssertEqualObjects(expected, popped);
+    XCTAssertEqual(0, self.runQueue.count);
+}
+
+- (void)testScheduleQueuedOnce {
+    UASchedule *schedule = [self scheduleWithPriority:0];
+    XCTAssertTrue([self.runQueue addSchedule:schedule triggerContext:nil]);
+    XCTAssertFalse([self.runQueue addSchedule:schedule triggerContext:nil]);
+    XCTAssertEqual(1, self.runQueue.count);
+
+    // Can be queued again once popped
+    XCTAssertEqual(schedule, [self.runQueue popEntry].schedule);
+    XCTAssertTrue([self.runQueue addSchedule:schedule triggerContext:nil]);
+}
+
+- (UASchedule *)scheduleWithPriority:(NSInteger)priority {
+    return [UAActionSchedule scheduleWithActions:@{@"cool": @"story"} builderBlock:^(UAScheduleBuilder *builder) {
+        builder.priority = priority;
+        builder.triggers = @[[UAScheduleTrigger foregroundTriggerWithCount:1]];
+    }];
+}
+
+@end
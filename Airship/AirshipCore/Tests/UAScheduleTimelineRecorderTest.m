@@ -0,0 +1,79 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAScheduleTimeline+Internal.h"
+
+@interface UAScheduleTimelineRecorderTest : UABaseTest
+@property (nonatomic, strong) UAScheduleTimelineRecorder *recorder;
+@property (nonatomic, strong) id mockDelegate;
+@end
+
+@implementation UAScheduleTimelineRecorderTest
+
+- (void)setUp {
+    [super setUp];
+    self.recorder = [UAScheduleTimelineRecorder shared];
+    [self.recorder reset];
+
+    self.mockDelegate = [self mockForProtocol:@protocol(UAScheduleTimelineDelegate)];
+    self.recorder.delegate = self.mockDelegate;
+}
+
+- (void)tearDown {
+    self.recorder.delegate = nil;
+    [self.recorder reset];
+    [super tearDown];
+}
+
+- (void)testTimeline {
+    [self.recorder beginTimelineWithScheduleID:@"foo"];
+    [self.recorder recordStage:UAScheduleTimelineStageTrigger scheduleID:@"foo" duration:0.5 result:nil];
+
+    [self.recorder beginStage:UAScheduleTimelineStageAssets scheduleID:@"foo"];
+    [NSThread sleepForTimeInterval:0.01];
+    [self.recorder endStage:UAScheduleTimelineStageAssets scheduleID:@"foo" result:@"success"];
+
+    // Stages that never began are ignored
+    [self.recorder endStage:UAScheduleTimelineStageDisplay scheduleID:@"foo" result:nil];
+
+    UAScheduleTimeline *inProgress = [self.recorder timelineForScheduleID:@"foo"];
+    XCTAssertNil(inProgress.outcome);
+    XCTAssertEqual(2, inProgress.stages.count);
+
+    XCTestExpectation *finished = [self expectationWithDescription:@"timeline finished"];
+    [[[self.mockDelegate expect] andDo:^(NSInvocation *invocation) {
+        [finished fulfill];
+    }] scheduleTimelineFinished:[OCMArg checkWithBlock:^BOOL(UAScheduleTimeline *timeline) {
+        return [timeline.scheduleID isEqualToString:@"foo"] && [timeline.outcome isEqualToString:UAScheduleTimelineOutcomeDisplayed];
+    }]];
+
+    [self.recorder finishTimelineWithScheduleID:@"foo" outcome:UAScheduleTimelineOutcomeDisplayed];
+    [self waitForTestExpectations];
+    [self.mockDelegate verify];
+
+    UAScheduleTimeline *timeline = [self.recorder timelineForScheduleID:@"foo"];
+    XCTAssertEqualObjects(UAScheduleTimelineOutcomeDisplayed, timeline.outcome);
+    XCTAssertEqualObjects(UAScheduleTimelineStageTrigger, timeline.stages[0].name);
+    XCTAssertEqual(0.5, timeline.stages[0].duration);
+    XCTAssertEqualObjects(UAScheduleTimelineStageAssets, timeline.stages[1].name);
+    XCTAssertEqualObjects(@"success", timeline.stages[1].result);
+    XCTAssertGreaterThanOrEqual(timeline.stages[1].duration, 0.01);
+    XCTAssertEqualObjects(@[timeline], self.recorder.recentTimelines);
+
+    // Finishing again is ignored
+    [self.recorder finishTimelineWithScheduleID:@"foo" outcome:UAScheduleTimelineOutcomeSkipped];
+    XCTAssertEqual(1, self.recorder.recentTimelines.count);
+}
+
+- (void)testStageMetrics {
+    [self.recorder recordStage:UAScheduleTimelineStageTrigger scheduleID:@"foo" duration:1 result:nil];
+    [self.recorder recordStage:UAScheduleTimelineStageTrigger scheduleID:@"bar" duration:3 result:nil];
+
+    UAScheduleStageMetrics *metrics = self.recorder.stageMetrics[UAScheduleTimelineStageTrigger];
+    XCTAssertEqual(2, metrics.count);
+    XCTAssertEqual(4, metrics.totalDuration);
+    XCTAssertEqual(3, metrics.maxDuration);
+    XCTAssertEqual(2, metrics.averageDuration);
+}
+
+@end
@@ -0,0 +1,92 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAScheduleTimerQueue+Internal.h"
+#import "UATimerScheduler+Internal.h"
+#import "UATestDate.h"
+
+@interface UAScheduleTimerQueueTest : UABaseTest
+@property (nonatomic, strong) UAScheduleTimerQueue *timerQueue;
+@property (nonatomic, strong) UATestDate *testDate;
+@property (nonatomic, strong) NSMutableArray<NSTimer *> *timers;
+@end
+
+@implementation UAScheduleTimerQueueTest
+
+- (void)setUp {
+    [super setUp];
+    self.testDate = [[UATestDate alloc] initWithAbsoluteTime:[NSDate date]];
+    self.timers = [NSMutableArray array];
+
+    UATimerScheduler *timerScheduler = [UATimerScheduler timerSchedulerWithSchedulerBlock:^(NSTimer *timer) {
+        [self.timers addObject:timer];
+    }];
+
+    self.timerQueue = [UAScheduleTimerQueue timerQueueWithTimerScheduler:timerScheduler date:self.testDate];
+}
+
+- (void)tearDown {
+    [self.timerQueue cancelAllTimers];
+    [super tearDown];
+}
+
+- (void)testSingleTimerForEarliestDeadline {
+    NSMutableArray *fired = [NSMutableArray array];
+    void (^block)(NSString *) = ^(NSString *identifier) {
+        [fired addObject:identifier];
+    };
+
+    [self.timerQueue addTimerWithIdentifier:@"later" timeInterval:100 block:block];
+    [self.timerQueue addTimerWithIdentifier:@"sooner" timeInterval:10 block:block];
+    XCTAssertEqual(2, self.timerQueue.count);
+    XCTAssertTrue(self.timers.lastObject.isValid);
+    XCTAssertEqualWithAccuracy(10, [self.timers.lastObject.fireDate timeIntervalSinceNow], 1);
+
+    self.testDate.timeOffset = 10;
+    [self.timers.lastObject fire];
+    XCTAssertEqualObjects(@[@"sooner"], fired);
+    XCTAssertEqual(1, self.timerQueue.count);
+    XCTAssertEqualWithAccuracy(90, [self.timers.lastObject.fireDate timeIntervalSinceNow], 1);
+
+    [self.timers.lastObject fire];
+    XCTAssertEqualObjects((@[@"sooner", @"later"]), fired);
+    XCTAssertEqual(0, self.timerQueue.count);
+}
+
+- (void)testCancel {
+    __block BOOL fired = NO;
+    [self.timerQueue addTimerWithIdentifier:@"sooner" timeInterval:10 block:^(NSString *identifier) {
+        fired = YES;
+    }];
+    [self.timerQueue addTimerWithIdentifier:@"later" timeInterval:100 block:^(NSString *identifier) {}];
+
+    NSTimer *soonerTimer = self.timers.lastObject;
+    [self.timerQueue cancelTimersWithIdentifiers:[NSSet setWithObject:@"sooner"]];
+
+    XCTAssertFalse(soonerTimer.isValid);
+    XCTAssertEqual(1, self.timerQueue.count);
+    XCTAssertEqualWithAccuracy(100, [self.timers.lastObject.fireDate timeIntervalSinceNow], 1);
+
+    [self.timerQueue cancelAllTimers];
+    XCTAssertFalse(self.timers.lastObject.isValid);
+    XCTAssertEqual(0, self.timerQueue.count);
+    XCTAssertFalse(fired);
+}
+
+- (void)testReplaceTimer {
+    __block NSUInteger fireCount = 0;
+    [self.timerQueue addTimerWithIdentifier:@"schedule" timeInterval:10 block:^(NSString *identifier) {
+        fireCount++;
+    }];
+    [self.timerQueue addTimerWithIdentifier:@"schedule" timeInterval:50 block:^(NSString *identifier) {
+        fireCount++;
+    }];
+
+    XCTAssertEqual(1, self.timerQueue.count);
+    XCTAssertEqualWithAccuracy(50, [self.timers.lastObject.fireDate timeIntervalSinceNow], 1);
+
+    [self.timers.lastObject fire];
+    XCTAssertEqual(1, fireCount);
+}
+
+@end
@@ -1,8 +1,10 @@
 /* Copyright Airship and Contributors */
 
 #import "UAScheduleTriggerContext+Internal.h"
+#import "UAScheduleTriggerContextTransformer+Internal.h"
 #import "UABaseTest.h"
 #import "UAScheduleTrigger.h"
+#import "UAJSONPredicate.h"
 
 @interface UAScheduleTriggerContextTest : UABaseTest
 
@@ -50,6 +52,42 @@
     [self verifyCodingForContext:context];
 }
 
+- (void)testCompactData {
+    UAScheduleTrigger *trigger = [UAScheduleTrigger screenTriggerForScreenName:@"some-screen" count:100];
+    UAScheduleTriggerContext *context = [UAScheduleTriggerContext triggerContextWithTrigger:trigger event:@{@"neat": @"story"}];
+
+    UAScheduleTriggerContextTransformer *transformer = [UAScheduleTriggerContextTransformer transformerWithMaxEventSize:100];
+    UAScheduleTriggerContext *decoded = [transformer reverseTransformedValue:[transformer transformedValue:context]];
+
+    XCTAssertEqual(UAScheduleTriggerScreen, decoded.trigger.type);
+    XCTAssertEqualObjects(@(100), decoded.trigger.goal);
+    XCTAssertEqualObjects(context.event, decoded.event);
+}
+
+- (void)testCompactDataEventSizeLimit {
+    UAJSONPredicate *predicate = [UAJSONPredicate predicateWithJSON:@{ @"key": @"event_name", @"value": @{ @"equals": @"purchase" } } error:nil];
+    UAScheduleTrigger *trigger = [UAScheduleTrigger customEventTriggerWithPredicate:predicate count:1];
+    NSString *value = [@"" stringByPaddingToLength:200 withString:@"a" startingAtIndex:0];
+    id event = @{ @"event_name": @"purchase", @"properties": @{ @"value": value } };
+    UAScheduleTriggerContext *context = [UAScheduleTriggerContext triggerContextWithTrigger:trigger event:event];
+
+    UAScheduleTriggerContext *decoded = [UAScheduleTriggerContext triggerContextWithCompactData:[context compactDataWithMaxEventSize:100]];
+    XCTAssertEqualObjects(@{ @"event_name": @"purchase" }, decoded.event);
+
+    decoded = [UAScheduleTriggerContext triggerContextWithCompactData:[context compactDataWithMaxEventSize:10]];
+    XCTAssertNil(decoded.event);
+    XCTAssertEqual(UAScheduleTriggerCustomEventCount, decoded.trigger.type);
+}
+
+- (void)testTransformerReadsKeyedArchive {
+    UAScheduleTrigger *trigger = [UAScheduleTrigger screenTriggerForScreenName:@"some-screen" count:100];
+    UAScheduleTriggerContext *context = [UAScheduleTriggerContext triggerContextWithTrigger:trigger event:@"string"];
+    id archive = [NSKeyedArchiver archivedDataWithRootObject:context requiringSecureCoding:YES error:nil];
+
+    UAScheduleTriggerContextTransformer *transformer = [[UAScheduleTriggerContextTransformer alloc] init];
+    XCTAssertEqualObjects(context, [transformer reverseTransformedValue:archive]);
+}
+
 - (void)verifyCodingForContext:(UAScheduleTriggerContext *)context {
     NSError *error = nil;
     id encoded = [NSKeyedArchiver archivedDataWithRootObject:context
@@ -0,0 +1,108 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAScheduleTriggerIndex+Internal.h"
+#import "UAJSONPredicate.h"
+
+@interface UAScheduleTriggerIndexTest : UABaseTest
+@property (nonatomic, strong) UAScheduleTriggerIndex *index;
+@end
+
+@implementation UAScheduleTriggerIndexTest
+
+- (void)setUp {
+    [super setUp];
+    self.index = [UAScheduleTriggerIndex triggerIndex];
+}
+
+- (void)testCandidatesBeforeLoad {
+    XCTAssertTrue([self.index hasCandidatesForType:UAScheduleTriggerScreen argument:@"screen"]);
+}
+
+- (void)testTriggerType {
+    [self.index addTriggerWithType:UAScheduleTriggerScreen predicate:nil];
+    [self.index finishRebuild:[self.index beginRebuild] withIndex:[UAScheduleTriggerIndex triggerIndex]];
+
+    XCTAssertTrue([self.index hasCandidatesForType:UAScheduleTriggerScreen argument:@"screen"]);
+    XCTAssertFalse([self.index hasCandidatesForType:UAScheduleTriggerRegionEnter argument:@"region"]);
+}
+
+- (void)testCustomEventName {
+    [self.index finishRebuild:[self.index beginRebuild] withIndex:[UAScheduleTriggerIndex triggerIndex]];
+
+    NSDictionary *predicateJSON = @{ @"and": @[ @{ @"key": @"event_name", @"value": @{ @"equals": @"Purchase" } },
+                                                @{ @"key": @"event_value", @"value": @{ @"at_least": @(10) } } ]};
+    UAJSONPredicate *predicate = [UAJSONPredicate predicateWithJSON:predicateJSON error:nil];
+    [self.index addTriggerWithType:UAScheduleTriggerCustomEventCount predicate:predicate];
+
+    XCTAssertTrue([self.index hasCandidatesForType:UAScheduleTriggerCustomEventCount argument:@{ @"event_name": @"purchase" }]);
+    XCTAssertFalse([self.index hasCandidatesForType:UAScheduleTriggerCustomEventCount argument:@{ @"event_name": @"other" }]);
+    XCTAssertFalse([self.index hasCandidatesForType:UAScheduleTriggerCustomEventValue argument:@{ @"event_name": @"purchase" }]);
+}
+
+- (void)testPredicateEventNames {
+    NSDictionary *predicateJSON = @{ @"or": @[ @{ @"key": @"event_name", @"value": @{ @"equals": @"Purchase" } },
+                                               @{ @"key": @"event_name", @"value": @{ @"equals": @"refund" } } ]};
+    UAJSONPredicate *predicate = [UAJSONPredicate predicateWithJSON:predicateJSON error:nil];
+
+    NSSet *expected = [NSSet setWithArray:@[@"purchase", @"refund"]];
+    XCTAssertEqualObjects(expected, [UAScheduleTriggerIndex matchKeysForType:UAScheduleTriggerCustomEventCount predicate:predicate]);
+
+    XCTAssertEqualObjects(@"purchase", [UAScheduleTriggerIndex matchKeyForType:UAScheduleTriggerCustomEventValue argument:@{ @"event_name": @"Purchase" }]);
+    XCTAssertNil([UAScheduleTriggerIndex matchKeyForType:UAScheduleTriggerScreen argument:@{ @"event_name": @"Purchase" }]);
+}
+
+- (void)testScreenAndRegion {
+    [self.index finishRebuild:[self.index beginRebuild] withIndex:[UAScheduleTriggerIndex triggerIndex]];
+
+    [self.index addTriggerWithType:UAScheduleTriggerScreen predicate:[UAScheduleTrigger screenTriggerForScreenName:@"Home" count:1].predicate];
+    [self.index addTriggerWithType:UAScheduleTriggerRegionEnter predicate:[UAScheduleTrigger regionEnterTriggerForRegionID:@"office" count:1].predicate];
+
+    XCTAssertTrue([self.index hasCandidatesForType:UAScheduleTriggerScreen argument:@"home"]);
+    XCTAssertFalse([self.index hasCandidatesForType:UAScheduleTriggerScreen argument:@"settings"]);
+    XCTAssertTrue([self.index hasCandidatesForType:UAScheduleTriggerRegionEnter argument:@{ @"region_id": @"office" }]);
+    XCTAssertFalse([self.index hasCandidatesForType:UAScheduleTriggerRegionEnter argument:@{ @"region_id": @"home" }]);
+    XCTAssertFalse([self.index hasCandidatesForType:UAScheduleTriggerRegionExit argument:@{ @"region_id": @"office" }]);
+}
+
+- (void)testCustomEventWithoutName {
+    [self.index finishRebuild:[self.index beginRebuild] withIndex:[UAScheduleTriggerIndex triggerIndex]];
+
+    NSDictionary *predicateJSON = @{ @"not": @[ @{ @"key": @"event_name", @"value": @{ @"equals": @"purchase" } } ]};
+    UAJSONPredicate *predicate = [UAJSONPredicate predicateWithJSON:predicateJSON error:nil];
+    [self.index addTriggerWithType:UAScheduleTriggerCustomEventCount predicate:predicate];
+
+    XCTAssertTrue([self.index hasCandidatesForType:UAScheduleTriggerCustomEventCount argument:@{ @"event_name": @"other" }]);
+}
+
+- (void)testRebuildRemovesTriggers {
+    [self.index addTriggerWithType:UAScheduleTriggerScreen predicate:nil];
+
+    UAScheduleTriggerIndex *rebuilt = [UAScheduleTriggerIndex triggerIndex];
+    [rebuilt addTriggerWithType:UAScheduleTriggerRegionEnter predicate:nil];
+    [self.index finishRebuild:[self.index beginRebuild] withIndex:rebuilt];
+
+    XCTAssertFalse([self.index hasCandidatesForType:UAScheduleTriggerScreen argument:@"screen"]);
+    XCTAssertTrue([self.index hasCandidatesForType:UAScheduleTriggerRegionEnter argument:@"region"]);
+}
+
+- (void)testRebuildKeepsNewerAdditions {
+    NSUInteger first = [self.index beginRebuild];
+    [self.index addTriggerWithType:UAScheduleTriggerScreen predicate:nil];
+    NSUInteger second = [self.index beginRebuild];
+    [self.index addTriggerWithType:UAScheduleTriggerRegionExit predicate:nil];
+
+    // Stale rebuild is ignored
+    [self.index finishRebuild:first withIndex:[UAScheduleTriggerIndex triggerIndex]];
+    XCTAssertTrue([self.index hasCandidatesForType:UAScheduleTriggerAppInit argument:nil]);
+
+    UAScheduleTriggerIndex *rebuilt = [UAScheduleTriggerIndex triggerIndex];
+    [rebuilt addTriggerWithType:UAScheduleTriggerScreen predicate:nil];
+    [self.index finishRebuild:second withIndex:rebuilt];
+
+    XCTAssertTrue([self.index hasCandidatesForType:UAScheduleTriggerScreen argument:@"screen"]);
+    XCTAssertTrue([self.index hasCandidatesForType:UAScheduleTriggerRegionExit argument:@"region"]);
+    XCTAssertFalse([self.index hasCandidatesForType:UAScheduleTriggerAppInit argument:nil]);
+}
+
+@end
@@ -0,0 +1,72 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAStartupMetrics+Internal.h"
+
+@interface UAStartupMetricsTest : UABaseTest
+@property (nonatomic, strong) UAStartupMetrics *metrics;
+@end
+
+@implementation UAStartupMetricsTest
+
+- (void)setUp {
+    [super setUp];
+    self.metrics = [UAStartupMetrics shared];
+    [self.metrics reset];
+}
+
+- (void)tearDown {
+    [self.metrics reset];
+    [super tearDown];
+}
+
+- (void)testMeasure {
+    __block BOOL ran = NO;
+    [self.metrics measure:@"outer" block:^{
+        [self.metrics measure:@"inner" block:^{
+            ran = YES;
+            [NSThread sleepForTimeInterval:0.01];
+        }];
+    }];
+
+    XCTAssertTrue(ran);
+    XCTAssertEqual(2, self.metrics.measurements.count);
+
+    UAStartupMeasurement *inner = self.metrics.measurements[0];
+    UAStartupMeasurement *outer = self.metrics.measurements[1];
+    XCTAssertEqualObjects(@"inner", inner.name);
+    XCTAssertEqualObjects(@"outer", outer.name);
+    XCTAssertGreaterThanOrEqual(inner.duration, 0.01);
+    XCTAssertGreaterThanOrEqual(outer.duration, inner.duration);
+}
+
+- (void)testIntervalMeasuredOnce {
+    [self.metrics beginInterval:@"interval"];
+    [self.metrics endInterval:@"interval"];
+
+    // Later intervals with the same name are ignored
+    [self.metrics beginInterval:@"interval"];
+    [self.metrics endInterval:@"interval"];
+
+    // Ending an interval that never began is ignored
+    [self.metrics endInterval:@"other"];
+
+    XCTAssertEqual(1, self.metrics.measurements.count);
+    XCTAssertEqualObjects(@"interval", self.metrics.measurements[0].name);
+}
+
+- (void)testSummary {
+    [self.metrics measure:@"foo" block:^{}];
+    [self.metrics measure:@"bar" block:^{}];
+
+    XCTAssertTrue([self.metrics.summary containsString:@"foo"]);
+    XCTAssertTrue([self.metrics.summary containsString:@"bar"]);
+}
+
+- (void)testReset {
+    [self.metrics measure:@"step" block:^{}];
+    [self.metrics reset];
+    XCTAssertEqual(0, self.metrics.measurements.count);
+}
+
+@end
@@ -133,17 +133,22 @@
     [[self.mockChannel expect] addTags:[OCMArg any]];
     [[self.mockChannel expect] updateRegistration];
 
-    [action runWithArguments:self.stringArgs
-           completionHandler:^(UAActionResult *result) {
-           [self.mockChannel verify];
+    XCTestExpectation *stringArgsFinished = [self expectationWithDescription:@"action finished"];
+    [action runWithArguments:self.stringArgs completionHandler:^(UAActionResult *result) {
+        [self.mockChannel verify];
+        [stringArgsFinished fulfill];
     }];
+    [self waitForTestExpectations];
 
     [[self.mockChannel expect] addTags:[OCMArg any]];
     [[self.mockChannel expect] updateRegistration];
 
+    XCTestExpectation *arrayArgsFinished = [self expectationWithDescription:@"action finished"];
     [action runWithArguments:self.arrayArgs completionHandler:^(UAActionResult *result) {
-           [self.mockChannel verify];
+        [self.mockChannel verify];
+        [arrayArgsFinished fulfill];
     }];
+    [self waitForTestExpectations];
 
     [[self.mockChannel expect] addTags:@[@"device tag", @"another device tag"]];
     [[self.mockChannel expect] addTags:@[@"tag1", @"tag2"] group:@"group1"];
@@ -152,10 +157,13 @@
     [[self.mockChannel expect] updateRegistration];
     [[self.mockNamedUser expect] updateTags];
 
+    XCTestExpectation *dictArgsFinished = [self expectationWithDescription:@"action finished"];
     [action runWithArguments:self.dictArgs completionHandler:^(UAActionResult *result) {
         [self.mockChannel verify];
         [self.mockNamedUser verify];
+        [dictArgsFinished fulfill];
     }];
+    [self waitForTestExpectations];
 }
 
 /**
@@ -169,16 +177,22 @@
     [[self.mockChannel expect] removeTags:[OCMArg any]];
     [[self.mockChannel expect] updateRegistration];
 
+    XCTestExpectation *stringArgsFinished = [self expectationWithDescription:@"action finished"];
     [action runWithArguments:self.stringArgs completionHandler:^(UAActionResult *result) {
-           [self.mockChannel verify];
+        [self.mockChannel verify];
+        [stringArgsFinished fulfill];
     }];
+    [self waitForTestExpectations];
 
     [[self.mockChannel expect] removeTags:[OCMArg any]];
     [[self.mockChannel expect] updateRegistration];
 
+    XCTestExpectation *arrayArgsFinished = [self expectationWithDescription:@"action finished"];
     [action runWithArguments:self.arrayArgs completionHandler:^(UAActionResult *result) {
-           [self.mockChannel verify];
+        [self.mockChannel verify];
+        [arrayArgsFinished fulfill];
     }];
+    [self waitForTestExpectations];
 
     [[self.mockChannel expect] removeTags:@[@"device tag", @"another device tag"]];
     [[self.mockChannel expect] removeTags:@[@"tag1", @"tag2"] group:@"group1"];
@@ -187,10 +201,13 @@
     [[self.mockChannel expect] updateRegistration];
     [[self.mockNamedUser expect] updateTags];
     
+    XCTestExpectation *dictArgsFinished = [self expectationWithDescription:@"action finished"];
     [action runWithArguments:self.dictArgs completionHandler:^(UAActionResult *result) {
         [self.mockChannel verify];
         [self.mockNamedUser verify];
+        [dictArgsFinished fulfill];
     }];
+    [self waitForTestExpectations];
 }
 
 @end
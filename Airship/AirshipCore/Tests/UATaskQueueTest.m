@@ -0,0 +1,127 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UATaskQueue+Internal.h"
+#import "UATestDispatcher.h"
+
+@interface UATaskQueueTest : UABaseTest
+@property (nonatomic, strong) UATestDispatcher *testDispatcher;
+@property (nonatomic, strong) UATaskQueue *queue;
+@end
+
+@implementation UATaskQueueTest
+
+- (void)setUp {
+    [super setUp];
+    self.testDispatcher = [UATestDispatcher testDispatcher];
+    self.queue = [UATaskQueue queueWithDispatcher:self.testDispatcher];
+}
+
+- (void)testTasksRunOneAtATime {
+    __block UATask *firstTask;
+    __block BOOL secondStarted = NO;
+
+    [self.queue addTask:[UATask taskWithBlock:^(UATask *task) {
+        firstTask = task;
+    }]];
+
+    [self.queue addTask:[UATask taskWithBlock:^(UATask *task) {
+        secondStarted = YES;
+        [task finish];
+    }]];
+
+    XCTAssertNotNil(firstTask);
+    XCTAssertFalse(secondStarted);
+
+    [firstTask finish];
+    XCTAssertTrue(secondStarted);
+}
+
+- (void)testDelay {
+    __block BOOL started = NO;
+    [self.queue addTask:[UATask taskWithBlock:^(UATask *task) {
+        started = YES;
+        [task finish];
+    }] delay:10];
+
+    [self.testDispatcher advanceTime:9];
+    XCTAssertFalse(started);
+
+    [self.testDispatcher advanceTime:1];
+    XCTAssertTrue(started);
+}
+
+- (void)testCancelDelayedTask {
+    __block BOOL started = NO;
+    UATask *delayed = [UATask taskWithBlock:^(UATask *task) {
+        started = YES;
+        [task finish];
+    }];
+
+    __block BOOL nextStarted = NO;
+    UATask *next = [UATask taskWithBlock:^(UATask *task) {
+        nextStarted = YES;
+        [task finish];
+    }];
+
+    [self.queue addTask:delayed delay:10];
+    [self.queue addTask:next];
+
+    [delayed cancel];
+
+    XCTAssertTrue(delayed.isFinished);
+    XCTAssertFalse(started);
+    XCTAssertTrue(nextStarted);
+}
+
+- (void)testDependency {
+    UATask *dependency = [UATask taskWithBlock:^(UATask *task) {}];
+
+    __block BOOL started = NO;
+    UATask *task = [UATask taskWithBlock:^(UATask *task) {
+        started = YES;
+        [task finish];
+    }];
+
+    [task addDependency:dependency];
+    [self.queue addTask:task];
+    XCTAssertFalse(started);
+
+    [dependency start];
+    [dependency finish];
+    XCTAssertTrue(started);
+}
+
+- (void)testCancelAllTasks {
+    __block BOOL cancelBlockCalled = NO;
+    UATask *running = [UATask taskWithBlock:^(UATask *task) {
+        task.cancelBlock = ^{
+            cancelBlockCalled = YES;
+            [task finish];
+        };
+    }];
+
+    __block BOOL pendingStarted = NO;
+    UATask *pending = [UATask taskWithBlock:^(UATask *task) {
+        pendingStarted = YES;
+        [task finish];
+    }];
+
+    __block BOOL pendingCompleted = NO;
+    pending.completionBlock = ^{
+        pendingCompleted = YES;
+    };
+
+    [self.queue addTask:running];
+    [self.queue addTask:pending delay:10];
+
+    [self.queue cancelAllTasks];
+
+    XCTAssertTrue(cancelBlockCalled);
+    XCTAssertTrue(running.isCancelled);
+    XCTAssertTrue(pending.isFinished);
+    XCTAssertTrue(pendingCompleted);
+    XCTAssertFalse(pendingStarted);
+}
+
+@end
@@ -4,17 +4,16 @@
 
 @implementation UATestAppStateTracker
 
-static UATestAppStateTracker *shared_;
-
-+ (void)load {
-    shared_ = [[UATestAppStateTracker alloc] init];
-}
-
 -(UAApplicationState)state {
     return self.currentState;
 }
 
 + (instancetype)shared {
+    static UATestAppStateTracker *shared_;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        shared_ = [[UATestAppStateTracker alloc] init];
+    });
     return shared_;
 }
 
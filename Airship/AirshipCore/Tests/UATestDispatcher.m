@@ -56,7 +56,8 @@
     self.currentTime += time;
 
     NSMutableArray *handled = [NSMutableArray array];
-    for (UAScheduledBlockEntry *entry in self.scheduledBlocks) {
+    // Blocks may schedule more blocks as they run
+    for (UAScheduledBlockEntry *entry in [self.scheduledBlocks copy]) {
         NSDate *currentDate = [NSDate dateWithTimeIntervalSince1970:self.currentTime];
         NSDate *entryDate = [NSDate dateWithTimeIntervalSince1970:entry.time];
         if ([currentDate compare:entryDate] != NSOrderedAscending) {
@@ -87,6 +88,10 @@
     block();
 }
 
+- (void)dispatchAsync:(void (^)(void))block workType:(UADispatcherWorkType)workType {
+    block();
+}
+
 - (void)dispatchSync:(void (^)(void))block {
     block();
 }
@@ -20,6 +20,7 @@
 @synthesize clearNamedUserOnAppRestore;
 @synthesize channelCaptureEnabled;
 @synthesize channelCreationDelayEnabled;
+@synthesize lazyMessageCenterEnabled;
 @synthesize customConfig;
 @synthesize requestAuthorizationToUseNotifications;
 @synthesize deviceAPIURL;
@@ -375,6 +375,16 @@
     XCTAssertFalse([self.URLAllowList isAllowed:[NSURL URLWithString:@"com.urbanairship.five:/cool"]]);
 }
 
+- (void)testAddingEntryUpdatesCachedDecisions {
+    NSURL *URL = [NSURL URLWithString:@"https://example.com/path"];
+    XCTAssertFalse([self.URLAllowList isAllowed:URL]);
+
+    [self.URLAllowList addEntry:@"https://*.example.com/path"];
+    XCTAssertTrue([self.URLAllowList isAllowed:URL]);
+    XCTAssertTrue([self.URLAllowList isAllowed:URL]);
+    XCTAssertFalse([self.URLAllowList isAllowed:[NSURL URLWithString:@"https://notexample.com/path"]]);
+}
+
 - (void)testDelegate {
     // set up a simple URL allow list
     [self.URLAllowList addEntry:@"https://*.urbanairship.com"];
@@ -89,5 +89,20 @@
     XCTAssertEqual(operation.isFinished, YES);
 }
 
+- (void)testPriority {
+    UAURLRequestOperation *operation = [UAURLRequestOperation operationWithRequest:self.request
+                                                                          priority:NSURLSessionTaskPriorityHigh
+                                                                           session:self.mockSession
+                                                                 completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {}];
+
+    id mockTask = [self mockForClass:[NSURLSessionDataTask class]];
+    [[mockTask expect] setPriority:NSURLSessionTaskPriorityHigh];
+    [[mockTask expect] resume];
+    [[[self.mockSession stub] andReturn:mockTask] dataTaskWithRequest:self.request completionHandler:OCMOCK_ANY];
+
+    [operation start];
+
+    [mockTask verify];
+}
 
 @end
@@ -222,6 +222,38 @@
 /**
  * Test isSilentPush is YES when no notification alerts exist in the payload.
  */
+- (void)testISODateStringMatchesFormatters {
+    NSDateFormatter *formatter = [UAUtils ISODateFormatterUTC];
+    NSDateFormatter *delimiterFormatter = [UAUtils ISODateFormatterUTCWithDelimiter];
+
+    NSArray *dates = @[[NSDate dateWithTimeIntervalSince1970:0],
+                       [NSDate dateWithTimeIntervalSince1970:951782400.75], // 2000-02-29
+                       [NSDate dateWithTimeIntervalSince1970:-86401.5],
+                       [NSDate dateWithTimeIntervalSince1970:4102444799]];
+
+    for (NSDate *date in dates) {
+        XCTAssertEqualObjects([formatter stringFromDate:date], [UAUtils ISODateStringFromDate:date delimiter:NO]);
+        XCTAssertEqualObjects([delimiterFormatter stringFromDate:date], [UAUtils ISODateStringFromDate:date delimiter:YES]);
+    }
+}
+
+- (void)testParseISO8601MatchesFormatter {
+    NSDateFormatter *formatter = [[NSDateFormatter alloc] init];
+    formatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+    formatter.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+    formatter.dateFormat = @"yyyy-MM-dd'T'HH:mm:ss.SSS";
+
+    NSDate *expected = [formatter dateFromString:@"2020-02-29T23:59:58.123"];
+    XCTAssertEqualWithAccuracy(expected.timeIntervalSince1970,
+                               [UAUtils parseISO8601DateFromString:@"2020-02-29T23:59:58.123"].timeIntervalSince1970,
+                               0.0001);
+
+    // Shapes the fast path rejects still go through the formatters
+    XCTAssertNil([UAUtils parseISO8601DateFromString:@"not a date"]);
+    XCTAssertNil([UAUtils parseISO8601DateFromString:@"2021-02-29"]);
+    XCTAssertNil([UAUtils parseISO8601DateFromString:(NSString *)[NSNull null]]);
+}
+
 - (void)testIsSilentPush {
 
     NSDictionary *emptyNotification = @{
@@ -2,6 +2,7 @@
 
 #import "UABaseTest.h"
 #import "UAVersionMatcher.h"
+#import "UAUtils+Internal.h"
 
 @interface UAVersionMatcherTests : UABaseTest
 
@@ -317,4 +318,28 @@
     XCTAssertFalse([matcher evaluateObject:@"3.0"]);
     XCTAssertFalse([matcher evaluateObject:@"999.999.999"]);
 }
+
+- (void)testMatchersAreCached {
+    UAVersionMatcher *matcher = [UAVersionMatcher matcherWithVersionConstraint:@"[1.0, 2.0]"];
+    XCTAssertEqual(matcher, [UAVersionMatcher matcherWithVersionConstraint:@"[1.0, 2.0]"]);
+
+    XCTAssertNil([UAVersionMatcher matcherWithVersionConstraint:@"not a version"]);
+    XCTAssertNil([UAVersionMatcher matcherWithVersionConstraint:@"not a version"]);
+}
+
+- (void)testVersionRangeMatchesUtilsComparison {
+    UAVersionMatcher *matcher = [UAVersionMatcher matcherWithVersionConstraint:@"[1.2.3, 10.0["];
+
+    NSArray *versions = @[@"1.2.3", @"1.2.2", @"1.2.3.0.0", @"1.10", @"9.999", @"10", @"10.0.0.1", @"1.2a.4", @"", @"-1.0",
+                          @"1.2.3.4.5.6.7.8.9.10.11.12.13.14.15.16.17.18.19.20.21.22.23.24.25.26.27.28.29.30"];
+
+    for (NSString *version in versions) {
+        BOOL expected = [UAUtils compareVersion:@"1.2.3" toVersion:version] != NSOrderedDescending &&
+                        [UAUtils compareVersion:version toVersion:@"10.0"] == NSOrderedAscending;
+        XCTAssertEqual(expected, [matcher evaluateObject:version], @"Unexpected result for %@", version);
+    }
+
+    XCTAssertFalse([matcher evaluateObject:@(2)]);
+}
+
 @end
@@ -0,0 +1,58 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAWebViewPool+Internal.h"
+
+@interface UAWebViewPoolTest : UABaseTest
+@property (nonatomic, strong) UAWebViewPool *pool;
+@end
+
+@implementation UAWebViewPoolTest
+
+- (void)setUp {
+    [super setUp];
+    self.pool = [[UAWebViewPool alloc] init];
+}
+
+/**
+ * Test checked out web views share the process pool of other Airship web views.
+ */
+- (void)testWebViewsShareProcessPool {
+    UAWebView *first = [self.pool checkOutWebView];
+    UAWebView *second = [self.pool checkOutWebView];
+    UAWebView *webView = [[UAWebView alloc] initWithFrame:CGRectZero];
+
+    XCTAssertNotEqual(first, second);
+    XCTAssertEqual(webView.configuration.processPool, first.configuration.processPool);
+    XCTAssertEqual(webView.configuration.processPool, second.configuration.processPool);
+}
+
+/**
+ * Test checked in web views are reset and reused.
+ */
+- (void)testCheckInReusesWebView {
+    UAWebView *webView = [self.pool checkOutWebView];
+    UIView *superview = [[UIView alloc] init];
+    [superview addSubview:webView];
+    webView.scrollView.scrollEnabled = NO;
+
+    [self.pool checkInWebView:webView];
+    XCTAssertNil(webView.superview);
+    XCTAssertNil(webView.navigationDelegate);
+    XCTAssertTrue(webView.scrollView.scrollEnabled);
+
+    XCTAssertEqual(webView, [self.pool checkOutWebView]);
+}
+
+/**
+ * Test prewarm fills an empty pool.
+ */
+- (void)testPrewarm {
+    [self.pool prewarm];
+    UAWebView *webView = [self.pool checkOutWebView];
+
+    [self.pool prewarm];
+    XCTAssertNotEqual(webView, [self.pool checkOutWebView]);
+}
+
+@end
@@ -0,0 +1,169 @@
+/* Copyright Airship and Contributors */
+
+#import "UABaseTest.h"
+#import "UAWorkScheduler+Internal.h"
+#import "UAMetricsRegistry+Internal.h"
+#import "UATestDate.h"
+
+@interface UAWorkSchedulerTest : UABaseTest
+@property (nonatomic, strong) UATestDate *testDate;
+@property (nonatomic, strong) UAMetricsRegistry *metrics;
+@property (nonatomic, strong) UAWorkScheduler *scheduler;
+@property (nonatomic, strong) NSMutableArray<NSString *> *ran;
+@property (nonatomic, strong) NSMutableArray<NSString *> *dropped;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, void (^)(void)> *completionHandlers;
+@end
+
+@implementation UAWorkSchedulerTest
+
+- (void)setUp {
+    [super setUp];
+    self.testDate = [[UATestDate alloc] initWithAbsoluteTime:[NSDate date]];
+    self.metrics = [UAMetricsRegistry metricsRegistry];
+    self.scheduler = [UAWorkScheduler schedulerWithLaunchType:UAWorkLaunchTypeBackgroundFetch
+                                           notificationCenter:[[NSNotificationCenter alloc] init]
+                                                         date:self.testDate
+                                                      metrics:self.metrics];
+    self.ran = [NSMutableArray array];
+    self.dropped = [NSMutableArray array];
+    self.completionHandlers = [NSMutableDictionary dictionary];
+}
+
+/**
+ * Submits work that finishes once its completion handler in `completionHandlers` is called.
+ */
+- (UADisposable *)submitWorkWithName:(NSString *)name priority:(UAWorkPriority)priority deadline:(NSTimeInterval)deadline {
+    return [self.scheduler submitWorkWithName:name priority:priority deadline:deadline dispatcher:nil block:^UADisposable *(void (^completionHandler)(void)) {
+        [self.ran addObject:name];
+        self.completionHandlers[name] = completionHandler;
+        return nil;
+    } dropHandler:^{
+        [self.dropped addObject:name];
+    }];
+}
+
+- (void)finishWorkWithName:(NSString *)name {
+    void (^completionHandler)(void) = self.completionHandlers[name];
+    [self.completionHandlers removeObjectForKey:name];
+    completionHandler();
+}
+
+- (void)testWorkRunsInPriorityAndDeadlineOrder {
+    // Fill the running slots
+    for (NSUInteger i = 0; i < UAWorkBackgroundMaxRunningJobs; i++) {
+        [self submitWorkWithName:[NSString stringWithFormat:@"blocker %lu", (unsigned long)i] priority:UAWorkPriorityDefault deadline:0];
+    }
+    [self.ran removeAllObjects];
+
+    [self submitWorkWithName:@"low" priority:UAWorkPriorityLow deadline:0];
+    [self submitWorkWithName:@"default" priority:UAWorkPriorityDefault deadline:0];
+    [self submitWorkWithName:@"default with deadline" priority:UAWorkPriorityDefault deadline:60];
+    [self submitWorkWithName:@"high" priority:UAWorkPriorityHigh deadline:0];
+    XCTAssertEqual(0, self.ran.count);
+
+    // Each finished job makes room for the next one
+    for (NSUInteger i = 0; i < UAWorkBackgroundMaxRunningJobs; i++) {
+        [self finishWorkWithName:[NSString stringWithFormat:@"blocker %lu", (unsigned long)i]];
+    }
+    XCTAssertEqualObjects((@[@"high", @"default with deadline"]), self.ran);
+
+    [self finishWorkWithName:@"high"];
+    [self finishWorkWithName:@"default with deadline"];
+    XCTAssertEqualObjects((@[@"high", @"default with deadline", @"default", @"low"]), self.ran);
+}
+
+- (void)testSpentBudgetDefersAndDropsWork {
+    [self submitWorkWithName:@"long" priority:UAWorkPriorityDefault deadline:0];
+    self.testDate.timeOffset = UAWorkBackgroundFetchBudget;
+    XCTAssertEqual(0, self.scheduler.remainingBudget);
+    [self finishWorkWithName:@"long"];
+
+    [self submitWorkWithName:@"high" priority:UAWorkPriorityHigh deadline:0];
+    [self submitWorkWithName:@"default" priority:UAWorkPriorityDefault deadline:0];
+    [self submitWorkWithName:@"low" priority:UAWorkPriorityLow deadline:0];
+
+    // Only high priority work runs once the budget is spent
+    XCTAssertEqualObjects((@[@"long", @"high"]), self.ran);
+    XCTAssertEqualObjects(@[@"low"], self.dropped);
+    XCTAssertEqual(1, [self.metrics counterWithName:UAMetricWorkDeferred].value);
+    XCTAssertEqual(1, [self.metrics counterWithName:UAMetricWorkDropped].value);
+
+    // Deferred work runs in the next window
+    [self finishWorkWithName:@"high"];
+    [self.scheduler beginWindowWithLaunchType:UAWorkLaunchTypeSilentPush];
+    XCTAssertEqual(UAWorkLaunchTypeSilentPush, self.scheduler.launchType);
+    XCTAssertEqualObjects((@[@"long", @"high", @"default"]), self.ran);
+}
+
+- (void)testActiveWindowIsNotRestarted {
+    [self submitWorkWithName:@"running" priority:UAWorkPriorityDefault deadline:0];
+    self.testDate.timeOffset = UAWorkBackgroundFetchBudget;
+
+    // A silent push while the fetch window is still running work keeps the spent budget
+    [self.scheduler beginWindowWithLaunchType:UAWorkLaunchTypeSilentPush];
+    XCTAssertEqual(UAWorkLaunchTypeBackgroundFetch, self.scheduler.launchType);
+    XCTAssertEqual(0, self.scheduler.remainingBudget);
+
+    // Once idle, a new window starts
+    [self finishWorkWithName:@"running"];
+    [self.scheduler beginWindowWithLaunchType:UAWorkLaunchTypeBackgroundProcessing];
+    XCTAssertEqual(UAWorkLaunchTypeBackgroundProcessing, self.scheduler.launchType);
+    XCTAssertEqualWithAccuracy(UAWorkBackgroundProcessingBudget, self.scheduler.remainingBudget, 0.001);
+}
+
+- (void)testWorkPastItsDeadlineIsDropped {
+    for (NSUInteger i = 0; i < UAWorkBackgroundMaxRunningJobs; i++) {
+        [self submitWorkWithName:[NSString stringWithFormat:@"blocker %lu", (unsigned long)i] priority:UAWorkPriorityDefault deadline:0];
+    }
+
+    [self submitWorkWithName:@"urgent" priority:UAWorkPriorityHigh deadline:1];
+    self.testDate.timeOffset = 2;
+    [self finishWorkWithName:@"blocker 0"];
+
+    XCTAssertFalse([self.ran containsObject:@"urgent"]);
+    XCTAssertEqualObjects(@[@"urgent"], self.dropped);
+}
+
+- (void)testDisposePendingWork {
+    for (NSUInteger i = 0; i < UAWorkBackgroundMaxRunningJobs; i++) {
+        [self submitWorkWithName:[NSString stringWithFormat:@"blocker %lu", (unsigned long)i] priority:UAWorkPriorityDefault deadline:0];
+    }
+
+    UADisposable *disposable = [self submitWorkWithName:@"cancelled" priority:UAWorkPriorityDefault deadline:0];
+    [disposable dispose];
+    [self finishWorkWithName:@"blocker 0"];
+
+    XCTAssertFalse([self.ran containsObject:@"cancelled"]);
+    XCTAssertEqual(0, self.dropped.count);
+}
+
+- (void)testDisposeRunningWork {
+    __block BOOL workDisposed = NO;
+    UADisposable *disposable = [self.scheduler submitWorkWithName:@"work" priority:UAWorkPriorityDefault deadline:0 dispatcher:nil block:^UADisposable *(void (^completionHandler)(void)) {
+        return [UADisposable disposableWithBlock:^{
+            workDisposed = YES;
+        }];
+    } dropHandler:nil];
+
+    [disposable dispose];
+    XCTAssertTrue(workDisposed);
+
+    // The slot is released even though the work never called its completion handler
+    for (NSUInteger i = 0; i < UAWorkBackgroundMaxRunningJobs; i++) {
+        [self submitWorkWithName:[NSString stringWithFormat:@"next %lu", (unsigned long)i] priority:UAWorkPriorityDefault deadline:0];
+    }
+    XCTAssertEqual(UAWorkBackgroundMaxRunningJobs, self.ran.count);
+}
+
+- (void)testWorkDurationIsRecorded {
+    [self submitWorkWithName:@"timed" priority:UAWorkPriorityDefault deadline:0];
+    self.testDate.timeOffset = 3;
+    [self finishWorkWithName:@"timed"];
+
+    UAMetric *metric = [self.metrics metricWithName:[UAMetricWorkPrefix stringByAppendingString:@"timed"]];
+    XCTAssertEqual(UAMetricTypeTimer, metric.type);
+    XCTAssertEqualWithAccuracy(3, metric.total, 0.001);
+    XCTAssertEqualWithAccuracy(UAWorkBackgroundFetchBudget - 3, self.scheduler.remainingBudget, 0.001);
+}
+
+@end
@@ -1,5 +1,6 @@
 
 #import <UIKit/UIKit.h>
+#import <objc/runtime.h>
 #import "UABaseTest.h"
 #import "UAirship.h"
 #import "UAConfig.h"
@@ -31,4 +32,29 @@
     [self waitForTestExpectations];
 }
 
+/**
+ * Test that no SDK class implements +load, so linking the SDK adds no work before main.
+ */
+- (void)testNoLoadMethods {
+    const char *image = class_getImageName([UAirship class]);
+    unsigned int classCount = 0;
+    const char **classNames = objc_copyClassNamesForImage(image, &classCount);
+
+    for (unsigned int i = 0; i < classCount; i++) {
+        Class metaClass = object_getClass(objc_getClass(classNames[i]));
+        unsigned int methodCount = 0;
+        Method *methods = class_copyMethodList(metaClass, &methodCount);
+
+        for (unsigned int j = 0; j < methodCount; j++) {
+            if (method_getName(methods[j]) == @selector(load)) {
+                XCTFail(@"%s implements +load", classNames[i]);
+            }
+        }
+
+        free(methods);
+    }
+
+    free(classNames);
+}
+
 @end
@@ -41,6 +41,24 @@ public class AirshipDebug : NSObject {
         }
     }
     
+    /**
+     * Network metrics for the requests the SDK makes to Airship.
+     */
+    @objc public class var networkMetricsViewController : UIViewController {
+        get {
+            return NetworkMetricsTableViewController(style: .plain)
+        }
+    }
+
+    /**
+     * Live SDK performance metrics from the shared metrics registry.
+     */
+    @objc public class var performanceMetricsViewController : UIViewController {
+        get {
+            return PerformanceMetricsTableViewController(style: .grouped)
+        }
+    }
+
     /**
      * Get the initial view controller for the requested storyboard
      */
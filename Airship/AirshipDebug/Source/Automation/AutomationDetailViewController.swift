@@ -53,6 +53,9 @@ class AutomationDetailViewController: UIViewController, UITableViewDelegate, UIT
 
     private let inAppAutomation = UAInAppAutomation.shared()
 
+    /* The schedule's display timeline, if one was recorded */
+    private var timeline : UAScheduleTimeline?
+
 
     /* Section
      * Note: Number of sections and sections for row are defined in their respective
@@ -60,7 +63,8 @@ class AutomationDetailViewController: UIViewController, UITableViewDelegate, UIT
      */
     let scheduleSection = 0,
     messageSection = 1,
-    contentSection = 2
+    contentSection = 2,
+    timelineSection = 3
 
     // Indexes section 0
     private let identifierIdx = IndexPath(row: 0, section: 0),
@@ -106,6 +110,15 @@ class AutomationDetailViewController: UIViewController, UITableViewDelegate, UIT
         setTableViewTheme()
     }
 
+    override func viewWillAppear(_ animated: Bool) {
+        super.viewWillAppear(animated)
+
+        if let schedule = schedule {
+            timeline = inAppAutomation?.timeline(forScheduleID: schedule.identifier)
+            tableView.reloadData()
+        }
+    }
+
     func setTableViewTheme() {
         tableView.backgroundColor = ThemeManager.shared.currentTheme.Background;
         navigationController?.navigationBar.titleTextAttributes = [.foregroundColor:ThemeManager.shared.currentTheme.NavigationBarText]
@@ -120,6 +133,9 @@ class AutomationDetailViewController: UIViewController, UITableViewDelegate, UIT
             return 5
         case contentSection:
             return 14
+        case timelineSection:
+            // Outcome row followed by a row per stage
+            return 1 + (timeline?.stages.count ?? 0)
         default:
             return 0
         }
@@ -139,6 +155,8 @@ class AutomationDetailViewController: UIViewController, UITableViewDelegate, UIT
             return createMessageCell(indexPath)
         case contentSection:
             return createContentCell(indexPath)
+        case timelineSection:
+            return createTimelineCell(indexPath)
         default:
             break
         }
@@ -631,6 +649,32 @@ class AutomationDetailViewController: UIViewController, UITableViewDelegate, UIT
         return 44
     }
 
+    func createTimelineCell(_ indexPath:IndexPath) -> UITableViewCell {
+        let cell = defaultAutomationDetailCell(indexPath)
+
+        guard let timeline = timeline else {
+            cell.title.text = "ua_timeline_none".localized()
+            return cell
+        }
+
+        if indexPath.row == 0 {
+            cell.title.text = "ua_timeline_outcome".localized()
+            let outcome = timeline.outcome ?? "ua_timeline_in_progress".localized()
+            cell.subtitle.text = "\(outcome): \(String(format: "%.1fms", timeline.duration * 1000))"
+            return cell
+        }
+
+        let stage = timeline.stages[indexPath.row - 1]
+        cell.title.text = stage.name
+        var description = String(format: "%.1fms", stage.duration * 1000)
+        if let result = stage.result {
+            description += " (\(result))"
+        }
+        cell.subtitle.text = description
+
+        return cell
+    }
+
     func createMessageCell(_ indexPath:IndexPath) -> UITableViewCell {
         guard let schedule = schedule else {
             return UITableViewCell()
@@ -712,7 +756,7 @@ class AutomationDetailViewController: UIViewController, UITableViewDelegate, UIT
     }
 
     func numberOfSections(in tableView: UITableView) -> Int {
-        return 3
+        return 4
     }
 
     func tableView(_ tableView: UITableView, titleForHeaderInSection section: Int) -> String? {
@@ -737,6 +781,8 @@ class AutomationDetailViewController: UIViewController, UITableViewDelegate, UIT
             @unknown default:
                 return "ua_displaycontent_title_unknown".localized()
             }
+        case timelineSection:
+            return "ua_timeline_title".localized()
         default:
             return "ua_displaycontent_title_unknown".localized()
         }
@@ -10,7 +10,7 @@ import Airship
 #endif
 
 protocol EventDataManagerDelegate {
-    func eventAdded()
+    func eventsAdded(count:Int)
 }
 
 class EventDataManager: NSObject, UAAnalyticsEventConsumerProtocol {
@@ -34,6 +34,18 @@ class EventDataManager: NSObject, UAAnalyticsEventConsumerProtocol {
         }
     }
 
+    // Events are inserted on a background context and saved in batches, at most a second apart.
+    private let saveDelay:TimeInterval = 1
+    private let saveBatchSize = 50
+
+    // The default page size for event fetches.
+    private let defaultFetchLimit = 500
+    private let fetchBatchSize = 50
+
+    // Only accessed on the background context's queue
+    private var pendingSaveCount = 0
+    private var saveScheduled = false
+
     var delegate:EventDataManagerDelegate?
 
     static let shared = EventDataManager()
@@ -57,9 +69,17 @@ class EventDataManager: NSObject, UAAnalyticsEventConsumerProtocol {
             }
         })
 
+        container.viewContext.automaticallyMergesChangesFromParent = true
+
         return container
     }()
 
+    private lazy var backgroundContext:NSManagedObjectContext = {
+        let context = persistentContainer.newBackgroundContext()
+        context.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy
+        return context
+    }()
+
     override init() {
         super.init()
 
@@ -69,9 +89,7 @@ class EventDataManager: NSObject, UAAnalyticsEventConsumerProtocol {
 
     @objc func eventAdded(_ event:UAEvent) {
         let event = Event(event: event)
-        EventDataManager.shared.saveEvent(event)
-
-        delegate?.eventAdded()
+        saveEvent(event)
     }
 
     private func saveContext(_ context:NSManagedObjectContext) {
@@ -88,8 +106,48 @@ class EventDataManager: NSObject, UAAnalyticsEventConsumerProtocol {
         }
     }
 
+    // Must be called on the background context's queue
+    private func scheduleSave() {
+        if pendingSaveCount >= saveBatchSize {
+            flushPendingSaves()
+            return
+        }
+
+        guard !saveScheduled else {
+            return
+        }
+
+        saveScheduled = true
+        DispatchQueue.global(qos:.utility).asyncAfter(deadline:.now() + saveDelay) { [weak self] in
+            guard let self = self else {
+                return
+            }
+
+            self.backgroundContext.perform {
+                self.flushPendingSaves()
+            }
+        }
+    }
+
+    // Must be called on the background context's queue
+    private func flushPendingSaves() {
+        saveScheduled = false
+
+        guard pendingSaveCount > 0 else {
+            return
+        }
+
+        let count = pendingSaveCount
+        pendingSaveCount = 0
+        saveContext(backgroundContext)
+
+        DispatchQueue.main.async {
+            self.delegate?.eventsAdded(count:count)
+        }
+    }
+
     private func batchDeleteEventsOlderThanStorageDays() {
-        let context = persistentContainer.viewContext
+        let context = backgroundContext
 
         let startOfTodayDate = Calendar.current.startOfDay(for: Date())
 
@@ -102,42 +160,52 @@ class EventDataManager: NSObject, UAAnalyticsEventConsumerProtocol {
         fetchRequest.predicate = NSPredicate(format:"time < %f", storageDaysInterval)
         let batchDeleteRequest = NSBatchDeleteRequest(fetchRequest:fetchRequest)
 
-        do {
-            _ = try context.execute(batchDeleteRequest)
-        } catch {
-            print("Failed to execute request: \(error)")
+        context.perform {
+            do {
+                _ = try context.execute(batchDeleteRequest)
+            } catch {
+                print("Failed to execute request: \(error)")
+            }
         }
     }
 
     private func saveEvent(_ event:Event) {
-        let context = persistentContainer.viewContext
+        let context = backgroundContext
 
-        let persistedEvent = EventData(entity: EventData.entity(), insertInto:context)
-        persistedEvent.data = event.data
-        persistedEvent.eventID = event.eventID
-        persistedEvent.time = event.time
-        persistedEvent.eventType = event.eventType
+        context.perform {
+            let persistedEvent = EventData(entity: EventData.entity(), insertInto:context)
+            persistedEvent.data = event.data
+            persistedEvent.eventID = event.eventID
+            persistedEvent.time = event.time
+            persistedEvent.eventType = event.eventType
 
-        saveContext(context)
+            self.pendingSaveCount += 1
+            self.scheduleSave()
+        }
     }
 
     func fetchAllEvents() -> [Event] {
         return fetchEventsContaining(searchString: nil, timeWindow:nil)
     }
 
-    func fetchEventsContaining(searchString:String?, timeWindow:DateInterval?) -> [Event] {
+    /**
+     * Fetches a page of events, newest first.
+     *
+     * The time window is matched first so the string search only scans events within the indexed time range.
+     */
+    func fetchEventsContaining(searchString:String?, timeWindow:DateInterval?, offset:Int = 0, limit:Int? = nil) -> [Event] {
         var eventDatas:[Any] = []
         var events:[Event] = []
 
         let context = persistentContainer.viewContext
         let fetchRequest:NSFetchRequest = EventData.fetchRequest()
+        fetchRequest.sortDescriptors = [NSSortDescriptor(key: "time", ascending: false)]
+        fetchRequest.fetchOffset = offset
+        fetchRequest.fetchLimit = limit ?? defaultFetchLimit
+        fetchRequest.fetchBatchSize = fetchBatchSize
 
         var subpredicates:[NSPredicate] = []
 
-        if let str = searchString, !str.isEmpty {
-            subpredicates.append(NSPredicate(format: "eventID CONTAINS[cd] %@ OR eventType CONTAINS[cd] %@", str, str))
-        }
-
         if let timeWindow = timeWindow {
             let start:Double = timeWindow.start.timeIntervalSince1970
             let end:Double = start + timeWindow.duration
@@ -147,6 +215,10 @@ class EventDataManager: NSObject, UAAnalyticsEventConsumerProtocol {
             subpredicates.append(NSPredicate(format:"time >= %f AND time < %f", start, end))
         }
 
+        if let str = searchString, !str.isEmpty {
+            subpredicates.append(NSPredicate(format: "eventType CONTAINS[cd] %@ OR eventID CONTAINS[cd] %@", str, str))
+        }
+
         fetchRequest.predicate = NSCompoundPredicate(andPredicateWithSubpredicates:subpredicates)
 
         do {
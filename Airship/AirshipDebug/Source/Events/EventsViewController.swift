@@ -41,10 +41,10 @@ class EventsViewController:UIViewController, UITableViewDataSource, UITableViewD
     let currentSearchString:String? = nil
     let currentTimeWindow:TimeWindow = .All
 
-    func eventAdded() {
+    func eventsAdded(count:Int) {
         displayEvents = EventDataManager.shared.fetchEventsContaining(searchString:currentSearchString, timeWindow:timeWindowToDateInterval(timeWindow:currentTimeWindow))
 
-        totalEventsCount += 1
+        totalEventsCount += count
         tableView.reloadData()
     }
 
@@ -0,0 +1,102 @@
+/* Copyright Airship and Contributors */
+
+import UIKit
+
+#if canImport(AirshipCore)
+import AirshipCore
+#elseif canImport(Airship)
+import Airship
+#endif
+
+/**
+ * Lists the network metrics collected for each Airship endpoint.
+ */
+class NetworkMetricsTableViewController: UITableViewController {
+    private let cellIdentifier = "NetworkMetricsCell"
+
+    private var endpointMetrics: [UANetworkEndpointMetrics] = []
+
+    private let byteFormatter = ByteCountFormatter()
+
+    override func viewDidLoad() {
+        super.viewDidLoad()
+
+        title = "ua_network_metrics_title".localized()
+        navigationItem.rightBarButtonItem = UIBarButtonItem(title: "ua_network_metrics_reset".localized(),
+                                                            style: .plain,
+                                                            target: self,
+                                                            action: #selector(reset))
+
+        refreshControl = UIRefreshControl()
+        refreshControl?.addTarget(self, action: #selector(refresh), for: .valueChanged)
+    }
+
+    override func viewWillAppear(_ animated: Bool) {
+        super.viewWillAppear(animated)
+        setTableViewTheme()
+        refresh()
+    }
+
+    func setTableViewTheme() {
+        tableView.backgroundColor = ThemeManager.shared.currentTheme.Background;
+        navigationController?.navigationBar.titleTextAttributes = [.foregroundColor:ThemeManager.shared.currentTheme.NavigationBarText]
+        navigationController?.navigationBar.barTintColor = ThemeManager.shared.currentTheme.NavigationBarBackground;
+    }
+
+    @objc func refresh() {
+        endpointMetrics = UANetworkMetrics.shared().endpointMetrics
+        tableView.reloadData()
+        refreshControl?.endRefreshing()
+    }
+
+    @objc func reset() {
+        UANetworkMetrics.shared().reset()
+        refresh()
+    }
+
+    override func tableView(_ tableView: UITableView, numberOfRowsInSection section: Int) -> Int {
+        return endpointMetrics.count
+    }
+
+    override func tableView(_ tableView: UITableView, cellForRowAt indexPath: IndexPath) -> UITableViewCell {
+        let cell = tableView.dequeueReusableCell(withIdentifier: cellIdentifier) ?? UITableViewCell(style: .subtitle, reuseIdentifier: cellIdentifier)
+        let metrics = endpointMetrics[indexPath.row]
+
+        cell.backgroundColor = ThemeManager.shared.currentTheme.Background
+        cell.selectionStyle = .none
+
+        cell.textLabel?.text = metrics.endpoint
+        cell.textLabel?.textColor = ThemeManager.shared.currentTheme.PrimaryText
+        cell.textLabel?.numberOfLines = 0
+
+        cell.detailTextLabel?.text = details(metrics)
+        cell.detailTextLabel?.textColor = ThemeManager.shared.currentTheme.SecondaryText
+        cell.detailTextLabel?.numberOfLines = 0
+
+        return cell
+    }
+
+    private func details(_ metrics: UANetworkEndpointMetrics) -> String {
+        let lines = [
+            String(format: "ua_network_metrics_requests".localized(), metrics.requestCount, metrics.connectionReuseRate * 100),
+            String(format: "ua_network_metrics_latency".localized(),
+                   milliseconds(metrics.latencyPercentile(50)),
+                   milliseconds(metrics.latencyPercentile(90)),
+                   milliseconds(metrics.latencyPercentile(99))),
+            String(format: "ua_network_metrics_phases".localized(),
+                   milliseconds(metrics.averageDNSTime),
+                   milliseconds(metrics.averageTLSTime),
+                   milliseconds(metrics.averageTimeToFirstByte),
+                   milliseconds(metrics.averageTransferTime)),
+            String(format: "ua_network_metrics_bytes".localized(),
+                   byteFormatter.string(fromByteCount: metrics.bytesSent),
+                   byteFormatter.string(fromByteCount: metrics.bytesReceived))
+        ]
+
+        return lines.joined(separator: "\n")
+    }
+
+    private func milliseconds(_ interval: TimeInterval) -> Int {
+        return Int((interval * 1000).rounded())
+    }
+}
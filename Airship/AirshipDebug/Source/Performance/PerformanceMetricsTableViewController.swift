@@ -0,0 +1,176 @@
+/* Copyright Airship and Contributors */
+
+import UIKit
+
+#if canImport(AirshipCore)
+import AirshipCore
+#elseif canImport(Airship)
+import Airship
+#endif
+
+/**
+ * Shows the SDK performance metrics from the shared metrics registry, grouped by component
+ * and refreshed while the screen is visible.
+ */
+class PerformanceMetricsTableViewController: UITableViewController {
+    private enum Row {
+        case metric(UAMetric)
+        case histogram(UAMetricHistogram)
+
+        var name: String {
+            switch self {
+            case .metric(let metric):
+                return metric.name
+            case .histogram(let histogram):
+                return histogram.name
+            }
+        }
+    }
+
+    private let cellIdentifier = "PerformanceMetricsCell"
+
+    // How often the metrics are refreshed while visible
+    private let refreshInterval:TimeInterval = 1
+
+    private var sections: [(component: String, rows: [Row])] = []
+    private var refreshTimer: Timer?
+
+    private let byteFormatter = ByteCountFormatter()
+
+    override func viewDidLoad() {
+        super.viewDidLoad()
+
+        title = "ua_performance_metrics_title".localized()
+        navigationItem.rightBarButtonItem = UIBarButtonItem(title: "ua_performance_metrics_reset".localized(),
+                                                            style: .plain,
+                                                            target: self,
+                                                            action: #selector(reset))
+    }
+
+    override func viewWillAppear(_ animated: Bool) {
+        super.viewWillAppear(animated)
+        setTableViewTheme()
+        refresh()
+
+        refreshTimer = Timer.scheduledTimer(timeInterval: refreshInterval,
+                                            target: self,
+                                            selector: #selector(refresh),
+                                            userInfo: nil,
+                                            repeats: true)
+    }
+
+    override func viewWillDisappear(_ animated: Bool) {
+        super.viewWillDisappear(animated)
+        refreshTimer?.invalidate()
+        refreshTimer = nil
+    }
+
+    func setTableViewTheme() {
+        tableView.backgroundColor = ThemeManager.shared.currentTheme.Background;
+        navigationController?.navigationBar.titleTextAttributes = [.foregroundColor:ThemeManager.shared.currentTheme.NavigationBarText]
+        navigationController?.navigationBar.barTintColor = ThemeManager.shared.currentTheme.NavigationBarBackground;
+    }
+
+    @objc func refresh() {
+        // Sampling the gauges reads from the SDK stores, so keep it off the main queue
+        DispatchQueue.global(qos: .utility).async {
+            let snapshot = UAMetricsRegistry.shared().snapshot()
+            let rows = (snapshot.metrics.map { Row.metric($0) } + snapshot.histograms.map { Row.histogram($0) }).sorted { $0.name < $1.name }
+            let grouped = Dictionary(grouping: rows) { $0.name.components(separatedBy: ".").first ?? $0.name }
+            let sections = grouped.keys.sorted().map { (component: $0, rows: grouped[$0] ?? []) }
+
+            DispatchQueue.main.async {
+                self.sections = sections
+                self.tableView.reloadData()
+            }
+        }
+    }
+
+    @objc func reset() {
+        UAMetricsRegistry.shared().reset()
+        refresh()
+    }
+
+    override func numberOfSections(in tableView: UITableView) -> Int {
+        return sections.count
+    }
+
+    override func tableView(_ tableView: UITableView, titleForHeaderInSection section: Int) -> String? {
+        return sections[section].component
+    }
+
+    override func tableView(_ tableView: UITableView, numberOfRowsInSection section: Int) -> Int {
+        return sections[section].rows.count
+    }
+
+    override func tableView(_ tableView: UITableView, cellForRowAt indexPath: IndexPath) -> UITableViewCell {
+        let cell = tableView.dequeueReusableCell(withIdentifier: cellIdentifier) ?? UITableViewCell(style: .subtitle, reuseIdentifier: cellIdentifier)
+        let row = sections[indexPath.section].rows[indexPath.row]
+
+        cell.backgroundColor = ThemeManager.shared.currentTheme.Background
+        cell.selectionStyle = .none
+
+        cell.textLabel?.text = row.name
+        cell.textLabel?.textColor = ThemeManager.shared.currentTheme.PrimaryText
+        cell.textLabel?.numberOfLines = 0
+
+        switch row {
+        case .metric(let metric):
+            cell.detailTextLabel?.text = details(metric)
+        case .histogram(let histogram):
+            cell.detailTextLabel?.text = details(histogram)
+        }
+        cell.detailTextLabel?.textColor = ThemeManager.shared.currentTheme.SecondaryText
+        cell.detailTextLabel?.numberOfLines = 0
+
+        return cell
+    }
+
+    private func details(_ metric: UAMetric) -> String {
+        switch metric.type {
+        case .timer:
+            return [
+                String(format: "ua_performance_metrics_timer".localized(),
+                       milliseconds(metric.value),
+                       milliseconds(metric.average),
+                       milliseconds(metric.maxValue),
+                       metric.count),
+                String(format: "ua_performance_metrics_percentiles".localized(),
+                       milliseconds(metric.percentile(50)),
+                       milliseconds(metric.percentile(90)),
+                       milliseconds(metric.percentile(99)))
+            ].joined(separator: "\n")
+        case .counter:
+            return String(format: "ua_performance_metrics_counter".localized(), format(metric, metric.value), metric.count)
+        case .gauge:
+            return String(format: "ua_performance_metrics_gauge".localized(), format(metric, metric.value), format(metric, metric.maxValue))
+        @unknown default:
+            return ""
+        }
+    }
+
+    private func details(_ histogram: UAMetricHistogram) -> String {
+        return [
+            String(format: "ua_performance_metrics_histogram".localized(),
+                   histogram.count,
+                   milliseconds(histogram.average),
+                   milliseconds(histogram.maxValue)),
+            String(format: "ua_performance_metrics_percentiles".localized(),
+                   milliseconds(histogram.percentile(50)),
+                   milliseconds(histogram.percentile(90)),
+                   milliseconds(histogram.percentile(99)))
+        ].joined(separator: "\n")
+    }
+
+    private func format(_ metric: UAMetric, _ value: Double) -> String {
+        if metric.name.hasSuffix("bytes") || metric.name.hasPrefix(UAMetricCoreDataStorePrefix) {
+            return byteFormatter.string(fromByteCount: Int64(value))
+        }
+
+        return String(format: "%.0f", value)
+    }
+
+    private func milliseconds(_ interval: TimeInterval) -> Int {
+        return Int((interval * 1000).rounded())
+    }
+}
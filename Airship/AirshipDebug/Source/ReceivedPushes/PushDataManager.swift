@@ -11,7 +11,7 @@ import Airship
 #endif
 
 protocol PushDataManagerDelegate {
-    func pushAdded()
+    func pushesAdded(count:Int)
 }
 
 class PushDataManager: NSObject {
@@ -32,6 +32,18 @@ class PushDataManager: NSObject {
         }
     }
 
+    // Pushes are inserted on a background context and saved in batches, at most a second apart.
+    private let saveDelay:TimeInterval = 1
+    private let saveBatchSize = 20
+
+    // The default page size for push fetches.
+    private let defaultFetchLimit = 500
+    private let fetchBatchSize = 50
+
+    // Only accessed on the background context's queue
+    private var pendingSaveCount = 0
+    private var saveScheduled = false
+
     var delegate:PushDataManagerDelegate?
 
     static let shared = PushDataManager()
@@ -55,9 +67,17 @@ class PushDataManager: NSObject {
             }
         })
 
+        container.viewContext.automaticallyMergesChangesFromParent = true
+
         return container
     }()
 
+    private lazy var backgroundContext:NSManagedObjectContext = {
+        let context = persistentContainer.newBackgroundContext()
+        context.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy
+        return context
+    }()
+
     override init() {
         super.init()
     }
@@ -76,8 +96,48 @@ class PushDataManager: NSObject {
         }
     }
 
+    // Must be called on the background context's queue
+    private func scheduleSave() {
+        if pendingSaveCount >= saveBatchSize {
+            flushPendingSaves()
+            return
+        }
+
+        guard !saveScheduled else {
+            return
+        }
+
+        saveScheduled = true
+        DispatchQueue.global(qos:.utility).asyncAfter(deadline:.now() + saveDelay) { [weak self] in
+            guard let self = self else {
+                return
+            }
+
+            self.backgroundContext.perform {
+                self.flushPendingSaves()
+            }
+        }
+    }
+
+    // Must be called on the background context's queue
+    private func flushPendingSaves() {
+        saveScheduled = false
+
+        guard pendingSaveCount > 0 else {
+            return
+        }
+
+        let count = pendingSaveCount
+        pendingSaveCount = 0
+        saveContext(backgroundContext)
+
+        DispatchQueue.main.async {
+            self.delegate?.pushesAdded(count:count)
+        }
+    }
+
     private func batchDeletePushNotificationsOlderThanStorageDays() {
-        let context = persistentContainer.viewContext
+        let context = backgroundContext
 
         let startOfTodayDate = Calendar.current.startOfDay(for: Date())
 
@@ -90,53 +150,60 @@ class PushDataManager: NSObject {
         fetchRequest.predicate = NSPredicate(format:"time < %f", storageDaysInterval)
         let batchDeleteRequest = NSBatchDeleteRequest(fetchRequest:fetchRequest)
 
-        do {
-            _ = try context.execute(batchDeleteRequest)
-        } catch {
-            print("Failed to execute request: \(error)")
+        context.perform {
+            do {
+                _ = try context.execute(batchDeleteRequest)
+            } catch {
+                print("Failed to execute request: \(error)")
+            }
         }
     }
 
     public func savePushNotification(_ push:PushNotification) {
-        
-        let context = persistentContainer.viewContext
-        
-        let persistedPush = PushData(entity: PushData.entity(), insertInto:context)
+        let context = backgroundContext
+
+        context.perform {
+            // Unsaved inserts are included in the fetch, so duplicates within a batch are caught too
+            guard !self.somePushExists(id: push.pushID, context:context) else {
+                return
+            }
 
-        if(!somePushExists(id: push.pushID)) {
-            
+            let persistedPush = PushData(entity: PushData.entity(), insertInto:context)
             persistedPush.pushID = push.pushID
             persistedPush.alert = push.alert
             persistedPush.data = push.data
             persistedPush.time = push.time
 
-            saveContext(context)
+            self.pendingSaveCount += 1
+            self.scheduleSave()
         }
     }
-    
-    func somePushExists(id: String) -> Bool {
-        let context = persistentContainer.viewContext
-        let fetchRequest:NSFetchRequest = PushData.fetchRequest()
 
+    private func somePushExists(id: String, context:NSManagedObjectContext) -> Bool {
+        let fetchRequest:NSFetchRequest = PushData.fetchRequest()
         fetchRequest.predicate = NSPredicate(format: "pushID = %@", id)
+        fetchRequest.fetchLimit = 1
 
-        var results: [NSManagedObject] = []
+        var count = 0
 
         do {
-            results = try context.fetch(fetchRequest)
+            count = try context.count(for: fetchRequest)
         }
         catch {
             print("error executing fetch request: \(error)")
         }
 
-        return results.count > 0
+        return count > 0
     }
 
     func fetchAllPushNotifications() -> [PushNotification] {
         return fetchPushesContaining()
     }
     
-    func fetchPushesContaining() -> [PushNotification] {
+    /**
+     * Fetches a page of push notifications, newest first.
+     */
+    func fetchPushesContaining(offset:Int = 0, limit:Int? = nil) -> [PushNotification] {
         var pushDatas:[Any] = []
         var pushes:[PushNotification] = []
 
@@ -145,6 +212,9 @@ class PushDataManager: NSObject {
         let sortDescriptors = [sort]
         let fetchRequest:NSFetchRequest = PushData.fetchRequest()
         fetchRequest.sortDescriptors = sortDescriptors
+        fetchRequest.fetchOffset = offset
+        fetchRequest.fetchLimit = limit ?? defaultFetchLimit
+        fetchRequest.fetchBatchSize = fetchBatchSize
         do {
             pushDatas = try context.fetch(fetchRequest)
         } catch {
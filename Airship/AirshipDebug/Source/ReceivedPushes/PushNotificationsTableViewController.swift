@@ -26,10 +26,10 @@ class PushNotificationsTableViewController:UIViewController, UITableViewDataSour
         var displayPushes = [PushNotification]()
         let currentTimeWindow:TimeWindow = .All
 
-        func pushAdded() {
+        func pushesAdded(count:Int) {
             displayPushes = PushDataManager.shared.fetchPushesContaining()
 
-            totalPushesCount += 1
+            totalPushesCount += count
             tableView.reloadData()
         }
 
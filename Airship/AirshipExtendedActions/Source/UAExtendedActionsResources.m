@@ -5,10 +5,14 @@
 @implementation UAExtendedActionsResources
 
 + (NSBundle *)bundle {
-    NSBundle *bundle = [NSBundle bundleWithPath:[[NSBundle mainBundle] pathForResource:@"Airship_AirshipAutomation"
-                                                                                ofType:@"bundle"]];
+    static NSBundle *bundle;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        bundle = [NSBundle bundleWithPath:[[NSBundle mainBundle] pathForResource:@"Airship_AirshipAutomation" ofType:@"bundle"]];
+        bundle = bundle ? : [NSBundle bundleForClass:[self class]];
+    });
 
-    return bundle ? : [NSBundle bundleForClass:[self class]];
+    return bundle;
 }
 
 @end
@@ -65,6 +65,34 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, assign, getter=isBackgroundLocationUpdatesAllowed) BOOL backgroundLocationUpdatesAllowed;
 
+/**
+ * Minimum distance in meters from the last recorded location for a location update
+ * to generate a location event. Defaults to 100 meters. Set to `0` to disable.
+ */
+@property (nonatomic, assign) CLLocationDistance minimumDisplacement;
+
+/**
+ * Minimum time in seconds since the last recorded location for a location update
+ * to generate a location event. Defaults to 60 seconds. Set to `0` to disable.
+ */
+@property (nonatomic, assign) NSTimeInterval minimumInterval;
+
+/**
+ * Location updates that do not pass the displacement or interval filters still generate
+ * a location event when their horizontal accuracy improves on the last recorded location
+ * by at least this fraction. Defaults to `0.5`. Set to `0` to disable.
+ */
+@property (nonatomic, assign) double accuracyImprovementThreshold;
+
+/**
+ * Flag to enable/disable adaptive sampling. When enabled, updates that stay within their own
+ * accuracy of the last recorded location count as stationary, and each stationary update doubles
+ * the minimum interval, up to 30 minutes, until the device moves. Defaults to `NO`.
+ *
+ * @note Location filtering only applies to location events. Delegates always receive every location update.
+ */
+@property (nonatomic, assign, getter=isAdaptiveSamplingEnabled) BOOL adaptiveSamplingEnabled;
+
 /**
  * UALocationDelegate to receive location callbacks.
  */
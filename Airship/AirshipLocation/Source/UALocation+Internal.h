@@ -34,6 +34,16 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, assign, getter=isLocationUpdatesStarted) BOOL locationUpdatesStarted;
 
+/**
+ * The last location that generated a location event.
+ */
+@property (nonatomic, strong, nullable) CLLocation *lastRecordedLocation;
+
+/**
+ * Number of consecutive stationary updates since the last recorded location.
+ */
+@property (nonatomic, assign) NSUInteger stationaryCount;
+
 /**
  * Location factory method.
  * @param dataStore The data store.
@@ -7,6 +7,14 @@ NSString *const UALocationAutoRequestAuthorizationEnabled = @"UALocationAutoRequ
 NSString *const UALocationUpdatesEnabled = @"UALocationUpdatesEnabled";
 NSString *const UALocationBackgroundUpdatesAllowed = @"UALocationBackgroundUpdatesAllowed";
 
+// Default location event filters
+static CLLocationDistance const UALocationDefaultMinimumDisplacement = 100;
+static NSTimeInterval const UALocationDefaultMinimumInterval = 60;
+static double const UALocationDefaultAccuracyImprovementThreshold = 0.5;
+
+// Adaptive sampling never waits longer than this between location events
+static NSTimeInterval const UALocationAdaptiveMaxInterval = 30 * 60;
+
 @interface UALocation()
 @property (nonatomic, strong) UAAnalytics<UAExtendableAnalyticsHeaders> *analytics;
 @end
@@ -26,6 +34,9 @@ NSString *const UALocationBackgroundUpdatesAllowed = @"UALocationBackgroundUpdat
         self.analytics = analytics;
         self.systemVersion = [UASystemVersion systemVersion];
         self.locationManager.delegate = self;
+        self.minimumDisplacement = UALocationDefaultMinimumDisplacement;
+        self.minimumInterval = UALocationDefaultMinimumInterval;
+        self.accuracyImprovementThreshold = UALocationDefaultAccuracyImprovementThreshold;
 
         NSNotificationCenter *notificationCenter = [NSNotificationCenter defaultCenter];
 
@@ -391,6 +402,13 @@ NSString *const UALocationBackgroundUpdatesAllowed = @"UALocationBackgroundUpdat
         return;
     }
 
+    if (![self shouldRecordLocation:location]) {
+        UA_LTRACE(@"Location %@ filtered, last recorded location: %@", location, self.lastRecordedLocation);
+        return;
+    }
+
+    self.lastRecordedLocation = location;
+
     UALocationInfo *info = [UALocationInfo infoWithLatitude:location.coordinate.latitude
                                                   longitude:location.coordinate.longitude
                                          horizontalAccuracy:location.horizontalAccuracy
@@ -402,6 +420,52 @@ NSString *const UALocationBackgroundUpdatesAllowed = @"UALocationBackgroundUpdat
     [self.analytics addEvent:event];
 }
 
+- (BOOL)shouldRecordLocation:(CLLocation *)location {
+    CLLocation *last = self.lastRecordedLocation;
+    if (!last) {
+        return YES;
+    }
+
+    // Always take a noticeably more accurate fix
+    if (self.accuracyImprovementThreshold > 0 &&
+        location.horizontalAccuracy < last.horizontalAccuracy * (1 - self.accuracyImprovementThreshold)) {
+        self.stationaryCount = 0;
+        return YES;
+    }
+
+    CLLocationDistance distance = [location distanceFromLocation:last];
+
+    // Cell and Wi-Fi fixes jitter within their accuracy while the device is not moving
+    BOOL stationary = self.isAdaptiveSamplingEnabled && distance <= MAX(location.horizontalAccuracy, last.horizontalAccuracy);
+    if (stationary) {
+        self.stationaryCount++;
+    }
+
+    NSTimeInterval elapsed = [location.timestamp timeIntervalSinceDate:last.timestamp];
+    if (elapsed < [self effectiveMinimumInterval]) {
+        return NO;
+    }
+
+    if (stationary || distance < self.minimumDisplacement) {
+        return NO;
+    }
+
+    self.stationaryCount = 0;
+    return YES;
+}
+
+- (NSTimeInterval)effectiveMinimumInterval {
+    if (!self.isAdaptiveSamplingEnabled || !self.stationaryCount) {
+        return self.minimumInterval;
+    }
+
+    NSTimeInterval interval = MAX(self.minimumInterval, UALocationDefaultMinimumInterval);
+    for (NSUInteger i = 0; i < self.stationaryCount && interval < UALocationAdaptiveMaxInterval; i++) {
+        interval *= 2;
+    }
+    return MIN(interval, UALocationAdaptiveMaxInterval);
+}
+
 - (void)locationManager:(CLLocationManager *)manager didFailWithError:(NSError *)error {
     UA_LTRACE(@"Location updates failed with error: %@", error);
 
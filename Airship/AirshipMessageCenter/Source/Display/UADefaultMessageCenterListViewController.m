@@ -1,5 +1,7 @@
 /* Copyright Airship and Contributors */
 
+#import <ImageIO/ImageIO.h>
+
 #import "UADefaultMessageCenterListViewController.h"
 #import "UAMessageCenterListCell.h"
 #import "UAInboxMessage.h"
@@ -17,17 +19,30 @@
 #define kUAPlaceholderIconImage @"ua-inbox-icon-placeholder"
 #define kUAIconImageCacheMaxCount 100
 #define kUAIconImageCacheMaxByteCost (2 * 1024 * 1024) /* 2MB */
+#define kUAIconFetchTimeout 30 /* seconds */
+#define kUAIconDiskCacheDirectory @"com.urbanairship.messagecenter.icons"
+#define kUAIconDiskCacheMaxAge (7 * 24 * 60 * 60) /* 7 days */
 #define kUAMessageCenterListCellNibName @"UAMessageCenterListCell"
 
+/*
+ * Fraction of the displayed rows that can change before the table is reloaded instead of batch updated
+ */
+#define kUAMessageTableBatchUpdateMaxChangeRatio 0.5
+
 NS_ASSUME_NONNULL_BEGIN
 
-@interface UADefaultMessageCenterListViewController()
+@interface UADefaultMessageCenterListViewController() <UITableViewDataSourcePrefetching>
 
 /**
  * The placeholder image to display in lieu of the icon
  */
 @property (nonatomic, strong) UIImage *placeholderIcon;
 
+/**
+ * The list cell nib, loaded from the resource bundle once and instantiated for each new cell.
+ */
+@property (nonatomic, strong) UINib *cellNib;
+
 /**
  * The table view of message list cells
  */
@@ -38,6 +53,16 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, copy) NSArray *messages;
 
+/**
+ * The indexes of the messages in the message table, keyed by message ID.
+ */
+@property (nonatomic, copy) NSDictionary<NSString *, NSNumber *> *messageIndexes;
+
+/**
+ * The messages the message table last loaded, used to batch update the table.
+ */
+@property (nonatomic, copy, nullable) NSArray<UAInboxMessage *> *displayedMessages;
+
 /**
  * The default tint color to use when overriding the inherited tint.
  */
@@ -58,20 +83,46 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong, nullable) NSMutableArray<NSString *> *selectedMessageIDs;
 
 /**
- * A dictionary of sets of (NSIndexPath *) with absolute URLs (NSString *) for keys.
+ * A dictionary of in-flight icon fetch tasks with absolute URLs (NSString *) for keys.
  * Used to track current list icon fetches.
- * Try to use this on the main thread.
+ * Only access this on the main thread.
+ */
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSURLSessionTask *> *currentIconURLRequests;
+
+/**
+ * Icon URLs requested by table view prefetching that should not be cancelled when
+ * their rows are not visible. Only access this on the main thread.
  */
-@property (nonatomic, strong) NSMutableDictionary *currentIconURLRequests;
+@property (nonatomic, strong) NSMutableSet<NSString *> *prefetchedIconURLStrings;
 
 /**
  * An icon cache that stores UIImage representations of fetched icon images
- * The default limit is 1MB or 100 items
- * Images are also stored in the Airship HTTP Cache, so a re-fetch will typically only
- * incur the decoding (PNG->UIImage) costs.
+ * The default limit is 2MB or 100 items
+ * Decoded thumbnails are also stored in the icon disk cache, so a re-fetch will typically only
+ * incur the cost of decoding a cell sized image.
  */
 @property (nonatomic, strong) NSCache *iconCache;
 
+/**
+ * The session used to fetch icons.
+ */
+@property (nonatomic, strong) NSURLSession *iconSession;
+
+/**
+ * The directory for cached icon thumbnails, or nil if unavailable.
+ */
+@property (nonatomic, strong, nullable) NSURL *iconCacheDirectoryURL;
+
+/**
+ * The size of the most recently displayed list icon. Used to size prefetched icons.
+ */
+@property (nonatomic, assign) CGSize iconSize;
+
+/**
+ * Whether a check for icon fetches that are no longer needed is pending.
+ */
+@property (nonatomic, assign) BOOL iconCancellationPending;
+
 /**
  * A refresh control used for "pull to refresh" behavior.
  */
@@ -98,9 +149,18 @@ NS_ASSUME_NONNULL_BEGIN
         self.iconCache.countLimit = kUAIconImageCacheMaxCount;
         self.iconCache.totalCostLimit = kUAIconImageCacheMaxByteCost;
         self.currentIconURLRequests = [NSMutableDictionary dictionary];
+        self.prefetchedIconURLStrings = [NSMutableSet set];
         self.refreshControl = [[UIRefreshControl alloc] init];
         self.iconFetchQueue = dispatch_queue_create("com.urbanairship.messagecenter.ListIconQueue", DISPATCH_QUEUE_CONCURRENT);
 
+        NSURLSessionConfiguration *sessionConfig = [NSURLSessionConfiguration defaultSessionConfiguration];
+        sessionConfig.timeoutIntervalForRequest = kUAIconFetchTimeout;
+        self.iconSession = [NSURLSession sessionWithConfiguration:sessionConfig];
+
+        NSURL *cachesDirectoryURL = [[[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask] firstObject];
+        self.iconCacheDirectoryURL = [cachesDirectoryURL URLByAppendingPathComponent:kUAIconDiskCacheDirectory];
+        [self pruneIconDiskCache];
+
         // grab the default tint color from a dummy view
         self.defaultTintColor = [[UIView alloc] init].tintColor;
     }
@@ -140,6 +200,8 @@ NS_ASSUME_NONNULL_BEGIN
     tableController.refreshControl = self.refreshControl;
     tableController.clearsSelectionOnViewWillAppear = false;
 
+    self.messageTable.prefetchDataSource = self;
+
     [self applyStyle];
 
     // This allows us to use the UITableViewController for managing the refresh control, while keeping the
@@ -151,7 +213,7 @@ NS_ASSUME_NONNULL_BEGIN
 
     // watch for changes to the message list
     [[NSNotificationCenter defaultCenter] addObserver:self
-                                             selector:@selector(messageListUpdated)
+                                             selector:@selector(messageListUpdated:)
                                                  name:UAInboxMessageListUpdatedNotification object:nil];
 }
 
@@ -177,6 +239,7 @@ NS_ASSUME_NONNULL_BEGIN
 
 -(void)dealloc {
     [[NSNotificationCenter defaultCenter] removeObserver:self name:UAInboxMessageListUpdatedNotification object:nil];
+    [self.iconSession invalidateAndCancel];
 }
 
 - (void)didReceiveMemoryWarning {
@@ -233,6 +296,7 @@ NS_ASSUME_NONNULL_BEGIN
     [self applyToolbarItemStyles];
 
     // apply styles to table cells
+    self.displayedMessages = self.messages;
     [self.messageTable reloadData];
 }
 
@@ -303,7 +367,7 @@ NS_ASSUME_NONNULL_BEGIN
 }
 
 - (void)reload {
-    [self.messageTable reloadData];
+    [self reloadMessageTable];
     
     if (self.editing) {
         if (self.selectedMessageIDs.count > 0) {
@@ -331,6 +395,99 @@ NS_ASSUME_NONNULL_BEGIN
     }
 }
 
+/**
+ * Updates the message table to the current messages, animating the inserted, deleted and changed
+ * rows when possible.
+ */
+- (void)reloadMessageTable {
+    NSArray<UAInboxMessage *> *displayedMessages = self.displayedMessages;
+    self.displayedMessages = self.messages;
+
+    // The table must still be showing the previous messages for the row updates to apply
+    if (!displayedMessages || !self.messageTable.window || [self.messageTable numberOfRowsInSection:0] != (NSInteger)displayedMessages.count) {
+        [self.messageTable reloadData];
+        return;
+    }
+
+    if (![self batchUpdateMessageTableFromMessages:displayedMessages]) {
+        [self.messageTable reloadData];
+    }
+}
+
+/**
+ * Batch updates the message table from the previously displayed messages to the current messages.
+ *
+ * @return `NO` if the messages were reordered or too many changed, and the table needs to be reloaded instead.
+ */
+- (BOOL)batchUpdateMessageTableFromMessages:(NSArray<UAInboxMessage *> *)previousMessages {
+    NSDictionary<NSString *, NSNumber *> *indexes = self.messageIndexes;
+
+    NSMutableArray<NSIndexPath *> *deletedIndexPaths = [NSMutableArray array];
+    NSMutableArray<NSIndexPath *> *reloadedIndexPaths = [NSMutableArray array];
+    NSMutableArray<NSString *> *retainedMessageIDs = [NSMutableArray array];
+    NSMutableSet<NSString *> *previousMessageIDs = [NSMutableSet setWithCapacity:previousMessages.count];
+
+    for (NSUInteger row = 0; row < previousMessages.count; row++) {
+        UAInboxMessage *previous = previousMessages[row];
+        [previousMessageIDs addObject:previous.messageID];
+
+        NSNumber *index = indexes[previous.messageID];
+        if (!index) {
+            [deletedIndexPaths addObject:[NSIndexPath indexPathForRow:row inSection:0]];
+            continue;
+        }
+
+        [retainedMessageIDs addObject:previous.messageID];
+        if (![self message:previous isDisplayedEqualToMessage:self.messages[index.unsignedIntegerValue]]) {
+            [reloadedIndexPaths addObject:[NSIndexPath indexPathForRow:row inSection:0]];
+        }
+    }
+
+    NSMutableArray<NSIndexPath *> *insertedIndexPaths = [NSMutableArray array];
+    NSUInteger retainedIndex = 0;
+    for (NSUInteger row = 0; row < self.messages.count; row++) {
+        UAInboxMessage *message = self.messages[row];
+        if (![previousMessageIDs containsObject:message.messageID]) {
+            [insertedIndexPaths addObject:[NSIndexPath indexPathForRow:row inSection:0]];
+        } else if (retainedIndex >= retainedMessageIDs.count || ![retainedMessageIDs[retainedIndex++] isEqualToString:message.messageID]) {
+            // Moved rows are rare enough that a reload is simpler
+            return NO;
+        }
+    }
+
+    if (retainedIndex != retainedMessageIDs.count) {
+        return NO;
+    }
+
+    NSUInteger changes = deletedIndexPaths.count + insertedIndexPaths.count + reloadedIndexPaths.count;
+    if (!changes) {
+        return YES;
+    }
+
+    if (changes > MAX(previousMessages.count, self.messages.count) * kUAMessageTableBatchUpdateMaxChangeRatio) {
+        return NO;
+    }
+
+    [self.messageTable performBatchUpdates:^{
+        [self.messageTable deleteRowsAtIndexPaths:deletedIndexPaths withRowAnimation:UITableViewRowAnimationAutomatic];
+        [self.messageTable reloadRowsAtIndexPaths:reloadedIndexPaths withRowAnimation:UITableViewRowAnimationNone];
+        [self.messageTable insertRowsAtIndexPaths:insertedIndexPaths withRowAnimation:UITableViewRowAnimationAutomatic];
+    } completion:nil];
+
+    return YES;
+}
+
+/**
+ * Checks if two versions of a message display the same in a list cell.
+ */
+- (BOOL)message:(UAInboxMessage *)message isDisplayedEqualToMessage:(UAInboxMessage *)other {
+    return message.unread == other.unread &&
+    (message.title == other.title || [message.title isEqualToString:other.title]) &&
+    (message.messageSent == other.messageSent || [message.messageSent isEqualToDate:other.messageSent]) &&
+    (message.extra == other.extra || [message.extra isEqualToDictionary:other.extra]) &&
+    (message.rawMessageObject == other.rawMessageObject || [message.rawMessageObject isEqualToDictionary:other.rawMessageObject]);
+}
+
 - (void)setSelectedMessageID:(nullable NSString *)selectedMessageID {
     if ([selectedMessageID isEqual:_selectedMessageID]) {
         return;
@@ -581,6 +738,20 @@ NS_ASSUME_NONNULL_BEGIN
 #pragma mark -
 #pragma mark Methods to manage copy of inbox message list
 
+- (void)setMessages:(NSArray *)messages {
+    _messages = [messages copy];
+
+    NSMutableDictionary *indexes = [NSMutableDictionary dictionaryWithCapacity:_messages.count];
+    for (NSUInteger index = 0; index < _messages.count; index++) {
+        UAInboxMessage *message = _messages[index];
+        if (message.messageID && !indexes[message.messageID]) {
+            indexes[message.messageID] = @(index);
+        }
+    }
+
+    self.messageIndexes = indexes;
+}
+
 - (void)copyMessages {
     if (self.filter) {
         self.messages = [NSArray arrayWithArray:[[UAMessageCenter shared].messageList.messages filteredArrayUsingPredicate:self.filter]];
@@ -598,31 +769,21 @@ NS_ASSUME_NONNULL_BEGIN
 }
 
 - (NSUInteger)indexOfMessage:(UAInboxMessage *)messageToFind {
-    if (!messageToFind) {
+    if (!messageToFind.messageID) {
         return NSNotFound;
     }
-    
-    for (NSUInteger index = 0;index<self.messages.count;index++) {
-        UAInboxMessage *message = [self messageAtIndex:index];
-        if ([messageToFind.messageID isEqualToString:message.messageID]) {
-            return index;
-        }
-    }
-    
-    return NSNotFound;
+
+    NSNumber *index = self.messageIndexes[messageToFind.messageID];
+    return index ? index.unsignedIntegerValue : NSNotFound;
 }
 
 - (nullable UAInboxMessage *)messageForID:(NSString *)messageIDToFind {
     if (!messageIDToFind) {
         return nil;
-    } else {
-        for (UAInboxMessage *message in self.messages) {
-            if ([messageIDToFind isEqualToString:message.messageID]) {
-                return message;
-            }
-        }
-        return nil;
     }
+
+    NSNumber *index = self.messageIndexes[messageIDToFind];
+    return index ? [self messageAtIndex:index.unsignedIntegerValue] : nil;
 }
 
 - (void)deleteMessageAtIndexPath:(NSIndexPath *)indexPath {
@@ -653,18 +814,24 @@ NS_ASSUME_NONNULL_BEGIN
     return _placeholderIcon;
 }
 
+- (UINib *)cellNib {
+    if (!_cellNib) {
+        _cellNib = [UINib nibWithNibName:kUAMessageCenterListCellNibName bundle:[UAMessageCenterResources bundle]];
+    }
+    return _cellNib;
+}
+
 #pragma mark -
 #pragma mark UITableViewDataSource
 
 - (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath {
 
     NSString *nibName = kUAMessageCenterListCellNibName;
-    NSBundle *bundle = [UAMessageCenterResources bundle];
 
     UAMessageCenterListCell *cell = (UAMessageCenterListCell *)[tableView dequeueReusableCellWithIdentifier:nibName];
 
     if (!cell) {
-        cell = [[bundle loadNibNamed:nibName owner:nil options:nil] firstObject];
+        cell = [[self.cellNib instantiateWithOwner:nil options:nil] firstObject];
     }
 
     cell.messageCenterStyle = self.messageCenterStyle;
@@ -672,6 +839,7 @@ NS_ASSUME_NONNULL_BEGIN
     [cell setData:message];
 
     UIImageView *localImageView = cell.listIconView;
+    self.iconSize = localImageView.frame.size;
 
     if ([self.iconCache objectForKey:[self iconURLStringForMessage:message]]) {
         localImageView.image = [self.iconCache objectForKey:[self iconURLStringForMessage:message]];
@@ -762,10 +930,52 @@ NS_ASSUME_NONNULL_BEGIN
     }
 }
 
+- (void)tableView:(UITableView *)tableView didEndDisplayingCell:(UITableViewCell *)cell forRowAtIndexPath:(NSIndexPath *)indexPath {
+    [self cancelUnneededIconRetrievals];
+}
+
+#pragma mark -
+#pragma mark UITableViewDataSourcePrefetching
+
+- (void)tableView:(UITableView *)tableView prefetchRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths {
+    if (self.iconSize.width <= 0 || self.iconSize.height <= 0) {
+        // No cell has been laid out yet, so the icon size is unknown
+        return;
+    }
+
+    for (NSIndexPath *indexPath in indexPaths) {
+        NSString *iconListURLString = [self iconURLStringForMessage:[self messageAtIndex:indexPath.row]];
+        if (iconListURLString && ![self.iconCache objectForKey:iconListURLString]) {
+            [self.prefetchedIconURLStrings addObject:iconListURLString];
+            [self retrieveIconForIndexPath:indexPath iconSize:self.iconSize];
+        }
+    }
+}
+
+- (void)tableView:(UITableView *)tableView cancelPrefetchingForRowsAtIndexPaths:(NSArray<NSIndexPath *> *)indexPaths {
+    for (NSIndexPath *indexPath in indexPaths) {
+        NSString *iconListURLString = [self iconURLStringForMessage:[self messageAtIndex:indexPath.row]];
+        if (iconListURLString) {
+            [self.prefetchedIconURLStrings removeObject:iconListURLString];
+        }
+    }
+
+    [self cancelUnneededIconRetrievals];
+}
+
 #pragma mark -
 #pragma mark NSNotificationCenter callbacks
 
-- (void)messageListUpdated {
+- (void)messageListUpdated:(NSNotification *)notification {
+    // Nothing to update if the message list reports that no messages changed
+    NSDictionary *changes = notification.userInfo;
+    if (changes[UAInboxMessageListInsertedMessageIDsKey] &&
+        ![changes[UAInboxMessageListInsertedMessageIDsKey] count] &&
+        ![changes[UAInboxMessageListRemovedMessageIDsKey] count] &&
+        ![changes[UAInboxMessageListUpdatedMessageIDsKey] count]) {
+        return;
+    }
+
     // copy the back-end list of messages as it can change from under the UI
     [self copyMessages];
 
@@ -810,37 +1020,112 @@ NS_ASSUME_NONNULL_BEGIN
 #pragma mark - List Icon Load + Fetch
 
 /**
- * Scales a source image to the provided size.
+ * Decodes image data to a thumbnail that fills the provided size, without decoding the
+ * source image at full size.
  */
-- (UIImage *)scaleImage:(UIImage *)source toSize:(CGSize)size {
+- (nullable UIImage *)thumbnailWithData:(NSData *)data iconSize:(CGSize)iconSize scale:(CGFloat)scale {
+    CGImageSourceRef source = CGImageSourceCreateWithData((__bridge CFDataRef)data, (__bridge CFDictionaryRef)@{ (id)kCGImageSourceShouldCache : @NO });
+    if (!source) {
+        return nil;
+    }
+
+    NSDictionary *properties = CFBridgingRelease(CGImageSourceCopyPropertiesAtIndex(source, 0, NULL));
+    CGFloat sourceWidth = [properties[(id)kCGImagePropertyPixelWidth] doubleValue];
+    CGFloat sourceHeight = [properties[(id)kCGImagePropertyPixelHeight] doubleValue];
+
+    // Orientations 5-8 are rotated by 90 degrees
+    if ([properties[(id)kCGImagePropertyOrientation] integerValue] > 4) {
+        CGFloat width = sourceWidth;
+        sourceWidth = sourceHeight;
+        sourceHeight = width;
+    }
+
+    if (sourceWidth <= 0 || sourceHeight <= 0) {
+        CFRelease(source);
+        return nil;
+    }
+
+    // Scale the shorter side to fill the icon, never scaling up
+    CGFloat scaleFactor = 1;
+    if (iconSize.width > 0 && iconSize.height > 0) {
+        CGFloat widthFactor = iconSize.width * scale / sourceWidth;
+        CGFloat heightFactor = iconSize.height * scale / sourceHeight;
+        scaleFactor = MIN(1, MAX(widthFactor, heightFactor));
+    }
+
+    NSDictionary *options = @{ (id)kCGImageSourceCreateThumbnailFromImageAlways : @YES,
+                               (id)kCGImageSourceCreateThumbnailWithTransform : @YES,
+                               (id)kCGImageSourceShouldCacheImmediately : @YES,
+                               (id)kCGImageSourceThumbnailMaxPixelSize : @(ceil(MAX(sourceWidth, sourceHeight) * scaleFactor)) };
+
+    CGImageRef imageRef = CGImageSourceCreateThumbnailAtIndex(source, 0, (__bridge CFDictionaryRef)options);
+    CFRelease(source);
 
-    CGFloat sourceWidth = source.size.width;
-    CGFloat sourceHeight = source.size.height;
+    if (!imageRef) {
+        return nil;
+    }
 
-    CGFloat widthFactor = size.width / sourceWidth;
-    CGFloat heightFactor = size.height / sourceHeight;
-    CGFloat maxFactor = MAX(widthFactor, heightFactor);
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:scale orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
 
-    CGFloat scaledWidth = truncf(sourceWidth * maxFactor);
-    CGFloat scaledHeight = truncf(sourceHeight * maxFactor);
+    return image;
+}
 
-    CGAffineTransform transform = CGAffineTransformMakeScale(maxFactor, maxFactor);
-    CGSize transformSize = CGSizeApplyAffineTransform(source.size, transform);
+/**
+ * Reads a cached thumbnail from disk, decoding it before it is returned.
+ */
+- (nullable UIImage *)cachedThumbnailAtURL:(NSURL *)fileURL scale:(CGFloat)scale {
+    CGImageSourceRef source = CGImageSourceCreateWithURL((__bridge CFURLRef)fileURL, NULL);
+    if (!source) {
+        return nil;
+    }
 
-    // Note: passing 0.0 causes the function below to use the scale factor of the main screen
-    CGFloat transformScaleFactor = 0.0;
+    CGImageRef imageRef = CGImageSourceCreateImageAtIndex(source, 0, (__bridge CFDictionaryRef)@{ (id)kCGImageSourceShouldCacheImmediately : @YES });
+    CFRelease(source);
 
-    UIGraphicsBeginImageContextWithOptions(transformSize, NO, transformScaleFactor);
+    if (!imageRef) {
+        return nil;
+    }
 
-    CGContextRef context = UIGraphicsGetCurrentContext();
-    CGContextSetInterpolationQuality(context, kCGInterpolationHigh);
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:scale orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
 
-    [source drawInRect:CGRectMake(0, 0, scaledWidth, scaledHeight)];
-    UIImage* scaledImage = UIGraphicsGetImageFromCurrentImageContext();
+    return image;
+}
 
-    UIGraphicsEndImageContext();
+/**
+ * Returns the disk cache location for an icon thumbnail of the given pixel size.
+ */
+- (nullable NSURL *)iconCacheURLForURLString:(NSString *)URLString iconSize:(CGSize)iconSize scale:(CGFloat)scale {
+    NSString *key = [NSString stringWithFormat:@"%@@%.0fx%.0f", URLString, iconSize.width * scale, iconSize.height * scale];
+    return [self.iconCacheDirectoryURL URLByAppendingPathComponent:[UAUtils sha256HashWithString:key]];
+}
+
+/**
+ * Removes cached icon thumbnails older than the maximum disk cache age.
+ */
+- (void)pruneIconDiskCache {
+    NSURL *directoryURL = self.iconCacheDirectoryURL;
+    if (!directoryURL) {
+        return;
+    }
 
-    return scaledImage;
+    dispatch_async(self.iconFetchQueue, ^{
+        NSFileManager *fileManager = [NSFileManager defaultManager];
+        NSArray<NSURL *> *fileURLs = [fileManager contentsOfDirectoryAtURL:directoryURL
+                                                includingPropertiesForKeys:@[NSURLContentModificationDateKey]
+                                                                   options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                                     error:nil];
+
+        NSDate *expiry = [NSDate dateWithTimeIntervalSinceNow:-kUAIconDiskCacheMaxAge];
+        for (NSURL *fileURL in fileURLs) {
+            NSDate *modified;
+            [fileURL getResourceValue:&modified forKey:NSURLContentModificationDateKey error:nil];
+            if (!modified || [modified compare:expiry] == NSOrderedAscending) {
+                [fileManager removeItemAtURL:fileURL error:nil];
+            }
+        }
+    });
 }
 
 /**
@@ -857,63 +1142,135 @@ NS_ASSUME_NONNULL_BEGIN
         return;
     }
 
-    // If the icon isn't already in the cache
-    if (![self.iconCache objectForKey:iconListURLString]) {
+    // If the icon is already in the cache or being requested, there is nothing to do
+    // NOTE: All add/remove operations on the cache & in-progress requests should be done
+    // on the main thread.
+    if ([self.iconCache objectForKey:iconListURLString] || self.currentIconURLRequests[iconListURLString]) {
+        return;
+    }
 
-        NSURL *iconListURL = [NSURL URLWithString:iconListURLString];
+    NSURL *iconListURL = [NSURL URLWithString:iconListURLString];
+    if (!iconListURL) {
+        return;
+    }
+
+    CGFloat scale = [UIScreen mainScreen].scale;
+    NSURL *cacheURL = [self iconCacheURLForURLString:iconListURLString iconSize:iconSize scale:scale];
 
-        // NOTE: All add/remove operations on the cache & in-progress set should be done
-        // on the main thread. They'll be cleared below in a dispatch_async/main queue block.
+    UA_WEAKIFY(self)
 
-        // Next, check to see if we're currently requesting the icon
-        // Add the index path to the set of paths to update when a request is completed and then proceed if necessary
-        NSMutableSet *currentRequestedIndexPaths = [self.currentIconURLRequests objectForKey:iconListURLString];
-        if (currentRequestedIndexPaths.count) {
-            [currentRequestedIndexPaths addObject:indexPath];
-            // Wait for the in-flight request to finish
+    // The fetch is created up front so it can be cancelled while the disk cache is checked
+    __block NSURLSessionTask *task = [self.iconSession dataTaskWithURL:iconListURL completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+        UA_STRONGIFY(self)
+
+        NSInteger status = [response isKindOfClass:[NSHTTPURLResponse class]] ? ((NSHTTPURLResponse *)response).statusCode : 200;
+        if (error || !data || status < 200 || status > 299) {
+            if (error.code != NSURLErrorCancelled) {
+                UA_LDEBUG(@"Failed to fetch icon %@: %@", iconListURLString, error);
+            }
+            [self finishIconRetrieval:task URLString:iconListURLString image:nil];
             return;
-        } else {
-            // No in-flight request. Add and continue.
-            [self.currentIconURLRequests setValue:[NSMutableSet setWithObject:indexPath] forKey:iconListURLString];
         }
 
-        UA_WEAKIFY(self)
-
         dispatch_async(self.iconFetchQueue, ^{
             UA_STRONGIFY(self)
+            UIImage *iconImage = [self thumbnailWithData:data iconSize:iconSize scale:scale];
+
+            if (iconImage && cacheURL) {
+                [[NSFileManager defaultManager] createDirectoryAtURL:self.iconCacheDirectoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+                [UIImagePNGRepresentation(iconImage) writeToURL:cacheURL atomically:YES];
+            }
+
+            [self finishIconRetrieval:task URLString:iconListURLString image:iconImage];
+        });
+    }];
 
+    self.currentIconURLRequests[iconListURLString] = task;
+
+    dispatch_async(self.iconFetchQueue, ^{
+        UA_STRONGIFY(self)
+
+        UIImage *cachedImage = cacheURL ? [self cachedThumbnailAtURL:cacheURL scale:scale] : nil;
+        if (cachedImage) {
+            UA_LTRACE(@"Loaded RP Icon from disk cache: %@", iconListURLString);
+            [[UAMetricsRegistry shared] incrementCounter:UAMetricMessageCenterIconCacheLoads by:1];
+            [task cancel];
+            [self finishIconRetrieval:task URLString:iconListURLString image:cachedImage];
+        } else {
             UA_LTRACE(@"Fetching RP Icon: %@", iconListURLString);
+            [[UAMetricsRegistry shared] incrementCounter:UAMetricMessageCenterIconFetches by:1];
+            [task resume];
+        }
+    });
+}
 
-            // Note: this decodes the source image at full size
-            NSData *iconImageData = [NSData dataWithContentsOfURL:iconListURL];
-            UIImage *iconImage = [UIImage imageWithData:iconImageData];
-            iconImage = [self scaleImage:iconImage toSize:iconSize];
+/**
+ * Caches a retrieved icon and updates the visible cells that display it.
+ */
+- (void)finishIconRetrieval:(NSURLSessionTask *)task URLString:(NSString *)iconListURLString image:(nullable UIImage *)iconImage {
+    UA_WEAKIFY(self)
+    [[UADispatcher mainDispatcher] dispatchAsync:^{
+        UA_STRONGIFY(self)
 
-           [[UADispatcher mainDispatcher] dispatchAsync:^{
-                // Recapture self for the duration of this block
-                UA_STRONGIFY(self)
+        // Ignore a request that has already been finished or replaced
+        if (self.currentIconURLRequests[iconListURLString] != task) {
+            return;
+        }
 
-                // Place the icon image in the cache and reload the row
-                if (iconImage) {
+        // Clear the request marker
+        [self.currentIconURLRequests removeObjectForKey:iconListURLString];
+        [self.prefetchedIconURLStrings removeObject:iconListURLString];
 
-                    NSUInteger sizeInBytes = CGImageGetHeight(iconImage.CGImage) * CGImageGetBytesPerRow(iconImage.CGImage);
+        if (!iconImage) {
+            return;
+        }
 
-                    [self.iconCache setObject:iconImage forKey:iconListURLString];
-                    UA_LTRACE(@"Added image to cache (%@) with size in bytes: %lu", iconListURL, (unsigned long)sizeInBytes);
+        NSUInteger sizeInBytes = CGImageGetHeight(iconImage.CGImage) * CGImageGetBytesPerRow(iconImage.CGImage);
+        [self.iconCache setObject:iconImage forKey:iconListURLString cost:sizeInBytes];
+        UA_LTRACE(@"Added image to cache (%@) with size in bytes: %lu", iconListURLString, (unsigned long)sizeInBytes);
 
-                    // Update cells directly rather than forcing a reload (which deselects)
-                    UAMessageCenterListCell *cell;
-                    for (NSIndexPath *indexPath in (NSSet *)[self.currentIconURLRequests objectForKey:iconListURLString]) {
-                        cell = (UAMessageCenterListCell *)[self.messageTable cellForRowAtIndexPath:indexPath];
-                        cell.listIconView.image = iconImage;
-                    }
-                }
-                
-                // Clear the request marker
-                [self.currentIconURLRequests removeObjectForKey:iconListURLString];
-           }];
-        });
+        // Update cells directly rather than forcing a reload (which deselects)
+        for (NSIndexPath *indexPath in self.messageTable.indexPathsForVisibleRows) {
+            if ([[self iconURLStringForMessage:[self messageAtIndex:indexPath.row]] isEqualToString:iconListURLString]) {
+                UAMessageCenterListCell *cell = (UAMessageCenterListCell *)[self.messageTable cellForRowAtIndexPath:indexPath];
+                cell.listIconView.image = iconImage;
+            }
+        }
+    }];
+}
+
+/**
+ * Cancels icon fetches that are neither visible nor prefetched. The check is deferred so
+ * that rows redisplayed by a reload keep their in-flight fetches.
+ */
+- (void)cancelUnneededIconRetrievals {
+    if (self.iconCancellationPending) {
+        return;
     }
+
+    self.iconCancellationPending = YES;
+
+    UA_WEAKIFY(self)
+    [[UADispatcher mainDispatcher] dispatchAsync:^{
+        UA_STRONGIFY(self)
+        self.iconCancellationPending = NO;
+
+        NSMutableSet<NSString *> *neededURLStrings = [self.prefetchedIconURLStrings mutableCopy];
+        for (NSIndexPath *indexPath in self.messageTable.indexPathsForVisibleRows) {
+            NSString *iconListURLString = [self iconURLStringForMessage:[self messageAtIndex:indexPath.row]];
+            if (iconListURLString) {
+                [neededURLStrings addObject:iconListURLString];
+            }
+        }
+
+        for (NSString *iconListURLString in self.currentIconURLRequests.allKeys) {
+            if (![neededURLStrings containsObject:iconListURLString]) {
+                UA_LTRACE(@"Cancelling RP Icon fetch: %@", iconListURLString);
+                [self.currentIconURLRequests[iconListURLString] cancel];
+                [self.currentIconURLRequests removeObjectForKey:iconListURLString];
+            }
+        }
+    }];
 }
 
 /**
@@ -5,7 +5,7 @@
 #import "UADefaultMessageCenterMessageViewController.h"
 #import "UAMessageCenterNativeBridgeExtension.h"
 #import "UAMessageCenter.h"
-#import "UAInboxMessageList.h"
+#import "UAInboxMessageList+Internal.h"
 #import "UAInboxMessage.h"
 #import "UAInboxUtils.h"
 #import "UAMessageCenterLocalization.h"
@@ -342,7 +342,51 @@ typedef enum MessageState {
 
 - (void)loadMessageIntoWebView {
     self.title = self.message.title;
-    
+
+    UAInboxMessage *message = self.message;
+
+    // Load the user data up front so the native bridge can extend the JS environment without blocking
+    UA_WEAKIFY(self)
+    [self.nativeBridgeExtension loadUserDataWithCompletionHandler:^{
+        UA_STRONGIFY(self)
+        if (self.message == message) {
+            [self loadMessageBody];
+        }
+    }];
+}
+
+- (void)loadMessageBody {
+    UAInboxMessageList *messageList = [UAMessageCenter shared].messageList;
+    if (!messageList.messageBodyPrefetchEnabled) {
+        [self loadMessageBodyFromNetwork];
+        return;
+    }
+
+    UAInboxMessage *message = self.message;
+
+    UA_WEAKIFY(self)
+    [messageList.bodyCache cachedBodyForMessage:message completionHandler:^(NSCachedURLResponse *cachedResponse) {
+        UA_STRONGIFY(self)
+        if (self.message != message) {
+            return;
+        }
+
+        if (!cachedResponse) {
+            [self loadMessageBodyFromNetwork];
+            return;
+        }
+
+        // Use the body URL as the base URL so relative resources and the native bridge behave
+        // the same as a network load
+        UA_LTRACE(@"Loading message %@ from the message body cache", message.messageID);
+        [self.webView loadData:cachedResponse.data
+                      MIMEType:cachedResponse.response.MIMEType ?: @"text/html"
+         characterEncodingName:cachedResponse.response.textEncodingName ?: @"utf-8"
+                       baseURL:message.messageBodyURL];
+    }];
+}
+
+- (void)loadMessageBodyFromNetwork {
     NSMutableURLRequest *requestObj = [NSMutableURLRequest requestWithURL:self.message.messageBodyURL];
     requestObj.timeoutInterval = 60;
 
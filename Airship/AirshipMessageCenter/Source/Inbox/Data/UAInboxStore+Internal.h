@@ -2,6 +2,7 @@
 
 #import <Foundation/Foundation.h>
 #import "UAInboxMessageData+Internal.h"
+#import "UAInboxMessageListResponse+Internal.h"
 
 #import "UAAirshipMessageCenterCoreImport.h"
 
@@ -61,6 +62,41 @@ NS_ASSUME_NONNULL_BEGIN
 - (void)syncMessagesWithResponse:(NSArray *)messages
                completionHandler:(void(^)(BOOL))completionHandler;
 
+/**
+ * Updates the inbox store with a message list response. Messages are parsed and saved a chunk
+ * at a time, so memory stays bounded regardless of the size of the inbox.
+ *
+ * @param response The message list response.
+ * @param completionHandler The completion handler with the sync result.
+ */
+- (void)syncMessagesWithMessageListResponse:(UAInboxMessageListResponse *)response
+                          completionHandler:(void(^)(BOOL))completionHandler;
+
+/**
+ * Deletes messages that expired before the given date, including messages pending a delete
+ * on the server.
+ *
+ * @param date The date.
+ * @param completionHandler The completion handler with the number of deleted messages.
+ */
+- (void)deleteMessagesExpiredBeforeDate:(NSDate *)date
+                      completionHandler:(void(^)(NSUInteger))completionHandler;
+
+/**
+ * Rebuilds the database file to reclaim the space left by deleted messages. Does nothing
+ * for in-memory stores.
+ *
+ * @param completionHandler The completion handler with the vacuum result.
+ */
+- (void)vacuumWithCompletionHandler:(void(^)(BOOL))completionHandler;
+
+/**
+ * Gets the size of the database files on disk, including the write-ahead log.
+ *
+ * @param completionHandler The completion handler with the size in bytes. The size is `0`
+ * for in-memory stores.
+ */
+- (void)storeSizeWithCompletionHandler:(void(^)(NSUInteger))completionHandler;
 
 /**
  * Waits for the store to become idle and then returns. Used by Unit Tests.
@@ -12,8 +12,35 @@
 @property (strong, nonatomic) NSManagedObjectContext *managedContext;
 @property (nonatomic, assign) BOOL inMemory;
 @property (nonatomic, assign) BOOL finished;
+
+/**
+ * Whether the legacy database relocation ran. Only accessed on the managed context's queue.
+ */
+@property (nonatomic, assign) BOOL databaseRelocated;
+
+/**
+ * The legacy store file, if the relocation could not move it. Only accessed on the managed
+ * context's queue.
+ */
+@property (nonatomic, strong, nullable) NSURL *legacyStoreURL;
 @end
 
+/**
+ * Sets a managed object value only if it differs from the current value. Assigning an equal
+ * value still marks the object as updated.
+ */
+static void UAInboxStoreSetValue(NSManagedObject *object, NSString *key, id _Nullable value) {
+    id current = [object valueForKey:key];
+    if (current == value || [current isEqual:value]) {
+        return;
+    }
+
+    [object setValue:value forKey:key];
+}
+
+// Number of messages parsed and saved at a time when syncing the message list
+static NSUInteger const UAInboxStoreSyncChunkSize = 50;
+
 @implementation UAInboxStore
 
 
@@ -27,22 +54,22 @@
         self.finished = NO;
 
         NSURL *modelURL = [[UAMessageCenterResources bundle] URLForResource:@"UAInbox" withExtension:@"momd"];
-        self.managedContext = [NSManagedObjectContext managedObjectContextForModelURL:modelURL
-                                                                      concurrencyType:NSPrivateQueueConcurrencyType];
 
-        
         UA_WEAKIFY(self);
-        [self.managedContext performBlock:^{
+        self.managedContext = [NSManagedObjectContext lazyManagedObjectContextForModelURL:modelURL
+                                                                              storeLoader:^(NSManagedObjectContext *context) {
             UA_STRONGIFY(self)
-            [self moveDatabase];
+            [self addStoresToContext:context];
         }];
 
-        [self addStores];
-
-        [[NSNotificationCenter defaultCenter] addObserver:self
-                                                 selector:@selector(protectedDataAvailable)
-                                                     name:UIApplicationProtectedDataDidBecomeAvailable
-                                                   object:nil];
+        // Relocate ahead of the first fetch. Blocks on the context's queue run in order, so
+        // the store is never opened mid-move.
+        if (!inMemory) {
+            [self.managedContext performBlock:^{
+                UA_STRONGIFY(self)
+                [self relocateDatabaseIfNeeded];
+            }];
+        }
     }
 
     return self;
@@ -56,24 +83,36 @@
     return [UAInboxStore storeWithName:storeName inMemory:NO];
 }
 
-- (void) addStores {
-    void (^completion)(NSPersistentStore *, NSError*) = ^void(NSPersistentStore *store, NSError *error) {
-        if (!store) {
-            UA_LERR(@"Failed to create inbox message persistent store: %@", error);
-        }
-    };
+- (void)addStoresToContext:(NSManagedObjectContext *)context {
+    [self relocateDatabaseIfNeeded];
+    [self addStoreToContext:context options:nil];
+}
+
+- (nullable NSPersistentStore *)addStoreToContext:(NSManagedObjectContext *)context options:(nullable NSDictionary *)options {
+    NSError *error = nil;
+    NSPersistentStore *store;
 
     if (self.inMemory) {
-        [self.managedContext addPersistentInMemoryStore:self.storeName completionHandler:completion];
+        store = [context addPersistentInMemoryStore:self.storeName error:&error];
+    } else if (self.legacyStoreURL) {
+        // Keep serving the legacy store until it can be moved on a later launch
+        NSMutableDictionary *storeOptions = [NSMutableDictionary dictionaryWithDictionary:options ?: @{}];
+        storeOptions[NSMigratePersistentStoresAutomaticallyOption] = @YES;
+        storeOptions[NSInferMappingModelAutomaticallyOption] = @YES;
+        store = [context.persistentStoreCoordinator addPersistentStoreWithType:NSSQLiteStoreType
+                                                                 configuration:nil
+                                                                           URL:self.legacyStoreURL
+                                                                       options:storeOptions
+                                                                         error:&error];
     } else {
-        [self.managedContext addPersistentSqlStore:self.storeName completionHandler:completion];
+        store = [context addPersistentSqlStore:self.storeName options:options error:&error];
     }
-}
 
-- (void)protectedDataAvailable {
-    if (!self.managedContext.persistentStoreCoordinator.persistentStores.count) {
-        [self addStores];
+    if (!store) {
+        UA_LERR(@"Failed to create inbox message persistent store: %@", error);
     }
+
+    return store;
 }
 
 - (void)fetchMessagesWithPredicate:(NSPredicate *)predicate
@@ -109,6 +148,28 @@
 }
 
 - (void)syncMessagesWithResponse:(NSArray *)messages completionHandler:(void(^)(BOOL))completionHandler {
+    [self syncMessagesWithChunks:^(void (^processChunk)(NSArray *)) {
+        for (NSUInteger start = 0; start < messages.count; start += UAInboxStoreSyncChunkSize) {
+            NSUInteger length = MIN(UAInboxStoreSyncChunkSize, messages.count - start);
+            processChunk([messages subarrayWithRange:NSMakeRange(start, length)]);
+        }
+    } completionHandler:completionHandler];
+}
+
+- (void)syncMessagesWithMessageListResponse:(UAInboxMessageListResponse *)response
+                          completionHandler:(void(^)(BOOL))completionHandler {
+    [self syncMessagesWithChunks:^(void (^processChunk)(NSArray *)) {
+        [response enumerateMessagesWithChunkSize:UAInboxStoreSyncChunkSize usingBlock:processChunk];
+    } completionHandler:completionHandler];
+}
+
+/**
+ * Syncs the store with the messages handed to the process block a chunk at a time. Only the
+ * stored messages of the current chunk are fetched, and they are saved and turned back into
+ * faults before the next chunk, so neither the response nor the store is ever fully in memory.
+ */
+- (void)syncMessagesWithChunks:(void (^)(void (^processChunk)(NSArray *messages)))chunks
+             completionHandler:(void(^)(BOOL))completionHandler {
     [self safePerformBlock:^(BOOL isSafe) {
         if (!isSafe) {
             completionHandler(NO);
@@ -118,39 +179,177 @@
         // Track the response messageIDs so we can remove any messages that are
         // no longer in the response.
         NSMutableSet *newMessageIDs = [NSMutableSet set];
+        __block BOOL success = YES;
+
+        chunks(^(NSArray *messages) {
+            @autoreleasepool {
+                NSMutableArray<NSDictionary *> *payloads = [NSMutableArray arrayWithCapacity:messages.count];
+                NSMutableArray<NSString *> *messageIDs = [NSMutableArray arrayWithCapacity:messages.count];
+
+                for (NSDictionary *messagePayload in messages) {
+                    NSString *messageID = [messagePayload isKindOfClass:[NSDictionary class]] ? messagePayload[@"message_id"] : nil;
+
+                    if (!messageID) {
+                        UA_LDEBUG(@"Missing message ID: %@", messagePayload);
+                        continue;
+                    }
+
+                    [payloads addObject:messagePayload];
+                    [messageIDs addObject:messageID];
+                }
+
+                if (!payloads.count) {
+                    return;
+                }
+
+                // Fetch the stored messages of the chunk once and index them by message ID
+                NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:kUAInboxDBEntityName];
+                request.predicate = [NSPredicate predicateWithFormat:@"messageID IN %@", messageIDs];
+                request.returnsObjectsAsFaults = NO;
+
+                NSError *error;
+                NSArray<UAInboxMessageData *> *storedMessages = [self.managedContext executeFetchRequest:request error:&error];
+                if (error) {
+                    UA_LERR(@"Fetch request %@ failed with with error: %@", request, error);
+                }
+
+                NSMutableDictionary<NSString *, UAInboxMessageData *> *storedMessagesByID = [NSMutableDictionary dictionaryWithCapacity:storedMessages.count];
+                for (UAInboxMessageData *data in storedMessages) {
+                    storedMessagesByID[data.messageID] = data;
+                }
+
+                for (NSUInteger i = 0; i < payloads.count; i++) {
+                    UAInboxMessageData *data = storedMessagesByID[messageIDs[i]];
+                    if (data) {
+                        [self updateMessageData:data withDictionary:payloads[i]];
+                    } else {
+                        [self addMessageFromDictionary:payloads[i]];
+                    }
+                }
+
+                [newMessageIDs addObjectsFromArray:messageIDs];
+
+                if (![self.managedContext safeSave]) {
+                    success = NO;
+                }
+
+                for (UAInboxMessageData *data in storedMessages) {
+                    [self.managedContext refreshObject:data mergeChanges:NO];
+                }
+            }
+        });
 
-        for (NSDictionary *messagePayload in messages) {
-            NSString *messageID = messagePayload[@"message_id"];
+        // Delete any messages that are no longer in the response
+        NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:kUAInboxDBEntityName];
+        request.predicate = [NSPredicate predicateWithFormat:@"messageID == nil OR NOT (messageID IN %@)", newMessageIDs];
+        request.includesPropertyValues = NO;
 
-            if (!messageID) {
-                UA_LDEBUG(@"Missing message ID: %@", messagePayload);
-                continue;
-            }
+        NSError *error;
+        NSArray<UAInboxMessageData *> *removedMessages = [self.managedContext executeFetchRequest:request error:&error];
+        if (error) {
+            UA_LERR(@"Fetch request %@ failed with with error: %@", request, error);
+        }
 
-            if (![self updateMessageWithDictionary:messagePayload]) {
-                [self addMessageFromDictionary:messagePayload];
-            }
+        for (UAInboxMessageData *data in removedMessages) {
+            [self.managedContext deleteObject:data];
+        }
 
-            [newMessageIDs addObject:messageID];
+        if (![self.managedContext safeSave]) {
+            success = NO;
+        }
+
+        completionHandler(success);
+    }];
+}
+
+- (void)deleteMessagesExpiredBeforeDate:(NSDate *)date completionHandler:(void(^)(NSUInteger))completionHandler {
+    [self safePerformBlock:^(BOOL isSafe) {
+        if (!isSafe) {
+            completionHandler(0);
+            return;
         }
 
-        // Delete any messages that are no longer in the array
         NSFetchRequest *request = [NSFetchRequest fetchRequestWithEntityName:kUAInboxDBEntityName];
-        request.predicate = [NSPredicate predicateWithFormat:@"NOT (messageID IN %@)", newMessageIDs];
+        request.predicate = [NSPredicate predicateWithFormat:@"messageExpiration != nil && messageExpiration < %@", date];
 
         NSError *error;
+        NSUInteger deleted = 0;
+
         if (self.inMemory) {
+            // Batch deletes are only supported by SQLite stores
             request.includesPropertyValues = NO;
-            NSArray *events = [self.managedContext executeFetchRequest:request error:&error];
-            for (NSManagedObject *event in events) {
-                [self.managedContext deleteObject:event];
+            NSArray<UAInboxMessageData *> *expired = [self.managedContext executeFetchRequest:request error:&error];
+            for (UAInboxMessageData *data in expired) {
+                [self.managedContext deleteObject:data];
             }
+
+            deleted = [self.managedContext safeSave] ? expired.count : 0;
         } else {
             NSBatchDeleteRequest *deleteRequest = [[NSBatchDeleteRequest alloc] initWithFetchRequest:request];
-            [self.managedContext executeRequest:deleteRequest error:&error];
+            deleteRequest.resultType = NSBatchDeleteResultTypeObjectIDs;
+
+            NSBatchDeleteResult *result = [self.managedContext executeRequest:deleteRequest error:&error];
+            NSArray<NSManagedObjectID *> *objectIDs = result.result;
+            if (objectIDs.count) {
+                // Batch deletes bypass the context, so drop any registered objects
+                [NSManagedObjectContext mergeChangesFromRemoteContextSave:@{ NSDeletedObjectsKey: objectIDs }
+                                                             intoContexts:@[self.managedContext]];
+            }
+
+            deleted = objectIDs.count;
+        }
+
+        if (error) {
+            UA_LERR(@"Error deleting expired messages: %@", error);
         }
 
-        completionHandler([self.managedContext safeSave]);
+        completionHandler(deleted);
+    }];
+}
+
+- (void)vacuumWithCompletionHandler:(void(^)(BOOL))completionHandler {
+    [self safePerformBlock:^(BOOL isSafe) {
+        if (!isSafe || self.inMemory) {
+            completionHandler(NO);
+            return;
+        }
+
+        [self.managedContext safeSave];
+        [self.managedContext reset];
+
+        // SQLite only vacuums when the store is added, so reload it with the vacuum option
+        NSPersistentStoreCoordinator *coordinator = self.managedContext.persistentStoreCoordinator;
+        for (NSPersistentStore *store in coordinator.persistentStores) {
+            NSError *error;
+            if (![coordinator removePersistentStore:store error:&error]) {
+                UA_LERR(@"Unable to remove inbox store for vacuum: %@", error);
+            }
+        }
+
+        NSPersistentStore *store = [self addStoreToContext:self.managedContext
+                                                   options:@{ NSSQLiteManualVacuumOption: @YES }];
+        completionHandler(store != nil);
+    }];
+}
+
+- (void)storeSizeWithCompletionHandler:(void(^)(NSUInteger))completionHandler {
+    [self safePerformBlock:^(BOOL isSafe) {
+        NSURL *storeURL = self.managedContext.persistentStoreCoordinator.persistentStores.firstObject.URL;
+        if (!isSafe || self.inMemory || !storeURL.isFileURL) {
+            completionHandler(0);
+            return;
+        }
+
+        NSUInteger size = 0;
+        for (NSString *suffix in @[@"", @"-wal", @"-shm"]) {
+            NSURL *fileURL = [NSURL fileURLWithPath:[storeURL.path stringByAppendingString:suffix]];
+            NSNumber *fileSize;
+            if ([fileURL getResourceValue:&fileSize forKey:NSURLFileSizeKey error:nil]) {
+                size += fileSize.unsignedIntegerValue;
+            }
+        }
+
+        completionHandler(size);
     }];
 }
 
@@ -161,22 +360,21 @@
     }] allObjects]];
 
     if (!data.isGone) {
-        data.messageID = dict[@"message_id"];
-        data.contentType = dict[@"content_type"];
-        data.title = dict[@"title"];
-        data.extra = dict[@"extra"];
-        data.messageBodyURL = [NSURL URLWithString:dict[@"message_body_url"]];
-        data.messageURL = [NSURL URLWithString:dict[@"message_url"]];
-        data.unread = [dict[@"unread"] boolValue];
-        data.messageSent = [UAUtils parseISO8601DateFromString:dict[@"message_sent"]];
-        data.rawMessageObject = dict;
+        // Only assign values that changed so unchanged messages are not saved again
+        UAInboxStoreSetValue(data, @"messageID", dict[@"message_id"]);
+        UAInboxStoreSetValue(data, @"title", dict[@"title"]);
+        UAInboxStoreSetValue(data, @"extra", dict[@"extra"]);
+        UAInboxStoreSetValue(data, @"messageBodyURL", [NSURL URLWithString:dict[@"message_body_url"]]);
+        UAInboxStoreSetValue(data, @"messageURL", [NSURL URLWithString:dict[@"message_url"]]);
+        UAInboxStoreSetValue(data, @"unread", @([dict[@"unread"] boolValue]));
+        UAInboxStoreSetValue(data, @"messageSent", [UAUtils parseISO8601DateFromString:dict[@"message_sent"]]);
+        UAInboxStoreSetValue(data, @"rawMessageObject", dict);
 
         NSString *messageExpiration = dict[@"message_expiry"];
-        if (messageExpiration) {
-            data.messageExpiration = [UAUtils parseISO8601DateFromString:messageExpiration];
-        } else {
-            data.messageExpiration = nil;
-        }
+        UAInboxStoreSetValue(data, @"messageExpiration", messageExpiration ? [UAUtils parseISO8601DateFromString:messageExpiration] : nil);
+
+        // Not persisted
+        data.contentType = dict[@"content_type"];
     }
 }
 
@@ -188,39 +386,34 @@
     [self updateMessageData:data withDictionary:dictionary];
 }
 
-- (BOOL)updateMessageWithDictionary:(NSDictionary *)dictionary {
-    NSString *messageID = dictionary[@"message_id"];
-    NSError *error = nil;
-
-    if (!messageID) {
-        UA_LDEBUG(@"Missing message ID: %@", dictionary);
-        return NO;
+/**
+ * Moves the database out of its legacy location once per store, recording how long the move
+ * took. Must be called on the managed context's queue.
+ */
+- (void)relocateDatabaseIfNeeded {
+    if (self.databaseRelocated) {
+        return;
     }
 
-    NSFetchRequest *request = [[NSFetchRequest alloc] init];
-    request.entity = [NSEntityDescription entityForName:kUAInboxDBEntityName
-                                 inManagedObjectContext:self.managedContext];
-    request.predicate = [NSPredicate predicateWithFormat:@"messageID == %@", messageID];
-    request.fetchLimit = 1;
-
-    NSArray *resultData = [self.managedContext executeFetchRequest:request error:&error];
+    self.databaseRelocated = YES;
 
-    if (error) {
-        UA_LERR(@"Fetch request %@ failed with with error: %@", request, error);
+    NSDate *start = [NSDate date];
+    if ([self moveDatabase]) {
+        NSTimeInterval duration = -[start timeIntervalSinceNow];
+        UA_LDEBUG(@"Relocated inbox database in %f seconds", duration);
+        [[[UAMetricsRegistry shared] durationHistogramWithName:UAMetricMessageCenterStoreRelocationDuration] recordValue:duration];
     }
-
-    UAInboxMessageData *data;
-    if (resultData.count) {
-        data = [resultData lastObject];
-        [self updateMessageData:data withDictionary:dictionary];
-        return YES;
-    }
-    
-    return NO;
 }
 
-- (void)moveDatabase {
+/**
+ * Moves the files of the legacy database directories. A directory is only removed once all of
+ * its files moved, and a store file left behind is opened in place.
+ *
+ * @return `YES` if there was a legacy database to move, otherwise `NO`.
+ */
+- (BOOL)moveDatabase {
     NSFileManager *fm = [NSFileManager defaultManager];
+    BOOL found = NO;
 
     NSURL *libraryDirectoryURL = [[fm URLsForDirectory:NSLibraryDirectory inDomains:NSUserDomainMask] lastObject];
     NSURL *targetDirectory = [libraryDirectoryURL URLByAppendingPathComponent:@"com.urbanairship.no-backup"];
@@ -233,7 +426,22 @@
             continue;
         }
 
-        [self moveFilesFromDirectory:legacyURL toDirectory:targetDirectory];
+        found = YES;
+
+        // The files can only move once the target directory exists
+        NSError *directoryError = nil;
+        BOOL targetExists = [fm createDirectoryAtURL:targetDirectory withIntermediateDirectories:YES attributes:nil error:&directoryError];
+        if (!targetExists) {
+            UA_LERR(@"Unable to create directory: %@ error: %@", targetDirectory, directoryError);
+        }
+
+        if (!targetExists || ![self moveFilesFromDirectory:legacyURL toDirectory:targetDirectory]) {
+            NSURL *legacyStoreURL = [legacyURL URLByAppendingPathComponent:self.storeName];
+            if ([fm fileExistsAtPath:[legacyStoreURL path]]) {
+                self.legacyStoreURL = legacyStoreURL;
+            }
+            continue;
+        }
 
         NSError *error = nil;
         [fm removeItemAtURL:legacyURL error:&error];
@@ -241,33 +449,42 @@
             UA_LERR(@"Unable to delete directory: %@ error: %@", legacyURL, error);
         }
     }
+
+    return found;
 }
 
-- (void)moveFilesFromDirectory:(NSURL *)directoryURL toDirectory:(NSURL *)targetDirectoryURL {
+- (BOOL)moveFilesFromDirectory:(NSURL *)directoryURL toDirectory:(NSURL *)targetDirectoryURL {
     NSFileManager *fm = [NSFileManager defaultManager];
 
-    if ([fm fileExistsAtPath:[directoryURL path]]) {
-        NSError *error = nil;
-        NSArray *files = [fm contentsOfDirectoryAtURL:directoryURL
-                           includingPropertiesForKeys:nil
-                                              options:NSDirectoryEnumerationSkipsHiddenFiles
-                                                error:&error];
+    if (![fm fileExistsAtPath:[directoryURL path]]) {
+        return YES;
+    }
 
-        if (error) {
-            UA_LERR(@"Unable to move files, error: %@", error);
-            return;
-        }
+    NSError *error = nil;
+    NSArray *files = [fm contentsOfDirectoryAtURL:directoryURL
+                       includingPropertiesForKeys:nil
+                                          options:NSDirectoryEnumerationSkipsHiddenFiles
+                                            error:&error];
+
+    if (error) {
+        UA_LERR(@"Unable to move files, error: %@", error);
+        return NO;
+    }
 
-        for (NSURL *file in files) {
-            [fm moveItemAtURL:file
-                        toURL:[targetDirectoryURL URLByAppendingPathComponent:[file lastPathComponent]]
-                        error:&error];
+    BOOL moved = YES;
+    for (NSURL *file in files) {
+        error = nil;
+        [fm moveItemAtURL:file
+                    toURL:[targetDirectoryURL URLByAppendingPathComponent:[file lastPathComponent]]
+                    error:&error];
 
-            if (error) {
-                UA_LERR(@"Unable to move file: %@ error: %@", file, error);
-            }
+        if (error) {
+            UA_LERR(@"Unable to move file: %@ error: %@", file, error);
+            moved = NO;
         }
     }
+
+    return moved;
 }
 
 - (void)safePerformBlock:(void (^)(BOOL))block {
@@ -4,6 +4,8 @@
 
 #import "UAAirshipMessageCenterCoreImport.h"
 
+static NSString * const UABinaryPlistHeader = @"bplist";
+
 @implementation UAJSONValueTransformer
 
 + (Class)transformedValueClass {
@@ -15,12 +17,35 @@
 }
 
 - (id)transformedValue:(NSDictionary *)value {
-    return [UAJSONSerialization dataWithJSONObject:value
-                                           options:NSJSONWritingPrettyPrinted
-                                             error:nil];
+    if (!value) {
+        return nil;
+    }
+
+    // Prefer a binary plist since it decodes faster than JSON. Values that are not
+    // property lists (e.g. containing NSNull) are still stored as JSON.
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:value
+                                                              format:NSPropertyListBinaryFormat_v1_0
+                                                             options:0
+                                                               error:nil];
+
+    return data ?: [UAJSONSerialization dataWithJSONObject:value
+                                                   options:0
+                                                     error:nil];
 }
 
 - (id)reverseTransformedValue:(id)value {
+    if (!value) {
+        return nil;
+    }
+
+    NSData *header = [UABinaryPlistHeader dataUsingEncoding:NSASCIIStringEncoding];
+    if ([value length] >= header.length && [[value subdataWithRange:NSMakeRange(0, header.length)] isEqualToData:header]) {
+        return [NSPropertyListSerialization propertyListWithData:value
+                                                         options:NSPropertyListMutableContainers
+                                                          format:nil
+                                                           error:nil];
+    }
+
     return [NSJSONSerialization JSONObjectWithData: value
                                            options: NSJSONReadingMutableContainers
                                              error: nil];
@@ -3,6 +3,7 @@
 #import <Foundation/Foundation.h>
 
 #import "UAAirshipMessageCenterCoreImport.h"
+#import "UAInboxMessageListResponse+Internal.h"
 
 @class UAUser;
 @class UARuntimeConfig;
@@ -16,9 +17,9 @@ NS_ASSUME_NONNULL_BEGIN
  * A block called when the inbox message retrieval succeeded.
  *
  * @param status The request status.
- * @param messages The retrieved messages.
+ * @param response The retrieved message list, or `nil` if it did not change.
  */
-typedef void (^UAInboxClientMessageRetrievalSuccessBlock)(NSUInteger status,  NSArray * _Nullable messages);
+typedef void (^UAInboxClientMessageRetrievalSuccessBlock)(NSUInteger status, UAInboxMessageListResponse * _Nullable response);
 
 /**
  * A block called when the channel update succeeded.
@@ -68,8 +68,9 @@ NSString *const UALastMessageListModifiedTime = @"UALastMessageListModifiedTime.
             UA_LTRACE(@"Request to retrieve message list: %@", urlString);
         }];
 
-        [self.session dataTaskWithRequest:request
-                               retryWhere:^BOOL(NSData * _Nullable data, NSURLResponse * _Nullable response) {
+        [self dataTaskWithRequest:request
+                       requestKey:[UAAPIClient requestKeyForRequest:request]
+                       retryWhere:^BOOL(NSData * _Nullable data, NSURLResponse * _Nullable response) {
                                    return NO;
                                } completionHandler:^(NSData * _Nullable data, NSURLResponse * _Nullable response, NSError * _Nullable error) {
                                    NSHTTPURLResponse *httpResponse = nil;
@@ -98,28 +99,25 @@ NSString *const UALastMessageListModifiedTime = @"UALastMessageListModifiedTime.
                                    }
 
                                    // Success
-                                   NSArray *messages = nil;
                                    NSDictionary *headers = httpResponse.allHeaderFields;
                                    NSString *lastModified = [headers objectForKey:@"Last-Modified"];
 
-                                   // Parse the response
-                                   NSError *parseError;
-                                   NSDictionary *jsonResponse = [NSJSONSerialization JSONObjectWithData:data options:NSJSONReadingAllowFragments error:&error];
-                                   messages = [jsonResponse objectForKey:@"messages"];
+                                   // Locate the messages, they are parsed as the store consumes them
+                                   UAInboxMessageListResponse *messageList = [UAInboxMessageListResponse responseWithData:data];
 
-                                   if (!messages) {
-                                       UA_LERR(@"Unable to parse inbox message body: %@ Error: %@", data, parseError);
+                                   if (!messageList) {
+                                       UA_LERR(@"Unable to parse inbox message list response of %lu bytes", (unsigned long)data.length);
                                        failureBlock();
                                        return;
                                    }
 
-                                   UA_LTRACE(@"Retrieved message list with status: %ld jsonResponse: %@", (unsigned long)httpResponse.statusCode, jsonResponse);
+                                   UA_LTRACE(@"Retrieved message list with status: %ld message count: %lu", (unsigned long)httpResponse.statusCode, (unsigned long)messageList.count);
 
                                    UA_LTRACE(@"Setting Last-Modified time to '%@' for user %@'s message list.", lastModified, userData.username);
                                    [self.dataStore setValue:lastModified
                                                      forKey:[NSString stringWithFormat:UALastMessageListModifiedTime, userData.username]];
 
-                                   successBlock(httpResponse.statusCode, messages);
+                                   successBlock(httpResponse.statusCode, messageList);
                                }];
 
     }];
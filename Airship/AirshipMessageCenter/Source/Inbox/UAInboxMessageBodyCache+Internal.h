@@ -0,0 +1,105 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+#import "UAAirshipMessageCenterCoreImport.h"
+
+@class UAUser;
+@class UAInboxMessage;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Default maximum number of message bodies kept in the cache.
+ */
+extern NSUInteger const UAInboxMessageBodyCacheDefaultMaxMessageCount;
+
+/**
+ * Default maximum total size of the message bodies kept in the cache, in bytes.
+ */
+extern NSUInteger const UAInboxMessageBodyCacheDefaultMaxTotalBytes;
+
+/**
+ * Prefetches unread message bodies and stores them on disk so messages can be displayed
+ * without waiting on the network. Bodies are stored per user, and only the current
+ * user's bodies are ever returned.
+ */
+@interface UAInboxMessageBodyCache : NSObject
+
+///---------------------------------------------------------------------------------------
+/// @name Message Body Cache Internal Properties
+///---------------------------------------------------------------------------------------
+
+/**
+ * The maximum number of message bodies to keep. Defaults to `UAInboxMessageBodyCacheDefaultMaxMessageCount`.
+ */
+@property (atomic, assign) NSUInteger maxMessageCount;
+
+/**
+ * The maximum total size of the message bodies to keep, in bytes. Bodies that do not fit are
+ * not prefetched. Defaults to `UAInboxMessageBodyCacheDefaultMaxTotalBytes`.
+ */
+@property (atomic, assign) NSUInteger maxTotalBytes;
+
+/**
+ * Whether message bodies are only prefetched on Wi-Fi. Defaults to `YES`.
+ */
+@property (atomic, assign) BOOL requiresWiFi;
+
+///---------------------------------------------------------------------------------------
+/// @name Message Body Cache Internal Methods
+///---------------------------------------------------------------------------------------
+
+/**
+ * Factory method.
+ *
+ * @param config The Airship config.
+ * @param user The inbox user.
+ * @return A message body cache instance.
+ */
++ (instancetype)cacheWithConfig:(UARuntimeConfig *)config user:(UAUser *)user;
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param user The inbox user.
+ * @param session The request session.
+ * @param directoryURL The directory the bodies are stored in.
+ * @return A message body cache instance.
+ */
++ (instancetype)cacheWithUser:(UAUser *)user
+                      session:(UARequestSession *)session
+                 directoryURL:(NSURL *)directoryURL;
+
+/**
+ * Prefetches the bodies of the unread, unexpired messages, newest first, until either limit is
+ * reached. Cached bodies for any other messages are removed. Calling this again while a prefetch
+ * is in progress replaces the earlier prefetch.
+ *
+ * @param messages The current messages.
+ */
+- (void)prefetchMessages:(NSArray<UAInboxMessage *> *)messages;
+
+/**
+ * Gets the cached body for a message.
+ *
+ * @param message The message.
+ * @param completionHandler A completion handler called on the main queue with the cached
+ * response, or nil if the body is not cached for the current user.
+ */
+- (void)cachedBodyForMessage:(UAInboxMessage *)message
+           completionHandler:(void (^)(NSCachedURLResponse * _Nullable))completionHandler;
+
+/**
+ * Removes all cached message bodies.
+ */
+- (void)removeAll;
+
+/**
+ * Waits for pending disk work to finish. Used by Unit Tests.
+ */
+- (void)waitForIdle;
+
+@end
+
+NS_ASSUME_NONNULL_END
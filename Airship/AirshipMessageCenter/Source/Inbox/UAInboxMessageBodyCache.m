@@ -0,0 +1,254 @@
+/* Copyright Airship and Contributors */
+
+#import "UAInboxMessageBodyCache+Internal.h"
+#import "UAInboxMessage.h"
+#import "UAUser.h"
+
+NSUInteger const UAInboxMessageBodyCacheDefaultMaxMessageCount = 10;
+NSUInteger const UAInboxMessageBodyCacheDefaultMaxTotalBytes = 5 * 1024 * 1024;
+
+static NSString * const UAInboxMessageBodyCacheDirectory = @"com.urbanairship.messagecenter.bodies";
+
+@interface UAInboxMessageBodyCache ()
+@property (nonatomic, strong) UAUser *user;
+@property (nonatomic, strong) UARequestSession *session;
+@property (nonatomic, strong) NSURL *directoryURL;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) dispatch_group_t group;
+
+/**
+ * Incremented for each prefetch so a superseded prefetch stops fetching. Only accessed on the queue.
+ */
+@property (nonatomic, assign) NSUInteger prefetchGeneration;
+@end
+
+@implementation UAInboxMessageBodyCache
+
+- (instancetype)initWithUser:(UAUser *)user session:(UARequestSession *)session directoryURL:(NSURL *)directoryURL {
+    self = [super init];
+
+    if (self) {
+        self.user = user;
+        self.session = session;
+        self.directoryURL = directoryURL;
+        self.queue = dispatch_queue_create("com.urbanairship.messagecenter.MessageBodyCache", DISPATCH_QUEUE_SERIAL);
+        self.group = dispatch_group_create();
+        self.maxMessageCount = UAInboxMessageBodyCacheDefaultMaxMessageCount;
+        self.maxTotalBytes = UAInboxMessageBodyCacheDefaultMaxTotalBytes;
+        self.requiresWiFi = YES;
+    }
+
+    return self;
+}
+
++ (instancetype)cacheWithConfig:(UARuntimeConfig *)config user:(UAUser *)user {
+    NSURL *cachesDirectoryURL = [[[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask] firstObject];
+    NSURL *directoryURL = [[cachesDirectoryURL URLByAppendingPathComponent:UAInboxMessageBodyCacheDirectory] URLByAppendingPathComponent:config.appKey];
+
+    return [[self alloc] initWithUser:user session:[UARequestSession sessionWithConfig:config] directoryURL:directoryURL];
+}
+
++ (instancetype)cacheWithUser:(UAUser *)user session:(UARequestSession *)session directoryURL:(NSURL *)directoryURL {
+    return [[self alloc] initWithUser:user session:session directoryURL:directoryURL];
+}
+
+#pragma mark -
+#pragma mark Cache
+
+- (NSURL *)userDirectoryURL:(UAUserData *)userData {
+    return [self.directoryURL URLByAppendingPathComponent:[UAUtils sha256HashWithString:userData.username]];
+}
+
+- (NSURL *)fileURLForMessage:(UAInboxMessage *)message userDirectoryURL:(NSURL *)userDirectoryURL {
+    return [userDirectoryURL URLByAppendingPathComponent:[UAUtils sha256HashWithString:message.messageBodyURL.absoluteString]];
+}
+
+- (void)cachedBodyForMessage:(UAInboxMessage *)message
+           completionHandler:(void (^)(NSCachedURLResponse * _Nullable))completionHandler {
+
+    UA_WEAKIFY(self)
+    [self.user getUserData:^(UAUserData *userData) {
+        UA_STRONGIFY(self)
+
+        NSCachedURLResponse *cachedResponse;
+        if (userData.username && message.messageBodyURL.absoluteString) {
+            NSURL *fileURL = [self fileURLForMessage:message userDirectoryURL:[self userDirectoryURL:userData]];
+            NSData *data = [NSData dataWithContentsOfURL:fileURL];
+            id object = data ? [NSKeyedUnarchiver unarchiveObjectWithData:data] : nil;
+
+            if ([object isKindOfClass:[NSCachedURLResponse class]]) {
+                cachedResponse = object;
+            }
+        }
+
+        [[UADispatcher mainDispatcher] dispatchAsync:^{
+            completionHandler(cachedResponse);
+        }];
+    } queue:self.queue];
+}
+
+- (void)removeAll {
+    dispatch_group_async(self.group, self.queue, ^{
+        self.prefetchGeneration++;
+        [[NSFileManager defaultManager] removeItemAtURL:self.directoryURL error:nil];
+    });
+}
+
+- (void)waitForIdle {
+    dispatch_group_wait(self.group, DISPATCH_TIME_FOREVER);
+}
+
+#pragma mark -
+#pragma mark Prefetch
+
+- (void)prefetchMessages:(NSArray<UAInboxMessage *> *)messages {
+    if (self.requiresWiFi && ![[UAUtils connectionType] isEqualToString:UAConnectionTypeWifi]) {
+        UA_LTRACE(@"Skipping message body prefetch, not on Wi-Fi");
+        return;
+    }
+
+    UANetworkMonitor *networkMonitor = [UANetworkMonitor shared];
+    if (networkMonitor.isExpensive || networkMonitor.isConstrained) {
+        UA_LTRACE(@"Skipping message body prefetch, network is expensive or constrained");
+        return;
+    }
+
+    NSMutableArray<UAInboxMessage *> *unreadMessages = [NSMutableArray array];
+    for (UAInboxMessage *message in messages) {
+        if (message.unread && ![message isExpired] && message.messageBodyURL.absoluteString) {
+            [unreadMessages addObject:message];
+        }
+    }
+
+    [unreadMessages sortUsingComparator:^NSComparisonResult(UAInboxMessage *message1, UAInboxMessage *message2) {
+        return [message2.messageSent compare:message1.messageSent];
+    }];
+
+    NSUInteger maxMessageCount = self.maxMessageCount;
+    NSArray<UAInboxMessage *> *prefetchMessages = unreadMessages.count > maxMessageCount ?
+        [unreadMessages subarrayWithRange:NSMakeRange(0, maxMessageCount)] : [unreadMessages copy];
+
+    dispatch_group_enter(self.group);
+
+    UA_WEAKIFY(self)
+    [self.user getUserData:^(UAUserData *userData) {
+        UA_STRONGIFY(self)
+
+        if (userData.username) {
+            NSUInteger generation = ++self.prefetchGeneration;
+            NSURL *userDirectoryURL = [self userDirectoryURL:userData];
+
+            NSUInteger totalBytes = [self removeEntriesExcludingMessages:prefetchMessages userDirectoryURL:userDirectoryURL];
+
+            NSMutableArray<UAInboxMessage *> *pending = [NSMutableArray array];
+            for (UAInboxMessage *message in prefetchMessages) {
+                NSURL *fileURL = [self fileURLForMessage:message userDirectoryURL:userDirectoryURL];
+                if (![[NSFileManager defaultManager] fileExistsAtPath:fileURL.path]) {
+                    [pending addObject:message];
+                }
+            }
+
+            [self fetchMessages:pending userData:userData userDirectoryURL:userDirectoryURL totalBytes:totalBytes generation:generation];
+        }
+
+        dispatch_group_leave(self.group);
+    } queue:self.queue];
+}
+
+/**
+ * Removes other users' bodies and the bodies of messages that are no longer prefetched.
+ *
+ * @return The total size of the remaining bodies, in bytes.
+ */
+- (NSUInteger)removeEntriesExcludingMessages:(NSArray<UAInboxMessage *> *)messages userDirectoryURL:(NSURL *)userDirectoryURL {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+
+    for (NSURL *otherUserDirectoryURL in [fileManager contentsOfDirectoryAtURL:self.directoryURL includingPropertiesForKeys:nil options:0 error:nil]) {
+        if (![otherUserDirectoryURL.lastPathComponent isEqualToString:userDirectoryURL.lastPathComponent]) {
+            [fileManager removeItemAtURL:otherUserDirectoryURL error:nil];
+        }
+    }
+
+    NSMutableSet<NSString *> *fileNames = [NSMutableSet set];
+    for (UAInboxMessage *message in messages) {
+        [fileNames addObject:[self fileURLForMessage:message userDirectoryURL:userDirectoryURL].lastPathComponent];
+    }
+
+    NSUInteger totalBytes = 0;
+    for (NSURL *fileURL in [fileManager contentsOfDirectoryAtURL:userDirectoryURL includingPropertiesForKeys:@[NSURLFileSizeKey] options:0 error:nil]) {
+        if (![fileNames containsObject:fileURL.lastPathComponent]) {
+            [fileManager removeItemAtURL:fileURL error:nil];
+            continue;
+        }
+
+        NSNumber *fileSize;
+        [fileURL getResourceValue:&fileSize forKey:NSURLFileSizeKey error:nil];
+        totalBytes += fileSize.unsignedIntegerValue;
+    }
+
+    return totalBytes;
+}
+
+/**
+ * Fetches message bodies one at a time until the list is exhausted or the size limit is reached.
+ * Must be called on the queue.
+ */
+- (void)fetchMessages:(NSArray<UAInboxMessage *> *)messages
+             userData:(UAUserData *)userData
+     userDirectoryURL:(NSURL *)userDirectoryURL
+           totalBytes:(NSUInteger)totalBytes
+           generation:(NSUInteger)generation {
+
+    if (!messages.count || generation != self.prefetchGeneration) {
+        return;
+    }
+
+    UAInboxMessage *message = messages[0];
+    NSArray<UAInboxMessage *> *remaining = [messages subarrayWithRange:NSMakeRange(1, messages.count - 1)];
+
+    UARequest *request = [UARequest requestWithBuilderBlock:^(UARequestBuilder * _Nonnull builder) {
+        builder.URL = message.messageBodyURL;
+        builder.method = @"GET";
+        builder.username = userData.username;
+        builder.password = userData.password;
+        builder.priority = NSURLSessionTaskPriorityLow;
+        builder.trafficClass = UARequestTrafficClassPrefetch;
+    }];
+
+    UA_LTRACE(@"Prefetching message body: %@", message.messageID);
+
+    dispatch_group_enter(self.group);
+
+    UA_WEAKIFY(self)
+    [self.session dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+        UA_STRONGIFY(self)
+        dispatch_async(self.queue, ^{
+            NSUInteger updatedTotalBytes = totalBytes;
+            NSInteger status = ((NSHTTPURLResponse *)response).statusCode;
+
+            if (error || !data || status != 200) {
+                UA_LDEBUG(@"Failed to prefetch message body %@: %lu %@", message.messageID, (unsigned long)status, error);
+            } else if (generation == self.prefetchGeneration) {
+                NSCachedURLResponse *cachedResponse = [[NSCachedURLResponse alloc] initWithResponse:response data:data];
+                NSData *encoded = [NSKeyedArchiver archivedDataWithRootObject:cachedResponse];
+
+                if (totalBytes + encoded.length > self.maxTotalBytes) {
+                    UA_LDEBUG(@"Message body %@ exceeds the cache size limit", message.messageID);
+                    dispatch_group_leave(self.group);
+                    return;
+                }
+
+                [[NSFileManager defaultManager] createDirectoryAtURL:userDirectoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+                NSURL *fileURL = [self fileURLForMessage:message userDirectoryURL:userDirectoryURL];
+                if ([encoded writeToURL:fileURL options:NSDataWritingAtomic error:nil]) {
+                    updatedTotalBytes += encoded.length;
+                }
+            }
+
+            [self fetchMessages:remaining userData:userData userDirectoryURL:userDirectoryURL totalBytes:updatedTotalBytes generation:generation];
+            dispatch_group_leave(self.group);
+        });
+    }];
+}
+
+@end
@@ -3,6 +3,7 @@
 #import "UAInboxMessageList.h"
 #import "UAInboxAPIClient+Internal.h"
 #import "UAInboxStore+Internal.h"
+#import "UAInboxMessageBodyCache+Internal.h"
 
 #import "UAAirshipMessageCenterCoreImport.h"
 
@@ -32,6 +33,11 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, strong) UAInboxStore *inboxStore;
 
+/**
+ * The message body cache used for prefetching.
+ */
+@property (nonatomic, strong) UAInboxMessageBodyCache *bodyCache;
+
 /**
  * The current count of batch operations.
  */
@@ -71,6 +77,12 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)loadSavedMessages;
 
+/**
+ * Deletes expired messages from the inbox store and reclaims the freed space when enough
+ * messages were deleted. Runs at most once a day, the rest of the calls are ignored.
+ */
+- (void)performStoreMaintenance;
+
 /**
  * Factory method for creating an Inbox Message List
  *
@@ -12,14 +12,141 @@
 
 NSString * const UAInboxMessageListWillUpdateNotification = @"com.urbanairship.notification.message_list_will_update";
 NSString * const UAInboxMessageListUpdatedNotification = @"com.urbanairship.notification.message_list_updated";
+NSString * const UAInboxMessageListInsertedMessageIDsKey = @"inserted_message_ids";
+NSString * const UAInboxMessageListRemovedMessageIDsKey = @"removed_message_ids";
+NSString * const UAInboxMessageListUpdatedMessageIDsKey = @"updated_message_ids";
+NSString * const UAInboxMessageListReadMessageIDsKey = @"read_message_ids";
 
 typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
 
+// How long local read and delete changes settle before they are sent, in seconds
+static NSTimeInterval const UAInboxMessageListStateSyncDelay = 3;
+
+// Minimum time between inbox store maintenance runs, in seconds
+static NSTimeInterval const UAInboxMessageListStoreMaintenanceInterval = 24 * 60 * 60;
+
+// Number of pruned messages that makes reclaiming the freed database space worthwhile
+static NSUInteger const UAInboxMessageListStoreVacuumThreshold = 25;
+
+// Options used to normalize titles for searching
+static NSStringCompareOptions const UAInboxMessageListTitleSearchOptions = NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch;
+
+/**
+ * An immutable snapshot of the messages and the indexes used to query them. Replaced
+ * as a whole whenever the messages change, so it can be read from any thread without locking.
+ */
+@interface UAInboxMessageListIndex : NSObject
+
+/**
+ * The messages, in message list order.
+ */
+@property (nonatomic, copy) NSArray<UAInboxMessage *> *messages;
+
+/**
+ * The unread messages, in message list order.
+ */
+@property (nonatomic, copy) NSArray<UAInboxMessage *> *unreadMessages;
+
+/**
+ * The messages with an expiration, soonest first.
+ */
+@property (nonatomic, copy) NSArray<UAInboxMessage *> *expiringMessages;
+
+/**
+ * The messages with each extra key, in message list order.
+ */
+@property (nonatomic, copy) NSDictionary<NSString *, NSArray<UAInboxMessage *> *> *messagesByExtraKey;
+
+/**
+ * The normalized message titles, matching the order of `messages`.
+ */
+@property (nonatomic, copy) NSArray<NSString *> *searchTitles;
+
+@end
+
+@implementation UAInboxMessageListIndex
+
++ (instancetype)indexWithMessages:(NSArray<UAInboxMessage *> *)messages {
+    UAInboxMessageListIndex *index = [[self alloc] init];
+
+    NSMutableArray<UAInboxMessage *> *unreadMessages = [NSMutableArray array];
+    NSMutableArray<UAInboxMessage *> *expiringMessages = [NSMutableArray array];
+    NSMutableDictionary<NSString *, NSMutableArray<UAInboxMessage *> *> *messagesByExtraKey = [NSMutableDictionary dictionary];
+    NSMutableArray<NSString *> *searchTitles = [NSMutableArray arrayWithCapacity:messages.count];
+
+    for (UAInboxMessage *message in messages) {
+        if (message.unread) {
+            [unreadMessages addObject:message];
+        }
+
+        if (message.messageExpiration) {
+            [expiringMessages addObject:message];
+        }
+
+        for (NSString *key in message.extra) {
+            NSMutableArray<UAInboxMessage *> *keyMessages = messagesByExtraKey[key];
+            if (!keyMessages) {
+                keyMessages = [NSMutableArray array];
+                messagesByExtraKey[key] = keyMessages;
+            }
+            [keyMessages addObject:message];
+        }
+
+        NSString *title = message.title ?: @"";
+        [searchTitles addObject:[title stringByFoldingWithOptions:UAInboxMessageListTitleSearchOptions locale:nil]];
+    }
+
+    [expiringMessages sortUsingComparator:^NSComparisonResult(UAInboxMessage *message1, UAInboxMessage *message2) {
+        return [message1.messageExpiration compare:message2.messageExpiration];
+    }];
+
+    index.messages = messages;
+    index.unreadMessages = unreadMessages;
+    index.expiringMessages = expiringMessages;
+    index.messagesByExtraKey = messagesByExtraKey;
+    index.searchTitles = searchTitles;
+
+    return index;
+}
+
+@end
+
 @interface UAInboxMessageList()
+
+/**
+ * The current message index.
+ */
+@property (atomic, strong) UAInboxMessageListIndex *index;
 @property (nonatomic, strong) NSNotificationCenter *notificationCenter;
 @property (nonatomic, strong) UADispatcher *dispatcher;
 @property (nonatomic, strong) UADate *date;
 
+/**
+ * The message state at the last update notification, keyed by message ID. Each value holds
+ * the unread flag and the raw message object.
+ */
+@property (nonatomic, copy) NSDictionary<NSString *, NSArray *> *notifiedMessageState;
+
+/**
+ * The scheduled sync of the local message state, if any. Only accessed on the dispatcher.
+ */
+@property (nonatomic, strong, nullable) UADisposable *stateSyncDisposable;
+
+/**
+ * Whether a sync of the local message state is in progress. Only accessed on the dispatcher.
+ */
+@property (nonatomic, assign) BOOL stateSyncInProgress;
+
+/**
+ * Whether local message state changed since the last sync started. Only accessed on the dispatcher.
+ */
+@property (nonatomic, assign) BOOL stateSyncPending;
+
+/**
+ * When the inbox store maintenance last ran. Only accessed on the dispatcher.
+ */
+@property (nonatomic, strong, nullable) NSDate *lastStoreMaintenanceDate;
+
 @end
 
 @implementation UAInboxMessageList
@@ -46,6 +173,8 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
         self.retrieveOperationCount = 0;
         self.unreadCount = -1;
         self.messages = @[];
+        self.notifiedMessageState = @{};
+        self.bodyCache = [UAInboxMessageBodyCache cacheWithConfig:config user:user];
         self.notificationCenter = notificationCenter;
         self.dispatcher = dispatcher;
         self.date = date;
@@ -111,16 +240,101 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
 
     self.messageIDMap = [messageIDMap copy];
     self.messageURLMap = [messageURLMap copy];
+    self.index = [UAInboxMessageListIndex indexWithMessages:_messages];
 }
 
 - (NSArray *)messages {
     return _messages;
 }
 
+- (void)setMessageBodyPrefetchEnabled:(BOOL)messageBodyPrefetchEnabled {
+    _messageBodyPrefetchEnabled = messageBodyPrefetchEnabled;
+
+    if (!messageBodyPrefetchEnabled) {
+        [self.bodyCache removeAll];
+    }
+}
+
+- (NSUInteger)messageBodyPrefetchMaxCount {
+    return self.bodyCache.maxMessageCount;
+}
+
+- (void)setMessageBodyPrefetchMaxCount:(NSUInteger)messageBodyPrefetchMaxCount {
+    self.bodyCache.maxMessageCount = messageBodyPrefetchMaxCount;
+}
+
+- (NSUInteger)messageBodyPrefetchMaxBytes {
+    return self.bodyCache.maxTotalBytes;
+}
+
+- (void)setMessageBodyPrefetchMaxBytes:(NSUInteger)messageBodyPrefetchMaxBytes {
+    self.bodyCache.maxTotalBytes = messageBodyPrefetchMaxBytes;
+}
+
+- (BOOL)messageBodyPrefetchRequiresWiFi {
+    return self.bodyCache.requiresWiFi;
+}
+
+- (void)setMessageBodyPrefetchRequiresWiFi:(BOOL)messageBodyPrefetchRequiresWiFi {
+    self.bodyCache.requiresWiFi = messageBodyPrefetchRequiresWiFi;
+}
+
 - (NSArray<UAInboxMessage *> *)messagesFilteredUsingPredicate:(NSPredicate *)predicate {
-    @synchronized(self) {
-        return [_messages filteredArrayUsingPredicate:predicate];
+    return [self.index.messages filteredArrayUsingPredicate:predicate];
+}
+
+- (NSArray<UAInboxMessage *> *)unreadMessages {
+    return self.index.unreadMessages;
+}
+
+- (NSArray<UAInboxMessage *> *)messagesWithExtraKey:(NSString *)key value:(nullable id)value {
+    NSArray<UAInboxMessage *> *messages = self.index.messagesByExtraKey[key] ?: @[];
+    if (!value) {
+        return messages;
     }
+
+    NSMutableArray<UAInboxMessage *> *result = [NSMutableArray array];
+    for (UAInboxMessage *message in messages) {
+        if ([message.extra[key] isEqual:value]) {
+            [result addObject:message];
+        }
+    }
+
+    return result;
+}
+
+- (NSArray<UAInboxMessage *> *)messagesExpiringBeforeDate:(NSDate *)date {
+    NSArray<UAInboxMessage *> *expiringMessages = self.index.expiringMessages;
+
+    // The search object is the date, so either side of the comparison may be a message
+    NSUInteger count = [expiringMessages indexOfObject:date
+                                         inSortedRange:NSMakeRange(0, expiringMessages.count)
+                                               options:NSBinarySearchingFirstEqual | NSBinarySearchingInsertionIndex
+                                       usingComparator:^NSComparisonResult(id obj1, id obj2) {
+        NSDate *date1 = [obj1 isKindOfClass:[UAInboxMessage class]] ? ((UAInboxMessage *)obj1).messageExpiration : obj1;
+        NSDate *date2 = [obj2 isKindOfClass:[UAInboxMessage class]] ? ((UAInboxMessage *)obj2).messageExpiration : obj2;
+        return [date1 compare:date2];
+    }];
+
+    return [expiringMessages subarrayWithRange:NSMakeRange(0, count)];
+}
+
+- (NSArray<UAInboxMessage *> *)messagesWithTitleContainingText:(NSString *)text {
+    UAInboxMessageListIndex *index = self.index;
+    if (!text.length) {
+        return index.messages;
+    }
+
+    NSString *searchText = [text stringByFoldingWithOptions:UAInboxMessageListTitleSearchOptions locale:nil];
+
+    NSMutableArray<UAInboxMessage *> *result = [NSMutableArray array];
+    [index.searchTitles enumerateObjectsUsingBlock:^(NSString *title, NSUInteger idx, BOOL *stop) {
+        if ([title rangeOfString:searchText options:NSLiteralSearch].location != NSNotFound) {
+            [result addObject:index.messages[idx]];
+        }
+    }];
+
+    return result;
 }
 
 #pragma mark NSNotificationCenter helper methods
@@ -130,7 +344,47 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
 }
 
 - (void)sendMessageListUpdatedNotification {
-    [self.notificationCenter postNotificationName:UAInboxMessageListUpdatedNotification object:nil];
+    NSDictionary<NSString *, NSArray *> *previousState = self.notifiedMessageState;
+    NSMutableDictionary<NSString *, NSArray *> *state = [NSMutableDictionary dictionaryWithCapacity:self.messages.count];
+
+    NSMutableArray<NSString *> *inserted = [NSMutableArray array];
+    NSMutableArray<NSString *> *updated = [NSMutableArray array];
+    NSMutableArray<NSString *> *read = [NSMutableArray array];
+
+    for (UAInboxMessage *message in self.messages) {
+        if (!message.messageID) {
+            continue;
+        }
+
+        NSArray *messageState = @[@(message.unread), message.rawMessageObject ?: @{}];
+        state[message.messageID] = messageState;
+
+        NSArray *previousMessageState = previousState[message.messageID];
+        if (!previousMessageState) {
+            [inserted addObject:message.messageID];
+        } else if (![previousMessageState isEqualToArray:messageState]) {
+            [updated addObject:message.messageID];
+            if ([previousMessageState[0] boolValue] && !message.unread) {
+                [read addObject:message.messageID];
+            }
+        }
+    }
+
+    NSMutableArray<NSString *> *removed = [NSMutableArray array];
+    for (NSString *messageID in previousState) {
+        if (!state[messageID]) {
+            [removed addObject:messageID];
+        }
+    }
+
+    self.notifiedMessageState = state;
+
+    [self.notificationCenter postNotificationName:UAInboxMessageListUpdatedNotification
+                                           object:nil
+                                         userInfo:@{ UAInboxMessageListInsertedMessageIDsKey: inserted,
+                                                     UAInboxMessageListRemovedMessageIDsKey: removed,
+                                                     UAInboxMessageListUpdatedMessageIDsKey: updated,
+                                                     UAInboxMessageListReadMessageIDsKey: read }];
 }
 
 #pragma mark Update/Delete/Mark Messages
@@ -145,6 +399,11 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
     [self.dispatcher dispatchAsyncIfNecessary:^{
         UA_STRONGIFY(self)
         self.retrieveOperationCount++;
+
+        // Send any scheduled state sync with the retrieval instead
+        [self.stateSyncDisposable dispose];
+        self.stateSyncDisposable = nil;
+
         [self sendMessageListWillUpdateNotification];
     }];
 
@@ -164,7 +423,14 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
             if (self.retrieveOperationCount > 0) {
                 self.retrieveOperationCount--;
             }
+            if (self.stateSyncPending && !self.isRetrieving && !self.stateSyncInProgress) {
+                // The retrieval did not get to sync the state
+                [self scheduleLocalMessageStateSync];
+            }
             if (success) {
+                if (self.messageBodyPrefetchEnabled) {
+                    [self.bodyCache prefetchMessages:self.messages];
+                }
                 if (retrieveMessageListSuccessBlock) {
                     retrieveMessageListSuccessBlock();
                 }
@@ -178,7 +444,7 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
     };
 
     // Fetch
-    [self.client retrieveMessageListOnSuccess:^(NSUInteger status, NSArray *messages) {
+    [self.client retrieveMessageListOnSuccess:^(NSUInteger status, UAInboxMessageListResponse *response) {
         UA_STRONGIFY(self)
 
         // Sync client state
@@ -187,7 +453,7 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
         UA_LDEBUG(@"Retrieve message list succeeded with status: %lu", (unsigned long)status);
 
         if (status == 200) {
-            [self.inboxStore syncMessagesWithResponse:messages completionHandler:^(BOOL success) {
+            [self.inboxStore syncMessagesWithMessageListResponse:response completionHandler:^(BOOL success) {
                 UA_STRONGIFY(self)
                 if (!success) {
                     [self.client clearLastModifiedTime];
@@ -253,7 +519,7 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
                                       [self sendMessageListUpdatedNotification];
                                   }];
 
-                                  [self syncLocalMessageState];
+                                  [self scheduleLocalMessageStateSync];
                               }];
 
     return disposable;
@@ -305,7 +571,7 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
                                       [self sendMessageListUpdatedNotification];
                                   }];
 
-                                  [self syncLocalMessageState];
+                                  [self scheduleLocalMessageStateSync];
                               }];
 
 
@@ -320,6 +586,33 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
     }];
 }
 
+- (void)performStoreMaintenance {
+    NSDate *now = [self.date now];
+    if (self.lastStoreMaintenanceDate && [now timeIntervalSinceDate:self.lastStoreMaintenanceDate] < UAInboxMessageListStoreMaintenanceInterval) {
+        return;
+    }
+
+    self.lastStoreMaintenanceDate = now;
+
+    UA_WEAKIFY(self)
+    [self.inboxStore deleteMessagesExpiredBeforeDate:now completionHandler:^(NSUInteger deleted) {
+        UA_STRONGIFY(self)
+        UA_LDEBUG(@"Pruned %lu expired inbox messages.", (unsigned long)deleted);
+
+        void (^logStoreSize)(BOOL) = ^(BOOL vacuumed) {
+            [self.inboxStore storeSizeWithCompletionHandler:^(NSUInteger size) {
+                UA_LDEBUG(@"Inbox store size: %lu bytes%@", (unsigned long)size, vacuumed ? @" after vacuum" : @"");
+            }];
+        };
+
+        if (deleted >= UAInboxMessageListStoreVacuumThreshold) {
+            [self.inboxStore vacuumWithCompletionHandler:logStoreSize];
+        } else {
+            logStoreSize(NO);
+        }
+    }];
+}
+
 #pragma mark -
 #pragma mark Internal/Helper Methods
 
@@ -364,77 +657,127 @@ typedef void (^UAInboxMessageFetchCompletionHandler)(NSArray *);
 }
 
 /**
- * Synchronizes local read messages state with the server, on the private context.
+ * Schedules a sync of the local read and deleted message state. Changes made in quick
+ * succession are sent together once they settle, or with the next list retrieval if
+ * one is in progress.
  */
-- (void)syncReadMessageState {
+- (void)scheduleLocalMessageStateSync {
     UA_WEAKIFY(self)
-    [self.inboxStore fetchMessagesWithPredicate:[NSPredicate predicateWithFormat:@"unreadClient == NO && unread == YES"]
-                              completionHandler:^(NSArray<UAInboxMessageData *> *data) {
-                                  UA_STRONGIFY(self)
+    [self.dispatcher dispatchAsyncIfNecessary:^{
+        UA_STRONGIFY(self)
+        self.stateSyncPending = YES;
 
-                                  if (!data.count) {
-                                      // Nothing to do
-                                      return;
-                                  }
+        [self.stateSyncDisposable dispose];
+        self.stateSyncDisposable = nil;
 
-                                  NSArray *messageURLs = [data valueForKeyPath:@"messageURL"];
-                                  NSArray *messageIDs = [data valueForKeyPath:@"messageID"];
+        if (self.isRetrieving) {
+            // The retrieval syncs the state once the list is fetched
+            return;
+        }
 
-                                  UA_LTRACE(@"Synchronizing locally read messages %@ on server.", messageIDs);
+        self.stateSyncDisposable = [self.dispatcher dispatchAfter:UAInboxMessageListStateSyncDelay block:^{
+            UA_STRONGIFY(self)
+            self.stateSyncDisposable = nil;
+            [self syncLocalMessageState];
+        }];
+    }];
+}
 
-                                  [self.client performBatchMarkAsReadForMessageURLs:messageURLs onSuccess:^{
+/**
+ * Synchronizes any local read or deleted message state with the server. Only one sync
+ * runs at a time, changes made during a sync are sent once it finishes.
+ */
+- (void)syncLocalMessageState {
+    UA_WEAKIFY(self)
+    [self.dispatcher dispatchAsyncIfNecessary:^{
+        UA_STRONGIFY(self)
+        [self.stateSyncDisposable dispose];
+        self.stateSyncDisposable = nil;
 
-                                      // Mark the messages as read
-                                      [self.inboxStore fetchMessagesWithPredicate:[NSPredicate predicateWithFormat:@"messageID IN %@", messageIDs]
-                                                                completionHandler:^(NSArray<UAInboxMessageData *> *data) {
-                                                                    for (UAInboxMessageData *messageData in data) {
-                                                                        messageData.unread = NO;
-                                                                    }
+        if (self.stateSyncInProgress) {
+            self.stateSyncPending = YES;
+            return;
+        }
 
-                                                                    UA_LTRACE(@"Successfully synchronized locally read messages on server.");
-                                                                }];
-                                  } onFailure:^() {
-                                      UA_LTRACE(@"Failed to synchronize locally read messages on server.");
-                                  }];
+        self.stateSyncPending = NO;
+        self.stateSyncInProgress = YES;
 
-                              }];
+        [self performLocalMessageStateSync:^{
+            [self.dispatcher dispatchAsync:^{
+                UA_STRONGIFY(self)
+                self.stateSyncInProgress = NO;
+                if (self.stateSyncPending) {
+                    [self scheduleLocalMessageStateSync];
+                }
+            }];
+        }];
+    }];
 }
 
 /**
- * Synchronizes local deleted message state with the server, on the private context.
+ * Sends the local read and deleted message state to the server, on the private context.
+ * Messages that are deleted are not also marked as read.
+ *
+ * @param completionHandler Called once all requests are finished.
  */
-- (void)syncDeletedMessageState {
+- (void)performLocalMessageStateSync:(void (^)(void))completionHandler {
+    NSPredicate *predicate = [NSPredicate predicateWithFormat:@"deletedClient == YES || (unreadClient == NO && unread == YES)"];
 
     UA_WEAKIFY(self)
-    [self.inboxStore fetchMessagesWithPredicate:[NSPredicate predicateWithFormat:@"deletedClient == YES"]
+    [self.inboxStore fetchMessagesWithPredicate:predicate
                               completionHandler:^(NSArray<UAInboxMessageData *> *data) {
                                   UA_STRONGIFY(self)
 
-                                  if (!data.count) {
-                                      // Nothing to do
-                                      return;
+                                  NSMutableArray<UAInboxMessageData *> *readData = [NSMutableArray array];
+                                  NSMutableArray<UAInboxMessageData *> *deletedData = [NSMutableArray array];
+                                  for (UAInboxMessageData *messageData in data) {
+                                      [(messageData.deletedClient ? deletedData : readData) addObject:messageData];
                                   }
 
+                                  dispatch_group_t group = dispatch_group_create();
+
+                                  if (readData.count) {
+                                      NSArray *messageURLs = [readData valueForKeyPath:@"messageURL"];
+                                      NSArray *messageIDs = [readData valueForKeyPath:@"messageID"];
+
+                                      UA_LTRACE(@"Synchronizing locally read messages %@ on server.", messageIDs);
+
+                                      dispatch_group_enter(group);
+                                      [self.client performBatchMarkAsReadForMessageURLs:messageURLs onSuccess:^{
+                                          // Mark the messages as read
+                                          [self.inboxStore fetchMessagesWithPredicate:[NSPredicate predicateWithFormat:@"messageID IN %@", messageIDs]
+                                                                    completionHandler:^(NSArray<UAInboxMessageData *> *data) {
+                                                                        for (UAInboxMessageData *messageData in data) {
+                                                                            messageData.unread = NO;
+                                                                        }
+
+                                                                        UA_LTRACE(@"Successfully synchronized locally read messages on server.");
+                                                                        dispatch_group_leave(group);
+                                                                    }];
+                                      } onFailure:^() {
+                                          UA_LTRACE(@"Failed to synchronize locally read messages on server.");
+                                          dispatch_group_leave(group);
+                                      }];
+                                  }
 
-                                  NSArray *messageURLs = [data valueForKeyPath:@"messageURL"];
-                                  NSArray *messageIDs = [data valueForKeyPath:@"messageID"];
+                                  if (deletedData.count) {
+                                      NSArray *messageURLs = [deletedData valueForKeyPath:@"messageURL"];
+                                      NSArray *messageIDs = [deletedData valueForKeyPath:@"messageID"];
 
-                                  UA_LTRACE(@"Synchronizing locally deleted messages %@ on server.", messageIDs);
+                                      UA_LTRACE(@"Synchronizing locally deleted messages %@ on server.", messageIDs);
 
-                                  [self.client performBatchDeleteForMessageURLs:messageURLs onSuccess:^{
-                                      UA_LTRACE(@"Successfully synchronized locally deleted messages on server.");
-                                  } onFailure:^() {
-                                      UA_LTRACE(@"Failed to synchronize locally deleted messages on server.");
-                                  }];
-                              }];
-}
+                                      dispatch_group_enter(group);
+                                      [self.client performBatchDeleteForMessageURLs:messageURLs onSuccess:^{
+                                          UA_LTRACE(@"Successfully synchronized locally deleted messages on server.");
+                                          dispatch_group_leave(group);
+                                      } onFailure:^() {
+                                          UA_LTRACE(@"Failed to synchronize locally deleted messages on server.");
+                                          dispatch_group_leave(group);
+                                      }];
+                                  }
 
-/**
- * Synchronizes any local read or deleted message state with the server, on the private context.
- */
-- (void)syncLocalMessageState {
-    [self syncReadMessageState];
-    [self syncDeletedMessageState];
+                                  dispatch_group_notify(group, dispatch_get_global_queue([UADispatcher qosClassForWorkType:UADispatcherWorkTypeUpload], 0), completionHandler);
+                              }];
 }
 
 - (NSUInteger)messageCount {
@@ -0,0 +1,39 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A message list response body. The body is scanned once to find each message, and messages
+ * are only parsed when they are enumerated, so the full list is never materialized at once.
+ * Fields outside of the messages array are skipped.
+ */
+@interface UAInboxMessageListResponse : NSObject
+
+/**
+ * The number of messages in the response.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ * Factory method.
+ *
+ * @param data The response body.
+ * @return A response, or `nil` if the body is not an object with a messages array.
+ */
++ (nullable instancetype)responseWithData:(NSData *)data;
+
+/**
+ * Parses and enumerates the messages in order, a chunk at a time. Each chunk is parsed and
+ * released before the next one, and messages that fail to parse are skipped.
+ *
+ * @param chunkSize The maximum number of messages in a chunk.
+ * @param block The block called with each chunk.
+ */
+- (void)enumerateMessagesWithChunkSize:(NSUInteger)chunkSize
+                            usingBlock:(void (^)(NSArray *messages))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
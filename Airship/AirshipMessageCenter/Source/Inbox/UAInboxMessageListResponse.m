@@ -0,0 +1,238 @@
+/* Copyright Airship and Contributors */
+
+#import "UAInboxMessageListResponse+Internal.h"
+
+#import "UAAirshipMessageCenterCoreImport.h"
+
+@interface UAInboxMessageListResponse ()
+@property (nonatomic, strong) NSData *data;
+
+// Byte ranges of the messages in the response body
+@property (nonatomic, copy) NSArray<NSValue *> *messageRanges;
+@end
+
+@implementation UAInboxMessageListResponse
+
+static NSUInteger UAInboxMessageListSkipWhitespace(const uint8_t *bytes, NSUInteger index, NSUInteger length) {
+    while (index < length && (bytes[index] == ' ' || bytes[index] == '\t' || bytes[index] == '\n' || bytes[index] == '\r')) {
+        index++;
+    }
+    return index;
+}
+
+/**
+ * Returns the index past the string that starts at index, or NSNotFound if it is not terminated.
+ */
+static NSUInteger UAInboxMessageListScanString(const uint8_t *bytes, NSUInteger index, NSUInteger length) {
+    for (index = index + 1; index < length; index++) {
+        if (bytes[index] == '\\') {
+            index++;
+        } else if (bytes[index] == '"') {
+            return index + 1;
+        }
+    }
+    return NSNotFound;
+}
+
+/**
+ * Returns the index past the value that starts at index, or NSNotFound if it is not terminated.
+ * Values are only delimited here, they are validated when parsed.
+ */
+static NSUInteger UAInboxMessageListScanValue(const uint8_t *bytes, NSUInteger index, NSUInteger length) {
+    if (index >= length) {
+        return NSNotFound;
+    }
+
+    uint8_t c = bytes[index];
+    if (c == '"') {
+        return UAInboxMessageListScanString(bytes, index, length);
+    }
+
+    if (c == '{' || c == '[') {
+        NSUInteger depth = 0;
+        while (index < length) {
+            c = bytes[index];
+            if (c == '"') {
+                index = UAInboxMessageListScanString(bytes, index, length);
+                if (index == NSNotFound) {
+                    return NSNotFound;
+                }
+                continue;
+            }
+
+            if (c == '{' || c == '[') {
+                depth++;
+            } else if ((c == '}' || c == ']') && --depth == 0) {
+                return index + 1;
+            }
+            index++;
+        }
+        return NSNotFound;
+    }
+
+    // Numbers, true, false and null
+    NSUInteger start = index;
+    while (index < length && !strchr(",}] \t\n\r", bytes[index])) {
+        index++;
+    }
+    return index > start ? index : NSNotFound;
+}
+
+static BOOL UAInboxMessageListIsMessagesKey(const uint8_t *bytes, NSRange range) {
+    static const char key[] = "\"messages\"";
+    if (range.length == sizeof(key) - 1 && !memcmp(bytes + range.location, key, range.length)) {
+        return YES;
+    }
+
+    // Only escaped keys need decoding
+    if (!memchr(bytes + range.location, '\\', range.length)) {
+        return NO;
+    }
+
+    NSData *keyData = [NSData dataWithBytesNoCopy:(void *)(bytes + range.location) length:range.length freeWhenDone:NO];
+    id decoded = [NSJSONSerialization JSONObjectWithData:keyData options:NSJSONReadingAllowFragments error:nil];
+    return [decoded isEqual:@"messages"];
+}
+
+/**
+ * Returns the byte ranges of the elements of the array that starts at index, or nil if it is not an array.
+ */
+static NSArray<NSValue *> *UAInboxMessageListScanArray(const uint8_t *bytes, NSUInteger *index, NSUInteger length) {
+    NSUInteger i = *index;
+    if (i >= length || bytes[i] != '[') {
+        return nil;
+    }
+
+    NSMutableArray<NSValue *> *ranges = [NSMutableArray array];
+    i = UAInboxMessageListSkipWhitespace(bytes, i + 1, length);
+    if (i < length && bytes[i] == ']') {
+        *index = i + 1;
+        return ranges;
+    }
+
+    while (i < length) {
+        NSUInteger end = UAInboxMessageListScanValue(bytes, i, length);
+        if (end == NSNotFound) {
+            return nil;
+        }
+
+        [ranges addObject:[NSValue valueWithRange:NSMakeRange(i, end - i)]];
+
+        i = UAInboxMessageListSkipWhitespace(bytes, end, length);
+        if (i < length && bytes[i] == ']') {
+            *index = i + 1;
+            return ranges;
+        }
+
+        if (i >= length || bytes[i] != ',') {
+            return nil;
+        }
+        i = UAInboxMessageListSkipWhitespace(bytes, i + 1, length);
+    }
+
+    return nil;
+}
+
+- (instancetype)initWithData:(NSData *)data messageRanges:(NSArray<NSValue *> *)messageRanges {
+    self = [super init];
+
+    if (self) {
+        self.data = data;
+        self.messageRanges = messageRanges;
+    }
+
+    return self;
+}
+
++ (nullable instancetype)responseWithData:(NSData *)data {
+    const uint8_t *bytes = data.bytes;
+    NSUInteger length = data.length;
+    NSArray<NSValue *> *messageRanges = nil;
+
+    // A single pass over the top level object, only the messages array is looked into
+    NSUInteger i = UAInboxMessageListSkipWhitespace(bytes, 0, length);
+    if (i >= length || bytes[i] != '{') {
+        return nil;
+    }
+
+    i = UAInboxMessageListSkipWhitespace(bytes, i + 1, length);
+    while (i < length && bytes[i] != '}') {
+        if (bytes[i] != '"') {
+            return nil;
+        }
+
+        NSUInteger keyEnd = UAInboxMessageListScanString(bytes, i, length);
+        if (keyEnd == NSNotFound) {
+            return nil;
+        }
+
+        BOOL isMessagesKey = UAInboxMessageListIsMessagesKey(bytes, NSMakeRange(i, keyEnd - i));
+
+        i = UAInboxMessageListSkipWhitespace(bytes, keyEnd, length);
+        if (i >= length || bytes[i] != ':') {
+            return nil;
+        }
+        i = UAInboxMessageListSkipWhitespace(bytes, i + 1, length);
+
+        if (isMessagesKey) {
+            messageRanges = UAInboxMessageListScanArray(bytes, &i, length);
+            if (!messageRanges) {
+                return nil;
+            }
+        } else {
+            i = UAInboxMessageListScanValue(bytes, i, length);
+            if (i == NSNotFound) {
+                return nil;
+            }
+        }
+
+        i = UAInboxMessageListSkipWhitespace(bytes, i, length);
+        if (i < length && bytes[i] == ',') {
+            i = UAInboxMessageListSkipWhitespace(bytes, i + 1, length);
+        } else if (i >= length || bytes[i] != '}') {
+            return nil;
+        }
+    }
+
+    if (i >= length || !messageRanges) {
+        return nil;
+    }
+
+    return [[self alloc] initWithData:data messageRanges:messageRanges];
+}
+
+- (NSUInteger)count {
+    return self.messageRanges.count;
+}
+
+- (void)enumerateMessagesWithChunkSize:(NSUInteger)chunkSize
+                            usingBlock:(void (^)(NSArray *messages))block {
+    chunkSize = MAX(chunkSize, 1);
+    const uint8_t *bytes = self.data.bytes;
+    NSUInteger count = self.messageRanges.count;
+
+    for (NSUInteger start = 0; start < count; start += chunkSize) {
+        @autoreleasepool {
+            NSUInteger end = MIN(start + chunkSize, count);
+            NSMutableArray *messages = [NSMutableArray arrayWithCapacity:end - start];
+
+            for (NSUInteger i = start; i < end; i++) {
+                NSRange range = self.messageRanges[i].rangeValue;
+                NSData *messageData = [NSData dataWithBytesNoCopy:(void *)(bytes + range.location) length:range.length freeWhenDone:NO];
+
+                NSError *error;
+                id message = [NSJSONSerialization JSONObjectWithData:messageData options:NSJSONReadingAllowFragments error:&error];
+                if (!message) {
+                    UA_LERR(@"Unable to parse inbox message at index %lu: %@", (unsigned long)i, error);
+                    continue;
+                }
+
+                [messages addObject:message];
+            }
+
+            block(messages);
+        }
+    }
+}
+
+@end
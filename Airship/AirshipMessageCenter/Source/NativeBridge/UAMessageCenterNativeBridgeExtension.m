@@ -3,13 +3,45 @@
 #import "UAMessageCenterNativeBridgeExtension.h"
 #import "UAMessageCenter.h"
 #import "UAInboxMessageList.h"
-#import "UAUser.h"
+#import "UAUser+Internal.h"
 #import "UAInboxMessage.h"
 
 #import "UAAirshipMessageCenterCoreImport.h"
 
+static NSString * const UAMessageEnvironmentIDKey = @"id";
+static NSString * const UAMessageEnvironmentTitleKey = @"title";
+static NSString * const UAMessageEnvironmentSentDateKey = @"sent_date";
+static NSString * const UAMessageEnvironmentSentDateMSKey = @"sent_date_ms";
+static NSString * const UAMessageEnvironmentExtrasKey = @"extras";
+
+@interface UAMessageCenterNativeBridgeExtension ()
+@property (atomic, strong, nullable) UAUserData *userData;
+@end
+
 @implementation UAMessageCenterNativeBridgeExtension
 
+/**
+ * Message environment values, keyed by message ID. Shared so re-opening a message skips the date formatting.
+ */
++ (NSCache<NSString *, NSDictionary *> *)messageEnvironmentCache {
+    static NSCache *cache;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        cache = [[NSCache alloc] init];
+        cache.countLimit = 50;
+    });
+    return cache;
+}
+
+- (void)loadUserDataWithCompletionHandler:(void (^)(void))completionHandler {
+    UA_WEAKIFY(self)
+    [[UAMessageCenter shared].user getUserData:^(UAUserData *userData) {
+        UA_STRONGIFY(self)
+        self.userData = userData;
+        completionHandler();
+    } dispatcher:[UADispatcher mainDispatcher]];
+}
+
 - (NSDictionary *)actionsMetadataForCommand:(UAJavaScriptCommand *)command webView:(WKWebView *)webView {
     NSMutableDictionary *metadata = [NSMutableDictionary dictionary];
     UAInboxMessage *message = [[UAMessageCenter shared].messageList messageForBodyURL:webView.URL];
@@ -23,21 +55,41 @@
         return;
     }
 
-    UAUserData *userData = [[UAMessageCenter shared].user getUserDataSync];
-    NSNumber *messageSentDateMS = nil;
-    NSString *messageSentDate = nil;
-    if (message.messageSent) {
-       messageSentDateMS = [NSNumber numberWithDouble:[message.messageSent timeIntervalSince1970] * 1000];
-       messageSentDate = [[UAUtils ISODateFormatterUTC] stringFromDate:message.messageSent];
-    }
+    // Never read the keychain here, this is called during navigation on the main queue
+    UAUserData *userData = self.userData ?: [[UAMessageCenter shared].user getCachedUserData];
+    NSDictionary *environment = [self environmentForMessage:message];
 
     // Message data
-    [js addStringGetter:@"getMessageId" value:message.messageID];
-    [js addStringGetter:@"getMessageTitle" value:message.title];
-    [js addNumberGetter:@"getMessageSentDateMS" value:messageSentDateMS];
-    [js addStringGetter:@"getMessageSentDate" value:messageSentDate];
-    [js addDictionaryGetter:@"getMessageExtras" value:message.extra];
+    [js addStringGetter:@"getMessageId" value:environment[UAMessageEnvironmentIDKey]];
+    [js addStringGetter:@"getMessageTitle" value:environment[UAMessageEnvironmentTitleKey]];
+    [js addNumberGetter:@"getMessageSentDateMS" value:environment[UAMessageEnvironmentSentDateMSKey]];
+    [js addStringGetter:@"getMessageSentDate" value:environment[UAMessageEnvironmentSentDateKey]];
+    [js addDictionaryGetter:@"getMessageExtras" value:environment[UAMessageEnvironmentExtrasKey]];
     [js addStringGetter:@"getUserId" value:userData.username];
 }
 
+- (NSDictionary *)environmentForMessage:(UAInboxMessage *)message {
+    NSCache *cache = [UAMessageCenterNativeBridgeExtension messageEnvironmentCache];
+    NSDictionary *environment = message.messageID ? [cache objectForKey:message.messageID] : nil;
+    if (environment) {
+        return environment;
+    }
+
+    NSMutableDictionary *values = [NSMutableDictionary dictionary];
+    [values setValue:message.messageID forKey:UAMessageEnvironmentIDKey];
+    [values setValue:message.title forKey:UAMessageEnvironmentTitleKey];
+    [values setValue:message.extra forKey:UAMessageEnvironmentExtrasKey];
+    if (message.messageSent) {
+        [values setValue:@([message.messageSent timeIntervalSince1970] * 1000) forKey:UAMessageEnvironmentSentDateMSKey];
+        [values setValue:[UAUtils ISODateStringFromDate:message.messageSent delimiter:NO] forKey:UAMessageEnvironmentSentDateKey];
+    }
+
+    environment = [values copy];
+    if (message.messageID) {
+        [cache setObject:environment forKey:message.messageID];
+    }
+
+    return environment;
+}
+
 @end
@@ -9,12 +9,15 @@
 #import "UARuntimeConfig.h"
 #import "UAPushableComponent.h"
 #import "UAPreferenceDataStore.h"
+#import "UANetworkMonitor.h"
 #import "UANativeBridgeExtensionDelegate.h"
 #import "UANativeBridge.h"
 #import "UAModuleLoader.h"
+#import "UAMetricsRegistry.h"
 #import "UAMessageCenterModuleLoaderFactory.h"
 #import "UAJSONSerialization.h"
 #import "UAGlobal.h"
+#import "UAForegroundWorkScheduler.h"
 #import "UAExtendableChannelRegistration.h"
 #import "UADisposable.h"
 #import "UADispatcher.h"
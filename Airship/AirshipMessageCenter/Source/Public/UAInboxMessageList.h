@@ -28,6 +28,32 @@ extern NSString * const UAInboxMessageListWillUpdateNotification;
  */
 extern NSString * const UAInboxMessageListUpdatedNotification;
 
+/**
+ * UAInboxMessageListUpdatedNotification user info key for the IDs of the messages added
+ * to the message list since the previous update notification, as an NSArray of NSStrings.
+ */
+extern NSString * const UAInboxMessageListInsertedMessageIDsKey;
+
+/**
+ * UAInboxMessageListUpdatedNotification user info key for the IDs of the messages removed
+ * from the message list since the previous update notification, as an NSArray of NSStrings.
+ * Removed messages include deleted and expired messages.
+ */
+extern NSString * const UAInboxMessageListRemovedMessageIDsKey;
+
+/**
+ * UAInboxMessageListUpdatedNotification user info key for the IDs of the messages whose
+ * contents or read state changed since the previous update notification, as an NSArray of NSStrings.
+ */
+extern NSString * const UAInboxMessageListUpdatedMessageIDsKey;
+
+/**
+ * UAInboxMessageListUpdatedNotification user info key for the IDs of the messages that were
+ * marked read since the previous update notification, as an NSArray of NSStrings. These messages
+ * are also included in the updated message IDs.
+ */
+extern NSString * const UAInboxMessageListReadMessageIDsKey;
+
 @class UAInboxMessage;
 
 /**
@@ -65,6 +91,28 @@ extern NSString * const UAInboxMessageListUpdatedNotification;
  */
 @property (readonly) BOOL isBatchUpdating;
 
+/**
+ * Whether unread message bodies are downloaded after the message list is retrieved, so
+ * they can be displayed without waiting on the network, including while offline.
+ * Defaults to `NO`. Disabling prefetching removes any downloaded message bodies.
+ */
+@property (nonatomic, assign, getter=isMessageBodyPrefetchEnabled) BOOL messageBodyPrefetchEnabled;
+
+/**
+ * The maximum number of unread message bodies to prefetch, newest first. Defaults to 10.
+ */
+@property (nonatomic, assign) NSUInteger messageBodyPrefetchMaxCount;
+
+/**
+ * The maximum total size of the prefetched message bodies, in bytes. Defaults to 5MB.
+ */
+@property (nonatomic, assign) NSUInteger messageBodyPrefetchMaxBytes;
+
+/**
+ * Whether message bodies are only prefetched while on Wi-Fi. Defaults to `YES`.
+ */
+@property (nonatomic, assign) BOOL messageBodyPrefetchRequiresWiFi;
+
 
 ///---------------------------------------------------------------------------------------
 /// @name Message List Retrieval
@@ -117,6 +165,43 @@ extern NSString * const UAInboxMessageListUpdatedNotification;
  */
 - (NSArray<UAInboxMessage *> *)messagesFilteredUsingPredicate:(NSPredicate *)predicate;
 
+/**
+ * Returns the unread messages, in message list order. Uses an index maintained with the
+ * message list, so it is cheaper than filtering with a predicate.
+ *
+ * @return The unread messages.
+ */
+- (NSArray<UAInboxMessage *> *)unreadMessages;
+
+/**
+ * Returns the messages with an extra for the given key, in message list order. Uses an
+ * index maintained with the message list, so it is cheaper than filtering with a predicate.
+ *
+ * @param key The extra key.
+ * @param value The extra value to match, or nil to match any value.
+ * @return The matching messages.
+ */
+- (NSArray<UAInboxMessage *> *)messagesWithExtraKey:(NSString *)key value:(nullable id)value;
+
+/**
+ * Returns the messages that expire before the given date, soonest first. Messages without
+ * an expiration are never returned.
+ *
+ * @param date The date.
+ * @return The matching messages.
+ */
+- (NSArray<UAInboxMessage *> *)messagesExpiringBeforeDate:(NSDate *)date;
+
+/**
+ * Returns the messages whose title contains the given text, ignoring case and diacritics,
+ * in message list order. Titles are normalized when the message list changes, so this is
+ * suitable for searching as the user types.
+ *
+ * @param text The text to search for. An empty string matches every message.
+ * @return The matching messages.
+ */
+- (NSArray<UAInboxMessage *> *)messagesWithTitleContainingText:(NSString *)text;
+
 /**
  * Returns the number of messages currently in the inbox.
  *
@@ -11,6 +11,14 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @interface UAMessageCenterNativeBridgeExtension : NSObject<UANativeBridgeExtensionDelegate>
 
+/**
+ * Loads the user data exposed to the JavaScript environment without blocking the calling queue.
+ * Call before starting a message navigation so the environment is extended from memory.
+ *
+ * @param completionHandler A completion handler called on the main queue once the user data is loaded.
+ */
+- (void)loadUserDataWithCompletionHandler:(void (^)(void))completionHandler;
+
 @end
 
 NS_ASSUME_NONNULL_END
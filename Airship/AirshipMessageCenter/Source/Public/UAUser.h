@@ -41,6 +41,14 @@ extern NSString * const UAUserCreatedNotification;
  */
 - (nullable UAUserData *)getUserDataSync;
 
+/**
+ * Gets the data associated with the user if it has already been loaded. Never blocks and never reads
+ * the keychain, so it is safe to call on the main queue and while protected data is unavailable.
+ *
+ * @return The user data, or `nil` if no data has been loaded yet.
+ */
+- (nullable UAUserData *)getCachedUserData;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -46,6 +46,23 @@ NS_ASSUME_NONNULL_BEGIN
                                  defaultUI:(UADefaultMessageCenterUI *)defaultUI
                         notificationCenter:(NSNotificationCenter *)notificationCenter;
 
+/**
+ * Factory method for testing.
+ * @param dataStore The data store.
+ * @param user The user.
+ * @param messageList The message list.
+ * @param defaultUI The default UI.
+ * @param notificationCenter The notification center.
+ * @param lazyEnabled Whether user creation and the inbox are deferred until first access.
+ * @return A message center instance.
+*/
++ (instancetype)messageCenterWithDataStore:(UAPreferenceDataStore *)dataStore
+                                      user:(UAUser *)user
+                               messageList:(UAInboxMessageList *)messageList
+                                 defaultUI:(UADefaultMessageCenterUI *)defaultUI
+                        notificationCenter:(NSNotificationCenter *)notificationCenter
+                               lazyEnabled:(BOOL)lazyEnabled;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -15,26 +15,35 @@
 @property (nonatomic, strong) UADefaultMessageCenterUI *defaultUI;
 @property (nonatomic, strong) UAInboxMessageList *messageList;
 @property (nonatomic, strong) UAUser *user;
+@property (nonatomic, strong) UAPreferenceDataStore *dataStore;
+@property (atomic, assign) BOOL activated;
 @end
 
 @implementation UAMessageCenter
 
 NSString *const UAMessageDataScheme = @"message";
 
+static NSString * const UAMessageCenterActivatedKey = @"UAMessageCenterActivated";
+
 - (instancetype)initWithDataStore:(UAPreferenceDataStore *)dataStore
                              user:(UAUser *)user
                       messageList:(UAInboxMessageList *)messageList
                         defaultUI:(UADefaultMessageCenterUI *)defaultUI
-               notificationCenter:(NSNotificationCenter *)notificationCenter {
+               notificationCenter:(NSNotificationCenter *)notificationCenter
+                      lazyEnabled:(BOOL)lazyEnabled {
 
     self = [super initWithDataStore:dataStore];
     if (self) {
-        self.user = user;
-        self.messageList = messageList;
+        _user = user;
+        _messageList = messageList;
         self.defaultUI = defaultUI;
+        self.dataStore = dataStore;
+        self.activated = !lazyEnabled || [dataStore boolForKey:UAMessageCenterActivatedKey];
 
-        self.user.enabled = self.componentEnabled;
-        self.messageList.enabled = self.componentEnabled;
+        // Set before enabling the user so the initial registration respects it
+        _user.creationDeferred = !self.activated;
+        _user.enabled = self.componentEnabled;
+        _messageList.enabled = self.componentEnabled;
 
         [notificationCenter addObserver:self
                                selector:@selector(userCreated)
@@ -46,7 +55,14 @@ NSString *const UAMessageDataScheme = @"message";
                                    name:UAApplicationDidTransitionToForeground
                                  object:nil];
 
-        [self.messageList loadSavedMessages];
+        [notificationCenter addObserver:self
+                               selector:@selector(applicationDidEnterBackground)
+                                   name:UAApplicationDidEnterBackgroundNotification
+                                 object:nil];
+
+        if (self.activated) {
+            [_messageList loadSavedMessages];
+        }
     }
 
     return self;
@@ -72,7 +88,8 @@ NSString *const UAMessageDataScheme = @"message";
                                       user:user
                                messageList:messageList
                                  defaultUI:defaultUI
-                        notificationCenter:notificationCenter];
+                        notificationCenter:notificationCenter
+                               lazyEnabled:config.isLazyMessageCenterEnabled];
 }
 
 + (instancetype)messageCenterWithDataStore:(UAPreferenceDataStore *)dataStore
@@ -81,14 +98,59 @@ NSString *const UAMessageDataScheme = @"message";
                                  defaultUI:(UADefaultMessageCenterUI *)defaultUI
                         notificationCenter:(NSNotificationCenter *)notificationCenter {
 
+    return [self messageCenterWithDataStore:dataStore
+                                       user:user
+                                messageList:messageList
+                                  defaultUI:defaultUI
+                         notificationCenter:notificationCenter
+                                lazyEnabled:NO];
+}
+
++ (instancetype)messageCenterWithDataStore:(UAPreferenceDataStore *)dataStore
+                                      user:(UAUser *)user
+                               messageList:(UAInboxMessageList *)messageList
+                                 defaultUI:(UADefaultMessageCenterUI *)defaultUI
+                        notificationCenter:(NSNotificationCenter *)notificationCenter
+                               lazyEnabled:(BOOL)lazyEnabled {
+
     return [[self alloc] initWithDataStore:dataStore
                                       user:user
                                messageList:messageList
                                  defaultUI:defaultUI
-                        notificationCenter:notificationCenter];
+                        notificationCenter:notificationCenter
+                               lazyEnabled:lazyEnabled];
+}
+
+- (UAInboxMessageList *)messageList {
+    [self activateIfNeeded];
+    return _messageList;
+}
+
+- (UAUser *)user {
+    [self activateIfNeeded];
+    return _user;
+}
+
+/**
+ * Creates the user and loads the inbox the first time the Message Center is used when
+ * lazy Message Center is enabled. No-op otherwise.
+ */
+- (void)activateIfNeeded {
+    @synchronized (self) {
+        if (self.activated) {
+            return;
+        }
+        self.activated = YES;
+    }
+
+    UA_LDEBUG(@"Activating Message Center");
+    [self.dataStore setBool:YES forKey:UAMessageCenterActivatedKey];
+    _user.creationDeferred = NO;
+    [_messageList loadSavedMessages];
 }
 
 - (void)display:(BOOL)animated {
+    [self activateIfNeeded];
     id<UAMessageCenterDisplayDelegate> displayDelegate = self.displayDelegate ?: self.defaultUI;
     [displayDelegate displayMessageCenterAnimated:animated];
 }
@@ -98,6 +160,7 @@ NSString *const UAMessageDataScheme = @"message";
 }
 
 - (void)displayMessageForID:(NSString *)messageID animated:(BOOL)animated {
+    [self activateIfNeeded];
     id<UAMessageCenterDisplayDelegate> displayDelegate = self.displayDelegate ?: self.defaultUI;
     [displayDelegate displayMessageCenterForMessageID:messageID animated:animated];
 }
@@ -116,7 +179,26 @@ NSString *const UAMessageDataScheme = @"message";
 }
 
 - (void)applicationDidTransitionToForeground {
-    [self.messageList retrieveMessageListWithSuccessBlock:nil withFailureBlock:nil];
+    if (!self.activated) {
+        return;
+    }
+
+    UA_WEAKIFY(self)
+    [[UAForegroundWorkScheduler shared] scheduleWorkWithName:@"com.urbanairship.message_center.refresh"
+                                                    priority:UAForegroundWorkPriorityLow
+                                                  dispatcher:[UADispatcher mainDispatcher]
+                                                       block:^{
+        UA_STRONGIFY(self)
+        [self.messageList retrieveMessageListWithSuccessBlock:nil withFailureBlock:nil];
+    }];
+}
+
+- (void)applicationDidEnterBackground {
+    if (!self.activated) {
+        return;
+    }
+
+    [self.messageList performStoreMaintenance];
 }
 
 - (void)userCreated {
@@ -124,8 +206,8 @@ NSString *const UAMessageDataScheme = @"message";
 }
 
 - (void)onComponentEnableChange {
-    self.user.enabled = self.componentEnabled;
-    self.messageList.enabled = self.componentEnabled;
+    _user.enabled = self.componentEnabled;
+    _messageList.enabled = self.componentEnabled;
 }
 
 #pragma mark -
@@ -139,6 +221,7 @@ NSString *const UAMessageDataScheme = @"message";
         return;
     }
 
+    // A Message Center push activates a lazy Message Center so the message is ready when opened
     [self.messageList retrieveMessageListWithSuccessBlock:^{
         UAInboxMessage *message = [self.messageList messageForID:messageID];
         if (!message) {
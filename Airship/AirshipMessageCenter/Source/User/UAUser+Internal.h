@@ -65,6 +65,13 @@ NS_ASSUME_NONNULL_BEGIN
  */
 @property (nonatomic, assign) BOOL enabled;
 
+/**
+ * Flag indicating whether user creation is deferred. While set, an existing user will
+ * still be updated but a new user will not be created. Clearing the flag will create
+ * the user if needed.
+ */
+@property (nonatomic, assign) BOOL creationDeferred;
+
 @end
 
 NS_ASSUME_NONNULL_END
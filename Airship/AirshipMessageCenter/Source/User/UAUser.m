@@ -77,7 +77,7 @@ NSString * const UAUserCreatedNotification = @"com.urbanairship.notification.use
                                     client:[UAUserAPIClient clientWithConfig:config]
                         notificationCenter:[NSNotificationCenter defaultCenter]
                                application:[UIApplication sharedApplication]
-                      backgroundDispatcher:[UADispatcher globalDispatcher]
+                      backgroundDispatcher:[UADispatcher globalDispatcherForWorkType:UADispatcherWorkTypeUpload]
                                userDataDAO:[UAUserDataDAO userDataDAOWithConfig:config]];
 }
 
@@ -102,6 +102,10 @@ NSString * const UAUserCreatedNotification = @"com.urbanairship.notification.use
     return [self.userDataDAO getUserDataSync];
 }
 
+- (nullable UAUserData *)getCachedUserData {
+    return [self.userDataDAO getCachedUserData];
+}
+
 - (void)getUserData:(void (^)(UAUserData * _Nullable))completionHandler dispatcher:(nullable UADispatcher *)dispatcher {
     return [self.userDataDAO getUserData:completionHandler dispatcher:dispatcher];
 }
@@ -166,6 +170,13 @@ NSString * const UAUserCreatedNotification = @"com.urbanairship.notification.use
     } dispatcher:self.backgroundDispatcher];
 }
 
+- (void)setCreationDeferred:(BOOL)creationDeferred {
+    _creationDeferred = creationDeferred;
+    if (!creationDeferred) {
+        [self ensureUserUpToDate];
+    }
+}
+
 - (void)setEnabled:(BOOL)enabled {
     _enabled = enabled;
     self.apiClient.enabled = enabled;
@@ -233,6 +244,12 @@ NSString * const UAUserCreatedNotification = @"com.urbanairship.notification.use
             return;
         }
 
+        if (!data && self.creationDeferred) {
+            UA_LDEBUG(@"Skipping user creation, creation deferred");
+            completionHandler(NO);
+            return;
+        }
+
         self.registrationInProgress = YES;
         if (data) {
             [self updateUserWithUserData:data channelID:channelID completionHandler:completionHandler];
@@ -52,6 +52,14 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (nullable UAUserData *)getUserDataSync;
 
+/**
+ * Gets the data associated with the user if it has already been loaded, without reading the keychain.
+ * Safe to call from any queue, including while protected data is unavailable.
+ *
+ * @return The user data, or `nil` if no data has been loaded.
+ */
+- (nullable UAUserData *)getCachedUserData;
+
 /**
  * Save username and password data to disk.
  */
@@ -17,7 +17,7 @@
 
     if (self) {
         self.config = config;
-        self.backgroundDispatcher = [UADispatcher globalDispatcher];
+        self.backgroundDispatcher = [UADispatcher globalDispatcherForWorkType:UADispatcherWorkTypeProcessing];
     }
 
     return self;
@@ -28,6 +28,13 @@
 }
 
 - (nullable UAUserData *)getUserDataSync {
+    // Steady state reads skip the background hop
+    @synchronized (self) {
+        if (self.userData) {
+            return self.userData;
+        }
+    }
+
     __block UAUserData *userData;
 
     UA_WEAKIFY(self)
@@ -52,6 +59,22 @@
     return userData;
 }
 
+- (nullable UAUserData *)getCachedUserData {
+    @synchronized (self) {
+        if (self.userData) {
+            return self.userData;
+        }
+    }
+
+    NSString *username = [UAKeychainUtils getCachedUsername:self.config.appKey];
+    NSString *password = [UAKeychainUtils getCachedPassword:self.config.appKey];
+    if (username && password) {
+        return [UAUserData dataWithUsername:username password:password];
+    }
+
+    return nil;
+}
+
 - (void)getUserData:(void (^)(UAUserData *))completionHandler dispatcher:(nullable UADispatcher *)dispatcher {
     UA_WEAKIFY(self)
     [self.backgroundDispatcher dispatchAsync:^{
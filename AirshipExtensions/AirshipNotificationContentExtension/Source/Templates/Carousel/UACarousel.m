@@ -90,8 +90,16 @@
 - (UIView *)containerViewFromView:(UIView *)view {
     CGRect frame = view.bounds;
     frame.size.width =  self.itemWidth;
-    UIView *containerView = [[UIView alloc] initWithFrame:frame];
-    
+
+    // Recycled views keep their container
+    UIView *containerView = view.superview;
+    if (containerView) {
+        containerView.layer.transform = CATransform3DIdentity;
+        containerView.frame = frame;
+        return containerView;
+    }
+
+    containerView = [[UIView alloc] initWithFrame:frame];
     [containerView addSubview:view];
     
     return containerView;
@@ -132,6 +140,7 @@
     return view;
 }
 
+// Only the centered item and its neighbors are loaded, views scrolled out of that window are recycled
 - (void)loadViews {
     NSMutableSet *visibleIndexes = [NSMutableSet setWithCapacity:self.numberOfVisibleItems];
     int offset = round(self.scrollOffset) - self.numberOfVisibleItems/2;
@@ -162,15 +171,16 @@
 
 - (void)reloadData {
     for (UIView *view in [self.itemViews allValues]) {
-        [view removeFromSuperview];
+        [self queueItemView:view];
+        [view.superview removeFromSuperview];
     }
     
-    id dataSource = self.dataSource;
-    self.itemWidth = [dataSource itemWidthInCarousel:self];
-    self.spacing = [dataSource spacingInCarousel:self];
+    id delegate = self.delegate;
+    self.itemWidth = [delegate itemWidthInCarousel:self];
+    self.spacing = [delegate spacingInCarousel:self];
     
     [self.itemViews removeAllObjects];
-    [self.itemViewPool removeAllObjects];
+    [self setNeedsLayout];
 }
 
 #pragma mark -
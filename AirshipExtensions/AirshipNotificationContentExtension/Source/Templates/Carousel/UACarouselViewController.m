@@ -1,5 +1,6 @@
 /* Copyright Airship and Contributors */
 
+#import <ImageIO/ImageIO.h>
 #import "UACarouselViewController.h"
 #import "UACarousel.h"
 
@@ -16,6 +17,7 @@ static const double UACarouselScrollDuration = 0.5;
 static const double UACarouselDefaultImageCornerRadius = 5.0;
 static const double UACarouselDefaultViewRatio = 0.75;
 static const int UACarouselNumberOfVisibleItems = 3;
+static const NSUInteger UACarouselImageCacheCountLimit = UACarouselNumberOfVisibleItems + 1;
 static const int UACarouselDefaultContentBackgroundColor = 0xFFFFFF;
 static const int UACarouselDefaultBackgroundColor = 0xF8F8F8;
 static const double UACarouselDefaultSpacing = 10.0;
@@ -43,7 +45,9 @@ static NSString * const UACarouselNotificationContentModeKey = @"ua-contentMode"
 
 @property (nonatomic, strong) UACarousel *carousel;
 @property (nonatomic, copy) NSArray *attachments;
-@property (nonatomic, copy) NSArray *images;
+@property (nonatomic, copy) NSArray<NSURL *> *imageURLs;
+@property (nonatomic, strong) NSCache<NSNumber *, UIImage *> *imageCache;
+@property (nonatomic, strong) dispatch_queue_t imageQueue;
 @property (nonatomic, strong) NSTimer *timer;
 @property (nonatomic, assign) double carouselImageRatio;
 @property (nonatomic, assign) CGSize adaptedSize;
@@ -75,7 +79,7 @@ static NSString * const UACarouselNotificationContentModeKey = @"ua-contentMode"
     self.carousel.delegate = nil;
     self.carousel.dataSource = nil;
     self.carousel = nil;
-    self.images = nil;
+    self.imageURLs = nil;
     self.attachments = nil;
     [self.view removeFromSuperview];
 }
@@ -87,25 +91,38 @@ static NSString * const UACarouselNotificationContentModeKey = @"ua-contentMode"
         return;
     }
     
-    // preload images
-    __block NSMutableArray *images = @[].mutableCopy;
-    [attachments enumerateObjectsUsingBlock:^(UNNotificationAttachment *attachment, NSUInteger index, BOOL * _Nonnull stop) {
-        if ([attachment.URL startAccessingSecurityScopedResource]) {
-            images[index] = [UIImage imageWithContentsOfFile:attachment.URL.path];
+    // Images are decoded lazily, only the size of the first one is needed up front
+    NSMutableArray<NSURL *> *imageURLs = [NSMutableArray array];
+    CGSize firstImageSize = CGSizeZero;
+    for (UNNotificationAttachment *attachment in attachments) {
+        if (![attachment.URL startAccessingSecurityScopedResource]) {
+            continue;
         }
-    }];
+
+        CGSize imageSize = [self pixelSizeOfImageAtURL:attachment.URL];
+        if (imageSize.width <= 0 || imageSize.height <= 0) {
+            continue;
+        }
+
+        if (!imageURLs.count) {
+            firstImageSize = imageSize;
+        }
+        [imageURLs addObject:attachment.URL];
+    }
     
-    if (images.count == 0) {
+    if (imageURLs.count == 0) {
         return;
     }
     
-    self.images = images.copy;
+    self.imageURLs = imageURLs;
+    self.imageCache = [[NSCache alloc] init];
+    self.imageCache.countLimit = UACarouselImageCacheCountLimit;
+    self.imageQueue = dispatch_queue_create("com.urbanairship.carousel.images", DISPATCH_QUEUE_SERIAL);
     
     [self initCustomParamsFromUserInfo:notification.request.content.userInfo];
     
-    UIImage *firstImage = self.images[0];
     CGSize containerSize = self.view.frame.size;
-    self.carouselImageRatio = firstImage.size.height / firstImage.size.width;
+    self.carouselImageRatio = firstImageSize.height / firstImageSize.width;
     
     self.adaptedSize = [self adaptedSizeFromSize:containerSize];
     [self updateWithContentSize:CGSizeMake(CGRectGetWidth(self.view.frame),  (self.adaptedSize.height > kUAScreenHeight) ? kUAScreenHeight : (self.adaptedSize.height + self.padding * 2))];
@@ -123,7 +140,7 @@ static NSString * const UACarouselNotificationContentModeKey = @"ua-contentMode"
         
         [self addPaddingForView:self.carousel];
 
-        if (self.images.count > 1) {
+        if (self.imageURLs.count > 1) {
             UA_WEAKIFY(self);
             self.timer = [NSTimer scheduledTimerWithTimeInterval:self.scrollInterval repeats:YES block:^(NSTimer * _Nonnull timer) {
                 UA_STRONGIFY(self);
@@ -246,7 +263,7 @@ static NSString * const UACarouselNotificationContentModeKey = @"ua-contentMode"
 #pragma mark UACarousel methods
 
 - (NSUInteger)numberOfVisibleItemsInCarousel:(UACarousel *)carousel {
-   return (self.images.count > 1) ? UACarouselNumberOfVisibleItems : 1;
+   return (self.imageURLs.count > 1) ? UACarouselNumberOfVisibleItems : 1;
 }
 
 - (double)itemWidthInCarousel:(UACarousel *)carousel {
@@ -264,31 +281,119 @@ static NSString * const UACarouselNotificationContentModeKey = @"ua-contentMode"
         view.layer.cornerRadius = self.cornerRadius;
         ((UIImageView *)view).contentMode = self.contentMode;
         
-        CGRect frame = view.frame;
-        frame.size = self.adaptedSize;
-        view.frame = frame;
-        
         view.backgroundColor = self.contentBackgroundColor;
         
-        if (self.images.count == 1) {
+        if (self.imageURLs.count == 1) {
             self.view.backgroundColor = view.backgroundColor;
         }
     }
     
-    NSUInteger newIndex = index % self.images.count;
-    ((UIImageView *)view).image = self.images[newIndex];
+    // Recycled views are resized in case the carousel was reloaded for a new size
+    CGRect frame = view.frame;
+    frame.size = self.adaptedSize;
+    view.frame = frame;
+    
+    NSUInteger newIndex = index % self.imageURLs.count;
+    UIImageView *imageView = (UIImageView *)view;
+    imageView.tag = newIndex;
+    imageView.image = [self.imageCache objectForKey:@(newIndex)];
+    
+    if (!imageView.image) {
+        [self loadImageAtIndex:newIndex completionHandler:^(UIImage *image) {
+            // The view may have been recycled for another item while decoding
+            if (imageView.tag == newIndex) {
+                imageView.image = image;
+            }
+        }];
+    }
     
     return view;
 }
 
+#pragma mark -
+#pragma mark Image loading
+
+- (CGSize)pixelSizeOfImageAtURL:(NSURL *)URL {
+    CGImageSourceRef source = CGImageSourceCreateWithURL((__bridge CFURLRef)URL, NULL);
+    if (!source) {
+        return CGSizeZero;
+    }
+
+    NSDictionary *properties = (__bridge_transfer NSDictionary *)CGImageSourceCopyPropertiesAtIndex(source, 0, NULL);
+    CFRelease(source);
+
+    CGFloat width = [properties[(__bridge NSString *)kCGImagePropertyPixelWidth] doubleValue];
+    CGFloat height = [properties[(__bridge NSString *)kCGImagePropertyPixelHeight] doubleValue];
+
+    // Orientations 5 through 8 are rotated a quarter turn
+    if ([properties[(__bridge NSString *)kCGImagePropertyOrientation] intValue] >= 5) {
+        return CGSizeMake(height, width);
+    }
+
+    return CGSizeMake(width, height);
+}
+
+- (void)loadImageAtIndex:(NSUInteger)index completionHandler:(void (^)(UIImage *))completionHandler {
+    NSURL *URL = self.imageURLs[index];
+    CGFloat scale = [UIScreen mainScreen].scale;
+    CGFloat maxPixelSize = MAX(self.adaptedSize.width, self.adaptedSize.height) * scale;
+    NSCache *imageCache = self.imageCache;
+
+    UA_WEAKIFY(self);
+    dispatch_async(self.imageQueue, ^{
+        UA_STRONGIFY(self);
+        UIImage *image = [self downsampledImageAtURL:URL maxPixelSize:maxPixelSize scale:scale];
+        if (!image) {
+            return;
+        }
+
+        [imageCache setObject:image forKey:@(index)];
+        dispatch_async(dispatch_get_main_queue(), ^{
+            completionHandler(image);
+        });
+    });
+}
+
+// Decodes the image straight to the display size instead of inflating the full resolution bitmap
+- (UIImage *)downsampledImageAtURL:(NSURL *)URL maxPixelSize:(CGFloat)maxPixelSize scale:(CGFloat)scale {
+    NSDictionary *sourceOptions = @{ (__bridge NSString *)kCGImageSourceShouldCache : @NO };
+    CGImageSourceRef source = CGImageSourceCreateWithURL((__bridge CFURLRef)URL, (__bridge CFDictionaryRef)sourceOptions);
+    if (!source) {
+        return nil;
+    }
+
+    NSDictionary *thumbnailOptions = @{ (__bridge NSString *)kCGImageSourceCreateThumbnailFromImageAlways : @YES,
+                                        (__bridge NSString *)kCGImageSourceShouldCacheImmediately : @YES,
+                                        (__bridge NSString *)kCGImageSourceCreateThumbnailWithTransform : @YES,
+                                        (__bridge NSString *)kCGImageSourceThumbnailMaxPixelSize : @(MAX(maxPixelSize, 1)) };
+    CGImageRef imageRef = CGImageSourceCreateThumbnailAtIndex(source, 0, (__bridge CFDictionaryRef)thumbnailOptions);
+    CFRelease(source);
+
+    if (!imageRef) {
+        return nil;
+    }
+
+    UIImage *image = [UIImage imageWithCGImage:imageRef scale:scale orientation:UIImageOrientationUp];
+    CGImageRelease(imageRef);
+    return image;
+}
+
+- (void)didReceiveMemoryWarning {
+    [super didReceiveMemoryWarning];
+    [self.imageCache removeAllObjects];
+}
+
 - (void)viewWillTransitionToSize:(CGSize)size withTransitionCoordinator:(id<UIViewControllerTransitionCoordinator>)coordinator{
     self.spacingRatio = [self spacingRatioFromSpacing:self.spacing];
+    self.adaptedSize = [self adaptedSizeFromSize:size];
+    
+    // Images were decoded for the previous size
+    [self.imageCache removeAllObjects];
     
     if (self.carousel) {
         [self.carousel reloadData];
     }
     
-    self.adaptedSize = [self adaptedSizeFromSize:size];
     [self updateWithContentSize:CGSizeMake(size.width, (self.adaptedSize.height > kUAScreenHeight) ? kUAScreenHeight : (self.adaptedSize.height + self.padding * 2))];
 }
 
@@ -10,3 +10,4 @@ FOUNDATION_EXPORT const unsigned char AirshipNotificationServiceExtensionVersion
 
 #import "UANotificationServiceExtension.h"
 #import "UAMediaAttachmentPayload.h"
+#import "UAExtensionState.h"
@@ -0,0 +1,96 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+#import <UserNotifications/UserNotifications.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Info.plist key for the app group shared with the app. When not set, the media cache app group
+ * `UAMediaCacheAppGroup` is used. The app and its extensions must all use the same group.
+ */
+extern NSString * const UAExtensionStateAppGroupKey;
+
+/**
+ * Info.plist key to enable uploading delivery receipts directly from the extension. Defaults to `NO`.
+ */
+extern NSString * const UAExtensionStateDirectUploadEnabledKey;
+
+/**
+ * Airship state shared by the app through an app group container, so extensions can use the
+ * channel ID and config without taking off.
+ *
+ * The app writes a snapshot whenever the channel is created or updated. The snapshot is memory
+ * mapped and read once when the state is created.
+ *
+ * Deliveries are recorded as receipts in an append-only log that the app adds to its analytics in
+ * one batch on its next launch or foreground. When direct upload is enabled, the receipt is also
+ * uploaded right away under a small size and time budget, and the app then skips it.
+ */
+__TVOS_PROHIBITED __WATCHOS_PROHIBITED
+@interface UAExtensionState : NSObject
+
+/**
+ * The channel ID, or `nil` if the app has not created a channel yet.
+ */
+@property (nonatomic, readonly, nullable) NSString *channelID;
+
+/**
+ * The app key.
+ */
+@property (nonatomic, readonly, nullable) NSString *appKey;
+
+/**
+ * The device API URL.
+ */
+@property (nonatomic, readonly, nullable) NSString *deviceAPIURL;
+
+/**
+ * The analytics URL.
+ */
+@property (nonatomic, readonly, nullable) NSString *analyticsURL;
+
+/**
+ * When the app wrote the snapshot.
+ */
+@property (nonatomic, readonly, nullable) NSDate *lastUpdated;
+
+/**
+ * Whether analytics were enabled in the app when it wrote the snapshot. Receipts are only
+ * recorded when enabled.
+ */
+@property (nonatomic, readonly, getter=isAnalyticsEnabled) BOOL analyticsEnabled;
+
+/**
+ * Whether receipts are uploaded directly from the extension. Defaults to the
+ * `UAExtensionStateDirectUploadEnabledKey` Info.plist value.
+ */
+@property (nonatomic, assign, getter=isDirectUploadEnabled) BOOL directUploadEnabled;
+
+/**
+ * Factory method.
+ *
+ * @return The state for the app group set in the main bundle's Info.plist, or `nil` if no app
+ * group is set, its container is not available or the app has not written a snapshot yet.
+ */
++ (nullable instancetype)sharedState;
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param directoryURL The directory holding the shared state.
+ * @return The state, or `nil` if the directory has no readable snapshot.
+ */
++ (nullable instancetype)stateWithDirectoryURL:(NSURL *)directoryURL;
+
+/**
+ * Records a delivery receipt for a notification, for the app to collect. Uploads it directly
+ * when enabled. Does nothing if analytics are disabled.
+ *
+ * @param request The notification request.
+ */
+- (void)recordDeliveryOfNotificationRequest:(UNNotificationRequest *)request;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,198 @@
+/* Copyright Airship and Contributors */
+
+#import <fcntl.h>
+#import <unistd.h>
+
+#import "UAExtensionState.h"
+
+NSString * const UAExtensionStateAppGroupKey = @"UAAppGroup";
+NSString * const UAExtensionStateDirectUploadEnabledKey = @"UADeliveryDirectUploadEnabled";
+
+// Must match the app side of the state
+static NSString * const UAExtensionStateMediaCacheAppGroupKey = @"UAMediaCacheAppGroup";
+static NSString * const UAExtensionStateDirectory = @"Library/Application Support/com.urbanairship.extension_state";
+static NSString * const UAExtensionStateSnapshotFile = @"state.plist";
+static NSString * const UAExtensionStateDeliveriesFile = @"deliveries";
+static NSInteger const UAExtensionStateVersion = 1;
+
+static NSString * const UAExtensionStateVersionKey = @"version";
+static NSString * const UAExtensionStateDateKey = @"date";
+static NSString * const UAExtensionStateChannelIDKey = @"channel_id";
+static NSString * const UAExtensionStateAppKeyKey = @"app_key";
+static NSString * const UAExtensionStateDeviceAPIURLKey = @"device_api_url";
+static NSString * const UAExtensionStateAnalyticsURLKey = @"analytics_url";
+static NSString * const UAExtensionStateAnalyticsEnabledKey = @"analytics_enabled";
+static NSString * const UAExtensionStateAnalyticsHeadersKey = @"analytics_headers";
+
+static NSString * const UAExtensionStateReceiptEventIDKey = @"event_id";
+static NSString * const UAExtensionStateReceiptTimeKey = @"time";
+static NSString * const UAExtensionStateReceiptPushIDKey = @"push_id";
+static NSString * const UAExtensionStateReceiptMetadataKey = @"metadata";
+static NSString * const UAExtensionStateReceiptUploadedKey = @"uploaded";
+
+static NSString * const UAExtensionStatePushIDKey = @"_";
+static NSString * const UAExtensionStatePushMetadataKey = @"com.urbanairship.metadata";
+
+// Direct uploads are skipped for larger bodies and given up on after the timeout, the app
+// uploads those receipts instead
+static NSUInteger const UAExtensionStateDirectUploadMaxBytes = 2048;
+static NSTimeInterval const UAExtensionStateDirectUploadTimeout = 5;
+
+@interface UAExtensionState ()
+@property (nonatomic, strong) NSURL *directoryURL;
+@property (nonatomic, copy, nullable) NSString *channelID;
+@property (nonatomic, copy, nullable) NSString *appKey;
+@property (nonatomic, copy, nullable) NSString *deviceAPIURL;
+@property (nonatomic, copy, nullable) NSString *analyticsURL;
+@property (nonatomic, strong, nullable) NSDate *lastUpdated;
+@property (nonatomic, assign) BOOL analyticsEnabled;
+@property (nonatomic, copy, nullable) NSDictionary<NSString *, NSString *> *analyticsHeaders;
+@end
+
+@implementation UAExtensionState
+
+- (instancetype)initWithDirectoryURL:(NSURL *)directoryURL state:(NSDictionary *)state {
+    self = [super init];
+    if (self) {
+        self.directoryURL = directoryURL;
+        self.channelID = [self stringValue:state[UAExtensionStateChannelIDKey]];
+        self.appKey = [self stringValue:state[UAExtensionStateAppKeyKey]];
+        self.deviceAPIURL = [self stringValue:state[UAExtensionStateDeviceAPIURLKey]];
+        self.analyticsURL = [self stringValue:state[UAExtensionStateAnalyticsURLKey]];
+
+        id date = state[UAExtensionStateDateKey];
+        self.lastUpdated = [date isKindOfClass:[NSDate class]] ? date : nil;
+
+        self.analyticsEnabled = [state[UAExtensionStateAnalyticsEnabledKey] boolValue];
+        id headers = state[UAExtensionStateAnalyticsHeadersKey];
+        self.analyticsHeaders = [headers isKindOfClass:[NSDictionary class]] ? headers : nil;
+
+        self.directUploadEnabled = [[[NSBundle mainBundle] objectForInfoDictionaryKey:UAExtensionStateDirectUploadEnabledKey] boolValue];
+    }
+    return self;
+}
+
++ (nullable instancetype)sharedState {
+    NSBundle *bundle = [NSBundle mainBundle];
+    id appGroup = [bundle objectForInfoDictionaryKey:UAExtensionStateAppGroupKey] ?: [bundle objectForInfoDictionaryKey:UAExtensionStateMediaCacheAppGroupKey];
+    if (![appGroup isKindOfClass:[NSString class]] || ![appGroup length]) {
+        return nil;
+    }
+
+    NSURL *containerURL = [[NSFileManager defaultManager] containerURLForSecurityApplicationGroupIdentifier:appGroup];
+    if (!containerURL) {
+        NSLog(@"Unable to access app group container: %@", appGroup);
+        return nil;
+    }
+
+    return [self stateWithDirectoryURL:[containerURL URLByAppendingPathComponent:UAExtensionStateDirectory isDirectory:YES]];
+}
+
++ (nullable instancetype)stateWithDirectoryURL:(NSURL *)directoryURL {
+    // Mapped so reading the snapshot does not copy it into the extension's memory
+    NSURL *snapshotURL = [directoryURL URLByAppendingPathComponent:UAExtensionStateSnapshotFile];
+    NSData *data = [NSData dataWithContentsOfURL:snapshotURL options:NSDataReadingMappedAlways error:nil];
+    if (!data) {
+        return nil;
+    }
+
+    NSError *error;
+    id state = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:NULL error:&error];
+    if (![state isKindOfClass:[NSDictionary class]] || [state[UAExtensionStateVersionKey] integerValue] != UAExtensionStateVersion) {
+        NSLog(@"Unable to read shared Airship state: %@", error.localizedDescription ?: @"unsupported snapshot");
+        return nil;
+    }
+
+    return [[self alloc] initWithDirectoryURL:directoryURL state:state];
+}
+
+- (nullable NSString *)stringValue:(id)value {
+    return [value isKindOfClass:[NSString class]] ? value : nil;
+}
+
+- (void)recordDeliveryOfNotificationRequest:(UNNotificationRequest *)request {
+    if (!self.analyticsEnabled) {
+        return;
+    }
+
+    NSDictionary *userInfo = request.content.userInfo;
+    NSMutableDictionary *receipt = [NSMutableDictionary dictionary];
+    receipt[UAExtensionStateReceiptEventIDKey] = [NSUUID UUID].UUIDString;
+    receipt[UAExtensionStateReceiptTimeKey] = [NSString stringWithFormat:@"%f", [[NSDate date] timeIntervalSince1970]];
+    receipt[UAExtensionStateReceiptPushIDKey] = [self stringValue:userInfo[UAExtensionStatePushIDKey]];
+    receipt[UAExtensionStateReceiptMetadataKey] = [self stringValue:userInfo[UAExtensionStatePushMetadataKey]];
+
+    [self appendReceipt:receipt];
+
+    if (self.directUploadEnabled) {
+        [self uploadReceipt:receipt];
+    }
+}
+
+- (void)appendReceipt:(NSDictionary *)receipt {
+    NSMutableData *line = [[NSJSONSerialization dataWithJSONObject:receipt options:0 error:nil] mutableCopy];
+    if (!line) {
+        return;
+    }
+    [line appendBytes:"\n" length:1];
+
+    // A single append keeps the line whole even if the app collects the log at the same time
+    NSURL *deliveriesURL = [self.directoryURL URLByAppendingPathComponent:UAExtensionStateDeliveriesFile];
+    int fd = open(deliveriesURL.fileSystemRepresentation, O_WRONLY | O_APPEND | O_CREAT, 0644);
+    if (fd < 0) {
+        NSLog(@"Unable to record delivery: %s", strerror(errno));
+        return;
+    }
+
+    if (write(fd, line.bytes, line.length) != (ssize_t)line.length) {
+        NSLog(@"Unable to record delivery: %s", strerror(errno));
+    }
+    close(fd);
+}
+
+- (void)uploadReceipt:(NSDictionary *)receipt {
+    if (!self.analyticsURL.length || !self.analyticsHeaders[@"X-UA-Channel-ID"]) {
+        return;
+    }
+
+    NSMutableDictionary *data = [NSMutableDictionary dictionary];
+    data[@"push_id"] = receipt[UAExtensionStateReceiptPushIDKey] ?: @"MISSING_SEND_ID";
+    data[@"metadata"] = receipt[UAExtensionStateReceiptMetadataKey];
+
+    NSDictionary *event = @{ @"event_id" : receipt[UAExtensionStateReceiptEventIDKey],
+                             @"time" : receipt[UAExtensionStateReceiptTimeKey],
+                             @"type" : @"push_received",
+                             @"data" : data };
+
+    NSData *body = [NSJSONSerialization dataWithJSONObject:@[event] options:0 error:nil];
+    if (!body || body.length > UAExtensionStateDirectUploadMaxBytes) {
+        return;
+    }
+
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:[self.analyticsURL stringByAppendingString:@"/warp9/"]]];
+    request.HTTPMethod = @"POST";
+    request.HTTPBody = body;
+    [self.analyticsHeaders enumerateKeysAndObjectsUsingBlock:^(NSString *header, NSString *value, BOOL *stop) {
+        [request setValue:value forHTTPHeaderField:header];
+    }];
+    [request setValue:@"application/json" forHTTPHeaderField:@"Content-Type"];
+    [request setValue:[NSString stringWithFormat:@"%f", [[NSDate date] timeIntervalSince1970]] forHTTPHeaderField:@"X-UA-Sent-At"];
+
+    NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration ephemeralSessionConfiguration];
+    configuration.timeoutIntervalForResource = UAExtensionStateDirectUploadTimeout;
+    NSURLSession *session = [NSURLSession sessionWithConfiguration:configuration];
+
+    NSString *eventID = receipt[UAExtensionStateReceiptEventIDKey];
+    [[session dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+        if (error || ![response isKindOfClass:[NSHTTPURLResponse class]] || ((NSHTTPURLResponse *)response).statusCode != 200) {
+            NSLog(@"Direct delivery upload failed, the app will upload it: %@", error.localizedDescription);
+            return;
+        }
+
+        // Tells the app not to add the receipt again
+        [self appendReceipt:@{ UAExtensionStateReceiptUploadedKey : eventID }];
+    }] resume];
+    [session finishTasksAndInvalidate];
+}
+
+@end
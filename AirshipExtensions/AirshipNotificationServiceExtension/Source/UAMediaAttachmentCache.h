@@ -0,0 +1,57 @@
+/* Copyright Airship and Contributors */
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Info.plist key for the app group whose container holds the shared media cache. The app and
+ * its extensions must all set the same group to share downloaded media.
+ */
+extern NSString * const UAMediaAttachmentCacheAppGroupKey;
+
+/**
+ * Media cache shared through an app group container by the app and its notification extensions,
+ * so media downloaded by one process is not downloaded again by another.
+ *
+ * Entries are stored under the SHA-256 hash of the media URL, keeping the URL's path extension.
+ * Files are written atomically and copied out on read, so readers never see a partial file.
+ */
+__TVOS_PROHIBITED __WATCHOS_PROHIBITED
+@interface UAMediaAttachmentCache : NSObject
+
+/**
+ * Factory method.
+ *
+ * @return A cache for the app group set in the main bundle's Info.plist, or `nil` if no app
+ * group is set or its container is not available.
+ */
++ (nullable instancetype)sharedCache;
+
+/**
+ * Factory method. Used for testing.
+ *
+ * @param directoryURL The cache directory.
+ * @return A cache instance.
+ */
++ (instancetype)cacheWithDirectoryURL:(NSURL *)directoryURL;
+
+/**
+ * Copies a cached file for a media URL to a new temporary location.
+ *
+ * @param mediaURL The media URL.
+ * @return The temporary copy, or `nil` if the media is not cached or the entry expired.
+ */
+- (nullable NSURL *)copyOfCachedFileForURL:(NSURL *)mediaURL;
+
+/**
+ * Stores a copy of a downloaded file for a media URL.
+ *
+ * @param fileURL The downloaded file.
+ * @param mediaURL The media URL.
+ */
+- (void)storeFile:(NSURL *)fileURL forURL:(NSURL *)mediaURL;
+
+@end
+
+NS_ASSUME_NONNULL_END
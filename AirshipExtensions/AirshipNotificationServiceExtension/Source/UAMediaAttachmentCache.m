@@ -0,0 +1,132 @@
+/* Copyright Airship and Contributors */
+
+#import <CommonCrypto/CommonDigest.h>
+
+#import "UAMediaAttachmentCache.h"
+
+NSString * const UAMediaAttachmentCacheAppGroupKey = @"UAMediaCacheAppGroup";
+
+// Must match the app side of the cache
+static NSString * const UAMediaAttachmentCacheDirectory = @"Library/Caches/com.urbanairship.shared_media";
+static NSTimeInterval const UAMediaAttachmentCacheMaxAge = 7 * 24 * 60 * 60;
+
+@interface UAMediaAttachmentCache ()
+@property (nonatomic, strong) NSURL *directoryURL;
+@end
+
+@implementation UAMediaAttachmentCache
+
+- (instancetype)initWithDirectoryURL:(NSURL *)directoryURL {
+    self = [super init];
+    if (self) {
+        self.directoryURL = directoryURL;
+    }
+    return self;
+}
+
++ (nullable instancetype)sharedCache {
+    id appGroup = [[NSBundle mainBundle] objectForInfoDictionaryKey:UAMediaAttachmentCacheAppGroupKey];
+    if (![appGroup isKindOfClass:[NSString class]] || ![appGroup length]) {
+        return nil;
+    }
+
+    NSURL *containerURL = [[NSFileManager defaultManager] containerURLForSecurityApplicationGroupIdentifier:appGroup];
+    if (!containerURL) {
+        NSLog(@"Unable to access app group container: %@", appGroup);
+        return nil;
+    }
+
+    return [[self alloc] initWithDirectoryURL:[containerURL URLByAppendingPathComponent:UAMediaAttachmentCacheDirectory isDirectory:YES]];
+}
+
++ (instancetype)cacheWithDirectoryURL:(NSURL *)directoryURL {
+    return [[self alloc] initWithDirectoryURL:directoryURL];
+}
+
+- (NSURL *)entryURLForURL:(NSURL *)mediaURL {
+    NSData *data = [mediaURL.absoluteString dataUsingEncoding:NSUTF8StringEncoding];
+    uint8_t digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256(data.bytes, (CC_LONG)data.length, digest);
+
+    NSMutableString *name = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [name appendFormat:@"%02x", digest[i]];
+    }
+
+    // Keep the extension so the file type can still be inferred
+    NSString *extension = mediaURL.pathExtension.lowercaseString;
+    if (extension.length) {
+        [name appendFormat:@".%@", extension];
+    }
+
+    return [self.directoryURL URLByAppendingPathComponent:name];
+}
+
+- (BOOL)isExpired:(NSURL *)entryURL {
+    NSDate *modified;
+    if (![entryURL getResourceValue:&modified forKey:NSURLContentModificationDateKey error:nil] || !modified) {
+        return YES;
+    }
+
+    return -[modified timeIntervalSinceNow] > UAMediaAttachmentCacheMaxAge;
+}
+
+- (nullable NSURL *)copyOfCachedFileForURL:(NSURL *)mediaURL {
+    NSFileManager *fm = [NSFileManager defaultManager];
+    NSURL *entryURL = [self entryURLForURL:mediaURL];
+
+    if (![fm fileExistsAtPath:entryURL.path] || [self isExpired:entryURL]) {
+        return nil;
+    }
+
+    NSURL *directoryURL = [[NSURL fileURLWithPath:NSTemporaryDirectory()] URLByAppendingPathComponent:[NSUUID UUID].UUIDString isDirectory:YES];
+    NSURL *copyURL = [directoryURL URLByAppendingPathComponent:entryURL.lastPathComponent];
+
+    NSError *error;
+    if (![fm createDirectoryAtURL:directoryURL withIntermediateDirectories:YES attributes:nil error:&error] ||
+        ![fm copyItemAtURL:entryURL toURL:copyURL error:&error]) {
+        NSLog(@"Unable to copy cached media for %@: %@", mediaURL, error.localizedDescription);
+        return nil;
+    }
+
+    return copyURL;
+}
+
+- (void)storeFile:(NSURL *)fileURL forURL:(NSURL *)mediaURL {
+    NSFileManager *fm = [NSFileManager defaultManager];
+    [fm createDirectoryAtURL:self.directoryURL withIntermediateDirectories:YES attributes:nil error:nil];
+
+    [self removeExpiredEntries];
+
+    // Copy next to the entry and then swap it in so other processes never read a partial file
+    NSURL *entryURL = [self entryURLForURL:mediaURL];
+    NSURL *stagingURL = [self.directoryURL URLByAppendingPathComponent:[NSString stringWithFormat:@".%@", [NSUUID UUID].UUIDString]];
+
+    NSError *error;
+    if (![fm copyItemAtURL:fileURL toURL:stagingURL error:&error]) {
+        NSLog(@"Unable to cache media for %@: %@", mediaURL, error.localizedDescription);
+        return;
+    }
+
+    // rename replaces any existing entry atomically
+    if (rename(stagingURL.fileSystemRepresentation, entryURL.fileSystemRepresentation) != 0) {
+        NSLog(@"Unable to cache media for %@: %s", mediaURL, strerror(errno));
+        [fm removeItemAtURL:stagingURL error:nil];
+    }
+}
+
+- (void)removeExpiredEntries {
+    NSFileManager *fm = [NSFileManager defaultManager];
+    NSArray<NSURL *> *entries = [fm contentsOfDirectoryAtURL:self.directoryURL
+                                  includingPropertiesForKeys:@[NSURLContentModificationDateKey]
+                                                     options:NSDirectoryEnumerationSkipsHiddenFiles
+                                                       error:nil];
+
+    for (NSURL *entryURL in entries) {
+        if ([self isExpired:entryURL]) {
+            [fm removeItemAtURL:entryURL error:nil];
+        }
+    }
+}
+
+@end
@@ -2,19 +2,30 @@
 
 #import <UserNotifications/UserNotifications.h>
 
+@class UAExtensionState;
+
+NS_ASSUME_NONNULL_BEGIN
+
 /**
  * A notification service extension for downloading and attaching media.
  */
 __TVOS_PROHIBITED __WATCHOS_PROHIBITED
 @interface UANotificationServiceExtension : UNNotificationServiceExtension
 
+/**
+ * The Airship state shared by the app, loaded when a notification request is received. `nil` if
+ * no app group is set or the app has not shared its state yet.
+ */
+@property (nonatomic, readonly, nullable) UAExtensionState *extensionState;
+
 /**
  * Method for inferring a Uniform Type Identifier for a media attachment if the file lacks an extension.
  *
  * @param data A memory-mapped NSData instance representing a downloaded attachment file
  * @return The inferred identifier, or nil if unsuccessful.
  */
-- (NSString *)uniformTypeIdentifierForData:(NSData *)data;
-
+- (nullable NSString *)uniformTypeIdentifierForData:(NSData *)data;
 
 @end
+
+NS_ASSUME_NONNULL_END
@@ -5,16 +5,60 @@
 
 #import "UANotificationServiceExtension.h"
 #import "UAMediaAttachmentPayload.h"
+#import "UAMediaAttachmentCache.h"
+#import "UAExtensionState.h"
 
 #define kUANotificationAttachmentServiceMediaAttachmentKey @"com.urbanairship.media_attachment"
 #define kUAAccengageNotificationIDKey @"a4sid"
+#define kUANotificationPushIDKey @"_"
+
+// The system gives the extension about 30 seconds, keep a margin to deliver the content
+#define kUAServiceExtensionTimeLimit 30
+#define kUAServiceExtensionDeliveryMargin 3
+
+// Maximum time for a single attachment download, in seconds
+#define kUAMediaAttachmentDownloadTimeout 15
+
+// Attachment size limits enforced by UNNotificationAttachment, in bytes
+#define kUAMediaAttachmentMaxImageBytes (10 * 1024 * 1024)
+#define kUAMediaAttachmentMaxAudioBytes (5 * 1024 * 1024)
+#define kUAMediaAttachmentMaxVideoBytes (50 * 1024 * 1024)
+
+/**
+ * A single attachment download. Only accessed on the download queue.
+ */
+@interface UAMediaAttachmentDownload : NSObject
+@property (nonatomic, strong) UAMediaAttachmentURL *attachmentURL;
+@property (nonatomic, copy) NSString *identifier;
+@property (nonatomic, copy) NSDictionary *options;
+@property (nonatomic, strong) NSURLSessionDownloadTask *task;
+@property (nonatomic, strong) UNNotificationAttachment *attachment;
+@property (nonatomic, assign) BOOL finished;
+@end
+
+@implementation UAMediaAttachmentDownload
+@end
 
-@interface UANotificationServiceExtension ()
+@interface UANotificationServiceExtension () <NSURLSessionDownloadDelegate>
 
 @property (nonatomic, strong) void (^contentHandler)(UNNotificationContent *contentToDeliver);
 @property (nonatomic, strong) UNMutableNotificationContent *bestAttemptContent;
 @property (nonatomic, strong) UNMutableNotificationContent *modifiedContent;
-@property (nonatomic, copy) NSArray *downloadTasks;
+@property (nonatomic, strong) UAMediaAttachmentPayload *payload;
+@property (nonatomic, strong) NSURLSession *session;
+@property (nonatomic, strong) NSOperationQueue *downloadQueue;
+@property (nonatomic, strong) UAMediaAttachmentCache *mediaCache;
+@property (nonatomic, strong, nullable) UAExtensionState *extensionState;
+
+/**
+ * The attachment downloads in payload order. Only accessed on the download queue.
+ */
+@property (nonatomic, copy) NSArray<UAMediaAttachmentDownload *> *downloads;
+
+/**
+ * Whether the content was handed to the content handler. Only accessed on the download queue.
+ */
+@property (nonatomic, assign) BOOL contentDelivered;
 
 @end
 
@@ -196,8 +240,24 @@
     return attachment;
 }
 
-- (NSURLSessionDownloadTask *)downloadTaskWithURL:(UAMediaAttachmentURL *)attachmentUrl completionHandler:(void (^)(NSURL *temporaryFileLocation, NSURLResponse *response, NSError *error))completionHandler {
-    return [[NSURLSession sharedSession] downloadTaskWithURL:attachmentUrl.url completionHandler:completionHandler];
+- (NSUInteger)maxBytesForMIMEType:(NSString *)mimeType {
+    if ([mimeType hasPrefix:@"image/"]) {
+        return kUAMediaAttachmentMaxImageBytes;
+    } else if ([mimeType hasPrefix:@"audio/"]) {
+        return kUAMediaAttachmentMaxAudioBytes;
+    }
+
+    return kUAMediaAttachmentMaxVideoBytes;
+}
+
+- (UAMediaAttachmentDownload *)downloadForTask:(NSURLSessionTask *)task {
+    for (UAMediaAttachmentDownload *download in self.downloads) {
+        if (download.task == task) {
+            return download;
+        }
+    }
+
+    return nil;
 }
 
 - (void)didReceiveNotificationRequest:(UNNotificationRequest *)request withContentHandler:(void (^)(UNNotificationContent * _Nonnull))contentHandler {
@@ -207,102 +267,240 @@
     self.bestAttemptContent = [request.content mutableCopy];
     self.modifiedContent = [request.content mutableCopy];
 
+    // Read from the snapshot the app shares, no SDK takeoff needed
+    self.extensionState = [UAExtensionState sharedState];
+    if (request.content.userInfo[kUANotificationPushIDKey]) {
+        [self.extensionState recordDeliveryOfNotificationRequest:request];
+    }
+
     id jsonPayload = request.content.userInfo[kUANotificationAttachmentServiceMediaAttachmentKey];
     
     if (!jsonPayload && request.content.userInfo[kUAAccengageNotificationIDKey]) {
         jsonPayload = request.content.userInfo;
     }
 
-    if (jsonPayload) {
-        UAMediaAttachmentPayload *payload = [UAMediaAttachmentPayload payloadWithJSONObject:jsonPayload];
-        if (payload) {
-            __block NSMutableArray *attachments = [NSMutableArray array];
-            dispatch_group_t downloadTaskGroup = dispatch_group_create();
-            
-            NSMutableArray *currentDownloadTasks = [NSMutableArray array];
-            [currentDownloadTasks addObjectsFromArray:self.downloadTasks];
-           
-            for (UAMediaAttachmentURL *url in payload.urls) {
-                
-                // If the payload url doesn't contain an ID, pass an empty string for the identifier so that the attachment can generate its own unique ID
-                NSString *identifier = url.urlID ?: @"";
-                
-                NSMutableDictionary *options = [NSMutableDictionary dictionaryWithDictionary:payload.options];
-                
-                // Only leave the thumbnail visible for the attachment with the thumbnail ID
-                if (payload.thumbnailID && ![payload.thumbnailID isEqualToString:identifier]) {
-                    [options setValue:@YES forKey:UNNotificationAttachmentOptionsThumbnailHiddenKey];
-                }
-                
-                void (^completionHandler)(NSURL *temporaryFileLocation, NSURLResponse *response, NSError *error) = ^(NSURL *temporaryFileLocation, NSURLResponse *response, NSError *error) {
-                    if (error) {
-                        NSLog(@"Error downloading attachment: %@", error.localizedDescription);
-                        self.contentHandler(self.bestAttemptContent);
-                        dispatch_group_leave(downloadTaskGroup);
-                        return;
-                    }
-
-                    NSString *mimeType = nil;
-                    if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
-                        NSHTTPURLResponse *httpResponse = (NSHTTPURLResponse *)response;
-                        mimeType = httpResponse.allHeaderFields[@"Content-Type"];
-                    }
-
-                    UNNotificationAttachment *attachment = [self attachmentWithTemporaryFileLocation:temporaryFileLocation originalURL:url.url mimeType:mimeType options:options.copy identifier:identifier];
-
-                    // A nil attachment may indicate an unrecognized file type
-                    if (!attachment) {
-                        self.contentHandler(self.bestAttemptContent);
-                        dispatch_group_leave(downloadTaskGroup);
-                        return;
-                    }
-                           
-                    [attachments addObject:attachment];
-                           
-                    self.modifiedContent.attachments = attachments.copy;
-                    self.bestAttemptContent.attachments = attachments.copy;
-                           
-                    dispatch_group_leave(downloadTaskGroup);
-                };
-                
-                dispatch_group_enter(downloadTaskGroup);
-                NSURLSessionDownloadTask *downloadTask = [self downloadTaskWithURL:url completionHandler:completionHandler];
-                [currentDownloadTasks addObject:downloadTask];
-                [downloadTask resume];
+    if (!jsonPayload) {
+        self.contentHandler(self.bestAttemptContent);
+        return;
+    }
+
+    UAMediaAttachmentPayload *payload = [UAMediaAttachmentPayload payloadWithJSONObject:jsonPayload];
+    if (!payload) {
+        NSLog(@"Unable to parse attachment: %@", payload);
+        self.contentHandler(self.bestAttemptContent);
+        return;
+    }
+
+    self.payload = payload;
+    self.mediaCache = [UAMediaAttachmentCache sharedCache];
+
+    if (payload.content.body) {
+        self.modifiedContent.body = payload.content.body;
+    }
+
+    if (payload.content.title) {
+        self.modifiedContent.title = payload.content.title;
+    }
+
+    if (payload.content.subtitle) {
+        self.modifiedContent.subtitle = payload.content.subtitle;
+    }
+
+    // All download state is confined to a serial queue shared with the session callbacks
+    self.downloadQueue = [[NSOperationQueue alloc] init];
+    self.downloadQueue.maxConcurrentOperationCount = 1;
+
+    NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration ephemeralSessionConfiguration];
+    configuration.timeoutIntervalForResource = kUAMediaAttachmentDownloadTimeout;
+    self.session = [NSURLSession sessionWithConfiguration:configuration delegate:self delegateQueue:self.downloadQueue];
+
+    [self.downloadQueue addOperationWithBlock:^{
+        [self startDownloads];
+    }];
+
+    // Deliver whatever is ready once the deadline passes
+    NSTimeInterval deadline = kUAServiceExtensionTimeLimit - kUAServiceExtensionDeliveryMargin;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(deadline * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+        [self.downloadQueue addOperationWithBlock:^{
+            if (!self.contentDelivered) {
+                NSLog(@"Attachment download deadline reached");
+                [self deliverContent];
             }
-         
-            self.downloadTasks = currentDownloadTasks.copy;
-            
-            dispatch_group_notify(downloadTaskGroup, dispatch_get_main_queue(),^{
-                if (payload.content.body) {
-                    self.modifiedContent.body = payload.content.body;
-                }
+        }];
+    });
+}
 
-                if (payload.content.title) {
-                    self.modifiedContent.title = payload.content.title;
-                }
+/**
+ * Starts a download for each attachment, the thumbnail first and at a higher priority so
+ * it is the most likely to be ready. Must be called on the download queue.
+ */
+- (void)startDownloads {
+    UAMediaAttachmentPayload *payload = self.payload;
+    NSMutableArray<UAMediaAttachmentDownload *> *downloads = [NSMutableArray array];
 
-                if (payload.content.subtitle) {
-                    self.modifiedContent.subtitle = payload.content.subtitle;
-                }
-                self.contentHandler(self.modifiedContent);
-            });
+    for (UAMediaAttachmentURL *url in payload.urls) {
+        UAMediaAttachmentDownload *download = [[UAMediaAttachmentDownload alloc] init];
+        download.attachmentURL = url;
+
+        // If the payload url doesn't contain an ID, pass an empty string for the identifier so that the attachment can generate its own unique ID
+        download.identifier = url.urlID ?: @"";
+
+        NSMutableDictionary *options = [NSMutableDictionary dictionaryWithDictionary:payload.options];
+
+        // Only leave the thumbnail visible for the attachment with the thumbnail ID
+        if (payload.thumbnailID && ![payload.thumbnailID isEqualToString:download.identifier]) {
+            [options setValue:@YES forKey:UNNotificationAttachmentOptionsThumbnailHiddenKey];
+        }
+
+        download.options = options;
+        [downloads addObject:download];
+
+        // Media already downloaded by the app or an earlier notification skips the network
+        NSURL *cachedFileURL = [self.mediaCache copyOfCachedFileForURL:url.url];
+        if (cachedFileURL) {
+            download.attachment = [self attachmentWithTemporaryFileLocation:cachedFileURL
+                                                                originalURL:url.url
+                                                                   mimeType:nil
+                                                                    options:download.options
+                                                                 identifier:download.identifier];
+        }
+
+        if (download.attachment) {
+            download.finished = YES;
         } else {
-            NSLog(@"Unable to parse attachment: %@", payload);
-            self.contentHandler(self.bestAttemptContent);
+            download.task = [self.session downloadTaskWithURL:url.url];
+        }
+    }
+
+    self.downloads = downloads;
+
+    NSArray<UAMediaAttachmentDownload *> *pending = [downloads filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"finished == NO"]];
+    if (!pending.count) {
+        [self deliverContent];
+        return;
+    }
+
+    // Without a thumbnail ID the first attachment is used as the thumbnail
+    NSUInteger thumbnailIndex = [downloads indexOfObjectPassingTest:^BOOL(UAMediaAttachmentDownload *download, NSUInteger idx, BOOL *stop) {
+        return [download.identifier isEqualToString:payload.thumbnailID];
+    }];
+
+    UAMediaAttachmentDownload *thumbnailDownload = downloads[thumbnailIndex == NSNotFound ? 0 : thumbnailIndex];
+    thumbnailDownload.task.priority = NSURLSessionTaskPriorityHigh;
+    [thumbnailDownload.task resume];
+
+    for (UAMediaAttachmentDownload *download in pending) {
+        if (download != thumbnailDownload) {
+            [download.task resume];
         }
-    } else {
-        self.contentHandler(self.bestAttemptContent);
     }
 }
 
-- (void)serviceExtensionTimeWillExpire {
-    for (NSURLSessionDownloadTask *task in self.downloadTasks) {
-        if (task.state != NSURLSessionTaskStateCompleted) {
-            [task cancel];
+/**
+ * Hands the content with the finished attachments to the content handler and cancels any
+ * remaining downloads. Must be called on the download queue.
+ */
+- (void)deliverContent {
+    if (self.contentDelivered) {
+        return;
+    }
+
+    self.contentDelivered = YES;
+
+    NSMutableArray<UNNotificationAttachment *> *attachments = [NSMutableArray array];
+    for (UAMediaAttachmentDownload *download in self.downloads) {
+        if (download.attachment) {
+            [attachments addObject:download.attachment];
+        }
+    }
+
+    self.modifiedContent.attachments = attachments;
+    self.bestAttemptContent.attachments = attachments;
+
+    [self.session invalidateAndCancel];
+    self.contentHandler(self.modifiedContent);
+}
+
+#pragma mark -
+#pragma mark NSURLSessionDownloadDelegate
+
+- (void)URLSession:(NSURLSession *)session
+      downloadTask:(NSURLSessionDownloadTask *)downloadTask
+      didWriteData:(int64_t)bytesWritten
+ totalBytesWritten:(int64_t)totalBytesWritten
+totalBytesExpectedToWrite:(int64_t)totalBytesExpectedToWrite {
+
+    // Stop as soon as the attachment is known to exceed the system limit for its type
+    NSUInteger maxBytes = [self maxBytesForMIMEType:downloadTask.response.MIMEType];
+    if (totalBytesWritten > maxBytes || totalBytesExpectedToWrite > (int64_t)maxBytes) {
+        NSLog(@"Attachment %@ exceeds the maximum size of %lu bytes", downloadTask.originalRequest.URL, (unsigned long)maxBytes);
+        [downloadTask cancel];
+    }
+}
+
+- (void)URLSession:(NSURLSession *)session downloadTask:(NSURLSessionDownloadTask *)downloadTask didFinishDownloadingToURL:(NSURL *)location {
+    UAMediaAttachmentDownload *download = [self downloadForTask:downloadTask];
+    if (!download || self.contentDelivered) {
+        return;
+    }
+
+    NSURLResponse *response = downloadTask.response;
+    if ([response isKindOfClass:[NSHTTPURLResponse class]] && ((NSHTTPURLResponse *)response).statusCode / 100 != 2) {
+        NSLog(@"Error downloading attachment: status %ld", (long)((NSHTTPURLResponse *)response).statusCode);
+        return;
+    }
+
+    NSString *mimeType = nil;
+    if ([response isKindOfClass:[NSHTTPURLResponse class]]) {
+        NSHTTPURLResponse *httpResponse = (NSHTTPURLResponse *)response;
+        mimeType = httpResponse.allHeaderFields[@"Content-Type"];
+    }
+
+    [self.mediaCache storeFile:location forURL:download.attachmentURL.url];
+
+    // The file at location is removed once this returns, so the attachment has to be created now.
+    // A nil attachment may indicate an unrecognized file type.
+    download.attachment = [self attachmentWithTemporaryFileLocation:location
+                                                        originalURL:download.attachmentURL.url
+                                                           mimeType:mimeType
+                                                            options:download.options
+                                                         identifier:download.identifier];
+}
+
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didCompleteWithError:(NSError *)error {
+    UAMediaAttachmentDownload *download = [self downloadForTask:task];
+    if (!download || self.contentDelivered) {
+        return;
+    }
+
+    if (error) {
+        NSLog(@"Error downloading attachment: %@", error.localizedDescription);
+    }
+
+    download.finished = YES;
+
+    for (UAMediaAttachmentDownload *other in self.downloads) {
+        if (!other.finished) {
+            return;
         }
     }
-    self.contentHandler(self.bestAttemptContent);
+
+    [self deliverContent];
+}
+
+#pragma mark -
+#pragma mark UNNotificationServiceExtension
+
+- (void)serviceExtensionTimeWillExpire {
+    if (!self.downloadQueue) {
+        return;
+    }
+
+    // Deliver synchronously, the extension is terminated once this returns
+    NSOperation *operation = [NSBlockOperation blockOperationWithBlock:^{
+        [self deliverContent];
+    }];
+    [self.downloadQueue addOperations:@[operation] waitUntilFinished:YES];
 }
 
 @end
@@ -130,4 +130,26 @@
     [self waitForTestExpectations];
 }
 
+- (void)testFailedAttachmentDoesNotDropOthers {
+    NSBundle *bundle = [NSBundle bundleForClass:[self class]];
+    NSURL *mediaURL = [bundle URLForResource:@"airship" withExtension:@"jpg"];
+    NSURL *missingURL = [[mediaURL URLByDeletingLastPathComponent] URLByAppendingPathComponent:@"missing.jpg"];
+
+    UNMutableNotificationContent *content = [[UNMutableNotificationContent alloc] init];
+    content.userInfo = @{ @"com.urbanairship.media_attachment": @{ @"url": @[ missingURL.absoluteString, mediaURL.absoluteString ],
+                                                                     @"content": @{ @"body": @"body" } } };
+
+    UNNotificationRequest *request = [UNNotificationRequest requestWithIdentifier:@"identifier" content:content trigger:nil];
+
+    XCTestExpectation *contentDelivered = [self expectationWithDescription:@"content delivered"];
+    [self.serviceExtension didReceiveNotificationRequest:request withContentHandler:^(UNNotificationContent * _Nonnull deliveredContent) {
+        // The failed download is skipped instead of delivering early without the other attachment
+        XCTAssertEqual(deliveredContent.attachments.count, 1);
+        XCTAssertEqualObjects(deliveredContent.body, @"body");
+        [contentDelivered fulfill];
+    }];
+
+    [self waitForTestExpectations];
+}
+
 @end
@@ -64,11 +64,13 @@ let package = Package(
                     .linkedFramework("SystemConfiguration"),
                     .linkedFramework("UIKit"),
                     .linkedFramework("CoreData"),
+                    .linkedFramework("Network"),
                     .linkedFramework("WebKit", .when(platforms: [.iOS])),
                     .linkedFramework("CoreTelephony", .when(platforms: [.iOS])),
                     //Libraries
                     .linkedLibrary("z"),
-                    .linkedLibrary("sqlite3")
+                    .linkedLibrary("sqlite3"),
+                    .linkedLibrary("compression")
                 ]
         ),
         .target(name:"AirshipAutomation",
@@ -85,7 +87,8 @@ let package = Package(
                 cSettings: [
                     .headerSearchPath("Source")],
                 linkerSettings: [
-                    .linkedFramework("UIKit")]
+                    .linkedFramework("UIKit"),
+                    .linkedFramework("AVKit", .when(platforms: [.iOS]))]
         ),
         .target(name:"AirshipMessageCenter",
                 dependencies: [.target(name: "AirshipCore")],
@@ -102,7 +105,9 @@ let package = Package(
                     .headerSearchPath("Source"),
                     .headerSearchPath("Source/Inbox"),
                     .headerSearchPath("Source/Inbox/Data"),
-                    .headerSearchPath("Source/User"),]
+                    .headerSearchPath("Source/User"),],
+                linkerSettings: [
+                    .linkedFramework("ImageIO")]
         ),
         .target(name:"AirshipExtendedActions",
                 dependencies: [.target(name: "AirshipCore")],
@@ -41,4 +41,26 @@ class CoreUITests: XCTestCase {
         messageCenterNavigationBar.buttons["Edit"].tap()
         messageCenterNavigationBar.buttons["Cancel"].tap()
     }
+
+    /// Measures scroll hitches in the message center list. Needs an inbox with enough messages to scroll.
+    func testMessageCenterScrollPerformance() throws {
+        guard #available(iOS 14.0, *) else {
+            throw XCTSkip("Scroll metrics require iOS 14")
+        }
+
+        app.tabBars.buttons["Message Center"].tap()
+
+        let messageTable = app.tables.firstMatch
+        XCTAssert(messageTable.waitForExistence(timeout: 10))
+        try XCTSkipUnless(messageTable.cells.count > 10, "Inbox has too few messages to scroll")
+
+        let options = XCTMeasureOptions()
+        options.invocationOptions = [.manuallyStop]
+
+        measure(metrics: [XCTOSSignpostMetric.scrollDecelerationMetric], options: options) {
+            messageTable.swipeUp(velocity: .fast)
+            stopMeasuring()
+            messageTable.swipeDown(velocity: .fast)
+        }
+    }
 }
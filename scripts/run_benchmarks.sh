@@ -0,0 +1,24 @@
+#!/bin/bash
+
+set -o pipefail
+set -e
+set -x
+
+ROOT_PATH=`dirname "${0}"`/..
+RESULT_BUNDLE_PATH=${1:-"${ROOT_PATH}/build/benchmarks/Benchmarks.xcresult"}
+
+echo -ne "\n\n *********** RUNNING BENCHMARKS *********** \n\n"
+
+rm -rf "${RESULT_BUNDLE_PATH}"
+
+# Benchmarks are skipped unless UA_BENCHMARKS is set in the test process
+TEST_RUNNER_UA_BENCHMARKS=1 xcrun xcodebuild \
+-destination "${TEST_DESTINATION}" \
+-workspace "${ROOT_PATH}/Airship.xcworkspace" \
+-scheme AirshipCore \
+-only-testing:AirshipTests/UAEventPipelineBenchmarkTest \
+-only-testing:AirshipTests/UAAutomationEngineBenchmarkTest \
+-only-testing:AirshipTests/UARemoteDataIngestBenchmarkTest \
+-only-testing:AirshipTests/UAMessageCenterBenchmarkTest \
+-resultBundlePath "${RESULT_BUNDLE_PATH}" \
+test